@@ -10,12 +10,85 @@
 
 #include "api/audio/audio_frame.h"
 
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 #include <string.h>
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "rtc_base/checks.h"
 #include "rtc_base/time_utils.h"
 
 namespace webrtc {
+namespace {
+
+AudioFrame::SampleStats ComputeSampleStats(const int16_t* data,
+                                           size_t length) {
+  size_t i = 0;
+  int max_abs = 0;
+  int64_t sum_square = 0;
+#if defined(WEBRTC_HAS_NEON)
+  int16x8_t max_abs_8 = vdupq_n_s16(0);
+  int64x2_t sum_square_2 = vdupq_n_s64(0);
+  for (; i + 8 <= length; i += 8) {
+    const int16x8_t samples = vld1q_s16(data + i);
+    max_abs_8 = vmaxq_s16(max_abs_8, vqabsq_s16(samples));
+    // The squares fit in 31 bits, and are accumulated in 64 bits.
+    sum_square_2 = vpadalq_s32(
+        sum_square_2, vmull_s16(vget_low_s16(samples), vget_low_s16(samples)));
+    sum_square_2 =
+        vpadalq_s32(sum_square_2,
+                    vmull_s16(vget_high_s16(samples), vget_high_s16(samples)));
+  }
+  int16_t max_abs_lanes[8];
+  vst1q_s16(max_abs_lanes, max_abs_8);
+  max_abs = *std::max_element(max_abs_lanes, max_abs_lanes + 8);
+  sum_square =
+      vgetq_lane_s64(sum_square_2, 0) + vgetq_lane_s64(sum_square_2, 1);
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  const __m128i zero = _mm_setzero_si128();
+  __m128i max_abs_8 = zero;
+  __m128i sum_square_2 = zero;
+  for (; i + 8 <= length; i += 8) {
+    const __m128i samples =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    // The saturating negation makes the absolute value of -32768 be 32767.
+    max_abs_8 = _mm_max_epi16(
+        max_abs_8, _mm_max_epi16(samples, _mm_subs_epi16(zero, samples)));
+    // Each pair of squares sums to at most 2^31, which fits when treated as
+    // unsigned, and is zero extended to be accumulated in 64 bits.
+    const __m128i squares = _mm_madd_epi16(samples, samples);
+    sum_square_2 =
+        _mm_add_epi64(sum_square_2, _mm_unpacklo_epi32(squares, zero));
+    sum_square_2 =
+        _mm_add_epi64(sum_square_2, _mm_unpackhi_epi32(squares, zero));
+  }
+  int16_t max_abs_lanes[8];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(max_abs_lanes), max_abs_8);
+  max_abs = *std::max_element(max_abs_lanes, max_abs_lanes + 8);
+  int64_t sum_square_lanes[2];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(sum_square_lanes), sum_square_2);
+  sum_square = sum_square_lanes[0] + sum_square_lanes[1];
+#endif
+  for (; i < length; ++i) {
+    const int sample = data[i];
+    max_abs = std::max(max_abs, std::abs(sample));
+    sum_square += sample * sample;
+  }
+  AudioFrame::SampleStats stats;
+  stats.max_abs = static_cast<int16_t>(std::min(max_abs, 32767));
+  stats.sum_square = sum_square;
+  return stats;
+}
+
+}  // namespace
 
 AudioFrame::AudioFrame() {
   // Visual Studio doesn't like this in the class definition.
@@ -25,6 +98,7 @@ AudioFrame::AudioFrame() {
 void AudioFrame::Reset() {
   ResetWithoutMuting();
   muted_ = true;
+  sample_stats_ = absl::nullopt;
 }
 
 void AudioFrame::ResetWithoutMuting() {
@@ -70,6 +144,7 @@ void AudioFrame::UpdateFrame(uint32_t timestamp,
   } else {
     muted_ = true;
   }
+  sample_stats_ = absl::nullopt;
 }
 
 void AudioFrame::CopyFrom(const AudioFrame& src) {
@@ -95,6 +170,8 @@ void AudioFrame::CopyFrom(const AudioFrame& src) {
     memcpy(data_, src.data(), sizeof(int16_t) * length);
     muted_ = false;
   }
+  sample_stats_ = src.sample_stats_;
+  sample_stats_length_ = src.sample_stats_length_;
 }
 
 void AudioFrame::UpdateProfileTimeStamp() {
@@ -120,17 +197,32 @@ int16_t* AudioFrame::mutable_data() {
     memset(data_, 0, kMaxDataSizeBytes);
     muted_ = false;
   }
+  sample_stats_ = absl::nullopt;
   return data_;
 }
 
 void AudioFrame::Mute() {
   muted_ = true;
+  sample_stats_ = absl::nullopt;
 }
 
 bool AudioFrame::muted() const {
   return muted_;
 }
 
+AudioFrame::SampleStats AudioFrame::sample_stats() const {
+  if (muted_) {
+    return SampleStats();
+  }
+  const size_t length = samples_per_channel_ * num_channels_;
+  RTC_DCHECK_LE(length, kMaxDataSizeSamples);
+  if (!sample_stats_ || sample_stats_length_ != length) {
+    sample_stats_ = ComputeSampleStats(data_, length);
+    sample_stats_length_ = length;
+  }
+  return *sample_stats_;
+}
+
 // static
 const int16_t* AudioFrame::empty_data() {
   static int16_t* null_data = new int16_t[kMaxDataSizeSamples]();
@@ -14,6 +14,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "absl/types/optional.h"
 #include "api/audio/channel_layout.h"
 #include "api/rtp_packet_infos.h"
 
@@ -100,6 +101,20 @@ class AudioFrame {
   // Frame is muted by default.
   bool muted() const;
 
+  struct SampleStats {
+    // Largest absolute sample value, saturated to 32767.
+    int16_t max_abs = 0;
+    // Sum of the squared sample values.
+    int64_t sum_square = 0;
+  };
+  // Returns the statistics of all samples of all channels, which audio levels
+  // and energies are computed from. They are computed on the first call and
+  // cached until the frame is modified, so that each stage of the audio
+  // pipeline doesn't compute them again. Samples must only be written through
+  // a pointer returned by a mutable_data() call made after the last call to
+  // sample_stats().
+  SampleStats sample_stats() const;
+
   size_t max_16bit_samples() const { return kMaxDataSizeSamples; }
   size_t samples_per_channel() const { return samples_per_channel_; }
   size_t num_channels() const { return num_channels_; }
@@ -161,6 +176,11 @@ class AudioFrame {
   int16_t data_[kMaxDataSizeSamples];
   bool muted_ = true;
 
+  // Cached result of sample_stats(), and the number of samples it was
+  // computed over.
+  mutable absl::optional<SampleStats> sample_stats_;
+  mutable size_t sample_stats_length_ = 0;
+
   // Absolute capture timestamp when this audio frame was originally captured.
   // This is only valid for audio frames captured on this machine. The absolute
   // capture timestamp of a received frame is found in `packet_infos_`.
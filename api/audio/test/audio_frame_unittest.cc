@@ -133,4 +133,35 @@ TEST(AudioFrameTest, CopyFrom) {
   EXPECT_EQ(0, memcmp(frame2.data(), frame1.data(), sizeof(samples)));
 }
 
+TEST(AudioFrameTest, SampleStats) {
+  AudioFrame frame;
+  EXPECT_EQ(frame.sample_stats().max_abs, 0);
+  EXPECT_EQ(frame.sample_stats().sum_square, 0);
+
+  // An odd number of samples, so that both the vectorized and the remaining
+  // samples are covered, with extreme values in both.
+  constexpr size_t kNumSamplesPerChannel = 21;
+  int16_t samples[kNumSamplesPerChannel * kNumChannelsStereo];
+  int64_t sum_square = 0;
+  for (size_t i = 0; i < kNumSamplesPerChannel * kNumChannelsStereo; ++i) {
+    samples[i] = i % 3 == 0 ? -32768 : static_cast<int16_t>(i * 100);
+    sum_square += samples[i] * samples[i];
+  }
+  frame.UpdateFrame(kTimestamp, samples, kNumSamplesPerChannel, kSampleRateHz,
+                    AudioFrame::kNormalSpeech, AudioFrame::kVadActive,
+                    kNumChannelsStereo);
+  EXPECT_EQ(frame.sample_stats().max_abs, 32767);
+  EXPECT_EQ(frame.sample_stats().sum_square, sum_square);
+
+  frame.mutable_data()[0] = 0;
+  EXPECT_EQ(frame.sample_stats().sum_square, sum_square - 32768 * 32768);
+  frame.samples_per_channel_ = 1;
+  EXPECT_EQ(frame.sample_stats().max_abs, 100);
+  EXPECT_EQ(frame.sample_stats().sum_square, 100 * 100);
+
+  frame.Mute();
+  EXPECT_EQ(frame.sample_stats().max_abs, 0);
+  EXPECT_EQ(frame.sample_stats().sum_square, 0);
+}
+
 }  // namespace webrtc
@@ -0,0 +1,508 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/crypto/sframe_transformer.h"
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/string_view.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNonceSize = 12;
+constexpr size_t kTagSize = 16;
+// The configuration byte, followed by a key id and a counter of up to 8 bytes
+// each.
+constexpr size_t kMaxHeaderSize = 1 + 8 + 8;
+
+constexpr absl::string_view kKeyLabel = "SFrame 1.0 Secret key ";
+constexpr absl::string_view kSaltLabel = "SFrame 1.0 Secret salt ";
+constexpr absl::string_view kRatchetLabel = "SFrame 1.0 Ratchet";
+
+const EVP_MD* Hash(SframeTransformer::CipherSuite cipher_suite) {
+  switch (cipher_suite) {
+    case SframeTransformer::CipherSuite::kAes128GcmSha256:
+      return EVP_sha256();
+    case SframeTransformer::CipherSuite::kAes256GcmSha512:
+      return EVP_sha512();
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+const EVP_CIPHER* Cipher(SframeTransformer::CipherSuite cipher_suite) {
+  switch (cipher_suite) {
+    case SframeTransformer::CipherSuite::kAes128GcmSha256:
+      return EVP_aes_128_gcm();
+    case SframeTransformer::CipherSuite::kAes256GcmSha512:
+      return EVP_aes_256_gcm();
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+// Number of bytes needed to encode `value`, at least one.
+size_t EncodedSize(uint64_t value) {
+  size_t size = 1;
+  while (size < 8 && (value >> (8 * size)) != 0) {
+    ++size;
+  }
+  return size;
+}
+
+void WriteBigEndian(uint64_t value, size_t size, uint8_t* data) {
+  for (size_t i = 0; i < size; ++i) {
+    data[size - 1 - i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+uint64_t ReadBigEndian(const uint8_t* data, size_t size) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; ++i) {
+    value = (value << 8) | data[i];
+  }
+  return value;
+}
+
+// Writes the SFrame header for `key_id` and `counter`, and returns its size.
+size_t WriteHeader(uint64_t key_id, uint64_t counter, uint8_t* header) {
+  size_t size = 1;
+  header[0] = 0;
+  if (key_id < 8) {
+    header[0] |= key_id << 4;
+  } else {
+    const size_t key_id_size = EncodedSize(key_id);
+    header[0] |= 0x80 | ((key_id_size - 1) << 4);
+    WriteBigEndian(key_id, key_id_size, &header[size]);
+    size += key_id_size;
+  }
+  if (counter < 8) {
+    header[0] |= counter;
+  } else {
+    const size_t counter_size = EncodedSize(counter);
+    header[0] |= 0x08 | (counter_size - 1);
+    WriteBigEndian(counter, counter_size, &header[size]);
+    size += counter_size;
+  }
+  return size;
+}
+
+// Parses the SFrame header at the start of `data`, and returns its size, or 0
+// if `data` is too short.
+size_t ParseHeader(rtc::ArrayView<const uint8_t> data,
+                   uint64_t& key_id,
+                   uint64_t& counter) {
+  if (data.empty()) {
+    return 0;
+  }
+  const uint8_t config = data[0];
+  size_t size = 1;
+  if (config & 0x80) {
+    const size_t key_id_size = ((config >> 4) & 0x07) + 1;
+    if (data.size() < size + key_id_size) {
+      return 0;
+    }
+    key_id = ReadBigEndian(&data[size], key_id_size);
+    size += key_id_size;
+  } else {
+    key_id = (config >> 4) & 0x07;
+  }
+  if (config & 0x08) {
+    const size_t counter_size = (config & 0x07) + 1;
+    if (data.size() < size + counter_size) {
+      return 0;
+    }
+    counter = ReadBigEndian(&data[size], counter_size);
+    size += counter_size;
+  } else {
+    counter = config & 0x07;
+  }
+  return size;
+}
+
+// HKDF-Extract with an empty salt, as specified in RFC 5869.
+rtc::ZeroOnFreeBuffer<uint8_t> HkdfExtract(
+    const EVP_MD* hash,
+    rtc::ArrayView<const uint8_t> key_material) {
+  // An empty salt is the same as a salt of hash length zeros.
+  const uint8_t salt[EVP_MAX_MD_SIZE] = {};
+  rtc::ZeroOnFreeBuffer<uint8_t> prk(EVP_MAX_MD_SIZE);
+  unsigned int prk_size = 0;
+  if (!HMAC(hash, salt, EVP_MD_size(hash), key_material.data(),
+            key_material.size(), prk.data(), &prk_size)) {
+    return {};
+  }
+  prk.SetSize(prk_size);
+  return prk;
+}
+
+// HKDF-Expand, as specified in RFC 5869, with `info` being `label` followed by
+// `context`.
+rtc::ZeroOnFreeBuffer<uint8_t> HkdfExpand(const EVP_MD* hash,
+                                          rtc::ArrayView<const uint8_t> prk,
+                                          absl::string_view label,
+                                          rtc::ArrayView<const uint8_t> context,
+                                          size_t size) {
+  rtc::ZeroOnFreeBuffer<uint8_t> output;
+  rtc::ZeroOnFreeBuffer<uint8_t> block;
+  rtc::ZeroOnFreeBuffer<uint8_t> input;
+  for (uint8_t i = 1; output.size() < size; ++i) {
+    input.SetData(block);
+    input.AppendData(label.data(), label.size());
+    input.AppendData(context);
+    input.AppendData(i);
+    block.SetSize(EVP_MAX_MD_SIZE);
+    unsigned int block_size = 0;
+    if (!HMAC(hash, prk.data(), static_cast<int>(prk.size()), input.data(),
+              input.size(), block.data(), &block_size)) {
+      return {};
+    }
+    block.SetSize(block_size);
+    output.AppendData(block);
+  }
+  output.SetSize(size);
+  return output;
+}
+
+struct CipherContextDeleter {
+  void operator()(EVP_CIPHER_CTX* context) const {
+    EVP_CIPHER_CTX_free(context);
+  }
+};
+
+}  // namespace
+
+// The key and salt derived from a base key, with a cipher context which is
+// initialized with the key, so that only the nonce is set for each frame.
+class SframeTransformer::Key {
+ public:
+  // Returns null if the key can't be derived or used.
+  static std::unique_ptr<Key> Create(CipherSuite cipher_suite,
+                                     uint64_t key_id,
+                                     rtc::ArrayView<const uint8_t> base_key,
+                                     bool encrypt) {
+    const EVP_MD* hash = Hash(cipher_suite);
+    const EVP_CIPHER* cipher = Cipher(cipher_suite);
+    rtc::ZeroOnFreeBuffer<uint8_t> secret = HkdfExtract(hash, base_key);
+    uint8_t context[8 + 2];
+    WriteBigEndian(key_id, 8, context);
+    WriteBigEndian(static_cast<uint16_t>(cipher_suite), 2, &context[8]);
+    rtc::ZeroOnFreeBuffer<uint8_t> key = HkdfExpand(
+        hash, secret, kKeyLabel, context, EVP_CIPHER_key_length(cipher));
+    rtc::ZeroOnFreeBuffer<uint8_t> salt =
+        HkdfExpand(hash, secret, kSaltLabel, context, kNonceSize);
+    if (secret.empty() || key.empty() || salt.empty()) {
+      return nullptr;
+    }
+
+    std::unique_ptr<EVP_CIPHER_CTX, CipherContextDeleter> cipher_context(
+        EVP_CIPHER_CTX_new());
+    if (!cipher_context) {
+      return nullptr;
+    }
+    const int result =
+        encrypt ? EVP_EncryptInit_ex(cipher_context.get(), cipher, nullptr,
+                                     key.data(), nullptr)
+                : EVP_DecryptInit_ex(cipher_context.get(), cipher, nullptr,
+                                     key.data(), nullptr);
+    if (result != 1) {
+      return nullptr;
+    }
+    return absl::WrapUnique(new Key(
+        rtc::ZeroOnFreeBuffer<uint8_t>(base_key.data(), base_key.size()),
+        std::move(salt), std::move(cipher_context)));
+  }
+
+  const rtc::ZeroOnFreeBuffer<uint8_t>& base_key() const { return base_key_; }
+
+  // Encrypts `data` in place, and writes the authentication tag to `tag`.
+  bool Seal(uint64_t counter,
+            rtc::ArrayView<const uint8_t> aad,
+            rtc::ArrayView<uint8_t> data,
+            uint8_t* tag) {
+    uint8_t nonce[kNonceSize];
+    Nonce(counter, nonce);
+    int size = 0;
+    if (EVP_EncryptInit_ex(context_.get(), nullptr, nullptr, nullptr, nonce) !=
+            1 ||
+        EVP_EncryptUpdate(context_.get(), nullptr, &size, aad.data(),
+                          static_cast<int>(aad.size())) != 1) {
+      return false;
+    }
+    if (!data.empty() &&
+        EVP_EncryptUpdate(context_.get(), data.data(), &size, data.data(),
+                          static_cast<int>(data.size())) != 1) {
+      return false;
+    }
+    // GCM doesn't buffer any data, so nothing is written by the final call.
+    uint8_t unused[16];
+    return EVP_EncryptFinal_ex(context_.get(), unused, &size) == 1 &&
+           EVP_CIPHER_CTX_ctrl(context_.get(), EVP_CTRL_GCM_GET_TAG, kTagSize,
+                               tag) == 1;
+  }
+
+  // Decrypts `data` in place, and verifies it and `aad` against `tag`.
+  bool Open(uint64_t counter,
+            rtc::ArrayView<const uint8_t> aad,
+            rtc::ArrayView<uint8_t> data,
+            const uint8_t* tag) {
+    uint8_t nonce[kNonceSize];
+    Nonce(counter, nonce);
+    uint8_t expected_tag[kTagSize];
+    std::memcpy(expected_tag, tag, kTagSize);
+    int size = 0;
+    if (EVP_DecryptInit_ex(context_.get(), nullptr, nullptr, nullptr, nonce) !=
+            1 ||
+        EVP_DecryptUpdate(context_.get(), nullptr, &size, aad.data(),
+                          static_cast<int>(aad.size())) != 1) {
+      return false;
+    }
+    if (!data.empty() &&
+        EVP_DecryptUpdate(context_.get(), data.data(), &size, data.data(),
+                          static_cast<int>(data.size())) != 1) {
+      return false;
+    }
+    uint8_t unused[16];
+    return EVP_CIPHER_CTX_ctrl(context_.get(), EVP_CTRL_GCM_SET_TAG, kTagSize,
+                               expected_tag) == 1 &&
+           EVP_DecryptFinal_ex(context_.get(), unused, &size) == 1;
+  }
+
+ private:
+  Key(rtc::ZeroOnFreeBuffer<uint8_t> base_key,
+      rtc::ZeroOnFreeBuffer<uint8_t> salt,
+      std::unique_ptr<EVP_CIPHER_CTX, CipherContextDeleter> context)
+      : base_key_(std::move(base_key)),
+        salt_(std::move(salt)),
+        context_(std::move(context)) {}
+
+  // The nonce is the salt xor:ed with the counter.
+  void Nonce(uint64_t counter, uint8_t* nonce) const {
+    std::memset(nonce, 0, kNonceSize);
+    WriteBigEndian(counter, 8, &nonce[kNonceSize - 8]);
+    for (size_t i = 0; i < kNonceSize; ++i) {
+      nonce[i] ^= salt_[i];
+    }
+  }
+
+  const rtc::ZeroOnFreeBuffer<uint8_t> base_key_;
+  const rtc::ZeroOnFreeBuffer<uint8_t> salt_;
+  const std::unique_ptr<EVP_CIPHER_CTX, CipherContextDeleter> context_;
+};
+
+SframeTransformer::SframeTransformer(CipherSuite cipher_suite)
+    : cipher_suite_(cipher_suite) {}
+
+SframeTransformer::~SframeTransformer() = default;
+
+rtc::ZeroOnFreeBuffer<uint8_t> SframeTransformer::RatchetKey(
+    CipherSuite cipher_suite,
+    rtc::ArrayView<const uint8_t> base_key) {
+  const EVP_MD* hash = Hash(cipher_suite);
+  return HkdfExpand(hash, HkdfExtract(hash, base_key), kRatchetLabel,
+                    /*context=*/{}, EVP_MD_size(hash));
+}
+
+bool SframeTransformer::SetEncryptionKey(
+    uint64_t key_id,
+    rtc::ArrayView<const uint8_t> base_key) {
+  std::unique_ptr<Key> key =
+      Key::Create(cipher_suite_, key_id, base_key, /*encrypt=*/true);
+  if (!key) {
+    RTC_LOG(LS_ERROR) << "Failed to set SFrame encryption key " << key_id;
+    return false;
+  }
+  MutexLock lock(&mutex_);
+  if (encryption_key_) {
+    next_counters_[encryption_key_id_] = counter_;
+  }
+  auto it = next_counters_.find(key_id);
+  counter_ = it != next_counters_.end() ? it->second : 0;
+  encryption_key_ = std::move(key);
+  encryption_key_id_ = key_id;
+  return true;
+}
+
+bool SframeTransformer::RatchetEncryptionKey(uint64_t key_id) {
+  rtc::ZeroOnFreeBuffer<uint8_t> base_key;
+  {
+    MutexLock lock(&mutex_);
+    if (!encryption_key_) {
+      return false;
+    }
+    base_key = RatchetKey(cipher_suite_, encryption_key_->base_key());
+  }
+  return SetEncryptionKey(key_id, base_key);
+}
+
+bool SframeTransformer::AddDecryptionKey(
+    uint64_t key_id,
+    rtc::ArrayView<const uint8_t> base_key) {
+  std::unique_ptr<Key> key =
+      Key::Create(cipher_suite_, key_id, base_key, /*encrypt=*/false);
+  if (!key) {
+    RTC_LOG(LS_ERROR) << "Failed to add SFrame decryption key " << key_id;
+    return false;
+  }
+  MutexLock lock(&mutex_);
+  decryption_keys_[key_id] = std::move(key);
+  return true;
+}
+
+bool SframeTransformer::RatchetDecryptionKey(uint64_t key_id,
+                                             uint64_t new_key_id) {
+  rtc::ZeroOnFreeBuffer<uint8_t> base_key;
+  {
+    MutexLock lock(&mutex_);
+    auto it = decryption_keys_.find(key_id);
+    if (it == decryption_keys_.end()) {
+      return false;
+    }
+    base_key = RatchetKey(cipher_suite_, it->second->base_key());
+  }
+  return AddDecryptionKey(new_key_id, base_key);
+}
+
+void SframeTransformer::RemoveDecryptionKey(uint64_t key_id) {
+  MutexLock lock(&mutex_);
+  decryption_keys_.erase(key_id);
+}
+
+void SframeTransformer::Transform(
+    std::unique_ptr<TransformableFrameInterface> frame) {
+  const bool transformed =
+      frame->GetDirection() == TransformableFrameInterface::Direction::kReceiver
+          ? Decrypt(*frame)
+          : Encrypt(*frame);
+  if (!transformed) {
+    return;
+  }
+  rtc::scoped_refptr<TransformedFrameCallback> callback;
+  {
+    MutexLock lock(&callbacks_mutex_);
+    auto it = sink_callbacks_.find(frame->GetSsrc());
+    callback = it != sink_callbacks_.end() ? it->second : callback_;
+  }
+  if (callback) {
+    callback->OnTransformedFrame(std::move(frame));
+  }
+}
+
+bool SframeTransformer::Encrypt(TransformableFrameInterface& frame) {
+  MutexLock lock(&mutex_);
+  if (!encryption_key_) {
+    return false;
+  }
+  if (counter_ == std::numeric_limits<uint64_t>::max()) {
+    // Wrapping around would reuse nonces; a new key id is needed.
+    RTC_LOG(LS_ERROR) << "SFrame counter exhausted for key "
+                      << encryption_key_id_;
+    return false;
+  }
+  uint8_t header[kMaxHeaderSize];
+  const size_t header_size = WriteHeader(encryption_key_id_, counter_, header);
+  const size_t payload_size = frame.GetData().size();
+  const size_t size = header_size + payload_size + kTagSize;
+
+  // The payload is moved to make room for the header, and encrypted in place.
+  rtc::Buffer buffer;
+  rtc::ArrayView<uint8_t> data = frame.GetMutableData(size);
+  if (data.empty()) {
+    buffer.SetSize(size);
+    std::memcpy(&buffer[header_size], frame.GetData().data(), payload_size);
+    data = buffer;
+  } else {
+    std::memmove(&data[header_size], data.data(), payload_size);
+  }
+  std::memcpy(data.data(), header, header_size);
+  if (!encryption_key_->Seal(counter_, data.subview(0, header_size),
+                             data.subview(header_size, payload_size),
+                             &data[header_size + payload_size])) {
+    RTC_LOG(LS_ERROR) << "Failed to encrypt SFrame";
+    return false;
+  }
+  ++counter_;
+  if (!buffer.empty()) {
+    frame.SetData(buffer);
+  }
+  return true;
+}
+
+bool SframeTransformer::Decrypt(TransformableFrameInterface& frame) {
+  uint64_t key_id = 0;
+  uint64_t counter = 0;
+  const size_t size = frame.GetData().size();
+  const size_t header_size = ParseHeader(frame.GetData(), key_id, counter);
+  if (header_size == 0 || size < header_size + kTagSize) {
+    RTC_LOG(LS_WARNING) << "Dropping frame without SFrame header";
+    return false;
+  }
+  const size_t payload_size = size - header_size - kTagSize;
+
+  MutexLock lock(&mutex_);
+  auto it = decryption_keys_.find(key_id);
+  if (it == decryption_keys_.end()) {
+    RTC_LOG(LS_WARNING) << "Dropping SFrame with unknown key " << key_id;
+    return false;
+  }
+  // The payload is decrypted in place, and then moved to the start of the
+  // frame, over the header.
+  rtc::Buffer buffer;
+  rtc::ArrayView<uint8_t> data = frame.GetMutableData(size);
+  if (data.empty()) {
+    buffer.SetData(frame.GetData());
+    data = buffer;
+  }
+  if (!it->second->Open(counter, data.subview(0, header_size),
+                        data.subview(header_size, payload_size),
+                        &data[header_size + payload_size])) {
+    RTC_LOG(LS_WARNING) << "Dropping SFrame which failed to decrypt";
+    return false;
+  }
+  std::memmove(data.data(), &data[header_size], payload_size);
+  if (buffer.empty()) {
+    frame.GetMutableData(payload_size);
+  } else {
+    frame.SetData(data.subview(0, payload_size));
+  }
+  return true;
+}
+
+void SframeTransformer::RegisterTransformedFrameCallback(
+    rtc::scoped_refptr<TransformedFrameCallback> callback) {
+  MutexLock lock(&callbacks_mutex_);
+  callback_ = std::move(callback);
+}
+
+void SframeTransformer::RegisterTransformedFrameSinkCallback(
+    rtc::scoped_refptr<TransformedFrameCallback> callback,
+    uint32_t ssrc) {
+  MutexLock lock(&callbacks_mutex_);
+  sink_callbacks_[ssrc] = std::move(callback);
+}
+
+void SframeTransformer::UnregisterTransformedFrameCallback() {
+  MutexLock lock(&callbacks_mutex_);
+  callback_ = nullptr;
+}
+
+void SframeTransformer::UnregisterTransformedFrameSinkCallback(uint32_t ssrc) {
+  MutexLock lock(&callbacks_mutex_);
+  sink_callbacks_.erase(ssrc);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,113 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_CRYPTO_SFRAME_TRANSFORMER_H_
+#define API_CRYPTO_SFRAME_TRANSFORMER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+
+#include "api/array_view.h"
+#include "api/frame_transformer_interface.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Frame transformer which encrypts sent frames and decrypts received frames
+// with SFrame, as specified in RFC 9605, using the AES-GCM cipher suites.
+// Each frame is encrypted as a whole, with the SFrame header and
+// authentication tag added around it, and is modified in place when the frame
+// supports TransformableFrameInterface::GetMutableData(). Frames which fail
+// to encrypt or decrypt, e.g. because there is no key for them, are dropped.
+//
+// The same transformer may be set on any number of senders and receivers.
+// Keys are identified by a key id (KID), which is sent in the SFrame header;
+// how key ids and base keys are assigned and distributed is up to the
+// application. All methods are thread safe.
+class RTC_EXPORT SframeTransformer : public FrameTransformerInterface {
+ public:
+  enum class CipherSuite : uint16_t {
+    kAes128GcmSha256 = 0x0004,
+    kAes256GcmSha512 = 0x0005,
+  };
+
+  explicit SframeTransformer(CipherSuite cipher_suite);
+
+  // Derives the base key which follows `base_key` in the SFrame key ratchet.
+  static rtc::ZeroOnFreeBuffer<uint8_t> RatchetKey(
+      CipherSuite cipher_suite,
+      rtc::ArrayView<const uint8_t> base_key);
+
+  // Sets the key sent frames are encrypted with. Returns false if the key
+  // can't be used. The counter of encrypted frames is kept per key id, and
+  // continues where it left off if `key_id` was used before, so that setting
+  // the same key again doesn't reuse nonces.
+  bool SetEncryptionKey(uint64_t key_id,
+                        rtc::ArrayView<const uint8_t> base_key);
+  // Replaces the encryption key with the next key of the ratchet, identified
+  // by `key_id`. Returns false if there is no encryption key.
+  bool RatchetEncryptionKey(uint64_t key_id);
+
+  // Adds or replaces a key received frames are decrypted with.
+  bool AddDecryptionKey(uint64_t key_id,
+                        rtc::ArrayView<const uint8_t> base_key);
+  // Replaces the decryption key `key_id` with the next key of the ratchet,
+  // identified by `new_key_id`. The key `key_id` is kept until it is removed,
+  // for frames which were encrypted with it before the sender ratcheted.
+  bool RatchetDecryptionKey(uint64_t key_id, uint64_t new_key_id);
+  void RemoveDecryptionKey(uint64_t key_id);
+
+  // Implements FrameTransformerInterface.
+  void Transform(std::unique_ptr<TransformableFrameInterface> frame) override;
+  void RegisterTransformedFrameCallback(
+      rtc::scoped_refptr<TransformedFrameCallback> callback) override;
+  void RegisterTransformedFrameSinkCallback(
+      rtc::scoped_refptr<TransformedFrameCallback> callback,
+      uint32_t ssrc) override;
+  void UnregisterTransformedFrameCallback() override;
+  void UnregisterTransformedFrameSinkCallback(uint32_t ssrc) override;
+
+ protected:
+  ~SframeTransformer() override;
+
+ private:
+  class Key;
+
+  bool Encrypt(TransformableFrameInterface& frame);
+  bool Decrypt(TransformableFrameInterface& frame);
+
+  const CipherSuite cipher_suite_;
+
+  Mutex mutex_;
+  std::unique_ptr<Key> encryption_key_ RTC_GUARDED_BY(mutex_);
+  uint64_t encryption_key_id_ RTC_GUARDED_BY(mutex_) = 0;
+  uint64_t counter_ RTC_GUARDED_BY(mutex_) = 0;
+  // The next counter of key ids which were used before the current one.
+  std::map<uint64_t, uint64_t> next_counters_ RTC_GUARDED_BY(mutex_);
+  std::map<uint64_t, std::unique_ptr<Key>> decryption_keys_
+      RTC_GUARDED_BY(mutex_);
+
+  Mutex callbacks_mutex_;
+  rtc::scoped_refptr<TransformedFrameCallback> callback_
+      RTC_GUARDED_BY(callbacks_mutex_);
+  std::map<uint32_t, rtc::scoped_refptr<TransformedFrameCallback>>
+      sink_callbacks_ RTC_GUARDED_BY(callbacks_mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // API_CRYPTO_SFRAME_TRANSFORMER_H_
@@ -0,0 +1,356 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/crypto/sframe_transformer.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "api/make_ref_counted.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+using CipherSuite = SframeTransformer::CipherSuite;
+using Direction = TransformableFrameInterface::Direction;
+
+constexpr uint32_t kSsrc = 1111;
+const std::vector<uint8_t> kBaseKey = {1, 2, 3, 4, 5, 6, 7, 8,
+                                       9, 10, 11, 12, 13, 14, 15, 16};
+const std::vector<uint8_t> kPayload = {10, 20, 30, 40, 50, 60, 70, 80};
+
+class FakeFrame : public TransformableFrameInterface {
+ public:
+  FakeFrame(Direction direction,
+            std::vector<uint8_t> data,
+            bool supports_mutable_data = true)
+      : direction_(direction),
+        data_(std::move(data)),
+        supports_mutable_data_(supports_mutable_data) {}
+
+  rtc::ArrayView<const uint8_t> GetData() const override { return data_; }
+  void SetData(rtc::ArrayView<const uint8_t> data) override {
+    data_.assign(data.begin(), data.end());
+    ++set_data_calls_;
+  }
+  rtc::ArrayView<uint8_t> GetMutableData(size_t size) override {
+    if (!supports_mutable_data_) {
+      return {};
+    }
+    data_.resize(size);
+    return data_;
+  }
+  uint8_t GetPayloadType() const override { return 0; }
+  uint32_t GetSsrc() const override { return kSsrc; }
+  uint32_t GetTimestamp() const override { return 0; }
+  void SetRTPTimestamp(uint32_t timestamp) override {}
+  Direction GetDirection() const override { return direction_; }
+  std::string GetMimeType() const override { return "video/VP8"; }
+
+  void set_direction(Direction direction) { direction_ = direction; }
+  int set_data_calls() const { return set_data_calls_; }
+
+ private:
+  Direction direction_;
+  std::vector<uint8_t> data_;
+  const bool supports_mutable_data_;
+  int set_data_calls_ = 0;
+};
+
+class FrameCollector : public TransformedFrameCallback {
+ public:
+  void OnTransformedFrame(
+      std::unique_ptr<TransformableFrameInterface> frame) override {
+    frames_.emplace_back(static_cast<FakeFrame*>(frame.release()));
+  }
+
+  // Returns the oldest transformed frame.
+  std::unique_ptr<FakeFrame> TakeFrame() {
+    std::unique_ptr<FakeFrame> frame = std::move(frames_.front());
+    frames_.erase(frames_.begin());
+    return frame;
+  }
+
+  const std::vector<std::unique_ptr<FakeFrame>>& frames() const {
+    return frames_;
+  }
+
+ private:
+  std::vector<std::unique_ptr<FakeFrame>> frames_;
+};
+
+class SframeTransformerTest : public ::testing::TestWithParam<CipherSuite> {
+ protected:
+  SframeTransformerTest()
+      : sender_(rtc::make_ref_counted<SframeTransformer>(GetParam())),
+        receiver_(rtc::make_ref_counted<SframeTransformer>(GetParam())),
+        sent_(rtc::make_ref_counted<FrameCollector>()),
+        received_(rtc::make_ref_counted<FrameCollector>()) {
+    sender_->RegisterTransformedFrameCallback(sent_);
+    receiver_->RegisterTransformedFrameSinkCallback(received_, kSsrc);
+  }
+
+  // Encrypts `payload`, and returns the encrypted frame turned into a
+  // received frame.
+  std::unique_ptr<FakeFrame> Encrypt(const std::vector<uint8_t>& payload,
+                                     bool supports_mutable_data = true) {
+    sender_->Transform(std::make_unique<FakeFrame>(
+        Direction::kSender, payload, supports_mutable_data));
+    if (sent_->frames().empty()) {
+      return nullptr;
+    }
+    std::unique_ptr<FakeFrame> frame = sent_->TakeFrame();
+    frame->set_direction(Direction::kReceiver);
+    return frame;
+  }
+
+  rtc::scoped_refptr<SframeTransformer> sender_;
+  rtc::scoped_refptr<SframeTransformer> receiver_;
+  rtc::scoped_refptr<FrameCollector> sent_;
+  rtc::scoped_refptr<FrameCollector> received_;
+};
+
+TEST_P(SframeTransformerTest, DecryptsEncryptedFrame) {
+  ASSERT_TRUE(sender_->SetEncryptionKey(3, kBaseKey));
+  ASSERT_TRUE(receiver_->AddDecryptionKey(3, kBaseKey));
+
+  std::unique_ptr<FakeFrame> frame = Encrypt(kPayload);
+  ASSERT_TRUE(frame);
+  // A one byte header, since both the key id and the counter are small, and
+  // a 16 byte authentication tag.
+  EXPECT_THAT(frame->GetData(), SizeIs(1 + kPayload.size() + 16));
+  EXPECT_EQ(frame->GetData()[0], 0x30);
+  EXPECT_EQ(frame->set_data_calls(), 0);
+
+  receiver_->Transform(std::move(frame));
+  ASSERT_THAT(received_->frames(), SizeIs(1));
+  EXPECT_THAT(received_->frames()[0]->GetData(), ElementsAreArray(kPayload));
+  EXPECT_EQ(received_->frames()[0]->set_data_calls(), 0);
+}
+
+TEST_P(SframeTransformerTest, DecryptsFramesWithLargeKeyIdAndCounter) {
+  constexpr uint64_t kKeyId = 0x123456;
+  ASSERT_TRUE(sender_->SetEncryptionKey(kKeyId, kBaseKey));
+  ASSERT_TRUE(receiver_->AddDecryptionKey(kKeyId, kBaseKey));
+
+  for (int i = 0; i < 300; ++i) {
+    std::unique_ptr<FakeFrame> frame = Encrypt(kPayload);
+    ASSERT_TRUE(frame);
+    receiver_->Transform(std::move(frame));
+  }
+  ASSERT_THAT(received_->frames(), SizeIs(300));
+  for (const auto& frame : received_->frames()) {
+    EXPECT_THAT(frame->GetData(), ElementsAreArray(kPayload));
+  }
+}
+
+TEST_P(SframeTransformerTest, DecryptsEmptyFrame) {
+  ASSERT_TRUE(sender_->SetEncryptionKey(1, kBaseKey));
+  ASSERT_TRUE(receiver_->AddDecryptionKey(1, kBaseKey));
+
+  receiver_->Transform(Encrypt({}));
+  ASSERT_THAT(received_->frames(), SizeIs(1));
+  EXPECT_THAT(received_->frames()[0]->GetData(), IsEmpty());
+}
+
+TEST_P(SframeTransformerTest, TransformsFramesWithoutMutableData) {
+  ASSERT_TRUE(sender_->SetEncryptionKey(1, kBaseKey));
+  ASSERT_TRUE(receiver_->AddDecryptionKey(1, kBaseKey));
+
+  std::unique_ptr<FakeFrame> frame =
+      Encrypt(kPayload, /*supports_mutable_data=*/false);
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(frame->set_data_calls(), 1);
+  receiver_->Transform(std::make_unique<FakeFrame>(
+      Direction::kReceiver,
+      std::vector<uint8_t>(frame->GetData().begin(), frame->GetData().end()),
+      /*supports_mutable_data=*/false));
+  ASSERT_THAT(received_->frames(), SizeIs(1));
+  EXPECT_THAT(received_->frames()[0]->GetData(), ElementsAreArray(kPayload));
+  EXPECT_EQ(received_->frames()[0]->set_data_calls(), 1);
+}
+
+TEST_P(SframeTransformerTest, DropsFramesWithoutEncryptionKey) {
+  EXPECT_FALSE(Encrypt(kPayload));
+}
+
+TEST_P(SframeTransformerTest, DropsFramesWithUnknownKey) {
+  ASSERT_TRUE(sender_->SetEncryptionKey(1, kBaseKey));
+  ASSERT_TRUE(receiver_->AddDecryptionKey(2, kBaseKey));
+
+  receiver_->Transform(Encrypt(kPayload));
+  EXPECT_THAT(received_->frames(), IsEmpty());
+}
+
+TEST_P(SframeTransformerTest, DropsFramesWithWrongKey) {
+  std::vector<uint8_t> other_key = kBaseKey;
+  other_key[0] ^= 1;
+  ASSERT_TRUE(sender_->SetEncryptionKey(1, kBaseKey));
+  ASSERT_TRUE(receiver_->AddDecryptionKey(1, other_key));
+
+  receiver_->Transform(Encrypt(kPayload));
+  EXPECT_THAT(received_->frames(), IsEmpty());
+}
+
+TEST_P(SframeTransformerTest, DropsTamperedFrames) {
+  ASSERT_TRUE(sender_->SetEncryptionKey(1, kBaseKey));
+  ASSERT_TRUE(receiver_->AddDecryptionKey(1, kBaseKey));
+
+  std::unique_ptr<FakeFrame> frame = Encrypt(kPayload);
+  ASSERT_TRUE(frame);
+  std::vector<uint8_t> data(frame->GetData().begin(), frame->GetData().end());
+  data[3] ^= 1;
+  frame->SetData(data);
+  receiver_->Transform(std::move(frame));
+
+  // The header is authenticated as well.
+  frame = Encrypt(kPayload);
+  ASSERT_TRUE(frame);
+  data.assign(frame->GetData().begin(), frame->GetData().end());
+  data[0] ^= 1;
+  frame->SetData(data);
+  receiver_->Transform(std::move(frame));
+
+  // Frames too short to hold the header and the tag.
+  receiver_->Transform(
+      std::make_unique<FakeFrame>(Direction::kReceiver, kPayload));
+  receiver_->Transform(std::make_unique<FakeFrame>(Direction::kReceiver,
+                                                   std::vector<uint8_t>()));
+  EXPECT_THAT(received_->frames(), IsEmpty());
+}
+
+TEST_P(SframeTransformerTest, DecryptsFramesAfterRatchet) {
+  ASSERT_TRUE(sender_->SetEncryptionKey(1, kBaseKey));
+  ASSERT_TRUE(receiver_->AddDecryptionKey(1, kBaseKey));
+  std::unique_ptr<FakeFrame> old_frame = Encrypt(kPayload);
+
+  ASSERT_TRUE(sender_->RatchetEncryptionKey(2));
+  ASSERT_TRUE(receiver_->RatchetDecryptionKey(1, 2));
+  receiver_->Transform(Encrypt(kPayload));
+  // Frames encrypted with the old key are still decrypted.
+  receiver_->Transform(std::move(old_frame));
+  ASSERT_THAT(received_->frames(), SizeIs(2));
+
+  receiver_->RemoveDecryptionKey(1);
+  sender_->SetEncryptionKey(1, kBaseKey);
+  receiver_->Transform(Encrypt(kPayload));
+  EXPECT_THAT(received_->frames(), SizeIs(2));
+}
+
+TEST_P(SframeTransformerTest, SettingUsedKeyAgainContinuesCounter) {
+  ASSERT_TRUE(sender_->SetEncryptionKey(1, kBaseKey));
+  std::unique_ptr<FakeFrame> first = Encrypt(kPayload);
+  ASSERT_TRUE(sender_->SetEncryptionKey(2, kBaseKey));
+  std::unique_ptr<FakeFrame> other_key = Encrypt(kPayload);
+  ASSERT_TRUE(sender_->SetEncryptionKey(1, kBaseKey));
+  std::unique_ptr<FakeFrame> second = Encrypt(kPayload);
+  ASSERT_TRUE(first && other_key && second);
+
+  // The header is the key id in the upper nibble and the counter in the lower
+  // one.
+  EXPECT_EQ(first->GetData()[0], 0x10);
+  EXPECT_EQ(other_key->GetData()[0], 0x20);
+  EXPECT_EQ(second->GetData()[0], 0x11);
+  EXPECT_NE(rtc::ArrayView<const uint8_t>(first->GetData()).subview(1),
+            rtc::ArrayView<const uint8_t>(second->GetData()).subview(1));
+
+  ASSERT_TRUE(receiver_->AddDecryptionKey(1, kBaseKey));
+  receiver_->Transform(std::move(first));
+  receiver_->Transform(std::move(second));
+  EXPECT_THAT(received_->frames(), SizeIs(2));
+}
+
+TEST_P(SframeTransformerTest, RatchetedKeyDiffers) {
+  rtc::ZeroOnFreeBuffer<uint8_t> next_key =
+      SframeTransformer::RatchetKey(GetParam(), kBaseKey);
+  EXPECT_FALSE(next_key.empty());
+  EXPECT_NE(rtc::ZeroOnFreeBuffer<uint8_t>(kBaseKey.data(), kBaseKey.size()),
+            next_key);
+  EXPECT_EQ(SframeTransformer::RatchetKey(GetParam(), kBaseKey), next_key);
+
+  ASSERT_TRUE(sender_->SetEncryptionKey(1, next_key));
+  ASSERT_TRUE(receiver_->AddDecryptionKey(1, kBaseKey));
+  receiver_->Transform(Encrypt(kPayload));
+  EXPECT_THAT(received_->frames(), IsEmpty());
+}
+
+TEST_P(SframeTransformerTest, ForwardsFramesToCallbackWithoutSink) {
+  auto other = rtc::make_ref_counted<FrameCollector>();
+  ASSERT_TRUE(receiver_->AddDecryptionKey(1, kBaseKey));
+  ASSERT_TRUE(sender_->SetEncryptionKey(1, kBaseKey));
+  receiver_->UnregisterTransformedFrameSinkCallback(kSsrc);
+  receiver_->RegisterTransformedFrameCallback(other);
+
+  receiver_->Transform(Encrypt(kPayload));
+  EXPECT_THAT(received_->frames(), IsEmpty());
+  EXPECT_THAT(other->frames(), SizeIs(1));
+}
+
+INSTANTIATE_TEST_SUITE_P(All,
+                         SframeTransformerTest,
+                         ::testing::Values(CipherSuite::kAes128GcmSha256,
+                                           CipherSuite::kAes256GcmSha512));
+
+// Uses the base key and key id of the SFrame encryption test vectors in
+// RFC 9605 Appendix C.4, which derive the following key and salt:
+//   AES_128_GCM_SHA256_128: key d34f547f4ca4f9a7447006fe7fcbf768
+//                           salt 75234edefe07819026751816
+//   AES_256_GCM_SHA512_128: key d3e27b0d4a5ae9e55df01a70e6d4d28d
+//                               969b246e2936f4b7a5d9b494da6b9633
+//                           salt 84991c167b8cd23c93708ec7
+// The transformer doesn't take metadata, and starts at counter 0, so the
+// expected frames are the RFC plaintext sealed with that key and salt, with
+// counter 0 and the header as the only AAD.
+TEST(SframeTransformerRfc9605Test, EncryptsWithKeysDerivedAsInTestVectors) {
+  const std::vector<uint8_t> kRfcBaseKey = {
+      0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+      0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+  constexpr uint64_t kRfcKeyId = 0x123;
+  const std::string kRfcPlaintext = "draft-ietf-sframe-enc";
+  const struct {
+    CipherSuite cipher_suite;
+    std::vector<uint8_t> expected;
+  } kTestVectors[] = {
+      {CipherSuite::kAes128GcmSha256,
+       {0x90, 0x01, 0x23, 0xed, 0x9c, 0x73, 0x0a, 0xf0, 0x88, 0xd8, 0x1e,
+        0x18, 0x8b, 0x03, 0xcf, 0x65, 0x28, 0xd1, 0x12, 0xba, 0x60, 0x14,
+        0xb4, 0x14, 0x8f, 0xdc, 0x67, 0xf9, 0x54, 0x69, 0xbc, 0xb3, 0x1e,
+        0x13, 0xa5, 0xe0, 0x7a, 0x2c, 0xad, 0x3f}},
+      {CipherSuite::kAes256GcmSha512,
+       {0x90, 0x01, 0x23, 0x04, 0x92, 0x8e, 0x39, 0xea, 0x79, 0xa4, 0x52,
+        0x1b, 0x75, 0xdf, 0xd1, 0xc2, 0x1c, 0x33, 0x55, 0x15, 0xa2, 0x6f,
+        0xe3, 0x85, 0xe7, 0x2b, 0xf6, 0xa8, 0x76, 0x21, 0x13, 0x0a, 0xc6,
+        0xa2, 0xaf, 0x82, 0x2b, 0xd8, 0x33, 0x5d}},
+  };
+  for (const auto& test : kTestVectors) {
+    auto transformer =
+        rtc::make_ref_counted<SframeTransformer>(test.cipher_suite);
+    auto collector = rtc::make_ref_counted<FrameCollector>();
+    transformer->RegisterTransformedFrameCallback(collector);
+    ASSERT_TRUE(transformer->SetEncryptionKey(kRfcKeyId, kRfcBaseKey));
+
+    transformer->Transform(std::make_unique<FakeFrame>(
+        Direction::kSender,
+        std::vector<uint8_t>(kRfcPlaintext.begin(), kRfcPlaintext.end())));
+    ASSERT_THAT(collector->frames(), SizeIs(1));
+    EXPECT_THAT(collector->frames()[0]->GetData(),
+                ElementsAreArray(test.expected));
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -33,6 +33,14 @@ class TransformableFrameInterface {
   // Copies `data` into the owned frame payload data.
   virtual void SetData(rtc::ArrayView<const uint8_t> data) = 0;
 
+  // Resizes the owned frame payload data to `size` bytes and returns it for
+  // modification in place, which saves the copy made by SetData(), e.g. for
+  // transforms which encrypt or decrypt the payload. The data is kept up to
+  // `size` bytes, and bytes added at the end are uninitialized. The data is
+  // valid until the next non-const method call. Frames which don't support
+  // this return an empty view, in which case SetData() must be used.
+  virtual rtc::ArrayView<uint8_t> GetMutableData(size_t size) { return {}; }
+
   virtual uint8_t GetPayloadType() const = 0;
   virtual uint32_t GetSsrc() const = 0;
   virtual uint32_t GetTimestamp() const = 0;
@@ -216,6 +216,19 @@ class NetEq {
       int* current_sample_rate_hz = nullptr,
       absl::optional<Operation> action_override = absl::nullopt) = 0;
 
+  // Advances the playout by 10 ms like GetAudio(), but without decoding, for
+  // streams whose output isn't used, e.g. while they aren't mixed. A muted
+  // frame is written to `audio_frame`. The packets that would have been
+  // played out are discarded, while the delay estimates keep being updated
+  // from the inserted packets, so that the next call to GetAudio() resumes
+  // decoding from the packets buffered for the current playout time. The
+  // default implementation decodes.
+  // Returns kOK on success, or kFail in case of an error.
+  virtual int SkipAudio(AudioFrame* audio_frame) {
+    bool muted;
+    return GetAudio(audio_frame, &muted);
+  }
+
   // Replaces the current set of decoders with the given one.
   virtual void SetCodecs(const std::map<int, SdpAudioFormat>& codecs) = 0;
 
@@ -79,6 +79,13 @@ class RTC_EXPORT RTCStats {
   bool operator==(const RTCStats& other) const;
   bool operator!=(const RTCStats& other) const;
 
+  // Returns a copy of this stats object in which only the members whose values
+  // differ from those of `previous`, the same stats object in an earlier
+  // report, are defined. Returns null if no member differs. Members that have
+  // become undefined since `previous` can't be told apart from unchanged ones.
+  // Unchanged members of types other than `RTCStatsMember<T>` stay defined.
+  std::unique_ptr<RTCStats> CopyChangedMembers(const RTCStats& previous) const;
+
   // Creates a JSON readable string representation of the stats
   // object, listing all of its members (names and values).
   std::string ToJson() const;
@@ -264,9 +271,14 @@ class RTCStatsMemberInterface {
   }
 
  protected:
+  friend class RTCStats;
+
   explicit RTCStatsMemberInterface(const char* name) : name_(name) {}
 
   virtual bool IsEqual(const RTCStatsMemberInterface& other) const = 0;
+  // Makes the value undefined. Implementations that don't override this keep
+  // their value, which RTCStats::CopyChangedMembers() then reports as changed.
+  virtual void Reset() {}
 
   const char* const name_;
 };
@@ -342,6 +354,7 @@ class RTCStatsMember : public RTCStatsMemberInterface {
         static_cast<const RTCStatsMember<T>&>(other);
     return value_ == other_t.value_;
   }
+  void Reset() override { value_.reset(); }
 
  private:
   absl::optional<T> value_;
@@ -20,6 +20,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/strings/string_view.h"
 #include "api/ref_counted_base.h"
 #include "api/scoped_refptr.h"
 #include "api/stats/rtc_stats.h"
@@ -36,7 +37,10 @@ namespace webrtc {
 class RTC_EXPORT RTCStatsReport final
     : public rtc::RefCountedNonVirtual<RTCStatsReport> {
  public:
-  typedef std::map<std::string, std::unique_ptr<const RTCStats>> StatsMap;
+  // The keys refer to the IDs of the stats objects they map to, which saves
+  // copying each ID when stats are added.
+  typedef std::map<absl::string_view, std::unique_ptr<const RTCStats>>
+      StatsMap;
 
   class RTC_EXPORT ConstIterator {
    public:
@@ -74,14 +78,13 @@ class RTC_EXPORT RTCStatsReport final
   template <typename T>
   T* TryAddStats(std::unique_ptr<T> stats) {
     T* stats_ptr = stats.get();
-    if (!stats_
-             .insert(std::make_pair(std::string(stats->id()), std::move(stats)))
-             .second) {
+    absl::string_view id = stats->id();
+    if (!stats_.insert(std::make_pair(id, std::move(stats))).second) {
       return nullptr;
     }
     return stats_ptr;
   }
-  const RTCStats* Get(const std::string& id) const;
+  const RTCStats* Get(absl::string_view id) const;
   size_t size() const { return stats_.size(); }
 
   // Gets the stat object of type `T` by ID, where `T` is any class descending
@@ -89,7 +92,7 @@ class RTC_EXPORT RTCStatsReport final
   // Returns null if there is no stats object for the given ID or it is the
   // wrong type.
   template <typename T>
-  const T* GetAs(const std::string& id) const {
+  const T* GetAs(absl::string_view id) const {
     const RTCStats* stats = Get(id);
     if (!stats || stats->type() != T::kType) {
       return nullptr;
@@ -99,7 +102,7 @@ class RTC_EXPORT RTCStatsReport final
 
   // Removes the stats object from the report, returning ownership of it or null
   // if there is no object with `id`.
-  std::unique_ptr<const RTCStats> Take(const std::string& id);
+  std::unique_ptr<const RTCStats> Take(absl::string_view id);
   // Takes ownership of all the stats in `other`, leaving it empty.
   void TakeMembersFrom(rtc::scoped_refptr<RTCStatsReport> other);
 
@@ -119,6 +122,17 @@ class RTC_EXPORT RTCStatsReport final
     return stats_of_type;
   }
 
+  // Returns a report with the stats of this report that are new or have
+  // changed since `previous`, an earlier report of the same PeerConnection, for
+  // sending only what changed between frequent polls. New stats are copied in
+  // full, while only the changed members of the others are defined, see
+  // `RTCStats::CopyChangedMembers`. Stats that are unchanged, or only in
+  // `previous`, are left out. If `types` isn't empty, only stats of the listed
+  // types, e.g. `RTCOutboundRtpStreamStats::kType`, are included.
+  rtc::scoped_refptr<RTCStatsReport> CreateDelta(
+      const RTCStatsReport& previous,
+      const std::vector<std::string>& types = {}) const;
+
   // Creates a JSON readable string representation of the report,
   // listing all of its stats objects.
   std::string ToJson() const;
@@ -112,7 +112,11 @@ bool FrameBuffer::InsertFrame(std::unique_ptr<EncodedFrame> frame) {
   }
 
   PropagateContinuity(insert_res.first);
-  FindNextAndLastDecodableTemporalUnit();
+  if (decodable_temporal_unit_scan_.last_frame_id < frame_id) {
+    ContinueFindingDecodableTemporalUnits();
+  } else {
+    FindNextAndLastDecodableTemporalUnit();
+  }
   return true;
 }
 
@@ -191,6 +195,12 @@ bool FrameBuffer::IsContinuous(const FrameIterator& it) const {
 }
 
 void FrameBuffer::PropagateContinuity(const FrameIterator& frame_it) {
+  // Only frames depending on `frame_it` can become continuous, and none of
+  // them will unless it is.
+  if (!IsContinuous(frame_it)) {
+    return;
+  }
+
   for (auto it = frame_it; it != frames_.end(); ++it) {
     if (!it->second.continuous) {
       if (IsContinuous(it)) {
@@ -212,36 +222,44 @@ void FrameBuffer::PropagateContinuity(const FrameIterator& frame_it) {
 void FrameBuffer::FindNextAndLastDecodableTemporalUnit() {
   next_decodable_temporal_unit_.reset();
   decodable_temporal_units_info_.reset();
+  decodable_temporal_unit_scan_ = {};
+  ContinueFindingDecodableTemporalUnits();
+}
 
+void FrameBuffer::ContinueFindingDecodableTemporalUnits() {
   if (!last_continuous_temporal_unit_frame_id_) {
     return;
   }
 
-  FrameIterator first_frame_it = frames_.begin();
-  FrameIterator last_frame_it = frames_.begin();
-  absl::InlinedVector<int64_t, 4> frames_in_temporal_unit;
-  uint32_t last_decodable_temporal_unit_timestamp;
-  for (auto frame_it = frames_.begin(); frame_it != frames_.end();) {
+  DecodableTemporalUnitScan& scan = decodable_temporal_unit_scan_;
+  auto frame_it = scan.last_frame_id ? frames_.upper_bound(*scan.last_frame_id)
+                                     : frames_.begin();
+  while (frame_it != frames_.end()) {
     if (GetFrameId(frame_it) > *last_continuous_temporal_unit_frame_id_) {
       break;
     }
 
-    if (GetTimestamp(frame_it) != GetTimestamp(first_frame_it)) {
-      frames_in_temporal_unit.clear();
-      first_frame_it = frame_it;
+    if (!scan.temporal_unit_first_frame ||
+        GetTimestamp(frame_it) !=
+            GetTimestamp(*scan.temporal_unit_first_frame)) {
+      scan.frames_in_temporal_unit.clear();
+      scan.temporal_unit_first_frame = frame_it;
     }
 
-    frames_in_temporal_unit.push_back(GetFrameId(frame_it));
+    scan.frames_in_temporal_unit.push_back(GetFrameId(frame_it));
+    scan.last_frame_id = GetFrameId(frame_it);
 
-    last_frame_it = frame_it++;
+    FrameIterator last_frame_it = frame_it++;
 
     if (IsLastFrameInTemporalUnit(last_frame_it)) {
+      FrameIterator first_frame_it = *scan.temporal_unit_first_frame;
       bool temporal_unit_decodable = true;
       for (auto it = first_frame_it; it != frame_it && temporal_unit_decodable;
            ++it) {
         for (int64_t reference : GetReferences(it)) {
           if (!decoded_frame_history_.WasDecoded(reference) &&
-              !absl::c_linear_search(frames_in_temporal_unit, reference)) {
+              !absl::c_linear_search(scan.frames_in_temporal_unit,
+                                     reference)) {
             // A frame in the temporal unit has a non-decoded reference outside
             // the temporal unit, so it's not yet ready to be decoded.
             temporal_unit_decodable = false;
@@ -255,7 +273,8 @@ void FrameBuffer::FindNextAndLastDecodableTemporalUnit() {
           next_decodable_temporal_unit_ = {first_frame_it, last_frame_it};
         }
 
-        last_decodable_temporal_unit_timestamp = GetTimestamp(first_frame_it);
+        scan.last_decodable_temporal_unit_timestamp =
+            GetTimestamp(first_frame_it);
       }
     }
   }
@@ -264,7 +283,7 @@ void FrameBuffer::FindNextAndLastDecodableTemporalUnit() {
     decodable_temporal_units_info_ = {
         .next_rtp_timestamp =
             GetTimestamp(next_decodable_temporal_unit_->first_frame),
-        .last_rtp_timestamp = last_decodable_temporal_unit_timestamp};
+        .last_rtp_timestamp = scan.last_decodable_temporal_unit_timestamp};
   }
 }
 
@@ -272,6 +291,7 @@ void FrameBuffer::Clear() {
   frames_.clear();
   next_decodable_temporal_unit_.reset();
   decodable_temporal_units_info_.reset();
+  decodable_temporal_unit_scan_ = {};
   last_continuous_frame_id_.reset();
   last_continuous_temporal_unit_frame_id_.reset();
   decoded_frame_history_.Clear();
@@ -83,9 +83,20 @@ class FrameBuffer {
     FrameIterator last_frame;
   };
 
+  // Where the search for decodable temporal units stopped. Frames inserted
+  // after `last_frame_id` can't change the decodability of the temporal units
+  // before them, so the search continues from there.
+  struct DecodableTemporalUnitScan {
+    absl::optional<int64_t> last_frame_id;
+    absl::optional<FrameIterator> temporal_unit_first_frame;
+    absl::InlinedVector<int64_t, 4> frames_in_temporal_unit;
+    uint32_t last_decodable_temporal_unit_timestamp = 0;
+  };
+
   bool IsContinuous(const FrameIterator& it) const;
   void PropagateContinuity(const FrameIterator& frame_it);
   void FindNextAndLastDecodableTemporalUnit();
+  void ContinueFindingDecodableTemporalUnits();
   void Clear();
 
   const bool legacy_frame_id_jump_behavior_;
@@ -93,6 +104,7 @@ class FrameBuffer {
   FrameMap frames_;
   absl::optional<TemporalUnit> next_decodable_temporal_unit_;
   absl::optional<DecodabilityInfo> decodable_temporal_units_info_;
+  DecodableTemporalUnitScan decodable_temporal_unit_scan_;
   absl::optional<int64_t> last_continuous_frame_id_;
   absl::optional<int64_t> last_continuous_temporal_unit_frame_id_;
   video_coding::DecodedFramesHistory decoded_frame_history_;
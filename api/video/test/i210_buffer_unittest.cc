@@ -123,4 +123,28 @@ TEST(I210BufferTest, ToI420) {
   EXPECT_EQ(width, i420_buffer->width());
 }
 
+TEST(I210BufferTest, CropAndScaleKeepsTenBits) {
+  rtc::scoped_refptr<I210Buffer> i210_buffer(I210Buffer::Create(8, 8));
+  // Y = 4, U = 8, V = 16.
+  FillI210Buffer(i210_buffer);
+
+  rtc::scoped_refptr<VideoFrameBuffer> scaled =
+      i210_buffer->CropAndScale(2, 2, 6, 6, 3, 3);
+  ASSERT_EQ(scaled->type(), VideoFrameBuffer::Type::kI210);
+  const I210BufferInterface* i210 = scaled->GetI210();
+  EXPECT_EQ(3, i210->width());
+  EXPECT_EQ(3, i210->height());
+  for (int row = 0; row < i210->height(); row++) {
+    for (int col = 0; col < i210->width(); col++) {
+      EXPECT_EQ(4, i210->DataY()[row * i210->StrideY() + col]);
+    }
+  }
+  for (int row = 0; row < i210->ChromaHeight(); row++) {
+    for (int col = 0; col < i210->ChromaWidth(); col++) {
+      EXPECT_EQ(8, i210->DataU()[row * i210->StrideU() + col]);
+      EXPECT_EQ(16, i210->DataV()[row * i210->StrideV() + col]);
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -117,4 +117,23 @@ TEST(I410BufferTest, ToI420) {
   EXPECT_TRUE(test::FrameBufsEqual(reference, i420_buffer));
 }
 
+TEST(I410BufferTest, CropAndScaleKeepsTenBits) {
+  rtc::scoped_refptr<I410Buffer> i410_buffer(I410Buffer::Create(8, 8));
+  FillI410Buffer(i410_buffer);
+
+  rtc::scoped_refptr<VideoFrameBuffer> scaled =
+      i410_buffer->CropAndScale(2, 2, 6, 6, 3, 3);
+  ASSERT_EQ(scaled->type(), VideoFrameBuffer::Type::kI410);
+  const I410BufferInterface* i410 = scaled->GetI410();
+  EXPECT_EQ(3, i410->width());
+  EXPECT_EQ(3, i410->height());
+  for (int row = 0; row < i410->height(); row++) {
+    for (int col = 0; col < i410->width(); col++) {
+      EXPECT_EQ(kYValue, i410->DataY()[row * i410->StrideY() + col]);
+      EXPECT_EQ(kUValue, i410->DataU()[row * i410->StrideU() + col]);
+      EXPECT_EQ(kVValue, i410->DataV()[row * i410->StrideV() + col]);
+    }
+  }
+}
+
 }  // namespace webrtc
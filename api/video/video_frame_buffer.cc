@@ -10,6 +10,9 @@
 
 #include "api/video/video_frame_buffer.h"
 
+#include "api/video/i010_buffer.h"
+#include "api/video/i210_buffer.h"
+#include "api/video/i410_buffer.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/i422_buffer.h"
 #include "api/video/i444_buffer.h"
@@ -190,6 +193,19 @@ int I010BufferInterface::ChromaHeight() const {
   return (height() + 1) / 2;
 }
 
+rtc::scoped_refptr<VideoFrameBuffer> I010BufferInterface::CropAndScale(
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  rtc::scoped_refptr<I010Buffer> result =
+      I010Buffer::Create(scaled_width, scaled_height);
+  result->CropAndScaleFrom(*this, offset_x, offset_y, crop_width, crop_height);
+  return result;
+}
+
 VideoFrameBuffer::Type I210BufferInterface::type() const {
   return Type::kI210;
 }
@@ -202,6 +218,19 @@ int I210BufferInterface::ChromaHeight() const {
   return height();
 }
 
+rtc::scoped_refptr<VideoFrameBuffer> I210BufferInterface::CropAndScale(
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  rtc::scoped_refptr<I210Buffer> result =
+      I210Buffer::Create(scaled_width, scaled_height);
+  result->CropAndScaleFrom(*this, offset_x, offset_y, crop_width, crop_height);
+  return result;
+}
+
 VideoFrameBuffer::Type I410BufferInterface::type() const {
   return Type::kI410;
 }
@@ -214,6 +243,19 @@ int I410BufferInterface::ChromaHeight() const {
   return height();
 }
 
+rtc::scoped_refptr<VideoFrameBuffer> I410BufferInterface::CropAndScale(
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  rtc::scoped_refptr<I410Buffer> result =
+      I410Buffer::Create(scaled_width, scaled_height);
+  result->CropAndScaleFrom(*this, offset_x, offset_y, crop_width, crop_height);
+  return result;
+}
+
 VideoFrameBuffer::Type NV12BufferInterface::type() const {
   return Type::kNV12;
 }
@@ -247,6 +247,13 @@ class I010BufferInterface : public PlanarYuv16BBuffer {
   int ChromaWidth() const final;
   int ChromaHeight() const final;
 
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) override;
+
  protected:
   ~I010BufferInterface() override {}
 };
@@ -260,6 +267,13 @@ class I210BufferInterface : public PlanarYuv16BBuffer {
   int ChromaWidth() const final;
   int ChromaHeight() const final;
 
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) override;
+
  protected:
   ~I210BufferInterface() override {}
 };
@@ -273,6 +287,13 @@ class I410BufferInterface : public PlanarYuv16BBuffer {
   int ChromaWidth() const final;
   int ChromaHeight() const final;
 
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) override;
+
  protected:
   ~I410BufferInterface() override {}
 };
@@ -53,6 +53,19 @@ struct VideoStreamEncoderSettings {
   // Negotiated capabilities which the VideoEncoder may expect the other
   // side to use.
   VideoEncoder::Capabilities capabilities;
+
+  // If positive, native frames which the encoder can't encode directly are
+  // converted to one of its preferred pixel formats on a separate task queue,
+  // so that converting a frame overlaps encoding the previous one. At most
+  // this many frames are converted or wait to be converted at a time, further
+  // frames are dropped.
+  int max_preprocessed_frames_in_flight = 0;
+
+  // Enables a cheap comparison of each frame with the previous one on the
+  // encoder queue. A key frame is requested when the scene changes, at most
+  // once per second, and static content is encoded at a reduced frame rate,
+  // which is restored with the first frame that changes.
+  bool enable_content_analysis = false;
 };
 
 }  // namespace webrtc
@@ -319,6 +319,18 @@ class RTC_EXPORT VideoEncoder {
     bool loss_notification;
   };
 
+  // Trade-off between compression efficiency and encode latency of encoders
+  // which encode a frame on several threads.
+  enum class ParallelismPolicy {
+    // The encoder chooses the number of threads from the resolution, leaving
+    // cores for other streams.
+    kDefault,
+    // The encoder splits each frame into as many tiles or slices as the
+    // resolution and `number_of_cores` allow, and encodes them in parallel, at
+    // some cost in compression efficiency.
+    kLowLatency,
+  };
+
   struct Settings {
     Settings(const Capabilities& capabilities,
              int number_of_cores,
@@ -333,6 +345,9 @@ class RTC_EXPORT VideoEncoder {
     // Experimental API - currently only supported by LibvpxVp8Encoder and
     // the OpenH264 encoder. If set, limits the number of encoder threads.
     absl::optional<int> encoder_thread_limit;
+    // Experimental API - currently only supported by LibaomAv1Encoder and
+    // the OpenH264 encoder.
+    ParallelismPolicy parallelism_policy = ParallelismPolicy::kDefault;
   };
 
   static VideoCodecVP8 GetDefaultVp8Settings();
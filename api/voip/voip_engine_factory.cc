@@ -31,7 +31,8 @@ std::unique_ptr<VoipEngine> CreateVoipEngine(VoipEngineConfig config) {
                                     std::move(config.decoder_factory),
                                     std::move(config.task_queue_factory),
                                     std::move(config.audio_device_module),
-                                    std::move(config.audio_processing));
+                                    std::move(config.audio_processing),
+                                    config.num_shared_encoder_queues);
 }
 
 }  // namespace webrtc
@@ -58,6 +58,13 @@ struct VoipEngineConfig {
   // such functionalities to perform on audio input samples received from
   // AudioDeviceModule.
   rtc::scoped_refptr<AudioProcessing> audio_processing;
+
+  // Optional.
+  // Number of encoder task queues shared by all channels. By default each
+  // channel encodes on a task queue of its own. Applications handling many
+  // channels, such as media servers, can set this e.g. to the number of CPU
+  // cores to bound the number of encoder threads.
+  int num_shared_encoder_queues = 0;
 };
 
 // Creates a VoipEngine instance with provided VoipEngineConfig.
@@ -11,7 +11,6 @@
 #include "audio/audio_level.h"
 
 #include "api/audio/audio_frame.h"
-#include "common_audio/signal_processing/include/signal_processing_library.h"
 
 namespace webrtc {
 namespace voe {
@@ -54,12 +53,7 @@ double AudioLevel::TotalDuration() const {
 
 void AudioLevel::ComputeLevel(const AudioFrame& audioFrame, double duration) {
   // Check speech level (works for 2 channels as well)
-  int16_t abs_value =
-      audioFrame.muted()
-          ? 0
-          : WebRtcSpl_MaxAbsValueW16(
-                audioFrame.data(),
-                audioFrame.samples_per_channel_ * audioFrame.num_channels_);
+  int16_t abs_value = audioFrame.sample_stats().max_abs;
 
   // Protect member access using a lock since this method is called on a
   // dedicated audio thread in the RecordedDataIsAvailable() callback.
@@ -781,8 +781,10 @@ void ChannelSend::ProcessAndEncodeAudio(
           if (is_muted && previous_frame_muted_) {
             rms_level_.AnalyzeMuted(length);
           } else {
-            rms_level_.Analyze(
-                rtc::ArrayView<const int16_t>(audio_frame->data(), length));
+            // Usually reuses the sample statistics already computed for the
+            // audio level of the send stream.
+            rms_level_.AnalyzeSumSquare(
+                length, audio_frame->sample_stats().sum_square);
           }
         }
         previous_frame_muted_ = is_muted;
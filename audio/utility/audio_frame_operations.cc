@@ -10,6 +10,14 @@
 
 #include "audio/utility/audio_frame_operations.h"
 
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 #include <string.h>
 
 #include <algorithm>
@@ -285,8 +293,38 @@ int AudioFrameOperations::ScaleWithSat(float scale, AudioFrame* frame) {
   }
 
   int16_t* frame_data = frame->mutable_data();
-  for (size_t i = 0; i < frame->samples_per_channel_ * frame->num_channels_;
-       i++) {
+  const size_t length = frame->samples_per_channel_ * frame->num_channels_;
+  size_t i = 0;
+  // Like rtc::saturated_cast<int16_t>(), the products are truncated towards
+  // zero and saturated.
+#if defined(WEBRTC_HAS_NEON)
+  for (; i + 4 <= length; i += 4) {
+    const float32x4_t product =
+        vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(frame_data + i))), scale);
+    vst1_s16(frame_data + i, vqmovn_s32(vcvtq_s32_f32(product)));
+  }
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  const __m128 m_scale = _mm_set1_ps(scale);
+  // Clamping before the conversion avoids out of range int32 results.
+  const __m128 m_min = _mm_set1_ps(-32768.f);
+  const __m128 m_max = _mm_set1_ps(32767.f);
+  for (; i + 8 <= length; i += 8) {
+    __m128i* data = reinterpret_cast<__m128i*>(frame_data + i);
+    const __m128i samples = _mm_loadu_si128(data);
+    // Sign extends to 32 bits.
+    const __m128i low =
+        _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+    const __m128i high =
+        _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+    const __m128 low_product = _mm_max_ps(
+        _mm_min_ps(_mm_mul_ps(_mm_cvtepi32_ps(low), m_scale), m_max), m_min);
+    const __m128 high_product = _mm_max_ps(
+        _mm_min_ps(_mm_mul_ps(_mm_cvtepi32_ps(high), m_scale), m_max), m_min);
+    _mm_storeu_si128(data, _mm_packs_epi32(_mm_cvttps_epi32(low_product),
+                                           _mm_cvttps_epi32(high_product)));
+  }
+#endif
+  for (; i < length; i++) {
     frame_data[i] = rtc::saturated_cast<int16_t>(scale * frame_data[i]);
   }
   return 0;
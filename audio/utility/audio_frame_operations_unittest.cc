@@ -11,6 +11,7 @@
 #include "audio/utility/audio_frame_operations.h"
 
 #include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -562,6 +563,28 @@ TEST_F(AudioFrameOperationsTest, ScaleWithSatSucceeds) {
   VerifyFramesAreEqual(scaled_frame, frame_);
 }
 
+TEST_F(AudioFrameOperationsTest, ScaleWithSatTruncatesAndSaturates) {
+  // An odd number of samples, to also cover the samples after the last full
+  // vector.
+  frame_.num_channels_ = 1;
+  frame_.samples_per_channel_ = 101;
+  int16_t* frame_data = frame_.mutable_data();
+  for (size_t i = 0; i < frame_.samples_per_channel_; ++i) {
+    frame_data[i] = static_cast<int16_t>(i * 655 - 32768);
+  }
+  AudioFrame expected_frame;
+  expected_frame.CopyFrom(frame_);
+
+  for (float scale : {0.5f, -1.7f, 3.3f, 1e6f}) {
+    int16_t* expected_data = expected_frame.mutable_data();
+    for (size_t i = 0; i < expected_frame.samples_per_channel_; ++i) {
+      expected_data[i] = rtc::saturated_cast<int16_t>(scale * expected_data[i]);
+    }
+    EXPECT_EQ(0, AudioFrameOperations::ScaleWithSat(scale, &frame_));
+    VerifyFramesAreEqual(expected_frame, frame_);
+  }
+}
+
 TEST_F(AudioFrameOperationsTest, ScaleWithSatMuted) {
   ASSERT_TRUE(frame_.muted());
   EXPECT_EQ(0, AudioFrameOperations::ScaleWithSat(2.0, &frame_));
@@ -10,12 +10,65 @@
 
 #include "audio/utility/channel_mixer.h"
 
+#include <algorithm>
+
 #include "audio/utility/channel_mixing_matrix.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
-#include "rtc_base/numerics/safe_conversions.h"
 
 namespace webrtc {
+namespace {
+
+// Same as rtc::saturated_cast<int16_t>() for the finite sums of the mixer, but
+// without branches, so that it doesn't keep the loops from being vectorized.
+int16_t SaturateToInt16(float value) {
+  return static_cast<int16_t>(std::min(std::max(value, -32768.f), 32767.f));
+}
+
+// Gives the weighted sums of the `kInputChannels` samples of
+// `samples_per_channel` frames, with the known number of input channels
+// letting the compiler unroll and vectorize the inner loop.
+template <size_t kInputChannels>
+void MixFrames(const float* matrix,
+               size_t output_channels,
+               size_t samples_per_channel,
+               const int16_t* in_audio,
+               int16_t* out_audio) {
+  for (size_t i = 0; i < samples_per_channel; ++i) {
+    const int16_t* const in_frame = &in_audio[i * kInputChannels];
+    int16_t* const out_frame = &out_audio[i * output_channels];
+    for (size_t output_ch = 0; output_ch < output_channels; ++output_ch) {
+      const float* const scales = &matrix[output_ch * kInputChannels];
+      float acc_value = 0.0f;
+      for (size_t input_ch = 0; input_ch < kInputChannels; ++input_ch) {
+        acc_value += scales[input_ch] * in_frame[input_ch];
+      }
+      out_frame[output_ch] = SaturateToInt16(acc_value);
+    }
+  }
+}
+
+void MixFrames(const float* matrix,
+               size_t input_channels,
+               size_t output_channels,
+               size_t samples_per_channel,
+               const int16_t* in_audio,
+               int16_t* out_audio) {
+  for (size_t i = 0; i < samples_per_channel; ++i) {
+    const int16_t* const in_frame = &in_audio[i * input_channels];
+    int16_t* const out_frame = &out_audio[i * output_channels];
+    for (size_t output_ch = 0; output_ch < output_channels; ++output_ch) {
+      const float* const scales = &matrix[output_ch * input_channels];
+      float acc_value = 0.0f;
+      for (size_t input_ch = 0; input_ch < input_channels; ++input_ch) {
+        acc_value += scales[input_ch] * in_frame[input_ch];
+      }
+      out_frame[output_ch] = SaturateToInt16(acc_value);
+    }
+  }
+}
+
+}  // namespace
 
 ChannelMixer::ChannelMixer(ChannelLayout input_layout,
                            ChannelLayout output_layout)
@@ -27,6 +80,15 @@ ChannelMixer::ChannelMixer(ChannelLayout input_layout,
   ChannelMixingMatrix matrix_builder(input_layout_, input_channels_,
                                      output_layout_, output_channels_);
   remapping_ = matrix_builder.CreateTransformationMatrix(&matrix_);
+  flat_matrix_.reserve(input_channels_ * output_channels_);
+  for (const std::vector<float>& row : matrix_) {
+    RTC_DCHECK_EQ(row.size(), input_channels_);
+    for (float scale : row) {
+      // Scale should always be positive.
+      RTC_DCHECK_GE(scale, 0);
+      flat_matrix_.push_back(scale);
+    }
+  }
 }
 
 ChannelMixer::~ChannelMixer() = default;
@@ -69,21 +131,31 @@ void ChannelMixer::Transform(AudioFrame* frame) {
 
   // Modify the number of channels by creating a weighted sum of input samples
   // where the weights (scale factors) for each output sample are given by the
-  // transformation matrix.
-  for (size_t i = 0; i < frame->samples_per_channel(); i++) {
-    for (size_t output_ch = 0; output_ch < output_channels_; ++output_ch) {
-      float acc_value = 0.0f;
-      for (size_t input_ch = 0; input_ch < input_channels_; ++input_ch) {
-        const float scale = matrix_[output_ch][input_ch];
-        // Scale should always be positive.
-        RTC_DCHECK_GE(scale, 0);
-        // Each output sample is a weighted sum of input samples.
-        acc_value += scale * in_audio[i * input_channels_ + input_ch];
-      }
-      const size_t index = output_channels_ * i + output_ch;
-      RTC_CHECK_LE(index, audio_vector_size_);
-      out_audio[index] = rtc::saturated_cast<int16_t>(acc_value);
-    }
+  // transformation matrix. The common layouts get loops specialized for their
+  // number of input channels.
+  RTC_CHECK_LE(num_elements, audio_vector_size_);
+  const float* const matrix = flat_matrix_.data();
+  const size_t samples_per_channel = frame->samples_per_channel();
+  switch (input_channels_) {
+    case 1:
+      MixFrames<1>(matrix, output_channels_, samples_per_channel, in_audio,
+                   out_audio);
+      break;
+    case 2:
+      MixFrames<2>(matrix, output_channels_, samples_per_channel, in_audio,
+                   out_audio);
+      break;
+    case 6:
+      MixFrames<6>(matrix, output_channels_, samples_per_channel, in_audio,
+                   out_audio);
+      break;
+    case 8:
+      MixFrames<8>(matrix, output_channels_, samples_per_channel, in_audio,
+                   out_audio);
+      break;
+    default:
+      MixFrames(matrix, input_channels_, output_channels_, samples_per_channel,
+                in_audio, out_audio);
   }
 
   // Update channel information.
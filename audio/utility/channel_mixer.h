@@ -66,6 +66,9 @@ class ChannelMixer {
   // 2D matrix of output channels to input channels.
   std::vector<std::vector<float> > matrix_;
 
+  // `matrix_` with the rows stored back to back.
+  std::vector<float> flat_matrix_;
+
   // 1D array used as temporary storage during the transformation.
   std::unique_ptr<int16_t[]> audio_vector_;
 
@@ -32,7 +32,8 @@ AudioChannel::AudioChannel(
     uint32_t local_ssrc,
     TaskQueueFactory* task_queue_factory,
     AudioMixer* audio_mixer,
-    rtc::scoped_refptr<AudioDecoderFactory> decoder_factory)
+    rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
+    TaskQueueBase* encoder_queue)
     : audio_mixer_(audio_mixer) {
   RTC_DCHECK(task_queue_factory);
   RTC_DCHECK(audio_mixer);
@@ -56,8 +57,13 @@ AudioChannel::AudioChannel(
   ingress_ = std::make_unique<AudioIngress>(rtp_rtcp_.get(), clock,
                                             receive_statistics_.get(),
                                             std::move(decoder_factory));
-  egress_ =
-      std::make_unique<AudioEgress>(rtp_rtcp_.get(), clock, task_queue_factory);
+  if (encoder_queue) {
+    egress_ =
+        std::make_unique<AudioEgress>(rtp_rtcp_.get(), clock, encoder_queue);
+  } else {
+    egress_ = std::make_unique<AudioEgress>(rtp_rtcp_.get(), clock,
+                                            task_queue_factory);
+  }
 
   // Set the instance of audio ingress to be part of audio mixer for ADM to
   // fetch audio samples to play.
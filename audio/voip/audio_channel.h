@@ -16,6 +16,7 @@
 #include <queue>
 #include <utility>
 
+#include "api/task_queue/task_queue_base.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "api/voip/voip_base.h"
 #include "api/voip/voip_statistics.h"
@@ -31,11 +32,14 @@ namespace webrtc {
 // these two classes as it has both sending and receiving capabilities.
 class AudioChannel : public rtc::RefCountInterface {
  public:
+  // When `encoder_queue` is set, the channel encodes on it rather than on a
+  // task queue of its own created with `task_queue_factory`.
   AudioChannel(Transport* transport,
                uint32_t local_ssrc,
                TaskQueueFactory* task_queue_factory,
                AudioMixer* audio_mixer,
-               rtc::scoped_refptr<AudioDecoderFactory> decoder_factory);
+               rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
+               TaskQueueBase* encoder_queue = nullptr);
   ~AudioChannel() override;
 
   // Set and get ChannelId that this audio channel belongs for debugging and
@@ -13,6 +13,7 @@
 #include <utility>
 #include <vector>
 
+#include "rtc_base/event.h"
 #include "rtc_base/logging.h"
 
 namespace webrtc {
@@ -20,16 +21,42 @@ namespace webrtc {
 AudioEgress::AudioEgress(RtpRtcpInterface* rtp_rtcp,
                          Clock* clock,
                          TaskQueueFactory* task_queue_factory)
-    : rtp_rtcp_(rtp_rtcp),
+    : AudioEgress(rtp_rtcp,
+                  clock,
+                  /*encoder_queue=*/nullptr,
+                  task_queue_factory->CreateTaskQueue(
+                      "AudioEncoder",
+                      TaskQueueFactory::Priority::NORMAL)) {}
+
+AudioEgress::AudioEgress(RtpRtcpInterface* rtp_rtcp,
+                         Clock* clock,
+                         TaskQueueBase* encoder_queue)
+    : AudioEgress(rtp_rtcp, clock, encoder_queue, nullptr) {
+  RTC_DCHECK(encoder_queue);
+}
+
+AudioEgress::AudioEgress(
+    RtpRtcpInterface* rtp_rtcp,
+    Clock* clock,
+    TaskQueueBase* encoder_queue,
+    std::unique_ptr<TaskQueueBase, TaskQueueDeleter> owned_encoder_queue)
+    : encoder_queue_(encoder_queue ? encoder_queue : owned_encoder_queue.get()),
+      rtp_rtcp_(rtp_rtcp),
       rtp_sender_audio_(clock, rtp_rtcp_->RtpSender()),
       audio_coding_(AudioCodingModule::Create()),
-      encoder_queue_(task_queue_factory->CreateTaskQueue(
-          "AudioEncoder",
-          TaskQueueFactory::Priority::NORMAL)) {
+      owned_encoder_queue_(std::move(owned_encoder_queue)) {
   audio_coding_->RegisterTransportCallback(this);
 }
 
 AudioEgress::~AudioEgress() {
+  if (!owned_encoder_queue_) {
+    // Pending tasks on a shared encoder queue refer to this object and aren't
+    // dropped when it is destroyed, so wait for them.
+    RTC_DCHECK(!encoder_queue_->IsCurrent());
+    rtc::Event done;
+    encoder_queue_->PostTask([&done] { done.Set(); });
+    done.Wait(rtc::Event::kForever);
+  }
   audio_coding_->RegisterTransportCallback(nullptr);
 }
 
@@ -73,9 +100,9 @@ void AudioEgress::SendAudioData(std::unique_ptr<AudioFrame> audio_frame) {
   RTC_DCHECK_GT(audio_frame->samples_per_channel_, 0);
   RTC_DCHECK_LE(audio_frame->num_channels_, 8);
 
-  encoder_queue_.PostTask(
+  encoder_queue_->PostTask(
       [this, audio_frame = std::move(audio_frame)]() mutable {
-        RTC_DCHECK_RUN_ON(&encoder_queue_);
+        RTC_DCHECK_RUN_ON(encoder_queue_);
         if (!rtp_rtcp_->SendingMedia()) {
           return;
         }
@@ -112,7 +139,7 @@ int32_t AudioEgress::SendData(AudioFrameType frame_type,
                               uint32_t timestamp,
                               const uint8_t* payload_data,
                               size_t payload_size) {
-  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  RTC_DCHECK_RUN_ON(encoder_queue_);
 
   rtc::ArrayView<const uint8_t> payload(payload_data, payload_size);
 
@@ -175,8 +202,8 @@ bool AudioEgress::SendTelephoneEvent(int dtmf_event, int duration_ms) {
 }
 
 void AudioEgress::SetMute(bool mute) {
-  encoder_queue_.PostTask([this, mute] {
-    RTC_DCHECK_RUN_ON(&encoder_queue_);
+  encoder_queue_->PostTask([this, mute] {
+    RTC_DCHECK_RUN_ON(encoder_queue_);
     encoder_context_.mute_ = mute;
   });
 }
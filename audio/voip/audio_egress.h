@@ -16,6 +16,7 @@
 
 #include "api/audio_codecs/audio_format.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "audio/audio_level.h"
 #include "audio/utility/audio_frame_operations.h"
@@ -25,7 +26,6 @@
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
 #include "modules/rtp_rtcp/source/rtp_sender_audio.h"
 #include "rtc_base/synchronization/mutex.h"
-#include "rtc_base/task_queue.h"
 #include "rtc_base/time_utils.h"
 
 namespace webrtc {
@@ -38,7 +38,9 @@ namespace webrtc {
 //
 // TaskQueue is used to encode and send RTP asynchrounously as some OS platform
 // uses the same thread for both audio input and output sample deliveries which
-// can affect audio quality.
+// can affect audio quality. The TaskQueue is either owned by AudioEgress or
+// shared by the egresses of many channels, which keeps the number of encoder
+// threads bounded on servers that handle many channels.
 //
 // Note that this class is originally based on ChannelSend in
 // audio/channel_send.cc with non-audio related logic trimmed as aimed for
@@ -48,6 +50,11 @@ class AudioEgress : public AudioSender, public AudioPacketizationCallback {
   AudioEgress(RtpRtcpInterface* rtp_rtcp,
               Clock* clock,
               TaskQueueFactory* task_queue_factory);
+  // Encodes on `encoder_queue`, which must outlive AudioEgress. The destructor
+  // waits for the tasks that were posted to `encoder_queue` to run.
+  AudioEgress(RtpRtcpInterface* rtp_rtcp,
+              Clock* clock,
+              TaskQueueBase* encoder_queue);
   ~AudioEgress() override;
 
   // Set the encoder format and payload type for AudioCodingModule.
@@ -111,6 +118,12 @@ class AudioEgress : public AudioSender, public AudioPacketizationCallback {
                    size_t payload_size) override;
 
  private:
+  AudioEgress(RtpRtcpInterface* rtp_rtcp,
+              Clock* clock,
+              TaskQueueBase* encoder_queue,
+              std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
+                  owned_encoder_queue);
+
   void SetEncoderFormat(const SdpAudioFormat& encoder_format) {
     MutexLock lock(&lock_);
     encoder_format_ = encoder_format;
@@ -118,6 +131,8 @@ class AudioEgress : public AudioSender, public AudioPacketizationCallback {
 
   mutable Mutex lock_;
 
+  TaskQueueBase* const encoder_queue_;
+
   // Current encoder format selected by caller.
   absl::optional<SdpAudioFormat> encoder_format_ RTC_GUARDED_BY(lock_);
 
@@ -148,9 +163,9 @@ class AudioEgress : public AudioSender, public AudioPacketizationCallback {
 
   EncoderContext encoder_context_ RTC_GUARDED_BY(encoder_queue_);
 
-  // Defined last to ensure that there are no running tasks when the other
-  // members are destroyed.
-  rtc::TaskQueue encoder_queue_;
+  // Set when `encoder_queue_` is owned. Defined last to ensure that there are
+  // no running tasks when the other members are destroyed.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> owned_encoder_queue_;
 };
 
 }  // namespace webrtc
@@ -13,6 +13,8 @@
 #include "api/audio_codecs/builtin_audio_encoder_factory.h"
 #include "api/call/transport.h"
 #include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "modules/audio_mixer/sine_wave_generator.h"
@@ -322,5 +324,70 @@ TEST_F(AudioEgressTest, TestAudioInputLevelAndEnergyDuration) {
   EXPECT_DOUBLE_EQ(egress_->GetInputTotalDuration(), kExpectedDuration);
 }
 
+TEST_F(AudioEgressTest, EgressesShareEncoderQueue) {
+  constexpr int kExpected = 10;
+  constexpr uint32_t kOtherRemoteSsrc = 0xC0FFEE;
+  constexpr int kPcmuPayload = 0;
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> encoder_queue =
+      time_controller_.GetTaskQueueFactory()->CreateTaskQueue(
+          "AudioEncoder", TaskQueueFactory::Priority::NORMAL);
+  NiceMock<MockTransport> other_transport;
+  int rtp_count = 0;
+  int other_rtp_count = 0;
+  EXPECT_CALL(transport_, SendRtp)
+      .WillRepeatedly(Invoke([&](rtc::ArrayView<const uint8_t>, Unused) {
+        ++rtp_count;
+        return true;
+      }));
+  EXPECT_CALL(other_transport, SendRtp)
+      .WillRepeatedly(Invoke([&](rtc::ArrayView<const uint8_t>, Unused) {
+        ++other_rtp_count;
+        return true;
+      }));
+
+  auto create_egress = [&](ModuleRtpRtcpImpl2* rtp_rtcp) {
+    auto egress = std::make_unique<AudioEgress>(
+        rtp_rtcp, time_controller_.GetClock(), encoder_queue.get());
+    egress->SetEncoder(kPcmuPayload, kPcmuFormat,
+                       encoder_factory_->MakeAudioEncoder(
+                           kPcmuPayload, kPcmuFormat, absl::nullopt));
+    egress->StartSend();
+    rtp_rtcp->SetSendingStatus(true);
+    return egress;
+  };
+  std::unique_ptr<ModuleRtpRtcpImpl2> rtp_rtcp =
+      CreateRtpStack(time_controller_.GetClock(), &transport_, kRemoteSsrc);
+  std::unique_ptr<ModuleRtpRtcpImpl2> other_rtp_rtcp = CreateRtpStack(
+      time_controller_.GetClock(), &other_transport, kOtherRemoteSsrc);
+  std::unique_ptr<AudioEgress> egress = create_egress(rtp_rtcp.get());
+  std::unique_ptr<AudioEgress> other_egress =
+      create_egress(other_rtp_rtcp.get());
+
+  // Two 10 ms audio frames will result in rtp packet with ptime 20.
+  for (size_t i = 0; i < kExpected * 2; i++) {
+    egress->SendAudioData(GetAudioFrame(i));
+    other_egress->SendAudioData(GetAudioFrame(i));
+    time_controller_.AdvanceTime(TimeDelta::Millis(10));
+  }
+  EXPECT_EQ(rtp_count, kExpected);
+  EXPECT_EQ(other_rtp_count, kExpected);
+
+  // Destroying an egress with pending tasks leaves the shared queue working
+  // for the other one.
+  egress->SendAudioData(GetAudioFrame(kExpected * 2));
+  egress->StopSend();
+  egress = nullptr;
+  for (size_t i = kExpected * 2; i < kExpected * 2 + 2; i++) {
+    other_egress->SendAudioData(GetAudioFrame(i));
+    time_controller_.AdvanceTime(TimeDelta::Millis(10));
+  }
+  EXPECT_EQ(rtp_count, kExpected);
+  EXPECT_EQ(other_rtp_count, kExpected + 1);
+
+  other_egress->StopSend();
+  other_egress = nullptr;
+}
+
 }  // namespace
 }  // namespace webrtc
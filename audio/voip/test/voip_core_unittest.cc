@@ -10,6 +10,9 @@
 
 #include "audio/voip/voip_core.h"
 
+#include <memory>
+#include <vector>
+
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
 #include "api/audio_codecs/builtin_audio_encoder_factory.h"
 #include "api/task_queue/default_task_queue_factory.h"
@@ -189,5 +192,45 @@ TEST_F(VoipCoreTest, StopSendAndPlayoutWithoutStarting) {
   EXPECT_EQ(voip_core_->ReleaseChannel(channel), VoipResult::kOk);
 }
 
+TEST_F(VoipCoreTest, ManagesManyChannels) {
+  // Enough channels to use every channel table more than once.
+  constexpr int kNumChannels = 40;
+  std::vector<ChannelId> channels;
+  for (int i = 0; i < kNumChannels; ++i) {
+    channels.push_back(voip_core_->CreateChannel(&transport_, 0xdeadc0de + i));
+  }
+  for (ChannelId channel : channels) {
+    EXPECT_EQ(voip_core_->SetSendCodec(channel, kPcmuPayload, kPcmuFormat),
+              VoipResult::kOk);
+  }
+  for (ChannelId channel : channels) {
+    EXPECT_EQ(voip_core_->ReleaseChannel(channel), VoipResult::kOk);
+    EXPECT_EQ(voip_core_->SetSendCodec(channel, kPcmuPayload, kPcmuFormat),
+              VoipResult::kInvalidArgument);
+  }
+}
+
+TEST_F(VoipCoreTest, ChannelsShareEncoderQueues) {
+  voip_core_ = std::make_unique<VoipCore>(
+      CreateBuiltinAudioEncoderFactory(), CreateBuiltinAudioDecoderFactory(),
+      CreateDefaultTaskQueueFactory(), audio_device_,
+      rtc::make_ref_counted<NiceMock<test::MockAudioProcessing>>(),
+      /*num_shared_encoder_queues=*/2);
+
+  std::vector<ChannelId> channels;
+  for (int i = 0; i < 3; ++i) {
+    ChannelId channel = voip_core_->CreateChannel(&transport_, 0xdeadc0de + i);
+    EXPECT_EQ(voip_core_->SetSendCodec(channel, kPcmuPayload, kPcmuFormat),
+              VoipResult::kOk);
+    EXPECT_EQ(voip_core_->StartSend(channel), VoipResult::kOk);
+    EXPECT_EQ(voip_core_->SetInputMuted(channel, true), VoipResult::kOk);
+    channels.push_back(channel);
+  }
+  for (ChannelId channel : channels) {
+    EXPECT_EQ(voip_core_->StopSend(channel), VoipResult::kOk);
+    EXPECT_EQ(voip_core_->ReleaseChannel(channel), VoipResult::kOk);
+  }
+}
+
 }  // namespace
 }  // namespace webrtc
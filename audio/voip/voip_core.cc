@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
 #include <utility>
 
 #include "api/audio_codecs/audio_format.h"
@@ -41,7 +42,8 @@ VoipCore::VoipCore(rtc::scoped_refptr<AudioEncoderFactory> encoder_factory,
                    rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
                    std::unique_ptr<TaskQueueFactory> task_queue_factory,
                    rtc::scoped_refptr<AudioDeviceModule> audio_device_module,
-                   rtc::scoped_refptr<AudioProcessing> audio_processing) {
+                   rtc::scoped_refptr<AudioProcessing> audio_processing,
+                   int num_shared_encoder_queues) {
   encoder_factory_ = std::move(encoder_factory);
   decoder_factory_ = std::move(decoder_factory);
   task_queue_factory_ = std::move(task_queue_factory);
@@ -52,6 +54,12 @@ VoipCore::VoipCore(rtc::scoped_refptr<AudioEncoderFactory> encoder_factory,
   // AudioTransportImpl depends on audio mixer and audio processing instances.
   audio_transport_ = std::make_unique<AudioTransportImpl>(
       audio_mixer_.get(), audio_processing_.get(), nullptr);
+
+  for (int i = 0; i < num_shared_encoder_queues; ++i) {
+    encoder_queues_.push_back(task_queue_factory_->CreateTaskQueue(
+        "AudioEncoder" + std::to_string(i),
+        TaskQueueFactory::Priority::NORMAL));
+  }
 }
 
 bool VoipCore::InitializeIfNeeded() {
@@ -131,22 +139,33 @@ ChannelId VoipCore::CreateChannel(Transport* transport,
     local_ssrc = random.Rand<uint32_t>();
   }
 
-  rtc::scoped_refptr<AudioChannel> channel =
-      rtc::make_ref_counted<AudioChannel>(transport, local_ssrc.value(),
-                                          task_queue_factory_.get(),
-                                          audio_mixer_.get(), decoder_factory_);
-
   {
     MutexLock lock(&lock_);
 
     channel_id = static_cast<ChannelId>(next_channel_id_);
-    channels_[channel_id] = channel;
     next_channel_id_++;
     if (next_channel_id_ >= kMaxChannelId) {
       next_channel_id_ = 0;
     }
   }
 
+  TaskQueueBase* encoder_queue = nullptr;
+  if (!encoder_queues_.empty()) {
+    size_t index = static_cast<size_t>(channel_id) % encoder_queues_.size();
+    encoder_queue = encoder_queues_[index].get();
+  }
+
+  rtc::scoped_refptr<AudioChannel> channel =
+      rtc::make_ref_counted<AudioChannel>(
+          transport, local_ssrc.value(), task_queue_factory_.get(),
+          audio_mixer_.get(), decoder_factory_, encoder_queue);
+
+  {
+    ChannelShard& shard = GetShard(channel_id);
+    MutexLock lock(&shard.lock);
+    shard.channels[channel_id] = channel;
+  }
+
   // Set ChannelId in audio channel for logging/debugging purpose.
   channel->SetId(channel_id);
 
@@ -157,20 +176,19 @@ VoipResult VoipCore::ReleaseChannel(ChannelId channel_id) {
   // Destroy channel outside of the lock.
   rtc::scoped_refptr<AudioChannel> channel;
 
-  bool no_channels_after_release = false;
-
   {
-    MutexLock lock(&lock_);
+    ChannelShard& shard = GetShard(channel_id);
+    MutexLock lock(&shard.lock);
 
-    auto iter = channels_.find(channel_id);
-    if (iter != channels_.end()) {
+    auto iter = shard.channels.find(channel_id);
+    if (iter != shard.channels.end()) {
       channel = std::move(iter->second);
-      channels_.erase(iter);
+      shard.channels.erase(iter);
     }
-
-    no_channels_after_release = channels_.empty();
   }
 
+  bool no_channels_after_release = !HasChannels();
+
   VoipResult status_code = VoipResult::kOk;
   if (!channel) {
     RTC_LOG(LS_WARNING) << "Channel " << channel_id << " not found";
@@ -197,9 +215,10 @@ VoipResult VoipCore::ReleaseChannel(ChannelId channel_id) {
 rtc::scoped_refptr<AudioChannel> VoipCore::GetChannel(ChannelId channel_id) {
   rtc::scoped_refptr<AudioChannel> channel;
   {
-    MutexLock lock(&lock_);
-    auto iter = channels_.find(channel_id);
-    if (iter != channels_.end()) {
+    ChannelShard& shard = GetShard(channel_id);
+    MutexLock lock(&shard.lock);
+    auto iter = shard.channels.find(channel_id);
+    if (iter != shard.channels.end()) {
       channel = iter->second;
     }
   }
@@ -209,6 +228,16 @@ rtc::scoped_refptr<AudioChannel> VoipCore::GetChannel(ChannelId channel_id) {
   return channel;
 }
 
+bool VoipCore::HasChannels() {
+  for (ChannelShard& shard : channel_shards_) {
+    MutexLock lock(&shard.lock);
+    if (!shard.channels.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool VoipCore::UpdateAudioTransportWithSenders() {
   std::vector<AudioSender*> audio_senders;
 
@@ -217,12 +246,10 @@ bool VoipCore::UpdateAudioTransportWithSenders() {
   // transport.
   int max_sampling_rate = 8000;
   size_t max_num_channels = 1;
-  {
-    MutexLock lock(&lock_);
-    // Reserve to prevent run time vector re-allocation.
-    audio_senders.reserve(channels_.size());
-    for (auto kv : channels_) {
-      rtc::scoped_refptr<AudioChannel>& channel = kv.second;
+  for (ChannelShard& shard : channel_shards_) {
+    MutexLock lock(&shard.lock);
+    for (const auto& kv : shard.channels) {
+      const rtc::scoped_refptr<AudioChannel>& channel = kv.second;
       if (channel->IsSendingMedia()) {
         auto encoder_format = channel->GetEncoderFormat();
         if (!encoder_format) {
@@ -11,6 +11,7 @@
 #ifndef AUDIO_VOIP_VOIP_CORE_H_
 #define AUDIO_VOIP_VOIP_CORE_H_
 
+#include <array>
 #include <map>
 #include <memory>
 #include <queue>
@@ -20,6 +21,7 @@
 #include "api/audio_codecs/audio_decoder_factory.h"
 #include "api/audio_codecs/audio_encoder_factory.h"
 #include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "api/voip/voip_base.h"
 #include "api/voip/voip_codec.h"
@@ -44,6 +46,9 @@ namespace webrtc {
 //
 // This class receives required audio components from caller at construction and
 // owns the life cycle of them to orchestrate the proper destruction sequence.
+//
+// The AudioChannel objects are spread over several independently locked
+// tables, so that calls for different channels rarely contend.
 class VoipCore : public VoipEngine,
                  public VoipBase,
                  public VoipNetwork,
@@ -52,12 +57,15 @@ class VoipCore : public VoipEngine,
                  public VoipStatistics,
                  public VoipVolumeControl {
  public:
-  // Construct VoipCore with provided arguments.
+  // Construct VoipCore with provided arguments. When
+  // `num_shared_encoder_queues` is positive, channels are assigned round robin
+  // to that many encoder task queues instead of each creating its own.
   VoipCore(rtc::scoped_refptr<AudioEncoderFactory> encoder_factory,
            rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
            std::unique_ptr<TaskQueueFactory> task_queue_factory,
            rtc::scoped_refptr<AudioDeviceModule> audio_device_module,
-           rtc::scoped_refptr<AudioProcessing> audio_processing);
+           rtc::scoped_refptr<AudioProcessing> audio_processing,
+           int num_shared_encoder_queues = 0);
   ~VoipCore() override = default;
 
   // Implements VoipEngine interfaces.
@@ -125,10 +133,27 @@ class VoipCore : public VoipEngine,
   // mode. Therefore it would be better to delay the logic as late as possible.
   bool InitializeIfNeeded();
 
+  // Table holding the AudioChannel objects whose ChannelId maps to it.
+  struct ChannelShard {
+    Mutex lock;
+    std::unordered_map<ChannelId, rtc::scoped_refptr<AudioChannel>> channels
+        RTC_GUARDED_BY(lock);
+  };
+
+  static constexpr size_t kNumChannelShards = 16;
+
+  ChannelShard& GetShard(ChannelId channel_id) {
+    return channel_shards_[static_cast<size_t>(channel_id) %
+                           kNumChannelShards];
+  }
+
   // Fetches the corresponding AudioChannel assigned with given `channel`.
   // Returns nullptr if not found.
   rtc::scoped_refptr<AudioChannel> GetChannel(ChannelId channel_id);
 
+  // Returns true if any channel exists.
+  bool HasChannels();
+
   // Updates AudioTransportImpl with a new set of actively sending AudioSender
   // (AudioEgress). This needs to be invoked whenever StartSend/StopSend is
   // involved by caller. Returns false when the selected audio device fails to
@@ -155,15 +180,19 @@ class VoipCore : public VoipEngine,
   // Synchronization is handled internally by AudioDeviceModule.
   rtc::scoped_refptr<AudioDeviceModule> audio_device_module_;
 
+  // Encoder task queues shared by the channels, if any. Must be placed before
+  // `channel_shards_` to outlive the channels.
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>>
+      encoder_queues_;
+
   Mutex lock_;
 
   // Member to track a next ChannelId for new AudioChannel.
   int next_channel_id_ RTC_GUARDED_BY(lock_) = 0;
 
-  // Container to track currently active AudioChannel objects mapped by
+  // Containers to track currently active AudioChannel objects mapped by
   // ChannelId.
-  std::unordered_map<ChannelId, rtc::scoped_refptr<AudioChannel>> channels_
-      RTC_GUARDED_BY(lock_);
+  std::array<ChannelShard, kNumChannelShards> channel_shards_;
 
   // Boolean flag to ensure initialization only occurs once.
   bool initialized_ RTC_GUARDED_BY(lock_) = false;
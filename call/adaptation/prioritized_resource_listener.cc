@@ -0,0 +1,198 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/adaptation/prioritized_resource_listener.h"
+
+#include <string>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "api/make_ref_counted.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// The AdapterResource redirects the resource usage measurements its parent
+// forwards to it to a single ResourceListener.
+class PrioritizedResourceListener::AdapterResource : public Resource {
+ public:
+  explicit AdapterResource(absl::string_view name) : name_(name) {}
+  ~AdapterResource() override { RTC_DCHECK(!listener_); }
+
+  void OnResourceUsageStateMeasured(ResourceUsageState usage_state) {
+    MutexLock lock(&lock_);
+    if (!listener_)
+      return;
+    listener_->OnResourceUsageStateMeasured(rtc::scoped_refptr<Resource>(this),
+                                            usage_state);
+  }
+
+  // Resource implementation.
+  std::string Name() const override { return name_; }
+  void SetResourceListener(ResourceListener* listener) override {
+    MutexLock lock(&lock_);
+    RTC_DCHECK(!listener_ || !listener);
+    listener_ = listener;
+  }
+
+ private:
+  const std::string name_;
+  Mutex lock_;
+  ResourceListener* listener_ RTC_GUARDED_BY(lock_) = nullptr;
+};
+
+PrioritizedResourceListener::PrioritizedResourceListener(
+    rtc::scoped_refptr<Resource> source_resource,
+    int max_adaptations_per_adapter)
+    : source_resource_(source_resource),
+      max_adaptations_per_adapter_(max_adaptations_per_adapter),
+      is_listening_(false) {
+  RTC_DCHECK(source_resource_);
+  RTC_DCHECK_GT(max_adaptations_per_adapter_, 0);
+}
+
+PrioritizedResourceListener::~PrioritizedResourceListener() {
+  RTC_DCHECK(!is_listening_);
+}
+
+rtc::scoped_refptr<Resource> PrioritizedResourceListener::SourceResource()
+    const {
+  return source_resource_;
+}
+
+void PrioritizedResourceListener::StartListening() {
+  MutexLock lock(&lock_);
+  RTC_DCHECK(!is_listening_);
+  source_resource_->SetResourceListener(this);
+  is_listening_ = true;
+}
+
+void PrioritizedResourceListener::StopListening() {
+  MutexLock lock(&lock_);
+  RTC_DCHECK(is_listening_);
+  RTC_DCHECK(adapters_.empty());
+  source_resource_->SetResourceListener(nullptr);
+  is_listening_ = false;
+}
+
+rtc::scoped_refptr<Resource> PrioritizedResourceListener::CreateAdapterResource(
+    double priority) {
+  MutexLock lock(&lock_);
+  RTC_DCHECK(is_listening_);
+  rtc::scoped_refptr<AdapterResource> adapter =
+      rtc::make_ref_counted<AdapterResource>(source_resource_->Name() +
+                                             "Adapter");
+  adapters_.push_back({adapter, priority, 0});
+  return adapter;
+}
+
+void PrioritizedResourceListener::SetAdapterPriority(
+    rtc::scoped_refptr<Resource> resource,
+    double priority) {
+  MutexLock lock(&lock_);
+  Adapter* adapter = FindAdapter(resource);
+  RTC_DCHECK(adapter);
+  adapter->priority = priority;
+}
+
+int PrioritizedResourceListener::GetAdaptationCount(
+    rtc::scoped_refptr<Resource> resource) {
+  MutexLock lock(&lock_);
+  Adapter* adapter = FindAdapter(resource);
+  RTC_DCHECK(adapter);
+  return adapter->adaptations;
+}
+
+void PrioritizedResourceListener::RemoveAdapterResource(
+    rtc::scoped_refptr<Resource> resource) {
+  MutexLock lock(&lock_);
+  Adapter* adapter = FindAdapter(resource);
+  RTC_DCHECK(adapter);
+  adapters_.erase(adapters_.begin() + (adapter - adapters_.data()));
+}
+
+std::vector<rtc::scoped_refptr<Resource>>
+PrioritizedResourceListener::GetAdapterResources() {
+  std::vector<rtc::scoped_refptr<Resource>> resources;
+  MutexLock lock(&lock_);
+  for (const Adapter& adapter : adapters_) {
+    resources.push_back(adapter.resource);
+  }
+  return resources;
+}
+
+void PrioritizedResourceListener::OnResourceUsageStateMeasured(
+    rtc::scoped_refptr<Resource> resource,
+    ResourceUsageState usage_state) {
+  RTC_DCHECK_EQ(resource, source_resource_);
+  MutexLock lock(&lock_);
+  if (usage_state == ResourceUsageState::kOveruse) {
+    if (Adapter* adapter = AdapterToDegrade()) {
+      ++adapter->adaptations;
+      adapter->resource->OnResourceUsageStateMeasured(usage_state);
+      return;
+    }
+    // Every adapter has been degraded as much as the limit allows; the source
+    // is still overused, so degrade all of them.
+    for (Adapter& adapter : adapters_) {
+      ++adapter.adaptations;
+      adapter.resource->OnResourceUsageStateMeasured(usage_state);
+    }
+  } else {
+    if (Adapter* adapter = AdapterToRestore()) {
+      --adapter->adaptations;
+      adapter->resource->OnResourceUsageStateMeasured(usage_state);
+    }
+  }
+}
+
+PrioritizedResourceListener::Adapter* PrioritizedResourceListener::FindAdapter(
+    const rtc::scoped_refptr<Resource>& resource) {
+  for (Adapter& adapter : adapters_) {
+    if (adapter.resource == resource) {
+      return &adapter;
+    }
+  }
+  return nullptr;
+}
+
+PrioritizedResourceListener::Adapter*
+PrioritizedResourceListener::AdapterToDegrade() {
+  Adapter* selected = nullptr;
+  for (Adapter& adapter : adapters_) {
+    if (adapter.adaptations >= max_adaptations_per_adapter_) {
+      continue;
+    }
+    if (!selected || adapter.priority < selected->priority ||
+        (adapter.priority == selected->priority &&
+         adapter.adaptations < selected->adaptations)) {
+      selected = &adapter;
+    }
+  }
+  return selected;
+}
+
+PrioritizedResourceListener::Adapter*
+PrioritizedResourceListener::AdapterToRestore() {
+  Adapter* selected = nullptr;
+  for (Adapter& adapter : adapters_) {
+    if (adapter.adaptations <= 0) {
+      continue;
+    }
+    if (!selected || adapter.priority > selected->priority ||
+        (adapter.priority == selected->priority &&
+         adapter.adaptations > selected->adaptations)) {
+      selected = &adapter;
+    }
+  }
+  return selected;
+}
+
+}  // namespace webrtc
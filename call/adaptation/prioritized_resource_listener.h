@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_ADAPTATION_PRIORITIZED_RESOURCE_LISTENER_H_
+#define CALL_ADAPTATION_PRIORITIZED_RESOURCE_LISTENER_H_
+
+#include <vector>
+
+#include "api/adaptation/resource.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/synchronization/mutex.h"
+
+namespace webrtc {
+
+// Like BroadcastResourceListener, forwards the measurements of 1 resource to N
+// "adapter" resources, but forwards each measurement to a single adapter
+// chosen by priority instead of to all of them. This lets a process-wide
+// resource, such as the CPU usage of the process, be shared by the
+// ResourceAdaptationProcessors of several VideoSendStreams without every
+// stream adapting on every overuse and then oscillating together.
+//
+// Overuse is forwarded to the lowest priority adapter that has been adapted
+// down fewer than `max_adaptations_per_adapter` times, so that low priority
+// streams are degraded first. Underuse is forwarded to the highest priority
+// adapter that has been adapted down, so that high priority streams are
+// restored first. Among adapters of equal priority the one that has been
+// adapted the least is degraded, and the one adapted the most is restored,
+// which spreads the degradation evenly. When every adapter is at the limit,
+// overuse is forwarded to all of them.
+//
+// The number of adaptations is counted from the forwarded measurements; an
+// adaptation that the receiving processor could not apply is still counted.
+// The limit bounds the error this causes.
+//
+// A suitable priority is the RtpEncodingParameters::bitrate_priority of the
+// stream, which can be updated with SetAdapterPriority().
+class PrioritizedResourceListener : public ResourceListener {
+ public:
+  static constexpr int kDefaultMaxAdaptationsPerAdapter = 4;
+
+  explicit PrioritizedResourceListener(
+      rtc::scoped_refptr<Resource> source_resource,
+      int max_adaptations_per_adapter = kDefaultMaxAdaptationsPerAdapter);
+  ~PrioritizedResourceListener() override;
+
+  rtc::scoped_refptr<Resource> SourceResource() const;
+  void StartListening();
+  void StopListening();
+
+  // Creates a Resource that gets the measurements the
+  // PrioritizedResourceListener forwards to it, based on `priority`. A higher
+  // value means a higher priority.
+  rtc::scoped_refptr<Resource> CreateAdapterResource(double priority);
+  void SetAdapterPriority(rtc::scoped_refptr<Resource> resource,
+                          double priority);
+  // Returns the number of overuse measurements minus the number of underuse
+  // measurements forwarded to the adapter.
+  int GetAdaptationCount(rtc::scoped_refptr<Resource> resource);
+
+  // Unregister the adapter from the PrioritizedResourceListener; it will no
+  // longer receive resource usage measurement and will no longer be
+  // referenced.
+  void RemoveAdapterResource(rtc::scoped_refptr<Resource> resource);
+  std::vector<rtc::scoped_refptr<Resource>> GetAdapterResources();
+
+  // ResourceListener implementation.
+  void OnResourceUsageStateMeasured(rtc::scoped_refptr<Resource> resource,
+                                    ResourceUsageState usage_state) override;
+
+ private:
+  class AdapterResource;
+  struct Adapter {
+    rtc::scoped_refptr<AdapterResource> resource;
+    double priority;
+    int adaptations;
+  };
+
+  Adapter* FindAdapter(const rtc::scoped_refptr<Resource>& resource)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  Adapter* AdapterToDegrade() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  Adapter* AdapterToRestore() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  const rtc::scoped_refptr<Resource> source_resource_;
+  const int max_adaptations_per_adapter_;
+  Mutex lock_;
+  bool is_listening_ RTC_GUARDED_BY(lock_);
+  std::vector<Adapter> adapters_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_ADAPTATION_PRIORITIZED_RESOURCE_LISTENER_H_
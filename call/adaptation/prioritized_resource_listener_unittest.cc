@@ -0,0 +1,164 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/adaptation/prioritized_resource_listener.h"
+
+#include "call/adaptation/test/fake_resource.h"
+#include "call/adaptation/test/mock_resource_listener.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+using ::testing::_;
+using ::testing::Eq;
+using ::testing::StrictMock;
+
+class PrioritizedResourceListenerTest : public ::testing::Test {
+ public:
+  PrioritizedResourceListenerTest()
+      : source_resource_(FakeResource::Create("SourceResource")),
+        prioritized_resource_listener_(source_resource_,
+                                       /*max_adaptations_per_adapter=*/2) {
+    prioritized_resource_listener_.StartListening();
+  }
+
+  ~PrioritizedResourceListenerTest() override {
+    for (const auto& adapter :
+         prioritized_resource_listener_.GetAdapterResources()) {
+      adapter->SetResourceListener(nullptr);
+      prioritized_resource_listener_.RemoveAdapterResource(adapter);
+    }
+    prioritized_resource_listener_.StopListening();
+  }
+
+  rtc::scoped_refptr<Resource> CreateAdapter(double priority,
+                                             ResourceListener* listener) {
+    rtc::scoped_refptr<Resource> adapter =
+        prioritized_resource_listener_.CreateAdapterResource(priority);
+    adapter->SetResourceListener(listener);
+    return adapter;
+  }
+
+  int AdaptationCount(rtc::scoped_refptr<Resource> adapter) {
+    return prioritized_resource_listener_.GetAdaptationCount(adapter);
+  }
+
+ protected:
+  rtc::scoped_refptr<FakeResource> source_resource_;
+  PrioritizedResourceListener prioritized_resource_listener_;
+};
+
+TEST_F(PrioritizedResourceListenerTest, CreateAndRemoveAdapterResource) {
+  EXPECT_TRUE(prioritized_resource_listener_.GetAdapterResources().empty());
+  StrictMock<MockResourceListener> listener;
+  rtc::scoped_refptr<Resource> adapter = CreateAdapter(1.0, &listener);
+  EXPECT_EQ(std::vector<rtc::scoped_refptr<Resource>>{adapter},
+            prioritized_resource_listener_.GetAdapterResources());
+  EXPECT_EQ("SourceResourceAdapter", adapter->Name());
+
+  prioritized_resource_listener_.RemoveAdapterResource(adapter);
+  EXPECT_TRUE(prioritized_resource_listener_.GetAdapterResources().empty());
+  // The removed adapter is not forwarding measurements.
+  EXPECT_CALL(listener, OnResourceUsageStateMeasured(_, _)).Times(0);
+  source_resource_->SetUsageState(ResourceUsageState::kOveruse);
+  adapter->SetResourceListener(nullptr);
+}
+
+TEST_F(PrioritizedResourceListenerTest, DegradesLowestPriorityFirst) {
+  StrictMock<MockResourceListener> low_listener;
+  StrictMock<MockResourceListener> high_listener;
+  rtc::scoped_refptr<Resource> high = CreateAdapter(2.0, &high_listener);
+  rtc::scoped_refptr<Resource> low = CreateAdapter(1.0, &low_listener);
+
+  EXPECT_CALL(low_listener, OnResourceUsageStateMeasured(
+                                Eq(low), Eq(ResourceUsageState::kOveruse)))
+      .Times(2);
+  source_resource_->SetUsageState(ResourceUsageState::kOveruse);
+  source_resource_->SetUsageState(ResourceUsageState::kOveruse);
+  ::testing::Mock::VerifyAndClearExpectations(&low_listener);
+  EXPECT_EQ(2, AdaptationCount(low));
+  EXPECT_EQ(0, AdaptationCount(high));
+
+  // The low priority stream is at the limit, continue with the next one.
+  EXPECT_CALL(high_listener, OnResourceUsageStateMeasured(
+                                 Eq(high), Eq(ResourceUsageState::kOveruse)));
+  source_resource_->SetUsageState(ResourceUsageState::kOveruse);
+  ::testing::Mock::VerifyAndClearExpectations(&high_listener);
+  EXPECT_EQ(1, AdaptationCount(high));
+}
+
+TEST_F(PrioritizedResourceListenerTest, RestoresHighestPriorityFirst) {
+  StrictMock<MockResourceListener> low_listener;
+  StrictMock<MockResourceListener> high_listener;
+  rtc::scoped_refptr<Resource> low = CreateAdapter(1.0, &low_listener);
+  rtc::scoped_refptr<Resource> high = CreateAdapter(2.0, &high_listener);
+  EXPECT_CALL(low_listener, OnResourceUsageStateMeasured(_, _)).Times(2);
+  EXPECT_CALL(high_listener, OnResourceUsageStateMeasured(_, _));
+  for (int i = 0; i < 3; ++i) {
+    source_resource_->SetUsageState(ResourceUsageState::kOveruse);
+  }
+  ::testing::Mock::VerifyAndClearExpectations(&low_listener);
+  ::testing::Mock::VerifyAndClearExpectations(&high_listener);
+
+  ::testing::InSequence s;
+  EXPECT_CALL(high_listener, OnResourceUsageStateMeasured(
+                                 Eq(high), Eq(ResourceUsageState::kUnderuse)));
+  EXPECT_CALL(low_listener, OnResourceUsageStateMeasured(
+                                Eq(low), Eq(ResourceUsageState::kUnderuse)))
+      .Times(2);
+  // Nothing is left to restore; the last underuse is not forwarded.
+  for (int i = 0; i < 4; ++i) {
+    source_resource_->SetUsageState(ResourceUsageState::kUnderuse);
+  }
+  EXPECT_EQ(0, AdaptationCount(low));
+  EXPECT_EQ(0, AdaptationCount(high));
+}
+
+TEST_F(PrioritizedResourceListenerTest, SpreadsAdaptationsOverEqualPriority) {
+  StrictMock<MockResourceListener> listener_a;
+  StrictMock<MockResourceListener> listener_b;
+  rtc::scoped_refptr<Resource> a = CreateAdapter(1.0, &listener_a);
+  rtc::scoped_refptr<Resource> b = CreateAdapter(1.0, &listener_b);
+  EXPECT_CALL(listener_a, OnResourceUsageStateMeasured(_, _)).Times(2);
+  EXPECT_CALL(listener_b, OnResourceUsageStateMeasured(_, _)).Times(2);
+  for (int i = 0; i < 4; ++i) {
+    source_resource_->SetUsageState(ResourceUsageState::kOveruse);
+  }
+  EXPECT_EQ(2, AdaptationCount(a));
+  EXPECT_EQ(2, AdaptationCount(b));
+}
+
+TEST_F(PrioritizedResourceListenerTest, OveruseGoesToAllWhenAllAreAtLimit) {
+  StrictMock<MockResourceListener> low_listener;
+  StrictMock<MockResourceListener> high_listener;
+  rtc::scoped_refptr<Resource> low = CreateAdapter(1.0, &low_listener);
+  rtc::scoped_refptr<Resource> high = CreateAdapter(2.0, &high_listener);
+  EXPECT_CALL(low_listener, OnResourceUsageStateMeasured(_, _)).Times(3);
+  EXPECT_CALL(high_listener, OnResourceUsageStateMeasured(_, _)).Times(3);
+  for (int i = 0; i < 5; ++i) {
+    source_resource_->SetUsageState(ResourceUsageState::kOveruse);
+  }
+  EXPECT_EQ(3, AdaptationCount(low));
+  EXPECT_EQ(3, AdaptationCount(high));
+}
+
+TEST_F(PrioritizedResourceListenerTest, PriorityCanBeChanged) {
+  StrictMock<MockResourceListener> listener_a;
+  StrictMock<MockResourceListener> listener_b;
+  rtc::scoped_refptr<Resource> a = CreateAdapter(1.0, &listener_a);
+  rtc::scoped_refptr<Resource> b = CreateAdapter(2.0, &listener_b);
+  prioritized_resource_listener_.SetAdapterPriority(a, 3.0);
+  EXPECT_CALL(listener_b, OnResourceUsageStateMeasured(
+                              Eq(b), Eq(ResourceUsageState::kOveruse)));
+  source_resource_->SetUsageState(ResourceUsageState::kOveruse);
+}
+
+}  // namespace webrtc
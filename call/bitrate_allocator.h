@@ -93,6 +93,13 @@ struct AllocatableTrack {
   // enable-hysteresis if the observer is in a paused state.
   uint32_t MinBitrateWithHysteresis() const;
 };
+
+// Scratch space reused by every allocation, so that computing an allocation
+// doesn't allocate memory once the buffers have grown to the number of tracks.
+struct AllocationBuffers {
+  std::vector<int> capacities;
+  std::vector<size_t> order;
+};
 }  // namespace bitrate_allocator_impl
 
 // Usage: this class will register multiple RtcpBitrateObserver's one at each
@@ -143,6 +150,10 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   // calls LimitObserver::OnAllocationLimitsChanged.
   void UpdateAllocationLimits() RTC_RUN_ON(&sequenced_checker_);
 
+  // Computes `allocation_` and `stable_allocation_` from the last target
+  // rates.
+  void UpdateAllocations() RTC_RUN_ON(&sequenced_checker_);
+
   // Allow packets to be transmitted in up to 2 times max video bitrate if the
   // bandwidth estimate allows it.
   // TODO(bugs.webrtc.org/8541): May be worth to refactor to keep this logic in
@@ -164,6 +175,12 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   int num_pause_events_ RTC_GUARDED_BY(&sequenced_checker_);
   int64_t last_bwe_log_time_ RTC_GUARDED_BY(&sequenced_checker_);
   BitrateAllocationLimits current_limits_ RTC_GUARDED_BY(&sequenced_checker_);
+  // Allocations of the last target and stable target rates, indexed like
+  // `allocatable_tracks_`. Kept as members to reuse their memory.
+  std::vector<int> allocation_ RTC_GUARDED_BY(&sequenced_checker_);
+  std::vector<int> stable_allocation_ RTC_GUARDED_BY(&sequenced_checker_);
+  bitrate_allocator_impl::AllocationBuffers allocation_buffers_
+      RTC_GUARDED_BY(&sequenced_checker_);
 };
 
 }  // namespace webrtc
@@ -1034,4 +1034,42 @@ TEST_F(BitrateAllocatorTest, PriorityRateThreeObserversTwoAllocatedToMax) {
   allocator_->RemoveObserver(&observer_high);
 }
 
+TEST_F(BitrateAllocatorTest, AllocatesToManyObservers) {
+  constexpr int kNumObservers = 1000;
+  std::vector<TestBitrateObserver> observers(kNumObservers);
+  for (int i = 0; i < kNumObservers; ++i) {
+    // Every other observer has a lower max bitrate, and every fourth twice
+    // the bitrate priority.
+    AddObserver(&observers[i], 30000, i % 2 == 0 ? 1000000 : 100000, 0, true,
+                i % 4 == 0 ? 2.0 : 1.0);
+  }
+
+  // Enough for everyone to get the min bitrate, plus a share of the rest
+  // according to the bitrate priority, capped by the max bitrate.
+  allocator_->OnNetworkEstimateChanged(CreateTargetRateMessage(
+      kNumObservers * 150000, 0, 0, kDefaultProbingIntervalMs));
+  int64_t total_bitrate_bps = 0;
+  for (int i = 0; i < kNumObservers; ++i) {
+    total_bitrate_bps += observers[i].last_bitrate_bps_;
+  }
+  EXPECT_NEAR(total_bitrate_bps, kNumObservers * 150000, kNumObservers);
+  EXPECT_EQ(observers[1].last_bitrate_bps_, 100000u);
+  EXPECT_EQ(observers[2].last_bitrate_bps_, observers[6].last_bitrate_bps_);
+  EXPECT_NEAR(observers[0].last_bitrate_bps_ - 30000,
+              2 * (observers[2].last_bitrate_bps_ - 30000), 2);
+
+  // Above the sum of max bitrates, the rest is split evenly up to twice the
+  // max bitrate, starting with the observers with the lowest max bitrate.
+  allocator_->OnNetworkEstimateChanged(CreateTargetRateMessage(
+      kNumObservers * 1000000, 0, 0, kDefaultProbingIntervalMs));
+  for (int i = 0; i < kNumObservers; ++i) {
+    EXPECT_EQ(observers[i].last_bitrate_bps_,
+              i % 2 == 0 ? 1800000u : 200000u);
+  }
+
+  for (TestBitrateObserver& observer : observers) {
+    allocator_->RemoveObserver(&observer);
+  }
+}
+
 }  // namespace webrtc
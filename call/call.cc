@@ -911,7 +911,7 @@ webrtc::VideoSendStream* Call::CreateVideoSendStream(
       bitrate_allocator_.get(), video_send_delay_stats_.get(), event_log_,
       std::move(config), std::move(encoder_config), suspended_video_send_ssrcs_,
       suspended_video_payload_states_, std::move(fec_controller),
-      *config_.trials);
+      *config_.trials, config_.encode_metronome);
 
   for (uint32_t ssrc : ssrcs) {
     RTC_DCHECK(video_send_ssrcs_.find(ssrc) == video_send_ssrcs_.end());
@@ -38,6 +38,7 @@ RtpTransportConfig CallConfig::ExtractTransportConfig() const {
   transportConfig.network_state_predictor_factory =
       network_state_predictor_factory;
   transportConfig.task_queue_factory = task_queue_factory;
+  transportConfig.pacing_scheduler = pacing_scheduler;
   transportConfig.trials = trials;
 
   return transportConfig;
@@ -28,6 +28,7 @@
 namespace webrtc {
 
 class AudioProcessing;
+class PacingScheduler;
 class RtcEventLog;
 
 struct CallConfig {
@@ -78,6 +79,11 @@ struct CallConfig {
   // Network controller factory to use for this call.
   NetworkControllerFactoryInterface* network_controller_factory = nullptr;
 
+  // Optional scheduler for the pacer's delayed process tasks. Calls sharing a
+  // worker thread may share a scheduler, so that their pacers are woken up
+  // together. Must outlive the call.
+  PacingScheduler* pacing_scheduler = nullptr;
+
   // NetEq factory to use for this call.
   NetEqFactory* neteq_factory = nullptr;
 
@@ -91,6 +97,9 @@ struct CallConfig {
       rtp_transport_controller_send_factory = nullptr;
 
   Metronome* metronome = nullptr;
+  // Metronome on whose ticks frames are delivered to the video encoders, used
+  // on the worker thread.
+  Metronome* encode_metronome = nullptr;
 
   // Enables send packet batching from the egress RTP sender.
   bool enable_send_packet_batching = false;
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <string>
+
+#include "api/numerics/samples_stats_counter.h"
+#include "api/test/metrics/global_metrics_logger_and_exporter.h"
+#include "api/test/metrics/metric.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/video_codecs/scalability_mode.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/memory_usage.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "test/gtest.h"
+#include "test/scenario/scenario.h"
+
+namespace webrtc {
+namespace {
+
+using ::webrtc::test::GetGlobalMetricsLogger;
+using ::webrtc::test::ImprovementDirection;
+using ::webrtc::test::Unit;
+
+constexpr TimeDelta kWarmUpTime = TimeDelta::Seconds(2);
+constexpr TimeDelta kMeasurementTime = TimeDelta::Seconds(10);
+constexpr TimeDelta kMemorySampleInterval = TimeDelta::Seconds(1);
+constexpr DataRate kVideoRate = DataRate::KilobitsPerSec(2500);
+constexpr DataRate kAudioRate = DataRate::KilobitsPerSec(32);
+
+// Collects the capture to decode delay of the frames decoded during the
+// measurement.
+class DelayCollector {
+ public:
+  void set_measuring(bool measuring) {
+    MutexLock lock(&mutex_);
+    measuring_ = measuring;
+  }
+
+  void OnFramePair(const test::VideoFramePair& pair) {
+    if (!pair.decoded) {
+      return;
+    }
+    MutexLock lock(&mutex_);
+    if (measuring_) {
+      delay_ms_.AddSample((pair.decoded_time - pair.capture_time).ms<double>());
+    }
+  }
+
+  SamplesStatsCounter delay_ms() const {
+    MutexLock lock(&mutex_);
+    return delay_ms_;
+  }
+
+ private:
+  mutable Mutex mutex_;
+  bool measuring_ RTC_GUARDED_BY(mutex_) = false;
+  SamplesStatsCounter delay_ms_ RTC_GUARDED_BY(mutex_);
+};
+
+// Runs the parameterized number of audio and simulcast video send/receive
+// stream pairs in one pair of calls, over an unconstrained emulated network,
+// with fake video encoders and decoders. The streams run in simulated time,
+// so the CPU time spent per simulated second is the share of a core the
+// streams would need in real time, without any time spent waiting.
+class CallLoadPerfTest : public ::testing::TestWithParam<int> {};
+
+TEST_P(CallLoadPerfTest, ResourceUsagePerStream) {
+  const int num_streams = GetParam();
+  const std::string test_case_name =
+      "call_load_" + std::to_string(num_streams) + "_streams";
+  DelayCollector delays;
+  SamplesStatsCounter memory_usage_bytes;
+
+  const int64_t initial_memory_usage_bytes =
+      rtc::GetProcessResidentSizeBytes();
+  test::Scenario s;
+  test::CallClientConfig client_config;
+  client_config.transport.rates.start_rate =
+      (kVideoRate + kAudioRate) * num_streams;
+  client_config.transport.rates.max_rate =
+      client_config.transport.rates.start_rate;
+  auto* caller = s.CreateClient("caller", client_config);
+  auto* callee = s.CreateClient("callee", client_config);
+  auto* route = s.CreateRoutes(
+      caller, {s.CreateSimulationNode(test::NetworkSimulationConfig())},
+      callee, {s.CreateSimulationNode(test::NetworkSimulationConfig())});
+  for (int i = 0; i < num_streams; ++i) {
+    s.CreateAudioStream(route->forward(), [](test::AudioStreamConfig* c) {
+      c->encoder.fixed_rate = kAudioRate;
+    });
+    s.CreateVideoStream(route->forward(), [&](test::VideoStreamConfig* c) {
+      c->source.generator.width = 1280;
+      c->source.generator.height = 720;
+      c->encoder.implementation = test::VideoStreamConfig::Encoder::kFake;
+      c->encoder.codec = kVideoCodecVP8;
+      c->encoder.max_data_rate = kVideoRate;
+      c->encoder.simulcast_streams = {ScalabilityMode::kL1T3,
+                                      ScalabilityMode::kL1T3,
+                                      ScalabilityMode::kL1T3};
+      c->hooks.frame_pair_handlers = {
+          [&delays](const test::VideoFramePair& pair) {
+            delays.OnFramePair(pair);
+          }};
+    });
+  }
+  s.RunFor(kWarmUpTime);
+
+  delays.set_measuring(true);
+  s.Every(kMemorySampleInterval, [&memory_usage_bytes] {
+    memory_usage_bytes.AddSample(rtc::GetProcessResidentSizeBytes());
+  });
+  const int64_t start_cpu_time_ns = rtc::GetProcessCpuTimeNanos();
+  s.RunFor(kMeasurementTime);
+  const int64_t cpu_time_ns =
+      rtc::GetProcessCpuTimeNanos() - start_cpu_time_ns;
+  delays.set_measuring(false);
+
+  const double cpu_usage_percent =
+      100.0 * cpu_time_ns / kMeasurementTime.ns<double>();
+  const double memory_usage_increase_bytes =
+      memory_usage_bytes.GetAverage() - initial_memory_usage_bytes;
+  SamplesStatsCounter delay_ms = delays.delay_ms();
+  ASSERT_FALSE(delay_ms.IsEmpty());
+
+  GetGlobalMetricsLogger()->LogSingleValueMetric(
+      "cpu_usage", test_case_name, cpu_usage_percent, Unit::kPercent,
+      ImprovementDirection::kSmallerIsBetter);
+  GetGlobalMetricsLogger()->LogSingleValueMetric(
+      "cpu_usage_per_stream", test_case_name, cpu_usage_percent / num_streams,
+      Unit::kPercent, ImprovementDirection::kSmallerIsBetter);
+  GetGlobalMetricsLogger()->LogSingleValueMetric(
+      "memory_usage_per_stream", test_case_name,
+      memory_usage_increase_bytes / num_streams, Unit::kBytes,
+      ImprovementDirection::kSmallerIsBetter);
+  GetGlobalMetricsLogger()->LogMetric(
+      "capture_to_decode_delay", test_case_name, delay_ms,
+      Unit::kMilliseconds, ImprovementDirection::kSmallerIsBetter);
+  for (double percentile : {0.5, 0.95, 0.99}) {
+    GetGlobalMetricsLogger()->LogSingleValueMetric(
+        "capture_to_decode_delay_p" +
+            std::to_string(static_cast<int>(percentile * 100)),
+        test_case_name, delay_ms.GetPercentile(percentile),
+        Unit::kMilliseconds, ImprovementDirection::kSmallerIsBetter);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(NumStreams,
+                         CallLoadPerfTest,
+                         ::testing::Values(1, 4, 16));
+
+}  // namespace
+}  // namespace webrtc
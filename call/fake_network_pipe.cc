@@ -170,8 +170,9 @@ void FakeNetworkPipe::SetClockOffset(int64_t offset_ms) {
   clock_offset_ms_ = offset_ms;
 }
 
-FakeNetworkPipe::StoredPacket::StoredPacket(NetworkPacket&& packet)
-    : packet(std::move(packet)) {}
+FakeNetworkPipe::StoredPacket::StoredPacket(uint64_t id,
+                                            NetworkPacket&& packet)
+    : id(id), packet(std::move(packet)) {}
 
 bool FakeNetworkPipe::EnqueuePacket(rtc::CopyOnWriteBuffer packet,
                                     absl::optional<PacketOptions> options,
@@ -200,8 +201,8 @@ bool FakeNetworkPipe::EnqueuePacket(NetworkPacket&& net_packet) {
   int64_t send_time_us = net_packet.send_time();
   size_t packet_size = net_packet.data_length();
 
-  packets_in_flight_.emplace_back(StoredPacket(std::move(net_packet)));
-  int64_t packet_id = reinterpret_cast<uint64_t>(&packets_in_flight_.back());
+  const uint64_t packet_id = next_packet_id_++;
+  packets_in_flight_.emplace_back(packet_id, std::move(net_packet));
   bool sent = network_behavior_->EnqueuePacket(
       PacketInFlightInfo(packet_size, send_time_us, packet_id));
 
@@ -260,16 +261,15 @@ void FakeNetworkPipe::Process() {
     std::vector<PacketDeliveryInfo> delivery_infos =
         network_behavior_->DequeueDeliverablePackets(time_now_us);
     for (auto& delivery_info : delivery_infos) {
-      // In the common case where no reordering happens, find will return early
-      // as the first packet will be a match.
-      auto packet_it =
-          std::find_if(packets_in_flight_.begin(), packets_in_flight_.end(),
-                       [&delivery_info](StoredPacket& packet_ref) {
-                         return reinterpret_cast<uint64_t>(&packet_ref) ==
-                                delivery_info.packet_id;
-                       });
+      auto packet_it = std::lower_bound(
+          packets_in_flight_.begin(), packets_in_flight_.end(),
+          delivery_info.packet_id,
+          [](const StoredPacket& packet_ref, uint64_t packet_id) {
+            return packet_ref.id < packet_id;
+          });
       // Check that the packet is in the deque of packets in flight.
-      RTC_CHECK(packet_it != packets_in_flight_.end());
+      RTC_CHECK(packet_it != packets_in_flight_.end() &&
+                packet_it->id == delivery_info.packet_id);
       // Check that the packet is not already removed.
       RTC_DCHECK(!packet_it->removed);
 
@@ -167,9 +167,10 @@ class FakeNetworkPipe : public SimulatedPacketReceiverInterface {
 
  private:
   struct StoredPacket {
+    uint64_t id;
     NetworkPacket packet;
     bool removed = false;
-    explicit StoredPacket(NetworkPacket&& packet);
+    StoredPacket(uint64_t id, NetworkPacket&& packet);
     StoredPacket(StoredPacket&&) = default;
     StoredPacket(const StoredPacket&) = delete;
     StoredPacket& operator=(const StoredPacket&) = delete;
@@ -207,12 +208,11 @@ class FakeNetworkPipe : public SimulatedPacketReceiverInterface {
   // `process_lock` guards the data structures involved in delay and loss
   // processes, such as the packet queues.
   Mutex process_lock_;
-  // Packets  are added at the back of the deque, this makes the deque ordered
-  // by increasing send time. The common case when removing packets from the
-  // deque is removing early packets, which will be close to the front of the
-  // deque. This makes finding the packets in the deque efficient in the common
-  // case.
+  // Packets are added at the back of the deque, with increasing ids, which
+  // makes the deque ordered by id and by increasing send time. Delivered
+  // packets are found by binary search on the id.
   std::deque<StoredPacket> packets_in_flight_ RTC_GUARDED_BY(process_lock_);
+  uint64_t next_packet_id_ RTC_GUARDED_BY(process_lock_) = 0;
 
   int64_t clock_offset_ms_ RTC_GUARDED_BY(config_lock_);
 
@@ -10,6 +10,9 @@
 
 #include "call/rtp_demuxer.h"
 
+#include <algorithm>
+#include <utility>
+
 #include "absl/strings/string_view.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
@@ -21,6 +24,11 @@
 namespace webrtc {
 namespace {
 
+// Fibonacci hashing; the top bits are well mixed even for sequential SSRCs.
+size_t RouteHash(uint32_t ssrc) {
+  return (ssrc * uint32_t{0x9E3779B1}) >> 16;
+}
+
 template <typename Container, typename Value>
 size_t RemoveFromMultimapByValue(Container* multimap, const Value& value) {
   size_t count = 0;
@@ -159,6 +167,7 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
   }
 
   RefreshKnownMids();
+  ClearRoutes();
 
   RTC_DLOG(LS_INFO) << "Added sink = " << sink << " for criteria "
                     << criteria.ToString();
@@ -252,6 +261,7 @@ bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
                        RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
                        RemoveFromMapByValue(&sink_by_rsid_, sink);
   RefreshKnownMids();
+  ClearRoutes();
   return num_removed > 0;
 }
 
@@ -279,6 +289,32 @@ bool RtpDemuxer::OnRtpPacket(const RtpPacketReceived& packet) {
 
 RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
     const RtpPacketReceived& packet) {
+  uint32_t ssrc = packet.Ssrc();
+  // Without MID and RSID the outcome depends only on the latched state of the
+  // SSRC, which ResolveSinkSlow() records in `route_cache_`.
+  bool has_ids = (use_mid_ && packet.HasExtension<RtpMid>()) ||
+                 packet.HasExtension<RtpStreamId>() ||
+                 packet.HasExtension<RepairedRtpStreamId>();
+  if (!has_ids) {
+    if (RtpPacketSinkInterface* sink = LookUpRoute(ssrc)) {
+      return sink;
+    }
+  }
+
+  RtpPacketSinkInterface* sink = ResolveSinkSlow(packet);
+  // Payload type routing of unbound SSRCs depends on the packet, and is not
+  // cached. All other outcomes bind the SSRC, unless the binding limit is hit.
+  auto it = sink_by_ssrc_.find(ssrc);
+  if (sink != nullptr && it != sink_by_ssrc_.end() && it->second == sink) {
+    UpdateRoute(ssrc, sink);
+  } else if (LookUpRoute(ssrc) != nullptr) {
+    ClearRoutes();
+  }
+  return sink;
+}
+
+RtpPacketSinkInterface* RtpDemuxer::ResolveSinkSlow(
+    const RtpPacketReceived& packet) {
   // See the BUNDLE spec for high level reference to this algorithm:
   // https://tools.ietf.org/html/draft-ietf-mmusic-sdp-bundle-negotiation-38#section-10.2
 
@@ -449,4 +485,51 @@ void RtpDemuxer::AddSsrcSinkBinding(uint32_t ssrc,
   }
 }
 
+RtpPacketSinkInterface* RtpDemuxer::LookUpRoute(uint32_t ssrc) const {
+  if (route_cache_.empty()) {
+    return nullptr;
+  }
+  const size_t mask = route_cache_.size() - 1;
+  for (size_t i = RouteHash(ssrc) & mask;; i = (i + 1) & mask) {
+    const Route& route = route_cache_[i];
+    if (route.sink == nullptr || route.ssrc == ssrc) {
+      return route.sink;
+    }
+  }
+}
+
+void RtpDemuxer::UpdateRoute(uint32_t ssrc, RtpPacketSinkInterface* sink) {
+  RTC_DCHECK(sink);
+  // Keep the load at most one half, so that probe sequences stay short.
+  if (2 * (num_routes_ + 1) > route_cache_.size()) {
+    std::vector<Route> routes(std::max<size_t>(16, 2 * route_cache_.size()));
+    std::swap(routes, route_cache_);
+    num_routes_ = 0;
+    for (const Route& route : routes) {
+      if (route.sink != nullptr) {
+        UpdateRoute(route.ssrc, route.sink);
+      }
+    }
+  }
+  const size_t mask = route_cache_.size() - 1;
+  for (size_t i = RouteHash(ssrc) & mask;; i = (i + 1) & mask) {
+    Route& route = route_cache_[i];
+    if (route.sink == nullptr) {
+      route.ssrc = ssrc;
+      route.sink = sink;
+      ++num_routes_;
+      return;
+    }
+    if (route.ssrc == ssrc) {
+      route.sink = sink;
+      return;
+    }
+  }
+}
+
+void RtpDemuxer::ClearRoutes() {
+  route_cache_.clear();
+  num_routes_ = 0;
+}
+
 }  // namespace webrtc
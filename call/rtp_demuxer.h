@@ -168,6 +168,7 @@ class RtpDemuxer {
   // Will record any SSRC<->ID associations along the way.
   // If the packet should be dropped, this method returns null.
   RtpPacketSinkInterface* ResolveSink(const RtpPacketReceived& packet);
+  RtpPacketSinkInterface* ResolveSinkSlow(const RtpPacketReceived& packet);
 
   // Used by the ResolveSink algorithm.
   RtpPacketSinkInterface* ResolveSinkByMid(absl::string_view mid,
@@ -213,6 +214,24 @@ class RtpDemuxer {
   // Adds a binding from the SSRC to the given sink.
   void AddSsrcSinkBinding(uint32_t ssrc, RtpPacketSinkInterface* sink);
 
+  // Route cache, see `route_cache_`.
+  RtpPacketSinkInterface* LookUpRoute(uint32_t ssrc) const;
+  void UpdateRoute(uint32_t ssrc, RtpPacketSinkInterface* sink);
+  void ClearRoutes();
+
+  // Sinks of SSRCs bound in `sink_by_ssrc_`, as resolved by the full demux
+  // algorithm. Once a stream is latched, packets without MID and RSID are
+  // routed by a single probe of this table, instead of the string lookups of
+  // ResolveSinkSlow(). Open addressing with linear probing, with a power of
+  // two size; entries with a null sink are unused. Cleared whenever sinks are
+  // added or removed, and refilled as packets are demuxed.
+  struct Route {
+    uint32_t ssrc = 0;
+    RtpPacketSinkInterface* sink = nullptr;
+  };
+  std::vector<Route> route_cache_;
+  size_t num_routes_ = 0;
+
   const bool use_mid_;
 };
 
@@ -818,6 +818,49 @@ TEST_F(RtpDemuxerTest, DontForgetMidSsrcBindingWhenSinkRemoved) {
   EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_with_ssrc));
 }
 
+TEST_F(RtpDemuxerTest, LatchedSsrcFollowsChangedMid) {
+  constexpr uint32_t ssrc = 10;
+  MockRtpPacketSink sink_a;
+  MockRtpPacketSink sink_b;
+  AddSinkOnlyMid("a", &sink_a);
+  AddSinkOnlyMid("b", &sink_b);
+
+  auto packet_a = CreatePacketWithSsrcMid(ssrc, "a");
+  auto packet_a_ssrc = CreatePacketWithSsrc(ssrc);
+  auto packet_b = CreatePacketWithSsrcMid(ssrc, "b");
+  auto packet_b_ssrc = CreatePacketWithSsrc(ssrc);
+
+  InSequence sequence;
+  EXPECT_CALL(sink_a, OnRtpPacket(SamePacketAs(*packet_a)));
+  EXPECT_CALL(sink_a, OnRtpPacket(SamePacketAs(*packet_a_ssrc)));
+  EXPECT_CALL(sink_b, OnRtpPacket(SamePacketAs(*packet_b)));
+  EXPECT_CALL(sink_b, OnRtpPacket(SamePacketAs(*packet_b_ssrc)));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_a));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_a_ssrc));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_b));
+  EXPECT_TRUE(demuxer_.OnRtpPacket(*packet_b_ssrc));
+}
+
+TEST_F(RtpDemuxerTest, ManyLatchedSsrcsRoutedWithOnlySsrc) {
+  constexpr int kNumSsrcs = 200;
+  MockRtpPacketSink sinks[4];
+  const std::string mids[] = {"a", "b", "c", "d"};
+  for (int i = 0; i < 4; ++i) {
+    AddSinkOnlyMid(mids[i], &sinks[i]);
+    EXPECT_CALL(sinks[i], OnRtpPacket).Times(3 * kNumSsrcs / 4);
+  }
+
+  for (int i = 0; i < kNumSsrcs; ++i) {
+    EXPECT_TRUE(demuxer_.OnRtpPacket(
+        *CreatePacketWithSsrcMid(1000 + 7919 * i, mids[i % 4])));
+  }
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 0; i < kNumSsrcs; ++i) {
+      EXPECT_TRUE(demuxer_.OnRtpPacket(*CreatePacketWithSsrc(1000 + 7919 * i)));
+    }
+  }
+}
+
 // If a sink is added with only a MID, then any packet with that MID no matter
 // the RSID should be routed to that sink.
 TEST_F(RtpDemuxerTest, RoutedByMidWithAnyRsid) {
@@ -21,6 +21,7 @@
 #include "rtc_base/task_queue.h"
 
 namespace webrtc {
+class PacingScheduler;
 
 struct RtpTransportConfig {
   // Bitrate config used until valid bitrate estimates are calculated. Also
@@ -41,6 +42,10 @@ struct RtpTransportConfig {
   // Network controller factory to use for this call.
   NetworkControllerFactoryInterface* network_controller_factory = nullptr;
 
+  // Optional scheduler for the pacer's delayed process tasks, which may be
+  // shared by all calls on the same worker thread. Must outlive the call.
+  PacingScheduler* pacing_scheduler = nullptr;
+
   // Key-value mapping of internal configurations to apply,
   // e.g. field trials.
   const FieldTrialsView* trials = nullptr;
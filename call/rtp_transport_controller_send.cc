@@ -80,7 +80,12 @@ RtpTransportControllerSend::RtpTransportControllerSend(
       task_queue_(TaskQueueBase::Current()),
       bitrate_configurator_(config.bitrate_config),
       pacer_started_(false),
-      pacer_(clock, &packet_router_, *config.trials, TimeDelta::Millis(5), 3),
+      pacer_(clock,
+             &packet_router_,
+             *config.trials,
+             TimeDelta::Millis(5),
+             3,
+             config.pacing_scheduler),
       observer_(nullptr),
       controller_factory_override_(config.network_controller_factory),
       controller_factory_fallback_(
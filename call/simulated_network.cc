@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <iterator>
 #include <utility>
 
 #include "api/units/data_rate.h"
@@ -164,7 +165,6 @@ void SimulatedNetwork::UpdateCapacityQueue(ConfigState state,
       time_now_us < capacity_link_.front().arrival_time_us) {
     return;
   }
-  bool reorder_packets = false;
 
   do {
     // Time to get this packet (the original or just updated arrival_time_us is
@@ -207,14 +207,25 @@ void SimulatedNetwork::UpdateCapacityQueue(ConfigState state,
         arrival_time_jitter_us = last_arrival_time_us - packet.arrival_time_us;
       }
       packet.arrival_time_us += arrival_time_jitter_us;
+    }
 
-      // Optimization: Schedule a reorder only when a packet will exit before
-      // the one in front.
-      if (last_arrival_time_us > packet.arrival_time_us) {
-        reorder_packets = true;
+    if (state.config.allow_reordering &&
+        packet.arrival_time_us != PacketDeliveryInfo::kNotReceived) {
+      // Packets may exit out of order, so insert the packet after the last
+      // received packet that exits no later than it, which keeps the received
+      // packets in `delay_link_` ordered by arrival time. Reordering is
+      // local, so the search from the back is short.
+      auto insert_it = delay_link_.end();
+      while (insert_it != delay_link_.begin() &&
+             (std::prev(insert_it)->arrival_time_us ==
+                  PacketDeliveryInfo::kNotReceived ||
+              std::prev(insert_it)->arrival_time_us > packet.arrival_time_us)) {
+        --insert_it;
       }
+      delay_link_.insert(insert_it, packet);
+    } else {
+      delay_link_.emplace_back(packet);
     }
-    delay_link_.emplace_back(packet);
 
     // If there are no packets in the queue, there is nothing else to do.
     if (capacity_link_.empty()) {
@@ -230,16 +241,6 @@ void SimulatedNetwork::UpdateCapacityQueue(ConfigState state,
         state.config.link_capacity_kbps);
     // And if the next packet in the queue needs to exit, let's dequeue it.
   } while (capacity_link_.front().arrival_time_us <= time_now_us);
-
-  if (state.config.allow_reordering && reorder_packets) {
-    // Packets arrived out of order and since the network config allows
-    // reordering, let's sort them per arrival_time_us to make so they will also
-    // be delivered out of order.
-    std::stable_sort(delay_link_.begin(), delay_link_.end(),
-                     [](const PacketInfo& p1, const PacketInfo& p2) {
-                       return p1.arrival_time_us < p2.arrival_time_us;
-                     });
-  }
 }
 
 SimulatedNetwork::ConfigState SimulatedNetwork::GetConfigState() const {
@@ -123,6 +123,8 @@ std::string VideoReceiveStreamInterface::Config::ToString() const {
   ss << ", rtp: " << rtp.ToString();
   ss << ", renderer: " << (renderer ? "(renderer)" : "nullptr");
   ss << ", render_delay_ms: " << render_delay_ms;
+  if (decode_ahead_frames > 0)
+    ss << ", decode_ahead_frames: " << decode_ahead_frames;
   if (!sync_group.empty())
     ss << ", sync_group: " << sync_group;
   ss << '}';
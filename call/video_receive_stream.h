@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/call/transport.h"
 #include "api/crypto/crypto_options.h"
 #include "api/rtp_headers.h"
@@ -248,6 +249,18 @@ class VideoReceiveStreamInterface : public MediaReceiveStreamInterface {
     // available.
     bool enable_prerenderer_smoothing = true;
 
+    // If positive, frames are released to the decoder as soon as they are
+    // decodable, without waiting for their render time or for the previous
+    // frame to be decoded, with at most this many frames queued for decoding.
+    // Meant for receivers which record or transcode the stream rather than
+    // render it, e.g. to decode RTP dumps faster than real time.
+    int decode_ahead_frames = 0;
+
+    // If set, limits the number of threads the decoders of the stream may
+    // use. The decoders never use more than the stream's share of the decoder
+    // threads of the process, see video/decoder_thread_budget.h.
+    absl::optional<int> max_decoder_threads;
+
     // Identifier for an A/V synchronization group. Empty string to disable.
     // TODO(pbos): Synchronize streams in a sync group, not just video streams
     // to one of the audio streams.
@@ -10,7 +10,56 @@
 
 #include "common_audio/include/audio_util.h"
 
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
 namespace webrtc {
+namespace {
+
+// Downmixes stereo 8 frames at a time, with the rounding towards zero of
+// DownmixInterleavedToMonoImpl(). Returns the number of frames downmixed. Each
+// output is written after the input it overwrites is read, so `interleaved`
+// and `deinterleaved` may be the same buffer.
+size_t DownmixStereoToMonoS16(const int16_t* interleaved,
+                              size_t num_frames,
+                              int16_t* deinterleaved) {
+  size_t i = 0;
+#if defined(WEBRTC_HAS_NEON)
+  for (; i + 8 <= num_frames; i += 8) {
+    const int16x8x2_t in = vld2q_s16(interleaved + 2 * i);
+    int32x4_t low = vaddl_s16(vget_low_s16(in.val[0]), vget_low_s16(in.val[1]));
+    int32x4_t high =
+        vaddl_s16(vget_high_s16(in.val[0]), vget_high_s16(in.val[1]));
+    // Adding the sign bit makes the shift round towards zero.
+    low = vsubq_s32(low, vshrq_n_s32(low, 31));
+    high = vsubq_s32(high, vshrq_n_s32(high, 31));
+    vst1q_s16(deinterleaved + i,
+              vcombine_s16(vshrn_n_s32(low, 1), vshrn_n_s32(high, 1)));
+  }
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  const __m128i ones = _mm_set1_epi16(1);
+  for (; i + 8 <= num_frames; i += 8) {
+    const __m128i* in = reinterpret_cast<const __m128i*>(interleaved + 2 * i);
+    // Sums of the left and right samples of each frame.
+    __m128i low = _mm_madd_epi16(_mm_loadu_si128(in), ones);
+    __m128i high = _mm_madd_epi16(_mm_loadu_si128(in + 1), ones);
+    // Adding the sign bit makes the shift round towards zero.
+    low = _mm_srai_epi32(_mm_add_epi32(low, _mm_srli_epi32(low, 31)), 1);
+    high = _mm_srai_epi32(_mm_add_epi32(high, _mm_srli_epi32(high, 31)), 1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(deinterleaved + i),
+                     _mm_packs_epi32(low, high));
+  }
+#endif
+  return i;
+}
+
+}  // namespace
 
 void FloatToS16(const float* src, size_t size, int16_t* dest) {
   for (size_t i = 0; i < size; ++i)
@@ -47,6 +96,17 @@ void DownmixInterleavedToMono<int16_t>(const int16_t* interleaved,
                                        size_t num_frames,
                                        int num_channels,
                                        int16_t* deinterleaved) {
+  if (num_channels == 2) {
+    RTC_DCHECK_GT(num_frames, 0);
+    const size_t downmixed =
+        DownmixStereoToMonoS16(interleaved, num_frames, deinterleaved);
+    if (downmixed == num_frames) {
+      return;
+    }
+    interleaved += 2 * downmixed;
+    deinterleaved += downmixed;
+    num_frames -= downmixed;
+  }
   DownmixInterleavedToMonoImpl<int16_t, int32_t>(interleaved, num_frames,
                                                  num_channels, deinterleaved);
 }
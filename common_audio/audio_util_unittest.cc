@@ -10,6 +10,8 @@
 
 #include "common_audio/include/audio_util.h"
 
+#include <vector>
+
 #include "rtc_base/arraysize.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -194,6 +196,25 @@ TEST(AudioUtilTest, DownmixInterleavedToMono) {
   }
 }
 
+TEST(AudioUtilTest, DownmixStereoToMonoInPlace) {
+  // Not a multiple of the frames downmixed at a time.
+  constexpr size_t kNumFrames = 21;
+  int16_t audio[2 * kNumFrames];
+  int16_t expected[kNumFrames];
+  for (size_t i = 0; i < kNumFrames; ++i) {
+    const int16_t left = static_cast<int16_t>(i * 3121 - 32768);
+    const int16_t right = static_cast<int16_t>(-static_cast<int>(i) * 1001 - 1);
+    audio[2 * i] = left;
+    audio[2 * i + 1] = right;
+    expected[i] = (static_cast<int32_t>(left) + right) / 2;
+  }
+
+  DownmixInterleavedToMono<int16_t>(audio, kNumFrames, 2, audio);
+
+  EXPECT_THAT(std::vector<int16_t>(audio, audio + kNumFrames),
+              ElementsAreArray(expected));
+}
+
 TEST(AudioUtilTest, DownmixToMonoTest) {
   {
     const size_t kNumFrames = 4;
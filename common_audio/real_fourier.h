@@ -34,9 +34,18 @@ class RealFourier {
   // The alignment required for all input and output buffers, in bytes.
   static const size_t kFftBufferAlignment;
 
+  enum class Backend {
+    // Ooura's scalar FFT, which supports all orders.
+    kOoura,
+    // PFFFT, which is vectorized on platforms with SSE or NEON. Orders below
+    // RealFourierPffft::kMinOrder fall back to Ooura.
+    kPffft,
+  };
+
   // Construct a wrapper instance for the given input order, which must be
   // between 1 and kMaxFftOrder, inclusively.
-  static std::unique_ptr<RealFourier> Create(int fft_order);
+  static std::unique_ptr<RealFourier> Create(int fft_order,
+                                             Backend backend = Backend::kOoura);
   virtual ~RealFourier() {}
 
   // Helper to compute the smallest FFT order (a power of 2) which will contain
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_audio/real_fourier_pffft.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "third_party/pffft/src/pffft.h"
+
+namespace webrtc {
+
+using std::complex;
+
+RealFourierPffft::RealFourierPffft(int fft_order)
+    : order_(fft_order),
+      length_(FftLength(order_)),
+      complex_length_(ComplexLength(order_)),
+      setup_(pffft_new_setup(static_cast<int>(length_), PFFFT_REAL)),
+      work_(AllocRealBuffer(static_cast<int>(length_))) {
+  RTC_CHECK_GE(fft_order, kMinOrder);
+  RTC_CHECK(setup_);
+}
+
+RealFourierPffft::~RealFourierPffft() {
+  pffft_destroy_setup(setup_);
+}
+
+void RealFourierPffft::Forward(const float* src, complex<float>* dest) const {
+  auto* dest_float = reinterpret_cast<float*>(dest);
+  pffft_transform_ordered(setup_, src, dest_float, work_.get(),
+                          PFFFT_FORWARD);
+
+  // PFFFT places real[n/2] in imag[0].
+  dest[complex_length_ - 1] = complex<float>(dest[0].imag(), 0.0f);
+  dest[0] = complex<float>(dest[0].real(), 0.0f);
+}
+
+void RealFourierPffft::Inverse(const complex<float>* src, float* dest) const {
+  {
+    auto* dest_complex = reinterpret_cast<complex<float>*>(dest);
+    // The real output array is shorter than the input complex array by one
+    // complex element.
+    std::copy(src, src + complex_length_ - 1, dest_complex);
+    // Restore real[n/2] to imag[0].
+    dest_complex[0] =
+        complex<float>(dest_complex[0].real(), src[complex_length_ - 1].real());
+  }
+
+  pffft_transform_ordered(setup_, dest, dest, work_.get(), PFFFT_BACKWARD);
+
+  // PFFFT doesn't scale the inverse transform.
+  const float scale = 1.0f / length_;
+  std::for_each(dest, dest + length_, [scale](float& v) { v *= scale; });
+}
+
+int RealFourierPffft::order() const {
+  return order_;
+}
+
+}  // namespace webrtc
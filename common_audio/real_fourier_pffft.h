@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_REAL_FOURIER_PFFFT_H_
+#define COMMON_AUDIO_REAL_FOURIER_PFFFT_H_
+
+#include <stddef.h>
+
+#include <complex>
+
+#include "common_audio/real_fourier.h"
+
+// Forward declaration.
+struct PFFFT_Setup;
+
+namespace webrtc {
+
+// Real DFT using PFFFT, which uses SSE or NEON when available. Supports orders
+// of at least kMinOrder.
+class RealFourierPffft : public RealFourier {
+ public:
+  static constexpr int kMinOrder = 5;
+
+  explicit RealFourierPffft(int fft_order);
+  ~RealFourierPffft() override;
+
+  void Forward(const float* src, std::complex<float>* dest) const override;
+  void Inverse(const std::complex<float>* src, float* dest) const override;
+
+  int order() const override;
+
+ private:
+  const int order_;
+  const size_t length_;
+  const size_t complex_length_;
+  PFFFT_Setup* const setup_;
+  const fft_real_scoper work_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_REAL_FOURIER_PFFFT_H_
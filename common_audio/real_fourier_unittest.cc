@@ -13,6 +13,7 @@
 #include <stdlib.h>
 
 #include "common_audio/real_fourier_ooura.h"
+#include "common_audio/real_fourier_pffft.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -99,4 +100,44 @@ TYPED_TEST(RealFourierTest, SimpleBackwardTransform) {
   EXPECT_NEAR(this->real_buffer_[3], 4.0f, 1e-8f);
 }
 
+TEST(RealFourierPffftTest, MatchesOoura) {
+  for (int order = RealFourierPffft::kMinOrder; order <= 9; ++order) {
+    SCOPED_TRACE(order);
+    const size_t length = RealFourier::FftLength(order);
+    const size_t complex_length = RealFourier::ComplexLength(order);
+    RealFourierOoura ooura(order);
+    RealFourierPffft pffft(order);
+    RealFourier::fft_real_scoper real = RealFourier::AllocRealBuffer(length);
+    RealFourier::fft_cplx_scoper ooura_cplx =
+        RealFourier::AllocCplxBuffer(complex_length);
+    RealFourier::fft_cplx_scoper pffft_cplx =
+        RealFourier::AllocCplxBuffer(complex_length);
+    for (size_t i = 0; i < length; ++i) {
+      real[i] = static_cast<float>(rand()) / RAND_MAX - 0.5f;
+    }
+
+    ooura.Forward(real.get(), ooura_cplx.get());
+    pffft.Forward(real.get(), pffft_cplx.get());
+    for (size_t i = 0; i < complex_length; ++i) {
+      EXPECT_NEAR(ooura_cplx[i].real(), pffft_cplx[i].real(), 1e-4f);
+      EXPECT_NEAR(ooura_cplx[i].imag(), pffft_cplx[i].imag(), 1e-4f);
+    }
+
+    RealFourier::fft_real_scoper inverse = RealFourier::AllocRealBuffer(length);
+    pffft.Inverse(pffft_cplx.get(), inverse.get());
+    for (size_t i = 0; i < length; ++i) {
+      EXPECT_NEAR(real[i], inverse[i], 1e-5f);
+    }
+  }
+}
+
+TEST(RealFourierPffftTest, CreateFallsBackToOouraForLowOrders) {
+  std::unique_ptr<RealFourier> fft =
+      RealFourier::Create(2, RealFourier::Backend::kPffft);
+  ASSERT_TRUE(fft);
+  EXPECT_EQ(fft->order(), 2);
+  EXPECT_TRUE(RealFourier::Create(RealFourierPffft::kMinOrder,
+                                  RealFourier::Backend::kPffft));
+}
+
 }  // namespace webrtc
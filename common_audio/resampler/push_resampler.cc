@@ -94,6 +94,12 @@ int PushResampler<T>::Resample(const T* src,
   const size_t src_length_mono = src_length / num_channels_;
   const size_t dst_capacity_mono = dst_capacity / num_channels_;
 
+  if (num_channels_ == 1) {
+    // Mono audio needs no deinterleaving, so resample it without copies.
+    return static_cast<int>(channel_resamplers_[0].resampler->Resample(
+        src, src_length_mono, dst, dst_capacity_mono));
+  }
+
   for (size_t ch = 0; ch < num_channels_; ++ch) {
     channel_data_array_[ch] = channel_resamplers_[ch].source.data();
   }
@@ -125,17 +125,23 @@ const size_t SincResampler::kKernelSize;
 void SincResampler::InitializeCPUSpecificFeatures() {
 #if defined(WEBRTC_HAS_NEON)
   convolve_proc_ = Convolve_NEON;
+  single_kernel_convolve_proc_ = ConvolveSingleKernel_NEON;
 #elif defined(WEBRTC_ARCH_X86_FAMILY)
   // Using AVX2 instead of SSE2 when AVX2/FMA3 supported.
-  if (GetCPUInfo(kAVX2) && GetCPUInfo(kFMA3))
+  if (GetCPUInfo(kAVX2) && GetCPUInfo(kFMA3)) {
     convolve_proc_ = Convolve_AVX2;
-  else if (GetCPUInfo(kSSE2))
+    single_kernel_convolve_proc_ = ConvolveSingleKernel_AVX2;
+  } else if (GetCPUInfo(kSSE2)) {
     convolve_proc_ = Convolve_SSE;
-  else
+    single_kernel_convolve_proc_ = ConvolveSingleKernel_SSE;
+  } else {
     convolve_proc_ = Convolve_C;
+    single_kernel_convolve_proc_ = ConvolveSingleKernel_C;
+  }
 #else
   // Unknown architecture.
   convolve_proc_ = Convolve_C;
+  single_kernel_convolve_proc_ = ConvolveSingleKernel_C;
 #endif
 }
 
@@ -156,10 +162,13 @@ SincResampler::SincResampler(double io_sample_rate_ratio,
       input_buffer_(static_cast<float*>(
           AlignedMalloc(sizeof(float) * input_buffer_size_, 32))),
       convolve_proc_(nullptr),
+      single_kernel_convolve_proc_(nullptr),
+      use_single_kernel_(false),
       r1_(input_buffer_.get()),
       r2_(input_buffer_.get() + kKernelSize / 2) {
   InitializeCPUSpecificFeatures();
   RTC_DCHECK(convolve_proc_);
+  RTC_DCHECK(single_kernel_convolve_proc_);
   RTC_DCHECK_GT(request_frames_, 0);
   Flush();
   RTC_DCHECK_GT(block_size_, kKernelSize);
@@ -192,6 +201,18 @@ void SincResampler::UpdateRegions(bool second_load) {
   RTC_DCHECK_LT(r2_, r3_);
 }
 
+void SincResampler::UpdateSingleKernelConvolution() {
+  // `virtual_source_idx_` only ever moves by `io_sample_rate_ratio_` and by
+  // whole blocks. If both it and the ratio are multiples of
+  // 1 / kKernelOffsetCount, it stays one, which is exact in double precision
+  // since kKernelOffsetCount is a power of two. After SetRatio() from another
+  // ratio it may not be, in which case two kernels are needed until Flush().
+  const double offsets_per_step = io_sample_rate_ratio_ * kKernelOffsetCount;
+  const double offsets = virtual_source_idx_ * kKernelOffsetCount;
+  use_single_kernel_ = offsets_per_step == floor(offsets_per_step) &&
+                       offsets == floor(offsets);
+}
+
 void SincResampler::InitializeKernel() {
   // Blackman window parameters.
   static const double kAlpha = 0.16;
@@ -236,6 +257,7 @@ void SincResampler::SetRatio(double io_sample_rate_ratio) {
   }
 
   io_sample_rate_ratio_ = io_sample_rate_ratio;
+  UpdateSingleKernelConvolution();
 
   // Optimize reinitialization by reusing values which are independent of
   // `sinc_scale_factor`.  Provides a 3x speedup.
@@ -266,6 +288,7 @@ void SincResampler::Resample(size_t frames, float* destination) {
   // Step (2) -- Resample!  const what we can outside of the loop for speed.  It
   // actually has an impact on ARM performance.  See inner loop comment below.
   const double current_io_ratio = io_sample_rate_ratio_;
+  const bool use_single_kernel = use_single_kernel_;
   const float* const kernel_ptr = kernel_storage_.get();
   while (remaining_frames) {
     // `i` may be negative if the last Resample() call ended on an iteration
@@ -303,8 +326,13 @@ void SincResampler::Resample(size_t frames, float* destination) {
       // Figure out how much to weight each kernel's "convolution".
       const double kernel_interpolation_factor =
           virtual_offset_idx - offset_idx;
-      *destination++ =
-          convolve_proc_(input_ptr, k1, k2, kernel_interpolation_factor);
+      if (use_single_kernel) {
+        RTC_DCHECK_EQ(kernel_interpolation_factor, 0);
+        *destination++ = single_kernel_convolve_proc_(input_ptr, k1);
+      } else {
+        *destination++ =
+            convolve_proc_(input_ptr, k1, k2, kernel_interpolation_factor);
+      }
 
       // Advance the virtual index.
       virtual_source_idx_ += current_io_ratio;
@@ -337,6 +365,7 @@ size_t SincResampler::ChunkSize() const {
 
 void SincResampler::Flush() {
   virtual_source_idx_ = 0;
+  UpdateSingleKernelConvolution();
   buffer_primed_ = false;
   memset(input_buffer_.get(), 0,
          sizeof(*input_buffer_.get()) * input_buffer_size_);
@@ -363,4 +392,14 @@ float SincResampler::Convolve_C(const float* input_ptr,
                             kernel_interpolation_factor * sum2);
 }
 
+float SincResampler::ConvolveSingleKernel_C(const float* input_ptr,
+                                            const float* k) {
+  float sum = 0;
+  size_t n = kKernelSize;
+  while (n--) {
+    sum += *input_ptr++ * *k++;
+  }
+  return sum;
+}
+
 }  // namespace webrtc
@@ -92,9 +92,14 @@ class SincResampler {
  private:
   FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, Convolve);
   FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, ConvolveBenchmark);
+  FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, ConvolveSingleKernel);
+  FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, UsesSingleKernelForIntegerRatio);
+  FRIEND_TEST_ALL_PREFIXES(SincResamplerTest,
+                           SetRatioToIntegerRatioKeepsSubSampleOffset);
 
   void InitializeKernel();
   void UpdateRegions(bool second_load);
+  void UpdateSingleKernelConvolution();
 
   // Selects runtime specific CPU features like SSE.  Must be called before
   // using SincResampler.
@@ -125,6 +130,19 @@ class SincResampler {
                              double kernel_interpolation_factor);
 #endif
 
+  // Compute convolution of `k` over `input_ptr`. Gives the same result as the
+  // Convolve functions above with a `kernel_interpolation_factor` of 0, at half
+  // the cost.
+  static float ConvolveSingleKernel_C(const float* input_ptr, const float* k);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  static float ConvolveSingleKernel_SSE(const float* input_ptr, const float* k);
+  static float ConvolveSingleKernel_AVX2(const float* input_ptr,
+                                         const float* k);
+#elif defined(WEBRTC_HAS_NEON)
+  static float ConvolveSingleKernel_NEON(const float* input_ptr,
+                                         const float* k);
+#endif
+
   // The ratio of input / output sample rates.
   double io_sample_rate_ratio_;
 
@@ -166,6 +184,14 @@ class SincResampler {
                                 const float*,
                                 double);
   ConvolveProc convolve_proc_;
+  typedef float (*SingleKernelConvolveProc)(const float*, const float*);
+  SingleKernelConvolveProc single_kernel_convolve_proc_;
+
+  // True if `io_sample_rate_ratio_` and `virtual_source_idx_` are multiples of
+  // 1 / kKernelOffsetCount, as for integer ratios like 48 kHz to 16 kHz. Every
+  // output sample then falls exactly on one of the kernel offsets, and needs
+  // only one convolution.
+  bool use_single_kernel_;
 
   // Pointers to the various regions inside `input_buffer_`.  See the diagram at
   // the top of the .cc file for more information.
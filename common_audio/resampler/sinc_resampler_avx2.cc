@@ -63,4 +63,30 @@ float SincResampler::Convolve_AVX2(const float* input_ptr,
   return result;
 }
 
+float SincResampler::ConvolveSingleKernel_AVX2(const float* input_ptr,
+                                               const float* k) {
+  __m256 m_sums = _mm256_setzero_ps();
+  if ((reinterpret_cast<uintptr_t>(input_ptr) & 0x1F) != 0) {
+    for (size_t i = 0; i < kKernelSize; i += 8) {
+      m_sums = _mm256_fmadd_ps(_mm256_loadu_ps(input_ptr + i),
+                               _mm256_load_ps(k + i), m_sums);
+    }
+  } else {
+    for (size_t i = 0; i < kKernelSize; i += 8) {
+      m_sums = _mm256_fmadd_ps(_mm256_load_ps(input_ptr + i),
+                               _mm256_load_ps(k + i), m_sums);
+    }
+  }
+
+  // Sum components together.
+  float result;
+  __m128 m128_sums = _mm_add_ps(_mm256_extractf128_ps(m_sums, 0),
+                                _mm256_extractf128_ps(m_sums, 1));
+  __m128 m128_half =
+      _mm_add_ps(_mm_movehl_ps(m128_sums, m128_sums), m128_sums);
+  _mm_store_ss(&result, _mm_add_ss(m128_half,
+                                   _mm_shuffle_ps(m128_half, m128_half, 1)));
+  return result;
+}
+
 }  // namespace webrtc
@@ -154,6 +154,63 @@ TEST(SincResamplerTest, Convolve) {
   EXPECT_NEAR(result2, result, kEpsilon);
 }
 
+// Ensure the single kernel Convolve() methods return exactly what the two
+// kernel methods return when no interpolation is needed.
+TEST(SincResamplerTest, ConvolveSingleKernel) {
+  MockSource mock_source;
+  SincResampler resampler(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                          &mock_source);
+  const float* const kernel = resampler.kernel_storage_.get();
+  const float* const other_kernel = kernel + SincResampler::kKernelSize;
+
+  for (const float* input : {kernel, kernel + 1}) {
+    EXPECT_EQ(resampler.ConvolveSingleKernel_C(input, kernel),
+              resampler.Convolve_C(input, kernel, other_kernel, 0));
+    EXPECT_EQ(resampler.single_kernel_convolve_proc_(input, kernel),
+              resampler.convolve_proc_(input, kernel, other_kernel, 0));
+  }
+}
+
+TEST(SincResamplerTest, UsesSingleKernelForIntegerRatio) {
+  MockSource mock_source;
+  SincResampler resampler(48000.0 / 16000.0, SincResampler::kDefaultRequestSize,
+                          &mock_source);
+  EXPECT_TRUE(resampler.use_single_kernel_);
+  resampler.SetRatio(kSampleRateRatio);
+  EXPECT_FALSE(resampler.use_single_kernel_);
+  resampler.SetRatio(16000.0 / 32000.0);
+  EXPECT_TRUE(resampler.use_single_kernel_);
+  resampler.SetRatio(16000.0 / 48000.0);
+  EXPECT_FALSE(resampler.use_single_kernel_);
+}
+
+// Switching to an integer ratio after resampling with another ratio leaves a
+// sub-sample offset that a single kernel can't interpolate, until flushed.
+TEST(SincResamplerTest, SetRatioToIntegerRatioKeepsSubSampleOffset) {
+  MockSource mock_source;
+  SincResampler resampler(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                          &mock_source);
+  EXPECT_CALL(mock_source, Run(_, _)).WillRepeatedly(FillBuffer());
+  constexpr size_t kFrames = 100;
+  float resampled_destination[kFrames];
+  resampler.Resample(kFrames, resampled_destination);
+  const double offsets =
+      resampler.virtual_source_idx_ * SincResampler::kKernelOffsetCount;
+  ASSERT_NE(offsets, floor(offsets));
+
+  resampler.SetRatio(48000.0 / 16000.0);
+  EXPECT_FALSE(resampler.use_single_kernel_);
+  // Resampling still interpolates between kernels, e.g. without hitting the
+  // DCHECK of the single kernel path.
+  resampler.Resample(kFrames, resampled_destination);
+  EXPECT_FALSE(resampler.use_single_kernel_);
+
+  resampler.Flush();
+  EXPECT_TRUE(resampler.use_single_kernel_);
+  resampler.Resample(kFrames, resampled_destination);
+  EXPECT_TRUE(resampler.use_single_kernel_);
+}
+
 // Benchmark for the various Convolve() methods.  Make sure to build with
 // branding=Chrome so that RTC_DCHECKs are compiled out when benchmarking.
 // Original benchmarks were run with --convolve-iterations=50000000.
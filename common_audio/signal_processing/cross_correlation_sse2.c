@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+/* SSE2 version of WebRtcSpl_CrossCorrelation() for x86-64 platforms. Each
+ * product is shifted before it's added, as in the C version, so that the
+ * results are bit exact. */
+void WebRtcSpl_CrossCorrelationSse2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  const size_t vector_length = dim_seq & ~(size_t)7;
+  const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+  size_t i = 0, j = 0;
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    __m128i sum = _mm_setzero_si128();
+    for (j = 0; j < vector_length; j += 8) {
+      const __m128i x = _mm_loadu_si128((const __m128i*)&seq1[j]);
+      const __m128i y = _mm_loadu_si128((const __m128i*)&seq2[j]);
+      const __m128i low = _mm_mullo_epi16(x, y);
+      const __m128i high = _mm_mulhi_epi16(x, y);
+      sum = _mm_add_epi32(
+          sum, _mm_sra_epi32(_mm_unpacklo_epi16(low, high), shift));
+      sum = _mm_add_epi32(
+          sum, _mm_sra_epi32(_mm_unpackhi_epi16(low, high), shift));
+    }
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+    int32_t corr = _mm_cvtsi128_si32(sum);
+    for (; j < dim_seq; j++)
+      corr += (seq1[j] * seq2[j]) >> right_shifts;
+    seq2 += step_seq2;
+    *cross_correlation++ = corr;
+  }
+}
@@ -535,11 +535,11 @@ TEST(SplTest, CrossCorrelationTest) {
                              kCrossCorrelationDimension, kShift, kStep);
 
   // WebRtcSpl_CrossCorrelationC() and WebRtcSpl_CrossCorrelationNeon()
-  // are not bit-exact.
+  // are not bit-exact, while WebRtcSpl_CrossCorrelationSse2() is.
   const int32_t kExpected[kCrossCorrelationDimension] = {-266947903, -15579555,
                                                          -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] = {
       -266947901, -15579553, -171281999};
   if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
@@ -551,6 +551,47 @@ TEST(SplTest, CrossCorrelationTest) {
   }
 }
 
+#if defined(WEBRTC_ARCH_X86_64)
+TEST(SplTest, Sse2MatchesC) {
+  // Long enough for both the vectorized loops and their scalar tails.
+  const size_t kSeqDimension = 83;
+  const size_t kCrossCorrelationDimension = 7;
+  const size_t kSize = kSeqDimension + kCrossCorrelationDimension;
+  int16_t seq1[kSize];
+  int16_t seq2[kSize];
+  uint32_t seed = 1;
+  for (size_t i = 0; i < kSize; ++i) {
+    seq1[i] = WebRtcSpl_RandU(&seed) * 2 - WEBRTC_SPL_WORD16_MAX;
+    seq2[i] = WebRtcSpl_RandU(&seed) * 2 - WEBRTC_SPL_WORD16_MAX;
+  }
+  seq1[3] = WEBRTC_SPL_WORD16_MIN;
+  seq2[5] = WEBRTC_SPL_WORD16_MIN;
+
+  for (int shift = 0; shift < 8; shift += 3) {
+    for (int step : {1, -1}) {
+      const int16_t* seq2_start =
+          step > 0 ? seq2 : seq2 + kCrossCorrelationDimension - 1;
+      int32_t expected[kCrossCorrelationDimension];
+      int32_t result[kCrossCorrelationDimension];
+      WebRtcSpl_CrossCorrelationC(expected, seq1, seq2_start, kSeqDimension,
+                                  kCrossCorrelationDimension, shift, step);
+      WebRtcSpl_CrossCorrelationSse2(result, seq1, seq2_start, kSeqDimension,
+                                     kCrossCorrelationDimension, shift, step);
+      for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
+        EXPECT_EQ(expected[i], result[i]);
+      }
+    }
+  }
+
+  for (size_t length = 1; length <= kSize; ++length) {
+    EXPECT_EQ(WebRtcSpl_MaxAbsValueW16C(seq1, length),
+              WebRtcSpl_MaxAbsValueW16Sse2(seq1, length));
+    EXPECT_EQ(WebRtcSpl_MaxAbsValueW16C(seq2, length),
+              WebRtcSpl_MaxAbsValueW16Sse2(seq2, length));
+  }
+}
+#endif
+
 TEST(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
@@ -71,6 +71,30 @@ int WebRtcVad_Process(VadInst* handle,
                       const int16_t* audio_frame,
                       size_t frame_length);
 
+// Calculates VAD decisions for one audio frame of each of `num_handles`
+// streams, which have the same sampling frequency and frame length. The
+// decisions are the same as from calling WebRtcVad_Process() for each stream,
+// but the feature extraction of several streams is vectorized, which makes
+// it cheaper per stream when there are many streams.
+//
+// - handles       [i/o] : VAD instances of the streams. Need to be initialized
+//                         by WebRtcVad_Init() before call.
+// - fs            [i]   : Sampling frequency (Hz): 8000, 16000, or 32000
+// - audio_frames  [i]   : Audio frame buffer of each stream.
+// - frame_length  [i]   : Length of each audio frame buffer in number of
+//                         samples.
+// - num_handles   [i]   : Number of streams.
+// - vad_decisions [o]   : Decision of each stream, 1 - (Active Voice) or
+//                         0 - (Non-active Voice).
+//
+// returns               : 0 - (OK), -1 - (Error, no instance is changed)
+int WebRtcVad_ProcessBatch(VadInst* const* handles,
+                           int fs,
+                           const int16_t* const* audio_frames,
+                           size_t frame_length,
+                           size_t num_handles,
+                           int* vad_decisions);
+
 // Checks for valid combinations of `rate` and `frame_length`. We support 10,
 // 20 and 30 ms frames and the rates 8000, 16000 and 32000 Hz.
 //
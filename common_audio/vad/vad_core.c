@@ -10,6 +10,7 @@
 
 #include "common_audio/vad/vad_core.h"
 
+#include "rtc_base/checks.h"
 #include "rtc_base/sanitizer.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "common_audio/vad/vad_filterbank.h"
@@ -601,72 +602,76 @@ int WebRtcVad_set_mode_core(VadInstT* self, int mode) {
   return return_value;
 }
 
+// Downsamples `speech_frame`, sampled at `fs`, to 8 kHz, and returns the
+// number of samples written to `speech_nb`.
+static size_t DownsampleTo8khz(VadInstT* inst, int fs,
+                               const int16_t* speech_frame,
+                               size_t frame_length, int16_t* speech_nb) {
+  if (fs == 48000) {
+    size_t i;
+    // `tmp_mem` is a temporary memory used by resample function, length is
+    // frame length in 10 ms (480 samples) + 256 extra.
+    int32_t tmp_mem[480 + 256] = { 0 };
+    const size_t kFrameLen10ms48khz = 480;
+    const size_t kFrameLen10ms8khz = 80;
+    size_t num_10ms_frames = frame_length / kFrameLen10ms48khz;
+
+    for (i = 0; i < num_10ms_frames; i++) {
+      WebRtcSpl_Resample48khzTo8khz(speech_frame,
+                                    &speech_nb[i * kFrameLen10ms8khz],
+                                    &inst->state_48_to_8,
+                                    tmp_mem);
+    }
+    return frame_length / 6;
+  }
+  if (fs == 32000) {
+    // Downsampled speech frame: 960 samples (30ms in SWB).
+    int16_t speech_wb[480];
+
+    // Downsample signal 32->16->8.
+    WebRtcVad_Downsampling(speech_frame, speech_wb,
+                           &(inst->downsampling_filter_states[2]),
+                           frame_length);
+    WebRtcVad_Downsampling(speech_wb, speech_nb,
+                           inst->downsampling_filter_states, frame_length / 2);
+    return frame_length / 4;
+  }
+  RTC_DCHECK_EQ(fs, 16000);
+  WebRtcVad_Downsampling(speech_frame, speech_nb,
+                         inst->downsampling_filter_states, frame_length);
+  return frame_length / 2;
+}
+
 // Calculate VAD decision by first extracting feature values and then calculate
 // probability for both speech and background noise.
 
 int WebRtcVad_CalcVad48khz(VadInstT* inst, const int16_t* speech_frame,
                            size_t frame_length) {
-  int vad;
-  size_t i;
   int16_t speech_nb[240];  // 30 ms in 8 kHz.
-  // `tmp_mem` is a temporary memory used by resample function, length is
-  // frame length in 10 ms (480 samples) + 256 extra.
-  int32_t tmp_mem[480 + 256] = { 0 };
-  const size_t kFrameLen10ms48khz = 480;
-  const size_t kFrameLen10ms8khz = 80;
-  size_t num_10ms_frames = frame_length / kFrameLen10ms48khz;
-
-  for (i = 0; i < num_10ms_frames; i++) {
-    WebRtcSpl_Resample48khzTo8khz(speech_frame,
-                                  &speech_nb[i * kFrameLen10ms8khz],
-                                  &inst->state_48_to_8,
-                                  tmp_mem);
-  }
+  size_t len = DownsampleTo8khz(inst, 48000, speech_frame, frame_length,
+                                speech_nb);
 
   // Do VAD on an 8 kHz signal
-  vad = WebRtcVad_CalcVad8khz(inst, speech_nb, frame_length / 6);
-
-  return vad;
+  return WebRtcVad_CalcVad8khz(inst, speech_nb, len);
 }
 
 int WebRtcVad_CalcVad32khz(VadInstT* inst, const int16_t* speech_frame,
-                           size_t frame_length)
-{
-    size_t len;
-    int vad;
-    int16_t speechWB[480]; // Downsampled speech frame: 960 samples (30ms in SWB)
-    int16_t speechNB[240]; // Downsampled speech frame: 480 samples (30ms in WB)
-
-
-    // Downsample signal 32->16->8 before doing VAD
-    WebRtcVad_Downsampling(speech_frame, speechWB, &(inst->downsampling_filter_states[2]),
-                           frame_length);
-    len = frame_length / 2;
-
-    WebRtcVad_Downsampling(speechWB, speechNB, inst->downsampling_filter_states, len);
-    len /= 2;
-
-    // Do VAD on an 8 kHz signal
-    vad = WebRtcVad_CalcVad8khz(inst, speechNB, len);
+                           size_t frame_length) {
+  int16_t speech_nb[240];  // Downsampled speech frame: 480 samples (30ms in WB)
+  size_t len = DownsampleTo8khz(inst, 32000, speech_frame, frame_length,
+                                speech_nb);
 
-    return vad;
+  // Do VAD on an 8 kHz signal
+  return WebRtcVad_CalcVad8khz(inst, speech_nb, len);
 }
 
 int WebRtcVad_CalcVad16khz(VadInstT* inst, const int16_t* speech_frame,
-                           size_t frame_length)
-{
-    size_t len;
-    int vad;
-    int16_t speechNB[240]; // Downsampled speech frame: 480 samples (30ms in WB)
-
-    // Wideband: Downsample signal before doing VAD
-    WebRtcVad_Downsampling(speech_frame, speechNB, inst->downsampling_filter_states,
-                           frame_length);
-
-    len = frame_length / 2;
-    vad = WebRtcVad_CalcVad8khz(inst, speechNB, len);
+                           size_t frame_length) {
+  int16_t speech_nb[240];  // Downsampled speech frame: 480 samples (30ms in WB)
+  size_t len = DownsampleTo8khz(inst, 16000, speech_frame, frame_length,
+                                speech_nb);
 
-    return vad;
+  return WebRtcVad_CalcVad8khz(inst, speech_nb, len);
 }
 
 int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
@@ -683,3 +688,44 @@ int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
 
     return inst->vad;
 }
+
+// Number of streams processed at a time by WebRtcVad_CalcVadBatch(), which
+// bounds the size of the temporary buffers.
+enum { kMaxBatchStreams = 16 };
+
+void WebRtcVad_CalcVadBatch(VadInstT* const* insts, int fs,
+                            const int16_t* const* speech_frames,
+                            size_t num_streams, size_t frame_length,
+                            int* vads) {
+  int16_t speech_nb[kMaxBatchStreams][240];  // 30 ms in 8 kHz.
+  const int16_t* frames_nb[kMaxBatchStreams];
+  int16_t features[kMaxBatchStreams * kNumChannels];
+  int16_t total_power[kMaxBatchStreams];
+  size_t i, k;
+
+  for (i = 0; i < num_streams; i += kMaxBatchStreams) {
+    const size_t batch_size = num_streams - i < kMaxBatchStreams
+                                  ? num_streams - i
+                                  : kMaxBatchStreams;
+    size_t len = frame_length;
+    for (k = 0; k < batch_size; k++) {
+      if (fs == 8000) {
+        frames_nb[k] = speech_frames[i + k];
+      } else {
+        len = DownsampleTo8khz(insts[i + k], fs, speech_frames[i + k],
+                               frame_length, speech_nb[k]);
+        frames_nb[k] = speech_nb[k];
+      }
+    }
+
+    WebRtcVad_CalculateFeaturesBatch(&insts[i], frames_nb, batch_size, len,
+                                     features, total_power);
+
+    for (k = 0; k < batch_size; k++) {
+      VadInstT* inst = insts[i + k];
+      inst->vad = GmmProbability(inst, &features[k * kNumChannels],
+                                 total_power[k], len);
+      vads[i + k] = inst->vad;
+    }
+  }
+}
@@ -120,4 +120,32 @@ int WebRtcVad_CalcVad8khz(VadInstT* inst,
                           const int16_t* speech_frame,
                           size_t frame_length);
 
+/****************************************************************************
+ * WebRtcVad_CalcVadBatch(...)
+ *
+ * Makes VAD decisions for one frame of each of `num_streams` streams with the
+ * same sample rate and frame length. The decisions and the updated instances
+ * are the same as from calling WebRtcVad_CalcVad*khz() for each stream, but
+ * the feature extraction of several streams runs in lockstep, see
+ * WebRtcVad_CalculateFeaturesBatch().
+ *
+ * Input:
+ *      - insts         : Instances of the streams
+ *      - fs            : Sample rate, 8000, 16000, 32000 or 48000 Hz
+ *      - speech_frames : Input speech frames of the streams
+ *      - num_streams   : Number of streams
+ *      - frame_length  : Number of input samples of each stream
+ *
+ * Output:
+ *      - insts         : Updated filter states etc.
+ *      - vads          : VAD decision of each stream, as returned by
+ *                        WebRtcVad_CalcVad*khz()
+ */
+void WebRtcVad_CalcVadBatch(VadInstT* const* insts,
+                            int fs,
+                            const int16_t* const* speech_frames,
+                            size_t num_streams,
+                            size_t frame_length,
+                            int* vads);
+
 #endif  // COMMON_AUDIO_VAD_VAD_CORE_H_
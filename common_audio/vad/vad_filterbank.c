@@ -10,6 +10,12 @@
 
 #include "common_audio/vad/vad_filterbank.h"
 
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_64)
+#include <emmintrin.h>
+#endif
+
 #include "rtc_base/checks.h"
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 
@@ -327,3 +333,216 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
 
   return total_energy;
 }
+
+#if defined(WEBRTC_ARCH_X86_64)
+// The filters of `kLanes` streams run in lockstep, one stream per vector
+// lane. Signals are interleaved, with sample `i` of the stream in lane `k` at
+// index `i * kLanes + k`, and each sample stored as an int32_t holding the
+// int16_t value of the scalar version of the filter.
+#define kLanes 4
+
+typedef __m128i Lanes;
+#define LoadLanes(data) _mm_loadu_si128((const __m128i*)(data))
+#define StoreLanes(data, lanes) _mm_storeu_si128((__m128i*)(data), (lanes))
+#define AddLanes(a, b) _mm_add_epi32((a), (b))
+#define SubLanes(a, b) _mm_sub_epi32((a), (b))
+#define ShiftLeftLanes(a, shift) _mm_slli_epi32((a), (shift))
+#define ShiftRightLanes(a, shift) _mm_srai_epi32((a), (shift))
+// Multiplies lanes holding int16_t values with an int16_t coefficient. SSE2
+// has no 32 bit multiplication, but since the upper half of each coefficient
+// lane is zero, multiplying and adding the 16 bit halves gives the product.
+#define CoefficientLanes(coefficient) \
+  _mm_set1_epi32((int32_t)(uint16_t)(coefficient))
+#define MulLanes(a, coefficient) _mm_madd_epi16((a), (coefficient))
+
+// Truncates the lanes to int16_t values, like a cast to int16_t does.
+#define Int16Lanes(a) ShiftRightLanes(ShiftLeftLanes((a), 16), 16)
+
+// Lockstep version of HighPassFilter().
+static void HighPassFilterLanes(const int32_t* data_in, size_t data_length,
+                                int32_t filter_state[4][kLanes],
+                                int32_t* data_out) {
+  size_t i;
+  const Lanes zero_coef_0 = CoefficientLanes(kHpZeroCoefs[0]);
+  const Lanes zero_coef_1 = CoefficientLanes(kHpZeroCoefs[1]);
+  const Lanes zero_coef_2 = CoefficientLanes(kHpZeroCoefs[2]);
+  const Lanes pole_coef_1 = CoefficientLanes(kHpPoleCoefs[1]);
+  const Lanes pole_coef_2 = CoefficientLanes(kHpPoleCoefs[2]);
+  Lanes state_0 = LoadLanes(filter_state[0]);
+  Lanes state_1 = LoadLanes(filter_state[1]);
+  Lanes state_2 = LoadLanes(filter_state[2]);
+  Lanes state_3 = LoadLanes(filter_state[3]);
+
+  for (i = 0; i < data_length; i++) {
+    const Lanes in = LoadLanes(&data_in[i * kLanes]);
+    Lanes tmp32 = MulLanes(in, zero_coef_0);
+    tmp32 = AddLanes(tmp32, MulLanes(state_0, zero_coef_1));
+    tmp32 = AddLanes(tmp32, MulLanes(state_1, zero_coef_2));
+    state_1 = state_0;
+    state_0 = in;
+
+    tmp32 = SubLanes(tmp32, MulLanes(state_2, pole_coef_1));
+    tmp32 = SubLanes(tmp32, MulLanes(state_3, pole_coef_2));
+    state_3 = state_2;
+    state_2 = Int16Lanes(ShiftRightLanes(tmp32, 14));
+    StoreLanes(&data_out[i * kLanes], state_2);
+  }
+
+  StoreLanes(filter_state[0], state_0);
+  StoreLanes(filter_state[1], state_1);
+  StoreLanes(filter_state[2], state_2);
+  StoreLanes(filter_state[3], state_3);
+}
+
+// Lockstep version of AllPassFilter().
+static void AllPassFilterLanes(const int32_t* data_in, size_t data_length,
+                               int16_t filter_coefficient,
+                               int32_t* filter_state, int32_t* data_out) {
+  size_t i;
+  const Lanes coef = CoefficientLanes(filter_coefficient);
+  Lanes state32 = ShiftLeftLanes(LoadLanes(filter_state), 16);  // Q15
+
+  for (i = 0; i < data_length; i++) {
+    const Lanes in = LoadLanes(data_in);
+    const Lanes tmp16 = Int16Lanes(
+        ShiftRightLanes(AddLanes(state32, MulLanes(in, coef)), 16));  // Q(-1)
+    StoreLanes(&data_out[i * kLanes], tmp16);
+    state32 = SubLanes(ShiftLeftLanes(in, 14), MulLanes(tmp16, coef));  // Q14
+    state32 = ShiftLeftLanes(state32, 1);  // Q15.
+    data_in += 2 * kLanes;
+  }
+
+  StoreLanes(filter_state, Int16Lanes(ShiftRightLanes(state32, 16)));
+}
+
+// Lockstep version of SplitFilter(), with the states of the `kLanes` streams
+// given by `upper_state` and `lower_state`.
+static void SplitFilterLanes(const int32_t* data_in, size_t data_length,
+                             int32_t* upper_state, int32_t* lower_state,
+                             int32_t* hp_data_out, int32_t* lp_data_out) {
+  size_t i;
+  size_t half_length = data_length >> 1;  // Downsampling by 2.
+
+  AllPassFilterLanes(&data_in[0], half_length, kAllPassCoefsQ15[0],
+                     upper_state, hp_data_out);
+  AllPassFilterLanes(&data_in[kLanes], half_length, kAllPassCoefsQ15[1],
+                     lower_state, lp_data_out);
+
+  // Make LP and HP signals.
+  for (i = 0; i < half_length * kLanes; i += kLanes) {
+    const Lanes hp = LoadLanes(&hp_data_out[i]);
+    const Lanes lp = LoadLanes(&lp_data_out[i]);
+    StoreLanes(&hp_data_out[i], Int16Lanes(SubLanes(hp, lp)));
+    StoreLanes(&lp_data_out[i], Int16Lanes(AddLanes(lp, hp)));
+  }
+}
+
+// Applies LogOfEnergy() to the signal of each stream in `data_in`.
+static void LogOfEnergyLanes(const int32_t* data_in, size_t data_length,
+                             int channel, int16_t* total_energy,
+                             int16_t* features) {
+  int16_t data[120];
+  size_t i;
+  int k;
+
+  for (k = 0; k < kLanes; k++) {
+    for (i = 0; i < data_length; i++) {
+      data[i] = (int16_t) data_in[i * kLanes + k];
+    }
+    LogOfEnergy(data, data_length, kOffsetVector[channel], &total_energy[k],
+                &features[k * kNumChannels + channel]);
+  }
+}
+
+// Calculates the features of `kLanes` streams, like
+// WebRtcVad_CalculateFeatures() does for each of them.
+static void CalculateFeaturesLanes(VadInstT* const* selves,
+                                   const int16_t* const* data_in,
+                                   size_t data_length, int16_t* features,
+                                   int16_t* total_energy) {
+  int32_t in[240 * kLanes];
+  int32_t hp_120[120 * kLanes], lp_120[120 * kLanes];
+  int32_t hp_60[60 * kLanes], lp_60[60 * kLanes];
+  int32_t upper_state[kNumChannels - 1][kLanes];
+  int32_t lower_state[kNumChannels - 1][kLanes];
+  int32_t hp_filter_state[4][kLanes];
+  const size_t half_data_length = data_length >> 1;
+  size_t length = half_data_length;
+  size_t i;
+  int band, k;
+
+  RTC_DCHECK_LE(data_length, 240);
+
+  for (k = 0; k < kLanes; k++) {
+    for (i = 0; i < data_length; i++) {
+      in[i * kLanes + k] = data_in[k][i];
+    }
+    for (band = 0; band < kNumChannels - 1; band++) {
+      upper_state[band][k] = selves[k]->upper_state[band];
+      lower_state[band][k] = selves[k]->lower_state[band];
+    }
+    for (i = 0; i < 4; i++) {
+      hp_filter_state[i][k] = selves[k]->hp_filter_state[i];
+    }
+    total_energy[k] = 0;
+  }
+
+  // The same bands, in the same order, as WebRtcVad_CalculateFeatures().
+  SplitFilterLanes(in, data_length, upper_state[0], lower_state[0], hp_120,
+                   lp_120);
+
+  SplitFilterLanes(hp_120, length, upper_state[1], lower_state[1], hp_60,
+                   lp_60);
+  length >>= 1;
+  LogOfEnergyLanes(hp_60, length, 5, total_energy, features);
+  LogOfEnergyLanes(lp_60, length, 4, total_energy, features);
+
+  length = half_data_length;
+  SplitFilterLanes(lp_120, length, upper_state[2], lower_state[2], hp_60,
+                   lp_60);
+  length >>= 1;
+  LogOfEnergyLanes(hp_60, length, 3, total_energy, features);
+
+  SplitFilterLanes(lp_60, length, upper_state[3], lower_state[3], hp_120,
+                   lp_120);
+  length >>= 1;
+  LogOfEnergyLanes(hp_120, length, 2, total_energy, features);
+
+  SplitFilterLanes(lp_120, length, upper_state[4], lower_state[4], hp_60,
+                   lp_60);
+  length >>= 1;
+  LogOfEnergyLanes(hp_60, length, 1, total_energy, features);
+
+  HighPassFilterLanes(lp_60, length, hp_filter_state, hp_120);
+  LogOfEnergyLanes(hp_120, length, 0, total_energy, features);
+
+  for (k = 0; k < kLanes; k++) {
+    for (band = 0; band < kNumChannels - 1; band++) {
+      selves[k]->upper_state[band] = (int16_t) upper_state[band][k];
+      selves[k]->lower_state[band] = (int16_t) lower_state[band][k];
+    }
+    for (i = 0; i < 4; i++) {
+      selves[k]->hp_filter_state[i] = (int16_t) hp_filter_state[i][k];
+    }
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_64)
+
+void WebRtcVad_CalculateFeaturesBatch(VadInstT* const* selves,
+                                      const int16_t* const* data_in,
+                                      size_t num_streams, size_t data_length,
+                                      int16_t* features,
+                                      int16_t* total_energy) {
+  size_t i = 0;
+
+#if defined(WEBRTC_ARCH_X86_64)
+  for (; i + kLanes <= num_streams; i += kLanes) {
+    CalculateFeaturesLanes(&selves[i], &data_in[i], data_length,
+                           &features[i * kNumChannels], &total_energy[i]);
+  }
+#endif
+  for (; i < num_streams; i++) {
+    total_energy[i] = WebRtcVad_CalculateFeatures(
+        selves[i], data_in[i], data_length, &features[i * kNumChannels]);
+  }
+}
@@ -42,4 +42,23 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self,
                                     size_t data_length,
                                     int16_t* features);
 
+// Calculates the features of one frame of each of `num_streams` streams, with
+// the same result as calling WebRtcVad_CalculateFeatures() for each stream.
+// On x86-64, the filters of four streams at a time run in lockstep with SSE2,
+// one stream per vector lane.
+//
+// - selves       [i/o] : State information of the VAD of each stream.
+// - data_in      [i]   : Input audio data of each stream.
+// - num_streams  [i]   : Number of streams.
+// - data_length  [i]   : Audio data size of each stream, in number of samples.
+// - features     [o]   : `kNumChannels` features per stream. The features of
+//                        stream `i` start at `features[i * kNumChannels]`.
+// - total_energy [o]   : Total energy of the signal of each stream.
+void WebRtcVad_CalculateFeaturesBatch(VadInstT* const* selves,
+                                      const int16_t* const* data_in,
+                                      size_t num_streams,
+                                      size_t data_length,
+                                      int16_t* features,
+                                      int16_t* total_energy);
+
 #endif  // COMMON_AUDIO_VAD_VAD_FILTERBANK_H_
@@ -9,6 +9,9 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
+
+#include <vector>
 
 #include "common_audio/vad/vad_unittest.h"
 #include "test/gtest.h"
@@ -87,5 +90,57 @@ TEST_F(VadTest, vad_filterbank) {
 
   free(self);
 }
+
+TEST_F(VadTest, vad_filterbank_batch) {
+  // An odd number of streams, so that both the vectorized streams and the
+  // remaining streams are covered.
+  constexpr size_t kNumStreams = 7;
+  constexpr int kNumFrames = 20;
+  std::vector<VadInstT> selves(kNumStreams);
+  std::vector<VadInstT> batch_selves(kNumStreams);
+  std::vector<VadInstT*> batch_self_ptrs(kNumStreams);
+  std::vector<std::vector<int16_t>> speech(
+      kNumStreams, std::vector<int16_t>(kMaxFrameLength));
+  std::vector<const int16_t*> speech_ptrs(kNumStreams);
+  int16_t features[kNumChannels];
+  int16_t batch_features[kNumStreams * kNumChannels];
+  int16_t batch_total_energy[kNumStreams];
+
+  for (size_t j = 0; j < kFrameLengthsSize; ++j) {
+    if (!ValidRatesAndFrameLengths(8000, kFrameLengths[j])) {
+      continue;
+    }
+    for (size_t k = 0; k < kNumStreams; ++k) {
+      ASSERT_EQ(0, WebRtcVad_InitCore(&selves[k]));
+      ASSERT_EQ(0, WebRtcVad_InitCore(&batch_selves[k]));
+      batch_self_ptrs[k] = &batch_selves[k];
+      speech_ptrs[k] = speech[k].data();
+    }
+    // Pseudo random signals with different levels per stream, including full
+    // scale ones where the scalar filters wrap around.
+    uint32_t seed = 17;
+    for (int frame = 0; frame < kNumFrames; ++frame) {
+      for (size_t k = 0; k < kNumStreams; ++k) {
+        for (size_t i = 0; i < kFrameLengths[j]; ++i) {
+          seed = seed * 1664525 + 1013904223;
+          speech[k][i] = static_cast<int16_t>(seed >> 16) >> (2 * k);
+        }
+      }
+      WebRtcVad_CalculateFeaturesBatch(batch_self_ptrs.data(),
+                                       speech_ptrs.data(), kNumStreams,
+                                       kFrameLengths[j], batch_features,
+                                       batch_total_energy);
+      for (size_t k = 0; k < kNumStreams; ++k) {
+        EXPECT_EQ(WebRtcVad_CalculateFeatures(&selves[k], speech[k].data(),
+                                              kFrameLengths[j], features),
+                  batch_total_energy[k]);
+        for (int c = 0; c < kNumChannels; ++c) {
+          EXPECT_EQ(features[c], batch_features[k * kNumChannels + c]);
+        }
+        EXPECT_EQ(0, memcmp(&selves[k], &batch_selves[k], sizeof(VadInstT)));
+      }
+    }
+  }
+}
 }  // namespace test
 }  // namespace webrtc
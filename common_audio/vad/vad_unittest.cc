@@ -11,6 +11,9 @@
 #include "common_audio/vad/vad_unittest.h"
 
 #include <stdlib.h>
+#include <string.h>
+
+#include <vector>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
 #include "common_audio/vad/include/webrtc_vad.h"
@@ -18,6 +21,10 @@
 #include "rtc_base/checks.h"
 #include "test/gtest.h"
 
+extern "C" {
+#include "common_audio/vad/vad_core.h"
+}
+
 VadTest::VadTest() {}
 
 void VadTest::SetUp() {}
@@ -142,6 +149,80 @@ TEST_F(VadTest, ValidRatesFrameLengths) {
   }
 }
 
+TEST_F(VadTest, ProcessBatch) {
+  // More streams than are processed at a time internally.
+  constexpr size_t kNumStreams = 19;
+  constexpr int kNumFrames = 10;
+  std::vector<VadInst*> handles(kNumStreams);
+  std::vector<VadInst*> batch_handles(kNumStreams);
+  std::vector<std::vector<int16_t>> speech(
+      kNumStreams, std::vector<int16_t>(kMaxFrameLength));
+  std::vector<const int16_t*> speech_ptrs(kNumStreams);
+  std::vector<int> decisions(kNumStreams);
+  for (size_t k = 0; k < kNumStreams; ++k) {
+    handles[k] = WebRtcVad_Create();
+    batch_handles[k] = WebRtcVad_Create();
+    // Zeroed, so that the instances can be compared as a whole.
+    memset(handles[k], 0, sizeof(VadInstT));
+    memset(batch_handles[k], 0, sizeof(VadInstT));
+    speech_ptrs[k] = speech[k].data();
+  }
+
+  // Uninitialized instances.
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles.data(), kRates[0],
+                                       speech_ptrs.data(), kFrameLengths[0],
+                                       kNumStreams, decisions.data()));
+
+  for (size_t m = 0; m < kModesSize; ++m) {
+    for (size_t i = 0; i < kRatesSize; ++i) {
+      for (size_t j = 0; j < kFrameLengthsSize; ++j) {
+        for (size_t k = 0; k < kNumStreams; ++k) {
+          ASSERT_EQ(0, WebRtcVad_Init(handles[k]));
+          ASSERT_EQ(0, WebRtcVad_Init(batch_handles[k]));
+          ASSERT_EQ(0, WebRtcVad_set_mode(handles[k], kModes[m]));
+          ASSERT_EQ(0, WebRtcVad_set_mode(batch_handles[k], kModes[m]));
+        }
+        if (!ValidRatesAndFrameLengths(kRates[i], kFrameLengths[j])) {
+          EXPECT_EQ(-1, WebRtcVad_ProcessBatch(
+                            batch_handles.data(), kRates[i], speech_ptrs.data(),
+                            kFrameLengths[j], kNumStreams, decisions.data()));
+          continue;
+        }
+        // Bursts of pseudo random noise with different levels per stream,
+        // so that the decisions differ between streams and frames.
+        uint32_t seed = 4711;
+        for (int frame = 0; frame < kNumFrames; ++frame) {
+          for (size_t k = 0; k < kNumStreams; ++k) {
+            const int shift = (k + frame) % 12;
+            for (size_t n = 0; n < kFrameLengths[j]; ++n) {
+              seed = seed * 1664525 + 1013904223;
+              speech[k][n] = static_cast<int16_t>(seed >> 16) >> shift;
+            }
+          }
+          ASSERT_EQ(0, WebRtcVad_ProcessBatch(batch_handles.data(), kRates[i],
+                                              speech_ptrs.data(),
+                                              kFrameLengths[j], kNumStreams,
+                                              decisions.data()));
+          for (size_t k = 0; k < kNumStreams; ++k) {
+            EXPECT_EQ(WebRtcVad_Process(handles[k], kRates[i],
+                                        speech[k].data(), kFrameLengths[j]),
+                      decisions[k]);
+          }
+        }
+        for (size_t k = 0; k < kNumStreams; ++k) {
+          EXPECT_EQ(0, memcmp(handles[k], batch_handles[k],
+                              sizeof(VadInstT)));
+        }
+      }
+    }
+  }
+
+  for (size_t k = 0; k < kNumStreams; ++k) {
+    WebRtcVad_Free(handles[k]);
+    WebRtcVad_Free(batch_handles[k]);
+  }
+}
+
 // TODO(bjornv): Add a process test, run on file.
 
 }  // namespace test
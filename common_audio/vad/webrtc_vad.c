@@ -88,6 +88,37 @@ int WebRtcVad_Process(VadInst* handle, int fs, const int16_t* audio_frame,
   return vad;
 }
 
+int WebRtcVad_ProcessBatch(VadInst* const* handles, int fs,
+                           const int16_t* const* audio_frames,
+                           size_t frame_length, size_t num_handles,
+                           int* vad_decisions) {
+  size_t i;
+
+  if (handles == NULL || audio_frames == NULL || vad_decisions == NULL) {
+    return -1;
+  }
+  for (i = 0; i < num_handles; i++) {
+    if (handles[i] == NULL ||
+        ((VadInstT*) handles[i])->init_flag != kInitCheck ||
+        audio_frames[i] == NULL) {
+      return -1;
+    }
+  }
+  if (WebRtcVad_ValidRateAndFrameLength(fs, frame_length) != 0) {
+    return -1;
+  }
+
+  WebRtcVad_CalcVadBatch((VadInstT* const*) handles, fs, audio_frames,
+                         num_handles, frame_length, vad_decisions);
+
+  for (i = 0; i < num_handles; i++) {
+    if (vad_decisions[i] > 0) {
+      vad_decisions[i] = 1;
+    }
+  }
+  return 0;
+}
+
 int WebRtcVad_ValidRateAndFrameLength(int rate, size_t frame_length) {
   int return_value = -1;
   size_t i;
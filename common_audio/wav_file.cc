@@ -11,6 +11,7 @@
 #include "common_audio/wav_file.h"
 
 #include <errno.h>
+#include <string.h>
 
 #include <algorithm>
 #include <array>
@@ -61,8 +62,73 @@ class WavHeaderFileReader : public WavHeaderReader {
   int64_t pos_ = 0;
 };
 
+// Doesn't take a reference to the file.
+class WavHeaderMemoryReader : public WavHeaderReader {
+ public:
+  explicit WavHeaderMemoryReader(const MemoryMappedFile* file) : file_(file) {}
+
+  WavHeaderMemoryReader(const WavHeaderMemoryReader&) = delete;
+  WavHeaderMemoryReader& operator=(const WavHeaderMemoryReader&) = delete;
+
+  size_t Read(void* buf, size_t num_bytes) override {
+    size_t count = std::min(num_bytes, file_->size() - pos_);
+    memcpy(buf, file_->data().data() + pos_, count);
+    pos_ += count;
+    return count;
+  }
+  bool SeekForward(uint32_t num_bytes) override {
+    if (num_bytes > file_->size() - pos_) {
+      return false;
+    }
+    pos_ += num_bytes;
+    return true;
+  }
+  int64_t GetPosition() override { return pos_; }
+
+ private:
+  const MemoryMappedFile* const file_;
+  size_t pos_ = 0;
+};
+
+// Converts samples read from a memory mapped file, which need not be aligned.
+void ConvertMappedSamples(const uint8_t* data,
+                          WavFormat format,
+                          size_t num_samples,
+                          int16_t* samples) {
+  if (format == WavFormat::kWavFormatPcm) {
+    memcpy(samples, data, num_samples * sizeof(samples[0]));
+    return;
+  }
+  RTC_CHECK_EQ(format, WavFormat::kWavFormatIeeeFloat);
+  for (size_t i = 0; i < num_samples; ++i) {
+    float sample;
+    memcpy(&sample, data + i * sizeof(sample), sizeof(sample));
+    samples[i] = FloatToS16(sample);
+  }
+}
+
+void ConvertMappedSamples(const uint8_t* data,
+                          WavFormat format,
+                          size_t num_samples,
+                          float* samples) {
+  if (format == WavFormat::kWavFormatPcm) {
+    for (size_t i = 0; i < num_samples; ++i) {
+      int16_t sample;
+      memcpy(&sample, data + i * sizeof(sample), sizeof(sample));
+      samples[i] = static_cast<float>(sample);
+    }
+    return;
+  }
+  RTC_CHECK_EQ(format, WavFormat::kWavFormatIeeeFloat);
+  memcpy(samples, data, num_samples * sizeof(samples[0]));
+  FloatToFloatS16(samples, num_samples, samples);
+}
+
 constexpr size_t kMaxChunksize = 4096;
 
+// How far ahead of the read position a memory mapped file is prefetched.
+constexpr size_t kMappedReadAheadBytes = 1024 * 1024;
+
 }  // namespace
 
 WavReader::WavReader(absl::string_view filename)
@@ -81,9 +147,28 @@ WavReader::WavReader(FileWrapper file) : file_(std::move(file)) {
   RTC_CHECK(FormatSupported(format_)) << "Non-implemented wav-format";
 }
 
+WavReader::WavReader(rtc::scoped_refptr<MemoryMappedFile> file)
+    : mapped_file_(std::move(file)) {
+  RTC_CHECK(mapped_file_) << "Invalid file. Could not memory map wav file.";
+
+  WavHeaderMemoryReader readable(mapped_file_.get());
+  size_t bytes_per_sample;
+  RTC_CHECK(ReadWavHeader(&readable, &num_channels_, &sample_rate_, &format_,
+                          &bytes_per_sample, &num_samples_in_file_,
+                          &data_start_pos_));
+  num_unread_samples_ = num_samples_in_file_;
+  mapped_read_pos_ = static_cast<size_t>(data_start_pos_);
+  RTC_CHECK(FormatSupported(format_)) << "Non-implemented wav-format";
+}
+
 void WavReader::Reset() {
-  RTC_CHECK(file_.SeekTo(data_start_pos_))
-      << "Failed to set position in the file to WAV data start position";
+  if (mapped_file_) {
+    mapped_read_pos_ = static_cast<size_t>(data_start_pos_);
+    mapped_prefetch_end_ = 0;
+  } else {
+    RTC_CHECK(file_.SeekTo(data_start_pos_))
+        << "Failed to set position in the file to WAV data start position";
+  }
   num_unread_samples_ = num_samples_in_file_;
 }
 
@@ -93,6 +178,13 @@ size_t WavReader::ReadSamples(const size_t num_samples,
 #error "Need to convert samples to big-endian when reading from WAV file"
 #endif
 
+  if (mapped_file_) {
+    size_t num_samples_read = num_samples;
+    const uint8_t* data = ReadMappedSamples(&num_samples_read);
+    ConvertMappedSamples(data, format_, num_samples_read, samples);
+    return num_samples_read;
+  }
+
   size_t num_samples_left_to_read = num_samples;
   size_t next_chunk_start = 0;
   while (num_samples_left_to_read > 0 && num_unread_samples_ > 0) {
@@ -133,6 +225,13 @@ size_t WavReader::ReadSamples(const size_t num_samples, float* const samples) {
 #error "Need to convert samples to big-endian when reading from WAV file"
 #endif
 
+  if (mapped_file_) {
+    size_t num_samples_read = num_samples;
+    const uint8_t* data = ReadMappedSamples(&num_samples_read);
+    ConvertMappedSamples(data, format_, num_samples_read, samples);
+    return num_samples_read;
+  }
+
   size_t num_samples_left_to_read = num_samples;
   size_t next_chunk_start = 0;
   while (num_samples_left_to_read > 0 && num_unread_samples_ > 0) {
@@ -176,6 +275,27 @@ size_t WavReader::ReadSamples(const size_t num_samples, float* const samples) {
 
 void WavReader::Close() {
   file_.Close();
+  mapped_file_ = nullptr;
+}
+
+const uint8_t* WavReader::ReadMappedSamples(size_t* num_samples) {
+  const size_t bytes_per_sample =
+      format_ == WavFormat::kWavFormatPcm ? sizeof(int16_t) : sizeof(float);
+  // As when reading from a file, a file shorter than its header says just
+  // ends early.
+  const size_t num_samples_left = std::min(
+      num_unread_samples_,
+      (mapped_file_->size() - mapped_read_pos_) / bytes_per_sample);
+  *num_samples = std::min(*num_samples, num_samples_left);
+  const uint8_t* data = mapped_file_->data().data() + mapped_read_pos_;
+  mapped_read_pos_ += *num_samples * bytes_per_sample;
+  num_unread_samples_ -= *num_samples;
+  // Keep at least half of the read ahead window prefetched.
+  if (mapped_read_pos_ + kMappedReadAheadBytes / 2 > mapped_prefetch_end_) {
+    mapped_file_->Prefetch(mapped_read_pos_, kMappedReadAheadBytes);
+    mapped_prefetch_end_ = mapped_read_pos_ + kMappedReadAheadBytes;
+  }
+  return data;
 }
 
 WavWriter::WavWriter(absl::string_view filename,
@@ -16,8 +16,10 @@
 #include <cstddef>
 #include <string>
 
+#include "api/scoped_refptr.h"
 #include "common_audio/wav_header.h"
 #include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/system/memory_mapped_file.h"
 
 namespace webrtc {
 
@@ -79,6 +81,9 @@ class WavReader final : public WavFile {
   // Opens an existing WAV file for reading.
   explicit WavReader(absl::string_view filename);
   explicit WavReader(FileWrapper file);
+  // Reads from a memory mapped file. The samples are converted straight from
+  // the mapping, and the file is prefetched ahead of the read position.
+  explicit WavReader(rtc::scoped_refptr<MemoryMappedFile> file);
 
   // Close the WAV file.
   ~WavReader() { Close(); }
@@ -100,6 +105,10 @@ class WavReader final : public WavFile {
 
  private:
   void Close();
+  // Returns the next `*num_samples` samples of `mapped_file_`, clamping
+  // `*num_samples` to the samples left, and advances past them.
+  const uint8_t* ReadMappedSamples(size_t* num_samples);
+
   int sample_rate_;
   size_t num_channels_;
   WavFormat format_;
@@ -108,6 +117,9 @@ class WavReader final : public WavFile {
   FileWrapper file_;
   int64_t
       data_start_pos_;  // Position in the file immediately after WAV header.
+  rtc::scoped_refptr<MemoryMappedFile> mapped_file_;
+  size_t mapped_read_pos_ = 0;
+  size_t mapped_prefetch_end_ = 0;
 };
 
 }  // namespace webrtc
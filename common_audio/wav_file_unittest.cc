@@ -15,8 +15,10 @@
 
 #include <cmath>
 #include <limits>
+#include <vector>
 
 #include "common_audio/wav_header.h"
+#include "rtc_base/system/memory_mapped_file.h"
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
 
@@ -248,4 +250,51 @@ TEST(WavReaderTest, MAYBE_CPPReset) {
   }
 }
 
+#if defined(WEBRTC_POSIX)
+
+// Reads a memory mapped file in chunks and checks that the samples match
+// those read through the file.
+TEST(WavReaderTest, MemoryMappedReaderMatchesFileReader) {
+  const std::string outfile = test::OutputPath() + "wavtest_mapped.wav";
+  constexpr size_t kNumSamples = 10000;
+  for (WavFile::SampleFormat format :
+       {WavFile::SampleFormat::kInt16, WavFile::SampleFormat::kFloat}) {
+    {
+      WavWriter w(outfile, 48000, 2, format);
+      std::vector<float> samples(kNumSamples);
+      for (size_t i = 0; i < kNumSamples; ++i) {
+        samples[i] = 30000.0f * std::sin(i / 10.0f);
+      }
+      w.WriteSamples(samples.data(), samples.size());
+    }
+
+    WavReader file_reader(outfile);
+    WavReader mapped_reader(MemoryMappedFile::Open(outfile));
+    EXPECT_EQ(mapped_reader.sample_rate(), 48000);
+    EXPECT_EQ(mapped_reader.num_channels(), 2u);
+    EXPECT_EQ(mapped_reader.num_samples(), kNumSamples);
+    for (int pass = 0; pass < 2; ++pass) {
+      std::vector<float> expected_float(kNumSamples + 1);
+      std::vector<float> mapped_float(kNumSamples + 1);
+      EXPECT_EQ(file_reader.ReadSamples(333, expected_float.data()), 333u);
+      EXPECT_EQ(mapped_reader.ReadSamples(333, mapped_float.data()), 333u);
+      EXPECT_EQ(expected_float, mapped_float);
+
+      std::vector<int16_t> expected_int(kNumSamples + 1);
+      std::vector<int16_t> mapped_int(kNumSamples + 1);
+      EXPECT_EQ(file_reader.ReadSamples(kNumSamples, expected_int.data()),
+                kNumSamples - 333);
+      EXPECT_EQ(mapped_reader.ReadSamples(kNumSamples, mapped_int.data()),
+                kNumSamples - 333);
+      EXPECT_EQ(expected_int, mapped_int);
+      EXPECT_EQ(mapped_reader.ReadSamples(1, mapped_int.data()), 0u);
+
+      file_reader.Reset();
+      mapped_reader.Reset();
+    }
+  }
+}
+
+#endif  // defined(WEBRTC_POSIX)
+
 }  // namespace webrtc
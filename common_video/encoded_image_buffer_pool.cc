@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "api/make_ref_counted.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+
+namespace {
+// Enough for the frames held by the packetizer and the pacer at typical
+// frame rates; more than this indicates buffers are not being released.
+constexpr size_t kDefaultMaxNumberOfBuffers = 8;
+}  // namespace
+
+// Derives from EncodedImageBufferInterface rather than EncodedImageBuffer, so
+// that users of the pool can't reach EncodedImageBuffer::Realloc and change
+// the size behind the pool's back.
+class EncodedImageBufferPool::PooledBuffer
+    : public EncodedImageBufferInterface {
+ public:
+  explicit PooledBuffer(size_t size)
+      : buffer_(static_cast<uint8_t*>(malloc(size))),
+        size_(size),
+        capacity_(size) {}
+  ~PooledBuffer() override { free(buffer_); }
+
+  const uint8_t* data() const override { return buffer_; }
+  uint8_t* data() override { return buffer_; }
+  size_t size() const override { return size_; }
+  size_t capacity() const { return capacity_; }
+
+  // Sets the size without preserving the contents.
+  void Resize(size_t size) {
+    if (size > capacity_) {
+      free(buffer_);
+      buffer_ = static_cast<uint8_t*>(malloc(size));
+      capacity_ = size;
+    }
+    size_ = size;
+  }
+
+  // Returns true if the pool holds the only reference, in which case it's safe
+  // to reuse the buffer.
+  bool IsFree() const {
+    // Cast is safe because the only way a PooledBuffer is created is through
+    // make_ref_counted in Create().
+    return static_cast<const rtc::RefCountedObject<PooledBuffer>*>(this)
+        ->HasOneRef();
+  }
+
+ private:
+  uint8_t* buffer_;
+  size_t size_;
+  size_t capacity_;
+};
+
+EncodedImageBufferPool::EncodedImageBufferPool()
+    : EncodedImageBufferPool(kDefaultMaxNumberOfBuffers) {}
+
+EncodedImageBufferPool::EncodedImageBufferPool(size_t max_number_of_buffers)
+    : max_number_of_buffers_(max_number_of_buffers) {}
+
+EncodedImageBufferPool::~EncodedImageBufferPool() = default;
+
+rtc::scoped_refptr<EncodedImageBufferInterface> EncodedImageBufferPool::Create(
+    size_t size) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  // Prefers a free buffer which is large enough, and otherwise grows the
+  // largest free one.
+  PooledBuffer* free_buffer = nullptr;
+  for (const rtc::scoped_refptr<PooledBuffer>& buffer : buffers_) {
+    if (!buffer->IsFree()) {
+      continue;
+    }
+    if (buffer->capacity() >= size) {
+      free_buffer = buffer.get();
+      break;
+    }
+    if (!free_buffer || buffer->capacity() > free_buffer->capacity()) {
+      free_buffer = buffer.get();
+    }
+  }
+  if (free_buffer) {
+    free_buffer->Resize(size);
+    return rtc::scoped_refptr<EncodedImageBufferInterface>(free_buffer);
+  }
+  if (buffers_.size() >= max_number_of_buffers_) {
+    return EncodedImageBuffer::Create(size);
+  }
+
+  rtc::scoped_refptr<PooledBuffer> buffer =
+      rtc::make_ref_counted<PooledBuffer>(size);
+  buffers_.push_back(buffer);
+  return buffer;
+}
+
+rtc::scoped_refptr<EncodedImageBufferInterface> EncodedImageBufferPool::Create(
+    const uint8_t* data,
+    size_t size) {
+  rtc::scoped_refptr<EncodedImageBufferInterface> buffer = Create(size);
+  if (size > 0) {
+    memcpy(buffer->data(), data, size);
+  }
+  return buffer;
+}
+
+void EncodedImageBufferPool::Release() {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  buffers_.clear();
+}
+
+}  // namespace webrtc
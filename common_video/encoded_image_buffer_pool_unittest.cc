@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/include/encoded_image_buffer_pool.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(TestEncodedImageBufferPool, ReusesReleasedBuffer) {
+  EncodedImageBufferPool pool;
+  auto buffer = pool.Create(100);
+  EXPECT_EQ(buffer->size(), 100u);
+  const uint8_t* data = buffer->data();
+  // Release buffer so that it is returned to the pool.
+  buffer = nullptr;
+  buffer = pool.Create(50);
+  EXPECT_EQ(buffer->size(), 50u);
+  EXPECT_EQ(buffer->data(), data);
+  // Grows to a larger frame, and keeps the capacity for smaller ones.
+  buffer = nullptr;
+  buffer = pool.Create(200);
+  EXPECT_EQ(buffer->size(), 200u);
+  data = buffer->data();
+  buffer = nullptr;
+  buffer = pool.Create(150);
+  EXPECT_EQ(buffer->data(), data);
+}
+
+TEST(TestEncodedImageBufferPool, DoesNotReuseBufferInUse) {
+  EncodedImageBufferPool pool;
+  auto buffer1 = pool.Create(100);
+  auto buffer2 = pool.Create(100);
+  EXPECT_NE(buffer1->data(), buffer2->data());
+}
+
+TEST(TestEncodedImageBufferPool, PrefersBufferLargeEnough) {
+  EncodedImageBufferPool pool;
+  auto small = pool.Create(10);
+  auto large = pool.Create(1000);
+  const uint8_t* large_data = large->data();
+  small = nullptr;
+  large = nullptr;
+  auto buffer = pool.Create(500);
+  EXPECT_EQ(buffer->data(), large_data);
+}
+
+TEST(TestEncodedImageBufferPool, CopiesData) {
+  EncodedImageBufferPool pool;
+  const uint8_t kData[] = {1, 2, 3, 4};
+  auto buffer = pool.Create(kData, sizeof(kData));
+  ASSERT_EQ(buffer->size(), sizeof(kData));
+  EXPECT_EQ(memcmp(buffer->data(), kData, sizeof(kData)), 0);
+}
+
+TEST(TestEncodedImageBufferPool, BufferValidAfterPoolDestruction) {
+  rtc::scoped_refptr<EncodedImageBufferInterface> buffer;
+  {
+    EncodedImageBufferPool pool;
+    buffer = pool.Create(16);
+  }
+  memset(buffer->data(), 1, buffer->size());
+}
+
+TEST(TestEncodedImageBufferPool, ShrinkThenGrowStaysWithinCapacity) {
+  EncodedImageBufferPool pool;
+  auto buffer = pool.Create(100);
+  const uint8_t* data = buffer->data();
+  buffer = nullptr;
+  buffer = pool.Create(10);
+  EXPECT_EQ(buffer->data(), data);
+  buffer = nullptr;
+  // Reusing for a size up to the original capacity must not reallocate.
+  buffer = pool.Create(100);
+  EXPECT_EQ(buffer->data(), data);
+  memset(buffer->data(), 1, buffer->size());
+}
+
+TEST(TestEncodedImageBufferPool, NumberOfPooledBuffersIsCapped) {
+  EncodedImageBufferPool pool(/*max_number_of_buffers=*/2);
+  auto buffer1 = pool.Create(10);
+  auto buffer2 = pool.Create(10);
+  auto unpooled = pool.Create(10);
+  ASSERT_TRUE(unpooled);
+  EXPECT_EQ(unpooled->size(), 10u);
+  const uint8_t* pooled_data = buffer1->data();
+  buffer1 = nullptr;
+  unpooled = nullptr;
+  // Only the pooled buffer is handed out again.
+  auto buffer = pool.Create(10);
+  EXPECT_EQ(buffer->data(), pooled_data);
+}
+
+}  // namespace webrtc
@@ -11,47 +11,48 @@
 #include "common_video/h264/h264_common.h"
 
 #include <cstdint>
+#include <cstring>
 
 namespace webrtc {
 namespace H264 {
 
 const uint8_t kNaluTypeMask = 0x1F;
+const uint8_t kEmulationByte = 0x03;
 
 std::vector<NaluIndex> FindNaluIndices(const uint8_t* buffer,
                                        size_t buffer_size) {
-  // This is sorta like Boyer-Moore, but with only the first optimization step:
-  // given a 3-byte sequence we're looking at, if the 3rd byte isn't 1 or 0,
-  // skip ahead to the next 3-byte sequence. 0s and 1s are relatively rare, so
-  // this will skip the majority of reads/checks.
+  // Look for the 1 ending each start sequence with memchr, which is
+  // vectorized by the C library. 1s are relatively rare in the payload, so
+  // this skips the majority of reads/checks.
   std::vector<NaluIndex> sequences;
   if (buffer_size < kNaluShortStartSequenceSize)
     return sequences;
 
   static_assert(kNaluShortStartSequenceSize >= 2,
                 "kNaluShortStartSequenceSize must be larger or equals to 2");
-  const size_t end = buffer_size - kNaluShortStartSequenceSize;
-  for (size_t i = 0; i < end;) {
-    if (buffer[i + 2] > 1) {
-      i += 3;
-    } else if (buffer[i + 2] == 1) {
-      if (buffer[i + 1] == 0 && buffer[i] == 0) {
-        // We found a start sequence, now check if it was a 3 of 4 byte one.
-        NaluIndex index = {i, i + 3, 0};
-        if (index.start_offset > 0 && buffer[index.start_offset - 1] == 0)
-          --index.start_offset;
-
-        // Update length of previous entry.
-        auto it = sequences.rbegin();
-        if (it != sequences.rend())
-          it->payload_size = index.start_offset - it->payload_start_offset;
-
-        sequences.push_back(index);
-      }
-
-      i += 3;
-    } else {
-      ++i;
+  // A start sequence in the last byte would be followed by an empty NALU, so
+  // search up to, but not including, the last byte.
+  const size_t end = buffer_size - 1;
+  for (size_t i = kNaluShortStartSequenceSize - 1; i < end;) {
+    const uint8_t* one =
+        static_cast<const uint8_t*>(std::memchr(buffer + i, 1, end - i));
+    if (one == nullptr)
+      break;
+    i = one - buffer;
+    if (buffer[i - 1] == 0 && buffer[i - 2] == 0) {
+      // We found a start sequence, now check if it was a 3 of 4 byte one.
+      NaluIndex index = {i - 2, i + 1, 0};
+      if (index.start_offset > 0 && buffer[index.start_offset - 1] == 0)
+        --index.start_offset;
+
+      // Update length of previous entry.
+      auto it = sequences.rbegin();
+      if (it != sequences.rend())
+        it->payload_size = index.start_offset - it->payload_start_offset;
+
+      sequences.push_back(index);
     }
+    ++i;
   }
 
   // Update length of last entry, if any.
@@ -70,46 +71,56 @@ std::vector<uint8_t> ParseRbsp(const uint8_t* data, size_t length) {
   std::vector<uint8_t> out;
   out.reserve(length);
 
-  for (size_t i = 0; i < length;) {
-    // Be careful about over/underflow here. byte_length_ - 3 can underflow, and
-    // i + 3 can overflow, but byte_length_ - i can't, because i < byte_length_
-    // above, and that expression will produce the number of bytes left in
-    // the stream including the byte at i.
-    if (length - i >= 3 && !data[i] && !data[i + 1] && data[i + 2] == 3) {
-      // Two rbsp bytes.
-      out.push_back(data[i++]);
-      out.push_back(data[i++]);
-      // Skip the emulation byte.
-      i++;
+  // Copy everything in between the emulation bytes, which are found with
+  // memchr. Any 3 preceded by two zeros which aren't part of an earlier
+  // emulation sequence is one.
+  size_t copied = 0;
+  for (size_t i = 2; i < length;) {
+    const uint8_t* emulation_byte = static_cast<const uint8_t*>(
+        std::memchr(data + i, kEmulationByte, length - i));
+    if (emulation_byte == nullptr)
+      break;
+    i = emulation_byte - data;
+    if (data[i - 1] == 0 && data[i - 2] == 0) {
+      // Skip the emulation byte. The zeros before it can't be part of the
+      // next emulation sequence.
+      out.insert(out.end(), data + copied, data + i);
+      copied = i + 1;
+      i += 3;
     } else {
-      // Single rbsp byte.
-      out.push_back(data[i++]);
+      ++i;
     }
   }
+  out.insert(out.end(), data + copied, data + length);
   return out;
 }
 
 void WriteRbsp(const uint8_t* bytes, size_t length, rtc::Buffer* destination) {
-  static const uint8_t kZerosInStartSequence = 2;
-  static const uint8_t kEmulationByte = 0x03u;
-  size_t num_consecutive_zeros = 0;
   destination->EnsureCapacity(destination->size() + length);
 
-  for (size_t i = 0; i < length; ++i) {
-    uint8_t byte = bytes[i];
-    if (byte <= kEmulationByte &&
-        num_consecutive_zeros >= kZerosInStartSequence) {
+  // Find each pair of zeros with memchr, and escape the byte after it if
+  // needed. The escaped byte may start the next pair, but the zeros before the
+  // emulation byte may not. Bytes before `appended` have been appended.
+  size_t appended = 0;
+  for (size_t i = 0; i + 2 < length;) {
+    const uint8_t* zero = static_cast<const uint8_t*>(
+        std::memchr(bytes + i, 0, length - 2 - i));
+    if (zero == nullptr)
+      break;
+    i = zero - bytes;
+    if (bytes[i + 1] != 0) {
+      i += 2;
+      continue;
+    }
+    if (bytes[i + 2] <= kEmulationByte) {
       // Need to escape.
+      destination->AppendData(bytes + appended, i + 2 - appended);
       destination->AppendData(kEmulationByte);
-      num_consecutive_zeros = 0;
-    }
-    destination->AppendData(byte);
-    if (byte == 0) {
-      ++num_consecutive_zeros;
-    } else {
-      num_consecutive_zeros = 0;
+      appended = i + 2;
     }
+    i += 2;
   }
+  destination->AppendData(bytes + appended, length - appended);
 }
 
 }  // namespace H264
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/h264/h264_common.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "rtc_base/buffer.h"
+#include "rtc_base/random.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::testing::IsEmpty;
+
+MATCHER_P3(NaluAt, start_offset, payload_start_offset, payload_size, "") {
+  return arg.start_offset == size_t{start_offset} &&
+         arg.payload_start_offset == size_t{payload_start_offset} &&
+         arg.payload_size == size_t{payload_size};
+}
+
+// Byte by byte implementations to compare against.
+std::vector<H264::NaluIndex> FindNaluIndicesReference(const uint8_t* buffer,
+                                                      size_t buffer_size) {
+  std::vector<H264::NaluIndex> sequences;
+  for (size_t i = 0; i + 3 < buffer_size; ++i) {
+    if (buffer[i] == 0 && buffer[i + 1] == 0 && buffer[i + 2] == 1) {
+      H264::NaluIndex index = {i, i + 3, 0};
+      if (i > 0 && buffer[i - 1] == 0)
+        --index.start_offset;
+      if (!sequences.empty())
+        sequences.back().payload_size =
+            index.start_offset - sequences.back().payload_start_offset;
+      sequences.push_back(index);
+    }
+  }
+  if (!sequences.empty())
+    sequences.back().payload_size =
+        buffer_size - sequences.back().payload_start_offset;
+  return sequences;
+}
+
+std::vector<uint8_t> ParseRbspReference(const uint8_t* data, size_t length) {
+  std::vector<uint8_t> out;
+  for (size_t i = 0; i < length;) {
+    if (length - i >= 3 && !data[i] && !data[i + 1] && data[i + 2] == 3) {
+      out.push_back(data[i++]);
+      out.push_back(data[i++]);
+      i++;
+    } else {
+      out.push_back(data[i++]);
+    }
+  }
+  return out;
+}
+
+std::vector<uint8_t> WriteRbspReference(const uint8_t* bytes, size_t length) {
+  std::vector<uint8_t> out;
+  size_t num_consecutive_zeros = 0;
+  for (size_t i = 0; i < length; ++i) {
+    if (bytes[i] <= 3 && num_consecutive_zeros >= 2) {
+      out.push_back(3);
+      num_consecutive_zeros = 0;
+    }
+    out.push_back(bytes[i]);
+    num_consecutive_zeros = bytes[i] == 0 ? num_consecutive_zeros + 1 : 0;
+  }
+  return out;
+}
+
+// Mostly zeros, ones and threes, to make start and emulation sequences common.
+std::vector<uint8_t> RandomBytes(Random& random) {
+  std::vector<uint8_t> bytes(random.Rand(0, 64));
+  for (uint8_t& byte : bytes) {
+    byte = random.Rand(0, 3) == 0 ? random.Rand<uint8_t>() : random.Rand(0, 3);
+  }
+  return bytes;
+}
+
+TEST(H264CommonTest, FindNaluIndices) {
+  const uint8_t kBuffer[] = {0, 0, 0, 1, 0x65, 0xAA, 0, 0, 1, 0x41, 0, 0, 1};
+  EXPECT_THAT(H264::FindNaluIndices(kBuffer, sizeof(kBuffer)),
+              ElementsAre(NaluAt(0, 4, 2), NaluAt(6, 9, 4)));
+}
+
+TEST(H264CommonTest, FindNaluIndicesWithoutStartSequence) {
+  const uint8_t kBuffer[] = {0, 0, 2, 1, 0, 1, 0};
+  EXPECT_THAT(H264::FindNaluIndices(kBuffer, sizeof(kBuffer)), IsEmpty());
+  EXPECT_THAT(H264::FindNaluIndices(kBuffer, 2), IsEmpty());
+}
+
+TEST(H264CommonTest, ParseRbspRemovesEmulationBytes) {
+  const uint8_t kData[] = {0xAA, 0, 0, 3, 0, 0, 0, 3, 1, 0, 0, 3, 3, 0, 0, 3};
+  EXPECT_THAT(H264::ParseRbsp(kData, sizeof(kData)),
+              ElementsAre(0xAA, 0, 0, 0, 0, 0, 1, 0, 0, 3, 0, 0));
+}
+
+TEST(H264CommonTest, WriteRbspInsertsEmulationBytes) {
+  const uint8_t kBytes[] = {0, 0, 0, 0, 0, 4, 0, 0, 1, 0, 0};
+  rtc::Buffer buffer;
+  H264::WriteRbsp(kBytes, sizeof(kBytes), &buffer);
+  EXPECT_THAT(buffer, ElementsAre(0, 0, 3, 0, 0, 3, 0, 4, 0, 0, 3, 1, 0, 0));
+}
+
+TEST(H264CommonTest, MatchesByteByByteImplementation) {
+  Random random(0x1234);
+  for (int i = 0; i < 1000; ++i) {
+    std::vector<uint8_t> bytes = RandomBytes(random);
+    std::vector<H264::NaluIndex> expected =
+        FindNaluIndicesReference(bytes.data(), bytes.size());
+    std::vector<H264::NaluIndex> actual =
+        H264::FindNaluIndices(bytes.data(), bytes.size());
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t j = 0; j < expected.size(); ++j) {
+      EXPECT_THAT(actual[j], NaluAt(expected[j].start_offset,
+                                    expected[j].payload_start_offset,
+                                    expected[j].payload_size));
+    }
+
+    EXPECT_THAT(
+        H264::ParseRbsp(bytes.data(), bytes.size()),
+        ElementsAreArray(ParseRbspReference(bytes.data(), bytes.size())));
+
+    rtc::Buffer buffer;
+    H264::WriteRbsp(bytes.data(), bytes.size(), &buffer);
+    EXPECT_THAT(buffer, ElementsAreArray(
+                            WriteRbspReference(bytes.data(), bytes.size())));
+    EXPECT_THAT(H264::ParseRbsp(buffer.data(), buffer.size()),
+                ElementsAreArray(bytes));
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
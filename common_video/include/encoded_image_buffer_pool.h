@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+#define COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/encoded_image.h"
+#include "rtc_base/race_checker.h"
+
+namespace webrtc {
+
+// Buffer pool to avoid allocating an EncodedImageBuffer for every encoded
+// frame. When the last reference to a buffer returned from Create() outside of
+// the pool is released, e.g. once the frame has been packetized, the memory is
+// returned to the pool for use by subsequent calls to Create(). A buffer keeps
+// its capacity when reused for a smaller frame, and only grows when reused for
+// a larger one, so that the capacities of the pooled buffers follow the largest
+// frames encoded. The returned buffers can't be resized by the caller, since
+// that would bypass the pool's capacity accounting. At most
+// `max_number_of_buffers` are pooled; beyond that, Create() falls back to
+// allocating buffers which are not returned to the pool.
+//
+// Create() must be called on a single sequence at a time, while the buffers
+// may be released on any thread.
+class EncodedImageBufferPool {
+ public:
+  EncodedImageBufferPool();
+  explicit EncodedImageBufferPool(size_t max_number_of_buffers);
+  ~EncodedImageBufferPool();
+
+  // Returns a buffer of `size` bytes, with unspecified contents.
+  rtc::scoped_refptr<EncodedImageBufferInterface> Create(size_t size);
+  // Returns a buffer holding a copy of `data`.
+  rtc::scoped_refptr<EncodedImageBufferInterface> Create(const uint8_t* data,
+                                                         size_t size);
+
+  // Clears the pool. Buffers still in use are freed once released.
+  void Release();
+
+ private:
+  class PooledBuffer;
+
+  const size_t max_number_of_buffers_;
+  rtc::RaceChecker race_checker_;
+  std::vector<rtc::scoped_refptr<PooledBuffer>> buffers_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
@@ -32,7 +32,10 @@ namespace webrtc {
 // Create(I420|NV12)Buffer. When the buffer is destructed, the memory is
 // returned to the pool for use by subsequent calls to Create(I420|NV12)Buffer.
 // If the resolution passed to Create(I420|NV12)Buffer changes or requested
-// pixel format changes, old buffers will be purged from the pool.
+// pixel format changes, old buffers will be purged from the pool. Buffers the
+// pool grew by to absorb a peak in the number of buffers in use, e.g. while
+// the renderer held on to frames, are purged once they have gone unused for
+// a while.
 // Note that Create(I420|NV12)Buffer will crash if more than
 // kMaxNumberOfFramesBeforeCrash are created. This is to prevent memory leaks
 // where frames are not returned.
@@ -63,9 +66,15 @@ class VideoFrameBufferPool {
   // later from another thread.
   void Release();
 
+  // Returns the number of buffers held by the pool, in use or not.
+  size_t GetNumberOfBuffers() const;
+
  private:
   rtc::scoped_refptr<VideoFrameBuffer>
   GetExistingBuffer(int width, int height, VideoFrameBuffer::Type type);
+  // Purges free buffers beyond the most buffers in use at a time since the
+  // last call, once every so many requested buffers.
+  void MaybeTrim(size_t buffers_in_use);
 
   rtc::RaceChecker race_checker_;
   std::list<rtc::scoped_refptr<VideoFrameBuffer>> buffers_;
@@ -77,6 +86,8 @@ class VideoFrameBufferPool {
   const bool zero_initialize_;
   // Max number of buffers this pool can have pending.
   size_t max_number_of_buffers_;
+  size_t buffers_requested_since_trim_ = 0;
+  size_t max_buffers_in_use_since_trim_ = 0;
 };
 
 }  // namespace webrtc
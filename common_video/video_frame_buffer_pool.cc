@@ -10,6 +10,7 @@
 
 #include "common_video/include/video_frame_buffer_pool.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "api/make_ref_counted.h"
@@ -18,6 +19,11 @@
 namespace webrtc {
 
 namespace {
+
+// How many buffers are requested between trims of unused buffers. About ten
+// seconds of frames at 30 fps.
+constexpr size_t kBuffersRequestedPerTrim = 300;
+
 bool HasOneRef(const rtc::scoped_refptr<VideoFrameBuffer>& buffer) {
   // Cast to rtc::RefCountedObject is safe because this function is only called
   // on locally created VideoFrameBuffers, which are either
@@ -77,6 +83,11 @@ void VideoFrameBufferPool::Release() {
   buffers_.clear();
 }
 
+size_t VideoFrameBufferPool::GetNumberOfBuffers() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  return buffers_.size();
+}
+
 bool VideoFrameBufferPool::Resize(size_t max_number_of_buffers) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
   size_t used_buffers_count = 0;
@@ -327,17 +338,44 @@ rtc::scoped_refptr<VideoFrameBuffer> VideoFrameBufferPool::GetExistingBuffer(
     }
   }
   // Look for a free buffer.
+  rtc::scoped_refptr<VideoFrameBuffer> free_buffer;
+  size_t buffers_in_use = 0;
   for (const rtc::scoped_refptr<VideoFrameBuffer>& buffer : buffers_) {
     // If the buffer is in use, the ref count will be >= 2, one from the list we
     // are looping over and one from the application. If the ref count is 1,
     // then the list we are looping over holds the only reference and it's safe
     // to reuse.
-    if (HasOneRef(buffer)) {
+    if (!HasOneRef(buffer)) {
+      ++buffers_in_use;
+    } else if (!free_buffer) {
       RTC_CHECK(buffer->type() == type);
-      return buffer;
+      free_buffer = buffer;
+    }
+  }
+  // Whether reused or newly allocated, the requested buffer is in use too.
+  MaybeTrim(buffers_in_use + 1);
+  return free_buffer;
+}
+
+void VideoFrameBufferPool::MaybeTrim(size_t buffers_in_use) {
+  max_buffers_in_use_since_trim_ =
+      std::max(max_buffers_in_use_since_trim_, buffers_in_use);
+  if (++buffers_requested_since_trim_ < kBuffersRequestedPerTrim) {
+    return;
+  }
+  // Buffers in use have a ref count above 1 and are never purged, which
+  // includes a free buffer that is about to be handed out.
+  auto it = buffers_.begin();
+  while (it != buffers_.end() &&
+         buffers_.size() > max_buffers_in_use_since_trim_) {
+    if (HasOneRef(*it)) {
+      it = buffers_.erase(it);
+    } else {
+      ++it;
     }
   }
-  return nullptr;
+  buffers_requested_since_trim_ = 0;
+  max_buffers_in_use_since_trim_ = 0;
 }
 
 }  // namespace webrtc
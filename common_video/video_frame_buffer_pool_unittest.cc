@@ -13,6 +13,8 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <vector>
+
 #include "api/scoped_refptr.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame_buffer.h"
@@ -73,6 +75,28 @@ TEST(TestVideoFrameBufferPool, MaxNumberOfBuffers) {
   EXPECT_EQ(nullptr, pool.CreateI420Buffer(16, 16).get());
 }
 
+TEST(TestVideoFrameBufferPool, PurgesBuffersUnusedAfterPeak) {
+  VideoFrameBufferPool pool;
+  std::vector<rtc::scoped_refptr<I420Buffer>> buffers;
+  for (int i = 0; i < 5; ++i) {
+    buffers.push_back(pool.CreateI420Buffer(16, 16));
+  }
+  buffers.clear();
+  EXPECT_EQ(pool.GetNumberOfBuffers(), 5u);
+
+  // Two buffers at a time are in use from now on. The pool keeps the buffers
+  // until the peak has been over for a while.
+  rtc::scoped_refptr<I420Buffer> held = pool.CreateI420Buffer(16, 16);
+  for (int i = 0; i < 299; ++i) {
+    pool.CreateI420Buffer(16, 16);
+  }
+  EXPECT_EQ(pool.GetNumberOfBuffers(), 5u);
+  for (int i = 0; i < 300; ++i) {
+    pool.CreateI420Buffer(16, 16);
+  }
+  EXPECT_EQ(pool.GetNumberOfBuffers(), 2u);
+}
+
 TEST(TestVideoFrameBufferPool, ProducesNv12) {
   VideoFrameBufferPool pool(false, 1);
   auto buffer = pool.CreateNV12Buffer(16, 16);
@@ -20,6 +20,7 @@
 #include "api/video/i422_buffer.h"
 #include "api/video/i444_buffer.h"
 #include "api/video/nv12_buffer.h"
+#include "common_video/include/video_frame_buffer.h"
 #include "rtc_base/time_utils.h"
 #include "test/fake_texture_frame.h"
 #include "test/frame_utils.h"
@@ -471,6 +472,44 @@ TEST(TestNV12Buffer, CropAndScale) {
             kRelativeHeight);
 }
 
+TEST(TestI010Buffer, CropAndScaleOfWrappedBufferKeepsTenBits) {
+  const uint16_t kY = 1000;
+  const uint16_t kU = 600;
+  const uint16_t kV = 300;
+  rtc::scoped_refptr<I010Buffer> source = I010Buffer::Create(16, 16);
+  for (int i = 0; i < source->StrideY() * source->height(); ++i) {
+    source->MutableDataY()[i] = kY;
+  }
+  for (int i = 0; i < source->StrideU() * source->ChromaHeight(); ++i) {
+    source->MutableDataU()[i] = kU;
+    source->MutableDataV()[i] = kV;
+  }
+  // A wrapped buffer is not an I010Buffer, and only gets CropAndScale() from
+  // I010BufferInterface.
+  rtc::scoped_refptr<I010BufferInterface> wrapped = WrapI010Buffer(
+      source->width(), source->height(), source->DataY(), source->StrideY(),
+      source->DataU(), source->StrideU(), source->DataV(), source->StrideV(),
+      [source] {});
+
+  rtc::scoped_refptr<VideoFrameBuffer> scaled =
+      wrapped->CropAndScale(4, 4, 12, 12, 6, 6);
+  ASSERT_EQ(scaled->type(), VideoFrameBuffer::Type::kI010);
+  const I010BufferInterface* i010 = scaled->GetI010();
+  EXPECT_EQ(6, i010->width());
+  EXPECT_EQ(6, i010->height());
+  for (int row = 0; row < i010->height(); ++row) {
+    for (int col = 0; col < i010->width(); ++col) {
+      EXPECT_EQ(kY, i010->DataY()[row * i010->StrideY() + col]);
+    }
+  }
+  for (int row = 0; row < i010->ChromaHeight(); ++row) {
+    for (int col = 0; col < i010->ChromaWidth(); ++col) {
+      EXPECT_EQ(kU, i010->DataU()[row * i010->StrideU() + col]);
+      EXPECT_EQ(kV, i010->DataV()[row * i010->StrideV() + col]);
+    }
+  }
+}
+
 TEST(TestUpdateRect, CanCompare) {
   VideoFrame::UpdateRect a = {0, 0, 100, 200};
   VideoFrame::UpdateRect b = {0, 0, 100, 200};
@@ -122,6 +122,9 @@ ACTIVE_FIELD_TRIALS: FrozenSet[FieldTrial] = frozenset([
     FieldTrial('WebRTC-Video-RequestedResolutionOverrideOutputFormatRequest',
                'webrtc:14451',
                date(2024, 4, 1)),
+    FieldTrial('WebRTC-Video-ScreenshareActiveMap',
+               'chromium:1255737',
+               date(2024, 10, 1)),
     FieldTrial('WebRTC-VideoEncoderSettings',
                'chromium:1406331',
                date(2024, 4, 1)),
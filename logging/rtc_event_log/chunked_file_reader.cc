@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/chunked_file_reader.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+ChunkedFileReader::ChunkedFileReader(FileWrapper& file,
+                                     size_t file_size,
+                                     size_t chunk_size)
+    : file_(file), chunk_size_(chunk_size), bytes_left_(file_size) {
+  RTC_DCHECK_GT(chunk_size_, 0);
+}
+
+absl::string_view ChunkedFileReader::ReadMore(absl::string_view unparsed,
+                                              size_t min_size) {
+  RTC_DCHECK_LE(unparsed.size(), buffer_.size());
+  if (unparsed.size() >= min_size || bytes_left_ == 0 || read_failed_) {
+    return unparsed;
+  }
+  buffer_.erase(0, buffer_.size() - unparsed.size());
+  while (buffer_.size() < min_size && bytes_left_ > 0 && !read_failed_) {
+    const size_t read_size = std::min(
+        bytes_left_, std::max(chunk_size_, min_size - buffer_.size()));
+    const size_t old_size = buffer_.size();
+    buffer_.resize(old_size + read_size);
+    const size_t bytes_read = file_.Read(&buffer_[old_size], read_size);
+    buffer_.resize(old_size + bytes_read);
+    bytes_left_ -= bytes_read;
+    read_failed_ = bytes_read != read_size;
+  }
+  return buffer_;
+}
+
+}  // namespace webrtc
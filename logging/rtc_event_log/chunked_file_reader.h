@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef LOGGING_RTC_EVENT_LOG_CHUNKED_FILE_READER_H_
+#define LOGGING_RTC_EVENT_LOG_CHUNKED_FILE_READER_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/system/file_wrapper.h"
+
+namespace webrtc {
+
+// Reads a file on demand, keeping only the data that hasn't been parsed yet in
+// memory.
+class ChunkedFileReader {
+ public:
+  // Files are read in chunks of this size, or more if an event doesn't fit.
+  static constexpr size_t kDefaultChunkSize = 1 << 20;
+
+  // `file` must outlive the reader, and contain `file_size` more bytes.
+  ChunkedFileReader(FileWrapper& file,
+                    size_t file_size,
+                    size_t chunk_size = kDefaultChunkSize);
+
+  // Returns `unparsed`, extended so that it's at least `min_size` bytes long,
+  // unless the end of the file is reached first. `unparsed` must be a suffix
+  // of the previously returned data. The returned data is valid until the
+  // next call.
+  absl::string_view ReadMore(absl::string_view unparsed, size_t min_size);
+
+  // True if the file ended before `file_size` bytes had been read.
+  bool read_failed() const { return read_failed_; }
+
+ private:
+  FileWrapper& file_;
+  const size_t chunk_size_;
+  size_t bytes_left_;
+  bool read_failed_ = false;
+  std::string buffer_;
+};
+
+}  // namespace webrtc
+
+#endif  // LOGGING_RTC_EVENT_LOG_CHUNKED_FILE_READER_H_
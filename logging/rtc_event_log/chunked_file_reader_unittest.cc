@@ -0,0 +1,98 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/chunked_file_reader.h"
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+constexpr absl::string_view kContents = "0123456789";
+constexpr size_t kChunkSize = 4;
+
+class ChunkedFileReaderTest : public ::testing::Test {
+ protected:
+  ChunkedFileReaderTest()
+      : filename_(test::TempFilename(test::OutputPath(),
+                                     "chunked_file_reader_test")) {
+    FileWrapper file = FileWrapper::OpenWriteOnly(filename_);
+    EXPECT_TRUE(file.Write(kContents.data(), kContents.size()));
+  }
+  ~ChunkedFileReaderTest() override { test::RemoveFile(filename_); }
+
+  const std::string filename_;
+};
+
+TEST_F(ChunkedFileReaderTest, ReadsWholeChunks) {
+  FileWrapper file = FileWrapper::OpenReadOnly(filename_);
+  ChunkedFileReader reader(file, kContents.size(), kChunkSize);
+
+  EXPECT_EQ(reader.ReadMore(absl::string_view(), 1), "0123");
+}
+
+TEST_F(ChunkedFileReaderTest, ReturnsUnparsedDataIfLongEnough) {
+  FileWrapper file = FileWrapper::OpenReadOnly(filename_);
+  ChunkedFileReader reader(file, kContents.size(), kChunkSize);
+
+  absl::string_view data = reader.ReadMore(absl::string_view(), 1);
+  absl::string_view unparsed = data.substr(1);
+  absl::string_view more = reader.ReadMore(unparsed, unparsed.size());
+  EXPECT_EQ(more.data(), unparsed.data());
+  EXPECT_EQ(more, "123");
+}
+
+TEST_F(ChunkedFileReaderTest, KeepsUnparsedDataAcrossChunkBoundary) {
+  FileWrapper file = FileWrapper::OpenReadOnly(filename_);
+  ChunkedFileReader reader(file, kContents.size(), kChunkSize);
+
+  absl::string_view data = reader.ReadMore(absl::string_view(), 1);
+  ASSERT_EQ(data, "0123");
+  // An event starting at "3" needs two more bytes than have been read.
+  EXPECT_EQ(reader.ReadMore(data.substr(3), 3), "34567");
+}
+
+TEST_F(ChunkedFileReaderTest, ReadsMoreThanChunkSizeForLargeEvents) {
+  FileWrapper file = FileWrapper::OpenReadOnly(filename_);
+  ChunkedFileReader reader(file, kContents.size(), kChunkSize);
+
+  absl::string_view data = reader.ReadMore(absl::string_view(), 1);
+  EXPECT_EQ(reader.ReadMore(data.substr(2), 7), "2345678");
+}
+
+TEST_F(ChunkedFileReaderTest, ReturnsRemainingDataAtEndOfFile) {
+  FileWrapper file = FileWrapper::OpenReadOnly(filename_);
+  ChunkedFileReader reader(file, kContents.size(), kChunkSize);
+
+  absl::string_view data = reader.ReadMore(absl::string_view(), 8);
+  ASSERT_EQ(data, "01234567");
+  data = reader.ReadMore(data.substr(6), 4);
+  EXPECT_EQ(data, "6789");
+  EXPECT_EQ(reader.ReadMore(data.substr(4), 1), "");
+  EXPECT_FALSE(reader.read_failed());
+}
+
+TEST_F(ChunkedFileReaderTest, FailsIfFileIsShorterThanExpected) {
+  FileWrapper file = FileWrapper::OpenReadOnly(filename_);
+  ChunkedFileReader reader(file, kContents.size() + 1, kChunkSize);
+
+  absl::string_view data = reader.ReadMore(absl::string_view(), 12);
+  EXPECT_EQ(data, kContents);
+  EXPECT_TRUE(reader.read_failed());
+  EXPECT_EQ(reader.ReadMore(data, 12), kContents);
+}
+
+}  // namespace
+}  // namespace webrtc
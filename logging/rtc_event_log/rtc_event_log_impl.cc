@@ -58,7 +58,7 @@ RtcEventLogImpl::RtcEventLogImpl(std::unique_ptr<RtcEventLogEncoder> encoder,
       task_queue_(
           std::make_unique<rtc::TaskQueue>(task_queue_factory->CreateTaskQueue(
               "rtc_event_log",
-              TaskQueueFactory::Priority::NORMAL))) {}
+              TaskQueueFactory::Priority::LOW))) {}
 
 RtcEventLogImpl::~RtcEventLogImpl() {
   // If we're logging to the output, this will stop that. Blocking function.
@@ -99,6 +99,8 @@ bool RtcEventLogImpl::StartLogging(std::unique_ptr<RtcEventLogOutput> output,
   logging_state_started_ = true;
   immediately_output_mode_ = (output_period_ms == kImmediateOutput);
   need_schedule_output_ = (output_period_ms != kImmediateOutput);
+  immediate_output_pending_ = false;
+  ++logging_session_id_;
 
   // Binding to `this` is safe because `this` outlives the `task_queue_`.
   task_queue_->PostTask([this, output_period_ms, timestamp_us, utc_time_us,
@@ -149,6 +151,8 @@ void RtcEventLogImpl::StopLogging(std::function<void()> callback) {
   RTC_DCHECK_RUN_ON(&logging_state_checker_);
   MutexLock lock(&mutex_);
   logging_state_started_ = false;
+  immediate_output_pending_ = false;
+  ++logging_session_id_;
   task_queue_->PostTask(
       [this, callback, histories = ExtractRecentHistories()]() mutable {
         RTC_DCHECK_RUN_ON(task_queue_.get());
@@ -170,10 +174,15 @@ RtcEventLogImpl::EventHistories RtcEventLogImpl::ExtractRecentHistories() {
 void RtcEventLogImpl::Log(std::unique_ptr<RtcEvent> event) {
   RTC_CHECK(event);
   MutexLock lock(&mutex_);
+  if (!sampling_.empty() && IsSampledOut(*event)) {
+    return;
+  }
 
   LogToMemory(std::move(event));
   if (logging_state_started_) {
-    if (ShouldOutputImmediately()) {
+    if (immediately_output_mode_) {
+      MaybeScheduleImmediateOutput();
+    } else if (ShouldOutputImmediately()) {
       // Binding to `this` is safe because `this` outlives the `task_queue_`.
       task_queue_->PostTask(
           [this, histories = ExtractRecentHistories()]() mutable {
@@ -197,14 +206,62 @@ void RtcEventLogImpl::Log(std::unique_ptr<RtcEvent> event) {
   }
 }
 
-bool RtcEventLogImpl::ShouldOutputImmediately() {
-  if (recent_.history.size() >= max_events_in_history_) {
-    // We have to emergency drain the buffer. We can't wait for the scheduled
-    // output task because there might be other event incoming before that.
-    return true;
+void RtcEventLogImpl::SetSamplingInterval(RtcEvent::Type type, int interval) {
+  RTC_DCHECK_GT(interval, 0);
+  MutexLock lock(&mutex_);
+  if (interval <= 1) {
+    sampling_.erase(type);
+  } else {
+    sampling_[type] = SamplingState{interval};
+  }
+}
+
+bool RtcEventLogImpl::IsSampledOut(const RtcEvent& event) {
+  if (event.IsConfigEvent()) {
+    return false;
+  }
+  auto it = sampling_.find(event.GetType());
+  if (it == sampling_.end()) {
+    return false;
   }
+  SamplingState& state = it->second;
+  const bool sampled_out = state.count != 0;
+  state.count = (state.count + 1) % state.interval;
+  return sampled_out;
+}
+
+bool RtcEventLogImpl::ShouldOutputImmediately() {
+  // We have to emergency drain the buffer. We can't wait for the scheduled
+  // output task because there might be other event incoming before that.
+  return recent_.history.size() >= max_events_in_history_;
+}
 
-  return immediately_output_mode_;
+void RtcEventLogImpl::MaybeScheduleImmediateOutput() {
+  // Events are extracted when the task runs rather than when it's posted, so
+  // that all events logged in the meantime are encoded as a single batch
+  // instead of posting and encoding each event by itself.
+  if (immediate_output_pending_) {
+    return;
+  }
+  immediate_output_pending_ = true;
+  // Binding to `this` is safe because `this` outlives the `task_queue_`.
+  task_queue_->PostTask([this, session_id = logging_session_id_]() {
+    RTC_DCHECK_RUN_ON(task_queue_.get());
+    mutex_.Lock();
+    if (session_id != logging_session_id_) {
+      // Logging was stopped or restarted after this task was posted, and the
+      // events were handed over to the task posted by that call.
+      mutex_.Unlock();
+      return;
+    }
+    immediate_output_pending_ = false;
+    EventHistories histories = ExtractRecentHistories();
+    mutex_.Unlock();
+    if (event_output_) {
+      RTC_DCHECK(event_output_->IsActive());
+      LogEventsToOutput(std::move(histories));
+    }
+  });
 }
 
 void RtcEventLogImpl::ScheduleOutput() {
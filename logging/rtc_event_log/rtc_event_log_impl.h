@@ -14,6 +14,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <deque>
+#include <map>
 #include <memory>
 #include <string>
 
@@ -63,9 +64,23 @@ class RtcEventLogImpl final : public RtcEventLog {
   // task queue if the buffers are full or `output_period_ms_` is expired.
   void Log(std::unique_ptr<RtcEvent> event) override;
 
+  // Only keeps one in every `interval` events of the given type, starting with
+  // the first one, and drops the others before they are stored or encoded.
+  // This makes it cheaper to always keep logging of high rate events, like
+  // RTP packets, at the expense of analysis of those events being approximate.
+  // An interval of 1, the default, keeps all events. Config events are never
+  // dropped, since they are needed to interpret the other events.
+  void SetSamplingInterval(RtcEvent::Type type, int interval);
+
  private:
   using EventDeque = std::deque<std::unique_ptr<RtcEvent>>;
 
+  struct SamplingState {
+    int interval;
+    // Number of events seen since the last one that was kept.
+    int count = 0;
+  };
+
   struct EventHistories {
     EventDeque config_history;
     EventDeque history;
@@ -86,7 +101,9 @@ class RtcEventLogImpl final : public RtcEventLog {
 
   void StopLoggingInternal() RTC_RUN_ON(task_queue_);
 
+  bool IsSampledOut(const RtcEvent& event) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
   bool ShouldOutputImmediately() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void MaybeScheduleImmediateOutput() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
   void ScheduleOutput() RTC_RUN_ON(task_queue_);
 
   // Max size of event history.
@@ -113,6 +130,14 @@ class RtcEventLogImpl final : public RtcEventLog {
   bool logging_state_started_ RTC_GUARDED_BY(mutex_) = false;
   bool immediately_output_mode_ RTC_GUARDED_BY(mutex_) = false;
   bool need_schedule_output_ RTC_GUARDED_BY(mutex_) = false;
+  // In immediate output mode, events logged while an output task is pending
+  // are encoded together with the events already waiting for it.
+  bool immediate_output_pending_ RTC_GUARDED_BY(mutex_) = false;
+  // Incremented when logging is started or stopped, so that pending immediate
+  // output tasks of a previous session can tell that they are obsolete.
+  uint64_t logging_session_id_ RTC_GUARDED_BY(mutex_) = 0;
+  // Event types that aren't logged in full.
+  std::map<RtcEvent::Type, SamplingState> sampling_ RTC_GUARDED_BY(mutex_);
 
   // Since we are posting tasks bound to `this`,  it is critical that the event
   // log and its members outlive `task_queue_`. Keep the `task_queue_`
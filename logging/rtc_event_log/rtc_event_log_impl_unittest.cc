@@ -59,6 +59,7 @@ class FakeOutput : public RtcEventLogOutput {
   bool IsActive() const { return is_active_; }
   bool Write(absl::string_view data) override {
     RTC_DCHECK(is_active_);
+    ++num_writes_;
     if (fails_write_) {
       is_active_ = false;
       fails_write_ = false;
@@ -71,11 +72,13 @@ class FakeOutput : public RtcEventLogOutput {
   void Flush() override {}
 
   void FailsNextWrite() { fails_write_ = true; }
+  int num_writes() const { return num_writes_; }
 
  private:
   std::string& written_data_;
   bool is_active_ = true;
   bool fails_write_ = false;
+  int num_writes_ = 0;
 };
 
 class FakeEvent : public RtcEvent {
@@ -293,5 +296,72 @@ TEST_F(RtcEventLogImplTest, StopOutputOnWriteFailure) {
   Mock::VerifyAndClearExpectations(encoder_ptr_);
 }
 
+TEST_F(RtcEventLogImplTest, BatchesEventsLoggedWhileImmediateOutputIsPending) {
+  EXPECT_CALL(*encoder_ptr_, EncodeLogStart).WillOnce(Return("start"));
+  EXPECT_CALL(*encoder_ptr_, OnEncode).Times(3).WillRepeatedly(Return("event"));
+  event_log_.StartLogging(std::move(output_), RtcEventLog::kImmediateOutput);
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  const int num_writes_at_start = output_ptr_->num_writes();
+  event_log_.Log(std::make_unique<FakeEvent>());
+  event_log_.Log(std::make_unique<FakeEvent>());
+  event_log_.Log(std::make_unique<FakeEvent>());
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  Mock::VerifyAndClearExpectations(encoder_ptr_);
+  EXPECT_EQ(written_data_, "starteventeventevent");
+  // All three events are written at once.
+  EXPECT_EQ(output_ptr_->num_writes(), num_writes_at_start + 1);
+}
+
+TEST_F(RtcEventLogImplTest, KeepsEventsLoggedAfterStopInImmediateOutputMode) {
+  auto e1 = std::make_unique<FakeEvent>();
+  RtcEvent* e1_ptr = e1.get();
+  auto e2 = std::make_unique<FakeEvent>();
+  RtcEvent* e2_ptr = e2.get();
+  event_log_.StartLogging(std::move(output_), RtcEventLog::kImmediateOutput);
+  event_log_.Log(std::move(e1));
+  event_log_.StopLogging([] {});
+  // Logged before the pending output task runs, but after logging stopped.
+  event_log_.Log(std::move(e2));
+  EXPECT_CALL(*encoder_ptr_, OnEncode(Ref(*e1_ptr)));
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  Mock::VerifyAndClearExpectations(encoder_ptr_);
+
+  EXPECT_CALL(*encoder_ptr_, OnEncode(Ref(*e2_ptr)));
+  event_log_.StartLogging(std::make_unique<FakeOutput>(written_data_),
+                          RtcEventLog::kImmediateOutput);
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  Mock::VerifyAndClearExpectations(encoder_ptr_);
+}
+
+TEST_F(RtcEventLogImplTest, KeepsOneInEverySamplingIntervalEvents) {
+  std::vector<std::unique_ptr<FakeEvent>> events;
+  for (int i = 0; i < 7; ++i) {
+    events.push_back(std::make_unique<FakeEvent>());
+  }
+  InSequence s;
+  EXPECT_CALL(*encoder_ptr_, OnEncode(Ref(*events[0])));
+  EXPECT_CALL(*encoder_ptr_, OnEncode(Ref(*events[3])));
+  EXPECT_CALL(*encoder_ptr_, OnEncode(Ref(*events[6])));
+  event_log_.SetSamplingInterval(RtcEvent::Type::FakeEvent, 3);
+  event_log_.StartLogging(std::move(output_), RtcEventLog::kImmediateOutput);
+  for (std::unique_ptr<FakeEvent>& event : events) {
+    event_log_.Log(std::move(event));
+  }
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  Mock::VerifyAndClearExpectations(encoder_ptr_);
+}
+
+TEST_F(RtcEventLogImplTest, DoesNotSampleConfigEvents) {
+  EXPECT_CALL(*encoder_ptr_, OnEncode(Property(&RtcEvent::IsConfigEvent, true)))
+      .Times(3);
+  event_log_.SetSamplingInterval(RtcEvent::Type::FakeEvent, 3);
+  event_log_.StartLogging(std::move(output_), RtcEventLog::kImmediateOutput);
+  for (int i = 0; i < 3; ++i) {
+    event_log_.Log(std::make_unique<FakeConfigEvent>());
+  }
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  Mock::VerifyAndClearExpectations(encoder_ptr_);
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -25,6 +25,7 @@
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "api/rtp_headers.h"
 #include "api/rtp_parameters.h"
+#include "logging/rtc_event_log/chunked_file_reader.h"
 #include "logging/rtc_event_log/dependency_descriptor_encoder_decoder.h"
 #include "logging/rtc_event_log/encoder/blob_encoding.h"
 #include "logging/rtc_event_log/encoder/delta_encoding.h"
@@ -1110,15 +1111,22 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseFile(
   RTC_PARSE_CHECK_OR_RETURN_LE(signed_filesize, kMaxLogSize);
   size_t filesize = rtc::checked_cast<size_t>(signed_filesize);
 
-  // Read file into memory.
-  std::string buffer(filesize, '\0');
-  size_t bytes_read = file.Read(&buffer[0], buffer.size());
-  if (bytes_read != filesize) {
+  // The file is parsed while it's being read, so that the whole log doesn't
+  // have to be kept in memory in addition to the parsed events.
+  ChunkedFileReader reader(file, filesize);
+  Clear();
+  ParseStatus status = ParseStreamInternal(
+      absl::string_view(),
+      [&reader](absl::string_view unparsed, size_t min_size) {
+        return reader.ReadMore(unparsed, min_size);
+      });
+  if (reader.read_failed()) {
     RTC_LOG(LS_WARNING) << "Failed to read file " << filename;
-    RTC_PARSE_CHECK_OR_RETURN_EQ(bytes_read, filesize);
+    RTC_PARSE_CHECK_OR_RETURN(!reader.read_failed());
   }
 
-  return ParseStream(buffer);
+  RTC_RETURN_IF_ERROR(ProcessParsedEvents());
+  return status;
 }
 
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseString(
@@ -1129,8 +1137,14 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseString(
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStream(
     absl::string_view s) {
   Clear();
-  ParseStatus status = ParseStreamInternal(s);
+  ParseStatus status = ParseStreamInternal(
+      s, [](absl::string_view unparsed, size_t min_size) { return unparsed; });
+
+  RTC_RETURN_IF_ERROR(ProcessParsedEvents());
+  return status;
+}
 
+ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ProcessParsedEvents() {
   // Cache the configured SSRCs.
   for (const auto& video_recv_config : video_recv_configs()) {
     incoming_video_ssrcs_.insert(video_recv_config.config.remote_ssrc);
@@ -1278,12 +1292,15 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStream(
     first_timestamp_ = last_timestamp_ = Timestamp::Zero();
   }
 
-  return status;
+  return ParseStatus::Success();
 }
 
 ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternal(
-    absl::string_view s) {
+    absl::string_view s,
+    ReadMoreFunction read_more) {
   constexpr uint64_t kMaxEventSize = 10000000;  // Sanity check.
+  // Enough to hold the field tag and the message length.
+  const size_t kMaxEventHeaderSize = 2 * kMaxVarIntLengthBytes;
   // Protobuf defines the message tag as
   // (field_number << 3) | wire_type. In the legacy encoding, the field number
   // is supposed to be 1 and the wire type for a length-delimited field is 2.
@@ -1293,6 +1310,7 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternal(
   bool success = false;
 
   // "Peek" at the first varint.
+  s = read_more(s, kMaxEventHeaderSize);
   absl::string_view event_start = s;
   uint64_t tag = 0;
   std::tie(success, std::ignore) = DecodeVarInt(s, &tag);
@@ -1306,10 +1324,11 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternal(
   s = event_start;
 
   if (tag >> 1 == static_cast<uint64_t>(RtcEvent::Type::BeginV3Log)) {
-    return ParseStreamInternalV3(s);
+    return ParseStreamInternalV3(
+        read_more(s, std::numeric_limits<size_t>::max()));
   }
 
-  while (!s.empty()) {
+  while (!(s = read_more(s, kMaxEventHeaderSize)).empty()) {
     // If not, "reset" event_start and read the field tag for the next event.
     event_start = s;
     std::tie(success, s) = DecodeVarInt(s, &tag);
@@ -1344,6 +1363,13 @@ ParsedRtcEventLog::ParseStatus ParsedRtcEventLog::ParseStreamInternal(
                                 __FILE__, __LINE__);
     }
 
+    if (message_length > s.size() && message_length <= kMaxEventSize) {
+      // The rest of the message may not have been read yet.
+      const size_t header_size = event_start.size() - s.size();
+      event_start = read_more(event_start, header_size + message_length);
+      s = event_start.substr(header_size);
+    }
+
     if (message_length > s.size()) {
       RTC_LOG(LS_WARNING) << "Protobuf message length is larger than the "
                              "remaining bytes in the proto.";
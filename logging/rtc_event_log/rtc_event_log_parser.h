@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "absl/base/attributes.h"
+#include "absl/functional/function_ref.h"
 #include "absl/strings/string_view.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "call/video_receive_stream.h"
@@ -665,8 +666,19 @@ class ParsedRtcEventLog {
   std::vector<InferredRouteChangeEvent> GetRouteChanges() const;
 
  private:
-  ABSL_MUST_USE_RESULT ParseStatus ParseStreamInternal(absl::string_view s);
+  // Returns `unparsed`, which is what remains of the previously returned data,
+  // extended so that it's at least `min_size` bytes long if the log has that
+  // much data left.
+  using ReadMoreFunction = absl::FunctionRef<absl::string_view(
+      absl::string_view unparsed,
+      size_t min_size)>;
+
+  ABSL_MUST_USE_RESULT ParseStatus
+  ParseStreamInternal(absl::string_view s, ReadMoreFunction read_more);
   ABSL_MUST_USE_RESULT ParseStatus ParseStreamInternalV3(absl::string_view s);
+  // Derives the SSRC sets, RTP stream views, RTCP blocks and log segments from
+  // the parsed events.
+  ABSL_MUST_USE_RESULT ParseStatus ProcessParsedEvents();
 
   ABSL_MUST_USE_RESULT ParseStatus
   StoreParsedLegacyEvent(const rtclog::Event& event);
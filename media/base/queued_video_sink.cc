@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/base/queued_video_sink.h"
+
+#include <utility>
+
+#include "api/sequence_checker.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+QueuedVideoSink::QueuedVideoSink(rtc::VideoSinkInterface<VideoFrame>* sink,
+                                 TaskQueueBase* task_queue)
+    : sink_(sink),
+      task_queue_(task_queue),
+      safety_(PendingTaskSafetyFlag::CreateAttachedToTaskQueue(
+          /*alive=*/true,
+          task_queue)) {
+  RTC_DCHECK(sink_);
+}
+
+QueuedVideoSink::~QueuedVideoSink() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  safety_->SetNotAlive();
+}
+
+int64_t QueuedVideoSink::delivered_frames() const {
+  MutexLock lock(&lock_);
+  return delivered_frames_;
+}
+
+int64_t QueuedVideoSink::dropped_frames() const {
+  MutexLock lock(&lock_);
+  return dropped_frames_;
+}
+
+void QueuedVideoSink::OnFrame(const VideoFrame& frame) {
+  MutexLock lock(&lock_);
+  if (pending_frame_) {
+    // The previous frame is still waiting for `sink_`; replace it, and make
+    // the update rect cover the changes it carried.
+    ++dropped_frames_;
+    absl::optional<VideoFrame::UpdateRect> update_rect;
+    if (frame.has_update_rect() && pending_frame_->has_update_rect() &&
+        frame.width() == pending_frame_->width() &&
+        frame.height() == pending_frame_->height()) {
+      update_rect = pending_frame_->update_rect();
+      update_rect->Union(frame.update_rect());
+    }
+    pending_frame_ = frame;
+    if (update_rect) {
+      pending_frame_->set_update_rect(*update_rect);
+    } else {
+      pending_frame_->clear_update_rect();
+    }
+    return;
+  }
+  pending_frame_ = frame;
+  task_queue_->PostTask(SafeTask(safety_, [this] { DeliverFrame(); }));
+}
+
+void QueuedVideoSink::OnDiscardedFrame() {
+  task_queue_->PostTask(
+      SafeTask(safety_, [this] { sink_->OnDiscardedFrame(); }));
+}
+
+void QueuedVideoSink::OnConstraintsChanged(
+    const VideoTrackSourceConstraints& constraints) {
+  task_queue_->PostTask(SafeTask(safety_, [this, constraints] {
+    sink_->OnConstraintsChanged(constraints);
+  }));
+}
+
+void QueuedVideoSink::DeliverFrame() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  absl::optional<VideoFrame> frame;
+  {
+    MutexLock lock(&lock_);
+    frame = std::move(pending_frame_);
+    pending_frame_.reset();
+    ++delivered_frames_;
+  }
+  RTC_DCHECK(frame);
+  sink_->OnFrame(*frame);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MEDIA_BASE_QUEUED_VIDEO_SINK_H_
+#define MEDIA_BASE_QUEUED_VIDEO_SINK_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_sink_interface.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Delivers the frames it gets to `sink` on `task_queue` instead of on the
+// calling thread, keeping only the latest frame that has not been delivered
+// yet. A frame that is replaced before it is delivered is dropped and
+// counted, and the update rect of the replacing frame is widened to cover
+// it.
+//
+// Meant to be added to a source, such as an rtc::VideoBroadcaster, in place
+// of a sink that may be slow, so that the slow sink neither stalls the
+// capture thread nor delays the other sinks of the source:
+//
+//   QueuedVideoSink queued_sink(&recorder, recorder_queue);
+//   broadcaster.AddOrUpdateSink(&queued_sink, wants);
+//
+// OnFrame() and OnDiscardedFrame() may be called on any thread. The
+// QueuedVideoSink must be removed from its source before it is destroyed,
+// and destroyed on `task_queue`; `sink` gets no calls after that.
+class QueuedVideoSink : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  QueuedVideoSink(rtc::VideoSinkInterface<VideoFrame>* sink,
+                  TaskQueueBase* task_queue);
+  ~QueuedVideoSink() override;
+
+  // Number of frames delivered to, and dropped before reaching, `sink`.
+  int64_t delivered_frames() const;
+  int64_t dropped_frames() const;
+
+  // rtc::VideoSinkInterface implementation.
+  void OnFrame(const VideoFrame& frame) override;
+  void OnDiscardedFrame() override;
+  void OnConstraintsChanged(
+      const VideoTrackSourceConstraints& constraints) override;
+
+ private:
+  void DeliverFrame();
+
+  rtc::VideoSinkInterface<VideoFrame>* const sink_;
+  TaskQueueBase* const task_queue_;
+  const rtc::scoped_refptr<PendingTaskSafetyFlag> safety_;
+  mutable Mutex lock_;
+  absl::optional<VideoFrame> pending_frame_ RTC_GUARDED_BY(lock_);
+  int64_t delivered_frames_ RTC_GUARDED_BY(lock_) = 0;
+  int64_t dropped_frames_ RTC_GUARDED_BY(lock_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MEDIA_BASE_QUEUED_VIDEO_SINK_H_
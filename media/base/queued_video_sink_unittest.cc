@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/base/queued_video_sink.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "api/video/i420_buffer.h"
+#include "media/base/fake_video_renderer.h"
+#include "media/base/video_broadcaster.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 48;
+
+class RecordingSink : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  void OnFrame(const VideoFrame& frame) override { frames_.push_back(frame); }
+  void OnDiscardedFrame() override { ++discarded_frames_; }
+
+  const std::vector<VideoFrame>& frames() const { return frames_; }
+  int discarded_frames() const { return discarded_frames_; }
+
+ private:
+  std::vector<VideoFrame> frames_;
+  int discarded_frames_ = 0;
+};
+
+VideoFrame CreateFrame(uint16_t id,
+                       absl::optional<VideoFrame::UpdateRect> update_rect =
+                           absl::nullopt) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(kWidth, kHeight);
+  I420Buffer::SetBlack(buffer.get());
+  return VideoFrame::Builder()
+      .set_video_frame_buffer(buffer)
+      .set_id(id)
+      .set_update_rect(update_rect)
+      .build();
+}
+
+class QueuedVideoSinkTest : public ::testing::Test {
+ public:
+  QueuedVideoSinkTest()
+      : time_controller_(Timestamp::Seconds(1)),
+        task_queue_(time_controller_.GetTaskQueueFactory()->CreateTaskQueue(
+            "SinkQueue",
+            TaskQueueFactory::Priority::NORMAL)),
+        queued_sink_(std::make_unique<QueuedVideoSink>(&sink_,
+                                                       task_queue_.get())) {}
+
+  ~QueuedVideoSinkTest() override { DestroyQueuedSink(); }
+
+  void RunTasks() { time_controller_.AdvanceTime(TimeDelta::Zero()); }
+
+  void DestroyQueuedSink() {
+    task_queue_->PostTask([this] { queued_sink_ = nullptr; });
+    RunTasks();
+  }
+
+ protected:
+  GlobalSimulatedTimeController time_controller_;
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue_;
+  RecordingSink sink_;
+  std::unique_ptr<QueuedVideoSink> queued_sink_;
+};
+
+TEST_F(QueuedVideoSinkTest, DeliversFramesOnTaskQueue) {
+  queued_sink_->OnFrame(CreateFrame(1));
+  EXPECT_TRUE(sink_.frames().empty());
+  RunTasks();
+  ASSERT_EQ(sink_.frames().size(), 1u);
+  EXPECT_EQ(sink_.frames()[0].id(), 1);
+
+  queued_sink_->OnFrame(CreateFrame(2));
+  queued_sink_->OnDiscardedFrame();
+  RunTasks();
+  ASSERT_EQ(sink_.frames().size(), 2u);
+  EXPECT_EQ(sink_.frames()[1].id(), 2);
+  EXPECT_EQ(sink_.discarded_frames(), 1);
+  EXPECT_EQ(queued_sink_->delivered_frames(), 2);
+  EXPECT_EQ(queued_sink_->dropped_frames(), 0);
+}
+
+TEST_F(QueuedVideoSinkTest, LatestFrameWins) {
+  for (uint16_t id = 1; id <= 3; ++id) {
+    queued_sink_->OnFrame(CreateFrame(id));
+  }
+  RunTasks();
+  ASSERT_EQ(sink_.frames().size(), 1u);
+  EXPECT_EQ(sink_.frames()[0].id(), 3);
+  EXPECT_EQ(queued_sink_->delivered_frames(), 1);
+  EXPECT_EQ(queued_sink_->dropped_frames(), 2);
+}
+
+TEST_F(QueuedVideoSinkTest, UpdateRectCoversDroppedFrames) {
+  queued_sink_->OnFrame(CreateFrame(1, VideoFrame::UpdateRect{0, 0, 8, 8}));
+  queued_sink_->OnFrame(CreateFrame(2, VideoFrame::UpdateRect{16, 8, 8, 8}));
+  RunTasks();
+  ASSERT_EQ(sink_.frames().size(), 1u);
+  EXPECT_EQ(sink_.frames()[0].update_rect(),
+            (VideoFrame::UpdateRect{0, 0, 24, 16}));
+
+  // Without an update rect on one of the frames, the whole frame may have
+  // changed.
+  queued_sink_->OnFrame(CreateFrame(3));
+  queued_sink_->OnFrame(CreateFrame(4, VideoFrame::UpdateRect{0, 0, 8, 8}));
+  RunTasks();
+  ASSERT_EQ(sink_.frames().size(), 2u);
+  EXPECT_FALSE(sink_.frames()[1].has_update_rect());
+}
+
+TEST_F(QueuedVideoSinkTest, NothingIsDeliveredAfterDestruction) {
+  // Destroy the queued sink before its pending tasks run.
+  task_queue_->PostTask([this] {
+    queued_sink_->OnFrame(CreateFrame(1));
+    queued_sink_->OnDiscardedFrame();
+    queued_sink_ = nullptr;
+  });
+  RunTasks();
+  EXPECT_TRUE(sink_.frames().empty());
+  EXPECT_EQ(sink_.discarded_frames(), 0);
+}
+
+TEST_F(QueuedVideoSinkTest, SlowSinkDoesNotDelayOtherBroadcasterSinks) {
+  rtc::VideoBroadcaster broadcaster;
+  cricket::FakeVideoRenderer direct_sink;
+  broadcaster.AddOrUpdateSink(&direct_sink, rtc::VideoSinkWants());
+  broadcaster.AddOrUpdateSink(queued_sink_.get(), rtc::VideoSinkWants());
+
+  // The task queue of the queued sink doesn't run while the frames are
+  // broadcast, as if its sink was busy.
+  for (uint16_t id = 1; id <= 5; ++id) {
+    broadcaster.OnFrame(CreateFrame(id));
+  }
+  EXPECT_EQ(direct_sink.num_rendered_frames(), 5);
+  EXPECT_TRUE(sink_.frames().empty());
+
+  RunTasks();
+  ASSERT_EQ(sink_.frames().size(), 1u);
+  EXPECT_EQ(sink_.frames()[0].id(), 5);
+  EXPECT_EQ(queued_sink_->dropped_frames(), 4);
+  broadcaster.RemoveSink(queued_sink_.get());
+  broadcaster.RemoveSink(&direct_sink);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/base/received_rtp_packet_queue.h"
+
+#include <utility>
+
+#include "api/sequence_checker.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+ReceivedRtpPacketQueue::ReceivedRtpPacketQueue(TaskQueueBase* task_queue,
+                                               Handler handler)
+    : task_queue_(task_queue),
+      handler_(std::move(handler)),
+      safety_(PendingTaskSafetyFlag::CreateAttachedToTaskQueue(
+          /*alive=*/true,
+          task_queue)) {
+  RTC_DCHECK(handler_);
+}
+
+ReceivedRtpPacketQueue::~ReceivedRtpPacketQueue() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  safety_->SetNotAlive();
+}
+
+void ReceivedRtpPacketQueue::Push(RtpPacketReceived packet) {
+  bool post_task;
+  {
+    MutexLock lock(&lock_);
+    post_task = pending_packets_.empty();
+    pending_packets_.push_back(std::move(packet));
+  }
+  if (post_task) {
+    task_queue_->PostTask(SafeTask(safety_, [this] { DeliverPackets(); }));
+  }
+}
+
+void ReceivedRtpPacketQueue::DeliverPackets() {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  RTC_DCHECK(delivered_packets_.empty());
+  {
+    MutexLock lock(&lock_);
+    delivered_packets_.swap(pending_packets_);
+  }
+  for (RtpPacketReceived& packet : delivered_packets_) {
+    handler_(std::move(packet));
+  }
+  delivered_packets_.clear();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MEDIA_BASE_RECEIVED_RTP_PACKET_QUEUE_H_
+#define MEDIA_BASE_RECEIVED_RTP_PACKET_QUEUE_H_
+
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Hands the RTP packets a media channel receives on the network thread over
+// to `handler` on `task_queue`, the worker thread. A task is only posted for
+// a packet that arrives when none is pending; packets that arrive while one
+// is pending are delivered by the same task, in order. A burst of packets
+// read from the socket together thus crosses threads in a handful of tasks
+// rather than in one task per packet.
+//
+// Push() may be called on any thread. The queue must be destroyed on
+// `task_queue`; `handler` gets no calls after that.
+class ReceivedRtpPacketQueue {
+ public:
+  using Handler = absl::AnyInvocable<void(RtpPacketReceived packet)>;
+
+  ReceivedRtpPacketQueue(TaskQueueBase* task_queue, Handler handler);
+  ~ReceivedRtpPacketQueue();
+
+  void Push(RtpPacketReceived packet);
+
+ private:
+  void DeliverPackets();
+
+  TaskQueueBase* const task_queue_;
+  Handler handler_;
+  const rtc::scoped_refptr<PendingTaskSafetyFlag> safety_;
+  Mutex lock_;
+  std::vector<RtpPacketReceived> pending_packets_ RTC_GUARDED_BY(lock_);
+  // Only used by DeliverPackets(), kept to reuse its capacity.
+  std::vector<RtpPacketReceived> delivered_packets_;
+};
+
+}  // namespace webrtc
+
+#endif  // MEDIA_BASE_RECEIVED_RTP_PACKET_QUEUE_H_
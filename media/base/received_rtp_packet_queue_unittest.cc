@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/base/received_rtp_packet_queue.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+// Task queue that holds on to posted tasks until they are run.
+class FakeTaskQueue : public TaskQueueBase {
+ public:
+  void Delete() override {}
+  void PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                    const PostTaskTraits& /*traits*/,
+                    const Location& /*location*/) override {
+    tasks_.push_back(std::move(task));
+  }
+  void PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                           TimeDelta /*delay*/,
+                           const PostDelayedTaskTraits& /*traits*/,
+                           const Location& /*location*/) override {
+    RTC_DCHECK_NOTREACHED();
+  }
+
+  size_t num_pending_tasks() const { return tasks_.size(); }
+
+  void RunTasks() {
+    std::vector<absl::AnyInvocable<void() &&>> tasks = std::move(tasks_);
+    tasks_.clear();
+    for (absl::AnyInvocable<void() &&>& task : tasks) {
+      RunOnQueue(std::move(task));
+    }
+  }
+
+  void RunOnQueue(absl::AnyInvocable<void() &&> task) {
+    CurrentTaskQueueSetter set_current(this);
+    std::move(task)();
+  }
+
+ private:
+  std::vector<absl::AnyInvocable<void() &&>> tasks_;
+};
+
+RtpPacketReceived CreatePacket(uint16_t sequence_number) {
+  RtpPacketReceived packet;
+  packet.SetSequenceNumber(sequence_number);
+  return packet;
+}
+
+class ReceivedRtpPacketQueueTest : public ::testing::Test {
+ public:
+  ReceivedRtpPacketQueueTest() {
+    task_queue_.RunOnQueue([this] {
+      queue_ = std::make_unique<ReceivedRtpPacketQueue>(
+          &task_queue_, [this](RtpPacketReceived packet) {
+            delivered_.push_back(packet.SequenceNumber());
+          });
+    });
+  }
+
+  ~ReceivedRtpPacketQueueTest() override { DestroyQueue(); }
+
+  void DestroyQueue() {
+    task_queue_.RunOnQueue([this] { queue_ = nullptr; });
+  }
+
+ protected:
+  FakeTaskQueue task_queue_;
+  std::vector<uint16_t> delivered_;
+  std::unique_ptr<ReceivedRtpPacketQueue> queue_;
+};
+
+TEST_F(ReceivedRtpPacketQueueTest, PacketsPushedWhileTaskIsPendingShareIt) {
+  queue_->Push(CreatePacket(1));
+  queue_->Push(CreatePacket(2));
+  queue_->Push(CreatePacket(3));
+  EXPECT_EQ(task_queue_.num_pending_tasks(), 1u);
+  EXPECT_TRUE(delivered_.empty());
+
+  task_queue_.RunTasks();
+  EXPECT_THAT(delivered_, ElementsAre(1, 2, 3));
+
+  // The next packet needs a task of its own.
+  queue_->Push(CreatePacket(4));
+  EXPECT_EQ(task_queue_.num_pending_tasks(), 1u);
+  task_queue_.RunTasks();
+  EXPECT_THAT(delivered_, ElementsAre(1, 2, 3, 4));
+}
+
+TEST_F(ReceivedRtpPacketQueueTest, NothingIsDeliveredAfterDestruction) {
+  queue_->Push(CreatePacket(1));
+  DestroyQueue();
+  task_queue_.RunTasks();
+  EXPECT_TRUE(delivered_.empty());
+}
+
+}  // namespace
+}  // namespace webrtc
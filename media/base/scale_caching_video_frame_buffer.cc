@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/base/scale_caching_video_frame_buffer.h"
+
+#include <utility>
+
+#include "api/make_ref_counted.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+ScaledBufferCache::ScaledBufferCache() = default;
+ScaledBufferCache::~ScaledBufferCache() = default;
+
+rtc::scoped_refptr<VideoFrameBuffer> ScaledBufferCache::CropAndScale(
+    VideoFrameBuffer& buffer,
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  MutexLock lock(&mutex_);
+  for (const CachedBuffer& cached : cached_buffers_) {
+    if (cached.offset_x == offset_x && cached.offset_y == offset_y &&
+        cached.crop_width == crop_width && cached.crop_height == crop_height &&
+        cached.scaled_width == scaled_width &&
+        cached.scaled_height == scaled_height) {
+      return cached.buffer;
+    }
+  }
+  rtc::scoped_refptr<VideoFrameBuffer> scaled_buffer = buffer.CropAndScale(
+      offset_x, offset_y, crop_width, crop_height, scaled_width, scaled_height);
+  if (scaled_buffer && cached_buffers_.size() < kMaxCachedBuffers) {
+    cached_buffers_.push_back({offset_x, offset_y, crop_width, crop_height,
+                               scaled_width, scaled_height, scaled_buffer});
+  }
+  return scaled_buffer;
+}
+
+rtc::scoped_refptr<ScaleCachingI420Buffer> ScaleCachingI420Buffer::Create(
+    rtc::scoped_refptr<I420BufferInterface> buffer) {
+  return rtc::make_ref_counted<ScaleCachingI420Buffer>(std::move(buffer));
+}
+
+ScaleCachingI420Buffer::ScaleCachingI420Buffer(
+    rtc::scoped_refptr<I420BufferInterface> buffer)
+    : buffer_(std::move(buffer)) {
+  RTC_DCHECK(buffer_);
+}
+
+ScaleCachingI420Buffer::~ScaleCachingI420Buffer() = default;
+
+rtc::scoped_refptr<VideoFrameBuffer> ScaleCachingI420Buffer::CropAndScale(
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  return cache_.CropAndScale(*buffer_, offset_x, offset_y, crop_width,
+                             crop_height, scaled_width, scaled_height);
+}
+
+rtc::scoped_refptr<ScaleCachingNV12Buffer> ScaleCachingNV12Buffer::Create(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer) {
+  return rtc::make_ref_counted<ScaleCachingNV12Buffer>(std::move(buffer));
+}
+
+ScaleCachingNV12Buffer::ScaleCachingNV12Buffer(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer)
+    : buffer_(std::move(buffer)), nv12_(buffer_->GetNV12()) {}
+
+ScaleCachingNV12Buffer::~ScaleCachingNV12Buffer() = default;
+
+rtc::scoped_refptr<I420BufferInterface> ScaleCachingNV12Buffer::ToI420() {
+  MutexLock lock(&i420_mutex_);
+  if (!i420_buffer_) {
+    i420_buffer_ = buffer_->ToI420();
+  }
+  return i420_buffer_;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> ScaleCachingNV12Buffer::CropAndScale(
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    int scaled_width,
+    int scaled_height) {
+  return cache_.CropAndScale(*buffer_, offset_x, offset_y, crop_width,
+                             crop_height, scaled_width, scaled_height);
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> CreateScaleCachingBuffer(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer) {
+  switch (buffer->type()) {
+    case VideoFrameBuffer::Type::kI420:
+      return ScaleCachingI420Buffer::Create(buffer->ToI420());
+    case VideoFrameBuffer::Type::kNV12:
+      return ScaleCachingNV12Buffer::Create(std::move(buffer));
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MEDIA_BASE_SCALE_CACHING_VIDEO_FRAME_BUFFER_H_
+#define MEDIA_BASE_SCALE_CACHING_VIDEO_FRAME_BUFFER_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Remembers the results of CropAndScale() on a buffer. May be used from
+// several threads.
+class ScaledBufferCache {
+ public:
+  // The number of scaled buffers remembered. Further resolutions are scaled
+  // on every call.
+  static constexpr size_t kMaxCachedBuffers = 4;
+
+  ScaledBufferCache();
+  ~ScaledBufferCache();
+
+  // Returns the cached result of `buffer.CropAndScale()` with the same
+  // arguments, or calls it and caches the result.
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(VideoFrameBuffer& buffer,
+                                                    int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height);
+
+ private:
+  struct CachedBuffer {
+    int offset_x;
+    int offset_y;
+    int crop_width;
+    int crop_height;
+    int scaled_width;
+    int scaled_height;
+    rtc::scoped_refptr<VideoFrameBuffer> buffer;
+  };
+
+  // Held while scaling, so that concurrent calls for the same resolution
+  // wait for the first one instead of scaling too.
+  Mutex mutex_;
+  std::vector<CachedBuffer> cached_buffers_ RTC_GUARDED_BY(mutex_);
+};
+
+// Wraps an I420 buffer and remembers the results of CropAndScale(), so that
+// sinks of the same frame that scale it to the same resolution, e.g. the
+// encoders of several send streams fed by one track, share a single scaling
+// pass. May be used from several threads.
+class ScaleCachingI420Buffer : public I420BufferInterface {
+ public:
+  static rtc::scoped_refptr<ScaleCachingI420Buffer> Create(
+      rtc::scoped_refptr<I420BufferInterface> buffer);
+
+  int width() const override { return buffer_->width(); }
+  int height() const override { return buffer_->height(); }
+  const uint8_t* DataY() const override { return buffer_->DataY(); }
+  const uint8_t* DataU() const override { return buffer_->DataU(); }
+  const uint8_t* DataV() const override { return buffer_->DataV(); }
+  int StrideY() const override { return buffer_->StrideY(); }
+  int StrideU() const override { return buffer_->StrideU(); }
+  int StrideV() const override { return buffer_->StrideV(); }
+
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) override;
+
+ protected:
+  explicit ScaleCachingI420Buffer(
+      rtc::scoped_refptr<I420BufferInterface> buffer);
+  ~ScaleCachingI420Buffer() override;
+
+ private:
+  const rtc::scoped_refptr<I420BufferInterface> buffer_;
+  ScaledBufferCache cache_;
+};
+
+// Like ScaleCachingI420Buffer, for NV12 buffers. Also remembers the result of
+// ToI420(), so that sinks that can't take NV12 share a single conversion.
+class ScaleCachingNV12Buffer : public NV12BufferInterface {
+ public:
+  // `buffer` must be of type kNV12.
+  static rtc::scoped_refptr<ScaleCachingNV12Buffer> Create(
+      rtc::scoped_refptr<VideoFrameBuffer> buffer);
+
+  int width() const override { return nv12_->width(); }
+  int height() const override { return nv12_->height(); }
+  const uint8_t* DataY() const override { return nv12_->DataY(); }
+  const uint8_t* DataUV() const override { return nv12_->DataUV(); }
+  int StrideY() const override { return nv12_->StrideY(); }
+  int StrideUV() const override { return nv12_->StrideUV(); }
+
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(int offset_x,
+                                                    int offset_y,
+                                                    int crop_width,
+                                                    int crop_height,
+                                                    int scaled_width,
+                                                    int scaled_height) override;
+
+ protected:
+  explicit ScaleCachingNV12Buffer(rtc::scoped_refptr<VideoFrameBuffer> buffer);
+  ~ScaleCachingNV12Buffer() override;
+
+ private:
+  const rtc::scoped_refptr<VideoFrameBuffer> buffer_;
+  const NV12BufferInterface* const nv12_;
+  ScaledBufferCache cache_;
+  Mutex i420_mutex_;
+  rtc::scoped_refptr<I420BufferInterface> i420_buffer_
+      RTC_GUARDED_BY(i420_mutex_);
+};
+
+// Returns `buffer` wrapped in one of the buffers above, or nullptr if there's
+// none for its type.
+rtc::scoped_refptr<VideoFrameBuffer> CreateScaleCachingBuffer(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer);
+
+}  // namespace webrtc
+
+#endif  // MEDIA_BASE_SCALE_CACHING_VIDEO_FRAME_BUFFER_H_
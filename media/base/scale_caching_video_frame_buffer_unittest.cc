@@ -0,0 +1,101 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/base/scale_caching_video_frame_buffer.h"
+
+#include "api/video/i420_buffer.h"
+#include "api/video/i444_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+rtc::scoped_refptr<ScaleCachingI420Buffer> CreateBuffer() {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(64, 48);
+  buffer->InitializeData();
+  return ScaleCachingI420Buffer::Create(buffer);
+}
+
+TEST(ScaleCachingI420BufferTest, ForwardsPlanes) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(64, 48);
+  auto caching_buffer = ScaleCachingI420Buffer::Create(buffer);
+  EXPECT_EQ(caching_buffer->type(), VideoFrameBuffer::Type::kI420);
+  EXPECT_EQ(caching_buffer->width(), 64);
+  EXPECT_EQ(caching_buffer->height(), 48);
+  EXPECT_EQ(caching_buffer->DataY(), buffer->DataY());
+  EXPECT_EQ(caching_buffer->DataU(), buffer->DataU());
+  EXPECT_EQ(caching_buffer->DataV(), buffer->DataV());
+  EXPECT_EQ(caching_buffer->StrideY(), buffer->StrideY());
+  EXPECT_EQ(caching_buffer->StrideU(), buffer->StrideU());
+  EXPECT_EQ(caching_buffer->StrideV(), buffer->StrideV());
+}
+
+TEST(ScaleCachingI420BufferTest, ScalesOncePerCropAndSize) {
+  auto buffer = CreateBuffer();
+  rtc::scoped_refptr<VideoFrameBuffer> scaled = buffer->Scale(32, 24);
+  ASSERT_TRUE(scaled);
+  EXPECT_EQ(scaled->width(), 32);
+  EXPECT_EQ(scaled->height(), 24);
+  EXPECT_EQ(buffer->Scale(32, 24), scaled);
+  EXPECT_EQ(buffer->CropAndScale(0, 0, 64, 48, 32, 24), scaled);
+
+  EXPECT_NE(buffer->Scale(16, 12), scaled);
+  EXPECT_NE(buffer->CropAndScale(2, 0, 60, 48, 32, 24), scaled);
+}
+
+TEST(ScaleCachingI420BufferTest, ScalesOnEveryCallWhenFull) {
+  auto buffer = CreateBuffer();
+  for (size_t i = 0; i < ScaledBufferCache::kMaxCachedBuffers; ++i) {
+    buffer->Scale(32 - 2 * i, 24);
+  }
+  rtc::scoped_refptr<VideoFrameBuffer> scaled = buffer->Scale(8, 6);
+  ASSERT_TRUE(scaled);
+  EXPECT_NE(buffer->Scale(8, 6), scaled);
+  EXPECT_EQ(buffer->Scale(32, 24), buffer->Scale(32, 24));
+}
+
+TEST(ScaleCachingNV12BufferTest, ForwardsPlanes) {
+  rtc::scoped_refptr<NV12Buffer> buffer = NV12Buffer::Create(64, 48);
+  auto caching_buffer = ScaleCachingNV12Buffer::Create(buffer);
+  EXPECT_EQ(caching_buffer->type(), VideoFrameBuffer::Type::kNV12);
+  EXPECT_EQ(caching_buffer->width(), 64);
+  EXPECT_EQ(caching_buffer->height(), 48);
+  EXPECT_EQ(caching_buffer->DataY(), buffer->DataY());
+  EXPECT_EQ(caching_buffer->DataUV(), buffer->DataUV());
+  EXPECT_EQ(caching_buffer->StrideY(), buffer->StrideY());
+  EXPECT_EQ(caching_buffer->StrideUV(), buffer->StrideUV());
+}
+
+TEST(ScaleCachingNV12BufferTest, ConvertsAndScalesOnce) {
+  rtc::scoped_refptr<NV12Buffer> buffer = NV12Buffer::Create(64, 48);
+  buffer->InitializeData();
+  auto caching_buffer = ScaleCachingNV12Buffer::Create(buffer);
+
+  rtc::scoped_refptr<I420BufferInterface> i420 = caching_buffer->ToI420();
+  ASSERT_TRUE(i420);
+  EXPECT_EQ(caching_buffer->ToI420(), i420);
+
+  rtc::scoped_refptr<VideoFrameBuffer> scaled = caching_buffer->Scale(32, 24);
+  ASSERT_TRUE(scaled);
+  EXPECT_EQ(scaled->type(), VideoFrameBuffer::Type::kNV12);
+  EXPECT_EQ(caching_buffer->Scale(32, 24), scaled);
+}
+
+TEST(ScaleCachingVideoFrameBufferTest, WrapsI420AndNV12Only) {
+  EXPECT_EQ(CreateScaleCachingBuffer(I420Buffer::Create(16, 16))->type(),
+            VideoFrameBuffer::Type::kI420);
+  EXPECT_EQ(CreateScaleCachingBuffer(NV12Buffer::Create(16, 16))->type(),
+            VideoFrameBuffer::Type::kNV12);
+  EXPECT_FALSE(CreateScaleCachingBuffer(I444Buffer::Create(16, 16)));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -11,11 +11,14 @@
 #include "media/base/video_broadcaster.h"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/types/optional.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_rotation.h"
+#include "media/base/scale_caching_video_frame_buffer.h"
 #include "media/base/video_common.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -66,6 +69,21 @@ VideoSinkWants VideoBroadcaster::wants() const {
 void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
   webrtc::MutexLock lock(&sinks_and_wants_lock_);
   bool current_frame_was_discarded = false;
+  // When several sinks get the same frame, let them share the buffers they
+  // scale or convert it to, rather than each of them doing it on its own.
+  absl::optional<webrtc::VideoFrame> scale_caching_frame;
+  if (absl::c_count_if(sink_pairs(), [](const SinkPair& sink_pair) {
+        return !sink_pair.wants.black_frames;
+      }) > 1) {
+    rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer =
+        webrtc::CreateScaleCachingBuffer(frame.video_frame_buffer());
+    if (buffer) {
+      scale_caching_frame = frame;
+      scale_caching_frame->set_video_frame_buffer(std::move(buffer));
+    }
+  }
+  const webrtc::VideoFrame& sink_frame =
+      scale_caching_frame ? *scale_caching_frame : frame;
   for (auto& sink_pair : sink_pairs()) {
     if (sink_pair.wants.rotation_applied &&
         frame.rotation() != webrtc::kVideoRotation_0) {
@@ -91,11 +109,11 @@ void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
     } else if (!previous_frame_sent_to_all_sinks_ && frame.has_update_rect()) {
       // Since last frame was not sent to some sinks, no reliable update
       // information is available, so we need to clear the update rect.
-      webrtc::VideoFrame copy = frame;
+      webrtc::VideoFrame copy = sink_frame;
       copy.clear_update_rect();
       sink_pair.sink->OnFrame(copy);
     } else {
-      sink_pair.sink->OnFrame(frame);
+      sink_pair.sink->OnFrame(sink_frame);
     }
   }
   previous_frame_sent_to_all_sinks_ = !current_frame_was_discarded;
@@ -27,6 +27,10 @@ namespace rtc {
 // rtc::VideoSinkInterface. The class is threadsafe; methods may be called on
 // any thread. This is needed because VideoStreamEncoder calls AddOrUpdateSink
 // both on the worker thread and on the encoder task queue.
+//
+// Frames are delivered to all sinks synchronously on the thread calling
+// OnFrame(). A sink that may be slow can be wrapped in a
+// webrtc::QueuedVideoSink, so that it doesn't hold up the other sinks.
 class VideoBroadcaster : public VideoSourceBase,
                          public VideoSinkInterface<webrtc::VideoFrame> {
  public:
@@ -90,6 +90,42 @@ TEST(VideoBroadcasterTest, OnFrame) {
   EXPECT_EQ(3, sink2.num_rendered_frames());
 }
 
+TEST(VideoBroadcasterTest, SinksShareScaledBuffers) {
+  class ScalingSink : public rtc::VideoSinkInterface<webrtc::VideoFrame> {
+   public:
+    void OnFrame(const webrtc::VideoFrame& frame) override {
+      scaled_buffer = frame.video_frame_buffer()->Scale(50, 25);
+    }
+    rtc::scoped_refptr<webrtc::VideoFrameBuffer> scaled_buffer;
+  };
+
+  VideoBroadcaster broadcaster;
+  ScalingSink sink1;
+  ScalingSink sink2;
+  broadcaster.AddOrUpdateSink(&sink1, rtc::VideoSinkWants());
+  broadcaster.AddOrUpdateSink(&sink2, rtc::VideoSinkWants());
+
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(100, 50));
+  webrtc::I420Buffer::SetBlack(buffer.get());
+  webrtc::VideoFrame frame = webrtc::VideoFrame::Builder()
+                                 .set_video_frame_buffer(buffer)
+                                 .set_rotation(webrtc::kVideoRotation_0)
+                                 .set_timestamp_us(0)
+                                 .build();
+  broadcaster.OnFrame(frame);
+  ASSERT_TRUE(sink1.scaled_buffer);
+  EXPECT_EQ(sink1.scaled_buffer->width(), 50);
+  EXPECT_EQ(sink1.scaled_buffer, sink2.scaled_buffer);
+
+  // The next frame is scaled again.
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> scaled_buffer =
+      sink1.scaled_buffer;
+  broadcaster.OnFrame(frame);
+  EXPECT_NE(sink1.scaled_buffer, scaled_buffer);
+  EXPECT_EQ(sink1.scaled_buffer, sink2.scaled_buffer);
+}
+
 TEST(VideoBroadcasterTest, AppliesRotationIfAnySinkWantsRotationApplied) {
   VideoBroadcaster broadcaster;
   EXPECT_FALSE(broadcaster.wants().rotation_applied);
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/fallback_decoder_factory.h"
+
+#include <utility>
+
+#include "api/video_codecs/video_decoder_software_fallback_wrapper.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+FallbackDecoderFactory::FallbackDecoderFactory(
+    std::unique_ptr<VideoDecoderFactory> hardware_factory,
+    std::unique_ptr<VideoDecoderFactory> software_factory)
+    : hardware_factory_(std::move(hardware_factory)),
+      software_factory_(std::move(software_factory)) {
+  RTC_DCHECK(hardware_factory_);
+  RTC_DCHECK(software_factory_);
+}
+
+FallbackDecoderFactory::~FallbackDecoderFactory() = default;
+
+std::vector<SdpVideoFormat> FallbackDecoderFactory::GetSupportedFormats()
+    const {
+  const std::vector<SdpVideoFormat> software_formats =
+      software_factory_->GetSupportedFormats();
+  std::vector<SdpVideoFormat> formats = software_formats;
+  for (SdpVideoFormat& format : hardware_factory_->GetSupportedFormats()) {
+    if (!format.IsCodecInList(software_formats)) {
+      formats.push_back(std::move(format));
+    }
+  }
+  return formats;
+}
+
+VideoDecoderFactory::CodecSupport FallbackDecoderFactory::QueryCodecSupport(
+    const SdpVideoFormat& format,
+    bool reference_scaling) const {
+  CodecSupport codec_support =
+      hardware_factory_->QueryCodecSupport(format, reference_scaling);
+  if (codec_support.is_supported) {
+    return codec_support;
+  }
+  return software_factory_->QueryCodecSupport(format, reference_scaling);
+}
+
+std::unique_ptr<VideoDecoder> FallbackDecoderFactory::CreateVideoDecoder(
+    const SdpVideoFormat& format) {
+  std::unique_ptr<VideoDecoder> hardware_decoder;
+  if (format.IsCodecInList(hardware_factory_->GetSupportedFormats())) {
+    hardware_decoder = hardware_factory_->CreateVideoDecoder(format);
+  }
+  std::unique_ptr<VideoDecoder> software_decoder;
+  if (format.IsCodecInList(software_factory_->GetSupportedFormats())) {
+    software_decoder = software_factory_->CreateVideoDecoder(format);
+  }
+  if (hardware_decoder && software_decoder) {
+    return CreateVideoDecoderSoftwareFallbackWrapper(
+        std::move(software_decoder), std::move(hardware_decoder));
+  }
+  return hardware_decoder ? std::move(hardware_decoder)
+                          : std::move(software_decoder);
+}
+
+}  // namespace webrtc
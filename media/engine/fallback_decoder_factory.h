@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MEDIA_ENGINE_FALLBACK_DECODER_FACTORY_H_
+#define MEDIA_ENGINE_FALLBACK_DECODER_FACTORY_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_decoder.h"
+#include "api/video_codecs/video_decoder_factory.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Decoder factory which prefers the decoders of a hardware factory, e.g. one
+// backed by a platform API such as VA-API, and falls back to the decoders of
+// a software factory, e.g. InternalDecoderFactory. For formats supported by
+// both, the hardware decoder is wrapped by
+// CreateVideoDecoderSoftwareFallbackWrapper(), which switches to the software
+// decoder if the hardware one fails to initialize or decode.
+class RTC_EXPORT FallbackDecoderFactory : public VideoDecoderFactory {
+ public:
+  FallbackDecoderFactory(
+      std::unique_ptr<VideoDecoderFactory> hardware_factory,
+      std::unique_ptr<VideoDecoderFactory> software_factory);
+  ~FallbackDecoderFactory() override;
+
+  // Formats of the software factory, followed by those only supported by the
+  // hardware factory.
+  std::vector<SdpVideoFormat> GetSupportedFormats() const override;
+  CodecSupport QueryCodecSupport(const SdpVideoFormat& format,
+                                 bool reference_scaling) const override;
+  std::unique_ptr<VideoDecoder> CreateVideoDecoder(
+      const SdpVideoFormat& format) override;
+
+ private:
+  const std::unique_ptr<VideoDecoderFactory> hardware_factory_;
+  const std::unique_ptr<VideoDecoderFactory> software_factory_;
+};
+
+}  // namespace webrtc
+
+#endif  // MEDIA_ENGINE_FALLBACK_DECODER_FACTORY_H_
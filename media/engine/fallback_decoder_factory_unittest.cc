@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/fallback_decoder_factory.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/test/mock_video_decoder.h"
+#include "api/test/mock_video_decoder_factory.h"
+#include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_decoder.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ByMove;
+using ::testing::ElementsAre;
+using ::testing::Field;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+class FallbackDecoderFactoryTest : public ::testing::Test {
+ protected:
+  FallbackDecoderFactoryTest() {
+    auto hardware_factory =
+        std::make_unique<NiceMock<MockVideoDecoderFactory>>();
+    auto software_factory =
+        std::make_unique<NiceMock<MockVideoDecoderFactory>>();
+    hardware_factory_ = hardware_factory.get();
+    software_factory_ = software_factory.get();
+    ON_CALL(*hardware_factory_, GetSupportedFormats)
+        .WillByDefault(Return(std::vector<SdpVideoFormat>{
+            SdpVideoFormat("VP9"), SdpVideoFormat("AV1")}));
+    ON_CALL(*software_factory_, GetSupportedFormats)
+        .WillByDefault(Return(std::vector<SdpVideoFormat>{
+            SdpVideoFormat("VP8"), SdpVideoFormat("VP9")}));
+    factory_ = std::make_unique<FallbackDecoderFactory>(
+        std::move(hardware_factory), std::move(software_factory));
+  }
+
+  NiceMock<MockVideoDecoderFactory>* hardware_factory_;
+  NiceMock<MockVideoDecoderFactory>* software_factory_;
+  std::unique_ptr<FallbackDecoderFactory> factory_;
+};
+
+TEST_F(FallbackDecoderFactoryTest, SupportsFormatsOfBothFactories) {
+  EXPECT_THAT(factory_->GetSupportedFormats(),
+              ElementsAre(Field(&SdpVideoFormat::name, "VP8"),
+                          Field(&SdpVideoFormat::name, "VP9"),
+                          Field(&SdpVideoFormat::name, "AV1")));
+}
+
+TEST_F(FallbackDecoderFactoryTest, FallsBackToSoftwareDecoder) {
+  auto hardware_decoder = std::make_unique<NiceMock<MockVideoDecoder>>();
+  auto software_decoder = std::make_unique<NiceMock<MockVideoDecoder>>();
+  EXPECT_CALL(*hardware_decoder, Configure).WillOnce(Return(false));
+  EXPECT_CALL(*software_decoder, Configure).WillOnce(Return(true));
+  EXPECT_CALL(*hardware_factory_, CreateVideoDecoder)
+      .WillOnce(Return(ByMove(std::move(hardware_decoder))));
+  EXPECT_CALL(*software_factory_, CreateVideoDecoder)
+      .WillOnce(Return(ByMove(std::move(software_decoder))));
+
+  std::unique_ptr<VideoDecoder> decoder =
+      factory_->CreateVideoDecoder(SdpVideoFormat("VP9"));
+  ASSERT_TRUE(decoder);
+  EXPECT_TRUE(decoder->Configure(VideoDecoder::Settings()));
+}
+
+TEST_F(FallbackDecoderFactoryTest, CreatesDecoderOfSingleSupportingFactory) {
+  EXPECT_CALL(*software_factory_, CreateVideoDecoder).Times(0);
+  EXPECT_CALL(*hardware_factory_, CreateVideoDecoder)
+      .WillOnce(Return(ByMove(std::make_unique<NiceMock<MockVideoDecoder>>())));
+  EXPECT_TRUE(factory_->CreateVideoDecoder(SdpVideoFormat("AV1")));
+
+  EXPECT_CALL(*hardware_factory_, CreateVideoDecoder).Times(0);
+  EXPECT_CALL(*software_factory_, CreateVideoDecoder)
+      .WillOnce(Return(ByMove(std::make_unique<NiceMock<MockVideoDecoder>>())));
+  EXPECT_TRUE(factory_->CreateVideoDecoder(SdpVideoFormat("VP8")));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,177 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/pooled_decoder_factory.h"
+
+#include <deque>
+#include <iterator>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "api/make_ref_counted.h"
+#include "api/ref_counted_base.h"
+#include "modules/video_coding/include/video_error_codes.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+class PooledDecoderFactory::Pool final
+    : public rtc::RefCountedNonVirtual<Pool> {
+ public:
+  struct Entry {
+    SdpVideoFormat format;
+    std::unique_ptr<VideoDecoder> decoder;
+  };
+
+  explicit Pool(size_t max_size) : max_size_(max_size) {}
+
+  ~Pool() {
+    for (Entry& entry : entries_) {
+      entry.decoder->Release();
+    }
+  }
+
+  // Takes the most recently returned decoder for `format`, if any.
+  absl::optional<Entry> Take(const SdpVideoFormat& format) {
+    MutexLock lock(&mutex_);
+    for (auto it = entries_.rbegin(); it != entries_.rend(); ++it) {
+      if (it->format == format) {
+        Entry entry = std::move(*it);
+        entries_.erase(std::next(it).base());
+        return entry;
+      }
+    }
+    return absl::nullopt;
+  }
+
+  void Return(Entry entry) {
+    absl::optional<Entry> evicted;
+    {
+      MutexLock lock(&mutex_);
+      entries_.push_back(std::move(entry));
+      if (entries_.size() > max_size_) {
+        evicted = std::move(entries_.front());
+        entries_.pop_front();
+      }
+    }
+    // Outside the lock, since releasing a decoder may take a while.
+    if (evicted) {
+      evicted->decoder->Release();
+    }
+  }
+
+  size_t size() const {
+    MutexLock lock(&mutex_);
+    return entries_.size();
+  }
+
+ private:
+  const size_t max_size_;
+  mutable Mutex mutex_;
+  std::deque<Entry> entries_ RTC_GUARDED_BY(mutex_);
+};
+
+class PooledDecoderFactory::PooledDecoder final : public VideoDecoder {
+ public:
+  PooledDecoder(rtc::scoped_refptr<Pool> pool,
+                SdpVideoFormat format,
+                std::unique_ptr<VideoDecoder> decoder)
+      : pool_(std::move(pool)),
+        format_(std::move(format)),
+        decoder_(std::move(decoder)) {}
+
+  ~PooledDecoder() override {
+    decoder_->RegisterDecodeCompleteCallback(nullptr);
+    if (!configured_) {
+      // Not configured successfully, so there is nothing to keep warm.
+      decoder_->Release();
+      return;
+    }
+    pool_->Return({std::move(format_), std::move(decoder_)});
+  }
+
+  // Always passed on, also for a decoder taken from the pool, since the
+  // decoder may depend on the settings in ways that aren't visible here.
+  bool Configure(const Settings& settings) override {
+    configured_ = decoder_->Configure(settings);
+    return configured_;
+  }
+
+  int32_t Decode(const EncodedImage& input_image,
+                 int64_t render_time_ms) override {
+    return decoder_->Decode(input_image, render_time_ms);
+  }
+
+  int32_t RegisterDecodeCompleteCallback(
+      DecodedImageCallback* callback) override {
+    return decoder_->RegisterDecodeCompleteCallback(callback);
+  }
+
+  // The wrapped decoder is kept configured, so that the next user of it
+  // doesn't have to wait for it to initialize. It is released when it leaves
+  // the pool.
+  int32_t Release() override { return WEBRTC_VIDEO_CODEC_OK; }
+
+  DecoderInfo GetDecoderInfo() const override {
+    return decoder_->GetDecoderInfo();
+  }
+
+  const char* ImplementationName() const override {
+    return decoder_->ImplementationName();
+  }
+
+ private:
+  const rtc::scoped_refptr<Pool> pool_;
+  SdpVideoFormat format_;
+  std::unique_ptr<VideoDecoder> decoder_;
+  bool configured_ = false;
+};
+
+PooledDecoderFactory::PooledDecoderFactory(
+    std::unique_ptr<VideoDecoderFactory> factory,
+    size_t max_pooled_decoders)
+    : factory_(std::move(factory)),
+      pool_(rtc::make_ref_counted<Pool>(max_pooled_decoders)) {
+  RTC_DCHECK(factory_);
+}
+
+PooledDecoderFactory::~PooledDecoderFactory() = default;
+
+std::vector<SdpVideoFormat> PooledDecoderFactory::GetSupportedFormats() const {
+  return factory_->GetSupportedFormats();
+}
+
+VideoDecoderFactory::CodecSupport PooledDecoderFactory::QueryCodecSupport(
+    const SdpVideoFormat& format,
+    bool reference_scaling) const {
+  return factory_->QueryCodecSupport(format, reference_scaling);
+}
+
+std::unique_ptr<VideoDecoder> PooledDecoderFactory::CreateVideoDecoder(
+    const SdpVideoFormat& format) {
+  absl::optional<Pool::Entry> entry = pool_->Take(format);
+  if (entry) {
+    return std::make_unique<PooledDecoder>(pool_, format,
+                                           std::move(entry->decoder));
+  }
+  std::unique_ptr<VideoDecoder> decoder = factory_->CreateVideoDecoder(format);
+  if (!decoder) {
+    return nullptr;
+  }
+  return std::make_unique<PooledDecoder>(pool_, format, std::move(decoder));
+}
+
+size_t PooledDecoderFactory::pooled_decoders() const {
+  return pool_->size();
+}
+
+}  // namespace webrtc
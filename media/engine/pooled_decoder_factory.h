@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MEDIA_ENGINE_POOLED_DECODER_FACTORY_H_
+#define MEDIA_ENGINE_POOLED_DECODER_FACTORY_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_decoder.h"
+#include "api/video_codecs/video_decoder_factory.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Decoder factory which keeps the decoders of a wrapped factory warm for
+// reuse. When a decoder created by this factory is destroyed, the wrapped
+// decoder is kept, without being released, and is handed out again by a
+// later CreateVideoDecoder() for the same format, so that a new receive
+// stream, e.g. of a participant joining a call, doesn't wait for a decoder to
+// be created. This matters most for hardware decoders. Every Configure() is
+// passed on to the wrapped decoder, so that it is set up for the settings of
+// the new stream.
+//
+// The wrapped decoders must not deliver decoded images once they have been
+// returned to the pool, i.e. after the last Decode() call has returned, and
+// must accept Configure() without a Release() in between.
+class RTC_EXPORT PooledDecoderFactory : public VideoDecoderFactory {
+ public:
+  // At most `max_pooled_decoders` unused decoders are kept; older ones are
+  // released and destroyed first.
+  PooledDecoderFactory(std::unique_ptr<VideoDecoderFactory> factory,
+                       size_t max_pooled_decoders);
+  ~PooledDecoderFactory() override;
+
+  std::vector<SdpVideoFormat> GetSupportedFormats() const override;
+  CodecSupport QueryCodecSupport(const SdpVideoFormat& format,
+                                 bool reference_scaling) const override;
+  std::unique_ptr<VideoDecoder> CreateVideoDecoder(
+      const SdpVideoFormat& format) override;
+
+  // Number of unused decoders in the pool.
+  size_t pooled_decoders() const;
+
+ private:
+  class Pool;
+  class PooledDecoder;
+
+  const std::unique_ptr<VideoDecoderFactory> factory_;
+  // Shared with the decoders, which may outlive the factory.
+  const rtc::scoped_refptr<Pool> pool_;
+};
+
+}  // namespace webrtc
+
+#endif  // MEDIA_ENGINE_POOLED_DECODER_FACTORY_H_
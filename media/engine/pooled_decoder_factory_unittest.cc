@@ -0,0 +1,171 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "media/engine/pooled_decoder_factory.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/test/mock_video_decoder.h"
+#include "api/test/mock_video_decoder_factory.h"
+#include "api/video/render_resolution.h"
+#include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_decoder.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ByMove;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+constexpr size_t kMaxPooledDecoders = 2;
+
+VideoDecoder::Settings SettingsWithResolution(int width, int height) {
+  VideoDecoder::Settings settings;
+  settings.set_codec_type(kVideoCodecVP8);
+  settings.set_max_render_resolution(RenderResolution(width, height));
+  return settings;
+}
+
+class PooledDecoderFactoryTest : public ::testing::Test {
+ protected:
+  PooledDecoderFactoryTest() {
+    auto factory = std::make_unique<NiceMock<MockVideoDecoderFactory>>();
+    factory_ = factory.get();
+    pooled_factory_ = std::make_unique<PooledDecoderFactory>(
+        std::move(factory), kMaxPooledDecoders);
+  }
+
+  // Makes the wrapped factory create a decoder, and returns it.
+  NiceMock<MockVideoDecoder>* ExpectCreateDecoder() {
+    auto decoder = std::make_unique<NiceMock<MockVideoDecoder>>();
+    NiceMock<MockVideoDecoder>* decoder_ptr = decoder.get();
+    EXPECT_CALL(*factory_, CreateVideoDecoder)
+        .WillOnce(Return(ByMove(std::move(decoder))));
+    return decoder_ptr;
+  }
+
+  NiceMock<MockVideoDecoderFactory>* factory_;
+  std::unique_ptr<PooledDecoderFactory> pooled_factory_;
+};
+
+TEST_F(PooledDecoderFactoryTest, ReusesConfiguredDecoder) {
+  NiceMock<MockVideoDecoder>* wrapped = ExpectCreateDecoder();
+  EXPECT_CALL(*wrapped, Configure).Times(2).WillRepeatedly(Return(true));
+  EXPECT_CALL(*wrapped, Release).Times(0);
+
+  std::unique_ptr<VideoDecoder> decoder =
+      pooled_factory_->CreateVideoDecoder(SdpVideoFormat("VP8"));
+  ASSERT_TRUE(decoder);
+  EXPECT_TRUE(decoder->Configure(SettingsWithResolution(1280, 720)));
+  decoder->Release();
+  decoder = nullptr;
+  EXPECT_EQ(pooled_factory_->pooled_decoders(), 1u);
+
+  // The same decoder is handed out again, without being released, and is
+  // configured again.
+  decoder = pooled_factory_->CreateVideoDecoder(SdpVideoFormat("VP8"));
+  ASSERT_TRUE(decoder);
+  EXPECT_EQ(pooled_factory_->pooled_decoders(), 0u);
+  EXPECT_TRUE(decoder->Configure(SettingsWithResolution(1280, 720)));
+  ::testing::Mock::VerifyAndClearExpectations(wrapped);
+}
+
+TEST_F(PooledDecoderFactoryTest, ConfiguresReusedDecoderWithNewSettings) {
+  NiceMock<MockVideoDecoder>* wrapped = ExpectCreateDecoder();
+  EXPECT_CALL(*wrapped, Configure).WillOnce(Return(true));
+
+  std::unique_ptr<VideoDecoder> decoder =
+      pooled_factory_->CreateVideoDecoder(SdpVideoFormat("VP8"));
+  EXPECT_TRUE(decoder->Configure(SettingsWithResolution(1280, 720)));
+  decoder = nullptr;
+
+  EXPECT_CALL(*wrapped, Configure).WillOnce([](const auto& settings) {
+    EXPECT_EQ(settings.max_render_resolution(), RenderResolution(640, 360));
+    return true;
+  });
+  decoder = pooled_factory_->CreateVideoDecoder(SdpVideoFormat("VP8"));
+  EXPECT_TRUE(decoder->Configure(SettingsWithResolution(640, 360)));
+  ::testing::Mock::VerifyAndClearExpectations(wrapped);
+}
+
+TEST_F(PooledDecoderFactoryTest, DoesNotPoolDecoderThatFailsToReconfigure) {
+  NiceMock<MockVideoDecoder>* wrapped = ExpectCreateDecoder();
+  EXPECT_CALL(*wrapped, Configure)
+      .WillOnce(Return(true))
+      .WillOnce(Return(false));
+
+  std::unique_ptr<VideoDecoder> decoder =
+      pooled_factory_->CreateVideoDecoder(SdpVideoFormat("VP8"));
+  EXPECT_TRUE(decoder->Configure(SettingsWithResolution(1280, 720)));
+  decoder = nullptr;
+
+  decoder = pooled_factory_->CreateVideoDecoder(SdpVideoFormat("VP8"));
+  EXPECT_FALSE(decoder->Configure(SettingsWithResolution(640, 360)));
+  EXPECT_CALL(*wrapped, Release);
+  EXPECT_CALL(*wrapped, Destruct);
+  decoder = nullptr;
+  EXPECT_EQ(pooled_factory_->pooled_decoders(), 0u);
+}
+
+TEST_F(PooledDecoderFactoryTest, DoesNotReuseDecoderForOtherFormat) {
+  NiceMock<MockVideoDecoder>* vp8 = ExpectCreateDecoder();
+  std::unique_ptr<VideoDecoder> decoder =
+      pooled_factory_->CreateVideoDecoder(SdpVideoFormat("VP8"));
+  EXPECT_TRUE(decoder->Configure(SettingsWithResolution(1280, 720)));
+  decoder = nullptr;
+
+  NiceMock<MockVideoDecoder>* vp9 = ExpectCreateDecoder();
+  EXPECT_CALL(*vp9, Configure).WillOnce(Return(true));
+  decoder = pooled_factory_->CreateVideoDecoder(SdpVideoFormat("VP9"));
+  EXPECT_TRUE(decoder->Configure(SettingsWithResolution(1280, 720)));
+  EXPECT_EQ(pooled_factory_->pooled_decoders(), 1u);
+
+  // The unused VP8 decoder is released with the pool.
+  EXPECT_CALL(*vp8, Release);
+  decoder = nullptr;
+  pooled_factory_ = nullptr;
+}
+
+TEST_F(PooledDecoderFactoryTest, DoesNotPoolUnconfiguredDecoder) {
+  NiceMock<MockVideoDecoder>* wrapped = ExpectCreateDecoder();
+  EXPECT_CALL(*wrapped, Configure).WillOnce(Return(false));
+  EXPECT_CALL(*wrapped, Release);
+  EXPECT_CALL(*wrapped, Destruct);
+
+  std::unique_ptr<VideoDecoder> decoder =
+      pooled_factory_->CreateVideoDecoder(SdpVideoFormat("VP8"));
+  EXPECT_FALSE(decoder->Configure(SettingsWithResolution(1280, 720)));
+  decoder = nullptr;
+  EXPECT_EQ(pooled_factory_->pooled_decoders(), 0u);
+}
+
+TEST_F(PooledDecoderFactoryTest, ReleasesOldestDecoderWhenPoolIsFull) {
+  std::vector<std::unique_ptr<VideoDecoder>> decoders;
+  std::vector<NiceMock<MockVideoDecoder>*> wrapped;
+  for (size_t i = 0; i < kMaxPooledDecoders + 1; ++i) {
+    wrapped.push_back(ExpectCreateDecoder());
+    decoders.push_back(
+        pooled_factory_->CreateVideoDecoder(SdpVideoFormat("VP8")));
+    EXPECT_TRUE(decoders.back()->Configure(SettingsWithResolution(640, 360)));
+  }
+
+  EXPECT_CALL(*wrapped[0], Release);
+  EXPECT_CALL(*wrapped[0], Destruct);
+  decoders.clear();
+  EXPECT_EQ(pooled_factory_->pooled_decoders(), kMaxPooledDecoders);
+  ::testing::Mock::VerifyAndClearExpectations(wrapped[0]);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -213,6 +213,20 @@ SimulcastEncoderAdapter::StreamContext::ReleaseEncoderContext() && {
   return std::move(encoder_context_);
 }
 
+rtc::scoped_refptr<VideoFrameBuffer>
+SimulcastEncoderAdapter::StreamContext::ScaleBuffer(
+    VideoFrameBuffer& src_buffer) {
+  if (src_buffer.type() == VideoFrameBuffer::Type::kI420) {
+    rtc::scoped_refptr<I420Buffer> dst_buffer =
+        scaled_buffer_pool_.CreateI420Buffer(width_, height_);
+    if (dst_buffer) {
+      dst_buffer->ScaleFrom(*src_buffer.GetI420());
+      return dst_buffer;
+    }
+  }
+  return src_buffer.Scale(width_, height_);
+}
+
 void SimulcastEncoderAdapter::StreamContext::OnKeyframe(Timestamp timestamp) {
   is_keyframe_needed_ = false;
   if (framerate_controller_) {
@@ -476,11 +490,19 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  // Temporary thay may hold the result of texture to i420 buffer conversion.
-  rtc::scoped_refptr<VideoFrameBuffer> src_buffer;
   int src_width = input_image.width();
   int src_height = input_image.height();
 
+  // Layers to encode, with their frame types and, if the input frame has to
+  // be scaled for them, the scaled buffer.
+  struct LayerToEncode {
+    StreamContext* layer;
+    std::vector<VideoFrameType> frame_types;
+    bool needs_scaling;
+    rtc::scoped_refptr<VideoFrameBuffer> scaled_buffer;
+  };
+  std::vector<LayerToEncode> layers_to_encode;
+
   for (auto& layer : stream_contexts_) {
     // Don't encode frames in resolutions that we don't intend to send.
     if (layer.is_paused()) {
@@ -539,33 +561,67 @@ int SimulcastEncoderAdapter::Encode(
     // correctly sample/scale the source texture.
     // TODO(perkj): ensure that works going forward, and figure out how this
     // affects webrtc:5683.
-    if ((layer.width() == src_width && layer.height() == src_height) ||
-        (input_image.video_frame_buffer()->type() ==
-             VideoFrameBuffer::Type::kNative &&
-         layer.encoder().GetEncoderInfo().supports_native_handle)) {
-      int ret = layer.encoder().Encode(input_image, &stream_frame_types);
+    bool needs_scaling =
+        !((layer.width() == src_width && layer.height() == src_height) ||
+          (input_image.video_frame_buffer()->type() ==
+               VideoFrameBuffer::Type::kNative &&
+           layer.encoder().GetEncoderInfo().supports_native_handle));
+    layers_to_encode.push_back(
+        {&layer, std::move(stream_frame_types), needs_scaling, nullptr});
+  }
+
+  // Scale from the largest layer to the smallest. Each layer is scaled from
+  // the smallest buffer already scaled that is at least as large, instead of
+  // from the input frame, so the full resolution frame is read only once.
+  std::vector<LayerToEncode*> layers_to_scale;
+  for (LayerToEncode& layer_to_encode : layers_to_encode) {
+    if (layer_to_encode.needs_scaling) {
+      layers_to_scale.push_back(&layer_to_encode);
+    }
+  }
+  absl::c_stable_sort(layers_to_scale, [](const LayerToEncode* lhs,
+                                          const LayerToEncode* rhs) {
+    return lhs->layer->width() * lhs->layer->height() >
+           rhs->layer->width() * rhs->layer->height();
+  });
+  rtc::scoped_refptr<VideoFrameBuffer> src_buffer =
+      input_image.video_frame_buffer();
+  for (LayerToEncode* layer_to_scale : layers_to_scale) {
+    StreamContext& layer = *layer_to_scale->layer;
+    rtc::scoped_refptr<VideoFrameBuffer> dst_buffer;
+    if (src_buffer->width() >= layer.width() &&
+        src_buffer->height() >= layer.height()) {
+      dst_buffer = layer.ScaleBuffer(*src_buffer);
+    } else {
+      dst_buffer = layer.ScaleBuffer(*input_image.video_frame_buffer());
+    }
+    if (!dst_buffer) {
+      RTC_LOG(LS_ERROR) << "Failed to scale video frame";
+      return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
+    }
+    if (dst_buffer->width() <= src_buffer->width() &&
+        dst_buffer->height() <= src_buffer->height()) {
+      src_buffer = dst_buffer;
+    }
+    layer_to_scale->scaled_buffer = std::move(dst_buffer);
+  }
+
+  for (LayerToEncode& layer_to_encode : layers_to_encode) {
+    VideoEncoder& encoder = layer_to_encode.layer->encoder();
+    if (!layer_to_encode.needs_scaling) {
+      int ret = encoder.Encode(input_image, &layer_to_encode.frame_types);
       if (ret != WEBRTC_VIDEO_CODEC_OK) {
         return ret;
       }
     } else {
-      if (src_buffer == nullptr) {
-        src_buffer = input_image.video_frame_buffer();
-      }
-      rtc::scoped_refptr<VideoFrameBuffer> dst_buffer =
-          src_buffer->Scale(layer.width(), layer.height());
-      if (!dst_buffer) {
-        RTC_LOG(LS_ERROR) << "Failed to scale video frame";
-        return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
-      }
-
       // UpdateRect is not propagated to lower simulcast layers currently.
       // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
       VideoFrame frame(input_image);
-      frame.set_video_frame_buffer(dst_buffer);
+      frame.set_video_frame_buffer(layer_to_encode.scaled_buffer);
       frame.set_rotation(webrtc::kVideoRotation_0);
       frame.set_update_rect(
           VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
-      int ret = layer.encoder().Encode(frame, &stream_frame_types);
+      int ret = encoder.Encode(frame, &layer_to_encode.frame_types);
       if (ret != WEBRTC_VIDEO_CODEC_OK) {
         return ret;
       }
@@ -933,6 +989,8 @@ VideoEncoder::EncoderInfo SimulcastEncoderAdapter::GetEncoderInfo() const {
       encoder_info.is_hardware_accelerated =
           encoder_impl_info.is_hardware_accelerated;
       encoder_info.is_qp_trusted = encoder_impl_info.is_qp_trusted;
+      encoder_info.preferred_pixel_formats =
+          encoder_impl_info.preferred_pixel_formats;
     } else {
       encoder_info.implementation_name += ", ";
       encoder_info.implementation_name += encoder_impl_info.implementation_name;
@@ -957,6 +1015,18 @@ VideoEncoder::EncoderInfo SimulcastEncoderAdapter::GetEncoderInfo() const {
       encoder_info.is_qp_trusted =
           encoder_info.is_qp_trusted.value_or(true) &&
           encoder_impl_info.is_qp_trusted.value_or(true);
+
+      // Pixel formats preferred only if all encoders prefer them, so that a
+      // frame mapped to one of them needs no conversion in any encoder.
+      encoder_info.preferred_pixel_formats.erase(
+          std::remove_if(encoder_info.preferred_pixel_formats.begin(),
+                         encoder_info.preferred_pixel_formats.end(),
+                         [&](VideoFrameBuffer::Type type) {
+                           return !absl::c_linear_search(
+                               encoder_impl_info.preferred_pixel_formats,
+                               type);
+                         }),
+          encoder_info.preferred_pixel_formats.end());
     }
     encoder_info.fps_allocation[i] = encoder_impl_info.fps_allocation[0];
     encoder_info.requested_resolution_alignment = cricket::LeastCommonMultiple(
@@ -972,6 +1042,10 @@ VideoEncoder::EncoderInfo SimulcastEncoderAdapter::GetEncoderInfo() const {
     }
   }
   encoder_info.implementation_name += ")";
+  if (encoder_info.preferred_pixel_formats.empty()) {
+    encoder_info.preferred_pixel_formats.push_back(
+        VideoFrameBuffer::Type::kI420);
+  }
 
   OverrideFromFieldTrial(&encoder_info);
 
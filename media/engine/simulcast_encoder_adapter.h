@@ -23,11 +23,14 @@
 #include "absl/types/optional.h"
 #include "api/fec_controller_override.h"
 #include "api/field_trials_view.h"
+#include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/video_encoder_factory.h"
 #include "common_video/framerate_controller.h"
+#include "common_video/include/video_frame_buffer_pool.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
 #include "rtc_base/system/no_unique_address.h"
@@ -132,6 +135,10 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     std::unique_ptr<EncoderContext> ReleaseEncoderContext() &&;
     void OnKeyframe(Timestamp timestamp);
     bool ShouldDropFrame(Timestamp timestamp);
+    // Scales `src_buffer` to the resolution of the stream. I420 buffers are
+    // scaled into buffers from `scaled_buffer_pool_`.
+    rtc::scoped_refptr<VideoFrameBuffer> ScaleBuffer(
+        VideoFrameBuffer& src_buffer);
 
    private:
     SimulcastEncoderAdapter* const parent_;
@@ -142,6 +149,9 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     const uint16_t height_;
     bool is_keyframe_needed_;
     bool is_paused_;
+    // Not moved along with the rest of the state, since it only saves
+    // allocations.
+    VideoFrameBufferPool scaled_buffer_pool_;
   };
 
   bool Initialized() const;
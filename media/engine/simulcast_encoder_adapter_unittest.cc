@@ -14,12 +14,14 @@
 #include <memory>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "api/field_trials_view.h"
 #include "api/test/create_simulcast_test_fixture.h"
 #include "api/test/simulcast_test_fixture.h"
 #include "api/test/video/function_video_decoder_factory.h"
 #include "api/test/video/function_video_encoder_factory.h"
 #include "api/video/video_codec_constants.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/video_encoder_factory.h"
@@ -252,6 +254,7 @@ class MockVideoEncoder : public VideoEncoder {
     info.supports_simulcast = supports_simulcast_;
     info.is_qp_trusted = is_qp_trusted_;
     info.resolution_bitrate_limits = resolution_bitrate_limits;
+    info.preferred_pixel_formats = preferred_pixel_formats_;
     return info;
   }
 
@@ -325,6 +328,12 @@ class MockVideoEncoder : public VideoEncoder {
     resolution_bitrate_limits = limits;
   }
 
+  void set_preferred_pixel_formats(
+      absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
+          formats) {
+    preferred_pixel_formats_ = formats;
+  }
+
   bool supports_simulcast() const { return supports_simulcast_; }
 
   SdpVideoFormat video_format() const { return video_format_; }
@@ -345,6 +354,8 @@ class MockVideoEncoder : public VideoEncoder {
   absl::optional<bool> is_qp_trusted_;
   SdpVideoFormat video_format_;
   std::vector<VideoEncoder::ResolutionBitrateLimits> resolution_bitrate_limits;
+  absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>
+      preferred_pixel_formats_{VideoFrameBuffer::Type::kI420};
 
   VideoCodec codec_;
   EncodedImageCallback* callback_;
@@ -1104,6 +1115,72 @@ TEST_F(TestSimulcastEncoderAdapterFake, NativeHandleForwardingOnlyIfSupported) {
   EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
 }
 
+class CountingScaleBuffer : public VideoFrameBuffer {
+ public:
+  CountingScaleBuffer(int width, int height) : width_(width), height_(height) {}
+
+  Type type() const override { return Type::kNative; }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override {
+    return I420Buffer::Create(width_, height_);
+  }
+
+  rtc::scoped_refptr<VideoFrameBuffer> CropAndScale(
+      int offset_x,
+      int offset_y,
+      int crop_width,
+      int crop_height,
+      int scaled_width,
+      int scaled_height) override {
+    ++num_scale_calls_;
+    return I420Buffer::Create(scaled_width, scaled_height);
+  }
+
+  int num_scale_calls() const { return num_scale_calls_; }
+
+ private:
+  const int width_;
+  const int height_;
+  int num_scale_calls_ = 0;
+};
+
+TEST_F(TestSimulcastEncoderAdapterFake, ScalesInputFrameOnlyOnce) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  // High start bitrate, so all streams are enabled.
+  codec_.startBitrate = 3000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kSettings));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+
+  auto buffer = rtc::make_ref_counted<CountingScaleBuffer>(1280, 720);
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(buffer)
+                               .set_timestamp_rtp(100)
+                               .set_timestamp_ms(1000)
+                               .set_rotation(kVideoRotation_180)
+                               .build();
+  auto& encoders = helper_->factory()->encoders();
+  EXPECT_CALL(*encoders[2], Encode(::testing::Ref(input_frame), _)).Times(1);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_CALL(*encoders[i], Encode)
+        .WillOnce([&, i](const VideoFrame& frame,
+                         const std::vector<VideoFrameType>* frame_types) {
+          EXPECT_EQ(frame.width(), codec_.simulcastStream[i].width);
+          EXPECT_EQ(frame.height(), codec_.simulcastStream[i].height);
+          return 0;
+        });
+  }
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+  // The smallest layer is scaled from the middle one.
+  EXPECT_EQ(buffer->num_scale_calls(), 1);
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, GeneratesKeyFramesOnRequestedLayers) {
   // Set up common settings for three streams.
   SimulcastTestFixtureImpl::DefaultSettings(
@@ -1402,6 +1479,37 @@ TEST_F(TestSimulcastEncoderAdapterFake, ReportsHardwareAccelerated) {
   EXPECT_TRUE(adapter_->GetEncoderInfo().is_hardware_accelerated);
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ReportsPixelFormatsPreferredByAllEncoders) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  adapter_->RegisterEncodeCompleteCallback(this);
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kSettings));
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+
+  for (MockVideoEncoder* encoder : helper_->factory()->encoders()) {
+    encoder->set_preferred_pixel_formats(
+        {VideoFrameBuffer::Type::kNV12, VideoFrameBuffer::Type::kI420});
+  }
+  EXPECT_THAT(adapter_->GetEncoderInfo().preferred_pixel_formats,
+              ::testing::ElementsAre(VideoFrameBuffer::Type::kNV12,
+                                     VideoFrameBuffer::Type::kI420));
+
+  // One encoder only takes I420, so NV12 would need converting there.
+  helper_->factory()->encoders()[1]->set_preferred_pixel_formats(
+      {VideoFrameBuffer::Type::kI420});
+  EXPECT_THAT(adapter_->GetEncoderInfo().preferred_pixel_formats,
+              ::testing::ElementsAre(VideoFrameBuffer::Type::kI420));
+
+  // No format common to all encoders.
+  helper_->factory()->encoders()[2]->set_preferred_pixel_formats(
+      {VideoFrameBuffer::Type::kNV12});
+  EXPECT_THAT(adapter_->GetEncoderInfo().preferred_pixel_formats,
+              ::testing::ElementsAre(VideoFrameBuffer::Type::kI420));
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake,
        ReportsLeastCommonMultipleOfRequestedResolutionAlignments) {
   SimulcastTestFixtureImpl::DefaultSettings(
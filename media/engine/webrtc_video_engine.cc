@@ -2593,6 +2593,11 @@ WebRtcVideoReceiveChannel::WebRtcVideoReceiveChannel(
     webrtc::VideoDecoderFactory* decoder_factory)
     : MediaChannelUtil(call->network_thread(), config.enable_dscp),
       worker_thread_(call->worker_thread()),
+      received_packets_(worker_thread_,
+                        [this](webrtc::RtpPacketReceived packet) {
+                          RTC_DCHECK_RUN_ON(&thread_checker_);
+                          ProcessReceivedPacket(std::move(packet));
+                        }),
       receiving_(false),
       call_(call),
       default_sink_(nullptr),
@@ -3077,11 +3082,7 @@ void WebRtcVideoReceiveChannel::OnPacketReceived(
   // TODO(crbug.com/1373439): Stop posting to the worker thread when the
   // combined network/worker project launches.
   if (webrtc::TaskQueueBase::Current() != worker_thread_) {
-    worker_thread_->PostTask(
-        SafeTask(task_safety_.flag(), [this, packet = packet]() mutable {
-          RTC_DCHECK_RUN_ON(&thread_checker_);
-          ProcessReceivedPacket(std::move(packet));
-        }));
+    received_packets_.Push(packet);
   } else {
     RTC_DCHECK_RUN_ON(&thread_checker_);
     ProcessReceivedPacket(packet);
@@ -61,6 +61,7 @@
 #include "media/base/media_channel_impl.h"
 #include "media/base/media_config.h"
 #include "media/base/media_engine.h"
+#include "media/base/received_rtp_packet_queue.h"
 #include "media/base/stream_params.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
@@ -802,6 +803,8 @@ class WebRtcVideoReceiveChannel : public MediaChannelUtil,
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker network_thread_checker_{
       webrtc::SequenceChecker::kDetached};
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker thread_checker_;
+  // Packets received on the network thread, on their way to the worker.
+  webrtc::ReceivedRtpPacketQueue received_packets_;
 
   uint32_t rtcp_receiver_report_ssrc_ RTC_GUARDED_BY(thread_checker_);
   bool receiving_ RTC_GUARDED_BY(&thread_checker_);
@@ -381,19 +381,6 @@ void WebRtcVoiceEngine::Init() {
       new rtc::TaskQueue(task_queue_factory_->CreateTaskQueue(
           "rtc-low-prio", webrtc::TaskQueueFactory::Priority::LOW)));
 
-  // Load our audio codec lists.
-  RTC_LOG(LS_VERBOSE) << "Supported send codecs in order of preference:";
-  send_codecs_ = CollectCodecs(encoder_factory_->GetSupportedEncoders());
-  for (const AudioCodec& codec : send_codecs_) {
-    RTC_LOG(LS_VERBOSE) << ToString(codec);
-  }
-
-  RTC_LOG(LS_VERBOSE) << "Supported recv codecs in order of preference:";
-  recv_codecs_ = CollectCodecs(decoder_factory_->GetSupportedDecoders());
-  for (const AudioCodec& codec : recv_codecs_) {
-    RTC_LOG(LS_VERBOSE) << ToString(codec);
-  }
-
 #if defined(WEBRTC_INCLUDE_INTERNAL_AUDIO_DEVICE)
   // No ADM supplied? Create a default one.
   if (!adm_) {
@@ -632,12 +619,28 @@ void WebRtcVoiceEngine::ApplyOptions(const AudioOptions& options_in) {
 
 const std::vector<AudioCodec>& WebRtcVoiceEngine::send_codecs() const {
   RTC_DCHECK(signal_thread_checker_.IsCurrent());
-  return send_codecs_;
+  // The codec lists are only needed once media is negotiated, so they are
+  // loaded on first use rather than when the engine is initialized.
+  if (!send_codecs_) {
+    send_codecs_ = CollectCodecs(encoder_factory_->GetSupportedEncoders());
+    RTC_LOG(LS_VERBOSE) << "Supported send codecs in order of preference:";
+    for (const AudioCodec& codec : *send_codecs_) {
+      RTC_LOG(LS_VERBOSE) << ToString(codec);
+    }
+  }
+  return *send_codecs_;
 }
 
 const std::vector<AudioCodec>& WebRtcVoiceEngine::recv_codecs() const {
   RTC_DCHECK(signal_thread_checker_.IsCurrent());
-  return recv_codecs_;
+  if (!recv_codecs_) {
+    recv_codecs_ = CollectCodecs(decoder_factory_->GetSupportedDecoders());
+    RTC_LOG(LS_VERBOSE) << "Supported recv codecs in order of preference:";
+    for (const AudioCodec& codec : *recv_codecs_) {
+      RTC_LOG(LS_VERBOSE) << ToString(codec);
+    }
+  }
+  return *recv_codecs_;
 }
 
 std::vector<webrtc::RtpHeaderExtensionCapability>
@@ -2017,6 +2020,10 @@ WebRtcVoiceReceiveChannel::WebRtcVoiceReceiveChannel(
     webrtc::AudioCodecPairId codec_pair_id)
     : MediaChannelUtil(call->network_thread(), config.enable_dscp),
       worker_thread_(call->worker_thread()),
+      received_packets_(worker_thread_,
+                        [this](webrtc::RtpPacketReceived packet) {
+                          ProcessReceivedPacket(std::move(packet));
+                        }),
       engine_(engine),
       call_(call),
       audio_config_(config.audio),
@@ -2445,27 +2452,28 @@ void WebRtcVoiceReceiveChannel::OnPacketReceived(
   // call_->Receiver() to a common implementation and provide a callback on
   // the worker thread for the exception case (DELIVERY_UNKNOWN_SSRC) and
   // how retry is attempted.
-  worker_thread_->PostTask(
-      SafeTask(task_safety_.flag(), [this, packet = packet]() mutable {
-        RTC_DCHECK_RUN_ON(worker_thread_);
+  received_packets_.Push(packet);
+}
 
-        // TODO(bugs.webrtc.org/7135): extensions in `packet` is currently set
-        // in RtpTransport and does not neccessarily include extensions specific
-        // to this channel/MID. Also see comment in
-        // BaseChannel::MaybeUpdateDemuxerAndRtpExtensions_w.
-        // It would likely be good if extensions where merged per BUNDLE and
-        // applied directly in RtpTransport::DemuxPacket;
-        packet.IdentifyExtensions(recv_rtp_extension_map_);
-        if (!packet.arrival_time().IsFinite()) {
-          packet.set_arrival_time(webrtc::Timestamp::Micros(rtc::TimeMicros()));
-        }
+void WebRtcVoiceReceiveChannel::ProcessReceivedPacket(
+    webrtc::RtpPacketReceived packet) {
+  RTC_DCHECK_RUN_ON(worker_thread_);
 
-        call_->Receiver()->DeliverRtpPacket(
-            webrtc::MediaType::AUDIO, std::move(packet),
-            absl::bind_front(
-                &WebRtcVoiceReceiveChannel::MaybeCreateDefaultReceiveStream,
-                this));
-      }));
+  // TODO(bugs.webrtc.org/7135): extensions in `packet` is currently set
+  // in RtpTransport and does not neccessarily include extensions specific
+  // to this channel/MID. Also see comment in
+  // BaseChannel::MaybeUpdateDemuxerAndRtpExtensions_w.
+  // It would likely be good if extensions where merged per BUNDLE and
+  // applied directly in RtpTransport::DemuxPacket;
+  packet.IdentifyExtensions(recv_rtp_extension_map_);
+  if (!packet.arrival_time().IsFinite()) {
+    packet.set_arrival_time(webrtc::Timestamp::Micros(rtc::TimeMicros()));
+  }
+
+  call_->Receiver()->DeliverRtpPacket(
+      webrtc::MediaType::AUDIO, std::move(packet),
+      absl::bind_front(
+          &WebRtcVoiceReceiveChannel::MaybeCreateDefaultReceiveStream, this));
 }
 
 bool WebRtcVoiceReceiveChannel::MaybeCreateDefaultReceiveStream(
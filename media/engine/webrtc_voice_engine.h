@@ -55,6 +55,7 @@
 #include "media/base/media_channel_impl.h"
 #include "media/base/media_config.h"
 #include "media/base/media_engine.h"
+#include "media/base/received_rtp_packet_queue.h"
 #include "media/base/rtp_utils.h"
 #include "media/base/stream_params.h"
 #include "modules/async_audio_processing/async_audio_processing.h"
@@ -166,8 +167,9 @@ class WebRtcVoiceEngine final : public VoiceEngineInterface {
   std::unique_ptr<webrtc::AudioFrameProcessor> audio_frame_processor_;
   // The primary instance of WebRtc VoiceEngine.
   rtc::scoped_refptr<webrtc::AudioState> audio_state_;
-  std::vector<AudioCodec> send_codecs_;
-  std::vector<AudioCodec> recv_codecs_;
+  // Loaded on first use, on the signaling thread.
+  mutable absl::optional<std::vector<AudioCodec>> send_codecs_;
+  mutable absl::optional<std::vector<AudioCodec>> recv_codecs_;
   bool is_dumping_aec_ = false;
   bool initialized_ = false;
 
@@ -442,11 +444,14 @@ class WebRtcVoiceReceiveChannel final
   // Check if 'ssrc' is an unsignaled stream, and if so mark it as not being
   // unsignaled anymore (i.e. it is now removed, or signaled), and return true.
   bool MaybeDeregisterUnsignaledRecvStream(uint32_t ssrc);
+  void ProcessReceivedPacket(webrtc::RtpPacketReceived packet);
 
   webrtc::TaskQueueBase* const worker_thread_;
   webrtc::ScopedTaskSafety task_safety_;
   webrtc::SequenceChecker network_thread_checker_{
       webrtc::SequenceChecker::kDetached};
+  // Packets received on the network thread, on their way to the worker.
+  webrtc::ReceivedRtpPacketQueue received_packets_;
 
   WebRtcVoiceEngine* const engine_ = nullptr;
 
@@ -149,6 +149,11 @@ DcSctpTransport::~DcSctpTransport() {
   if (socket_) {
     socket_->Close();
   }
+  // Unlike the signals, the callbacks are not disconnected automatically.
+  if (transport_) {
+    transport_->DeregisterReceivedPacketCallback(this);
+    transport_->DeregisterDestroyedCallback(this);
+  }
 }
 
 void DcSctpTransport::SetOnConnectedCallback(std::function<void()> callback) {
@@ -217,6 +222,33 @@ bool DcSctpTransport::Start(int local_sctp_port,
   return true;
 }
 
+absl::optional<dcsctp::DcSctpSocketHandoverState>
+DcSctpTransport::GetHandoverStateAndClose() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (!socket_) {
+    RTC_LOG(LS_ERROR) << debug_name_
+                      << "->GetHandoverStateAndClose(): Transport is not "
+                         "started.";
+    return absl::nullopt;
+  }
+  dcsctp::HandoverReadinessStatus readiness = socket_->GetHandoverReadiness();
+  if (!readiness.IsReady()) {
+    RTC_LOG(LS_WARNING) << debug_name_
+                        << "->GetHandoverStateAndClose(): Not ready for "
+                           "handover: "
+                        << readiness.ToString();
+    return absl::nullopt;
+  }
+  return socket_->GetHandoverStateAndClose();
+}
+
+void DcSctpTransport::RestoreFromHandoverState(
+    dcsctp::DcSctpSocketHandoverState state) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  RTC_DCHECK(!socket_);
+  handover_state_ = std::move(state);
+}
+
 bool DcSctpTransport::OpenStream(int sid) {
   RTC_DCHECK_RUN_ON(network_thread_);
   RTC_DLOG(LS_INFO) << debug_name_ << "->OpenStream(" << sid << ").";
@@ -380,6 +412,36 @@ void DcSctpTransport::set_debug_name_for_testing(const char* debug_name) {
 
 SendPacketStatus DcSctpTransport::SendPacketWithStatus(
     rtc::ArrayView<const uint8_t> data) {
+  return SendPacketWithOptions(data, rtc::PacketOptions());
+}
+
+SendPacketStatus DcSctpTransport::SendBurstPacketWithStatus(
+    rtc::ArrayView<const uint8_t> data) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (!CanSendPacket(data)) {
+    return SendPacketStatus::kError;
+  }
+  burst_.emplace_back(data.data(), data.size());
+  return SendPacketStatus::kSuccess;
+}
+
+void DcSctpTransport::OnPacketBurstEnd() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  std::vector<rtc::Buffer> burst = std::move(burst_);
+  burst_.clear();
+  // Mark the packets of a burst as batchable, so that they are sent together
+  // when the last one reaches the socket. All packets are attempted, even after
+  // a failure, so that the batch is always completed. Packets that fail here
+  // are recovered by retransmission, like packets lost on the path.
+  rtc::PacketOptions options;
+  options.batchable = burst.size() > 1;
+  for (size_t i = 0; i < burst.size(); ++i) {
+    options.last_packet_in_batch = options.batchable && i == burst.size() - 1;
+    SendPacketWithOptions(burst[i], options);
+  }
+}
+
+bool DcSctpTransport::CanSendPacket(rtc::ArrayView<const uint8_t> data) const {
   RTC_DCHECK_RUN_ON(network_thread_);
   RTC_DCHECK(socket_);
 
@@ -389,19 +451,26 @@ SendPacketStatus DcSctpTransport::SendPacketWithStatus(
                          "SCTP seems to have made a packet that is bigger "
                          "than its official MTU: "
                       << data.size() << " vs max of " << socket_->options().mtu;
-    return SendPacketStatus::kError;
+    return false;
   }
-  TRACE_EVENT0("webrtc", "DcSctpTransport::SendPacket");
+  return transport_ && transport_->writable();
+}
 
-  if (!transport_ || !transport_->writable())
+SendPacketStatus DcSctpTransport::SendPacketWithOptions(
+    rtc::ArrayView<const uint8_t> data,
+    const rtc::PacketOptions& options) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (!CanSendPacket(data)) {
     return SendPacketStatus::kError;
+  }
+  TRACE_EVENT0("webrtc", "DcSctpTransport::SendPacket");
 
   RTC_DLOG(LS_VERBOSE) << debug_name_ << "->SendPacket(length=" << data.size()
                        << ")";
 
   auto result =
       transport_->SendPacket(reinterpret_cast<const char*>(data.data()),
-                             data.size(), rtc::PacketOptions(), 0);
+                             data.size(), options, 0);
 
   if (result < 0) {
     RTC_LOG(LS_WARNING) << debug_name_ << "->SendPacket(length=" << data.size()
@@ -605,8 +674,12 @@ void DcSctpTransport::ConnectTransportSignals() {
   }
   transport_->SignalWritableState.connect(
       this, &DcSctpTransport::OnTransportWritableState);
-  transport_->SignalReadPacket.connect(this,
-                                       &DcSctpTransport::OnTransportReadPacket);
+  transport_->RegisterReceivedPacketCallback(
+      this, [this](rtc::PacketTransportInternal* transport,
+                   const rtc::ReceivedPacket& packet, int flags) {
+        OnTransportReadPacket(transport, packet, flags);
+      });
+  transport_->RegisterDestroyedCallback(this, [this] { transport_ = nullptr; });
   transport_->SignalClosed.connect(this, &DcSctpTransport::OnTransportClosed);
 }
 
@@ -616,7 +689,8 @@ void DcSctpTransport::DisconnectTransportSignals() {
     return;
   }
   transport_->SignalWritableState.disconnect(this);
-  transport_->SignalReadPacket.disconnect(this);
+  transport_->DeregisterReceivedPacketCallback(this);
+  transport_->DeregisterDestroyedCallback(this);
   transport_->SignalClosed.disconnect(this);
 }
 
@@ -632,9 +706,7 @@ void DcSctpTransport::OnTransportWritableState(
 
 void DcSctpTransport::OnTransportReadPacket(
     rtc::PacketTransportInternal* transport,
-    const char* data,
-    size_t length,
-    const int64_t& /* packet_time_us */,
+    const rtc::ReceivedPacket& packet,
     int flags) {
   RTC_DCHECK_RUN_ON(network_thread_);
   if (flags) {
@@ -643,10 +715,10 @@ void DcSctpTransport::OnTransportReadPacket(
   }
 
   RTC_DLOG(LS_VERBOSE) << debug_name_
-                       << "->OnTransportReadPacket(), length=" << length;
+                       << "->OnTransportReadPacket(), length="
+                       << packet.payload().size();
   if (socket_) {
-    socket_->ReceivePacket(rtc::ArrayView<const uint8_t>(
-        reinterpret_cast<const uint8_t*>(data), length));
+    socket_->ReceivePacket(packet.payload());
   }
 }
 
@@ -662,7 +734,12 @@ void DcSctpTransport::OnTransportClosed(
 void DcSctpTransport::MaybeConnectSocket() {
   if (transport_ && transport_->writable() && socket_ &&
       socket_->state() == dcsctp::SocketState::kClosed) {
-    socket_->Connect();
+    if (handover_state_) {
+      socket_->RestoreFromState(*handover_state_);
+      handover_state_.reset();
+    } else {
+      socket_->Connect();
+    }
   }
 }
 }  // namespace webrtc
@@ -13,20 +13,25 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/task_queue/task_queue_base.h"
 #include "media/sctp/sctp_transport_internal.h"
+#include "net/dcsctp/public/dcsctp_handover_state.h"
 #include "net/dcsctp/public/dcsctp_options.h"
 #include "net/dcsctp/public/dcsctp_socket.h"
 #include "net/dcsctp/public/dcsctp_socket_factory.h"
 #include "net/dcsctp/public/types.h"
 #include "net/dcsctp/timer/task_queue_timeout.h"
 #include "p2p/base/packet_transport_internal.h"
+#include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/containers/flat_map.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/random.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread.h"
@@ -66,10 +71,24 @@ class DcSctpTransport : public cricket::SctpTransportInternal,
   absl::optional<int> max_inbound_streams() const override;
   void set_debug_name_for_testing(const char* debug_name) override;
 
+  // Captures the state of the SCTP association, so that a DcSctpTransport in
+  // another process can take it over without a new handshake, and closes the
+  // association. Returns nullopt if the association can't be handed over in
+  // its current state, see dcsctp::DcSctpSocketInterface::
+  // GetHandoverReadiness().
+  absl::optional<dcsctp::DcSctpSocketHandoverState> GetHandoverStateAndClose();
+  // Makes the transport restore the association from `state` instead of
+  // connecting a new one once its DTLS transport is writable. Must be called
+  // before Start().
+  void RestoreFromHandoverState(dcsctp::DcSctpSocketHandoverState state);
+
  private:
   // dcsctp::DcSctpSocketCallbacks
   dcsctp::SendPacketStatus SendPacketWithStatus(
       rtc::ArrayView<const uint8_t> data) override;
+  dcsctp::SendPacketStatus SendBurstPacketWithStatus(
+      rtc::ArrayView<const uint8_t> data) override;
+  void OnPacketBurstEnd() override;
   std::unique_ptr<dcsctp::Timeout> CreateTimeout(
       TaskQueueBase::DelayPrecision precision) override;
   dcsctp::TimeMs TimeMillis() override;
@@ -89,14 +108,19 @@ class DcSctpTransport : public cricket::SctpTransportInternal,
   void OnIncomingStreamsReset(
       rtc::ArrayView<const dcsctp::StreamID> incoming_streams) override;
 
+  // Returns false if `data` can't be sent, e.g. since the transport isn't
+  // writable.
+  bool CanSendPacket(rtc::ArrayView<const uint8_t> data) const;
+  dcsctp::SendPacketStatus SendPacketWithOptions(
+      rtc::ArrayView<const uint8_t> data,
+      const rtc::PacketOptions& options);
+
   // Transport callbacks
   void ConnectTransportSignals();
   void DisconnectTransportSignals();
   void OnTransportWritableState(rtc::PacketTransportInternal* transport);
   void OnTransportReadPacket(rtc::PacketTransportInternal* transport,
-                             const char* data,
-                             size_t length,
-                             const int64_t& /* packet_time_us */,
+                             const rtc::ReceivedPacket& packet,
                              int flags);
   void OnTransportClosed(rtc::PacketTransportInternal* transport);
 
@@ -132,6 +156,10 @@ class DcSctpTransport : public cricket::SctpTransportInternal,
   flat_map<dcsctp::StreamID, StreamState> stream_states_
       RTC_GUARDED_BY(network_thread_);
   bool ready_to_send_data_ RTC_GUARDED_BY(network_thread_) = false;
+  // Packets of the current burst, sent together once it ends.
+  std::vector<rtc::Buffer> burst_ RTC_GUARDED_BY(network_thread_);
+  absl::optional<dcsctp::DcSctpSocketHandoverState> handover_state_
+      RTC_GUARDED_BY(network_thread_);
   std::function<void()> on_connected_callback_ RTC_GUARDED_BY(network_thread_);
   DataChannelSink* data_channel_sink_ RTC_GUARDED_BY(network_thread_) = nullptr;
 };
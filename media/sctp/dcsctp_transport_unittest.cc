@@ -10,8 +10,10 @@
 
 #include "media/sctp/dcsctp_transport.h"
 
+#include <cstdint>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "net/dcsctp/public/mock_dcsctp_socket.h"
 #include "net/dcsctp/public/mock_dcsctp_socket_factory.h"
@@ -22,11 +24,14 @@ using ::testing::_;
 using ::testing::ByMove;
 using ::testing::DoAll;
 using ::testing::ElementsAre;
+using ::testing::Field;
 using ::testing::InSequence;
 using ::testing::Invoke;
+using ::testing::InvokeWithoutArgs;
 using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::ReturnPointee;
+using ::testing::ReturnRef;
 
 namespace webrtc {
 
@@ -89,6 +94,87 @@ TEST(DcSctpTransportTest, OpenSequence) {
   peer_a.sctp_transport_->Start(5000, 5000, 256 * 1024);
 }
 
+TEST(DcSctpTransportTest, RestoresHandedOverAssociationInsteadOfConnecting) {
+  rtc::AutoThread main_thread;
+  Peer peer_a;
+  peer_a.fake_packet_transport_.SetWritable(true);
+
+  dcsctp::DcSctpSocketHandoverState state;
+  state.socket_state =
+      dcsctp::DcSctpSocketHandoverState::SocketState::kConnected;
+  state.my_verification_tag = 42;
+  EXPECT_CALL(*peer_a.socket_, Connect).Times(0);
+  EXPECT_CALL(*peer_a.socket_,
+              RestoreFromState(Field(
+                  &dcsctp::DcSctpSocketHandoverState::my_verification_tag, 42)))
+      .WillOnce(InvokeWithoutArgs(peer_a.sctp_transport_.get(),
+                                  &dcsctp::DcSctpSocketCallbacks::OnConnected));
+  EXPECT_CALL(peer_a.sink_, OnConnected);
+
+  peer_a.sctp_transport_->RestoreFromHandoverState(state);
+  peer_a.sctp_transport_->Start(5000, 5000, 256 * 1024);
+}
+
+TEST(DcSctpTransportTest, HandsOverAssociationOnlyWhenReady) {
+  rtc::AutoThread main_thread;
+  Peer peer_a;
+  EXPECT_FALSE(peer_a.sctp_transport_->GetHandoverStateAndClose());
+
+  peer_a.sctp_transport_->Start(5000, 5000, 256 * 1024);
+  EXPECT_CALL(*peer_a.socket_, GetHandoverReadiness)
+      .WillOnce(Return(dcsctp::HandoverReadinessStatus(
+          dcsctp::HandoverUnreadinessReason::kSendQueueNotEmpty)))
+      .WillOnce(Return(dcsctp::HandoverReadinessStatus()));
+  EXPECT_CALL(*peer_a.socket_, GetHandoverStateAndClose)
+      .WillOnce(Return(dcsctp::DcSctpSocketHandoverState()));
+
+  EXPECT_FALSE(peer_a.sctp_transport_->GetHandoverStateAndClose());
+  EXPECT_TRUE(peer_a.sctp_transport_->GetHandoverStateAndClose());
+}
+
+TEST(DcSctpTransportTest, SendsBurstPacketsWhenBurstEnds) {
+  rtc::AutoThread main_thread;
+  Peer peer_a;
+  rtc::FakePacketTransport remote("remote");
+  peer_a.fake_packet_transport_.SetDestination(&remote, /*asymmetric=*/false);
+  std::vector<size_t> received_sizes;
+  remote.RegisterReceivedPacketCallback(
+      &received_sizes, [&](rtc::PacketTransportInternal*,
+                           const rtc::ReceivedPacket& packet, int) {
+        received_sizes.push_back(packet.payload().size());
+      });
+  dcsctp::DcSctpOptions options;
+  EXPECT_CALL(*peer_a.socket_, options).WillRepeatedly(ReturnRef(options));
+  peer_a.sctp_transport_->Start(5000, 5000, 256 * 1024);
+  dcsctp::DcSctpSocketCallbacks& callbacks = *peer_a.sctp_transport_;
+
+  const std::vector<uint8_t> first(100);
+  const std::vector<uint8_t> second(200);
+  EXPECT_EQ(callbacks.SendBurstPacketWithStatus(first),
+            dcsctp::SendPacketStatus::kSuccess);
+  EXPECT_EQ(callbacks.SendBurstPacketWithStatus(second),
+            dcsctp::SendPacketStatus::kSuccess);
+  EXPECT_TRUE(received_sizes.empty());
+
+  callbacks.OnPacketBurstEnd();
+  EXPECT_THAT(received_sizes, ElementsAre(100u, 200u));
+  remote.DeregisterReceivedPacketCallback(&received_sizes);
+}
+
+TEST(DcSctpTransportTest, FailsBurstPacketsRightAwayWhenNotWritable) {
+  rtc::AutoThread main_thread;
+  Peer peer_a;
+  dcsctp::DcSctpOptions options;
+  EXPECT_CALL(*peer_a.socket_, options).WillRepeatedly(ReturnRef(options));
+  peer_a.sctp_transport_->Start(5000, 5000, 256 * 1024);
+  dcsctp::DcSctpSocketCallbacks& callbacks = *peer_a.sctp_transport_;
+
+  EXPECT_EQ(callbacks.SendBurstPacketWithStatus(std::vector<uint8_t>(100)),
+            dcsctp::SendPacketStatus::kError);
+  callbacks.OnPacketBurstEnd();
+  EXPECT_TRUE(peer_a.fake_packet_transport_.last_sent_packet()->empty());
+}
+
 // Tests that the close sequence invoked from one end results in the stream to
 // be reset from both ends and all the proper signals are sent.
 TEST(DcSctpTransportTest, CloseSequence) {
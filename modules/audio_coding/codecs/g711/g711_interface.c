@@ -10,15 +10,25 @@
 
 #include <string.h>
 
-#include "modules/third_party/g711/g711.h"
 #include "modules/audio_coding/codecs/g711/g711_interface.h"
+#include "modules/audio_coding/codecs/g711/g711_tables.h"
+
+// The conversions are made with lookup tables, which are generated from the
+// inline routines in modules/third_party/g711/g711.h and are bit exact to
+// them. The tables take 7 kB in total, and avoid the per sample branches and
+// bit searches of the routines. For encoding, a sample `x` is split into a
+// sign, which only affects bit 7 of the code, and a magnitude: `x` for
+// non-negative samples and `~x` for negative samples, as in the routines.
 
 size_t WebRtcG711_EncodeA(const int16_t* speechIn,
                           size_t len,
                           uint8_t* encoded) {
   size_t n;
-  for (n = 0; n < len; n++)
-    encoded[n] = linear_to_alaw(speechIn[n]);
+  for (n = 0; n < len; n++) {
+    const int sign = speechIn[n] >> 15;
+    const int magnitude = speechIn[n] ^ sign;
+    encoded[n] = WebRtcG711_kLinearToAlaw[magnitude >> 4] ^ (sign & 0x80);
+  }
   return len;
 }
 
@@ -26,8 +36,11 @@ size_t WebRtcG711_EncodeU(const int16_t* speechIn,
                           size_t len,
                           uint8_t* encoded) {
   size_t n;
-  for (n = 0; n < len; n++)
-    encoded[n] = linear_to_ulaw(speechIn[n]);
+  for (n = 0; n < len; n++) {
+    const int sign = speechIn[n] >> 15;
+    const int magnitude = speechIn[n] ^ sign;
+    encoded[n] = WebRtcG711_kLinearToUlaw[(magnitude + 4) >> 3] ^ (sign & 0x80);
+  }
   return len;
 }
 
@@ -37,7 +50,7 @@ size_t WebRtcG711_DecodeA(const uint8_t* encoded,
                           int16_t* speechType) {
   size_t n;
   for (n = 0; n < len; n++)
-    decoded[n] = alaw_to_linear(encoded[n]);
+    decoded[n] = WebRtcG711_kAlawToLinear[encoded[n]];
   *speechType = 1;
   return len;
 }
@@ -48,7 +61,7 @@ size_t WebRtcG711_DecodeU(const uint8_t* encoded,
                           int16_t* speechType) {
   size_t n;
   for (n = 0; n < len; n++)
-    decoded[n] = ulaw_to_linear(encoded[n]);
+    decoded[n] = WebRtcG711_kUlawToLinear[encoded[n]];
   *speechType = 1;
   return len;
 }
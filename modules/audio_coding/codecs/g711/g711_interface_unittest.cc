@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/g711/g711_interface.h"
+
+#include <stdint.h>
+
+#include <limits>
+#include <vector>
+
+#include "modules/third_party/g711/g711.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::vector<int16_t> AllSamples() {
+  std::vector<int16_t> samples;
+  for (int x = std::numeric_limits<int16_t>::min();
+       x <= std::numeric_limits<int16_t>::max(); ++x) {
+    samples.push_back(x);
+  }
+  return samples;
+}
+
+std::vector<uint8_t> AllCodes() {
+  std::vector<uint8_t> codes;
+  for (int x = 0; x < 256; ++x) {
+    codes.push_back(x);
+  }
+  return codes;
+}
+
+TEST(G711InterfaceTest, EncodeAIsBitExactForAllSamples) {
+  const std::vector<int16_t> samples = AllSamples();
+  std::vector<uint8_t> encoded(samples.size());
+  EXPECT_EQ(samples.size(), WebRtcG711_EncodeA(samples.data(), samples.size(),
+                                               encoded.data()));
+  for (size_t i = 0; i < samples.size(); ++i) {
+    ASSERT_EQ(linear_to_alaw(samples[i]), encoded[i]) << samples[i];
+  }
+}
+
+TEST(G711InterfaceTest, EncodeUIsBitExactForAllSamples) {
+  const std::vector<int16_t> samples = AllSamples();
+  std::vector<uint8_t> encoded(samples.size());
+  EXPECT_EQ(samples.size(), WebRtcG711_EncodeU(samples.data(), samples.size(),
+                                               encoded.data()));
+  for (size_t i = 0; i < samples.size(); ++i) {
+    ASSERT_EQ(linear_to_ulaw(samples[i]), encoded[i]) << samples[i];
+  }
+}
+
+TEST(G711InterfaceTest, DecodeIsBitExactForAllCodes) {
+  const std::vector<uint8_t> codes = AllCodes();
+  std::vector<int16_t> decoded_a(codes.size());
+  std::vector<int16_t> decoded_u(codes.size());
+  int16_t speech_type = 0;
+  EXPECT_EQ(codes.size(), WebRtcG711_DecodeA(codes.data(), codes.size(),
+                                             decoded_a.data(), &speech_type));
+  EXPECT_EQ(G711_WEBRTC_SPEECH, speech_type);
+  speech_type = 0;
+  EXPECT_EQ(codes.size(), WebRtcG711_DecodeU(codes.data(), codes.size(),
+                                             decoded_u.data(), &speech_type));
+  EXPECT_EQ(G711_WEBRTC_SPEECH, speech_type);
+  for (size_t i = 0; i < codes.size(); ++i) {
+    EXPECT_EQ(alaw_to_linear(codes[i]), decoded_a[i]);
+    EXPECT_EQ(ulaw_to_linear(codes[i]), decoded_u[i]);
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
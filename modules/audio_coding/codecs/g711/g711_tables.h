@@ -0,0 +1,39 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_G711_G711_TABLES_H_
+#define MODULES_AUDIO_CODING_CODECS_G711_G711_TABLES_H_
+
+#include <stdint.h>
+
+// Lookup tables generated from the conversion routines in
+// modules/third_party/g711/g711.h, and bit exact to them.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A-law code of a non-negative sample `x`, indexed by `x >> 4`. The code of a
+// negative sample `x` is the code of `~x` with bit 7 cleared.
+extern const uint8_t WebRtcG711_kLinearToAlaw[2048];
+
+// u-law code of a non-negative sample `x`, indexed by `(x + 4) >> 3`. The code
+// of a negative sample `x` is the code of `~x` with bit 7 cleared.
+extern const uint8_t WebRtcG711_kLinearToUlaw[4097];
+
+// Linear sample values of the A-law and u-law codes.
+extern const int16_t WebRtcG711_kAlawToLinear[256];
+extern const int16_t WebRtcG711_kUlawToLinear[256];
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // MODULES_AUDIO_CODING_CODECS_G711_G711_TABLES_H_
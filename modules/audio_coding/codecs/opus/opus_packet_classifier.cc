@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/opus/opus_packet_classifier.h"
+
+#include "modules/audio_coding/codecs/opus/opus_interface.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kRedHeaderLength = 4;
+constexpr size_t kRedLastHeaderLength = 1;
+// Matches AudioDecoderOpusImpl::IsDtxPacket().
+constexpr size_t kMaxDtxPacketLength = 2;
+
+// Ordered by how much a packet of the type needs to be forwarded.
+int ForwardingPriority(OpusPacketType type) {
+  switch (type) {
+    case OpusPacketType::kDtx:
+      return 0;
+    case OpusPacketType::kSilence:
+      return 1;
+    case OpusPacketType::kUnknown:
+      return 2;
+    case OpusPacketType::kActive:
+      return 3;
+  }
+  return 2;
+}
+
+}  // namespace
+
+OpusPacketType ClassifyOpusPacket(rtc::ArrayView<const uint8_t> payload) {
+  if (payload.size() <= kMaxDtxPacketLength) {
+    return OpusPacketType::kDtx;
+  }
+  switch (WebRtcOpus_PacketHasVoiceActivity(payload.data(), payload.size())) {
+    case 0:
+      return OpusPacketType::kSilence;
+    case 1:
+      return OpusPacketType::kActive;
+    default:
+      return OpusPacketType::kUnknown;
+  }
+}
+
+OpusPacketType ClassifyOpusRedPacket(rtc::ArrayView<const uint8_t> payload,
+                                     uint8_t opus_payload_type) {
+  // The RED headers (RFC 2198) are parsed as in RedPayloadSplitter: every
+  // block but the last has a four byte header with the F bit set, a seven bit
+  // payload type, a 14 bit timestamp offset and a 10 bit block length. The
+  // last block has a one byte header and takes up the rest of the payload.
+  size_t header_offset = 0;
+  size_t block_lengths = 0;
+  size_t num_blocks = 0;
+  while (true) {
+    if (header_offset == payload.size()) {
+      return OpusPacketType::kUnknown;
+    }
+    if ((payload[header_offset] & 0x7F) != opus_payload_type) {
+      return OpusPacketType::kUnknown;
+    }
+    if ((payload[header_offset] & 0x80) == 0) {
+      header_offset += kRedLastHeaderLength;
+      break;
+    }
+    if (payload.size() - header_offset < kRedHeaderLength) {
+      return OpusPacketType::kUnknown;
+    }
+    block_lengths += ((payload[header_offset + 2] & 0x03) << 8) +
+                     payload[header_offset + 3];
+    header_offset += kRedHeaderLength;
+    ++num_blocks;
+  }
+  if (block_lengths > payload.size() - header_offset) {
+    return OpusPacketType::kUnknown;
+  }
+
+  // Classify the redundant blocks in order, followed by the primary block.
+  OpusPacketType type = OpusPacketType::kDtx;
+  size_t block_offset = header_offset;
+  for (size_t i = 0; i <= num_blocks; ++i) {
+    size_t block_length;
+    if (i < num_blocks) {
+      const size_t header = i * kRedHeaderLength;
+      block_length =
+          ((payload[header + 2] & 0x03) << 8) + payload[header + 3];
+    } else {
+      block_length = payload.size() - block_offset;
+    }
+    const OpusPacketType block_type =
+        ClassifyOpusPacket(payload.subview(block_offset, block_length));
+    if (ForwardingPriority(block_type) > ForwardingPriority(type)) {
+      type = block_type;
+    }
+    block_offset += block_length;
+  }
+  return type;
+}
+
+OpusSilenceSuppressor::OpusSilenceSuppressor()
+    : OpusSilenceSuppressor(Config()) {}
+
+OpusSilenceSuppressor::OpusSilenceSuppressor(const Config& config)
+    : config_(config) {}
+
+bool OpusSilenceSuppressor::ShouldForward(OpusPacketType type,
+                                          Timestamp now) {
+  bool forward;
+  if (type == OpusPacketType::kActive || type == OpusPacketType::kUnknown) {
+    last_active_ = now;
+    suppressing_ = false;
+    forward = true;
+  } else if (last_active_ && now - *last_active_ < config_.hangover) {
+    forward = true;
+  } else {
+    suppressing_ = true;
+    forward = !last_forwarded_ ||
+              now - *last_forwarded_ >=
+                  config_.refresh_interval - config_.jitter_tolerance;
+  }
+  if (forward) {
+    last_forwarded_ = now;
+  }
+  return forward;
+}
+
+}  // namespace webrtc
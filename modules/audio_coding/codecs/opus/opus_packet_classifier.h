@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_PACKET_CLASSIFIER_H_
+#define MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_PACKET_CLASSIFIER_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+
+// Classification of an Opus payload, made from the TOC byte and the SILK VAD
+// flags, without decoding the payload.
+enum class OpusPacketType {
+  // A DTX packet of at most two bytes, which the decoder turns into comfort
+  // noise.
+  kDtx,
+  // A SILK or hybrid packet in which no frame has the VAD flag set.
+  kSilence,
+  // A packet in which at least one frame has the VAD flag set.
+  kActive,
+  // A CELT-only or malformed packet, which carries no VAD information.
+  kUnknown,
+};
+
+OpusPacketType ClassifyOpusPacket(rtc::ArrayView<const uint8_t> payload);
+
+// Classifies a RED (RFC 2198) payload by the Opus blocks it carries: it is
+// active if any block is, so that a redundant copy of the last active packet
+// is not dropped at the end of a talk spurt. Blocks of other payload types,
+// and payloads whose RED headers don't match their length, are kUnknown.
+OpusPacketType ClassifyOpusRedPacket(rtc::ArrayView<const uint8_t> payload,
+                                     uint8_t opus_payload_type);
+
+// Decides, per forwarded Opus stream, which packets an SFU needs to forward.
+// All active and unknown packets are forwarded, as well as the silent packets
+// within `hangover` of the last active one. After that, only one packet per
+// `refresh_interval` is forwarded, which is enough for the receiving decoder
+// to keep generating comfort noise, like the refresh packets of an encoder in
+// DTX. The caller is responsible for rewriting sequence numbers so that the
+// suppressed packets are not mistaken for losses.
+class OpusSilenceSuppressor {
+ public:
+  struct Config {
+    TimeDelta hangover = TimeDelta::Millis(200);
+    TimeDelta refresh_interval = TimeDelta::Millis(400);
+    // A silent packet arriving up to this much before `refresh_interval` has
+    // passed is forwarded as well. Otherwise a DTX sender's own refresh
+    // packets, which arrive about once per `refresh_interval`, would be
+    // dropped whenever network jitter makes one arrive early.
+    TimeDelta jitter_tolerance = TimeDelta::Millis(40);
+  };
+
+  OpusSilenceSuppressor();
+  explicit OpusSilenceSuppressor(const Config& config);
+
+  // Returns true if a packet of type `type` received at `now` is to be
+  // forwarded.
+  bool ShouldForward(OpusPacketType type, Timestamp now);
+
+  // Returns true if the stream has been silent for longer than the hangover.
+  bool suppressing() const { return suppressing_; }
+
+ private:
+  const Config config_;
+  absl::optional<Timestamp> last_active_;
+  absl::optional<Timestamp> last_forwarded_;
+  bool suppressing_ = false;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_CODECS_OPUS_OPUS_PACKET_CLASSIFIER_H_
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/opus/opus_packet_classifier.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint8_t kOpusPayloadType = 111;
+constexpr uint8_t kOtherPayloadType = 63;
+
+// Hybrid, 20 ms, single frame packets, with and without the VAD flag set, and
+// a CELT-only packet.
+const std::vector<uint8_t> kActivePacket = {0x78, 0x80, 0x12, 0x34};
+const std::vector<uint8_t> kSilentPacket = {0x78, 0x00, 0x12, 0x34};
+const std::vector<uint8_t> kCeltPacket = {0x80, 0x00, 0x12, 0x34};
+const std::vector<uint8_t> kDtxPacket = {0x78};
+
+// Builds a RED payload with `redundant` blocks followed by `primary`.
+std::vector<uint8_t> CreateRedPacket(
+    const std::vector<std::vector<uint8_t>>& redundant,
+    const std::vector<uint8_t>& primary,
+    uint8_t payload_type = kOpusPayloadType) {
+  std::vector<uint8_t> red;
+  const uint32_t kTimestampOffset = 960;
+  for (const auto& block : redundant) {
+    red.push_back(0x80 | kOpusPayloadType);
+    red.push_back(kTimestampOffset >> 6);
+    red.push_back(((kTimestampOffset & 0x3F) << 2) | (block.size() >> 8));
+    red.push_back(block.size() & 0xFF);
+  }
+  red.push_back(payload_type);
+  for (const auto& block : redundant) {
+    red.insert(red.end(), block.begin(), block.end());
+  }
+  red.insert(red.end(), primary.begin(), primary.end());
+  return red;
+}
+
+TEST(OpusPacketClassifierTest, ClassifiesOpusPackets) {
+  EXPECT_EQ(ClassifyOpusPacket(kActivePacket), OpusPacketType::kActive);
+  EXPECT_EQ(ClassifyOpusPacket(kSilentPacket), OpusPacketType::kSilence);
+  EXPECT_EQ(ClassifyOpusPacket(kCeltPacket), OpusPacketType::kUnknown);
+  EXPECT_EQ(ClassifyOpusPacket(kDtxPacket), OpusPacketType::kDtx);
+  EXPECT_EQ(ClassifyOpusPacket({}), OpusPacketType::kDtx);
+}
+
+TEST(OpusPacketClassifierTest, ClassifiesRedPacketsByPrimaryBlock) {
+  EXPECT_EQ(ClassifyOpusRedPacket(CreateRedPacket({}, kActivePacket),
+                                  kOpusPayloadType),
+            OpusPacketType::kActive);
+  EXPECT_EQ(ClassifyOpusRedPacket(CreateRedPacket({kSilentPacket}, kDtxPacket),
+                                  kOpusPayloadType),
+            OpusPacketType::kSilence);
+  EXPECT_EQ(ClassifyOpusRedPacket(CreateRedPacket({kDtxPacket}, kDtxPacket),
+                                  kOpusPayloadType),
+            OpusPacketType::kDtx);
+}
+
+TEST(OpusPacketClassifierTest, RedPacketWithActiveRedundancyIsActive) {
+  EXPECT_EQ(ClassifyOpusRedPacket(
+                CreateRedPacket({kActivePacket, kSilentPacket}, kSilentPacket),
+                kOpusPayloadType),
+            OpusPacketType::kActive);
+}
+
+TEST(OpusPacketClassifierTest, MalformedRedPacketIsUnknown) {
+  EXPECT_EQ(ClassifyOpusRedPacket({}, kOpusPayloadType),
+            OpusPacketType::kUnknown);
+  EXPECT_EQ(ClassifyOpusRedPacket(
+                CreateRedPacket({}, kSilentPacket, kOtherPayloadType),
+                kOpusPayloadType),
+            OpusPacketType::kUnknown);
+
+  // Truncated header.
+  std::vector<uint8_t> red = CreateRedPacket({kSilentPacket}, kSilentPacket);
+  red.resize(3);
+  EXPECT_EQ(ClassifyOpusRedPacket(red, kOpusPayloadType),
+            OpusPacketType::kUnknown);
+
+  // Redundant block longer than the payload.
+  red = CreateRedPacket({kSilentPacket}, kSilentPacket);
+  red[3] = 0xFF;
+  EXPECT_EQ(ClassifyOpusRedPacket(red, kOpusPayloadType),
+            OpusPacketType::kUnknown);
+}
+
+TEST(OpusSilenceSuppressorTest, ForwardsActivePacketsAndHangover) {
+  OpusSilenceSuppressor suppressor;
+  Timestamp now = Timestamp::Seconds(1);
+  EXPECT_TRUE(suppressor.ShouldForward(OpusPacketType::kActive, now));
+  for (int i = 0; i < 9; ++i) {
+    now += TimeDelta::Millis(20);
+    EXPECT_TRUE(suppressor.ShouldForward(OpusPacketType::kSilence, now));
+    EXPECT_FALSE(suppressor.suppressing());
+  }
+  now += TimeDelta::Millis(20);
+  EXPECT_FALSE(suppressor.ShouldForward(OpusPacketType::kSilence, now));
+  EXPECT_TRUE(suppressor.suppressing());
+
+  now += TimeDelta::Millis(20);
+  EXPECT_TRUE(suppressor.ShouldForward(OpusPacketType::kActive, now));
+  EXPECT_FALSE(suppressor.suppressing());
+  now += TimeDelta::Millis(20);
+  EXPECT_TRUE(suppressor.ShouldForward(OpusPacketType::kUnknown, now));
+}
+
+TEST(OpusSilenceSuppressorTest, ForwardsOneSilentPacketPerRefreshInterval) {
+  OpusSilenceSuppressor::Config config;
+  config.hangover = TimeDelta::Zero();
+  config.refresh_interval = TimeDelta::Millis(400);
+  config.jitter_tolerance = TimeDelta::Zero();
+  OpusSilenceSuppressor suppressor(config);
+  Timestamp now = Timestamp::Seconds(1);
+  int forwarded = 0;
+  for (int i = 0; i < 100; ++i) {
+    if (suppressor.ShouldForward(
+            i % 2 ? OpusPacketType::kSilence : OpusPacketType::kDtx, now)) {
+      ++forwarded;
+    }
+    now += TimeDelta::Millis(20);
+  }
+  // 2 seconds of silence.
+  EXPECT_EQ(forwarded, 5);
+  EXPECT_TRUE(suppressor.suppressing());
+}
+
+TEST(OpusSilenceSuppressorTest, ForwardsEarlyDtxRefreshPackets) {
+  OpusSilenceSuppressor::Config config;
+  config.hangover = TimeDelta::Zero();
+  config.refresh_interval = TimeDelta::Millis(400);
+  config.jitter_tolerance = TimeDelta::Millis(40);
+  OpusSilenceSuppressor suppressor(config);
+  // A DTX sender's refresh packets, 400 ms apart, with network jitter.
+  const Timestamp start = Timestamp::Seconds(1);
+  for (int64_t arrival_ms : {0, 390, 800, 1165, 1600}) {
+    EXPECT_TRUE(suppressor.ShouldForward(
+        OpusPacketType::kDtx, start + TimeDelta::Millis(arrival_ms)))
+        << arrival_ms;
+  }
+  // Packets well within the refresh interval are still dropped.
+  EXPECT_FALSE(suppressor.ShouldForward(OpusPacketType::kDtx,
+                                        start + TimeDelta::Millis(1900)));
+}
+
+}  // namespace
+}  // namespace webrtc
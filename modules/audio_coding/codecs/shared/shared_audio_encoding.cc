@@ -0,0 +1,147 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/shared/shared_audio_encoding.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "api/scoped_refptr.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+class SharedAudioEncoding::Encoder final : public AudioEncoder {
+ public:
+  Encoder(rtc::scoped_refptr<SharedAudioEncoding> shared, int64_t block_index)
+      : shared_(std::move(shared)), block_index_(block_index) {}
+
+  int SampleRateHz() const override {
+    MutexLock lock(&shared_->mutex_);
+    return shared_->encoder_->SampleRateHz();
+  }
+  size_t NumChannels() const override {
+    MutexLock lock(&shared_->mutex_);
+    return shared_->encoder_->NumChannels();
+  }
+  int RtpTimestampRateHz() const override {
+    MutexLock lock(&shared_->mutex_);
+    return shared_->encoder_->RtpTimestampRateHz();
+  }
+  size_t Num10MsFramesInNextPacket() const override {
+    MutexLock lock(&shared_->mutex_);
+    return shared_->encoder_->Num10MsFramesInNextPacket();
+  }
+  size_t Max10MsFramesInAPacket() const override {
+    MutexLock lock(&shared_->mutex_);
+    return shared_->encoder_->Max10MsFramesInAPacket();
+  }
+  int GetTargetBitrate() const override {
+    MutexLock lock(&shared_->mutex_);
+    return shared_->encoder_->GetTargetBitrate();
+  }
+  bool GetDtx() const override {
+    MutexLock lock(&shared_->mutex_);
+    return shared_->encoder_->GetDtx();
+  }
+  absl::optional<std::pair<TimeDelta, TimeDelta>> GetFrameLengthRange()
+      const override {
+    MutexLock lock(&shared_->mutex_);
+    return shared_->encoder_->GetFrameLengthRange();
+  }
+
+  void Reset() override {
+    if (separate_encoder_) {
+      separate_encoder_->Reset();
+    }
+  }
+
+ protected:
+  EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
+                         rtc::ArrayView<const int16_t> audio,
+                         rtc::Buffer* encoded) override {
+    if (!separate_encoder_) {
+      absl::optional<EncodedInfo> info =
+          shared_->Encode(block_index_, rtp_timestamp, audio, encoded);
+      if (info) {
+        ++block_index_;
+        return *info;
+      }
+      separate_encoder_ = shared_->CreateSeparateEncoder();
+    }
+    return separate_encoder_->Encode(rtp_timestamp, audio, encoded);
+  }
+
+ private:
+  const rtc::scoped_refptr<SharedAudioEncoding> shared_;
+  // Number of blocks taken from the shared encoding.
+  int64_t block_index_;
+  // Set once this encoder has left the shared encoding.
+  std::unique_ptr<AudioEncoder> separate_encoder_;
+};
+
+SharedAudioEncoding::SharedAudioEncoding(
+    absl::AnyInvocable<std::unique_ptr<AudioEncoder>()> create_encoder)
+    : create_encoder_(std::move(create_encoder)),
+      encoder_(create_encoder_()) {
+  RTC_DCHECK(encoder_);
+}
+
+SharedAudioEncoding::~SharedAudioEncoding() = default;
+
+std::unique_ptr<AudioEncoder> SharedAudioEncoding::CreateEncoder() {
+  MutexLock lock(&mutex_);
+  return std::make_unique<Encoder>(
+      rtc::scoped_refptr<SharedAudioEncoding>(this), encoded_blocks_);
+}
+
+int64_t SharedAudioEncoding::encoded_blocks() const {
+  MutexLock lock(&mutex_);
+  return encoded_blocks_;
+}
+
+absl::optional<AudioEncoder::EncodedInfo> SharedAudioEncoding::Encode(
+    int64_t block_index,
+    uint32_t rtp_timestamp,
+    rtc::ArrayView<const int16_t> audio,
+    rtc::Buffer* encoded) {
+  MutexLock lock(&mutex_);
+  if (block_index == encoded_blocks_) {
+    // First to get to the next block.
+    last_audio_.assign(audio.begin(), audio.end());
+    last_rtp_timestamp_ = rtp_timestamp;
+    last_encoded_.Clear();
+    last_info_ = encoder_->Encode(rtp_timestamp, audio, &last_encoded_);
+    ++encoded_blocks_;
+  } else if (block_index != encoded_blocks_ - 1 ||
+             !std::equal(audio.begin(), audio.end(), last_audio_.begin(),
+                         last_audio_.end())) {
+    return absl::nullopt;
+  }
+  encoded->AppendData(last_encoded_);
+  AudioEncoder::EncodedInfo info = last_info_;
+  // The encoded audio may start in an earlier block, at the same offset from
+  // the caller's timestamp as from that of the first encoder.
+  info.encoded_timestamp =
+      rtp_timestamp + (last_info_.encoded_timestamp - last_rtp_timestamp_);
+  for (AudioEncoder::EncodedInfoLeaf& redundant : info.redundant) {
+    redundant.encoded_timestamp =
+        rtp_timestamp + (redundant.encoded_timestamp - last_rtp_timestamp_);
+  }
+  return info;
+}
+
+std::unique_ptr<AudioEncoder> SharedAudioEncoding::CreateSeparateEncoder() {
+  MutexLock lock(&mutex_);
+  return create_encoder_();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_SHARED_SHARED_AUDIO_ENCODING_H_
+#define MODULES_AUDIO_CODING_CODECS_SHARED_SHARED_AUDIO_ENCODING_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/audio_codecs/audio_encoder.h"
+#include "api/ref_counted_base.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Shares the work of encoding the same audio for many receivers, e.g. the mix
+// that a conference server sends to the participants that aren't speaking.
+// The encoders created by CreateEncoder() are used like any other encoder,
+// one per outgoing stream. As long as they are given the same 10 ms blocks
+// of audio in step with each other, only the first one to get a block
+// actually encodes it, and the others get copies of the result. An encoder
+// that gets audio that differs from what it would share, or that falls
+// behind, continues on an encoder of its own.
+//
+// The shared encoding can't adapt to the individual streams, so the encoders
+// ignore per stream settings such as target bitrate, FEC and DTX changes,
+// and their default AudioEncoder implementations are used instead. Encoders
+// may be used on different threads.
+//
+// Create with rtc::make_ref_counted<SharedAudioEncoding>(create_encoder).
+class SharedAudioEncoding final
+    : public rtc::RefCountedNonVirtual<SharedAudioEncoding> {
+ public:
+  // `create_encoder` is used for the shared encoder and for the encoders of
+  // streams that leave the shared encoding, so it must create identically
+  // configured encoders.
+  explicit SharedAudioEncoding(
+      absl::AnyInvocable<std::unique_ptr<AudioEncoder>()> create_encoder);
+  ~SharedAudioEncoding();
+
+  SharedAudioEncoding(const SharedAudioEncoding&) = delete;
+  SharedAudioEncoding& operator=(const SharedAudioEncoding&) = delete;
+
+  // Returns an encoder that takes part in the shared encoding from the next
+  // block of audio on.
+  std::unique_ptr<AudioEncoder> CreateEncoder();
+
+  // Number of 10 ms blocks encoded by the shared encoder.
+  int64_t encoded_blocks() const;
+
+ private:
+  class Encoder;
+
+  // Gives the encoding of the block of audio following the `block_index`
+  // blocks that the caller has encoded so far, encoding it if the caller is
+  // the first to get there. Returns nullopt if the caller's audio differs from
+  // the shared block, or if the caller is too far behind to share it.
+  absl::optional<AudioEncoder::EncodedInfo> Encode(
+      int64_t block_index,
+      uint32_t rtp_timestamp,
+      rtc::ArrayView<const int16_t> audio,
+      rtc::Buffer* encoded);
+
+  std::unique_ptr<AudioEncoder> CreateSeparateEncoder();
+
+  mutable Mutex mutex_;
+  absl::AnyInvocable<std::unique_ptr<AudioEncoder>()> create_encoder_
+      RTC_GUARDED_BY(mutex_);
+  const std::unique_ptr<AudioEncoder> encoder_ RTC_PT_GUARDED_BY(mutex_);
+  // Number of blocks encoded by `encoder_`, and the last block and its
+  // encoding.
+  int64_t encoded_blocks_ RTC_GUARDED_BY(mutex_) = 0;
+  std::vector<int16_t> last_audio_ RTC_GUARDED_BY(mutex_);
+  uint32_t last_rtp_timestamp_ RTC_GUARDED_BY(mutex_) = 0;
+  AudioEncoder::EncodedInfo last_info_ RTC_GUARDED_BY(mutex_);
+  rtc::Buffer last_encoded_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_CODECS_SHARED_SHARED_AUDIO_ENCODING_H_
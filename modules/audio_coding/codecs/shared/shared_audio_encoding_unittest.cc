@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/shared/shared_audio_encoding.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/make_ref_counted.h"
+#include "rtc_base/buffer.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr int kSampleRateHz = 8000;
+constexpr size_t kBlockSize = kSampleRateHz / 100;
+
+// Encodes two blocks into a packet holding the first sample of each.
+class FakeEncoder : public AudioEncoder {
+ public:
+  explicit FakeEncoder(int* encode_calls) : encode_calls_(encode_calls) {}
+
+  int SampleRateHz() const override { return kSampleRateHz; }
+  size_t NumChannels() const override { return 1; }
+  size_t Num10MsFramesInNextPacket() const override { return 2; }
+  size_t Max10MsFramesInAPacket() const override { return 2; }
+  int GetTargetBitrate() const override { return 64000; }
+  void Reset() override { samples_.clear(); }
+  absl::optional<std::pair<TimeDelta, TimeDelta>> GetFrameLengthRange()
+      const override {
+    return absl::nullopt;
+  }
+
+ protected:
+  EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
+                         rtc::ArrayView<const int16_t> audio,
+                         rtc::Buffer* encoded) override {
+    ++*encode_calls_;
+    if (samples_.empty()) {
+      first_timestamp_ = rtp_timestamp;
+    }
+    samples_.push_back(static_cast<uint8_t>(audio[0]));
+    EncodedInfo info;
+    if (samples_.size() == 2) {
+      encoded->AppendData(samples_.data(), samples_.size());
+      info.encoded_bytes = samples_.size();
+      info.encoded_timestamp = first_timestamp_;
+      info.payload_type = 0;
+      samples_.clear();
+    }
+    return info;
+  }
+
+ private:
+  int* const encode_calls_;
+  std::vector<uint8_t> samples_;
+  uint32_t first_timestamp_ = 0;
+};
+
+std::vector<int16_t> Block(int16_t value) {
+  return std::vector<int16_t>(kBlockSize, value);
+}
+
+class SharedAudioEncodingTest : public ::testing::Test {
+ protected:
+  SharedAudioEncodingTest()
+      : shared_(rtc::make_ref_counted<SharedAudioEncoding>([this] {
+          ++encoders_created_;
+          return std::make_unique<FakeEncoder>(&encode_calls_);
+        })) {}
+
+  int encode_calls_ = 0;
+  int encoders_created_ = 0;
+  rtc::scoped_refptr<SharedAudioEncoding> shared_;
+};
+
+TEST_F(SharedAudioEncodingTest, EncodesOnceForEncodersInStep) {
+  std::unique_ptr<AudioEncoder> first = shared_->CreateEncoder();
+  std::unique_ptr<AudioEncoder> second = shared_->CreateEncoder();
+  EXPECT_EQ(first->SampleRateHz(), kSampleRateHz);
+  EXPECT_EQ(first->Num10MsFramesInNextPacket(), 2u);
+
+  rtc::Buffer first_encoded;
+  rtc::Buffer second_encoded;
+  // The streams use different RTP timestamps.
+  first->Encode(1000, Block(1), &first_encoded);
+  second->Encode(5000, Block(1), &second_encoded);
+  AudioEncoder::EncodedInfo first_info =
+      first->Encode(1000 + kBlockSize, Block(2), &first_encoded);
+  AudioEncoder::EncodedInfo second_info =
+      second->Encode(5000 + kBlockSize, Block(2), &second_encoded);
+
+  EXPECT_EQ(encode_calls_, 2);
+  EXPECT_EQ(shared_->encoded_blocks(), 2);
+  EXPECT_EQ(encoders_created_, 1);
+  EXPECT_EQ(first_info.encoded_bytes, 2u);
+  EXPECT_EQ(first_info.encoded_timestamp, 1000u);
+  EXPECT_EQ(second_info.encoded_bytes, 2u);
+  EXPECT_EQ(second_info.encoded_timestamp, 5000u);
+  EXPECT_THAT(first_encoded, ElementsAre(1, 2));
+  EXPECT_EQ(second_encoded, first_encoded);
+}
+
+TEST_F(SharedAudioEncodingTest, EncodesRepeatedBlocksEachTime) {
+  std::unique_ptr<AudioEncoder> first = shared_->CreateEncoder();
+  std::unique_ptr<AudioEncoder> second = shared_->CreateEncoder();
+
+  rtc::Buffer encoded;
+  for (int i = 0; i < 4; ++i) {
+    // Identical blocks, e.g. silence.
+    first->Encode(i * kBlockSize, Block(0), &encoded);
+    second->Encode(i * kBlockSize, Block(0), &encoded);
+  }
+  EXPECT_EQ(encode_calls_, 4);
+  EXPECT_EQ(encoders_created_, 1);
+  EXPECT_EQ(encoded.size(), 8u);
+}
+
+TEST_F(SharedAudioEncodingTest, EncoderWithDifferentAudioEncodesSeparately) {
+  std::unique_ptr<AudioEncoder> first = shared_->CreateEncoder();
+  std::unique_ptr<AudioEncoder> second = shared_->CreateEncoder();
+
+  rtc::Buffer first_encoded;
+  rtc::Buffer second_encoded;
+  first->Encode(0, Block(1), &first_encoded);
+  second->Encode(0, Block(7), &second_encoded);
+  first->Encode(kBlockSize, Block(2), &first_encoded);
+  second->Encode(kBlockSize, Block(2), &second_encoded);
+
+  EXPECT_EQ(encoders_created_, 2);
+  EXPECT_EQ(encode_calls_, 4);
+  EXPECT_THAT(first_encoded, ElementsAre(1, 2));
+  EXPECT_THAT(second_encoded, ElementsAre(7, 2));
+}
+
+TEST_F(SharedAudioEncodingTest, EncoderThatFallsBehindEncodesSeparately) {
+  std::unique_ptr<AudioEncoder> first = shared_->CreateEncoder();
+  std::unique_ptr<AudioEncoder> second = shared_->CreateEncoder();
+
+  rtc::Buffer encoded;
+  first->Encode(0, Block(1), &encoded);
+  first->Encode(kBlockSize, Block(2), &encoded);
+  second->Encode(0, Block(1), &encoded);
+  EXPECT_EQ(encoders_created_, 2);
+
+  // Encoders created later join the shared encoding.
+  std::unique_ptr<AudioEncoder> third = shared_->CreateEncoder();
+  first->Encode(2 * kBlockSize, Block(3), &encoded);
+  third->Encode(2 * kBlockSize, Block(3), &encoded);
+  EXPECT_EQ(encoders_created_, 2);
+  EXPECT_EQ(shared_->encoded_blocks(), 3);
+}
+
+}  // namespace
+}  // namespace webrtc
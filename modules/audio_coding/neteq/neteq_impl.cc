@@ -799,6 +799,48 @@ bool NetEqImpl::MaybeChangePayloadType(uint8_t payload_type) {
   return changed;
 }
 
+int NetEqImpl::SkipAudio(AudioFrame* audio_frame) {
+  TRACE_EVENT0("webrtc", "NetEqImpl::SkipAudio");
+  MutexLock lock(&mutex_);
+  tick_timer_->Increment();
+  stats_->IncreaseCounter(output_size_samples_, fs_hz_);
+  stats_->ExpandedNoiseSamples(output_size_samples_, false);
+  if (!skipped_audio_) {
+    // Clear the audio played out before skipping, so that it isn't concealed
+    // when decoding resumes.
+    sync_buffer_->Flush();
+    sync_buffer_->set_next_index(sync_buffer_->next_index() -
+                                 expand_->overlap_length());
+    expand_->Reset();
+    skipped_audio_ = true;
+  }
+  last_mode_ = Mode::kExpand;
+  playout_timestamp_ += static_cast<uint32_t>(output_size_samples_);
+  if (!first_packet_ && !new_codec_) {
+    // Discard the packets that would have been played out by now. Before the
+    // first packet is decoded, `playout_timestamp_` isn't related to the
+    // packet timestamps yet.
+    packet_buffer_->DiscardOldPackets(playout_timestamp_, 5 * fs_hz_);
+  }
+
+  audio_frame->Reset();
+  // Make sure the total number of samples fits in the AudioFrame.
+  if (output_size_samples_ * sync_buffer_->Channels() >
+      AudioFrame::kMaxDataSizeSamples) {
+    return kFail;
+  }
+  audio_frame->sample_rate_hz_ = fs_hz_;
+  audio_frame->samples_per_channel_ = output_size_samples_;
+  audio_frame->timestamp_ =
+      first_packet_
+          ? 0
+          : timestamp_scaler_->ToExternal(playout_timestamp_) -
+                static_cast<uint32_t>(audio_frame->samples_per_channel_);
+  audio_frame->num_channels_ = sync_buffer_->Channels();
+  last_output_sample_rate_hz_ = audio_frame->sample_rate_hz_;
+  return kOK;
+}
+
 int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame,
                                 bool* muted,
                                 absl::optional<Operation> action_override) {
@@ -842,6 +884,12 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame,
     *muted = true;
     return 0;
   }
+  if (skipped_audio_ && !packet_buffer_->Empty()) {
+    // Resume decoding from the next buffered packet, as if it started a new
+    // stream, since the timestamps of the flushed `sync_buffer_` are stale.
+    new_codec_ = true;
+    skipped_audio_ = false;
+  }
   int return_value = GetDecision(&operation, &packet_list, &dtmf_event,
                                  &play_dtmf, action_override);
   if (return_value != 0) {
@@ -138,6 +138,8 @@ class NetEqImpl : public webrtc::NetEq {
       int* current_sample_rate_hz = nullptr,
       absl::optional<Operation> action_override = absl::nullopt) override;
 
+  int SkipAudio(AudioFrame* audio_frame) override;
+
   void SetCodecs(const std::map<int, SdpAudioFormat>& codecs) override;
 
   bool RegisterPayloadType(int rtp_payload_type,
@@ -397,6 +399,8 @@ class NetEqImpl : public webrtc::NetEq {
   std::unique_ptr<NackTracker> nack_ RTC_GUARDED_BY(mutex_);
   bool nack_enabled_ RTC_GUARDED_BY(mutex_);
   const bool enable_muted_state_ RTC_GUARDED_BY(mutex_);
+  // True if SkipAudio() has been called since the last decoded packet.
+  bool skipped_audio_ RTC_GUARDED_BY(mutex_) = false;
   AudioFrame::VADActivity last_vad_activity_ RTC_GUARDED_BY(mutex_) =
       AudioFrame::kVadPassive;
   std::unique_ptr<TickTimer::Stopwatch> generated_noise_stopwatch_
@@ -1291,6 +1291,54 @@ TEST_F(NetEqImplTest, FloodBufferAndGetNetworkStats) {
   EXPECT_EQ(NetEq::kOK, neteq_->NetworkStatistics(&stats));
 }
 
+TEST_F(NetEqImplTest, SkipAudioKeepsBufferAtPlayoutTime) {
+  UseNoMocks();
+  CreateInstance();
+
+  const size_t kPayloadLengthSamples = 80;
+  const size_t kPayloadLengthBytes = 2 * kPayloadLengthSamples;  // PCM 16-bit.
+  const uint8_t kPayloadType = 17;  // Just an arbitrary number.
+  uint8_t payload[kPayloadLengthBytes] = {0};
+  RTPHeader rtp_header;
+  rtp_header.payloadType = kPayloadType;
+  rtp_header.sequenceNumber = 0x1234;
+  rtp_header.timestamp = 0x12345678;
+  rtp_header.ssrc = 0x87654321;
+  EXPECT_TRUE(neteq_->RegisterPayloadType(kPayloadType,
+                                          SdpAudioFormat("l16", 8000, 1)));
+  auto insert_packet = [&] {
+    EXPECT_EQ(NetEq::kOK, neteq_->InsertPacket(rtp_header, payload));
+    rtp_header.timestamp += rtc::checked_cast<uint32_t>(kPayloadLengthSamples);
+    ++rtp_header.sequenceNumber;
+  };
+
+  // Insert one 10 ms packet per 10 ms of playout.
+  AudioFrame output;
+  bool muted;
+  for (int i = 0; i < 10; ++i) {
+    insert_packet();
+    EXPECT_EQ(NetEq::kOK, neteq_->GetAudio(&output, &muted));
+    EXPECT_FALSE(muted);
+  }
+
+  // The packets which would have been played out while skipping are
+  // discarded, instead of accumulating in the buffer.
+  for (int i = 0; i < 50; ++i) {
+    insert_packet();
+    EXPECT_EQ(NetEq::kOK, neteq_->SkipAudio(&output));
+    EXPECT_TRUE(output.muted());
+    EXPECT_EQ(kPayloadLengthSamples, output.samples_per_channel_);
+  }
+  EXPECT_LE(packet_buffer_->NumPacketsInBuffer(), 2u);
+
+  // Decoding resumes from the buffered packets.
+  insert_packet();
+  EXPECT_EQ(NetEq::kOK, neteq_->GetAudio(&output, &muted));
+  EXPECT_FALSE(muted);
+  EXPECT_EQ(NetEq::Operation::kNormal, neteq_->last_operation_for_test());
+  EXPECT_LE(packet_buffer_->NumPacketsInBuffer(), 2u);
+}
+
 TEST_F(NetEqImplTest, DecodedPayloadTooShort) {
   UseNoMocks();
   // Create a mock decoder object.
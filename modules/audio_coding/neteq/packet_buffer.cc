@@ -8,14 +8,13 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-// This is the implementation of the PacketBuffer class. It is mostly based on
-// an STL list. The list is kept sorted at all times so that the next packet to
-// decode is at the beginning of the list.
+// This is the implementation of the PacketBuffer class. It is based on a ring
+// buffer of packets, which is kept sorted at all times so that the next packet
+// to decode is at the beginning of the buffer.
 
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <algorithm>
-#include <list>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -32,17 +31,10 @@
 
 namespace webrtc {
 namespace {
-// Predicate used when inserting packets in the buffer list.
-// Operator() returns true when `packet` goes before `new_packet`.
-class NewTimestampIsLarger {
- public:
-  explicit NewTimestampIsLarger(const Packet& new_packet)
-      : new_packet_(new_packet) {}
-  bool operator()(const Packet& packet) { return (new_packet_ >= packet); }
-
- private:
-  const Packet& new_packet_;
-};
+
+// Initial number of packet slots, which is doubled each time the buffer runs
+// out of slots, up to the maximum number of packets.
+constexpr size_t kMinNumberOfSlots = 8;
 
 }  // namespace
 
@@ -54,21 +46,19 @@ PacketBuffer::PacketBuffer(size_t max_number_of_packets,
       stats_(stats) {}
 
 // Destructor. All packets in the buffer will be destroyed.
-PacketBuffer::~PacketBuffer() {
-  buffer_.clear();
-}
+PacketBuffer::~PacketBuffer() = default;
 
 // Flush the buffer. All packets in the buffer will be destroyed.
 void PacketBuffer::Flush() {
-  for (auto& p : buffer_) {
-    LogPacketDiscarded(p.priority.codec_level);
+  for (size_t i = 0; i < size_; ++i) {
+    LogPacketDiscarded(at(i).priority.codec_level);
   }
-  buffer_.clear();
+  Clear();
   stats_->FlushedPacketBuffer();
 }
 
 bool PacketBuffer::Empty() const {
-  return buffer_.empty();
+  return size_ == 0;
 }
 
 int PacketBuffer::InsertPacket(Packet&& packet) {
@@ -84,36 +74,38 @@ int PacketBuffer::InsertPacket(Packet&& packet) {
 
   packet.waiting_time = tick_timer_->GetNewStopwatch();
 
-  if (buffer_.size() >= max_number_of_packets_) {
+  if (size_ >= max_number_of_packets_) {
     // Buffer is full.
     Flush();
     return_val = kFlushed;
     RTC_LOG(LS_WARNING) << "Packet buffer flushed.";
   }
 
-  // Get an iterator pointing to the place in the buffer where the new packet
-  // should be inserted. The list is searched from the back, since the most
-  // likely case is that the new packet should be near the end of the list.
-  PacketList::reverse_iterator rit = std::find_if(
-      buffer_.rbegin(), buffer_.rend(), NewTimestampIsLarger(packet));
+  // Find the place in the buffer where the new packet should be inserted. The
+  // buffer is searched from the back, since the most likely case is that the
+  // new packet should be near the end of the buffer.
+  size_t index = size_;
+  while (index > 0 && !(packet >= at(index - 1))) {
+    --index;
+  }
 
-  // The new packet is to be inserted to the right of `rit`. If it has the same
-  // timestamp as `rit`, which has a higher priority, do not insert the new
-  // packet to list.
-  if (rit != buffer_.rend() && packet.timestamp == rit->timestamp) {
+  // The new packet is to be inserted after the packet at `index - 1`. If it
+  // has the same timestamp as that packet, which has a higher priority, do not
+  // insert the new packet to the buffer.
+  if (index > 0 && packet.timestamp == at(index - 1).timestamp) {
     LogPacketDiscarded(packet.priority.codec_level);
     return return_val;
   }
 
-  // The new packet is to be inserted to the left of `it`. If it has the same
-  // timestamp as `it`, which has a lower priority, replace `it` with the new
-  // packet.
-  PacketList::iterator it = rit.base();
-  if (it != buffer_.end() && packet.timestamp == it->timestamp) {
-    LogPacketDiscarded(it->priority.codec_level);
-    it = buffer_.erase(it);
+  // If the new packet has the same timestamp as the packet at `index`, which
+  // has a lower priority, replace that packet with the new packet.
+  if (index < size_ && packet.timestamp == at(index).timestamp) {
+    LogPacketDiscarded(at(index).priority.codec_level);
+    at(index) = std::move(packet);
+    sample_count_ = absl::nullopt;
+    return return_val;
   }
-  buffer_.insert(it, std::move(packet));  // Insert the packet at that position.
+  Insert(index, std::move(packet));
 
   return return_val;
 }
@@ -125,7 +117,7 @@ int PacketBuffer::NextTimestamp(uint32_t* next_timestamp) const {
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  *next_timestamp = buffer_.front().timestamp;
+  *next_timestamp = front().timestamp;
   return kOK;
 }
 
@@ -137,11 +129,10 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_iterator it;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    if (it->timestamp >= timestamp) {
+  for (size_t i = 0; i < size_; ++i) {
+    if (at(i).timestamp >= timestamp) {
       // Found a packet matching the search.
-      *next_timestamp = it->timestamp;
+      *next_timestamp = at(i).timestamp;
       return kOK;
     }
   }
@@ -149,7 +140,7 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
 }
 
 const Packet* PacketBuffer::PeekNextPacket() const {
-  return buffer_.empty() ? nullptr : &buffer_.front();
+  return Empty() ? nullptr : &front();
 }
 
 absl::optional<Packet> PacketBuffer::GetNextPacket() {
@@ -158,10 +149,10 @@ absl::optional<Packet> PacketBuffer::GetNextPacket() {
     return absl::nullopt;
   }
 
-  absl::optional<Packet> packet(std::move(buffer_.front()));
+  absl::optional<Packet> packet(std::move(at(0)));
   // Assert that the packet sanity checks in InsertPacket method works.
   RTC_DCHECK(!packet->empty());
-  buffer_.pop_front();
+  PopFront();
 
   return packet;
 }
@@ -171,16 +162,16 @@ int PacketBuffer::DiscardNextPacket() {
     return kBufferEmpty;
   }
   // Assert that the packet sanity checks in InsertPacket method works.
-  const Packet& packet = buffer_.front();
+  const Packet& packet = front();
   RTC_DCHECK(!packet.empty());
   LogPacketDiscarded(packet.priority.codec_level);
-  buffer_.pop_front();
+  PopFront();
   return kOK;
 }
 
 void PacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
                                      uint32_t horizon_samples) {
-  buffer_.remove_if([this, timestamp_limit, horizon_samples](const Packet& p) {
+  RemoveIf([this, timestamp_limit, horizon_samples](const Packet& p) {
     if (timestamp_limit == p.timestamp ||
         !IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples)) {
       return false;
@@ -195,7 +186,7 @@ void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit) {
 }
 
 void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type) {
-  buffer_.remove_if([this, payload_type](const Packet& p) {
+  RemoveIf([this, payload_type](const Packet& p) {
     if (p.payload_type != payload_type) {
       return false;
     }
@@ -205,44 +196,55 @@ void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type) {
 }
 
 size_t PacketBuffer::NumPacketsInBuffer() const {
-  return buffer_.size();
+  return size_;
 }
 
 size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
-  size_t num_samples = 0;
-  size_t last_duration = last_decoded_length;
-  for (const Packet& packet : buffer_) {
-    if (packet.frame) {
-      // TODO(hlundin): Verify that it's fine to count all packets and remove
-      // this check.
-      if (packet.priority != Packet::Priority(0, 0)) {
-        continue;
+  if (!sample_count_) {
+    SampleCount count;
+    absl::optional<size_t> last_duration;
+    for (size_t i = 0; i < size_; ++i) {
+      const Packet& packet = at(i);
+      if (packet.frame) {
+        // TODO(hlundin): Verify that it's fine to count all packets and remove
+        // this check.
+        if (packet.priority != Packet::Priority(0, 0)) {
+          continue;
+        }
+        size_t duration = packet.frame->Duration();
+        if (duration > 0) {
+          // Save the most up-to-date (valid) duration.
+          last_duration = duration;
+        }
       }
-      size_t duration = packet.frame->Duration();
-      if (duration > 0) {
-        last_duration = duration;  // Save the most up-to-date (valid) duration.
+      if (last_duration) {
+        count.later_samples += *last_duration;
+      } else {
+        ++count.leading_packets;
       }
     }
-    num_samples += last_duration;
+    sample_count_ = count;
   }
-  return num_samples;
+  return sample_count_->leading_packets * last_decoded_length +
+         sample_count_->later_samples;
 }
 
 size_t PacketBuffer::GetSpanSamples(size_t last_decoded_length,
                                     size_t sample_rate,
                                     bool count_waiting_time) const {
-  if (buffer_.size() == 0) {
+  if (Empty()) {
     return 0;
   }
 
-  size_t span = buffer_.back().timestamp - buffer_.front().timestamp;
+  const Packet& last_packet = back();
+  size_t span = last_packet.timestamp - front().timestamp;
   size_t waiting_time_samples = rtc::dchecked_cast<size_t>(
-      buffer_.back().waiting_time->ElapsedMs() * (sample_rate / 1000));
+      last_packet.waiting_time->ElapsedMs() * (sample_rate / 1000));
   if (count_waiting_time) {
     span += waiting_time_samples;
-  } else if (buffer_.back().frame && buffer_.back().frame->Duration() > 0) {
-    size_t duration = buffer_.back().frame->Duration();
-    if (buffer_.back().frame->IsDtxPacket()) {
+  } else if (last_packet.frame && last_packet.frame->Duration() > 0) {
+    size_t duration = last_packet.frame->Duration();
+    if (last_packet.frame->IsDtxPacket()) {
       duration = std::max(duration, waiting_time_samples);
     }
     span += duration;
@@ -255,7 +257,8 @@ size_t PacketBuffer::GetSpanSamples(size_t last_decoded_length,
 bool PacketBuffer::ContainsDtxOrCngPacket(
     const DecoderDatabase* decoder_database) const {
   RTC_DCHECK(decoder_database);
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = at(i);
     if ((packet.frame && packet.frame->IsDtxPacket()) ||
         decoder_database->IsComfortNoise(packet.payload_type)) {
       return true;
@@ -272,4 +275,66 @@ void PacketBuffer::LogPacketDiscarded(int codec_level) {
   }
 }
 
+void PacketBuffer::PopFront() {
+  RTC_DCHECK_GT(size_, 0);
+  // Release the payload and frame of the packet, but keep the slot.
+  at(0) = Packet();
+  first_ = (first_ + 1) % slots_.size();
+  --size_;
+  sample_count_ = absl::nullopt;
+}
+
+void PacketBuffer::Insert(size_t index, Packet&& packet) {
+  RTC_DCHECK_LE(index, size_);
+  if (size_ == slots_.size()) {
+    const size_t num_slots = std::max(
+        size_ + 1, std::min(std::max(2 * slots_.size(), kMinNumberOfSlots),
+                            max_number_of_packets_));
+    std::vector<Packet> slots(num_slots);
+    for (size_t i = 0; i < size_; ++i) {
+      slots[i] = std::move(at(i));
+    }
+    slots_.swap(slots);
+    first_ = 0;
+  }
+  if (index == 0 && size_ > 0) {
+    first_ = (first_ + slots_.size() - 1) % slots_.size();
+  } else {
+    for (size_t i = size_; i > index; --i) {
+      at(i) = std::move(at(i - 1));
+    }
+  }
+  at(index) = std::move(packet);
+  ++size_;
+  sample_count_ = absl::nullopt;
+}
+
+template <typename Predicate>
+void PacketBuffer::RemoveIf(Predicate predicate) {
+  size_t kept = 0;
+  for (size_t i = 0; i < size_; ++i) {
+    if (predicate(at(i))) {
+      continue;
+    }
+    if (kept != i) {
+      at(kept) = std::move(at(i));
+    }
+    ++kept;
+  }
+  for (size_t i = kept; i < size_; ++i) {
+    at(i) = Packet();
+  }
+  size_ = kept;
+  sample_count_ = absl::nullopt;
+}
+
+void PacketBuffer::Clear() {
+  for (size_t i = 0; i < size_; ++i) {
+    at(i) = Packet();
+  }
+  first_ = 0;
+  size_ = 0;
+  sample_count_ = absl::nullopt;
+}
+
 }  // namespace webrtc
@@ -11,6 +11,11 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/packet.h"
@@ -22,7 +27,10 @@ class DecoderDatabase;
 class StatisticsCalculator;
 class TickTimer;
 
-// This is the actual buffer holding the packets before decoding.
+// This is the actual buffer holding the packets before decoding. The packets
+// are kept sorted by timestamp in a ring buffer, which grows up to the maximum
+// number of packets and is then reused, so that no memory is allocated for the
+// buffer itself in steady state.
 class PacketBuffer {
  public:
   enum BufferReturnCodes {
@@ -132,10 +140,38 @@ class PacketBuffer {
   }
 
  private:
+  // Sample counts cached for NumSamplesInBuffer(). The packets before the
+  // first primary packet with a known duration are counted with the last
+  // decoded length, and `later_samples` holds the count of the rest.
+  struct SampleCount {
+    size_t leading_packets = 0;
+    size_t later_samples = 0;
+  };
+
   void LogPacketDiscarded(int codec_level);
 
+  // Returns the packet at `index`, counted from the first packet.
+  Packet& at(size_t index) {
+    return slots_[(first_ + index) % slots_.size()];
+  }
+  const Packet& at(size_t index) const {
+    return slots_[(first_ + index) % slots_.size()];
+  }
+  const Packet& front() const { return at(0); }
+  const Packet& back() const { return at(size_ - 1); }
+  void PopFront();
+  void Insert(size_t index, Packet&& packet);
+  // Removes the packets for which `predicate` returns true, keeping the order
+  // of the others.
+  template <typename Predicate>
+  void RemoveIf(Predicate predicate);
+  void Clear();
+
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  std::vector<Packet> slots_;
+  size_t first_ = 0;
+  size_t size_ = 0;
+  mutable absl::optional<SampleCount> sample_count_;
   const TickTimer* tick_timer_;
   StatisticsCalculator* stats_;
 };
@@ -503,6 +503,93 @@ TEST(PacketBuffer, ComparePackets) {
   EXPECT_TRUE(d >= b);
 }
 
+// Keeps a sliding window of packets in the buffer, with every other packet
+// arriving late, so that packets are inserted at both ends and in the middle
+// while the ring buffer wraps around many times.
+TEST(PacketBuffer, SlidingWindowWithReordering) {
+  TickTimer tick_timer;
+  StrictMock<MockStatisticsCalculator> mock_stats;
+  PacketBuffer buffer(100, &tick_timer, &mock_stats);  // 100 packets.
+  const uint32_t start_ts = 0xFFFFF000;  // Wraps around during the test.
+  const uint32_t ts_increment = 960;
+  PacketGenerator gen(0, start_ts, 0, ts_increment);
+  const int payload_len = 10;
+
+  uint32_t next_ts = start_ts;
+  for (int i = 0; i < 500; i += 2) {
+    Packet first = gen.NextPacket(payload_len, nullptr);
+    Packet second = gen.NextPacket(payload_len, nullptr);
+    EXPECT_EQ(PacketBuffer::kOK, buffer.InsertPacket(std::move(second)));
+    EXPECT_EQ(PacketBuffer::kOK, buffer.InsertPacket(std::move(first)));
+    if (buffer.NumPacketsInBuffer() < 20) {
+      continue;
+    }
+    for (int j = 0; j < 2; ++j) {
+      const absl::optional<Packet> packet = buffer.GetNextPacket();
+      ASSERT_TRUE(packet);
+      EXPECT_EQ(next_ts, packet->timestamp);
+      next_ts += ts_increment;
+    }
+  }
+  EXPECT_EQ(18u, buffer.NumPacketsInBuffer());
+  while (absl::optional<Packet> packet = buffer.GetNextPacket()) {
+    EXPECT_EQ(next_ts, packet->timestamp);
+    next_ts += ts_increment;
+  }
+  EXPECT_EQ(gen.ts_, next_ts);
+}
+
+TEST(PacketBuffer, NumSamplesInBuffer) {
+  constexpr size_t kFrameSizeSamples = 960;
+  constexpr size_t kLastDecodedSizeSamples = 480;
+  TickTimer tick_timer;
+  StrictMock<MockStatisticsCalculator> mock_stats;
+  PacketBuffer buffer(10, &tick_timer, &mock_stats);
+  PacketGenerator gen(0, 0, 0, kFrameSizeSamples);
+  auto create_frame = [](size_t duration) {
+    auto frame = std::make_unique<MockEncodedAudioFrame>();
+    EXPECT_CALL(*frame, Duration()).WillRepeatedly(Return(duration));
+    return frame;
+  };
+
+  EXPECT_EQ(0u, buffer.NumSamplesInBuffer(kLastDecodedSizeSamples));
+  // Packets without a known duration are counted with the last known
+  // duration, which is the last decoded length until there is a packet with
+  // a known duration.
+  EXPECT_EQ(PacketBuffer::kOK,
+            buffer.InsertPacket(gen.NextPacket(10, nullptr)));
+  EXPECT_EQ(PacketBuffer::kOK,
+            buffer.InsertPacket(gen.NextPacket(10, create_frame(0))));
+  EXPECT_EQ(2 * kLastDecodedSizeSamples,
+            buffer.NumSamplesInBuffer(kLastDecodedSizeSamples));
+  EXPECT_EQ(2 * kFrameSizeSamples,
+            buffer.NumSamplesInBuffer(kFrameSizeSamples));
+
+  EXPECT_EQ(PacketBuffer::kOK, buffer.InsertPacket(gen.NextPacket(
+                                   10, create_frame(kFrameSizeSamples))));
+  EXPECT_EQ(PacketBuffer::kOK,
+            buffer.InsertPacket(gen.NextPacket(10, nullptr)));
+  EXPECT_EQ(2 * kLastDecodedSizeSamples + 2 * kFrameSizeSamples,
+            buffer.NumSamplesInBuffer(kLastDecodedSizeSamples));
+
+  // Secondary packets are not counted.
+  Packet secondary = gen.NextPacket(10, create_frame(kFrameSizeSamples));
+  secondary.priority = Packet::Priority(1, 0);
+  EXPECT_EQ(PacketBuffer::kOK, buffer.InsertPacket(std::move(secondary)));
+  EXPECT_EQ(2 * kLastDecodedSizeSamples + 2 * kFrameSizeSamples,
+            buffer.NumSamplesInBuffer(kLastDecodedSizeSamples));
+
+  // The count follows packets being removed.
+  EXPECT_CALL(mock_stats, PacketsDiscarded(1)).Times(2);
+  EXPECT_EQ(PacketBuffer::kOK, buffer.DiscardNextPacket());
+  EXPECT_EQ(PacketBuffer::kOK, buffer.DiscardNextPacket());
+  EXPECT_EQ(2 * kFrameSizeSamples,
+            buffer.NumSamplesInBuffer(kLastDecodedSizeSamples));
+  EXPECT_TRUE(buffer.GetNextPacket());
+  EXPECT_EQ(kLastDecodedSizeSamples,
+            buffer.NumSamplesInBuffer(kLastDecodedSizeSamples));
+}
+
 TEST(PacketBuffer, GetSpanSamples) {
   constexpr size_t kFrameSizeSamples = 10;
   constexpr int kPayloadSizeBytes = 1;  // Does not matter to this test;
@@ -9,6 +9,7 @@
  */
 
 #include "absl/flags/flag.h"
+#include "absl/strings/string_view.h"
 #include "api/test/metrics/global_metrics_logger_and_exporter.h"
 #include "api/test/metrics/metric.h"
 #include "modules/audio_coding/neteq/tools/neteq_performance_test.h"
@@ -22,39 +23,53 @@ using ::webrtc::test::GetGlobalMetricsLogger;
 using ::webrtc::test::ImprovementDirection;
 using ::webrtc::test::Unit;
 
-// Runs a test with 10% packet losses and 10% clock drift, to exercise
-// both loss concealment and time-stretching code.
-TEST(NetEqPerformanceTest, 10_Pl_10_Drift) {
+// Runs a simulation with every `loss_period`th packet lost and the given
+// clock drift, and logs both the total runtime and the runtime per 10 ms of
+// output audio.
+void RunAndLogMetrics(int loss_period,
+                      double drift_factor,
+                      absl::string_view name) {
   const int kSimulationTimeMs = 10000000;
   const int kQuickSimulationTimeMs = 100000;
-  const int kLossPeriod = 10;  // Drop every 10th packet.
-  const double kDriftFactor = 0.1;
+  const int simulation_time_ms = absl::GetFlag(FLAGS_webrtc_quick_perf_test)
+                                     ? kQuickSimulationTimeMs
+                                     : kSimulationTimeMs;
   int64_t runtime = test::NetEqPerformanceTest::Run(
-      absl::GetFlag(FLAGS_webrtc_quick_perf_test) ? kQuickSimulationTimeMs
-                                                  : kSimulationTimeMs,
-      kLossPeriod, kDriftFactor);
+      simulation_time_ms, loss_period, drift_factor);
   ASSERT_GT(runtime, 0);
   GetGlobalMetricsLogger()->LogSingleValueMetric(
-      "neteq_performance", "10_pl_10_drift", runtime, Unit::kMilliseconds,
+      "neteq_performance", name, runtime, Unit::kMilliseconds,
       ImprovementDirection::kNeitherIsBetter);
+  GetGlobalMetricsLogger()->LogSingleValueMetric(
+      "neteq_performance_per_10ms", name,
+      10.0 * runtime / simulation_time_ms, Unit::kMilliseconds,
+      ImprovementDirection::kSmallerIsBetter);
+}
+
+// Runs a test with 10% packet losses and 10% clock drift, to exercise
+// both loss concealment and time-stretching code.
+TEST(NetEqPerformanceTest, 10_Pl_10_Drift) {
+  RunAndLogMetrics(/*loss_period=*/10, /*drift_factor=*/0.1,
+                   "10_pl_10_drift");
 }
 
 // Runs a test with neither packet losses nor clock drift, to put
 // emphasis on the "good-weather" code path, which is presumably much
 // more lightweight.
 TEST(NetEqPerformanceTest, 0_Pl_0_Drift) {
-  const int kSimulationTimeMs = 10000000;
-  const int kQuickSimulationTimeMs = 100000;
-  const int kLossPeriod = 0;        // No losses.
-  const double kDriftFactor = 0.0;  // No clock drift.
-  int64_t runtime = test::NetEqPerformanceTest::Run(
-      absl::GetFlag(FLAGS_webrtc_quick_perf_test) ? kQuickSimulationTimeMs
-                                                  : kSimulationTimeMs,
-      kLossPeriod, kDriftFactor);
-  ASSERT_GT(runtime, 0);
-  GetGlobalMetricsLogger()->LogSingleValueMetric(
-      "neteq_performance", "0_pl_0_drift", runtime, Unit::kMilliseconds,
-      ImprovementDirection::kNeitherIsBetter);
+  RunAndLogMetrics(/*loss_period=*/0, /*drift_factor=*/0.0, "0_pl_0_drift");
+}
+
+// Runs a test where every other packet is lost, to put emphasis on the
+// expand and merge code.
+TEST(NetEqPerformanceTest, 50_Pl_0_Drift) {
+  RunAndLogMetrics(/*loss_period=*/2, /*drift_factor=*/0.0, "50_pl_0_drift");
+}
+
+// Runs a test with 30% clock drift and no losses, to put emphasis on the
+// accelerate and preemptive expand code.
+TEST(NetEqPerformanceTest, 0_Pl_30_Drift) {
+  RunAndLogMetrics(/*loss_period=*/0, /*drift_factor=*/0.3, "0_pl_30_drift");
 }
 
 }  // namespace
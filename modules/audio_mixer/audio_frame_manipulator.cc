@@ -13,23 +13,12 @@
 #include "audio/utility/audio_frame_operations.h"
 #include "audio/utility/channel_mixer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_conversions.h"
 
 namespace webrtc {
 
 uint32_t AudioMixerCalculateEnergy(const AudioFrame& audio_frame) {
-  if (audio_frame.muted()) {
-    return 0;
-  }
-
-  uint32_t energy = 0;
-  const int16_t* frame_data = audio_frame.data();
-  for (size_t position = 0;
-       position < audio_frame.samples_per_channel_ * audio_frame.num_channels_;
-       position++) {
-    // TODO(aleloi): This can overflow. Convert to floats.
-    energy += frame_data[position] * frame_data[position];
-  }
-  return energy;
+  return rtc::saturated_cast<uint32_t>(audio_frame.sample_stats().sum_square);
 }
 
 void Ramp(float start_gain, float target_gain, AudioFrame* audio_frame) {
@@ -32,6 +32,16 @@ struct AudioMixerImpl::SourceStatus {
 
   // A frame that will be passed to audio_source->GetAudioFrameWithInfo.
   AudioFrame audio_frame;
+
+  // Number of calls to Mix() to skip before the source is asked for audio
+  // again, while it's muted.
+  int mix_calls_until_poll = 0;
+
+  // Set up when the source is first mixed by MixWithMixMinus().
+  std::unique_ptr<AudioFrame> mix_minus_frame;
+  std::unique_ptr<Limiter> mix_minus_limiter;
+  // Whether `mix_minus_frame` holds the mix-minus of the last mix.
+  bool has_mix_minus = false;
 };
 
 namespace {
@@ -53,19 +63,29 @@ struct AudioMixerImpl::HelperContainers {
   void resize(size_t size) {
     audio_to_mix.resize(size);
     preferred_rates.resize(size);
+    mixed_sources.resize(size);
+    mix_minus_frames.resize(size);
+    mix_minus_limiters.resize(size);
   }
 
   std::vector<AudioFrame*> audio_to_mix;
   std::vector<int> preferred_rates;
+  std::vector<SourceStatus*> mixed_sources;
+  std::vector<AudioFrame*> mix_minus_frames;
+  std::vector<Limiter*> mix_minus_limiters;
 };
 
 AudioMixerImpl::AudioMixerImpl(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
-    bool use_limiter)
+    bool use_limiter,
+    int muted_source_poll_interval)
     : output_rate_calculator_(std::move(output_rate_calculator)),
+      muted_source_poll_interval_(muted_source_poll_interval),
       audio_source_list_(),
       helper_containers_(std::make_unique<HelperContainers>()),
-      frame_combiner_(use_limiter) {}
+      frame_combiner_(use_limiter) {
+  RTC_DCHECK_GE(muted_source_poll_interval_, 1);
+}
 
 AudioMixerImpl::~AudioMixerImpl() {}
 
@@ -77,14 +97,38 @@ rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create() {
 
 rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
-    bool use_limiter) {
+    bool use_limiter,
+    int muted_source_poll_interval) {
   return rtc::make_ref_counted<AudioMixerImpl>(
-      std::move(output_rate_calculator), use_limiter);
+      std::move(output_rate_calculator), use_limiter,
+      muted_source_poll_interval);
 }
 
 void AudioMixerImpl::Mix(size_t number_of_channels,
                          AudioFrame* audio_frame_for_mixing) {
   TRACE_EVENT0("webrtc", "AudioMixerImpl::Mix");
+  MixSources(number_of_channels, /*with_mix_minus=*/false,
+             audio_frame_for_mixing);
+}
+
+void AudioMixerImpl::MixWithMixMinus(size_t number_of_channels,
+                                     AudioFrame* audio_frame_for_mixing) {
+  TRACE_EVENT0("webrtc", "AudioMixerImpl::MixWithMixMinus");
+  MixSources(number_of_channels, /*with_mix_minus=*/true,
+             audio_frame_for_mixing);
+}
+
+const AudioFrame* AudioMixerImpl::GetMixMinusFrame(
+    const Source* audio_source) const {
+  MutexLock lock(&mutex_);
+  const auto iter = FindSourceInList(audio_source, &audio_source_list_);
+  RTC_DCHECK(iter != audio_source_list_.end()) << "Source not present in mixer";
+  return (*iter)->has_mix_minus ? (*iter)->mix_minus_frame.get() : nullptr;
+}
+
+void AudioMixerImpl::MixSources(size_t number_of_channels,
+                                bool with_mix_minus,
+                                AudioFrame* audio_frame_for_mixing) {
   RTC_DCHECK(number_of_channels >= 1);
   MutexLock lock(&mutex_);
 
@@ -100,9 +144,38 @@ void AudioMixerImpl::Mix(size_t number_of_channels,
       rtc::ArrayView<const int>(helper_containers_->preferred_rates.data(),
                                 number_of_streams));
 
-  frame_combiner_.Combine(GetAudioFromSources(output_frequency),
-                          number_of_channels, output_frequency,
-                          number_of_streams, audio_frame_for_mixing);
+  for (auto& source_and_status : audio_source_list_) {
+    source_and_status->has_mix_minus = false;
+  }
+  rtc::ArrayView<AudioFrame* const> audio_to_mix =
+      GetAudioFromSources(output_frequency);
+  if (!with_mix_minus) {
+    frame_combiner_.Combine(audio_to_mix, number_of_channels, output_frequency,
+                            number_of_streams, audio_frame_for_mixing);
+    return;
+  }
+
+  for (size_t i = 0; i < audio_to_mix.size(); ++i) {
+    SourceStatus* source_status = helper_containers_->mixed_sources[i];
+    if (!source_status->mix_minus_frame) {
+      source_status->mix_minus_frame = std::make_unique<AudioFrame>();
+      source_status->mix_minus_limiter =
+          frame_combiner_.CreateMixMinusLimiter();
+    }
+    source_status->has_mix_minus = true;
+    helper_containers_->mix_minus_frames[i] =
+        source_status->mix_minus_frame.get();
+    helper_containers_->mix_minus_limiters[i] =
+        source_status->mix_minus_limiter.get();
+  }
+  frame_combiner_.CombineWithMixMinus(
+      audio_to_mix, number_of_channels, output_frequency, number_of_streams,
+      audio_frame_for_mixing,
+      rtc::ArrayView<AudioFrame* const>(
+          helper_containers_->mix_minus_frames.data(), audio_to_mix.size()),
+      rtc::ArrayView<Limiter* const>(
+          helper_containers_->mix_minus_limiters.data(),
+          audio_to_mix.size()));
 }
 
 bool AudioMixerImpl::AddSource(Source* audio_source) {
@@ -129,6 +202,10 @@ rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
     int output_frequency) {
   int audio_to_mix_count = 0;
   for (auto& source_and_status : audio_source_list_) {
+    if (source_and_status->mix_calls_until_poll > 0) {
+      --source_and_status->mix_calls_until_poll;
+      continue;
+    }
     const auto audio_frame_info =
         source_and_status->audio_source->GetAudioFrameWithInfo(
             output_frequency, &source_and_status->audio_frame);
@@ -138,8 +215,12 @@ rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
             << "failed to GetAudioFrameWithInfo() from source";
         break;
       case Source::AudioFrameInfo::kMuted:
+        source_and_status->mix_calls_until_poll =
+            muted_source_poll_interval_ - 1;
         break;
       case Source::AudioFrameInfo::kNormal:
+        helper_containers_->mixed_sources[audio_to_mix_count] =
+            source_and_status.get();
         helper_containers_->audio_to_mix[audio_to_mix_count++] =
             &source_and_status->audio_frame;
     }
@@ -37,9 +37,16 @@ class AudioMixerImpl : public AudioMixer {
 
   static rtc::scoped_refptr<AudioMixerImpl> Create();
 
+  // Sources which returned kMuted on the last call to
+  // GetAudioFrameWithInfo() are only asked for audio again on one in
+  // `muted_source_poll_interval` calls to Mix(). This saves pulling audio from
+  // the sources of a call with many muted participants, at the cost of
+  // delaying by up to `muted_source_poll_interval` - 1 frames the audio of a
+  // source which becomes unmuted.
   static rtc::scoped_refptr<AudioMixerImpl> Create(
       std::unique_ptr<OutputRateCalculator> output_rate_calculator,
-      bool use_limiter);
+      bool use_limiter,
+      int muted_source_poll_interval = 1);
 
   ~AudioMixerImpl() override;
 
@@ -54,16 +61,39 @@ class AudioMixerImpl : public AudioMixer {
            AudioFrame* audio_frame_for_mixing) override
       RTC_LOCKS_EXCLUDED(mutex_);
 
+  // Mixes like Mix(), and also makes the mix-minus of every source whose audio
+  // is mixed, i.e. the mix of all other sources, as is sent back to the
+  // participants of a conference. The audio of the sources is summed once and
+  // each source's audio is subtracted from the sum, which is far cheaper than
+  // mixing for each participant. Each mix-minus is limited on its own.
+  void MixWithMixMinus(size_t number_of_channels,
+                       AudioFrame* audio_frame_for_mixing)
+      RTC_LOCKS_EXCLUDED(mutex_);
+
+  // Returns the mix-minus of `audio_source` made by the last call to
+  // MixWithMixMinus(), or null if its audio wasn't mixed, in which case it
+  // hears the full mix. The frame stays valid until the next mix or until the
+  // source is removed.
+  const AudioFrame* GetMixMinusFrame(const Source* audio_source) const
+      RTC_LOCKS_EXCLUDED(mutex_);
+
  protected:
   AudioMixerImpl(std::unique_ptr<OutputRateCalculator> output_rate_calculator,
-                 bool use_limiter);
+                 bool use_limiter,
+                 int muted_source_poll_interval = 1);
 
  private:
   struct HelperContainers;
 
+  void MixSources(size_t number_of_channels,
+                  bool with_mix_minus,
+                  AudioFrame* audio_frame_for_mixing)
+      RTC_LOCKS_EXCLUDED(mutex_);
+
   void UpdateSourceCountStats() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
-  // Fetches audio frames to mix from sources.
+  // Fetches audio frames to mix from sources. The sources of the frames are
+  // put in `helper_containers_->mixed_sources`.
   rtc::ArrayView<AudioFrame* const> GetAudioFromSources(int output_frequency)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
@@ -73,6 +103,7 @@ class AudioMixerImpl : public AudioMixer {
   mutable Mutex mutex_;
 
   std::unique_ptr<OutputRateCalculator> output_rate_calculator_;
+  const int muted_source_poll_interval_;
 
   // List of all audio sources.
   std::vector<std::unique_ptr<SourceStatus>> audio_source_list_
@@ -12,6 +12,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <limits>
 #include <memory>
@@ -353,6 +354,36 @@ TEST(AudioMixer, NoLimiterBasicApiCalls) {
   mixer->Mix(1, &frame_for_mixing);
 }
 
+TEST(AudioMixer, PollsMutedSourcesAtGivenInterval) {
+  constexpr int kMutedSourcePollInterval = 3;
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      kMutedSourcePollInterval);
+  MockMixerAudioSource muted_source;
+  MockMixerAudioSource unmuted_source;
+  muted_source.set_fake_info(AudioMixer::Source::AudioFrameInfo::kMuted);
+  ResetFrame(muted_source.fake_frame());
+  ResetFrame(unmuted_source.fake_frame());
+  EXPECT_TRUE(mixer->AddSource(&muted_source));
+  EXPECT_TRUE(mixer->AddSource(&unmuted_source));
+
+  constexpr int kNumMixCalls = 2 * kMutedSourcePollInterval;
+  EXPECT_CALL(muted_source, GetAudioFrameWithInfo(_, _)).Times(2);
+  EXPECT_CALL(unmuted_source, GetAudioFrameWithInfo(_, _))
+      .Times(2 * kNumMixCalls);
+  for (int i = 0; i < kNumMixCalls; ++i) {
+    mixer->Mix(1, &frame_for_mixing);
+  }
+  ::testing::Mock::VerifyAndClearExpectations(&muted_source);
+
+  // Once the source is found to be unmuted, it's polled on every call.
+  muted_source.set_fake_info(AudioMixer::Source::AudioFrameInfo::kNormal);
+  EXPECT_CALL(muted_source, GetAudioFrameWithInfo(_, _)).Times(kNumMixCalls);
+  for (int i = 0; i < kNumMixCalls; ++i) {
+    mixer->Mix(1, &frame_for_mixing);
+  }
+}
+
 TEST(AudioMixer, AnyRateIsPossibleWithNoLimiter) {
   // No APM limiter means no AudioProcessing::NativeRate restriction
   // on mixing rate. The rate has to be divisible by 100 since we use
@@ -479,6 +510,95 @@ TEST(AudioMixer, ShouldIncludeRtpPacketInfoFromAllMixedSources) {
   EXPECT_THAT(frame_for_mixing.packet_infos_, UnorderedElementsAre(p0, p1, p2));
 }
 
+TEST(AudioMixer, MixMinusLeavesOutEachSource) {
+  constexpr int kNumSources = 3;
+  const int16_t kValues[kNumSources] = {100, 200, 400};
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/false);
+  MockMixerAudioSource sources[kNumSources];
+  for (int i = 0; i < kNumSources; ++i) {
+    ResetFrame(sources[i].fake_frame());
+    std::fill_n(sources[i].fake_frame()->mutable_data(),
+                sources[i].fake_frame()->samples_per_channel_, kValues[i]);
+    sources[i].set_packet_infos(RtpPacketInfos(
+        {RtpPacketInfo(/*ssrc=*/i, {}, 0, Timestamp::Millis(0))}));
+    mixer->AddSource(&sources[i]);
+  }
+
+  mixer->MixWithMixMinus(/*number_of_channels=*/1, &frame_for_mixing);
+
+  EXPECT_EQ(frame_for_mixing.data()[0], 700);
+  EXPECT_EQ(frame_for_mixing.packet_infos_.size(), 3u);
+  for (int i = 0; i < kNumSources; ++i) {
+    const AudioFrame* mix_minus = mixer->GetMixMinusFrame(&sources[i]);
+    ASSERT_NE(mix_minus, nullptr);
+    EXPECT_EQ(mix_minus->samples_per_channel_,
+              frame_for_mixing.samples_per_channel_);
+    EXPECT_EQ(mix_minus->data()[0], 700 - kValues[i]);
+    EXPECT_EQ(mix_minus->data()[mix_minus->samples_per_channel_ - 1],
+              700 - kValues[i]);
+    ASSERT_EQ(mix_minus->packet_infos_.size(), 2u);
+    for (const RtpPacketInfo& packet_info : mix_minus->packet_infos_) {
+      EXPECT_NE(packet_info.ssrc(), static_cast<uint32_t>(i));
+    }
+  }
+}
+
+TEST(AudioMixer, LimitedMixMinusMatchesMixOfOtherSources) {
+  constexpr int kNumSources = 3;
+  const auto mixer = AudioMixerImpl::Create();
+  // Mixes all sources but the first one.
+  const auto other_mixer = AudioMixerImpl::Create();
+  MockMixerAudioSource sources[kNumSources];
+  for (int i = 0; i < kNumSources; ++i) {
+    AudioFrame* frame = sources[i].fake_frame();
+    ResetFrame(frame);
+    // Loud enough for the mixes to be limited.
+    for (size_t k = 0; k < frame->samples_per_channel_; ++k) {
+      frame->mutable_data()[k] = (k % 2 == 0 ? 1 : -1) * 10000 * (i + 1);
+    }
+    mixer->AddSource(&sources[i]);
+    if (i > 0) {
+      other_mixer->AddSource(&sources[i]);
+    }
+  }
+
+  AudioFrame other_mix;
+  // The limiters adapt over a number of frames.
+  for (int n = 0; n < 10; ++n) {
+    mixer->MixWithMixMinus(/*number_of_channels=*/1, &frame_for_mixing);
+    other_mixer->Mix(/*number_of_channels=*/1, &other_mix);
+    const AudioFrame* mix_minus = mixer->GetMixMinusFrame(&sources[0]);
+    ASSERT_NE(mix_minus, nullptr);
+    EXPECT_EQ(0, memcmp(mix_minus->data(), other_mix.data(),
+                        other_mix.samples_per_channel_ * sizeof(int16_t)));
+  }
+}
+
+TEST(AudioMixer, NoMixMinusForSourcesNotMixed) {
+  const auto mixer = AudioMixerImpl::Create();
+  MockMixerAudioSource source;
+  MockMixerAudioSource muted_source;
+  ResetFrame(source.fake_frame());
+  ResetFrame(muted_source.fake_frame());
+  muted_source.set_fake_info(AudioMixer::Source::AudioFrameInfo::kMuted);
+  mixer->AddSource(&source);
+  mixer->AddSource(&muted_source);
+
+  mixer->MixWithMixMinus(/*number_of_channels=*/1, &frame_for_mixing);
+  // The muted source hears the full mix, and the only source that is mixed
+  // hears silence.
+  EXPECT_EQ(mixer->GetMixMinusFrame(&muted_source), nullptr);
+  const AudioFrame* mix_minus = mixer->GetMixMinusFrame(&source);
+  ASSERT_NE(mix_minus, nullptr);
+  EXPECT_TRUE(std::all_of(
+      mix_minus->data(), mix_minus->data() + mix_minus->samples_per_channel_,
+      [](int16_t sample) { return sample == 0; }));
+
+  mixer->Mix(/*number_of_channels=*/1, &frame_for_mixing);
+  EXPECT_EQ(mixer->GetMixMinusFrame(&source), nullptr);
+}
+
 class HighOutputRateCalculator : public OutputRateCalculator {
  public:
   static const int kDefaultFrequency = 76000;
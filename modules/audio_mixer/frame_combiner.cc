@@ -97,25 +97,63 @@ void MixToFloatFrame(rtc::ArrayView<const AudioFrame* const> mix_list,
                      MixingBuffer* mixing_buffer) {
   RTC_DCHECK_LE(samples_per_channel, FrameCombiner::kMaximumChannelSize);
   RTC_DCHECK_LE(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
-  // Clear the mixing buffer.
-  *mixing_buffer = {};
+  const size_t num_channels =
+      std::min(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t num_samples =
+      std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+  // Clear the part of the mixing buffer in use.
+  for (size_t j = 0; j < num_channels; ++j) {
+    std::fill_n((*mixing_buffer)[j].begin(), num_samples, 0.f);
+  }
 
-  // Convert to FloatS16 and mix.
-  for (size_t i = 0; i < mix_list.size(); ++i) {
-    const AudioFrame* const frame = mix_list[i];
+  // Convert to FloatS16 and mix. The frames are read in order, and the loops
+  // over mono frames are kept simple enough to be vectorized.
+  for (const AudioFrame* frame : mix_list) {
     const int16_t* const frame_data = frame->data();
-    for (size_t j = 0; j < std::min(number_of_channels,
-                                    FrameCombiner::kMaximumNumberOfChannels);
-         ++j) {
-      for (size_t k = 0; k < std::min(samples_per_channel,
-                                      FrameCombiner::kMaximumChannelSize);
-           ++k) {
-        (*mixing_buffer)[j][k] += frame_data[number_of_channels * k + j];
+    if (number_of_channels == 1) {
+      float* const channel = (*mixing_buffer)[0].data();
+      for (size_t k = 0; k < num_samples; ++k) {
+        channel[k] += frame_data[k];
+      }
+      continue;
+    }
+    for (size_t k = 0; k < num_samples; ++k) {
+      const int16_t* const interleaved = &frame_data[number_of_channels * k];
+      for (size_t j = 0; j < num_channels; ++j) {
+        (*mixing_buffer)[j][k] += interleaved[j];
       }
     }
   }
 }
 
+// Computes into `mix_minus_buffer` the mix in `mixing_buffer` without `frame`,
+// which is one of the frames that were mixed.
+void SubtractFromFloatFrame(const MixingBuffer& mixing_buffer,
+                            const AudioFrame& frame,
+                            size_t samples_per_channel,
+                            size_t number_of_channels,
+                            MixingBuffer* mix_minus_buffer) {
+  const size_t num_channels =
+      std::min(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t num_samples =
+      std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+  const int16_t* const frame_data = frame.data();
+  if (number_of_channels == 1) {
+    const float* const mix = mixing_buffer[0].data();
+    float* const channel = (*mix_minus_buffer)[0].data();
+    for (size_t k = 0; k < num_samples; ++k) {
+      channel[k] = mix[k] - frame_data[k];
+    }
+    return;
+  }
+  for (size_t k = 0; k < num_samples; ++k) {
+    const int16_t* const interleaved = &frame_data[number_of_channels * k];
+    for (size_t j = 0; j < num_channels; ++j) {
+      (*mix_minus_buffer)[j][k] = mixing_buffer[j][k] - interleaved[j];
+    }
+  }
+}
+
 void RunLimiter(AudioFrameView<float> mixing_buffer_view, Limiter* limiter) {
   const size_t sample_rate = mixing_buffer_view.samples_per_channel() * 1000 /
                              AudioMixerImpl::kFrameDurationInMs;
@@ -130,11 +168,16 @@ void InterleaveToAudioFrame(AudioFrameView<const float> mixing_buffer_view,
   const size_t number_of_channels = mixing_buffer_view.num_channels();
   const size_t samples_per_channel = mixing_buffer_view.samples_per_channel();
   int16_t* const mixing_data = audio_frame_for_mixing->mutable_data();
-  // Put data in the result frame.
-  for (size_t i = 0; i < number_of_channels; ++i) {
-    for (size_t j = 0; j < samples_per_channel; ++j) {
-      mixing_data[number_of_channels * j + i] =
-          FloatS16ToS16(mixing_buffer_view.channel(i)[j]);
+  if (number_of_channels == 1) {
+    FloatS16ToS16(mixing_buffer_view.channel(0).data(), samples_per_channel,
+                  mixing_data);
+    return;
+  }
+  // Put data in the result frame, which is written in order.
+  for (size_t j = 0; j < samples_per_channel; ++j) {
+    int16_t* const interleaved = &mixing_data[number_of_channels * j];
+    for (size_t i = 0; i < number_of_channels; ++i) {
+      interleaved[i] = FloatS16ToS16(mixing_buffer_view.channel(i)[j]);
     }
   }
 }
@@ -162,10 +205,40 @@ void FrameCombiner::Combine(rtc::ArrayView<AudioFrame* const> mix_list,
                             int sample_rate,
                             size_t number_of_streams,
                             AudioFrame* audio_frame_for_mixing) {
+  CombineWithMixMinus(mix_list, number_of_channels, sample_rate,
+                      number_of_streams, audio_frame_for_mixing,
+                      /*mix_minus_frames=*/{}, /*mix_minus_limiters=*/{});
+}
+
+void FrameCombiner::CombineWithMixMinus(
+    rtc::ArrayView<AudioFrame* const> mix_list,
+    size_t number_of_channels,
+    int sample_rate,
+    size_t number_of_streams,
+    AudioFrame* audio_frame_for_mixing,
+    rtc::ArrayView<AudioFrame* const> mix_minus_frames,
+    rtc::ArrayView<Limiter* const> mix_minus_limiters) {
   RTC_DCHECK(audio_frame_for_mixing);
+  RTC_DCHECK(mix_minus_frames.empty() ||
+             mix_minus_frames.size() == mix_list.size());
+  RTC_DCHECK_EQ(mix_minus_frames.size(), mix_minus_limiters.size());
 
   SetAudioFrameFields(mix_list, number_of_channels, sample_rate,
                       number_of_streams, audio_frame_for_mixing);
+  if (!mix_minus_frames.empty()) {
+    std::vector<const AudioFrame*> other_frames;
+    other_frames.reserve(mix_list.size() - 1);
+    for (size_t i = 0; i < mix_list.size(); ++i) {
+      other_frames.clear();
+      for (size_t j = 0; j < mix_list.size(); ++j) {
+        if (j != i) {
+          other_frames.push_back(mix_list[j]);
+        }
+      }
+      SetAudioFrameFields(other_frames, number_of_channels, sample_rate,
+                          number_of_streams, mix_minus_frames[i]);
+    }
+  }
 
   const size_t samples_per_channel = static_cast<size_t>(
       (sample_rate * webrtc::AudioMixerImpl::kFrameDurationInMs) / 1000);
@@ -182,6 +255,8 @@ void FrameCombiner::Combine(rtc::ArrayView<AudioFrame* const> mix_list,
   }
 
   if (number_of_streams <= 1) {
+    // A mix-minus of at most one frame is silence, which its fields already
+    // say.
     MixFewFramesWithNoLimiter(mix_list, audio_frame_for_mixing);
     return;
   }
@@ -194,6 +269,30 @@ void FrameCombiner::Combine(rtc::ArrayView<AudioFrame* const> mix_list,
   const size_t output_samples_per_channel =
       std::min(samples_per_channel, kMaximumChannelSize);
 
+  if (!mix_minus_frames.empty()) {
+    if (!mix_minus_buffer_) {
+      mix_minus_buffer_ = std::make_unique<MixingBuffer>();
+    }
+    std::array<float*, kMaximumNumberOfChannels> channel_pointers{};
+    for (size_t i = 0; i < output_number_of_channels; ++i) {
+      channel_pointers[i] = &(*mix_minus_buffer_.get())[i][0];
+    }
+    AudioFrameView<float> mix_minus_view(&channel_pointers[0],
+                                         output_number_of_channels,
+                                         output_samples_per_channel);
+    // Done before the mix is limited in place.
+    for (size_t i = 0; i < mix_list.size(); ++i) {
+      SubtractFromFloatFrame(*mixing_buffer_, *mix_list[i],
+                             samples_per_channel, number_of_channels,
+                             mix_minus_buffer_.get());
+      if (use_limiter_) {
+        RTC_DCHECK(mix_minus_limiters[i]);
+        RunLimiter(mix_minus_view, mix_minus_limiters[i]);
+      }
+      InterleaveToAudioFrame(mix_minus_view, mix_minus_frames[i]);
+    }
+  }
+
   // Put float data in an AudioFrameView.
   std::array<float*, kMaximumNumberOfChannels> channel_pointers{};
   for (size_t i = 0; i < output_number_of_channels; ++i) {
@@ -210,4 +309,11 @@ void FrameCombiner::Combine(rtc::ArrayView<AudioFrame* const> mix_list,
   InterleaveToAudioFrame(mixing_buffer_view, audio_frame_for_mixing);
 }
 
+std::unique_ptr<Limiter> FrameCombiner::CreateMixMinusLimiter() {
+  if (!use_limiter_) {
+    return nullptr;
+  }
+  return std::make_unique<Limiter>(48000, data_dumper_.get(), "AudioMixer");
+}
+
 }  // namespace webrtc
@@ -38,6 +38,24 @@ class FrameCombiner {
                size_t number_of_streams,
                AudioFrame* audio_frame_for_mixing);
 
+  // Like Combine(), and also combines into `mix_minus_frames[i]` all frames
+  // of `mix_list` except `mix_list[i]`, as is sent back to the participant
+  // that `mix_list[i]` comes from. The frames are summed once, and each
+  // mix-minus is computed by subtracting its frame from the sum.
+  // `mix_minus_limiters[i]`, created by CreateMixMinusLimiter(), limits
+  // `mix_minus_frames[i]` and must be used for the same output on every call.
+  void CombineWithMixMinus(rtc::ArrayView<AudioFrame* const> mix_list,
+                           size_t number_of_channels,
+                           int sample_rate,
+                           size_t number_of_streams,
+                           AudioFrame* audio_frame_for_mixing,
+                           rtc::ArrayView<AudioFrame* const> mix_minus_frames,
+                           rtc::ArrayView<Limiter* const> mix_minus_limiters);
+
+  // Returns the limiter for a mix-minus output, or null if this combiner
+  // doesn't use a limiter.
+  std::unique_ptr<Limiter> CreateMixMinusLimiter();
+
   // Stereo, 48 kHz, 10 ms.
   static constexpr size_t kMaximumNumberOfChannels = 8;
   static constexpr size_t kMaximumChannelSize = 48 * 10;
@@ -48,6 +66,8 @@ class FrameCombiner {
  private:
   std::unique_ptr<ApmDataDumper> data_dumper_;
   std::unique_ptr<MixingBuffer> mixing_buffer_;
+  // Allocated when first needed by CombineWithMixMinus().
+  std::unique_ptr<MixingBuffer> mix_minus_buffer_;
   Limiter limiter_;
   const bool use_limiter_;
 };
@@ -0,0 +1,176 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/audio_processing/aec3/adaptive_fir_filter.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace aec3 {
+
+// Computes and stores the frequency response of the filter.
+void ComputeFrequencyResponse_Avx512(
+    size_t num_partitions,
+    const std::vector<std::vector<FftData>>& H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
+  for (auto& H2_ch : *H2) {
+    H2_ch.fill(0.f);
+  }
+
+  const size_t num_render_channels = H[0].size();
+  RTC_DCHECK_EQ(H.size(), H2->capacity());
+  for (size_t p = 0; p < num_partitions; ++p) {
+    RTC_DCHECK_EQ(kFftLengthBy2Plus1, (*H2)[p].size());
+    auto& H2_p = (*H2)[p];
+    for (size_t ch = 0; ch < num_render_channels; ++ch) {
+      const FftData& H_p_ch = H[p][ch];
+      for (size_t j = 0; j < kFftLengthBy2; j += 16) {
+        __m512 re = _mm512_loadu_ps(&H_p_ch.re[j]);
+        __m512 re2 = _mm512_mul_ps(re, re);
+        __m512 im = _mm512_loadu_ps(&H_p_ch.im[j]);
+        re2 = _mm512_fmadd_ps(im, im, re2);
+        __m512 H2_k_j = _mm512_loadu_ps(&H2_p[j]);
+        H2_k_j = _mm512_max_ps(H2_k_j, re2);
+        _mm512_storeu_ps(&H2_p[j], H2_k_j);
+      }
+      float H2_new = H_p_ch.re[kFftLengthBy2] * H_p_ch.re[kFftLengthBy2] +
+                     H_p_ch.im[kFftLengthBy2] * H_p_ch.im[kFftLengthBy2];
+      H2_p[kFftLengthBy2] = std::max(H2_p[kFftLengthBy2], H2_new);
+    }
+  }
+}
+
+// Adapts the filter partitions.
+void AdaptPartitions_Avx512(const RenderBuffer& render_buffer,
+                            const FftData& G,
+                            size_t num_partitions,
+                            std::vector<std::vector<FftData>>* H) {
+  rtc::ArrayView<const std::vector<FftData>> render_buffer_data =
+      render_buffer.GetFftBuffer();
+  const size_t num_render_channels = render_buffer_data[0].size();
+  const size_t lim1 = std::min(
+      render_buffer_data.size() - render_buffer.Position(), num_partitions);
+  const size_t lim2 = num_partitions;
+  constexpr size_t kNumSixteenBinBands = kFftLengthBy2 / 16;
+
+  // The gain is the same for all partitions, so it's loaded only once.
+  __m512 G_re[kNumSixteenBinBands];
+  __m512 G_im[kNumSixteenBinBands];
+  for (size_t k = 0, n = 0; n < kNumSixteenBinBands; ++n, k += 16) {
+    G_re[n] = _mm512_loadu_ps(&G.re[k]);
+    G_im[n] = _mm512_loadu_ps(&G.im[k]);
+  }
+
+  size_t X_partition = render_buffer.Position();
+  size_t limit = lim1;
+  size_t p = 0;
+  do {
+    for (; p < limit; ++p, ++X_partition) {
+      for (size_t ch = 0; ch < num_render_channels; ++ch) {
+        FftData& H_p_ch = (*H)[p][ch];
+        const FftData& X = render_buffer_data[X_partition][ch];
+
+        for (size_t k = 0, n = 0; n < kNumSixteenBinBands; ++n, k += 16) {
+          const __m512 X_re = _mm512_loadu_ps(&X.re[k]);
+          const __m512 X_im = _mm512_loadu_ps(&X.im[k]);
+          const __m512 H_re = _mm512_loadu_ps(&H_p_ch.re[k]);
+          const __m512 H_im = _mm512_loadu_ps(&H_p_ch.im[k]);
+          const __m512 a = _mm512_mul_ps(X_re, G_re[n]);
+          const __m512 b = _mm512_mul_ps(X_im, G_im[n]);
+          const __m512 c = _mm512_mul_ps(X_re, G_im[n]);
+          const __m512 d = _mm512_mul_ps(X_im, G_re[n]);
+          const __m512 e = _mm512_add_ps(a, b);
+          const __m512 f = _mm512_sub_ps(c, d);
+          const __m512 g = _mm512_add_ps(H_re, e);
+          const __m512 h = _mm512_add_ps(H_im, f);
+          _mm512_storeu_ps(&H_p_ch.re[k], g);
+          _mm512_storeu_ps(&H_p_ch.im[k], h);
+        }
+
+        H_p_ch.re[kFftLengthBy2] += X.re[kFftLengthBy2] * G.re[kFftLengthBy2] +
+                                    X.im[kFftLengthBy2] * G.im[kFftLengthBy2];
+        H_p_ch.im[kFftLengthBy2] += X.re[kFftLengthBy2] * G.im[kFftLengthBy2] -
+                                    X.im[kFftLengthBy2] * G.re[kFftLengthBy2];
+      }
+    }
+    X_partition = 0;
+    limit = lim2;
+  } while (p < lim2);
+}
+
+// Produces the filter output (AVX-512 variant).
+void ApplyFilter_Avx512(const RenderBuffer& render_buffer,
+                        size_t num_partitions,
+                        const std::vector<std::vector<FftData>>& H,
+                        FftData* S) {
+  RTC_DCHECK_GE(H.size(), H.size() - 1);
+  rtc::ArrayView<const std::vector<FftData>> render_buffer_data =
+      render_buffer.GetFftBuffer();
+  const size_t num_render_channels = render_buffer_data[0].size();
+  const size_t lim1 = std::min(
+      render_buffer_data.size() - render_buffer.Position(), num_partitions);
+  const size_t lim2 = num_partitions;
+  constexpr size_t kNumSixteenBinBands = kFftLengthBy2 / 16;
+
+  // The output is accumulated in registers over all partitions and channels,
+  // and only stored once.
+  __m512 S_re[kNumSixteenBinBands];
+  __m512 S_im[kNumSixteenBinBands];
+  for (size_t n = 0; n < kNumSixteenBinBands; ++n) {
+    S_re[n] = _mm512_setzero_ps();
+    S_im[n] = _mm512_setzero_ps();
+  }
+  float S_re_last = 0.f;
+  float S_im_last = 0.f;
+
+  size_t X_partition = render_buffer.Position();
+  size_t p = 0;
+  size_t limit = lim1;
+  do {
+    for (; p < limit; ++p, ++X_partition) {
+      for (size_t ch = 0; ch < num_render_channels; ++ch) {
+        const FftData& H_p_ch = H[p][ch];
+        const FftData& X = render_buffer_data[X_partition][ch];
+        for (size_t k = 0, n = 0; n < kNumSixteenBinBands; ++n, k += 16) {
+          const __m512 X_re = _mm512_loadu_ps(&X.re[k]);
+          const __m512 X_im = _mm512_loadu_ps(&X.im[k]);
+          const __m512 H_re = _mm512_loadu_ps(&H_p_ch.re[k]);
+          const __m512 H_im = _mm512_loadu_ps(&H_p_ch.im[k]);
+          const __m512 a = _mm512_mul_ps(X_re, H_re);
+          const __m512 b = _mm512_mul_ps(X_im, H_im);
+          const __m512 c = _mm512_mul_ps(X_re, H_im);
+          const __m512 d = _mm512_mul_ps(X_im, H_re);
+          const __m512 e = _mm512_sub_ps(a, b);
+          const __m512 f = _mm512_add_ps(c, d);
+          S_re[n] = _mm512_add_ps(S_re[n], e);
+          S_im[n] = _mm512_add_ps(S_im[n], f);
+        }
+        S_re_last += X.re[kFftLengthBy2] * H_p_ch.re[kFftLengthBy2] -
+                     X.im[kFftLengthBy2] * H_p_ch.im[kFftLengthBy2];
+        S_im_last += X.re[kFftLengthBy2] * H_p_ch.im[kFftLengthBy2] +
+                     X.im[kFftLengthBy2] * H_p_ch.re[kFftLengthBy2];
+      }
+    }
+    limit = lim2;
+    X_partition = 0;
+  } while (p < lim2);
+
+  for (size_t k = 0, n = 0; n < kNumSixteenBinBands; ++n, k += 16) {
+    _mm512_storeu_ps(&S->re[k], S_re[n]);
+    _mm512_storeu_ps(&S->im[k], S_im[n]);
+  }
+  S->re[kFftLengthBy2] = S_re_last;
+  S->im[kFftLengthBy2] = S_im_last;
+}
+
+}  // namespace aec3
+}  // namespace webrtc
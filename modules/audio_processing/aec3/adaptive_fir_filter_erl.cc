@@ -86,6 +86,7 @@ void ComputeErl(const Aec3Optimization& optimization,
       aec3::ErlComputer_SSE2(H2, erl);
       break;
     case Aec3Optimization::kAvx2:
+    case Aec3Optimization::kAvx512:
       aec3::ErlComputer_AVX2(H2, erl);
       break;
 #endif
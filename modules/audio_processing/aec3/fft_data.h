@@ -42,6 +42,7 @@ struct FftData {
 
   // Computes the power spectrum of the data.
   void SpectrumAVX2(rtc::ArrayView<float> power_spectrum) const;
+  void SpectrumAVX512(rtc::ArrayView<float> power_spectrum) const;
 
   // Computes the power spectrum of the data.
   void Spectrum(Aec3Optimization optimization,
@@ -66,6 +67,9 @@ struct FftData {
       case Aec3Optimization::kAvx2:
         SpectrumAVX2(power_spectrum);
         break;
+      case Aec3Optimization::kAvx512:
+        SpectrumAVX512(power_spectrum);
+        break;
 #endif
       default:
         std::transform(re.begin(), re.end(), im.begin(), power_spectrum.begin(),
@@ -15,6 +15,7 @@
 
 #include "absl/strings/string_view.h"
 #include "modules/audio_processing/aec_dump/aec_dump_factory.h"
+#include "api/array_view.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/event.h"
 #include "rtc_base/task_queue.h"
@@ -60,12 +61,14 @@ void CopyFromConfigToEvent(const webrtc::InternalAPMConfig& config,
 AecDumpImpl::AecDumpImpl(FileWrapper debug_file,
                          int64_t max_log_size_bytes,
                          rtc::TaskQueue* worker_queue)
-    : debug_file_(std::move(debug_file)),
-      num_bytes_left_for_log_(max_log_size_bytes),
+    : writer_(std::move(debug_file),
+              worker_queue->Get(),
+              {.max_file_size_bytes = max_log_size_bytes}),
       worker_queue_(worker_queue) {}
 
 AecDumpImpl::~AecDumpImpl() {
-  // Block until all tasks have finished running.
+  // Block until all tasks have finished running, so that no event is left to
+  // hand to `writer_`.
   rtc::Event thread_sync_event;
   worker_queue_->PostTask([&thread_sync_event] { thread_sync_event.Set(); });
   // Wait until the event has been signaled with .Set(). By then all
@@ -96,7 +99,7 @@ void AecDumpImpl::WriteInitMessage(const ProcessingConfig& api_format,
       api_format.reverse_output_stream().num_channels());
   msg->set_timestamp_ms(time_now_ms);
 
-  PostWriteToFileTask(std::move(event));
+  WriteEvent(std::move(event));
 }
 
 void AecDumpImpl::AddCaptureStreamInput(
@@ -126,7 +129,7 @@ void AecDumpImpl::AddAudioProcessingState(const AudioProcessingState& state) {
 }
 
 void AecDumpImpl::WriteCaptureStreamMessage() {
-  PostWriteToFileTask(capture_stream_info_.FetchEvent());
+  WriteEvent(capture_stream_info_.FetchEvent());
 }
 
 void AecDumpImpl::WriteRenderStreamMessage(const int16_t* const data,
@@ -138,7 +141,7 @@ void AecDumpImpl::WriteRenderStreamMessage(const int16_t* const data,
   const size_t data_size = sizeof(int16_t) * samples_per_channel * num_channels;
   msg->set_data(data, data_size);
 
-  PostWriteToFileTask(std::move(event));
+  WriteEvent(std::move(event));
 }
 
 void AecDumpImpl::WriteRenderStreamMessage(
@@ -153,7 +156,7 @@ void AecDumpImpl::WriteRenderStreamMessage(
     msg->add_channel(channel_view.begin(), sizeof(float) * channel_view.size());
   }
 
-  PostWriteToFileTask(std::move(event));
+  WriteEvent(std::move(event));
 }
 
 void AecDumpImpl::WriteConfig(const InternalAPMConfig& config) {
@@ -161,7 +164,7 @@ void AecDumpImpl::WriteConfig(const InternalAPMConfig& config) {
   auto event = std::make_unique<audioproc::Event>();
   event->set_type(audioproc::Event::CONFIG);
   CopyFromConfigToEvent(config, event->mutable_config());
-  PostWriteToFileTask(std::move(event));
+  WriteEvent(std::move(event));
 }
 
 void AecDumpImpl::WriteRuntimeSetting(
@@ -224,33 +227,26 @@ void AecDumpImpl::WriteRuntimeSetting(
       RTC_DCHECK_NOTREACHED();
       break;
   }
-  PostWriteToFileTask(std::move(event));
+  WriteEvent(std::move(event));
 }
 
-void AecDumpImpl::PostWriteToFileTask(std::unique_ptr<audioproc::Event> event) {
+void AecDumpImpl::WriteEvent(std::unique_ptr<audioproc::Event> event) {
   RTC_DCHECK(event);
+  // Serializing is about as costly as filling in the event was, so it is done
+  // on `worker_queue_` rather than on the audio thread.
   worker_queue_->PostTask([event = std::move(event), this] {
-    std::string event_string = event->SerializeAsString();
-    const size_t event_byte_size = event_string.size();
-
-    if (num_bytes_left_for_log_ >= 0) {
-      const int64_t next_message_size = sizeof(int32_t) + event_byte_size;
-      if (num_bytes_left_for_log_ < next_message_size) {
-        // Ensure that no further events are written, even if they're smaller
-        // than the current event.
-        num_bytes_left_for_log_ = 0;
-        return;
-      }
-      num_bytes_left_for_log_ -= next_message_size;
-    }
-
-    // Write message preceded by its size.
-    if (!debug_file_.Write(&event_byte_size, sizeof(int32_t))) {
-      RTC_DCHECK_NOTREACHED();
-    }
-    if (!debug_file_.Write(event_string.data(), event_string.size())) {
-      RTC_DCHECK_NOTREACHED();
-    }
+    const std::string event_string = event->SerializeAsString();
+    const int32_t event_byte_size = static_cast<int32_t>(event_string.size());
+
+    // Write message preceded by its size. When the log size limit is reached,
+    // no further events are written, even if they're smaller than the current
+    // event.
+    writer_.Write(
+        {rtc::MakeArrayView(reinterpret_cast<const uint8_t*>(&event_byte_size),
+                            sizeof(event_byte_size)),
+         rtc::MakeArrayView(
+             reinterpret_cast<const uint8_t*>(event_string.data()),
+             event_string.size())});
   });
 }
 
@@ -17,6 +17,7 @@
 
 #include "modules/audio_processing/aec_dump/capture_stream_info.h"
 #include "modules/audio_processing/include/aec_dump.h"
+#include "rtc_base/async_file_writer.h"
 #include "rtc_base/race_checker.h"
 #include "rtc_base/system/file_wrapper.h"
 #include "rtc_base/task_queue.h"
@@ -31,8 +32,10 @@
 
 namespace webrtc {
 
-// Task-queue based implementation of AecDump. It is thread safe by
-// relying on locks in TaskQueue.
+// Task-queue based implementation of AecDump. Events are serialized on
+// `worker_queue` and written to the file by an AsyncFileWriter, which drops
+// events rather than buffering without bound when the disk can't keep up. It
+// is thread safe by relying on locks in TaskQueue and AsyncFileWriter.
 class AecDumpImpl : public AecDump {
  public:
   // `max_log_size_bytes` - maximum number of bytes to write to the debug file,
@@ -69,12 +72,11 @@ class AecDumpImpl : public AecDump {
       const AudioProcessing::RuntimeSetting& runtime_setting) override;
 
  private:
-  void PostWriteToFileTask(std::unique_ptr<audioproc::Event> event);
+  void WriteEvent(std::unique_ptr<audioproc::Event> event);
 
-  FileWrapper debug_file_;
-  int64_t num_bytes_left_for_log_ = 0;
-  rtc::RaceChecker race_checker_;
+  AsyncFileWriter writer_;
   rtc::TaskQueue* worker_queue_;
+  rtc::RaceChecker race_checker_;
   CaptureStreamInfo capture_stream_info_;
 };
 }  // namespace webrtc
@@ -11,9 +11,9 @@
 #include "modules/audio_processing/agc2/fixed_digital_level_estimator.h"
 
 #include <algorithm>
-#include <cmath>
 
 #include "api/array_view.h"
+#include "modules/audio_processing/agc2/vector_ops.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 
@@ -62,13 +62,10 @@ std::array<float, kSubFramesInFrame> FixedDigitalLevelEstimator::ComputeLevel(
        ++channel_idx) {
     const auto channel = float_frame.channel(channel_idx);
     for (int sub_frame = 0; sub_frame < kSubFramesInFrame; ++sub_frame) {
-      for (int sample_in_sub_frame = 0;
-           sample_in_sub_frame < samples_in_sub_frame_; ++sample_in_sub_frame) {
-        envelope[sub_frame] =
-            std::max(envelope[sub_frame],
-                     std::abs(channel[sub_frame * samples_in_sub_frame_ +
-                                      sample_in_sub_frame]));
-      }
+      envelope[sub_frame] = std::max(
+          envelope[sub_frame],
+          MaxAbs(channel.subview(sub_frame * samples_in_sub_frame_,
+                                 samples_in_sub_frame_)));
     }
   }
 
@@ -12,7 +12,8 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/agc2_common.h"
-#include "rtc_base/numerics/safe_minmax.h"
+#include "modules/audio_processing/agc2/vector_ops.h"
+#include "rtc_base/checks.h"
 
 namespace webrtc {
 namespace {
@@ -26,16 +27,14 @@ bool GainCloseToOne(float gain_factor) {
 
 void ClipSignal(AudioFrameView<float> signal) {
   for (int k = 0; k < signal.num_channels(); ++k) {
-    rtc::ArrayView<float> channel_view = signal.channel(k);
-    for (auto& sample : channel_view) {
-      sample = rtc::SafeClamp(sample, kMinFloatS16Value, kMaxFloatS16Value);
-    }
+    ClampToFloatS16(signal.channel(k));
   }
 }
 
 void ApplyGainWithRamping(float last_gain_linear,
                           float gain_at_end_of_frame_linear,
                           float inverse_samples_per_channel,
+                          rtc::ArrayView<float> gain_ramp,
                           AudioFrameView<float> float_frame) {
   // Do not modify the signal.
   if (last_gain_linear == gain_at_end_of_frame_linear &&
@@ -55,15 +54,18 @@ void ApplyGainWithRamping(float last_gain_linear,
   }
 
   // The gain changes. We have to change slowly to avoid discontinuities.
+  // The ramp is computed once and then applied to every channel.
+  RTC_DCHECK_EQ(gain_ramp.size(), float_frame.samples_per_channel());
   const float increment = (gain_at_end_of_frame_linear - last_gain_linear) *
                           inverse_samples_per_channel;
   float gain = last_gain_linear;
-  for (int i = 0; i < float_frame.samples_per_channel(); ++i) {
-    for (int ch = 0; ch < float_frame.num_channels(); ++ch) {
-      float_frame.channel(ch)[i] *= gain;
-    }
+  for (float& ramp_gain : gain_ramp) {
+    ramp_gain = gain;
     gain += increment;
   }
+  for (int ch = 0; ch < float_frame.num_channels(); ++ch) {
+    Multiply(gain_ramp, float_frame.channel(ch));
+  }
 }
 
 }  // namespace
@@ -79,7 +81,7 @@ void GainApplier::ApplyGain(AudioFrameView<float> signal) {
   }
 
   ApplyGainWithRamping(last_gain_factor_, current_gain_factor_,
-                       inverse_samples_per_channel_, signal);
+                       inverse_samples_per_channel_, gain_ramp_, signal);
 
   last_gain_factor_ = current_gain_factor_;
 
@@ -98,6 +100,7 @@ void GainApplier::Initialize(int samples_per_channel) {
   RTC_DCHECK_GT(samples_per_channel, 0);
   samples_per_channel_ = static_cast<int>(samples_per_channel);
   inverse_samples_per_channel_ = 1.f / samples_per_channel_;
+  gain_ramp_.resize(samples_per_channel_);
 }
 
 }  // namespace webrtc
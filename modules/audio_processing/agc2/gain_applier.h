@@ -13,6 +13,8 @@
 
 #include <stddef.h>
 
+#include <vector>
+
 #include "modules/audio_processing/include/audio_frame_view.h"
 
 namespace webrtc {
@@ -38,6 +40,8 @@ class GainApplier {
   float current_gain_factor_;
   int samples_per_channel_ = -1;
   float inverse_samples_per_channel_ = -1.f;
+  // Per-sample gains used while ramping.
+  std::vector<float> gain_ramp_;
 };
 }  // namespace webrtc
 
@@ -17,10 +17,10 @@
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/agc2_common.h"
+#include "modules/audio_processing/agc2/vector_ops.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
-#include "rtc_base/numerics/safe_minmax.h"
 
 namespace webrtc {
 namespace {
@@ -75,14 +75,10 @@ void ComputePerSampleSubframeFactors(
 
 void ScaleSamples(rtc::ArrayView<const float> per_sample_scaling_factors,
                   AudioFrameView<float> signal) {
-  const int samples_per_channel = signal.samples_per_channel();
-  RTC_DCHECK_EQ(samples_per_channel, per_sample_scaling_factors.size());
+  RTC_DCHECK_EQ(signal.samples_per_channel(),
+                per_sample_scaling_factors.size());
   for (int i = 0; i < signal.num_channels(); ++i) {
-    rtc::ArrayView<float> channel = signal.channel(i);
-    for (int j = 0; j < samples_per_channel; ++j) {
-      channel[j] = rtc::SafeClamp(channel[j] * per_sample_scaling_factors[j],
-                                  kMinFloatS16Value, kMaxFloatS16Value);
-    }
+    MultiplyAndClampToFloatS16(per_sample_scaling_factors, signal.channel(i));
   }
 }
 
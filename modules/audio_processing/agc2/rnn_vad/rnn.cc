@@ -87,5 +87,48 @@ float RnnVad::ComputeVadProbability(
   return output_.data()[0];
 }
 
+void RnnVad::ComputeVadProbabilities(
+    rtc::ArrayView<RnnVad* const> rnn_vads,
+    rtc::ArrayView<const rtc::ArrayView<const float, kFeatureVectorSize>>
+        feature_vectors,
+    rtc::ArrayView<const bool> is_silence,
+    rtc::ArrayView<float> vad_probabilities) {
+  RTC_DCHECK_EQ(rnn_vads.size(), feature_vectors.size());
+  RTC_DCHECK_EQ(rnn_vads.size(), is_silence.size());
+  RTC_DCHECK_EQ(rnn_vads.size(), vad_probabilities.size());
+  // Indexes of the RNNs in the current batch of the hidden layer.
+  std::array<size_t, kGruMaxBatchSize> batch;
+  std::array<GatedRecurrentLayer*, kGruMaxBatchSize> hidden_layers;
+  std::array<rtc::ArrayView<const float>, kGruMaxBatchSize> hidden_inputs;
+  size_t batch_size = 0;
+  const auto process_batch = [&] {
+    GatedRecurrentLayer::ComputeOutputs(
+        {hidden_layers.data(), batch_size}, {hidden_inputs.data(), batch_size});
+    for (size_t b = 0; b < batch_size; ++b) {
+      RnnVad& rnn_vad = *rnn_vads[batch[b]];
+      rnn_vad.output_.ComputeOutput(rnn_vad.hidden_);
+      RTC_DCHECK_EQ(rnn_vad.output_.size(), 1);
+      vad_probabilities[batch[b]] = rnn_vad.output_.data()[0];
+    }
+    batch_size = 0;
+  };
+  for (size_t i = 0; i < rnn_vads.size(); ++i) {
+    RnnVad& rnn_vad = *rnn_vads[i];
+    if (is_silence[i]) {
+      rnn_vad.Reset();
+      vad_probabilities[i] = 0.f;
+      continue;
+    }
+    rnn_vad.input_.ComputeOutput(feature_vectors[i]);
+    batch[batch_size] = i;
+    hidden_layers[batch_size] = &rnn_vad.hidden_;
+    hidden_inputs[batch_size] = rnn_vad.input_;
+    if (++batch_size == kGruMaxBatchSize) {
+      process_batch();
+    }
+  }
+  process_batch();
+}
+
 }  // namespace rnn_vad
 }  // namespace webrtc
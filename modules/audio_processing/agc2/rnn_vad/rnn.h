@@ -40,6 +40,16 @@ class RnnVad {
   float ComputeVadProbability(
       rtc::ArrayView<const float, kFeatureVectorSize> feature_vector,
       bool is_silence);
+  // Same as calling ComputeVadProbability() on each RNN in `rnn_vads` with the
+  // inputs with the same index, and writing the results to
+  // `vad_probabilities`, but faster, since the hidden layers of the RNNs are
+  // evaluated together. Useful when running a VAD on several streams.
+  static void ComputeVadProbabilities(
+      rtc::ArrayView<RnnVad* const> rnn_vads,
+      rtc::ArrayView<const rtc::ArrayView<const float, kFeatureVectorSize>>
+          feature_vectors,
+      rtc::ArrayView<const bool> is_silence,
+      rtc::ArrayView<float> vad_probabilities);
 
  private:
   FullyConnectedLayer input_;
@@ -43,7 +43,10 @@ std::vector<float> PreprocessGruTensor(rtc::ArrayView<const int8_t> tensor_src,
   return tensor_dst;
 }
 
-// Computes the output for the update or the reset gate.
+using GateBuffer = std::array<float, kGruLayerMaxUnits>;
+
+// Computes the output for the update or the reset gate of each layer in a
+// batch of layers with the same weights.
 // Operation: `g = sigmoid(W^T∙i + R^T∙s + b)` where
 // - `g`: output gate vector
 // - `W`: weights matrix
@@ -51,32 +54,39 @@ std::vector<float> PreprocessGruTensor(rtc::ArrayView<const int8_t> tensor_src,
 // - `R`: recurrent weights matrix
 // - `s`: state gate vector
 // - `b`: bias vector
-void ComputeUpdateResetGate(int input_size,
-                            int output_size,
-                            const VectorMath& vector_math,
-                            rtc::ArrayView<const float> input,
-                            rtc::ArrayView<const float> state,
-                            rtc::ArrayView<const float> bias,
-                            rtc::ArrayView<const float> weights,
-                            rtc::ArrayView<const float> recurrent_weights,
-                            rtc::ArrayView<float> gate) {
-  RTC_DCHECK_EQ(input.size(), input_size);
-  RTC_DCHECK_EQ(state.size(), output_size);
+void ComputeUpdateResetGates(
+    int input_size,
+    int output_size,
+    const VectorMath& vector_math,
+    rtc::ArrayView<const rtc::ArrayView<const float>> inputs,
+    rtc::ArrayView<const rtc::ArrayView<float>> states,
+    rtc::ArrayView<const float> bias,
+    rtc::ArrayView<const float> weights,
+    rtc::ArrayView<const float> recurrent_weights,
+    rtc::ArrayView<GateBuffer> gates) {
   RTC_DCHECK_EQ(bias.size(), output_size);
   RTC_DCHECK_EQ(weights.size(), input_size * output_size);
   RTC_DCHECK_EQ(recurrent_weights.size(), output_size * output_size);
-  RTC_DCHECK_GE(gate.size(), output_size);  // `gate` is over-allocated.
+  RTC_DCHECK_EQ(inputs.size(), states.size());
+  RTC_DCHECK_LE(inputs.size(), gates.size());
   for (int o = 0; o < output_size; ++o) {
-    float x = bias[o];
-    x += vector_math.DotProduct(input,
-                                weights.subview(o * input_size, input_size));
-    x += vector_math.DotProduct(
-        state, recurrent_weights.subview(o * output_size, output_size));
-    gate[o] = ::rnnoise::SigmoidApproximated(x);
+    // The weights for the current output are used for all the layers in a
+    // row, while they are in the cache.
+    rtc::ArrayView<const float> weights_row =
+        weights.subview(o * input_size, input_size);
+    rtc::ArrayView<const float> recurrent_weights_row =
+        recurrent_weights.subview(o * output_size, output_size);
+    for (size_t b = 0; b < inputs.size(); ++b) {
+      float x = bias[o];
+      x += vector_math.DotProduct(inputs[b], weights_row);
+      x += vector_math.DotProduct(states[b], recurrent_weights_row);
+      gates[b][o] = ::rnnoise::SigmoidApproximated(x);
+    }
   }
 }
 
-// Computes the output for the state gate.
+// Computes the output for the state gate of each layer in a batch of layers
+// with the same weights.
 // Operation: `s' = u .* s + (1 - u) .* ReLU(W^T∙i + R^T∙(s .* r) + b)` where
 // - `s'`: output state gate vector
 // - `s`: previous state gate vector
@@ -87,35 +97,43 @@ void ComputeUpdateResetGate(int input_size,
 // - `r`: reset gate vector
 // - `b`: bias vector
 // - `.*` element-wise product
-void ComputeStateGate(int input_size,
-                      int output_size,
-                      const VectorMath& vector_math,
-                      rtc::ArrayView<const float> input,
-                      rtc::ArrayView<const float> update,
-                      rtc::ArrayView<const float> reset,
-                      rtc::ArrayView<const float> bias,
-                      rtc::ArrayView<const float> weights,
-                      rtc::ArrayView<const float> recurrent_weights,
-                      rtc::ArrayView<float> state) {
-  RTC_DCHECK_EQ(input.size(), input_size);
-  RTC_DCHECK_GE(update.size(), output_size);  // `update` is over-allocated.
-  RTC_DCHECK_GE(reset.size(), output_size);   // `reset` is over-allocated.
+void ComputeStateGates(int input_size,
+                       int output_size,
+                       const VectorMath& vector_math,
+                       rtc::ArrayView<const rtc::ArrayView<const float>> inputs,
+                       rtc::ArrayView<const GateBuffer> updates,
+                       rtc::ArrayView<const GateBuffer> resets,
+                       rtc::ArrayView<const float> bias,
+                       rtc::ArrayView<const float> weights,
+                       rtc::ArrayView<const float> recurrent_weights,
+                       rtc::ArrayView<const rtc::ArrayView<float>> states) {
   RTC_DCHECK_EQ(bias.size(), output_size);
   RTC_DCHECK_EQ(weights.size(), input_size * output_size);
   RTC_DCHECK_EQ(recurrent_weights.size(), output_size * output_size);
-  RTC_DCHECK_EQ(state.size(), output_size);
-  std::array<float, kGruLayerMaxUnits> reset_x_state;
-  for (int o = 0; o < output_size; ++o) {
-    reset_x_state[o] = state[o] * reset[o];
+  RTC_DCHECK_EQ(inputs.size(), states.size());
+  RTC_DCHECK_LE(inputs.size(), updates.size());
+  RTC_DCHECK_LE(inputs.size(), resets.size());
+  std::array<GateBuffer, kGruMaxBatchSize> reset_x_states;
+  RTC_DCHECK_LE(inputs.size(), reset_x_states.size());
+  for (size_t b = 0; b < inputs.size(); ++b) {
+    for (int o = 0; o < output_size; ++o) {
+      reset_x_states[b][o] = states[b][o] * resets[b][o];
+    }
   }
   for (int o = 0; o < output_size; ++o) {
-    float x = bias[o];
-    x += vector_math.DotProduct(input,
-                                weights.subview(o * input_size, input_size));
-    x += vector_math.DotProduct(
-        {reset_x_state.data(), static_cast<size_t>(output_size)},
-        recurrent_weights.subview(o * output_size, output_size));
-    state[o] = update[o] * state[o] + (1.f - update[o]) * std::max(0.f, x);
+    rtc::ArrayView<const float> weights_row =
+        weights.subview(o * input_size, input_size);
+    rtc::ArrayView<const float> recurrent_weights_row =
+        recurrent_weights.subview(o * output_size, output_size);
+    for (size_t b = 0; b < inputs.size(); ++b) {
+      float x = bias[o];
+      x += vector_math.DotProduct(inputs[b], weights_row);
+      x += vector_math.DotProduct(
+          {reset_x_states[b].data(), static_cast<size_t>(output_size)},
+          recurrent_weights_row);
+      const float update = updates[b][o];
+      states[b][o] = update * states[b][o] + (1.f - update) * std::max(0.f, x);
+    }
   }
 }
 
@@ -158,40 +176,64 @@ void GatedRecurrentLayer::Reset() {
 }
 
 void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
-  RTC_DCHECK_EQ(input.size(), input_size_);
+  GatedRecurrentLayer* const layers[] = {this};
+  const rtc::ArrayView<const float> inputs[] = {input};
+  ComputeOutputs(layers, inputs);
+}
+
+void GatedRecurrentLayer::ComputeOutputs(
+    rtc::ArrayView<GatedRecurrentLayer* const> layers,
+    rtc::ArrayView<const rtc::ArrayView<const float>> inputs) {
+  RTC_DCHECK_EQ(layers.size(), inputs.size());
+  RTC_DCHECK_LE(layers.size(), kGruMaxBatchSize);
+  if (layers.empty()) {
+    return;
+  }
+  // All the layers have the same weights, hence those of the first one are
+  // used.
+  const GatedRecurrentLayer& first = *layers[0];
+  const int input_size = first.input_size_;
+  const int output_size = first.output_size_;
+  std::array<rtc::ArrayView<float>, kGruMaxBatchSize> states;
+  for (size_t b = 0; b < layers.size(); ++b) {
+    RTC_DCHECK_EQ(layers[b]->input_size_, input_size);
+    RTC_DCHECK_EQ(layers[b]->output_size_, output_size);
+    RTC_DCHECK_EQ(inputs[b].size(), input_size);
+    states[b] = rtc::ArrayView<float>(layers[b]->state_.data(), output_size);
+  }
+  rtc::ArrayView<const rtc::ArrayView<float>> states_view(states.data(),
+                                                          layers.size());
 
   // The tensors below are organized as a sequence of flattened tensors for the
   // `update`, `reset` and `state` gates.
-  rtc::ArrayView<const float> bias(bias_);
-  rtc::ArrayView<const float> weights(weights_);
-  rtc::ArrayView<const float> recurrent_weights(recurrent_weights_);
+  rtc::ArrayView<const float> bias(first.bias_);
+  rtc::ArrayView<const float> weights(first.weights_);
+  rtc::ArrayView<const float> recurrent_weights(first.recurrent_weights_);
   // Strides to access to the flattened tensors for a specific gate.
-  const int stride_weights = input_size_ * output_size_;
-  const int stride_recurrent_weights = output_size_ * output_size_;
-
-  rtc::ArrayView<float> state(state_.data(), output_size_);
+  const int stride_weights = input_size * output_size;
+  const int stride_recurrent_weights = output_size * output_size;
 
   // Update gate.
-  std::array<float, kGruLayerMaxUnits> update;
-  ComputeUpdateResetGate(
-      input_size_, output_size_, vector_math_, input, state,
-      bias.subview(0, output_size_), weights.subview(0, stride_weights),
-      recurrent_weights.subview(0, stride_recurrent_weights), update);
+  std::array<GateBuffer, kGruMaxBatchSize> updates;
+  ComputeUpdateResetGates(
+      input_size, output_size, first.vector_math_, inputs, states_view,
+      bias.subview(0, output_size), weights.subview(0, stride_weights),
+      recurrent_weights.subview(0, stride_recurrent_weights), updates);
   // Reset gate.
-  std::array<float, kGruLayerMaxUnits> reset;
-  ComputeUpdateResetGate(input_size_, output_size_, vector_math_, input, state,
-                         bias.subview(output_size_, output_size_),
-                         weights.subview(stride_weights, stride_weights),
-                         recurrent_weights.subview(stride_recurrent_weights,
-                                                   stride_recurrent_weights),
-                         reset);
+  std::array<GateBuffer, kGruMaxBatchSize> resets;
+  ComputeUpdateResetGates(input_size, output_size, first.vector_math_, inputs,
+                          states_view, bias.subview(output_size, output_size),
+                          weights.subview(stride_weights, stride_weights),
+                          recurrent_weights.subview(stride_recurrent_weights,
+                                                    stride_recurrent_weights),
+                          resets);
   // State gate.
-  ComputeStateGate(input_size_, output_size_, vector_math_, input, update,
-                   reset, bias.subview(2 * output_size_, output_size_),
-                   weights.subview(2 * stride_weights, stride_weights),
-                   recurrent_weights.subview(2 * stride_recurrent_weights,
-                                             stride_recurrent_weights),
-                   state);
+  ComputeStateGates(input_size, output_size, first.vector_math_, inputs,
+                    updates, resets, bias.subview(2 * output_size, output_size),
+                    weights.subview(2 * stride_weights, stride_weights),
+                    recurrent_weights.subview(2 * stride_recurrent_weights,
+                                              stride_recurrent_weights),
+                    states_view);
 }
 
 }  // namespace rnn_vad
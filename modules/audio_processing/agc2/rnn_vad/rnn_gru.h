@@ -24,6 +24,9 @@ namespace rnn_vad {
 
 // Maximum number of units for a GRU layer.
 constexpr int kGruLayerMaxUnits = 24;
+// Maximum number of layers evaluated together by
+// GatedRecurrentLayer::ComputeOutputs().
+constexpr int kGruMaxBatchSize = 8;
 
 // Recurrent layer with gated recurrent units (GRUs) with sigmoid and ReLU as
 // activation functions for the update/reset and output gates respectively.
@@ -52,6 +55,14 @@ class GatedRecurrentLayer {
   void Reset();
   // Computes the recurrent layer output and updates the status.
   void ComputeOutput(rtc::ArrayView<const float> input);
+  // Computes the output of each layer in `layers` for the input with the same
+  // index in `inputs`, and updates their status. The layers must have been
+  // created with the same sizes and weights, e.g. for different streams. This
+  // is faster than calling ComputeOutput() on each layer, since each weight is
+  // read once for the whole batch. At most `kGruMaxBatchSize` layers.
+  static void ComputeOutputs(
+      rtc::ArrayView<GatedRecurrentLayer* const> layers,
+      rtc::ArrayView<const rtc::ArrayView<const float>> inputs);
 
  private:
   const int input_size_;
@@ -117,6 +117,46 @@ TEST_P(RnnGruParametrization, CheckGatedRecurrentLayer) {
   TestGatedRecurrentLayer(gru, kGruInputSequence, kGruExpectedOutputSequence);
 }
 
+// Checks that the layers evaluated as a batch produce the same output as when
+// evaluated one at a time.
+TEST_P(RnnGruParametrization, CheckBatchMatchesSingleLayers) {
+  constexpr int kNumLayers = 3;
+  std::vector<std::unique_ptr<GatedRecurrentLayer>> batch;
+  std::vector<std::unique_ptr<GatedRecurrentLayer>> single;
+  for (int b = 0; b < kNumLayers; ++b) {
+    batch.push_back(std::make_unique<GatedRecurrentLayer>(
+        kGruInputSize, kGruOutputSize, kGruBias, kGruWeights,
+        kGruRecurrentWeights,
+        /*cpu_features=*/GetParam(),
+        /*layer_name=*/"GRU"));
+    single.push_back(std::make_unique<GatedRecurrentLayer>(
+        kGruInputSize, kGruOutputSize, kGruBias, kGruWeights,
+        kGruRecurrentWeights,
+        /*cpu_features=*/GetParam(),
+        /*layer_name=*/"GRU"));
+  }
+  rtc::ArrayView<const float> input_sequence(kGruInputSequence);
+  const int input_sequence_length = input_sequence.size() / kGruInputSize;
+  std::array<GatedRecurrentLayer*, kNumLayers> layers;
+  std::array<rtc::ArrayView<const float>, kNumLayers> inputs;
+  for (int i = 0; i < input_sequence_length; ++i) {
+    SCOPED_TRACE(i);
+    for (int b = 0; b < kNumLayers; ++b) {
+      // Each layer observes the input sequence from a different offset.
+      inputs[b] = input_sequence.subview(
+          ((i + b) % input_sequence_length) * kGruInputSize, kGruInputSize);
+      layers[b] = batch[b].get();
+      single[b]->ComputeOutput(inputs[b]);
+    }
+    GatedRecurrentLayer::ComputeOutputs(layers, inputs);
+    for (int b = 0; b < kNumLayers; ++b) {
+      for (int o = 0; o < kGruOutputSize; ++o) {
+        EXPECT_EQ(batch[b]->data()[o], single[b]->data()[o]);
+      }
+    }
+  }
+}
+
 TEST_P(RnnGruParametrization, DISABLED_BenchmarkGatedRecurrentLayer) {
   // Prefetch test data.
   std::unique_ptr<FileReader> reader = CreateGruInputReader();
@@ -10,6 +10,10 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/rnn.h"
 
+#include <array>
+#include <memory>
+#include <vector>
+
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/agc2/rnn_vad/common.h"
@@ -65,6 +69,43 @@ TEST(RnnVadTest, CheckRnnVadSilence) {
   EXPECT_EQ(pre, post);
 }
 
+// Checks that evaluating the RNNs of several streams together produces the
+// same output as evaluating each of them separately.
+TEST(RnnVadTest, CheckBatchMatchesSingleRnnVads) {
+  constexpr int kNumStreams = kGruMaxBatchSize + 2;
+  std::vector<std::unique_ptr<RnnVad>> batch;
+  std::vector<std::unique_ptr<RnnVad>> single;
+  std::array<RnnVad*, kNumStreams> rnn_vads;
+  for (int i = 0; i < kNumStreams; ++i) {
+    batch.push_back(std::make_unique<RnnVad>(GetAvailableCpuFeatures()));
+    single.push_back(std::make_unique<RnnVad>(GetAvailableCpuFeatures()));
+    rnn_vads[i] = batch[i].get();
+  }
+  std::array<std::array<float, kFeatureVectorSize>, kNumStreams> features;
+  std::vector<rtc::ArrayView<const float, kFeatureVectorSize>> feature_views;
+  for (int i = 0; i < kNumStreams; ++i) {
+    // Gives each stream a different input.
+    for (int k = 0; k < kFeatureVectorSize; ++k) {
+      features[i][k] = kFeatures[(k + i) % kFeatureVectorSize];
+    }
+    feature_views.push_back(features[i]);
+  }
+  for (int step = 0; step < 10; ++step) {
+    SCOPED_TRACE(step);
+    std::array<bool, kNumStreams> is_silence;
+    for (int i = 0; i < kNumStreams; ++i) {
+      is_silence[i] = (i + step) % 4 == 0;
+    }
+    std::array<float, kNumStreams> vad_probabilities;
+    RnnVad::ComputeVadProbabilities(rnn_vads, feature_views, is_silence,
+                                    vad_probabilities);
+    for (int i = 0; i < kNumStreams; ++i) {
+      EXPECT_EQ(vad_probabilities[i], single[i]->ComputeVadProbability(
+                                          features[i], is_silence[i]));
+    }
+  }
+}
+
 }  // namespace
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/vector_ops.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "modules/audio_processing/agc2/agc2_common.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_minmax.h"
+#include "rtc_base/system/arch.h"
+
+// SSE2 is part of the x86-64 baseline, so no run-time detection is needed.
+#if defined(WEBRTC_ARCH_X86_64)
+#include <emmintrin.h>
+#define WEBRTC_AGC2_VECTOR_OPS_SSE2
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#define WEBRTC_AGC2_VECTOR_OPS_NEON
+#endif
+
+namespace webrtc {
+namespace {
+
+constexpr int kBlockSize = 4;
+
+// Number of leading samples processed in blocks of `kBlockSize`.
+int BlockedSize(size_t size) {
+  return static_cast<int>(size) / kBlockSize * kBlockSize;
+}
+
+// The operand order of the min and max below makes a NaN sample pass
+// through unchanged, as it does with `rtc::SafeClamp()`.
+#if defined(WEBRTC_AGC2_VECTOR_OPS_SSE2)
+__m128 ClampBlock(__m128 x) {
+  x = _mm_min_ps(_mm_set1_ps(kMaxFloatS16Value), x);
+  return _mm_max_ps(_mm_set1_ps(kMinFloatS16Value), x);
+}
+#elif defined(WEBRTC_AGC2_VECTOR_OPS_NEON)
+float32x4_t ClampBlock(float32x4_t x) {
+  // `vbslq_f32()` keeps `x` where the comparison fails, including NaN.
+  const float32x4_t max = vdupq_n_f32(kMaxFloatS16Value);
+  const float32x4_t min = vdupq_n_f32(kMinFloatS16Value);
+  x = vbslq_f32(vcgeq_f32(x, max), max, x);
+  return vbslq_f32(vcleq_f32(x, min), min, x);
+}
+#endif
+
+}  // namespace
+
+void MultiplyAndClampToFloatS16(rtc::ArrayView<const float> gains,
+                                rtc::ArrayView<float> samples) {
+  RTC_DCHECK_EQ(gains.size(), samples.size());
+  int i = 0;
+#if defined(WEBRTC_AGC2_VECTOR_OPS_SSE2)
+  for (; i < BlockedSize(samples.size()); i += kBlockSize) {
+    const __m128 x =
+        _mm_mul_ps(_mm_loadu_ps(&samples[i]), _mm_loadu_ps(&gains[i]));
+    _mm_storeu_ps(&samples[i], ClampBlock(x));
+  }
+#elif defined(WEBRTC_AGC2_VECTOR_OPS_NEON)
+  for (; i < BlockedSize(samples.size()); i += kBlockSize) {
+    const float32x4_t x =
+        vmulq_f32(vld1q_f32(&samples[i]), vld1q_f32(&gains[i]));
+    vst1q_f32(&samples[i], ClampBlock(x));
+  }
+#endif
+  for (; i < static_cast<int>(samples.size()); ++i) {
+    samples[i] = rtc::SafeClamp(samples[i] * gains[i], kMinFloatS16Value,
+                                kMaxFloatS16Value);
+  }
+}
+
+void Multiply(rtc::ArrayView<const float> gains,
+              rtc::ArrayView<float> samples) {
+  RTC_DCHECK_EQ(gains.size(), samples.size());
+  int i = 0;
+#if defined(WEBRTC_AGC2_VECTOR_OPS_SSE2)
+  for (; i < BlockedSize(samples.size()); i += kBlockSize) {
+    _mm_storeu_ps(&samples[i], _mm_mul_ps(_mm_loadu_ps(&samples[i]),
+                                          _mm_loadu_ps(&gains[i])));
+  }
+#elif defined(WEBRTC_AGC2_VECTOR_OPS_NEON)
+  for (; i < BlockedSize(samples.size()); i += kBlockSize) {
+    vst1q_f32(&samples[i],
+              vmulq_f32(vld1q_f32(&samples[i]), vld1q_f32(&gains[i])));
+  }
+#endif
+  for (; i < static_cast<int>(samples.size()); ++i) {
+    samples[i] *= gains[i];
+  }
+}
+
+void ClampToFloatS16(rtc::ArrayView<float> samples) {
+  int i = 0;
+#if defined(WEBRTC_AGC2_VECTOR_OPS_SSE2)
+  for (; i < BlockedSize(samples.size()); i += kBlockSize) {
+    _mm_storeu_ps(&samples[i], ClampBlock(_mm_loadu_ps(&samples[i])));
+  }
+#elif defined(WEBRTC_AGC2_VECTOR_OPS_NEON)
+  for (; i < BlockedSize(samples.size()); i += kBlockSize) {
+    vst1q_f32(&samples[i], ClampBlock(vld1q_f32(&samples[i])));
+  }
+#endif
+  for (; i < static_cast<int>(samples.size()); ++i) {
+    samples[i] =
+        rtc::SafeClamp(samples[i], kMinFloatS16Value, kMaxFloatS16Value);
+  }
+}
+
+float MaxAbs(rtc::ArrayView<const float> samples) {
+  float max_abs = 0.f;
+  int i = 0;
+  // The maximum does not depend on the evaluation order, so reducing four
+  // lanes in parallel matches the scalar loop. Like `std::max()` below, the
+  // blocks skip NaN samples.
+#if defined(WEBRTC_AGC2_VECTOR_OPS_SSE2)
+  if (BlockedSize(samples.size()) > 0) {
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    __m128 max_abs_block = _mm_setzero_ps();
+    for (; i < BlockedSize(samples.size()); i += kBlockSize) {
+      max_abs_block = _mm_max_ps(
+          _mm_and_ps(_mm_loadu_ps(&samples[i]), abs_mask), max_abs_block);
+    }
+    max_abs_block = _mm_max_ps(max_abs_block,
+                               _mm_movehl_ps(max_abs_block, max_abs_block));
+    max_abs_block = _mm_max_ss(max_abs_block,
+                               _mm_shuffle_ps(max_abs_block, max_abs_block, 1));
+    max_abs = _mm_cvtss_f32(max_abs_block);
+  }
+#elif defined(WEBRTC_AGC2_VECTOR_OPS_NEON)
+  if (BlockedSize(samples.size()) > 0) {
+    float32x4_t max_abs_block = vdupq_n_f32(0.f);
+    for (; i < BlockedSize(samples.size()); i += kBlockSize) {
+      const float32x4_t x = vabsq_f32(vld1q_f32(&samples[i]));
+      max_abs_block =
+          vbslq_f32(vcgtq_f32(x, max_abs_block), x, max_abs_block);
+    }
+    float lanes[kBlockSize];
+    vst1q_f32(lanes, max_abs_block);
+    for (float lane : lanes) {
+      max_abs = std::max(max_abs, lane);
+    }
+  }
+#endif
+  for (; i < static_cast<int>(samples.size()); ++i) {
+    max_abs = std::max(max_abs, std::abs(samples[i]));
+  }
+  return max_abs;
+}
+
+}  // namespace webrtc
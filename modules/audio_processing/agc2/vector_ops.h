@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AGC2_VECTOR_OPS_H_
+#define MODULES_AUDIO_PROCESSING_AGC2_VECTOR_OPS_H_
+
+#include "api/array_view.h"
+
+namespace webrtc {
+
+// Per-sample kernels shared by the limiter and the gain applier. They use
+// SSE2 on x86-64 and NEON where available, and give bit-exact results with
+// respect to the scalar fallback.
+
+// Multiplies each sample by the gain with the same index and clamps the
+// result to the FloatS16 range.
+void MultiplyAndClampToFloatS16(rtc::ArrayView<const float> gains,
+                                rtc::ArrayView<float> samples);
+
+// Multiplies each sample by the gain with the same index.
+void Multiply(rtc::ArrayView<const float> gains, rtc::ArrayView<float> samples);
+
+// Clamps the samples to the FloatS16 range.
+void ClampToFloatS16(rtc::ArrayView<float> samples);
+
+// Returns the largest absolute value in `samples`, zero if empty.
+float MaxAbs(rtc::ArrayView<const float> samples);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AGC2_VECTOR_OPS_H_
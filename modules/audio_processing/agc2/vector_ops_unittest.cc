@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/agc2/vector_ops.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "modules/audio_processing/agc2/agc2_common.h"
+#include "rtc_base/numerics/safe_minmax.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Covers empty input, partial blocks and several full blocks.
+constexpr int kMaxSize = 37;
+
+// Samples in a range twice as large as FloatS16 so that clamping kicks in.
+std::vector<float> CreateSamples(int size, Random& random) {
+  std::vector<float> samples(size);
+  for (float& sample : samples) {
+    sample = 4 * kMaxFloatS16Value * (random.Rand<float>() - 0.5f);
+  }
+  return samples;
+}
+
+std::vector<float> CreateGains(int size, Random& random) {
+  std::vector<float> gains(size);
+  for (float& gain : gains) {
+    gain = 2 * random.Rand<float>();
+  }
+  return gains;
+}
+
+TEST(GainController2VectorOps, MultiplyAndClampIsBitExact) {
+  Random random(/*seed=*/42);
+  for (int size = 0; size <= kMaxSize; ++size) {
+    SCOPED_TRACE(size);
+    const std::vector<float> gains = CreateGains(size, random);
+    std::vector<float> samples = CreateSamples(size, random);
+    std::vector<float> expected = samples;
+    for (int i = 0; i < size; ++i) {
+      expected[i] = rtc::SafeClamp(expected[i] * gains[i], kMinFloatS16Value,
+                                   kMaxFloatS16Value);
+    }
+    MultiplyAndClampToFloatS16(gains, samples);
+    EXPECT_EQ(samples, expected);
+  }
+}
+
+TEST(GainController2VectorOps, MultiplyIsBitExact) {
+  Random random(/*seed=*/42);
+  for (int size = 0; size <= kMaxSize; ++size) {
+    SCOPED_TRACE(size);
+    const std::vector<float> gains = CreateGains(size, random);
+    std::vector<float> samples = CreateSamples(size, random);
+    std::vector<float> expected = samples;
+    for (int i = 0; i < size; ++i) {
+      expected[i] *= gains[i];
+    }
+    Multiply(gains, samples);
+    EXPECT_EQ(samples, expected);
+  }
+}
+
+TEST(GainController2VectorOps, ClampIsBitExact) {
+  Random random(/*seed=*/42);
+  for (int size = 0; size <= kMaxSize; ++size) {
+    SCOPED_TRACE(size);
+    std::vector<float> samples = CreateSamples(size, random);
+    std::vector<float> expected = samples;
+    for (float& sample : expected) {
+      sample = rtc::SafeClamp(sample, kMinFloatS16Value, kMaxFloatS16Value);
+    }
+    ClampToFloatS16(samples);
+    EXPECT_EQ(samples, expected);
+  }
+}
+
+TEST(GainController2VectorOps, ClampKeepsNaN) {
+  std::vector<float> samples(8, std::nanf(""));
+  samples[3] = 2 * kMaxFloatS16Value;
+  ClampToFloatS16(samples);
+  for (int i = 0; i < 8; ++i) {
+    if (i == 3) {
+      EXPECT_EQ(samples[i], kMaxFloatS16Value);
+    } else {
+      EXPECT_TRUE(std::isnan(samples[i]));
+    }
+  }
+}
+
+TEST(GainController2VectorOps, MaxAbsIsBitExact) {
+  Random random(/*seed=*/42);
+  for (int size = 0; size <= kMaxSize; ++size) {
+    SCOPED_TRACE(size);
+    const std::vector<float> samples = CreateSamples(size, random);
+    float expected = 0.f;
+    for (float sample : samples) {
+      expected = std::max(expected, std::abs(sample));
+    }
+    EXPECT_EQ(MaxAbs(samples), expected);
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
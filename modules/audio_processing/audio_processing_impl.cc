@@ -1337,13 +1337,14 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
     RTC_DCHECK(aecm_render_signal_queue_);
     // Insert the samples into the queue.
     if (!aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result =
-          aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
-      RTC_DCHECK(result);
+      // The data queue is full and needs to be emptied. If the capture thread
+      // is processing a frame, the render frame is dropped instead.
+      if (TryEmptyQueuedRenderAudio()) {
+        // Retry the insert (should always work).
+        bool result =
+            aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
+        RTC_DCHECK(result);
+      }
     }
   }
 
@@ -1351,12 +1352,14 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
     GainControlImpl::PackRenderAudioBuffer(*audio, &agc_render_queue_buffer_);
     // Insert the samples into the queue.
     if (!agc_render_signal_queue_->Insert(&agc_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
-      RTC_DCHECK(result);
+      // The data queue is full and needs to be emptied. If the capture thread
+      // is processing a frame, the render frame is dropped instead.
+      if (TryEmptyQueuedRenderAudio()) {
+        // Retry the insert (should always work).
+        bool result =
+            agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
+        RTC_DCHECK(result);
+      }
     }
   }
 }
@@ -1367,12 +1370,14 @@ void AudioProcessingImpl::QueueNonbandedRenderAudio(AudioBuffer* audio) {
     RTC_DCHECK(red_render_signal_queue_);
     // Insert the samples into the queue.
     if (!red_render_signal_queue_->Insert(&red_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
-      // Retry the insert (should always work).
-      bool result = red_render_signal_queue_->Insert(&red_render_queue_buffer_);
-      RTC_DCHECK(result);
+      // The data queue is full and needs to be emptied. If the capture thread
+      // is processing a frame, the render frame is dropped instead.
+      if (TryEmptyQueuedRenderAudio()) {
+        // Retry the insert (should always work).
+        bool result =
+            red_render_signal_queue_->Insert(&red_render_queue_buffer_);
+        RTC_DCHECK(result);
+      }
     }
   }
 }
@@ -1429,9 +1434,13 @@ void AudioProcessingImpl::AllocateRenderQueue() {
   }
 }
 
-void AudioProcessingImpl::EmptyQueuedRenderAudio() {
-  MutexLock lock_capture(&mutex_capture_);
+bool AudioProcessingImpl::TryEmptyQueuedRenderAudio() {
+  if (!mutex_capture_.TryLock()) {
+    return false;
+  }
   EmptyQueuedRenderAudioLocked();
+  mutex_capture_.Unlock();
+  return true;
 }
 
 void AudioProcessingImpl::EmptyQueuedRenderAudioLocked() {
@@ -348,7 +348,10 @@ class AudioProcessingImpl : public AudioProcessing {
   void HandleRenderRuntimeSettings()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_render_);
 
-  void EmptyQueuedRenderAudio() RTC_LOCKS_EXCLUDED(mutex_capture_);
+  // Empties the render queues and returns true, unless the capture lock is
+  // held, in which case it returns false without waiting for it. Called on the
+  // render thread, which must not wait for the processing of a capture frame.
+  bool TryEmptyQueuedRenderAudio() RTC_LOCKS_EXCLUDED(mutex_capture_);
   void EmptyQueuedRenderAudioLocked()
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void AllocateRenderQueue()
@@ -10,6 +10,8 @@
 
 #include "modules/audio_processing/high_pass_filter.h"
 
+#include <algorithm>
+
 #include "api/array_view.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "rtc_base/checks.h"
@@ -112,4 +114,77 @@ void HighPassFilter::Reset(size_t num_channels) {
   }
 }
 
+BatchedHighPassFilter::BatchedHighPassFilter(int sample_rate_hz,
+                                             size_t num_streams)
+    : sample_rate_hz_(sample_rate_hz),
+      coefficients_(ChooseCoefficients(sample_rate_hz)),
+      x0_(num_streams),
+      x1_(num_streams),
+      y0_(num_streams),
+      y1_(num_streams) {
+  static_assert(kNumberOfHighPassBiQuads == 1,
+                "The batched filter only applies one biquad.");
+}
+
+BatchedHighPassFilter::~BatchedHighPassFilter() = default;
+
+void BatchedHighPassFilter::Process(
+    rtc::ArrayView<const rtc::ArrayView<float>> frames) {
+  const size_t num_streams = x0_.size();
+  RTC_DCHECK_EQ(frames.size(), num_streams);
+  if (num_streams == 0) {
+    return;
+  }
+  const size_t num_samples = frames[0].size();
+  interleaved_.resize(num_samples * num_streams);
+  for (size_t s = 0; s < num_streams; ++s) {
+    RTC_DCHECK_EQ(frames[s].size(), num_samples);
+    for (size_t k = 0; k < num_samples; ++k) {
+      interleaved_[k * num_streams + s] = frames[s][k];
+    }
+  }
+
+  const float c_a_0 = coefficients_.a[0];
+  const float c_a_1 = coefficients_.a[1];
+  const float c_b_0 = coefficients_.b[0];
+  const float c_b_1 = coefficients_.b[1];
+  const float c_b_2 = coefficients_.b[2];
+  float* x0 = x0_.data();
+  float* x1 = x1_.data();
+  float* y0 = y0_.data();
+  float* y1 = y1_.data();
+  for (size_t k = 0; k < num_samples; ++k) {
+    float* samples = &interleaved_[k * num_streams];
+    // The same computations as in CascadedBiQuadFilter, for all streams.
+    for (size_t s = 0; s < num_streams; ++s) {
+      const float tmp = samples[s];
+      const float y = c_b_0 * tmp + c_b_1 * x0[s] + c_b_2 * x1[s] -
+                      c_a_0 * y0[s] - c_a_1 * y1[s];
+      x1[s] = x0[s];
+      x0[s] = tmp;
+      y1[s] = y0[s];
+      y0[s] = y;
+      samples[s] = y;
+    }
+  }
+
+  for (size_t s = 0; s < num_streams; ++s) {
+    for (size_t k = 0; k < num_samples; ++k) {
+      frames[s][k] = interleaved_[k * num_streams + s];
+    }
+  }
+}
+
+void BatchedHighPassFilter::Reset() {
+  std::fill(x0_.begin(), x0_.end(), 0.f);
+  std::fill(x1_.begin(), x1_.end(), 0.f);
+  std::fill(y0_.begin(), y0_.end(), 0.f);
+  std::fill(y1_.begin(), y1_.end(), 0.f);
+}
+
+void BatchedHighPassFilter::Reset(size_t stream) {
+  RTC_DCHECK_LT(stream, x0_.size());
+  x0_[stream] = x1_[stream] = y0_[stream] = y1_[stream] = 0.f;
+}
+
 }  // namespace webrtc
@@ -40,6 +40,44 @@ class HighPassFilter {
   const int sample_rate_hz_;
   std::vector<std::unique_ptr<CascadedBiQuadFilter>> filters_;
 };
+
+// Applies the high-pass filter of `HighPassFilter` to a batch of independent
+// mono streams, one 10 ms frame of each stream per call, for servers that
+// process many streams at once. The filter states of the streams are kept
+// side by side and all streams are filtered in lockstep, sample by sample, so
+// that the computations for the different streams can be vectorized. The
+// output is the same as that of one `HighPassFilter` per stream.
+class BatchedHighPassFilter {
+ public:
+  BatchedHighPassFilter(int sample_rate_hz, size_t num_streams);
+  ~BatchedHighPassFilter();
+  BatchedHighPassFilter(const BatchedHighPassFilter&) = delete;
+  BatchedHighPassFilter& operator=(const BatchedHighPassFilter&) = delete;
+
+  // Filters `frames` in place, where `frames[k]` is the frame of the stream
+  // `k`. All frames must have the same number of samples.
+  void Process(rtc::ArrayView<const rtc::ArrayView<float>> frames);
+  // Resets the filter state of all streams.
+  void Reset();
+  // Resets the filter state of the stream `stream`, e.g. when the stream is
+  // replaced by a new one.
+  void Reset(size_t stream);
+
+  int sample_rate_hz() const { return sample_rate_hz_; }
+  size_t num_streams() const { return x0_.size(); }
+
+ private:
+  const int sample_rate_hz_;
+  const CascadedBiQuadFilter::BiQuadCoefficients& coefficients_;
+  // The filter state of each stream, in direct form 1.
+  std::vector<float> x0_;
+  std::vector<float> x1_;
+  std::vector<float> y0_;
+  std::vector<float> y1_;
+  // The samples of all streams, interleaved sample by sample.
+  std::vector<float> interleaved_;
+};
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_HIGH_PASS_FILTER_H_
@@ -9,6 +9,7 @@
  */
 #include "modules/audio_processing/high_pass_filter.h"
 
+#include <memory>
 #include <vector>
 
 #include "api/array_view.h"
@@ -298,4 +299,42 @@ TEST(HighPassFilterAccuracyTest, MonoConverged) {
   }
 }
 
+TEST(BatchedHighPassFilterTest, MatchesFilterPerStream) {
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumStreams = 5;
+  constexpr size_t kNumSamples = kSampleRateHz / 100;
+  BatchedHighPassFilter batched_filter(kSampleRateHz, kNumStreams);
+  std::vector<std::unique_ptr<HighPassFilter>> filters;
+  for (size_t s = 0; s < kNumStreams; ++s) {
+    filters.push_back(std::make_unique<HighPassFilter>(kSampleRateHz, 1));
+  }
+
+  std::vector<std::vector<float>> frames(kNumStreams,
+                                         std::vector<float>(kNumSamples));
+  for (int frame = 0; frame < 10; ++frame) {
+    if (frame == 5) {
+      // Only the state of the reset stream is cleared.
+      batched_filter.Reset(2);
+      filters[2]->Reset();
+    }
+    std::vector<std::vector<float>> expected(kNumStreams);
+    std::vector<rtc::ArrayView<float>> views;
+    for (size_t s = 0; s < kNumStreams; ++s) {
+      for (size_t k = 0; k < kNumSamples; ++k) {
+        frames[s][k] = ((frame * 7 + s * 13 + k * 31) % 101) / 50.f - 1.f;
+      }
+      std::vector<std::vector<float>> channels = {frames[s]};
+      filters[s]->Process(&channels);
+      expected[s] = channels[0];
+      views.push_back(frames[s]);
+    }
+    batched_filter.Process(views);
+    for (size_t s = 0; s < kNumStreams; ++s) {
+      for (size_t k = 0; k < kNumSamples; ++k) {
+        EXPECT_FLOAT_EQ(frames[s][k], expected[s][k]);
+      }
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -14,6 +14,15 @@
 #include <stdint.h>
 
 #include "rtc_base/checks.h"
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 
 namespace webrtc {
 
@@ -58,7 +67,35 @@ float LogApproximation(float x) {
 }
 
 void LogApproximation(rtc::ArrayView<const float> x, rtc::ArrayView<float> y) {
-  for (size_t k = 0; k < x.size(); ++k) {
+  RTC_DCHECK_EQ(x.size(), y.size());
+  // The vectorized versions perform the same operations as FastLog2f(), in the
+  // same order, and thus produce the same output as the scalar version.
+  size_t k = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  const size_t vector_limit = x.size() & ~size_t{3};
+  const __m128 one_by_2_pow_23 = _mm_set1_ps(1.1920929e-7f);
+  const __m128 bias = _mm_set1_ps(126.942695f);
+  const __m128 log_of_2 = _mm_set1_ps(0.69314718056f);
+  for (; k < vector_limit; k += 4) {
+    // The inputs are positive, so their bits can be read as signed integers.
+    __m128 log2 = _mm_cvtepi32_ps(_mm_castps_si128(_mm_loadu_ps(&x[k])));
+    log2 = _mm_mul_ps(log2, one_by_2_pow_23);
+    log2 = _mm_sub_ps(log2, bias);
+    _mm_storeu_ps(&y[k], _mm_mul_ps(log2, log_of_2));
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  const size_t vector_limit = x.size() & ~size_t{3};
+  const float32x4_t one_by_2_pow_23 = vdupq_n_f32(1.1920929e-7f);
+  const float32x4_t bias = vdupq_n_f32(126.942695f);
+  const float32x4_t log_of_2 = vdupq_n_f32(0.69314718056f);
+  for (; k < vector_limit; k += 4) {
+    float32x4_t log2 = vcvtq_f32_u32(vreinterpretq_u32_f32(vld1q_f32(&x[k])));
+    log2 = vmulq_f32(log2, one_by_2_pow_23);
+    log2 = vsubq_f32(log2, bias);
+    vst1q_f32(&y[k], vmulq_f32(log2, log_of_2));
+  }
+#endif
+  for (; k < x.size(); ++k) {
     y[k] = LogApproximation(x[k]);
   }
 }
@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/fast_math.h"
+
+#include <math.h>
+
+#include <array>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Verifies that the vectorized log approximation produces the same output as
+// the scalar one, including for the elements after the last full vector.
+TEST(NsFastMath, LogApproximationOfArrayMatchesScalar) {
+  std::array<float, 131> x;
+  for (size_t k = 0; k < x.size(); ++k) {
+    x[k] = 0.001f * powf(1.2f, static_cast<float>(k));
+  }
+  std::array<float, 131> y;
+  LogApproximation(x, y);
+  for (size_t k = 0; k < x.size(); ++k) {
+    EXPECT_EQ(y[k], LogApproximation(x[k]));
+    EXPECT_NEAR(y[k], logf(x[k]), 0.1f);
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
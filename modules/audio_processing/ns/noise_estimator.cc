@@ -11,6 +11,7 @@
 #include "modules/audio_processing/ns/noise_estimator.h"
 
 #include <algorithm>
+#include <array>
 
 #include "modules/audio_processing/ns/fast_math.h"
 #include "rtc_base/checks.h"
@@ -69,11 +70,16 @@ void NoiseEstimator::PreUpdate(
     float sum_log_i = 0.f;
     float sum_log_i_square = 0.f;
     float sum_log_magn = 0.f;
+    std::array<float, kFftSizeBy2Plus1 - kStartBand> log_signal_spectrum;
+    LogApproximation(
+        rtc::ArrayView<const float>(&signal_spectrum[kStartBand],
+                                    kFftSizeBy2Plus1 - kStartBand),
+        log_signal_spectrum);
     for (size_t i = kStartBand; i < kFftSizeBy2Plus1; ++i) {
       float log_i = log_table[i];
       sum_log_i += log_i;
       sum_log_i_square += log_i * log_i;
-      float log_signal = LogApproximation(signal_spectrum[i]);
+      float log_signal = log_signal_spectrum[i - kStartBand];
       sum_log_magn += log_signal;
       sum_log_i_log_magn += log_i * log_signal;
     }
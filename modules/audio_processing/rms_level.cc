@@ -95,6 +95,19 @@ void RmsLevel::Analyze(rtc::ArrayView<const float> data) {
   max_sum_square_ = std::max(max_sum_square_, sum_square);
 }
 
+void RmsLevel::AnalyzeSumSquare(size_t length, float sum_square) {
+  if (length == 0) {
+    return;
+  }
+
+  CheckBlockSize(length);
+  RTC_DCHECK_GE(sum_square, 0.f);
+  sum_square_ += sum_square;
+  sample_count_ += length;
+
+  max_sum_square_ = std::max(max_sum_square_, sum_square);
+}
+
 void RmsLevel::AnalyzeMuted(size_t length) {
   CheckBlockSize(length);
   sample_count_ += length;
@@ -46,6 +46,9 @@ class RmsLevel {
   // Pass each chunk of audio to Analyze() to accumulate the level.
   void Analyze(rtc::ArrayView<const int16_t> data);
   void Analyze(rtc::ArrayView<const float> data);
+  // Like Analyze(), for a chunk of `length` samples of which the sum of the
+  // squares, e.g. from AudioFrame::sample_stats(), is `sum_square`.
+  void AnalyzeSumSquare(size_t length, float sum_square);
 
   // If all samples with the given `length` have a magnitude of zero, this is
   // a shortcut to avoid some computation.
@@ -79,6 +79,25 @@ TEST(RmsLevelTest, VerifyIndentityBetweenFloatAndFix) {
   EXPECT_EQ(avg_f, avg_i);
 }
 
+TEST(RmsLevelTest, VerifyIdentityBetweenSamplesAndSumSquare) {
+  auto x = CreateInt16Sinusoid(1000, INT16_MAX / 2, kSampleRateHz);
+  auto level = RunTest(x);
+  RmsLevel level_sum_square;
+  for (size_t n = 0; n + kBlockSizeSamples <= x.size();
+       n += kBlockSizeSamples) {
+    float sum_square = 0.f;
+    for (size_t k = n; k < n + kBlockSizeSamples; ++k) {
+      sum_square += x[k] * x[k];
+    }
+    level_sum_square.AnalyzeSumSquare(kBlockSizeSamples, sum_square);
+  }
+  RmsLevel::Levels levels = level->AverageAndPeak();
+  RmsLevel::Levels levels_sum_square = level_sum_square.AverageAndPeak();
+  EXPECT_EQ(9, levels.average);  // -9 dBFS
+  EXPECT_EQ(levels.average, levels_sum_square.average);
+  EXPECT_EQ(levels.peak, levels_sum_square.peak);
+}
+
 TEST(RmsLevelTest, Run1000HzFullScale) {
   auto x = CreateInt16Sinusoid(1000, INT16_MAX, kSampleRateHz);
   auto level = RunTest(x);
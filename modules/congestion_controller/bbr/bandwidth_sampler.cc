@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bandwidth_sampler.h"
+
+#include <algorithm>
+
+#include "api/units/time_delta.h"
+
+namespace webrtc {
+namespace bbr {
+namespace {
+// Packets feedback never arrived for are forgotten after this time.
+constexpr TimeDelta kPacketHistoryWindow = TimeDelta::Seconds(10);
+}  // namespace
+
+void BandwidthSampler::OnPacketSent(const SentPacket& packet) {
+  if (packets_in_flight_.empty()) {
+    first_send_time_ = packet.send_time;
+  }
+  packets_in_flight_[packet.sequence_number] = {
+      .send_time = packet.send_time,
+      .delivered = delivered_,
+      .delivered_time = delivered_time_,
+      .first_send_time = first_send_time_};
+
+  while (packets_in_flight_.begin()->second.send_time <
+         packet.send_time - kPacketHistoryWindow) {
+    packets_in_flight_.erase(packets_in_flight_.begin());
+  }
+}
+
+absl::optional<BandwidthSampler::Sample> BandwidthSampler::OnPacketsFeedback(
+    const std::vector<PacketResult>& packet_feedbacks) {
+  absl::optional<PacketState> newest_acked;
+  for (const PacketResult& packet : packet_feedbacks) {
+    auto it = packets_in_flight_.find(packet.sent_packet.sequence_number);
+    if (it == packets_in_flight_.end()) {
+      continue;
+    }
+    if (packet.IsReceived()) {
+      delivered_ += packet.sent_packet.size;
+      delivered_time_ = std::max(delivered_time_, packet.receive_time);
+      if (!newest_acked || it->second.send_time >= newest_acked->send_time) {
+        newest_acked = it->second;
+      }
+    }
+    packets_in_flight_.erase(it);
+  }
+  if (!newest_acked) {
+    return absl::nullopt;
+  }
+
+  first_send_time_ = newest_acked->send_time;
+  if (!newest_acked->delivered_time.IsFinite()) {
+    // Nothing was received yet when the packet was sent.
+    return absl::nullopt;
+  }
+  TimeDelta send_elapsed =
+      newest_acked->send_time - newest_acked->first_send_time;
+  TimeDelta ack_elapsed = delivered_time_ - newest_acked->delivered_time;
+  TimeDelta interval = std::max(send_elapsed, ack_elapsed);
+  if (interval <= TimeDelta::Zero()) {
+    return absl::nullopt;
+  }
+  return Sample{
+      .delivery_rate = (delivered_ - newest_acked->delivered) / interval,
+      .prior_delivered = newest_acked->delivered};
+}
+
+}  // namespace bbr
+}  // namespace webrtc
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_BBR_BANDWIDTH_SAMPLER_H_
+#define MODULES_CONGESTION_CONTROLLER_BBR_BANDWIDTH_SAMPLER_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+namespace bbr {
+
+// Estimates the delivery rate of the path from the acknowledgements of
+// individual packets, as described in
+// https://datatracker.ietf.org/doc/html/draft-cheng-iccrg-delivery-rate-estimation
+// The data delivered between sending a packet and its acknowledgement is
+// divided by the longer of the send and the receive intervals it took.
+// Receive times are used instead of the arrival times of the
+// acknowledgements, since transport feedback reports them for every packet.
+class BandwidthSampler {
+ public:
+  struct Sample {
+    DataRate delivery_rate = DataRate::Zero();
+    // Data delivered before the packet the sample is based on was sent.
+    DataSize prior_delivered = DataSize::Zero();
+  };
+
+  BandwidthSampler() = default;
+  BandwidthSampler(const BandwidthSampler&) = delete;
+  BandwidthSampler& operator=(const BandwidthSampler&) = delete;
+  ~BandwidthSampler() = default;
+
+  void OnPacketSent(const SentPacket& packet);
+  // Returns the sample of the most recently sent packet acknowledged by the
+  // feedback, if any.
+  absl::optional<Sample> OnPacketsFeedback(
+      const std::vector<PacketResult>& packet_feedbacks);
+
+  // Total data acknowledged to have been received.
+  DataSize delivered() const { return delivered_; }
+
+ private:
+  struct PacketState {
+    Timestamp send_time = Timestamp::MinusInfinity();
+    DataSize delivered = DataSize::Zero();
+    Timestamp delivered_time = Timestamp::MinusInfinity();
+    Timestamp first_send_time = Timestamp::MinusInfinity();
+  };
+
+  DataSize delivered_ = DataSize::Zero();
+  // Receive time of the most recently received packet.
+  Timestamp delivered_time_ = Timestamp::MinusInfinity();
+  // Send time of the most recently acknowledged packet, or of the first
+  // packet sent after all packets in flight were acknowledged.
+  Timestamp first_send_time_ = Timestamp::MinusInfinity();
+  std::map<int64_t, PacketState> packets_in_flight_;
+};
+
+}  // namespace bbr
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_BBR_BANDWIDTH_SAMPLER_H_
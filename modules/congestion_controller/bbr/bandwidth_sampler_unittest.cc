@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bandwidth_sampler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace bbr {
+namespace {
+
+constexpr DataSize kPacketSize = DataSize::Bytes(1000);
+constexpr TimeDelta kOneWayDelay = TimeDelta::Millis(50);
+
+class BandwidthSamplerTest : public ::testing::Test {
+ protected:
+  // Sends `num_packets` spaced by `send_interval`, received spaced by
+  // `receive_interval`, and returns their feedback.
+  std::vector<PacketResult> SendPackets(int num_packets,
+                                        TimeDelta send_interval,
+                                        TimeDelta receive_interval) {
+    std::vector<PacketResult> feedback;
+    Timestamp receive_time =
+        std::max(now_ + kOneWayDelay, last_receive_time_ + receive_interval);
+    for (int i = 0; i < num_packets; ++i) {
+      PacketResult packet;
+      packet.sent_packet.send_time = now_;
+      packet.sent_packet.size = kPacketSize;
+      packet.sent_packet.sequence_number = sequence_number_++;
+      packet.receive_time = receive_time;
+      sampler_.OnPacketSent(packet.sent_packet);
+      feedback.push_back(packet);
+      last_receive_time_ = receive_time;
+      now_ += send_interval;
+      receive_time += receive_interval;
+    }
+    return feedback;
+  }
+
+  BandwidthSampler sampler_;
+  Timestamp now_ = Timestamp::Seconds(100);
+  Timestamp last_receive_time_ = Timestamp::Zero();
+  int64_t sequence_number_ = 1;
+};
+
+TEST_F(BandwidthSamplerTest, NoSampleBeforeAnyPacketWasReceived) {
+  EXPECT_EQ(sampler_.OnPacketsFeedback(SendPackets(
+                10, TimeDelta::Millis(1), TimeDelta::Millis(1))),
+            absl::nullopt);
+  EXPECT_EQ(sampler_.delivered(), 10 * kPacketSize);
+}
+
+TEST_F(BandwidthSamplerTest, MeasuresSendRateWhenNotLimitedByPath) {
+  sampler_.OnPacketsFeedback(
+      SendPackets(1, TimeDelta::Millis(1), TimeDelta::Millis(1)));
+  absl::optional<BandwidthSampler::Sample> sample = sampler_.OnPacketsFeedback(
+      SendPackets(100, TimeDelta::Millis(1), TimeDelta::Millis(1)));
+  ASSERT_TRUE(sample);
+  EXPECT_NEAR(sample->delivery_rate.kbps(), 8000, 100);
+  EXPECT_EQ(sample->prior_delivered, kPacketSize);
+}
+
+TEST_F(BandwidthSamplerTest, MeasuresReceiveRateOfBottleneck) {
+  sampler_.OnPacketsFeedback(
+      SendPackets(1, TimeDelta::Millis(1), TimeDelta::Millis(1)));
+  // Sent at 8 Mbps, received at 2 Mbps.
+  absl::optional<BandwidthSampler::Sample> sample = sampler_.OnPacketsFeedback(
+      SendPackets(100, TimeDelta::Millis(1), TimeDelta::Millis(4)));
+  ASSERT_TRUE(sample);
+  EXPECT_NEAR(sample->delivery_rate.kbps(), 2000, 50);
+}
+
+TEST_F(BandwidthSamplerTest, LostPacketsAreNotDelivered) {
+  std::vector<PacketResult> feedback =
+      SendPackets(4, TimeDelta::Millis(1), TimeDelta::Millis(1));
+  feedback[1].receive_time = Timestamp::PlusInfinity();
+  sampler_.OnPacketsFeedback(feedback);
+  EXPECT_EQ(sampler_.delivered(), 3 * kPacketSize);
+
+  // Repeated feedback is ignored.
+  sampler_.OnPacketsFeedback(feedback);
+  EXPECT_EQ(sampler_.delivered(), 3 * kPacketSize);
+}
+
+TEST_F(BandwidthSamplerTest, IgnoresFeedbackForUnknownPackets) {
+  PacketResult packet;
+  packet.sent_packet.sequence_number = 1234;
+  packet.sent_packet.size = kPacketSize;
+  packet.receive_time = now_;
+  EXPECT_EQ(sampler_.OnPacketsFeedback({packet}), absl::nullopt);
+  EXPECT_EQ(sampler_.delivered(), DataSize::Zero());
+}
+
+}  // namespace
+}  // namespace bbr
+}  // namespace webrtc
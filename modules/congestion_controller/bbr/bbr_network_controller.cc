@@ -0,0 +1,376 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bbr_network_controller.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace bbr {
+namespace {
+constexpr DataRate kDefaultStartingRate = DataRate::KilobitsPerSec(300);
+// Used for the bandwidth-delay product before the first round trip time
+// sample.
+constexpr TimeDelta kInitialRtt = TimeDelta::Millis(100);
+
+// 2/ln(2), the lowest gain which doubles the delivery rate every round trip.
+constexpr double kStartupGain = 2.885;
+constexpr double kDrainGain = 1 / kStartupGain;
+constexpr double kCongestionWindowGain = 2;
+// One phase, of about one round trip, probing for more bandwidth, one
+// draining the queue that may have built up, and six cruising at the
+// estimate.
+constexpr double kProbeBwGains[] = {1.25, 0.75, 1, 1, 1, 1, 1, 1};
+constexpr int kProbeBwPhases = std::size(kProbeBwGains);
+constexpr int kProbeBwCruiseIndex = 2;
+
+constexpr int kBandwidthWindowRounds = 10;
+constexpr double kFullBandwidthGrowth = 1.25;
+constexpr int kFullBandwidthRounds = 3;
+
+// Round trips with more loss than this are taken as a sign of overshooting.
+constexpr double kLossThreshold = 0.02;
+constexpr int kMinLostPacketsPerRound = 2;
+constexpr double kLossBeta = 0.7;
+
+constexpr TimeDelta kMinRttWindow = TimeDelta::Seconds(5);
+constexpr TimeDelta kProbeRttDuration = TimeDelta::Millis(200);
+constexpr double kProbeRttCongestionWindowGain = 0.5;
+constexpr DataSize kMinCongestionWindow = DataSize::Bytes(4 * 1200);
+
+constexpr TimeDelta kPacerTimeWindow = TimeDelta::Seconds(1);
+}  // namespace
+
+BbrNetworkController::BbrNetworkController(NetworkControllerConfig config)
+    : starting_rate_(
+          config.constraints.starting_rate.value_or(kDefaultStartingRate)),
+      max_bandwidth_(kBandwidthWindowRounds) {
+  UpdateConstraints(config.constraints);
+}
+
+BbrNetworkController::~BbrNetworkController() {}
+
+void BbrNetworkController::Reset() {
+  mode_ = Mode::kStartup;
+  max_bandwidth_.Reset();
+  max_bandwidth_estimate_ = absl::nullopt;
+  bandwidth_lo_ = DataRate::PlusInfinity();
+  min_rtt_ = TimeDelta::PlusInfinity();
+  min_rtt_time_ = Timestamp::MinusInfinity();
+  full_bandwidth_ = DataRate::Zero();
+  full_bandwidth_rounds_ = 0;
+  full_bandwidth_reached_ = false;
+  probe_rtt_done_time_ = Timestamp::PlusInfinity();
+  round_packets_ = 0;
+  round_lost_packets_ = 0;
+  round_max_delivery_rate_ = DataRate::Zero();
+  last_round_loss_ratio_ = 0;
+}
+
+void BbrNetworkController::UpdateConstraints(
+    const TargetRateConstraints& constraints) {
+  min_rate_ = constraints.min_data_rate.value_or(DataRate::Zero());
+  max_rate_ = constraints.max_data_rate.value_or(DataRate::PlusInfinity());
+  if (constraints.starting_rate) {
+    starting_rate_ = *constraints.starting_rate;
+  }
+}
+
+DataRate BbrNetworkController::BandwidthEstimate() const {
+  DataRate bandwidth = max_bandwidth_estimate_.value_or(starting_rate_);
+  if (!full_bandwidth_reached_) {
+    // Startup doesn't go below the starting rate before it has ended.
+    bandwidth = std::max(bandwidth, starting_rate_);
+  }
+  return std::min({bandwidth, bandwidth_lo_, max_rate_});
+}
+
+DataSize BbrNetworkController::Bdp() const {
+  return BandwidthEstimate() * (min_rtt_.IsFinite() ? min_rtt_ : kInitialRtt);
+}
+
+double BbrNetworkController::PacingGain() const {
+  switch (mode_) {
+    case Mode::kStartup:
+      return kStartupGain;
+    case Mode::kDrain:
+      return kDrainGain;
+    case Mode::kProbeBw:
+      return kProbeBwGains[cycle_index_];
+    case Mode::kProbeRtt:
+      return 1;
+  }
+  RTC_CHECK_NOTREACHED();
+}
+
+DataSize BbrNetworkController::CongestionWindow() const {
+  double gain = kCongestionWindowGain;
+  if (mode_ == Mode::kStartup) {
+    gain = kStartupGain;
+  } else if (mode_ == Mode::kProbeRtt) {
+    gain = kProbeRttCongestionWindowGain;
+  }
+  return std::max(gain * Bdp(), kMinCongestionWindow);
+}
+
+NetworkControlUpdate BbrNetworkController::CreateUpdate(
+    Timestamp at_time) const {
+  const DataRate bandwidth = BandwidthEstimate();
+  const DataRate target_rate = std::max(bandwidth, min_rate_);
+  const DataRate pacing_rate = std::max(PacingGain() * bandwidth, min_rate_);
+
+  NetworkControlUpdate update;
+  TargetTransferRate target_rate_msg;
+  target_rate_msg.at_time = at_time;
+  target_rate_msg.network_estimate.at_time = at_time;
+  target_rate_msg.network_estimate.round_trip_time =
+      min_rtt_.IsFinite() ? min_rtt_ : kInitialRtt;
+  target_rate_msg.network_estimate.bwe_period =
+      kProbeBwPhases * target_rate_msg.network_estimate.round_trip_time;
+  target_rate_msg.network_estimate.loss_rate_ratio = last_round_loss_ratio_;
+  target_rate_msg.target_rate = target_rate;
+  target_rate_msg.stable_target_rate = target_rate;
+  update.target_rate = target_rate_msg;
+
+  // Padding makes up for the media not filling the pacing rate while probing
+  // for more bandwidth.
+  PacerConfig pacer_config;
+  pacer_config.at_time = at_time;
+  pacer_config.time_window = kPacerTimeWindow;
+  pacer_config.data_window = pacing_rate * kPacerTimeWindow;
+  pacer_config.pad_window =
+      PacingGain() > 1 ? pacer_config.data_window : DataSize::Zero();
+  update.pacer_config = pacer_config;
+
+  if (min_rtt_.IsFinite()) {
+    update.congestion_window = CongestionWindow();
+  }
+  return update;
+}
+
+NetworkControlUpdate BbrNetworkController::OnNetworkAvailability(
+    NetworkAvailability msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnNetworkRouteChange(
+    NetworkRouteChange msg) {
+  UpdateConstraints(msg.constraints);
+  Reset();
+  return CreateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate BbrNetworkController::OnProcessInterval(
+    ProcessInterval msg) {
+  return CreateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate BbrNetworkController::OnSentPacket(SentPacket msg) {
+  bandwidth_sampler_.OnPacketSent(msg);
+  data_in_flight_ = msg.data_in_flight;
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnTargetRateConstraints(
+    TargetRateConstraints msg) {
+  UpdateConstraints(msg);
+  return CreateUpdate(msg.at_time);
+}
+
+NetworkControlUpdate BbrNetworkController::OnTransportPacketsFeedback(
+    TransportPacketsFeedback msg) {
+  if (msg.packet_feedbacks.empty()) {
+    return NetworkControlUpdate();
+  }
+  data_in_flight_ = msg.data_in_flight;
+  const bool min_rtt_expired = UpdateMinRtt(msg);
+
+  for (const PacketResult& packet : msg.packet_feedbacks) {
+    ++round_packets_;
+    if (!packet.IsReceived()) {
+      ++round_lost_packets_;
+    }
+  }
+  bool high_loss = false;
+  absl::optional<BandwidthSampler::Sample> sample =
+      bandwidth_sampler_.OnPacketsFeedback(msg.packet_feedbacks);
+  if (sample) {
+    round_max_delivery_rate_ =
+        std::max(round_max_delivery_rate_, sample->delivery_rate);
+    max_bandwidth_.Add(sample->delivery_rate.bps(), round_count_);
+    const bool round_end = sample->prior_delivered >= next_round_delivered_;
+    if (round_end) {
+      high_loss = OnRoundEnd();
+    }
+    max_bandwidth_estimate_ =
+        DataRate::BitsPerSec(*max_bandwidth_.Max(round_count_));
+    if (round_end && mode_ == Mode::kStartup) {
+      CheckFullBandwidthReached(high_loss);
+    }
+  }
+
+  UpdateMode(msg.feedback_time, high_loss, min_rtt_expired);
+  return CreateUpdate(msg.feedback_time);
+}
+
+bool BbrNetworkController::UpdateMinRtt(const TransportPacketsFeedback& msg) {
+  const bool expired = min_rtt_time_.IsFinite() &&
+                       msg.feedback_time - min_rtt_time_ > kMinRttWindow;
+  // The most recently sent packet has waited the least for the feedback.
+  Timestamp last_send_time = Timestamp::MinusInfinity();
+  for (const PacketResult& packet : msg.packet_feedbacks) {
+    if (packet.IsReceived()) {
+      last_send_time = std::max(last_send_time, packet.sent_packet.send_time);
+    }
+  }
+  if (last_send_time.IsFinite()) {
+    TimeDelta rtt = msg.feedback_time - last_send_time;
+    if (rtt < min_rtt_ || expired) {
+      min_rtt_ = rtt;
+      min_rtt_time_ = msg.feedback_time;
+    }
+  }
+  return expired;
+}
+
+bool BbrNetworkController::OnRoundEnd() {
+  ++round_count_;
+  next_round_delivered_ = bandwidth_sampler_.delivered();
+
+  const bool high_loss =
+      round_lost_packets_ >= kMinLostPacketsPerRound &&
+      round_lost_packets_ > kLossThreshold * round_packets_;
+  last_round_loss_ratio_ =
+      round_packets_ > 0
+          ? static_cast<double>(round_lost_packets_) / round_packets_
+          : 0;
+  if (high_loss && max_bandwidth_estimate_) {
+    bandwidth_lo_ =
+        std::max(round_max_delivery_rate_,
+                 kLossBeta * std::min(bandwidth_lo_, *max_bandwidth_estimate_));
+  }
+  round_packets_ = 0;
+  round_lost_packets_ = 0;
+  round_max_delivery_rate_ = DataRate::Zero();
+  return high_loss;
+}
+
+void BbrNetworkController::CheckFullBandwidthReached(bool high_loss) {
+  if (full_bandwidth_reached_) {
+    return;
+  }
+  if (high_loss) {
+    full_bandwidth_reached_ = true;
+    return;
+  }
+  DataRate bandwidth = BandwidthEstimate();
+  if (bandwidth >= kFullBandwidthGrowth * full_bandwidth_) {
+    full_bandwidth_ = bandwidth;
+    full_bandwidth_rounds_ = 0;
+    return;
+  }
+  if (++full_bandwidth_rounds_ >= kFullBandwidthRounds) {
+    full_bandwidth_reached_ = true;
+  }
+}
+
+void BbrNetworkController::UpdateMode(Timestamp at_time,
+                                      bool high_loss,
+                                      bool min_rtt_expired) {
+  switch (mode_) {
+    case Mode::kStartup:
+      if (full_bandwidth_reached_) {
+        mode_ = Mode::kDrain;
+      }
+      break;
+    case Mode::kDrain:
+      // Handled below, also right after startup has ended.
+      break;
+    case Mode::kProbeBw:
+      if (cycle_index_ == 0 && high_loss) {
+        // Stop probing as soon as it causes loss.
+        EnterProbeBw(at_time, 1);
+      } else if (at_time - cycle_start_time_ >= min_rtt_) {
+        EnterProbeBw(at_time, (cycle_index_ + 1) % kProbeBwPhases);
+      }
+      break;
+    case Mode::kProbeRtt:
+      if (probe_rtt_done_time_.IsInfinite()) {
+        if (data_in_flight_ <= CongestionWindow()) {
+          probe_rtt_done_time_ = at_time + kProbeRttDuration;
+          probe_rtt_round_ = round_count_;
+        }
+      } else if (at_time >= probe_rtt_done_time_ &&
+                 round_count_ > probe_rtt_round_) {
+        min_rtt_time_ = at_time;
+        probe_rtt_done_time_ = Timestamp::PlusInfinity();
+        if (full_bandwidth_reached_) {
+          EnterProbeBw(at_time, kProbeBwCruiseIndex);
+        } else {
+          mode_ = Mode::kStartup;
+        }
+      }
+      break;
+  }
+
+  if (mode_ == Mode::kDrain && data_in_flight_ <= Bdp()) {
+    EnterProbeBw(at_time, kProbeBwCruiseIndex);
+  }
+  if (mode_ != Mode::kProbeRtt && min_rtt_expired && min_rtt_.IsFinite()) {
+    mode_ = Mode::kProbeRtt;
+    probe_rtt_done_time_ = Timestamp::PlusInfinity();
+  }
+}
+
+void BbrNetworkController::EnterProbeBw(Timestamp at_time, int cycle_index) {
+  mode_ = Mode::kProbeBw;
+  cycle_index_ = cycle_index;
+  cycle_start_time_ = at_time;
+  if (cycle_index_ == 0) {
+    // Probing again, the loss that lowered the estimate may have been
+    // transient.
+    bandwidth_lo_ = DataRate::PlusInfinity();
+  }
+}
+
+NetworkControlUpdate BbrNetworkController::OnStreamsConfig(StreamsConfig msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnRemoteBitrateReport(
+    RemoteBitrateReport msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnRoundTripTimeUpdate(
+    RoundTripTimeUpdate msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnTransportLossReport(
+    TransportLossReport msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnReceivedPacket(
+    ReceivedPacket msg) {
+  return NetworkControlUpdate();
+}
+
+NetworkControlUpdate BbrNetworkController::OnNetworkStateEstimate(
+    NetworkStateEstimate msg) {
+  return NetworkControlUpdate();
+}
+
+}  // namespace bbr
+}  // namespace webrtc
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_BBR_BBR_NETWORK_CONTROLLER_H_
+#define MODULES_CONGESTION_CONTROLLER_BBR_BBR_NETWORK_CONTROLLER_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "api/transport/network_control.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/congestion_controller/bbr/bandwidth_sampler.h"
+#include "rtc_base/numerics/moving_max_counter.h"
+
+namespace webrtc {
+namespace bbr {
+
+// BBR (Bottleneck Bandwidth and Round-trip propagation time) builds a model
+// of the path from the maximum recent delivery rate and the minimum recent
+// round trip time, and paces at, and keeps in flight, multiples of them.
+// It does not back off on delay increases or random loss, which makes it
+// better than delay based controllers at using links with a large
+// bandwidth-delay product and shallow buffers.
+// See https://datatracker.ietf.org/doc/html/draft-cardwell-iccrg-bbr-congestion-control
+// Like BBRv2, the bandwidth estimate is bounded from below by the delivery
+// rate of round trips with excessive loss, until the next probe for more
+// bandwidth. Probing above the media rate is done with padding.
+class BbrNetworkController : public NetworkControllerInterface {
+ public:
+  enum class Mode {
+    // Doubles the sending rate every round trip until the estimate stops
+    // growing.
+    kStartup,
+    // Drains the queue built up during startup.
+    kDrain,
+    // Cycles through sending above, below, and at the estimate.
+    kProbeBw,
+    // Reduces the data in flight to refresh the minimum round trip time.
+    kProbeRtt,
+  };
+
+  explicit BbrNetworkController(NetworkControllerConfig config);
+  ~BbrNetworkController() override;
+
+  // NetworkControllerInterface
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override;
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override;
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override;
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override;
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override;
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override;
+
+  // Not used by BBR.
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override;
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override;
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override;
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport msg) override;
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket msg) override;
+  NetworkControlUpdate OnNetworkStateEstimate(
+      NetworkStateEstimate msg) override;
+
+  Mode mode() const { return mode_; }
+
+ private:
+  void Reset();
+  void UpdateConstraints(const TargetRateConstraints& constraints);
+  // Returns true if the minimum round trip time had expired.
+  bool UpdateMinRtt(const TransportPacketsFeedback& msg);
+  // Returns true if the round trip had excessive loss.
+  bool OnRoundEnd();
+  void CheckFullBandwidthReached(bool high_loss);
+  void UpdateMode(Timestamp at_time, bool high_loss, bool min_rtt_expired);
+  void EnterProbeBw(Timestamp at_time, int cycle_index);
+
+  DataRate BandwidthEstimate() const;
+  // Bandwidth-delay product, the data in flight needed to use the bandwidth.
+  DataSize Bdp() const;
+  double PacingGain() const;
+  DataSize CongestionWindow() const;
+  NetworkControlUpdate CreateUpdate(Timestamp at_time) const;
+
+  DataRate starting_rate_;
+  DataRate min_rate_ = DataRate::Zero();
+  DataRate max_rate_ = DataRate::PlusInfinity();
+
+  BandwidthSampler bandwidth_sampler_;
+  Mode mode_ = Mode::kStartup;
+
+  // Round trips are counted by the data delivered, a round ends when a packet
+  // sent after it started is acknowledged.
+  int64_t round_count_ = 0;
+  DataSize next_round_delivered_ = DataSize::Zero();
+  int round_packets_ = 0;
+  int round_lost_packets_ = 0;
+  DataRate round_max_delivery_rate_ = DataRate::Zero();
+  double last_round_loss_ratio_ = 0;
+
+  // Maximum delivery rate over the last round trips, in bps, by round count.
+  rtc::MovingMaxCounter<int64_t> max_bandwidth_;
+  absl::optional<DataRate> max_bandwidth_estimate_;
+  // Lower bound of the estimate after round trips with excessive loss.
+  DataRate bandwidth_lo_ = DataRate::PlusInfinity();
+
+  TimeDelta min_rtt_ = TimeDelta::PlusInfinity();
+  Timestamp min_rtt_time_ = Timestamp::MinusInfinity();
+
+  // Startup ends when the estimate stops growing.
+  DataRate full_bandwidth_ = DataRate::Zero();
+  int full_bandwidth_rounds_ = 0;
+  bool full_bandwidth_reached_ = false;
+
+  int cycle_index_ = 0;
+  Timestamp cycle_start_time_ = Timestamp::MinusInfinity();
+
+  Timestamp probe_rtt_done_time_ = Timestamp::PlusInfinity();
+  int64_t probe_rtt_round_ = 0;
+
+  DataSize data_in_flight_ = DataSize::Zero();
+};
+
+}  // namespace bbr
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_BBR_BBR_NETWORK_CONTROLLER_H_
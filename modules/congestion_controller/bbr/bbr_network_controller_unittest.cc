@@ -0,0 +1,273 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/bbr/bbr_network_controller.h"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace bbr {
+namespace {
+
+using ::testing::Ge;
+using ::testing::Property;
+
+constexpr DataRate kStartingRate = DataRate::KilobitsPerSec(300);
+constexpr DataSize kPacketSize = DataSize::Bytes(1200);
+constexpr TimeDelta kTick = TimeDelta::Millis(1);
+constexpr TimeDelta kFeedbackInterval = TimeDelta::Millis(50);
+constexpr TimeDelta kProcessInterval = TimeDelta::Millis(25);
+
+NetworkControllerConfig InitialConfig(
+    DataRate max_rate = DataRate::PlusInfinity()) {
+  NetworkControllerConfig config;
+  config.constraints.at_time = Timestamp::Seconds(1000);
+  config.constraints.min_data_rate = DataRate::KilobitsPerSec(30);
+  config.constraints.max_data_rate = max_rate;
+  config.constraints.starting_rate = kStartingRate;
+  return config;
+}
+
+struct LinkConfig {
+  DataRate capacity = DataRate::KilobitsPerSec(2000);
+  TimeDelta one_way_delay = TimeDelta::Millis(25);
+  // Packets which would queue for longer are dropped.
+  TimeDelta max_queue_delay = TimeDelta::Millis(100);
+};
+
+// Sends media at the target rate, and padding up to the pacing rate when
+// asked to, over a single bottleneck link, and feeds the transport feedback
+// back to the controller.
+class LinkSimulation {
+ public:
+  explicit LinkSimulation(LinkConfig link,
+                          NetworkControllerConfig config = InitialConfig())
+      : link_(link), now_(config.constraints.at_time), controller_(config) {
+    Apply(controller_.OnProcessInterval({.at_time = now_}));
+  }
+
+  void RunFor(TimeDelta duration) {
+    const Timestamp end_time = now_ + duration;
+    while (now_ < end_time) {
+      now_ += kTick;
+      ++ticks_;
+      SendPackets();
+      if (ticks_ % (kFeedbackInterval.ms() / kTick.ms()) == 0) {
+        CreateFeedback();
+      }
+      while (!feedbacks_.empty() && feedbacks_.front().feedback_time <= now_) {
+        for (const PacketResult& packet :
+             feedbacks_.front().packet_feedbacks) {
+          data_in_flight_ -= packet.sent_packet.size;
+        }
+        feedbacks_.front().data_in_flight = data_in_flight_;
+        Apply(controller_.OnTransportPacketsFeedback(feedbacks_.front()));
+        feedbacks_.pop_front();
+      }
+      if (ticks_ % (kProcessInterval.ms() / kTick.ms()) == 0) {
+        Apply(controller_.OnProcessInterval({.at_time = now_}));
+      }
+    }
+  }
+
+  void SetLink(LinkConfig link) { link_ = link; }
+
+  BbrNetworkController& controller() { return controller_; }
+  DataRate target_rate() const { return target_rate_; }
+  DataRate pacing_rate() const { return pacing_rate_; }
+  DataRate padding_rate() const { return padding_rate_; }
+  DataSize congestion_window() const { return congestion_window_; }
+  TimeDelta max_queue_delay() const { return max_queue_delay_; }
+  void ResetMaxQueueDelay() { max_queue_delay_ = TimeDelta::Zero(); }
+
+ private:
+  void Apply(const NetworkControlUpdate& update) {
+    if (update.target_rate) {
+      target_rate_ = update.target_rate->target_rate;
+    }
+    if (update.pacer_config) {
+      pacing_rate_ = update.pacer_config->data_rate();
+      padding_rate_ = update.pacer_config->pad_rate();
+    }
+    if (update.congestion_window) {
+      congestion_window_ = *update.congestion_window;
+    }
+  }
+
+  void SendPackets() {
+    DataRate send_rate =
+        std::min(std::max(target_rate_, padding_rate_), pacing_rate_);
+    budget_ = std::min(budget_ + send_rate * kTick, 4 * kPacketSize);
+    while (budget_ >= kPacketSize &&
+           data_in_flight_ + kPacketSize <= congestion_window_) {
+      budget_ -= kPacketSize;
+      data_in_flight_ += kPacketSize;
+
+      PacketResult packet;
+      packet.sent_packet.send_time = now_;
+      packet.sent_packet.size = kPacketSize;
+      packet.sent_packet.sequence_number = sequence_number_++;
+      packet.sent_packet.data_in_flight = data_in_flight_;
+      controller_.OnSentPacket(packet.sent_packet);
+
+      TimeDelta queue_delay =
+          std::max(link_free_time_ - now_, TimeDelta::Zero());
+      if (queue_delay <= link_.max_queue_delay) {
+        max_queue_delay_ = std::max(max_queue_delay_, queue_delay);
+        link_free_time_ = now_ + queue_delay + kPacketSize / link_.capacity;
+        packet.receive_time = link_free_time_ + link_.one_way_delay;
+      }
+      in_network_.push_back(packet);
+    }
+  }
+
+  void CreateFeedback() {
+    TransportPacketsFeedback feedback;
+    feedback.feedback_time = now_ + link_.one_way_delay;
+    while (!in_network_.empty() &&
+           (in_network_.front().receive_time <= now_ ||
+            (!in_network_.front().IsReceived() &&
+             in_network_.front().sent_packet.send_time +
+                     link_.one_way_delay <=
+                 now_))) {
+      feedback.packet_feedbacks.push_back(in_network_.front());
+      in_network_.pop_front();
+    }
+    if (!feedback.packet_feedbacks.empty()) {
+      feedbacks_.push_back(feedback);
+    }
+  }
+
+  LinkConfig link_;
+  Timestamp now_;
+  int64_t ticks_ = 0;
+  BbrNetworkController controller_;
+
+  DataRate target_rate_ = DataRate::Zero();
+  DataRate pacing_rate_ = DataRate::Zero();
+  DataRate padding_rate_ = DataRate::Zero();
+  DataSize congestion_window_ = DataSize::PlusInfinity();
+
+  DataSize budget_ = DataSize::Zero();
+  DataSize data_in_flight_ = DataSize::Zero();
+  int64_t sequence_number_ = 1;
+  Timestamp link_free_time_ = Timestamp::Zero();
+  TimeDelta max_queue_delay_ = TimeDelta::Zero();
+  std::deque<PacketResult> in_network_;
+  std::deque<TransportPacketsFeedback> feedbacks_;
+};
+
+TEST(BbrNetworkControllerTest, SendsConfigurationOnFirstProcess) {
+  BbrNetworkController controller(InitialConfig());
+  NetworkControlUpdate update =
+      controller.OnProcessInterval({.at_time = Timestamp::Seconds(1000)});
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(update.target_rate->target_rate, kStartingRate);
+  ASSERT_TRUE(update.pacer_config);
+  // Startup probes with padding.
+  EXPECT_THAT(*update.pacer_config,
+              Property(&PacerConfig::data_rate, Ge(2 * kStartingRate)));
+  EXPECT_EQ(update.pacer_config->pad_rate(), update.pacer_config->data_rate());
+  EXPECT_EQ(controller.mode(), BbrNetworkController::Mode::kStartup);
+}
+
+TEST(BbrNetworkControllerTest, FactoryCreatesController) {
+  BbrNetworkControllerFactory factory;
+  std::unique_ptr<NetworkControllerInterface> controller =
+      factory.Create(InitialConfig());
+  ASSERT_TRUE(controller);
+  EXPECT_TRUE(
+      controller->OnProcessInterval({.at_time = Timestamp::Seconds(1000)})
+          .has_updates());
+  EXPECT_TRUE(factory.GetProcessInterval().IsFinite());
+}
+
+TEST(BbrNetworkControllerTest, ConvergesToLinkCapacity) {
+  LinkSimulation simulation({.capacity = DataRate::KilobitsPerSec(2000)});
+  simulation.RunFor(TimeDelta::Seconds(3));
+  EXPECT_EQ(simulation.controller().mode(),
+            BbrNetworkController::Mode::kProbeBw);
+  EXPECT_NEAR(simulation.target_rate().kbps(), 2000, 200);
+
+  simulation.ResetMaxQueueDelay();
+  simulation.RunFor(TimeDelta::Seconds(10));
+  EXPECT_NEAR(simulation.target_rate().kbps(), 2000, 200);
+  // Only probing for more bandwidth builds up a short queue.
+  EXPECT_LT(simulation.max_queue_delay(), TimeDelta::Millis(50));
+}
+
+TEST(BbrNetworkControllerTest, UsesHighBdpLinkWithShallowBuffer) {
+  LinkSimulation simulation({.capacity = DataRate::KilobitsPerSec(20'000),
+                             .one_way_delay = TimeDelta::Millis(100),
+                             .max_queue_delay = TimeDelta::Millis(10)});
+  simulation.RunFor(TimeDelta::Seconds(10));
+  EXPECT_GT(simulation.target_rate().kbps(), 17'000);
+  EXPECT_LE(simulation.target_rate().kbps(), 21'000);
+}
+
+TEST(BbrNetworkControllerTest, FollowsCapacityDecrease) {
+  LinkSimulation simulation({.capacity = DataRate::KilobitsPerSec(5000)});
+  simulation.RunFor(TimeDelta::Seconds(5));
+  EXPECT_NEAR(simulation.target_rate().kbps(), 5000, 500);
+
+  simulation.SetLink({.capacity = DataRate::KilobitsPerSec(1000)});
+  simulation.RunFor(TimeDelta::Seconds(3));
+  EXPECT_NEAR(simulation.target_rate().kbps(), 1000, 150);
+}
+
+TEST(BbrNetworkControllerTest, FollowsCapacityIncrease) {
+  LinkSimulation simulation({.capacity = DataRate::KilobitsPerSec(1000)});
+  simulation.RunFor(TimeDelta::Seconds(5));
+  simulation.SetLink({.capacity = DataRate::KilobitsPerSec(2000)});
+  simulation.RunFor(TimeDelta::Seconds(10));
+  EXPECT_NEAR(simulation.target_rate().kbps(), 2000, 250);
+}
+
+TEST(BbrNetworkControllerTest, RefreshesMinRttWithProbeRtt) {
+  LinkSimulation simulation({.capacity = DataRate::KilobitsPerSec(2000)});
+  simulation.RunFor(TimeDelta::Seconds(3));
+  bool probed_rtt = false;
+  for (int i = 0; i < 100 && !probed_rtt; ++i) {
+    simulation.RunFor(TimeDelta::Millis(100));
+    probed_rtt = simulation.controller().mode() ==
+                 BbrNetworkController::Mode::kProbeRtt;
+  }
+  EXPECT_TRUE(probed_rtt);
+  EXPECT_LT(simulation.congestion_window(),
+            simulation.target_rate() * TimeDelta::Millis(50));
+  simulation.RunFor(TimeDelta::Seconds(1));
+  EXPECT_EQ(simulation.controller().mode(),
+            BbrNetworkController::Mode::kProbeBw);
+}
+
+TEST(BbrNetworkControllerTest, RespectsMaxRate) {
+  LinkSimulation simulation({.capacity = DataRate::KilobitsPerSec(5000)},
+                            InitialConfig(DataRate::KilobitsPerSec(1000)));
+  simulation.RunFor(TimeDelta::Seconds(5));
+  EXPECT_EQ(simulation.target_rate(), DataRate::KilobitsPerSec(1000));
+  EXPECT_EQ(simulation.controller().mode(),
+            BbrNetworkController::Mode::kProbeBw);
+}
+
+}  // namespace
+}  // namespace bbr
+}  // namespace webrtc
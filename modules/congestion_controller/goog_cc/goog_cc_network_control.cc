@@ -510,17 +510,13 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
     probe_controller_->SetAlrEndedTimeMs(now_ms);
   }
   previously_in_alr_ = alr_start_time.has_value();
+  std::vector<PacketResult> received_packets = report.SortedByReceiveTime();
   acknowledged_bitrate_estimator_->IncomingPacketFeedbackVector(
-      report.SortedByReceiveTime());
+      received_packets);
   auto acknowledged_bitrate = acknowledged_bitrate_estimator_->bitrate();
   bandwidth_estimation_->SetAcknowledgedRate(acknowledged_bitrate,
                                              report.feedback_time);
-  for (const auto& feedback : report.SortedByReceiveTime()) {
-    if (feedback.sent_packet.pacing_info.probe_cluster_id !=
-        PacedPacketInfo::kNotAProbe) {
-      probe_bitrate_estimator_->HandleProbeAndEstimateBitrate(feedback);
-    }
-  }
+  probe_bitrate_estimator_->HandleProbesAndEstimateBitrate(received_packets);
 
   if (network_estimator_) {
     network_estimator_->OnTransportPacketsFeedback(report);
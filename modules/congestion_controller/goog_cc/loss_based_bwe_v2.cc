@@ -14,6 +14,7 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
+#include <iterator>
 #include <limits>
 #include <vector>
 
@@ -131,6 +132,7 @@ LossBasedBweV2::LossBasedBweV2(const FieldTrialsView* key_value_config)
   temporal_weights_.resize(config_->observation_window_size);
   instant_upper_bound_temporal_weights_.resize(
       config_->observation_window_size);
+  weighted_observations_.reserve(config_->observation_window_size);
   CalculateTemporalWeights();
   last_hold_info_.duration = kInitHoldDuration;
 }
@@ -805,7 +807,12 @@ bool LossBasedBweV2::IsConfigValid() const {
 }
 
 double LossBasedBweV2::GetAverageReportedLossRatio() const {
-  return config_->use_byte_loss_rate ? GetAverageReportedByteLossRatio()
+  return average_reported_loss_ratio_;
+}
+
+void LossBasedBweV2::CalculateAverageReportedLossRatio() {
+  average_reported_loss_ratio_ = config_->use_byte_loss_rate
+                                     ? GetAverageReportedByteLossRatio()
                                      : GetAverageReportedPacketLossRatio();
 }
 
@@ -928,40 +935,35 @@ LossBasedBweV2::Derivatives LossBasedBweV2::GetDerivatives(
     const ChannelParameters& channel_parameters) const {
   Derivatives derivatives;
 
-  for (const Observation& observation : observations_) {
-    if (!observation.IsInitialized()) {
-      continue;
-    }
-
+  // Observations sent at no more than the loss limited bandwidth all have the
+  // inherent loss as loss probability, so their sums are used as is.
+  auto loss_limited = absl::c_upper_bound(
+      weighted_observations_, channel_parameters.loss_limited_bandwidth,
+      [](DataRate bandwidth, const WeightedObservation& observation) {
+        return bandwidth < observation.sending_rate;
+      });
+  if (loss_limited != weighted_observations_.begin()) {
+    const WeightedObservation& observation = *std::prev(loss_limited);
     double loss_probability = GetLossProbability(
         channel_parameters.inherent_loss,
         channel_parameters.loss_limited_bandwidth, observation.sending_rate);
+    derivatives.first += (observation.lost_sum / loss_probability) -
+                         (observation.received_sum / (1.0 - loss_probability));
+    derivatives.second -=
+        (observation.lost_sum / (loss_probability * loss_probability)) +
+        (observation.received_sum /
+         ((1.0 - loss_probability) * (1.0 - loss_probability)));
+  }
 
-    double temporal_weight =
-        temporal_weights_[(num_observations_ - 1) - observation.id];
-    if (config_->use_byte_loss_rate) {
-      derivatives.first +=
-          temporal_weight *
-          ((ToKiloBytes(observation.lost_size) / loss_probability) -
-           (ToKiloBytes(observation.size - observation.lost_size) /
-            (1.0 - loss_probability)));
-      derivatives.second -=
-          temporal_weight *
-          ((ToKiloBytes(observation.lost_size) /
-            std::pow(loss_probability, 2)) +
-           (ToKiloBytes(observation.size - observation.lost_size) /
-            std::pow(1.0 - loss_probability, 2)));
-    } else {
-      derivatives.first +=
-          temporal_weight *
-          ((observation.num_lost_packets / loss_probability) -
-           (observation.num_received_packets / (1.0 - loss_probability)));
-      derivatives.second -=
-          temporal_weight *
-          ((observation.num_lost_packets / std::pow(loss_probability, 2)) +
-           (observation.num_received_packets /
-            std::pow(1.0 - loss_probability, 2)));
-    }
+  for (auto it = loss_limited; it != weighted_observations_.end(); ++it) {
+    double loss_probability = GetLossProbability(
+        channel_parameters.inherent_loss,
+        channel_parameters.loss_limited_bandwidth, it->sending_rate);
+    derivatives.first += (it->lost / loss_probability) -
+                         (it->received / (1.0 - loss_probability));
+    derivatives.second -=
+        (it->lost / (loss_probability * loss_probability)) +
+        (it->received / ((1.0 - loss_probability) * (1.0 - loss_probability)));
   }
 
   if (derivatives.second >= 0.0) {
@@ -1017,39 +1019,36 @@ double LossBasedBweV2::GetHighBandwidthBias(DataRate bandwidth) const {
 
 double LossBasedBweV2::GetObjective(
     const ChannelParameters& channel_parameters) const {
-  double objective = 0.0;
-
-  const double high_bandwidth_bias =
-      GetHighBandwidthBias(channel_parameters.loss_limited_bandwidth);
+  if (weighted_observations_.empty()) {
+    return 0.0;
+  }
 
-  for (const Observation& observation : observations_) {
-    if (!observation.IsInitialized()) {
-      continue;
-    }
+  const WeightedObservation& total = weighted_observations_.back();
+  double objective =
+      GetHighBandwidthBias(channel_parameters.loss_limited_bandwidth) *
+      (total.lost_sum + total.received_sum);
 
+  // See `GetDerivatives`.
+  auto loss_limited = absl::c_upper_bound(
+      weighted_observations_, channel_parameters.loss_limited_bandwidth,
+      [](DataRate bandwidth, const WeightedObservation& observation) {
+        return bandwidth < observation.sending_rate;
+      });
+  if (loss_limited != weighted_observations_.begin()) {
+    const WeightedObservation& observation = *std::prev(loss_limited);
     double loss_probability = GetLossProbability(
         channel_parameters.inherent_loss,
         channel_parameters.loss_limited_bandwidth, observation.sending_rate);
+    objective += (observation.lost_sum * std::log(loss_probability)) +
+                 (observation.received_sum * std::log(1.0 - loss_probability));
+  }
 
-    double temporal_weight =
-        temporal_weights_[(num_observations_ - 1) - observation.id];
-    if (config_->use_byte_loss_rate) {
-      objective +=
-          temporal_weight *
-          ((ToKiloBytes(observation.lost_size) * std::log(loss_probability)) +
-           (ToKiloBytes(observation.size - observation.lost_size) *
-            std::log(1.0 - loss_probability)));
-      objective +=
-          temporal_weight * high_bandwidth_bias * ToKiloBytes(observation.size);
-    } else {
-      objective +=
-          temporal_weight *
-          ((observation.num_lost_packets * std::log(loss_probability)) +
-           (observation.num_received_packets *
-            std::log(1.0 - loss_probability)));
-      objective +=
-          temporal_weight * high_bandwidth_bias * observation.num_packets;
-    }
+  for (auto it = loss_limited; it != weighted_observations_.end(); ++it) {
+    double loss_probability = GetLossProbability(
+        channel_parameters.inherent_loss,
+        channel_parameters.loss_limited_bandwidth, it->sending_rate);
+    objective += (it->lost * std::log(loss_probability)) +
+                 (it->received * std::log(1.0 - loss_probability));
   }
 
   return objective;
@@ -1116,6 +1115,46 @@ void LossBasedBweV2::CalculateTemporalWeights() {
   }
 }
 
+void LossBasedBweV2::CalculateWeightedObservations() {
+  weighted_observations_.clear();
+  for (const Observation& observation : observations_) {
+    if (!observation.IsInitialized()) {
+      continue;
+    }
+
+    double temporal_weight =
+        temporal_weights_[(num_observations_ - 1) - observation.id];
+    WeightedObservation weighted_observation;
+    weighted_observation.sending_rate = observation.sending_rate;
+    if (config_->use_byte_loss_rate) {
+      weighted_observation.lost =
+          temporal_weight * ToKiloBytes(observation.lost_size);
+      weighted_observation.received =
+          temporal_weight *
+          ToKiloBytes(observation.size - observation.lost_size);
+    } else {
+      weighted_observation.lost =
+          temporal_weight * observation.num_lost_packets;
+      weighted_observation.received =
+          temporal_weight * observation.num_received_packets;
+    }
+    weighted_observations_.push_back(weighted_observation);
+  }
+
+  absl::c_sort(weighted_observations_, [](const WeightedObservation& a,
+                                          const WeightedObservation& b) {
+    return a.sending_rate < b.sending_rate;
+  });
+  double lost_sum = 0.0;
+  double received_sum = 0.0;
+  for (WeightedObservation& weighted_observation : weighted_observations_) {
+    lost_sum += weighted_observation.lost;
+    received_sum += weighted_observation.received;
+    weighted_observation.lost_sum = lost_sum;
+    weighted_observation.received_sum = received_sum;
+  }
+}
+
 void LossBasedBweV2::NewtonsMethodUpdate(
     ChannelParameters& channel_parameters) const {
   if (num_observations_ <= 0) {
@@ -1178,6 +1217,8 @@ bool LossBasedBweV2::PushBackObservation(
 
   partial_observation_ = PartialObservation();
 
+  CalculateAverageReportedLossRatio();
+  CalculateWeightedObservations();
   CalculateInstantUpperBound();
   return true;
 }
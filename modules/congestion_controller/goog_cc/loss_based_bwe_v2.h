@@ -143,6 +143,18 @@ class LossBasedBweV2 {
     int id = -1;
   };
 
+  // The loss statistics of an observation, in packets or, if
+  // `use_byte_loss_rate`, in kilobytes, multiplied by its temporal weight.
+  // `lost_sum` and `received_sum` also include all observations with a lower
+  // sending rate.
+  struct WeightedObservation {
+    DataRate sending_rate = DataRate::MinusInfinity();
+    double lost = 0.0;
+    double received = 0.0;
+    double lost_sum = 0.0;
+    double received_sum = 0.0;
+  };
+
   struct PartialObservation {
     int num_packets = 0;
     int num_lost_packets = 0;
@@ -167,6 +179,7 @@ class LossBasedBweV2 {
 
   // Returns `0.0` if not enough loss statistics have been received.
   double GetAverageReportedLossRatio() const;
+  void CalculateAverageReportedLossRatio();
   double GetAverageReportedPacketLossRatio() const;
   double GetAverageReportedByteLossRatio() const;
   std::vector<ChannelParameters> GetCandidates(bool in_alr) const;
@@ -185,6 +198,7 @@ class LossBasedBweV2 {
   void CalculateInstantLowerBound();
 
   void CalculateTemporalWeights();
+  void CalculateWeightedObservations();
   void NewtonsMethodUpdate(ChannelParameters& channel_parameters) const;
 
   // Returns false if no observation was created.
@@ -206,6 +220,11 @@ class LossBasedBweV2 {
   absl::optional<DataRate> cached_instant_lower_bound_;
   std::vector<double> instant_upper_bound_temporal_weights_;
   std::vector<double> temporal_weights_;
+  // Updated with every new observation, sorted by sending rate. Candidates
+  // are evaluated against these instead of `observations_`, see
+  // `GetDerivatives` and `GetObjective`.
+  std::vector<WeightedObservation> weighted_observations_;
+  double average_reported_loss_ratio_ = 0.0;
   Timestamp recovering_after_loss_timestamp_ = Timestamp::MinusInfinity();
   DataRate bandwidth_limit_in_current_window_ = DataRate::PlusInfinity();
   DataRate min_bitrate_ = DataRate::KilobitsPerSec(1);
@@ -12,6 +12,8 @@
 
 #include <algorithm>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/rtc_event_log/rtc_event_log.h"
@@ -70,8 +72,54 @@ absl::optional<DataRate> ProbeBitrateEstimator::HandleProbeAndEstimateBitrate(
   RTC_DCHECK_NE(cluster_id, PacedPacketInfo::kNotAProbe);
 
   EraseOldClusters(packet_feedback.receive_time);
+  const AggregatedCluster& cluster = AddToCluster(packet_feedback);
+  return EstimateBitrate(cluster_id, packet_feedback.sent_packet.pacing_info,
+                         cluster);
+}
+
+absl::optional<DataRate> ProbeBitrateEstimator::HandleProbesAndEstimateBitrate(
+    const std::vector<PacketResult>& packet_feedbacks) {
+  // Clusters updated by this report, ordered by their last packet, with the
+  // pacing info of that packet.
+  std::vector<std::pair<int, PacedPacketInfo>> updated_clusters;
+  for (const PacketResult& packet_feedback : packet_feedbacks) {
+    const PacedPacketInfo& pacing_info =
+        packet_feedback.sent_packet.pacing_info;
+    if (pacing_info.probe_cluster_id == PacedPacketInfo::kNotAProbe) {
+      continue;
+    }
+    if (updated_clusters.empty()) {
+      // A report spans much less than kMaxClusterHistory, so pruning once
+      // per report is enough.
+      EraseOldClusters(packet_feedback.receive_time);
+    }
+    AddToCluster(packet_feedback);
+    auto it = std::find_if(updated_clusters.begin(), updated_clusters.end(),
+                           [&](const std::pair<int, PacedPacketInfo>& entry) {
+                             return entry.first ==
+                                    pacing_info.probe_cluster_id;
+                           });
+    if (it != updated_clusters.end()) {
+      updated_clusters.erase(it);
+    }
+    updated_clusters.emplace_back(pacing_info.probe_cluster_id, pacing_info);
+  }
 
-  AggregatedCluster* cluster = &clusters_[cluster_id];
+  absl::optional<DataRate> estimate;
+  for (const auto& [cluster_id, pacing_info] : updated_clusters) {
+    absl::optional<DataRate> cluster_estimate =
+        EstimateBitrate(cluster_id, pacing_info, clusters_[cluster_id]);
+    if (cluster_estimate) {
+      estimate = cluster_estimate;
+    }
+  }
+  return estimate;
+}
+
+ProbeBitrateEstimator::AggregatedCluster& ProbeBitrateEstimator::AddToCluster(
+    const PacketResult& packet_feedback) {
+  AggregatedCluster* cluster =
+      &clusters_[packet_feedback.sent_packet.pacing_info.probe_cluster_id];
 
   if (packet_feedback.sent_packet.send_time < cluster->first_send) {
     cluster->first_send = packet_feedback.sent_packet.send_time;
@@ -89,24 +137,25 @@ absl::optional<DataRate> ProbeBitrateEstimator::HandleProbeAndEstimateBitrate(
   }
   cluster->size_total += packet_feedback.sent_packet.size;
   cluster->num_probes += 1;
+  return *cluster;
+}
 
-  RTC_DCHECK_GT(
-      packet_feedback.sent_packet.pacing_info.probe_cluster_min_probes, 0);
-  RTC_DCHECK_GT(packet_feedback.sent_packet.pacing_info.probe_cluster_min_bytes,
-                0);
+absl::optional<DataRate> ProbeBitrateEstimator::EstimateBitrate(
+    int cluster_id,
+    const PacedPacketInfo& pacing_info,
+    const AggregatedCluster& cluster) {
+  RTC_DCHECK_GT(pacing_info.probe_cluster_min_probes, 0);
+  RTC_DCHECK_GT(pacing_info.probe_cluster_min_bytes, 0);
 
   int min_probes =
-      packet_feedback.sent_packet.pacing_info.probe_cluster_min_probes *
-      kMinReceivedProbesRatio;
-  DataSize min_size =
-      DataSize::Bytes(
-          packet_feedback.sent_packet.pacing_info.probe_cluster_min_bytes) *
-      kMinReceivedBytesRatio;
-  if (cluster->num_probes < min_probes || cluster->size_total < min_size)
+      pacing_info.probe_cluster_min_probes * kMinReceivedProbesRatio;
+  DataSize min_size = DataSize::Bytes(pacing_info.probe_cluster_min_bytes) *
+                      kMinReceivedBytesRatio;
+  if (cluster.num_probes < min_probes || cluster.size_total < min_size)
     return absl::nullopt;
 
-  TimeDelta send_interval = cluster->last_send - cluster->first_send;
-  TimeDelta receive_interval = cluster->last_receive - cluster->first_receive;
+  TimeDelta send_interval = cluster.last_send - cluster.first_send;
+  TimeDelta receive_interval = cluster.last_receive - cluster.first_receive;
 
   if (send_interval <= TimeDelta::Zero() || send_interval > kMaxProbeInterval ||
       receive_interval <= TimeDelta::Zero() ||
@@ -127,15 +176,15 @@ absl::optional<DataRate> ProbeBitrateEstimator::HandleProbeAndEstimateBitrate(
   // Since the `send_interval` does not include the time it takes to actually
   // send the last packet the size of the last sent packet should not be
   // included when calculating the send bitrate.
-  RTC_DCHECK_GT(cluster->size_total, cluster->size_last_send);
-  DataSize send_size = cluster->size_total - cluster->size_last_send;
+  RTC_DCHECK_GT(cluster.size_total, cluster.size_last_send);
+  DataSize send_size = cluster.size_total - cluster.size_last_send;
   DataRate send_rate = send_size / send_interval;
 
   // Since the `receive_interval` does not include the time it takes to
   // actually receive the first packet the size of the first received packet
   // should not be included when calculating the receive bitrate.
-  RTC_DCHECK_GT(cluster->size_total, cluster->size_first_receive);
-  DataSize receive_size = cluster->size_total - cluster->size_first_receive;
+  RTC_DCHECK_GT(cluster.size_total, cluster.size_first_receive);
+  DataSize receive_size = cluster.size_total - cluster.size_first_receive;
   DataRate receive_rate = receive_size / receive_interval;
 
   double ratio = receive_rate / send_rate;
@@ -12,6 +12,7 @@
 #define MODULES_CONGESTION_CONTROLLER_GOOG_CC_PROBE_BITRATE_ESTIMATOR_H_
 
 #include <map>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/transport/network_types.h"
@@ -32,6 +33,14 @@ class ProbeBitrateEstimator {
   absl::optional<DataRate> HandleProbeAndEstimateBitrate(
       const PacketResult& packet_feedback);
 
+  // Handles all packets of a feedback report, sorted by receive time, at once.
+  // Packets that are not probes are ignored. Each cluster is evaluated once,
+  // after all of its packets in the report have been added, which avoids
+  // re-evaluating (and logging) the estimate for every packet of large
+  // clusters. Returns the last valid estimate, if any.
+  absl::optional<DataRate> HandleProbesAndEstimateBitrate(
+      const std::vector<PacketResult>& packet_feedbacks);
+
   absl::optional<DataRate> FetchAndResetLastEstimatedBitrate();
 
  private:
@@ -46,6 +55,13 @@ class ProbeBitrateEstimator {
     DataSize size_total = DataSize::Zero();
   };
 
+  // Adds the packet to its cluster and returns the cluster.
+  AggregatedCluster& AddToCluster(const PacketResult& packet_feedback);
+  // Returns the estimated bitrate if `cluster` is a valid, complete cluster.
+  absl::optional<DataRate> EstimateBitrate(int cluster_id,
+                                           const PacedPacketInfo& pacing_info,
+                                           const AggregatedCluster& cluster);
+
   // Erases old cluster data that was seen before `timestamp`.
   void EraseOldClusters(Timestamp timestamp);
 
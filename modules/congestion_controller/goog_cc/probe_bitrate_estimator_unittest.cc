@@ -13,6 +13,7 @@
 #include <stddef.h>
 
 #include <cstdint>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/transport/network_types.h"
@@ -42,6 +43,18 @@ class TestProbeBitrateEstimator : public ::testing::Test {
                          int64_t arrival_time_ms,
                          int min_probes = kDefaultMinProbes,
                          int min_bytes = kDefaultMinBytes) {
+    measured_data_rate_ =
+        probe_bitrate_estimator_.HandleProbeAndEstimateBitrate(
+            CreatePacketFeedback(probe_cluster_id, size_bytes, send_time_ms,
+                                 arrival_time_ms, min_probes, min_bytes));
+  }
+
+  static PacketResult CreatePacketFeedback(int probe_cluster_id,
+                                           size_t size_bytes,
+                                           int64_t send_time_ms,
+                                           int64_t arrival_time_ms,
+                                           int min_probes = kDefaultMinProbes,
+                                           int min_bytes = kDefaultMinBytes) {
     const Timestamp kReferenceTime = Timestamp::Seconds(1000);
     PacketResult feedback;
     feedback.sent_packet.send_time =
@@ -50,8 +63,7 @@ class TestProbeBitrateEstimator : public ::testing::Test {
     feedback.sent_packet.pacing_info =
         PacedPacketInfo(probe_cluster_id, min_probes, min_bytes);
     feedback.receive_time = kReferenceTime + TimeDelta::Millis(arrival_time_ms);
-    measured_data_rate_ =
-        probe_bitrate_estimator_.HandleProbeAndEstimateBitrate(feedback);
+    return feedback;
   }
 
  protected:
@@ -232,4 +244,64 @@ TEST_F(TestProbeBitrateEstimator, FetchLastEstimatedBitrateBps) {
   EXPECT_FALSE(probe_bitrate_estimator_.FetchAndResetLastEstimatedBitrate());
 }
 
+TEST_F(TestProbeBitrateEstimator, OneClusterInOneReport) {
+  std::vector<PacketResult> report;
+  for (int i = 0; i < 4; ++i) {
+    report.push_back(CreatePacketFeedback(0, 1000, 10 * i, 10 * i + 10));
+  }
+  // Packets that are not probes are ignored.
+  PacketResult not_a_probe = CreatePacketFeedback(0, 1000, 35, 45);
+  not_a_probe.sent_packet.pacing_info = PacedPacketInfo();
+  report.push_back(not_a_probe);
+
+  absl::optional<DataRate> estimate =
+      probe_bitrate_estimator_.HandleProbesAndEstimateBitrate(report);
+  ASSERT_TRUE(estimate);
+  EXPECT_NEAR(estimate->bps(), 800000, 10);
+  EXPECT_EQ(probe_bitrate_estimator_.FetchAndResetLastEstimatedBitrate(),
+            estimate);
+}
+
+TEST_F(TestProbeBitrateEstimator, ReportWithTooFewProbes) {
+  std::vector<PacketResult> report;
+  for (int i = 0; i < 3; ++i) {
+    report.push_back(CreatePacketFeedback(0, 2000, 10 * i, 10 * i + 10));
+  }
+  EXPECT_FALSE(probe_bitrate_estimator_.HandleProbesAndEstimateBitrate(report));
+}
+
+TEST_F(TestProbeBitrateEstimator, ClusterSpanningReports) {
+  std::vector<PacketResult> first_report = {
+      CreatePacketFeedback(0, 1000, 0, 10),
+      CreatePacketFeedback(0, 1000, 10, 20)};
+  EXPECT_FALSE(
+      probe_bitrate_estimator_.HandleProbesAndEstimateBitrate(first_report));
+
+  std::vector<PacketResult> second_report = {
+      CreatePacketFeedback(0, 1000, 20, 30),
+      CreatePacketFeedback(0, 1000, 30, 40)};
+  absl::optional<DataRate> estimate =
+      probe_bitrate_estimator_.HandleProbesAndEstimateBitrate(second_report);
+  ASSERT_TRUE(estimate);
+  EXPECT_NEAR(estimate->bps(), 800000, 10);
+}
+
+TEST_F(TestProbeBitrateEstimator, MultipleClustersInOneReport) {
+  std::vector<PacketResult> report = {CreatePacketFeedback(0, 1000, 0, 10),
+                                      CreatePacketFeedback(0, 1000, 10, 20),
+                                      CreatePacketFeedback(0, 1000, 20, 30),
+                                      CreatePacketFeedback(0, 1000, 40, 60),
+                                      CreatePacketFeedback(0, 1000, 50, 60),
+                                      CreatePacketFeedback(1, 1000, 60, 70),
+                                      CreatePacketFeedback(1, 1000, 65, 77),
+                                      CreatePacketFeedback(1, 1000, 70, 84),
+                                      CreatePacketFeedback(1, 1000, 75, 90)};
+  // The last cluster, with expected send rate = 1600 kbps and expected receive
+  // rate = 1200 kbps, wins.
+  absl::optional<DataRate> estimate =
+      probe_bitrate_estimator_.HandleProbesAndEstimateBitrate(report);
+  ASSERT_TRUE(estimate);
+  EXPECT_NEAR(estimate->bps(), kTargetUtilizationFraction * 1200000, 10);
+}
+
 }  // namespace webrtc
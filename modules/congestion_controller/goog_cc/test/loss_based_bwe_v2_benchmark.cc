@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string>
+#include <vector>
+
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "benchmark/benchmark.h"
+#include "modules/congestion_controller/goog_cc/loss_based_bwe_v2.h"
+#include "rtc_base/system/unused.h"
+#include "test/explicit_key_value_config.h"
+
+namespace webrtc {
+namespace {
+
+constexpr TimeDelta kFeedbackInterval = TimeDelta::Millis(5);
+constexpr int kPacketsPerFeedback = 10;
+constexpr DataSize kPacketSize = DataSize::Bytes(1200);
+
+// Every feedback creates a new observation, i.e. the candidates are evaluated
+// over the whole observation window on every update, as with per-packet
+// feedback at high bitrates.
+std::string Config(int observation_window_size) {
+  return "WebRTC-Bwe-LossBasedBweV2/ObservationDurationLowerBound:1ms,"
+         "MinNumObservations:1,ObservationWindowSize:" +
+         std::to_string(observation_window_size) + "/";
+}
+
+void BM_UpdateBandwidthEstimate(benchmark::State& state) {
+  test::ExplicitKeyValueConfig key_value_config(
+      Config(static_cast<int>(state.range(0))));
+  LossBasedBweV2 loss_based_bwe(&key_value_config);
+  loss_based_bwe.SetMinMaxBitrate(DataRate::KilobitsPerSec(30),
+                                  DataRate::KilobitsPerSec(50'000));
+  loss_based_bwe.SetAcknowledgedBitrate(DataRate::KilobitsPerSec(15'000));
+
+  std::vector<PacketResult> feedback(kPacketsPerFeedback);
+  Timestamp now = Timestamp::Seconds(1000);
+  int64_t packet_number = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    for (PacketResult& packet : feedback) {
+      packet.sent_packet.size = kPacketSize;
+      packet.sent_packet.send_time =
+          now + kFeedbackInterval * packet_number++ / kPacketsPerFeedback;
+      // 2% loss.
+      packet.receive_time = packet_number % 50 == 0
+                                ? Timestamp::PlusInfinity()
+                                : packet.sent_packet.send_time;
+    }
+    loss_based_bwe.UpdateBandwidthEstimate(feedback,
+                                           DataRate::KilobitsPerSec(20'000),
+                                           /*in_alr=*/false);
+    benchmark::DoNotOptimize(loss_based_bwe.GetLossBasedResult());
+  }
+}
+
+BENCHMARK(BM_UpdateBandwidthEstimate)->Arg(20)->Arg(100);
+
+}  // namespace
+}  // namespace webrtc
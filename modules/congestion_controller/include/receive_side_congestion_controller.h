@@ -11,6 +11,7 @@
 #ifndef MODULES_CONGESTION_CONTROLLER_INCLUDE_RECEIVE_SIDE_CONGESTION_CONTROLLER_H_
 #define MODULES_CONGESTION_CONTROLLER_INCLUDE_RECEIVE_SIDE_CONGESTION_CONTROLLER_H_
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -56,6 +57,10 @@ class ReceiveSideCongestionController : public CallStatsObserver {
 
   void SetTransportOverhead(DataSize overhead_per_packet);
 
+  // Sends congestion control feedback according to RFC 8888 for all received
+  // packets, instead of transport-wide congestion control feedback.
+  void EnableSendCongestionControlFeedbackAccordingToRfc8888();
+
   // Returns latest receive side bandwidth estimation.
   // Returns zero if receive side bandwidth estimation is unavailable.
   DataRate LatestReceiveSideEstimate() const;
@@ -75,6 +80,7 @@ class ReceiveSideCongestionController : public CallStatsObserver {
   Clock& clock_;
   RembThrottler remb_throttler_;
   RemoteEstimatorProxy remote_estimator_proxy_;
+  std::atomic<bool> send_rfc8888_congestion_feedback_{false};
 
   mutable Mutex mutex_;
   std::unique_ptr<RemoteBitrateEstimator> rbe_ RTC_GUARDED_BY(mutex_);
@@ -84,6 +84,10 @@ ReceiveSideCongestionController::ReceiveSideCongestionController(
 void ReceiveSideCongestionController::OnReceivedPacket(
     const RtpPacketReceived& packet,
     MediaType media_type) {
+  if (send_rfc8888_congestion_feedback_) {
+    remote_estimator_proxy_.IncomingPacket(packet);
+    return;
+  }
   bool has_transport_sequence_number =
       packet.HasExtension<TransportSequenceNumber>() ||
       packet.HasExtension<TransportSequenceNumberV2>();
@@ -103,6 +107,12 @@ void ReceiveSideCongestionController::OnReceivedPacket(
   }
 }
 
+void ReceiveSideCongestionController::
+    EnableSendCongestionControlFeedbackAccordingToRfc8888() {
+  remote_estimator_proxy_.EnableCongestionControlFeedback();
+  send_rfc8888_congestion_feedback_ = true;
+}
+
 void ReceiveSideCongestionController::OnBitrateChanged(int bitrate_bps) {
   remote_estimator_proxy_.OnBitrateChanged(bitrate_bps);
 }
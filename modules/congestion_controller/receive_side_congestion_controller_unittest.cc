@@ -33,6 +33,8 @@ using ::testing::_;
 using ::testing::AtLeast;
 using ::testing::ElementsAre;
 using ::testing::MockFunction;
+using ::testing::Pointee;
+using ::testing::Property;
 
 constexpr DataRate kInitialBitrate = DataRate::BitsPerSec(60'000);
 
@@ -80,6 +82,30 @@ TEST(ReceiveSideCongestionControllerTest,
   controller.SetMaxDesiredReceiveBitrate(DataRate::BitsPerSec(123));
 }
 
+TEST(ReceiveSideCongestionControllerTest,
+     SendsRfc8888FeedbackForPacketsWithoutTransportSequenceNumber) {
+  MockFunction<void(std::vector<std::unique_ptr<rtcp::RtcpPacket>>)>
+      feedback_sender;
+  MockFunction<void(uint64_t, std::vector<uint32_t>)> remb_sender;
+  SimulatedClock clock_(123456);
+
+  ReceiveSideCongestionController controller(
+      &clock_, feedback_sender.AsStdFunction(), remb_sender.AsStdFunction(),
+      nullptr);
+  controller.EnableSendCongestionControlFeedbackAccordingToRfc8888();
+
+  RtpPacketReceived packet;
+  packet.SetSsrc(0x11eb21c);
+  packet.SetSequenceNumber(1);
+  packet.set_arrival_time(clock_.CurrentTime());
+  controller.OnReceivedPacket(packet, MediaType::AUDIO);
+
+  EXPECT_CALL(feedback_sender, Call(ElementsAre(Pointee(Property(
+                                   &rtcp::RtcpPacket::BlockLength, 24u)))));
+  EXPECT_CALL(remb_sender, Call).Times(0);
+  controller.MaybeProcess();
+}
+
 TEST(ReceiveSideCongestionControllerTest, ConvergesToCapacity) {
   Scenario s("receive_cc_unit/converge");
   NetworkSimulationConfig net_conf;
@@ -25,7 +25,15 @@
 
 namespace webrtc {
 
+namespace {
+
 constexpr TimeDelta kSendTimeHistoryWindow = TimeDelta::Seconds(60);
+constexpr size_t kMinHistoryCapacity = 1 << 10;
+// Feedback can't refer to packets more than half the sequence number space
+// behind the newest one, as they would be unwrapped as new packets.
+constexpr size_t kMaxHistorySize = 1 << 15;
+
+}  // namespace
 
 void InFlightBytesTracker::AddInFlightPacketBytes(
     const PacketFeedback& packet) {
@@ -97,28 +105,31 @@ void TransportFeedbackAdapter::AddPacket(const RtpPacketSendInfo& packet_info,
   packet.network_route = network_route_;
   packet.sent.pacing_info = packet_info.pacing_info;
 
-  while (!history_.empty() &&
-         creation_time - history_.begin()->second.creation_time >
+  while (history_begin_ < history_end_ &&
+         creation_time - HistorySlot(history_begin_)->creation_time >
              kSendTimeHistoryWindow) {
     // TODO(sprang): Warn if erasing (too many) old items?
-    if (history_.begin()->second.sent.sequence_number > last_ack_seq_num_)
-      in_flight_.RemoveInFlightPacketBytes(history_.begin()->second);
-    history_.erase(history_.begin());
+    RemoveOldestFromHistory();
   }
-  history_.insert(std::make_pair(packet.sent.sequence_number, packet));
+  AddToHistory(packet);
 }
 
 absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
     const rtc::SentPacket& sent_packet) {
-  auto send_time = Timestamp::Millis(sent_packet.send_time_ms);
+  // Prefer the microsecond send time when the socket provides it, since
+  // rounding send times to whole milliseconds adds noise to the delay based
+  // estimate.
+  Timestamp send_time = sent_packet.send_time_us != -1
+                            ? Timestamp::Micros(sent_packet.send_time_us)
+                            : Timestamp::Millis(sent_packet.send_time_ms);
   // TODO(srte): Only use one way to indicate that packet feedback is used.
   if (sent_packet.info.included_in_feedback || sent_packet.packet_id != -1) {
     int64_t unwrapped_seq_num =
         seq_num_unwrapper_.Unwrap(sent_packet.packet_id);
-    auto it = history_.find(unwrapped_seq_num);
-    if (it != history_.end()) {
-      bool packet_retransmit = it->second.sent.send_time.IsFinite();
-      it->second.sent.send_time = send_time;
+    PacketFeedback* packet = FindPacket(unwrapped_seq_num);
+    if (packet != nullptr) {
+      bool packet_retransmit = packet->sent.send_time.IsFinite();
+      packet->sent.send_time = send_time;
       last_send_time_ = std::max(last_send_time_, send_time);
       // TODO(srte): Don't do this on retransmit.
       if (!pending_untracked_size_.IsZero()) {
@@ -126,14 +137,14 @@ absl::optional<SentPacket> TransportFeedbackAdapter::ProcessSentPacket(
           RTC_LOG(LS_WARNING)
               << "appending acknowledged data for out of order packet. (Diff: "
               << ToString(last_untracked_send_time_ - send_time) << " ms.)";
-        it->second.sent.prior_unacked_data += pending_untracked_size_;
+        packet->sent.prior_unacked_data += pending_untracked_size_;
         pending_untracked_size_ = DataSize::Zero();
       }
       if (!packet_retransmit) {
-        if (it->second.sent.sequence_number > last_ack_seq_num_)
-          in_flight_.AddInFlightPacketBytes(it->second);
-        it->second.sent.data_in_flight = GetOutstandingData();
-        return it->second.sent;
+        if (packet->sent.sequence_number > last_ack_seq_num_)
+          in_flight_.AddInFlightPacketBytes(*packet);
+        packet->sent.data_in_flight = GetOutstandingData();
+        return packet->sent;
       }
     }
   } else if (sent_packet.info.included_in_allocation) {
@@ -165,9 +176,8 @@ TransportFeedbackAdapter::ProcessTransportFeedback(
   if (msg.packet_feedbacks.empty())
     return absl::nullopt;
 
-  auto it = history_.find(last_ack_seq_num_);
-  if (it != history_.end()) {
-    msg.first_unacked_send_time = it->second.sent.send_time;
+  if (const PacketFeedback* packet = FindPacket(last_ack_seq_num_)) {
+    msg.first_unacked_send_time = packet->sent.send_time;
   }
   msg.data_in_flight = in_flight_.GetOutstandingData(network_route_);
 
@@ -217,22 +227,24 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
         int64_t seq_num = seq_num_unwrapper_.Unwrap(sequence_number);
 
         if (seq_num > last_ack_seq_num_) {
-          // Starts at history_.begin() if last_ack_seq_num_ < 0, since any
+          // Starts at `history_begin_` if last_ack_seq_num_ < 0, since any
           // valid sequence number is >= 0.
-          for (auto it = history_.upper_bound(last_ack_seq_num_);
-               it != history_.upper_bound(seq_num); ++it) {
-            in_flight_.RemoveInFlightPacketBytes(it->second);
+          int64_t end = std::min(seq_num + 1, history_end_);
+          for (int64_t i = std::max(last_ack_seq_num_ + 1, history_begin_);
+               i < end; ++i) {
+            if (const absl::optional<PacketFeedback>& packet = HistorySlot(i))
+              in_flight_.RemoveInFlightPacketBytes(*packet);
           }
           last_ack_seq_num_ = seq_num;
         }
 
-        auto it = history_.find(seq_num);
-        if (it == history_.end()) {
+        PacketFeedback* packet = FindPacket(seq_num);
+        if (packet == nullptr) {
           ++failed_lookups;
           return;
         }
 
-        if (it->second.sent.send_time.IsInfinite()) {
+        if (packet->sent.send_time.IsInfinite()) {
           // TODO(srte): Fix the tests that makes this happen and make this a
           // DCHECK.
           RTC_DLOG(LS_ERROR)
@@ -240,14 +252,14 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
           return;
         }
 
-        PacketFeedback packet_feedback = it->second;
+        PacketFeedback packet_feedback = *packet;
         if (delta_since_base.IsFinite()) {
           packet_feedback.receive_time =
               current_offset_ +
               delta_since_base.RoundDownTo(TimeDelta::Millis(1));
           // Note: Lost packets are not removed from history because they might
           // be reported as received by a later feedback.
-          history_.erase(it);
+          RemoveFromHistory(seq_num);
         }
         if (packet_feedback.network_route == network_route_) {
           PacketResult result;
@@ -272,4 +284,86 @@ TransportFeedbackAdapter::ProcessTransportFeedbackInner(
   return packet_result_vector;
 }
 
+PacketFeedback* TransportFeedbackAdapter::FindPacket(int64_t seq_num) {
+  if (seq_num < history_begin_ || seq_num >= history_end_) {
+    return nullptr;
+  }
+  absl::optional<PacketFeedback>& packet = HistorySlot(seq_num);
+  return packet ? &*packet : nullptr;
+}
+
+void TransportFeedbackAdapter::AddToHistory(const PacketFeedback& packet) {
+  const int64_t seq_num = packet.sent.sequence_number;
+  if (history_begin_ == history_end_) {
+    history_begin_ = seq_num;
+    history_end_ = seq_num;
+  }
+
+  if (seq_num < history_begin_) {
+    // Packet to be inserted ahead of the first packet, expand front.
+    if (static_cast<size_t>(history_end_ - seq_num) > kMaxHistorySize) {
+      RTC_LOG(LS_WARNING) << "Ignoring packet " << seq_num
+                          << " too far behind the send time history.";
+      return;
+    }
+    EnsureHistoryCapacity(history_end_ - seq_num);
+    history_begin_ = seq_num;
+  } else if (seq_num >= history_end_) {
+    // Packet to be inserted behind the last packet, expand back.
+    while (history_begin_ < history_end_ &&
+           static_cast<size_t>(seq_num + 1 - history_begin_) >
+               kMaxHistorySize) {
+      RemoveOldestFromHistory();
+    }
+    if (history_begin_ == history_end_) {
+      history_begin_ = seq_num;
+    }
+    EnsureHistoryCapacity(seq_num + 1 - history_begin_);
+    history_end_ = seq_num + 1;
+  }
+
+  absl::optional<PacketFeedback>& slot = HistorySlot(seq_num);
+  if (!slot) {
+    slot = packet;
+  }
+}
+
+void TransportFeedbackAdapter::RemoveOldestFromHistory() {
+  RTC_DCHECK_LT(history_begin_, history_end_);
+  const PacketFeedback& packet = *HistorySlot(history_begin_);
+  if (packet.sent.sequence_number > last_ack_seq_num_)
+    in_flight_.RemoveInFlightPacketBytes(packet);
+  RemoveFromHistory(history_begin_);
+}
+
+void TransportFeedbackAdapter::RemoveFromHistory(int64_t seq_num) {
+  HistorySlot(seq_num) = absl::nullopt;
+  if (seq_num == history_begin_) {
+    while (history_begin_ < history_end_ && !HistorySlot(history_begin_)) {
+      ++history_begin_;
+    }
+  }
+}
+
+absl::optional<PacketFeedback>& TransportFeedbackAdapter::HistorySlot(
+    int64_t seq_num) {
+  RTC_DCHECK(!history_.empty());
+  return history_[seq_num & (history_.size() - 1)];
+}
+
+void TransportFeedbackAdapter::EnsureHistoryCapacity(size_t num_packets) {
+  if (num_packets <= history_.size()) {
+    return;
+  }
+  size_t capacity = std::max(history_.size(), kMinHistoryCapacity);
+  while (capacity < num_packets) {
+    capacity *= 2;
+  }
+  std::vector<absl::optional<PacketFeedback>> history(capacity);
+  for (int64_t seq_num = history_begin_; seq_num < history_end_; ++seq_num) {
+    history[seq_num & (capacity - 1)] = std::move(HistorySlot(seq_num));
+  }
+  history_.swap(history);
+}
+
 }  // namespace webrtc
@@ -16,6 +16,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/sequence_checker.h"
 #include "api/transport/network_types.h"
 #include "api/units/timestamp.h"
@@ -80,11 +81,29 @@ class TransportFeedbackAdapter {
       const rtcp::TransportFeedback& feedback,
       Timestamp feedback_receive_time);
 
+  // Returns the packet with unwrapped sequence number `seq_num`, or nullptr
+  // if it is not in the history.
+  PacketFeedback* FindPacket(int64_t seq_num);
+  void AddToHistory(const PacketFeedback& packet);
+  // Removes the oldest packet, which is no longer in flight.
+  void RemoveOldestFromHistory();
+  void RemoveFromHistory(int64_t seq_num);
+  absl::optional<PacketFeedback>& HistorySlot(int64_t seq_num);
+  // Grows the ring buffer, if needed, to hold `num_packets` packets.
+  void EnsureHistoryCapacity(size_t num_packets);
+
   DataSize pending_untracked_size_ = DataSize::Zero();
   Timestamp last_send_time_ = Timestamp::MinusInfinity();
   Timestamp last_untracked_send_time_ = Timestamp::MinusInfinity();
   RtpSequenceNumberUnwrapper seq_num_unwrapper_;
-  std::map<int64_t, PacketFeedback> history_;
+  // Ring buffer of sent packets with unwrapped sequence numbers in
+  // [history_begin_, history_end_), stored in slot `sequence_number &
+  // (history_.size() - 1)`. Received packets are removed out-of-order, leaving
+  // empty slots, but the first packet in the range is always present. Slots
+  // outside of the range are always empty.
+  std::vector<absl::optional<PacketFeedback>> history_;
+  int64_t history_begin_ = 0;
+  int64_t history_end_ = 0;
 
   // Sequence numbers are never negative, using -1 as it always < a real
   // sequence number.
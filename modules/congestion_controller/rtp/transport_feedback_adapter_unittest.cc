@@ -374,6 +374,65 @@ TEST_F(TransportFeedbackAdapterTest, TimestampDeltas) {
   }
 }
 
+TEST_F(TransportFeedbackAdapterTest, ReportsLostPacketReceivedLater) {
+  std::vector<PacketResult> packets;
+  packets.push_back(CreatePacket(100, 200, 0, 1500, kPacingInfo0));
+  packets.push_back(CreatePacket(110, 210, 1, 1500, kPacingInfo0));
+  packets.push_back(CreatePacket(120, 220, 2, 1500, kPacingInfo0));
+  for (const auto& packet : packets)
+    OnSentPacket(packet);
+
+  rtcp::TransportFeedback feedback;
+  feedback.SetBase(0, packets[0].receive_time);
+  EXPECT_TRUE(feedback.AddReceivedPacket(0, packets[0].receive_time));
+  EXPECT_TRUE(feedback.AddReceivedPacket(2, packets[2].receive_time));
+  feedback.Build();
+  auto res = adapter_->ProcessTransportFeedback(feedback, clock_.CurrentTime());
+  ASSERT_TRUE(res);
+  ASSERT_EQ(res->packet_feedbacks.size(), 3u);
+  EXPECT_FALSE(res->packet_feedbacks[1].IsReceived());
+  EXPECT_EQ(adapter_->GetOutstandingData(), DataSize::Zero());
+
+  rtcp::TransportFeedback late_feedback;
+  late_feedback.SetBase(1, packets[1].receive_time);
+  EXPECT_TRUE(late_feedback.AddReceivedPacket(1, packets[1].receive_time));
+  late_feedback.Build();
+  res = adapter_->ProcessTransportFeedback(late_feedback, clock_.CurrentTime());
+  ASSERT_TRUE(res);
+  ComparePacketFeedbackVectors({packets[1]}, res->packet_feedbacks);
+}
+
+TEST_F(TransportFeedbackAdapterTest, TracksDataInFlightForManyPackets) {
+  constexpr int kNumPackets = 5000;
+  for (int i = 0; i < kNumPackets; ++i) {
+    OnSentPacket(CreatePacket(0, 200 + i, i, 1000, kPacingInfo0));
+  }
+  EXPECT_EQ(adapter_->GetOutstandingData(),
+            kNumPackets * DataSize::Bytes(1000));
+
+  // Acknowledging a packet removes all packets before it from flight, while
+  // they remain in the history in case they are reported later.
+  rtcp::TransportFeedback feedback;
+  feedback.SetBase(kNumPackets - 2, Timestamp::Millis(1000));
+  EXPECT_TRUE(
+      feedback.AddReceivedPacket(kNumPackets - 2, Timestamp::Millis(1000)));
+  feedback.Build();
+  auto res = adapter_->ProcessTransportFeedback(feedback, clock_.CurrentTime());
+  ASSERT_TRUE(res);
+  EXPECT_EQ(res->data_in_flight, DataSize::Bytes(1000));
+
+  rtcp::TransportFeedback late_feedback;
+  late_feedback.SetBase(0, Timestamp::Millis(1010));
+  EXPECT_TRUE(late_feedback.AddReceivedPacket(0, Timestamp::Millis(1010)));
+  late_feedback.Build();
+  res = adapter_->ProcessTransportFeedback(late_feedback, clock_.CurrentTime());
+  ASSERT_TRUE(res);
+  ASSERT_EQ(res->packet_feedbacks.size(), 1u);
+  EXPECT_EQ(res->packet_feedbacks[0].sent_packet.send_time,
+            Timestamp::Millis(200));
+  EXPECT_EQ(res->data_in_flight, DataSize::Bytes(1000));
+}
+
 TEST_F(TransportFeedbackAdapterTest, IgnoreDuplicatePacketSentCalls) {
   auto packet = CreatePacket(100, 200, 0, 1500, kPacingInfo0);
 
@@ -398,4 +457,22 @@ TEST_F(TransportFeedbackAdapterTest, IgnoreDuplicatePacketSentCalls) {
   EXPECT_FALSE(duplicate_packet.has_value());
 }
 
+
+TEST_F(TransportFeedbackAdapterTest, UsesMicrosecondSendTimeWhenAvailable) {
+  RtpPacketSendInfo packet_info;
+  packet_info.media_ssrc = kSsrc;
+  packet_info.transport_sequence_number = 1;
+  packet_info.length = 1200;
+  packet_info.packet_type = RtpPacketMediaType::kVideo;
+  adapter_->AddPacket(packet_info, 0u, clock_.CurrentTime());
+
+  rtc::SentPacket socket_sent_packet(1, /*send_time_ms=*/200,
+                                     rtc::PacketInfo());
+  socket_sent_packet.send_time_us = 200'345;
+  absl::optional<SentPacket> sent_packet =
+      adapter_->ProcessSentPacket(socket_sent_packet);
+  ASSERT_TRUE(sent_packet.has_value());
+  EXPECT_EQ(sent_packet->send_time, Timestamp::Micros(200'345));
+}
+
 }  // namespace webrtc
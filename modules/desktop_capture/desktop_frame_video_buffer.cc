@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/desktop_frame_video_buffer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "modules/desktop_capture/desktop_geometry.h"
+#include "modules/desktop_capture/desktop_region.h"
+#include "rtc_base/checks.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+#include "third_party/libyuv/include/libyuv/convert_from_argb.h"
+#include "third_party/libyuv/include/libyuv/planar_functions.h"
+
+namespace webrtc {
+
+namespace {
+
+// Converts `rect` of `frame` into `buffer`. `rect` is expanded to even
+// coordinates, since each chroma sample covers 2x2 pixels.
+void ConvertRectToNV12(const DesktopFrame& frame,
+                       DesktopRect rect,
+                       NV12Buffer& buffer) {
+  rect = DesktopRect::MakeLTRB(rect.left() & ~1, rect.top() & ~1,
+                               rect.right() + (rect.right() & 1),
+                               rect.bottom() + (rect.bottom() & 1));
+  rect.IntersectWith(DesktopRect::MakeSize(frame.size()));
+  if (rect.is_empty()) {
+    return;
+  }
+  libyuv::ARGBToNV12(
+      frame.GetFrameDataAtPos(rect.top_left()), frame.stride(),
+      buffer.MutableDataY() + rect.top() * buffer.StrideY() + rect.left(),
+      buffer.StrideY(),
+      buffer.MutableDataUV() + rect.top() / 2 * buffer.StrideUV() +
+          rect.left(),
+      buffer.StrideUV(), rect.width(), rect.height());
+}
+
+}  // namespace
+
+rtc::scoped_refptr<DesktopFrameVideoBuffer> DesktopFrameVideoBuffer::Create(
+    std::unique_ptr<SharedDesktopFrame> frame,
+    rtc::scoped_refptr<DesktopFrameVideoBuffer> previous) {
+  RTC_DCHECK(frame);
+  if (previous) {
+    RTC_DCHECK(previous->frame().size().equals(frame->size()));
+    previous->ReleasePrevious();
+  }
+  return rtc::make_ref_counted<DesktopFrameVideoBuffer>(std::move(frame),
+                                                        std::move(previous));
+}
+
+DesktopFrameVideoBuffer::DesktopFrameVideoBuffer(
+    std::unique_ptr<SharedDesktopFrame> frame,
+    rtc::scoped_refptr<DesktopFrameVideoBuffer> previous)
+    : frame_(std::move(frame)), previous_(std::move(previous)) {}
+
+DesktopFrameVideoBuffer::~DesktopFrameVideoBuffer() = default;
+
+VideoFrameBuffer::Type DesktopFrameVideoBuffer::type() const {
+  return Type::kNative;
+}
+
+int DesktopFrameVideoBuffer::width() const {
+  return frame_->size().width();
+}
+
+int DesktopFrameVideoBuffer::height() const {
+  return frame_->size().height();
+}
+
+rtc::scoped_refptr<I420BufferInterface> DesktopFrameVideoBuffer::ToI420() {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width(), height());
+  libyuv::ARGBToI420(frame_->data(), frame_->stride(), buffer->MutableDataY(),
+                     buffer->StrideY(), buffer->MutableDataU(),
+                     buffer->StrideU(), buffer->MutableDataV(),
+                     buffer->StrideV(), width(), height());
+  return buffer;
+}
+
+rtc::scoped_refptr<VideoFrameBuffer>
+DesktopFrameVideoBuffer::GetMappedFrameBuffer(rtc::ArrayView<Type> types) {
+  if (absl::c_linear_search(types, Type::kNV12)) {
+    return ToNV12();
+  }
+  if (absl::c_linear_search(types, Type::kI420)) {
+    return ToI420();
+  }
+  return nullptr;
+}
+
+VideoFrame::UpdateRect DesktopFrameVideoBuffer::update_rect() const {
+  VideoFrame::UpdateRect update_rect;
+  for (DesktopRegion::Iterator it(frame_->updated_region()); !it.IsAtEnd();
+       it.Advance()) {
+    update_rect.Union({.offset_x = it.rect().left(),
+                       .offset_y = it.rect().top(),
+                       .width = it.rect().width(),
+                       .height = it.rect().height()});
+  }
+  update_rect.Intersect(
+      {.offset_x = 0, .offset_y = 0, .width = width(), .height = height()});
+  return update_rect;
+}
+
+rtc::scoped_refptr<NV12Buffer> DesktopFrameVideoBuffer::ToNV12() {
+  MutexLock lock(&lock_);
+  if (nv12_) {
+    return nv12_;
+  }
+  rtc::scoped_refptr<NV12Buffer> previous_nv12;
+  if (previous_) {
+    previous_nv12 = previous_->GetCachedNV12();
+    previous_ = nullptr;
+  }
+
+  nv12_ = NV12Buffer::Create(width(), height());
+  if (!previous_nv12) {
+    ConvertRectToNV12(*frame_, DesktopRect::MakeSize(frame_->size()), *nv12_);
+    return nv12_;
+  }
+  // Only the updated region differs from the previous frame.
+  libyuv::CopyPlane(previous_nv12->DataY(), previous_nv12->StrideY(),
+                    nv12_->MutableDataY(), nv12_->StrideY(), width(),
+                    height());
+  libyuv::CopyPlane(previous_nv12->DataUV(), previous_nv12->StrideUV(),
+                    nv12_->MutableDataUV(), nv12_->StrideUV(),
+                    nv12_->ChromaWidth() * 2, nv12_->ChromaHeight());
+  for (DesktopRegion::Iterator it(frame_->updated_region()); !it.IsAtEnd();
+       it.Advance()) {
+    ConvertRectToNV12(*frame_, it.rect(), *nv12_);
+  }
+  return nv12_;
+}
+
+rtc::scoped_refptr<NV12Buffer> DesktopFrameVideoBuffer::GetCachedNV12() {
+  MutexLock lock(&lock_);
+  return nv12_;
+}
+
+void DesktopFrameVideoBuffer::ReleasePrevious() {
+  MutexLock lock(&lock_);
+  previous_ = nullptr;
+}
+
+}  // namespace webrtc
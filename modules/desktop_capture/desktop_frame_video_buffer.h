@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_VIDEO_BUFFER_H_
+#define MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_VIDEO_BUFFER_H_
+
+#include <memory>
+
+#include "api/array_view.h"
+#include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
+#include "modules/desktop_capture/shared_desktop_frame.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// A native VideoFrameBuffer which wraps a captured DesktopFrame without
+// copying it, so that the ARGB pixels are only converted once an encoder maps
+// the buffer, and only into the format the encoder asks for. NV12 is preferred
+// over I420 by GetMappedFrameBuffer() when both are accepted.
+//
+// If the buffer of the previous captured frame is passed to Create(), and has
+// already been mapped to NV12 by the time this one is, the conversion only
+// covers the updated region of the DesktopFrame, and the rest is copied from
+// the NV12 buffer of the previous frame. Use update_rect() as the update rect
+// of the VideoFrame, so that encoders can skip frames without any change.
+class DesktopFrameVideoBuffer : public VideoFrameBuffer {
+ public:
+  // `previous`, if not null, must be the buffer of the frame captured just
+  // before `frame`, with the same size.
+  static rtc::scoped_refptr<DesktopFrameVideoBuffer> Create(
+      std::unique_ptr<SharedDesktopFrame> frame,
+      rtc::scoped_refptr<DesktopFrameVideoBuffer> previous = nullptr);
+
+  Type type() const override;
+  int width() const override;
+  int height() const override;
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+  rtc::scoped_refptr<VideoFrameBuffer> GetMappedFrameBuffer(
+      rtc::ArrayView<Type> types) override;
+
+  // Returns the bounding box of the updated region of the DesktopFrame.
+  VideoFrame::UpdateRect update_rect() const;
+
+  const SharedDesktopFrame& frame() const { return *frame_; }
+
+ protected:
+  DesktopFrameVideoBuffer(
+      std::unique_ptr<SharedDesktopFrame> frame,
+      rtc::scoped_refptr<DesktopFrameVideoBuffer> previous);
+  ~DesktopFrameVideoBuffer() override;
+
+ private:
+  rtc::scoped_refptr<NV12Buffer> ToNV12();
+  // Returns the NV12 buffer if the frame has been mapped to NV12 already.
+  rtc::scoped_refptr<NV12Buffer> GetCachedNV12();
+  void ReleasePrevious();
+
+  const std::unique_ptr<SharedDesktopFrame> frame_;
+  Mutex lock_;
+  // Released once the frame has been mapped to NV12, or the buffer of the next
+  // frame has been created, so that buffers don't keep a chain of previous
+  // frames alive.
+  rtc::scoped_refptr<DesktopFrameVideoBuffer> previous_ RTC_GUARDED_BY(lock_);
+  // Kept as frames may be mapped more than once, e.g. by simulcast encoders
+  // or when a frame is repeated.
+  rtc::scoped_refptr<NV12Buffer> nv12_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_VIDEO_BUFFER_H_
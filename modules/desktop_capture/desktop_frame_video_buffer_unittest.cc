@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/desktop_frame_video_buffer.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <utility>
+
+#include "modules/desktop_capture/desktop_frame.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 48;
+
+std::unique_ptr<SharedDesktopFrame> CreateFrame(uint8_t seed) {
+  auto frame =
+      std::make_unique<BasicDesktopFrame>(DesktopSize(kWidth, kHeight));
+  for (int y = 0; y < kHeight; ++y) {
+    uint8_t* row = frame->data() + y * frame->stride();
+    for (int i = 0; i < kWidth * DesktopFrame::kBytesPerPixel; ++i) {
+      row[i] = static_cast<uint8_t>(seed + y * 7 + i * 3);
+    }
+  }
+  frame->mutable_updated_region()->SetRect(
+      DesktopRect::MakeWH(kWidth, kHeight));
+  return SharedDesktopFrame::Wrap(std::move(frame));
+}
+
+void ExpectEqualNV12(const NV12BufferInterface& a,
+                     const NV12BufferInterface& b) {
+  ASSERT_EQ(a.width(), b.width());
+  ASSERT_EQ(a.height(), b.height());
+  for (int y = 0; y < a.height(); ++y) {
+    EXPECT_EQ(memcmp(a.DataY() + y * a.StrideY(), b.DataY() + y * b.StrideY(),
+                     a.width()),
+              0)
+        << "Y row " << y;
+  }
+  for (int y = 0; y < a.ChromaHeight(); ++y) {
+    EXPECT_EQ(memcmp(a.DataUV() + y * a.StrideUV(),
+                     b.DataUV() + y * b.StrideUV(), a.ChromaWidth() * 2),
+              0)
+        << "UV row " << y;
+  }
+}
+
+TEST(DesktopFrameVideoBufferTest, WrapsFrameWithoutCopying) {
+  std::unique_ptr<SharedDesktopFrame> frame = CreateFrame(0);
+  const uint8_t* data = frame->data();
+  auto buffer = DesktopFrameVideoBuffer::Create(std::move(frame));
+  EXPECT_EQ(buffer->type(), VideoFrameBuffer::Type::kNative);
+  EXPECT_EQ(buffer->width(), kWidth);
+  EXPECT_EQ(buffer->height(), kHeight);
+  EXPECT_EQ(buffer->frame().data(), data);
+}
+
+TEST(DesktopFrameVideoBufferTest, MapsToRequestedFormat) {
+  auto buffer = DesktopFrameVideoBuffer::Create(CreateFrame(0));
+  VideoFrameBuffer::Type nv12_and_i420[] = {VideoFrameBuffer::Type::kI420,
+                                            VideoFrameBuffer::Type::kNV12};
+  auto mapped = buffer->GetMappedFrameBuffer(nv12_and_i420);
+  ASSERT_TRUE(mapped);
+  EXPECT_EQ(mapped->type(), VideoFrameBuffer::Type::kNV12);
+  // Mapped once, whichever encoder asks first.
+  EXPECT_EQ(buffer->GetMappedFrameBuffer(nv12_and_i420), mapped);
+
+  VideoFrameBuffer::Type i420[] = {VideoFrameBuffer::Type::kI420};
+  mapped = buffer->GetMappedFrameBuffer(i420);
+  ASSERT_TRUE(mapped);
+  EXPECT_EQ(mapped->type(), VideoFrameBuffer::Type::kI420);
+
+  VideoFrameBuffer::Type i444[] = {VideoFrameBuffer::Type::kI444};
+  EXPECT_FALSE(buffer->GetMappedFrameBuffer(i444));
+}
+
+TEST(DesktopFrameVideoBufferTest, ConvertsOnlyUpdatedRegion) {
+  VideoFrameBuffer::Type nv12[] = {VideoFrameBuffer::Type::kNV12};
+  std::unique_ptr<SharedDesktopFrame> first = CreateFrame(0);
+  std::unique_ptr<SharedDesktopFrame> second = CreateFrame(0);
+  // Odd coordinates, which share chroma samples with unchanged pixels.
+  const DesktopRect updated = DesktopRect::MakeXYWH(5, 3, 9, 7);
+  for (int y = updated.top(); y < updated.bottom(); ++y) {
+    memset(second->data() + y * second->stride() +
+               updated.left() * DesktopFrame::kBytesPerPixel,
+           0xff, updated.width() * DesktopFrame::kBytesPerPixel);
+  }
+  second->mutable_updated_region()->SetRect(updated);
+  std::unique_ptr<SharedDesktopFrame> reference = second->Share();
+
+  auto first_buffer = DesktopFrameVideoBuffer::Create(std::move(first));
+  ASSERT_TRUE(first_buffer->GetMappedFrameBuffer(nv12));
+  auto second_buffer =
+      DesktopFrameVideoBuffer::Create(std::move(second), first_buffer);
+  EXPECT_EQ(second_buffer->update_rect(),
+            (VideoFrame::UpdateRect{.offset_x = 5,
+                                    .offset_y = 3,
+                                    .width = 9,
+                                    .height = 7}));
+
+  auto mapped = second_buffer->GetMappedFrameBuffer(nv12);
+  ASSERT_TRUE(mapped);
+  auto expected = DesktopFrameVideoBuffer::Create(std::move(reference))
+                      ->GetMappedFrameBuffer(nv12);
+  ExpectEqualNV12(*mapped->GetNV12(), *expected->GetNV12());
+}
+
+TEST(DesktopFrameVideoBufferTest, ConvertsWholeFrameIfPreviousIsNotMapped) {
+  VideoFrameBuffer::Type nv12[] = {VideoFrameBuffer::Type::kNV12};
+  auto first_buffer = DesktopFrameVideoBuffer::Create(CreateFrame(0));
+  std::unique_ptr<SharedDesktopFrame> second = CreateFrame(1);
+  second->mutable_updated_region()->Clear();
+  std::unique_ptr<SharedDesktopFrame> reference = second->Share();
+  auto second_buffer =
+      DesktopFrameVideoBuffer::Create(std::move(second), first_buffer);
+  EXPECT_TRUE(second_buffer->update_rect().IsEmpty());
+
+  auto mapped = second_buffer->GetMappedFrameBuffer(nv12);
+  ASSERT_TRUE(mapped);
+  auto expected = DesktopFrameVideoBuffer::Create(std::move(reference))
+                      ->GetMappedFrameBuffer(nv12);
+  ExpectEqualNV12(*mapped->GetNV12(), *expected->GetNV12());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -86,4 +86,20 @@ TEST(BlockDifferenceTestFirst, BlockDifference) {
   }
 }
 
+TEST(BlockDifferenceTestEachByte, BlockDifference) {
+  uint8_t* block1;
+  uint8_t* block2;
+  PrepareBuffers(block1, block2);
+
+  // Every byte of a block row must be compared, whichever vector size the
+  // implementation uses.
+  for (int i = 0; i < kBlockSize * kBytesPerPixel; ++i) {
+    block2[i] += 1;
+    EXPECT_TRUE(BlockDifference(block1, block2, kBlockSize * kBytesPerPixel))
+        << "byte " << i;
+    block2[i] -= 1;
+  }
+  EXPECT_FALSE(BlockDifference(block1, block2, kBlockSize * kBytesPerPixel));
+}
+
 }  // namespace webrtc
@@ -634,24 +634,11 @@ bool EglDmaBuf::ImageFromDmaBuf(const DesktopSize& size,
     return false;
   }
 
-  GLenum gl_format = GL_BGRA;
-  switch (format) {
-    case SPA_VIDEO_FORMAT_RGBx:
-      gl_format = GL_RGBA;
-      break;
-    case SPA_VIDEO_FORMAT_RGBA:
-      gl_format = GL_RGBA;
-      break;
-    case SPA_VIDEO_FORMAT_BGRx:
-      gl_format = GL_BGRA;
-      break;
-    default:
-      gl_format = GL_BGRA;
-      break;
-  }
-
+  // The texture holds the channels of the image as given by its DRM format,
+  // so reading them back as BGRA converts RGBx images on the GPU rather than
+  // in a separate pass over the frame in system memory.
   GlReadPixels(offset.x(), offset.y(), buffer_size.width(),
-               buffer_size.height(), gl_format, GL_UNSIGNED_BYTE, data);
+               buffer_size.height(), GL_BGRA, GL_UNSIGNED_BYTE, data);
 
   const GLenum error = GlGetError();
   if (error) {
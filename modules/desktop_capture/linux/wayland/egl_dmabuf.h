@@ -42,7 +42,9 @@ class EglDmaBuf {
   ~EglDmaBuf();
 
   // Returns whether the image was successfully imported from
-  // given DmaBuf and its parameters
+  // given DmaBuf and its parameters. The image is read back into `data` in
+  // BGRx order, whatever the `format` of the DmaBuf, with the GPU swapping
+  // the channels where needed.
   bool ImageFromDmaBuf(const DesktopSize& size,
                        uint32_t format,
                        const std::vector<PlaneData>& plane_datas,
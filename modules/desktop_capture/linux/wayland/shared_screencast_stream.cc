@@ -27,6 +27,7 @@
 #include "rtc_base/sanitizer.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/time_utils.h"
+#include "third_party/libyuv/include/libyuv/convert_argb.h"
 
 namespace webrtc {
 
@@ -162,7 +163,6 @@ class SharedScreenCastStreamPrivate {
   bool ProcessDMABuffer(pw_buffer* buffer,
                         DesktopFrame& frame,
                         const DesktopVector& offset);
-  void ConvertRGBxToBGRx(uint8_t* frame, uint32_t size);
   void UpdateFrameUpdatedRegions(const spa_buffer* spa_buffer,
                                  DesktopFrame& frame);
   void NotifyCallbackOfNewFrame(std::unique_ptr<SharedDesktopFrame> frame);
@@ -847,17 +847,6 @@ void SharedScreenCastStreamPrivate::ProcessBuffer(pw_buffer* buffer) {
     return;
   }
 
-  if (spa_video_format_.format == SPA_VIDEO_FORMAT_RGBx ||
-      spa_video_format_.format == SPA_VIDEO_FORMAT_RGBA) {
-    uint8_t* tmp_src = queue_.current_frame()->data();
-    for (int i = 0; i < frame_size_.height(); ++i) {
-      // If both sides decided to go with the RGBx format we need to convert
-      // it to BGRx to match color format expected by WebRTC.
-      ConvertRGBxToBGRx(tmp_src, queue_.current_frame()->stride());
-      tmp_src += queue_.current_frame()->stride();
-    }
-  }
-
   if (observer_) {
     observer_->OnDesktopFrameChanged();
   }
@@ -904,6 +893,17 @@ bool SharedScreenCastStreamPrivate::ProcessMemFDBuffer(
   uint8_t* updated_src =
       src + (src_stride * offset.y()) + (kBytesPerPixel * offset.x());
 
+  if (spa_video_format_.format == SPA_VIDEO_FORMAT_RGBx ||
+      spa_video_format_.format == SPA_VIDEO_FORMAT_RGBA) {
+    // If both sides decided to go with the RGBx format we need to convert
+    // it to BGRx to match color format expected by WebRTC, which is done
+    // while copying.
+    libyuv::ABGRToARGB(updated_src, src_stride - (kBytesPerPixel * offset.x()),
+                       frame.data(), frame.stride(), frame.size().width(),
+                       frame.size().height());
+    return true;
+  }
+
   frame.CopyPixelsFrom(
       updated_src, (src_stride - (kBytesPerPixel * offset.x())),
       DesktopRect::MakeWH(frame.size().width(), frame.size().height()));
@@ -955,16 +955,6 @@ bool SharedScreenCastStreamPrivate::ProcessDMABuffer(
   return true;
 }
 
-void SharedScreenCastStreamPrivate::ConvertRGBxToBGRx(uint8_t* frame,
-                                                      uint32_t size) {
-  for (uint32_t i = 0; i < size; i += 4) {
-    uint8_t tempR = frame[i];
-    uint8_t tempB = frame[i + 2];
-    frame[i] = tempB;
-    frame[i + 2] = tempR;
-  }
-}
-
 SharedScreenCastStream::SharedScreenCastStream()
     : private_(std::make_unique<SharedScreenCastStreamPrivate>()) {}
 
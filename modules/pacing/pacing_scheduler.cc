@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/pacing_scheduler.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+PacingScheduler::PacingScheduler(Clock* clock, TimeDelta resolution)
+    : clock_(clock),
+      resolution_(resolution),
+      task_queue_(TaskQueueBase::Current()) {
+  RTC_DCHECK(task_queue_);
+  RTC_DCHECK_GT(resolution_, TimeDelta::Zero());
+}
+
+PacingScheduler::~PacingScheduler() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+}
+
+bool PacingScheduler::Later(const Entry& a, const Entry& b) {
+  if (a.time != b.time) {
+    return a.time > b.time;
+  }
+  return a.order > b.order;
+}
+
+void PacingScheduler::ScheduleAt(Timestamp at_time,
+                                 absl::AnyInvocable<void() &&> task) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  RTC_DCHECK(at_time.IsFinite());
+  heap_.push_back({at_time, next_order_++, std::move(task)});
+  std::push_heap(heap_.begin(), heap_.end(), &PacingScheduler::Later);
+  MaybeScheduleWakeup();
+}
+
+size_t PacingScheduler::num_pending_tasks() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return heap_.size();
+}
+
+int64_t PacingScheduler::num_wakeups() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return num_wakeups_;
+}
+
+void PacingScheduler::MaybeScheduleWakeup() {
+  if (heap_.empty()) {
+    return;
+  }
+  // Round up to the grid, so that wake ups are shared by all tasks due within
+  // the same slot.
+  const int64_t slot =
+      (heap_.front().time.us() + resolution_.us() - 1) / resolution_.us();
+  const Timestamp wakeup_time = Timestamp::Micros(slot * resolution_.us());
+  if (wakeup_time >= next_wakeup_time_) {
+    return;
+  }
+  // Any previously posted task is retired, since it's for a later time.
+  next_wakeup_time_ = wakeup_time;
+  const TimeDelta delay =
+      std::max(wakeup_time - clock_->CurrentTime(), TimeDelta::Zero());
+  task_queue_->PostDelayedHighPrecisionTask(
+      SafeTask(safety_.flag(),
+               [this, wakeup_time]() {
+                 RTC_DCHECK_RUN_ON(&sequence_checker_);
+                 OnWakeup(wakeup_time);
+               }),
+      delay);
+}
+
+void PacingScheduler::OnWakeup(Timestamp wakeup_time) {
+  if (wakeup_time != next_wakeup_time_) {
+    return;
+  }
+  next_wakeup_time_ = Timestamp::PlusInfinity();
+  ++num_wakeups_;
+
+  // Take out all due tasks before running them, so that tasks scheduled while
+  // running wait for the next wake up.
+  const Timestamp now = std::max(clock_->CurrentTime(), wakeup_time);
+  std::vector<absl::AnyInvocable<void() &&>> due_tasks;
+  while (!heap_.empty() && heap_.front().time <= now) {
+    std::pop_heap(heap_.begin(), heap_.end(), &PacingScheduler::Later);
+    due_tasks.push_back(std::move(heap_.back().task));
+    heap_.pop_back();
+  }
+  for (absl::AnyInvocable<void() &&>& task : due_tasks) {
+    std::move(task)();
+  }
+  MaybeScheduleWakeup();
+}
+
+}  // namespace webrtc
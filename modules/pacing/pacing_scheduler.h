@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_PACING_SCHEDULER_H_
+#define MODULES_PACING_PACING_SCHEDULER_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Schedules the delayed process tasks of several pacers, e.g. one per
+// RtpTransportControllerSend on a server sending to many peers, on a single
+// task queue. Pending tasks are kept in a timer heap, and only one delayed
+// task is posted to the task queue at a time. Wake up times are aligned to a
+// grid of `resolution`, so that all pacers which are due within the same
+// slot are processed by a single wake up, in order of their due time.
+//
+// The scheduler must be created on, and used from, the task queue that the
+// pacers run on, and must outlive them.
+class PacingScheduler {
+ public:
+  explicit PacingScheduler(Clock* clock,
+                           TimeDelta resolution = TimeDelta::Millis(1));
+  PacingScheduler(const PacingScheduler&) = delete;
+  PacingScheduler& operator=(const PacingScheduler&) = delete;
+  ~PacingScheduler();
+
+  // Runs `task` on the task queue no earlier than `at_time`. Tasks due at the
+  // same time run in the order they were scheduled.
+  void ScheduleAt(Timestamp at_time, absl::AnyInvocable<void() &&> task);
+
+  TaskQueueBase* task_queue() const { return task_queue_; }
+
+  // Number of scheduled tasks that have not run yet.
+  size_t num_pending_tasks() const;
+  // Number of delayed tasks that have run on the task queue.
+  int64_t num_wakeups() const;
+
+ private:
+  struct Entry {
+    Timestamp time;
+    int64_t order;
+    absl::AnyInvocable<void() &&> task;
+  };
+  // Orders the heap with the earliest entry at the front.
+  static bool Later(const Entry& a, const Entry& b);
+
+  void MaybeScheduleWakeup() RTC_RUN_ON(sequence_checker_);
+  void OnWakeup(Timestamp wakeup_time) RTC_RUN_ON(sequence_checker_);
+
+  Clock* const clock_;
+  const TimeDelta resolution_;
+  TaskQueueBase* const task_queue_;
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+
+  std::vector<Entry> heap_ RTC_GUARDED_BY(sequence_checker_);
+  int64_t next_order_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  // Time of the posted delayed task, or plus infinity if none is posted.
+  // Posted tasks for any other time are retired.
+  Timestamp next_wakeup_time_ RTC_GUARDED_BY(sequence_checker_) =
+      Timestamp::PlusInfinity();
+  int64_t num_wakeups_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  ScopedTaskSafety safety_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_PACING_SCHEDULER_H_
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/pacing_scheduler.h"
+
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(PacingSchedulerTest, RunsTasksInOrderOfDueTime) {
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  PacingScheduler scheduler(time_controller.GetClock());
+  const Timestamp now = time_controller.GetClock()->CurrentTime();
+
+  std::vector<int> order;
+  scheduler.ScheduleAt(now + TimeDelta::Millis(3), [&] { order.push_back(3); });
+  scheduler.ScheduleAt(now + TimeDelta::Millis(1), [&] { order.push_back(1); });
+  scheduler.ScheduleAt(now + TimeDelta::Millis(2), [&] { order.push_back(2); });
+  // Ties run in the order they were scheduled.
+  scheduler.ScheduleAt(now + TimeDelta::Millis(2), [&] { order.push_back(4); });
+  EXPECT_EQ(scheduler.num_pending_tasks(), 4u);
+
+  time_controller.AdvanceTime(TimeDelta::Millis(2));
+  EXPECT_THAT(order, ElementsAre(1, 2, 4));
+  time_controller.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_THAT(order, ElementsAre(1, 2, 4, 3));
+  EXPECT_EQ(scheduler.num_pending_tasks(), 0u);
+}
+
+TEST(PacingSchedulerTest, CoalescesTasksDueWithinResolution) {
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  PacingScheduler scheduler(time_controller.GetClock(), TimeDelta::Millis(1));
+  const Timestamp now = time_controller.GetClock()->CurrentTime();
+
+  int num_runs = 0;
+  for (int us : {100, 500, 900, 1000}) {
+    scheduler.ScheduleAt(now + TimeDelta::Micros(us), [&] { ++num_runs; });
+  }
+
+  time_controller.AdvanceTime(TimeDelta::Micros(999));
+  EXPECT_EQ(num_runs, 0);
+  time_controller.AdvanceTime(TimeDelta::Micros(1));
+  EXPECT_EQ(num_runs, 4);
+  EXPECT_EQ(scheduler.num_wakeups(), 1);
+}
+
+TEST(PacingSchedulerTest, EarlierTaskAdvancesWakeup) {
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  PacingScheduler scheduler(time_controller.GetClock());
+  const Timestamp now = time_controller.GetClock()->CurrentTime();
+
+  std::vector<Timestamp> run_times;
+  auto task = [&] {
+    run_times.push_back(time_controller.GetClock()->CurrentTime());
+  };
+  scheduler.ScheduleAt(now + TimeDelta::Millis(10), task);
+  scheduler.ScheduleAt(now + TimeDelta::Millis(2), task);
+
+  time_controller.AdvanceTime(TimeDelta::Millis(20));
+  EXPECT_THAT(run_times, ElementsAre(now + TimeDelta::Millis(2),
+                                     now + TimeDelta::Millis(10)));
+  // The retired wake up for the later task doesn't count.
+  EXPECT_EQ(scheduler.num_wakeups(), 2);
+}
+
+TEST(PacingSchedulerTest, TaskScheduledWhileRunningWaitsForNextWakeup) {
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  PacingScheduler scheduler(time_controller.GetClock());
+  const Timestamp now = time_controller.GetClock()->CurrentTime();
+
+  std::vector<int> order;
+  scheduler.ScheduleAt(now + TimeDelta::Millis(1), [&] {
+    order.push_back(1);
+    scheduler.ScheduleAt(time_controller.GetClock()->CurrentTime(),
+                         [&] { order.push_back(2); });
+  });
+
+  time_controller.AdvanceTime(TimeDelta::Millis(1));
+  EXPECT_THAT(order, ElementsAre(1, 2));
+  EXPECT_EQ(scheduler.num_wakeups(), 2);
+}
+
+TEST(PacingSchedulerTest, DoesNotRunTasksAfterDestruction) {
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  std::vector<int> order;
+  {
+    PacingScheduler scheduler(time_controller.GetClock());
+    scheduler.ScheduleAt(
+        time_controller.GetClock()->CurrentTime() + TimeDelta::Millis(1),
+        [&] { order.push_back(1); });
+  }
+  time_controller.AdvanceTime(TimeDelta::Millis(10));
+  EXPECT_THAT(order, IsEmpty());
+}
+
+}  // namespace
+}  // namespace webrtc
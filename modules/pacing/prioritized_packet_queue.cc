@@ -50,65 +50,24 @@ DataSize PrioritizedPacketQueue::QueuedPacket::PacketSize() const {
 }
 
 PrioritizedPacketQueue::StreamQueue::StreamQueue(Timestamp creation_time)
-    : last_enqueue_time_(creation_time), num_keyframe_packets_(0) {}
-
-bool PrioritizedPacketQueue::StreamQueue::EnqueuePacket(QueuedPacket packet,
-                                                        int priority_level) {
-  if (packet.packet->is_key_frame()) {
-    ++num_keyframe_packets_;
-  }
-  bool first_packet_at_level = packets_[priority_level].empty();
-  packets_[priority_level].push_back(std::move(packet));
-  return first_packet_at_level;
-}
-
-PrioritizedPacketQueue::QueuedPacket
-PrioritizedPacketQueue::StreamQueue::DequeuePacket(int priority_level) {
-  RTC_DCHECK(!packets_[priority_level].empty());
-  QueuedPacket packet = std::move(packets_[priority_level].front());
-  packets_[priority_level].pop_front();
-  if (packet.packet->is_key_frame()) {
-    RTC_DCHECK_GT(num_keyframe_packets_, 0);
-    --num_keyframe_packets_;
+    : last_enqueue_time(creation_time) {
+  for (int i = 0; i < kNumPriorityLevels; ++i) {
+    head[i] = kNoPacket;
+    tail[i] = kNoPacket;
+    prev_active[i] = nullptr;
+    next_active[i] = nullptr;
   }
-  return packet;
-}
-
-bool PrioritizedPacketQueue::StreamQueue::HasPacketsAtPrio(
-    int priority_level) const {
-  return !packets_[priority_level].empty();
 }
 
 bool PrioritizedPacketQueue::StreamQueue::IsEmpty() const {
-  for (const std::deque<QueuedPacket>& queue : packets_) {
-    if (!queue.empty()) {
+  for (PacketIndex index : head) {
+    if (index != kNoPacket) {
       return false;
     }
   }
   return true;
 }
 
-Timestamp PrioritizedPacketQueue::StreamQueue::LeadingPacketEnqueueTime(
-    int priority_level) const {
-  RTC_DCHECK(!packets_[priority_level].empty());
-  return packets_[priority_level].begin()->enqueue_time;
-}
-
-Timestamp PrioritizedPacketQueue::StreamQueue::LastEnqueueTime() const {
-  return last_enqueue_time_;
-}
-
-std::array<std::deque<PrioritizedPacketQueue::QueuedPacket>,
-           PrioritizedPacketQueue::kNumPriorityLevels>
-PrioritizedPacketQueue::StreamQueue::DequeueAll() {
-  std::array<std::deque<QueuedPacket>, kNumPriorityLevels> packets_by_prio;
-  for (int i = 0; i < kNumPriorityLevels; ++i) {
-    packets_by_prio[i].swap(packets_[i]);
-  }
-  num_keyframe_packets_ = 0;
-  return packets_by_prio;
-}
-
 PrioritizedPacketQueue::PrioritizedPacketQueue(Timestamp creation_time)
     : queue_time_sum_(TimeDelta::Zero()),
       pause_time_sum_(TimeDelta::Zero()),
@@ -118,7 +77,11 @@ PrioritizedPacketQueue::PrioritizedPacketQueue(Timestamp creation_time)
       last_update_time_(creation_time),
       paused_(false),
       last_culling_time_(creation_time),
-      top_active_prio_level_(-1) {}
+      active_streams_{},
+      top_active_prio_level_(-1),
+      free_packets_(kNoPacket),
+      oldest_packet_(kNoPacket),
+      newest_packet_(kNoPacket) {}
 
 void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
                                   std::unique_ptr<RtpPacketToSend> packet) {
@@ -129,16 +92,19 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   }
   stream_queue = it->second.get();
 
-  auto enqueue_time_iterator =
-      enqueue_times_.insert(enqueue_times_.end(), enqueue_time);
   RTC_DCHECK(packet->packet_type().has_value());
   RtpPacketMediaType packet_type = packet->packet_type().value();
   int prio_level = GetPriorityForType(packet_type);
   RTC_DCHECK_GE(prio_level, 0);
   RTC_DCHECK_LT(prio_level, kNumPriorityLevels);
-  QueuedPacket queued_packed = {.packet = std::move(packet),
-                                .enqueue_time = enqueue_time,
-                                .enqueue_time_iterator = enqueue_time_iterator};
+  if (packet->is_key_frame()) {
+    ++stream_queue->num_keyframe_packets;
+  }
+
+  PacketIndex index = AllocatePacket();
+  QueuedPacket& queued_packet = packets_[index];
+  queued_packet.packet = std::move(packet);
+  queued_packet.original_enqueue_time = enqueue_time;
   // In order to figure out how much time a packet has spent in the queue
   // while not in a paused state, we subtract the total amount of time the
   // queue has been paused so far, and when the packet is popped we subtract
@@ -146,15 +112,32 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   // way we subtract the total amount of time the packet has spent in the
   // queue while in a paused state.
   UpdateAverageQueueTime(enqueue_time);
-  queued_packed.enqueue_time -= pause_time_sum_;
+  queued_packet.enqueue_time = enqueue_time - pause_time_sum_;
   ++size_packets_;
   ++size_packets_per_media_type_[static_cast<size_t>(packet_type)];
-  size_payload_ += queued_packed.PacketSize();
+  size_payload_ += queued_packet.PacketSize();
+
+  // Append to the enqueue time ordered list.
+  queued_packet.older = newest_packet_;
+  queued_packet.newer = kNoPacket;
+  if (newest_packet_ != kNoPacket) {
+    packets_[newest_packet_].newer = index;
+  } else {
+    oldest_packet_ = index;
+  }
+  newest_packet_ = index;
 
-  if (stream_queue->EnqueuePacket(std::move(queued_packed), prio_level)) {
+  // Append to the fifo of the stream.
+  queued_packet.next_in_stream = kNoPacket;
+  if (stream_queue->HasPacketsAtPrio(prio_level)) {
+    packets_[stream_queue->tail[prio_level]].next_in_stream = index;
+  } else {
+    stream_queue->head[prio_level] = index;
     // Number packets at `prio_level` for this steam is now non-zero.
-    streams_by_prio_[prio_level].push_back(stream_queue);
+    ActivateStream(stream_queue, prio_level);
   }
+  stream_queue->tail[prio_level] = index;
+
   if (top_active_prio_level_ < 0 || prio_level < top_active_prio_level_) {
     top_active_prio_level_ = prio_level;
   }
@@ -163,7 +146,7 @@ void PrioritizedPacketQueue::Push(Timestamp enqueue_time,
   if (enqueue_time - last_culling_time_ > kTimeout) {
     for (auto it = streams_.begin(); it != streams_.end();) {
       if (it->second->IsEmpty() &&
-          it->second->LastEnqueueTime() + kTimeout < enqueue_time) {
+          it->second->last_enqueue_time + kTimeout < enqueue_time) {
         streams_.erase(it++);
       } else {
         ++it;
@@ -179,20 +162,21 @@ std::unique_ptr<RtpPacketToSend> PrioritizedPacketQueue::Pop() {
   }
 
   RTC_DCHECK_GE(top_active_prio_level_, 0);
-  StreamQueue& stream_queue = *streams_by_prio_[top_active_prio_level_].front();
-  QueuedPacket packet = stream_queue.DequeuePacket(top_active_prio_level_);
-  DequeuePacketInternal(packet);
+  StreamQueue& stream_queue = *active_streams_[top_active_prio_level_];
+  PacketIndex index = DequeueFromStream(stream_queue, top_active_prio_level_);
 
-  // Remove StreamQueue from head of fifo-queue for this prio level, and
-  // and add it to the end if it still has packets.
-  streams_by_prio_[top_active_prio_level_].pop_front();
+  // Move on to the next stream in the ring for this prio level, and drop this
+  // stream from the ring if it has no more packets.
   if (stream_queue.HasPacketsAtPrio(top_active_prio_level_)) {
-    streams_by_prio_[top_active_prio_level_].push_back(&stream_queue);
+    active_streams_[top_active_prio_level_] =
+        stream_queue.next_active[top_active_prio_level_];
   } else {
-    MaybeUpdateTopPrioLevel();
+    DeactivateStream(&stream_queue, top_active_prio_level_);
   }
 
-  return std::move(packet.packet);
+  std::unique_ptr<RtpPacketToSend> packet = DequeuePacketInternal(index);
+  MaybeUpdateTopPrioLevel();
+  return packet;
 }
 
 int PrioritizedPacketQueue::SizeInPackets() const {
@@ -215,16 +199,17 @@ PrioritizedPacketQueue::SizeInPacketsPerRtpPacketMediaType() const {
 Timestamp PrioritizedPacketQueue::LeadingPacketEnqueueTime(
     RtpPacketMediaType type) const {
   const int priority_level = GetPriorityForType(type);
-  if (streams_by_prio_[priority_level].empty()) {
+  const StreamQueue* stream_queue = active_streams_[priority_level];
+  if (stream_queue == nullptr) {
     return Timestamp::MinusInfinity();
   }
-  return streams_by_prio_[priority_level].front()->LeadingPacketEnqueueTime(
-      priority_level);
+  return packets_[stream_queue->head[priority_level]].enqueue_time;
 }
 
 Timestamp PrioritizedPacketQueue::OldestEnqueueTime() const {
-  return enqueue_times_.empty() ? Timestamp::MinusInfinity()
-                                : enqueue_times_.front();
+  return oldest_packet_ == kNoPacket
+             ? Timestamp::MinusInfinity()
+             : packets_[oldest_packet_].original_enqueue_time;
 }
 
 TimeDelta PrioritizedPacketQueue::AverageQueueTime() const {
@@ -258,57 +243,101 @@ void PrioritizedPacketQueue::SetPauseState(bool paused, Timestamp now) {
 
 void PrioritizedPacketQueue::RemovePacketsForSsrc(uint32_t ssrc) {
   auto kv = streams_.find(ssrc);
-  if (kv != streams_.end()) {
-    // Dequeue all packets from the queue for this SSRC.
-    StreamQueue& queue = *kv->second;
-    std::array<std::deque<QueuedPacket>, kNumPriorityLevels> packets_by_prio =
-        queue.DequeueAll();
-    for (int i = 0; i < kNumPriorityLevels; ++i) {
-      std::deque<QueuedPacket>& packet_queue = packets_by_prio[i];
-      if (packet_queue.empty()) {
-        continue;
-      }
-
-      // First erase all packets at this prio level.
-      while (!packet_queue.empty()) {
-        QueuedPacket packet = std::move(packet_queue.front());
-        packet_queue.pop_front();
-        DequeuePacketInternal(packet);
-      }
-
-      // Next, deregister this `StreamQueue` from the round-robin tables.
-      RTC_DCHECK(!streams_by_prio_[i].empty());
-      if (streams_by_prio_[i].size() == 1) {
-        // This is the last and only queue that had packets for this prio level.
-        // Update the global top prio level if neccessary.
-        RTC_DCHECK(streams_by_prio_[i].front() == &queue);
-        streams_by_prio_[i].pop_front();
-        if (i == top_active_prio_level_) {
-          MaybeUpdateTopPrioLevel();
-        }
-      } else {
-        // More than stream had packets at this prio level, filter this one out.
-        std::deque<StreamQueue*> filtered_queue;
-        for (StreamQueue* queue_ptr : streams_by_prio_[i]) {
-          if (queue_ptr != &queue) {
-            filtered_queue.push_back(queue_ptr);
-          }
-        }
-        streams_by_prio_[i].swap(filtered_queue);
-      }
+  if (kv == streams_.end()) {
+    return;
+  }
+  // Dequeue all packets from the queue for this SSRC.
+  StreamQueue& queue = *kv->second;
+  for (int i = 0; i < kNumPriorityLevels; ++i) {
+    if (!queue.HasPacketsAtPrio(i)) {
+      continue;
+    }
+    // Deregister this `StreamQueue` from the round-robin ring, then erase all
+    // packets at this prio level.
+    DeactivateStream(&queue, i);
+    while (queue.HasPacketsAtPrio(i)) {
+      DequeuePacketInternal(DequeueFromStream(queue, i));
     }
   }
+  MaybeUpdateTopPrioLevel();
 }
 
 bool PrioritizedPacketQueue::HasKeyframePackets(uint32_t ssrc) const {
   auto it = streams_.find(ssrc);
   if (it != streams_.end()) {
-    return it->second->has_keyframe_packets();
+    return it->second->num_keyframe_packets > 0;
   }
   return false;
 }
 
-void PrioritizedPacketQueue::DequeuePacketInternal(QueuedPacket& packet) {
+PrioritizedPacketQueue::PacketIndex PrioritizedPacketQueue::AllocatePacket() {
+  if (free_packets_ == kNoPacket) {
+    packets_.emplace_back();
+    return static_cast<PacketIndex>(packets_.size() - 1);
+  }
+  PacketIndex index = free_packets_;
+  free_packets_ = packets_[index].next_in_stream;
+  return index;
+}
+
+PrioritizedPacketQueue::PacketIndex PrioritizedPacketQueue::DequeueFromStream(
+    StreamQueue& stream,
+    int priority_level) {
+  PacketIndex index = stream.head[priority_level];
+  RTC_DCHECK_NE(index, kNoPacket);
+  stream.head[priority_level] = packets_[index].next_in_stream;
+  if (stream.head[priority_level] == kNoPacket) {
+    stream.tail[priority_level] = kNoPacket;
+  }
+  if (packets_[index].packet->is_key_frame()) {
+    RTC_DCHECK_GT(stream.num_keyframe_packets, 0);
+    --stream.num_keyframe_packets;
+  }
+  return index;
+}
+
+void PrioritizedPacketQueue::ActivateStream(StreamQueue* stream,
+                                            int priority_level) {
+  RTC_DCHECK(stream->next_active[priority_level] == nullptr);
+  StreamQueue*& front = active_streams_[priority_level];
+  if (front == nullptr) {
+    stream->prev_active[priority_level] = stream;
+    stream->next_active[priority_level] = stream;
+    front = stream;
+    return;
+  }
+  // Insert before the front, i.e. at the back of the ring.
+  StreamQueue* back = front->prev_active[priority_level];
+  stream->prev_active[priority_level] = back;
+  stream->next_active[priority_level] = front;
+  back->next_active[priority_level] = stream;
+  front->prev_active[priority_level] = stream;
+}
+
+void PrioritizedPacketQueue::DeactivateStream(StreamQueue* stream,
+                                              int priority_level) {
+  StreamQueue* next = stream->next_active[priority_level];
+  StreamQueue* prev = stream->prev_active[priority_level];
+  RTC_DCHECK(next != nullptr);
+  StreamQueue*& front = active_streams_[priority_level];
+  if (next == stream) {
+    // This is the last and only stream that had packets for this prio level.
+    RTC_DCHECK(front == stream);
+    front = nullptr;
+  } else {
+    prev->next_active[priority_level] = next;
+    next->prev_active[priority_level] = prev;
+    if (front == stream) {
+      front = next;
+    }
+  }
+  stream->prev_active[priority_level] = nullptr;
+  stream->next_active[priority_level] = nullptr;
+}
+
+std::unique_ptr<RtpPacketToSend> PrioritizedPacketQueue::DequeuePacketInternal(
+    PacketIndex index) {
+  QueuedPacket& packet = packets_[index];
   --size_packets_;
   RTC_DCHECK(packet.packet->packet_type().has_value());
   RtpPacketMediaType packet_type = packet.packet->packet_type().value();
@@ -335,23 +364,38 @@ void PrioritizedPacketQueue::DequeuePacketInternal(QueuedPacket& packet) {
 
   RTC_DCHECK(size_packets_ > 0 || queue_time_sum_ == TimeDelta::Zero());
 
-  RTC_CHECK(packet.enqueue_time_iterator != enqueue_times_.end());
-  enqueue_times_.erase(packet.enqueue_time_iterator);
+  // Unlink from the enqueue time ordered list.
+  if (packet.older != kNoPacket) {
+    packets_[packet.older].newer = packet.newer;
+  } else {
+    RTC_DCHECK_EQ(oldest_packet_, index);
+    oldest_packet_ = packet.newer;
+  }
+  if (packet.newer != kNoPacket) {
+    packets_[packet.newer].older = packet.older;
+  } else {
+    RTC_DCHECK_EQ(newest_packet_, index);
+    newest_packet_ = packet.older;
+  }
+
+  std::unique_ptr<RtpPacketToSend> rtp_packet = std::move(packet.packet);
+  packet.next_in_stream = free_packets_;
+  free_packets_ = index;
+  return rtp_packet;
 }
 
 void PrioritizedPacketQueue::MaybeUpdateTopPrioLevel() {
-  if (streams_by_prio_[top_active_prio_level_].empty()) {
-    // No stream queues have packets at this prio level, find top priority
-    // that is not empty.
-    if (size_packets_ == 0) {
-      top_active_prio_level_ = -1;
-    } else {
-      for (int i = 0; i < kNumPriorityLevels; ++i) {
-        if (!streams_by_prio_[i].empty()) {
-          top_active_prio_level_ = i;
-          break;
-        }
-      }
+  if (top_active_prio_level_ < 0 ||
+      active_streams_[top_active_prio_level_] != nullptr) {
+    return;
+  }
+  // No stream queues have packets at this prio level, find top priority
+  // that is not empty.
+  top_active_prio_level_ = -1;
+  for (int i = 0; i < kNumPriorityLevels; ++i) {
+    if (active_streams_[i] != nullptr) {
+      top_active_prio_level_ = i;
+      break;
     }
   }
 }
@@ -14,8 +14,6 @@
 #include <stddef.h>
 
 #include <array>
-#include <deque>
-#include <list>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -92,48 +90,65 @@ class PrioritizedPacketQueue {
  private:
   static constexpr int kNumPriorityLevels = 4;
 
+  // Index of a slot in `packets_`. Packets are linked into lists by index so
+  // that slots can be reused without any allocation once the pool has grown
+  // to the largest queue size seen.
+  using PacketIndex = int;
+  static constexpr PacketIndex kNoPacket = -1;
+
   class QueuedPacket {
    public:
     DataSize PacketSize() const;
 
     std::unique_ptr<RtpPacketToSend> packet;
-    Timestamp enqueue_time;
-    std::list<Timestamp>::iterator enqueue_time_iterator;
+    // Enqueue time with the pause time at the time of the push subtracted.
+    Timestamp enqueue_time = Timestamp::Zero();
+    // Enqueue time as given to Push().
+    Timestamp original_enqueue_time = Timestamp::Zero();
+    // Next packet of the same stream and priority level, or the next free
+    // slot if this slot is unused.
+    PacketIndex next_in_stream = kNoPacket;
+    // Neighbours in the list of all queued packets ordered by enqueue time.
+    PacketIndex older = kNoPacket;
+    PacketIndex newer = kNoPacket;
   };
 
-  // Class containing packets for an RTP stream.
-  // For each priority level, packets are simply stored in a fifo queue.
-  class StreamQueue {
-   public:
+  // Packets for an RTP stream. For each priority level, packets are stored in
+  // a fifo queue threaded through `QueuedPacket::next_in_stream`, and streams
+  // with packets at a level are linked into a round-robin ring.
+  struct StreamQueue {
     explicit StreamQueue(Timestamp creation_time);
-    StreamQueue(StreamQueue&&) = default;
-    StreamQueue& operator=(StreamQueue&&) = default;
-
     StreamQueue(const StreamQueue&) = delete;
     StreamQueue& operator=(const StreamQueue&) = delete;
 
-    // Enqueue packet at the given priority level. Returns true if the packet
-    // count for that priority level went from zero to non-zero.
-    bool EnqueuePacket(QueuedPacket packet, int priority_level);
+    bool HasPacketsAtPrio(int priority_level) const {
+      return head[priority_level] != kNoPacket;
+    }
+    bool IsEmpty() const;
 
-    QueuedPacket DequeuePacket(int priority_level);
+    PacketIndex head[kNumPriorityLevels];
+    PacketIndex tail[kNumPriorityLevels];
+    // Neighbours in the ring of streams with packets at each priority level.
+    StreamQueue* prev_active[kNumPriorityLevels];
+    StreamQueue* next_active[kNumPriorityLevels];
+    Timestamp last_enqueue_time;
+    int num_keyframe_packets = 0;
+  };
 
-    bool HasPacketsAtPrio(int priority_level) const;
-    bool IsEmpty() const;
-    Timestamp LeadingPacketEnqueueTime(int priority_level) const;
-    Timestamp LastEnqueueTime() const;
-    bool has_keyframe_packets() const { return num_keyframe_packets_ > 0; }
+  // Takes a slot from the free list, growing the pool if it is empty.
+  PacketIndex AllocatePacket();
 
-    std::array<std::deque<QueuedPacket>, kNumPriorityLevels> DequeueAll();
+  // Removes the front packet at `priority_level` from `stream`.
+  PacketIndex DequeueFromStream(StreamQueue& stream, int priority_level);
 
-   private:
-    std::deque<QueuedPacket> packets_[kNumPriorityLevels];
-    Timestamp last_enqueue_time_;
-    int num_keyframe_packets_;
-  };
+  // Adds `stream` to the back of, or removes it from, the round-robin ring
+  // for `priority_level`.
+  void ActivateStream(StreamQueue* stream, int priority_level);
+  void DeactivateStream(StreamQueue* stream, int priority_level);
 
-  // Remove the packet from the internal state, e.g. queue time / size etc.
-  void DequeuePacketInternal(QueuedPacket& packet);
+  // Remove the packet from the internal state, e.g. queue time / size etc,
+  // and return its slot to the free list.
+  std::unique_ptr<RtpPacketToSend> DequeuePacketInternal(PacketIndex index);
 
   // Check if the queue pointed to by `top_active_prio_level_` is empty and
   // if so move it to the lowest non-empty index.
@@ -159,17 +174,20 @@ class PrioritizedPacketQueue {
   // Map from SSRC to packet queues for the associated RTP stream.
   std::unordered_map<uint32_t, std::unique_ptr<StreamQueue>> streams_;
 
-  // For each priority level, a queue of StreamQueues which have at least one
-  // packet pending for that prio level.
-  std::deque<StreamQueue*> streams_by_prio_[kNumPriorityLevels];
+  // For each priority level, the stream to send from next in the ring of
+  // streams that have at least one packet pending for that prio level.
+  StreamQueue* active_streams_[kNumPriorityLevels];
 
-  // The first index into `stream_by_prio_` that is non-empty.
+  // The first index into `active_streams_` that is non-null.
   int top_active_prio_level_;
 
-  // Ordered list of enqueue times. Additions are always increasing and added to
-  // the end. QueuedPacket instances have a iterators into this list for fast
-  // removal.
-  std::list<Timestamp> enqueue_times_;
+  // Pool of packet slots, both queued and free.
+  std::vector<QueuedPacket> packets_;
+  PacketIndex free_packets_;
+  // Ends of the list of queued packets ordered by enqueue time. Additions are
+  // always increasing and added to the newest end.
+  PacketIndex oldest_packet_;
+  PacketIndex newest_packet_;
 };
 
 }  // namespace webrtc
@@ -362,6 +362,61 @@ TEST(PrioritizedPacketQueue, ClearPacketsAffectsOnlySpecifiedSsrc) {
   EXPECT_TRUE(queue.Empty());
 }
 
+TEST(PrioritizedPacketQueue, RoundRobinsManyStreamsAroundRemovedStreams) {
+  Timestamp now = Timestamp::Zero();
+  PrioritizedPacketQueue queue(now);
+  constexpr uint32_t kNumStreams = 300;
+
+  // Two rounds of packets for each stream.
+  for (uint16_t seq = 0; seq < 2; ++seq) {
+    for (uint32_t ssrc = 1; ssrc <= kNumStreams; ++ssrc) {
+      queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, seq, ssrc));
+    }
+  }
+  // Remove every third stream, including the first and the last.
+  for (uint32_t ssrc = 1; ssrc <= kNumStreams; ssrc += 3) {
+    queue.RemovePacketsForSsrc(ssrc);
+  }
+  queue.RemovePacketsForSsrc(kNumStreams);
+  EXPECT_EQ(queue.SizeInPackets(), 2 * 199);
+
+  for (uint16_t seq = 0; seq < 2; ++seq) {
+    for (uint32_t ssrc = 1; ssrc <= kNumStreams; ++ssrc) {
+      if (ssrc % 3 == 1 || ssrc == kNumStreams) {
+        continue;
+      }
+      std::unique_ptr<RtpPacketToSend> packet = queue.Pop();
+      ASSERT_TRUE(packet);
+      EXPECT_EQ(packet->Ssrc(), ssrc);
+      EXPECT_EQ(packet->SequenceNumber(), seq);
+    }
+  }
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(queue.OldestEnqueueTime(), Timestamp::MinusInfinity());
+}
+
+TEST(PrioritizedPacketQueue, ReusesSlotsOfPoppedPackets) {
+  Timestamp now = Timestamp::Zero();
+  PrioritizedPacketQueue queue(now);
+
+  // Interleave pushes and pops so that freed slots are reused while other
+  // packets are still queued, and check the enqueue time order survives.
+  queue.Push(now, CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/1));
+  queue.Push(now + TimeDelta::Millis(1),
+             CreatePacket(RtpPacketMediaType::kAudio, /*seq=*/2));
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 2);
+  queue.Push(now + TimeDelta::Millis(2),
+             CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/3));
+  EXPECT_EQ(queue.OldestEnqueueTime(), now);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 1);
+  EXPECT_EQ(queue.OldestEnqueueTime(), now + TimeDelta::Millis(2));
+  queue.Push(now + TimeDelta::Millis(3),
+             CreatePacket(RtpPacketMediaType::kVideo, /*seq=*/4));
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 3);
+  EXPECT_EQ(queue.Pop()->SequenceNumber(), 4);
+  EXPECT_TRUE(queue.Empty());
+}
+
 TEST(PrioritizedPacketQueue, ReportsKeyframePackets) {
   Timestamp now = Timestamp::Zero();
   PrioritizedPacketQueue queue(now);
@@ -14,8 +14,10 @@
 #include <utility>
 
 #include "absl/cleanup/cleanup.h"
+#include "absl/functional/any_invocable.h"
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/transport/network_types.h"
+#include "modules/pacing/pacing_scheduler.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/trace_event.h"
 
@@ -28,7 +30,8 @@ TaskQueuePacedSender::TaskQueuePacedSender(
     PacingController::PacketSender* packet_sender,
     const FieldTrialsView& field_trials,
     TimeDelta max_hold_back_window,
-    int max_hold_back_window_in_packets)
+    int max_hold_back_window_in_packets,
+    PacingScheduler* scheduler)
     : clock_(clock),
       max_hold_back_window_(max_hold_back_window),
       max_hold_back_window_in_packets_(max_hold_back_window_in_packets),
@@ -38,8 +41,10 @@ TaskQueuePacedSender::TaskQueuePacedSender(
       is_shutdown_(false),
       packet_size_(/*alpha=*/0.95),
       include_overhead_(false),
-      task_queue_(TaskQueueBase::Current()) {
+      task_queue_(TaskQueueBase::Current()),
+      scheduler_(scheduler) {
   RTC_DCHECK_GE(max_hold_back_window_, PacingController::kMinSleepTime);
+  RTC_DCHECK(!scheduler_ || scheduler_->task_queue() == task_queue_);
 }
 
 TaskQueuePacedSender::~TaskQueuePacedSender() {
@@ -208,6 +213,14 @@ void TaskQueuePacedSender::MaybeProcessPackets(
   Timestamp next_send_time = pacing_controller_.NextSendTime();
   RTC_DCHECK(next_send_time.IsFinite());
   const Timestamp now = clock_->CurrentTime();
+  if (scheduled_process_time.IsFinite()) {
+    TimeDelta wakeup_delay =
+        std::max(now - scheduled_process_time, TimeDelta::Zero());
+    ++wakeup_stats_.num_wakeups;
+    wakeup_stats_.total_wakeup_delay += wakeup_delay;
+    wakeup_stats_.max_wakeup_delay =
+        std::max(wakeup_stats_.max_wakeup_delay, wakeup_delay);
+  }
   TimeDelta early_execute_margin =
       pacing_controller_.IsProbing()
           ? PacingController::kMaxEarlyProbeProcessing
@@ -259,12 +272,16 @@ void TaskQueuePacedSender::MaybeProcessPackets(
   // schedule a new one. Previous in flight task will be retired.
   if (next_process_time_.IsMinusInfinity() ||
       next_process_time_ > next_send_time) {
-    // Prefer low precision if allowed and not probing.
-    task_queue_->PostDelayedHighPrecisionTask(
-        SafeTask(
-            safety_.flag(),
-            [this, next_send_time]() { MaybeProcessPackets(next_send_time); }),
-        time_to_next_process.RoundUpTo(TimeDelta::Millis(1)));
+    absl::AnyInvocable<void() &&> task = SafeTask(
+        safety_.flag(),
+        [this, next_send_time]() { MaybeProcessPackets(next_send_time); });
+    if (scheduler_) {
+      scheduler_->ScheduleAt(next_send_time, std::move(task));
+    } else {
+      task_queue_->PostDelayedHighPrecisionTask(
+          std::move(task),
+          time_to_next_process.RoundUpTo(TimeDelta::Millis(1)));
+    }
     next_process_time_ = next_send_time;
   }
 }
@@ -279,6 +296,12 @@ void TaskQueuePacedSender::UpdateStats() {
   OnStatsUpdated(new_stats);
 }
 
+TaskQueuePacedSender::WakeupStats TaskQueuePacedSender::GetWakeupStats()
+    const {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  return wakeup_stats_;
+}
+
 TaskQueuePacedSender::Stats TaskQueuePacedSender::GetStats() const {
   RTC_DCHECK_RUN_ON(task_queue_);
   return current_stats_;
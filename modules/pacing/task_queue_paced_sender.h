@@ -33,6 +33,7 @@
 
 namespace webrtc {
 class Clock;
+class PacingScheduler;
 
 class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
  public:
@@ -47,11 +48,17 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   //
   // The taskqueue used when constructing a TaskQueuePacedSender will also be
   // used for pacing.
+  //
+  // If `scheduler` is set, delayed process tasks are scheduled through it
+  // instead of being posted directly to the task queue, so that the wake ups
+  // of several pacers sharing the task queue can be coalesced. The scheduler
+  // must run on the same task queue and outlive the pacer.
   TaskQueuePacedSender(Clock* clock,
                        PacingController::PacketSender* packet_sender,
                        const FieldTrialsView& field_trials,
                        TimeDelta max_hold_back_window,
-                       int max_hold_back_window_in_packets);
+                       int max_hold_back_window_in_packets,
+                       PacingScheduler* scheduler = nullptr);
 
   ~TaskQueuePacedSender() override;
 
@@ -63,6 +70,19 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   // Ensure that necessary delayed tasks are scheduled.
   void EnsureStarted();
 
+  struct WakeupStats {
+    // Number of delayed process tasks that have run.
+    int64_t num_wakeups = 0;
+    // How much later than scheduled the delayed process tasks ran, e.g.
+    // because of timer resolution or a busy task queue.
+    TimeDelta total_wakeup_delay = TimeDelta::Zero();
+    TimeDelta max_wakeup_delay = TimeDelta::Zero();
+  };
+  // Returns statistics on the timing of the pacer's wake ups, so that the
+  // effect of the hold back window and the send burst interval can be
+  // measured.
+  WakeupStats GetWakeupStats() const;
+
   // Methods implementing RtpPacketSender.
 
   // Adds the packet to the queue and calls
@@ -172,11 +192,13 @@ class TaskQueuePacedSender : public RtpPacketPacer, public RtpPacketSender {
   bool include_overhead_ RTC_GUARDED_BY(task_queue_);
 
   Stats current_stats_ RTC_GUARDED_BY(task_queue_);
+  WakeupStats wakeup_stats_ RTC_GUARDED_BY(task_queue_);
   // Protects against ProcessPackets reentry from packet sent receipts.
   bool processing_packets_ RTC_GUARDED_BY(task_queue_) = false;
 
   ScopedTaskSafety safety_;
   TaskQueueBase* task_queue_;
+  PacingScheduler* const scheduler_;
 };
 }  // namespace webrtc
 #endif  // MODULES_PACING_TASK_QUEUE_PACED_SENDER_H_
@@ -26,6 +26,7 @@
 #include "api/units/data_size.h"
 #include "api/units/time_delta.h"
 #include "modules/pacing/pacing_controller.h"
+#include "modules/pacing/pacing_scheduler.h"
 #include "modules/pacing/packet_router.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "test/gmock.h"
@@ -212,6 +213,99 @@ TEST(TaskQueuePacedSenderTest, PacesPacketsWithBurst) {
   EXPECT_NEAR((end_time - start_time).ms<double>(), 500.0, 50.0);
 }
 
+TEST(TaskQueuePacedSenderTest, ReportsWakeupStats) {
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  NiceMock<MockPacketRouter> packet_router;
+  ScopedKeyValueConfig trials;
+  TaskQueuePacedSender pacer(time_controller.GetClock(), &packet_router, trials,
+                             PacingController::kMinSleepTime,
+                             TaskQueuePacedSender::kNoPacketHoldback);
+  pacer.SetSendBurstInterval(TimeDelta::Zero());
+  EXPECT_EQ(pacer.GetWakeupStats().num_wakeups, 0);
+
+  // Insert a number of packets, covering one second.
+  static constexpr size_t kPacketsToSend = 42;
+  pacer.SetPacingRates(
+      DataRate::BitsPerSec(kDefaultPacketSize * 8 * kPacketsToSend),
+      DataRate::Zero());
+  pacer.EnsureStarted();
+  pacer.EnqueuePackets(
+      GeneratePackets(RtpPacketMediaType::kVideo, kPacketsToSend));
+  time_controller.AdvanceTime(TimeDelta::Seconds(1));
+
+  // Without bursting, the pacer wakes up about once per packet. Wake ups are
+  // delayed at most by the rounding of delayed tasks to whole milliseconds.
+  TaskQueuePacedSender::WakeupStats stats = pacer.GetWakeupStats();
+  EXPECT_GE(stats.num_wakeups, static_cast<int64_t>(kPacketsToSend) - 5);
+  EXPECT_LT(stats.max_wakeup_delay, TimeDelta::Millis(1));
+  EXPECT_LE(stats.total_wakeup_delay, stats.num_wakeups * TimeDelta::Millis(1));
+}
+
+TEST(TaskQueuePacedSenderTest, BurstIntervalReducesWakeups) {
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  NiceMock<MockPacketRouter> packet_router;
+  ScopedKeyValueConfig trials;
+  TaskQueuePacedSender pacer(time_controller.GetClock(), &packet_router, trials,
+                             PacingController::kMinSleepTime,
+                             TaskQueuePacedSender::kNoPacketHoldback);
+  pacer.SetSendBurstInterval(TimeDelta::Millis(20));
+
+  // 5 Mbps of video, sent as 50 packets every 100 ms.
+  static constexpr int kPacketsPerFrame = 50;
+  pacer.SetPacingRates(
+      DataRate::BitsPerSec(kDefaultPacketSize * 8 * kPacketsPerFrame * 12),
+      DataRate::Zero());
+  pacer.EnsureStarted();
+  for (int i = 0; i < 10; ++i) {
+    pacer.EnqueuePackets(
+        GeneratePackets(RtpPacketMediaType::kVideo, kPacketsPerFrame));
+    time_controller.AdvanceTime(TimeDelta::Millis(100));
+  }
+
+  EXPECT_LT(pacer.GetWakeupStats().num_wakeups, 10 * kPacketsPerFrame / 4);
+}
+
+TEST(TaskQueuePacedSenderTest, SharedSchedulerCoalescesWakeups) {
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
+  MockPacketRouter packet_router;
+  ScopedKeyValueConfig trials;
+  PacingScheduler scheduler(time_controller.GetClock());
+
+  // Several pacers, e.g. for different peers, each sending 42 packets over
+  // one second.
+  static constexpr int kNumPacers = 4;
+  static constexpr size_t kPacketsToSend = 42;
+  std::vector<std::unique_ptr<TaskQueuePacedSender>> pacers;
+  for (int i = 0; i < kNumPacers; ++i) {
+    pacers.push_back(std::make_unique<TaskQueuePacedSender>(
+        time_controller.GetClock(), &packet_router, trials,
+        PacingController::kMinSleepTime,
+        TaskQueuePacedSender::kNoPacketHoldback, &scheduler));
+    pacers.back()->SetSendBurstInterval(TimeDelta::Zero());
+    pacers.back()->SetPacingRates(
+        DataRate::BitsPerSec(kDefaultPacketSize * 8 * kPacketsToSend),
+        DataRate::Zero());
+    pacers.back()->EnsureStarted();
+  }
+
+  EXPECT_CALL(packet_router, SendPacket).Times(kNumPacers * kPacketsToSend);
+  for (auto& pacer : pacers) {
+    pacer->EnqueuePackets(
+        GeneratePackets(RtpPacketMediaType::kVideo, kPacketsToSend));
+  }
+  time_controller.AdvanceTime(TimeDelta::Seconds(1));
+
+  // Each pacer still wakes up about once per packet, but the pacers that are
+  // due at the same time share the wake ups of the task queue.
+  int64_t num_pacer_wakeups = 0;
+  for (auto& pacer : pacers) {
+    EXPECT_GE(pacer->GetWakeupStats().num_wakeups,
+              static_cast<int64_t>(kPacketsToSend) - 5);
+    num_pacer_wakeups += pacer->GetWakeupStats().num_wakeups;
+  }
+  EXPECT_LE(scheduler.num_wakeups(), num_pacer_wakeups / kNumPacers + 5);
+}
+
 TEST(TaskQueuePacedSenderTest, ReschedulesProcessOnRateChange) {
   GlobalSimulatedTimeController time_controller(Timestamp::Millis(1234));
   MockPacketRouter packet_router;
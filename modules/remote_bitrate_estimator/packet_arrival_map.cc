@@ -17,6 +17,30 @@
 
 namespace webrtc {
 
+PacketArrivalTimeMap::PacketArrivalTime PacketArrivalTimeMap::FindNextAtOrAfter(
+    int64_t sequence_number) const {
+  RTC_DCHECK_GE(sequence_number, begin_sequence_number());
+  RTC_DCHECK_LT(sequence_number, end_sequence_number());
+  auto is_received = [](Timestamp t) { return t >= Timestamp::Zero(); };
+  // Scans runs of missing packets as contiguous memory, which wraps around at
+  // most once. The last packet in the map is always received, so the scan
+  // never reaches slots outside the map.
+  const Timestamp* const first_slot = arrival_times_.get();
+  const Timestamp* const end_slot = first_slot + capacity();
+  const Timestamp* const start_slot = first_slot + Index(sequence_number);
+  const Timestamp* slot = std::find_if(start_slot, end_slot, is_received);
+  if (slot == end_slot) {
+    sequence_number += end_slot - start_slot;
+    slot = std::find_if(first_slot, start_slot, is_received);
+    RTC_DCHECK(slot != start_slot);
+    sequence_number += slot - first_slot;
+  } else {
+    sequence_number += slot - start_slot;
+  }
+  RTC_DCHECK_LT(sequence_number, end_sequence_number());
+  return {.arrival_time = *slot, .sequence_number = sequence_number};
+}
+
 void PacketArrivalTimeMap::AddPacket(int64_t sequence_number,
                                      Timestamp arrival_time) {
   RTC_DCHECK_GE(arrival_time, Timestamp::Zero());
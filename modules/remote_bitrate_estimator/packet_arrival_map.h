@@ -70,17 +70,7 @@ class PacketArrivalTimeMap {
   // Returns timestamp and sequence number of the received packet with sequence
   // number equal or larger than `sequence_number`. `sequence_number` must be in
   // range [begin_sequence_number, end_sequence_number).
-  PacketArrivalTime FindNextAtOrAfter(int64_t sequence_number) const {
-    RTC_DCHECK_GE(sequence_number, begin_sequence_number());
-    RTC_DCHECK_LT(sequence_number, end_sequence_number());
-    while (true) {
-      Timestamp t = arrival_times_[Index(sequence_number)];
-      if (t >= Timestamp::Zero()) {
-        return {.arrival_time = t, .sequence_number = sequence_number};
-      }
-      ++sequence_number;
-    }
-  }
+  PacketArrivalTime FindNextAtOrAfter(int64_t sequence_number) const;
 
   // Clamps `sequence_number` between [begin_sequence_number,
   // end_sequence_number].
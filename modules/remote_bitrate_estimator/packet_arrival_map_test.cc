@@ -82,6 +82,23 @@ TEST(PacketArrivalMapTest, FindNextAtOrAfterWithGaps) {
   EXPECT_EQ(packet.sequence_number, 45);
 }
 
+TEST(PacketArrivalMapTest, FindNextAtOrAfterAcrossBufferWrap) {
+  PacketArrivalTimeMap map;
+
+  // With the minimum capacity of 128 packets, the gap between the packets
+  // wraps around the end of the buffer.
+  map.AddPacket(100, Timestamp::Millis(1));
+  map.AddPacket(200, Timestamp::Millis(2));
+
+  PacketArrivalTimeMap::PacketArrivalTime packet = map.FindNextAtOrAfter(101);
+  EXPECT_EQ(packet.arrival_time, Timestamp::Millis(2));
+  EXPECT_EQ(packet.sequence_number, 200);
+
+  packet = map.FindNextAtOrAfter(130);
+  EXPECT_EQ(packet.arrival_time, Timestamp::Millis(2));
+  EXPECT_EQ(packet.sequence_number, 200);
+}
+
 TEST(PacketArrivalMapTest, InsertsWithinBuffer) {
   PacketArrivalTimeMap map;
 
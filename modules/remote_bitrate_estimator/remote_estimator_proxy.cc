@@ -19,6 +19,7 @@
 #include "absl/types/optional.h"
 #include "api/units/data_size.h"
 #include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/remote_estimate.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
@@ -34,6 +35,18 @@ constexpr TimeDelta kBackWindow = TimeDelta::Millis(500);
 constexpr TimeDelta kMinInterval = TimeDelta::Millis(50);
 constexpr TimeDelta kMaxInterval = TimeDelta::Millis(250);
 constexpr TimeDelta kDefaultInterval = TimeDelta::Millis(100);
+// Streams that stopped receiving packets are forgotten after this time.
+constexpr TimeDelta kRtpStreamTimeout = TimeDelta::Seconds(10);
+// Congestion control feedback is split to keep the RTCP packets this small.
+constexpr size_t kMaxCongestionControlFeedbackSize = 1200;
+
+// Converts a packet arrival time to the 32 bit compact NTP format, the middle
+// 32 bits of a 64 bit NTP timestamp.
+uint32_t ToCompactNtp(Timestamp time) {
+  int64_t seconds = time.us() / 1'000'000;
+  int64_t fraction = time.us() % 1'000'000;
+  return static_cast<uint32_t>((seconds << 16) | (fraction << 16) / 1'000'000);
+}
 
 TimeDelta GetAbsoluteSendTimeDelta(uint32_t new_sendtime,
                                    uint32_t previous_sendtime) {
@@ -89,6 +102,14 @@ void RemoteEstimatorProxy::IncomingPacket(const RtpPacketReceived& packet) {
     return;
   }
 
+  {
+    MutexLock lock(&lock_);
+    if (send_congestion_control_feedback_) {
+      OnPacketForCongestionControlFeedback(packet);
+      return;
+    }
+  }
+
   uint16_t seqnum = 0;
   absl::optional<FeedbackRequest> feedback_request;
   if (!packet.GetExtension<TransportSequenceNumber>(&seqnum) &&
@@ -159,6 +180,15 @@ void RemoteEstimatorProxy::IncomingPacket(const RtpPacketReceived& packet) {
 
 TimeDelta RemoteEstimatorProxy::Process(Timestamp now) {
   MutexLock lock(&lock_);
+  if (send_congestion_control_feedback_) {
+    Timestamp next_process_time = last_process_time_ + send_interval_;
+    if (now >= next_process_time) {
+      last_process_time_ = now;
+      SendCongestionControlFeedback(now);
+      return send_interval_;
+    }
+    return next_process_time - now;
+  }
   if (!send_periodic_feedback_) {
     // If TransportSequenceNumberV2 has been received in one packet,
     // PeriodicFeedback is disabled for the rest of the call.
@@ -202,6 +232,135 @@ void RemoteEstimatorProxy::SetTransportOverhead(DataSize overhead_per_packet) {
   packet_overhead_ = overhead_per_packet;
 }
 
+void RemoteEstimatorProxy::EnableCongestionControlFeedback() {
+  MutexLock lock(&lock_);
+  send_congestion_control_feedback_ = true;
+}
+
+void RemoteEstimatorProxy::OnPacketForCongestionControlFeedback(
+    const RtpPacketReceived& packet) {
+  RtpStreamArrivals& stream = rtp_streams_[packet.Ssrc()];
+  int64_t seq = stream.unwrapper.Unwrap(packet.SequenceNumber());
+  stream.last_arrival_time = packet.arrival_time();
+  if (stream.arrival_times.has_received(seq)) {
+    return;
+  }
+
+  if (stream.next_report_sequence_number >=
+          stream.arrival_times.end_sequence_number() &&
+      packet.arrival_time() - Timestamp::Zero() >= kBackWindow) {
+    // All packets have been reported, cull old packets.
+    stream.arrival_times.RemoveOldPackets(seq,
+                                          packet.arrival_time() - kBackWindow);
+  }
+  bool first_packet = stream.arrival_times.end_sequence_number() ==
+                      stream.arrival_times.begin_sequence_number();
+  stream.arrival_times.AddPacket(seq, packet.arrival_time());
+  stream.ecn_markings.erase(stream.ecn_markings.begin(),
+                            stream.ecn_markings.lower_bound(
+                                stream.arrival_times.begin_sequence_number()));
+  if (packet.ecn() != rtc::EcnMarking::kNotEct) {
+    stream.ecn_markings[seq] = packet.ecn();
+  }
+
+  // Reordered packets are reported again, together with the packets after
+  // them, as long as they are in the map.
+  if (first_packet || seq < stream.next_report_sequence_number) {
+    stream.next_report_sequence_number = seq;
+  }
+  stream.next_report_sequence_number =
+      stream.arrival_times.clamp(stream.next_report_sequence_number);
+}
+
+void RemoteEstimatorProxy::SendCongestionControlFeedback(Timestamp now) {
+  // The report is timestamped with the latest packet arrival time, so that
+  // the timestamp and the arrival time offsets use the same clock.
+  Timestamp report_time = Timestamp::MinusInfinity();
+  for (const auto& [ssrc, stream] : rtp_streams_) {
+    report_time = std::max(report_time, stream.last_arrival_time);
+  }
+  if (report_time.IsInfinite()) {
+    return;
+  }
+  const uint32_t report_timestamp = ToCompactNtp(report_time);
+  std::unique_ptr<rtcp::RemoteEstimate> remote_estimate =
+      MaybeBuildRemoteEstimate();
+  std::vector<rtcp::CongestionControlFeedback::PacketInfo> packets;
+  // Header, sender SSRC and report timestamp.
+  size_t feedback_size = 12;
+
+  auto send_feedback = [&] {
+    RTC_DCHECK(feedback_sender_ != nullptr);
+    std::vector<std::unique_ptr<rtcp::RtcpPacket>> rtcp_packets;
+    if (remote_estimate) {
+      rtcp_packets.push_back(std::move(remote_estimate));
+    }
+    rtcp_packets.push_back(std::make_unique<rtcp::CongestionControlFeedback>(
+        std::move(packets), report_timestamp));
+    feedback_sender_(std::move(rtcp_packets));
+    packets.clear();
+    feedback_size = 12;
+  };
+
+  for (auto it = rtp_streams_.begin(); it != rtp_streams_.end();) {
+    RtpStreamArrivals& stream = it->second;
+    if (now - stream.last_arrival_time > kRtpStreamTimeout) {
+      it = rtp_streams_.erase(it);
+      continue;
+    }
+    const int64_t end_seq = stream.arrival_times.end_sequence_number();
+    auto ecn_it =
+        stream.ecn_markings.lower_bound(stream.next_report_sequence_number);
+    bool new_report_block = true;
+    for (int64_t seq = stream.next_report_sequence_number; seq < end_seq;
+         ++seq) {
+      // A report block has an 8 byte header and is padded to 32 bits, each
+      // packet takes 2 bytes.
+      size_t packet_size = new_report_block ? 8 + 4 : 2;
+      if (feedback_size + packet_size > kMaxCongestionControlFeedbackSize) {
+        send_feedback();
+        packet_size = 8 + 4;
+      }
+      feedback_size += packet_size;
+      new_report_block = false;
+
+      Timestamp arrival_time = stream.arrival_times.get(seq);
+      rtc::EcnMarking ecn = rtc::EcnMarking::kNotEct;
+      if (ecn_it != stream.ecn_markings.end() && ecn_it->first == seq) {
+        ecn = ecn_it->second;
+        ++ecn_it;
+      }
+      packets.push_back(
+          {.ssrc = it->first,
+           .sequence_number = static_cast<uint16_t>(seq),
+           .arrival_time_offset = arrival_time >= Timestamp::Zero()
+                                      ? report_time - arrival_time
+                                      : TimeDelta::MinusInfinity(),
+           .ecn = ecn});
+    }
+    stream.next_report_sequence_number = end_seq;
+    ++it;
+  }
+  if (!packets.empty()) {
+    send_feedback();
+  }
+}
+
+std::unique_ptr<rtcp::RemoteEstimate>
+RemoteEstimatorProxy::MaybeBuildRemoteEstimate() {
+  if (!network_state_estimator_) {
+    return nullptr;
+  }
+  absl::optional<NetworkStateEstimate> state_estimate =
+      network_state_estimator_->GetCurrentEstimate();
+  if (!state_estimate) {
+    return nullptr;
+  }
+  auto remote_estimate = std::make_unique<rtcp::RemoteEstimate>();
+  remote_estimate->SetEstimate(state_estimate.value());
+  return remote_estimate;
+}
+
 void RemoteEstimatorProxy::SendPeriodicFeedbacks() {
   // `periodic_window_start_seq_` is the first sequence number to include in
   // the current feedback packet. Some older may still be in the map, in case
@@ -209,15 +368,8 @@ void RemoteEstimatorProxy::SendPeriodicFeedbacks() {
   if (!periodic_window_start_seq_)
     return;
 
-  std::unique_ptr<rtcp::RemoteEstimate> remote_estimate;
-  if (network_state_estimator_) {
-    absl::optional<NetworkStateEstimate> state_estimate =
-        network_state_estimator_->GetCurrentEstimate();
-    if (state_estimate) {
-      remote_estimate = std::make_unique<rtcp::RemoteEstimate>();
-      remote_estimate->SetEstimate(state_estimate.value());
-    }
-  }
+  std::unique_ptr<rtcp::RemoteEstimate> remote_estimate =
+      MaybeBuildRemoteEstimate();
 
   int64_t packet_arrival_times_end_seq =
       packet_arrival_times_.end_sequence_number();
@@ -13,6 +13,7 @@
 
 #include <deque>
 #include <functional>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -25,8 +26,10 @@
 #include "api/units/timestamp.h"
 #include "modules/remote_bitrate_estimator/packet_arrival_map.h"
 #include "modules/rtp_rtcp/source/rtcp_packet.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/remote_estimate.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
 #include "rtc_base/synchronization/mutex.h"
 
@@ -54,7 +57,31 @@ class RemoteEstimatorProxy {
   void OnBitrateChanged(int bitrate);
   void SetTransportOverhead(DataSize overhead_per_packet);
 
+  // Sends periodic congestion control feedback according to RFC 8888, built
+  // from the arrival times of all incoming RTP packets by SSRC and RTP
+  // sequence number, instead of transport-wide congestion control feedback.
+  // Packets no longer need a transport sequence number.
+  void EnableCongestionControlFeedback();
+
  private:
+  // Arrival times of packets of one RTP stream, by RTP sequence number.
+  struct RtpStreamArrivals {
+    SeqNumUnwrapper<uint16_t> unwrapper;
+    PacketArrivalTimeMap arrival_times;
+    // First sequence number to include in the next feedback.
+    int64_t next_report_sequence_number = 0;
+    Timestamp last_arrival_time = Timestamp::MinusInfinity();
+    // ECN codepoints of the packets in `arrival_times` that arrived ECN
+    // capable, by sequence number. Empty unless the sender marks packets.
+    std::map<int64_t, rtc::EcnMarking> ecn_markings;
+  };
+
+  void OnPacketForCongestionControlFeedback(const RtpPacketReceived& packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  void SendCongestionControlFeedback(Timestamp now)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  std::unique_ptr<rtcp::RemoteEstimate> MaybeBuildRemoteEstimate()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   void MaybeCullOldPackets(int64_t sequence_number, Timestamp arrival_time)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   void SendPeriodicFeedbacks() RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
@@ -102,6 +129,9 @@ class RemoteEstimatorProxy {
   TimeDelta send_interval_ RTC_GUARDED_BY(&lock_);
   bool send_periodic_feedback_ RTC_GUARDED_BY(&lock_);
 
+  bool send_congestion_control_feedback_ RTC_GUARDED_BY(&lock_) = false;
+  std::map<uint32_t, RtpStreamArrivals> rtp_streams_ RTC_GUARDED_BY(&lock_);
+
   // Unwraps absolute send times.
   uint32_t previous_abs_send_time_ RTC_GUARDED_BY(&lock_);
   Timestamp abs_send_timestamp_ RTC_GUARDED_BY(&lock_);
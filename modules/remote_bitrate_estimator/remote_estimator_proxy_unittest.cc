@@ -20,6 +20,7 @@
 #include "api/units/data_size.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
@@ -111,6 +112,18 @@ class RemoteEstimatorProxyTest : public ::testing::Test {
     proxy_.IncomingPacket(packet);
   }
 
+  // Receives a packet without transport sequence number.
+  void IncomingRtpPacket(uint32_t ssrc,
+                         uint16_t seq,
+                         Timestamp arrival_time,
+                         rtc::EcnMarking ecn = rtc::EcnMarking::kNotEct) {
+    RtpPacketReceived packet(nullptr, arrival_time);
+    packet.SetSsrc(ssrc);
+    packet.SetSequenceNumber(seq);
+    packet.set_ecn(ecn);
+    proxy_.IncomingPacket(packet);
+  }
+
   void Process() {
     clock_.AdvanceTime(kDefaultSendInterval);
     proxy_.Process(clock_.CurrentTime());
@@ -666,5 +679,146 @@ TEST_F(RemoteEstimatorProxyTest, SendTransportFeedbackAndNetworkStateUpdate) {
   Process();
 }
 
+std::vector<rtcp::CongestionControlFeedback::PacketInfo> PacketInfos(
+    const std::vector<std::unique_ptr<rtcp::RtcpPacket>>& feedback_packets) {
+  std::vector<rtcp::CongestionControlFeedback::PacketInfo> packets;
+  for (const auto& feedback_packet : feedback_packets) {
+    const auto* feedback =
+        static_cast<const rtcp::CongestionControlFeedback*>(
+            feedback_packet.get());
+    packets.insert(packets.end(), feedback->packets().begin(),
+                   feedback->packets().end());
+  }
+  return packets;
+}
+
+TEST_F(RemoteEstimatorProxyTest, SendsCongestionControlFeedbackPerStream) {
+  constexpr uint32_t kOtherSsrc = 789;
+  proxy_.EnableCongestionControlFeedback();
+  clock_.AdvanceTime(kBaseTime - clock_.CurrentTime());
+  IncomingRtpPacket(kMediaSsrc, kBaseSeq, kBaseTime);
+  IncomingRtpPacket(kMediaSsrc, kBaseSeq + 1, kBaseTime + TimeDelta::Millis(1));
+  IncomingRtpPacket(kMediaSsrc, kBaseSeq + 3, kBaseTime + TimeDelta::Millis(3));
+  IncomingRtpPacket(kOtherSsrc, 0xFFFF, kBaseTime + TimeDelta::Millis(4));
+  IncomingRtpPacket(kOtherSsrc, 0, kBaseTime + TimeDelta::Millis(5));
+
+  std::vector<std::unique_ptr<rtcp::RtcpPacket>> feedback_packets;
+  EXPECT_CALL(feedback_sender_, Call)
+      .WillOnce([&](std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets) {
+        feedback_packets = std::move(packets);
+      });
+  Process();
+
+  ASSERT_THAT(feedback_packets, SizeIs(1));
+  std::vector<rtcp::CongestionControlFeedback::PacketInfo> packets =
+      PacketInfos(feedback_packets);
+  ASSERT_THAT(packets, SizeIs(6));
+  // The report is timestamped with the arrival time of the last packet.
+  const Timestamp report_time = kBaseTime + TimeDelta::Millis(5);
+  EXPECT_EQ(packets[0].ssrc, kMediaSsrc);
+  EXPECT_EQ(packets[0].sequence_number, kBaseSeq);
+  EXPECT_EQ(packets[0].arrival_time_offset, report_time - kBaseTime);
+  EXPECT_EQ(packets[2].sequence_number, kBaseSeq + 2);
+  EXPECT_TRUE(packets[2].arrival_time_offset.IsMinusInfinity());
+  EXPECT_EQ(packets[3].sequence_number, kBaseSeq + 3);
+  EXPECT_EQ(packets[4].ssrc, kOtherSsrc);
+  EXPECT_EQ(packets[4].sequence_number, 0xFFFF);
+  EXPECT_EQ(packets[5].ssrc, kOtherSsrc);
+  EXPECT_EQ(packets[5].sequence_number, 0);
+  EXPECT_EQ(packets[5].arrival_time_offset, TimeDelta::Zero());
+}
+
+TEST_F(RemoteEstimatorProxyTest, CongestionControlFeedbackReportsNewPackets) {
+  proxy_.EnableCongestionControlFeedback();
+  IncomingRtpPacket(kMediaSsrc, kBaseSeq, kBaseTime);
+  IncomingRtpPacket(kMediaSsrc, kBaseSeq + 2, kBaseTime);
+  EXPECT_CALL(feedback_sender_, Call);
+  Process();
+
+  // Nothing new to report.
+  EXPECT_CALL(feedback_sender_, Call).Times(0);
+  Process();
+
+  // A reordered packet is reported together with the packets after it.
+  IncomingRtpPacket(kMediaSsrc, kBaseSeq + 1, kBaseTime);
+  IncomingRtpPacket(kMediaSsrc, kBaseSeq + 3, kBaseTime);
+  EXPECT_CALL(feedback_sender_, Call)
+      .WillOnce([](std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets) {
+        std::vector<rtcp::CongestionControlFeedback::PacketInfo> infos =
+            PacketInfos(packets);
+        ASSERT_THAT(infos, SizeIs(3));
+        EXPECT_EQ(infos[0].sequence_number, kBaseSeq + 1);
+        EXPECT_EQ(infos[2].sequence_number, kBaseSeq + 3);
+      });
+  Process();
+}
+
+TEST_F(RemoteEstimatorProxyTest, SplitsLargeCongestionControlFeedback) {
+  proxy_.EnableCongestionControlFeedback();
+  for (int i = 0; i < 2000; ++i) {
+    IncomingRtpPacket(kMediaSsrc, kBaseSeq + i, kBaseTime);
+  }
+
+  std::vector<rtcp::CongestionControlFeedback::PacketInfo> packets;
+  EXPECT_CALL(feedback_sender_, Call)
+      .Times(4)
+      .WillRepeatedly(
+          [&](std::vector<std::unique_ptr<rtcp::RtcpPacket>> feedback_packets) {
+            ASSERT_THAT(feedback_packets, SizeIs(1));
+            EXPECT_LE(feedback_packets[0]->BlockLength(), 1200u);
+            std::vector<rtcp::CongestionControlFeedback::PacketInfo> infos =
+                PacketInfos(feedback_packets);
+            packets.insert(packets.end(), infos.begin(), infos.end());
+          });
+  Process();
+
+  ASSERT_THAT(packets, SizeIs(2000));
+  for (int i = 0; i < 2000; ++i) {
+    EXPECT_EQ(packets[i].sequence_number, kBaseSeq + i);
+  }
+}
+
+TEST_F(RemoteEstimatorProxyTest, CongestionControlFeedbackReportsEcn) {
+  proxy_.EnableCongestionControlFeedback();
+  IncomingRtpPacket(kMediaSsrc, kBaseSeq, kBaseTime, rtc::EcnMarking::kEct1);
+  IncomingRtpPacket(kMediaSsrc, kBaseSeq + 2, kBaseTime, rtc::EcnMarking::kCe);
+  IncomingRtpPacket(kMediaSsrc, kBaseSeq + 3, kBaseTime);
+  EXPECT_CALL(feedback_sender_, Call)
+      .WillOnce([](std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets) {
+        std::vector<rtcp::CongestionControlFeedback::PacketInfo> infos =
+            PacketInfos(packets);
+        ASSERT_THAT(infos, SizeIs(4));
+        EXPECT_EQ(infos[0].ecn, rtc::EcnMarking::kEct1);
+        EXPECT_EQ(infos[1].ecn, rtc::EcnMarking::kNotEct);
+        EXPECT_EQ(infos[2].ecn, rtc::EcnMarking::kCe);
+        EXPECT_EQ(infos[3].ecn, rtc::EcnMarking::kNotEct);
+      });
+  Process();
+
+  // A reordered packet is reported again with the packets after it, with the
+  // same markings.
+  IncomingRtpPacket(kMediaSsrc, kBaseSeq + 1, kBaseTime);
+  EXPECT_CALL(feedback_sender_, Call)
+      .WillOnce([](std::vector<std::unique_ptr<rtcp::RtcpPacket>> packets) {
+        std::vector<rtcp::CongestionControlFeedback::PacketInfo> infos =
+            PacketInfos(packets);
+        ASSERT_THAT(infos, SizeIs(3));
+        EXPECT_EQ(infos[0].ecn, rtc::EcnMarking::kNotEct);
+        EXPECT_EQ(infos[1].ecn, rtc::EcnMarking::kCe);
+        EXPECT_EQ(infos[2].ecn, rtc::EcnMarking::kNotEct);
+      });
+  Process();
+}
+
+TEST_F(RemoteEstimatorProxyTest, SendsCongestionControlFeedbackWithEstimate) {
+  proxy_.EnableCongestionControlFeedback();
+  IncomingRtpPacket(kMediaSsrc, kBaseSeq, kBaseTime);
+
+  EXPECT_CALL(network_state_estimator_, GetCurrentEstimate())
+      .WillOnce(Return(NetworkStateEstimate()));
+  EXPECT_CALL(feedback_sender_, Call(SizeIs(2)));
+  Process();
+}
+
 }  // namespace
 }  // namespace webrtc
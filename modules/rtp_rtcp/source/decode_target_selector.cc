@@ -0,0 +1,250 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/decode_target_selector.h"
+
+#include <utility>
+
+#include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+std::bitset<32> AllDecodeTargets(int num_decode_targets) {
+  return (uint64_t{1} << num_decode_targets) - 1;
+}
+
+template <int kWindow>
+size_t WindowIndex(int64_t value) {
+  static_assert((kWindow & (kWindow - 1)) == 0, "");
+  return static_cast<uint64_t>(value) & (kWindow - 1);
+}
+
+}  // namespace
+
+absl::optional<DecodeTargetSelector::PacketDecision>
+DecodeTargetSelector::OnPacket(const RtpPacket& packet) {
+  DependencyDescriptor descriptor;
+  if (!packet.GetExtension<RtpDependencyDescriptorExtension>(structure_.get(),
+                                                             &descriptor)) {
+    return absl::nullopt;
+  }
+  int64_t frame_number =
+      frame_number_unwrapper_.Unwrap(descriptor.frame_number);
+  int64_t sequence_number =
+      sequence_number_unwrapper_.Unwrap(packet.SequenceNumber());
+  if (descriptor.attached_structure &&
+      (structure_ == nullptr ||
+       *descriptor.attached_structure != *structure_)) {
+    OnNewStructure(std::move(descriptor.attached_structure));
+    structure_frame_number_ = frame_number;
+  }
+  if (frame_number < structure_frame_number_ ||
+      (latest_frame_number_ &&
+       frame_number <= *latest_frame_number_ - kFramesWindow)) {
+    return absl::nullopt;
+  }
+
+  const bool is_latest =
+      !latest_frame_number_ || frame_number >= *latest_frame_number_;
+  FrameState& frame = frames_[WindowIndex<kFramesWindow>(frame_number)];
+  bool frame_changed = false;
+  if (frame.frame_number != frame_number) {
+    OnNewFrame(frame_number, descriptor, frame);
+    frame_changed = true;
+  }
+  if (is_latest) {
+    latest_frame_number_ = frame_number;
+    active_decode_targets_ = frame.active_decode_targets;
+  }
+
+  ++frame.num_packets;
+  if (descriptor.first_packet_in_frame) {
+    frame.first_sequence_number = sequence_number;
+  }
+  if (descriptor.last_packet_in_frame) {
+    frame.last_sequence_number = sequence_number;
+  }
+  if (!frame.complete && frame.first_sequence_number &&
+      frame.last_sequence_number &&
+      *frame.last_sequence_number - *frame.first_sequence_number + 1 ==
+          frame.num_packets) {
+    frame.complete = true;
+    frame_changed = true;
+  }
+  if (frame_changed && !is_latest) {
+    UpdateFramesAfter(frame_number);
+  }
+
+  PacketDecision decision = frame.decision;
+  decision.first_packet_in_frame =
+      is_latest && descriptor.first_packet_in_frame;
+  return decision;
+}
+
+std::bitset<32> DecodeTargetSelector::ActiveDecodeTargets(
+    int decode_target,
+    const PacketDecision& decision) const {
+  RTC_DCHECK_GE(decode_target, 0);
+  RTC_DCHECK_LT(decode_target, DependencyDescriptor::kMaxDecodeTargets);
+  std::bitset<32> active = decision.decodable;
+  for (int i = 0; i < DependencyDescriptor::kMaxDecodeTargets; ++i) {
+    if (active[i] && !included_in_[i][decode_target]) {
+      active[i] = false;
+    }
+  }
+  return active;
+}
+
+bool DecodeTargetSelector::IsIncludedIn(int decode_target,
+                                        int other_decode_target) const {
+  RTC_DCHECK_GE(decode_target, 0);
+  RTC_DCHECK_LT(decode_target, DependencyDescriptor::kMaxDecodeTargets);
+  RTC_DCHECK_GE(other_decode_target, 0);
+  RTC_DCHECK_LT(other_decode_target, DependencyDescriptor::kMaxDecodeTargets);
+  return included_in_[decode_target][other_decode_target];
+}
+
+void DecodeTargetSelector::OnNewStructure(
+    std::unique_ptr<FrameDependencyStructure> structure) {
+  structure_ = std::move(structure);
+  const int num_decode_targets = structure_->num_decode_targets;
+  for (int i = 0; i < DependencyDescriptor::kMaxDecodeTargets; ++i) {
+    included_in_[i] =
+        i < num_decode_targets ? AllDecodeTargets(num_decode_targets) : 0;
+  }
+  for (const FrameDependencyTemplate& frame_template : structure_->templates) {
+    const auto& dtis = frame_template.decode_target_indications;
+    for (size_t i = 0; i < dtis.size(); ++i) {
+      if (dtis[i] == DecodeTargetIndication::kNotPresent) {
+        continue;
+      }
+      for (size_t j = 0; j < dtis.size(); ++j) {
+        if (dtis[j] == DecodeTargetIndication::kNotPresent) {
+          included_in_[i][j] = false;
+        }
+      }
+    }
+  }
+  active_decode_targets_ = AllDecodeTargets(num_decode_targets);
+  latest_frame_number_ = absl::nullopt;
+  frames_.fill(FrameState());
+}
+
+void DecodeTargetSelector::OnNewFrame(int64_t frame_number,
+                                      const DependencyDescriptor& descriptor,
+                                      FrameState& frame) {
+  RTC_DCHECK(structure_);
+  frame = FrameState();
+  frame.frame_number = frame_number;
+
+  const int num_decode_targets = structure_->num_decode_targets;
+  if (descriptor.active_decode_targets_bitmask) {
+    frame.active_decode_targets = *descriptor.active_decode_targets_bitmask;
+  } else if (descriptor.attached_structure) {
+    // All decode targets are active again when the structure is attached.
+    frame.active_decode_targets = AllDecodeTargets(num_decode_targets);
+  } else if (const FrameState* previous = Find(frame_number - 1)) {
+    frame.active_decode_targets = previous->active_decode_targets;
+  } else {
+    frame.active_decode_targets = active_decode_targets_;
+  }
+
+  const FrameDependencyTemplate& dependencies = descriptor.frame_dependencies;
+  frame.chain_diffs = dependencies.chain_diffs;
+
+  PacketDecision& decision = frame.decision;
+  const auto& dtis = dependencies.decode_target_indications;
+  for (int i = 0; i < num_decode_targets && i < static_cast<int>(dtis.size());
+       ++i) {
+    decision.forward[i] = dtis[i] != DecodeTargetIndication::kNotPresent;
+    decision.switch_point[i] = dtis[i] == DecodeTargetIndication::kSwitch;
+  }
+  UpdateChains(frame);
+}
+
+void DecodeTargetSelector::UpdateChains(FrameState& frame) {
+  RTC_DCHECK(frame.frame_number);
+  for (int chain = 0;
+       chain < structure_->num_chains &&
+       chain < static_cast<int>(frame.chain_diffs.size());
+       ++chain) {
+    int chain_diff = frame.chain_diffs[chain];
+    // A chain diff of zero restarts the chain. Otherwise the chain is intact
+    // if it was intact up to the previous frame in it, and that frame was
+    // completely received.
+    const FrameState* previous =
+        chain_diff == 0 ? nullptr : Find(*frame.frame_number - chain_diff);
+    frame.intact_chains[chain] =
+        chain_diff == 0 ||
+        (previous && previous->complete && previous->intact_chains[chain]);
+  }
+
+  const int num_decode_targets = structure_->num_decode_targets;
+  frame.decision.decodable.reset();
+  for (int i = 0; i < num_decode_targets; ++i) {
+    int chain = structure_->num_chains > 0
+                    ? structure_->decode_target_protected_by_chain[i]
+                    : -1;
+    frame.decision.decodable[i] =
+        frame.active_decode_targets[i] &&
+        (chain < 0 || chain >= structure_->num_chains ||
+         frame.intact_chains[chain]);
+  }
+}
+
+void DecodeTargetSelector::UpdateFramesAfter(int64_t frame_number) {
+  RTC_DCHECK(latest_frame_number_);
+  for (int64_t i = frame_number + 1; i <= *latest_frame_number_; ++i) {
+    if (FrameState* frame = Find(i)) {
+      UpdateChains(*frame);
+    }
+  }
+}
+
+DecodeTargetSelector::FrameState* DecodeTargetSelector::Find(
+    int64_t frame_number) {
+  FrameState& frame = frames_[WindowIndex<kFramesWindow>(frame_number)];
+  return frame.frame_number == frame_number ? &frame : nullptr;
+}
+
+void DecodeTargetSubscription::SetTargetDecodeTarget(int decode_target) {
+  RTC_DCHECK_GE(decode_target, 0);
+  RTC_DCHECK_LT(decode_target, DependencyDescriptor::kMaxDecodeTargets);
+  target_decode_target_ = decode_target;
+}
+
+bool DecodeTargetSubscription::OnPacket(
+    const DecodeTargetSelector::PacketDecision& decision) {
+  if (current_decode_target_ != target_decode_target_ &&
+      decision.first_packet_in_frame) {
+    // Receivers have all frames of the decode targets included in the current
+    // one, so they can switch down to them at any frame.
+    if (decision.switch_point[target_decode_target_] ||
+        (current_decode_target_ &&
+         selector_->IsIncludedIn(target_decode_target_,
+                                 *current_decode_target_))) {
+      current_decode_target_ = target_decode_target_;
+    }
+  }
+  return current_decode_target_ && decision.forward[*current_decode_target_];
+}
+
+absl::optional<uint32_t> DecodeTargetSubscription::ActiveDecodeTargetsBitmask(
+    const DecodeTargetSelector::PacketDecision& decision) const {
+  if (!current_decode_target_) {
+    return absl::nullopt;
+  }
+  return selector_->ActiveDecodeTargets(*current_decode_target_, decision)
+      .to_ulong();
+}
+
+}  // namespace webrtc
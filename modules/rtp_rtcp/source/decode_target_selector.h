@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_DECODE_TARGET_SELECTOR_H_
+#define MODULES_RTP_RTCP_SOURCE_DECODE_TARGET_SELECTOR_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <bitset>
+#include <memory>
+
+#include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
+#include "api/transport/rtp/dependency_descriptor.h"
+#include "modules/rtp_rtcp/source/rtp_packet.h"
+#include "rtc_base/numerics/sequence_number_unwrapper.h"
+
+namespace webrtc {
+
+// Decides which packets of a stream carrying the dependency descriptor rtp
+// header extension should be forwarded to the receivers of each decode target,
+// e.g. in an SFU which forwards one incoming stream to many receivers.
+// The descriptor is parsed, and the decisions are made, once per packet for
+// all decode targets at the same time. What is left to do for every receiver
+// is a few bit operations, see DecodeTargetSubscription.
+// See: https://aomediacodec.github.io/av1-rtp-spec/#dependency-descriptor-rtp-header-extension
+// This class is thread-compatible.
+class DecodeTargetSelector {
+ public:
+  struct PacketDecision {
+    // Only set for packets of the latest frame, so that receivers don't
+    // switch decode targets on a reordered packet of an older frame.
+    bool first_packet_in_frame = false;
+    // Bit `i` is set if the frame is part of decode target `i`, i.e. if the
+    // packet should be forwarded to its receivers.
+    std::bitset<32> forward;
+    // Bit `i` is set if receivers can start decoding decode target `i` with
+    // this frame.
+    std::bitset<32> switch_point;
+    // Decode targets which are active, and whose chain is intact.
+    std::bitset<32> decodable;
+  };
+
+  DecodeTargetSelector() = default;
+  DecodeTargetSelector(const DecodeTargetSelector&) = delete;
+  DecodeTargetSelector& operator=(const DecodeTargetSelector&) = delete;
+  ~DecodeTargetSelector() = default;
+
+  // To be called for every incoming packet of the stream, after duplicates
+  // have been removed. Returns nullopt if the packet has no dependency
+  // descriptor, or it can't be parsed, e.g. before the first structure was
+  // received, or belongs to a frame too old to be remembered. Such packets
+  // shouldn't be forwarded. Reordered packets of older frames get the same
+  // decision as the rest of their frame.
+  absl::optional<PacketDecision> OnPacket(const RtpPacket& packet);
+
+  // Returns the active decode targets bitmask to write into packets forwarded
+  // to the receivers of `decode_target`, i.e. the decodable targets which are
+  // made up of frames of `decode_target`.
+  std::bitset<32> ActiveDecodeTargets(int decode_target,
+                                      const PacketDecision& decision) const;
+
+  // Returns true if all frames of `decode_target` are also part of
+  // `other_decode_target`, i.e. receivers of `other_decode_target` can switch
+  // to `decode_target` at any frame.
+  bool IsIncludedIn(int decode_target, int other_decode_target) const;
+
+  const FrameDependencyStructure* structure() const { return structure_.get(); }
+
+ private:
+  // Chain diffs are written with 8 bits, so frames further back can't be
+  // referred to.
+  static constexpr int kFramesWindow = 256;
+
+  struct FrameState {
+    absl::optional<int64_t> frame_number;
+    // Decision for all packets of the frame.
+    PacketDecision decision;
+    absl::InlinedVector<int, 4> chain_diffs;
+    std::bitset<32> active_decode_targets;
+    // Chains which are intact up to this frame.
+    std::bitset<32> intact_chains;
+    // Packets received of the frame, to tell when it is complete.
+    absl::optional<int64_t> first_sequence_number;
+    absl::optional<int64_t> last_sequence_number;
+    int num_packets = 0;
+    bool complete = false;
+  };
+
+  void OnNewStructure(std::unique_ptr<FrameDependencyStructure> structure);
+  void OnNewFrame(int64_t frame_number,
+                  const DependencyDescriptor& descriptor,
+                  FrameState& frame);
+  // Updates the chains and decodable decode targets of `frame` from the state
+  // of the frames its chains refer to.
+  void UpdateChains(FrameState& frame);
+  // To be called when the state of an older frame changed, as newer frames
+  // may refer to it.
+  void UpdateFramesAfter(int64_t frame_number);
+  FrameState* Find(int64_t frame_number);
+
+  std::unique_ptr<FrameDependencyStructure> structure_;
+  // `included_in_[i]` holds the decode targets that all frames of decode
+  // target `i` are part of.
+  std::array<std::bitset<32>, DependencyDescriptor::kMaxDecodeTargets>
+      included_in_;
+  // Active decode targets as of the latest frame.
+  std::bitset<32> active_decode_targets_;
+
+  SeqNumUnwrapper<uint16_t> frame_number_unwrapper_;
+  SeqNumUnwrapper<uint16_t> sequence_number_unwrapper_;
+
+  absl::optional<int64_t> latest_frame_number_;
+  // Frames before the one which brought the current structure can't be
+  // parsed with it.
+  int64_t structure_frame_number_ = 0;
+
+  // Recent frames, in the slot given by the frame number modulo
+  // `kFramesWindow`.
+  std::array<FrameState, kFramesWindow> frames_;
+};
+
+// Keeps track of which decode target is forwarded to a single receiver.
+// This class is thread-compatible.
+class DecodeTargetSubscription {
+ public:
+  explicit DecodeTargetSubscription(const DecodeTargetSelector* selector)
+      : selector_(selector) {}
+
+  // Forwarding switches to `decode_target` as soon as possible.
+  void SetTargetDecodeTarget(int decode_target);
+  // Returns the decode target currently forwarded, if any.
+  absl::optional<int> current_decode_target() const {
+    return current_decode_target_;
+  }
+
+  // Returns true if the packet should be forwarded to the receiver.
+  bool OnPacket(const DecodeTargetSelector::PacketDecision& decision);
+
+  // Active decode targets bitmask to write into the forwarded packets.
+  absl::optional<uint32_t> ActiveDecodeTargetsBitmask(
+      const DecodeTargetSelector::PacketDecision& decision) const;
+
+ private:
+  const DecodeTargetSelector* const selector_;
+  int target_decode_target_ = 0;
+  absl::optional<int> current_decode_target_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_DECODE_TARGET_SELECTOR_H_
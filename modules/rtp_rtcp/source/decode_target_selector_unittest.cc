@@ -0,0 +1,264 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/decode_target_selector.h"
+
+#include <memory>
+
+#include "api/transport/rtp/dependency_descriptor.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
+#include "modules/rtp_rtcp/source/rtp_packet.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::Optional;
+
+// L1T2: decode target 0 is the base layer, decode target 1 adds the upper
+// temporal layer. Both are protected by the chain of base layer frames.
+enum Template : int {
+  kKeyFrame = 0,
+  kBaseLayer = 1,
+  kUpperLayer = 2,
+};
+
+FrameDependencyStructure L1T2() {
+  FrameDependencyStructure structure;
+  structure.num_decode_targets = 2;
+  structure.num_chains = 1;
+  structure.decode_target_protected_by_chain = {0, 0};
+  structure.templates = {
+      FrameDependencyTemplate().T(0).Dtis("SS").ChainDiffs({0}),
+      FrameDependencyTemplate().T(0).Dtis("SS").FrameDiffs({2}).ChainDiffs(
+          {2}),
+      FrameDependencyTemplate().T(1).Dtis("-D").FrameDiffs({1}).ChainDiffs(
+          {1}),
+  };
+  return structure;
+}
+
+class DecodeTargetSelectorTest : public ::testing::Test {
+ protected:
+  DecodeTargetSelectorTest() : structure_(L1T2()) {
+    extensions_.Register<RtpDependencyDescriptorExtension>(1);
+  }
+
+  // Returns the decision for a frame sent in `num_packets` packets, of which
+  // `lost_packet` isn't passed to the selector.
+  absl::optional<DecodeTargetSelector::PacketDecision> InsertFrame(
+      Template frame_template,
+      int num_packets = 1,
+      int lost_packet = -1) {
+    absl::optional<DecodeTargetSelector::PacketDecision> decision;
+    for (int i = 0; i < num_packets; ++i) {
+      RtpPacket packet =
+          CreatePacket(frame_template, /*first_packet_in_frame=*/i == 0,
+                       /*last_packet_in_frame=*/i == num_packets - 1);
+      if (i != lost_packet) {
+        decision = selector_.OnPacket(packet);
+      }
+    }
+    ++frame_number_;
+    return decision;
+  }
+
+  // Creates the next packet of the current frame.
+  RtpPacket CreatePacket(Template frame_template,
+                         bool first_packet_in_frame,
+                         bool last_packet_in_frame) {
+    DependencyDescriptor descriptor;
+    descriptor.first_packet_in_frame = first_packet_in_frame;
+    descriptor.last_packet_in_frame = last_packet_in_frame;
+    descriptor.frame_number = frame_number_;
+    descriptor.frame_dependencies = structure_.templates[frame_template];
+    if (frame_template == kKeyFrame) {
+      descriptor.attached_structure =
+          std::make_unique<FrameDependencyStructure>(structure_);
+    }
+    RtpPacket packet(&extensions_);
+    packet.SetSequenceNumber(sequence_number_++);
+    EXPECT_TRUE(packet.SetExtension<RtpDependencyDescriptorExtension>(
+        structure_, descriptor));
+    return packet;
+  }
+
+  // Skips a frame, as if all its packets were lost.
+  void LoseFrame(int num_packets = 1) {
+    sequence_number_ += num_packets;
+    ++frame_number_;
+  }
+
+  const FrameDependencyStructure structure_;
+  RtpHeaderExtensionMap extensions_;
+  DecodeTargetSelector selector_;
+  uint16_t frame_number_ = 0xfffe;
+  uint16_t sequence_number_ = 0xfffe;
+};
+
+TEST_F(DecodeTargetSelectorTest, NoDecisionBeforeStructure) {
+  EXPECT_EQ(InsertFrame(kBaseLayer), absl::nullopt);
+  EXPECT_EQ(selector_.structure(), nullptr);
+
+  EXPECT_NE(InsertFrame(kKeyFrame), absl::nullopt);
+  ASSERT_NE(selector_.structure(), nullptr);
+  EXPECT_EQ(*selector_.structure(), structure_);
+}
+
+TEST_F(DecodeTargetSelectorTest, ForwardsFramesPartOfDecodeTarget) {
+  auto decision = InsertFrame(kKeyFrame);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->forward, 0b11);
+  EXPECT_EQ(decision->switch_point, 0b11);
+  EXPECT_EQ(decision->decodable, 0b11);
+
+  decision = InsertFrame(kUpperLayer);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->forward, 0b10);
+  EXPECT_EQ(decision->switch_point, 0b00);
+  EXPECT_EQ(decision->decodable, 0b11);
+}
+
+TEST_F(DecodeTargetSelectorTest, ActiveDecodeTargetsAreIncludedInTarget) {
+  auto decision = InsertFrame(kKeyFrame);
+  ASSERT_TRUE(decision);
+  EXPECT_TRUE(selector_.IsIncludedIn(0, 1));
+  EXPECT_FALSE(selector_.IsIncludedIn(1, 0));
+  EXPECT_EQ(selector_.ActiveDecodeTargets(0, *decision), 0b01);
+  EXPECT_EQ(selector_.ActiveDecodeTargets(1, *decision), 0b11);
+}
+
+TEST_F(DecodeTargetSelectorTest, LostFrameBreaksChainUntilKeyFrame) {
+  InsertFrame(kKeyFrame);
+  InsertFrame(kUpperLayer);
+  LoseFrame();
+  auto decision = InsertFrame(kUpperLayer);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->decodable, 0b00);
+  decision = InsertFrame(kBaseLayer);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->decodable, 0b00);
+
+  decision = InsertFrame(kKeyFrame);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->decodable, 0b11);
+}
+
+TEST_F(DecodeTargetSelectorTest, LostPacketBreaksChain) {
+  InsertFrame(kKeyFrame, /*num_packets=*/3);
+  InsertFrame(kUpperLayer, /*num_packets=*/2);
+  InsertFrame(kBaseLayer, /*num_packets=*/3, /*lost_packet=*/1);
+  auto decision = InsertFrame(kUpperLayer);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->decodable, 0b00);
+}
+
+TEST_F(DecodeTargetSelectorTest, LostUpperLayerFrameKeepsChainIntact) {
+  InsertFrame(kKeyFrame);
+  LoseFrame();
+  auto decision = InsertFrame(kBaseLayer);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->decodable, 0b11);
+}
+
+TEST_F(DecodeTargetSelectorTest, ReorderedPacketCompletesOlderFrame) {
+  InsertFrame(kKeyFrame);
+  InsertFrame(kUpperLayer);
+  // The last packet of a base layer frame arrives after the next frame.
+  RtpPacket first = CreatePacket(kBaseLayer, /*first_packet_in_frame=*/true,
+                                 /*last_packet_in_frame=*/false);
+  RtpPacket last = CreatePacket(kBaseLayer, /*first_packet_in_frame=*/false,
+                                /*last_packet_in_frame=*/true);
+  ++frame_number_;
+  ASSERT_TRUE(selector_.OnPacket(first));
+  auto decision = InsertFrame(kUpperLayer);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->decodable, 0b00);
+
+  decision = selector_.OnPacket(last);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->forward, 0b11);
+  EXPECT_EQ(decision->decodable, 0b11);
+  EXPECT_FALSE(decision->first_packet_in_frame);
+
+  // The chain is intact again once the base layer frame is complete.
+  decision = InsertFrame(kBaseLayer);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->decodable, 0b11);
+}
+
+TEST_F(DecodeTargetSelectorTest, ReorderedFrameGetsItsOwnDecision) {
+  InsertFrame(kKeyFrame);
+  RtpPacket upper = CreatePacket(kUpperLayer, /*first_packet_in_frame=*/true,
+                                 /*last_packet_in_frame=*/true);
+  ++frame_number_;
+  InsertFrame(kBaseLayer);
+
+  // The upper layer frame arrives after the base layer frame following it.
+  auto decision = selector_.OnPacket(upper);
+  ASSERT_TRUE(decision);
+  EXPECT_EQ(decision->forward, 0b10);
+  EXPECT_EQ(decision->decodable, 0b11);
+  EXPECT_FALSE(decision->first_packet_in_frame);
+}
+
+TEST_F(DecodeTargetSelectorTest, NoDecisionForFramesOutsideWindow) {
+  InsertFrame(kKeyFrame);
+  RtpPacket old = CreatePacket(kUpperLayer, /*first_packet_in_frame=*/true,
+                               /*last_packet_in_frame=*/true);
+  ++frame_number_;
+  for (int i = 0; i < 300; ++i) {
+    InsertFrame(kBaseLayer);
+  }
+  EXPECT_EQ(selector_.OnPacket(old), absl::nullopt);
+}
+
+TEST_F(DecodeTargetSelectorTest, SubscriptionSwitchesUpAtSwitchPoint) {
+  DecodeTargetSubscription subscription(&selector_);
+  EXPECT_EQ(subscription.current_decode_target(), absl::nullopt);
+
+  EXPECT_TRUE(subscription.OnPacket(*InsertFrame(kKeyFrame)));
+  EXPECT_THAT(subscription.current_decode_target(), Optional(0));
+  EXPECT_FALSE(subscription.OnPacket(*InsertFrame(kUpperLayer)));
+
+  subscription.SetTargetDecodeTarget(1);
+  EXPECT_TRUE(subscription.OnPacket(*InsertFrame(kBaseLayer)));
+  EXPECT_THAT(subscription.current_decode_target(), Optional(1));
+  auto decision = InsertFrame(kUpperLayer);
+  EXPECT_TRUE(subscription.OnPacket(*decision));
+  EXPECT_THAT(subscription.ActiveDecodeTargetsBitmask(*decision),
+              Optional(0b11));
+}
+
+TEST_F(DecodeTargetSelectorTest, SubscriptionSwitchesDownAtAnyFrame) {
+  DecodeTargetSubscription subscription(&selector_);
+  subscription.SetTargetDecodeTarget(1);
+  EXPECT_TRUE(subscription.OnPacket(*InsertFrame(kKeyFrame)));
+  EXPECT_THAT(subscription.current_decode_target(), Optional(1));
+
+  subscription.SetTargetDecodeTarget(0);
+  auto decision = InsertFrame(kUpperLayer);
+  EXPECT_FALSE(subscription.OnPacket(*decision));
+  EXPECT_THAT(subscription.current_decode_target(), Optional(0));
+  EXPECT_THAT(subscription.ActiveDecodeTargetsBitmask(*decision),
+              Optional(0b01));
+}
+
+TEST_F(DecodeTargetSelectorTest, SubscriptionSwitchesOnlyAtStartOfFrame) {
+  DecodeTargetSubscription subscription(&selector_);
+  EXPECT_FALSE(subscription.OnPacket(
+      *InsertFrame(kKeyFrame, /*num_packets=*/2, /*lost_packet=*/0)));
+  EXPECT_EQ(subscription.current_decode_target(), absl::nullopt);
+}
+
+}  // namespace
+}  // namespace webrtc
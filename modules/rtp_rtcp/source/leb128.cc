@@ -12,18 +12,26 @@
 
 #include <cstdint>
 
+#include "absl/numeric/bits.h"
+
 namespace webrtc {
 
 int Leb128Size(uint64_t value) {
-  int size = 0;
-  while (value >= 0x80) {
-    ++size;
-    value >>= 7;
-  }
-  return size + 1;
+  // Each byte carries 7 bits of the value, and 0 takes one byte.
+  return (absl::bit_width(value | 1) + 6) / 7;
 }
 
 uint64_t ReadLeb128(const uint8_t*& read_at, const uint8_t* end) {
+  // OBU and fragment sizes below 128 bytes and two byte sizes, i.e. below
+  // 16 KiB, are by far the most common, so decode them without the loop.
+  if (read_at != end && read_at[0] < 0x80) {
+    return *read_at++;
+  }
+  if (end - read_at >= 2 && read_at[1] < 0x80) {
+    uint64_t value = (read_at[0] & 0x7Fu) | (uint64_t{read_at[1]} << 7);
+    read_at += 2;
+    return value;
+  }
   uint64_t value = 0;
   int fill_bits = 0;
   while (read_at != end && fill_bits < 64 - 7) {
@@ -99,6 +99,31 @@ TEST(Leb128Test, DoesntReadMoreThan10Bytes) {
   EXPECT_EQ(read_at, nullptr);
 }
 
+TEST(Leb128Test, ReadsWhatWasWritten) {
+  for (int bits = 0; bits <= 64; ++bits) {
+    for (uint64_t value : {bits == 0 ? 0 : (uint64_t{1} << (bits - 1)),
+                           bits == 64 ? ~uint64_t{0}
+                                      : (uint64_t{1} << bits) - 1}) {
+      uint8_t buffer[16] = {};
+      const int size = WriteLeb128(value, buffer);
+      EXPECT_EQ(size, Leb128Size(value));
+      const uint8_t* read_at = buffer;
+      EXPECT_EQ(ReadLeb128(read_at, buffer + size), value);
+      EXPECT_EQ(read_at, buffer + size);
+    }
+  }
+}
+
+TEST(Leb128Test, FailsToReadTruncatedValue) {
+  const uint8_t buffer[] = {0x80, 0x80};
+  const uint8_t* read_at = buffer;
+  ReadLeb128(read_at, buffer + 1);
+  EXPECT_EQ(read_at, nullptr);
+  read_at = buffer;
+  ReadLeb128(read_at, std::end(buffer));
+  EXPECT_EQ(read_at, nullptr);
+}
+
 TEST(Leb128Test, WriteZero) {
   uint8_t buffer[16];
   EXPECT_EQ(WriteLeb128(0, buffer), 1);
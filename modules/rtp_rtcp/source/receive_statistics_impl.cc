@@ -12,6 +12,7 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -41,6 +42,118 @@ TimeDelta UnixEpochDelta(Clock& clock) {
 
 StreamStatistician::~StreamStatistician() {}
 
+AtomicRtcpReportSnapshot::AtomicRtcpReportSnapshot() {
+  Store(RtcpReportSnapshot());
+}
+
+void AtomicRtcpReportSnapshot::Store(const RtcpReportSnapshot& snapshot) {
+  uint32_t version = version_.load(std::memory_order_relaxed);
+  version_.store(version + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  last_receive_time_us_.store(snapshot.last_receive_time.has_value()
+                                  ? snapshot.last_receive_time->us()
+                                  : std::numeric_limits<int64_t>::min(),
+                              std::memory_order_relaxed);
+  received_seq_first_.store(snapshot.received_seq_first,
+                            std::memory_order_relaxed);
+  received_seq_max_.store(snapshot.received_seq_max, std::memory_order_relaxed);
+  cumulative_loss_.store(snapshot.cumulative_loss, std::memory_order_relaxed);
+  jitter_q4_.store(snapshot.jitter_q4, std::memory_order_relaxed);
+  num_restarts_.store(snapshot.num_restarts, std::memory_order_relaxed);
+  restart_seq_max_.store(snapshot.restart_seq_max, std::memory_order_relaxed);
+  version_.store(version + 2, std::memory_order_release);
+}
+
+RtcpReportSnapshot AtomicRtcpReportSnapshot::Load() const {
+  RtcpReportSnapshot snapshot;
+  int64_t last_receive_time_us;
+  uint32_t version;
+  do {
+    version = version_.load(std::memory_order_acquire);
+    last_receive_time_us =
+        last_receive_time_us_.load(std::memory_order_relaxed);
+    snapshot.received_seq_first =
+        received_seq_first_.load(std::memory_order_relaxed);
+    snapshot.received_seq_max =
+        received_seq_max_.load(std::memory_order_relaxed);
+    snapshot.cumulative_loss = cumulative_loss_.load(std::memory_order_relaxed);
+    snapshot.jitter_q4 = jitter_q4_.load(std::memory_order_relaxed);
+    snapshot.num_restarts = num_restarts_.load(std::memory_order_relaxed);
+    snapshot.restart_seq_max = restart_seq_max_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((version & 1) != 0 ||
+           version != version_.load(std::memory_order_relaxed));
+  if (last_receive_time_us != std::numeric_limits<int64_t>::min()) {
+    snapshot.last_receive_time = Timestamp::Micros(last_receive_time_us);
+  }
+  return snapshot;
+}
+
+RtcpReportBlockGenerator::RtcpReportBlockGenerator(uint32_t ssrc)
+    : ssrc_(ssrc) {}
+
+void RtcpReportBlockGenerator::MaybeAppendReportBlockAndReset(
+    const RtcpReportSnapshot& snapshot,
+    Timestamp now,
+    std::vector<rtcp::ReportBlock>& report_blocks) {
+  if (!snapshot.last_receive_time.has_value()) {
+    return;
+  }
+  if (snapshot.num_restarts != num_restarts_) {
+    num_restarts_ = snapshot.num_restarts;
+    last_report_seq_max_ = snapshot.restart_seq_max;
+  }
+  if (now - *snapshot.last_receive_time >= kStatisticsTimeout) {
+    // Not active.
+    return;
+  }
+
+  report_blocks.emplace_back();
+  rtcp::ReportBlock& stats = report_blocks.back();
+  stats.SetMediaSsrc(ssrc_);
+  // Calculate fraction lost.
+  int64_t exp_since_last = snapshot.received_seq_max - last_report_seq_max_;
+  RTC_DCHECK_GE(exp_since_last, 0);
+
+  int32_t lost_since_last =
+      snapshot.cumulative_loss - last_report_cumulative_loss_;
+  if (exp_since_last > 0 && lost_since_last > 0) {
+    // Scale 0 to 255, where 255 is 100% loss.
+    stats.SetFractionLost(255 * lost_since_last / exp_since_last);
+  }
+
+  int packets_lost = snapshot.cumulative_loss + cumulative_loss_rtcp_offset_;
+  if (packets_lost < 0) {
+    // Clamp to zero. Work around to accommodate for senders that misbehave with
+    // negative cumulative loss.
+    packets_lost = 0;
+    cumulative_loss_rtcp_offset_ = -snapshot.cumulative_loss;
+  }
+  if (packets_lost > 0x7fffff) {
+    // Packets lost is a 24 bit signed field, and thus should be clamped, as
+    // described in https://datatracker.ietf.org/doc/html/rfc3550#appendix-A.3
+    if (!cumulative_loss_is_capped_) {
+      cumulative_loss_is_capped_ = true;
+      RTC_LOG(LS_WARNING) << "Cumulative loss reached maximum value for ssrc "
+                          << ssrc_;
+    }
+    packets_lost = 0x7fffff;
+  }
+  stats.SetCumulativeLost(packets_lost);
+  stats.SetExtHighestSeqNum(snapshot.received_seq_max);
+  // Note: internal jitter value is in Q4 and needs to be scaled by 1/16.
+  stats.SetJitter(snapshot.jitter_q4 >> 4);
+
+  // Only for report blocks in RTCP SR and RR.
+  last_report_cumulative_loss_ = snapshot.cumulative_loss;
+  last_report_seq_max_ = snapshot.received_seq_max;
+  BWE_TEST_LOGGING_PLOT_WITH_SSRC(1, "cumulative_loss_pkts", now.ms(),
+                                  snapshot.cumulative_loss, ssrc_);
+  BWE_TEST_LOGGING_PLOT_WITH_SSRC(
+      1, "received_seq_max_pkts", now.ms(),
+      (snapshot.received_seq_max - snapshot.received_seq_first), ssrc_);
+}
+
 StreamStatisticianImpl::StreamStatisticianImpl(uint32_t ssrc,
                                                Clock* clock,
                                                int max_reordering_threshold)
@@ -50,15 +163,14 @@ StreamStatisticianImpl::StreamStatisticianImpl(uint32_t ssrc,
       incoming_bitrate_(/*max_window_size=*/kStatisticsProcessInterval),
       max_reordering_threshold_(max_reordering_threshold),
       enable_retransmit_detection_(false),
-      cumulative_loss_is_capped_(false),
       jitter_q4_(0),
       cumulative_loss_(0),
-      cumulative_loss_rtcp_offset_(0),
       last_received_timestamp_(0),
       received_seq_first_(-1),
       received_seq_max_(-1),
-      last_report_cumulative_loss_(0),
-      last_report_seq_max_(-1),
+      num_restarts_(0),
+      restart_seq_max_(-1),
+      report_block_generator_(ssrc),
       last_payload_type_frequency_(0) {}
 
 StreamStatisticianImpl::~StreamStatisticianImpl() = default;
@@ -82,7 +194,8 @@ bool StreamStatisticianImpl::UpdateOutOfOrder(const RtpPacketReceived& packet,
       // Fraction loss for the next report may get a bit off, since we don't
       // update last_report_seq_max_ and last_report_cumulative_loss_ in a
       // consistent way.
-      last_report_seq_max_ = sequence_number - 2;
+      ++num_restarts_;
+      restart_seq_max_ = sequence_number - 2;
       received_seq_max_ = sequence_number - 2;
       return false;
     }
@@ -126,7 +239,8 @@ void StreamStatisticianImpl::UpdateCounters(const RtpPacketReceived& packet) {
 
   if (!ReceivedRtpPacket()) {
     received_seq_first_ = sequence_number;
-    last_report_seq_max_ = sequence_number - 1;
+    ++num_restarts_;
+    restart_seq_max_ = sequence_number - 1;
     received_seq_max_ = sequence_number - 1;
     receive_counters_.first_packet_time = now;
   } else if (UpdateOutOfOrder(packet, sequence_number, now)) {
@@ -235,58 +349,20 @@ RtpReceiveStats StreamStatisticianImpl::GetStats() const {
 
 void StreamStatisticianImpl::MaybeAppendReportBlockAndReset(
     std::vector<rtcp::ReportBlock>& report_blocks) {
-  if (!ReceivedRtpPacket()) {
-    return;
-  }
-  Timestamp now = clock_->CurrentTime();
-  if (now - *last_receive_time_ >= kStatisticsTimeout) {
-    // Not active.
-    return;
-  }
-
-  report_blocks.emplace_back();
-  rtcp::ReportBlock& stats = report_blocks.back();
-  stats.SetMediaSsrc(ssrc_);
-  // Calculate fraction lost.
-  int64_t exp_since_last = received_seq_max_ - last_report_seq_max_;
-  RTC_DCHECK_GE(exp_since_last, 0);
-
-  int32_t lost_since_last = cumulative_loss_ - last_report_cumulative_loss_;
-  if (exp_since_last > 0 && lost_since_last > 0) {
-    // Scale 0 to 255, where 255 is 100% loss.
-    stats.SetFractionLost(255 * lost_since_last / exp_since_last);
-  }
-
-  int packets_lost = cumulative_loss_ + cumulative_loss_rtcp_offset_;
-  if (packets_lost < 0) {
-    // Clamp to zero. Work around to accommodate for senders that misbehave with
-    // negative cumulative loss.
-    packets_lost = 0;
-    cumulative_loss_rtcp_offset_ = -cumulative_loss_;
-  }
-  if (packets_lost > 0x7fffff) {
-    // Packets lost is a 24 bit signed field, and thus should be clamped, as
-    // described in https://datatracker.ietf.org/doc/html/rfc3550#appendix-A.3
-    if (!cumulative_loss_is_capped_) {
-      cumulative_loss_is_capped_ = true;
-      RTC_LOG(LS_WARNING) << "Cumulative loss reached maximum value for ssrc "
-                          << ssrc_;
-    }
-    packets_lost = 0x7fffff;
-  }
-  stats.SetCumulativeLost(packets_lost);
-  stats.SetExtHighestSeqNum(received_seq_max_);
-  // Note: internal jitter value is in Q4 and needs to be scaled by 1/16.
-  stats.SetJitter(jitter_q4_ >> 4);
+  report_block_generator_.MaybeAppendReportBlockAndReset(
+      GetRtcpReportSnapshot(), clock_->CurrentTime(), report_blocks);
+}
 
-  // Only for report blocks in RTCP SR and RR.
-  last_report_cumulative_loss_ = cumulative_loss_;
-  last_report_seq_max_ = received_seq_max_;
-  BWE_TEST_LOGGING_PLOT_WITH_SSRC(1, "cumulative_loss_pkts", now.ms(),
-                                  cumulative_loss_, ssrc_);
-  BWE_TEST_LOGGING_PLOT_WITH_SSRC(1, "received_seq_max_pkts", now.ms(),
-                                  (received_seq_max_ - received_seq_first_),
-                                  ssrc_);
+RtcpReportSnapshot StreamStatisticianImpl::GetRtcpReportSnapshot() const {
+  RtcpReportSnapshot snapshot;
+  snapshot.last_receive_time = last_receive_time_;
+  snapshot.received_seq_first = received_seq_first_;
+  snapshot.received_seq_max = received_seq_max_;
+  snapshot.cumulative_loss = cumulative_loss_;
+  snapshot.jitter_q4 = jitter_q4_;
+  snapshot.num_restarts = num_restarts_;
+  snapshot.restart_seq_max = restart_seq_max_;
+  return snapshot;
 }
 
 absl::optional<int> StreamStatisticianImpl::GetFractionLostInPercent() const {
@@ -12,6 +12,7 @@
 #define MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
 
 #include <algorithm>
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -30,6 +31,70 @@
 
 namespace webrtc {
 
+// The state of a received stream that its RTCP report blocks are computed
+// from. Kept small so that it can be handed from the thread receiving packets
+// to the thread generating RTCP without locking.
+struct RtcpReportSnapshot {
+  absl::optional<Timestamp> last_receive_time;
+  int64_t received_seq_first = -1;
+  int64_t received_seq_max = -1;
+  int32_t cumulative_loss = 0;
+  uint32_t jitter_q4 = 0;
+  // Incremented when the stream starts or restarts, at which point the
+  // highest sequence number of the last report is reset to
+  // `restart_seq_max`.
+  uint32_t num_restarts = 0;
+  int64_t restart_seq_max = -1;
+};
+
+// Publishes RtcpReportSnapshots from a single writer to any number of
+// readers. Neither side blocks the other: a reader that races with an update
+// retries until it has read a consistent snapshot.
+class AtomicRtcpReportSnapshot {
+ public:
+  AtomicRtcpReportSnapshot();
+
+  // Must not be called concurrently with itself.
+  void Store(const RtcpReportSnapshot& snapshot);
+  RtcpReportSnapshot Load() const;
+
+ private:
+  // Odd while `Store()` is in progress.
+  std::atomic<uint32_t> version_;
+  std::atomic<int64_t> last_receive_time_us_;
+  std::atomic<int64_t> received_seq_first_;
+  std::atomic<int64_t> received_seq_max_;
+  std::atomic<int32_t> cumulative_loss_;
+  std::atomic<uint32_t> jitter_q4_;
+  std::atomic<uint32_t> num_restarts_;
+  std::atomic<int64_t> restart_seq_max_;
+};
+
+// Generates the report blocks of a stream from its RtcpReportSnapshots, and
+// owns the state that only report generation needs.
+class RtcpReportBlockGenerator {
+ public:
+  explicit RtcpReportBlockGenerator(uint32_t ssrc);
+
+  void MaybeAppendReportBlockAndReset(
+      const RtcpReportSnapshot& snapshot,
+      Timestamp now,
+      std::vector<rtcp::ReportBlock>& report_blocks);
+
+ private:
+  const uint32_t ssrc_;
+  bool cumulative_loss_is_capped_ = false;
+  // Offset added to outgoing rtcp reports, to make ensure that the reported
+  // cumulative loss is non-negative. Reports with negative values confuse some
+  // senders, in particular, our own loss-based bandwidth estimator.
+  int32_t cumulative_loss_rtcp_offset_ = 0;
+
+  // Counter values when we sent the last report.
+  int32_t last_report_cumulative_loss_ = 0;
+  int64_t last_report_seq_max_ = -1;
+  uint32_t num_restarts_ = 0;
+};
+
 // Extends StreamStatistician with methods needed by the implementation.
 class StreamStatisticianImplInterface : public StreamStatistician {
  public:
@@ -63,6 +128,8 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   // Updates StreamStatistician for incoming packets.
   void UpdateCounters(const RtpPacketReceived& packet) override;
 
+  RtcpReportSnapshot GetRtcpReportSnapshot() const;
+
  private:
   bool IsRetransmitOfOldPacket(const RtpPacketReceived& packet,
                                Timestamp now) const;
@@ -84,17 +151,12 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   // In number of packets or sequence numbers.
   int max_reordering_threshold_;
   bool enable_retransmit_detection_;
-  bool cumulative_loss_is_capped_;
 
   // Stats on received RTP packets.
   uint32_t jitter_q4_;
   // Cumulative loss according to RFC 3550, which may be negative (and often is,
   // if packets are reordered and there are non-RTX retransmissions).
   int32_t cumulative_loss_;
-  // Offset added to outgoing rtcp reports, to make ensure that the reported
-  // cumulative loss is non-negative. Reports with negative values confuse some
-  // senders, in particular, our own loss-based bandwidth estimator.
-  int32_t cumulative_loss_rtcp_offset_;
 
   absl::optional<Timestamp> last_receive_time_;
   uint32_t last_received_timestamp_;
@@ -108,21 +170,27 @@ class StreamStatisticianImpl : public StreamStatisticianImplInterface {
   // Current counter values.
   StreamDataCounters receive_counters_;
 
-  // Counter values when we sent the last report.
-  int32_t last_report_cumulative_loss_;
-  int64_t last_report_seq_max_;
+  // See RtcpReportSnapshot.
+  uint32_t num_restarts_;
+  int64_t restart_seq_max_;
+
+  RtcpReportBlockGenerator report_block_generator_;
 
   // The sample frequency of the last received packet.
   int last_payload_type_frequency_;
 };
 
-// Thread-safe implementation of StreamStatisticianImplInterface.
+// Thread-safe implementation of StreamStatisticianImplInterface. Report
+// blocks are generated from a snapshot published on every packet, so that RTCP
+// generation never waits for, or stalls, packet processing.
 class StreamStatisticianLocked : public StreamStatisticianImplInterface {
  public:
   StreamStatisticianLocked(uint32_t ssrc,
                            Clock* clock,
                            int max_reordering_threshold)
-      : impl_(ssrc, clock, max_reordering_threshold) {}
+      : clock_(clock),
+        impl_(ssrc, clock, max_reordering_threshold),
+        report_block_generator_(ssrc) {}
   ~StreamStatisticianLocked() override = default;
 
   RtpReceiveStats GetStats() const override {
@@ -143,8 +211,9 @@ class StreamStatisticianLocked : public StreamStatisticianImplInterface {
   }
   void MaybeAppendReportBlockAndReset(
       std::vector<rtcp::ReportBlock>& report_blocks) override {
-    MutexLock lock(&stream_lock_);
-    impl_.MaybeAppendReportBlockAndReset(report_blocks);
+    MutexLock lock(&report_lock_);
+    report_block_generator_.MaybeAppendReportBlockAndReset(
+        report_snapshot_.Load(), clock_->CurrentTime(), report_blocks);
   }
   void SetMaxReorderingThreshold(int max_reordering_threshold) override {
     MutexLock lock(&stream_lock_);
@@ -156,12 +225,19 @@ class StreamStatisticianLocked : public StreamStatisticianImplInterface {
   }
   void UpdateCounters(const RtpPacketReceived& packet) override {
     MutexLock lock(&stream_lock_);
-    return impl_.UpdateCounters(packet);
+    impl_.UpdateCounters(packet);
+    report_snapshot_.Store(impl_.GetRtcpReportSnapshot());
   }
 
  private:
+  Clock* const clock_;
   mutable Mutex stream_lock_;
   StreamStatisticianImpl impl_ RTC_GUARDED_BY(&stream_lock_);
+  // Written with `stream_lock_` held.
+  AtomicRtcpReportSnapshot report_snapshot_;
+  Mutex report_lock_;
+  RtcpReportBlockGenerator report_block_generator_
+      RTC_GUARDED_BY(&report_lock_);
 };
 
 // Thread-compatible implementation.
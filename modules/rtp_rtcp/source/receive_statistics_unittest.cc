@@ -10,12 +10,15 @@
 
 #include "modules/rtp_rtcp/include/receive_statistics.h"
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
 #include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/random.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
@@ -631,6 +634,45 @@ TEST_P(ReceiveStatisticsTest, SimpleJitterComputation) {
             statistician->GetStats().interarrival_jitter);
 }
 
+TEST(ReceiveStatisticsThreadSafetyTest,
+     GeneratesReportBlocksWhileReceivingPackets) {
+  constexpr int kNumPackets = 10'000;
+  SimulatedClock clock(0);
+  std::unique_ptr<ReceiveStatistics> receive_statistics =
+      ReceiveStatistics::Create(&clock);
+  std::atomic<bool> done(false);
+
+  rtc::PlatformThread receive_thread = rtc::PlatformThread::SpawnJoinable(
+      [&] {
+        RtpPacketReceived packet = CreateRtpPacket(kSsrc1, kPacketSize1);
+        // Every other packet is lost.
+        for (int i = 0; i < kNumPackets; ++i) {
+          packet.SetSequenceNumber(2 * i);
+          receive_statistics->OnRtpPacket(packet);
+        }
+        done = true;
+      },
+      "ReceiveThread");
+
+  uint32_t highest_seq_num = 0;
+  while (!done) {
+    for (const rtcp::ReportBlock& block :
+         receive_statistics->RtcpReportBlocks(1)) {
+      EXPECT_GE(block.extended_high_seq_num(), highest_seq_num);
+      EXPECT_EQ(block.cumulative_lost(),
+                static_cast<int32_t>(block.extended_high_seq_num() / 2));
+      highest_seq_num = block.extended_high_seq_num();
+    }
+  }
+  receive_thread.Finalize();
+
+  std::vector<rtcp::ReportBlock> report_blocks =
+      receive_statistics->RtcpReportBlocks(1);
+  ASSERT_THAT(report_blocks, SizeIs(1));
+  EXPECT_EQ(report_blocks[0].extended_high_seq_num(), 2u * (kNumPackets - 1));
+  EXPECT_EQ(report_blocks[0].cumulative_lost(), kNumPackets - 1);
+}
+
 TEST(ReviseJitterTest, AllPacketsHaveSamePayloadTypeFrequency) {
   SimulatedClock clock(0);
   std::unique_ptr<ReceiveStatistics> statistics =
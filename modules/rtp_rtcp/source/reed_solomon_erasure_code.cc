@@ -0,0 +1,217 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_erasure_code.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Logarithm and exponential tables of GF(2^8) with the primitive polynomial
+// x^8 + x^4 + x^3 + x^2 + 1 and generator 2. `exp` is doubled so that the
+// sum of two logarithms can index it directly.
+struct GaloisFieldTables {
+  uint8_t exp[510];
+  uint8_t log[256];
+};
+
+constexpr GaloisFieldTables MakeGaloisFieldTables() {
+  GaloisFieldTables tables = {};
+  int x = 1;
+  for (int i = 0; i < 255; ++i) {
+    tables.exp[i] = x;
+    tables.exp[i + 255] = x;
+    tables.log[x] = i;
+    x <<= 1;
+    if (x & 0x100) {
+      x ^= 0x11d;
+    }
+  }
+  return tables;
+}
+
+constexpr GaloisFieldTables kGf = MakeGaloisFieldTables();
+
+uint8_t Multiply(uint8_t a, uint8_t b) {
+  if (a == 0 || b == 0) {
+    return 0;
+  }
+  return kGf.exp[kGf.log[a] + kGf.log[b]];
+}
+
+uint8_t Inverse(uint8_t a) {
+  RTC_DCHECK_NE(a, 0);
+  return kGf.exp[255 - kGf.log[a]];
+}
+
+// dst[i] ^= c * src[i] for the `src.size()` first bytes of `dst`.
+void MultiplyAdd(uint8_t c, rtc::ArrayView<const uint8_t> src, uint8_t* dst) {
+  if (c == 0) {
+    return;
+  }
+  if (c == 1) {
+    for (size_t i = 0; i < src.size(); ++i) {
+      dst[i] ^= src[i];
+    }
+    return;
+  }
+  // Products of `c` with every field element, so that the inner loop is a
+  // single lookup per byte.
+  uint8_t products[256];
+  products[0] = 0;
+  for (int x = 1; x < 256; ++x) {
+    products[x] = kGf.exp[kGf.log[c] + kGf.log[x]];
+  }
+  for (size_t i = 0; i < src.size(); ++i) {
+    dst[i] ^= products[src[i]];
+  }
+}
+
+// Inverts the row major `size` x `size` matrix `matrix` in place with
+// Gauss-Jordan elimination. Returns false if it is singular.
+bool InvertMatrix(std::vector<uint8_t>& matrix, int size) {
+  std::vector<uint8_t> inverse(matrix.size(), 0);
+  for (int i = 0; i < size; ++i) {
+    inverse[i * size + i] = 1;
+  }
+  for (int col = 0; col < size; ++col) {
+    int pivot = col;
+    while (pivot < size && matrix[pivot * size + col] == 0) {
+      ++pivot;
+    }
+    if (pivot == size) {
+      return false;
+    }
+    if (pivot != col) {
+      std::swap_ranges(&matrix[pivot * size], &matrix[(pivot + 1) * size],
+                       &matrix[col * size]);
+      std::swap_ranges(&inverse[pivot * size], &inverse[(pivot + 1) * size],
+                       &inverse[col * size]);
+    }
+    uint8_t scale = Inverse(matrix[col * size + col]);
+    for (int j = 0; j < size; ++j) {
+      matrix[col * size + j] = Multiply(matrix[col * size + j], scale);
+      inverse[col * size + j] = Multiply(inverse[col * size + j], scale);
+    }
+    for (int row = 0; row < size; ++row) {
+      uint8_t factor = matrix[row * size + col];
+      if (row == col || factor == 0) {
+        continue;
+      }
+      for (int j = 0; j < size; ++j) {
+        matrix[row * size + j] ^= Multiply(factor, matrix[col * size + j]);
+        inverse[row * size + j] ^= Multiply(factor, inverse[col * size + j]);
+      }
+    }
+  }
+  matrix = std::move(inverse);
+  return true;
+}
+
+}  // namespace
+
+ReedSolomonErasureCode::ReedSolomonErasureCode(int num_data, int num_parity)
+    : num_data_(num_data),
+      num_parity_(num_parity),
+      parity_matrix_(num_data * num_parity) {
+  RTC_DCHECK_GT(num_data, 0);
+  RTC_DCHECK_GE(num_parity, 0);
+  RTC_DCHECK_LE(num_data + num_parity, kMaxBlocks);
+  // Cauchy matrix 1 / (x_j + y_i), with the distinct elements x_j = k + j
+  // and y_i = i.
+  for (int j = 0; j < num_parity; ++j) {
+    for (int i = 0; i < num_data; ++i) {
+      parity_matrix_[j * num_data + i] = Inverse((num_data + j) ^ i);
+    }
+  }
+}
+
+ReedSolomonErasureCode::~ReedSolomonErasureCode() = default;
+
+void ReedSolomonErasureCode::Encode(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> data,
+    rtc::ArrayView<const rtc::ArrayView<uint8_t>> parity) const {
+  RTC_DCHECK_EQ(data.size(), num_data_);
+  RTC_DCHECK_EQ(parity.size(), num_parity_);
+  for (int j = 0; j < num_parity_; ++j) {
+    memset(parity[j].data(), 0, parity[j].size());
+    for (int i = 0; i < num_data_; ++i) {
+      RTC_DCHECK_GE(parity[j].size(), data[i].size());
+      MultiplyAdd(parity_matrix_[j * num_data_ + i], data[i],
+                  parity[j].data());
+    }
+  }
+}
+
+bool ReedSolomonErasureCode::Decode(rtc::ArrayView<rtc::Buffer> blocks,
+                                    size_t block_size) const {
+  RTC_DCHECK_EQ(blocks.size(), num_data_ + num_parity_);
+  std::vector<int> lost_data;
+  for (int i = 0; i < num_data_; ++i) {
+    if (blocks[i].empty()) {
+      lost_data.push_back(i);
+    }
+  }
+  if (lost_data.empty()) {
+    return true;
+  }
+
+  // The received data blocks, completed with as many parity blocks as there
+  // are lost data blocks.
+  std::vector<int> used;
+  used.reserve(num_data_);
+  for (int i = 0; i < num_data_ + num_parity_; ++i) {
+    if (static_cast<int>(used.size()) == num_data_) {
+      break;
+    }
+    if (!blocks[i].empty()) {
+      RTC_DCHECK_LE(blocks[i].size(), block_size);
+      used.push_back(i);
+    }
+  }
+  if (static_cast<int>(used.size()) < num_data_) {
+    return false;
+  }
+
+  // Invert the generator rows of the used blocks. Row `d` of the inverse
+  // expresses data block `d` in terms of the used blocks.
+  std::vector<uint8_t> matrix(num_data_ * num_data_, 0);
+  for (int row = 0; row < num_data_; ++row) {
+    if (used[row] < num_data_) {
+      matrix[row * num_data_ + used[row]] = 1;
+    } else {
+      memcpy(&matrix[row * num_data_],
+             &parity_matrix_[(used[row] - num_data_) * num_data_], num_data_);
+    }
+  }
+  if (!InvertMatrix(matrix, num_data_)) {
+    RTC_DCHECK_NOTREACHED();
+    return false;
+  }
+
+  for (int lost : lost_data) {
+    rtc::Buffer recovered(block_size);
+    memset(recovered.data(), 0, block_size);
+    for (int col = 0; col < num_data_; ++col) {
+      MultiplyAdd(matrix[lost * num_data_ + col], blocks[used[col]],
+                  recovered.data());
+    }
+    blocks[lost] = std::move(recovered);
+  }
+  return true;
+}
+
+}  // namespace webrtc
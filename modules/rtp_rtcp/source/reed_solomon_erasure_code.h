@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_ERASURE_CODE_H_
+#define MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_ERASURE_CODE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "rtc_base/buffer.h"
+
+namespace webrtc {
+
+// Systematic Reed-Solomon erasure code over GF(2^8). Protects `num_data`
+// data blocks with `num_parity` parity blocks, such that all data blocks can
+// be recovered from any `num_data` of the `num_data + num_parity` blocks.
+// Unlike the XOR masks of ULPFEC and FlexFEC, every parity block protects
+// every data block, so a burst of up to `num_parity` lost blocks is always
+// recoverable.
+//
+// The generator is the identity stacked on a Cauchy matrix, which makes
+// every square submatrix of the parity rows invertible. Blocks may have
+// different lengths and are treated as zero padded to the longest block.
+class ReedSolomonErasureCode {
+ public:
+  // Upper bound of `num_data + num_parity`.
+  static constexpr int kMaxBlocks = 256;
+
+  ReedSolomonErasureCode(int num_data, int num_parity);
+  ~ReedSolomonErasureCode();
+
+  int num_data() const { return num_data_; }
+  int num_parity() const { return num_parity_; }
+
+  // Writes the parity blocks of `data`, which must hold `num_data()` blocks,
+  // to `parity`, which must hold `num_parity()` blocks, each at least as long
+  // as the longest data block.
+  void Encode(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> data,
+              rtc::ArrayView<const rtc::ArrayView<uint8_t>> parity) const;
+
+  // `blocks` holds the `num_data() + num_parity()` blocks in order, data
+  // blocks first, with lost blocks left empty. Received parity blocks must
+  // have the length of the encoded parity blocks, `block_size`. Restores
+  // the lost data blocks, with length `block_size`, from the received ones.
+  // Returns false, and leaves `blocks` untouched, if fewer than `num_data()`
+  // blocks were received.
+  bool Decode(rtc::ArrayView<rtc::Buffer> blocks, size_t block_size) const;
+
+ private:
+  const int num_data_;
+  const int num_parity_;
+  // Row major `num_parity_` x `num_data_` Cauchy matrix of the parity rows.
+  std::vector<uint8_t> parity_matrix_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_REED_SOLOMON_ERASURE_CODE_H_
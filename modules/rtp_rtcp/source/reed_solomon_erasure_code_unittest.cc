@@ -0,0 +1,151 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/reed_solomon_erasure_code.h"
+
+#include <algorithm>
+#include <bitset>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+// Encodes `data`, and returns all data and parity blocks.
+std::vector<rtc::Buffer> EncodeBlocks(const ReedSolomonErasureCode& code,
+                                      const std::vector<rtc::Buffer>& data) {
+  size_t block_size = 0;
+  std::vector<rtc::ArrayView<const uint8_t>> data_views;
+  for (const rtc::Buffer& block : data) {
+    block_size = std::max(block_size, block.size());
+    data_views.push_back(block);
+  }
+  std::vector<rtc::Buffer> blocks;
+  for (const rtc::Buffer& block : data) {
+    blocks.emplace_back(block.data(), block.size());
+  }
+  std::vector<rtc::ArrayView<uint8_t>> parity_views;
+  for (int i = 0; i < code.num_parity(); ++i) {
+    blocks.emplace_back(block_size);
+  }
+  for (int i = 0; i < code.num_parity(); ++i) {
+    parity_views.push_back(blocks[code.num_data() + i]);
+  }
+  code.Encode(data_views, parity_views);
+  return blocks;
+}
+
+std::vector<rtc::Buffer> RandomBlocks(Random& random,
+                                      int num_blocks,
+                                      size_t block_size) {
+  std::vector<rtc::Buffer> blocks;
+  for (int i = 0; i < num_blocks; ++i) {
+    rtc::Buffer block(block_size);
+    for (uint8_t& byte : block) {
+      byte = random.Rand<uint8_t>();
+    }
+    blocks.push_back(std::move(block));
+  }
+  return blocks;
+}
+
+TEST(ReedSolomonErasureCodeTest, DecodesWithoutLoss) {
+  Random random(123);
+  ReedSolomonErasureCode code(/*num_data=*/4, /*num_parity=*/2);
+  std::vector<rtc::Buffer> data = RandomBlocks(random, 4, 100);
+  std::vector<rtc::Buffer> blocks = EncodeBlocks(code, data);
+
+  ASSERT_TRUE(code.Decode(blocks, 100));
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(blocks[i], data[i]);
+  }
+}
+
+TEST(ReedSolomonErasureCodeTest, RecoversBurstOfLostDataBlocks) {
+  Random random(123);
+  ReedSolomonErasureCode code(/*num_data=*/10, /*num_parity=*/3);
+  std::vector<rtc::Buffer> data = RandomBlocks(random, 10, 1200);
+  std::vector<rtc::Buffer> blocks = EncodeBlocks(code, data);
+
+  blocks[4].Clear();
+  blocks[5].Clear();
+  blocks[6].Clear();
+  ASSERT_TRUE(code.Decode(blocks, 1200));
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(blocks[i], data[i]) << "Block " << i;
+  }
+}
+
+TEST(ReedSolomonErasureCodeTest, RecoversFromAnySubsetOfBlocks) {
+  Random random(456);
+  constexpr int kNumData = 5;
+  constexpr int kNumParity = 3;
+  ReedSolomonErasureCode code(kNumData, kNumParity);
+  std::vector<rtc::Buffer> data = RandomBlocks(random, kNumData, 64);
+  const std::vector<rtc::Buffer> encoded = EncodeBlocks(code, data);
+
+  // Try every pattern dropping exactly `kNumParity` of the blocks.
+  for (int lost = 0; lost < (1 << (kNumData + kNumParity)); ++lost) {
+    if (std::bitset<kNumData + kNumParity>(lost).count() != kNumParity) {
+      continue;
+    }
+    std::vector<rtc::Buffer> blocks;
+    for (int i = 0; i < kNumData + kNumParity; ++i) {
+      blocks.emplace_back();
+      if (!(lost & (1 << i))) {
+        blocks.back().SetData(encoded[i]);
+      }
+    }
+    ASSERT_TRUE(code.Decode(blocks, 64)) << "Lost " << lost;
+    for (int i = 0; i < kNumData; ++i) {
+      EXPECT_EQ(blocks[i], data[i]) << "Lost " << lost << ", block " << i;
+    }
+  }
+}
+
+TEST(ReedSolomonErasureCodeTest, ZeroPadsShorterDataBlocks) {
+  ReedSolomonErasureCode code(/*num_data=*/3, /*num_parity=*/1);
+  const uint8_t kBlock0[] = {1, 2, 3, 4, 5};
+  const uint8_t kBlock1[] = {6, 7};
+  const uint8_t kBlock2[] = {8, 9, 10};
+  std::vector<rtc::Buffer> data;
+  data.emplace_back(kBlock0);
+  data.emplace_back(kBlock1);
+  data.emplace_back(kBlock2);
+  std::vector<rtc::Buffer> blocks = EncodeBlocks(code, data);
+  ASSERT_EQ(blocks[3].size(), 5u);
+
+  blocks[1].Clear();
+  ASSERT_TRUE(code.Decode(blocks, 5));
+  EXPECT_THAT(blocks[1], ElementsAreArray({6, 7, 0, 0, 0}));
+}
+
+TEST(ReedSolomonErasureCodeTest, FailsWithTooFewBlocks) {
+  Random random(789);
+  ReedSolomonErasureCode code(/*num_data=*/4, /*num_parity=*/2);
+  std::vector<rtc::Buffer> blocks =
+      EncodeBlocks(code, RandomBlocks(random, 4, 10));
+
+  blocks[0].Clear();
+  blocks[2].Clear();
+  blocks[5].Clear();
+  EXPECT_FALSE(code.Decode(blocks, 10));
+  EXPECT_TRUE(blocks[0].empty());
+  EXPECT_TRUE(blocks[2].empty());
+}
+
+}  // namespace
+}  // namespace webrtc
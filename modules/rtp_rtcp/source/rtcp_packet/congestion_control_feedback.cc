@@ -0,0 +1,225 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
+
+#include <utility>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace rtcp {
+namespace {
+
+constexpr size_t kSenderSsrcLength = 4;
+constexpr size_t kReportTimestampLength = 4;
+constexpr size_t kReportBlockHeaderLength = 8;
+constexpr size_t kMetricBlockLength = 2;
+
+// Arrival time offsets are in units of 1/1024 seconds.
+constexpr uint16_t kMaxArrivalTimeOffset = 0x1FFE;
+constexpr uint16_t kArrivalTimeOffsetUnavailable = 0x1FFF;
+
+uint16_t ToArrivalTimeOffset(TimeDelta offset) {
+  if (offset.IsPlusInfinity()) {
+    return kArrivalTimeOffsetUnavailable;
+  }
+  if (offset < TimeDelta::Zero()) {
+    return 0;
+  }
+  if (offset >= TimeDelta::Micros(int64_t{kMaxArrivalTimeOffset} * 1'000'000 /
+                                  1024)) {
+    return kMaxArrivalTimeOffset;
+  }
+  return static_cast<uint16_t>(offset.us() * 1024 / 1'000'000);
+}
+
+TimeDelta FromArrivalTimeOffset(uint16_t offset) {
+  if (offset == kArrivalTimeOffsetUnavailable) {
+    return TimeDelta::PlusInfinity();
+  }
+  return TimeDelta::Micros(int64_t{offset} * 1'000'000 / 1024);
+}
+
+size_t ReportBlockLength(size_t num_reports) {
+  // Metric blocks are padded to a multiple of 32 bits.
+  return kReportBlockHeaderLength +
+         (num_reports * kMetricBlockLength + 3) / 4 * 4;
+}
+
+}  // namespace
+
+// RFC 8888: RTP Control Protocol (RTCP) Feedback for Congestion Control.
+//
+//   0                   1                   2                   3
+//   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |V=2|P| FMT=11  |   PT = 205    |          length               |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |                 SSRC of RTCP packet sender                    |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |                   SSRC of 1st RTP Stream                      |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |          begin_seq            |          num_reports          |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |R|ECN|  Arrival time offset    | ...                           .
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  .                                                               .
+//  .                                                               .
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |                   SSRC of nth RTP Stream                      |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |          begin_seq            |          num_reports          |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |R|ECN|  Arrival time offset    | ...                           |
+//  .                                                               .
+//  .                                                               .
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |                 Report Timestamp (32 bits)                    |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+CongestionControlFeedback::CongestionControlFeedback(
+    std::vector<PacketInfo> packets,
+    uint32_t report_timestamp_compact_ntp)
+    : packets_(std::move(packets)),
+      report_timestamp_compact_ntp_(report_timestamp_compact_ntp) {}
+
+size_t CongestionControlFeedback::ReportBlockSize(size_t begin) const {
+  RTC_DCHECK_LT(begin, packets_.size());
+  size_t end = begin + 1;
+  while (end < packets_.size() && end - begin < kMaxReportsPerStream &&
+         packets_[end].ssrc == packets_[begin].ssrc &&
+         packets_[end].sequence_number ==
+             static_cast<uint16_t>(packets_[end - 1].sequence_number + 1)) {
+    ++end;
+  }
+  return end - begin;
+}
+
+size_t CongestionControlFeedback::BlockLength() const {
+  size_t length = kHeaderLength + kSenderSsrcLength + kReportTimestampLength;
+  for (size_t i = 0; i < packets_.size();) {
+    size_t num_reports = ReportBlockSize(i);
+    length += ReportBlockLength(num_reports);
+    i += num_reports;
+  }
+  return length;
+}
+
+bool CongestionControlFeedback::Create(uint8_t* packet,
+                                       size_t* position,
+                                       size_t max_length,
+                                       PacketReadyCallback callback) const {
+  while (*position + BlockLength() > max_length) {
+    if (!OnBufferFull(packet, position, callback))
+      return false;
+  }
+  const size_t position_end = *position + BlockLength();
+
+  CreateHeader(kFeedbackMessageType, kPacketType, HeaderLength(), packet,
+               position);
+  ByteWriter<uint32_t>::WriteBigEndian(&packet[*position], sender_ssrc());
+  *position += kSenderSsrcLength;
+
+  for (size_t i = 0; i < packets_.size();) {
+    const size_t num_reports = ReportBlockSize(i);
+    ByteWriter<uint32_t>::WriteBigEndian(&packet[*position], packets_[i].ssrc);
+    ByteWriter<uint16_t>::WriteBigEndian(&packet[*position + 4],
+                                         packets_[i].sequence_number);
+    ByteWriter<uint16_t>::WriteBigEndian(&packet[*position + 6], num_reports);
+    *position += kReportBlockHeaderLength;
+
+    for (size_t j = i; j < i + num_reports; ++j) {
+      const PacketInfo& info = packets_[j];
+      uint16_t metric_block = 0;
+      if (!info.arrival_time_offset.IsMinusInfinity()) {
+        metric_block = 0x8000 | (static_cast<uint16_t>(info.ecn) << 13) |
+                       ToArrivalTimeOffset(info.arrival_time_offset);
+      }
+      ByteWriter<uint16_t>::WriteBigEndian(&packet[*position], metric_block);
+      *position += kMetricBlockLength;
+    }
+    if (num_reports % 2 != 0) {
+      ByteWriter<uint16_t>::WriteBigEndian(&packet[*position], 0);
+      *position += kMetricBlockLength;
+    }
+    i += num_reports;
+  }
+
+  ByteWriter<uint32_t>::WriteBigEndian(&packet[*position],
+                                       report_timestamp_compact_ntp_);
+  *position += kReportTimestampLength;
+  RTC_DCHECK_EQ(*position, position_end);
+  return true;
+}
+
+bool CongestionControlFeedback::Parse(const CommonHeader& packet) {
+  RTC_DCHECK_EQ(packet.type(), kPacketType);
+  RTC_DCHECK_EQ(packet.fmt(), kFeedbackMessageType);
+
+  const size_t payload_size = packet.payload_size_bytes();
+  if (payload_size < kSenderSsrcLength + kReportTimestampLength) {
+    RTC_LOG(LS_WARNING) << "Payload length " << payload_size
+                        << " is too small for congestion control feedback.";
+    return false;
+  }
+  const uint8_t* const payload = packet.payload();
+  const size_t report_blocks_end = payload_size - kReportTimestampLength;
+
+  std::vector<PacketInfo> packets;
+  size_t position = kSenderSsrcLength;
+  while (position < report_blocks_end) {
+    if (position + kReportBlockHeaderLength > report_blocks_end) {
+      RTC_LOG(LS_WARNING) << "Truncated congestion control feedback report.";
+      return false;
+    }
+    uint32_t ssrc = ByteReader<uint32_t>::ReadBigEndian(&payload[position]);
+    uint16_t begin_seq =
+        ByteReader<uint16_t>::ReadBigEndian(&payload[position + 4]);
+    uint16_t num_reports =
+        ByteReader<uint16_t>::ReadBigEndian(&payload[position + 6]);
+    if (num_reports > kMaxReportsPerStream ||
+        position + ReportBlockLength(num_reports) > report_blocks_end) {
+      RTC_LOG(LS_WARNING) << "Invalid congestion control feedback report of "
+                          << num_reports << " packets.";
+      return false;
+    }
+    position += kReportBlockHeaderLength;
+
+    for (uint16_t i = 0; i < num_reports; ++i) {
+      uint16_t metric_block =
+          ByteReader<uint16_t>::ReadBigEndian(&payload[position]);
+      position += kMetricBlockLength;
+      PacketInfo& info = packets.emplace_back();
+      info.ssrc = ssrc;
+      info.sequence_number = static_cast<uint16_t>(begin_seq + i);
+      if (metric_block & 0x8000) {
+        info.ecn = static_cast<rtc::EcnMarking>((metric_block >> 13) & 0x03);
+        info.arrival_time_offset = FromArrivalTimeOffset(metric_block & 0x1FFF);
+      }
+    }
+    if (num_reports % 2 != 0) {
+      position += kMetricBlockLength;
+    }
+  }
+
+  SetSenderSsrc(ByteReader<uint32_t>::ReadBigEndian(&payload[0]));
+  report_timestamp_compact_ntp_ =
+      ByteReader<uint32_t>::ReadBigEndian(&payload[report_blocks_end]);
+  packets_ = std::move(packets);
+  return true;
+}
+
+}  // namespace rtcp
+}  // namespace webrtc
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_CONGESTION_CONTROL_FEEDBACK_H_
+#define MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_CONGESTION_CONTROL_FEEDBACK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/units/time_delta.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
+#include "rtc_base/network/ecn_marking.h"
+
+namespace webrtc {
+namespace rtcp {
+class CommonHeader;
+
+// Congestion control feedback, RFC 8888.
+// Reports the arrival time and ECN codepoint of RTP packets, by SSRC and RTP
+// sequence number, relative to the time the report was created.
+class CongestionControlFeedback : public Rtpfb {
+ public:
+  struct PacketInfo {
+    uint32_t ssrc = 0;
+    uint16_t sequence_number = 0;
+    // Time from arrival of the packet until the report timestamp.
+    // Minus infinity if the packet was not received, plus infinity if it was
+    // received at an unknown time.
+    TimeDelta arrival_time_offset = TimeDelta::MinusInfinity();
+    // ECN codepoint the packet arrived with, only meaningful if it was
+    // received.
+    rtc::EcnMarking ecn = rtc::EcnMarking::kNotEct;
+  };
+
+  static constexpr uint8_t kFeedbackMessageType = 11;
+  // RFC 8888 limits the number of packets reported per stream.
+  static constexpr size_t kMaxReportsPerStream = 16384;
+
+  CongestionControlFeedback() = default;
+  // `packets` should be grouped by SSRC, and ordered by sequence number within
+  // each SSRC. Packets that were not received in between reported packets
+  // should be included, with an infinite `arrival_time_offset`.
+  CongestionControlFeedback(std::vector<PacketInfo> packets,
+                            uint32_t report_timestamp_compact_ntp);
+  ~CongestionControlFeedback() override = default;
+
+  // Parse assumes header is already parsed and validated.
+  bool Parse(const CommonHeader& packet);
+
+  rtc::ArrayView<const PacketInfo> packets() const { return packets_; }
+  // Time the report was created, in the receiver's clock, in compact NTP
+  // format.
+  uint32_t report_timestamp_compact_ntp() const {
+    return report_timestamp_compact_ntp_;
+  }
+
+  size_t BlockLength() const override;
+
+  bool Create(uint8_t* packet,
+              size_t* position,
+              size_t max_length,
+              PacketReadyCallback callback) const override;
+
+ private:
+  // Returns the number of packets, starting at `packets_[begin]`, which are
+  // reported in the same report block.
+  size_t ReportBlockSize(size_t begin) const;
+
+  std::vector<PacketInfo> packets_;
+  uint32_t report_timestamp_compact_ntp_ = 0;
+};
+
+}  // namespace rtcp
+}  // namespace webrtc
+#endif  // MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_CONGESTION_CONTROL_FEEDBACK_H_
@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtcp_packet/congestion_control_feedback.h"
+
+#include <cstring>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "rtc_base/buffer.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/rtcp_packet_parser.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+using ::testing::make_tuple;
+using ::webrtc::rtcp::CongestionControlFeedback;
+
+constexpr uint32_t kSenderSsrc = 0x12345678;
+constexpr uint32_t kMediaSsrc = 0x23456789;
+constexpr uint32_t kReportTimestamp = 0x11223344;
+
+// Packets 0x1000 and 0x1002 received 1 and 0.5 seconds before the report,
+// with ECN-capable transport(1) on the latter, 0x1001 lost.
+constexpr uint8_t kPacket[] = {0x8B, 205,  0x00, 0x06,  // Header.
+                               0x12, 0x34, 0x56, 0x78,  // Sender ssrc.
+                               0x23, 0x45, 0x67, 0x89,  // Media ssrc.
+                               0x10, 0x00, 0x00, 0x03,  // Seq, 3 reports.
+                               0x84, 0x00, 0x00, 0x00,  // Received, lost.
+                               0xA2, 0x00, 0x00, 0x00,  // Received, padding.
+                               0x11, 0x22, 0x33, 0x44};  // Report timestamp.
+
+std::vector<CongestionControlFeedback::PacketInfo> PacketInfos() {
+  return {{.ssrc = kMediaSsrc,
+           .sequence_number = 0x1000,
+           .arrival_time_offset = TimeDelta::Seconds(1)},
+          {.ssrc = kMediaSsrc, .sequence_number = 0x1001},
+          {.ssrc = kMediaSsrc,
+           .sequence_number = 0x1002,
+           .arrival_time_offset = TimeDelta::Millis(500),
+           .ecn = rtc::EcnMarking::kEct1}};
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, Create) {
+  CongestionControlFeedback feedback(PacketInfos(), kReportTimestamp);
+  feedback.SetSenderSsrc(kSenderSsrc);
+
+  rtc::Buffer packet = feedback.Build();
+
+  EXPECT_THAT(make_tuple(packet.data(), packet.size()),
+              ElementsAreArray(kPacket));
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, Parse) {
+  CongestionControlFeedback parsed;
+  ASSERT_TRUE(test::ParseSinglePacket(kPacket, &parsed));
+
+  EXPECT_EQ(parsed.sender_ssrc(), kSenderSsrc);
+  EXPECT_EQ(parsed.report_timestamp_compact_ntp(), kReportTimestamp);
+  ASSERT_EQ(parsed.packets().size(), 3u);
+  std::vector<CongestionControlFeedback::PacketInfo> expected = PacketInfos();
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(parsed.packets()[i].ssrc, expected[i].ssrc);
+    EXPECT_EQ(parsed.packets()[i].sequence_number,
+              expected[i].sequence_number);
+    EXPECT_EQ(parsed.packets()[i].arrival_time_offset,
+              expected[i].arrival_time_offset);
+    EXPECT_EQ(parsed.packets()[i].ecn, expected[i].ecn);
+  }
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, ParsesMultipleStreams) {
+  std::vector<CongestionControlFeedback::PacketInfo> packets;
+  for (uint32_t ssrc = 1; ssrc <= 3; ++ssrc) {
+    for (uint16_t seq = 0xFFFE; seq != 2; ++seq) {
+      packets.push_back({.ssrc = ssrc,
+                         .sequence_number = seq,
+                         .arrival_time_offset = TimeDelta::Millis(seq % 8)});
+    }
+  }
+  CongestionControlFeedback feedback(packets, kReportTimestamp);
+  rtc::Buffer buffer = feedback.Build();
+  EXPECT_EQ(buffer.size(), feedback.BlockLength());
+
+  CongestionControlFeedback parsed;
+  ASSERT_TRUE(test::ParseSinglePacket(buffer, &parsed));
+  ASSERT_EQ(parsed.packets().size(), packets.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(parsed.packets()[i].ssrc, packets[i].ssrc);
+    EXPECT_EQ(parsed.packets()[i].sequence_number, packets[i].sequence_number);
+    // Arrival time offsets are rounded down to 1/1024 seconds.
+    EXPECT_LE(parsed.packets()[i].arrival_time_offset,
+              packets[i].arrival_time_offset);
+    EXPECT_GT(parsed.packets()[i].arrival_time_offset,
+              packets[i].arrival_time_offset - TimeDelta::Millis(1));
+  }
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, StartsNewReportOnGap) {
+  CongestionControlFeedback feedback(
+      {{.ssrc = kMediaSsrc,
+        .sequence_number = 1,
+        .arrival_time_offset = TimeDelta::Zero()},
+       {.ssrc = kMediaSsrc,
+        .sequence_number = 10,
+        .arrival_time_offset = TimeDelta::Zero()}},
+      kReportTimestamp);
+  rtc::Buffer buffer = feedback.Build();
+
+  CongestionControlFeedback parsed;
+  ASSERT_TRUE(test::ParseSinglePacket(buffer, &parsed));
+  ASSERT_EQ(parsed.packets().size(), 2u);
+  EXPECT_EQ(parsed.packets()[0].sequence_number, 1);
+  EXPECT_EQ(parsed.packets()[1].sequence_number, 10);
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, LimitsArrivalTimeOffset) {
+  CongestionControlFeedback feedback(
+      {{.ssrc = kMediaSsrc,
+        .sequence_number = 1,
+        .arrival_time_offset = TimeDelta::Seconds(10)},
+       {.ssrc = kMediaSsrc,
+        .sequence_number = 2,
+        .arrival_time_offset = TimeDelta::PlusInfinity()}},
+      kReportTimestamp);
+  rtc::Buffer buffer = feedback.Build();
+
+  CongestionControlFeedback parsed;
+  ASSERT_TRUE(test::ParseSinglePacket(buffer, &parsed));
+  ASSERT_EQ(parsed.packets().size(), 2u);
+  EXPECT_EQ(parsed.packets()[0].arrival_time_offset,
+            TimeDelta::Micros(int64_t{0x1FFE} * 1'000'000 / 1024));
+  EXPECT_EQ(parsed.packets()[1].arrival_time_offset,
+            TimeDelta::PlusInfinity());
+}
+
+TEST(RtcpPacketCongestionControlFeedbackTest, ParseFailsOnTruncatedReport) {
+  uint8_t packet[sizeof(kPacket)];
+  memcpy(packet, kPacket, sizeof(kPacket));
+  // Claim 5 reports, which doesn't fit before the report timestamp.
+  packet[15] = 0x05;
+  CongestionControlFeedback parsed;
+  EXPECT_FALSE(test::ParseSinglePacket(packet, &parsed));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,137 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtcp_packet/packet_view.h"
+
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace rtcp {
+namespace {
+
+// Lengths of the fixed parts of the packets, see sender_report.cc,
+// receiver_report.cc and nack.cc for the layouts.
+constexpr size_t kSsrcLength = 4;
+constexpr size_t kSenderInfoLength = 20;
+constexpr size_t kCommonFeedbackLength = 8;
+constexpr size_t kNackItemLength = 4;
+
+}  // namespace
+
+bool ForEachRtcpPacket(
+    rtc::ArrayView<const uint8_t> compound_packet,
+    rtc::FunctionView<bool(const CommonHeader& packet)> handler) {
+  CommonHeader packet;
+  for (const uint8_t* next_packet = compound_packet.begin();
+       next_packet != compound_packet.end();
+       next_packet = packet.NextPacket()) {
+    if (!packet.Parse(next_packet, compound_packet.end() - next_packet) ||
+        !handler(packet)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+absl::optional<ReportView> ReportView::Parse(const CommonHeader& packet) {
+  RTC_DCHECK(packet.type() == SenderReport::kPacketType ||
+             packet.type() == ReceiverReport::kPacketType);
+  const bool has_sender_info = packet.type() == SenderReport::kPacketType;
+  const size_t num_report_blocks = packet.count();
+  if (packet.payload_size_bytes() <
+      kSsrcLength + (has_sender_info ? kSenderInfoLength : 0) +
+          num_report_blocks * ReportBlock::kLength) {
+    RTC_LOG(LS_WARNING) << "Packet is too small to contain all the data.";
+    return absl::nullopt;
+  }
+  return ReportView(packet.payload(), has_sender_info, num_report_blocks);
+}
+
+uint32_t ReportView::sender_ssrc() const {
+  return ByteReader<uint32_t>::ReadBigEndian(&payload_[0]);
+}
+
+NtpTime ReportView::ntp() const {
+  RTC_DCHECK(has_sender_info_);
+  return NtpTime(ByteReader<uint32_t>::ReadBigEndian(&payload_[4]),
+                 ByteReader<uint32_t>::ReadBigEndian(&payload_[8]));
+}
+
+uint32_t ReportView::rtp_timestamp() const {
+  RTC_DCHECK(has_sender_info_);
+  return ByteReader<uint32_t>::ReadBigEndian(&payload_[12]);
+}
+
+uint32_t ReportView::sender_packet_count() const {
+  RTC_DCHECK(has_sender_info_);
+  return ByteReader<uint32_t>::ReadBigEndian(&payload_[16]);
+}
+
+uint32_t ReportView::sender_octet_count() const {
+  RTC_DCHECK(has_sender_info_);
+  return ByteReader<uint32_t>::ReadBigEndian(&payload_[20]);
+}
+
+ReportBlock ReportView::report_block(size_t index) const {
+  RTC_DCHECK_LT(index, num_report_blocks_);
+  ReportBlock block;
+  bool block_parsed =
+      block.Parse(payload_ + kSsrcLength +
+                      (has_sender_info_ ? kSenderInfoLength : 0) +
+                      index * ReportBlock::kLength,
+                  ReportBlock::kLength);
+  RTC_DCHECK(block_parsed);
+  return block;
+}
+
+absl::optional<NackView> NackView::Parse(const CommonHeader& packet) {
+  RTC_DCHECK_EQ(packet.type(), Rtpfb::kPacketType);
+  RTC_DCHECK_EQ(packet.fmt(), Nack::kFeedbackMessageType);
+  if (packet.payload_size_bytes() < kCommonFeedbackLength + kNackItemLength) {
+    RTC_LOG(LS_WARNING) << "Payload length " << packet.payload_size_bytes()
+                        << " is too small for a Nack.";
+    return absl::nullopt;
+  }
+  return NackView(
+      packet.payload(),
+      (packet.payload_size_bytes() - kCommonFeedbackLength) / kNackItemLength);
+}
+
+uint32_t NackView::sender_ssrc() const {
+  return ByteReader<uint32_t>::ReadBigEndian(&payload_[0]);
+}
+
+uint32_t NackView::media_ssrc() const {
+  return ByteReader<uint32_t>::ReadBigEndian(&payload_[4]);
+}
+
+void NackView::AppendPacketIds(std::vector<uint16_t>& packet_ids) const {
+  const uint8_t* next_item = payload_ + kCommonFeedbackLength;
+  for (size_t i = 0; i < num_items_; ++i) {
+    uint16_t pid = ByteReader<uint16_t>::ReadBigEndian(next_item);
+    packet_ids.push_back(pid);
+    ++pid;
+    for (uint16_t bitmask = ByteReader<uint16_t>::ReadBigEndian(next_item + 2);
+         bitmask != 0; bitmask >>= 1, ++pid) {
+      if (bitmask & 1)
+        packet_ids.push_back(pid);
+    }
+    next_item += kNackItemLength;
+  }
+}
+
+}  // namespace rtcp
+}  // namespace webrtc
@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_PACKET_VIEW_H_
+#define MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_PACKET_VIEW_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/function_view.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
+#include "system_wrappers/include/ntp_time.h"
+
+namespace webrtc {
+namespace rtcp {
+
+// Views of the RTCP packets that are received in almost every compound
+// packet. Unlike SenderReport, ReceiverReport and Nack they don't copy the
+// packet into containers of their own, but read the fields from the buffer
+// the CommonHeader points into, which must outlive the view.
+
+// Calls `handler` for each RTCP packet in `compound_packet`, in order.
+// Stops and returns false when a packet header fails to parse or the handler
+// returns false.
+bool ForEachRtcpPacket(
+    rtc::ArrayView<const uint8_t> compound_packet,
+    rtc::FunctionView<bool(const CommonHeader& packet)> handler);
+
+// Sender report (RFC 3550, section 6.4.1) or receiver report (section 6.4.2).
+class ReportView {
+ public:
+  // Returns nullopt if the packet is too small for the report blocks it
+  // claims to contain. `packet` must be a sender or a receiver report.
+  static absl::optional<ReportView> Parse(const CommonHeader& packet);
+
+  uint32_t sender_ssrc() const;
+
+  // The sender info is only present in sender reports.
+  bool has_sender_info() const { return has_sender_info_; }
+  NtpTime ntp() const;
+  uint32_t rtp_timestamp() const;
+  uint32_t sender_packet_count() const;
+  uint32_t sender_octet_count() const;
+
+  size_t num_report_blocks() const { return num_report_blocks_; }
+  ReportBlock report_block(size_t index) const;
+
+ private:
+  ReportView(const uint8_t* payload,
+             bool has_sender_info,
+             size_t num_report_blocks)
+      : payload_(payload),
+        has_sender_info_(has_sender_info),
+        num_report_blocks_(num_report_blocks) {}
+
+  const uint8_t* payload_;
+  bool has_sender_info_;
+  size_t num_report_blocks_;
+};
+
+// Generic NACK (RFC 4585, section 6.2.1).
+class NackView {
+ public:
+  // Returns nullopt if the packet doesn't contain a single NACK item.
+  // `packet` must be a generic NACK.
+  static absl::optional<NackView> Parse(const CommonHeader& packet);
+
+  uint32_t sender_ssrc() const;
+  uint32_t media_ssrc() const;
+
+  // Appends the lost packets to `packet_ids`, in the order of
+  // Nack::packet_ids().
+  void AppendPacketIds(std::vector<uint16_t>& packet_ids) const;
+
+ private:
+  NackView(const uint8_t* payload, size_t num_items)
+      : payload_(payload), num_items_(num_items) {}
+
+  const uint8_t* payload_;
+  size_t num_items_;
+};
+
+}  // namespace rtcp
+}  // namespace webrtc
+#endif  // MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_PACKET_VIEW_H_
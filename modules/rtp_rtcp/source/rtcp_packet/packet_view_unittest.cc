@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtcp_packet/packet_view.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
+#include "rtc_base/buffer.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+using ::webrtc::rtcp::CommonHeader;
+using ::webrtc::rtcp::CompoundPacket;
+using ::webrtc::rtcp::ForEachRtcpPacket;
+using ::webrtc::rtcp::Nack;
+using ::webrtc::rtcp::NackView;
+using ::webrtc::rtcp::ReceiverReport;
+using ::webrtc::rtcp::ReportBlock;
+using ::webrtc::rtcp::ReportView;
+using ::webrtc::rtcp::SenderReport;
+
+constexpr uint32_t kSenderSsrc = 0x12345678;
+constexpr uint32_t kRemoteSsrc = 0x23456789;
+
+ReportBlock CreateReportBlock(uint32_t source_ssrc) {
+  ReportBlock block;
+  block.SetMediaSsrc(source_ssrc);
+  block.SetFractionLost(55);
+  block.SetCumulativeLost(0x111111);
+  block.SetExtHighestSeqNum(0x22222222);
+  block.SetJitter(0x33333333);
+  block.SetLastSr(0x44444444);
+  block.SetDelayLastSr(0x55555555);
+  return block;
+}
+
+CommonHeader ParseHeader(const rtc::Buffer& packet) {
+  CommonHeader header;
+  EXPECT_TRUE(header.Parse(packet.data(), packet.size()));
+  return header;
+}
+
+void ExpectEqual(const ReportBlock& block, const ReportBlock& expected) {
+  EXPECT_EQ(block.source_ssrc(), expected.source_ssrc());
+  EXPECT_EQ(block.fraction_lost(), expected.fraction_lost());
+  EXPECT_EQ(block.cumulative_lost(), expected.cumulative_lost());
+  EXPECT_EQ(block.extended_high_seq_num(), expected.extended_high_seq_num());
+  EXPECT_EQ(block.jitter(), expected.jitter());
+  EXPECT_EQ(block.last_sr(), expected.last_sr());
+  EXPECT_EQ(block.delay_since_last_sr(), expected.delay_since_last_sr());
+}
+
+TEST(RtcpPacketViewTest, ReadsSenderReport) {
+  SenderReport sr;
+  sr.SetSenderSsrc(kSenderSsrc);
+  sr.SetNtp(NtpTime(0x11111111, 0x22222222));
+  sr.SetRtpTimestamp(0x33333333);
+  sr.SetPacketCount(0x44444444);
+  sr.SetOctetCount(0x55555555);
+  sr.AddReportBlock(CreateReportBlock(kRemoteSsrc));
+  sr.AddReportBlock(CreateReportBlock(kRemoteSsrc + 1));
+  rtc::Buffer packet = sr.Build();
+
+  absl::optional<ReportView> view = ReportView::Parse(ParseHeader(packet));
+  ASSERT_TRUE(view);
+  EXPECT_TRUE(view->has_sender_info());
+  EXPECT_EQ(view->sender_ssrc(), kSenderSsrc);
+  EXPECT_EQ(view->ntp(), NtpTime(0x11111111, 0x22222222));
+  EXPECT_EQ(view->rtp_timestamp(), 0x33333333u);
+  EXPECT_EQ(view->sender_packet_count(), 0x44444444u);
+  EXPECT_EQ(view->sender_octet_count(), 0x55555555u);
+  ASSERT_EQ(view->num_report_blocks(), 2u);
+  ExpectEqual(view->report_block(0), sr.report_blocks()[0]);
+  ExpectEqual(view->report_block(1), sr.report_blocks()[1]);
+}
+
+TEST(RtcpPacketViewTest, ReadsReceiverReport) {
+  ReceiverReport rr;
+  rr.SetSenderSsrc(kSenderSsrc);
+  rr.AddReportBlock(CreateReportBlock(kRemoteSsrc));
+  rtc::Buffer packet = rr.Build();
+
+  absl::optional<ReportView> view = ReportView::Parse(ParseHeader(packet));
+  ASSERT_TRUE(view);
+  EXPECT_FALSE(view->has_sender_info());
+  EXPECT_EQ(view->sender_ssrc(), kSenderSsrc);
+  ASSERT_EQ(view->num_report_blocks(), 1u);
+  ExpectEqual(view->report_block(0), rr.report_blocks()[0]);
+}
+
+TEST(RtcpPacketViewTest, RejectsReportTooSmallForItsReportBlocks) {
+  ReceiverReport rr;
+  rr.SetSenderSsrc(kSenderSsrc);
+  rr.AddReportBlock(CreateReportBlock(kRemoteSsrc));
+  rtc::Buffer packet = rr.Build();
+  // Claim a second report block.
+  packet[0] += 1;
+
+  EXPECT_FALSE(ReportView::Parse(ParseHeader(packet)));
+}
+
+TEST(RtcpPacketViewTest, UnpacksNackLikeNack) {
+  const uint16_t kList[] = {0xffdc, 0xffec, 0xfffe, 0xffff, 0x0000,
+                            0x0001, 0x0003, 0x0014, 0x0064};
+  Nack nack;
+  nack.SetSenderSsrc(kSenderSsrc);
+  nack.SetMediaSsrc(kRemoteSsrc);
+  nack.SetPacketIds(kList, std::size(kList));
+  rtc::Buffer packet = nack.Build();
+
+  absl::optional<NackView> view = NackView::Parse(ParseHeader(packet));
+  ASSERT_TRUE(view);
+  EXPECT_EQ(view->sender_ssrc(), kSenderSsrc);
+  EXPECT_EQ(view->media_ssrc(), kRemoteSsrc);
+  std::vector<uint16_t> packet_ids = {1234};
+  view->AppendPacketIds(packet_ids);
+  EXPECT_EQ(packet_ids[0], 1234);
+  EXPECT_THAT(rtc::ArrayView<const uint16_t>(packet_ids).subview(1),
+              ElementsAreArray(kList));
+}
+
+TEST(RtcpPacketViewTest, RejectsNackWithoutItems) {
+  // clang-format off
+  const uint8_t kPacket[] = {
+      0x80 | Nack::kFeedbackMessageType, Nack::kPacketType, 0, 2,
+      0x12, 0x34, 0x56, 0x78,
+      0x23, 0x45, 0x67, 0x89};
+  // clang-format on
+  CommonHeader header;
+  ASSERT_TRUE(header.Parse(kPacket, sizeof(kPacket)));
+
+  EXPECT_FALSE(NackView::Parse(header));
+}
+
+TEST(RtcpPacketViewTest, VisitsEachPacketOfCompoundPacket) {
+  CompoundPacket compound;
+  compound.Append(std::make_unique<SenderReport>());
+  compound.Append(std::make_unique<ReceiverReport>());
+  auto nack = std::make_unique<Nack>();
+  nack->SetPacketIds({1});
+  compound.Append(std::move(nack));
+  rtc::Buffer packet = compound.Build();
+
+  std::vector<uint8_t> types;
+  EXPECT_TRUE(ForEachRtcpPacket(packet, [&](const CommonHeader& header) {
+    types.push_back(header.type());
+    return true;
+  }));
+  EXPECT_THAT(types, ElementsAre(SenderReport::kPacketType,
+                                 ReceiverReport::kPacketType,
+                                 Nack::kPacketType));
+}
+
+TEST(RtcpPacketViewTest, StopsAtInvalidOrRejectedPacket) {
+  CompoundPacket compound;
+  compound.Append(std::make_unique<SenderReport>());
+  compound.Append(std::make_unique<ReceiverReport>());
+  rtc::Buffer packet = compound.Build();
+
+  int num_packets = 0;
+  EXPECT_FALSE(ForEachRtcpPacket(packet, [&](const CommonHeader& header) {
+    ++num_packets;
+    return false;
+  }));
+  EXPECT_EQ(num_packets, 1);
+
+  num_packets = 0;
+  EXPECT_FALSE(ForEachRtcpPacket(
+      rtc::ArrayView<const uint8_t>(packet).subview(0, packet.size() - 1),
+      [&](const CommonHeader& header) {
+        ++num_packets;
+        return true;
+      }));
+  EXPECT_EQ(num_packets, 1);
+}
+
+}  // namespace
+}  // namespace webrtc
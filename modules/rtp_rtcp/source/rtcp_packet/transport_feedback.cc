@@ -434,6 +434,7 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
   uint16_t status_count = ByteReader<uint16_t>::ReadBigEndian(&payload[10]);
   base_time_ticks_ = ByteReader<uint32_t, 3>::ReadBigEndian(&payload[12]);
   feedback_seq_ = payload[15];
+  include_timestamps_ = true;
   Clear();
   size_t index = 16;
   const size_t end_index = packet.payload_size_bytes();
@@ -443,9 +444,11 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
     return false;
   }
 
-  std::vector<uint8_t> delta_sizes;
-  delta_sizes.reserve(status_count);
-  while (delta_sizes.size() < status_count) {
+  // First pass over the chunks, to find the size of the receive deltas.
+  size_t num_delta_sizes = 0;
+  size_t num_received = 0;
+  size_t recv_delta_size = 0;
+  while (num_delta_sizes < status_count) {
     if (index + kChunkSizeBytes > end_index) {
       RTC_LOG(LS_WARNING) << "Buffer overflow while parsing packet.";
       Clear();
@@ -455,58 +458,82 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
     uint16_t chunk = ByteReader<uint16_t>::ReadBigEndian(&payload[index]);
     index += kChunkSizeBytes;
     encoded_chunks_.push_back(chunk);
-    last_chunk_.Decode(chunk, status_count - delta_sizes.size());
-    last_chunk_.AppendTo(&delta_sizes);
+    last_chunk_.Decode(chunk, status_count - num_delta_sizes);
+    for (size_t i = 0; i < last_chunk_.size(); ++i) {
+      DeltaSize delta_size = last_chunk_.delta_size(i);
+      num_received += delta_size > 0 ? 1 : 0;
+      recv_delta_size += delta_size;
+    }
+    num_delta_sizes += last_chunk_.size();
   }
   // Last chunk is stored in the `last_chunk_`.
   encoded_chunks_.pop_back();
-  RTC_DCHECK_EQ(delta_sizes.size(), status_count);
+  RTC_DCHECK_EQ(num_delta_sizes, status_count);
   num_seq_no_ = status_count;
+  received_packets_.reserve(num_received);
 
+  // Second pass, decoding the chunks again into a local copy.
   uint16_t seq_no = base_seq_no_;
-  size_t recv_delta_size = absl::c_accumulate(delta_sizes, 0);
+  size_t chunk_index = 16;
+  LastChunk chunk_decoder;
+  size_t num_remaining = status_count;
+  auto next_chunk = [&] {
+    chunk_decoder.Decode(
+        ByteReader<uint16_t>::ReadBigEndian(&payload[chunk_index]),
+        num_remaining);
+    chunk_index += kChunkSizeBytes;
+    num_remaining -= chunk_decoder.size();
+  };
 
   // Determine if timestamps, that is, recv_delta are included in the packet.
   if (end_index >= index + recv_delta_size) {
-    for (size_t delta_size : delta_sizes) {
-      RTC_DCHECK_LE(index + delta_size, end_index);
-      switch (delta_size) {
-        case 0:
-          break;
-        case 1: {
-          int16_t delta = payload[index];
-          received_packets_.emplace_back(seq_no, delta);
-          last_timestamp_ += delta * kDeltaTick;
-          index += delta_size;
-          break;
+    while (num_remaining > 0) {
+      next_chunk();
+      for (size_t i = 0; i < chunk_decoder.size(); ++i) {
+        DeltaSize delta_size = chunk_decoder.delta_size(i);
+        RTC_DCHECK_LE(index + delta_size, end_index);
+        switch (delta_size) {
+          case 0:
+            break;
+          case 1: {
+            int16_t delta = payload[index];
+            received_packets_.emplace_back(seq_no, delta);
+            last_timestamp_ += delta * kDeltaTick;
+            index += delta_size;
+            break;
+          }
+          case 2: {
+            int16_t delta =
+                ByteReader<int16_t>::ReadBigEndian(&payload[index]);
+            received_packets_.emplace_back(seq_no, delta);
+            last_timestamp_ += delta * kDeltaTick;
+            index += delta_size;
+            break;
+          }
+          case 3:
+            Clear();
+            RTC_LOG(LS_WARNING) << "Invalid delta_size for seq_no " << seq_no;
+
+            return false;
+          default:
+            RTC_DCHECK_NOTREACHED();
+            break;
         }
-        case 2: {
-          int16_t delta = ByteReader<int16_t>::ReadBigEndian(&payload[index]);
-          received_packets_.emplace_back(seq_no, delta);
-          last_timestamp_ += delta * kDeltaTick;
-          index += delta_size;
-          break;
-        }
-        case 3:
-          Clear();
-          RTC_LOG(LS_WARNING) << "Invalid delta_size for seq_no " << seq_no;
-
-          return false;
-        default:
-          RTC_DCHECK_NOTREACHED();
-          break;
+        ++seq_no;
       }
-      ++seq_no;
     }
   } else {
     // The packet does not contain receive deltas.
     include_timestamps_ = false;
-    for (size_t delta_size : delta_sizes) {
-      // Use delta sizes to detect if packet was received.
-      if (delta_size > 0) {
-        received_packets_.emplace_back(seq_no, 0);
+    while (num_remaining > 0) {
+      next_chunk();
+      for (size_t i = 0; i < chunk_decoder.size(); ++i) {
+        // Use delta sizes to detect if packet was received.
+        if (chunk_decoder.delta_size(i) > 0) {
+          received_packets_.emplace_back(seq_no, 0);
+        }
+        ++seq_no;
       }
-      ++seq_no;
     }
   }
   size_bytes_ = RtcpPacket::kHeaderLength + index;
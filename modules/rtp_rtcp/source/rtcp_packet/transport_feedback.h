@@ -89,6 +89,8 @@ class TransportFeedback : public Rtpfb {
   // Does the feedback packet contain timestamp information?
   bool IncludeTimestamps() const { return include_timestamps_; }
 
+  // Parsing into a previously used TransportFeedback reuses its storage, and
+  // does not allocate unless the new feedback describes more packets.
   bool Parse(const CommonHeader& packet);
   static std::unique_ptr<TransportFeedback> ParseFrom(const uint8_t* buffer,
                                                       size_t length);
@@ -136,6 +138,11 @@ class TransportFeedback : public Rtpfb {
     void Decode(uint16_t chunk, size_t max_size);
     // Appends content of the Lastchunk to `deltas`.
     void AppendTo(std::vector<DeltaSize>* deltas) const;
+    // Number of delta sizes stored, and the `i`th of them.
+    size_t size() const { return size_; }
+    DeltaSize delta_size(size_t i) const {
+      return all_same_ ? delta_sizes_[0] : delta_sizes_[i];
+    }
 
    private:
     static constexpr size_t kMaxOneBitCapacity = 14;
@@ -14,6 +14,7 @@
 #include <memory>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
@@ -663,5 +664,39 @@ TEST(TransportFeedbackTest, ReportsMissingPacketsWithoutTimestamps) {
   EXPECT_CALL(handler, Call(kBaseSeqNo + 3, Ne(TimeDelta::PlusInfinity())));
   Parse(feedback_builder.Build()).ForAllPackets(handler.AsStdFunction());
 }
+
+TEST(TransportFeedbackTest, ParsesIntoPreviouslyUsedFeedback) {
+  const uint16_t kBaseSeqNo = 1000;
+  const Timestamp kBaseTimestamp = Timestamp::Millis(10);
+  TransportFeedback without_timestamps(/*include_timestamps=*/false);
+  without_timestamps.SetBase(kBaseSeqNo, kBaseTimestamp);
+  for (int i = 0; i < 50; i += 2) {
+    without_timestamps.AddReceivedPacket(kBaseSeqNo + i, Timestamp::Zero());
+  }
+  TransportFeedback with_timestamps(/*include_timestamps=*/true);
+  with_timestamps.SetBase(kBaseSeqNo + 100, kBaseTimestamp);
+  for (int i = 0; i < 10; ++i) {
+    with_timestamps.AddReceivedPacket(kBaseSeqNo + 100 + i,
+                                      kBaseTimestamp + TimeDelta::Millis(i));
+  }
+
+  TransportFeedback feedback;
+  rtcp::CommonHeader header;
+  rtc::Buffer first = without_timestamps.Build();
+  ASSERT_TRUE(header.Parse(first.data(), first.size()));
+  ASSERT_TRUE(feedback.Parse(header));
+  EXPECT_FALSE(feedback.IncludeTimestamps());
+  EXPECT_THAT(feedback.GetReceivedPackets(), SizeIs(25));
+
+  rtc::Buffer second = with_timestamps.Build();
+  ASSERT_TRUE(header.Parse(second.data(), second.size()));
+  ASSERT_TRUE(feedback.Parse(header));
+  EXPECT_TRUE(feedback.IncludeTimestamps());
+  EXPECT_TRUE(feedback.IsConsistent());
+  EXPECT_EQ(feedback.GetPacketStatusCount(), 10u);
+  EXPECT_EQ(feedback.GetBaseSequence(), kBaseSeqNo + 100);
+  EXPECT_THAT(feedback.GetReceivedPackets(), SizeIs(10));
+  EXPECT_EQ(feedback.Build(), second);
+}
 }  // namespace
 }  // namespace webrtc
@@ -30,6 +30,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/loss_notification.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/packet_view.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/pli.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/rapid_resync_request.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
@@ -216,6 +217,12 @@ void RTCPReceiver::IncomingPacket(rtc::ArrayView<const uint8_t> packet) {
   if (!ParseCompoundPacket(packet, &packet_information))
     return;
   TriggerCallbacksFromRtcpPacket(packet_information);
+
+  if (packet_information.transport_feedback != nullptr) {
+    MutexLock lock(&rtcp_receiver_lock_);
+    spare_transport_feedback_ =
+        std::move(packet_information.transport_feedback);
+  }
 }
 
 // This method is only used by test and legacy code, so we should be able to
@@ -502,12 +509,13 @@ bool RTCPReceiver::ParseCompoundPacket(rtc::ArrayView<const uint8_t> packet,
 
 bool RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
                                       PacketInformation* packet_information) {
-  rtcp::SenderReport sender_report;
-  if (!sender_report.Parse(rtcp_block)) {
+  absl::optional<rtcp::ReportView> sender_report =
+      rtcp::ReportView::Parse(rtcp_block);
+  if (!sender_report) {
     return false;
   }
 
-  const uint32_t remote_ssrc = sender_report.sender_ssrc();
+  const uint32_t remote_ssrc = sender_report->sender_ssrc();
 
   packet_information->remote_ssrc = remote_ssrc;
 
@@ -518,11 +526,11 @@ bool RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
     // Only signal that we have received a SR when we accept one.
     packet_information->packet_type_flags |= kRtcpSr;
 
-    remote_sender_.last_remote_timestamp = sender_report.ntp();
-    remote_sender_.last_remote_rtp_timestamp = sender_report.rtp_timestamp();
+    remote_sender_.last_remote_timestamp = sender_report->ntp();
+    remote_sender_.last_remote_rtp_timestamp = sender_report->rtp_timestamp();
     remote_sender_.last_arrival_timestamp = clock_->CurrentNtpTime();
-    remote_sender_.packets_sent = sender_report.sender_packet_count();
-    remote_sender_.bytes_sent = sender_report.sender_octet_count();
+    remote_sender_.packets_sent = sender_report->sender_packet_count();
+    remote_sender_.bytes_sent = sender_report->sender_octet_count();
     remote_sender_.reports_count++;
   } else {
     // We will only store the send report from one source, but
@@ -530,8 +538,9 @@ bool RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
     packet_information->packet_type_flags |= kRtcpRr;
   }
 
-  for (const rtcp::ReportBlock& report_block : sender_report.report_blocks()) {
-    HandleReportBlock(report_block, packet_information, remote_ssrc);
+  for (size_t i = 0; i < sender_report->num_report_blocks(); ++i) {
+    HandleReportBlock(sender_report->report_block(i), packet_information,
+                      remote_ssrc);
   }
 
   return true;
@@ -539,12 +548,13 @@ bool RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
 
 bool RTCPReceiver::HandleReceiverReport(const CommonHeader& rtcp_block,
                                         PacketInformation* packet_information) {
-  rtcp::ReceiverReport receiver_report;
-  if (!receiver_report.Parse(rtcp_block)) {
+  absl::optional<rtcp::ReportView> receiver_report =
+      rtcp::ReportView::Parse(rtcp_block);
+  if (!receiver_report) {
     return false;
   }
 
-  const uint32_t remote_ssrc = receiver_report.sender_ssrc();
+  const uint32_t remote_ssrc = receiver_report->sender_ssrc();
 
   packet_information->remote_ssrc = remote_ssrc;
 
@@ -552,8 +562,9 @@ bool RTCPReceiver::HandleReceiverReport(const CommonHeader& rtcp_block,
 
   packet_information->packet_type_flags |= kRtcpRr;
 
-  for (const ReportBlock& report_block : receiver_report.report_blocks()) {
-    HandleReportBlock(report_block, packet_information, remote_ssrc);
+  for (size_t i = 0; i < receiver_report->num_report_blocks(); ++i) {
+    HandleReportBlock(receiver_report->report_block(i), packet_information,
+                      remote_ssrc);
   }
 
   return true;
@@ -719,21 +730,24 @@ bool RTCPReceiver::HandleSdes(const CommonHeader& rtcp_block,
 
 bool RTCPReceiver::HandleNack(const CommonHeader& rtcp_block,
                               PacketInformation* packet_information) {
-  rtcp::Nack nack;
-  if (!nack.Parse(rtcp_block)) {
+  absl::optional<rtcp::NackView> nack = rtcp::NackView::Parse(rtcp_block);
+  if (!nack) {
     return false;
   }
 
-  if (receiver_only_ || local_media_ssrc() != nack.media_ssrc())  // Not to us.
+  if (receiver_only_ || local_media_ssrc() != nack->media_ssrc())  // Not to us.
     return true;
 
-  packet_information->nack_sequence_numbers.insert(
-      packet_information->nack_sequence_numbers.end(),
-      nack.packet_ids().begin(), nack.packet_ids().end());
-  for (uint16_t packet_id : nack.packet_ids())
-    nack_stats_.ReportRequest(packet_id);
+  // Unpack the packet ids straight into the packet information, they may
+  // already hold the ones of an earlier NACK in the compound packet.
+  std::vector<uint16_t>& nack_sequence_numbers =
+      packet_information->nack_sequence_numbers;
+  const size_t first_new_packet_id = nack_sequence_numbers.size();
+  nack->AppendPacketIds(nack_sequence_numbers);
+  for (size_t i = first_new_packet_id; i < nack_sequence_numbers.size(); ++i)
+    nack_stats_.ReportRequest(nack_sequence_numbers[i]);
 
-  if (!nack.packet_ids().empty()) {
+  if (nack_sequence_numbers.size() > first_new_packet_id) {
     packet_information->packet_type_flags |= kRtcpNack;
     ++packet_type_counter_.nack_packets;
     packet_type_counter_.nack_requests = nack_stats_.requests();
@@ -1032,9 +1046,13 @@ bool RTCPReceiver::HandleFir(const CommonHeader& rtcp_block,
 void RTCPReceiver::HandleTransportFeedback(
     const CommonHeader& rtcp_block,
     PacketInformation* packet_information) {
-  std::unique_ptr<rtcp::TransportFeedback> transport_feedback(
-      new rtcp::TransportFeedback());
+  std::unique_ptr<rtcp::TransportFeedback> transport_feedback =
+      std::move(spare_transport_feedback_);
+  if (transport_feedback == nullptr) {
+    transport_feedback = std::make_unique<rtcp::TransportFeedback>();
+  }
   if (!transport_feedback->Parse(rtcp_block)) {
+    spare_transport_feedback_ = std::move(transport_feedback);
     ++num_skipped_packets_;
     // Application layer feedback message doesn't have a standard format.
     // Failing to parse it as transport feedback messages doesn't indicate an
@@ -1046,6 +1064,8 @@ void RTCPReceiver::HandleTransportFeedback(
       registered_ssrcs_.contains(media_source_ssrc)) {
     packet_information->packet_type_flags |= kRtcpTransportFeedback;
     packet_information->transport_feedback = std::move(transport_feedback);
+  } else {
+    spare_transport_feedback_ = std::move(transport_feedback);
   }
 }
 
@@ -13,6 +13,7 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -45,6 +46,7 @@ class ReportBlock;
 class Rrtr;
 class TargetBitrate;
 class TmmbItem;
+class TransportFeedback;
 }  // namespace rtcp
 
 class RTCPReceiver final {
@@ -416,6 +418,11 @@ class RTCPReceiver final {
 
   size_t num_skipped_packets_;
   Timestamp last_skipped_packets_warning_;
+
+  // Transport feedback handed back after the callbacks, and parsed into again
+  // to reuse its storage.
+  std::unique_ptr<rtcp::TransportFeedback> spare_transport_feedback_
+      RTC_GUARDED_BY(rtcp_receiver_lock_);
 };
 }  // namespace webrtc
 #endif  // MODULES_RTP_RTCP_SOURCE_RTCP_RECEIVER_H_
@@ -56,6 +56,9 @@ const uint32_t kRtcpAnyExtendedReports = kRtcpXrReceiverReferenceTime |
                                          kRtcpXrTargetBitrate;
 constexpr int32_t kDefaultVideoReportInterval = 1000;
 constexpr int32_t kDefaultAudioReportInterval = 5000;
+// Sizes of sender and receiver reports without report blocks.
+constexpr size_t kSenderReportHeaderLength = 28;
+constexpr size_t kReceiverReportHeaderLength = 8;
 }  // namespace
 
 // Helper to put several RTCP packets into lower layer datagram RTCP packet.
@@ -391,8 +394,18 @@ void RTCPSender::BuildSR(const RtcpContext& ctx, PacketSender& sender) {
   report.SetRtpTimestamp(rtp_timestamp);
   report.SetPacketCount(ctx.feedback_state_.packets_sent);
   report.SetOctetCount(ctx.feedback_state_.media_bytes_sent);
-  report.SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
+  std::vector<rtcp::ReportBlock> report_blocks =
+      CreateReportBlocks(ctx.feedback_state_,
+                         MaxReportBlocks(kSenderReportHeaderLength));
+  size_t num_blocks =
+      std::min<size_t>(report_blocks.size(), RTCP_MAX_REPORT_BLOCKS);
+  report.SetReportBlocks(std::vector<rtcp::ReportBlock>(
+      report_blocks.begin(), report_blocks.begin() + num_blocks));
   sender.AppendPacket(report);
+  AppendReceiverReports(
+      rtc::ArrayView<const rtcp::ReportBlock>(report_blocks)
+          .subview(num_blocks),
+      sender);
 }
 
 void RTCPSender::BuildSDES(const RtcpContext& ctx, PacketSender& sender) {
@@ -407,10 +420,35 @@ void RTCPSender::BuildSDES(const RtcpContext& ctx, PacketSender& sender) {
 void RTCPSender::BuildRR(const RtcpContext& ctx, PacketSender& sender) {
   rtcp::ReceiverReport report;
   report.SetSenderSsrc(ssrc_);
-  report.SetReportBlocks(CreateReportBlocks(ctx.feedback_state_));
+  std::vector<rtcp::ReportBlock> report_blocks =
+      CreateReportBlocks(ctx.feedback_state_,
+                         MaxReportBlocks(kReceiverReportHeaderLength));
+  size_t num_blocks =
+      std::min<size_t>(report_blocks.size(), RTCP_MAX_REPORT_BLOCKS);
+  report.SetReportBlocks(std::vector<rtcp::ReportBlock>(
+      report_blocks.begin(), report_blocks.begin() + num_blocks));
   if (method_ == RtcpMode::kCompound || !report.report_blocks().empty()) {
     sender.AppendPacket(report);
   }
+  AppendReceiverReports(
+      rtc::ArrayView<const rtcp::ReportBlock>(report_blocks)
+          .subview(num_blocks),
+      sender);
+}
+
+void RTCPSender::AppendReceiverReports(
+    rtc::ArrayView<const rtcp::ReportBlock> blocks,
+    PacketSender& sender) {
+  while (!blocks.empty()) {
+    size_t num_blocks =
+        std::min<size_t>(blocks.size(), RTCP_MAX_REPORT_BLOCKS);
+    rtcp::ReceiverReport report;
+    report.SetSenderSsrc(ssrc_);
+    report.SetReportBlocks(std::vector<rtcp::ReportBlock>(
+        blocks.begin(), blocks.begin() + num_blocks));
+    sender.AppendPacket(report);
+    blocks = blocks.subview(num_blocks);
+  }
 }
 
 void RTCPSender::BuildPLI(const RtcpContext& ctx, PacketSender& sender) {
@@ -758,13 +796,43 @@ void RTCPSender::PrepareReport(const FeedbackState& feedback_state) {
   }
 }
 
+size_t RTCPSender::MaxReportBlocks(size_t report_size) const {
+  // Leave room for the SDES, which compound packets always carry. Feedback
+  // messages that do not fit go in a following packet.
+  size_t reserved = report_size;
+  if (!cname_.empty()) {
+    rtcp::Sdes sdes;
+    sdes.AddCName(ssrc_, cname_);
+    reserved += sdes.BlockLength();
+  }
+  if (reserved >= max_packet_size_) {
+    return 0;
+  }
+  size_t available = max_packet_size_ - reserved;
+  size_t max_blocks = std::min<size_t>(
+      RTCP_MAX_REPORT_BLOCKS, available / rtcp::ReportBlock::kLength);
+  available -= max_blocks * rtcp::ReportBlock::kLength;
+  // Blocks beyond that go in additional receiver reports.
+  while (available >=
+         kReceiverReportHeaderLength + rtcp::ReportBlock::kLength) {
+    size_t num_blocks = std::min<size_t>(
+        RTCP_MAX_REPORT_BLOCKS, (available - kReceiverReportHeaderLength) /
+                                    rtcp::ReportBlock::kLength);
+    max_blocks += num_blocks;
+    available -=
+        kReceiverReportHeaderLength + num_blocks * rtcp::ReportBlock::kLength;
+  }
+  return max_blocks;
+}
+
 std::vector<rtcp::ReportBlock> RTCPSender::CreateReportBlocks(
-    const FeedbackState& feedback_state) {
+    const FeedbackState& feedback_state,
+    size_t max_report_blocks) {
   std::vector<rtcp::ReportBlock> result;
-  if (!receive_statistics_)
+  if (!receive_statistics_ || max_report_blocks == 0)
     return result;
 
-  result = receive_statistics_->RtcpReportBlocks(RTCP_MAX_REPORT_BLOCKS);
+  result = receive_statistics_->RtcpReportBlocks(max_report_blocks);
 
   if (!result.empty() && feedback_state.last_rr.Valid()) {
     // Get our NTP as late as possible to avoid a race.
@@ -19,6 +19,7 @@
 
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/call/transport.h"
 #include "api/units/data_rate.h"
 #include "api/units/time_delta.h"
@@ -200,8 +201,19 @@ class RTCPSender final {
   void PrepareReport(const FeedbackState& feedback_state)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_rtcp_sender_);
 
+  // Returns the number of report blocks that fit in one compound packet
+  // after a sender or receiver report of `report_size` bytes, counting the
+  // additional receiver reports needed to carry them.
+  size_t MaxReportBlocks(size_t report_size) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_rtcp_sender_);
   std::vector<rtcp::ReportBlock> CreateReportBlocks(
-      const FeedbackState& feedback_state)
+      const FeedbackState& feedback_state,
+      size_t max_report_blocks)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_rtcp_sender_);
+  // Appends receiver reports carrying the report blocks that did not fit in
+  // the leading sender or receiver report.
+  void AppendReceiverReports(rtc::ArrayView<const rtcp::ReportBlock> blocks,
+                             PacketSender& sender)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_rtcp_sender_);
 
   void BuildSR(const RtcpContext& context, PacketSender& sender)
@@ -299,6 +299,21 @@ TEST_F(RtcpSenderTest, SendRrWithTwoReportBlocks) {
           Property(&rtcp::ReportBlock::source_ssrc, Eq(kRemoteSsrc + 1))));
 }
 
+TEST_F(RtcpSenderTest, SendsReportBlocksBeyondOneReportInSameCompoundPacket) {
+  constexpr int kNumRemoteSsrcs = 40;
+  auto rtcp_sender = CreateRtcpSender(GetDefaultConfig());
+  for (int i = 0; i < kNumRemoteSsrcs; ++i) {
+    InsertIncomingPacket(kRemoteSsrc + i, 11111);
+  }
+  rtcp_sender->SetRTCPStatus(RtcpMode::kCompound);
+  EXPECT_EQ(0, rtcp_sender->SendRTCP(feedback_state(), kRtcpRr));
+  EXPECT_EQ(parser()->processed_rtcp_packets(), 1u);
+  EXPECT_EQ(parser()->receiver_report()->num_packets(), 2);
+  // The parser keeps the report blocks of the last receiver report.
+  EXPECT_THAT(parser()->receiver_report()->report_blocks(),
+              SizeIs(kNumRemoteSsrcs - 31));
+}
+
 TEST_F(RtcpSenderTest, SendSdes) {
   auto rtcp_sender = CreateRtcpSender(GetDefaultConfig());
   rtcp_sender->SetRTCPStatus(RtcpMode::kReducedSize);
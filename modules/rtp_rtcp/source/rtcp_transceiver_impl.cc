@@ -25,6 +25,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/packet_view.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/pli.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
@@ -198,15 +199,10 @@ void RtcpTransceiverImpl::ReceivePacket(rtc::ArrayView<const uint8_t> packet,
   // Report blocks may be spread across multiple sender and receiver reports.
   std::vector<ReportBlockData> report_blocks;
 
-  while (!packet.empty()) {
-    rtcp::CommonHeader rtcp_block;
-    if (!rtcp_block.Parse(packet.data(), packet.size()))
-      break;
-
+  rtcp::ForEachRtcpPacket(packet, [&](const rtcp::CommonHeader& rtcp_block) {
     HandleReceivedPacket(rtcp_block, now, report_blocks);
-
-    packet = packet.subview(rtcp_block.packet_size());
-  }
+    return true;
+  });
 
   if (!report_blocks.empty()) {
     ProcessReportBlocks(now, report_blocks);
@@ -325,18 +321,18 @@ void RtcpTransceiverImpl::HandleSenderReport(
     const rtcp::CommonHeader& rtcp_packet_header,
     Timestamp now,
     std::vector<ReportBlockData>& report_blocks) {
-  rtcp::SenderReport sender_report;
-  if (!sender_report.Parse(rtcp_packet_header))
+  absl::optional<rtcp::ReportView> sender_report =
+      rtcp::ReportView::Parse(rtcp_packet_header);
+  if (!sender_report)
     return;
   RemoteSenderState& remote_sender =
-      remote_senders_[sender_report.sender_ssrc()];
-  remote_sender.last_received_sender_report = {{now, sender_report.ntp()}};
-  HandleReportBlocks(sender_report.sender_ssrc(), now,
-                     sender_report.report_blocks(), report_blocks);
+      remote_senders_[sender_report->sender_ssrc()];
+  remote_sender.last_received_sender_report = {{now, sender_report->ntp()}};
+  HandleReportBlocks(*sender_report, now, report_blocks);
 
   for (MediaReceiverRtcpObserver* observer : remote_sender.observers) {
-    observer->OnSenderReport(sender_report.sender_ssrc(), sender_report.ntp(),
-                             sender_report.rtp_timestamp());
+    observer->OnSenderReport(sender_report->sender_ssrc(), sender_report->ntp(),
+                             sender_report->rtp_timestamp());
   }
 }
 
@@ -344,28 +340,29 @@ void RtcpTransceiverImpl::HandleReceiverReport(
     const rtcp::CommonHeader& rtcp_packet_header,
     Timestamp now,
     std::vector<ReportBlockData>& report_blocks) {
-  rtcp::ReceiverReport receiver_report;
-  if (!receiver_report.Parse(rtcp_packet_header)) {
+  absl::optional<rtcp::ReportView> receiver_report =
+      rtcp::ReportView::Parse(rtcp_packet_header);
+  if (!receiver_report) {
     return;
   }
-  HandleReportBlocks(receiver_report.sender_ssrc(), now,
-                     receiver_report.report_blocks(), report_blocks);
+  HandleReportBlocks(*receiver_report, now, report_blocks);
 }
 
 void RtcpTransceiverImpl::HandleReportBlocks(
-    uint32_t sender_ssrc,
+    const rtcp::ReportView& report,
     Timestamp now,
-    rtc::ArrayView<const rtcp::ReportBlock> rtcp_report_blocks,
     std::vector<ReportBlockData>& report_blocks) {
-  if (rtcp_report_blocks.empty()) {
+  if (report.num_report_blocks() == 0) {
     return;
   }
+  const uint32_t sender_ssrc = report.sender_ssrc();
   NtpTime now_ntp = config_.clock->ConvertTimestampToNtpTime(now);
   uint32_t receive_time_ntp = CompactNtp(now_ntp);
   Timestamp now_utc =
       Timestamp::Millis(now_ntp.ToMs() - rtc::kNtpJan1970Millisecs);
 
-  for (const rtcp::ReportBlock& block : rtcp_report_blocks) {
+  for (size_t i = 0; i < report.num_report_blocks(); ++i) {
+    const rtcp::ReportBlock block = report.report_block(i);
     absl::optional<TimeDelta> rtt;
     if (block.last_sr() != 0) {
       rtt = CompactNtpRttToTimeDelta(
@@ -469,13 +466,19 @@ void RtcpTransceiverImpl::HandleRtpFeedback(
 
 void RtcpTransceiverImpl::HandleNack(
     const rtcp::CommonHeader& rtcp_packet_header) {
-  rtcp::Nack nack;
-  if (local_senders_.empty() || !nack.Parse(rtcp_packet_header)) {
+  if (local_senders_.empty()) {
+    return;
+  }
+  absl::optional<rtcp::NackView> nack =
+      rtcp::NackView::Parse(rtcp_packet_header);
+  if (!nack) {
     return;
   }
-  auto it = local_senders_by_ssrc_.find(nack.media_ssrc());
+  auto it = local_senders_by_ssrc_.find(nack->media_ssrc());
   if (it != local_senders_by_ssrc_.end()) {
-    it->second->handler->OnNack(nack.sender_ssrc(), nack.packet_ids());
+    nack_packet_ids_.clear();
+    nack->AppendPacketIds(nack_packet_ids_);
+    it->second->handler->OnNack(nack->sender_ssrc(), nack_packet_ids_);
   }
 }
 
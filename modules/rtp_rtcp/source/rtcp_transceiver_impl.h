@@ -21,6 +21,7 @@
 #include "api/units/timestamp.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/dlrr.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/packet_view.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/remb.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/target_bitrate.h"
@@ -98,11 +99,9 @@ class RtcpTransceiverImpl {
   void HandleReceiverReport(const rtcp::CommonHeader& rtcp_packet_header,
                             Timestamp now,
                             std::vector<ReportBlockData>& report_blocks);
-  void HandleReportBlocks(
-      uint32_t sender_ssrc,
-      Timestamp now,
-      rtc::ArrayView<const rtcp::ReportBlock> rtcp_report_blocks,
-      std::vector<ReportBlockData>& report_blocks);
+  void HandleReportBlocks(const rtcp::ReportView& report,
+                          Timestamp now,
+                          std::vector<ReportBlockData>& report_blocks);
   void HandlePayloadSpecificFeedback(
       const rtcp::CommonHeader& rtcp_packet_header,
       Timestamp now);
@@ -162,6 +161,8 @@ class RtcpTransceiverImpl {
   flat_map<uint32_t, std::list<LocalSenderState>::iterator>
       local_senders_by_ssrc_;
   flat_map<uint32_t, RrtrTimes> received_rrtrs_;
+  // Reused to unpack received NACKs into, so that it keeps its capacity.
+  std::vector<uint16_t> nack_packet_ids_;
   RepeatingTaskHandle periodic_task_handle_;
 };
 
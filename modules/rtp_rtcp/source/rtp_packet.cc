@@ -67,6 +67,15 @@ RtpPacket::RtpPacket(const ExtensionManager* extensions, size_t capacity)
   Clear();
 }
 
+RtpPacket::RtpPacket(const ExtensionManager* extensions,
+                     rtc::CopyOnWriteBuffer buffer)
+    : extensions_(extensions ? *extensions : ExtensionManager()),
+      buffer_(std::move(buffer)) {
+  RTC_DCHECK_GE(buffer_.capacity(), kFixedHeaderSize);
+  buffer_.SetSize(buffer_.capacity());
+  Clear();
+}
+
 RtpPacket::RtpPacket(const RtpPacket&) = default;
 RtpPacket::RtpPacket(RtpPacket&&) = default;
 RtpPacket& RtpPacket::operator=(const RtpPacket&) = default;
@@ -75,6 +84,7 @@ RtpPacket::~RtpPacket() = default;
 
 void RtpPacket::IdentifyExtensions(ExtensionManager extensions) {
   extensions_ = std::move(extensions);
+  IndexExtensionEntries();
 }
 
 bool RtpPacket::Parse(const uint8_t* buffer, size_t buffer_size) {
@@ -122,8 +132,14 @@ void RtpPacket::CopyHeaderFrom(const RtpPacket& packet) {
   payload_offset_ = packet.payload_offset_;
   extensions_ = packet.extensions_;
   extension_entries_ = packet.extension_entries_;
+  memcpy(extension_entry_by_type_, packet.extension_entry_by_type_,
+         sizeof(extension_entry_by_type_));
   extensions_size_ = packet.extensions_size_;
-  buffer_ = packet.buffer_.Slice(0, packet.headers_size());
+  if (buffer_.capacity() >= packet.buffer_.capacity()) {
+    buffer_.SetData(packet.data(), packet.headers_size());
+  } else {
+    buffer_ = packet.buffer_.Slice(0, packet.headers_size());
+  }
   // Reset payload and padding.
   payload_size_ = 0;
   padding_size_ = 0;
@@ -328,6 +344,11 @@ rtc::ArrayView<uint8_t> RtpPacket::AllocateRawExtension(int id, size_t length) {
   const uint8_t extension_info_length = rtc::dchecked_cast<uint8_t>(length);
   extension_entries_.emplace_back(id, extension_info_length,
                                   extension_info_offset);
+  RTPExtensionType type = extensions_.GetType(id);
+  if (type != ExtensionManager::kInvalidType) {
+    extension_entry_by_type_[type] =
+        rtc::dchecked_cast<uint8_t>(extension_entries_.size());
+  }
 
   extensions_size_ = new_extensions_size;
 
@@ -436,6 +457,7 @@ void RtpPacket::Clear() {
   padding_size_ = 0;
   extensions_size_ = 0;
   extension_entries_.clear();
+  memset(extension_entry_by_type_, 0, sizeof(extension_entry_by_type_));
 
   memset(WriteAt(0), 0, kFixedHeaderSize);
   buffer_.SetSize(kFixedHeaderSize);
@@ -543,6 +565,7 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
     }
     payload_offset_ = extension_offset + extensions_capacity;
   }
+  IndexExtensionEntries();
 
   if (has_padding && payload_offset_ < size) {
     padding_size_ = buffer[size - 1];
@@ -580,19 +603,36 @@ RtpPacket::ExtensionInfo& RtpPacket::FindOrCreateExtensionInfo(int id) {
   return extension_entries_.back();
 }
 
+void RtpPacket::IndexExtensionEntries() {
+  memset(extension_entry_by_type_, 0, sizeof(extension_entry_by_type_));
+  if (extension_entries_.empty()) {
+    return;
+  }
+  uint8_t entry_by_id[RtpExtension::kMaxId + 1] = {};
+  for (size_t i = 0; i < extension_entries_.size(); ++i) {
+    entry_by_id[extension_entries_[i].id] = rtc::dchecked_cast<uint8_t>(i + 1);
+  }
+  for (int type = kRtpExtensionNone + 1; type < kRtpExtensionNumberOfExtensions;
+       ++type) {
+    uint8_t id = extensions_.GetId(static_cast<RTPExtensionType>(type));
+    if (id != ExtensionManager::kInvalidId) {
+      extension_entry_by_type_[type] = entry_by_id[id];
+    }
+  }
+}
+
 rtc::ArrayView<const uint8_t> RtpPacket::FindExtension(
     ExtensionType type) const {
-  uint8_t id = extensions_.GetId(type);
-  if (id == ExtensionManager::kInvalidId) {
-    // Extension not registered.
-    return nullptr;
-  }
-  ExtensionInfo const* extension_info = FindExtensionInfo(id);
-  if (extension_info == nullptr) {
+  RTC_DCHECK_GT(type, kRtpExtensionNone);
+  RTC_DCHECK_LT(type, kRtpExtensionNumberOfExtensions);
+  uint8_t entry = extension_entry_by_type_[type];
+  if (entry == 0) {
+    // Extension not registered or not present.
     return nullptr;
   }
-  return rtc::MakeArrayView(data() + extension_info->offset,
-                            extension_info->length);
+  const ExtensionInfo& extension_info = extension_entries_[entry - 1];
+  return rtc::MakeArrayView(data() + extension_info.offset,
+                            extension_info.length);
 }
 
 rtc::ArrayView<uint8_t> RtpPacket::AllocateExtension(ExtensionType type,
@@ -617,12 +657,9 @@ rtc::ArrayView<uint8_t> RtpPacket::AllocateExtension(ExtensionType type,
 }
 
 bool RtpPacket::HasExtension(ExtensionType type) const {
-  uint8_t id = extensions_.GetId(type);
-  if (id == ExtensionManager::kInvalidId) {
-    // Extension not registered.
-    return false;
-  }
-  return FindExtensionInfo(id) != nullptr;
+  RTC_DCHECK_GT(type, kRtpExtensionNone);
+  RTC_DCHECK_LT(type, kRtpExtensionNumberOfExtensions);
+  return extension_entry_by_type_[type] != 0;
 }
 
 bool RtpPacket::RemoveExtension(ExtensionType type) {
@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
@@ -35,6 +36,10 @@ class RtpPacket {
   RtpPacket();
   explicit RtpPacket(const ExtensionManager* extensions);
   RtpPacket(const ExtensionManager* extensions, size_t capacity);
+  // Writes the packet to the storage of `buffer`, e.g. to use storage from a
+  // `rtc::CopyOnWriteBufferPool`. The capacity of `buffer` limits the packet
+  // size, as with the `capacity` above.
+  RtpPacket(const ExtensionManager* extensions, rtc::CopyOnWriteBuffer buffer);
 
   RtpPacket(const RtpPacket&);
   RtpPacket(RtpPacket&&);
@@ -94,6 +99,10 @@ class RtpPacket {
   void Clear();
 
   // Header setters.
+  // Copies the header of `packet`, payload and padding are not copied. The
+  // header is written to the storage of this packet if that has room for
+  // whatever `packet` has room for, otherwise the storage of `packet` is
+  // shared until either packet is written to.
   void CopyHeaderFrom(const RtpPacket& packet);
   void SetMarker(bool marker_bit);
   void SetPayloadType(uint8_t payload_type);
@@ -188,6 +197,9 @@ class RtpPacket {
   // with the specified id if not found.
   ExtensionInfo& FindOrCreateExtensionInfo(int id);
 
+  // Rebuilds `extension_entry_by_type_` from `extension_entries_`.
+  void IndexExtensionEntries();
+
   // Allocates and returns place to store rtp header extension.
   // Returns empty arrayview on failure.
   rtc::ArrayView<uint8_t> AllocateRawExtension(int id, size_t length);
@@ -215,7 +227,13 @@ class RtpPacket {
   size_t payload_size_;
 
   ExtensionManager extensions_;
-  std::vector<ExtensionInfo> extension_entries_;
+  // Packets rarely carry more extensions than this, so building one does not
+  // allocate for them.
+  absl::InlinedVector<ExtensionInfo, 8> extension_entries_;
+  // For each extension type, one plus the index of its entry in
+  // `extension_entries_`, or 0 if the extension is not registered or not in
+  // the packet. Lets GetExtension() find an extension with a single lookup.
+  uint8_t extension_entry_by_type_[kRtpExtensionNumberOfExtensions] = {};
   size_t extensions_size_ = 0;  // Unaligned.
   rtc::CopyOnWriteBuffer buffer_;
 };
@@ -10,6 +10,8 @@
 
 #include "modules/rtp_rtcp/source/rtp_packet_history.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <cstdint>
 #include <limits>
@@ -28,6 +30,20 @@ namespace {
 
 constexpr size_t kOldPayloadPaddingSizeHysteresis = 100;
 constexpr uint16_t kMaxOldPayloadPaddingSequenceNumber = 1 << 13;
+// Smallest ring buffer allocated for the history.
+constexpr size_t kMinRingCapacity = 16;
+// A grown ring buffer is shrunk once no more than this fraction of it is used.
+// The smaller buffer leaves room for twice the packets still stored, so a
+// history hovering around a power of two doesn't reallocate back and forth.
+constexpr size_t kRingShrinkDivisor = 4;
+
+size_t RingCapacityFor(size_t num_packets) {
+  size_t capacity = kMinRingCapacity;
+  while (capacity < num_packets) {
+    capacity *= 2;
+  }
+  return capacity;
+}
 
 }  // namespace
 
@@ -76,11 +92,20 @@ bool RtpPacketHistory::MoreUseful::operator()(StoredPacket* lhs,
 }
 
 RtpPacketHistory::RtpPacketHistory(Clock* clock, PaddingMode padding_mode)
+    : RtpPacketHistory(clock, padding_mode, /*shared_payloads=*/nullptr) {}
+
+RtpPacketHistory::RtpPacketHistory(
+    Clock* clock,
+    PaddingMode padding_mode,
+    rtc::scoped_refptr<SharedRtpPayloadStore> shared_payloads)
     : clock_(clock),
       padding_mode_(padding_mode),
+      shared_payloads_(std::move(shared_payloads)),
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
       rtt_(TimeDelta::MinusInfinity()),
+      first_index_(0),
+      num_packets_(0),
       packets_inserted_(0) {}
 
 RtpPacketHistory::~RtpPacketHistory() {}
@@ -95,6 +120,12 @@ void RtpPacketHistory::SetStorePacketsStatus(StorageMode mode,
   Reset();
   mode_ = mode;
   number_to_store_ = std::min(kMaxCapacity, number_to_store);
+  if (mode_ == StorageMode::kDisabled) {
+    std::vector<StoredPacket>().swap(packet_history_);
+  } else {
+    packet_history_ =
+        std::vector<StoredPacket>(RingCapacityFor(number_to_store_));
+  }
 }
 
 RtpPacketHistory::StorageMode RtpPacketHistory::GetStorageMode() const {
@@ -128,9 +159,8 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   // Store packet.
   const uint16_t rtp_seq_no = packet->SequenceNumber();
   int packet_index = GetPacketIndex(rtp_seq_no);
-  if (packet_index >= 0 &&
-      static_cast<size_t>(packet_index) < packet_history_.size() &&
-      packet_history_[packet_index].packet_ != nullptr) {
+  if (packet_index >= 0 && static_cast<size_t>(packet_index) < num_packets_ &&
+      PacketAt(packet_index).packet_ != nullptr) {
     RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
     // Remove previous packet to avoid inconsistent state.
     RemovePacket(packet_index);
@@ -138,17 +168,24 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   }
 
   // Packet to be inserted ahead of first packet, expand front.
-  for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front();
+  if (packet_index < 0) {
+    size_t extra_packets = -packet_index;
+    EnsureCapacity(num_packets_ + extra_packets);
+    first_index_ =
+        (first_index_ - extra_packets) & (packet_history_.size() - 1);
+    num_packets_ += extra_packets;
+    packet_index = 0;
   }
   // Packet to be inserted behind last packet, expand back.
-  while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back();
+  if (static_cast<size_t>(packet_index) >= num_packets_) {
+    EnsureCapacity(packet_index + 1);
+    num_packets_ = packet_index + 1;
   }
 
   RTC_DCHECK_GE(packet_index, 0);
-  RTC_DCHECK_LT(packet_index, packet_history_.size());
-  RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
+  RTC_DCHECK_LT(packet_index, num_packets_);
+  StoredPacket& stored_packet = PacketAt(packet_index);
+  RTC_DCHECK(stored_packet.packet_ == nullptr);
 
   if (padding_mode_ == PaddingMode::kRecentLargePacket) {
     if ((!large_payload_packet_ ||
@@ -161,14 +198,28 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
     }
   }
 
-  packet_history_[packet_index] =
+  SharedRtpPayloadStore::Payload shared_payload;
+  if (shared_payloads_ && packet->payload_size() > 0 &&
+      packet->padding_size() == 0) {
+    // Keep a copy of just the header, the metadata and extension map come
+    // along with the packet.
+    auto header = std::make_unique<RtpPacketToSend>(*packet);
+    if (header->Parse(
+            rtc::CopyOnWriteBuffer(packet->data(), packet->headers_size()))) {
+      shared_payload = shared_payloads_->Add(packet->payload());
+      packet = std::move(header);
+    }
+  }
+
+  stored_packet =
       StoredPacket(std::move(packet), send_time, packets_inserted_++);
+  stored_packet.shared_payload_ = std::move(shared_payload);
 
   if (padding_priority_enabled()) {
     if (padding_priority_.size() >= kMaxPaddingHistory - 1) {
       padding_priority_.erase(std::prev(padding_priority_.end()));
     }
-    auto prio_it = padding_priority_.insert(&packet_history_[packet_index]);
+    auto prio_it = padding_priority_.insert(&stored_packet);
     RTC_DCHECK(prio_it.second) << "Failed to insert packet into prio set.";
   }
 }
@@ -207,7 +258,7 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndMarkAsPending(
 
   // Copy and/or encapsulate packet.
   std::unique_ptr<RtpPacketToSend> encapsulated_packet =
-      encapsulate(*packet->packet_);
+      EncapsulatePacket(*packet, encapsulate);
   if (encapsulated_packet) {
     packet->pending_transmission_ = true;
   }
@@ -241,11 +292,10 @@ bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
   }
 
   int packet_index = GetPacketIndex(sequence_number);
-  if (packet_index < 0 ||
-      static_cast<size_t>(packet_index) >= packet_history_.size()) {
+  if (packet_index < 0 || static_cast<size_t>(packet_index) >= num_packets_) {
     return false;
   }
-  const StoredPacket& packet = packet_history_[packet_index];
+  const StoredPacket& packet = PacketAt(packet_index);
   if (packet.packet_ == nullptr) {
     return false;
   }
@@ -293,12 +343,11 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
   if (padding_priority_enabled() && !padding_priority_.empty()) {
     auto best_packet_it = padding_priority_.begin();
     best_packet = *best_packet_it;
-  } else if (!padding_priority_enabled() && !packet_history_.empty()) {
+  } else if (!padding_priority_enabled()) {
     // Prioritization not available, pick the last packet.
-    for (auto it = packet_history_.rbegin(); it != packet_history_.rend();
-         ++it) {
-      if (it->packet_ != nullptr) {
-        best_packet = &(*it);
+    for (size_t i = num_packets_; i > 0; --i) {
+      if (PacketAt(i - 1).packet_ != nullptr) {
+        best_packet = &PacketAt(i - 1);
         break;
       }
     }
@@ -316,7 +365,7 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
     return nullptr;
   }
 
-  auto padding_packet = encapsulate(*best_packet->packet_);
+  auto padding_packet = EncapsulatePacket(*best_packet, encapsulate);
   if (!padding_packet) {
     return nullptr;
   }
@@ -333,8 +382,7 @@ void RtpPacketHistory::CullAcknowledgedPackets(
   MutexLock lock(&lock_);
   for (uint16_t sequence_number : sequence_numbers) {
     int packet_index = GetPacketIndex(sequence_number);
-    if (packet_index < 0 ||
-        static_cast<size_t>(packet_index) >= packet_history_.size()) {
+    if (packet_index < 0 || static_cast<size_t>(packet_index) >= num_packets_) {
       continue;
     }
     RemovePacket(packet_index);
@@ -344,10 +392,20 @@ void RtpPacketHistory::CullAcknowledgedPackets(
 void RtpPacketHistory::Clear() {
   MutexLock lock(&lock_);
   Reset();
+  MaybeShrink();
+}
+
+size_t RtpPacketHistory::CapacityForTesting() const {
+  MutexLock lock(&lock_);
+  return packet_history_.size();
 }
 
 void RtpPacketHistory::Reset() {
-  packet_history_.clear();
+  for (size_t i = 0; i < num_packets_; ++i) {
+    PacketAt(i) = StoredPacket();
+  }
+  first_index_ = 0;
+  num_packets_ = 0;
   padding_priority_.clear();
   large_payload_packet_ = absl::nullopt;
 }
@@ -358,26 +416,26 @@ void RtpPacketHistory::CullOldPackets() {
       rtt_.IsFinite()
           ? std::max(kMinPacketDurationRtt * rtt_, kMinPacketDuration)
           : kMinPacketDuration;
-  while (!packet_history_.empty()) {
-    if (packet_history_.size() >= kMaxCapacity) {
+  while (num_packets_ > 0) {
+    if (num_packets_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
       RemovePacket(0);
       continue;
     }
 
-    const StoredPacket& stored_packet = packet_history_.front();
+    const StoredPacket& stored_packet = PacketAt(0);
     if (stored_packet.pending_transmission_) {
       // Don't remove packets in the pacer queue, pending tranmission.
-      return;
+      break;
     }
 
     if (stored_packet.send_time() + packet_duration > now) {
       // Don't cull packets too early to avoid failed retransmission requests.
-      return;
+      break;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (num_packets_ >= number_to_store_ ||
         stored_packet.send_time() +
                 (packet_duration * kPacketCullingDelayFactor) <=
             now) {
@@ -386,26 +444,30 @@ void RtpPacketHistory::CullOldPackets() {
       RemovePacket(0);
     } else {
       // No more packets can be removed right now.
-      return;
+      break;
     }
   }
+  MaybeShrink();
 }
 
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
     int packet_index) {
+  StoredPacket& stored_packet = PacketAt(packet_index);
   // Move the packet out from the StoredPacket container.
   std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_history_[packet_index].packet_);
+      std::move(stored_packet.packet_);
+  stored_packet.shared_payload_ = SharedRtpPayloadStore::Payload();
 
   // Erase from padding priority set, if eligible.
   if (padding_mode_ == PaddingMode::kPriority) {
-    padding_priority_.erase(&packet_history_[packet_index]);
+    padding_priority_.erase(&stored_packet);
   }
 
   if (packet_index == 0) {
-    while (!packet_history_.empty() &&
-           packet_history_.front().packet_ == nullptr) {
-      packet_history_.pop_front();
+    while (num_packets_ > 0 && PacketAt(0).packet_ == nullptr) {
+      PacketAt(0) = StoredPacket();
+      first_index_ = (first_index_ + 1) & (packet_history_.size() - 1);
+      --num_packets_;
     }
   }
 
@@ -413,12 +475,12 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
 }
 
 int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
-  if (packet_history_.empty()) {
+  if (num_packets_ == 0) {
     return 0;
   }
 
-  RTC_DCHECK(packet_history_.front().packet_ != nullptr);
-  int first_seq = packet_history_.front().packet_->SequenceNumber();
+  RTC_DCHECK(PacketAt(0).packet_ != nullptr);
+  int first_seq = PacketAt(0).packet_->SequenceNumber();
   if (first_seq == sequence_number) {
     return 0;
   }
@@ -442,15 +504,82 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
 RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
     uint16_t sequence_number) {
   int index = GetPacketIndex(sequence_number);
-  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size() ||
-      packet_history_[index].packet_ == nullptr) {
+  if (index < 0 || static_cast<size_t>(index) >= num_packets_ ||
+      PacketAt(index).packet_ == nullptr) {
     return nullptr;
   }
-  return &packet_history_[index];
+  return &PacketAt(index);
+}
+
+RtpPacketHistory::StoredPacket& RtpPacketHistory::PacketAt(
+    size_t packet_index) {
+  RTC_DCHECK_LT(packet_index, num_packets_);
+  return packet_history_[(first_index_ + packet_index) &
+                         (packet_history_.size() - 1)];
+}
+
+const RtpPacketHistory::StoredPacket& RtpPacketHistory::PacketAt(
+    size_t packet_index) const {
+  RTC_DCHECK_LT(packet_index, num_packets_);
+  return packet_history_[(first_index_ + packet_index) &
+                         (packet_history_.size() - 1)];
+}
+
+void RtpPacketHistory::EnsureCapacity(size_t num_packets) {
+  if (num_packets <= packet_history_.size()) {
+    return;
+  }
+  // Only happens when packets are kept past `number_to_store_`, e.g. while
+  // pending in the pacer, or on large sequence number jumps.
+  Reallocate(RingCapacityFor(num_packets));
+}
+
+void RtpPacketHistory::MaybeShrink() {
+  const size_t capacity = packet_history_.size();
+  if (capacity <= RingCapacityFor(number_to_store_) ||
+      num_packets_ > capacity / kRingShrinkDivisor) {
+    return;
+  }
+  Reallocate(RingCapacityFor(std::max(number_to_store_, 2 * num_packets_)));
+}
+
+void RtpPacketHistory::Reallocate(size_t capacity) {
+  RTC_DCHECK_GE(capacity, num_packets_);
+  std::vector<StoredPacket> packet_history(capacity);
+  // Entry addresses change, so the padding priority set must be rebuilt.
+  std::vector<size_t> prioritized_indices;
+  for (StoredPacket* packet : padding_priority_) {
+    size_t slot = packet - packet_history_.data();
+    prioritized_indices.push_back((slot - first_index_) &
+                                  (packet_history_.size() - 1));
+  }
+  for (size_t i = 0; i < num_packets_; ++i) {
+    packet_history[i] = std::move(PacketAt(i));
+  }
+  packet_history_.swap(packet_history);
+  first_index_ = 0;
+  padding_priority_.clear();
+  for (size_t index : prioritized_indices) {
+    padding_priority_.insert(&packet_history_[index]);
+  }
 }
 
 bool RtpPacketHistory::padding_priority_enabled() const {
   return padding_mode_ == PaddingMode::kPriority;
 }
 
+std::unique_ptr<RtpPacketToSend> RtpPacketHistory::EncapsulatePacket(
+    const StoredPacket& packet,
+    rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
+        encapsulate) const {
+  if (!packet.shared_payload_) {
+    return encapsulate(*packet.packet_);
+  }
+  const rtc::CopyOnWriteBuffer& payload = packet.shared_payload_.data();
+  RtpPacketToSend full_packet(*packet.packet_);
+  memcpy(full_packet.AllocatePayload(payload.size()), payload.cdata(),
+         payload.size());
+  return encapsulate(full_packet);
+}
+
 }  // namespace webrtc
@@ -11,7 +11,6 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <deque>
 #include <map>
 #include <memory>
 #include <set>
@@ -20,10 +19,12 @@
 
 #include "absl/types/optional.h"
 #include "api/function_view.h"
+#include "api/scoped_refptr.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/shared_rtp_payload_store.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -64,6 +65,12 @@ class RtpPacketHistory {
                          enable_padding_prio ? PaddingMode::kPriority
                                              : PaddingMode::kDefault) {}
   RtpPacketHistory(Clock* clock, PaddingMode padding_mode);
+  // If `shared_payloads` is set, payloads are kept in that store and only the
+  // RTP header and packet metadata is kept per history, so histories of
+  // streams forwarding the same media store each payload once.
+  RtpPacketHistory(Clock* clock,
+                   PaddingMode padding_mode,
+                   rtc::scoped_refptr<SharedRtpPayloadStore> shared_payloads);
 
   RtpPacketHistory() = delete;
   RtpPacketHistory(const RtpPacketHistory&) = delete;
@@ -126,9 +133,12 @@ class RtpPacketHistory {
   void CullAcknowledgedPackets(rtc::ArrayView<const uint16_t> sequence_numbers);
 
   // Remove all pending packets from the history, but keep storage mode and
-  // capacity.
+  // capacity. Storage grown past what the capacity needs is released.
   void Clear();
 
+  // Number of packets the history can hold without growing its storage.
+  size_t CapacityForTesting() const;
+
  private:
   struct MoreUseful;
   class StoredPacket;
@@ -152,8 +162,9 @@ class RtpPacketHistory {
     Timestamp send_time() const { return send_time_; }
     void set_send_time(Timestamp value) { send_time_ = value; }
 
-    // The actual packet.
+    // The actual packet. Only holds the header if the payload is shared.
     std::unique_ptr<RtpPacketToSend> packet_;
+    SharedRtpPayloadStore::Payload shared_payload_;
 
     // True if the packet is currently in the pacer queue pending transmission.
     bool pending_transmission_;
@@ -174,6 +185,12 @@ class RtpPacketHistory {
 
   bool padding_priority_enabled() const;
 
+  // Calls `encapsulate` with the complete packet, restoring a shared payload.
+  std::unique_ptr<RtpPacketToSend> EncapsulatePacket(
+      const StoredPacket& packet,
+      rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(
+          const RtpPacketToSend&)> encapsulate) const;
+
   // Helper method to check if packet has too recently been sent.
   bool VerifyRtt(const StoredPacket& packet) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
@@ -187,21 +204,42 @@ class RtpPacketHistory {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   StoredPacket* GetStoredPacket(uint16_t sequence_number)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the packet `packet_index` places after the first one.
+  StoredPacket& PacketAt(size_t packet_index)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  const StoredPacket& PacketAt(size_t packet_index) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Grows the ring buffer, if needed, to hold `num_packets` packets.
+  void EnsureCapacity(size_t num_packets) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Shrinks a ring buffer grown past the size needed for `number_to_store_`
+  // once few enough packets are left in it.
+  void MaybeShrink() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Moves the stored packets to a ring buffer of `capacity` slots.
+  void Reallocate(size_t capacity) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   Clock* const clock_;
   const PaddingMode padding_mode_;
+  const rtc::scoped_refptr<SharedRtpPayloadStore> shared_payloads_;
   mutable Mutex lock_;
   size_t number_to_store_ RTC_GUARDED_BY(lock_);
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   TimeDelta rtt_ RTC_GUARDED_BY(lock_);
 
-  // Queue of stored packets, ordered by sequence number, with older packets in
-  // the front and new packets being added to the back. Note that there may be
-  // wrap-arounds so the back may have a lower sequence number.
+  // Ring buffer of stored packets, ordered by sequence number, with older
+  // packets in the front and new packets being added to the back. Note that
+  // there may be wrap-arounds so the back may have a lower sequence number.
   // Packets may also be removed out-of-order, in which case there will be
   // instances of StoredPacket with `packet_` set to nullptr. The first and last
-  // entry in the queue will however always be populated.
-  std::deque<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // entry in the history will however always be populated.
+  // The capacity is a power of two, sized for `number_to_store_` and only
+  // grown when packets can't be culled yet, so entries don't move and the
+  // history needs no allocation per packet. A grown buffer is shrunk back
+  // when it is at most a quarter full, or by Clear().
+  std::vector<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // Slot of the first packet in `packet_history_`.
+  size_t first_index_ RTC_GUARDED_BY(lock_);
+  // Number of entries from the first to the last packet, inclusive.
+  size_t num_packets_ RTC_GUARDED_BY(lock_);
 
   // Total number of packets with inserted.
   uint64_t packets_inserted_ RTC_GUARDED_BY(lock_);
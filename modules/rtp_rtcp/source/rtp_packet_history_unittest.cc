@@ -10,15 +10,19 @@
 
 #include "modules/rtp_rtcp/source/rtp_packet_history.h"
 
+#include <string.h>
+
 #include <cstdint>
 #include <limits>
 #include <memory>
 #include <utility>
 
+#include "api/make_ref_counted.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/shared_rtp_payload_store.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -36,6 +40,7 @@ uint16_t To16u(size_t sequence_number) {
 using StorageMode = RtpPacketHistory::StorageMode;
 
 using ::testing::AllOf;
+using ::testing::ElementsAreArray;
 using ::testing::Pointee;
 using ::testing::Property;
 
@@ -651,6 +656,74 @@ TEST_P(RtpPacketHistoryTest, OutOfOrderInsertRemoval) {
   }
 }
 
+TEST_P(RtpPacketHistoryTest, KeepsPendingPacketsBeyondNumberToStore) {
+  // Packets pending in the pacer can't be culled, so the history has to grow
+  // past the requested size while keeping all packets reachable.
+  const size_t kHistorySize = 10;
+  const size_t kNumPackets = 100;
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, kHistorySize);
+  hist_.SetRtt(TimeDelta::Millis(1));
+
+  // Insert the first packet last, so that the front needs to be expanded too.
+  for (size_t i = 1; i < kNumPackets; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       fake_clock_.CurrentTime());
+  }
+  hist_.PutRtpPacket(CreateRtpPacket(kStartSeqNum), fake_clock_.CurrentTime());
+  fake_clock_.AdvanceTimeMilliseconds(1);
+
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + i)));
+  }
+  std::unique_ptr<RtpPacketToSend> padding = hist_.GetPayloadPaddingPacket();
+  ASSERT_TRUE(padding);
+  if (GetParam() == RtpPacketHistory::PaddingMode::kPriority) {
+    // The packet inserted last is the most useful one.
+    EXPECT_EQ(padding->SequenceNumber(), kStartSeqNum);
+  } else if (GetParam() == RtpPacketHistory::PaddingMode::kDefault) {
+    EXPECT_EQ(padding->SequenceNumber(),
+              To16u(kStartSeqNum + kNumPackets - 1));
+  }
+}
+
+TEST_P(RtpPacketHistoryTest, ShrinksGrownStorageOnceOldPacketsAreCulled) {
+  const size_t kHistorySize = 10;
+  const size_t kNumPackets = 100;
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, kHistorySize);
+  const size_t initial_capacity = hist_.CapacityForTesting();
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       fake_clock_.CurrentTime());
+  }
+  EXPECT_GE(hist_.CapacityForTesting(), kNumPackets);
+
+  // Once the packets have timed out, storing a new one culls them all.
+  fake_clock_.AdvanceTime(RtpPacketHistory::kPacketCullingDelayFactor *
+                          RtpPacketHistory::kMinPacketDuration);
+  const uint16_t kSeqNum = To16u(kStartSeqNum + kNumPackets);
+  hist_.PutRtpPacket(CreateRtpPacket(kSeqNum), fake_clock_.CurrentTime());
+  EXPECT_EQ(hist_.CapacityForTesting(), initial_capacity);
+  EXPECT_FALSE(hist_.GetPacketState(kStartSeqNum));
+  EXPECT_TRUE(hist_.GetPacketState(kSeqNum));
+  EXPECT_TRUE(hist_.GetPayloadPaddingPacket());
+}
+
+TEST_P(RtpPacketHistoryTest, ClearReleasesGrownStorage) {
+  const size_t kHistorySize = 10;
+  const size_t kNumPackets = 100;
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, kHistorySize);
+  const size_t initial_capacity = hist_.CapacityForTesting();
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       fake_clock_.CurrentTime());
+  }
+  EXPECT_GE(hist_.CapacityForTesting(), kNumPackets);
+
+  hist_.Clear();
+  EXPECT_EQ(hist_.CapacityForTesting(), initial_capacity);
+  EXPECT_EQ(hist_.GetStorageMode(), StorageMode::kStoreAndCull);
+}
+
 TEST_P(RtpPacketHistoryTest, UsesLastPacketAsPaddingWithPrioOff) {
   if (GetParam() != RtpPacketHistory::PaddingMode::kDefault) {
     GTEST_SKIP() << "Default padding prioritization required for this test";
@@ -700,6 +773,47 @@ INSTANTIATE_TEST_SUITE_P(
                       RtpPacketHistory::PaddingMode::kPriority,
                       RtpPacketHistory::PaddingMode::kRecentLargePacket));
 
+TEST(RtpPacketHistorySharedPayloads, StoresForwardedPayloadsOnce) {
+  SimulatedClock clock(123456);
+  auto store = rtc::make_ref_counted<SharedRtpPayloadStore>();
+  RtpPacketHistory history1(&clock, RtpPacketHistory::PaddingMode::kPriority,
+                            store);
+  RtpPacketHistory history2(&clock, RtpPacketHistory::PaddingMode::kPriority,
+                            store);
+  history1.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  history2.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+
+  // The same packet forwarded to two receivers, with rewritten headers.
+  constexpr uint8_t kPayload[] = {1, 2, 3, 4, 5, 6, 7, 8};
+  std::unique_ptr<RtpPacketToSend> packet1 = CreatePacket(kStartSeqNum);
+  packet1->SetSsrc(1111);
+  memcpy(packet1->SetPayloadSize(sizeof(kPayload)), kPayload,
+         sizeof(kPayload));
+  std::unique_ptr<RtpPacketToSend> packet2 =
+      std::make_unique<RtpPacketToSend>(*packet1);
+  packet2->SetSsrc(2222);
+  packet2->SetSequenceNumber(17);
+  history1.PutRtpPacket(std::move(packet1), clock.CurrentTime());
+  history2.PutRtpPacket(std::move(packet2), clock.CurrentTime());
+  EXPECT_EQ(store->size(), 1u);
+
+  std::unique_ptr<RtpPacketToSend> retransmission1 =
+      history1.GetPacketAndMarkAsPending(kStartSeqNum);
+  ASSERT_TRUE(retransmission1);
+  EXPECT_EQ(retransmission1->Ssrc(), 1111u);
+  EXPECT_THAT(retransmission1->payload(), ElementsAreArray(kPayload));
+  std::unique_ptr<RtpPacketToSend> retransmission2 =
+      history2.GetPacketAndMarkAsPending(17);
+  ASSERT_TRUE(retransmission2);
+  EXPECT_EQ(retransmission2->Ssrc(), 2222u);
+  EXPECT_THAT(retransmission2->payload(), ElementsAreArray(kPayload));
+
+  history1.CullAcknowledgedPackets(std::vector<uint16_t>{kStartSeqNum});
+  EXPECT_EQ(store->size(), 1u);
+  history2.Clear();
+  EXPECT_EQ(store->size(), 0u);
+}
+
 TEST(RtpPacketHistoryRecentLargePacketMode,
      GetPayloadPaddingPacketAfterCullWithAcksReturnOldPacket) {
   SimulatedClock fake_clock(1234);
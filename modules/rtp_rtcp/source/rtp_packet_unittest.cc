@@ -813,6 +813,54 @@ TEST(RtpPacketTest, ParseWithExtensionDelayed) {
   EXPECT_EQ(0u, packet.padding_size());
 }
 
+TEST(RtpPacketTest, CopyHeaderFromKeepsExtensions) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  extensions.Register<AudioLevel>(kAudioLevelExtensionId);
+  RtpPacketReceived packet(&extensions);
+  EXPECT_TRUE(packet.Parse(kPacketWithTOAndAL, sizeof(kPacketWithTOAndAL)));
+
+  RtpPacket copy;
+  copy.CopyHeaderFrom(packet);
+  int32_t time_offset;
+  EXPECT_TRUE(copy.GetExtension<TransmissionOffset>(&time_offset));
+  EXPECT_EQ(kTimeOffset, time_offset);
+  EXPECT_TRUE(copy.HasExtension<AudioLevel>());
+
+  // Re-identifying the extensions must drop lookups for unregistered types.
+  RtpPacketToSend::ExtensionManager audio_level_only;
+  audio_level_only.Register<AudioLevel>(kAudioLevelExtensionId);
+  copy.IdentifyExtensions(audio_level_only);
+  EXPECT_FALSE(copy.HasExtension<TransmissionOffset>());
+  EXPECT_TRUE(copy.HasExtension<AudioLevel>());
+}
+
+TEST(RtpPacketTest, CopyHeaderFromWritesToStorageWithRoomForThePacket) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  RtpPacket packet(&extensions, /*capacity=*/100);
+  packet.SetSsrc(kSsrc);
+  packet.SetExtension<TransmissionOffset>(kTimeOffset);
+
+  RtpPacket copy(/*extensions=*/nullptr, /*capacity=*/200);
+  const uint8_t* storage = copy.data();
+  copy.CopyHeaderFrom(packet);
+  EXPECT_EQ(copy.data(), storage);
+  EXPECT_EQ(copy.Ssrc(), kSsrc);
+  int32_t time_offset;
+  EXPECT_TRUE(copy.GetExtension<TransmissionOffset>(&time_offset));
+  EXPECT_EQ(time_offset, kTimeOffset);
+  EXPECT_TRUE(copy.AllocatePayload(100 - packet.headers_size()));
+
+  // Smaller storage is left for storage shared with `packet`.
+  RtpPacket small_copy(/*extensions=*/nullptr, /*capacity=*/50);
+  small_copy.CopyHeaderFrom(packet);
+  EXPECT_EQ(small_copy.data(), packet.data());
+  EXPECT_TRUE(small_copy.AllocatePayload(100 - packet.headers_size()));
+  EXPECT_TRUE(small_copy.GetExtension<TransmissionOffset>(&time_offset));
+  EXPECT_EQ(time_offset, kTimeOffset);
+}
+
 TEST(RtpPacketTest, ParseDynamicSizeExtension) {
   // clang-format off
   const uint8_t kPacket1[] = {
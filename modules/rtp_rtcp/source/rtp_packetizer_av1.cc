@@ -18,7 +18,6 @@
 #include "api/video/video_frame_type.h"
 #include "modules/rtp_rtcp/source/leb128.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
-#include "rtc_base/byte_buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 
@@ -74,38 +73,35 @@ RtpPacketizerAv1::RtpPacketizerAv1(rtc::ArrayView<const uint8_t> payload,
 std::vector<RtpPacketizerAv1::Obu> RtpPacketizerAv1::ParseObus(
     rtc::ArrayView<const uint8_t> payload) {
   std::vector<Obu> result;
-  rtc::ByteBufferReader payload_reader(payload);
-  while (payload_reader.Length() > 0) {
+  const uint8_t* read_at = payload.data();
+  const uint8_t* const end = read_at + payload.size();
+  while (read_at != end) {
     Obu obu;
-    payload_reader.ReadUInt8(&obu.header);
+    obu.header = *read_at++;
     obu.size = 1;
     if (ObuHasExtension(obu.header)) {
-      if (payload_reader.Length() == 0) {
+      if (read_at == end) {
         RTC_DLOG(LS_ERROR) << "Malformed AV1 input: expected extension_header, "
                               "no more bytes in the buffer. Offset: "
-                           << (payload.size() - payload_reader.Length());
+                           << payload.size();
         return {};
       }
-      payload_reader.ReadUInt8(&obu.extension_header);
+      obu.extension_header = *read_at++;
       ++obu.size;
     }
     if (!ObuHasSize(obu.header)) {
-      obu.payload = rtc::MakeArrayView(
-          reinterpret_cast<const uint8_t*>(payload_reader.Data()),
-          payload_reader.Length());
-      payload_reader.Consume(payload_reader.Length());
+      obu.payload = rtc::MakeArrayView(read_at, end - read_at);
+      read_at = end;
     } else {
-      uint64_t size = 0;
-      if (!payload_reader.ReadUVarint(&size) ||
-          size > payload_reader.Length()) {
+      uint64_t size = ReadLeb128(read_at, end);
+      if (read_at == nullptr || size > static_cast<size_t>(end - read_at)) {
         RTC_DLOG(LS_ERROR) << "Malformed AV1 input: declared size " << size
                            << " is larger than remaining buffer size "
-                           << payload_reader.Length();
+                           << (read_at ? end - read_at : 0);
         return {};
       }
-      obu.payload = rtc::MakeArrayView(
-          reinterpret_cast<const uint8_t*>(payload_reader.Data()), size);
-      payload_reader.Consume(size);
+      obu.payload = rtc::MakeArrayView(read_at, size);
+      read_at += size;
     }
     obu.size += obu.payload.size();
     // Skip obus that shouldn't be transfered over rtp.
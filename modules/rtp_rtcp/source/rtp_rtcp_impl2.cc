@@ -65,7 +65,9 @@ RtpPacketHistory::PaddingMode GetPaddingMode(
 ModuleRtpRtcpImpl2::RtpSenderContext::RtpSenderContext(
     TaskQueueBase& worker_queue,
     const RtpRtcpInterface::Configuration& config)
-    : packet_history(config.clock, GetPaddingMode(config.field_trials)),
+    : packet_history(config.clock,
+                     GetPaddingMode(config.field_trials),
+                     config.shared_payload_store),
       sequencer(config.local_media_ssrc,
                 config.rtx_send_ssrc,
                 /*require_marker_before_media_padding=*/!config.audio,
@@ -280,6 +282,14 @@ int32_t ModuleRtpRtcpImpl2::SetSendingStatus(const bool sending) {
   if (rtcp_sender_.Sending() != sending) {
     // Sends RTCP BYE when going from true to false
     rtcp_sender_.SetSendingStatus(GetFeedbackState(), sending);
+    if (!sending && rtp_sender_) {
+      // A stopped stream creates no new packets, so it needs no spare storage
+      // for them. Streams on hold may stay stopped for a long time; storage is
+      // allocated again as packets are sent once the stream restarts. The
+      // packet history is kept, so that NACKs for the last packets that
+      // arrive after the stop can still be answered.
+      rtp_sender_->packet_generator.ReleaseFreePacketBuffers();
+    }
   }
   return 0;
 }
@@ -410,6 +410,18 @@ TEST_F(RtpRtcpImpl2Test, RetransmitsAllLayers) {
   EXPECT_EQ(kSequenceNumber + 2, sender_.LastRtpSequenceNumber());
 }
 
+TEST_F(RtpRtcpImpl2Test, RetransmitsLateNackAfterSendingStops) {
+  EXPECT_TRUE(SendFrame(&sender_, sender_video_.get(), kBaseLayerTid));
+  EXPECT_EQ(1, sender_.RtpSent());
+  AdvanceTime(TimeDelta::Millis(5));
+
+  // The stopped stream still has the packets it sent last.
+  EXPECT_EQ(0, sender_.impl_->SetSendingStatus(false));
+  IncomingRtcpNack(&sender_, kSequenceNumber);
+  EXPECT_EQ(2, sender_.RtpSent());
+  EXPECT_EQ(kSequenceNumber, sender_.LastRtpSequenceNumber());
+}
+
 TEST_F(RtpRtcpImpl2Test, Rtt) {
   RtpPacketReceived packet;
   packet.SetTimestamp(1);
@@ -28,6 +28,7 @@
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "modules/rtp_rtcp/source/rtp_sequence_number_map.h"
+#include "modules/rtp_rtcp/source/shared_rtp_payload_store.h"
 #include "modules/rtp_rtcp/source/video_fec_generator.h"
 #include "system_wrappers/include/ntp_time.h"
 
@@ -144,6 +145,11 @@ class RtpRtcpInterface : public RtcpFeedbackSenderInterface {
 
     // Enables send packet batching from the egress RTP sender.
     bool enable_send_packet_batching = false;
+
+    // If set, payloads kept for retransmission are stored once in this store
+    // and shared with other RTP modules using it, e.g. by an SFU forwarding
+    // the same media to many receivers.
+    rtc::scoped_refptr<SharedRtpPayloadStore> shared_payload_store;
   };
 
   // Stats for RTCP sender reports (SR) for a specific SSRC.
@@ -19,6 +19,7 @@
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
+#include "api/make_ref_counted.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "logging/rtc_event_log/events/rtc_event_rtp_packet_outgoing.h"
 #include "modules/rtp_rtcp/include/rtp_cvo.h"
@@ -40,6 +41,8 @@ namespace webrtc {
 namespace {
 constexpr size_t kMinAudioPaddingLength = 50;
 constexpr size_t kRtpHeaderLength = 12;
+// Upper bound on the number of idle packet buffers kept per sender.
+constexpr size_t kMaxFreePacketBuffers = 64;
 
 // Min size needed to get payload padding from packet history.
 constexpr int kMinPayloadPaddingBytes = 50;
@@ -163,7 +166,10 @@ RTPSender::RTPSender(const RtpRtcpInterface::Configuration& config,
       rtx_ssrc_has_acked_(false),
       rtx_(kRtxOff),
       supports_bwe_extension_(false),
-      retransmission_rate_limiter_(config.retransmission_rate_limiter) {
+      retransmission_rate_limiter_(config.retransmission_rate_limiter),
+      packet_buffer_pool_(rtc::make_ref_counted<rtc::CopyOnWriteBufferPool>(
+          max_packet_size_,
+          kMaxFreePacketBuffers)) {
   // This random initialization is not intended to be cryptographic strong.
   timestamp_offset_ = random_.Rand<uint32_t>();
 
@@ -204,12 +210,14 @@ rtc::ArrayView<const RtpExtensionSize> RTPSender::AudioExtensionSizes() {
 void RTPSender::SetExtmapAllowMixed(bool extmap_allow_mixed) {
   MutexLock lock(&send_mutex_);
   rtp_header_extension_map_.SetExtmapAllowMixed(extmap_allow_mixed);
+  padding_packet_template_ = absl::nullopt;
 }
 
 bool RTPSender::RegisterRtpHeaderExtension(absl::string_view uri, int id) {
   MutexLock lock(&send_mutex_);
   bool registered = rtp_header_extension_map_.RegisterByUri(id, uri);
   supports_bwe_extension_ = HasBweExtension(rtp_header_extension_map_);
+  padding_packet_template_ = absl::nullopt;
   UpdateHeaderSizes();
   return registered;
 }
@@ -223,6 +231,7 @@ void RTPSender::DeregisterRtpHeaderExtension(absl::string_view uri) {
   MutexLock lock(&send_mutex_);
   rtp_header_extension_map_.Deregister(uri);
   supports_bwe_extension_ = HasBweExtension(rtp_header_extension_map_);
+  padding_packet_template_ = absl::nullopt;
   UpdateHeaderSizes();
 }
 
@@ -230,6 +239,12 @@ void RTPSender::SetMaxRtpPacketSize(size_t max_packet_size) {
   RTC_DCHECK_GE(max_packet_size, 100);
   RTC_DCHECK_LE(max_packet_size, IP_PACKET_SIZE);
   MutexLock lock(&send_mutex_);
+  if (max_packet_size != max_packet_size_) {
+    // Buffers from the previous pool are freed once released.
+    packet_buffer_pool_ = rtc::make_ref_counted<rtc::CopyOnWriteBufferPool>(
+        max_packet_size, kMaxFreePacketBuffers);
+    padding_packet_template_ = absl::nullopt;
+  }
   max_packet_size_ = max_packet_size;
 }
 
@@ -416,11 +431,16 @@ std::vector<std::unique_ptr<RtpPacketToSend>> RTPSender::GeneratePadding(
     padding_bytes_in_packet = rtc::SafeMin(max_payload_size, kMaxPaddingLength);
   }
 
+  const RtpPacketToSend& padding_template = PaddingPacketTemplate();
   while (bytes_left > 0) {
-    auto padding_packet =
-        std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_);
+    // The header, extensions included, is copied from the template into
+    // storage from the pool, so building a padding packet neither allocates
+    // nor lays out its extensions again.
+    auto padding_packet = std::make_unique<RtpPacketToSend>(
+        /*extensions=*/nullptr,
+        packet_buffer_pool_->CreateEmptyBuffer(max_packet_size_));
+    padding_packet->CopyHeaderFrom(padding_template);
     padding_packet->set_packet_type(RtpPacketMediaType::kPadding);
-    padding_packet->SetMarker(false);
     if (rtx_ == kRtxOff) {
       if (!can_send_padding_on_media_ssrc) {
         break;
@@ -443,22 +463,30 @@ std::vector<std::unique_ptr<RtpPacketToSend>> RTPSender::GeneratePadding(
       padding_packet->SetPayloadType(rtx_payload_type_map_.begin()->second);
     }
 
+    padding_packet->SetPadding(padding_bytes_in_packet);
+    bytes_left -= std::min(bytes_left, padding_bytes_in_packet);
+    padding_packets.push_back(std::move(padding_packet));
+  }
+
+  return padding_packets;
+}
+
+const RtpPacketToSend& RTPSender::PaddingPacketTemplate() {
+  if (!padding_packet_template_) {
+    padding_packet_template_.emplace(&rtp_header_extension_map_,
+                                     max_packet_size_);
+    padding_packet_template_->SetMarker(false);
     if (rtp_header_extension_map_.IsRegistered(TransportSequenceNumber::kId)) {
-      padding_packet->ReserveExtension<TransportSequenceNumber>();
+      padding_packet_template_->ReserveExtension<TransportSequenceNumber>();
     }
     if (rtp_header_extension_map_.IsRegistered(TransmissionOffset::kId)) {
-      padding_packet->ReserveExtension<TransmissionOffset>();
+      padding_packet_template_->ReserveExtension<TransmissionOffset>();
     }
     if (rtp_header_extension_map_.IsRegistered(AbsoluteSendTime::kId)) {
-      padding_packet->ReserveExtension<AbsoluteSendTime>();
+      padding_packet_template_->ReserveExtension<AbsoluteSendTime>();
     }
-
-    padding_packet->SetPadding(padding_bytes_in_packet);
-    bytes_left -= std::min(bytes_left, padding_bytes_in_packet);
-    padding_packets.push_back(std::move(padding_packet));
   }
-
-  return padding_packets;
+  return *padding_packet_template_;
 }
 
 void RTPSender::EnqueuePackets(
@@ -495,8 +523,9 @@ std::unique_ptr<RtpPacketToSend> RTPSender::AllocatePacket(
     max_num_csrcs_ = csrcs.size();
     UpdateHeaderSizes();
   }
-  auto packet = std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_,
-                                                  max_packet_size_);
+  auto packet = std::make_unique<RtpPacketToSend>(
+      &rtp_header_extension_map_,
+      packet_buffer_pool_->CreateEmptyBuffer(max_packet_size_));
   packet->SetSsrc(ssrc_);
   packet->SetCsrcs(csrcs);
 
@@ -567,6 +596,11 @@ void RTPSender::SetSendingMediaStatus(bool enabled) {
   sending_media_ = enabled;
 }
 
+void RTPSender::ReleaseFreePacketBuffers() {
+  MutexLock lock(&send_mutex_);
+  packet_buffer_pool_->ReleaseFreeBuffers();
+}
+
 bool RTPSender::SendingMedia() const {
   MutexLock lock(&send_mutex_);
   return sending_media_;
@@ -658,8 +692,9 @@ std::unique_ptr<RtpPacketToSend> RTPSender::BuildRtxPacket(
     if (kv == rtx_payload_type_map_.end())
       return nullptr;
 
-    rtx_packet = std::make_unique<RtpPacketToSend>(&rtp_header_extension_map_,
-                                                   max_packet_size_);
+    rtx_packet = std::make_unique<RtpPacketToSend>(
+        &rtp_header_extension_map_,
+        packet_buffer_pool_->CreateEmptyBuffer(max_packet_size_));
 
     rtx_packet->SetPayloadType(kv->second);
 
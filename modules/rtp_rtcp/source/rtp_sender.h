@@ -22,13 +22,16 @@
 #include "api/array_view.h"
 #include "api/call/transport.h"
 #include "api/field_trials_view.h"
+#include "api/scoped_refptr.h"
 #include "modules/rtp_rtcp/include/flexfec_sender.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/include/rtp_packet_sender.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_config.h"
 #include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
+#include "rtc_base/copy_on_write_buffer_pool.h"
 #include "rtc_base/random.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
@@ -54,6 +57,8 @@ class RTPSender {
   ~RTPSender();
 
   void SetSendingMediaStatus(bool enabled) RTC_LOCKS_EXCLUDED(send_mutex_);
+  // Frees the packet storage kept around for reuse.
+  void ReleaseFreePacketBuffers() RTC_LOCKS_EXCLUDED(send_mutex_);
   bool SendingMedia() const RTC_LOCKS_EXCLUDED(send_mutex_);
   bool IsAudioConfigured() const RTC_LOCKS_EXCLUDED(send_mutex_);
 
@@ -163,6 +168,9 @@ class RTPSender {
 
   void UpdateHeaderSizes() RTC_EXCLUSIVE_LOCKS_REQUIRED(send_mutex_);
 
+  const RtpPacketToSend& PaddingPacketTemplate()
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(send_mutex_);
+
   void UpdateLastPacketState(const RtpPacketToSend& packet)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(send_mutex_);
 
@@ -207,6 +215,17 @@ class RTPSender {
   bool supports_bwe_extension_ RTC_GUARDED_BY(send_mutex_);
 
   RateLimiter* const retransmission_rate_limiter_;
+
+  // Storage of media, padding and RTX packets, with a capacity of
+  // `max_packet_size_`. Copies of the packets that are modified, e.g. by the
+  // FEC generators, also take their storage from the pool.
+  rtc::scoped_refptr<rtc::CopyOnWriteBufferPool> packet_buffer_pool_
+      RTC_GUARDED_BY(send_mutex_);
+  // Header shared by all padding packets, with their extensions reserved.
+  // Built on first use, and again once the extensions or the maximum packet
+  // size change.
+  absl::optional<RtpPacketToSend> padding_packet_template_
+      RTC_GUARDED_BY(send_mutex_);
 };
 
 }  // namespace webrtc
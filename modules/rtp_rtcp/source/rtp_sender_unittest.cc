@@ -1075,6 +1075,32 @@ TEST_F(RtpSenderTest, GeneratedPaddingHasBweExtensions) {
   EXPECT_GT(payload_padding->payload_size(), 0u);
 }
 
+TEST_F(RtpSenderTest, GeneratedPaddingFollowsExtensionChanges) {
+  EnableRtx();
+  ASSERT_TRUE(rtp_sender_->RegisterRtpHeaderExtension(
+      TransportSequenceNumber::Uri(), kTransportSequenceNumberExtensionId));
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> generated_packets =
+      GeneratePadding(/*target_size_bytes=*/1);
+  ASSERT_THAT(generated_packets, SizeIs(1));
+  EXPECT_EQ(generated_packets[0]->Ssrc(), kRtxSsrc);
+  EXPECT_TRUE(generated_packets[0]->HasExtension<TransportSequenceNumber>());
+  EXPECT_FALSE(generated_packets[0]->HasExtension<AbsoluteSendTime>());
+
+  ASSERT_TRUE(rtp_sender_->RegisterRtpHeaderExtension(
+      AbsoluteSendTime::Uri(), kAbsoluteSendTimeExtensionId));
+  generated_packets = GeneratePadding(/*target_size_bytes=*/1);
+  ASSERT_THAT(generated_packets, SizeIs(1));
+  EXPECT_TRUE(generated_packets[0]->HasExtension<TransportSequenceNumber>());
+  EXPECT_TRUE(generated_packets[0]->HasExtension<AbsoluteSendTime>());
+
+  rtp_sender_->DeregisterRtpHeaderExtension(TransportSequenceNumber::Uri());
+  generated_packets = GeneratePadding(/*target_size_bytes=*/1);
+  ASSERT_THAT(generated_packets, SizeIs(1));
+  EXPECT_FALSE(generated_packets[0]->HasExtension<TransportSequenceNumber>());
+  EXPECT_TRUE(generated_packets[0]->HasExtension<AbsoluteSendTime>());
+}
+
 TEST_F(RtpSenderTest, GeneratePaddingResendsOldPacketsWithRtx) {
   // Min requested size in order to use RTX payload.
   const size_t kMinPaddingSize = 50;
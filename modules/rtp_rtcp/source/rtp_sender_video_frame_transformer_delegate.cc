@@ -10,6 +10,8 @@
 
 #include "modules/rtp_rtcp/source/rtp_sender_video_frame_transformer_delegate.h"
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 #include <utility>
 #include <vector>
@@ -57,7 +59,26 @@ class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
   }
 
   void SetData(rtc::ArrayView<const uint8_t> data) override {
-    encoded_data_ = EncodedImageBuffer::Create(data.data(), data.size());
+    owned_data_ = EncodedImageBuffer::Create(data.data(), data.size());
+    encoded_data_ = owned_data_;
+  }
+
+  rtc::ArrayView<uint8_t> GetMutableData(size_t size) override {
+    if (size == 0) {
+      SetData({});
+      return {};
+    }
+    if (!owned_data_) {
+      // The encoded data may be shared with other users of the encoder output,
+      // so it is copied before it is modified.
+      owned_data_ = EncodedImageBuffer::Create(size);
+      std::memcpy(owned_data_->data(), encoded_data_->data(),
+                  std::min(size, encoded_data_->size()));
+      encoded_data_ = owned_data_;
+    } else if (size != owned_data_->size()) {
+      owned_data_->Realloc(size);
+    }
+    return rtc::ArrayView<uint8_t>(owned_data_->data(), size);
   }
 
   size_t GetPreTransformPayloadSize() const {
@@ -109,6 +130,8 @@ class TransformableVideoSenderFrame : public TransformableVideoFrameInterface {
 
  private:
   rtc::scoped_refptr<EncodedImageBufferInterface> encoded_data_;
+  // Set once the frame owns `encoded_data_`, which is then modified in place.
+  rtc::scoped_refptr<EncodedImageBuffer> owned_data_;
   const size_t pre_transform_payload_size_;
   RTPVideoHeader header_;
   const VideoFrameType frame_type_;
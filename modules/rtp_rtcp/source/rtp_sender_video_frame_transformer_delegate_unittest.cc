@@ -23,6 +23,7 @@ namespace webrtc {
 namespace {
 
 using ::testing::_;
+using ::testing::ElementsAre;
 using ::testing::NiceMock;
 using ::testing::Return;
 using ::testing::SaveArg;
@@ -313,5 +314,53 @@ TEST_F(RtpSenderVideoFrameTransformerDelegateTest,
       /*expected_retransmission_time=*/TimeDelta::PlusInfinity());
 }
 
+TEST_F(RtpSenderVideoFrameTransformerDelegateTest,
+       ModifiesCopyOfEncodedDataInPlace) {
+  auto delegate = rtc::make_ref_counted<RTPSenderVideoFrameTransformerDelegate>(
+      &test_sender_, frame_transformer_,
+      /*ssrc=*/1111, time_controller_.CreateTaskQueueFactory().get());
+  rtc::scoped_refptr<TransformedFrameCallback> callback;
+  EXPECT_CALL(*frame_transformer_, RegisterTransformedFrameSinkCallback)
+      .WillOnce(SaveArg<0>(&callback));
+  delegate->Init();
+  ASSERT_TRUE(callback);
+
+  const uint8_t kData[] = {1, 2, 3};
+  EncodedImage encoded_image;
+  encoded_image.SetEncodedData(EncodedImageBuffer::Create(kData, 3));
+  std::unique_ptr<TransformableFrameInterface> frame;
+  EXPECT_CALL(*frame_transformer_, Transform)
+      .WillOnce([&](std::unique_ptr<TransformableFrameInterface>
+                        frame_to_transform) {
+        frame = std::move(frame_to_transform);
+      });
+  delegate->TransformFrame(
+      /*payload_type=*/1, VideoCodecType::kVideoCodecVP8, /*rtp_timestamp=*/2,
+      encoded_image, RTPVideoHeader(),
+      /*expected_retransmission_time=*/TimeDelta::PlusInfinity());
+  ASSERT_TRUE(frame);
+
+  // Appends two bytes, as an encrypting transform would add a trailer.
+  rtc::ArrayView<uint8_t> data = frame->GetMutableData(5);
+  ASSERT_EQ(data.size(), 5u);
+  EXPECT_NE(data.data(), encoded_image.data());
+  data[3] = 4;
+  data[4] = 5;
+  // Once copied, the data is modified in place.
+  EXPECT_EQ(frame->GetMutableData(5).data(), data.data());
+  EXPECT_THAT(rtc::MakeArrayView(encoded_image.data(), encoded_image.size()),
+              ElementsAre(1, 2, 3));
+
+  rtc::Event event;
+  EXPECT_CALL(test_sender_,
+              SendVideo(_, _, _, _, ElementsAre(1, 2, 3, 4, 5), _, _, _, _))
+      .WillOnce(WithoutArgs([&] {
+        event.Set();
+        return true;
+      }));
+  callback->OnTransformedFrame(std::move(frame));
+  event.Wait(TimeDelta::Seconds(1));
+}
+
 }  // namespace
 }  // namespace webrtc
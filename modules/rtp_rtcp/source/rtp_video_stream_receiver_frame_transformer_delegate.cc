@@ -10,11 +10,13 @@
 
 #include "modules/rtp_rtcp/source/rtp_video_stream_receiver_frame_transformer_delegate.h"
 
+#include <cstring>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/memory/memory.h"
+#include "api/make_ref_counted.h"
 #include "modules/rtp_rtcp/source/rtp_descriptor_authentication.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -23,6 +25,25 @@
 namespace webrtc {
 
 namespace {
+// The first `size` bytes of `buffer`.
+class EncodedImageBufferPrefix : public EncodedImageBufferInterface {
+ public:
+  EncodedImageBufferPrefix(
+      rtc::scoped_refptr<EncodedImageBufferInterface> buffer,
+      size_t size)
+      : buffer_(std::move(buffer)), size_(size) {
+    RTC_DCHECK_LE(size_, buffer_->size());
+  }
+
+  const uint8_t* data() const override { return buffer_->data(); }
+  uint8_t* data() override { return buffer_->data(); }
+  size_t size() const override { return size_; }
+
+ private:
+  const rtc::scoped_refptr<EncodedImageBufferInterface> buffer_;
+  const size_t size_;
+};
+
 class TransformableVideoReceiverFrame
     : public TransformableVideoFrameInterface {
  public:
@@ -43,8 +64,29 @@ class TransformableVideoReceiverFrame
   }
 
   void SetData(rtc::ArrayView<const uint8_t> data) override {
-    frame_->SetEncodedData(
-        EncodedImageBuffer::Create(data.data(), data.size()));
+    buffer_ = EncodedImageBuffer::Create(data.data(), data.size());
+    frame_->SetEncodedData(buffer_);
+  }
+
+  rtc::ArrayView<uint8_t> GetMutableData(size_t size) override {
+    // The frame is the only user of the data assembled from the received
+    // packets, so it is modified in place, unless it grows.
+    if (!buffer_) {
+      buffer_ = frame_->GetEncodedData();
+    }
+    if (size > buffer_->size()) {
+      rtc::scoped_refptr<EncodedImageBuffer> buffer =
+          EncodedImageBuffer::Create(size);
+      std::memcpy(buffer->data(), buffer_->data(), frame_->size());
+      buffer_ = std::move(buffer);
+    }
+    if (size == buffer_->size()) {
+      frame_->SetEncodedData(buffer_);
+    } else {
+      frame_->SetEncodedData(
+          rtc::make_ref_counted<EncodedImageBufferPrefix>(buffer_, size));
+    }
+    return rtc::ArrayView<uint8_t>(buffer_->data(), size);
   }
 
   uint8_t GetPayloadType() const override { return frame_->PayloadType(); }
@@ -86,6 +128,9 @@ class TransformableVideoReceiverFrame
 
  private:
   std::unique_ptr<RtpFrameObject> frame_;
+  // The data of `frame_`, or the larger buffer holding it, once it has been
+  // modified.
+  rtc::scoped_refptr<EncodedImageBufferInterface> buffer_;
   VideoFrameMetadata metadata_;
   RtpVideoFrameReceiver* receiver_;
 };
@@ -11,6 +11,7 @@
 #include "modules/rtp_rtcp/source/rtp_video_stream_receiver_frame_transformer_delegate.h"
 
 #include <cstdio>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -41,7 +42,9 @@ const int kLastSeqNum = 2;
 
 std::unique_ptr<RtpFrameObject> CreateRtpFrameObject(
     const RTPVideoHeader& video_header,
-    std::vector<uint32_t> csrcs) {
+    std::vector<uint32_t> csrcs,
+    rtc::scoped_refptr<EncodedImageBuffer> data =
+        EncodedImageBuffer::Create(0)) {
   RtpPacketInfo packet_info(/*ssrc=*/123, csrcs, /*rtc_timestamp=*/0,
                             /*receive_time=*/Timestamp::Seconds(123456));
   return std::make_unique<RtpFrameObject>(
@@ -50,8 +53,7 @@ std::unique_ptr<RtpFrameObject> CreateRtpFrameObject(
       /*last_packet_received_time=*/5, /*rtp_timestamp=*/6, /*ntp_time_ms=*/7,
       VideoSendTiming(), /*payload_type=*/8, video_header.codec,
       kVideoRotation_0, VideoContentType::UNSPECIFIED, video_header,
-      absl::nullopt, RtpPacketInfos({packet_info}),
-      EncodedImageBuffer::Create(0));
+      absl::nullopt, RtpPacketInfos({packet_info}), std::move(data));
 }
 
 std::unique_ptr<RtpFrameObject> CreateRtpFrameObject() {
@@ -372,5 +374,83 @@ TEST(RtpVideoStreamReceiverFrameTransformerDelegateTest,
   delegate->TransformFrame(CreateRtpFrameObject());
 }
 
+TEST(RtpVideoStreamReceiverFrameTransformerDelegateTest,
+     ShrinksMutableDataInPlace) {
+  rtc::AutoThread main_thread_;
+  TestRtpVideoFrameReceiver receiver;
+  auto mock_frame_transformer =
+      rtc::make_ref_counted<NiceMock<MockFrameTransformer>>();
+  SimulatedClock clock(0);
+  auto delegate =
+      rtc::make_ref_counted<RtpVideoStreamReceiverFrameTransformerDelegate>(
+          &receiver, &clock, mock_frame_transformer, rtc::Thread::Current(),
+          1111);
+  rtc::scoped_refptr<TransformedFrameCallback> callback;
+  EXPECT_CALL(*mock_frame_transformer, RegisterTransformedFrameSinkCallback)
+      .WillOnce(SaveArg<0>(&callback));
+  delegate->Init();
+
+  const uint8_t kData[] = {1, 2, 3, 4, 5, 6};
+  rtc::scoped_refptr<EncodedImageBuffer> data =
+      EncodedImageBuffer::Create(kData, sizeof(kData));
+  const uint8_t* const data_pointer = data->data();
+  ON_CALL(*mock_frame_transformer, Transform)
+      .WillByDefault([&](std::unique_ptr<TransformableFrameInterface> frame) {
+        // Drops the first byte, as a decrypting transform would remove a
+        // header.
+        rtc::ArrayView<uint8_t> mutable_data = frame->GetMutableData(5);
+        ASSERT_EQ(mutable_data.data(), data_pointer);
+        std::memmove(mutable_data.data(), mutable_data.data() + 1, 5);
+        EXPECT_THAT(frame->GetData(), ElementsAre(2, 3, 4, 5, 6));
+        callback->OnTransformedFrame(std::move(frame));
+      });
+  EXPECT_CALL(receiver, ManageFrame)
+      .WillOnce([&](std::unique_ptr<RtpFrameObject> frame) {
+        EXPECT_EQ(frame->data(), data_pointer);
+        EXPECT_THAT(rtc::MakeArrayView(frame->data(), frame->size()),
+                    ElementsAre(2, 3, 4, 5, 6));
+      });
+  delegate->TransformFrame(
+      CreateRtpFrameObject(RTPVideoHeader(), /*csrcs=*/{}, std::move(data)));
+  rtc::ThreadManager::ProcessAllMessageQueuesForTesting();
+}
+
+TEST(RtpVideoStreamReceiverFrameTransformerDelegateTest,
+     GrowsMutableDataKeepingContent) {
+  rtc::AutoThread main_thread_;
+  TestRtpVideoFrameReceiver receiver;
+  auto mock_frame_transformer =
+      rtc::make_ref_counted<NiceMock<MockFrameTransformer>>();
+  SimulatedClock clock(0);
+  auto delegate =
+      rtc::make_ref_counted<RtpVideoStreamReceiverFrameTransformerDelegate>(
+          &receiver, &clock, mock_frame_transformer, rtc::Thread::Current(),
+          1111);
+  rtc::scoped_refptr<TransformedFrameCallback> callback;
+  EXPECT_CALL(*mock_frame_transformer, RegisterTransformedFrameSinkCallback)
+      .WillOnce(SaveArg<0>(&callback));
+  delegate->Init();
+
+  const uint8_t kData[] = {1, 2, 3};
+  ON_CALL(*mock_frame_transformer, Transform)
+      .WillByDefault([&](std::unique_ptr<TransformableFrameInterface> frame) {
+        frame->GetMutableData(2);
+        rtc::ArrayView<uint8_t> mutable_data = frame->GetMutableData(4);
+        ASSERT_EQ(mutable_data.size(), 4u);
+        mutable_data[2] = 7;
+        mutable_data[3] = 8;
+        callback->OnTransformedFrame(std::move(frame));
+      });
+  EXPECT_CALL(receiver, ManageFrame)
+      .WillOnce([&](std::unique_ptr<RtpFrameObject> frame) {
+        EXPECT_THAT(rtc::MakeArrayView(frame->data(), frame->size()),
+                    ElementsAre(1, 2, 7, 8));
+      });
+  delegate->TransformFrame(
+      CreateRtpFrameObject(RTPVideoHeader(), /*csrcs=*/{},
+                           EncodedImageBuffer::Create(kData, sizeof(kData))));
+  rtc::ThreadManager::ProcessAllMessageQueuesForTesting();
+}
+
 }  // namespace
 }  // namespace webrtc
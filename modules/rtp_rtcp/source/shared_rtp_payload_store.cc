@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/shared_rtp_payload_store.h"
+
+#include <string.h>
+
+#include <functional>
+#include <string_view>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+bool IsEqual(const rtc::CopyOnWriteBuffer& data,
+             rtc::ArrayView<const uint8_t> payload) {
+  return data.size() == payload.size() &&
+         (payload.empty() ||
+          memcmp(data.cdata(), payload.data(), payload.size()) == 0);
+}
+
+}  // namespace
+
+SharedRtpPayloadStore::Payload::Payload(Payload&& other)
+    : store_(std::move(other.store_)),
+      hash_(other.hash_),
+      data_(std::move(other.data_)) {}
+
+SharedRtpPayloadStore::Payload& SharedRtpPayloadStore::Payload::operator=(
+    Payload&& other) {
+  if (this != &other) {
+    Reset();
+    store_ = std::move(other.store_);
+    hash_ = other.hash_;
+    data_ = std::move(other.data_);
+  }
+  return *this;
+}
+
+SharedRtpPayloadStore::Payload::~Payload() {
+  Reset();
+}
+
+void SharedRtpPayloadStore::Payload::Reset() {
+  if (store_) {
+    store_->ReleasePayload(hash_, data_);
+    store_ = nullptr;
+  }
+  data_ = rtc::CopyOnWriteBuffer();
+}
+
+SharedRtpPayloadStore::~SharedRtpPayloadStore() {
+  // Every Payload holds a reference to the store.
+  RTC_DCHECK_EQ(size(), 0u);
+}
+
+SharedRtpPayloadStore::Payload SharedRtpPayloadStore::Add(
+    rtc::ArrayView<const uint8_t> payload) {
+  Payload result;
+  result.hash_ = std::hash<std::string_view>()(std::string_view(
+      reinterpret_cast<const char*>(payload.data()), payload.size()));
+  Shard& shard = ShardForHash(result.hash_);
+  {
+    MutexLock lock(&shard.mutex);
+    auto [begin, end] = shard.payloads.equal_range(result.hash_);
+    auto it = begin;
+    while (it != end && !IsEqual(it->second.data, payload)) {
+      ++it;
+    }
+    if (it == end) {
+      it = shard.payloads.emplace(
+          result.hash_,
+          Entry{rtc::CopyOnWriteBuffer(payload.data(), payload.size()), 0});
+    }
+    ++it->second.references;
+    result.data_ = it->second.data;
+  }
+  result.store_ = rtc::scoped_refptr<SharedRtpPayloadStore>(this);
+  return result;
+}
+
+size_t SharedRtpPayloadStore::size() const {
+  size_t size = 0;
+  for (const Shard& shard : shards_) {
+    MutexLock lock(&shard.mutex);
+    size += shard.payloads.size();
+  }
+  return size;
+}
+
+void SharedRtpPayloadStore::ReleasePayload(
+    size_t hash,
+    const rtc::CopyOnWriteBuffer& data) {
+  Shard& shard = ShardForHash(hash);
+  MutexLock lock(&shard.mutex);
+  auto [begin, end] = shard.payloads.equal_range(hash);
+  for (auto it = begin; it != end; ++it) {
+    // Entries are told apart by their storage, not by content.
+    if (it->second.data.cdata() == data.cdata()) {
+      RTC_DCHECK_GT(it->second.references, 0);
+      if (--it->second.references == 0) {
+        shard.payloads.erase(it);
+      }
+      return;
+    }
+  }
+  RTC_DCHECK_NOTREACHED();
+}
+
+}  // namespace webrtc
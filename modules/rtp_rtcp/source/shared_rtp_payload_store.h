@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_SHARED_RTP_PAYLOAD_STORE_H_
+#define MODULES_RTP_RTCP_SOURCE_SHARED_RTP_PAYLOAD_STORE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <unordered_map>
+
+#include "api/array_view.h"
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Keeps one copy of RTP payloads that are stored by several packet histories,
+// e.g. when an SFU forwards the same media to many receivers and each
+// downstream RTP module rewrites only the RTP header. Identical payloads added
+// by different histories share storage, so retransmission memory scales with
+// the number of distinct packets rather than with the number of receivers.
+// Thread safe. Payloads are spread over independently locked shards by their
+// hash, so histories adding packets on different threads rarely contend.
+class SharedRtpPayloadStore final
+    : public rtc::RefCountedNonVirtual<SharedRtpPayloadStore> {
+ public:
+  // Reference to a payload in the store, released when destroyed.
+  class Payload {
+   public:
+    Payload() = default;
+    Payload(Payload&& other);
+    Payload& operator=(Payload&& other);
+    ~Payload();
+
+    Payload(const Payload&) = delete;
+    Payload& operator=(const Payload&) = delete;
+
+    explicit operator bool() const { return store_ != nullptr; }
+    const rtc::CopyOnWriteBuffer& data() const { return data_; }
+
+   private:
+    friend class SharedRtpPayloadStore;
+
+    void Reset();
+
+    rtc::scoped_refptr<SharedRtpPayloadStore> store_;
+    size_t hash_ = 0;
+    rtc::CopyOnWriteBuffer data_;
+  };
+
+  SharedRtpPayloadStore() = default;
+  SharedRtpPayloadStore(const SharedRtpPayloadStore&) = delete;
+  SharedRtpPayloadStore& operator=(const SharedRtpPayloadStore&) = delete;
+
+  // Returns a reference to a stored copy of `payload`, storing it unless an
+  // identical payload is already referenced.
+  Payload Add(rtc::ArrayView<const uint8_t> payload);
+
+  // Number of distinct payloads currently stored.
+  size_t size() const;
+
+ private:
+  friend class rtc::RefCountedNonVirtual<SharedRtpPayloadStore>;
+  ~SharedRtpPayloadStore();
+
+  struct Entry {
+    rtc::CopyOnWriteBuffer data;
+    int references;
+  };
+
+  struct Shard {
+    mutable Mutex mutex;
+    std::unordered_multimap<size_t, Entry> payloads RTC_GUARDED_BY(mutex);
+  };
+
+  static constexpr int kShardBits = 4;
+
+  // Uses the top bits of the hash, the maps within a shard bucket entries by
+  // the low ones.
+  Shard& ShardForHash(size_t hash) {
+    return shards_[hash >> (8 * sizeof(size_t) - kShardBits)];
+  }
+  void ReleasePayload(size_t hash, const rtc::CopyOnWriteBuffer& data);
+
+  std::array<Shard, size_t{1} << kShardBits> shards_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_SHARED_RTP_PAYLOAD_STORE_H_
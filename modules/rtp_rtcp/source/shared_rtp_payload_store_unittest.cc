@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/shared_rtp_payload_store.h"
+
+#include <cstdint>
+#include <utility>
+
+#include "api/array_view.h"
+#include "api/make_ref_counted.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+constexpr uint8_t kPayload1[] = {1, 2, 3, 4, 5};
+constexpr uint8_t kPayload2[] = {5, 4, 3, 2, 1};
+
+TEST(SharedRtpPayloadStoreTest, StoresIdenticalPayloadsOnce) {
+  auto store = rtc::make_ref_counted<SharedRtpPayloadStore>();
+  SharedRtpPayloadStore::Payload a = store->Add(kPayload1);
+  SharedRtpPayloadStore::Payload b = store->Add(kPayload1);
+  SharedRtpPayloadStore::Payload c = store->Add(kPayload2);
+
+  EXPECT_EQ(store->size(), 2u);
+  EXPECT_EQ(a.data().cdata(), b.data().cdata());
+  EXPECT_THAT(rtc::ArrayView<const uint8_t>(a.data()),
+              ElementsAreArray(kPayload1));
+  EXPECT_THAT(rtc::ArrayView<const uint8_t>(c.data()),
+              ElementsAreArray(kPayload2));
+}
+
+TEST(SharedRtpPayloadStoreTest, RemovesPayloadWhenLastReferenceIsDropped) {
+  auto store = rtc::make_ref_counted<SharedRtpPayloadStore>();
+  SharedRtpPayloadStore::Payload a = store->Add(kPayload1);
+  SharedRtpPayloadStore::Payload b = store->Add(kPayload1);
+
+  a = SharedRtpPayloadStore::Payload();
+  EXPECT_FALSE(a);
+  EXPECT_EQ(store->size(), 1u);
+
+  SharedRtpPayloadStore::Payload moved = std::move(b);
+  EXPECT_TRUE(moved);
+  EXPECT_EQ(store->size(), 1u);
+
+  moved = SharedRtpPayloadStore::Payload();
+  EXPECT_EQ(store->size(), 0u);
+}
+
+TEST(SharedRtpPayloadStoreTest, PayloadsKeepTheStoreAlive) {
+  auto store = rtc::make_ref_counted<SharedRtpPayloadStore>();
+  SharedRtpPayloadStore::Payload payload = store->Add(kPayload1);
+  store = nullptr;
+  EXPECT_THAT(rtc::ArrayView<const uint8_t>(payload.data()),
+              ElementsAreArray(kPayload1));
+}
+
+}  // namespace
+}  // namespace webrtc
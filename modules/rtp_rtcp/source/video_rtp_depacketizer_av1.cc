@@ -17,7 +17,6 @@
 
 #include "modules/rtp_rtcp/source/leb128.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
-#include "rtc_base/byte_buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
@@ -188,13 +187,14 @@ VectorObuInfo ParseObus(
   VectorObuInfo obu_infos;
   bool expect_continues_obu = false;
   for (rtc::ArrayView<const uint8_t> rtp_payload : rtp_payloads) {
-    rtc::ByteBufferReader payload(rtp_payload);
-    uint8_t aggregation_header;
-    if (!payload.ReadUInt8(&aggregation_header)) {
+    if (rtp_payload.empty()) {
       RTC_DLOG(LS_WARNING)
           << "Failed to find aggregation header in the packet.";
       return {};
     }
+    const uint8_t* read_at = rtp_payload.data();
+    const uint8_t* const end = read_at + rtp_payload.size();
+    uint8_t aggregation_header = *read_at++;
     // Z-bit: 1 if the first OBU contained in the packet is a continuation of a
     // previous OBU.
     bool continues_obu = RtpStartsWithFragment(aggregation_header);
@@ -203,7 +203,7 @@ VectorObuInfo ParseObus(
       return {};
     }
     int num_expected_obus = RtpNumObus(aggregation_header);
-    if (payload.Length() == 0) {
+    if (read_at == end) {
       // rtp packet has just the aggregation header. That may be valid only when
       // there is exactly one fragment in the packet of size 0.
       if (num_expected_obus != 1) {
@@ -219,7 +219,7 @@ VectorObuInfo ParseObus(
       continue;
     }
 
-    for (int obu_index = 1; payload.Length() > 0; ++obu_index) {
+    for (int obu_index = 1; read_at != end; ++obu_index) {
       ObuInfo& obu_info = (obu_index == 1 && continues_obu)
                               ? obu_infos.back()
                               : obu_infos.emplace_back();
@@ -229,27 +229,27 @@ VectorObuInfo ParseObus(
       // https://aomediacodec.github.io/av1-rtp-spec/#43-av1-aggregation-header
       bool has_fragment_size = (obu_index != num_expected_obus);
       if (has_fragment_size) {
-        if (!payload.ReadUVarint(&fragment_size)) {
+        fragment_size = ReadLeb128(read_at, end);
+        if (read_at == nullptr) {
           RTC_DLOG(LS_WARNING) << "Failed to read fragment size for obu #"
                                << obu_index << "/" << num_expected_obus;
           return {};
         }
-        if (fragment_size > payload.Length()) {
+        if (fragment_size > static_cast<size_t>(end - read_at)) {
           // Malformed input: written size is larger than remaining buffer.
           RTC_DLOG(LS_WARNING) << "Malformed fragment size " << fragment_size
                                << " is larger than remaining size "
-                               << payload.Length() << " while reading obu #"
+                               << (end - read_at) << " while reading obu #"
                                << obu_index << "/" << num_expected_obus;
           return {};
         }
       } else {
-        fragment_size = payload.Length();
+        fragment_size = end - read_at;
       }
       // While it is in-practical to pass empty fragments, it is still possible.
       if (fragment_size > 0) {
-        obu_info.data.Append(reinterpret_cast<const uint8_t*>(payload.Data()),
-                             fragment_size);
-        payload.Consume(fragment_size);
+        obu_info.data.Append(read_at, fragment_size);
+        read_at += fragment_size;
       }
     }
     // Z flag should be same as Y flag of the next packet.
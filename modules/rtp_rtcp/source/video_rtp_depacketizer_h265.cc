@@ -0,0 +1,196 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer_h265.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "common_video/h265/h265_common.h"
+#include "common_video/h265/h265_sps_parser.h"
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace {
+
+// The payload header has the same format as the NAL unit header, see section
+// 4.4 of RFC 7798.
+constexpr size_t kPayloadHeaderSize = H265::kNaluHeaderSize;
+constexpr size_t kFuHeaderSize = 1;
+constexpr size_t kLengthFieldSize = 2;
+
+// PACI packets, see section 4.4.4 of RFC 7798, aren't supported.
+constexpr uint8_t kPaci = 50;
+
+constexpr uint8_t kFBitAndLayerIdHighBitMask = 0x81;
+constexpr uint8_t kFuSBit = 0x80;
+constexpr uint8_t kFuTypeMask = 0x3F;
+
+constexpr uint8_t kStartCode[] = {0, 0, 0, 1};
+
+bool IsIrap(uint8_t nalu_type) {
+  return nalu_type >= H265::NaluType::kBlaWLp &&
+         nalu_type <= H265::NaluType::kRsvIrapVcl23;
+}
+
+absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> ProcessApOrSingleNalu(
+    rtc::CopyOnWriteBuffer rtp_payload) {
+  const uint8_t* const payload_data = rtp_payload.cdata();
+  std::vector<rtc::ArrayView<const uint8_t>> nalus;
+  if (H265::ParseNaluType(payload_data[0]) == H265::NaluType::kAp) {
+    size_t offset = kPayloadHeaderSize;
+    while (offset < rtp_payload.size()) {
+      if (rtp_payload.size() - offset < kLengthFieldSize) {
+        RTC_LOG(LS_ERROR) << "AP NAL unit length truncated.";
+        return absl::nullopt;
+      }
+      uint16_t nalu_size =
+          ByteReader<uint16_t>::ReadBigEndian(&payload_data[offset]);
+      offset += kLengthFieldSize;
+      if (nalu_size < H265::kNaluHeaderSize ||
+          nalu_size > rtp_payload.size() - offset) {
+        RTC_LOG(LS_ERROR) << "AP packet with incorrect NALU packet lengths.";
+        return absl::nullopt;
+      }
+      nalus.emplace_back(&payload_data[offset], nalu_size);
+      offset += nalu_size;
+    }
+    if (nalus.empty()) {
+      RTC_LOG(LS_ERROR) << "AP packet without NAL units.";
+      return absl::nullopt;
+    }
+  } else {
+    nalus.emplace_back(payload_data, rtp_payload.size());
+  }
+
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed_payload(
+      absl::in_place);
+  parsed_payload->video_header.width = 0;
+  parsed_payload->video_header.height = 0;
+  parsed_payload->video_header.codec = kVideoCodecH265;
+  parsed_payload->video_header.simulcastIdx = 0;
+  parsed_payload->video_header.is_first_packet_in_frame = true;
+  parsed_payload->video_header.frame_type = VideoFrameType::kVideoFrameDelta;
+
+  size_t bitstream_size = 0;
+  for (rtc::ArrayView<const uint8_t> nalu : nalus) {
+    bitstream_size += sizeof(kStartCode) + nalu.size();
+  }
+  rtc::CopyOnWriteBuffer& bitstream = parsed_payload->video_payload;
+  bitstream.EnsureCapacity(bitstream_size);
+  for (rtc::ArrayView<const uint8_t> nalu : nalus) {
+    uint8_t nalu_type = H265::ParseNaluType(nalu[0]);
+    switch (nalu_type) {
+      case H265::NaluType::kVps:
+        parsed_payload->video_header.frame_type =
+            VideoFrameType::kVideoFrameKey;
+        break;
+      case H265::NaluType::kSps: {
+        absl::optional<H265SpsParser::SpsState> sps = H265SpsParser::ParseSps(
+            nalu.data() + H265::kNaluHeaderSize,
+            nalu.size() - H265::kNaluHeaderSize);
+        if (sps) {
+          parsed_payload->video_header.width = sps->width;
+          parsed_payload->video_header.height = sps->height;
+        } else {
+          RTC_LOG(LS_WARNING) << "Failed to parse SPS.";
+        }
+        parsed_payload->video_header.frame_type =
+            VideoFrameType::kVideoFrameKey;
+        break;
+      }
+      case H265::NaluType::kAp:
+      case H265::NaluType::kFu:
+      case kPaci:
+        RTC_LOG(LS_WARNING) << "Unexpected AP, FU or PACI received.";
+        return absl::nullopt;
+      default:
+        if (IsIrap(nalu_type)) {
+          parsed_payload->video_header.frame_type =
+              VideoFrameType::kVideoFrameKey;
+        }
+        break;
+    }
+    bitstream.AppendData(kStartCode);
+    bitstream.AppendData(nalu.data(), nalu.size());
+  }
+
+  return parsed_payload;
+}
+
+absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> ParseFuNalu(
+    rtc::CopyOnWriteBuffer rtp_payload) {
+  if (rtp_payload.size() <= kPayloadHeaderSize + kFuHeaderSize) {
+    RTC_LOG(LS_ERROR) << "FU NAL units truncated.";
+    return absl::nullopt;
+  }
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed_payload(
+      absl::in_place);
+  const uint8_t* const payload_data = rtp_payload.cdata();
+  const uint8_t fu_header = payload_data[kPayloadHeaderSize];
+  const uint8_t original_nal_type = fu_header & kFuTypeMask;
+  const bool first_fragment = (fu_header & kFuSBit) != 0;
+  constexpr size_t kFuPayloadOffset = kPayloadHeaderSize + kFuHeaderSize;
+  if (first_fragment) {
+    // The original NAL unit header is the payload header with the type
+    // replaced by the one in the FU header.
+    const uint8_t original_nal_header[H265::kNaluHeaderSize] = {
+        static_cast<uint8_t>(
+            (payload_data[0] & kFBitAndLayerIdHighBitMask) |
+            (original_nal_type << 1)),
+        payload_data[1]};
+    rtc::CopyOnWriteBuffer& bitstream = parsed_payload->video_payload;
+    bitstream.EnsureCapacity(sizeof(kStartCode) + H265::kNaluHeaderSize +
+                             rtp_payload.size() - kFuPayloadOffset);
+    bitstream.AppendData(kStartCode);
+    bitstream.AppendData(original_nal_header);
+    bitstream.AppendData(payload_data + kFuPayloadOffset,
+                         rtp_payload.size() - kFuPayloadOffset);
+  } else {
+    parsed_payload->video_payload = rtp_payload.Slice(
+        kFuPayloadOffset, rtp_payload.size() - kFuPayloadOffset);
+  }
+
+  parsed_payload->video_header.frame_type =
+      IsIrap(original_nal_type) ? VideoFrameType::kVideoFrameKey
+                                : VideoFrameType::kVideoFrameDelta;
+  parsed_payload->video_header.width = 0;
+  parsed_payload->video_header.height = 0;
+  parsed_payload->video_header.codec = kVideoCodecH265;
+  parsed_payload->video_header.simulcastIdx = 0;
+  parsed_payload->video_header.is_first_packet_in_frame = first_fragment;
+  return parsed_payload;
+}
+
+}  // namespace
+
+absl::optional<VideoRtpDepacketizer::ParsedRtpPayload>
+VideoRtpDepacketizerH265::Parse(rtc::CopyOnWriteBuffer rtp_payload) {
+  if (rtp_payload.size() < kPayloadHeaderSize) {
+    RTC_LOG(LS_ERROR) << "Payload header truncated.";
+    return absl::nullopt;
+  }
+
+  if (H265::ParseNaluType(rtp_payload.cdata()[0]) == H265::NaluType::kFu) {
+    // Fragmented NAL units (FU).
+    return ParseFuNalu(std::move(rtp_payload));
+  } else {
+    return ProcessApOrSingleNalu(std::move(rtp_payload));
+  }
+}
+
+}  // namespace webrtc
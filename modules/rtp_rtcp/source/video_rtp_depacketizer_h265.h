@@ -0,0 +1,35 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_VIDEO_RTP_DEPACKETIZER_H265_H_
+#define MODULES_RTP_RTCP_SOURCE_VIDEO_RTP_DEPACKETIZER_H265_H_
+
+#include "absl/types/optional.h"
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer.h"
+#include "rtc_base/copy_on_write_buffer.h"
+
+namespace webrtc {
+
+// Depacketizes H.265 payloads as specified in RFC 7798, for tx-mode SRST and
+// without decoding order numbers, i.e. single NAL unit packets, aggregation
+// packets (AP) and fragmentation units (FU). Unlike the H.264 depacketizer the
+// video payload is written in Annex B format, with a start code in front of
+// every NAL unit, so it doesn't need to be fixed up later in the pipeline.
+class VideoRtpDepacketizerH265 : public VideoRtpDepacketizer {
+ public:
+  ~VideoRtpDepacketizerH265() override = default;
+
+  absl::optional<ParsedRtpPayload> Parse(
+      rtc::CopyOnWriteBuffer rtp_payload) override;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_VIDEO_RTP_DEPACKETIZER_H265_H_
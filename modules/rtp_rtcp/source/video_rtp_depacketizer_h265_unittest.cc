@@ -0,0 +1,181 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer_h265.h"
+
+#include <cstdint>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+// Payload headers with F=0, LayerId=0 and TID=1, i.e. the first byte is the
+// NAL unit type shifted left by one.
+enum PayloadHeader : uint8_t {
+  kTrailR = 1 << 1,
+  kIdrWRadl = 19 << 1,
+  kVps = 32 << 1,
+  kSps = 33 << 1,
+  kPps = 34 << 1,
+  kAp = 48 << 1,
+  kFu = 49 << 1,
+  kPaci = 50 << 1,
+};
+constexpr uint8_t kTid = 0x01;
+
+constexpr uint8_t kSpsWithResolution[] = {
+    kSps, kTid, 0x01, 0x04, 0x08, 0x00, 0x00, 0x03, 0x00, 0x9d,
+    0x08, 0x00, 0x00, 0x03, 0x00, 0x00, 0x78, 0xb0, 0x03, 0xc0,
+    0x80, 0x10, 0xe5, 0x96, 0x56, 0x69, 0x24, 0xca, 0xe0, 0x10,
+    0x00, 0x00, 0x03, 0x00, 0x10, 0x00, 0x00, 0x03, 0x01, 0xe0,
+    0x80};
+
+rtc::ArrayView<const uint8_t> Payload(
+    const VideoRtpDepacketizer::ParsedRtpPayload& parsed) {
+  return rtc::MakeArrayView(parsed.video_payload.cdata(),
+                            parsed.video_payload.size());
+}
+
+TEST(VideoRtpDepacketizerH265Test, SingleNalu) {
+  const uint8_t kPacket[] = {kTrailR, kTid, 0xAA, 0xBB};
+  VideoRtpDepacketizerH265 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(kPacket));
+  ASSERT_TRUE(parsed);
+
+  EXPECT_THAT(Payload(*parsed),
+              ElementsAre(0, 0, 0, 1, kTrailR, kTid, 0xAA, 0xBB));
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameDelta);
+  EXPECT_EQ(parsed->video_header.codec, kVideoCodecH265);
+  EXPECT_TRUE(parsed->video_header.is_first_packet_in_frame);
+}
+
+TEST(VideoRtpDepacketizerH265Test, SingleNaluIrapIsKeyFrame) {
+  const uint8_t kPacket[] = {kIdrWRadl, kTid, 0xAA};
+  VideoRtpDepacketizerH265 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(kPacket));
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+}
+
+TEST(VideoRtpDepacketizerH265Test, SingleNaluSpsWithResolution) {
+  VideoRtpDepacketizerH265 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(kSpsWithResolution));
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(parsed->video_header.width, 1920u);
+  EXPECT_EQ(parsed->video_header.height, 1080u);
+}
+
+TEST(VideoRtpDepacketizerH265Test, AggregationPacket) {
+  const uint8_t kPacket[] = {kAp, kTid,                         //
+                             0,   4,    kVps,      kTid, 0x11, 0x22,  //
+                             0,   3,    kPps,      kTid, 0x33,        //
+                             0,   4,    kIdrWRadl, kTid, 0x44, 0x55};
+  VideoRtpDepacketizerH265 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(kPacket));
+  ASSERT_TRUE(parsed);
+
+  const uint8_t kExpected[] = {0, 0, 0, 1, kVps,      kTid, 0x11, 0x22,  //
+                               0, 0, 0, 1, kPps,      kTid, 0x33,        //
+                               0, 0, 0, 1, kIdrWRadl, kTid, 0x44, 0x55};
+  EXPECT_THAT(Payload(*parsed), ElementsAreArray(kExpected));
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(parsed->video_header.codec, kVideoCodecH265);
+  EXPECT_TRUE(parsed->video_header.is_first_packet_in_frame);
+}
+
+TEST(VideoRtpDepacketizerH265Test, AggregationPacketWithIncorrectLength) {
+  const uint8_t kPacket[] = {kAp, kTid, 0, 4, kVps, kTid, 0x11, 0x22, 0, 5,
+                             kPps, kTid, 0x33};
+  VideoRtpDepacketizerH265 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPacket)));
+}
+
+TEST(VideoRtpDepacketizerH265Test, AggregationPacketWithTruncatedLength) {
+  const uint8_t kPacket[] = {kAp, kTid, 0, 4, kVps, kTid, 0x11, 0x22, 0};
+  VideoRtpDepacketizerH265 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPacket)));
+}
+
+TEST(VideoRtpDepacketizerH265Test, EmptyAggregationPacket) {
+  const uint8_t kPacket[] = {kAp, kTid};
+  VideoRtpDepacketizerH265 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPacket)));
+}
+
+TEST(VideoRtpDepacketizerH265Test, FragmentationUnits) {
+  // FU headers with the S bit set in the first and the E bit set in the last
+  // fragment. The F bit and the layer id of the payload header are kept.
+  const uint8_t kFirst[] = {kFu | 0x81, 0xF9, 0x80 | 19, 0xAA, 0xBB};
+  const uint8_t kMiddle[] = {kFu | 0x81, 0xF9, 19, 0xCC};
+  const uint8_t kLast[] = {kFu | 0x81, 0xF9, 0x40 | 19, 0xDD};
+  VideoRtpDepacketizerH265 depacketizer;
+
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(kFirst));
+  ASSERT_TRUE(parsed);
+  EXPECT_THAT(Payload(*parsed),
+              ElementsAre(0, 0, 0, 1, kIdrWRadl | 0x81, 0xF9, 0xAA, 0xBB));
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(parsed->video_header.codec, kVideoCodecH265);
+  EXPECT_TRUE(parsed->video_header.is_first_packet_in_frame);
+
+  parsed = depacketizer.Parse(rtc::CopyOnWriteBuffer(kMiddle));
+  ASSERT_TRUE(parsed);
+  EXPECT_THAT(Payload(*parsed), ElementsAre(0xCC));
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameKey);
+  EXPECT_FALSE(parsed->video_header.is_first_packet_in_frame);
+
+  parsed = depacketizer.Parse(rtc::CopyOnWriteBuffer(kLast));
+  ASSERT_TRUE(parsed);
+  EXPECT_THAT(Payload(*parsed), ElementsAre(0xDD));
+  EXPECT_FALSE(parsed->video_header.is_first_packet_in_frame);
+}
+
+TEST(VideoRtpDepacketizerH265Test, FragmentationUnitOfDeltaFrame) {
+  const uint8_t kPacket[] = {kFu, kTid, 0x80 | 1, 0xAA};
+  VideoRtpDepacketizerH265 depacketizer;
+  absl::optional<VideoRtpDepacketizer::ParsedRtpPayload> parsed =
+      depacketizer.Parse(rtc::CopyOnWriteBuffer(kPacket));
+  ASSERT_TRUE(parsed);
+  EXPECT_THAT(Payload(*parsed),
+              ElementsAre(0, 0, 0, 1, kTrailR, kTid, 0xAA));
+  EXPECT_EQ(parsed->video_header.frame_type, VideoFrameType::kVideoFrameDelta);
+}
+
+TEST(VideoRtpDepacketizerH265Test, TruncatedPackets) {
+  const uint8_t kPayloadHeader[] = {kTrailR};
+  const uint8_t kFuHeader[] = {kFu, kTid, 0x80 | 1};
+  VideoRtpDepacketizerH265 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer()));
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPayloadHeader)));
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kFuHeader)));
+}
+
+TEST(VideoRtpDepacketizerH265Test, PaciIsNotSupported) {
+  const uint8_t kPacket[] = {kPaci, kTid, 0x00, 0x00, 0xAA};
+  VideoRtpDepacketizerH265 depacketizer;
+  EXPECT_FALSE(depacketizer.Parse(rtc::CopyOnWriteBuffer(kPacket)));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,333 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Microbenchmarks of the per-packet paths of RTP and RTCP processing. Each
+// benchmark reports its throughput in packets per second; its inverse is the
+// cost per packet.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/make_ref_counted.h"
+#include "api/scoped_refptr.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "api/video/video_codec_type.h"
+#include "api/video/video_frame_type.h"
+#include "benchmark/benchmark.h"
+#include "call/rtp_demuxer.h"
+#include "call/rtp_packet_sink_interface.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/report_block.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sdes.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "modules/rtp_rtcp/source/rtcp_receiver.h"
+#include "modules/rtp_rtcp/source/rtp_format.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_rtcp_interface.h"
+#include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "modules/rtp_rtcp/source/shared_rtp_payload_store.h"
+#include "modules/video_coding/packet_buffer.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/system/unused.h"
+#include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/ntp_time.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint8_t kPayloadType = 96;
+constexpr uint32_t kSenderSsrc = 0x1234;
+constexpr uint32_t kReceiverSsrc = 0x5678;
+constexpr size_t kPayloadSize = 1000;
+constexpr int kAbsoluteSendTimeId = 1;
+constexpr int kTransportSequenceNumberId = 2;
+constexpr int kVideoOrientationId = 3;
+constexpr int kMidId = 4;
+
+RtpHeaderExtensionMap VideoExtensions() {
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<AbsoluteSendTime>(kAbsoluteSendTimeId);
+  extensions.Register<TransportSequenceNumber>(kTransportSequenceNumberId);
+  extensions.Register<VideoOrientation>(kVideoOrientationId);
+  extensions.Register<RtpMid>(kMidId);
+  return extensions;
+}
+
+// A video packet as sent with the usual set of header extensions.
+rtc::CopyOnWriteBuffer VideoPacket(const RtpHeaderExtensionMap* extensions,
+                                   uint32_t ssrc,
+                                   uint16_t sequence_number) {
+  RtpPacketToSend packet(extensions);
+  packet.SetPayloadType(kPayloadType);
+  packet.SetSsrc(ssrc);
+  packet.SetSequenceNumber(sequence_number);
+  packet.SetTimestamp(90 * sequence_number);
+  packet.SetExtension<AbsoluteSendTime>(0x123456);
+  packet.SetExtension<TransportSequenceNumber>(sequence_number);
+  packet.SetExtension<VideoOrientation>(kVideoRotation_0);
+  packet.SetExtension<RtpMid>("video");
+  packet.AllocatePayload(kPayloadSize);
+  return packet.Buffer();
+}
+
+void BM_ParseRtpPacket(benchmark::State& state) {
+  const RtpHeaderExtensionMap extensions = VideoExtensions();
+  const rtc::CopyOnWriteBuffer buffer =
+      VideoPacket(&extensions, kSenderSsrc, 1);
+  RtpPacketReceived packet(&extensions);
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    bool parsed = packet.Parse(buffer);
+    benchmark::DoNotOptimize(parsed);
+    benchmark::DoNotOptimize(packet.GetExtension<TransportSequenceNumber>());
+    benchmark::DoNotOptimize(packet.GetExtension<AbsoluteSendTime>());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseRtpPacket);
+
+class NoopSink : public RtpPacketSinkInterface {
+ public:
+  void OnRtpPacket(const RtpPacketReceived& packet) override {}
+};
+
+// Routes packets by SSRC to one of `state.range(0)` sinks.
+void BM_DemuxRtpPacket(benchmark::State& state) {
+  const int num_sinks = static_cast<int>(state.range(0));
+  const RtpHeaderExtensionMap extensions = VideoExtensions();
+  RtpDemuxer demuxer(/*use_mid=*/false);
+  std::vector<NoopSink> sinks(num_sinks);
+  std::vector<RtpPacketReceived> packets;
+  for (int i = 0; i < num_sinks; ++i) {
+    demuxer.AddSink(kSenderSsrc + i, &sinks[i]);
+    RtpPacketReceived packet(&extensions);
+    packet.Parse(VideoPacket(&extensions, kSenderSsrc + i, 1));
+    packets.push_back(std::move(packet));
+  }
+  size_t index = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    bool delivered = demuxer.OnRtpPacket(packets[index]);
+    benchmark::DoNotOptimize(delivered);
+    index = (index + 1) % packets.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+  for (NoopSink& sink : sinks) {
+    demuxer.RemoveSink(&sink);
+  }
+}
+BENCHMARK(BM_DemuxRtpPacket)->Arg(1)->Arg(16)->Arg(256);
+
+class NoopOwner : public RTCPReceiver::ModuleRtpRtcp {
+ public:
+  void SetTmmbn(std::vector<rtcp::TmmbItem> bounding_set) override {}
+  void OnRequestSendReport() override {}
+  void OnReceivedNack(
+      const std::vector<uint16_t>& nack_sequence_numbers) override {}
+  void OnReceivedRtcpReportBlocks(
+      rtc::ArrayView<const ReportBlockData> report_blocks) override {}
+};
+
+// A sender report, SDES and NACK, as sent by a video receiver which is also
+// a sender.
+rtc::Buffer CompoundRtcpPacket() {
+  rtcp::CompoundPacket compound;
+  auto sr = std::make_unique<rtcp::SenderReport>();
+  sr->SetSenderSsrc(kSenderSsrc);
+  sr->SetNtp(NtpTime(0x11111111, 0x22222222));
+  sr->SetRtpTimestamp(0x33333333);
+  rtcp::ReportBlock report_block;
+  report_block.SetMediaSsrc(kReceiverSsrc);
+  report_block.SetExtHighestSeqNum(1000);
+  report_block.SetJitter(10);
+  sr->AddReportBlock(report_block);
+  compound.Append(std::move(sr));
+  auto sdes = std::make_unique<rtcp::Sdes>();
+  sdes->AddCName(kSenderSsrc, "benchmark_cname");
+  compound.Append(std::move(sdes));
+  auto nack = std::make_unique<rtcp::Nack>();
+  nack->SetSenderSsrc(kSenderSsrc);
+  nack->SetMediaSsrc(kReceiverSsrc);
+  nack->SetPacketIds({10, 11, 12, 30, 100});
+  compound.Append(std::move(nack));
+  return compound.Build();
+}
+
+void BM_RtcpReceiverCompoundPacket(benchmark::State& state) {
+  SimulatedClock clock(Timestamp::Seconds(1000));
+  NoopOwner owner;
+  RtpRtcpInterface::Configuration config;
+  config.clock = &clock;
+  config.local_media_ssrc = kReceiverSsrc;
+  RTCPReceiver receiver(config, &owner);
+  receiver.SetRemoteSSRC(kSenderSsrc);
+  const rtc::Buffer packet = CompoundRtcpPacket();
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    receiver.IncomingPacket(packet);
+    clock.AdvanceTime(TimeDelta::Millis(1));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RtcpReceiverCompoundPacket);
+
+// Feedback for `num_packets` packets received 1 ms apart, with every tenth
+// packet lost.
+rtcp::TransportFeedback TransportFeedback(int num_packets) {
+  rtcp::TransportFeedback feedback;
+  feedback.SetSenderSsrc(kReceiverSsrc);
+  feedback.SetMediaSsrc(kSenderSsrc);
+  const Timestamp base_time = Timestamp::Seconds(1000);
+  feedback.SetBase(/*base_sequence=*/1, base_time);
+  for (int i = 0; i < num_packets; ++i) {
+    if (i % 10 == 9) {
+      continue;
+    }
+    feedback.AddReceivedPacket(static_cast<uint16_t>(1 + i),
+                               base_time + TimeDelta::Millis(i));
+  }
+  return feedback;
+}
+
+void BM_BuildTransportFeedback(benchmark::State& state) {
+  const int num_packets = static_cast<int>(state.range(0));
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    rtc::Buffer buffer = TransportFeedback(num_packets).Build();
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetItemsProcessed(state.iterations() * num_packets);
+}
+BENCHMARK(BM_BuildTransportFeedback)->Arg(10)->Arg(100)->Arg(1000);
+
+void BM_ParseTransportFeedback(benchmark::State& state) {
+  const int num_packets = static_cast<int>(state.range(0));
+  const rtc::Buffer buffer = TransportFeedback(num_packets).Build();
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    rtcp::CommonHeader header;
+    header.Parse(buffer.data(), buffer.size());
+    rtcp::TransportFeedback feedback;
+    bool parsed = feedback.Parse(header);
+    benchmark::DoNotOptimize(parsed);
+  }
+  state.SetItemsProcessed(state.iterations() * num_packets);
+}
+BENCHMARK(BM_ParseTransportFeedback)->Arg(10)->Arg(100)->Arg(1000);
+
+// Inserts frames of `state.range(0)` packets, in order. Each packet which
+// completes a frame also assembles it.
+void BM_PacketBufferInsertPacket(benchmark::State& state) {
+  const int packets_per_frame = static_cast<int>(state.range(0));
+  video_coding::PacketBuffer packet_buffer(/*start_buffer_size=*/512,
+                                           /*max_buffer_size=*/2048);
+  const rtc::CopyOnWriteBuffer payload(kPayloadSize);
+  uint16_t seq_num = 0;
+  uint32_t timestamp = 0;
+  int packet_in_frame = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    auto packet = std::make_unique<video_coding::PacketBuffer::Packet>();
+    packet->payload_type = kPayloadType;
+    packet->seq_num = seq_num++;
+    packet->timestamp = timestamp;
+    packet->video_payload = payload;
+    packet->video_header.codec = kVideoCodecGeneric;
+    packet->video_header.frame_type = VideoFrameType::kVideoFrameDelta;
+    packet->video_header.is_first_packet_in_frame = packet_in_frame == 0;
+    packet->video_header.is_last_packet_in_frame =
+        packet_in_frame == packets_per_frame - 1;
+    packet->marker_bit = packet->video_header.is_last_packet_in_frame;
+    video_coding::PacketBuffer::InsertResult result =
+        packet_buffer.InsertPacket(std::move(packet));
+    benchmark::DoNotOptimize(result.packets.data());
+    if (++packet_in_frame == packets_per_frame) {
+      // As done by the receiver once the frame has been assembled.
+      packet_buffer.ClearTo(seq_num - 1);
+      packet_in_frame = 0;
+      timestamp += 3000;
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PacketBufferInsertPacket)->Arg(1)->Arg(10);
+
+// Packetizes a frame of `state.range(1)` bytes, with the packetizer selected
+// by `state.range(0)`.
+void BM_PacketizeVideo(benchmark::State& state) {
+  const auto codec = static_cast<VideoCodecType>(state.range(0));
+  const std::vector<uint8_t> frame(state.range(1), 0x55);
+  RTPVideoHeader video_header;
+  video_header.codec = codec;
+  video_header.frame_type = VideoFrameType::kVideoFrameDelta;
+  if (codec == kVideoCodecVP8) {
+    video_header.video_type_header.emplace<RTPVideoHeaderVP8>()
+        .InitRTPVideoHeaderVP8();
+  }
+  RtpPacketToSend packet(/*extensions=*/nullptr);
+  int64_t num_packets = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    std::unique_ptr<RtpPacketizer> packetizer = RtpPacketizer::Create(
+        codec == kVideoCodecGeneric ? absl::nullopt
+                                    : absl::make_optional(codec),
+        frame, RtpPacketizer::PayloadSizeLimits(), video_header);
+    while (packetizer->NextPacket(&packet)) {
+      benchmark::DoNotOptimize(packet.data());
+      ++num_packets;
+    }
+  }
+  state.SetItemsProcessed(num_packets);
+}
+BENCHMARK(BM_PacketizeVideo)
+    ->Args({kVideoCodecGeneric, 1000})
+    ->Args({kVideoCodecGeneric, 50'000})
+    ->Args({kVideoCodecVP8, 1000})
+    ->Args({kVideoCodecVP8, 50'000});
+
+// Stores payloads in a store shared by all benchmark threads, as packet
+// histories on different network threads do, keeping the last
+// `kSharedPayloadsPerThread` of them referenced like a history would.
+void BM_SharedRtpPayloadStoreAdd(benchmark::State& state) {
+  constexpr size_t kSharedPayloadsPerThread = 512;
+  static SharedRtpPayloadStore* const store =
+      rtc::make_ref_counted<SharedRtpPayloadStore>().release();
+  std::vector<uint8_t> payload(kPayloadSize, 0x55);
+  payload[0] = static_cast<uint8_t>(state.thread_index());
+  std::vector<SharedRtpPayloadStore::Payload> stored(kSharedPayloadsPerThread);
+  uint32_t counter = 0;
+  for (auto s : state) {
+    RTC_UNUSED(s);
+    memcpy(&payload[1], &counter, sizeof(counter));
+    stored[counter % kSharedPayloadsPerThread] = store->Add(payload);
+    ++counter;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SharedRtpPayloadStoreAdd)->Threads(1)->Threads(4)->ThreadPerCpu();
+
+}  // namespace
+}  // namespace webrtc
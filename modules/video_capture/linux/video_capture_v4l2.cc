@@ -21,13 +21,21 @@
 #include <time.h>
 #include <unistd.h>
 
+#include <functional>
 #include <new>
 #include <string>
+#include <utility>
+#include <vector>
 
+#include "api/make_ref_counted.h"
+#include "api/ref_counted_base.h"
 #include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
+#include "common_video/include/video_frame_buffer.h"
 #include "media/base/video_common.h"
 #include "modules/video_capture/video_capture.h"
 #include "rtc_base/logging.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
 
 // These defines are here to support building on kernel 3.16 which some
 // downstream projects, e.g. Firefox, use.
@@ -49,13 +57,108 @@
 
 namespace webrtc {
 namespace videocapturemodule {
+namespace {
+
+// NV12 frame in a mapped capture buffer, which is handed back by calling
+// `no_longer_used` when the frame buffer is destroyed.
+class WrappedNV12Buffer : public NV12BufferInterface {
+ public:
+  WrappedNV12Buffer(int width,
+                    int height,
+                    const uint8_t* y_plane,
+                    int y_stride,
+                    const uint8_t* uv_plane,
+                    int uv_stride,
+                    std::function<void()> no_longer_used)
+      : width_(width),
+        height_(height),
+        y_plane_(y_plane),
+        uv_plane_(uv_plane),
+        y_stride_(y_stride),
+        uv_stride_(uv_stride),
+        no_longer_used_cb_(std::move(no_longer_used)) {}
+  ~WrappedNV12Buffer() override { no_longer_used_cb_(); }
+
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+  const uint8_t* DataY() const override { return y_plane_; }
+  const uint8_t* DataUV() const override { return uv_plane_; }
+  int StrideY() const override { return y_stride_; }
+  int StrideUV() const override { return uv_stride_; }
+
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override {
+    rtc::scoped_refptr<I420Buffer> i420_buffer =
+        I420Buffer::Create(width_, height_);
+    libyuv::NV12ToI420(y_plane_, y_stride_, uv_plane_, uv_stride_,
+                       i420_buffer->MutableDataY(), i420_buffer->StrideY(),
+                       i420_buffer->MutableDataU(), i420_buffer->StrideU(),
+                       i420_buffer->MutableDataV(), i420_buffer->StrideV(),
+                       width_, height_);
+    return i420_buffer;
+  }
+
+ private:
+  const int width_;
+  const int height_;
+  const uint8_t* const y_plane_;
+  const uint8_t* const uv_plane_;
+  const int y_stride_;
+  const int uv_stride_;
+  std::function<void()> no_longer_used_cb_;
+};
+
+}  // namespace
+
+// Mapped buffers of a capture session. Frames delivered without copying hold
+// a reference, so the buffers stay mapped until the last of them is released,
+// even if the session has ended by then. Buffers released while the session
+// is running are queued in the driver again by the capture thread.
+class VideoCaptureModuleV4L2::BufferPool
+    : public rtc::RefCountedNonVirtual<BufferPool> {
+ public:
+  struct Buffer {
+    void* start = MAP_FAILED;
+    size_t length = 0;
+  };
+
+  explicit BufferPool(size_t size) : buffers_(size) {}
+  ~BufferPool() {
+    for (const Buffer& buffer : buffers_) {
+      if (buffer.start != MAP_FAILED)
+        munmap(buffer.start, buffer.length);
+    }
+  }
+
+  Buffer& buffer(int index) { return buffers_[index]; }
+
+  // Called on the thread that releases the frame.
+  void ReturnBuffer(int index) {
+    MutexLock lock(&mutex_);
+    released_.push_back(index);
+  }
+
+  std::vector<int> TakeReturnedBuffers() {
+    MutexLock lock(&mutex_);
+    return std::exchange(released_, {});
+  }
+
+  // Number of buffers held by delivered frames, counting the released ones
+  // until they are queued again. Used on the capture thread.
+  int delivered = 0;
+
+ private:
+  std::vector<Buffer> buffers_;
+  Mutex mutex_;
+  std::vector<int> released_ RTC_GUARDED_BY(mutex_);
+};
+
 VideoCaptureModuleV4L2::VideoCaptureModuleV4L2()
     : VideoCaptureImpl(),
       _deviceId(-1),
       _deviceFd(-1),
       _buffersAllocatedByDevice(-1),
-      _captureStarted(false),
-      _pool(NULL) {}
+      bytes_per_line_(0),
+      _captureStarted(false) {}
 
 int32_t VideoCaptureModuleV4L2::Init(const char* deviceUniqueIdUTF8) {
   RTC_DCHECK_RUN_ON(&api_checker_);
@@ -233,6 +336,7 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
   // initialize current width and height
   configured_capability_.width = video_fmt.fmt.pix.width;
   configured_capability_.height = video_fmt.fmt.pix.height;
+  bytes_per_line_ = video_fmt.fmt.pix.bytesperline;
 
   // Trying to set frame rate, before check driver capability.
   bool driver_framerate_support = true;
@@ -347,7 +451,7 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
   _buffersAllocatedByDevice = rbuffer.count;
 
   // Map the buffers
-  _pool = new Buffer[rbuffer.count];
+  pool_ = rtc::make_ref_counted<BufferPool>(rbuffer.count);
 
   for (unsigned int i = 0; i < rbuffer.count; i++) {
     struct v4l2_buffer buffer;
@@ -357,21 +461,24 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
     buffer.index = i;
 
     if (ioctl(_deviceFd, VIDIOC_QUERYBUF, &buffer) < 0) {
+      pool_ = nullptr;
       return false;
     }
 
-    _pool[i].start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
-                          MAP_SHARED, _deviceFd, buffer.m.offset);
+    BufferPool::Buffer& mapped = pool_->buffer(i);
+    mapped.start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, _deviceFd, buffer.m.offset);
 
-    if (MAP_FAILED == _pool[i].start) {
-      for (unsigned int j = 0; j < i; j++)
-        munmap(_pool[j].start, _pool[j].length);
+    if (MAP_FAILED == mapped.start) {
+      // Unmaps the buffers mapped so far.
+      pool_ = nullptr;
       return false;
     }
 
-    _pool[i].length = buffer.length;
+    mapped.length = buffer.length;
 
     if (ioctl(_deviceFd, VIDIOC_QBUF, &buffer) < 0) {
+      pool_ = nullptr;
       return false;
     }
   }
@@ -380,12 +487,6 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
 
 bool VideoCaptureModuleV4L2::DeAllocateVideoBuffers() {
   RTC_CHECK_RUNS_SERIALIZED(&capture_checker_);
-  // unmap buffers
-  for (int i = 0; i < _buffersAllocatedByDevice; i++)
-    munmap(_pool[i].start, _pool[i].length);
-
-  delete[] _pool;
-
   // turn off stream
   enum v4l2_buf_type type;
   type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -393,9 +494,71 @@ bool VideoCaptureModuleV4L2::DeAllocateVideoBuffers() {
     RTC_LOG(LS_INFO) << "VIDIOC_STREAMOFF error. errno: " << errno;
   }
 
+  // unmap buffers, once released by the frames that still use them
+  pool_ = nullptr;
+
   return true;
 }
 
+rtc::scoped_refptr<VideoFrameBuffer> VideoCaptureModuleV4L2::WrapCaptureBuffer(
+    int index,
+    size_t bytes_used) {
+  RTC_CHECK_RUNS_SERIALIZED(&capture_checker_);
+  const VideoType video_type = configured_capability_.videoType;
+  if (video_type != VideoType::kI420 && video_type != VideoType::kNV12) {
+    return nullptr;
+  }
+  if (pool_->delivered >= _buffersAllocatedByDevice - kNoOfQueuedV4L2Buffers) {
+    return nullptr;
+  }
+
+  const int width = configured_capability_.width;
+  const int height = configured_capability_.height;
+  const int stride_y = bytes_per_line_;
+  // Chroma planes of YUV420 have half the stride of the luma plane, and the
+  // interleaved chroma plane of NV12 has the same.
+  const int stride_uv = video_type == VideoType::kI420 ? stride_y / 2
+                                                       : stride_y;
+  const int chroma_height = (height + 1) / 2;
+  const size_t size_y = static_cast<size_t>(stride_y) * height;
+  const size_t size_uv = static_cast<size_t>(stride_uv) * chroma_height;
+  const size_t size =
+      size_y + (video_type == VideoType::kI420 ? 2 * size_uv : size_uv);
+  if (width <= 0 || height <= 0 || stride_y < width || bytes_used < size) {
+    return nullptr;
+  }
+
+  const uint8_t* data =
+      static_cast<const uint8_t*>(pool_->buffer(index).start);
+  ++pool_->delivered;
+  std::function<void()> no_longer_used = [pool = pool_, index] {
+    pool->ReturnBuffer(index);
+  };
+  if (video_type == VideoType::kNV12) {
+    return rtc::make_ref_counted<WrappedNV12Buffer>(
+        width, height, data, stride_y, data + size_y, stride_uv,
+        std::move(no_longer_used));
+  }
+  return WrapI420Buffer(width, height, data, stride_y, data + size_y,
+                        stride_uv, data + size_y + size_uv, stride_uv,
+                        std::move(no_longer_used));
+}
+
+void VideoCaptureModuleV4L2::RequeueReleasedBuffers() {
+  RTC_CHECK_RUNS_SERIALIZED(&capture_checker_);
+  for (int index : pool_->TakeReturnedBuffers()) {
+    --pool_->delivered;
+    struct v4l2_buffer buf;
+    memset(&buf, 0, sizeof(struct v4l2_buffer));
+    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index = index;
+    if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
+      RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+    }
+  }
+}
+
 bool VideoCaptureModuleV4L2::CaptureStarted() {
   RTC_CHECK_RUNS_SERIALIZED(&capture_checker_);
   return _captureStarted;
@@ -435,6 +598,8 @@ bool VideoCaptureModuleV4L2::CaptureProcess() {
     }
 
     if (_captureStarted) {
+      RequeueReleasedBuffers();
+
       struct v4l2_buffer buf;
       memset(&buf, 0, sizeof(struct v4l2_buffer));
       buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -448,12 +613,19 @@ bool VideoCaptureModuleV4L2::CaptureProcess() {
         }
       }
 
-      // convert to to I420 if needed
-      IncomingFrame(reinterpret_cast<uint8_t*>(_pool[buf.index].start),
-                    buf.bytesused, configured_capability_);
-      // enqueue the buffer again
-      if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
-        RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+      // I420 and NV12 frames are delivered in the capture buffer, which is
+      // queued again once released.
+      rtc::scoped_refptr<VideoFrameBuffer> frame_buffer =
+          WrapCaptureBuffer(buf.index, buf.bytesused);
+      if (!frame_buffer || IncomingFrameBuffer(frame_buffer) != 0) {
+        // convert to to I420 if needed
+        IncomingFrame(
+            reinterpret_cast<uint8_t*>(pool_->buffer(buf.index).start),
+            buf.bytesused, configured_capability_);
+        // enqueue the buffer again, unless it is queued once released
+        if (!frame_buffer && ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
+          RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+        }
       }
     }
   }
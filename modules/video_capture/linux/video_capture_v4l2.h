@@ -16,6 +16,8 @@
 
 #include <memory>
 
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
 #include "modules/video_capture/video_capture_defines.h"
 #include "modules/video_capture/video_capture_impl.h"
 #include "rtc_base/platform_thread.h"
@@ -35,11 +37,23 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
 
  private:
   enum { kNoOfV4L2Bufffers = 4 };
+  // Number of buffers kept queued in the driver while the others are
+  // delivered without copying.
+  enum { kNoOfQueuedV4L2Buffers = 2 };
+
+  class BufferPool;
 
   static void CaptureThread(void*);
   bool CaptureProcess();
   bool AllocateVideoBuffers() RTC_EXCLUSIVE_LOCKS_REQUIRED(capture_lock_);
   bool DeAllocateVideoBuffers() RTC_EXCLUSIVE_LOCKS_REQUIRED(capture_lock_);
+  // Wraps the dequeued buffer `index` into a frame buffer that queues it in
+  // the driver again once released. Returns null if the frame has to be
+  // converted, or if too few buffers would be left queued in the driver.
+  rtc::scoped_refptr<VideoFrameBuffer> WrapCaptureBuffer(int index,
+                                                         size_t bytes_used)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(capture_lock_);
+  void RequeueReleasedBuffers() RTC_EXCLUSIVE_LOCKS_REQUIRED(capture_lock_);
 
   rtc::PlatformThread _captureThread RTC_GUARDED_BY(api_checker_);
   Mutex capture_lock_ RTC_ACQUIRED_BEFORE(api_lock_);
@@ -50,12 +64,9 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
   int32_t _buffersAllocatedByDevice RTC_GUARDED_BY(capture_lock_);
   VideoCaptureCapability configured_capability_
       RTC_GUARDED_BY(capture_checker_);
+  int32_t bytes_per_line_ RTC_GUARDED_BY(capture_checker_);
   bool _captureStarted RTC_GUARDED_BY(capture_checker_);
-  struct Buffer {
-    void* start;
-    size_t length;
-  };
-  Buffer* _pool RTC_GUARDED_BY(capture_lock_);
+  rtc::scoped_refptr<BufferPool> pool_ RTC_GUARDED_BY(capture_lock_);
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
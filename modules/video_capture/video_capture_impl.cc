@@ -13,6 +13,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <utility>
+
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame_buffer.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
@@ -234,6 +236,33 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
   return 0;
 }
 
+int32_t VideoCaptureImpl::IncomingFrameBuffer(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    int64_t captureTime /*=0*/) {
+  RTC_CHECK_RUNS_SERIALIZED(&capture_checker_);
+  MutexLock lock(&api_lock_);
+
+  if (_rawDataCallBack ||
+      (apply_rotation_ && _rotateFrame != kVideoRotation_0)) {
+    return -1;
+  }
+
+  TRACE_EVENT1("webrtc", "VC::IncomingFrameBuffer", "capture_time",
+               captureTime);
+
+  VideoFrame captureFrame = VideoFrame::Builder()
+                                .set_video_frame_buffer(std::move(buffer))
+                                .set_timestamp_rtp(0)
+                                .set_timestamp_ms(rtc::TimeMillis())
+                                .set_rotation(_rotateFrame)
+                                .build();
+  captureFrame.set_ntp_time_ms(captureTime);
+
+  DeliverCapturedFrame(captureFrame);
+
+  return 0;
+}
+
 int32_t VideoCaptureImpl::StartCapture(
     const VideoCaptureCapability& capability) {
   RTC_DCHECK_RUN_ON(&api_checker_);
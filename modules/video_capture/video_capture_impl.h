@@ -21,6 +21,7 @@
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
 #include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "api/video/video_sink_interface.h"
 #include "modules/video_capture/video_capture.h"
@@ -78,6 +79,14 @@ class RTC_EXPORT VideoCaptureImpl : public VideoCaptureModule {
                         const VideoCaptureCapability& frameInfo,
                         int64_t captureTime = 0);
 
+  // Delivers `buffer` as is, for capture devices that produce frames that
+  // need no conversion. Returns -1 without delivering the frame if it does
+  // need conversion, i.e. when rotation is applied by the capture module or a
+  // raw data callback is registered, in which case the caller should use
+  // IncomingFrame() instead.
+  int32_t IncomingFrameBuffer(rtc::scoped_refptr<VideoFrameBuffer> buffer,
+                              int64_t captureTime = 0);
+
   // Platform dependent
   int32_t StartCapture(const VideoCaptureCapability& capability) override;
   int32_t StopCapture() override;
@@ -10,8 +10,6 @@
 
 #include "modules/video_coding/codecs/av1/dav1d_decoder.h"
 
-#include <algorithm>
-
 #include "api/scoped_refptr.h"
 #include "api/video/encoded_image.h"
 #include "api/video/video_frame_buffer.h"
@@ -84,7 +82,7 @@ bool Dav1dDecoder::Configure(const Settings& settings) {
   Dav1dSettings s;
   dav1d_default_settings(&s);
 
-  s.n_threads = std::max(2, settings.number_of_cores());
+  s.n_threads = settings.number_of_cores();
   s.max_frame_delay = 1;   // For low latency decoding.
   s.all_layers = 0;        // Don't output a frame for every spatial layer.
   s.operating_point = 31;  // Decode all operating points.
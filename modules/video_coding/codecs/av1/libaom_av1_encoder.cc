@@ -12,6 +12,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -29,11 +30,13 @@
 #include "api/video_codecs/scalability_mode.h"
 #include "api/video_codecs/video_codec.h"
 #include "api/video_codecs/video_encoder.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/include/video_error_codes.h"
 #include "modules/video_coding/svc/create_scalability_structure.h"
 #include "modules/video_coding/svc/scalable_video_controller.h"
 #include "modules/video_coding/svc/scalable_video_controller_no_layering.h"
+#include "modules/video_coding/utility/active_map_tracker.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
 #include "rtc_base/logging.h"
@@ -103,7 +106,10 @@ class LibaomAv1Encoder final : public VideoEncoder {
   int GetCpuSpeed(int width, int height);
 
   // Determine number of encoder threads to use.
-  int NumberOfThreads(int width, int height, int number_of_cores);
+  int NumberOfThreads(int width,
+                      int height,
+                      int number_of_cores,
+                      ParallelismPolicy parallelism_policy);
 
   bool SvcEnabled() const { return svc_params_.has_value(); }
   // Fills svc_params_ memeber value. Returns false on error.
@@ -116,6 +122,9 @@ class LibaomAv1Encoder final : public VideoEncoder {
       const ScalableVideoController::LayerFrameConfig& layer_frame);
   // If pixel format doesn't match, then reallocate.
   void MaybeRewrapImgWithFormat(const aom_img_fmt_t fmt);
+  // Lets the encoder skip the blocks which haven't changed since its last
+  // encoded frame, when screensharing without spatial or temporal layers.
+  void MaybeSetActiveMap(bool keyframe);
 
   std::unique_ptr<ScalableVideoController> svc_controller_;
   absl::optional<ScalabilityMode> scalability_mode_;
@@ -128,11 +137,15 @@ class LibaomAv1Encoder final : public VideoEncoder {
   aom_codec_ctx_t ctx_;
   aom_codec_enc_cfg_t cfg_;
   EncodedImageCallback* encoded_image_callback_;
+  EncodedImageBufferPool encoded_image_buffer_pool_;
+  ActiveMapTracker active_map_tracker_;
   int64_t timestamp_;
   const LibaomAv1EncoderInfoSettings encoder_info_override_;
   // TODO(webrtc:15225): Kill switch for disabling frame dropping. Remove it
   // after frame dropping is fully rolled out.
   bool disable_frame_dropping_;
+  // Whether active maps are set when screensharing, see ActiveMapTracker.
+  const bool use_active_map_;
 };
 
 int32_t VerifyCodecSettings(const VideoCodec& codec_settings) {
@@ -174,7 +187,8 @@ LibaomAv1Encoder::LibaomAv1Encoder(
       timestamp_(0),
       disable_frame_dropping_(absl::StartsWith(
           trials.Lookup("WebRTC-LibaomAv1Encoder-DisableFrameDropping"),
-          "Enabled")) {}
+          "Enabled")),
+      use_active_map_(trials.IsEnabled(ActiveMapTracker::kFieldTrial)) {}
 
 LibaomAv1Encoder::~LibaomAv1Encoder() {
   Release();
@@ -212,6 +226,7 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
     RTC_LOG(LS_WARNING) << "Scalability mode is not set, using 'L1T1'.";
     scalability_mode_ = ScalabilityMode::kL1T1;
   }
+  active_map_tracker_ = ActiveMapTracker();
   svc_controller_ = CreateScalabilityStructure(*scalability_mode_);
   if (svc_controller_ == nullptr) {
     RTC_LOG(LS_WARNING) << "Failed to set scalability mode "
@@ -235,8 +250,8 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
   // Overwrite default config with input encoder settings & RTC-relevant values.
   cfg_.g_w = encoder_settings_.width;
   cfg_.g_h = encoder_settings_.height;
-  cfg_.g_threads =
-      NumberOfThreads(cfg_.g_w, cfg_.g_h, settings.number_of_cores);
+  cfg_.g_threads = NumberOfThreads(cfg_.g_w, cfg_.g_h, settings.number_of_cores,
+                                   settings.parallelism_policy);
   cfg_.g_timebase.num = 1;
   cfg_.g_timebase.den = kRtpTicksPerSecond;
   cfg_.rc_target_bitrate = encoder_settings_.startBitrate;  // kilobits/sec.
@@ -297,20 +312,13 @@ int LibaomAv1Encoder::InitEncode(const VideoCodec* codec_settings,
     SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_ENABLE_PALETTE, 0);
   }
 
-  if (cfg_.g_threads == 8) {
-    // Values passed to AV1E_SET_TILE_ROWS and AV1E_SET_TILE_COLUMNS are log2()
-    // based.
-    // Use 4 tile columns x 2 tile rows for 8 threads.
-    SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_TILE_ROWS, 1);
-    SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_TILE_COLUMNS, 2);
-  } else if (cfg_.g_threads == 4) {
-    // Use 2 tile columns x 2 tile rows for 4 threads.
-    SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_TILE_ROWS, 1);
-    SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_TILE_COLUMNS, 1);
-  } else {
-    SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_TILE_COLUMNS,
-                                      static_cast<int>(log2(cfg_.g_threads)));
-  }
+  // Values passed to AV1E_SET_TILE_ROWS and AV1E_SET_TILE_COLUMNS are log2()
+  // based. Use one tile per thread, with at least as many tile columns as
+  // rows, e.g. 4 tile columns x 2 tile rows for 8 threads.
+  const int log2_threads = static_cast<int>(log2(cfg_.g_threads));
+  SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_TILE_ROWS, log2_threads / 2);
+  SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_TILE_COLUMNS,
+                                    log2_threads - log2_threads / 2);
 
   SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_ROW_MT, 1);
   SET_ENCODER_PARAM_OR_RETURN_ERROR(AV1E_SET_ENABLE_OBMC, 0);
@@ -406,10 +414,21 @@ int LibaomAv1Encoder::GetCpuSpeed(int width, int height) {
 
 int LibaomAv1Encoder::NumberOfThreads(int width,
                                       int height,
-                                      int number_of_cores) {
+                                      int number_of_cores,
+                                      ParallelismPolicy parallelism_policy) {
   // Keep the number of encoder threads equal to the possible number of
-  // column/row tiles, which is (1, 2, 4, 8). See comments below for
+  // column/row tiles, which is a power of two. See comments below for
   // AV1E_SET_TILE_COLUMNS/ROWS.
+  if (parallelism_policy == ParallelismPolicy::kLowLatency) {
+    // Use as many threads as there are cores, up to 16 for 4 tile columns x
+    // 4 tile rows, with tiles of at least 320x180 pixels.
+    int threads = 1;
+    while (threads * 2 <= std::min(number_of_cores, 16) &&
+           threads * 2 * 320 * 180 <= width * height) {
+      threads *= 2;
+    }
+    return threads;
+  }
   if (width * height > 1280 * 720 && number_of_cores > 8) {
     return 8;
   } else if (width * height >= 640 * 360 && number_of_cores > 4) {
@@ -550,6 +569,26 @@ void LibaomAv1Encoder::MaybeRewrapImgWithFormat(const aom_img_fmt_t fmt) {
   // else no-op since the image is already in the right format.
 }
 
+void LibaomAv1Encoder::MaybeSetActiveMap(bool keyframe) {
+  if (!use_active_map_ ||
+      encoder_settings_.mode != VideoCodecMode::kScreensharing ||
+      SvcEnabled()) {
+    return;
+  }
+  aom_active_map_t active_map = {
+      .active_map = nullptr,
+      .rows = (cfg_.g_h + ActiveMapTracker::kBlockSize - 1) /
+              ActiveMapTracker::kBlockSize,
+      .cols = (cfg_.g_w + ActiveMapTracker::kBlockSize - 1) /
+              ActiveMapTracker::kBlockSize};
+  // A null map disables the active map, as needed for key frames.
+  std::vector<uint8_t> map;
+  if (!keyframe && active_map_tracker_.GetActiveMap(cfg_.g_w, cfg_.g_h, map)) {
+    active_map.active_map = map.data();
+  }
+  SetEncoderControlParameters(AOME_SET_ACTIVEMAP, &active_map);
+}
+
 int32_t LibaomAv1Encoder::Encode(
     const VideoFrame& frame,
     const std::vector<VideoFrameType>* frame_types) {
@@ -557,6 +596,8 @@ int32_t LibaomAv1Encoder::Encode(
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
   }
 
+  active_map_tracker_.OnInputFrame(frame);
+
   bool keyframe_required =
       frame_types != nullptr &&
       absl::c_linear_search(*frame_types, VideoFrameType::kVideoFrameKey);
@@ -669,6 +710,7 @@ int32_t LibaomAv1Encoder::Encode(
       SetSvcLayerId(*layer_frame);
       SetSvcRefFrameConfig(*layer_frame);
     }
+    MaybeSetActiveMap(layer_frame->IsKeyframe());
 
     // Encode a frame. The presentation timestamp `pts` should not use real
     // timestamps from frames or the wall clock, as that can cause the rate
@@ -692,12 +734,13 @@ int32_t LibaomAv1Encoder::Encode(
     while (const aom_codec_cx_pkt_t* pkt =
                aom_codec_get_cx_data(&ctx_, &iter)) {
       if (pkt->kind == AOM_CODEC_CX_FRAME_PKT && pkt->data.frame.sz > 0) {
+        active_map_tracker_.OnFrameEncoded();
         if (data_pkt_count > 0) {
           RTC_LOG(LS_WARNING) << "LibaomAv1Encoder::Encoder returned more than "
                                  "one data packet for an input video frame.";
           Release();
         }
-        encoded_image.SetEncodedData(EncodedImageBuffer::Create(
+        encoded_image.SetEncodedData(encoded_image_buffer_pool_.Create(
             /*data=*/static_cast<const uint8_t*>(pkt->data.frame.buf),
             /*size=*/pkt->data.frame.sz));
 
@@ -57,9 +57,20 @@ enum H264EncoderImplEvent {
 };
 
 int NumberOfThreads(absl::optional<int> encoder_thread_limit,
+                    VideoEncoder::ParallelismPolicy parallelism_policy,
                     int width,
                     int height,
                     int number_of_cores) {
+  if (parallelism_policy == VideoEncoder::ParallelismPolicy::kLowLatency) {
+    // One slice per thread, up to 8 threads, with slices of at least 4 rows
+    // of macroblocks.
+    int threads = std::min({number_of_cores, 8, height / 64});
+    if (encoder_thread_limit.has_value()) {
+      RTC_DCHECK_GE(encoder_thread_limit.value(), 1);
+      threads = std::min(threads, encoder_thread_limit.value());
+    }
+    return std::max(threads, 1);
+  }
   // TODO(hbos): In Chromium, multiple threads do not work with sandbox on Mac,
   // see crbug.com/583348. Until further investigated, only use one thread.
   // While this limitation is gone, this changes the bitstream format (see
@@ -121,14 +132,16 @@ absl::optional<ScalabilityMode> ScalabilityModeFromTemporalLayers(
 
 // Helper method used by H264EncoderImpl::Encode.
 // Copies the encoded bytes from `info` to `encoded_image`. The
-// `encoded_image->_buffer` may be deleted and reallocated if a bigger buffer is
-// required.
+// `encoded_image->_buffer` is replaced by a buffer from `buffer_pool` large
+// enough to hold the encoded data.
 //
 // After OpenH264 encoding, the encoded bytes are stored in `info` spread out
 // over a number of layers and "NAL units". Each NAL unit is a fragment starting
 // with the four-byte start code {0,0,0,1}. All of this data (including the
 // start codes) is copied to the `encoded_image->_buffer`.
-static void RtpFragmentize(EncodedImage* encoded_image, SFrameBSInfo* info) {
+static void RtpFragmentize(EncodedImage* encoded_image,
+                           SFrameBSInfo* info,
+                           EncodedImageBufferPool& buffer_pool) {
   // Calculate minimum buffer size required to hold encoded data.
   size_t required_capacity = 0;
   size_t fragments_count = 0;
@@ -142,7 +155,7 @@ static void RtpFragmentize(EncodedImage* encoded_image, SFrameBSInfo* info) {
       required_capacity += layerInfo.pNalLengthInByte[nal];
     }
   }
-  auto buffer = EncodedImageBuffer::Create(required_capacity);
+  auto buffer = buffer_pool.Create(required_capacity);
   encoded_image->SetEncodedData(buffer);
 
   // Iterate layers and NAL units, note each NAL unit as a fragment and copy
@@ -237,6 +250,7 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* inst,
   max_payload_size_ = settings.max_payload_size;
   number_of_cores_ = settings.number_of_cores;
   encoder_thread_limit_ = settings.encoder_thread_limit;
+  parallelism_policy_ = settings.parallelism_policy;
   codec_ = *inst;
 
   // Code expects simulcastStream resolutions to be correct, make sure they are
@@ -540,7 +554,7 @@ int32_t H264EncoderImpl::Encode(
 
     // Split encoded image up into fragments. This also updates
     // `encoded_image_`.
-    RtpFragmentize(&encoded_images_[i], &info);
+    RtpFragmentize(&encoded_images_[i], &info, encoded_image_buffer_pool_);
 
     // Encoder can skip frames to save bandwidth in which case
     // `encoded_images_[i]._length` == 0.
@@ -649,8 +663,9 @@ SEncParamExt H264EncoderImpl::CreateEncoderParams(size_t i) const {
   //  1: single thread (default value)
   // >1: number of threads
   encoder_params.iMultipleThreadIdc =
-      NumberOfThreads(encoder_thread_limit_, encoder_params.iPicWidth,
-                      encoder_params.iPicHeight, number_of_cores_);
+      NumberOfThreads(encoder_thread_limit_, parallelism_policy_,
+                      encoder_params.iPicWidth, encoder_params.iPicHeight,
+                      number_of_cores_);
   // The base spatial layer 0 is the only one we use.
   encoder_params.sSpatialLayers[0].iVideoWidth = encoder_params.iPicWidth;
   encoder_params.sSpatialLayers[0].iVideoHeight = encoder_params.iPicHeight;
@@ -687,7 +702,13 @@ SEncParamExt H264EncoderImpl::CreateEncoderParams(size_t i) const {
       // design it with cpu core number.
       // TODO(sprang): Set to 0 when we understand why the rate controller borks
       //               when uiSliceNum > 1.
-      encoder_params.sSpatialLayers[0].sSliceArgument.uiSliceNum = 1;
+      // Each slice is a NAL unit, which the packetizer starts on a new packet
+      // unless it's aggregated with others into a STAP-A, so slices encoded in
+      // parallel don't straddle packet boundaries.
+      encoder_params.sSpatialLayers[0].sSliceArgument.uiSliceNum =
+          parallelism_policy_ == ParallelismPolicy::kLowLatency
+              ? encoder_params.iMultipleThreadIdc
+              : 1;
       encoder_params.sSpatialLayers[0].sSliceArgument.uiSliceMode =
           SM_FIXEDSLCNUM_SLICE;
       break;
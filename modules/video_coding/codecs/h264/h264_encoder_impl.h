@@ -31,6 +31,7 @@
 #include "api/video_codecs/scalability_mode.h"
 #include "api/video_codecs/video_encoder.h"
 #include "common_video/h264/h264_bitstream_parser.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/video_coding/codecs/h264/include/h264.h"
 #include "modules/video_coding/svc/scalable_video_controller.h"
 #include "modules/video_coding/utility/quality_scaler.h"
@@ -102,6 +103,7 @@ class H264EncoderImpl : public H264Encoder {
   std::vector<rtc::scoped_refptr<I420Buffer>> downscaled_buffers_;
   std::vector<LayerConfig> configurations_;
   std::vector<EncodedImage> encoded_images_;
+  EncodedImageBufferPool encoded_image_buffer_pool_;
   std::vector<std::unique_ptr<ScalableVideoController>> svc_controllers_;
   absl::InlinedVector<absl::optional<ScalabilityMode>, kMaxSimulcastStreams>
       scalability_modes_;
@@ -111,6 +113,7 @@ class H264EncoderImpl : public H264Encoder {
   size_t max_payload_size_;
   int32_t number_of_cores_;
   absl::optional<int> encoder_thread_limit_;
+  ParallelismPolicy parallelism_policy_ = ParallelismPolicy::kDefault;
   EncodedImageCallback* encoded_image_callback_;
 
   bool has_reported_init_;
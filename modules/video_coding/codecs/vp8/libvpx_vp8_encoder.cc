@@ -317,7 +317,8 @@ LibvpxVp8Encoder::LibvpxVp8Encoder(std::unique_ptr<LibvpxInterface> interface,
       variable_framerate_experiment_(ParseVariableFramerateConfig(
           "WebRTC-VP8VariableFramerateScreenshare")),
       framerate_controller_(variable_framerate_experiment_.framerate_limit),
-      max_frame_drop_interval_(ParseFrameDropInterval()) {
+      max_frame_drop_interval_(ParseFrameDropInterval()),
+      use_active_map_(field_trial::IsEnabled(ActiveMapTracker::kFieldTrial)) {
   // TODO(eladalon/ilnik): These reservations might be wasting memory.
   // InitEncode() is resizing to the actual size, which might be smaller.
   raw_images_.reserve(kMaxSimulcastStreams);
@@ -551,6 +552,7 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
   }
 
   encoded_images_.resize(number_of_streams);
+  active_map_trackers_.assign(number_of_streams, ActiveMapTracker());
   encoders_.resize(number_of_streams);
   vpx_configs_.resize(number_of_streams);
   config_overrides_.resize(number_of_streams);
@@ -988,6 +990,10 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
   if (encoded_complete_callback_ == NULL)
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
 
+  for (ActiveMapTracker& active_map_tracker : active_map_trackers_) {
+    active_map_tracker.OnInputFrame(frame);
+  }
+
   bool key_frame_requested = false;
   for (size_t i = 0; i < key_frame_request_.size() && i < send_stream_.size();
        ++i) {
@@ -1111,6 +1117,7 @@ int LibvpxVp8Encoder::Encode(const VideoFrame& frame,
                            static_cast<int>(flags[stream_idx]));
     libvpx_->codec_control(&encoders_[i], VP8E_SET_TEMPORAL_LAYER_ID,
                            tl_configs[i].encoder_layer_id);
+    MaybeSetActiveMap(i, send_key_frame);
   }
   // TODO(holmer): Ideally the duration should be the timestamp diff of this
   // frame and the next frame to be encoded, which we don't have. Instead we
@@ -1215,7 +1222,7 @@ int LibvpxVp8Encoder::GetEncodedPartitions(const VideoFrame& input_image,
       }
     }
 
-    auto buffer = EncodedImageBuffer::Create(encoded_size);
+    auto buffer = encoded_image_buffer_pool_.Create(encoded_size);
 
     iter = NULL;
     size_t encoded_pos = 0;
@@ -1257,6 +1264,9 @@ int LibvpxVp8Encoder::GetEncodedPartitions(const VideoFrame& input_image,
     encoded_images_[encoder_idx].SetColorSpace(input_image.color_space());
     encoded_images_[encoder_idx].SetRetransmissionAllowed(
         retransmission_allowed);
+    if (encoded_images_[encoder_idx].size() > 0) {
+      active_map_trackers_[encoder_idx].OnFrameEncoded();
+    }
 
     if (send_stream_[stream_idx]) {
       if (encoded_images_[encoder_idx].size() > 0) {
@@ -1297,6 +1307,29 @@ int LibvpxVp8Encoder::GetEncodedPartitions(const VideoFrame& input_image,
   return result;
 }
 
+void LibvpxVp8Encoder::MaybeSetActiveMap(size_t encoder_idx, bool key_frame) {
+  if (!use_active_map_ || codec_.mode != VideoCodecMode::kScreensharing) {
+    return;
+  }
+  const vpx_codec_enc_cfg_t& config = vpx_configs_[encoder_idx];
+  vpx_active_map_t active_map = {
+      .active_map = nullptr,
+      .rows = (config.g_h + ActiveMapTracker::kBlockSize - 1) /
+              ActiveMapTracker::kBlockSize,
+      .cols = (config.g_w + ActiveMapTracker::kBlockSize - 1) /
+              ActiveMapTracker::kBlockSize};
+  // Skipped macroblocks are copied from the last frame, which is only the
+  // previous one without temporal layers. A null map disables the active map.
+  std::vector<uint8_t> map;
+  if (!key_frame && config.ts_number_layers <= 1 &&
+      active_map_trackers_[encoder_idx].GetActiveMap(config.g_w, config.g_h,
+                                                     map)) {
+    active_map.active_map = map.data();
+  }
+  libvpx_->codec_control(&encoders_[encoder_idx], VP8E_SET_ACTIVEMAP,
+                         &active_map);
+}
+
 VideoEncoder::EncoderInfo LibvpxVp8Encoder::GetEncoderInfo() const {
   EncoderInfo info;
   info.supports_native_handle = false;
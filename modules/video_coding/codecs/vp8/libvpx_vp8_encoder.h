@@ -23,9 +23,11 @@
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/vp8_frame_buffer_controller.h"
 #include "api/video_codecs/vp8_frame_config.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "modules/video_coding/codecs/interface/libvpx_interface.h"
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/utility/active_map_tracker.h"
 #include "modules/video_coding/utility/framerate_controller_deprecated.h"
 #include "modules/video_coding/utility/vp8_constants.h"
 #include "rtc_base/experiments/cpu_speed_experiment.h"
@@ -86,6 +88,10 @@ class LibvpxVp8Encoder : public VideoEncoder {
   int GetEncodedPartitions(const VideoFrame& input_image,
                            bool retransmission_allowed);
 
+  // Lets encoder `encoder_idx` skip the macroblocks which haven't changed since
+  // its last encoded frame, when screensharing.
+  void MaybeSetActiveMap(size_t encoder_idx, bool key_frame);
+
   // Set the stream state for stream `stream_idx`.
   void SetStreamState(bool send_stream, int stream_idx);
 
@@ -130,6 +136,8 @@ class LibvpxVp8Encoder : public VideoEncoder {
   std::vector<int> cpu_speed_;
   std::vector<vpx_image_t> raw_images_;
   std::vector<EncodedImage> encoded_images_;
+  std::vector<ActiveMapTracker> active_map_trackers_;
+  EncodedImageBufferPool encoded_image_buffer_pool_;
   std::vector<vpx_codec_ctx_t> encoders_;
   std::vector<vpx_codec_enc_cfg_t> vpx_configs_;
   std::vector<Vp8EncoderConfig> config_overrides_;
@@ -157,6 +165,9 @@ class LibvpxVp8Encoder : public VideoEncoder {
   const LibvpxVp8EncoderInfoSettings encoder_info_override_;
 
   absl::optional<TimeDelta> max_frame_drop_interval_;
+
+  // Whether active maps are set when screensharing, see ActiveMapTracker.
+  const bool use_active_map_;
 };
 
 }  // namespace webrtc
@@ -34,6 +34,7 @@
 namespace webrtc {
 
 using ::testing::_;
+using ::testing::A;
 using ::testing::AllOf;
 using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
@@ -635,6 +636,114 @@ TEST_F(TestVp8Impl, KeepsTimestampOnReencode) {
   encoder.Encode(NextInputFrame(), &delta_frame);
 }
 
+TEST_F(TestVp8Impl, SetsActiveMapFromUpdateRectWhenScreensharing) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-Video-ScreenshareActiveMap/Enabled/");
+  auto* const vpx = new NiceMock<MockLibvpxInterface>();
+  LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)),
+                           VP8Encoder::Settings());
+  codec_settings_.mode = VideoCodecMode::kScreensharing;
+  codec_settings_.VP8()->numberOfTemporalLayers = 1;
+
+  ON_CALL(*vpx, img_wrap(_, _, _, _, _, _))
+      .WillByDefault(Invoke([](vpx_image_t* img, vpx_img_fmt_t fmt,
+                               unsigned int d_w, unsigned int d_h,
+                               unsigned int stride_align,
+                               unsigned char* img_data) {
+        img->fmt = fmt;
+        img->d_w = d_w;
+        img->d_h = d_h;
+        img->img_data = img_data;
+        return img;
+      }));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings_,
+                               VideoEncoder::Settings(kCapabilities, 1, 1000)));
+  NiceMock<MockEncodedImageCallback> callback;
+  ON_CALL(callback, OnEncodedImage)
+      .WillByDefault(Return(
+          EncodedImageCallback::Result(EncodedImageCallback::Result::OK)));
+  encoder.RegisterEncodeCompleteCallback(&callback);
+
+  // Every encoded frame is a one byte packet, the first one a key frame.
+  uint8_t data = 0;
+  vpx_codec_cx_pkt_t packet = {};
+  packet.kind = VPX_CODEC_CX_FRAME_PKT;
+  packet.data.frame.buf = &data;
+  packet.data.frame.sz = 1;
+  packet.data.frame.flags = VPX_FRAME_IS_KEY;
+  ON_CALL(*vpx, codec_get_cx_data)
+      .WillByDefault(
+          [&](vpx_codec_ctx_t*,
+              vpx_codec_iter_t* iter) -> const vpx_codec_cx_pkt_t* {
+            if (*iter) {
+              return nullptr;
+            }
+            *iter = &packet;
+            return &packet;
+          });
+  std::vector<std::vector<uint8_t>> active_maps;
+  ON_CALL(*vpx, codec_control(_, VP8E_SET_ACTIVEMAP, A<vpx_active_map*>()))
+      .WillByDefault([&](vpx_codec_ctx_t*, vp8e_enc_control_id,
+                         vpx_active_map* map) {
+        EXPECT_EQ(map->rows, (kHeight + 15) / 16u);
+        EXPECT_EQ(map->cols, (kWidth + 15) / 16u);
+        active_maps.emplace_back();
+        if (map->active_map) {
+          active_maps.back().assign(map->active_map,
+                                    map->active_map + map->rows * map->cols);
+        }
+        return VPX_CODEC_OK;
+      });
+
+  encoder.Encode(NextInputFrame(), nullptr);
+  packet.data.frame.flags = 0;
+  VideoFrame frame = NextInputFrame();
+  frame.set_update_rect(VideoFrame::UpdateRect{16, 0, 8, 8});
+  encoder.Encode(frame, nullptr);
+
+  ASSERT_EQ(active_maps.size(), 2u);
+  // All macroblocks are active in the key frame.
+  EXPECT_TRUE(active_maps[0].empty());
+  // Only the second macroblock of the first row changed.
+  std::vector<uint8_t> expected_map((kWidth + 15) / 16 * ((kHeight + 15) / 16));
+  expected_map[1] = 1;
+  EXPECT_EQ(active_maps[1], expected_map);
+}
+
+TEST_F(TestVp8Impl, DoesNotSetActiveMapByDefault) {
+  auto* const vpx = new NiceMock<MockLibvpxInterface>();
+  LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)),
+                           VP8Encoder::Settings());
+  codec_settings_.mode = VideoCodecMode::kScreensharing;
+  codec_settings_.VP8()->numberOfTemporalLayers = 1;
+
+  ON_CALL(*vpx, img_wrap(_, _, _, _, _, _))
+      .WillByDefault(Invoke([](vpx_image_t* img, vpx_img_fmt_t fmt,
+                               unsigned int d_w, unsigned int d_h,
+                               unsigned int stride_align,
+                               unsigned char* img_data) {
+        img->fmt = fmt;
+        img->d_w = d_w;
+        img->d_h = d_h;
+        img->img_data = img_data;
+        return img;
+      }));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings_,
+                               VideoEncoder::Settings(kCapabilities, 1, 1000)));
+  NiceMock<MockEncodedImageCallback> callback;
+  encoder.RegisterEncodeCompleteCallback(&callback);
+
+  // Neither for the key frame nor for the delta frame.
+  EXPECT_CALL(*vpx, codec_control(_, VP8E_SET_ACTIVEMAP, A<vpx_active_map*>()))
+      .Times(0);
+  encoder.Encode(NextInputFrame(), nullptr);
+  VideoFrame frame = NextInputFrame();
+  frame.set_update_rect(VideoFrame::UpdateRect{16, 0, 8, 8});
+  encoder.Encode(frame, nullptr);
+}
+
 TEST(LibvpxVp8EncoderTest, GetEncoderInfoReturnsStaticInformation) {
   auto* const vpx = new NiceMock<MockLibvpxInterface>();
   LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)),
@@ -266,7 +266,8 @@ LibvpxVp9Encoder::LibvpxVp9Encoder(const cricket::VideoCodec& codec,
                             "Disabled")),
       performance_flags_(ParsePerformanceFlagsFromTrials(trials)),
       num_steady_state_frames_(0),
-      config_changed_(true) {
+      config_changed_(true),
+      use_active_map_(trials.IsEnabled(ActiveMapTracker::kFieldTrial)) {
   codec_ = {};
   memset(&svc_params_, 0, sizeof(vpx_svc_extra_cfg_t));
 }
@@ -617,6 +618,7 @@ int LibvpxVp9Encoder::InitEncode(const VideoCodec* inst,
       num_spatial_layers_, FramerateControllerDeprecated(codec_.maxFramerate));
 
   is_svc_ = (num_spatial_layers_ > 1 || num_temporal_layers_ > 1);
+  active_map_tracker_ = ActiveMapTracker();
 
   // Populate encoder configuration with default values.
   if (libvpx_->codec_enc_config_default(vpx_codec_vp9_cx(), config_, 0)) {
@@ -991,6 +993,7 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
   if (encoded_complete_callback_ == nullptr) {
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
   }
+  active_map_tracker_.OnInputFrame(input_image);
   if (num_active_spatial_layers_ == 0) {
     // All spatial layers are disabled, return without encoding anything.
     return WEBRTC_VIDEO_CODEC_OK;
@@ -1241,6 +1244,8 @@ int LibvpxVp9Encoder::Encode(const VideoFrame& input_image,
                            &ref_config);
   }
 
+  MaybeSetActiveMap();
+
   first_frame_in_picture_ = true;
 
   // TODO(ssilkin): Frame duration should be specified per spatial layer
@@ -1693,6 +1698,26 @@ vpx_svc_ref_frame_config_t LibvpxVp9Encoder::SetReferences(
   return ref_config;
 }
 
+void LibvpxVp9Encoder::MaybeSetActiveMap() {
+  if (!use_active_map_ || codec_.mode != VideoCodecMode::kScreensharing ||
+      is_svc_) {
+    return;
+  }
+  vpx_active_map_t active_map = {
+      .active_map = nullptr,
+      .rows = (config_->g_h + ActiveMapTracker::kBlockSize - 1) /
+              ActiveMapTracker::kBlockSize,
+      .cols = (config_->g_w + ActiveMapTracker::kBlockSize - 1) /
+              ActiveMapTracker::kBlockSize};
+  // A null map disables the active map, as needed for key frames.
+  std::vector<uint8_t> map;
+  if (!force_key_frame_ &&
+      active_map_tracker_.GetActiveMap(config_->g_w, config_->g_h, map)) {
+    active_map.active_map = map.data();
+  }
+  libvpx_->codec_control(encoder_, VP8E_SET_ACTIVEMAP, &active_map);
+}
+
 void LibvpxVp9Encoder::GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt) {
   RTC_DCHECK_EQ(pkt->kind, VPX_CODEC_CX_FRAME_PKT);
 
@@ -1700,11 +1725,12 @@ void LibvpxVp9Encoder::GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt) {
     // Ignore dropped frame.
     return;
   }
+  active_map_tracker_.OnFrameEncoded();
 
   vpx_svc_layer_id_t layer_id = {0};
   libvpx_->codec_control(encoder_, VP9E_GET_SVC_LAYER_ID, &layer_id);
 
-  encoded_image_.SetEncodedData(EncodedImageBuffer::Create(
+  encoded_image_.SetEncodedData(encoded_image_buffer_pool_.Create(
       static_cast<const uint8_t*>(pkt->data.frame.buf), pkt->data.frame.sz));
 
   codec_specific_ = {};
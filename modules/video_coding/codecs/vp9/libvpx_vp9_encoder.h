@@ -23,11 +23,13 @@
 #include "api/video_codecs/scalability_mode.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/vp9_profile.h"
+#include "common_video/include/encoded_image_buffer_pool.h"
 #include "common_video/include/video_frame_buffer_pool.h"
 #include "modules/video_coding/codecs/interface/libvpx_interface.h"
 #include "modules/video_coding/codecs/vp9/include/vp9.h"
 #include "modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
 #include "modules/video_coding/svc/scalable_video_controller.h"
+#include "modules/video_coding/utility/active_map_tracker.h"
 #include "modules/video_coding/utility/framerate_controller_deprecated.h"
 #include "rtc_base/containers/flat_map.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
@@ -90,6 +92,10 @@ class LibvpxVp9Encoder : public VP9Encoder {
 
   void GetEncodedLayerFrame(const vpx_codec_cx_pkt* pkt);
 
+  // Lets the encoder skip the blocks which haven't changed since its last
+  // encoded frame, when screensharing without spatial or temporal layers.
+  void MaybeSetActiveMap();
+
   // Callback function for outputting packets per spatial layer.
   static void EncoderOutputCodedPacketCallback(vpx_codec_cx_pkt* pkt,
                                                void* user_data);
@@ -118,6 +124,8 @@ class LibvpxVp9Encoder : public VP9Encoder {
 
   const std::unique_ptr<LibvpxInterface> libvpx_;
   EncodedImage encoded_image_;
+  EncodedImageBufferPool encoded_image_buffer_pool_;
+  ActiveMapTracker active_map_tracker_;
   CodecSpecificInfo codec_specific_;
   EncodedImageCallback* encoded_complete_callback_;
   VideoCodec codec_;
@@ -236,6 +244,9 @@ class LibvpxVp9Encoder : public VP9Encoder {
   bool config_changed_;
 
   const LibvpxVp9EncoderInfoSettings encoder_info_override_;
+
+  // Whether active maps are set when screensharing, see ActiveMapTracker.
+  const bool use_active_map_;
 };
 
 }  // namespace webrtc
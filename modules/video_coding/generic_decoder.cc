@@ -196,6 +196,14 @@ void VCMDecodedFrameCallback::Decoded(VideoFrame& decodedImage,
     RTC_HISTOGRAM_COUNTS_1000(
         "WebRTC.Video.GenericDecoder.PacerAndPacketizationDelay",
         timing_frame_info.pacer_exit_ms - timing_frame_info.encode_finish_ms);
+    if (decodedImage.ntp_time_ms() >= 0) {
+      // The network delay spans the sender and receiver clocks, so it is only
+      // meaningful once the sender clock has been estimated.
+      RTC_HISTOGRAM_COUNTS_1000(
+          "WebRTC.Video.GenericDecoder.NetworkDelay",
+          frame_info->timing.receive_start_ms -
+              timing_frame_info.pacer_exit_ms);
+    }
   }
 
   timing_frame_info.flags = frame_info->timing.flags;
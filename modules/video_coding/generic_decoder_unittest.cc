@@ -21,6 +21,7 @@
 #include "common_video/test/utilities.h"
 #include "modules/video_coding/timing/timing.h"
 #include "system_wrappers/include/clock.h"
+#include "system_wrappers/include/metrics.h"
 #include "test/fake_decoder.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -188,5 +189,49 @@ TEST_F(GenericDecoderTest, IsLowLatencyStreamActivatedByPlayoutDelay) {
   EXPECT_TRUE(decoded_frame->render_parameters().use_low_latency_rendering);
 }
 
+TEST_F(GenericDecoderTest, ReportsNetworkDelayOfTimingFrames) {
+  metrics::Reset();
+  const int64_t ntp_offset_ms =
+      clock_->CurrentNtpInMilliseconds() - clock_->TimeInMilliseconds();
+  time_controller_.AdvanceTime(TimeDelta::Millis(100));
+  EncodedFrame encoded_frame;
+  encoded_frame.ntp_time_ms_ = ntp_offset_ms;
+  EncodedImage::Timing* timing = encoded_frame.video_timing_mutable();
+  timing->flags = VideoSendTiming::kTriggeredByTimer;
+  timing->encode_start_ms = ntp_offset_ms + 10;
+  timing->encode_finish_ms = ntp_offset_ms + 20;
+  timing->packetization_finish_ms = ntp_offset_ms + 25;
+  timing->pacer_exit_ms = ntp_offset_ms + 30;
+  timing->receive_start_ms = 70;
+  timing->receive_finish_ms = 80;
+  generic_decoder_.Decode(encoded_frame, clock_->CurrentTime());
+  time_controller_.AdvanceTime(TimeDelta::Millis(10));
+  ASSERT_TRUE(user_callback_.PopLastFrame().has_value());
+  EXPECT_METRIC_EQ(
+      1, metrics::NumEvents("WebRTC.Video.GenericDecoder.NetworkDelay", 40));
+  EXPECT_METRIC_EQ(
+      1,
+      metrics::NumEvents("WebRTC.Video.GenericDecoder.PacketReceiveDelay", 10));
+}
+
+TEST_F(GenericDecoderTest, NoNetworkDelayWithoutSenderClockEstimate) {
+  metrics::Reset();
+  time_controller_.AdvanceTime(TimeDelta::Millis(100));
+  EncodedFrame encoded_frame;
+  encoded_frame.ntp_time_ms_ = -1;
+  EncodedImage::Timing* timing = encoded_frame.video_timing_mutable();
+  timing->flags = VideoSendTiming::kTriggeredByTimer;
+  timing->pacer_exit_ms = 30;
+  timing->receive_start_ms = 70;
+  timing->receive_finish_ms = 80;
+  generic_decoder_.Decode(encoded_frame, clock_->CurrentTime());
+  time_controller_.AdvanceTime(TimeDelta::Millis(10));
+  ASSERT_TRUE(user_callback_.PopLastFrame().has_value());
+  EXPECT_METRIC_EQ(
+      0, metrics::NumSamples("WebRTC.Video.GenericDecoder.NetworkDelay"));
+  EXPECT_METRIC_EQ(
+      1, metrics::NumSamples("WebRTC.Video.GenericDecoder.PacketReceiveDelay"));
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
@@ -0,0 +1,237 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/h265_packet_buffer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "api/function_view.h"
+#include "api/video/video_frame_type.h"
+#include "common_video/h265/h265_common.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+
+namespace webrtc {
+namespace {
+int64_t EuclideanMod(int64_t n, int64_t div) {
+  RTC_DCHECK_GT(div, 0);
+  return (n %= div) < 0 ? n + div : n;
+}
+
+// Media packets with empty payloads are never inserted, so they are used to
+// mark the slots of padding packets.
+bool IsPadding(const H265PacketBuffer::Packet& packet) {
+  return packet.video_payload.size() == 0;
+}
+
+bool IsIrap(uint8_t nalu_type) {
+  return nalu_type >= H265::NaluType::kBlaWLp &&
+         nalu_type <= H265::NaluType::kRsvIrapVcl23;
+}
+
+// Calls `callback` with the type of every NAL unit starting in the packet.
+// Packets carrying anything but the first fragment of a NAL unit have no start
+// code, so no NAL unit starts in them.
+void ForEachNaluType(const H265PacketBuffer::Packet& packet,
+                     rtc::FunctionView<void(uint8_t)> callback) {
+  const uint8_t* payload = packet.video_payload.cdata();
+  for (const H265::NaluIndex& index :
+       H265::FindNaluIndices(payload, packet.video_payload.size())) {
+    if (index.payload_size > 0) {
+      callback(H265::ParseNaluType(payload[index.payload_start_offset]));
+    }
+  }
+}
+
+}  // namespace
+
+H265PacketBuffer::H265PacketBuffer(bool irap_only_keyframes_allowed)
+    : irap_only_keyframes_allowed_(irap_only_keyframes_allowed) {}
+
+H265PacketBuffer::InsertResult H265PacketBuffer::InsertPacket(
+    std::unique_ptr<Packet> packet) {
+  RTC_DCHECK(packet->video_header.codec == kVideoCodecH265);
+  RTC_DCHECK(!IsPadding(*packet));
+
+  InsertResult result;
+  int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(packet->seq_num);
+  auto& packet_slot = GetPacket(unwrapped_seq_num);
+  if (packet_slot != nullptr && !IsPadding(*packet_slot) &&
+      AheadOrAt(packet_slot->timestamp, packet->timestamp)) {
+    // The incoming `packet` is old or a duplicate.
+    return result;
+  } else {
+    packet_slot = std::move(packet);
+  }
+
+  result.packets = FindFrames(unwrapped_seq_num);
+  return result;
+}
+
+H265PacketBuffer::InsertResult H265PacketBuffer::InsertPadding(
+    uint16_t seq_num) {
+  InsertResult result;
+  int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(seq_num);
+  auto& packet_slot = GetPacket(unwrapped_seq_num);
+  if (packet_slot != nullptr && packet_slot->seq_num == seq_num) {
+    // Duplicate.
+    return result;
+  }
+  packet_slot = std::make_unique<Packet>();
+  packet_slot->seq_num = seq_num;
+
+  // Padding doesn't begin a stream, so there is nothing to find unless the
+  // padding continues it.
+  if (unwrapped_seq_num - 1 == last_continuous_unwrapped_seq_num_) {
+    result.packets = FindFrames(unwrapped_seq_num);
+  }
+  return result;
+}
+
+std::unique_ptr<H265PacketBuffer::Packet>& H265PacketBuffer::GetPacket(
+    int64_t unwrapped_seq_num) {
+  return buffer_[EuclideanMod(unwrapped_seq_num, kBufferSize)];
+}
+
+bool H265PacketBuffer::BeginningOfStream(
+    const H265PacketBuffer::Packet& packet) const {
+  bool beginning_of_stream = false;
+  ForEachNaluType(packet, [&](uint8_t nalu_type) {
+    beginning_of_stream |= nalu_type == H265::NaluType::kVps ||
+                           nalu_type == H265::NaluType::kSps ||
+                           (irap_only_keyframes_allowed_ && IsIrap(nalu_type));
+  });
+  return beginning_of_stream;
+}
+
+std::vector<std::unique_ptr<H265PacketBuffer::Packet>>
+H265PacketBuffer::FindFrames(int64_t unwrapped_seq_num) {
+  std::vector<std::unique_ptr<Packet>> found_frames;
+
+  Packet* packet = GetPacket(unwrapped_seq_num).get();
+  RTC_CHECK(packet != nullptr);
+
+  // Check if the packet is continuous or the beginning of a new coded video
+  // sequence.
+  if (unwrapped_seq_num - 1 != last_continuous_unwrapped_seq_num_) {
+    if (unwrapped_seq_num <= last_continuous_unwrapped_seq_num_ ||
+        !BeginningOfStream(*packet)) {
+      return found_frames;
+    }
+
+    last_continuous_unwrapped_seq_num_ = unwrapped_seq_num;
+  }
+
+  for (int64_t seq_num = unwrapped_seq_num;
+       seq_num < unwrapped_seq_num + kBufferSize;) {
+    RTC_DCHECK_GE(seq_num, *last_continuous_unwrapped_seq_num_);
+
+    // Packets that were never assembled into a completed frame will stay in
+    // the 'buffer_'. Check that the `packet` sequence number match the expected
+    // unwrapped sequence number.
+    if (static_cast<uint16_t>(seq_num) != packet->seq_num) {
+      return found_frames;
+    }
+
+    last_continuous_unwrapped_seq_num_ = seq_num;
+    // Last packet of the frame, try to assemble the frame.
+    if (packet->marker_bit) {
+      uint32_t rtp_timestamp = packet->timestamp;
+
+      // Iterate backwards to find where the frame starts.
+      for (int64_t seq_num_start = seq_num;
+           seq_num_start > seq_num - kBufferSize; --seq_num_start) {
+        auto& prev_packet = GetPacket(seq_num_start - 1);
+
+        if (prev_packet == nullptr || IsPadding(*prev_packet) ||
+            prev_packet->timestamp != rtp_timestamp) {
+          if (MaybeAssembleFrame(seq_num_start, seq_num, found_frames)) {
+            // Frame was assembled, continue to look for more frames.
+            break;
+          } else {
+            // Frame was not assembled, no subsequent frame will be continuous.
+            return found_frames;
+          }
+        }
+      }
+    }
+
+    seq_num++;
+    packet = GetPacket(seq_num).get();
+    if (packet == nullptr) {
+      return found_frames;
+    }
+  }
+
+  return found_frames;
+}
+
+bool H265PacketBuffer::MaybeAssembleFrame(
+    int64_t start_seq_num_unwrapped,
+    int64_t end_sequence_number_unwrapped,
+    std::vector<std::unique_ptr<Packet>>& frames) {
+  bool has_vps = false;
+  bool has_sps = false;
+  bool has_pps = false;
+  bool has_irap = false;
+
+  int width = -1;
+  int height = -1;
+
+  for (int64_t seq_num = start_seq_num_unwrapped;
+       seq_num <= end_sequence_number_unwrapped; ++seq_num) {
+    const auto& packet = GetPacket(seq_num);
+    ForEachNaluType(*packet, [&](uint8_t nalu_type) {
+      has_irap |= IsIrap(nalu_type);
+      has_vps |= nalu_type == H265::NaluType::kVps;
+      has_sps |= nalu_type == H265::NaluType::kSps;
+      has_pps |= nalu_type == H265::NaluType::kPps;
+    });
+
+    width = std::max<int>(packet->video_header.width, width);
+    height = std::max<int>(packet->video_header.height, height);
+  }
+
+  if (has_irap) {
+    if (!irap_only_keyframes_allowed_ && (!has_vps || !has_sps || !has_pps)) {
+      return false;
+    }
+  }
+
+  for (int64_t seq_num = start_seq_num_unwrapped;
+       seq_num <= end_sequence_number_unwrapped; ++seq_num) {
+    auto& packet = GetPacket(seq_num);
+
+    packet->video_header.is_first_packet_in_frame =
+        (seq_num == start_seq_num_unwrapped);
+    packet->video_header.is_last_packet_in_frame =
+        (seq_num == end_sequence_number_unwrapped);
+
+    if (packet->video_header.is_first_packet_in_frame) {
+      if (width > 0 && height > 0) {
+        packet->video_header.width = width;
+        packet->video_header.height = height;
+      }
+
+      packet->video_header.frame_type = has_irap
+                                            ? VideoFrameType::kVideoFrameKey
+                                            : VideoFrameType::kVideoFrameDelta;
+    }
+
+    frames.push_back(std::move(packet));
+  }
+
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,245 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "modules/video_coding/h265_packet_buffer.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "api/video/render_resolution.h"
+#include "common_video/h265/h265_common.h"
+#include "rtc_base/system/unused.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+
+using H265::NaluType::kIdrWRadl;
+using H265::NaluType::kPps;
+using H265::NaluType::kSps;
+using H265::NaluType::kTrailR;
+using H265::NaluType::kVps;
+
+// Builds packets the way the H265 depacketizer outputs them, i.e. with a start
+// code in front of every NAL unit which starts in the packet.
+class Packet {
+ public:
+  Packet& Nalu(H265::NaluType type) {
+    payload_.insert(payload_.end(), {0, 0, 0, 1});
+    payload_.insert(payload_.end(), {static_cast<uint8_t>(type << 1), 1});
+    payload_.insert(payload_.end(), {9, 9, 9});
+    return *this;
+  }
+  Packet& Vps() { return Nalu(kVps); }
+  Packet& Sps() { return Nalu(kSps); }
+  Packet& Pps() { return Nalu(kPps); }
+  Packet& Irap() { return Nalu(kIdrWRadl); }
+  Packet& Slice() { return Nalu(kTrailR); }
+  // Anything but the first fragment of a fragmented NAL unit.
+  Packet& Fragment() {
+    payload_.insert(payload_.end(), {9, 9, 9});
+    return *this;
+  }
+  Packet& Resolution(RenderResolution resolution) {
+    resolution_ = resolution;
+    return *this;
+  }
+  Packet& Marker() {
+    marker_bit_ = true;
+    return *this;
+  }
+  Packet& Time(uint32_t rtp_timestamp) {
+    rtp_timestamp_ = rtp_timestamp;
+    return *this;
+  }
+  Packet& SeqNum(uint16_t rtp_seq_num) {
+    rtp_seq_num_ = rtp_seq_num;
+    return *this;
+  }
+
+  std::unique_ptr<H265PacketBuffer::Packet> Build() {
+    auto res = std::make_unique<H265PacketBuffer::Packet>();
+    res->video_payload.SetData(payload_.data(), payload_.size());
+    res->marker_bit = marker_bit_;
+    res->timestamp = rtp_timestamp_;
+    res->seq_num = rtp_seq_num_;
+    res->video_header.codec = kVideoCodecH265;
+    res->video_header.width = resolution_.Width();
+    res->video_header.height = resolution_.Height();
+    return res;
+  }
+
+ private:
+  std::vector<uint8_t> payload_;
+  RenderResolution resolution_;
+  bool marker_bit_ = false;
+  uint32_t rtp_timestamp_ = 0;
+  uint16_t rtp_seq_num_ = 0;
+};
+
+TEST(H265PacketBufferTest, IrapIsKeyframe) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  auto frame = packet_buffer.InsertPacket(Packet().Irap().Marker().Build());
+  ASSERT_THAT(frame.packets, SizeIs(1));
+  EXPECT_EQ(frame.packets[0]->video_header.frame_type,
+            VideoFrameType::kVideoFrameKey);
+}
+
+TEST(H265PacketBufferTest, IrapIsNotKeyframe) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/false);
+
+  EXPECT_THAT(
+      packet_buffer.InsertPacket(Packet().Irap().Marker().Build()).packets,
+      IsEmpty());
+}
+
+TEST(H265PacketBufferTest, VpsSpsPpsIrapIsKeyframe) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/false);
+
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(
+                      Packet().Vps().Sps().Pps().Irap().Marker().Build())
+                  .packets,
+              SizeIs(1));
+}
+
+TEST(H265PacketBufferTest, SpsPpsIrapIsNotKeyframe) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/false);
+
+  EXPECT_THAT(
+      packet_buffer.InsertPacket(Packet().Sps().Pps().Irap().Marker().Build())
+          .packets,
+      IsEmpty());
+}
+
+TEST(H265PacketBufferTest, FragmentedIrapRequiresFirstFragment) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(Packet().Fragment().SeqNum(1).Time(0).Build())
+                  .packets,
+              IsEmpty());
+  EXPECT_THAT(
+      packet_buffer
+          .InsertPacket(Packet().Fragment().SeqNum(2).Time(0).Marker().Build())
+          .packets,
+      IsEmpty());
+
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet().Irap().SeqNum(3).Time(1).Build()));
+  EXPECT_THAT(
+      packet_buffer
+          .InsertPacket(Packet().Fragment().SeqNum(4).Time(1).Marker().Build())
+          .packets,
+      SizeIs(2));
+}
+
+TEST(H265PacketBufferTest, ParameterSetsInSeparatePackets) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/false);
+
+  RTC_UNUSED(
+      packet_buffer.InsertPacket(Packet().Vps().SeqNum(0).Time(0).Build()));
+  RTC_UNUSED(
+      packet_buffer.InsertPacket(Packet().Sps().SeqNum(1).Time(0).Build()));
+  RTC_UNUSED(
+      packet_buffer.InsertPacket(Packet().Pps().SeqNum(2).Time(0).Build()));
+  auto frame = packet_buffer.InsertPacket(
+      Packet().Irap().SeqNum(3).Time(0).Marker().Build());
+  ASSERT_THAT(frame.packets, SizeIs(4));
+  EXPECT_TRUE(frame.packets[0]->video_header.is_first_packet_in_frame);
+  EXPECT_EQ(frame.packets[0]->video_header.frame_type,
+            VideoFrameType::kVideoFrameKey);
+  EXPECT_TRUE(frame.packets[3]->video_header.is_last_packet_in_frame);
+}
+
+TEST(H265PacketBufferTest, DeltaFrameAfterKeyframe) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet().Irap().SeqNum(0).Time(0).Marker().Build()));
+  auto frame = packet_buffer.InsertPacket(
+      Packet().Slice().SeqNum(1).Time(1).Marker().Build());
+  ASSERT_THAT(frame.packets, SizeIs(1));
+  EXPECT_EQ(frame.packets[0]->video_header.frame_type,
+            VideoFrameType::kVideoFrameDelta);
+}
+
+TEST(H265PacketBufferTest, SeqNumJumpDoesNotCompleteFrame) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(
+                      Packet().Irap().SeqNum(0).Time(0).Marker().Build())
+                  .packets,
+              SizeIs(1));
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(
+                      Packet().Slice().SeqNum(2).Time(2).Marker().Build())
+                  .packets,
+              IsEmpty());
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(
+                      Packet().Slice().SeqNum(1).Time(1).Marker().Build())
+                  .packets,
+              SizeIs(2));
+}
+
+TEST(H265PacketBufferTest, PaddingKeepsSequenceContinuous) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet().Irap().SeqNum(0).Time(0).Marker().Build()));
+  EXPECT_THAT(packet_buffer
+                  .InsertPacket(
+                      Packet().Slice().SeqNum(3).Time(1).Marker().Build())
+                  .packets,
+              IsEmpty());
+  EXPECT_THAT(packet_buffer.InsertPadding(2).packets, IsEmpty());
+  EXPECT_THAT(packet_buffer.InsertPadding(1).packets, SizeIs(1));
+}
+
+TEST(H265PacketBufferTest, ResolutionSetOnFirstPacket) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/false);
+
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet().Vps().SeqNum(0).Time(0).Build()));
+  auto frame = packet_buffer.InsertPacket(Packet()
+                                              .Sps()
+                                              .Pps()
+                                              .Irap()
+                                              .Resolution({320, 240})
+                                              .SeqNum(1)
+                                              .Time(0)
+                                              .Marker()
+                                              .Build());
+  ASSERT_THAT(frame.packets, SizeIs(2));
+  EXPECT_EQ(frame.packets[0]->video_header.width, 320);
+  EXPECT_EQ(frame.packets[0]->video_header.height, 240);
+}
+
+TEST(H265PacketBufferTest, RtpSeqNumWrap) {
+  H265PacketBuffer packet_buffer(/*irap_only_keyframes_allowed=*/true);
+
+  RTC_UNUSED(packet_buffer.InsertPacket(
+      Packet().Irap().SeqNum(0xffff).Time(0).Build()));
+  EXPECT_THAT(
+      packet_buffer
+          .InsertPacket(Packet().Fragment().SeqNum(0).Time(0).Marker().Build())
+          .packets,
+      SizeIs(2));
+}
+
+}  // namespace
+}  // namespace webrtc
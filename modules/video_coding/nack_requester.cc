@@ -12,6 +12,7 @@
 
 #include <algorithm>
 #include <limits>
+#include <utility>
 
 #include "api/sequence_checker.h"
 #include "api/units/timestamp.h"
@@ -93,7 +94,8 @@ NackRequester::NackInfo::NackInfo()
       send_at_seq_num(0),
       created_at_time(Timestamp::MinusInfinity()),
       sent_at_time(Timestamp::MinusInfinity()),
-      retries(0) {}
+      retries(0),
+      received(false) {}
 
 NackRequester::NackInfo::NackInfo(uint16_t seq_num,
                                   uint16_t send_at_seq_num,
@@ -102,7 +104,95 @@ NackRequester::NackInfo::NackInfo(uint16_t seq_num,
       send_at_seq_num(send_at_seq_num),
       created_at_time(created_at_time),
       sent_at_time(Timestamp::MinusInfinity()),
-      retries(0) {}
+      retries(0),
+      received(false) {}
+
+NackRequester::NackList::NackList() = default;
+NackRequester::NackList::~NackList() = default;
+
+void NackRequester::NackList::PushBack(const NackInfo& nack_info) {
+  RTC_DCHECK(span_ == 0 || AheadOf(nack_info.seq_num, At(span_ - 1).seq_num));
+  if (span_ == entries_.size()) {
+    // Grow the ring, unwrapping the entries to the start of the new buffer.
+    std::vector<NackInfo> entries(std::max<size_t>(2 * entries_.size(), 64));
+    for (size_t i = 0; i < span_; ++i) {
+      entries[i] = At(i);
+    }
+    entries_ = std::move(entries);
+    begin_ = 0;
+  }
+  At(span_++) = nack_info;
+  ++num_missing_;
+}
+
+NackRequester::NackInfo* NackRequester::NackList::Find(uint16_t seq_num) {
+  // Binary search for the first entry not older than `seq_num`.
+  size_t low = 0;
+  size_t high = span_;
+  while (low < high) {
+    size_t mid = low + (high - low) / 2;
+    if (AheadOf(seq_num, At(mid).seq_num)) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  if (low == span_) {
+    return nullptr;
+  }
+  NackInfo& nack_info = At(low);
+  if (nack_info.seq_num != seq_num || nack_info.received) {
+    return nullptr;
+  }
+  return &nack_info;
+}
+
+void NackRequester::NackList::MarkReceived(NackInfo& nack_info) {
+  RTC_DCHECK(!nack_info.received);
+  nack_info.received = true;
+  --num_missing_;
+}
+
+bool NackRequester::NackList::RemoveOlderThan(uint16_t seq_num) {
+  bool removed = false;
+  while (span_ > 0 && AheadOf(seq_num, At(0).seq_num)) {
+    if (!At(0).received) {
+      --num_missing_;
+      removed = true;
+    }
+    begin_ = (begin_ + 1) & (entries_.size() - 1);
+    --span_;
+  }
+  return removed;
+}
+
+void NackRequester::NackList::Clear() {
+  begin_ = 0;
+  span_ = 0;
+  num_missing_ = 0;
+}
+
+void NackRequester::NackList::RemoveIf(
+    rtc::FunctionView<bool(NackInfo&)> visitor) {
+  // Compact the ring in place while visiting it, so that entries of received
+  // packets are never scanned more than once.
+  size_t kept = 0;
+  for (size_t i = 0; i < span_; ++i) {
+    NackInfo& nack_info = At(i);
+    if (nack_info.received) {
+      continue;
+    }
+    if (visitor(nack_info)) {
+      --num_missing_;
+      continue;
+    }
+    if (kept != i) {
+      At(kept) = nack_info;
+    }
+    ++kept;
+  }
+  span_ = kept;
+}
 
 NackRequester::NackRequester(TaskQueueBase* current_queue,
                              NackPeriodicProcessor* periodic_processor,
@@ -171,11 +261,11 @@ int NackRequester::OnReceivedPacket(uint16_t seq_num,
 
   if (AheadOf(newest_seq_num_, seq_num)) {
     // An out of order packet has been received.
-    auto nack_list_it = nack_list_.find(seq_num);
+    NackInfo* nack_info = nack_list_.Find(seq_num);
     int nacks_sent_for_packet = 0;
-    if (nack_list_it != nack_list_.end()) {
-      nacks_sent_for_packet = nack_list_it->second.retries;
-      nack_list_.erase(nack_list_it);
+    if (nack_info != nullptr) {
+      nacks_sent_for_packet = nack_info->retries;
+      nack_list_.MarkReceived(*nack_info);
     }
     if (!is_retransmitted)
       UpdateReorderingStatistics(seq_num);
@@ -224,7 +314,7 @@ void NackRequester::ClearUpTo(uint16_t seq_num) {
   // needs to be posted to the worker thread if callers migrate to the network
   // thread.
   RTC_DCHECK_RUN_ON(worker_thread_);
-  nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
+  nack_list_.RemoveOlderThan(seq_num);
   keyframe_list_.erase(keyframe_list_.begin(),
                        keyframe_list_.lower_bound(seq_num));
   recovered_list_.erase(recovered_list_.begin(),
@@ -239,12 +329,9 @@ void NackRequester::UpdateRtt(int64_t rtt_ms) {
 bool NackRequester::RemovePacketsUntilKeyFrame() {
   // Called on worker_thread_.
   while (!keyframe_list_.empty()) {
-    auto it = nack_list_.lower_bound(*keyframe_list_.begin());
-
-    if (it != nack_list_.begin()) {
+    if (nack_list_.RemoveOlderThan(*keyframe_list_.begin())) {
       // We have found a keyframe that actually is newer than at least one
       // packet in the nack list.
-      nack_list_.erase(nack_list_.begin(), it);
       return true;
     }
 
@@ -259,8 +346,7 @@ void NackRequester::AddPacketsToNack(uint16_t seq_num_start,
                                      uint16_t seq_num_end) {
   // Called on worker_thread_.
   // Remove old packets.
-  auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
-  nack_list_.erase(nack_list_.begin(), it);
+  nack_list_.RemoveOlderThan(seq_num_end - kMaxPacketAge);
 
   // If the nack list is too large, remove packets from the nack list until
   // the latest first packet of a keyframe. If the list is still too large,
@@ -272,7 +358,7 @@ void NackRequester::AddPacketsToNack(uint16_t seq_num_start,
     }
 
     if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
-      nack_list_.clear();
+      nack_list_.Clear();
       RTC_LOG(LS_WARNING) << "NACK list full, clearing NACK"
                              " list and requesting keyframe.";
       keyframe_request_sender_->RequestKeyFrame();
@@ -286,8 +372,8 @@ void NackRequester::AddPacketsToNack(uint16_t seq_num_start,
       continue;
     NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5),
                        clock_->CurrentTime());
-    RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
+    RTC_DCHECK(nack_list_.Find(seq_num) == nullptr);
+    nack_list_.PushBack(nack_info);
   }
 }
 
@@ -298,29 +384,25 @@ std::vector<uint16_t> NackRequester::GetNackBatch(NackFilterOptions options) {
   bool consider_timestamp = options != kSeqNumOnly;
   Timestamp now = clock_->CurrentTime();
   std::vector<uint16_t> nack_batch;
-  auto it = nack_list_.begin();
-  while (it != nack_list_.end()) {
-    bool delay_timed_out = now - it->second.created_at_time >= send_nack_delay_;
-    bool nack_on_rtt_passed = now - it->second.sent_at_time >= rtt_;
+  nack_list_.RemoveIf([&](NackInfo& nack_info) {
+    bool delay_timed_out = now - nack_info.created_at_time >= send_nack_delay_;
+    bool nack_on_rtt_passed = now - nack_info.sent_at_time >= rtt_;
     bool nack_on_seq_num_passed =
-        it->second.sent_at_time.IsInfinite() &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num);
+        nack_info.sent_at_time.IsInfinite() &&
+        AheadOrAt(newest_seq_num_, nack_info.send_at_seq_num);
     if (delay_timed_out && ((consider_seq_num && nack_on_seq_num_passed) ||
                             (consider_timestamp && nack_on_rtt_passed))) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now;
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
+      nack_batch.emplace_back(nack_info.seq_num);
+      ++nack_info.retries;
+      nack_info.sent_at_time = now;
+      if (nack_info.retries >= kMaxNackRetries) {
+        RTC_LOG(LS_WARNING) << "Sequence number " << nack_info.seq_num
                             << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
+        return true;
       }
-      continue;
     }
-    ++it;
-  }
+    return false;
+  });
   return nack_batch;
 }
 
@@ -13,11 +13,11 @@
 
 #include <stdint.h>
 
-#include <map>
 #include <set>
 #include <vector>
 
 #include "api/field_trials_view.h"
+#include "api/function_view.h"
 #include "api/sequence_checker.h"
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/task_queue/task_queue_base.h"
@@ -103,6 +103,49 @@ class NackRequester final : public NackRequesterBase {
     Timestamp created_at_time;
     Timestamp sent_at_time;
     int retries;
+    // Set once the packet has been received; such entries are skipped and
+    // dropped by the next scan of the list.
+    bool received;
+  };
+
+  // Packets to nack, ordered by sequence number. Packets are only ever added
+  // at the newest end, so the entries are kept in a ring buffer that is
+  // scanned linearly when building nack batches, rather than in a tree.
+  class NackList {
+   public:
+    NackList();
+    ~NackList();
+
+    // Number of packets in the list that have not been received.
+    size_t size() const { return num_missing_; }
+    bool empty() const { return num_missing_ == 0; }
+
+    // Adds a packet newer than all packets in the list.
+    void PushBack(const NackInfo& nack_info);
+    // Returns the entry of the missing packet `seq_num`, or null.
+    NackInfo* Find(uint16_t seq_num);
+    // Marks the missing packet `nack_info` as received.
+    void MarkReceived(NackInfo& nack_info);
+    // Removes all packets older than `seq_num`. Returns true if any missing
+    // packet was removed.
+    bool RemoveOlderThan(uint16_t seq_num);
+    void Clear();
+
+    // Calls `visitor` on each missing packet, oldest first, and removes the
+    // packets for which it returns true along with all received packets.
+    void RemoveIf(rtc::FunctionView<bool(NackInfo&)> visitor);
+
+   private:
+    NackInfo& At(size_t index) {
+      return entries_[(begin_ + index) & (entries_.size() - 1)];
+    }
+
+    // Ring buffer with a power of two size, holding `span_` entries
+    // starting at `begin_`.
+    std::vector<NackInfo> entries_;
+    size_t begin_ = 0;
+    size_t span_ = 0;
+    size_t num_missing_ = 0;
   };
 
   void AddPacketsToNack(uint16_t seq_num_start, uint16_t seq_num_end)
@@ -132,8 +175,7 @@ class NackRequester final : public NackRequesterBase {
   // TODO(philipel): Some of the variables below are consistently used on a
   // known thread (e.g. see `initialized_`). Those probably do not need
   // synchronized access.
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      RTC_GUARDED_BY(worker_thread_);
+  NackList nack_list_ RTC_GUARDED_BY(worker_thread_);
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
       RTC_GUARDED_BY(worker_thread_);
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> recovered_list_
@@ -356,6 +356,29 @@ TEST_F(TestNackRequester, SendNackWithoutDelay) {
   EXPECT_EQ(99u, sent_nacks_.size());
 }
 
+TEST_F(TestNackRequester, ResendsOnlyPacketsStillMissing) {
+  NackRequester& nack_module = CreateNackModule(TimeDelta::Millis(1));
+  nack_module.OnReceivedPacket(0, false, false);
+  nack_module.OnReceivedPacket(100, false, false);
+  ASSERT_EQ(99u, sent_nacks_.size());
+
+  // Receive every other missing packet out of order.
+  for (uint16_t seq_num = 2; seq_num < 100; seq_num += 2) {
+    EXPECT_EQ(1, nack_module.OnReceivedPacket(seq_num, false, false));
+  }
+
+  sent_nacks_.clear();
+  clock_->AdvanceTimeMilliseconds(kDefaultRttMs);
+  ASSERT_TRUE(WaitForSendNack());
+  std::vector<uint16_t> expected;
+  for (uint16_t seq_num = 1; seq_num < 100; seq_num += 2) {
+    expected.push_back(seq_num);
+  }
+  EXPECT_EQ(sent_nacks_, expected);
+  EXPECT_EQ(0, nack_module.OnReceivedPacket(2, false, false));
+  EXPECT_EQ(2, nack_module.OnReceivedPacket(3, false, false));
+}
+
 class TestNackRequesterWithFieldTrial : public ::testing::Test,
                                         public NackSender,
                                         public KeyFrameRequestSender {
@@ -49,6 +49,9 @@ PacketBuffer::PacketBuffer(size_t start_buffer_size, size_t max_buffer_size)
       first_packet_received_(false),
       is_cleared_to_first_seq_num_(false),
       buffer_(start_buffer_size),
+      slot_flags_(start_buffer_size),
+      slot_seq_nums_(start_buffer_size),
+      slot_timestamps_(start_buffer_size),
       sps_pps_idr_is_h264_keyframe_(false) {
   RTC_DCHECK_LE(start_buffer_size, max_buffer_size);
   // Buffer size must always be a power of 2.
@@ -87,19 +90,20 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
     first_seq_num_ = seq_num;
   }
 
-  if (buffer_[index] != nullptr) {
+  if (slot_flags_[index] & kSlotOccupied) {
     // Duplicate packet, just delete the payload.
-    if (buffer_[index]->seq_num == packet->seq_num) {
+    if (slot_seq_nums_[index] == seq_num) {
       return result;
     }
 
     // The packet buffer is full, try to expand the buffer.
-    while (ExpandBufferSize() && buffer_[seq_num % buffer_.size()] != nullptr) {
+    while (ExpandBufferSize() &&
+           (slot_flags_[seq_num % buffer_.size()] & kSlotOccupied)) {
     }
     index = seq_num % buffer_.size();
 
     // Packet buffer is still full since we were unable to expand the buffer.
-    if (buffer_[index] != nullptr) {
+    if (slot_flags_[index] & kSlotOccupied) {
       // Clear the buffer, delete payload, and return false to signal that a
       // new keyframe is needed.
       RTC_LOG(LS_WARNING) << "Clear PacketBuffer and request key frame.";
@@ -109,8 +113,7 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
     }
   }
 
-  packet->continuous = false;
-  buffer_[index] = std::move(packet);
+  StorePacket(index, std::move(packet));
 
   UpdateMissingPackets(seq_num);
 
@@ -139,9 +142,10 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   size_t diff = ForwardDiff<uint16_t>(first_seq_num_, seq_num);
   size_t iterations = std::min(diff, buffer_.size());
   for (size_t i = 0; i < iterations; ++i) {
-    auto& stored = buffer_[first_seq_num_ % buffer_.size()];
-    if (stored != nullptr && AheadOf<uint16_t>(seq_num, stored->seq_num)) {
-      stored = nullptr;
+    size_t index = first_seq_num_ % buffer_.size();
+    if ((slot_flags_[index] & kSlotOccupied) &&
+        AheadOf<uint16_t>(seq_num, slot_seq_nums_[index])) {
+      TakePacket(index);
     }
     ++first_seq_num_;
   }
@@ -182,6 +186,7 @@ void PacketBuffer::ClearInternal() {
   for (auto& entry : buffer_) {
     entry = nullptr;
   }
+  std::fill(slot_flags_.begin(), slot_flags_.end(), 0);
 
   first_packet_received_ = false;
   is_cleared_to_first_seq_num_ = false;
@@ -199,35 +204,63 @@ bool PacketBuffer::ExpandBufferSize() {
 
   size_t new_size = std::min(max_size_, 2 * buffer_.size());
   std::vector<std::unique_ptr<Packet>> new_buffer(new_size);
-  for (std::unique_ptr<Packet>& entry : buffer_) {
-    if (entry != nullptr) {
-      new_buffer[entry->seq_num % new_size] = std::move(entry);
+  std::vector<uint8_t> new_slot_flags(new_size);
+  std::vector<uint16_t> new_slot_seq_nums(new_size);
+  std::vector<uint32_t> new_slot_timestamps(new_size);
+  for (size_t i = 0; i < buffer_.size(); ++i) {
+    if (slot_flags_[i] & kSlotOccupied) {
+      size_t new_index = slot_seq_nums_[i] % new_size;
+      new_buffer[new_index] = std::move(buffer_[i]);
+      new_slot_flags[new_index] = slot_flags_[i];
+      new_slot_seq_nums[new_index] = slot_seq_nums_[i];
+      new_slot_timestamps[new_index] = slot_timestamps_[i];
     }
   }
   buffer_ = std::move(new_buffer);
+  slot_flags_ = std::move(new_slot_flags);
+  slot_seq_nums_ = std::move(new_slot_seq_nums);
+  slot_timestamps_ = std::move(new_slot_timestamps);
   RTC_LOG(LS_INFO) << "PacketBuffer size expanded to " << new_size;
   return true;
 }
 
+void PacketBuffer::StorePacket(size_t index, std::unique_ptr<Packet> packet) {
+  RTC_DCHECK(!(slot_flags_[index] & kSlotOccupied));
+  uint8_t flags = kSlotOccupied;
+  if (packet->is_first_packet_in_frame())
+    flags |= kSlotFirstPacketInFrame;
+  if (packet->is_last_packet_in_frame())
+    flags |= kSlotLastPacketInFrame;
+  slot_flags_[index] = flags;
+  slot_seq_nums_[index] = packet->seq_num;
+  slot_timestamps_[index] = packet->timestamp;
+  buffer_[index] = std::move(packet);
+}
+
+std::unique_ptr<PacketBuffer::Packet> PacketBuffer::TakePacket(size_t index) {
+  slot_flags_[index] = 0;
+  return std::move(buffer_[index]);
+}
+
 bool PacketBuffer::PotentialNewFrame(uint16_t seq_num) const {
   size_t index = seq_num % buffer_.size();
   int prev_index = index > 0 ? index - 1 : buffer_.size() - 1;
-  const auto& entry = buffer_[index];
-  const auto& prev_entry = buffer_[prev_index];
+  uint8_t flags = slot_flags_[index];
+  uint8_t prev_flags = slot_flags_[prev_index];
 
-  if (entry == nullptr)
+  if (!(flags & kSlotOccupied))
     return false;
-  if (entry->seq_num != seq_num)
+  if (slot_seq_nums_[index] != seq_num)
     return false;
-  if (entry->is_first_packet_in_frame())
+  if (flags & kSlotFirstPacketInFrame)
     return true;
-  if (prev_entry == nullptr)
+  if (!(prev_flags & kSlotOccupied))
     return false;
-  if (prev_entry->seq_num != static_cast<uint16_t>(entry->seq_num - 1))
+  if (slot_seq_nums_[prev_index] != static_cast<uint16_t>(seq_num - 1))
     return false;
-  if (prev_entry->timestamp != entry->timestamp)
+  if (slot_timestamps_[prev_index] != slot_timestamps_[index])
     return false;
-  if (prev_entry->continuous)
+  if (prev_flags & kSlotContinuous)
     return true;
 
   return false;
@@ -249,18 +282,18 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
     }
 
     size_t index = seq_num % buffer_.size();
-    buffer_[index]->continuous = true;
+    slot_flags_[index] |= kSlotContinuous;
 
     // If all packets of the frame is continuous, find the first packet of the
     // frame and add all packets of the frame to the returned packets.
-    if (buffer_[index]->is_last_packet_in_frame()) {
+    if (slot_flags_[index] & kSlotLastPacketInFrame) {
       uint16_t start_seq_num = seq_num;
 
       // Find the start index by searching backward until the packet with
       // the `frame_begin` flag is set.
       int start_index = index;
       size_t tested_packets = 0;
-      int64_t frame_timestamp = buffer_[start_index]->timestamp;
+      uint32_t frame_timestamp = slot_timestamps_[start_index];
 
       // Identify H.264 keyframes by means of SPS, PPS, and IDR.
       bool is_generic = buffer_[start_index]->video_header.generic.has_value();
@@ -277,9 +310,9 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
         ++tested_packets;
 
         if (!is_h264_descriptor) {
-          if (buffer_[start_index] == nullptr ||
-              buffer_[start_index]->is_first_packet_in_frame()) {
-            full_frame_found = buffer_[start_index] != nullptr;
+          uint8_t flags = slot_flags_[start_index];
+          if (!(flags & kSlotOccupied) || (flags & kSlotFirstPacketInFrame)) {
+            full_frame_found = (flags & kSlotOccupied) != 0;
             break;
           }
         }
@@ -327,8 +360,8 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
         // the PacketBuffer to hand out incomplete frames.
         // See: https://bugs.chromium.org/p/webrtc/issues/detail?id=7106
         if (is_h264_descriptor &&
-            (buffer_[start_index] == nullptr ||
-             buffer_[start_index]->timestamp != frame_timestamp)) {
+            (!(slot_flags_[start_index] & kSlotOccupied) ||
+             slot_timestamps_[start_index] != frame_timestamp)) {
           break;
         }
 
@@ -379,7 +412,7 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
         uint16_t num_packets = end_seq_num - start_seq_num;
         found_frames.reserve(found_frames.size() + num_packets);
         for (uint16_t i = start_seq_num; i != end_seq_num; ++i) {
-          std::unique_ptr<Packet>& packet = buffer_[i % buffer_.size()];
+          std::unique_ptr<Packet> packet = TakePacket(i % buffer_.size());
           RTC_DCHECK(packet);
           RTC_DCHECK_EQ(i, packet->seq_num);
           // Ensure frame boundary flags are properly set.
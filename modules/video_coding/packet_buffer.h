@@ -52,9 +52,6 @@ class PacketBuffer {
       return video_header.is_last_packet_in_frame;
     }
 
-    // If all its previous packets have been inserted into the packet buffer.
-    // Set and used internally by the PacketBuffer.
-    bool continuous = false;
     bool marker_bit = false;
     uint8_t payload_type = 0;
     uint16_t seq_num = 0;
@@ -85,8 +82,20 @@ class PacketBuffer {
   void ResetSpsPpsIdrIsH264Keyframe();
 
  private:
+  // Bits of `slot_flags_`.
+  enum SlotFlags : uint8_t {
+    kSlotOccupied = 1 << 0,
+    kSlotFirstPacketInFrame = 1 << 1,
+    kSlotLastPacketInFrame = 1 << 2,
+    // If all previous packets of the slot's packet have been inserted.
+    kSlotContinuous = 1 << 3,
+  };
+
   void ClearInternal();
 
+  void StorePacket(size_t index, std::unique_ptr<Packet> packet);
+  std::unique_ptr<Packet> TakePacket(size_t index);
+
   // Tries to expand the buffer.
   bool ExpandBufferSize();
 
@@ -111,10 +120,17 @@ class PacketBuffer {
   // If the buffer is cleared to `first_seq_num_`.
   bool is_cleared_to_first_seq_num_;
 
-  // Buffer that holds the the inserted packets and information needed to
-  // determine continuity between them.
+  // Buffer that holds the the inserted packets.
   std::vector<std::unique_ptr<Packet>> buffer_;
 
+  // Per slot of `buffer_`, the information needed to determine continuity
+  // and frame boundaries, kept in flat arrays so that scanning for them does
+  // not touch the packets themselves. `slot_seq_nums_` and `slot_timestamps_`
+  // are only valid for occupied slots.
+  std::vector<uint8_t> slot_flags_;
+  std::vector<uint16_t> slot_seq_nums_;
+  std::vector<uint32_t> slot_timestamps_;
+
   absl::optional<uint16_t> newest_inserted_seq_num_;
   std::set<uint16_t, DescendingSeqNumComp<uint16_t>> missing_packets_;
 
@@ -221,6 +221,20 @@ TEST_F(PacketBufferTest, SingleFrameExpandsBuffer) {
               StartSeqNumsAre(seq_num));
 }
 
+TEST_F(PacketBufferTest, ExpandBufferKeepsContinuity) {
+  const uint16_t seq_num = Rand();
+
+  EXPECT_THAT(Insert(seq_num, kKeyFrame, kFirst, kNotLast).packets, IsEmpty());
+  EXPECT_THAT(Insert(seq_num + 1, kKeyFrame, kNotFirst, kNotLast).packets,
+              IsEmpty());
+  // Collides with the slot of `seq_num`, so the buffer is expanded.
+  EXPECT_THAT(Insert(seq_num + kStartSize, kDeltaFrame, kFirst, kLast,
+                     /*data=*/{}, /*timestamp=*/456u),
+              StartSeqNumsAre(seq_num + kStartSize));
+  EXPECT_THAT(Insert(seq_num + 2, kKeyFrame, kNotFirst, kLast),
+              StartSeqNumsAre(seq_num));
+}
+
 TEST_F(PacketBufferTest, ExpandBufferOverflow) {
   const uint16_t seq_num = Rand();
 
@@ -11,11 +11,30 @@
 #include "modules/video_coding/rtp_vp9_ref_finder.h"
 
 #include <algorithm>
+#include <limits>
 #include <utility>
 
 #include "rtc_base/logging.h"
 
 namespace webrtc {
+namespace {
+
+template <int kWindow>
+size_t WindowIndex(int64_t value) {
+  static_assert((kWindow & (kWindow - 1)) == 0, "");
+  return static_cast<uint64_t>(value) & (kWindow - 1);
+}
+
+}  // namespace
+
+RtpVp9RefFinder::RtpVp9RefFinder() {
+  static_assert(kMissingFramesWindow > std::numeric_limits<uint8_t>::max());
+  static_assert(kNoMissingFrame >= kFrameIdLength);
+  for (auto& missing_frames : missing_frames_for_layer_) {
+    missing_frames.fill(kNoMissingFrame);
+  }
+}
+
 RtpFrameReferenceFinder::ReturnVector RtpVp9RefFinder::ManageFrame(
     std::unique_ptr<RtpFrameObject> frame) {
   const RTPVideoHeaderVP9& codec_header = absl::get<RTPVideoHeaderVP9>(
@@ -115,17 +134,15 @@ RtpVp9RefFinder::FrameDecision RtpVp9RefFinder::ManageFrameGof(
       current_ss_idx_ = Add<kMaxGofSaved>(current_ss_idx_, 1);
       scalability_structures_[current_ss_idx_] = gof;
       scalability_structures_[current_ss_idx_].pid_start = frame->Id();
-      gof_info_.emplace(
+      InsertGofInfo(
           unwrapped_tl0,
           GofInfo(&scalability_structures_[current_ss_idx_], frame->Id()));
     }
 
-    const auto gof_info_it = gof_info_.find(unwrapped_tl0);
-    if (gof_info_it == gof_info_.end())
+    info = FindGofInfo(unwrapped_tl0);
+    if (info == nullptr)
       return kStash;
 
-    info = &gof_info_it->second;
-
     if (frame->frame_type() == VideoFrameType::kVideoFrameKey) {
       frame->num_references = 0;
       FrameReceivedVp9(frame->Id(), info);
@@ -137,38 +154,31 @@ RtpVp9RefFinder::FrameDecision RtpVp9RefFinder::ManageFrameGof(
       RTC_LOG(LS_WARNING) << "Received keyframe without scalability structure";
       return kDrop;
     }
-    const auto gof_info_it = gof_info_.find(unwrapped_tl0);
-    if (gof_info_it == gof_info_.end())
+    info = FindGofInfo(unwrapped_tl0);
+    if (info == nullptr)
       return kStash;
 
-    info = &gof_info_it->second;
-
     frame->num_references = 0;
     FrameReceivedVp9(frame->Id(), info);
     FlattenFrameIdAndRefs(frame, codec_header.inter_layer_predicted);
     return kHandOff;
   } else {
-    auto gof_info_it = gof_info_.find(
-        (codec_header.temporal_idx == 0) ? unwrapped_tl0 - 1 : unwrapped_tl0);
+    info = FindGofInfo((codec_header.temporal_idx == 0) ? unwrapped_tl0 - 1
+                                                         : unwrapped_tl0);
 
     // Gof info for this frame is not available yet, stash this frame.
-    if (gof_info_it == gof_info_.end())
+    if (info == nullptr)
       return kStash;
 
     if (codec_header.temporal_idx == 0) {
-      gof_info_it = gof_info_
-                        .emplace(unwrapped_tl0,
-                                 GofInfo(gof_info_it->second.gof, frame->Id()))
-                        .first;
+      info = InsertGofInfo(unwrapped_tl0, GofInfo(info->gof, frame->Id()));
+      if (info == nullptr)
+        return kStash;
     }
-
-    info = &gof_info_it->second;
   }
 
   // Clean up info for base layers that are too old.
-  int64_t old_tl0_pic_idx = unwrapped_tl0 - kMaxGofSaved;
-  auto clean_gof_info_to = gof_info_.lower_bound(old_tl0_pic_idx);
-  gof_info_.erase(gof_info_.begin(), clean_gof_info_to);
+  ClearGofInfoBefore(unwrapped_tl0 - kMaxGofSaved);
 
   FrameReceivedVp9(frame->Id(), info);
 
@@ -178,12 +188,10 @@ RtpVp9RefFinder::FrameDecision RtpVp9RefFinder::ManageFrameGof(
     return kStash;
 
   if (codec_header.temporal_up_switch)
-    up_switch_.emplace(frame->Id(), codec_header.temporal_idx);
+    InsertUpSwitch(frame->Id(), codec_header.temporal_idx);
 
   // Clean out old info about up switch frames.
-  uint16_t old_picture_id = Subtract<kFrameIdLength>(frame->Id(), 50);
-  auto up_switch_erase_to = up_switch_.lower_bound(old_picture_id);
-  up_switch_.erase(up_switch_.begin(), up_switch_erase_to);
+  ClearUpSwitchesBefore(Subtract<kFrameIdLength>(frame->Id(), 50));
 
   size_t diff =
       ForwardDiff<uint16_t, kFrameIdLength>(info->gof->pid_start, frame->Id());
@@ -230,17 +238,18 @@ bool RtpVp9RefFinder::MissingRequiredFrameVp9(uint16_t picture_id,
   }
 
   // For every reference this frame has, check if there is a frame missing in
-  // the interval (`ref_pid`, `picture_id`) in any of the lower temporal
+  // the interval [`ref_pid`, `picture_id`) in any of the lower temporal
   // layers. If so, we are missing a required frame.
   uint8_t num_references = info.gof->num_ref_pics[gof_idx];
   for (size_t i = 0; i < num_references; ++i) {
     uint16_t ref_pid =
         Subtract<kFrameIdLength>(picture_id, info.gof->pid_diff[gof_idx][i]);
-    for (size_t l = 0; l < temporal_idx; ++l) {
-      auto missing_frame_it = missing_frames_for_layer_[l].lower_bound(ref_pid);
-      if (missing_frame_it != missing_frames_for_layer_[l].end() &&
-          AheadOf<uint16_t, kFrameIdLength>(picture_id, *missing_frame_it)) {
-        return true;
+    for (uint16_t pid = ref_pid; pid != picture_id;
+         pid = Add<kFrameIdLength>(pid, 1)) {
+      size_t index = WindowIndex<kMissingFramesWindow>(pid);
+      for (size_t l = 0; l < temporal_idx; ++l) {
+        if (missing_frames_for_layer_[l][index] == pid)
+          return true;
       }
     }
   }
@@ -272,7 +281,8 @@ void RtpVp9RefFinder::FrameReceivedVp9(uint16_t picture_id, GofInfo* info) {
         return;
       }
 
-      missing_frames_for_layer_[temporal_idx].insert(last_picture_id);
+      size_t index = WindowIndex<kMissingFramesWindow>(last_picture_id);
+      missing_frames_for_layer_[temporal_idx][index] = last_picture_id;
       last_picture_id = Add<kFrameIdLength>(last_picture_id, 1);
     }
 
@@ -291,24 +301,78 @@ void RtpVp9RefFinder::FrameReceivedVp9(uint16_t picture_id, GofInfo* info) {
       return;
     }
 
-    missing_frames_for_layer_[temporal_idx].erase(picture_id);
+    size_t index = WindowIndex<kMissingFramesWindow>(picture_id);
+    uint16_t& missing_frame = missing_frames_for_layer_[temporal_idx][index];
+    if (missing_frame == picture_id)
+      missing_frame = kNoMissingFrame;
   }
 }
 
 bool RtpVp9RefFinder::UpSwitchInIntervalVp9(uint16_t picture_id,
                                             uint8_t temporal_idx,
                                             uint16_t pid_ref) {
-  for (auto up_switch_it = up_switch_.upper_bound(pid_ref);
-       up_switch_it != up_switch_.end() &&
-       AheadOf<uint16_t, kFrameIdLength>(picture_id, up_switch_it->first);
-       ++up_switch_it) {
-    if (up_switch_it->second < temporal_idx)
+  for (const UpSwitchSlot& up_switch : up_switch_) {
+    if (up_switch.temporal_idx && *up_switch.temporal_idx < temporal_idx &&
+        AheadOf<uint16_t, kFrameIdLength>(up_switch.picture_id, pid_ref) &&
+        AheadOf<uint16_t, kFrameIdLength>(picture_id, up_switch.picture_id)) {
       return true;
+    }
   }
 
   return false;
 }
 
+RtpVp9RefFinder::GofInfo* RtpVp9RefFinder::FindGofInfo(int64_t unwrapped_tl0) {
+  GofInfoSlot& slot = gof_info_[WindowIndex<kGofInfoWindow>(unwrapped_tl0)];
+  if (!slot.info || slot.unwrapped_tl0 != unwrapped_tl0)
+    return nullptr;
+  return &*slot.info;
+}
+
+RtpVp9RefFinder::GofInfo* RtpVp9RefFinder::InsertGofInfo(int64_t unwrapped_tl0,
+                                                         const GofInfo& info) {
+  GofInfoSlot& slot = gof_info_[WindowIndex<kGofInfoWindow>(unwrapped_tl0)];
+  if (slot.info) {
+    if (slot.unwrapped_tl0 == unwrapped_tl0)
+      return &*slot.info;
+    if (slot.unwrapped_tl0 > unwrapped_tl0)
+      return nullptr;
+  }
+  slot.unwrapped_tl0 = unwrapped_tl0;
+  slot.info = info;
+  return &*slot.info;
+}
+
+void RtpVp9RefFinder::ClearGofInfoBefore(int64_t unwrapped_tl0) {
+  for (GofInfoSlot& slot : gof_info_) {
+    if (slot.info && slot.unwrapped_tl0 < unwrapped_tl0)
+      slot.info.reset();
+  }
+}
+
+void RtpVp9RefFinder::InsertUpSwitch(uint16_t picture_id,
+                                     uint8_t temporal_idx) {
+  UpSwitchSlot& slot = up_switch_[WindowIndex<kUpSwitchWindow>(picture_id)];
+  // Keep the newer frame if the slot is taken, the older one is cleared by the
+  // next frame anyway.
+  if (slot.temporal_idx &&
+      (slot.picture_id == picture_id ||
+       AheadOf<uint16_t, kFrameIdLength>(slot.picture_id, picture_id))) {
+    return;
+  }
+  slot.picture_id = picture_id;
+  slot.temporal_idx = temporal_idx;
+}
+
+void RtpVp9RefFinder::ClearUpSwitchesBefore(uint16_t picture_id) {
+  for (UpSwitchSlot& slot : up_switch_) {
+    if (slot.temporal_idx &&
+        AheadOf<uint16_t, kFrameIdLength>(picture_id, slot.picture_id)) {
+      slot.temporal_idx.reset();
+    }
+  }
+}
+
 void RtpVp9RefFinder::RetryStashedFrames(
     RtpFrameReferenceFinder::ReturnVector& res) {
   bool complete_frame = false;
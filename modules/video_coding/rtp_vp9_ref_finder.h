@@ -11,12 +11,12 @@
 #ifndef MODULES_VIDEO_CODING_RTP_VP9_REF_FINDER_H_
 #define MODULES_VIDEO_CODING_RTP_VP9_REF_FINDER_H_
 
+#include <array>
 #include <deque>
-#include <map>
 #include <memory>
-#include <set>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
 #include "modules/rtp_rtcp/source/frame_object.h"
 #include "modules/video_coding/rtp_frame_reference_finder.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
@@ -25,7 +25,7 @@ namespace webrtc {
 
 class RtpVp9RefFinder {
  public:
-  RtpVp9RefFinder() = default;
+  RtpVp9RefFinder();
 
   RtpFrameReferenceFinder::ReturnVector ManageFrame(
       std::unique_ptr<RtpFrameObject> frame);
@@ -38,6 +38,13 @@ class RtpVp9RefFinder {
   static constexpr int kMaxNotYetReceivedFrames = 100;
   static constexpr int kMaxStashedFrames = 100;
   static constexpr int kMaxTemporalLayers = 5;
+  // Sizes of the windows below. They must be powers of two, and large enough
+  // to hold the entries that are still in use when frames are reordered.
+  static constexpr int kGofInfoWindow = 128;
+  static constexpr int kUpSwitchWindow = 128;
+  // Must be larger than the largest `pid_diff` of a scalability structure.
+  static constexpr int kMissingFramesWindow = 512;
+  static constexpr uint16_t kNoMissingFrame = 0xFFFF;
 
   enum FrameDecision { kStash, kHandOff, kDrop };
 
@@ -48,6 +55,16 @@ class RtpVp9RefFinder {
     uint16_t last_picture_id;
   };
 
+  struct GofInfoSlot {
+    int64_t unwrapped_tl0 = 0;
+    absl::optional<GofInfo> info;
+  };
+
+  struct UpSwitchSlot {
+    uint16_t picture_id = 0;
+    absl::optional<uint8_t> temporal_idx;
+  };
+
   struct UnwrappedTl0Frame {
     int64_t unwrapped_tl0;
     std::unique_ptr<RtpFrameObject> frame;
@@ -60,6 +77,21 @@ class RtpVp9RefFinder {
                                int64_t unwrapped_tl0);
   void RetryStashedFrames(RtpFrameReferenceFinder::ReturnVector& res);
 
+  // Returns the Gof information for `unwrapped_tl0`, or nullptr if there is
+  // none.
+  GofInfo* FindGofInfo(int64_t unwrapped_tl0);
+  // Like std::map::emplace, returns the existing Gof information if there
+  // already is one for `unwrapped_tl0`. Returns nullptr if the slot is taken by
+  // the information of a newer TL0 picture index.
+  GofInfo* InsertGofInfo(int64_t unwrapped_tl0, const GofInfo& info);
+  // Removes the Gof information for TL0 picture indices older than
+  // `unwrapped_tl0`.
+  void ClearGofInfoBefore(int64_t unwrapped_tl0);
+
+  void InsertUpSwitch(uint16_t picture_id, uint8_t temporal_idx);
+  // Removes the up switch frames older than `picture_id`.
+  void ClearUpSwitchesBefore(uint16_t picture_id);
+
   bool MissingRequiredFrameVp9(uint16_t picture_id, const GofInfo& info);
 
   void FrameReceivedVp9(uint16_t picture_id, GofInfo* info);
@@ -80,17 +112,21 @@ class RtpVp9RefFinder {
   // Holds received scalability structures.
   std::array<GofInfoVP9, kMaxGofSaved> scalability_structures_;
 
-  // Holds the the Gof information for a given unwrapped TL0 picture index.
-  std::map<int64_t, GofInfo> gof_info_;
+  // Holds the the Gof information for a given unwrapped TL0 picture index, in
+  // the slot given by the index modulo `kGofInfoWindow`.
+  std::array<GofInfoSlot, kGofInfoWindow> gof_info_;
 
   // Keep track of which picture id and which temporal layer that had the
-  // up switch flag set.
-  std::map<uint16_t, uint8_t, DescendingSeqNumComp<uint16_t, kFrameIdLength>>
-      up_switch_;
-
-  // For every temporal layer, keep a set of which frames that are missing.
-  std::array<std::set<uint16_t, DescendingSeqNumComp<uint16_t, kFrameIdLength>>,
-             kMaxTemporalLayers>
+  // up switch flag set, in the slot given by the picture id modulo
+  // `kUpSwitchWindow`.
+  std::array<UpSwitchSlot, kUpSwitchWindow> up_switch_;
+
+  // For every temporal layer, keep track of which frames that are missing. A
+  // frame is missing if the slot given by its picture id modulo
+  // `kMissingFramesWindow` holds its picture id, and `kNoMissingFrame` marks
+  // unused slots. Only the frames a scalability structure can refer to are
+  // looked up, so older frames may be overwritten.
+  std::array<std::array<uint16_t, kMissingFramesWindow>, kMaxTemporalLayers>
       missing_frames_for_layer_;
 
   // Unwrapper used to unwrap VP8/VP9 streams which have their picture id
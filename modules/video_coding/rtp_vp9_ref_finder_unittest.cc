@@ -634,4 +634,28 @@ TEST_F(RtpVp9RefFinderTest, StashedFramesDoNotWrapTl0Backwards) {
   EXPECT_THAT(frames_, SizeIs(2));
 }
 
+TEST_F(RtpVp9RefFinderTest, GofMissingFrameAfterLongStream) {
+  GofInfoVP9 ss;
+  ss.SetGofInfoVP9(kTemporalStructureMode3);  // 02120212 pattern
+  const int kTids[] = {0, 2, 1, 2};
+  const int kMissingPid = 4 * 150 + 2;
+
+  Insert(Frame().Pid(0).SidAndTid(0, 0).Tl0(0).AsKeyFrame().NotAsInterPic().Gof(
+      &ss));
+  for (int pid = 1; pid < 4 * 200; ++pid) {
+    if (pid != kMissingPid) {
+      Insert(Frame().Pid(pid).SidAndTid(0, kTids[pid % 4]).Tl0(pid / 4 % 256));
+    }
+  }
+  // Only the frame referencing the missing frame is stashed.
+  ASSERT_EQ(frames_.size(), 4UL * 200 - 2);
+
+  Insert(Frame().Pid(kMissingPid).SidAndTid(0, 1).Tl0(kMissingPid / 4));
+  ASSERT_EQ(frames_.size(), 4UL * 200);
+  EXPECT_THAT(frames_, HasFrameWithIdAndRefs(kMissingPid * 5,
+                                             {(kMissingPid - 2) * 5}));
+  EXPECT_THAT(frames_, HasFrameWithIdAndRefs((kMissingPid + 1) * 5,
+                                             {kMissingPid * 5}));
+}
+
 }  // namespace webrtc
@@ -90,7 +90,7 @@ DecodeTargetIndication ScalabilityStructureFullSvc::Dti(
   }
   RTC_DCHECK_GT(sid, config.SpatialId());
   RTC_DCHECK_GE(tid, config.TemporalId());
-  if (config.IsKeyframe() || config.Id() == kKey) {
+  if (config.IsKeyframe() || config.Id() == kKey || config.Id() == kSwitch) {
     return DecodeTargetIndication::kSwitch;
   }
   return DecodeTargetIndication::kRequired;
@@ -115,6 +115,7 @@ ScalabilityStructureFullSvc::NextPattern() const {
       return kDeltaT0;
     case kKey:
     case kDeltaT0:
+    case kSwitch:
       if (TemporalLayerIsActive(2)) {
         return kDeltaT2A;
       }
@@ -141,11 +142,17 @@ ScalabilityStructureFullSvc::NextFrameConfig(bool restart) {
     last_pattern_ = kNone;
   }
   FramePattern current_pattern = NextPattern();
+  if (switch_point_requested_ && current_pattern != kKey) {
+    // A T0 frame is a switch point for the higher temporal layers, so only the
+    // spatial references need to change.
+    current_pattern = kSwitch;
+  }
 
   absl::optional<int> spatial_dependency_buffer_id;
   switch (current_pattern) {
     case kDeltaT0:
     case kKey:
+    case kSwitch:
       // Disallow temporal references cross T0 on higher temporal layers.
       can_reference_t1_frame_for_spatial_id_.reset();
       for (int sid = 0; sid < num_spatial_layers_; ++sid) {
@@ -165,7 +172,8 @@ ScalabilityStructureFullSvc::NextFrameConfig(bool restart) {
           config.Keyframe();
         }
 
-        if (can_reference_t0_frame_for_spatial_id_[sid]) {
+        if (can_reference_t0_frame_for_spatial_id_[sid] &&
+            !(current_pattern == kSwitch && spatial_dependency_buffer_id)) {
           config.ReferenceAndUpdate(BufferIndex(sid, /*tid=*/0));
         } else {
           // TODO(bugs.webrtc.org/11999): Propagate chain restart on delta frame
@@ -255,6 +263,9 @@ GenericFrameInfo ScalabilityStructureFullSvc::OnEncodeDone(
   // pattern defered here from the `NextFrameConfig`.
   // In particular creating VP9 references rely on this behavior.
   last_pattern_ = static_cast<FramePattern>(config.Id());
+  if (last_pattern_ == kKey || last_pattern_ == kSwitch) {
+    switch_point_requested_ = false;
+  }
   if (config.TemporalId() == 0) {
     can_reference_t0_frame_for_spatial_id_.set(config.SpatialId());
   }
@@ -298,6 +309,11 @@ void ScalabilityStructureFullSvc::OnRatesUpdated(
   }
 }
 
+bool ScalabilityStructureFullSvc::RequestSwitchPoint() {
+  switch_point_requested_ = true;
+  return true;
+}
+
 FrameDependencyStructure ScalabilityStructureL1T2::DependencyStructure() const {
   FrameDependencyStructure structure;
   structure.num_decode_targets = 2;
@@ -35,6 +35,10 @@ class ScalabilityStructureFullSvc : public ScalableVideoController {
   std::vector<LayerFrameConfig> NextFrameConfig(bool restart) override;
   GenericFrameInfo OnEncodeDone(const LayerFrameConfig& config) override;
   void OnRatesUpdated(const VideoBitrateAllocation& bitrates) override;
+  // The switch point is a T0 temporal unit where the frames of the spatial
+  // layers above the lowest active one only reference the lower spatial layer,
+  // like in a key frame, while the lowest one is a delta frame.
+  bool RequestSwitchPoint() override;
 
  private:
   enum FramePattern {
@@ -44,9 +48,11 @@ class ScalabilityStructureFullSvc : public ScalableVideoController {
     kDeltaT1,
     kDeltaT2B,
     kDeltaT0,
+    kSwitch,
   };
   static constexpr absl::string_view kFramePatternNames[] = {
-      "None", "Key", "DeltaT2A", "DeltaT1", "DeltaT2B", "DeltaT0"};
+      "None",     "Key",     "DeltaT2A", "DeltaT1",
+      "DeltaT2B", "DeltaT0", "Switch"};
   static constexpr int kMaxNumSpatialLayers = 3;
   static constexpr int kMaxNumTemporalLayers = 3;
 
@@ -71,6 +77,7 @@ class ScalabilityStructureFullSvc : public ScalableVideoController {
   const ScalingFactor resolution_factor_;
 
   FramePattern last_pattern_ = kNone;
+  bool switch_point_requested_ = false;
   std::bitset<kMaxNumSpatialLayers> can_reference_t0_frame_for_spatial_id_ = 0;
   std::bitset<kMaxNumSpatialLayers> can_reference_t1_frame_for_spatial_id_ = 0;
   std::bitset<32> active_decode_targets_;
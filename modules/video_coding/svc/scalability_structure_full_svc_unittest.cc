@@ -18,8 +18,10 @@
 namespace webrtc {
 namespace {
 
+using ::testing::ElementsAre;
 using ::testing::IsEmpty;
 using ::testing::SizeIs;
+using ::testing::UnorderedElementsAre;
 
 TEST(ScalabilityStructureL3T3Test, SkipT0FrameByEncoderKeepsReferencesValid) {
   std::vector<GenericFrameInfo> frames;
@@ -119,5 +121,41 @@ TEST(ScalabilityStructureL3T3Test, SwitchSpatialLayerBeforeT1Frame) {
   EXPECT_EQ(frames[0].temporal_id, 0);
 }
 
+TEST(ScalabilityStructureL3T3Test, SwitchPointReferencesOnlyLowerSpatialLayer) {
+  std::vector<GenericFrameInfo> frames;
+  ScalabilityStructureL3T3 structure;
+  ScalabilityStructureWrapper wrapper(structure);
+
+  // Key frame, followed by T2 and T1 temporal units.
+  wrapper.GenerateFrames(/*num_temporal_units=*/3, frames);
+  ASSERT_THAT(frames, SizeIs(9));
+  ASSERT_EQ(frames[6].temporal_id, 1);
+
+  EXPECT_TRUE(structure.RequestSwitchPoint());
+  wrapper.GenerateFrames(/*num_temporal_units=*/2, frames);
+  ASSERT_THAT(frames, SizeIs(15));
+  // The switch point is a T0 delta frame, even though the temporal pattern
+  // would continue with T2.
+  EXPECT_EQ(frames[9].temporal_id, 0);
+  EXPECT_THAT(frames[9].frame_diffs, ElementsAre(9));
+  // The higher spatial layers only reference the lower spatial layer.
+  EXPECT_THAT(frames[10].frame_diffs, ElementsAre(1));
+  EXPECT_THAT(frames[11].frame_diffs, ElementsAre(1));
+  // Receivers of any decode target may switch to the higher spatial layers.
+  for (int sid = 1; sid < 3; ++sid) {
+    for (int tid = 0; tid < 3; ++tid) {
+      EXPECT_EQ(frames[9].decode_target_indications[sid * 3 + tid],
+                DecodeTargetIndication::kSwitch);
+    }
+  }
+  // The temporal pattern starts over after the switch point.
+  EXPECT_EQ(frames[12].temporal_id, 2);
+  // The next T0 temporal unit is an ordinary delta frame.
+  wrapper.GenerateFrames(/*num_temporal_units=*/3, frames);
+  EXPECT_THAT(frames[22].frame_diffs, UnorderedElementsAre(1, 12));
+
+  EXPECT_TRUE(wrapper.FrameReferencesAreValid(frames));
+}
+
 }  // namespace
 }  // namespace webrtc
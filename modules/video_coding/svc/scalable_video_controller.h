@@ -95,6 +95,13 @@ class ScalableVideoController {
 
   // Returns configuration to pass to EncoderCallback.
   virtual GenericFrameInfo OnEncodeDone(const LayerFrameConfig& config) = 0;
+
+  // Requests that the next temporal unit is a switch point: delta frames from
+  // which a receiver that only decodes a lower decode target can move up to
+  // any higher one, e.g. when an SFU switches a subscriber to a higher layer,
+  // without the cost of a key frame. Returns false if the structure can't
+  // produce such frames, in which case a key frame is needed.
+  virtual bool RequestSwitchPoint() { return false; }
 };
 
 // Below are implementation details.
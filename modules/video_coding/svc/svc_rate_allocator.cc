@@ -269,6 +269,12 @@ VideoBitrateAllocation SvcRateAllocator::Allocate(
   }
   last_active_layer_count_ = num_spatial_layers;
 
+  if (cached_allocation_ &&
+      cached_allocation_->total_bitrate == total_bitrate &&
+      cached_allocation_->num_spatial_layers == num_spatial_layers) {
+    return cached_allocation_->allocation;
+  }
+
   VideoBitrateAllocation allocation;
   if (codec_.mode == VideoCodecMode::kRealtimeVideo) {
     allocation = GetAllocationNormalVideo(total_bitrate, active_layers.first,
@@ -278,6 +284,10 @@ VideoBitrateAllocation SvcRateAllocator::Allocate(
                                             num_spatial_layers);
   }
   allocation.set_bw_limited(num_spatial_layers < active_layers.num);
+  cached_allocation_ =
+      CachedAllocation{.total_bitrate = total_bitrate,
+                       .num_spatial_layers = num_spatial_layers,
+                       .allocation = allocation};
   return allocation;
 }
 
@@ -15,6 +15,8 @@
 #include <stdint.h>
 
 #include "absl/container/inlined_vector.h"
+#include "absl/types/optional.h"
+#include "api/units/data_rate.h"
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video/video_bitrate_allocator.h"
 #include "api/video/video_codec_constants.h"
@@ -56,12 +58,22 @@ class SvcRateAllocator : public VideoBitrateAllocator {
   // actually be enabled.
   size_t FindNumEnabledLayers(DataRate target_rate) const;
 
+  // The allocation only depends on the total bitrate and the number of
+  // enabled layers, so the last one is kept for repeated updates at an
+  // unchanged rate.
+  struct CachedAllocation {
+    DataRate total_bitrate;
+    size_t num_spatial_layers;
+    VideoBitrateAllocation allocation;
+  };
+
   const VideoCodec codec_;
   const NumLayers num_layers_;
   const StableTargetRateExperiment experiment_settings_;
   const absl::InlinedVector<DataRate, kMaxSpatialLayers>
       cumulative_layer_start_bitrates_;
   size_t last_active_layer_count_;
+  absl::optional<CachedAllocation> cached_allocation_;
 };
 
 }  // namespace webrtc
@@ -270,6 +270,26 @@ TEST(SvcRateAllocatorTest, FindLayerTogglingThreshold) {
   EXPECT_EQ(layer_start_bitrates[2], kThreeLayerMinRate);
 }
 
+TEST(SvcRateAllocatorTest, RepeatedRatesGiveSameAllocation) {
+  VideoCodec codec = Configure(1280, 720, 3, 3, false);
+  SvcRateAllocator allocator = SvcRateAllocator(codec);
+  const DataRate low_rate = SvcRateAllocator::GetLayerStartBitrates(codec)[1];
+  const DataRate high_rate = DataRate::KilobitsPerSec(2000);
+
+  VideoBitrateAllocation low_allocation =
+      allocator.Allocate(VideoBitrateAllocationParameters(low_rate, 30));
+  VideoBitrateAllocation high_allocation =
+      allocator.Allocate(VideoBitrateAllocationParameters(high_rate, 30));
+  EXPECT_NE(low_allocation, high_allocation);
+  EXPECT_EQ(
+      allocator.Allocate(VideoBitrateAllocationParameters(high_rate, 30)),
+      high_allocation);
+  EXPECT_EQ(allocator.Allocate(VideoBitrateAllocationParameters(low_rate, 30)),
+            low_allocation);
+  EXPECT_EQ(allocator.Allocate(VideoBitrateAllocationParameters(low_rate, 30)),
+            low_allocation);
+}
+
 TEST(SvcRateAllocatorTest, SupportsAv1) {
   VideoCodec codec;
   codec.width = 640;
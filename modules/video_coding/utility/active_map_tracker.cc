@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/active_map_tracker.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+void ActiveMapTracker::OnInputFrame(const VideoFrame& frame) {
+  if (frame.width() != frame_width_ || frame.height() != frame_height_) {
+    frame_width_ = frame.width();
+    frame_height_ = frame.height();
+    all_changed_ = true;
+  }
+  if (!frame.has_update_rect()) {
+    all_changed_ = true;
+  }
+  if (all_changed_) {
+    return;
+  }
+  changed_.Union(frame.update_rect());
+}
+
+void ActiveMapTracker::OnFrameEncoded() {
+  all_changed_ = false;
+  changed_.MakeEmptyUpdate();
+}
+
+bool ActiveMapTracker::GetActiveMap(int width,
+                                    int height,
+                                    std::vector<uint8_t>& map) const {
+  RTC_DCHECK_GT(width, 0);
+  RTC_DCHECK_GT(height, 0);
+  if (all_changed_) {
+    return false;
+  }
+  // Scaling also grows the rect to cover the taps of the scaling filter.
+  VideoFrame::UpdateRect changed = changed_;
+  if (!changed.IsEmpty() &&
+      (width != frame_width_ || height != frame_height_)) {
+    changed = changed.ScaleWithFrame(frame_width_, frame_height_, 0, 0,
+                                     frame_width_, frame_height_, width,
+                                     height);
+  }
+  const int cols = (width + kBlockSize - 1) / kBlockSize;
+  const int rows = (height + kBlockSize - 1) / kBlockSize;
+  map.assign(rows * cols, 0);
+  if (changed.IsEmpty()) {
+    return true;
+  }
+  const int first_col = changed.offset_x / kBlockSize;
+  const int last_col =
+      std::min(cols - 1, (changed.offset_x + changed.width - 1) / kBlockSize);
+  const int first_row = changed.offset_y / kBlockSize;
+  const int last_row =
+      std::min(rows - 1, (changed.offset_y + changed.height - 1) / kBlockSize);
+  if (first_col == 0 && first_row == 0 && last_col == cols - 1 &&
+      last_row == rows - 1) {
+    return false;
+  }
+  for (int row = first_row; row <= last_row; ++row) {
+    std::fill(map.begin() + row * cols + first_col,
+              map.begin() + row * cols + last_col + 1, 1);
+  }
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_UTILITY_ACTIVE_MAP_TRACKER_H_
+#define MODULES_VIDEO_CODING_UTILITY_ACTIVE_MAP_TRACKER_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/video/video_frame.h"
+
+namespace webrtc {
+
+// Tracks the region of the input frames which changed since an encoder last
+// produced a frame, as given by their update rects, and turns it into the
+// active maps of libvpx and libaom. Those encoders code the inactive blocks
+// of a map as skipped, without any motion search, which makes encoding mostly
+// static content such as screenshare a lot cheaper.
+//
+// Skipped blocks are copied from the last reference frame, so active maps may
+// only be used when every frame references the previous one, i.e. without
+// temporal or spatial layers, and not for key frames.
+//
+// The encoders only set active maps if the field trial `kFieldTrial` is
+// enabled.
+class ActiveMapTracker {
+ public:
+  static constexpr char kFieldTrial[] = "WebRTC-Video-ScreenshareActiveMap";
+  // Size of the square blocks of an active map, in pixels.
+  static constexpr int kBlockSize = 16;
+
+  // Adds the update rect of `frame` to the changed region. Frames without an
+  // update rect, or with a new resolution, change the whole frame.
+  void OnInputFrame(const VideoFrame& frame);
+
+  // Called when the encoder has produced a frame, which the next one will
+  // reference. Until then, the changed region keeps growing, e.g. while the
+  // encoder drops frames.
+  void OnFrameEncoded();
+
+  // Fills `map` with the active map of the input frames scaled to `width` x
+  // `height`, one byte per block row by row, with the blocks which intersect
+  // the changed region set to 1. Returns false, without touching `map`, if the
+  // whole frame changed.
+  bool GetActiveMap(int width, int height, std::vector<uint8_t>& map) const;
+
+ private:
+  int frame_width_ = 0;
+  int frame_height_ = 0;
+  bool all_changed_ = true;
+  VideoFrame::UpdateRect changed_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_UTILITY_ACTIVE_MAP_TRACKER_H_
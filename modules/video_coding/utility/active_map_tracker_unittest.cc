@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/active_map_tracker.h"
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/video/i420_buffer.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 32;
+
+VideoFrame CreateFrame(
+    absl::optional<VideoFrame::UpdateRect> update_rect,
+    int width = kWidth,
+    int height = kHeight) {
+  return VideoFrame::Builder()
+      .set_video_frame_buffer(I420Buffer::Create(width, height))
+      .set_update_rect(update_rect)
+      .build();
+}
+
+TEST(ActiveMapTrackerTest, AllActiveUntilFrameEncoded) {
+  ActiveMapTracker tracker;
+  std::vector<uint8_t> map;
+  tracker.OnInputFrame(CreateFrame(VideoFrame::UpdateRect{0, 0, 1, 1}));
+  EXPECT_FALSE(tracker.GetActiveMap(kWidth, kHeight, map));
+
+  tracker.OnFrameEncoded();
+  tracker.OnInputFrame(CreateFrame(VideoFrame::UpdateRect{0, 0, 0, 0}));
+  ASSERT_TRUE(tracker.GetActiveMap(kWidth, kHeight, map));
+  EXPECT_THAT(map, ElementsAre(0, 0, 0, 0, 0, 0, 0, 0));
+}
+
+TEST(ActiveMapTrackerTest, MarksBlocksIntersectingUpdateRect) {
+  ActiveMapTracker tracker;
+  tracker.OnInputFrame(CreateFrame(absl::nullopt));
+  tracker.OnFrameEncoded();
+  tracker.OnInputFrame(CreateFrame(VideoFrame::UpdateRect{15, 10, 2, 8}));
+  std::vector<uint8_t> map;
+  ASSERT_TRUE(tracker.GetActiveMap(kWidth, kHeight, map));
+  EXPECT_THAT(map, ElementsAre(1, 1, 0, 0,  //
+                               1, 1, 0, 0));
+}
+
+TEST(ActiveMapTrackerTest, AccumulatesUpdateRectsUntilFrameEncoded) {
+  ActiveMapTracker tracker;
+  tracker.OnInputFrame(CreateFrame(absl::nullopt));
+  tracker.OnFrameEncoded();
+  tracker.OnInputFrame(CreateFrame(VideoFrame::UpdateRect{0, 0, 4, 4}));
+  // Dropped by the encoder.
+  tracker.OnInputFrame(CreateFrame(VideoFrame::UpdateRect{20, 0, 4, 4}));
+  std::vector<uint8_t> map;
+  ASSERT_TRUE(tracker.GetActiveMap(kWidth, kHeight, map));
+  EXPECT_THAT(map, ElementsAre(1, 1, 0, 0,  //
+                               0, 0, 0, 0));
+
+  tracker.OnFrameEncoded();
+  tracker.OnInputFrame(CreateFrame(VideoFrame::UpdateRect{48, 16, 16, 16}));
+  ASSERT_TRUE(tracker.GetActiveMap(kWidth, kHeight, map));
+  EXPECT_THAT(map, ElementsAre(0, 0, 0, 0,  //
+                               0, 0, 0, 1));
+}
+
+TEST(ActiveMapTrackerTest, AllActiveIfWholeFrameChanged) {
+  ActiveMapTracker tracker;
+  tracker.OnInputFrame(CreateFrame(absl::nullopt));
+  tracker.OnFrameEncoded();
+  std::vector<uint8_t> map;
+  tracker.OnInputFrame(CreateFrame(absl::nullopt));
+  EXPECT_FALSE(tracker.GetActiveMap(kWidth, kHeight, map));
+
+  tracker.OnFrameEncoded();
+  tracker.OnInputFrame(
+      CreateFrame(VideoFrame::UpdateRect{1, 1, kWidth - 2, kHeight - 2}));
+  EXPECT_FALSE(tracker.GetActiveMap(kWidth, kHeight, map));
+
+  tracker.OnFrameEncoded();
+  tracker.OnInputFrame(
+      CreateFrame(VideoFrame::UpdateRect{0, 0, 0, 0}, kWidth * 2, kHeight));
+  EXPECT_FALSE(tracker.GetActiveMap(kWidth * 2, kHeight, map));
+}
+
+TEST(ActiveMapTrackerTest, ScalesUpdateRectToEncodedResolution) {
+  ActiveMapTracker tracker;
+  tracker.OnInputFrame(CreateFrame(absl::nullopt));
+  tracker.OnFrameEncoded();
+  tracker.OnInputFrame(CreateFrame(VideoFrame::UpdateRect{40, 20, 8, 8}));
+  std::vector<uint8_t> map;
+  ASSERT_TRUE(tracker.GetActiveMap(kWidth / 2, kHeight / 2, map));
+  // Rows and columns are rounded up to whole blocks.
+  EXPECT_THAT(map, ElementsAre(0, 1));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -10,12 +10,17 @@
 
 #include "modules/video_coding/utility/ivf_file_reader.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <string>
 #include <vector>
 
+#include "api/make_ref_counted.h"
 #include "api/video_codecs/video_codec.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/video_coding/utility/ivf_defines.h"
+#include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 
 namespace webrtc {
@@ -34,6 +39,27 @@ constexpr uint8_t kH265Header[kCodecTypeBytesCount] = {'H', '2', '6', '5'};
 // RTP standard required 90kHz clock rate.
 constexpr int32_t kRtpClockRateHz = 90000;
 
+// How far ahead of the read position a memory mapped file is prefetched.
+constexpr size_t kMappedReadAheadBytes = 4 * 1024 * 1024;
+
+// A frame pointing into a memory mapped file, which is read-only.
+class MappedEncodedImageBuffer : public EncodedImageBufferInterface {
+ public:
+  MappedEncodedImageBuffer(rtc::scoped_refptr<MemoryMappedFile> file,
+                           rtc::ArrayView<const uint8_t> data)
+      : file_(std::move(file)), data_(data) {}
+
+  const uint8_t* data() const override { return data_.data(); }
+  // EncodedImage::data() reads through this accessor too, so it has to
+  // return the mapping. Writing to it faults.
+  uint8_t* data() override { return const_cast<uint8_t*>(data_.data()); }
+  size_t size() const override { return data_.size(); }
+
+ private:
+  const rtc::scoped_refptr<MemoryMappedFile> file_;
+  const rtc::ArrayView<const uint8_t> data_;
+};
+
 }  // namespace
 
 std::unique_ptr<IvfFileReader> IvfFileReader::Create(FileWrapper file) {
@@ -44,6 +70,20 @@ std::unique_ptr<IvfFileReader> IvfFileReader::Create(FileWrapper file) {
   }
   return reader;
 }
+
+std::unique_ptr<IvfFileReader> IvfFileReader::Create(
+    rtc::scoped_refptr<MemoryMappedFile> file) {
+  if (!file) {
+    return nullptr;
+  }
+  auto reader =
+      std::unique_ptr<IvfFileReader>(new IvfFileReader(std::move(file)));
+  if (!reader->Reset()) {
+    return nullptr;
+  }
+  return reader;
+}
+
 IvfFileReader::~IvfFileReader() {
   Close();
 }
@@ -51,13 +91,13 @@ IvfFileReader::~IvfFileReader() {
 bool IvfFileReader::Reset() {
   // Set error to true while initialization.
   has_error_ = true;
-  if (!file_.Rewind()) {
+  if (!RewindFile()) {
     RTC_LOG(LS_ERROR) << "Failed to rewind IVF file";
     return false;
   }
 
   uint8_t ivf_header[kIvfHeaderSize] = {0};
-  size_t read = file_.Read(&ivf_header, kIvfHeaderSize);
+  size_t read = ReadFile(&ivf_header, kIvfHeaderSize);
   if (read != kIvfHeaderSize) {
     RTC_LOG(LS_ERROR) << "Failed to read IVF header";
     return false;
@@ -118,6 +158,9 @@ absl::optional<EncodedImage> IvfFileReader::NextFrame() {
 
   rtc::scoped_refptr<EncodedImageBuffer> payload = EncodedImageBuffer::Create();
   std::vector<size_t> layer_sizes;
+  // Layers of a mapped file. A single layer is returned as is, without
+  // copying it to `payload`.
+  std::vector<rtc::ArrayView<const uint8_t>> mapped_layers;
   // next_frame_header_ have to be presented by the way how it was loaded. If it
   // is missing it means there is a bug in error handling.
   RTC_DCHECK(next_frame_header_);
@@ -126,15 +169,21 @@ absl::optional<EncodedImage> IvfFileReader::NextFrame() {
   bool is_first_frame = num_read_frames_ == 0;
   while (next_frame_header_ &&
          current_timestamp == next_frame_header_->timestamp) {
-    // Resize payload to fit next spatial layer.
     size_t current_layer_size = next_frame_header_->frame_size;
-    size_t current_layer_start_pos = payload->size();
-    payload->Realloc(payload->size() + current_layer_size);
     layer_sizes.push_back(current_layer_size);
-
-    // Read next layer into payload
-    size_t read = file_.Read(&payload->data()[current_layer_start_pos],
-                             current_layer_size);
+    size_t read;
+    if (mapped_file_) {
+      mapped_layers.push_back(ReadMapped(current_layer_size));
+      read = mapped_layers.back().size();
+    } else {
+      // Resize payload to fit next spatial layer.
+      size_t current_layer_start_pos = payload->size();
+      payload->Realloc(payload->size() + current_layer_size);
+
+      // Read next layer into payload
+      read = file_.Read(&payload->data()[current_layer_start_pos],
+                        current_layer_size);
+    }
     if (read != current_layer_size) {
       RTC_LOG(LS_ERROR) << "Frame #" << num_read_frames_
                         << ": failed to read frame payload";
@@ -159,7 +208,17 @@ absl::optional<EncodedImage> IvfFileReader::NextFrame() {
   image.capture_time_ms_ = current_timestamp;
   image.SetRtpTimestamp(
       static_cast<uint32_t>(current_timestamp * kRtpClockRateHz / time_scale_));
-  image.SetEncodedData(payload);
+  if (mapped_layers.size() == 1) {
+    image.SetEncodedData(rtc::make_ref_counted<MappedEncodedImageBuffer>(
+        mapped_file_, mapped_layers[0]));
+  } else {
+    for (rtc::ArrayView<const uint8_t> layer : mapped_layers) {
+      size_t layer_start_pos = payload->size();
+      payload->Realloc(payload->size() + layer.size());
+      memcpy(&payload->data()[layer_start_pos], layer.data(), layer.size());
+    }
+    image.SetEncodedData(payload);
+  }
   image.SetSpatialIndex(static_cast<int>(layer_sizes.size()) - 1);
   for (size_t i = 0; i < layer_sizes.size(); ++i) {
     image.SetSpatialLayerFrameSize(static_cast<int>(i), layer_sizes[i]);
@@ -172,6 +231,10 @@ absl::optional<EncodedImage> IvfFileReader::NextFrame() {
 }
 
 bool IvfFileReader::Close() {
+  if (mapped_file_) {
+    mapped_file_ = nullptr;
+    return true;
+  }
   if (!file_.is_open())
     return false;
 
@@ -179,6 +242,45 @@ bool IvfFileReader::Close() {
   return true;
 }
 
+bool IvfFileReader::RewindFile() {
+  if (!mapped_file_) {
+    return file_.Rewind();
+  }
+  mapped_read_pos_ = 0;
+  mapped_prefetch_end_ = 0;
+  return true;
+}
+
+size_t IvfFileReader::ReadFile(void* buffer, size_t size) {
+  if (!mapped_file_) {
+    return file_.Read(buffer, size);
+  }
+  rtc::ArrayView<const uint8_t> data = ReadMapped(size);
+  memcpy(buffer, data.data(), data.size());
+  return data.size();
+}
+
+bool IvfFileReader::ReadEof() const {
+  if (!mapped_file_) {
+    return file_.ReadEof();
+  }
+  return mapped_read_pos_ == mapped_file_->size();
+}
+
+rtc::ArrayView<const uint8_t> IvfFileReader::ReadMapped(size_t size) {
+  RTC_DCHECK(mapped_file_);
+  size = std::min(size, mapped_file_->size() - mapped_read_pos_);
+  rtc::ArrayView<const uint8_t> data =
+      mapped_file_->data().subview(mapped_read_pos_, size);
+  mapped_read_pos_ += data.size();
+  // Keep at least half of the read ahead window prefetched.
+  if (mapped_read_pos_ + kMappedReadAheadBytes / 2 > mapped_prefetch_end_) {
+    mapped_file_->Prefetch(mapped_read_pos_, kMappedReadAheadBytes);
+    mapped_prefetch_end_ = mapped_read_pos_ + kMappedReadAheadBytes;
+  }
+  return data;
+}
+
 absl::optional<VideoCodecType> IvfFileReader::ParseCodecType(uint8_t* buffer,
                                                              size_t start_pos) {
   if (memcmp(&buffer[start_pos], kVp8Header, kCodecTypeBytesCount) == 0) {
@@ -207,9 +309,9 @@ absl::optional<VideoCodecType> IvfFileReader::ParseCodecType(uint8_t* buffer,
 absl::optional<IvfFileReader::FrameHeader>
 IvfFileReader::ReadNextFrameHeader() {
   uint8_t ivf_frame_header[kIvfFrameHeaderSize] = {0};
-  size_t read = file_.Read(&ivf_frame_header, kIvfFrameHeaderSize);
+  size_t read = ReadFile(&ivf_frame_header, kIvfFrameHeaderSize);
   if (read != kIvfFrameHeaderSize) {
-    if (read != 0 || !file_.ReadEof()) {
+    if (read != 0 || !ReadEof()) {
       has_error_ = true;
       RTC_LOG(LS_ERROR) << "Frame #" << num_read_frames_
                         << ": failed to read IVF frame header";
@@ -15,9 +15,11 @@
 #include <utility>
 
 #include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
 #include "api/video/encoded_image.h"
 #include "api/video_codecs/video_codec.h"
 #include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/system/memory_mapped_file.h"
 
 namespace webrtc {
 
@@ -25,6 +27,12 @@ class IvfFileReader {
  public:
   // Creates IvfFileReader. Returns nullptr if error acquired.
   static std::unique_ptr<IvfFileReader> Create(FileWrapper file);
+  // Creates IvfFileReader reading from a memory mapped file. The frames it
+  // returns reference the mapping instead of copying it, unless they have
+  // several spatial layers, and the file is prefetched ahead of the read
+  // position.
+  static std::unique_ptr<IvfFileReader> Create(
+      rtc::scoped_refptr<MemoryMappedFile> file);
   ~IvfFileReader();
 
   IvfFileReader(const IvfFileReader&) = delete;
@@ -57,6 +65,16 @@ class IvfFileReader {
   };
 
   explicit IvfFileReader(FileWrapper file) : file_(std::move(file)) {}
+  explicit IvfFileReader(rtc::scoped_refptr<MemoryMappedFile> file)
+      : mapped_file_(std::move(file)) {}
+
+  // Read from `file_` or `mapped_file_`, whichever is used.
+  bool RewindFile();
+  size_t ReadFile(void* buffer, size_t size);
+  bool ReadEof() const;
+  // Returns a view of the next `size` bytes of `mapped_file_`, or fewer at
+  // the end of the file, and advances the read position past them.
+  rtc::ArrayView<const uint8_t> ReadMapped(size_t size);
 
   // Parses codec type from specified position of the buffer. Codec type
   // contains kCodecTypeBytesCount bytes and caller has to ensure that buffer
@@ -72,6 +90,9 @@ class IvfFileReader {
   uint16_t height_;
   uint32_t time_scale_;
   FileWrapper file_;
+  rtc::scoped_refptr<MemoryMappedFile> mapped_file_;
+  size_t mapped_read_pos_ = 0;
+  size_t mapped_prefetch_end_ = 0;
 
   absl::optional<FrameHeader> next_frame_header_;
   bool has_error_;
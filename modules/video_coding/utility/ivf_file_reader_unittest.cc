@@ -14,6 +14,7 @@
 #include <string>
 
 #include "modules/video_coding/utility/ivf_file_writer.h"
+#include "rtc_base/system/memory_mapped_file.h"
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
 
@@ -103,9 +104,12 @@ class IvfFileReaderTest : public ::testing::Test {
 
   void ValidateContent(VideoCodecType codec_type,
                        bool use_capture_tims_ms,
-                       int spatial_layers_count) {
+                       int spatial_layers_count,
+                       bool memory_mapped = false) {
     std::unique_ptr<IvfFileReader> reader =
-        IvfFileReader::Create(FileWrapper::OpenReadOnly(file_name_));
+        memory_mapped
+            ? IvfFileReader::Create(MemoryMappedFile::Open(file_name_))
+            : IvfFileReader::Create(FileWrapper::OpenReadOnly(file_name_));
     ASSERT_TRUE(reader.get());
     EXPECT_EQ(reader->GetVideoCodecType(), codec_type);
     EXPECT_EQ(reader->GetFramesCount(),
@@ -185,4 +189,33 @@ TEST_F(IvfFileReaderTest, MultilayerH264FileNtpTimestamp) {
   ValidateContent(kVideoCodecH264, false, 3);
 }
 
+#if defined(WEBRTC_POSIX)
+
+TEST_F(IvfFileReaderTest, MemoryMappedVp8File) {
+  CreateTestFile(kVideoCodecVP8, false, 1);
+  ValidateContent(kVideoCodecVP8, false, 1, /*memory_mapped=*/true);
+}
+
+TEST_F(IvfFileReaderTest, MemoryMappedMultilayerVp9File) {
+  CreateTestFile(kVideoCodecVP9, false, 3);
+  ValidateContent(kVideoCodecVP9, false, 3, /*memory_mapped=*/true);
+}
+
+TEST_F(IvfFileReaderTest, MemoryMappedFramesOutliveReader) {
+  CreateTestFile(kVideoCodecVP8, true, 1);
+  std::unique_ptr<IvfFileReader> reader =
+      IvfFileReader::Create(MemoryMappedFile::Open(file_name_));
+  ASSERT_TRUE(reader);
+  absl::optional<EncodedImage> first_frame = reader->NextFrame();
+  ASSERT_TRUE(reader->Reset());
+  absl::optional<EncodedImage> frame = reader->NextFrame();
+  ASSERT_TRUE(first_frame && frame);
+  // Both reads point at the same bytes of the mapping.
+  EXPECT_EQ(first_frame->data(), frame->data());
+  reader = nullptr;
+  ValidateFrame(frame, 1, true, 1);
+}
+
+#endif  // defined(WEBRTC_POSIX)
+
 }  // namespace webrtc
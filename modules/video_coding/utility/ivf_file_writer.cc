@@ -10,17 +10,20 @@
 
 #include "modules/video_coding/utility/ivf_file_writer.h"
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <utility>
 
 #include "absl/strings/string_view.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/video/encoded_image.h"
 #include "api/video/video_codec_type.h"
 #include "api/video_codecs/video_codec.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/video_coding/utility/ivf_defines.h"
+#include "rtc_base/async_file_writer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/system/file_wrapper.h"
@@ -50,6 +53,12 @@ IvfFileWriter::IvfFileWriter(FileWrapper file, size_t byte_limit)
       << "The byte_limit is too low, not even the header will fit.";
 }
 
+IvfFileWriter::IvfFileWriter(std::unique_ptr<AsyncFileWriter> async_file,
+                             size_t byte_limit)
+    : IvfFileWriter(FileWrapper(), byte_limit) {
+  async_file_ = std::move(async_file);
+}
+
 IvfFileWriter::~IvfFileWriter() {
   Close();
 }
@@ -66,13 +75,19 @@ std::unique_ptr<IvfFileWriter> IvfFileWriter::Wrap(absl::string_view filename,
       new IvfFileWriter(FileWrapper::OpenWriteOnly(filename), byte_limit));
 }
 
-bool IvfFileWriter::WriteHeader() {
-  if (!file_.Rewind()) {
-    RTC_LOG(LS_WARNING) << "Unable to rewind ivf output file.";
-    return false;
+std::unique_ptr<IvfFileWriter> IvfFileWriter::Wrap(FileWrapper file,
+                                                   size_t byte_limit,
+                                                   TaskQueueBase* task_queue) {
+  if (!file.is_open()) {
+    return Wrap(std::move(file), byte_limit);
   }
+  return std::unique_ptr<IvfFileWriter>(new IvfFileWriter(
+      std::make_unique<AsyncFileWriter>(std::move(file), task_queue),
+      byte_limit));
+}
 
-  uint8_t ivf_header[kIvfHeaderSize] = {0};
+bool IvfFileWriter::WriteHeader() {
+  std::array<uint8_t, kIvfHeaderSize> ivf_header = {};
   ivf_header[0] = 'D';
   ivf_header[1] = 'K';
   ivf_header[2] = 'I';
@@ -132,9 +147,23 @@ bool IvfFileWriter::WriteHeader() {
                                           static_cast<uint32_t>(num_frames_));
   ByteWriter<uint32_t>::WriteLittleEndian(&ivf_header[28], 0);  // Reserved.
 
-  if (!file_.Write(ivf_header, kIvfHeaderSize)) {
-    RTC_LOG(LS_ERROR) << "Unable to write IVF header for ivf output file.";
-    return false;
+  if (async_file_) {
+    // The header is rewritten at the start of the file once all frames
+    // buffered so far have been written.
+    async_file_->PostFileTask([ivf_header](FileWrapper& file) {
+      if (!file.Rewind() || !file.Write(ivf_header.data(), kIvfHeaderSize)) {
+        RTC_LOG(LS_ERROR) << "Unable to write IVF header for ivf output file.";
+      }
+    });
+  } else {
+    if (!file_.Rewind()) {
+      RTC_LOG(LS_WARNING) << "Unable to rewind ivf output file.";
+      return false;
+    }
+    if (!file_.Write(ivf_header.data(), kIvfHeaderSize)) {
+      RTC_LOG(LS_ERROR) << "Unable to write IVF header for ivf output file.";
+      return false;
+    }
   }
 
   if (bytes_written_ < kIvfHeaderSize) {
@@ -172,7 +201,7 @@ bool IvfFileWriter::InitFromFirstFrame(const EncodedImage& encoded_image,
 
 bool IvfFileWriter::WriteFrame(const EncodedImage& encoded_image,
                                VideoCodecType codec_type) {
-  if (!file_.is_open())
+  if (!file_.is_open() && !async_file_)
     return false;
 
   if (num_frames_ == 0 && !InitFromFirstFrame(encoded_image, codec_type))
@@ -226,8 +255,13 @@ bool IvfFileWriter::WriteOneSpatialLayer(int64_t timestamp,
   ByteWriter<uint32_t>::WriteLittleEndian(&frame_header[0],
                                           static_cast<uint32_t>(size));
   ByteWriter<uint64_t>::WriteLittleEndian(&frame_header[4], timestamp);
-  if (!file_.Write(frame_header, kFrameHeaderSize) ||
-      !file_.Write(data, size)) {
+  if (async_file_) {
+    // Dropped frames are counted by the AsyncFileWriter.
+    if (!async_file_->Write({frame_header, {data, size}})) {
+      return false;
+    }
+  } else if (!file_.Write(frame_header, kFrameHeaderSize) ||
+             !file_.Write(data, size)) {
     RTC_LOG(LS_ERROR) << "Unable to write frame to file.";
     return false;
   }
@@ -239,6 +273,13 @@ bool IvfFileWriter::WriteOneSpatialLayer(int64_t timestamp,
 }
 
 bool IvfFileWriter::Close() {
+  if (async_file_) {
+    bool ret = num_frames_ == 0 || WriteHeader();
+    // Blocks until the buffered frames and the header have been written.
+    async_file_ = nullptr;
+    return ret;
+  }
+
   if (!file_.is_open())
     return false;
 
@@ -17,8 +17,10 @@
 #include <memory>
 
 #include "absl/strings/string_view.h"
+#include "api/task_queue/task_queue_base.h"
 #include "api/video/encoded_image.h"
 #include "api/video/video_codec_type.h"
+#include "rtc_base/async_file_writer.h"
 #include "rtc_base/numerics/sequence_number_unwrapper.h"
 #include "rtc_base/system/file_wrapper.h"
 
@@ -34,6 +36,13 @@ class IvfFileWriter {
                                              size_t byte_limit);
   static std::unique_ptr<IvfFileWriter> Wrap(absl::string_view filename,
                                              size_t byte_limit);
+  // As above, but the file is written on `task_queue` through an
+  // AsyncFileWriter, so that WriteFrame doesn't block on file IO. Frames that
+  // don't fit in its buffer are dropped. `task_queue` must outlive the
+  // IvfFileWriter, which must not be destroyed on it.
+  static std::unique_ptr<IvfFileWriter> Wrap(FileWrapper file,
+                                             size_t byte_limit,
+                                             TaskQueueBase* task_queue);
   ~IvfFileWriter();
 
   IvfFileWriter(const IvfFileWriter&) = delete;
@@ -43,7 +52,8 @@ class IvfFileWriter {
   bool Close();
 
  private:
-  explicit IvfFileWriter(FileWrapper file, size_t byte_limit);
+  IvfFileWriter(FileWrapper file, size_t byte_limit);
+  IvfFileWriter(std::unique_ptr<AsyncFileWriter> async_file, size_t byte_limit);
 
   bool WriteHeader();
   bool InitFromFirstFrame(const EncodedImage& encoded_image,
@@ -62,6 +72,7 @@ class IvfFileWriter {
   bool using_capture_timestamps_;
   RtpTimestampUnwrapper wrap_handler_;
   FileWrapper file_;
+  std::unique_ptr<AsyncFileWriter> async_file_;
 };
 
 }  // namespace webrtc
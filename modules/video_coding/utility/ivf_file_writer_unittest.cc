@@ -16,6 +16,7 @@
 #include <string>
 
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "rtc_base/task_queue_for_test.h"
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
 
@@ -200,6 +201,53 @@ TEST_F(IvfFileWriterTest, ClosesWhenReachesLimit) {
   out_file.Close();
 }
 
+TEST_F(IvfFileWriterTest, WritesFileThroughTaskQueue) {
+  const uint8_t fourcc[4] = {'V', 'P', '8', '0'};
+  const int kWidth = 320;
+  const int kHeight = 240;
+  const int kNumFrames = 257;
+  TaskQueueForTest task_queue;
+
+  file_writer_ = IvfFileWriter::Wrap(FileWrapper::OpenWriteOnly(file_name_), 0,
+                                     task_queue.Get());
+  ASSERT_TRUE(file_writer_.get());
+  ASSERT_TRUE(
+      WriteDummyTestFrames(kVideoCodecVP8, kWidth, kHeight, kNumFrames, true));
+  EXPECT_TRUE(file_writer_->Close());
+
+  FileWrapper out_file = FileWrapper::OpenReadOnly(file_name_);
+  VerifyIvfHeader(&out_file, fourcc, kWidth, kHeight, kNumFrames, true);
+  VerifyDummyTestFrames(&out_file, kNumFrames);
+
+  out_file.Close();
+}
+
+TEST_F(IvfFileWriterTest, ClosesThroughTaskQueueWhenReachesLimit) {
+  const uint8_t fourcc[4] = {'V', 'P', '8', '0'};
+  const int kWidth = 320;
+  const int kHeight = 240;
+  const int kNumFramesToWrite = 2;
+  const int kNumFramesToFit = 1;
+  TaskQueueForTest task_queue;
+
+  file_writer_ = IvfFileWriter::Wrap(
+      FileWrapper::OpenWriteOnly(file_name_),
+      kHeaderSize +
+          kNumFramesToFit * (kFrameHeaderSize + sizeof(dummy_payload)),
+      task_queue.Get());
+  ASSERT_TRUE(file_writer_.get());
+
+  ASSERT_FALSE(WriteDummyTestFrames(kVideoCodecVP8, kWidth, kHeight,
+                                    kNumFramesToWrite, true));
+  ASSERT_FALSE(file_writer_->Close());
+
+  FileWrapper out_file = FileWrapper::OpenReadOnly(file_name_);
+  VerifyIvfHeader(&out_file, fourcc, kWidth, kHeight, kNumFramesToFit, true);
+  VerifyDummyTestFrames(&out_file, kNumFramesToFit);
+
+  out_file.Close();
+}
+
 TEST_F(IvfFileWriterTest, UseDefaultValueWhenWidthAndHeightAreZero) {
   const uint8_t fourcc[4] = {'V', 'P', '8', '0'};
   const int kWidth = 0;
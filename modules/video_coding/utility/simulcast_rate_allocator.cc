@@ -17,7 +17,6 @@
 #include <cstdint>
 #include <numeric>
 #include <string>
-#include <tuple>
 #include <vector>
 
 #include "rtc_base/checks.h"
@@ -42,6 +41,19 @@ static const float kBaseHeavy3TlRateAllocation[kMaxTemporalStreams] = {
 
 const uint32_t kLegacyScreenshareTl0BitrateKbps = 200;
 const uint32_t kLegacyScreenshareTl1BitrateKbps = 1000;
+
+// Sorts the layers by maxBitrate, they might not always be from smallest to
+// biggest.
+std::vector<size_t> SortStreamsByMaxBitrate(const VideoCodec& codec) {
+  std::vector<size_t> layer_index(codec.numberOfSimulcastStreams);
+  std::iota(layer_index.begin(), layer_index.end(), 0);
+  std::stable_sort(layer_index.begin(), layer_index.end(),
+                   [&codec](size_t a, size_t b) {
+                     return codec.simulcastStream[a].maxBitrate <
+                            codec.simulcastStream[b].maxBitrate;
+                   });
+  return layer_index;
+}
 }  // namespace
 
 float SimulcastRateAllocator::GetTemporalRateAllocation(
@@ -60,6 +72,7 @@ float SimulcastRateAllocator::GetTemporalRateAllocation(
 
 SimulcastRateAllocator::SimulcastRateAllocator(const VideoCodec& codec)
     : codec_(codec),
+      sorted_stream_indices_(SortStreamsByMaxBitrate(codec)),
       stable_rate_settings_(StableTargetRateExperiment::ParseFromFieldTrials()),
       rate_control_settings_(RateControlSettings::ParseFromFieldTrials()),
       legacy_conference_mode_(false) {}
@@ -68,15 +81,31 @@ SimulcastRateAllocator::~SimulcastRateAllocator() = default;
 
 VideoBitrateAllocation SimulcastRateAllocator::Allocate(
     VideoBitrateAllocationParameters parameters) {
-  VideoBitrateAllocation allocated_bitrates;
   DataRate stable_rate = parameters.total_bitrate;
   if (stable_rate_settings_.IsEnabled() &&
       parameters.stable_bitrate > DataRate::Zero()) {
     stable_rate = std::min(parameters.stable_bitrate, parameters.total_bitrate);
   }
+  if (cached_allocation_ &&
+      cached_allocation_->total_bitrate == parameters.total_bitrate &&
+      cached_allocation_->stable_bitrate == stable_rate) {
+    return cached_allocation_->allocation;
+  }
+
+  const std::vector<bool> stream_enabled_before = stream_enabled_;
+  VideoBitrateAllocation allocated_bitrates;
   DistributeAllocationToSimulcastLayers(parameters.total_bitrate, stable_rate,
                                         &allocated_bitrates);
   DistributeAllocationToTemporalLayers(&allocated_bitrates);
+  if (stream_enabled_ == stream_enabled_before) {
+    cached_allocation_ = CachedAllocation{
+        .total_bitrate = parameters.total_bitrate,
+        .stable_bitrate = stable_rate,
+        .allocation = allocated_bitrates};
+  } else {
+    // With hysteresis, the same rates may give a different allocation now.
+    cached_allocation_ = absl::nullopt;
+  }
   return allocated_bitrates;
 }
 
@@ -105,15 +134,7 @@ void SimulcastRateAllocator::DistributeAllocationToSimulcastLayers(
     return;
   }
 
-  // Sort the layers by maxFramerate, they might not always be from smallest
-  // to biggest
-  std::vector<size_t> layer_index(codec_.numberOfSimulcastStreams);
-  std::iota(layer_index.begin(), layer_index.end(), 0);
-  std::stable_sort(layer_index.begin(), layer_index.end(),
-                   [this](size_t a, size_t b) {
-                     return std::tie(codec_.simulcastStream[a].maxBitrate) <
-                            std::tie(codec_.simulcastStream[b].maxBitrate);
-                   });
+  const std::vector<size_t>& layer_index = sorted_stream_indices_;
 
   // Find the first active layer. We don't allocate to inactive layers.
   size_t active_layer = 0;
@@ -338,6 +359,7 @@ int SimulcastRateAllocator::NumTemporalStreams(size_t simulcast_id) const {
 
 void SimulcastRateAllocator::SetLegacyConferenceMode(bool enabled) {
   legacy_conference_mode_ = enabled;
+  cached_allocation_ = absl::nullopt;
 }
 
 }  // namespace webrtc
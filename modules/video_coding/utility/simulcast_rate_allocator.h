@@ -16,6 +16,8 @@
 
 #include <vector>
 
+#include "absl/types/optional.h"
+#include "api/units/data_rate.h"
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video/video_bitrate_allocator.h"
 #include "api/video_codecs/video_codec.h"
@@ -58,11 +60,23 @@ class SimulcastRateAllocator : public VideoBitrateAllocator {
       int simulcast_id) const;
   int NumTemporalStreams(size_t simulcast_id) const;
 
+  // The result of the last Allocate() call, if it didn't change which
+  // streams are enabled. Allocating for the same rates then gives the same
+  // result, so repeated updates at an unchanged rate can return it.
+  struct CachedAllocation {
+    DataRate total_bitrate;
+    DataRate stable_bitrate;
+    VideoBitrateAllocation allocation;
+  };
+
   const VideoCodec codec_;
+  // Simulcast stream indices sorted by max bitrate.
+  const std::vector<size_t> sorted_stream_indices_;
   const StableTargetRateExperiment stable_rate_settings_;
   const RateControlSettings rate_control_settings_;
   std::vector<bool> stream_enabled_;
   bool legacy_conference_mode_;
+  absl::optional<CachedAllocation> cached_allocation_;
 };
 
 }  // namespace webrtc
@@ -647,6 +647,40 @@ TEST_F(SimulcastRateAllocatorTest, StableRate) {
   }
 }
 
+TEST_F(SimulcastRateAllocatorTest, RepeatedRatesKeepHysteresis) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-StableTargetRate/"
+      "enabled:true,"
+      "video_hysteresis_factor:1.1/");
+
+  SetupCodec3SL3TL({true, true, true});
+  CreateAllocator();
+
+  const DataRate volatile_rate =
+      (TargetRate(0) + TargetRate(1) + MinRate(2)) * 1.1;
+  const DataRate two_streams_rate = TargetRate(0) + MinRate(1);
+  const struct {
+    DataRate stable_rate;
+    bool second_stream_enabled;
+  } kSteps[] = {
+      {two_streams_rate - DataRate::BitsPerSec(1), false},
+      {two_streams_rate, false},
+      {two_streams_rate, false},
+      {two_streams_rate * 1.1, true},
+      {two_streams_rate * 1.1, true},
+      {two_streams_rate, true},
+      {two_streams_rate, true},
+      {two_streams_rate - DataRate::BitsPerSec(1), false},
+      {two_streams_rate, false},
+  };
+  for (const auto& step : kSteps) {
+    VideoBitrateAllocation allocation =
+        GetAllocation(volatile_rate, step.stable_rate);
+    EXPECT_EQ(allocation.IsSpatialLayerUsed(1), step.second_stream_enabled)
+        << ToString(step.stable_rate);
+  }
+}
+
 class ScreenshareRateAllocationTest : public SimulcastRateAllocatorTest {
  public:
   void SetupConferenceScreenshare(bool use_simulcast, bool active = true) {
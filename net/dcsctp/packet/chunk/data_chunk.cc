@@ -69,20 +69,26 @@ absl::optional<DataChunk> DataChunk::Parse(rtc::ArrayView<const uint8_t> data) {
                    options);
 }
 
+void DataChunk::SerializeTo(TSN tsn,
+                            const Data& data,
+                            ImmediateAckFlag immediate_ack,
+                            std::vector<uint8_t>& out) {
+  BoundedByteWriter<kHeaderSize> writer = AllocateTLV(out, data.payload.size());
+
+  writer.Store8<1>((*data.is_end ? (1 << kFlagsBitEnd) : 0) |
+                   (*data.is_beginning ? (1 << kFlagsBitBeginning) : 0) |
+                   (*data.is_unordered ? (1 << kFlagsBitUnordered) : 0) |
+                   (*immediate_ack ? (1 << kFlagsBitImmediateAck) : 0));
+  writer.Store32<4>(*tsn);
+  writer.Store16<8>(*data.stream_id);
+  writer.Store16<10>(*data.ssn);
+  writer.Store32<12>(*data.ppid);
+
+  writer.CopyToVariableData(data.payload);
+}
+
 void DataChunk::SerializeTo(std::vector<uint8_t>& out) const {
-  BoundedByteWriter<kHeaderSize> writer = AllocateTLV(out, payload().size());
-
-  writer.Store8<1>(
-      (*options().is_end ? (1 << kFlagsBitEnd) : 0) |
-      (*options().is_beginning ? (1 << kFlagsBitBeginning) : 0) |
-      (*options().is_unordered ? (1 << kFlagsBitUnordered) : 0) |
-      (*options().immediate_ack ? (1 << kFlagsBitImmediateAck) : 0));
-  writer.Store32<4>(*tsn());
-  writer.Store16<8>(*stream_id());
-  writer.Store16<10>(*ssn());
-  writer.Store32<12>(*ppid());
-
-  writer.CopyToVariableData(payload());
+  SerializeTo(tsn(), data(), options().immediate_ack, out);
 }
 
 std::string DataChunk::ToString() const {
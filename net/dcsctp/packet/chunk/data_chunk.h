@@ -61,6 +61,13 @@ class DataChunk : public AnyDataChunk, public TLVTrait<DataChunkConfig> {
 
   static absl::optional<DataChunk> Parse(rtc::ArrayView<const uint8_t> data);
 
+  // Serializes `data` as a chunk with the provided `tsn`, without having to
+  // take ownership of it, e.g. when it's kept around for retransmission.
+  static void SerializeTo(TSN tsn,
+                          const Data& data,
+                          ImmediateAckFlag immediate_ack,
+                          std::vector<uint8_t>& out);
+
   void SerializeTo(std::vector<uint8_t>& out) const override;
   std::string ToString() const override;
 };
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "api/array_view.h"
+#include "net/dcsctp/packet/data.h"
 #include "net/dcsctp/testing/testing_macros.h"
 #include "rtc_base/gunit.h"
 #include "test/gmock.h"
@@ -70,5 +71,28 @@ TEST(DataChunkTest, SerializeAndDeserialize) {
             "DATA, type=ordered::middle, tsn=123, sid=456, ssn=789, ppid=9090, "
             "length=5");
 }
+
+TEST(DataChunkTest, SerializeFromDataWithoutTakingOwnership) {
+  Data data(StreamID(456), SSN(789), MID(0), FSN(0), PPID(9090),
+            {1, 2, 3, 4, 5}, Data::IsBeginning(true), Data::IsEnd(false),
+            IsUnordered(true));
+
+  std::vector<uint8_t> serialized;
+  DataChunk::SerializeTo(TSN(123), data, DataChunk::ImmediateAckFlag(true),
+                         serialized);
+  EXPECT_THAT(data.payload, ElementsAre(1, 2, 3, 4, 5));
+
+  ASSERT_HAS_VALUE_AND_ASSIGN(DataChunk deserialized,
+                              DataChunk::Parse(serialized));
+  EXPECT_EQ(*deserialized.tsn(), 123u);
+  EXPECT_EQ(*deserialized.stream_id(), 456u);
+  EXPECT_EQ(*deserialized.ssn(), 789u);
+  EXPECT_EQ(*deserialized.ppid(), 9090u);
+  EXPECT_TRUE(*deserialized.options().is_beginning);
+  EXPECT_FALSE(*deserialized.options().is_end);
+  EXPECT_TRUE(*deserialized.options().is_unordered);
+  EXPECT_TRUE(*deserialized.options().immediate_ack);
+  EXPECT_THAT(deserialized.payload(), ElementsAre(1, 2, 3, 4, 5));
+}
 }  // namespace
 }  // namespace dcsctp
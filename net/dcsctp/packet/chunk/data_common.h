@@ -80,6 +80,8 @@ class AnyDataChunk : public Chunk {
       : tsn_(tsn), data_(std::move(data)), immediate_ack_(immediate_ack) {}
 
  protected:
+  const Data& data() const { return data_; }
+
   // Bits in `flags` header field.
   static constexpr int kFlagsBitEnd = 0;
   static constexpr int kFlagsBitBeginning = 1;
@@ -73,19 +73,25 @@ absl::optional<IDataChunk> IDataChunk::Parse(
                     options);
 }
 
-void IDataChunk::SerializeTo(std::vector<uint8_t>& out) const {
-  BoundedByteWriter<kHeaderSize> writer = AllocateTLV(out, payload().size());
+void IDataChunk::SerializeTo(TSN tsn,
+                             const Data& data,
+                             ImmediateAckFlag immediate_ack,
+                             std::vector<uint8_t>& out) {
+  BoundedByteWriter<kHeaderSize> writer = AllocateTLV(out, data.payload.size());
+
+  writer.Store8<1>((*data.is_end ? (1 << kFlagsBitEnd) : 0) |
+                   (*data.is_beginning ? (1 << kFlagsBitBeginning) : 0) |
+                   (*data.is_unordered ? (1 << kFlagsBitUnordered) : 0) |
+                   (*immediate_ack ? (1 << kFlagsBitImmediateAck) : 0));
+  writer.Store32<4>(*tsn);
+  writer.Store16<8>(*data.stream_id);
+  writer.Store32<12>(*data.mid);
+  writer.Store32<16>(data.is_beginning ? *data.ppid : *data.fsn);
+  writer.CopyToVariableData(data.payload);
+}
 
-  writer.Store8<1>(
-      (*options().is_end ? (1 << kFlagsBitEnd) : 0) |
-      (*options().is_beginning ? (1 << kFlagsBitBeginning) : 0) |
-      (*options().is_unordered ? (1 << kFlagsBitUnordered) : 0) |
-      (*options().immediate_ack ? (1 << kFlagsBitImmediateAck) : 0));
-  writer.Store32<4>(*tsn());
-  writer.Store16<8>(*stream_id());
-  writer.Store32<12>(*mid());
-  writer.Store32<16>(options().is_beginning ? *ppid() : *fsn());
-  writer.CopyToVariableData(payload());
+void IDataChunk::SerializeTo(std::vector<uint8_t>& out) const {
+  SerializeTo(tsn(), data(), options().immediate_ack, out);
 }
 
 std::string IDataChunk::ToString() const {
@@ -19,6 +19,15 @@ namespace dcsctp {
 // Generates the CRC32C checksum of `data`.
 uint32_t GenerateCrc32C(rtc::ArrayView<const uint8_t> data);
 
+// Allows the CRC32C checksum to be calculated incrementally, while data is
+// produced or consumed in pieces, which avoids an additional pass over it.
+// `ExtendCrc32C` returns the running CRC32C value for `crc` (the value for the
+// preceding data, or zero if there's none) followed by `data`, and
+// `FinalizeCrc32C` turns it into the checksum, as returned by
+// `GenerateCrc32C`.
+uint32_t ExtendCrc32C(uint32_t crc, rtc::ArrayView<const uint8_t> data);
+uint32_t FinalizeCrc32C(uint32_t crc);
+
 }  // namespace dcsctp
 
 #endif  // NET_DCSCTP_PACKET_CRC32C_H_
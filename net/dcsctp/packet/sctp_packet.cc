@@ -52,9 +52,13 @@ SctpPacket::Builder::Builder(VerificationTag verification_tag,
     : verification_tag_(verification_tag),
       source_port_(options.local_port),
       dest_port_(options.remote_port),
-      max_packet_size_(RoundDownTo4(options.mtu)) {}
+      max_packet_size_(RoundDownTo4(options.mtu)),
+      incremental_checksum_(!options.enable_zero_checksum) {}
 
 SctpPacket::Builder& SctpPacket::Builder::Add(const Chunk& chunk) {
+  // The data that is added by this call, including the common header if it's
+  // the first chunk.
+  const size_t offset = out_.size();
   if (out_.empty()) {
     out_.reserve(max_packet_size_);
     out_.resize(SctpPacket::kHeaderSize);
@@ -70,6 +74,11 @@ SctpPacket::Builder& SctpPacket::Builder::Add(const Chunk& chunk) {
   if (out_.size() % 4 != 0) {
     out_.resize(RoundUpTo4(out_.size()));
   }
+  if (incremental_checksum_) {
+    // The checksum field is still zero, as required when calculating it.
+    crc32c_ = ExtendCrc32C(
+        crc32c_, rtc::ArrayView<const uint8_t>(out_).subview(offset));
+  }
 
   RTC_DCHECK(out_.size() <= max_packet_size_)
       << "Exceeded max size, data=" << out_.size()
@@ -94,9 +103,11 @@ std::vector<uint8_t> SctpPacket::Builder::Build(bool write_checksum) {
   out_.swap(out);
 
   if (!out.empty() && write_checksum) {
-    uint32_t crc = GenerateCrc32C(out);
+    uint32_t crc = incremental_checksum_ ? FinalizeCrc32C(crc32c_)
+                                         : GenerateCrc32C(out);
     BoundedByteWriter<kHeaderSize>(out).Store32<8>(crc);
   }
+  crc32c_ = 0;
 
   RTC_DCHECK(out.size() <= max_packet_size_)
       << "Exceeded max size, data=" << out.size()
@@ -121,10 +132,6 @@ absl::optional<SctpPacket> SctpPacket::Parse(rtc::ArrayView<const uint8_t> data,
   common_header.verification_tag = VerificationTag(reader.Load32<4>());
   common_header.checksum = reader.Load32<8>();
 
-  // Create a copy of the packet, which will be held by this object.
-  std::vector<uint8_t> data_copy =
-      std::vector<uint8_t>(data.begin(), data.end());
-
   if (options.disable_checksum_verification ||
       (options.enable_zero_checksum && common_header.checksum == 0u)) {
     // https://www.ietf.org/archive/id/draft-tuexen-tsvwg-sctp-zero-checksum-01.html#section-4.3:
@@ -133,9 +140,13 @@ absl::optional<SctpPacket> SctpPacket::Parse(rtc::ArrayView<const uint8_t> data,
     // checksum value of zero in addition to SCTP packets containing the correct
     // CRC32c checksum value for this association.
   } else {
-    // Verify the checksum. The checksum field must be zero when that's done.
-    BoundedByteWriter<kHeaderSize>(data_copy).Store32<8>(0);
-    uint32_t calculated_checksum = GenerateCrc32C(data_copy);
+    // Verify the checksum. The checksum field must be zero when that's done,
+    // so it's replaced by zeros while calculating it.
+    static constexpr uint8_t kZeroChecksum[4] = {0, 0, 0, 0};
+    uint32_t crc = ExtendCrc32C(0, data.subview(0, 8));
+    crc = ExtendCrc32C(crc, kZeroChecksum);
+    crc = ExtendCrc32C(crc, data.subview(kHeaderSize));
+    uint32_t calculated_checksum = FinalizeCrc32C(crc);
     if (calculated_checksum != common_header.checksum) {
       RTC_DLOG(LS_WARNING) << rtc::StringFormat(
           "Invalid packet checksum, packet_checksum=0x%08x, "
@@ -143,11 +154,12 @@ absl::optional<SctpPacket> SctpPacket::Parse(rtc::ArrayView<const uint8_t> data,
           common_header.checksum, calculated_checksum);
       return absl::nullopt;
     }
-    // Restore the checksum in the header.
-    BoundedByteWriter<kHeaderSize>(data_copy).Store32<8>(
-        common_header.checksum);
   }
 
+  // Create a copy of the packet, which will be held by this object.
+  std::vector<uint8_t> data_copy =
+      std::vector<uint8_t>(data.begin(), data.end());
+
   // Validate and parse the chunk headers in the message.
   /*
     0                   1                   2                   3
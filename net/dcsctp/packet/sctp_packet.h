@@ -85,6 +85,10 @@ class SctpPacket {
     // The maximum packet size is always even divisible by four, as chunks are
     // always padded to a size even divisible by four.
     size_t max_packet_size_;
+    // Unless zero checksums may be used, the checksum is calculated while the
+    // chunks are added, when their data is still in the cache.
+    bool incremental_checksum_;
+    uint32_t crc32c_ = 0;
     std::vector<uint8_t> out_;
   };
 
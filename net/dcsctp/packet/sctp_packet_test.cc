@@ -438,5 +438,27 @@ TEST(SctpPacketTest, WritePacketWithZeroChecksum) {
                           0x00, 0x01, 0xc8, 0x00, 0x00, 0x00, 0x00));
 }
 
+TEST(SctpPacketTest, IncrementalChecksumMatchesChecksumOfBuiltPacket) {
+  DcSctpOptions zero_checksum_options;
+  zero_checksum_options.enable_zero_checksum = true;
+  SctpPacket::Builder incremental(kVerificationTag, {});
+  SctpPacket::Builder at_build(kVerificationTag, zero_checksum_options);
+
+  // The builders are reused, so that the checksum is reset between packets.
+  for (uint8_t payload_size : {1, 2, 7}) {
+    for (SctpPacket::Builder* b : {&incremental, &at_build}) {
+      b->Add(SackChunk(/*cumulative_tsn_ack=*/TSN(999), /*a_rwnd=*/456,
+                       /*gap_ack_blocks=*/{},
+                       /*duplicate_tsns=*/{}));
+      b->Add(DataChunk(TSN(1), StreamID(1), SSN(0), PPID(53),
+                       std::vector<uint8_t>(payload_size, payload_size),
+                       /*options=*/{}));
+    }
+    std::vector<uint8_t> packet = incremental.Build();
+    EXPECT_EQ(packet, at_build.Build());
+    EXPECT_TRUE(SctpPacket::Parse(packet, kVerifyChecksumOptions).has_value());
+  }
+}
+
 }  // namespace
 }  // namespace dcsctp
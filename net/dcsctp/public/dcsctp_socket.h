@@ -298,6 +298,31 @@ class DcSctpSocketCallbacks {
     return SendPacketStatus::kSuccess;
   }
 
+  // Called instead of `SendPacketWithStatus` for the packets of a burst, i.e.
+  // when the congestion window allows sending multiple packets in one go. The
+  // packets are passed one at a time, and the end of the burst is signaled by
+  // `OnPacketBurstEnd`. Clients may override this method to hold on to the
+  // packets and send them together when the burst ends, e.g. by using batched
+  // socket writes. Failures that are known up front, e.g. a transport that
+  // isn't writable, must still be returned right away, since the library
+  // stops the burst at the first packet that isn't successfully sent. The
+  // default implementation sends the packet using `SendPacketWithStatus`.
+  //
+  // Note that it's NOT ALLOWED to call into this library from within this
+  // callback.
+  virtual SendPacketStatus SendBurstPacketWithStatus(
+      rtc::ArrayView<const uint8_t> data) {
+    return SendPacketWithStatus(data);
+  }
+
+  // Called after the last packet of a burst was passed to
+  // `SendBurstPacketWithStatus`. Clients holding on to the packets of the
+  // burst must send them before returning.
+  //
+  // Note that it's NOT ALLOWED to call into this library from within this
+  // callback.
+  virtual void OnPacketBurstEnd() {}
+
   // Called when the library wants to create a Timeout. The callback must return
   // an object that implements that interface.
   //
@@ -92,6 +92,20 @@ int TraditionalReassemblyStreams::UnorderedStream::Add(UnwrappedTSN tsn,
     return 0;
   }
 
+  // A message containing this chunk can only be complete if the chunk is
+  // connected to a beginning and to an end. Checking the neighbours first
+  // avoids walking all fragments of a partially received message, which is
+  // quadratic when many fragments arrive in order.
+  if (!it->second.is_beginning &&
+      (it == chunks_.begin() ||
+       std::prev(it)->first.next_value() != it->first)) {
+    return queued_bytes;
+  }
+  if (!it->second.is_end && (std::next(it) == chunks_.end() ||
+                             std::next(it)->first != it->first.next_value())) {
+    return queued_bytes;
+  }
+
   queued_bytes -= TryToAssembleMessage(it);
 
   return queued_bytes;
@@ -99,10 +113,6 @@ int TraditionalReassemblyStreams::UnorderedStream::Add(UnwrappedTSN tsn,
 
 size_t TraditionalReassemblyStreams::UnorderedStream::TryToAssembleMessage(
     ChunkMap::iterator iter) {
-  // TODO(boivie): This method is O(N) with the number of fragments in a
-  // message, which can be inefficient for very large values of N. This could be
-  // optimized by e.g. only trying to assemble a message once _any_ beginning
-  // and _any_ end has been found.
   absl::optional<ChunkMap::iterator> start = FindBeginning(chunks_, iter);
   if (!start.has_value()) {
     return 0;
@@ -124,7 +134,7 @@ size_t TraditionalReassemblyStreams::StreamBase::AssembleMessage(
 
   if (count == 1) {
     // Fast path - zero-copy
-    const Data& data = start->second;
+    Data& data = start->second;
     size_t payload_size = start->second.size();
     UnwrappedTSN tsns[1] = {start->first};
     DcSctpMessage message(data.stream_id, data.ppid, std::move(data.payload));
@@ -140,9 +150,13 @@ size_t TraditionalReassemblyStreams::StreamBase::AssembleMessage(
       start, end, 0,
       [](size_t v, const auto& p) { return v + p.second.size(); });
 
+  // The payload of the first fragment is reused, and the others are appended
+  // to it.
   tsns.reserve(count);
+  tsns.push_back(start->first);
+  payload = std::move(start->second.payload);
   payload.reserve(payload_size);
-  for (auto it = start; it != end; ++it) {
+  for (auto it = std::next(start); it != end; ++it) {
     const Data& data = it->second;
     tsns.push_back(it->first);
     payload.insert(payload.end(), data.payload.begin(), data.payload.end());
@@ -253,5 +253,25 @@ TEST_F(TraditionalReassemblyStreamsTest, CanDeleteFirstOrderedMessage) {
   EXPECT_EQ(streams.Add(tsn(2), gen_.Ordered({2, 3, 4}, "BE")), 0);
 }
 
+TEST_F(TraditionalReassemblyStreamsTest,
+       AssemblesUnorderedMessageWhenMiddleFragmentArrivesLast) {
+  NiceMock<MockFunction<ReassemblyStreams::OnAssembledMessage>> on_assembled;
+  EXPECT_CALL(on_assembled,
+              Call(ElementsAre(tsn(1), tsn(2), tsn(3), tsn(4)),
+                   Property(&DcSctpMessage::payload,
+                            ElementsAre(1, 2, 3, 4, 5, 6))));
+
+  TraditionalReassemblyStreams streams("", on_assembled.AsStdFunction());
+
+  Data first = gen_.Unordered({1}, "B");
+  Data second = gen_.Unordered({2, 3});
+  Data third = gen_.Unordered({4, 5});
+  Data last = gen_.Unordered({6}, "E");
+  EXPECT_EQ(streams.Add(tsn(4), std::move(last)), 1);
+  EXPECT_EQ(streams.Add(tsn(1), std::move(first)), 1);
+  EXPECT_EQ(streams.Add(tsn(3), std::move(third)), 2);
+  EXPECT_EQ(streams.Add(tsn(2), std::move(second)), -4);
+}
+
 }  // namespace
 }  // namespace dcsctp
@@ -63,6 +63,17 @@ SendPacketStatus CallbackDeferrer::SendPacketWithStatus(
   return underlying_.SendPacketWithStatus(data);
 }
 
+SendPacketStatus CallbackDeferrer::SendBurstPacketWithStatus(
+    rtc::ArrayView<const uint8_t> data) {
+  // Will not be deferred - call directly.
+  return underlying_.SendBurstPacketWithStatus(data);
+}
+
+void CallbackDeferrer::OnPacketBurstEnd() {
+  // Will not be deferred - call directly.
+  underlying_.OnPacketBurstEnd();
+}
+
 std::unique_ptr<Timeout> CallbackDeferrer::CreateTimeout(
     webrtc::TaskQueueBase::DelayPrecision precision) {
   // Will not be deferred - call directly.
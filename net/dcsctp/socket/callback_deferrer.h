@@ -62,6 +62,9 @@ class CallbackDeferrer : public DcSctpSocketCallbacks {
   // Implementation of DcSctpSocketCallbacks
   SendPacketStatus SendPacketWithStatus(
       rtc::ArrayView<const uint8_t> data) override;
+  SendPacketStatus SendBurstPacketWithStatus(
+      rtc::ArrayView<const uint8_t> data) override;
+  void OnPacketBurstEnd() override;
   std::unique_ptr<Timeout> CreateTimeout(
       webrtc::TaskQueueBase::DelayPrecision precision) override;
   TimeMs TimeMillis() override;
@@ -2051,6 +2051,27 @@ TEST_P(DcSctpSocketParametrizedTest, DoesntSendMoreThanMaxBurstPackets) {
   MaybeHandoverSocketAndSendMessage(a, std::move(z));
 }
 
+TEST_P(DcSctpSocketParametrizedTest, StopsBurstAtFirstPacketThatFailsToSend) {
+  SocketUnderTest a("A");
+  auto z = std::make_unique<SocketUnderTest>("Z");
+
+  ConnectSockets(a, *z);
+  z = MaybeHandoverSocket(std::move(z));
+
+  // The congestion window allows a full burst, but the first packet fails.
+  EXPECT_CALL(a.cb, SendPacketWithStatus)
+      .WillOnce(testing::Return(SendPacketStatus::kTemporaryFailure));
+  EXPECT_CALL(a.cb, OnPacketBurstEnd);
+  a.socket.Send(DcSctpMessage(StreamID(1), PPID(53),
+                              std::vector<uint8_t>(kLargeMessageSize)),
+                kSendOptions);
+
+  // Only the data of the failed packet was taken from the send queue.
+  EXPECT_GE(a.socket.buffered_amount(StreamID(1)),
+            kLargeMessageSize - a.options.mtu);
+  EXPECT_THAT(a.cb.ConsumeSentPacket(), IsEmpty());
+}
+
 TEST_P(DcSctpSocketParametrizedTest, SendsOnlyLargePackets) {
   SocketUnderTest a("A");
   auto z = std::make_unique<SocketUnderTest>("Z");
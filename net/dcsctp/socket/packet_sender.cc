@@ -27,8 +27,25 @@ bool PacketSender::Send(SctpPacket::Builder& builder, bool write_checksum) {
   }
 
   std::vector<uint8_t> payload = builder.Build(write_checksum);
+  return OnSent(payload, callbacks_.SendPacketWithStatus(payload));
+}
+
+bool PacketSender::SendInBurst(SctpPacket::Builder& builder,
+                               bool write_checksum) {
+  if (builder.empty()) {
+    return false;
+  }
 
-  SendPacketStatus status = callbacks_.SendPacketWithStatus(payload);
+  std::vector<uint8_t> payload = builder.Build(write_checksum);
+  return OnSent(payload, callbacks_.SendBurstPacketWithStatus(payload));
+}
+
+void PacketSender::EndBurst() {
+  callbacks_.OnPacketBurstEnd();
+}
+
+bool PacketSender::OnSent(rtc::ArrayView<const uint8_t> payload,
+                          SendPacketStatus status) {
   on_sent_packet_(payload, status);
   switch (status) {
     case SendPacketStatus::kSuccess: {
@@ -45,4 +62,5 @@ bool PacketSender::Send(SctpPacket::Builder& builder, bool write_checksum) {
     }
   }
 }
+
 }  // namespace dcsctp
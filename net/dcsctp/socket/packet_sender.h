@@ -10,6 +10,11 @@
 #ifndef NET_DCSCTP_SOCKET_PACKET_SENDER_H_
 #define NET_DCSCTP_SOCKET_PACKET_SENDER_H_
 
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "api/array_view.h"
 #include "net/dcsctp/packet/sctp_packet.h"
 #include "net/dcsctp/public/dcsctp_socket.h"
 
@@ -27,7 +32,15 @@ class PacketSender {
   // Sends the packet, and returns true if it was sent successfully.
   bool Send(SctpPacket::Builder& builder, bool write_checksum = true);
 
+  // Like `Send`, for a packet that is part of a burst. `EndBurst` must be
+  // called after the last packet of the burst.
+  bool SendInBurst(SctpPacket::Builder& builder, bool write_checksum = true);
+  void EndBurst();
+
  private:
+  // Notifies `on_sent_packet_`, and returns true if `status` is a success.
+  bool OnSent(rtc::ArrayView<const uint8_t> payload, SendPacketStatus status);
+
   DcSctpSocketCallbacks& callbacks_;
 
   // Callback that will be triggered for every send attempt, indicating the
@@ -46,5 +46,22 @@ TEST_F(PacketSenderTest, SendPacketCallsCallback) {
   EXPECT_FALSE(sender_.Send(PacketBuilder().Add(CookieAckChunk())));
 }
 
+TEST_F(PacketSenderTest, SendsBurstPacketsWithSendPacketWithStatusByDefault) {
+  EXPECT_CALL(callbacks_, SendPacketWithStatus).Times(2);
+  EXPECT_CALL(on_send_fn_, Call(_, SendPacketStatus::kSuccess)).Times(2);
+  EXPECT_TRUE(sender_.SendInBurst(PacketBuilder().Add(CookieAckChunk())));
+  EXPECT_TRUE(sender_.SendInBurst(PacketBuilder().Add(CookieAckChunk())));
+
+  EXPECT_CALL(callbacks_, OnPacketBurstEnd);
+  sender_.EndBurst();
+}
+
+TEST_F(PacketSenderTest, SendInBurstReturnsFailure) {
+  EXPECT_CALL(callbacks_, SendPacketWithStatus)
+      .WillOnce(testing::Return(SendPacketStatus::kTemporaryFailure));
+  EXPECT_CALL(on_send_fn_, Call(_, SendPacketStatus::kTemporaryFailure));
+  EXPECT_FALSE(sender_.SendInBurst(PacketBuilder().Add(CookieAckChunk())));
+}
+
 }  // namespace
 }  // namespace dcsctp
@@ -18,12 +18,14 @@
 
 #include "absl/types/optional.h"
 #include "api/units/time_delta.h"
+#include "net/dcsctp/packet/chunk/chunk.h"
 #include "net/dcsctp/packet/chunk/data_chunk.h"
 #include "net/dcsctp/packet/chunk/forward_tsn_chunk.h"
 #include "net/dcsctp/packet/chunk/idata_chunk.h"
 #include "net/dcsctp/packet/chunk/iforward_tsn_chunk.h"
 #include "net/dcsctp/packet/chunk/reconfig_chunk.h"
 #include "net/dcsctp/packet/chunk/sack_chunk.h"
+#include "net/dcsctp/packet/data.h"
 #include "net/dcsctp/packet/sctp_packet.h"
 #include "net/dcsctp/public/dcsctp_options.h"
 #include "net/dcsctp/public/types.h"
@@ -38,9 +40,41 @@
 #include "rtc_base/strings/string_builder.h"
 
 namespace dcsctp {
+namespace {
 using ::webrtc::TimeDelta;
 using ::webrtc::Timestamp;
 
+// A DATA or I-DATA chunk that refers to data owned by the retransmission queue,
+// which allows it to be serialized into the packet without first being copied.
+class DataChunkRef : public Chunk {
+ public:
+  DataChunkRef(TSN tsn, const Data& data, bool message_interleaving)
+      : tsn_(tsn), data_(data), message_interleaving_(message_interleaving) {}
+
+  void SerializeTo(std::vector<uint8_t>& out) const override {
+    AnyDataChunk::ImmediateAckFlag immediate_ack(false);
+    if (message_interleaving_) {
+      IDataChunk::SerializeTo(tsn_, data_, immediate_ack, out);
+    } else {
+      DataChunk::SerializeTo(tsn_, data_, immediate_ack, out);
+    }
+  }
+
+  std::string ToString() const override {
+    rtc::StringBuilder sb;
+    sb << (message_interleaving_ ? "I-DATA" : "DATA") << ", tsn=" << *tsn_
+       << ", stream_id=" << *data_.stream_id
+       << ", length=" << data_.payload.size();
+    return sb.Release();
+  }
+
+ private:
+  const TSN tsn_;
+  const Data& data_;
+  const bool message_interleaving_;
+};
+}  // namespace
+
 TransmissionControlBlock::TransmissionControlBlock(
     TimerManager& timer_manager,
     absl::string_view log_prefix,
@@ -199,18 +233,18 @@ void TransmissionControlBlock::MaybeSendFastRetransmit() {
   SctpPacket::Builder builder(peer_verification_tag_, options_);
   auto chunks = retransmission_queue_.GetChunksForFastRetransmit(
       builder.bytes_remaining());
-  for (auto& [tsn, data] : chunks) {
-    if (capabilities_.message_interleaving) {
-      builder.Add(IDataChunk(tsn, std::move(data), false));
-    } else {
-      builder.Add(DataChunk(tsn, std::move(data), false));
-    }
+  for (const auto& [tsn, data] : chunks) {
+    builder.Add(DataChunkRef(tsn, *data, capabilities_.message_interleaving));
   }
   Send(builder);
 }
 
 void TransmissionControlBlock::SendBufferedPackets(SctpPacket::Builder& builder,
                                                    Timestamp now) {
+  // The packets are sent as a burst, so that the client can send them
+  // together. Each packet is sent as soon as it's built, so that no chunks are
+  // taken from the retransmission queue after a packet failed to be sent.
+  bool burst_started = false;
   for (int packet_idx = 0;
        packet_idx < options_.max_burst && retransmission_queue_.can_send_data();
        ++packet_idx) {
@@ -245,12 +279,8 @@ void TransmissionControlBlock::SendBufferedPackets(SctpPacket::Builder& builder,
 
     auto chunks =
         retransmission_queue_.GetChunksToSend(now, builder.bytes_remaining());
-    for (auto& [tsn, data] : chunks) {
-      if (capabilities_.message_interleaving) {
-        builder.Add(IDataChunk(tsn, std::move(data), false));
-      } else {
-        builder.Add(DataChunk(tsn, std::move(data), false));
-      }
+    for (const auto& [tsn, data] : chunks) {
+      builder.Add(DataChunkRef(tsn, *data, capabilities_.message_interleaving));
     }
 
     // https://www.ietf.org/archive/id/draft-tuexen-tsvwg-sctp-zero-checksum-02.html#section-4.2
@@ -259,7 +289,11 @@ void TransmissionControlBlock::SendBufferedPackets(SctpPacket::Builder& builder,
     // ECHO chunk."
     bool write_checksum =
         !capabilities_.zero_checksum || cookie_echo_chunk_.has_value();
-    if (!packet_sender_.Send(builder, write_checksum)) {
+    if (builder.empty()) {
+      break;
+    }
+    burst_started = true;
+    if (!packet_sender_.SendInBurst(builder, write_checksum)) {
       break;
     }
 
@@ -270,6 +304,9 @@ void TransmissionControlBlock::SendBufferedPackets(SctpPacket::Builder& builder,
       break;
     }
   }
+  if (burst_started) {
+    packet_sender_.EndBurst();
+  }
 }
 
 std::string TransmissionControlBlock::ToString() const {
@@ -10,6 +10,7 @@
 #include "net/dcsctp/tx/outstanding_data.h"
 
 #include <algorithm>
+#include <map>
 #include <set>
 #include <utility>
 #include <vector>
@@ -86,19 +87,19 @@ bool OutstandingData::IsConsistent() const {
                                       to_be_fast_retransmitted_.end());
 
   std::set<UnwrappedTSN> actual_combined_to_be_retransmitted;
-  for (const auto& [tsn, item] : outstanding_data_) {
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    const Item& item = outstanding_data_[i];
     if (item.is_outstanding()) {
       actual_outstanding_bytes += GetSerializedChunkSize(item.data());
       ++actual_outstanding_items;
     }
 
     if (item.should_be_retransmitted()) {
-      actual_combined_to_be_retransmitted.insert(tsn);
+      actual_combined_to_be_retransmitted.insert(GetTsn(i));
     }
   }
 
-  if (outstanding_data_.empty() &&
-      next_tsn_ != last_cumulative_tsn_ack_.next_value()) {
+  if (next_tsn_ != GetTsn(outstanding_data_.size())) {
     return false;
   }
 
@@ -108,22 +109,22 @@ bool OutstandingData::IsConsistent() const {
 }
 
 void OutstandingData::AckChunk(AckInfo& ack_info,
-                               std::map<UnwrappedTSN, Item>::iterator iter) {
-  if (!iter->second.is_acked()) {
-    size_t serialized_size = GetSerializedChunkSize(iter->second.data());
+                               UnwrappedTSN tsn,
+                               Item& item) {
+  if (!item.is_acked()) {
+    size_t serialized_size = GetSerializedChunkSize(item.data());
     ack_info.bytes_acked += serialized_size;
-    if (iter->second.is_outstanding()) {
+    if (item.is_outstanding()) {
       outstanding_bytes_ -= serialized_size;
       --outstanding_items_;
     }
-    if (iter->second.should_be_retransmitted()) {
-      RTC_DCHECK(to_be_fast_retransmitted_.find(iter->first) ==
+    if (item.should_be_retransmitted()) {
+      RTC_DCHECK(to_be_fast_retransmitted_.find(tsn) ==
                  to_be_fast_retransmitted_.end());
-      to_be_retransmitted_.erase(iter->first);
+      to_be_retransmitted_.erase(tsn);
     }
-    iter->second.Ack();
-    ack_info.highest_tsn_acked =
-        std::max(ack_info.highest_tsn_acked, iter->first);
+    item.Ack();
+    ack_info.highest_tsn_acked = std::max(ack_info.highest_tsn_acked, tsn);
   }
 }
 
@@ -148,21 +149,28 @@ OutstandingData::AckInfo OutstandingData::HandleSack(
 
 void OutstandingData::RemoveAcked(UnwrappedTSN cumulative_tsn_ack,
                                   AckInfo& ack_info) {
-  auto first_unacked = outstanding_data_.upper_bound(cumulative_tsn_ack);
-
-  for (auto iter = outstanding_data_.begin(); iter != first_unacked; ++iter) {
-    AckChunk(ack_info, iter);
-    if (iter->second.lifecycle_id().IsSet()) {
-      RTC_DCHECK(iter->second.data().is_end);
-      if (iter->second.is_abandoned()) {
-        ack_info.abandoned_lifecycle_ids.push_back(iter->second.lifecycle_id());
+  RTC_DCHECK(cumulative_tsn_ack >= last_cumulative_tsn_ack_);
+  RTC_DCHECK(cumulative_tsn_ack <= highest_outstanding_tsn());
+  size_t num_acked = std::min(GetIndex(cumulative_tsn_ack.next_value()),
+                              outstanding_data_.size());
+
+  for (size_t i = 0; i < num_acked; ++i) {
+    Item& item = outstanding_data_[i];
+    AckChunk(ack_info, GetTsn(i), item);
+    if (item.lifecycle_id().IsSet()) {
+      RTC_DCHECK(item.data().is_end);
+      if (item.is_abandoned()) {
+        ack_info.abandoned_lifecycle_ids.push_back(item.lifecycle_id());
       } else {
-        ack_info.acked_lifecycle_ids.push_back(iter->second.lifecycle_id());
+        ack_info.acked_lifecycle_ids.push_back(item.lifecycle_id());
       }
     }
   }
 
-  outstanding_data_.erase(outstanding_data_.begin(), first_unacked);
+  // Items can't be moved, which `std::deque::erase` would require.
+  for (size_t i = 0; i < num_acked; ++i) {
+    outstanding_data_.pop_front();
+  }
   last_cumulative_tsn_ack_ = cumulative_tsn_ack;
   stream_reset_breakpoint_tsns_.erase(stream_reset_breakpoint_tsns_.begin(),
                                       stream_reset_breakpoint_tsns_.upper_bound(
@@ -178,13 +186,14 @@ void OutstandingData::AckGapBlocks(
   // SACK chunk as advisory.". Note that when NR-SACK is supported, this can be
   // handled differently.
 
+  // The cumulative TSN ack has already been applied, so the gap block offsets,
+  // which are relative to it, are one more than the indexes.
+  RTC_DCHECK(cumulative_tsn_ack == last_cumulative_tsn_ack_);
   for (auto& block : gap_ack_blocks) {
-    auto start = outstanding_data_.lower_bound(
-        UnwrappedTSN::AddTo(cumulative_tsn_ack, block.start));
-    auto end = outstanding_data_.upper_bound(
-        UnwrappedTSN::AddTo(cumulative_tsn_ack, block.end));
-    for (auto iter = start; iter != end; ++iter) {
-      AckChunk(ack_info, iter);
+    size_t start = std::max<size_t>(block.start, 1) - 1;
+    size_t end = std::min<size_t>(block.end, outstanding_data_.size());
+    for (size_t i = start; i < end; ++i) {
+      AckChunk(ack_info, GetTsn(i), outstanding_data_[i]);
     }
   }
 }
@@ -215,19 +224,22 @@ void OutstandingData::NackBetweenAckBlocks(
         gap_ack_blocks.empty() ? 0 : gap_ack_blocks.rbegin()->end);
   }
 
-  UnwrappedTSN prev_block_last_acked = cumulative_tsn_ack;
+  // As in `AckGapBlocks`, the index of a TSN is one less than its offset from
+  // `cumulative_tsn_ack`. Nacking may append items, when abandoning messages,
+  // so iterators can't be held.
+  size_t prev_block_end = 0;
   for (auto& block : gap_ack_blocks) {
-    UnwrappedTSN cur_block_first_acked =
-        UnwrappedTSN::AddTo(cumulative_tsn_ack, block.start);
-    for (auto iter = outstanding_data_.upper_bound(prev_block_last_acked);
-         iter != outstanding_data_.lower_bound(cur_block_first_acked); ++iter) {
-      if (iter->first <= max_tsn_to_nack) {
+    size_t cur_block_start = std::max<size_t>(block.start, 1) - 1;
+    for (size_t i = prev_block_end;
+         i < std::min(cur_block_start, outstanding_data_.size()); ++i) {
+      UnwrappedTSN tsn = GetTsn(i);
+      if (tsn <= max_tsn_to_nack) {
         ack_info.has_packet_loss |=
-            NackItem(iter->first, iter->second, /*retransmit_now=*/false,
+            NackItem(tsn, outstanding_data_[i], /*retransmit_now=*/false,
                      /*do_fast_retransmit=*/!is_in_fast_recovery);
       }
     }
-    prev_block_last_acked = UnwrappedTSN::AddTo(cumulative_tsn_ack, block.end);
+    prev_block_end = std::max<size_t>(prev_block_end, block.end);
   }
 
   // Note that packets are not NACKED which are above the highest gap-ack-block
@@ -281,14 +293,10 @@ void OutstandingData::AbandonAllFor(const Item& item) {
                      item.data().fsn, item.data().ppid, std::vector<uint8_t>(),
                      Data::IsBeginning(false), Data::IsEnd(true),
                      item.data().is_unordered);
-    Item& added_item =
-        outstanding_data_
-            .emplace(std::piecewise_construct, std::forward_as_tuple(tsn),
-                     std::forward_as_tuple(
-                         item.message_id(), std::move(message_end),
-                         Timestamp::Zero(), MaxRetransmits(0),
-                         Timestamp::PlusInfinity(), LifecycleId::NotSet()))
-            .first->second;
+    RTC_DCHECK(tsn == GetTsn(outstanding_data_.size()));
+    Item& added_item = outstanding_data_.emplace_back(
+        item.message_id(), std::move(message_end), Timestamp::Zero(),
+        MaxRetransmits(0), Timestamp::PlusInfinity(), LifecycleId::NotSet());
     // The added chunk shouldn't be included in `outstanding_bytes`, so set it
     // as acked.
     added_item.Ack();
@@ -296,10 +304,12 @@ void OutstandingData::AbandonAllFor(const Item& item) {
                          << *tsn.Wrap();
   }
 
-  for (auto& [tsn, other] : outstanding_data_) {
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    Item& other = outstanding_data_[i];
     if (!other.is_abandoned() &&
         other.data().stream_id == item.data().stream_id &&
         other.message_id() == item.message_id()) {
+      UnwrappedTSN tsn = GetTsn(i);
       RTC_DLOG(LS_VERBOSE) << "Marking chunk " << *tsn.Wrap()
                            << " as abandoned";
       if (other.should_be_retransmitted()) {
@@ -311,16 +321,15 @@ void OutstandingData::AbandonAllFor(const Item& item) {
   }
 }
 
-std::vector<std::pair<TSN, Data>> OutstandingData::ExtractChunksThatCanFit(
-    std::set<UnwrappedTSN>& chunks,
-    size_t max_size) {
-  std::vector<std::pair<TSN, Data>> result;
+std::vector<std::pair<TSN, const Data*>>
+OutstandingData::ExtractChunksThatCanFit(std::set<UnwrappedTSN>& chunks,
+                                         size_t max_size) {
+  std::vector<std::pair<TSN, const Data*>> result;
 
   for (auto it = chunks.begin(); it != chunks.end();) {
     UnwrappedTSN tsn = *it;
-    auto elem = outstanding_data_.find(tsn);
-    RTC_DCHECK(elem != outstanding_data_.end());
-    Item& item = elem->second;
+    RTC_DCHECK_LT(GetIndex(tsn), outstanding_data_.size());
+    Item& item = outstanding_data_[GetIndex(tsn)];
     RTC_DCHECK(item.should_be_retransmitted());
     RTC_DCHECK(!item.is_outstanding());
     RTC_DCHECK(!item.is_abandoned());
@@ -329,7 +338,7 @@ std::vector<std::pair<TSN, Data>> OutstandingData::ExtractChunksThatCanFit(
     size_t serialized_size = GetSerializedChunkSize(item.data());
     if (serialized_size <= max_size) {
       item.MarkAsRetransmitted();
-      result.emplace_back(tsn.Wrap(), item.data().Clone());
+      result.emplace_back(tsn.Wrap(), &item.data());
       max_size -= serialized_size;
       outstanding_bytes_ += serialized_size;
       ++outstanding_items_;
@@ -345,9 +354,9 @@ std::vector<std::pair<TSN, Data>> OutstandingData::ExtractChunksThatCanFit(
   return result;
 }
 
-std::vector<std::pair<TSN, Data>>
+std::vector<std::pair<TSN, const Data*>>
 OutstandingData::GetChunksToBeFastRetransmitted(size_t max_size) {
-  std::vector<std::pair<TSN, Data>> result =
+  std::vector<std::pair<TSN, const Data*>> result =
       ExtractChunksThatCanFit(to_be_fast_retransmitted_, max_size);
 
   // https://datatracker.ietf.org/doc/html/rfc4960#section-7.2.4
@@ -366,22 +375,24 @@ OutstandingData::GetChunksToBeFastRetransmitted(size_t max_size) {
   return result;
 }
 
-std::vector<std::pair<TSN, Data>> OutstandingData::GetChunksToBeRetransmitted(
-    size_t max_size) {
+std::vector<std::pair<TSN, const Data*>>
+OutstandingData::GetChunksToBeRetransmitted(size_t max_size) {
   // Chunks scheduled for fast retransmission must be sent first.
   RTC_DCHECK(to_be_fast_retransmitted_.empty());
   return ExtractChunksThatCanFit(to_be_retransmitted_, max_size);
 }
 
 void OutstandingData::ExpireOutstandingChunks(Timestamp now) {
-  for (const auto& [tsn, item] : outstanding_data_) {
+  // Abandoning may append items, so iterators can't be held.
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    const Item& item = outstanding_data_[i];
     // Chunks that are nacked can be expired. Care should be taken not to expire
     // unacked (in-flight) chunks as they might have been received, but the SACK
     // is either delayed or in-flight and may be received later.
     if (item.is_abandoned()) {
       // Already abandoned.
     } else if (item.is_nacked() && item.has_expired(now)) {
-      RTC_DLOG(LS_VERBOSE) << "Marking nacked chunk " << *tsn.Wrap()
+      RTC_DLOG(LS_VERBOSE) << "Marking nacked chunk " << *GetTsn(i).Wrap()
                            << " and message " << *item.data().mid
                            << " as expired";
       AbandonAllFor(item);
@@ -394,13 +405,13 @@ void OutstandingData::ExpireOutstandingChunks(Timestamp now) {
 }
 
 UnwrappedTSN OutstandingData::highest_outstanding_tsn() const {
-  return outstanding_data_.empty() ? last_cumulative_tsn_ack_
-                                   : outstanding_data_.rbegin()->first;
+  return UnwrappedTSN::AddTo(last_cumulative_tsn_ack_,
+                             static_cast<int>(outstanding_data_.size()));
 }
 
 absl::optional<UnwrappedTSN> OutstandingData::Insert(
     OutgoingMessageId message_id,
-    const Data& data,
+    Data data,
     Timestamp time_sent,
     MaxRetransmits max_retransmissions,
     Timestamp expires_at,
@@ -412,20 +423,18 @@ absl::optional<UnwrappedTSN> OutstandingData::Insert(
   size_t chunk_size = GetSerializedChunkSize(data);
   outstanding_bytes_ += chunk_size;
   ++outstanding_items_;
-  auto it = outstanding_data_
-                .emplace(std::piecewise_construct, std::forward_as_tuple(tsn),
-                         std::forward_as_tuple(message_id, data.Clone(),
-                                               time_sent, max_retransmissions,
-                                               expires_at, lifecycle_id))
-                .first;
-
-  if (it->second.has_expired(time_sent)) {
+  RTC_DCHECK(tsn == GetTsn(outstanding_data_.size()));
+  Item& item = outstanding_data_.emplace_back(message_id, std::move(data),
+                                              time_sent, max_retransmissions,
+                                              expires_at, lifecycle_id);
+
+  if (item.has_expired(time_sent)) {
     // No need to send it - it was expired when it was in the send
     // queue.
-    RTC_DLOG(LS_VERBOSE) << "Marking freshly produced chunk "
-                         << *it->first.Wrap() << " and message "
-                         << *it->second.data().mid << " as expired";
-    AbandonAllFor(it->second);
+    RTC_DLOG(LS_VERBOSE) << "Marking freshly produced chunk " << *tsn.Wrap()
+                         << " and message " << *item.data().mid
+                         << " as expired";
+    AbandonAllFor(item);
     RTC_DCHECK(IsConsistent());
     return absl::nullopt;
   }
@@ -435,9 +444,12 @@ absl::optional<UnwrappedTSN> OutstandingData::Insert(
 }
 
 void OutstandingData::NackAll() {
-  for (auto& [tsn, item] : outstanding_data_) {
+  // Nacking may append items, when abandoning messages, so iterators can't be
+  // held.
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    Item& item = outstanding_data_[i];
     if (!item.is_acked()) {
-      NackItem(tsn, item, /*retransmit_now=*/true,
+      NackItem(GetTsn(i), item, /*retransmit_now=*/true,
                /*do_fast_retransmit=*/false);
     }
   }
@@ -446,14 +458,18 @@ void OutstandingData::NackAll() {
 
 webrtc::TimeDelta OutstandingData::MeasureRTT(Timestamp now,
                                               UnwrappedTSN tsn) const {
-  auto it = outstanding_data_.find(tsn);
-  if (it != outstanding_data_.end() && !it->second.has_been_retransmitted()) {
+  if (tsn <= last_cumulative_tsn_ack_ ||
+      GetIndex(tsn) >= outstanding_data_.size()) {
+    return webrtc::TimeDelta::PlusInfinity();
+  }
+  const Item& item = outstanding_data_[GetIndex(tsn)];
+  if (!item.has_been_retransmitted()) {
     // https://tools.ietf.org/html/rfc4960#section-6.3.1
     // "Karn's algorithm: RTT measurements MUST NOT be made using
     // packets that were retransmitted (and thus for which it is ambiguous
     // whether the reply was for the first instance of the chunk or for a
     // later instance)"
-    return now - it->second.time_sent();
+    return now - item.time_sent();
   }
   return webrtc::TimeDelta::PlusInfinity();
 }
@@ -462,7 +478,8 @@ std::vector<std::pair<TSN, OutstandingData::State>>
 OutstandingData::GetChunkStatesForTesting() const {
   std::vector<std::pair<TSN, State>> states;
   states.emplace_back(last_cumulative_tsn_ack_.Wrap(), State::kAcked);
-  for (const auto& [tsn, item] : outstanding_data_) {
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    const Item& item = outstanding_data_[i];
     State state;
     if (item.is_abandoned()) {
       state = State::kAbandoned;
@@ -476,27 +493,23 @@ OutstandingData::GetChunkStatesForTesting() const {
       state = State::kNacked;
     }
 
-    states.emplace_back(tsn.Wrap(), state);
+    states.emplace_back(GetTsn(i).Wrap(), state);
   }
   return states;
 }
 
 bool OutstandingData::ShouldSendForwardTsn() const {
-  if (!outstanding_data_.empty()) {
-    auto it = outstanding_data_.begin();
-    return it->first == last_cumulative_tsn_ack_.next_value() &&
-           it->second.is_abandoned();
-  }
-  return false;
+  return !outstanding_data_.empty() && outstanding_data_.front().is_abandoned();
 }
 
 ForwardTsnChunk OutstandingData::CreateForwardTsn() const {
   std::map<StreamID, SSN> skipped_per_ordered_stream;
   UnwrappedTSN new_cumulative_ack = last_cumulative_tsn_ack_;
 
-  for (const auto& [tsn, item] : outstanding_data_) {
-    if (stream_reset_breakpoint_tsns_.contains(tsn) ||
-        (tsn != new_cumulative_ack.next_value()) || !item.is_abandoned()) {
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    const Item& item = outstanding_data_[i];
+    UnwrappedTSN tsn = GetTsn(i);
+    if (stream_reset_breakpoint_tsns_.contains(tsn) || !item.is_abandoned()) {
       break;
     }
     new_cumulative_ack = tsn;
@@ -518,9 +531,10 @@ IForwardTsnChunk OutstandingData::CreateIForwardTsn() const {
   std::map<std::pair<IsUnordered, StreamID>, MID> skipped_per_stream;
   UnwrappedTSN new_cumulative_ack = last_cumulative_tsn_ack_;
 
-  for (const auto& [tsn, item] : outstanding_data_) {
-    if (stream_reset_breakpoint_tsns_.contains(tsn) ||
-        (tsn != new_cumulative_ack.next_value()) || !item.is_abandoned()) {
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    const Item& item = outstanding_data_[i];
+    UnwrappedTSN tsn = GetTsn(i);
+    if (stream_reset_breakpoint_tsns_.contains(tsn) || !item.is_abandoned()) {
       break;
     }
     new_cumulative_ack = tsn;
@@ -10,7 +10,7 @@
 #ifndef NET_DCSCTP_TX_OUTSTANDING_DATA_H_
 #define NET_DCSCTP_TX_OUTSTANDING_DATA_H_
 
-#include <map>
+#include <deque>
 #include <set>
 #include <utility>
 #include <vector>
@@ -24,6 +24,7 @@
 #include "net/dcsctp/packet/chunk/sack_chunk.h"
 #include "net/dcsctp/packet/data.h"
 #include "net/dcsctp/public/types.h"
+#include "rtc_base/checks.h"
 #include "rtc_base/containers/flat_set.h"
 
 namespace dcsctp {
@@ -92,12 +93,16 @@ class OutstandingData {
   // and that would fit in a single packet of `max_size`. The eligible chunks
   // that didn't fit will be marked for (normal) retransmission and will not be
   // returned if this method is called again.
-  std::vector<std::pair<TSN, Data>> GetChunksToBeFastRetransmitted(
+  //
+  // The returned data is owned by this object, and is only valid until the
+  // next time a SACK is handled.
+  std::vector<std::pair<TSN, const Data*>> GetChunksToBeFastRetransmitted(
       size_t max_size);
 
   // Given `max_size` of space left in a packet, which chunks can be added to
-  // it?
-  std::vector<std::pair<TSN, Data>> GetChunksToBeRetransmitted(size_t max_size);
+  // it? The returned data has the same lifetime as above.
+  std::vector<std::pair<TSN, const Data*>> GetChunksToBeRetransmitted(
+      size_t max_size);
 
   size_t outstanding_bytes() const { return outstanding_bytes_; }
 
@@ -131,12 +136,19 @@ class OutstandingData {
   // be sent, and absl::nullopt if it shouldn't be sent.
   absl::optional<UnwrappedTSN> Insert(
       OutgoingMessageId message_id,
-      const Data& data,
+      Data data,
       webrtc::Timestamp time_sent,
       MaxRetransmits max_retransmissions = MaxRetransmits::NoLimit(),
       webrtc::Timestamp expires_at = webrtc::Timestamp::PlusInfinity(),
       LifecycleId lifecycle_id = LifecycleId::NotSet());
 
+  // Returns the data of the outstanding chunk `tsn`, which must have been added
+  // by `Insert` and not yet been cumulatively acked.
+  const Data& GetData(UnwrappedTSN tsn) const {
+    RTC_DCHECK_LT(GetIndex(tsn), outstanding_data_.size());
+    return outstanding_data_[GetIndex(tsn)].data();
+  }
+
   // Nacks all outstanding data.
   void NackAll();
 
@@ -312,9 +324,22 @@ class OutstandingData {
       bool is_in_fast_recovery,
       OutstandingData::AckInfo& ack_info);
 
-  // Process the acknowledgement of the chunk referenced by `iter` and updates
-  // state in `ack_info` and the object's state.
-  void AckChunk(AckInfo& ack_info, std::map<UnwrappedTSN, Item>::iterator iter);
+  // Returns the TSN of the item at `index` in `outstanding_data_`.
+  UnwrappedTSN GetTsn(size_t index) const {
+    return UnwrappedTSN::AddTo(last_cumulative_tsn_ack_,
+                               static_cast<int>(index) + 1);
+  }
+
+  // Returns the index of `tsn` in `outstanding_data_`, which is not
+  // necessarily less than its size.
+  size_t GetIndex(UnwrappedTSN tsn) const {
+    RTC_DCHECK(tsn > last_cumulative_tsn_ack_);
+    return static_cast<size_t>(*tsn - *last_cumulative_tsn_ack_ - 1);
+  }
+
+  // Process the acknowledgement of `item`, having `tsn`, and updates state in
+  // `ack_info` and the object's state.
+  void AckChunk(AckInfo& ack_info, UnwrappedTSN tsn, Item& item);
 
   // Helper method to process an incoming nack of an item and perform the
   // correct operations given the action indicated when nacking an item (e.g.
@@ -334,7 +359,7 @@ class OutstandingData {
   // that are still in the SendQueue and outstanding chunks.
   void AbandonAllFor(const OutstandingData::Item& item);
 
-  std::vector<std::pair<TSN, Data>> ExtractChunksThatCanFit(
+  std::vector<std::pair<TSN, const Data*>> ExtractChunksThatCanFit(
       std::set<UnwrappedTSN>& chunks,
       size_t max_size);
 
@@ -349,7 +374,10 @@ class OutstandingData {
   // Callback when to discard items from the send queue.
   std::function<bool(StreamID, OutgoingMessageId)> discard_from_send_queue_;
 
-  std::map<UnwrappedTSN, Item> outstanding_data_;
+  // The chunks that have been sent and not yet covered by the cumulative TSN
+  // ack. TSNs are assigned consecutively, so the item at index `i` has TSN
+  // `last_cumulative_tsn_ack_ + 1 + i`, see `GetTsn()`.
+  std::deque<Item> outstanding_data_;
   // The number of bytes that are in-flight (sent but not yet acked or nacked).
   size_t outstanding_bytes_ = 0;
   // The number of DATA chunks that are in-flight (sent but not yet acked or
@@ -398,11 +398,11 @@ void RetransmissionQueue::HandleT3RtxTimerExpiry() {
   RTC_DCHECK(IsConsistent());
 }
 
-std::vector<std::pair<TSN, Data>>
+std::vector<std::pair<TSN, const Data*>>
 RetransmissionQueue::GetChunksForFastRetransmit(size_t bytes_in_packet) {
   RTC_DCHECK(outstanding_data_.has_data_to_be_fast_retransmitted());
   RTC_DCHECK(IsDivisibleBy4(bytes_in_packet));
-  std::vector<std::pair<TSN, Data>> to_be_sent;
+  std::vector<std::pair<TSN, const Data*>> to_be_sent;
   size_t old_outstanding_bytes = outstanding_bytes();
 
   to_be_sent =
@@ -429,8 +429,8 @@ RetransmissionQueue::GetChunksForFastRetransmit(size_t bytes_in_packet) {
   }
 
   size_t bytes_retransmitted = absl::c_accumulate(
-      to_be_sent, 0, [&](size_t r, const std::pair<TSN, Data>& d) {
-        return r + GetSerializedChunkSize(d.second);
+      to_be_sent, 0, [&](size_t r, const std::pair<TSN, const Data*>& d) {
+        return r + GetSerializedChunkSize(*d.second);
       });
   ++rtx_packets_count_;
   rtx_bytes_count_ += bytes_retransmitted;
@@ -438,7 +438,7 @@ RetransmissionQueue::GetChunksForFastRetransmit(size_t bytes_in_packet) {
   RTC_DLOG(LS_VERBOSE) << log_prefix_ << "Fast-retransmitting TSN "
                        << StrJoin(to_be_sent, ",",
                                   [&](rtc::StringBuilder& sb,
-                                      const std::pair<TSN, Data>& c) {
+                                      const std::pair<TSN, const Data*>& c) {
                                     sb << *c.first;
                                   })
                        << " - " << bytes_retransmitted
@@ -449,13 +449,13 @@ RetransmissionQueue::GetChunksForFastRetransmit(size_t bytes_in_packet) {
   return to_be_sent;
 }
 
-std::vector<std::pair<TSN, Data>> RetransmissionQueue::GetChunksToSend(
+std::vector<std::pair<TSN, const Data*>> RetransmissionQueue::GetChunksToSend(
     Timestamp now,
     size_t bytes_remaining_in_packet) {
   // Chunks are always padded to even divisible by four.
   RTC_DCHECK(IsDivisibleBy4(bytes_remaining_in_packet));
 
-  std::vector<std::pair<TSN, Data>> to_be_sent;
+  std::vector<std::pair<TSN, const Data*>> to_be_sent;
   size_t old_outstanding_bytes = outstanding_bytes();
   size_t old_rwnd = rwnd_;
 
@@ -469,8 +469,8 @@ std::vector<std::pair<TSN, Data>> RetransmissionQueue::GetChunksToSend(
   to_be_sent = outstanding_data_.GetChunksToBeRetransmitted(max_bytes);
 
   size_t bytes_retransmitted = absl::c_accumulate(
-      to_be_sent, 0, [&](size_t r, const std::pair<TSN, Data>& d) {
-        return r + GetSerializedChunkSize(d.second);
+      to_be_sent, 0, [&](size_t r, const std::pair<TSN, const Data*>& d) {
+        return r + GetSerializedChunkSize(*d.second);
       });
   max_bytes -= bytes_retransmitted;
 
@@ -491,8 +491,9 @@ std::vector<std::pair<TSN, Data>> RetransmissionQueue::GetChunksToSend(
     max_bytes -= chunk_size;
     rwnd_ -= chunk_size;
 
+    RTC_DCHECK(!chunk_opt->lifecycle_id.IsSet() || chunk_opt->data.is_end);
     absl::optional<UnwrappedTSN> tsn = outstanding_data_.Insert(
-        chunk_opt->message_id, chunk_opt->data, now,
+        chunk_opt->message_id, std::move(chunk_opt->data), now,
         partial_reliability_ ? chunk_opt->max_retransmissions
                              : MaxRetransmits::NoLimit(),
         partial_reliability_ ? chunk_opt->expires_at
@@ -501,10 +502,11 @@ std::vector<std::pair<TSN, Data>> RetransmissionQueue::GetChunksToSend(
 
     if (tsn.has_value()) {
       if (chunk_opt->lifecycle_id.IsSet()) {
-        RTC_DCHECK(chunk_opt->data.is_end);
         callbacks_.OnLifecycleMessageFullySent(chunk_opt->lifecycle_id);
       }
-      to_be_sent.emplace_back(tsn->Wrap(), std::move(chunk_opt->data));
+      // The data is now kept by `outstanding_data_` for retransmission, and is
+      // serialized from there, instead of being copied.
+      to_be_sent.emplace_back(tsn->Wrap(), &outstanding_data_.GetData(*tsn));
     }
   }
 
@@ -519,14 +521,15 @@ std::vector<std::pair<TSN, Data>> RetransmissionQueue::GetChunksToSend(
     RTC_DLOG(LS_VERBOSE) << log_prefix_ << "Sending TSN "
                          << StrJoin(to_be_sent, ",",
                                     [&](rtc::StringBuilder& sb,
-                                        const std::pair<TSN, Data>& c) {
+                                        const std::pair<TSN, const Data*>& c) {
                                       sb << *c.first;
                                     })
                          << " - "
                          << absl::c_accumulate(
                                 to_be_sent, 0,
-                                [&](size_t r, const std::pair<TSN, Data>& d) {
-                                  return r + GetSerializedChunkSize(d.second);
+                                [&](size_t r,
+                                    const std::pair<TSN, const Data*>& d) {
+                                  return r + GetSerializedChunkSize(*d.second);
                                 })
                          << " bytes. outstanding_bytes=" << outstanding_bytes()
                          << " (" << old_outstanding_bytes << "), cwnd=" << cwnd_
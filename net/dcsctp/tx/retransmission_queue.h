@@ -81,15 +81,19 @@ class RetransmissionQueue {
   // Returns a list of chunks to "fast retransmit" that would fit in one SCTP
   // packet with `bytes_in_packet` bytes available. The current value
   // of `cwnd` is ignored.
-  std::vector<std::pair<TSN, Data>> GetChunksForFastRetransmit(
+  //
+  // The returned data is owned by the retransmission queue, to avoid copying it
+  // before it's serialized into a packet, and is only valid until the next
+  // time a SACK is handled.
+  std::vector<std::pair<TSN, const Data*>> GetChunksForFastRetransmit(
       size_t bytes_in_packet);
 
   // Returns a list of chunks to send that would fit in one SCTP packet with
   // `bytes_remaining_in_packet` bytes available. This may be further limited by
   // the congestion control windows. Note that `ShouldSendForwardTSN` must be
   // called prior to this method, to abandon expired chunks, as this method will
-  // not expire any chunks.
-  std::vector<std::pair<TSN, Data>> GetChunksToSend(
+  // not expire any chunks. The returned data has the same lifetime as above.
+  std::vector<std::pair<TSN, const Data*>> GetChunksToSend(
       webrtc::Timestamp now,
       size_t bytes_remaining_in_packet);
 
@@ -409,7 +409,7 @@ TEST_F(RetransmissionQueueTest, CanOnlyProduceTwoPacketsButWantsToSendThree) {
       })
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _), Pair(TSN(11), _)));
 
@@ -429,7 +429,7 @@ TEST_F(RetransmissionQueueTest, RetransmitsOnT3Expiry) {
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
   EXPECT_FALSE(queue.ShouldSendForwardTsn(now_));
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _)));
   EXPECT_THAT(queue.GetChunkStatesForTesting(),
@@ -449,7 +449,7 @@ TEST_F(RetransmissionQueueTest, RetransmitsOnT3Expiry) {
               ElementsAre(Pair(TSN(9), State::kAcked),  //
                           Pair(TSN(10), State::kToBeRetransmitted)));
 
-  std::vector<std::pair<TSN, Data>> chunks_to_rtx =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_rtx =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_rtx, ElementsAre(Pair(TSN(10), _)));
   EXPECT_THAT(queue.GetChunkStatesForTesting(),
@@ -469,7 +469,7 @@ TEST_F(RetransmissionQueueTest, LimitedRetransmissionOnlyWithRfc3758Support) {
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
   EXPECT_FALSE(queue.ShouldSendForwardTsn(now_));
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _)));
   EXPECT_THAT(queue.GetChunkStatesForTesting(),
@@ -498,7 +498,7 @@ TEST_F(RetransmissionQueueTest, LimitsRetransmissionsAsUdp) {
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
   EXPECT_FALSE(queue.ShouldSendForwardTsn(now_));
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _)));
   EXPECT_THAT(queue.GetChunkStatesForTesting(),
@@ -520,7 +520,7 @@ TEST_F(RetransmissionQueueTest, LimitsRetransmissionsAsUdp) {
               ElementsAre(Pair(TSN(9), State::kAcked),  //
                           Pair(TSN(10), State::kAbandoned)));
 
-  std::vector<std::pair<TSN, Data>> chunks_to_rtx =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_rtx =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_rtx, testing::IsEmpty());
   EXPECT_THAT(queue.GetChunkStatesForTesting(),
@@ -539,7 +539,7 @@ TEST_F(RetransmissionQueueTest, LimitsRetransmissionsToThreeSends) {
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
   EXPECT_FALSE(queue.ShouldSendForwardTsn(now_));
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _)));
   EXPECT_THAT(queue.GetChunkStatesForTesting(),
@@ -590,7 +590,7 @@ TEST_F(RetransmissionQueueTest, RetransmitsWhenSendBufferIsFullT3Expiry) {
       })
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1500);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _)));
   EXPECT_THAT(queue.GetChunkStatesForTesting(),
@@ -608,7 +608,7 @@ TEST_F(RetransmissionQueueTest, RetransmitsWhenSendBufferIsFullT3Expiry) {
   EXPECT_EQ(queue.outstanding_bytes(), 0u);
   EXPECT_EQ(queue.outstanding_items(), 0u);
 
-  std::vector<std::pair<TSN, Data>> chunks_to_rtx =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_rtx =
       queue.GetChunksToSend(now_, 1500);
   EXPECT_THAT(chunks_to_rtx, ElementsAre(Pair(TSN(10), _)));
   EXPECT_THAT(queue.GetChunkStatesForTesting(),
@@ -640,7 +640,7 @@ TEST_F(RetransmissionQueueTest, ProducesValidForwardTsn) {
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
   // Send and ack first chunk (TSN 10)
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _), Pair(TSN(11), _),
                                           Pair(TSN(12), _)));
@@ -696,7 +696,7 @@ TEST_F(RetransmissionQueueTest, ProducesValidForwardTsnWhenFullySent) {
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
   // Send and ack first chunk (TSN 10)
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _), Pair(TSN(11), _),
                                           Pair(TSN(12), _)));
@@ -765,7 +765,7 @@ TEST_F(RetransmissionQueueTest, ProducesValidIForwardTsn) {
       })
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _), Pair(TSN(11), _),
                                           Pair(TSN(12), _), Pair(TSN(13), _)));
@@ -860,7 +860,7 @@ TEST_F(RetransmissionQueueTest, MeasureRTT) {
       })
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _)));
 
@@ -1012,7 +1012,7 @@ TEST_F(RetransmissionQueueTest, StaysWithinAvailableSize) {
                                      gen_.Ordered(payload, "BE"));
       });
 
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1188 - 12);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _), Pair(TSN(11), _)));
 }
@@ -1039,7 +1039,7 @@ TEST_F(RetransmissionQueueTest, AccountsNackedAbandonedChunksAsNotOutstanding) {
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
   // Send and ack first chunk (TSN 10)
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _), Pair(TSN(11), _),
                                           Pair(TSN(12), _)));
@@ -1100,7 +1100,7 @@ TEST_F(RetransmissionQueueTest, ExpireFromSendQueueWhenPartiallySent) {
       })
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 24);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _)));
 
@@ -1190,7 +1190,7 @@ TEST_F(RetransmissionQueueTest, LimitsRetransmissionsOnlyWhenNackedThreeTimes) {
 
   EXPECT_FALSE(queue.ShouldSendForwardTsn(now_));
 
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _), Pair(TSN(11), _),
                                           Pair(TSN(12), _), Pair(TSN(13), _)));
@@ -1266,7 +1266,7 @@ TEST_F(RetransmissionQueueTest, AbandonsRtxLimit2WhenNackedNineTimes) {
 
   EXPECT_FALSE(queue.ShouldSendForwardTsn(now_));
 
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1000);
   EXPECT_THAT(chunks_to_send,
               ElementsAre(Pair(TSN(10), _), Pair(TSN(11), _), Pair(TSN(12), _),
@@ -1394,7 +1394,7 @@ TEST_F(RetransmissionQueueTest, CwndRecoversWhenAcking) {
       })
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 1500);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _)));
   size_t serialized_size = payload.size() + DataChunk::kHeaderSize;
@@ -1424,7 +1424,7 @@ TEST_F(RetransmissionQueueTest, OnlySendsLargePacketsOnLargeCongestionWindow) {
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
   EXPECT_TRUE(queue.can_send_data());
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 10000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _)));
 
@@ -1457,7 +1457,7 @@ TEST_F(RetransmissionQueueTest, AllowsSmallFragmentsOnSmallCongestionWindow) {
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
   EXPECT_TRUE(queue.can_send_data());
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 10000);
   EXPECT_THAT(chunks_to_send, ElementsAre(Pair(TSN(10), _)));
 
@@ -1617,7 +1617,7 @@ TEST_F(RetransmissionQueueTest, CanAlwaysSendOnePacket) {
       .WillRepeatedly([](Timestamp, size_t) { return absl::nullopt; });
 
   // Produce all chunks and put them in the retransmission queue.
-  std::vector<std::pair<TSN, Data>> chunks_to_send =
+  std::vector<std::pair<TSN, const Data*>> chunks_to_send =
       queue.GetChunksToSend(now_, 5 * mtu);
   EXPECT_THAT(chunks_to_send,
               ElementsAre(Pair(TSN(10), _), Pair(TSN(11), _), Pair(TSN(12), _),
@@ -11,7 +11,6 @@
 
 #include <algorithm>
 
-#include "absl/algorithm/container.h"
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "net/dcsctp/packet/data.h"
@@ -42,11 +41,12 @@ absl::optional<SendQueue::DataToSend> StreamScheduler::Produce(
   RTC_DLOG(LS_VERBOSE) << log_prefix_
                        << "Producing data, rescheduling=" << rescheduling
                        << ", active="
-                       << StrJoin(active_streams_, ", ",
-                                  [&](rtc::StringBuilder& sb, const auto& p) {
-                                    sb << *p->stream_id() << "@"
-                                       << *p->next_finish_time();
-                                  });
+                       << webrtc::StrJoin(
+                              active_streams_, ", ",
+                              [&](rtc::StringBuilder& sb, const auto& p) {
+                                sb << *p->stream_id() << "@"
+                                   << *p->next_finish_time();
+                              });
 
   RTC_DCHECK(rescheduling || current_stream_ != nullptr);
 
@@ -63,9 +63,7 @@ absl::optional<SendQueue::DataToSend> StreamScheduler::Produce(
     } else {
       RTC_DLOG(LS_VERBOSE) << log_prefix_ << "Producing from previous stream: "
                            << *current_stream_->stream_id();
-      RTC_DCHECK(absl::c_any_of(active_streams_, [this](const auto* p) {
-        return p == current_stream_;
-      }));
+      RTC_DCHECK(active_streams_.count(current_stream_) > 0);
     }
 
     data = current_stream_->Produce(now, max_size);
@@ -176,9 +174,8 @@ void StreamScheduler::Stream::MakeActive(size_t bytes_to_send_next) {
                        << *next_finish_time;
   RTC_DCHECK(next_finish_time_ == VirtualTime::Zero());
   next_finish_time_ = next_finish_time;
-  RTC_DCHECK(!absl::c_any_of(parent_.active_streams_,
-                             [this](const auto* p) { return p == this; }));
-  parent_.active_streams_.emplace(this);
+  bool inserted = parent_.active_streams_.emplace(this).second;
+  RTC_DCHECK(inserted);
 }
 
 void StreamScheduler::Stream::ForceMarkInactive() {
@@ -189,9 +186,10 @@ void StreamScheduler::Stream::ForceMarkInactive() {
 }
 
 void StreamScheduler::Stream::MakeInactive() {
+  // Must be erased before its virtual finish time, which orders the active
+  // streams, is cleared.
+  parent_.active_streams_.erase(this);
   ForceMarkInactive();
-  webrtc::EraseIf(parent_.active_streams_,
-                  [&](const auto* s) { return s == this; });
 }
 
 std::set<StreamID> StreamScheduler::ActiveStreamsForTesting() const {
@@ -31,7 +31,6 @@
 #include "net/dcsctp/public/dcsctp_socket.h"
 #include "net/dcsctp/public/types.h"
 #include "net/dcsctp/tx/send_queue.h"
-#include "rtc_base/containers/flat_set.h"
 #include "rtc_base/strong_alias.h"
 
 namespace dcsctp {
@@ -217,8 +216,10 @@ class StreamScheduler {
   // stream until that message has been sent in full.
   bool currently_sending_a_message_ = false;
 
-  // The currently active streams, ordered by virtual finish time.
-  webrtc::flat_set<Stream*, ActiveStreamComparator> active_streams_;
+  // The currently active streams, ordered by virtual finish time. A node based
+  // set is used, so that streams can be activated, deactivated and scheduled
+  // in logarithmic time, even when there are many active streams.
+  std::set<Stream*, ActiveStreamComparator> active_streams_;
 };
 
 }  // namespace dcsctp
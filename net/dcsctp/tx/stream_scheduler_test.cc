@@ -9,6 +9,8 @@
  */
 #include "net/dcsctp/tx/stream_scheduler.h"
 
+#include <map>
+#include <memory>
 #include <vector>
 
 #include "net/dcsctp/packet/sctp_packet.h"
@@ -691,6 +693,36 @@ TEST(StreamSchedulerTest, WillDistributeFromFourStreamsFairly) {
   EXPECT_EQ(packet_counts[StreamID(4)], 20U);
 }
 
+TEST(StreamSchedulerTest, WillDistributeFromManyStreamsFairly) {
+  StreamScheduler scheduler("", kMtu);
+  // Enable WFQ scheduler.
+  scheduler.EnableMessageInterleaving(true);
+
+  constexpr int kNumStreams = 1000;
+  std::vector<std::unique_ptr<TestStream>> streams;
+  for (int i = 0; i < kNumStreams; ++i) {
+    // Every other stream has twice the priority.
+    streams.push_back(std::make_unique<TestStream>(
+        scheduler, StreamID(i), StreamPriority(i % 2 == 0 ? 100 : 200)));
+  }
+  // Deactivating a stream in the middle of the set must not affect the others.
+  streams[kNumStreams / 2]->stream().MakeInactive();
+
+  // 499 active streams at priority 100 get 10 packets, and 500 streams at
+  // priority 200 get 20 packets each.
+  std::map<StreamID, size_t> packet_counts =
+      GetPacketCounts(scheduler, 499 * 10 + 500 * 20);
+  for (int i = 0; i < kNumStreams; ++i) {
+    if (i == kNumStreams / 2) {
+      EXPECT_EQ(packet_counts[StreamID(i)], 0U);
+    } else if (i % 2 == 0) {
+      EXPECT_EQ(packet_counts[StreamID(i)], 10U) << "stream " << i;
+    } else {
+      EXPECT_EQ(packet_counts[StreamID(i)], 20U) << "stream " << i;
+    }
+  }
+}
+
 // Sending large messages with small MTU will fragment the messages and produce
 // a first fragment not larger than the MTU, and will then not first send from
 // the stream with the smallest message, as their first fragment will be equally
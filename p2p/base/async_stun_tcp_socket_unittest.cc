@@ -18,6 +18,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "api/array_view.h"
@@ -294,6 +295,56 @@ TEST_F(AsyncStunTCPSocketTest, TestWithSmallSendBuffer) {
                         sizeof(kTurnChannelDataMessageWithOddLength)));
 }
 
+// Test that packets split across reads are reassembled, when many packets
+// arrive at once.
+TEST_F(AsyncStunTCPSocketTest, TestManyPacketsInOneRead) {
+  constexpr int kNumPackets = 100;
+  rtc::PacketOptions options;
+  for (int i = 0; i < kNumPackets; ++i) {
+    ASSERT_EQ(send_socket_->Send(kTurnChannelDataMessageWithOddLength,
+                                 sizeof(kTurnChannelDataMessageWithOddLength),
+                                 options),
+              static_cast<int>(sizeof(kTurnChannelDataMessageWithOddLength)));
+  }
+  vss_->ProcessMessagesUntilIdle();
+  ASSERT_EQ(recv_packets_.size(), static_cast<size_t>(kNumPackets));
+  for (int i = 0; i < kNumPackets; ++i) {
+    EXPECT_TRUE(CheckData(kTurnChannelDataMessageWithOddLength,
+                          sizeof(kTurnChannelDataMessageWithOddLength)));
+  }
+}
+
+// Test that packets are reassembled when every read returns only a few bytes.
+// Reads end in the middle of packet headers, packets are larger than the
+// initial input buffer, and incomplete packets have to be moved to the front
+// of the buffer to make room.
+TEST_F(AsyncStunTCPSocketTest, TestShortReads) {
+  vss_->set_recv_buffer_capacity(5);
+  std::vector<uint8_t> large_packet(4 + 200, 'x');
+  large_packet[0] = 0x40;
+  large_packet[1] = 0x00;
+  large_packet[2] = 0x00;
+  large_packet[3] = 200;
+  constexpr int kNumPackets = 10;
+  rtc::PacketOptions options;
+  for (int i = 0; i < kNumPackets; ++i) {
+    ASSERT_EQ(send_socket_->Send(kTurnChannelDataMessageWithOddLength,
+                                 sizeof(kTurnChannelDataMessageWithOddLength),
+                                 options),
+              static_cast<int>(sizeof(kTurnChannelDataMessageWithOddLength)));
+    ASSERT_EQ(send_socket_->Send(large_packet.data(), large_packet.size(),
+                                 options),
+              static_cast<int>(large_packet.size()));
+  }
+  vss_->ProcessMessagesUntilIdle();
+  ASSERT_EQ(recv_packets_.size(), 2u * kNumPackets);
+  for (int i = 0; i < kNumPackets; ++i) {
+    EXPECT_TRUE(CheckData(kTurnChannelDataMessageWithOddLength,
+                          sizeof(kTurnChannelDataMessageWithOddLength)));
+    EXPECT_TRUE(CheckData(large_packet.data(), large_packet.size()));
+  }
+}
+
 // Test that SignalSentPacket is fired when a packet is sent.
 TEST_F(AsyncStunTCPSocketTest, SignalSentPacketFiredWhenPacketSent) {
   ASSERT_TRUE(
@@ -528,16 +528,26 @@ BasicIceController::SortAndSwitchConnection(IceSwitchReason reason) {
   // that amongst equal preference, writable connections, this will choose the
   // one whose estimated latency is lowest.  So it is the only one that we
   // need to consider switching to.
-  // TODO(honghaiz): Don't sort;  Just use std::max_element in the right places.
-  absl::c_stable_sort(
-      connections_, [this](const Connection* a, const Connection* b) {
-        int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
-        if (cmp != 0) {
-          return cmp > 0;
-        }
-        // Otherwise, sort based on latency estimate.
-        return a->rtt() < b->rtt();
-      });
+  auto better = [this](const Connection* a, const Connection* b) {
+    int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
+    if (cmp != 0) {
+      return cmp > 0;
+    }
+    // Otherwise, sort based on latency estimate.
+    return a->rtt() < b->rtt();
+  };
+  // `connections_` was sorted by the previous call, and a state change
+  // typically moves only a few connections. Sort incrementally by insertion,
+  // which costs one comparison per connection that is still in order, and
+  // moves the others to their upper bound among the already sorted ones. This
+  // gives the same order as a stable sort.
+  for (auto it = connections_.begin(); it != connections_.end(); ++it) {
+    if (it == connections_.begin() || !better(*it, *(it - 1))) {
+      continue;
+    }
+    auto pos = std::upper_bound(connections_.begin(), it, *it, better);
+    std::rotate(pos, it, it + 1);
+  }
 
   RTC_LOG(LS_VERBOSE) << "Sorting " << connections_.size()
                       << " available connections due to: "
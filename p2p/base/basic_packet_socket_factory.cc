@@ -43,12 +43,33 @@ AsyncPacketSocket* BasicPacketSocketFactory::CreateUdpSocket(
   if (!socket) {
     return NULL;
   }
+  if (udp_reuse_port_ && socket->SetOption(Socket::OPT_REUSEPORT, 1) != 0) {
+    RTC_LOG(LS_WARNING) << "Failed to set SO_REUSEPORT on UDP socket.";
+  }
   if (BindSocket(socket, address, min_port, max_port) < 0) {
     RTC_LOG(LS_ERROR) << "UDP bind failed with error " << socket->GetError();
     delete socket;
     return NULL;
   }
-  return new AsyncUDPSocket(socket);
+  AsyncUDPSocket* udp_socket = new AsyncUDPSocket(socket);
+  if (udp_receive_ecn_ &&
+      udp_socket->SetOption(Socket::OPT_RECV_ECN, 1) != 0) {
+    RTC_LOG(LS_WARNING) << "Failed to enable ECN reception on UDP socket.";
+  }
+  if (udp_send_ecn_ != EcnMarking::kNotEct &&
+      udp_socket->SetOption(Socket::OPT_SEND_ECN,
+                            static_cast<int>(udp_send_ecn_)) != 0) {
+    RTC_LOG(LS_WARNING) << "Failed to set ECN marking on UDP socket.";
+  }
+  if (udp_gro_enabled_ &&
+      udp_socket->EnableGroReceive(udp_receive_batch_packets_)) {
+    return udp_socket;
+  }
+  if (udp_receive_batch_packets_ > 1) {
+    udp_socket->EnableBatchedReceive(udp_receive_batch_packets_,
+                                     udp_receive_batch_packet_size_);
+  }
+  return udp_socket;
 }
 
 AsyncListenSocket* BasicPacketSocketFactory::CreateServerTcpSocket(
@@ -185,6 +206,12 @@ BasicPacketSocketFactory::CreateAsyncDnsResolver() {
   return std::make_unique<webrtc::AsyncDnsResolver>();
 }
 
+void BasicPacketSocketFactory::SetUdpReceiveBatchSize(size_t max_packets,
+                                                      size_t max_packet_size) {
+  udp_receive_batch_packets_ = max_packets;
+  udp_receive_batch_packet_size_ = max_packet_size;
+}
+
 int BasicPacketSocketFactory::BindSocket(Socket* socket,
                                          const SocketAddress& local_address,
                                          uint16_t min_port,
@@ -19,6 +19,7 @@
 #include "api/async_dns_resolver.h"
 #include "api/packet_socket_factory.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/proxy_info.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
@@ -51,6 +52,25 @@ class RTC_EXPORT BasicPacketSocketFactory : public PacketSocketFactory {
   std::unique_ptr<webrtc::AsyncDnsResolverInterface> CreateAsyncDnsResolver()
       override;
 
+  // Makes UDP sockets created from now on read up to `max_packets` datagrams
+  // per read event. See AsyncUDPSocket::EnableBatchedReceive().
+  void SetUdpReceiveBatchSize(size_t max_packets, size_t max_packet_size);
+  // Makes UDP sockets created from now on request UDP GRO, falling back to
+  // the receive batch size above where GRO is unavailable. See
+  // AsyncUDPSocket::EnableGroReceive().
+  void SetUdpGroEnabled(bool enabled) { udp_gro_enabled_ = enabled; }
+  // Makes UDP sockets created from now on set Socket::OPT_REUSEPORT before
+  // binding, so that factories on several network threads can each bind a
+  // socket to the same address and share its load.
+  void SetUdpReusePort(bool enabled) { udp_reuse_port_ = enabled; }
+  // Makes UDP sockets created from now on read the ECN codepoint of received
+  // datagrams, so that it shows up as ReceivedPacket::ecn().
+  void SetUdpReceiveEcn(bool enabled) { udp_receive_ecn_ = enabled; }
+  // Makes UDP sockets created from now on mark the datagrams they send with
+  // `marking`. Only mark packets as ECN capable when the congestion
+  // controller of the sender responds to CE marks.
+  void SetUdpSendEcn(EcnMarking marking) { udp_send_ecn_ = marking; }
+
  private:
   int BindSocket(Socket* socket,
                  const SocketAddress& local_address,
@@ -58,6 +78,12 @@ class RTC_EXPORT BasicPacketSocketFactory : public PacketSocketFactory {
                  uint16_t max_port);
 
   SocketFactory* socket_factory_;
+  size_t udp_receive_batch_packets_ = 0;
+  size_t udp_receive_batch_packet_size_ = 0;
+  bool udp_gro_enabled_ = false;
+  bool udp_reuse_port_ = false;
+  bool udp_receive_ecn_ = false;
+  EcnMarking udp_send_ecn_ = EcnMarking::kNotEct;
 };
 
 }  // namespace rtc
@@ -19,6 +19,7 @@
 #include "api/array_view.h"
 #include "api/dtls_transport_interface.h"
 #include "api/rtc_event_log/rtc_event_log.h"
+#include "api/units/timestamp.h"
 #include "logging/rtc_event_log/events/rtc_event_dtls_transport_state.h"
 #include "logging/rtc_event_log/events/rtc_event_dtls_writable_state.h"
 #include "p2p/base/packet_transport_internal.h"
@@ -26,7 +27,9 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/dscp.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/rtc_certificate.h"
+#include "rtc_base/socket_address.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/stream.h"
 #include "rtc_base/thread.h"
@@ -97,13 +100,18 @@ rtc::StreamResult StreamInterfaceChannel::Write(
   // Always succeeds, since this is an unreliable transport anyway.
   // TODO(zhihuang): Should this block if ice_transport_'s temporarily
   // unwritable?
-  rtc::PacketOptions packet_options;
   ice_transport_->SendPacket(reinterpret_cast<const char*>(data.data()),
-                             data.size(), packet_options);
+                             data.size(), packet_options_);
   written = data.size();
   return rtc::SR_SUCCESS;
 }
 
+void StreamInterfaceChannel::SetPacketOptions(
+    const rtc::PacketOptions& options) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  packet_options_ = options;
+}
+
 bool StreamInterfaceChannel::OnPacketReceived(const char* data, size_t size) {
   RTC_DCHECK_RUN_ON(&sequence_checker_);
   if (packets_.size() > 0) {
@@ -146,7 +154,9 @@ DtlsTransport::DtlsTransport(IceTransportInternal* ice_transport,
   ConnectToIceTransport();
 }
 
-DtlsTransport::~DtlsTransport() = default;
+DtlsTransport::~DtlsTransport() {
+  ice_transport_->DeregisterReceivedPacketCallback(this);
+}
 
 webrtc::DtlsTransportState DtlsTransport::dtls_state() const {
   return dtls_state_;
@@ -450,14 +460,20 @@ int DtlsTransport::SendPacket(const char* data,
 
         return ice_transport_->SendPacket(data, size, options);
       } else {
+        // The DTLS record is written synchronously, so let it be batched the
+        // same way as the packet it encrypts, e.g. for a burst of SCTP
+        // packets.
+        rtc::PacketOptions record_options;
+        record_options.batchable = options.batchable;
+        record_options.last_packet_in_batch = options.last_packet_in_batch;
+        downward_->SetPacketOptions(record_options);
         size_t written;
         int error;
-        return (dtls_->WriteAll(
-                    rtc::MakeArrayView(reinterpret_cast<const uint8_t*>(data),
-                                       size),
-                    written, error) == rtc::SR_SUCCESS)
-                   ? static_cast<int>(size)
-                   : -1;
+        rtc::StreamResult result = dtls_->WriteAll(
+            rtc::MakeArrayView(reinterpret_cast<const uint8_t*>(data), size),
+            written, error);
+        downward_->SetPacketOptions(rtc::PacketOptions());
+        return result == rtc::SR_SUCCESS ? static_cast<int>(size) : -1;
       }
     case webrtc::DtlsTransportState::kFailed:
       // Can't send anything when we're failed.
@@ -513,7 +529,11 @@ void DtlsTransport::ConnectToIceTransport() {
   RTC_DCHECK(ice_transport_);
   ice_transport_->SignalWritableState.connect(this,
                                               &DtlsTransport::OnWritableState);
-  ice_transport_->SignalReadPacket.connect(this, &DtlsTransport::OnReadPacket);
+  ice_transport_->RegisterReceivedPacketCallback(
+      this, [&](rtc::PacketTransportInternal* transport,
+                const rtc::ReceivedPacket& packet, int flags) {
+        OnReadPacket(transport, packet, flags);
+      });
   ice_transport_->SignalSentPacket.connect(this, &DtlsTransport::OnSentPacket);
   ice_transport_->SignalReadyToSend.connect(this,
                                             &DtlsTransport::OnReadyToSend);
@@ -590,9 +610,7 @@ void DtlsTransport::OnReceivingState(rtc::PacketTransportInternal* transport) {
 }
 
 void DtlsTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
-                                 const char* data,
-                                 size_t size,
-                                 const int64_t& packet_time_us,
+                                 const rtc::ReceivedPacket& packet,
                                  int flags) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   RTC_DCHECK(transport == ice_transport_);
@@ -600,10 +618,13 @@ void DtlsTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
 
   if (!dtls_active_) {
     // Not doing DTLS.
-    SignalReadPacket(this, data, size, packet_time_us, 0);
+    NotifyPacketReceived(packet, /*flags=*/0);
     return;
   }
 
+  const char* data = reinterpret_cast<const char*>(packet.payload().data());
+  size_t size = packet.payload().size();
+
   switch (dtls_state()) {
     case webrtc::DtlsTransportState::kNew:
       if (dtls_) {
@@ -663,7 +684,7 @@ void DtlsTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
         RTC_DCHECK(!srtp_ciphers_.empty());
 
         // Signal this upwards as a bypass packet.
-        SignalReadPacket(this, data, size, packet_time_us, PF_SRTP_BYPASS);
+        NotifyPacketReceived(packet, PF_SRTP_BYPASS);
       }
       break;
     case webrtc::DtlsTransportState::kFailed:
@@ -710,8 +731,11 @@ void DtlsTransport::OnDtlsEvent(rtc::StreamInterface* dtls, int sig, int err) {
     do {
       ret = dtls_->Read(buf, read, read_error);
       if (ret == rtc::SR_SUCCESS) {
-        SignalReadPacket(this, reinterpret_cast<const char*>(buf), read,
-                         rtc::TimeMicros(), 0);
+        NotifyPacketReceived(
+            rtc::ReceivedPacket(rtc::MakeArrayView(buf, read),
+                                rtc::SocketAddress(),
+                                webrtc::Timestamp::Micros(rtc::TimeMicros())),
+            /*flags=*/0);
       } else if (ret == rtc::SR_EOS) {
         // Remote peer shut down the association with no error.
         RTC_LOG(LS_INFO) << ToString() << ": DTLS transport closed by remote";
@@ -21,8 +21,10 @@
 #include "api/sequence_checker.h"
 #include "p2p/base/dtls_transport_internal.h"
 #include "p2p/base/ice_transport_internal.h"
+#include "rtc_base/async_packet_socket.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/buffer_queue.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/stream.h"
 #include "rtc_base/strings/string_builder.h"
@@ -46,6 +48,9 @@ class StreamInterfaceChannel : public rtc::StreamInterface {
   // Push in a packet; this gets pulled out from Read().
   bool OnPacketReceived(const char* data, size_t size);
 
+  // Sets the options that written packets are sent with.
+  void SetPacketOptions(const rtc::PacketOptions& options);
+
   // Implementations of StreamInterface
   rtc::StreamState GetState() const override;
   void Close() override;
@@ -61,6 +66,7 @@ class StreamInterfaceChannel : public rtc::StreamInterface {
   IceTransportInternal* const ice_transport_;  // owned by DtlsTransport
   rtc::StreamState state_ RTC_GUARDED_BY(sequence_checker_);
   rtc::BufferQueue packets_ RTC_GUARDED_BY(sequence_checker_);
+  rtc::PacketOptions packet_options_ RTC_GUARDED_BY(sequence_checker_);
 };
 
 // This class provides a DTLS SSLStreamAdapter inside a TransportChannel-style
@@ -216,9 +222,7 @@ class DtlsTransport : public DtlsTransportInternal {
 
   void OnWritableState(rtc::PacketTransportInternal* transport);
   void OnReadPacket(rtc::PacketTransportInternal* transport,
-                    const char* data,
-                    size_t size,
-                    const int64_t& packet_time_us,
+                    const rtc::ReceivedPacket& packet,
                     int flags);
   void OnSentPacket(rtc::PacketTransportInternal* transport,
                     const rtc::SentPacket& sent_packet);
@@ -22,6 +22,7 @@
 #include "p2p/base/dtls_transport_internal.h"
 #include "p2p/base/fake_ice_transport.h"
 #include "rtc_base/fake_ssl_identity.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/rtc_certificate.h"
 
 namespace cricket {
@@ -268,7 +269,9 @@ class FakeDtlsTransport : public DtlsTransportInternal {
                                 size_t len,
                                 const int64_t& packet_time_us,
                                 int flags) {
-    SignalReadPacket(this, data, len, packet_time_us, flags);
+    NotifyPacketReceived(
+        rtc::ReceivedPacket::CreateFromLegacy(data, len, packet_time_us),
+        flags);
   }
 
   void set_receiving(bool receiving) {
@@ -24,6 +24,7 @@
 #include "api/units/time_delta.h"
 #include "p2p/base/ice_transport_internal.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/task_queue_for_test.h"
 
 namespace cricket {
@@ -391,8 +392,10 @@ class FakeIceTransport : public IceTransportInternal {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(network_thread_) {
     if (dest_) {
       last_sent_packet_ = packet;
-      dest_->SignalReadPacket(dest_, packet.data<char>(), packet.size(),
-                              rtc::TimeMicros(), 0);
+      dest_->NotifyPacketReceived(
+          rtc::ReceivedPacket::CreateFromLegacy(
+              packet.data<char>(), packet.size(), rtc::TimeMicros()),
+          /*flags=*/0);
     }
   }
 
@@ -16,6 +16,7 @@
 
 #include "p2p/base/packet_transport_internal.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/network/received_packet.h"
 
 namespace rtc {
 
@@ -121,8 +122,10 @@ class FakePacketTransport : public PacketTransportInternal {
   void SendPacketInternal(const CopyOnWriteBuffer& packet) {
     last_sent_packet_ = packet;
     if (dest_) {
-      dest_->SignalReadPacket(dest_, packet.data<char>(), packet.size(),
-                              TimeMicros(), 0);
+      dest_->NotifyPacketReceived(
+          ReceivedPacket::CreateFromLegacy(packet.data<char>(), packet.size(),
+                                           TimeMicros()),
+          /*flags=*/0);
     }
   }
 
@@ -195,6 +195,20 @@ struct RTC_EXPORT IceConfig {
 
   webrtc::VpnPreference vpn_preference = webrtc::VpnPreference::kDefault;
 
+  // If true, every packet is also sent over the writable connection with the
+  // lowest RTT on a network other than that of the selected connection, for
+  // instance over cellular when the selected connection uses Wi-Fi. This
+  // trades bandwidth for resilience against losing a network. The copies are
+  // not reported to the congestion controller. The receiver drops whichever
+  // copy arrives second as an SRTP replay, which isn't counted as an error.
+  // Since the copy is sent after SRTP protection it carries the same
+  // transport-wide sequence number as the original. The remote transport
+  // feedback (transport-cc or RFC 8888) therefore reports the arrival time of
+  // whichever copy came first and doesn't report a loss on the selected path
+  // if the copy made it, which skews the delay and loss based estimates of
+  // the sender.
+  bool send_redundantly_over_backup_network = false;
+
   IceConfig();
   IceConfig(int receiving_timeout_ms,
             int backup_connection_ping_interval,
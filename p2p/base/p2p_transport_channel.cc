@@ -679,6 +679,14 @@ void P2PTransportChannel::SetIceConfig(const IceConfig& config) {
   config_.vpn_preference = config.vpn_preference;
   allocator_->SetVpnPreference(config_.vpn_preference);
 
+  if (config_.send_redundantly_over_backup_network !=
+      config.send_redundantly_over_backup_network) {
+    config_.send_redundantly_over_backup_network =
+        config.send_redundantly_over_backup_network;
+    RTC_LOG(LS_INFO) << "Set send redundantly over backup network to "
+                     << config_.send_redundantly_over_backup_network;
+  }
+
   ice_controller_->SetIceConfig(config_);
 
   RTC_DCHECK(ValidateIceConfig(config_).ok());
@@ -1615,9 +1623,40 @@ int P2PTransportChannel::SendPacket(const char* data,
   }
 
   bytes_sent_ += sent;
+  if (config_.send_redundantly_over_backup_network) {
+    SendOverBackupNetwork(data, len, modified_options);
+  }
   return sent;
 }
 
+void P2PTransportChannel::SendOverBackupNetwork(
+    const char* data,
+    size_t len,
+    const rtc::PacketOptions& options) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  const rtc::Network* selected_network = selected_connection_->network();
+  Connection* backup_connection = nullptr;
+  for (Connection* connection : connections_) {
+    if (connection->writable() && connection->network() != selected_network &&
+        (!backup_connection || connection->rtt() < backup_connection->rtt())) {
+      backup_connection = connection;
+    }
+  }
+  if (!backup_connection) {
+    return;
+  }
+  // The copy must not be mistaken for the original by the congestion
+  // controller, which only knows about the path of the selected connection.
+  // Its transport-wide sequence number can't be rewritten here since the
+  // packet is already SRTP protected, see
+  // IceConfig::send_redundantly_over_backup_network.
+  rtc::PacketOptions copy_options(options);
+  copy_options.packet_id = -1;
+  copy_options.info_signaled_after_sent.included_in_feedback = false;
+  copy_options.info_signaled_after_sent.included_in_allocation = false;
+  backup_connection->Send(data, len, copy_options);
+}
+
 bool P2PTransportChannel::GetStats(IceTransportStats* ice_transport_stats) {
   RTC_DCHECK_RUN_ON(network_thread_);
   // Gather candidate and candidate pair stats.
@@ -2230,10 +2269,7 @@ void P2PTransportChannel::OnReadPacket(Connection* connection,
     last_data_received_ms_ =
         std::max(last_data_received_ms_, connection->last_data_received());
 
-    SignalReadPacket(
-        this, reinterpret_cast<const char*>(packet.payload().data()),
-        packet.payload().size(),
-        packet.arrival_time() ? packet.arrival_time()->us() : -1, 0);
+    NotifyPacketReceived(packet, /*flags=*/0);
 
   // May need to switch the sending connection based on the receiving media
   // path if this is the controlled side.
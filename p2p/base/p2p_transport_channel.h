@@ -280,6 +280,11 @@ class RTC_EXPORT P2PTransportChannel : public IceTransportInternal,
 
   // Returns true if it's possible to send packets on `connection`.
   bool ReadyToSend(const Connection* connection) const;
+  // Sends a copy of a packet already sent over `selected_connection_` over
+  // the best writable connection on another network, if there is one.
+  void SendOverBackupNetwork(const char* data,
+                             size_t len,
+                             const rtc::PacketOptions& options);
   bool PresumedWritable(const Connection* conn) const;
   void SendPingRequestInternal(Connection* connection);
 
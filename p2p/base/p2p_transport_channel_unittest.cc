@@ -3035,6 +3035,47 @@ TEST_F(P2PTransportChannelMultihomedTest, TestPreferWifiOverCellularNetwork) {
   DestroyChannels();
 }
 
+// Test that packets are also sent over a connection on another network when
+// sending redundantly over a backup network.
+TEST_F(P2PTransportChannelMultihomedTest,
+       TestSendRedundantlyOverBackupNetwork) {
+  auto& wifi = kPublicAddrs;
+  auto& cellular = kAlternateAddrs;
+  AddAddress(0, wifi[0], "test0", rtc::ADAPTER_TYPE_WIFI);
+  AddAddress(0, cellular[0], "test1", rtc::ADAPTER_TYPE_CELLULAR);
+  AddAddress(1, wifi[1], "test0", rtc::ADAPTER_TYPE_WIFI);
+
+  // Use only local ports for simplicity.
+  SetAllocatorFlags(0, kOnlyLocalPorts);
+  SetAllocatorFlags(1, kOnlyLocalPorts);
+
+  // Create channels and let them go writable, as usual.
+  CreateChannels();
+  EXPECT_TRUE_WAIT_MARGIN(CheckCandidatePairAndConnected(ep1_ch1(), ep2_ch1(),
+                                                         wifi[0], wifi[1]),
+                          1000, 1000);
+  ASSERT_TRUE_WAIT(GetConnection(ep1_ch1(), cellular[0], wifi[1]) != nullptr,
+                   kMediumTimeout);
+  Connection* backup_conn = GetConnection(ep1_ch1(), cellular[0], wifi[1]);
+  EXPECT_TRUE_WAIT(backup_conn->writable(), kMediumTimeout);
+
+  const char kData[] = "ABCDEFGH";
+  const int kDataSize = static_cast<int>(sizeof(kData));
+  EXPECT_EQ(kDataSize, SendData(ep1_ch1(), kData, kDataSize));
+  EXPECT_TRUE_WAIT(GetPacketList(ep2_ch1()).size() == 1u, kDefaultTimeout);
+
+  IceConfig config = ep1_ch1()->config();
+  config.send_redundantly_over_backup_network = true;
+  ep1_ch1()->SetIceConfig(config);
+  EXPECT_EQ(kDataSize, SendData(ep1_ch1(), kData, kDataSize));
+  EXPECT_TRUE_WAIT(GetPacketList(ep2_ch1()).size() == 3u, kDefaultTimeout);
+  // The copy was sent while the selected connection stayed in use.
+  EXPECT_TRUE(
+      CheckCandidatePairAndConnected(ep1_ch1(), ep2_ch1(), wifi[0], wifi[1]));
+
+  DestroyChannels();
+}
+
 // Test that the backup connection is pinged at a rate no faster than
 // what was configured.
 TEST_F(P2PTransportChannelMultihomedTest, TestPingBackupConnectionRate) {
@@ -10,11 +10,15 @@
 
 #include "p2p/base/packet_transport_internal.h"
 
+#include <utility>
+
 namespace rtc {
 
 PacketTransportInternal::PacketTransportInternal() = default;
 
-PacketTransportInternal::~PacketTransportInternal() = default;
+PacketTransportInternal::~PacketTransportInternal() {
+  destroyed_callbacks_.Send();
+}
 
 bool PacketTransportInternal::GetOption(rtc::Socket::Option opt, int* value) {
   return false;
@@ -24,4 +28,39 @@ absl::optional<NetworkRoute> PacketTransportInternal::network_route() const {
   return absl::optional<NetworkRoute>();
 }
 
+void PacketTransportInternal::RegisterReceivedPacketCallback(
+    void* id,
+    absl::AnyInvocable<void(PacketTransportInternal*,
+                            const rtc::ReceivedPacket&,
+                            int flags)> callback) {
+  received_packet_callbacks_.AddReceiver(id, std::move(callback));
+}
+
+void PacketTransportInternal::DeregisterReceivedPacketCallback(void* id) {
+  received_packet_callbacks_.RemoveReceivers(id);
+}
+
+void PacketTransportInternal::RegisterDestroyedCallback(
+    void* id,
+    absl::AnyInvocable<void()> callback) {
+  destroyed_callbacks_.AddReceiver(id, std::move(callback));
+}
+
+void PacketTransportInternal::DeregisterDestroyedCallback(void* id) {
+  destroyed_callbacks_.RemoveReceivers(id);
+}
+
+void PacketTransportInternal::NotifyPacketReceived(
+    const rtc::ReceivedPacket& packet,
+    int flags) {
+  received_packet_callbacks_.Send(this, packet, flags);
+  if (!SignalReadPacket.is_empty()) {
+    SignalReadPacket(this,
+                     reinterpret_cast<const char*>(packet.payload().data()),
+                     packet.payload().size(),
+                     packet.arrival_time() ? packet.arrival_time()->us() : -1,
+                     flags);
+  }
+}
+
 }  // namespace rtc
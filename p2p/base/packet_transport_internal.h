@@ -14,9 +14,12 @@
 #include <string>
 #include <vector>
 
+#include "absl/functional/any_invocable.h"
 #include "absl/types/optional.h"
 #include "p2p/base/port.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/callback_list.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/network_route.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/system/rtc_export.h"
@@ -78,7 +81,29 @@ class RTC_EXPORT PacketTransportInternal : public sigslot::has_slots<> {
   // Emitted when receiving state changes to true.
   sigslot::signal1<PacketTransportInternal*> SignalReceivingState;
 
-  // Signalled each time a packet is received on this channel.
+  // Registers `callback` to be called with each packet received on this
+  // transport. `flags` are those of SignalReadPacket, e.g. PF_SRTP_BYPASS.
+  // The callbacks are called directly, without the lock and the walk over the
+  // connections of the signal, which adds up as every media packet passes
+  // through several transports. `id` identifies the callback to
+  // DeregisterReceivedPacketCallback().
+  void RegisterReceivedPacketCallback(
+      void* id,
+      absl::AnyInvocable<void(PacketTransportInternal*,
+                              const rtc::ReceivedPacket&,
+                              int flags)> callback);
+  void DeregisterReceivedPacketCallback(void* id);
+
+  // Registers `callback` to be called when this transport is destroyed. Unlike
+  // the signals, the received packet callbacks are not disconnected when their
+  // owner is destroyed, so owners deregister them, and use this to know
+  // whether the transport is still there to deregister from. `id` identifies
+  // the callback to DeregisterDestroyedCallback().
+  void RegisterDestroyedCallback(void* id, absl::AnyInvocable<void()> callback);
+  void DeregisterDestroyedCallback(void* id);
+
+  // Signalled each time a packet is received on this channel, after the
+  // received packet callbacks are called.
   sigslot::signal5<PacketTransportInternal*,
                    const char*,
                    size_t,
@@ -101,6 +126,16 @@ class RTC_EXPORT PacketTransportInternal : public sigslot::has_slots<> {
  protected:
   PacketTransportInternal();
   ~PacketTransportInternal() override;
+
+  // Hands `packet` to the received packet callbacks and SignalReadPacket.
+  void NotifyPacketReceived(const rtc::ReceivedPacket& packet, int flags);
+
+ private:
+  webrtc::CallbackList<PacketTransportInternal*,
+                       const rtc::ReceivedPacket&,
+                       int>
+      received_packet_callbacks_;
+  webrtc::CallbackList<> destroyed_callbacks_;
 };
 
 }  // namespace rtc
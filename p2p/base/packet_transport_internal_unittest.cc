@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/packet_transport_internal.h"
+
+#include <vector>
+
+#include "p2p/base/fake_packet_transport.h"
+#include "rtc_base/network/received_packet.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+class SignalListener : public sigslot::has_slots<> {
+ public:
+  void OnReadPacket(PacketTransportInternal* transport,
+                    const char* data,
+                    size_t len,
+                    const int64_t& packet_time_us,
+                    int flags) {
+    packet_sizes.push_back(len);
+  }
+
+  std::vector<size_t> packet_sizes;
+};
+
+TEST(PacketTransportInternalTest, CallsReceivedPacketCallbacksAndSignal) {
+  FakePacketTransport sender("sender");
+  FakePacketTransport receiver("receiver");
+  sender.SetDestination(&receiver, /*asymmetric=*/true);
+
+  std::vector<size_t> first_packet_sizes;
+  std::vector<size_t> second_packet_sizes;
+  int first_tag;
+  int second_tag;
+  receiver.RegisterReceivedPacketCallback(
+      &first_tag, [&](PacketTransportInternal* transport,
+                      const ReceivedPacket& packet, int flags) {
+        EXPECT_EQ(transport, &receiver);
+        EXPECT_EQ(flags, 0);
+        first_packet_sizes.push_back(packet.payload().size());
+      });
+  receiver.RegisterReceivedPacketCallback(
+      &second_tag, [&](PacketTransportInternal* transport,
+                       const ReceivedPacket& packet, int flags) {
+        second_packet_sizes.push_back(packet.payload().size());
+      });
+  SignalListener listener;
+  receiver.SignalReadPacket.connect(&listener, &SignalListener::OnReadPacket);
+
+  const char kData[] = "packet";
+  sender.SendPacket(kData, 3, PacketOptions(), /*flags=*/0);
+  receiver.DeregisterReceivedPacketCallback(&first_tag);
+  sender.SendPacket(kData, 4, PacketOptions(), /*flags=*/0);
+
+  EXPECT_THAT(first_packet_sizes, ElementsAre(3u));
+  EXPECT_THAT(second_packet_sizes, ElementsAre(3u, 4u));
+  EXPECT_THAT(listener.packet_sizes, ElementsAre(3u, 4u));
+}
+
+TEST(PacketTransportInternalTest, CallsDestroyedCallbacksOnDestruction) {
+  int first_tag;
+  int second_tag;
+  int first_calls = 0;
+  int second_calls = 0;
+  {
+    FakePacketTransport transport("transport");
+    transport.RegisterDestroyedCallback(&first_tag, [&] { ++first_calls; });
+    transport.RegisterDestroyedCallback(&second_tag, [&] { ++second_calls; });
+    transport.DeregisterDestroyedCallback(&first_tag);
+    EXPECT_EQ(second_calls, 0);
+  }
+  EXPECT_EQ(first_calls, 0);
+  EXPECT_EQ(second_calls, 1);
+}
+
+}  // namespace
+}  // namespace rtc
@@ -781,7 +781,8 @@ void TurnServerAllocation::OnExternalPacket(rtc::AsyncPacketSocket* socket,
   auto channel = FindChannel(packet.source_address());
   if (channel != channels_.end()) {
     // There is a channel bound to this address. Send as a channel message.
-    rtc::ByteBufferWriter buf;
+    rtc::ByteBufferWriter buf(nullptr,
+                              TURN_CHANNEL_HEADER_SIZE + packet.payload().size());
     buf.WriteUInt16(channel->id);
     buf.WriteUInt16(static_cast<uint16_t>(packet.payload().size()));
     buf.WriteBytes(reinterpret_cast<const char*>(packet.payload().data()),
@@ -19,6 +19,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/strings/string_view.h"
 #include "api/sequence_checker.h"
 #include "api/task_queue/pending_task_safety_flag.h"
@@ -58,6 +59,11 @@ class TurnServerConnection {
   bool operator<(const TurnServerConnection& t) const;
   std::string ToString() const;
 
+  template <typename H>
+  friend H AbslHashValue(H h, const TurnServerConnection& c) {
+    return H::combine(std::move(h), c.src_.Hash(), c.dst_.Hash(), c.proto_);
+  }
+
  private:
   rtc::SocketAddress src_;
   rtc::SocketAddress dst_;
@@ -179,7 +185,10 @@ class StunMessageObserver {
 // Not yet wired up: TCP support.
 class TurnServer : public sigslot::has_slots<> {
  public:
-  typedef std::map<TurnServerConnection, std::unique_ptr<TurnServerAllocation>>
+  // Allocations are looked up for every packet received from a client, so
+  // they are kept in a hash table rather than an ordered map.
+  typedef absl::flat_hash_map<TurnServerConnection,
+                              std::unique_ptr<TurnServerAllocation>>
       AllocationMap;
 
   explicit TurnServer(webrtc::TaskQueueBase* thread);
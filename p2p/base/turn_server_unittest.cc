@@ -62,4 +62,21 @@ TEST_F(TurnServerConnectionTest, ComparisonOperators) {
   ExpectNotEqual(connection1, connection4);
 }
 
+TEST_F(TurnServerConnectionTest, AllocationMapLookup) {
+  std::unique_ptr<rtc::AsyncPacketSocket> socket1(
+      socket_factory_.CreateUdpSocket(rtc::SocketAddress("1.1.1.1", 1), 0, 0));
+  std::unique_ptr<rtc::AsyncPacketSocket> socket2(
+      socket_factory_.CreateUdpSocket(rtc::SocketAddress("2.2.2.2", 2), 0, 0));
+  TurnServerConnection connection1(socket2->GetLocalAddress(), PROTO_UDP,
+                                   socket1.get());
+  TurnServerConnection connection2(socket2->GetLocalAddress(), PROTO_UDP,
+                                   socket1.get());
+  TurnServerConnection connection3(socket2->GetLocalAddress(), PROTO_TCP,
+                                   socket1.get());
+  TurnServer::AllocationMap allocations;
+  allocations[connection1] = nullptr;
+  EXPECT_TRUE(allocations.contains(connection2));
+  EXPECT_FALSE(allocations.contains(connection3));
+}
+
 }  // namespace cricket
@@ -21,8 +21,10 @@
 #include "pc/media_factory.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/internal/default_socket_server.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/socket_server.h"
 #include "rtc_base/time_utils.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 
@@ -195,7 +197,13 @@ ConnectionContext::ConnectionContext(
   if (media_engine_) {
     // TODO(tommi): Change VoiceEngine to do ctor time initialization so that
     // this isn't necessary.
+    int64_t init_start_ms = rtc::TimeMillis();
     worker_thread_->BlockingCall([&] { media_engine_->Init(); });
+    int64_t init_time_ms = rtc::TimeMillis() - init_start_ms;
+    RTC_LOG(LS_INFO) << "Media engine initialized in " << init_time_ms
+                     << " ms.";
+    RTC_HISTOGRAM_COUNTS_10000("WebRTC.PeerConnection.MediaEngineInitTimeMs",
+                               init_time_ms);
   }
 }
 
@@ -19,6 +19,8 @@
 #include <utility>
 
 #include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
@@ -485,8 +487,12 @@ bool UpdateTransportInfoForBundle(const ContentGroup& bundle_group,
       selected_transport_info->description.ice_pwd;
   ConnectionRole selected_connection_role =
       selected_transport_info->description.connection_role;
+  // With many m-sections, a linear search of the group per transport would
+  // make this quadratic.
+  const absl::flat_hash_set<absl::string_view> bundled_names(
+      bundle_group.content_names().begin(), bundle_group.content_names().end());
   for (TransportInfo& transport_info : sdesc->transport_infos()) {
-    if (bundle_group.HasContentName(transport_info.content_name) &&
+    if (bundled_names.contains(transport_info.content_name) &&
         transport_info.content_name != selected_content_name) {
       transport_info.description.ice_ufrag = selected_ufrag;
       transport_info.description.ice_pwd = selected_pwd;
@@ -496,22 +502,6 @@ bool UpdateTransportInfoForBundle(const ContentGroup& bundle_group,
   return true;
 }
 
-// Gets the CryptoParamsVec of the given `content_name` from `sdesc`, and
-// sets it to `cryptos`.
-bool GetCryptosByName(const SessionDescription* sdesc,
-                      const std::string& content_name,
-                      CryptoParamsVec* cryptos) {
-  if (!sdesc || !cryptos) {
-    return false;
-  }
-  const ContentInfo* content = sdesc->GetContentByName(content_name);
-  if (!content || !content->media_description()) {
-    return false;
-  }
-  *cryptos = content->media_description()->cryptos();
-  return true;
-}
-
 // Prunes the `target_cryptos` by removing the crypto params (crypto_suite)
 // which are not available in `filter`.
 void PruneCryptos(const CryptoParamsVec& filter,
@@ -534,13 +524,9 @@ void PruneCryptos(const CryptoParamsVec& filter,
       target_cryptos->end());
 }
 
-bool IsRtpContent(SessionDescription* sdesc, const std::string& content_name) {
-  bool is_rtp = false;
-  ContentInfo* content = sdesc->GetContentByName(content_name);
-  if (content && content->media_description()) {
-    is_rtp = IsRtpProtocol(content->media_description()->protocol());
-  }
-  return is_rtp;
+bool IsRtpContent(const ContentInfo* content) {
+  return content && content->media_description() &&
+         IsRtpProtocol(content->media_description()->protocol());
 }
 
 // Updates the crypto parameters of the `sdesc` according to the given
@@ -554,35 +540,53 @@ bool UpdateCryptoParamsForBundle(const ContentGroup& bundle_group,
     return false;
   }
 
+  // Index the contents and transports once, rather than looking each name up
+  // linearly, since bundles may contain hundreds of m-sections.
+  absl::flat_hash_map<absl::string_view, ContentInfo*> contents_by_name;
+  for (ContentInfo& content : sdesc->contents()) {
+    contents_by_name.try_emplace(content.name, &content);
+  }
+  absl::flat_hash_map<absl::string_view, const TransportInfo*>
+      transport_infos_by_name;
+  for (const TransportInfo& transport_info : sdesc->transport_infos()) {
+    transport_infos_by_name.try_emplace(transport_info.content_name,
+                                        &transport_info);
+  }
+  auto find_rtp_content = [&](absl::string_view content_name) -> ContentInfo* {
+    auto it = contents_by_name.find(content_name);
+    if (it == contents_by_name.end() || !IsRtpContent(it->second)) {
+      return nullptr;
+    }
+    return it->second;
+  };
+
   bool common_cryptos_needed = false;
   // Get the common cryptos.
   const ContentNames& content_names = bundle_group.content_names();
   CryptoParamsVec common_cryptos;
   bool first = true;
   for (const std::string& content_name : content_names) {
-    if (!IsRtpContent(sdesc, content_name)) {
+    const ContentInfo* content = find_rtp_content(content_name);
+    if (!content) {
       continue;
     }
     // The common cryptos are needed if any of the content does not have DTLS
     // enabled.
-    if (!sdesc->GetTransportInfoByName(content_name)->description.secure()) {
+    auto transport_info = transport_infos_by_name.find(content_name);
+    RTC_DCHECK(transport_info != transport_infos_by_name.end());
+    if (!transport_info->second->description.secure()) {
       common_cryptos_needed = true;
     }
+    const CryptoParamsVec& cryptos = content->media_description()->cryptos();
     if (first) {
       first = false;
       // Initial the common_cryptos with the first content in the bundle group.
-      if (!GetCryptosByName(sdesc, content_name, &common_cryptos)) {
-        return false;
-      }
+      common_cryptos = cryptos;
       if (common_cryptos.empty()) {
         // If there's no crypto params, we should just return.
         return true;
       }
     } else {
-      CryptoParamsVec cryptos;
-      if (!GetCryptosByName(sdesc, content_name, &cryptos)) {
-        return false;
-      }
       PruneCryptos(cryptos, &common_cryptos);
     }
   }
@@ -593,10 +597,10 @@ bool UpdateCryptoParamsForBundle(const ContentGroup& bundle_group,
 
   // Update to use the common cryptos.
   for (const std::string& content_name : content_names) {
-    if (!IsRtpContent(sdesc, content_name)) {
+    ContentInfo* content = find_rtp_content(content_name);
+    if (!content) {
       continue;
     }
-    ContentInfo* content = sdesc->GetContentByName(content_name);
     if (IsMediaContent(content)) {
       MediaContentDescription* media_desc = content->media_description();
       if (!media_desc) {
@@ -360,6 +360,9 @@ class PeerConnection : public PeerConnectionInternal,
   cricket::PortAllocator* port_allocator() override {
     return port_allocator_.get();
   }
+  rtc::scoped_refptr<PendingTaskSafetyFlag> network_thread_safety() override {
+    return network_thread_safety_;
+  }
   Call* call_ptr() override { return call_ptr_; }
 
   ConnectionContext* context() { return context_.get(); }
@@ -103,7 +103,8 @@ PeerConnectionFactory::PeerConnectionFactory(
           (dependencies->transport_controller_send_factory)
               ? std::move(dependencies->transport_controller_send_factory)
               : std::make_unique<RtpTransportControllerSendFactory>()),
-      metronome_(std::move(dependencies->metronome)) {}
+      metronome_(std::move(dependencies->metronome)),
+      encode_metronome_(std::move(dependencies->encode_metronome)) {}
 
 PeerConnectionFactory::PeerConnectionFactory(
     PeerConnectionFactoryDependencies dependencies)
@@ -119,6 +120,7 @@ PeerConnectionFactory::~PeerConnectionFactory() {
   worker_thread()->BlockingCall([this] {
     RTC_DCHECK_RUN_ON(worker_thread());
     metronome_ = nullptr;
+    encode_metronome_ = nullptr;
   });
 }
 
@@ -344,6 +346,7 @@ std::unique_ptr<Call> PeerConnectionFactory::CreateCall_w(
   call_config.rtp_transport_controller_send_factory =
       transport_controller_send_factory_.get();
   call_config.metronome = metronome_.get();
+  call_config.encode_metronome = encode_metronome_.get();
   return context_->call_factory()->CreateCall(call_config);
 }
 
@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/peer_connection_factory_pool.h"
+
+#include <string>
+#include <utility>
+
+#include "absl/memory/memory.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+namespace {
+
+// rtc::Thread spawns its own thread, so the attributes are applied from a
+// blocking call on it once it has started.
+std::unique_ptr<rtc::Thread> StartThread(
+    std::unique_ptr<rtc::Thread> thread,
+    const std::string& name,
+    const rtc::ThreadAttributes& attributes) {
+  thread->SetName(name, nullptr);
+  RTC_CHECK(thread->Start()) << "Failed to start " << name;
+  if (!attributes.cpu_affinity.empty()) {
+    thread->BlockingCall([&] {
+      if (!rtc::SetCurrentThreadCpuAffinity(attributes.cpu_affinity)) {
+        RTC_LOG(LS_WARNING) << "Failed to set the CPU affinity of " << name;
+      }
+    });
+  }
+  return thread;
+}
+
+}  // namespace
+
+std::unique_ptr<PeerConnectionFactoryPool> PeerConnectionFactoryPool::Create(
+    const Config& config,
+    DependenciesFactory create_dependencies) {
+  RTC_DCHECK_GE(config.num_shards, 1);
+  const int num_cores = CpuInfo::DetectNumberOfCores();
+  std::vector<Shard> shards(config.num_shards);
+  for (int i = 0; i < config.num_shards; ++i) {
+    Shard& shard = shards[i];
+    rtc::ThreadAttributes attributes;
+    if (config.pin_threads_to_cores) {
+      attributes.SetCpuAffinity({i % num_cores});
+    }
+    std::string suffix = "_" + std::to_string(i);
+    shard.network_thread =
+        StartThread(rtc::Thread::CreateWithSocketServer(),
+                    "pc_network_thread" + suffix, attributes);
+    shard.worker_thread = StartThread(rtc::Thread::Create(),
+                                      "pc_worker_thread" + suffix, attributes);
+
+    PeerConnectionFactoryDependencies dependencies = create_dependencies(i);
+    RTC_DCHECK(!dependencies.network_thread);
+    RTC_DCHECK(!dependencies.worker_thread);
+    dependencies.network_thread = shard.network_thread.get();
+    dependencies.worker_thread = shard.worker_thread.get();
+    shard.factory = CreateModularPeerConnectionFactory(std::move(dependencies));
+    if (!shard.factory) {
+      RTC_LOG(LS_ERROR) << "Failed to create the factory of shard " << i;
+      return nullptr;
+    }
+  }
+  return absl::WrapUnique(new PeerConnectionFactoryPool(std::move(shards)));
+}
+
+PeerConnectionFactoryPool::PeerConnectionFactoryPool(std::vector<Shard> shards)
+    : shards_(std::move(shards)) {}
+
+PeerConnectionFactoryPool::~PeerConnectionFactoryPool() = default;
+
+rtc::scoped_refptr<PeerConnectionFactoryInterface>
+PeerConnectionFactoryPool::NextFactory() {
+  unsigned shard = next_shard_.fetch_add(1, std::memory_order_relaxed);
+  return shards_[shard % shards_.size()].factory;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_PEER_CONNECTION_FACTORY_POOL_H_
+#define PC_PEER_CONNECTION_FACTORY_POOL_H_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "api/peer_connection_interface.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/thread.h"
+
+namespace webrtc {
+
+// Owns a number of shards, each being a PeerConnectionFactory with its own
+// network and worker threads, and places new PeerConnections on the shards in
+// turn. The Calls, transports and media channels of PeerConnections on
+// different shards then run on different threads, so that the number of calls
+// a process can host grows with its number of cores instead of being bound by
+// a single network and worker thread.
+//
+// A PeerConnection, and the tracks and sources added to it, must be created
+// from the factory of the same shard, since they're bound to its threads. The
+// factories, and everything created from them, must be released before the
+// pool is destroyed, since the pool owns the threads.
+class PeerConnectionFactoryPool {
+ public:
+  struct Config {
+    // Number of shards, at least one.
+    int num_shards = 1;
+    // If true, the threads of each shard are pinned to a core, the first shard
+    // to the first core and so on, wrapping around if there are more shards
+    // than cores. Ignored on platforms without support for thread affinity.
+    bool pin_threads_to_cores = true;
+  };
+
+  // Returns the dependencies of the factory of the shard `shard_index`. The
+  // network and worker threads must be left unset, since the pool provides
+  // them. The dependencies of all shards may share the signaling thread, and
+  // ref counted state such as the audio codec factories.
+  using DependenciesFactory =
+      absl::AnyInvocable<PeerConnectionFactoryDependencies(int shard_index)>;
+
+  // Returns nullptr if the factory of a shard couldn't be created.
+  static std::unique_ptr<PeerConnectionFactoryPool> Create(
+      const Config& config,
+      DependenciesFactory create_dependencies);
+
+  PeerConnectionFactoryPool(const PeerConnectionFactoryPool&) = delete;
+  PeerConnectionFactoryPool& operator=(const PeerConnectionFactoryPool&) =
+      delete;
+  ~PeerConnectionFactoryPool();
+
+  int num_shards() const { return static_cast<int>(shards_.size()); }
+
+  const rtc::scoped_refptr<PeerConnectionFactoryInterface>& factory(
+      int shard_index) const {
+    return shards_[shard_index].factory;
+  }
+
+  // Returns the factory of the shard to create the next PeerConnection on,
+  // together with its tracks. May be called on any thread.
+  rtc::scoped_refptr<PeerConnectionFactoryInterface> NextFactory();
+
+ private:
+  struct Shard {
+    std::unique_ptr<rtc::Thread> network_thread;
+    std::unique_ptr<rtc::Thread> worker_thread;
+    // Released before the threads it runs on.
+    rtc::scoped_refptr<PeerConnectionFactoryInterface> factory;
+  };
+
+  explicit PeerConnectionFactoryPool(std::vector<Shard> shards);
+
+  std::vector<Shard> shards_;
+  std::atomic<unsigned> next_shard_{0};
+};
+
+}  // namespace webrtc
+
+#endif  // PC_PEER_CONNECTION_FACTORY_POOL_H_
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/peer_connection_factory_pool.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/peer_connection_interface.h"
+#include "pc/test/mock_peer_connection_observers.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+PeerConnectionFactoryPool::DependenciesFactory CreateDependencies(
+    std::vector<int>* shard_indices) {
+  return [shard_indices](int shard_index) {
+    shard_indices->push_back(shard_index);
+    PeerConnectionFactoryDependencies dependencies;
+    dependencies.signaling_thread = rtc::Thread::Current();
+    return dependencies;
+  };
+}
+
+TEST(PeerConnectionFactoryPoolTest, CreatesFactoryPerShard) {
+  rtc::AutoThread main_thread;
+  std::vector<int> shard_indices;
+  auto pool = PeerConnectionFactoryPool::Create(
+      {.num_shards = 3}, CreateDependencies(&shard_indices));
+  ASSERT_TRUE(pool);
+  EXPECT_EQ(pool->num_shards(), 3);
+  EXPECT_EQ(shard_indices, (std::vector<int>{0, 1, 2}));
+  EXPECT_TRUE(pool->factory(0));
+  EXPECT_NE(pool->factory(0), pool->factory(1));
+  EXPECT_NE(pool->factory(1), pool->factory(2));
+}
+
+TEST(PeerConnectionFactoryPoolTest, PlacesPeerConnectionsInTurn) {
+  rtc::AutoThread main_thread;
+  std::vector<int> shard_indices;
+  auto pool = PeerConnectionFactoryPool::Create(
+      {.num_shards = 2, .pin_threads_to_cores = false},
+      CreateDependencies(&shard_indices));
+  ASSERT_TRUE(pool);
+  EXPECT_EQ(pool->NextFactory(), pool->factory(0));
+  EXPECT_EQ(pool->NextFactory(), pool->factory(1));
+  EXPECT_EQ(pool->NextFactory(), pool->factory(0));
+}
+
+TEST(PeerConnectionFactoryPoolTest, CreatesPeerConnectionsOnEachShard) {
+  rtc::AutoThread main_thread;
+  std::vector<int> shard_indices;
+  auto pool = PeerConnectionFactoryPool::Create(
+      {.num_shards = 2}, CreateDependencies(&shard_indices));
+  ASSERT_TRUE(pool);
+  MockPeerConnectionObserver observer;
+  std::vector<rtc::scoped_refptr<PeerConnectionInterface>> peer_connections;
+  for (int i = 0; i < 2; ++i) {
+    auto result = pool->NextFactory()->CreatePeerConnectionOrError(
+        PeerConnectionInterface::RTCConfiguration(),
+        PeerConnectionDependencies(&observer));
+    ASSERT_TRUE(result.ok());
+    peer_connections.push_back(result.MoveValue());
+  }
+  for (auto& peer_connection : peer_connections) {
+    peer_connection->Close();
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
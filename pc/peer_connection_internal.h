@@ -19,6 +19,7 @@
 
 #include "absl/types/optional.h"
 #include "api/peer_connection_interface.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "call/call.h"
 #include "modules/audio_device/include/audio_device.h"
 #include "pc/jsep_transport_controller.h"
@@ -73,6 +74,9 @@ class PeerConnectionSdpMethods {
   virtual JsepTransportController* transport_controller_n() = 0;
   virtual DataChannelController* data_channel_controller() = 0;
   virtual cricket::PortAllocator* port_allocator() = 0;
+  // Flag of the tasks posted to the network thread, which is set to not alive
+  // when the network thread objects, such as the port allocator, go away.
+  virtual rtc::scoped_refptr<PendingTaskSafetyFlag> network_thread_safety() = 0;
   virtual LegacyStatsCollector* legacy_stats() = 0;
   // Returns the observer. Will crash on CHECK if the observer is removed.
   virtual PeerConnectionObserver* Observer() const = 0;
@@ -1203,7 +1203,7 @@ void RTCStatsCollector::GetStatsReportInternal(
     // Prepare `transceiver_stats_infos_` and `call_stats_` for use in
     // `ProducePartialResultsOnNetworkThread` and
     // `ProducePartialResultsOnSignalingThread`.
-    PrepareTransceiverStatsInfosAndCallStats_s_w_n();
+    PrepareTransceiverStatsInfosAndCallStats_s_w();
     // Don't touch `network_report_` on the signaling thread until
     // ProducePartialResultsOnNetworkThread() has signaled the
     // `network_report_event_`.
@@ -1280,9 +1280,15 @@ void RTCStatsCollector::ProducePartialResultsOnNetworkThread(
     transport_names.emplace(std::move(*sctp_transport_name));
   }
 
-  for (const auto& info : transceiver_stats_infos_) {
-    if (info.transport_name)
-      transport_names.insert(*info.transport_name);
+  for (auto& info : transceiver_stats_infos_) {
+    // The channel is set and cleared on this thread, in blocking calls from
+    // the signaling thread, so it's still the one seen when this request was
+    // prepared.
+    cricket::ChannelInterface* channel = info.transceiver->channel();
+    if (!channel)
+      continue;
+    info.transport_name = std::string(channel->transport_name());
+    transport_names.insert(*info.transport_name);
   }
 
   std::map<std::string, cricket::TransportStats> transport_stats_by_name =
@@ -2020,7 +2026,7 @@ RTCStatsCollector::PrepareTransportCertificateStats_n(
   return transport_cert_stats;
 }
 
-void RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n() {
+void RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w() {
   RTC_DCHECK_RUN_ON(signaling_thread_);
 
   transceiver_stats_infos_.clear();
@@ -2041,9 +2047,12 @@ void RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n() {
 
   auto transceivers = pc_->GetTransceiversInternal();
 
-  // TODO(tommi): See if we can avoid synchronously blocking the signaling
-  // thread while we do this (or avoid the BlockingCall at all).
-  network_thread_->BlockingCall([&] {
+  // The channels of the transceivers are only set and cleared in blocking
+  // calls from the signaling thread, so they can be read here without a
+  // network thread hop. The transport names, which are owned by the network
+  // thread, are filled in by ProducePartialResultsOnNetworkThread(), which is
+  // the only reader of them.
+  {
     rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
 
     for (const auto& transceiver_proxy : transceivers) {
@@ -2064,7 +2073,6 @@ void RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n() {
       }
 
       stats.mid = channel->mid();
-      stats.transport_name = std::string(channel->transport_name());
 
       if (media_type == cricket::MEDIA_TYPE_AUDIO) {
         auto voice_send_channel = channel->voice_media_send_channel();
@@ -2093,7 +2101,7 @@ void RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n() {
         RTC_DCHECK_NOTREACHED();
       }
     }
-  });
+  }
 
   // We jump to the worker thread and call GetStats() on each media channel as
   // well as GetCallStats(). At the same time we construct the
@@ -166,7 +166,8 @@ class RTCStatsCollector : public rtc::RefCountInterface {
   // Some fields are copied from the RtpTransceiver/BaseChannel object so that
   // they can be accessed safely on threads other than the signaling thread.
   // If a BaseChannel is not available (e.g., if signaling has not started),
-  // then `mid` and `transport_name` will be null.
+  // then `mid` and `transport_name` will be null. `transport_name` is only
+  // set, and read, on the network thread.
   struct RtpTransceiverStatsInfo {
     rtc::scoped_refptr<RtpTransceiver> transceiver;
     cricket::MediaType media_type;
@@ -234,7 +235,7 @@ class RTCStatsCollector : public rtc::RefCountInterface {
       const std::map<std::string, cricket::TransportStats>&
           transport_stats_by_name);
   // The results are stored in `transceiver_stats_infos_` and `call_stats_`.
-  void PrepareTransceiverStatsInfosAndCallStats_s_w_n();
+  void PrepareTransceiverStatsInfosAndCallStats_s_w();
 
   // Stats gathering on a particular thread.
   void ProducePartialResultsOnSignalingThread(Timestamp timestamp);
@@ -274,15 +275,15 @@ class RTCStatsCollector : public rtc::RefCountInterface {
   // has updated the value of `network_report_`.
   rtc::Event network_report_event_;
 
-  // Cleared and set in `PrepareTransceiverStatsInfosAndCallStats_s_w_n`,
-  // starting out on the signaling thread, then network. Later read on the
-  // network and signaling threads as part of collecting stats and finally
-  // reset when the work is done. Initially this variable was added and not
-  // passed around as an arguments to avoid copies. This is thread safe due to
-  // how operations are sequenced and we don't start the stats collection
-  // sequence if one is in progress. As a future improvement though, we could
-  // now get rid of the variable and keep the data scoped within a stats
-  // collection sequence.
+  // Cleared and set in `PrepareTransceiverStatsInfosAndCallStats_s_w`,
+  // starting out on the signaling thread, then worker, with the transport
+  // names set on the network thread. Later read on the network and signaling
+  // threads as part of collecting stats and finally reset when the work is
+  // done. Initially this variable was added and not passed around as an
+  // arguments to avoid copies. This is thread safe due to how operations are
+  // sequenced and we don't start the stats collection sequence if one is in
+  // progress. As a future improvement though, we could now get rid of the
+  // variable and keep the data scoped within a stats collection sequence.
   std::vector<RtpTransceiverStatsInfo> transceiver_stats_infos_;
   // This cache avoids having to call rtc::SSLCertChain::GetStats(), which can
   // relatively expensive. ClearCachedStatsReport() needs to be called on
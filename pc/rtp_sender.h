@@ -125,7 +125,7 @@ class RtpSenderBase : public RtpSenderInternal, public ObserverInterface {
   bool SetTrack(MediaStreamTrackInterface* track) override;
   rtc::scoped_refptr<MediaStreamTrackInterface> track() const override {
     // This method is currently called from the worker thread by
-    // RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n.
+    // RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w.
     // RTC_DCHECK_RUN_ON(signaling_thread_);
     return track_;
   }
@@ -154,7 +154,7 @@ class RtpSenderBase : public RtpSenderInternal, public ObserverInterface {
   void SetSsrc(uint32_t ssrc) override;
   uint32_t ssrc() const override {
     // This method is currently called from the worker thread by
-    // RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w_n.
+    // RTCStatsCollector::PrepareTransceiverStatsInfosAndCallStats_s_w.
     // RTC_DCHECK_RUN_ON(signaling_thread_);
     return ssrc_;
   }
@@ -207,6 +207,16 @@ RTCError RtpTransceiver::CreateChannel(
     return RTCError(RTCErrorType::INTERNAL_ERROR,
                     "No media engine for mid=" + std::string(mid));
   }
+  // Cannot set a channel on a stopped transceiver.
+  if (stopped_) {
+    return RTCError::OK();
+  }
+
+  RTC_LOG_THREAD_BLOCK_COUNT();
+
+  // The senders and receivers are given the new media channels in the same
+  // worker thread hop that creates them, which saves a hop per transceiver
+  // compared to SetChannel().
   std::unique_ptr<cricket::ChannelInterface> new_channel;
   if (media_type() == cricket::MEDIA_TYPE_AUDIO) {
     // TODO(bugs.webrtc.org/11992): CreateVideoChannel internally switches to
@@ -250,6 +260,7 @@ RTCError RtpTransceiver::CreateChannel(
           context()->signaling_thread(), std::move(media_send_channel),
           std::move(media_receive_channel), mid, srtp_required, crypto_options,
           context()->ssrc_generator());
+      SetMediaChannels_w(new_channel.get());
     });
   } else {
     RTC_DCHECK_EQ(cricket::MEDIA_TYPE_VIDEO, media_type());
@@ -287,6 +298,7 @@ RTCError RtpTransceiver::CreateChannel(
           context()->signaling_thread(), std::move(media_send_channel),
           std::move(media_receive_channel), mid, srtp_required, crypto_options,
           context()->ssrc_generator());
+      SetMediaChannels_w(new_channel.get());
     });
   }
   if (!new_channel) {
@@ -294,7 +306,9 @@ RTCError RtpTransceiver::CreateChannel(
     return RTCError(RTCErrorType::INTERNAL_ERROR,
                     "Failed to create channel for mid=" + std::string(mid));
   }
-  SetChannel(std::move(new_channel), transport_lookup);
+  AttachChannel(std::move(new_channel), transport_lookup);
+
+  RTC_DCHECK_BLOCK_COUNT_NO_MORE_THAN(2);
   return RTCError::OK();
 }
 
@@ -312,6 +326,16 @@ void RtpTransceiver::SetChannel(
 
   RTC_LOG_THREAD_BLOCK_COUNT();
 
+  AttachChannel(std::move(channel), std::move(transport_lookup));
+  PushNewMediaChannelAndDeleteChannel(nullptr);
+
+  RTC_DCHECK_BLOCK_COUNT_NO_MORE_THAN(2);
+}
+
+void RtpTransceiver::AttachChannel(
+    std::unique_ptr<cricket::ChannelInterface> channel,
+    std::function<RtpTransportInternal*(const std::string&)> transport_lookup) {
+  RTC_DCHECK_RUN_ON(thread_);
   RTC_DCHECK_EQ(media_type(), channel->media_type());
   signaling_thread_safety_ = PendingTaskSafetyFlag::Create();
 
@@ -342,9 +366,6 @@ void RtpTransceiver::SetChannel(
               SafeTask(std::move(flag), [this]() { OnFirstPacketReceived(); }));
         });
   });
-  PushNewMediaChannelAndDeleteChannel(nullptr);
-
-  RTC_DCHECK_BLOCK_COUNT_NO_MORE_THAN(2);
 }
 
 void RtpTransceiver::ClearChannel() {
@@ -385,17 +406,7 @@ void RtpTransceiver::PushNewMediaChannelAndDeleteChannel(
   }
   context()->worker_thread()->BlockingCall([&]() {
     // Push down the new media_channel, if any, otherwise clear it.
-    auto* media_send_channel =
-        channel_ ? channel_->media_send_channel() : nullptr;
-    for (const auto& sender : senders_) {
-      sender->internal()->SetMediaChannel(media_send_channel);
-    }
-
-    auto* media_receive_channel =
-        channel_ ? channel_->media_receive_channel() : nullptr;
-    for (const auto& receiver : receivers_) {
-      receiver->internal()->SetMediaChannel(media_receive_channel);
-    }
+    SetMediaChannels_w(channel_.get());
 
     // Destroy the channel, if we had one, now _after_ updating the receivers
     // who might have had references to the previous channel.
@@ -405,6 +416,20 @@ void RtpTransceiver::PushNewMediaChannelAndDeleteChannel(
   });
 }
 
+void RtpTransceiver::SetMediaChannels_w(cricket::ChannelInterface* channel) {
+  RTC_DCHECK_RUN_ON(context()->worker_thread());
+  auto* media_send_channel = channel ? channel->media_send_channel() : nullptr;
+  for (const auto& sender : senders_) {
+    sender->internal()->SetMediaChannel(media_send_channel);
+  }
+
+  auto* media_receive_channel =
+      channel ? channel->media_receive_channel() : nullptr;
+  for (const auto& receiver : receivers_) {
+    receiver->internal()->SetMediaChannel(media_receive_channel);
+  }
+}
+
 void RtpTransceiver::AddSender(
     rtc::scoped_refptr<RtpSenderProxyWithInternal<RtpSenderInternal>> sender) {
   RTC_DCHECK_RUN_ON(thread_);
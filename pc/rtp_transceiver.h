@@ -303,6 +303,14 @@ class RtpTransceiver : public RtpTransceiverInterface {
   ConnectionContext* context() const { return context_; }
   void OnFirstPacketReceived();
   void StopSendingAndReceiving();
+  // Takes ownership of `channel` and connects it to its RTP transport on the
+  // network thread. Does not update the senders and receivers.
+  void AttachChannel(std::unique_ptr<cricket::ChannelInterface> channel,
+                     std::function<RtpTransportInternal*(const std::string&)>
+                         transport_lookup);
+  // Points the senders and receivers at the media channels of `channel`, or
+  // clears them if `channel` is null. Must be called on the worker thread.
+  void SetMediaChannels_w(cricket::ChannelInterface* channel);
   // Delete a channel, and ensure that references to its media channel
   // are updated before deleting it.
   void PushNewMediaChannelAndDeleteChannel(
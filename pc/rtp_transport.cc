@@ -14,18 +14,50 @@
 
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
+#include "api/make_ref_counted.h"
 #include "api/units/timestamp.h"
 #include "media/base/rtp_utils.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/trace_event.h"
 
 namespace webrtc {
+namespace {
+
+// Upper bound on the number of idle receive buffers of each size kept per
+// transport.
+constexpr size_t kMaxFreeReceiveBuffers = 64;
+// Fits most RTCP packets, which would otherwise each use storage for the
+// largest RTP packet.
+constexpr size_t kSmallReceiveBufferCapacity = 256;
+
+}  // namespace
+
+RtpTransport::RtpTransport(bool rtcp_mux_enabled)
+    : rtcp_mux_enabled_(rtcp_mux_enabled),
+      receive_buffer_pool_(rtc::make_ref_counted<rtc::CopyOnWriteBufferPool>(
+          std::vector<size_t>{kSmallReceiveBufferCapacity,
+                              cricket::kMaxRtpPacketLen},
+          kMaxFreeReceiveBuffers)) {}
+
+RtpTransport::~RtpTransport() {
+  // Unlike the signals, the callbacks are not disconnected automatically.
+  if (rtp_packet_transport_) {
+    rtp_packet_transport_->DeregisterReceivedPacketCallback(this);
+    rtp_packet_transport_->DeregisterDestroyedCallback(this);
+  }
+  if (rtcp_packet_transport_) {
+    rtcp_packet_transport_->DeregisterReceivedPacketCallback(this);
+    rtcp_packet_transport_->DeregisterDestroyedCallback(this);
+  }
+}
 
 void RtpTransport::SetRtcpMuxEnabled(bool enable) {
   rtcp_mux_enabled_ = enable;
@@ -54,7 +86,8 @@ void RtpTransport::SetRtpPacketTransport(
   }
   if (rtp_packet_transport_) {
     rtp_packet_transport_->SignalReadyToSend.disconnect(this);
-    rtp_packet_transport_->SignalReadPacket.disconnect(this);
+    rtp_packet_transport_->DeregisterReceivedPacketCallback(this);
+    rtp_packet_transport_->DeregisterDestroyedCallback(this);
     rtp_packet_transport_->SignalNetworkRouteChanged.disconnect(this);
     rtp_packet_transport_->SignalWritableState.disconnect(this);
     rtp_packet_transport_->SignalSentPacket.disconnect(this);
@@ -64,8 +97,13 @@ void RtpTransport::SetRtpPacketTransport(
   if (new_packet_transport) {
     new_packet_transport->SignalReadyToSend.connect(
         this, &RtpTransport::OnReadyToSend);
-    new_packet_transport->SignalReadPacket.connect(this,
-                                                   &RtpTransport::OnReadPacket);
+    new_packet_transport->RegisterReceivedPacketCallback(
+        this, [this](rtc::PacketTransportInternal* transport,
+                     const rtc::ReceivedPacket& packet, int flags) {
+          OnReadPacket(transport, packet, flags);
+        });
+    new_packet_transport->RegisterDestroyedCallback(
+        this, [this] { rtp_packet_transport_ = nullptr; });
     new_packet_transport->SignalNetworkRouteChanged.connect(
         this, &RtpTransport::OnNetworkRouteChanged);
     new_packet_transport->SignalWritableState.connect(
@@ -90,7 +128,8 @@ void RtpTransport::SetRtcpPacketTransport(
   }
   if (rtcp_packet_transport_) {
     rtcp_packet_transport_->SignalReadyToSend.disconnect(this);
-    rtcp_packet_transport_->SignalReadPacket.disconnect(this);
+    rtcp_packet_transport_->DeregisterReceivedPacketCallback(this);
+    rtcp_packet_transport_->DeregisterDestroyedCallback(this);
     rtcp_packet_transport_->SignalNetworkRouteChanged.disconnect(this);
     rtcp_packet_transport_->SignalWritableState.disconnect(this);
     rtcp_packet_transport_->SignalSentPacket.disconnect(this);
@@ -100,8 +139,13 @@ void RtpTransport::SetRtcpPacketTransport(
   if (new_packet_transport) {
     new_packet_transport->SignalReadyToSend.connect(
         this, &RtpTransport::OnReadyToSend);
-    new_packet_transport->SignalReadPacket.connect(this,
-                                                   &RtpTransport::OnReadPacket);
+    new_packet_transport->RegisterReceivedPacketCallback(
+        this, [this](rtc::PacketTransportInternal* transport,
+                     const rtc::ReceivedPacket& packet, int flags) {
+          OnReadPacket(transport, packet, flags);
+        });
+    new_packet_transport->RegisterDestroyedCallback(
+        this, [this] { rtcp_packet_transport_ = nullptr; });
     new_packet_transport->SignalNetworkRouteChanged.connect(
         this, &RtpTransport::OnNetworkRouteChanged);
     new_packet_transport->SignalWritableState.connect(
@@ -185,7 +229,8 @@ flat_set<uint32_t> RtpTransport::GetSsrcsForSink(RtpPacketSinkInterface* sink) {
 }
 
 void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
-                               int64_t packet_time_us) {
+                               int64_t packet_time_us,
+                               rtc::EcnMarking ecn) {
   RtpPacketReceived parsed_packet(&header_extension_map_,
                                   packet_time_us == -1
                                       ? Timestamp::MinusInfinity()
@@ -195,6 +240,7 @@ void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
         << "Failed to parse the incoming RTP packet before demuxing. Drop it.";
     return;
   }
+  parsed_packet.set_ecn(ecn);
 
   if (!rtp_demuxer_.OnRtpPacket(parsed_packet)) {
     RTC_LOG(LS_VERBOSE) << "Failed to demux RTP packet: "
@@ -241,8 +287,9 @@ void RtpTransport::OnSentPacket(rtc::PacketTransportInternal* packet_transport,
 }
 
 void RtpTransport::OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
-                                       int64_t packet_time_us) {
-  DemuxPacket(packet, packet_time_us);
+                                       int64_t packet_time_us,
+                                       rtc::EcnMarking ecn) {
+  DemuxPacket(packet, packet_time_us, ecn);
 }
 
 void RtpTransport::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
@@ -251,16 +298,16 @@ void RtpTransport::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
 }
 
 void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
-                                const char* data,
-                                size_t len,
-                                const int64_t& packet_time_us,
+                                const rtc::ReceivedPacket& received_packet,
                                 int flags) {
   TRACE_EVENT0("webrtc", "RtpTransport::OnReadPacket");
 
   // When using RTCP multiplexing we might get RTCP packets on the RTP
   // transport. We check the RTP payload type to determine if it is RTCP.
-  auto array_view = rtc::MakeArrayView(data, len);
-  cricket::RtpPacketType packet_type = cricket::InferRtpPacketType(array_view);
+  rtc::ArrayView<const uint8_t> data = received_packet.payload();
+  const size_t len = data.size();
+  cricket::RtpPacketType packet_type = cricket::InferRtpPacketType(
+      rtc::reinterpret_array_view<const char>(data));
   // Filter out the packet that is neither RTP nor RTCP.
   if (packet_type == cricket::RtpPacketType::kUnknown) {
     return;
@@ -274,11 +321,16 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
     return;
   }
 
-  rtc::CopyOnWriteBuffer packet(data, len);
+  rtc::CopyOnWriteBuffer packet =
+      receive_buffer_pool_->CreateBuffer(data.data(), len);
+  const int64_t packet_time_us = received_packet.arrival_time()
+                                     ? received_packet.arrival_time()->us()
+                                     : -1;
   if (packet_type == cricket::RtpPacketType::kRtcp) {
     OnRtcpPacketReceived(std::move(packet), packet_time_us);
   } else {
-    OnRtpPacketReceived(std::move(packet), packet_time_us);
+    OnRtpPacketReceived(std::move(packet), packet_time_us,
+                        received_packet.ecn());
   }
 }
 
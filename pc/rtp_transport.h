@@ -26,6 +26,9 @@
 #include "pc/session_description.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/copy_on_write_buffer_pool.h"
+#include "rtc_base/network/ecn_marking.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/network/sent_packet.h"
 #include "rtc_base/network_route.h"
 #include "rtc_base/socket.h"
@@ -45,8 +48,8 @@ class RtpTransport : public RtpTransportInternal {
   RtpTransport(const RtpTransport&) = delete;
   RtpTransport& operator=(const RtpTransport&) = delete;
 
-  explicit RtpTransport(bool rtcp_mux_enabled)
-      : rtcp_mux_enabled_(rtcp_mux_enabled) {}
+  explicit RtpTransport(bool rtcp_mux_enabled);
+  ~RtpTransport() override;
 
   bool rtcp_mux_enabled() const override { return rtcp_mux_enabled_; }
   void SetRtcpMuxEnabled(bool enable) override;
@@ -90,7 +93,9 @@ class RtpTransport : public RtpTransportInternal {
 
  protected:
   // These methods will be used in the subclasses.
-  void DemuxPacket(rtc::CopyOnWriteBuffer packet, int64_t packet_time_us);
+  void DemuxPacket(rtc::CopyOnWriteBuffer packet,
+                   int64_t packet_time_us,
+                   rtc::EcnMarking ecn);
 
   bool SendPacket(bool rtcp,
                   rtc::CopyOnWriteBuffer* packet,
@@ -102,7 +107,8 @@ class RtpTransport : public RtpTransportInternal {
   virtual void OnNetworkRouteChanged(
       absl::optional<rtc::NetworkRoute> network_route);
   virtual void OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
-                                   int64_t packet_time_us);
+                                   int64_t packet_time_us,
+                                   rtc::EcnMarking ecn);
   virtual void OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
                                     int64_t packet_time_us);
   // Overridden by SrtpTransport and DtlsSrtpTransport.
@@ -113,9 +119,7 @@ class RtpTransport : public RtpTransportInternal {
   void OnSentPacket(rtc::PacketTransportInternal* packet_transport,
                     const rtc::SentPacket& sent_packet);
   void OnReadPacket(rtc::PacketTransportInternal* transport,
-                    const char* data,
-                    size_t len,
-                    const int64_t& packet_time_us,
+                    const rtc::ReceivedPacket& received_packet,
                     int flags);
 
   // Updates "ready to send" for an individual channel and fires
@@ -142,6 +146,8 @@ class RtpTransport : public RtpTransportInternal {
   // Guard against recursive "ready to send" signals
   bool processing_ready_to_send_ = false;
   bool processing_sent_packet_ = false;
+  // Storage for received packets, recycled once the packets are consumed.
+  const rtc::scoped_refptr<rtc::CopyOnWriteBufferPool> receive_buffer_pool_;
   ScopedTaskSafety safety_;
 };
 
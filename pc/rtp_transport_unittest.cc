@@ -373,4 +373,25 @@ TEST(RtpTransportTest, RecursiveOnSentPacketDoesNotCrash) {
   EXPECT_EQ_WAIT(observer.sent_packet_count(), 2, kShortTimeout);
 }
 
+TEST(RtpTransportTest, DoesNotReceivePacketsAfterDestruction) {
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  fake_rtp.SetDestination(&fake_rtp, true);
+  {
+    RtpTransport transport(kMuxEnabled);
+    transport.SetRtpPacketTransport(&fake_rtp);
+  }
+  rtc::CopyOnWriteBuffer rtp_data(kRtpData, kRtpLen);
+  // The deregistered callback would otherwise run on the destroyed transport.
+  fake_rtp.SendPacket(rtp_data.data<char>(), kRtpLen, rtc::PacketOptions(), 0);
+}
+
+TEST(RtpTransportTest, CanOutlivePacketTransport) {
+  RtpTransport transport(kMuxEnabled);
+  {
+    rtc::FakePacketTransport fake_rtp("fake_rtp");
+    transport.SetRtpPacketTransport(&fake_rtp);
+  }
+  EXPECT_EQ(transport.rtp_packet_transport(), nullptr);
+}
+
 }  // namespace webrtc
@@ -30,6 +30,7 @@
 #include "api/rtp_parameters.h"
 #include "api/rtp_receiver_interface.h"
 #include "api/rtp_sender_interface.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "api/video/builtin_video_bitrate_allocator_factory.h"
 #include "media/base/codec.h"
 #include "media/base/rid_description.h"
@@ -2377,11 +2378,7 @@ void SdpOfferAnswerHandler::DoSetLocalDescription(
 
   if (local_description()->GetType() == SdpType::kAnswer) {
     RemoveStoppedTransceivers();
-
-    // TODO(deadbeef): We already had to hop to the network thread for
-    // MaybeStartGathering...
-    context_->network_thread()->BlockingCall(
-        [this] { port_allocator()->DiscardCandidatePool(); });
+    DiscardCandidatePool();
   }
 
   observer->OnSetLocalDescriptionComplete(RTCError::OK());
@@ -2580,10 +2577,7 @@ void SdpOfferAnswerHandler::SetRemoteDescriptionPostProcess(bool was_answer) {
   RTC_DCHECK(remote_description());
 
   if (was_answer) {
-    // TODO(deadbeef): We already had to hop to the network thread for
-    // MaybeStartGathering...
-    context_->network_thread()->BlockingCall(
-        [this] { port_allocator()->DiscardCandidatePool(); });
+    DiscardCandidatePool();
   }
 
   pc_->NoteUsageEvent(UsageEvent::SET_REMOTE_DESCRIPTION_SUCCEEDED);
@@ -4969,6 +4963,20 @@ void SdpOfferAnswerHandler::RemoveStoppedTransceivers() {
   }
 }
 
+void SdpOfferAnswerHandler::DiscardCandidatePool() {
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  cricket::PortAllocator* allocator = port_allocator();
+  if (context_->network_thread()->IsCurrent()) {
+    allocator->DiscardCandidatePool();
+    return;
+  }
+  // Nothing depends on the result, so there's no need to block the signaling
+  // thread. Later calls to the network thread run after this task.
+  context_->network_thread()->PostTask(
+      SafeTask(pc_->network_thread_safety(),
+               [allocator] { allocator->DiscardCandidatePool(); }));
+}
+
 void SdpOfferAnswerHandler::RemoveUnusedChannels(
     const SessionDescription* desc) {
   RTC_DCHECK_RUN_ON(signaling_thread());
@@ -489,6 +489,8 @@ class SdpOfferAnswerHandler : public SdpStateProvider {
                                         SdpType type);
   // Helper function to remove stopped transceivers.
   void RemoveStoppedTransceivers();
+  // Discards the ICE candidate pool on the network thread, without waiting.
+  void DiscardCandidatePool();
   // Deletes the corresponding channel of contents that don't exist in `desc`.
   // `desc` can be null. This means that all channels are deleted.
   void RemoveUnusedChannels(const cricket::SessionDescription* desc);
@@ -167,7 +167,30 @@ bool SrtpSession::ProtectRtp(void* p, int in_len, int max_len, int* out_len) {
     RTC_LOG(LS_WARNING) << "Failed to protect SRTP packet: no SRTP Session";
     return false;
   }
+  return DoProtectRtp(p, in_len, max_len, out_len);
+}
 
+size_t SrtpSession::ProtectRtp(rtc::ArrayView<RtpPacketBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to protect " << packets.size()
+                        << " SRTP packets: no SRTP Session";
+    return 0;
+  }
+  size_t num_protected = 0;
+  for (RtpPacketBuffer& packet : packets) {
+    int out_len;
+    if (DoProtectRtp(packet.data, packet.size, packet.capacity, &out_len)) {
+      packet.protected_size = out_len;
+      ++num_protected;
+    } else {
+      packet.protected_size = -1;
+    }
+  }
+  return num_protected;
+}
+
+bool SrtpSession::DoProtectRtp(void* p, int in_len, int max_len, int* out_len) {
   // Note: the need_len differs from the libsrtp recommendatіon to ensure
   // SRTP_MAX_TRAILER_LEN bytes of free space after the data. WebRTC
   // never includes a MKI, therefore the amount of bytes added by the
@@ -246,6 +269,12 @@ bool SrtpSession::UnprotectRtp(void* p, int in_len, int* out_len) {
 
   *out_len = in_len;
   int err = srtp_unprotect(session_, p, out_len);
+  if (err == srtp_err_status_replay_fail) {
+    // A copy of a packet that was already received, e.g. a duplicate from the
+    // network or a redundant copy sent over a backup network. It is dropped,
+    // but isn't reported as a failure.
+    return false;
+  }
   if (err != srtp_err_status_ok) {
     // Limit the error logging to avoid excessive logs when there are lots of
     // bad packets.
@@ -275,6 +304,10 @@ bool SrtpSession::UnprotectRtcp(void* p, int in_len, int* out_len) {
 
   *out_len = in_len;
   int err = srtp_unprotect_rtcp(session_, p, out_len);
+  if (err == srtp_err_status_replay_fail) {
+    // See UnprotectRtp().
+    return false;
+  }
   if (err != srtp_err_status_ok) {
     RTC_LOG(LS_WARNING) << "Failed to unprotect SRTCP packet, err=" << err;
     RTC_HISTOGRAM_ENUMERATION("WebRTC.PeerConnection.SrtcpUnprotectError",
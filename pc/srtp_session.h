@@ -16,6 +16,7 @@
 
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/field_trials_view.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
@@ -73,6 +74,18 @@ class SrtpSession {
                   int max_len,
                   int* out_len,
                   int64_t* index);
+  // An RTP packet protected in place by the batch version of ProtectRtp().
+  struct RtpPacketBuffer {
+    void* data;
+    int size;
+    int capacity;
+    // Set to the size including the auth tag, or -1 if protection failed.
+    int protected_size = -1;
+  };
+  // Encrypts/signs a burst of RTP packets in place, checking the session
+  // state once for the whole burst. Returns the number of packets protected;
+  // a packet that fails does not stop the others.
+  size_t ProtectRtp(rtc::ArrayView<RtpPacketBuffer> packets);
   bool ProtectRtcp(void* data, int in_len, int max_len, int* out_len);
   // Decrypts/verifies an invidiual RTP/RTCP packet.
   // If an HMAC is used, this will decrease the packet size.
@@ -121,6 +134,8 @@ class SrtpSession {
                  const uint8_t* key,
                  size_t len,
                  const std::vector<int>& extension_ids);
+  // ProtectRtp() without the session state checks.
+  bool DoProtectRtp(void* data, int in_len, int max_len, int* out_len);
   // Returns send stream current packet index from srtp db.
   bool GetSendStreamPacketIndex(void* data, int in_len, int64_t* index);
 
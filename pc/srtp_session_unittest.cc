@@ -183,6 +183,38 @@ TEST_F(SrtpSessionTest, TestUnencryptReject) {
       ElementsAre(Pair(srtp_err_status_cant_check, 1)));
 }
 
+// Test that a batch of RTP packets is protected in place, and that a packet
+// that fails does not affect the rest of the batch.
+TEST_F(SrtpSessionTest, TestProtectRtpBatch) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  char packets[3][sizeof(kPcmuFrame) + 10];
+  cricket::SrtpSession::RtpPacketBuffer buffers[3];
+  for (int i = 0; i < 3; ++i) {
+    memcpy(packets[i], kPcmuFrame, sizeof(kPcmuFrame));
+    SetBE16(reinterpret_cast<uint8_t*>(packets[i]) + 2, i + 1);
+    buffers[i].data = packets[i];
+    buffers[i].size = sizeof(kPcmuFrame);
+    buffers[i].capacity = sizeof(packets[i]);
+  }
+  // No room for the auth tag.
+  buffers[1].capacity = sizeof(kPcmuFrame);
+
+  EXPECT_EQ(2u, s1_.ProtectRtp(buffers));
+  EXPECT_EQ(-1, buffers[1].protected_size);
+  for (int i : {0, 2}) {
+    EXPECT_EQ(buffers[i].protected_size,
+              static_cast<int>(sizeof(kPcmuFrame)) +
+                  rtp_auth_tag_len(kCsAesCm128HmacSha1_80));
+    int out_len = 0;
+    EXPECT_TRUE(
+        s2_.UnprotectRtp(packets[i], buffers[i].protected_size, &out_len));
+    EXPECT_EQ(static_cast<int>(sizeof(kPcmuFrame)), out_len);
+  }
+}
+
 // Test that we fail when using buffers that are too small.
 TEST_F(SrtpSessionTest, TestBuffersTooSmall) {
   int out_len;
@@ -251,6 +283,31 @@ TEST_F(SrtpSessionTest, TestReplay) {
       s1_.ProtectRtp(rtp_packet_, rtp_len_, sizeof(rtp_packet_), &out_len));
 }
 
+// Test that replayed packets, like redundant copies of a packet, are dropped
+// without being reported as unprotect errors.
+TEST_F(SrtpSessionTest, TestReplayedPacketsAreNotReportedAsErrors) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  TestProtectRtp(kCsAesCm128HmacSha1_80);
+  TestProtectRtcp(kCsAesCm128HmacSha1_80);
+  char rtp_copy[sizeof(rtp_packet_)];
+  char rtcp_copy[sizeof(rtcp_packet_)];
+  memcpy(rtp_copy, rtp_packet_, rtp_len_);
+  memcpy(rtcp_copy, rtcp_packet_, rtcp_len_);
+  TestUnprotectRtp(kCsAesCm128HmacSha1_80);
+  TestUnprotectRtcp(kCsAesCm128HmacSha1_80);
+
+  int out_len;
+  EXPECT_FALSE(s2_.UnprotectRtp(rtp_copy, rtp_len_, &out_len));
+  EXPECT_FALSE(s2_.UnprotectRtcp(rtcp_copy, rtcp_len_, &out_len));
+  EXPECT_METRIC_EQ(0, webrtc::metrics::NumSamples(
+                          "WebRTC.PeerConnection.SrtpUnprotectError"));
+  EXPECT_METRIC_EQ(0, webrtc::metrics::NumSamples(
+                          "WebRTC.PeerConnection.SrtcpUnprotectError"));
+}
+
 TEST_F(SrtpSessionTest, RemoveSsrc) {
   EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
                           kEncryptedHeaderExtensionIds));
@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "absl/strings/match.h"
+#include "api/task_queue/task_queue_base.h"
 #include "media/base/rtp_utils.h"
 #include "modules/rtp_rtcp/source/rtp_util.h"
 #include "pc/rtp_transport.h"
@@ -45,6 +46,26 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
         << "Failed to send the packet because SRTP transport is inactive.";
     return false;
   }
+#if defined(ENABLE_EXTERNAL_AUTH)
+  bool can_batch = options.batchable && !IsExternalAuthActive();
+#else
+  bool can_batch = options.batchable;
+#endif
+  if (can_batch) {
+    // Batchable packets are protected together when the last packet of the
+    // batch arrives, see SendPendingRtpPackets().
+    pending_rtp_packets_.push_back({std::move(*packet), options, flags});
+    if (!options.last_packet_in_batch &&
+        pending_rtp_packets_.size() < kMaxPendingRtpPackets) {
+      if (pending_rtp_packets_.size() == 1) {
+        PostSendPendingRtpPackets();
+      }
+      return true;
+    }
+    return SendPendingRtpPackets();
+  }
+  SendPendingRtpPackets();
+
   rtc::PacketOptions updated_options = options;
   TRACE_EVENT0("webrtc", "SRTP Encode");
   bool res;
@@ -93,6 +114,76 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
   return SendPacket(/*rtcp=*/false, packet, updated_options, flags);
 }
 
+bool SrtpTransport::SendPendingRtpPackets() {
+  if (pending_rtp_packets_.empty()) {
+    return true;
+  }
+  ++pending_rtp_batch_id_;
+  std::vector<PendingRtpPacket> packets = std::move(pending_rtp_packets_);
+  pending_rtp_packets_.clear();
+  if (!IsSrtpActive()) {
+    RTC_LOG(LS_ERROR) << "Failed to send " << packets.size()
+                      << " packets because SRTP transport is inactive.";
+    return false;
+  }
+
+  TRACE_EVENT1("webrtc", "SRTP Encode batch", "packets", packets.size());
+  std::vector<cricket::SrtpSession::RtpPacketBuffer> buffers;
+  buffers.reserve(packets.size());
+  for (PendingRtpPacket& pending : packets) {
+    buffers.push_back({pending.packet.MutableData(),
+                       rtc::checked_cast<int>(pending.packet.size()),
+                       rtc::checked_cast<int>(pending.packet.capacity())});
+  }
+  send_session_->ProtectRtp(buffers);
+
+  // The last packet handed to the socket must close the batch, so find the
+  // last one that was protected.
+  size_t last_protected = packets.size();
+  for (size_t i = 0; i < packets.size(); ++i) {
+    if (buffers[i].protected_size < 0) {
+      RTC_LOG(LS_ERROR) << "Failed to protect RTP packet: size="
+                        << buffers[i].size << ", seqnum="
+                        << ParseRtpSequenceNumber(packets[i].packet)
+                        << ", SSRC=" << ParseRtpSsrc(packets[i].packet);
+      continue;
+    }
+    last_protected = i;
+  }
+
+  bool res = last_protected < packets.size();
+  for (size_t i = 0; i < packets.size(); ++i) {
+    if (buffers[i].protected_size < 0) {
+      res = false;
+      continue;
+    }
+    PendingRtpPacket& pending = packets[i];
+    // Update the length of the packet now that we've added the auth tag.
+    pending.packet.SetSize(buffers[i].protected_size);
+    pending.options.last_packet_in_batch = i == last_protected;
+    if (!SendPacket(/*rtcp=*/false, &pending.packet, pending.options,
+                    pending.flags)) {
+      res = false;
+    }
+  }
+  return res;
+}
+
+void SrtpTransport::PostSendPendingRtpPackets() {
+  TaskQueueBase* task_queue = TaskQueueBase::Current();
+  if (!task_queue) {
+    // Without a task queue the batch waits for its last packet.
+    return;
+  }
+  task_queue->PostTask(SafeTask(
+      pending_rtp_batch_safety_.flag(),
+      [this, batch_id = pending_rtp_batch_id_] {
+        if (batch_id == pending_rtp_batch_id_) {
+          SendPendingRtpPackets();
+        }
+      }));
+}
+
 bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
                                    const rtc::PacketOptions& options,
                                    int flags) {
@@ -102,6 +193,9 @@ bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
     return false;
   }
 
+  // Keep RTCP behind the RTP packets queued before it.
+  SendPendingRtpPackets();
+
   TRACE_EVENT0("webrtc", "SRTP Encode");
   uint8_t* data = packet->MutableData();
   int len = rtc::checked_cast<int>(packet->size());
@@ -119,7 +213,8 @@ bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
 }
 
 void SrtpTransport::OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
-                                        int64_t packet_time_us) {
+                                        int64_t packet_time_us,
+                                        rtc::EcnMarking ecn) {
   TRACE_EVENT0("webrtc", "SrtpTransport::OnRtpPacketReceived");
   if (!IsSrtpActive()) {
     RTC_LOG(LS_WARNING)
@@ -143,7 +238,7 @@ void SrtpTransport::OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
     return;
   }
   packet.SetSize(len);
-  DemuxPacket(std::move(packet), packet_time_us);
+  DemuxPacket(std::move(packet), packet_time_us, ecn);
 }
 
 void SrtpTransport::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
@@ -197,6 +292,7 @@ bool SrtpTransport::SetRtpParams(int send_crypto_suite,
   // sessions and call "SetSend/SetRecv". Otherwise we should call
   // "UpdateSend"/"UpdateRecv" on the existing sessions, which will internally
   // call "srtp_update".
+  SendPendingRtpPackets();
   bool new_sessions = false;
   if (!send_session_) {
     RTC_DCHECK(!recv_session_);
@@ -275,6 +371,8 @@ bool SrtpTransport::IsWritable(bool rtcp) const {
 }
 
 void SrtpTransport::ResetParams() {
+  // Send what was queued with the keys it was queued under.
+  SendPendingRtpPackets();
   send_session_ = nullptr;
   recv_session_ = nullptr;
   send_rtcp_session_ = nullptr;
@@ -22,12 +22,14 @@
 #include "api/crypto_params.h"
 #include "api/field_trials_view.h"
 #include "api/rtc_error.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "p2p/base/packet_transport_internal.h"
 #include "pc/rtp_transport.h"
 #include "pc/srtp_session.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/network_route.h"
 
 namespace webrtc {
@@ -119,7 +121,8 @@ class SrtpTransport : public RtpTransport {
   void CreateSrtpSessions();
 
   void OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
-                           int64_t packet_time_us) override;
+                           int64_t packet_time_us,
+                           rtc::EcnMarking ecn) override;
   void OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
                             int64_t packet_time_us) override;
   void OnNetworkRouteChanged(
@@ -128,6 +131,13 @@ class SrtpTransport : public RtpTransport {
   // Override the RtpTransport::OnWritableState.
   void OnWritableState(rtc::PacketTransportInternal* packet_transport) override;
 
+  // Protects and sends the batchable packets queued by SendRtpPacket().
+  // Returns false if any packet failed.
+  bool SendPendingRtpPackets();
+  // Posts a task that sends the pending batch if its last packet has not
+  // arrived by then, so a burst that ends early is not held indefinitely.
+  void PostSendPendingRtpPackets();
+
   bool ProtectRtp(void* data, int in_len, int max_len, int* out_len);
 
   // Overloaded version, outputs packet index.
@@ -169,6 +179,19 @@ class SrtpTransport : public RtpTransport {
 
   int decryption_failure_count_ = 0;
 
+  // Batchable RTP packets waiting for the last packet of their batch.
+  struct PendingRtpPacket {
+    rtc::CopyOnWriteBuffer packet;
+    rtc::PacketOptions options;
+    int flags;
+  };
+  static constexpr size_t kMaxPendingRtpPackets = 64;
+  std::vector<PendingRtpPacket> pending_rtp_packets_;
+  // Incremented each time a batch is sent, so that a posted send only
+  // applies to the batch it was posted for.
+  uint64_t pending_rtp_batch_id_ = 0;
+  ScopedTaskSafety pending_rtp_batch_safety_;
+
   const FieldTrialsView& field_trials_;
 };
 
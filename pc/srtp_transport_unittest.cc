@@ -26,6 +26,7 @@
 #include "rtc_base/containers/flat_set.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
 #include "test/gtest.h"
 #include "test/scoped_key_value_config.h"
 
@@ -487,4 +488,36 @@ TEST_F(SrtpTransportTest, RemoveSrtpReceiveStream) {
   srtp_transport->UnregisterRtpDemuxerSink(&rtp_sink);
 }
 
+TEST_F(SrtpTransportTest, SendsBatchWithoutLastPacketFromPostedTask) {
+  rtc::AutoThread main_thread;
+  std::vector<int> extension_ids;
+  EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::kSrtpAeadAes128Gcm, kTestKeyGcm128_1, kTestKeyGcm128Len,
+      extension_ids, rtc::kSrtpAeadAes128Gcm, kTestKeyGcm128_2,
+      kTestKeyGcm128Len, extension_ids));
+  EXPECT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::kSrtpAeadAes128Gcm, kTestKeyGcm128_2, kTestKeyGcm128Len,
+      extension_ids, rtc::kSrtpAeadAes128Gcm, kTestKeyGcm128_1,
+      kTestKeyGcm128Len, extension_ids));
+
+  size_t rtp_len = sizeof(kPcmuFrame);
+  size_t packet_size = rtp_len + rtc::rtp_auth_tag_len(rtc::kCsAeadAes128Gcm);
+  rtc::Buffer rtp_packet_buffer(packet_size);
+  uint8_t* rtp_packet_data = rtp_packet_buffer.data();
+  memcpy(rtp_packet_data, kPcmuFrame, rtp_len);
+  rtc::PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 2; ++i) {
+    rtc::SetBE16(rtp_packet_data + 2, ++sequence_number_);
+    rtc::CopyOnWriteBuffer packet(rtp_packet_data, rtp_len, packet_size);
+    EXPECT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                                cricket::PF_SRTP_BYPASS));
+  }
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 0);
+
+  // The packet marked `last_packet_in_batch` never comes.
+  main_thread.ProcessMessages(0);
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 2);
+}
+
 }  // namespace webrtc
@@ -318,6 +318,9 @@ class FakePeerConnectionBase : public PeerConnectionInternal {
   JsepTransportController* transport_controller_n() override { return nullptr; }
   DataChannelController* data_channel_controller() override { return nullptr; }
   cricket::PortAllocator* port_allocator() override { return nullptr; }
+  rtc::scoped_refptr<PendingTaskSafetyFlag> network_thread_safety() override {
+    return nullptr;
+  }
   LegacyStatsCollector* legacy_stats() override { return nullptr; }
   PeerConnectionObserver* Observer() const override { return nullptr; }
   absl::optional<rtc::SSLRole> GetSctpSslRole_n() override {
@@ -229,6 +229,10 @@ class MockPeerConnectionInternal : public PeerConnectionInternal {
   MOCK_METHOD(JsepTransportController*, transport_controller_n, (), (override));
   MOCK_METHOD(DataChannelController*, data_channel_controller, (), (override));
   MOCK_METHOD(cricket::PortAllocator*, port_allocator, (), (override));
+  MOCK_METHOD(rtc::scoped_refptr<PendingTaskSafetyFlag>,
+              network_thread_safety,
+              (),
+              (override));
   MOCK_METHOD(LegacyStatsCollector*, legacy_stats, (), (override));
   MOCK_METHOD(PeerConnectionObserver*, Observer, (), (const, override));
   MOCK_METHOD(absl::optional<rtc::SSLRole>, GetSctpSslRole_n, (), (override));
@@ -28,6 +28,7 @@
 #include "absl/algorithm/container.h"
 #include "absl/strings/ascii.h"
 #include "absl/strings/match.h"
+#include "absl/strings/str_cat.h"
 #include "api/candidate.h"
 #include "api/crypto_params.h"
 #include "api/jsep_ice_candidate.h"
@@ -545,7 +546,7 @@ static void InitLine(const char type,
                      absl::string_view value,
                      rtc::StringBuilder* os) {
   os->Clear();
-  *os << std::string(1, type) << kSdpDelimiterEqual << value;
+  *os << absl::string_view(&type, 1) << kSdpDelimiterEqual << value;
 }
 
 // Init `os` to "a=`attribute`".
@@ -619,17 +620,17 @@ static bool GetValue(absl::string_view message,
                      absl::string_view attribute,
                      std::string* value,
                      SdpParseError* error) {
-  std::string leftpart;
-  if (!rtc::tokenize_first(message, kSdpDelimiterColonChar, &leftpart, value)) {
+  absl::string_view leftpart;
+  absl::string_view rightpart;
+  if (!rtc::tokenize_first(message, kSdpDelimiterColonChar, &leftpart,
+                           &rightpart)) {
     return ParseFailedGetValue(message, attribute, error);
   }
   // The left part should end with the expected attribute.
-  if (leftpart.length() < attribute.length() ||
-      absl::string_view(leftpart).compare(
-          leftpart.length() - attribute.length(), attribute.length(),
-          attribute) != 0) {
+  if (!absl::EndsWith(leftpart, attribute)) {
     return ParseFailedGetValue(message, attribute, error);
   }
+  *value = std::string(rightpart);
   return true;
 }
 
@@ -1070,8 +1071,8 @@ bool ParseCandidate(absl::string_view message,
     first_line = first_line.substr(kLinePrefixLength);
   }
 
-  std::string attribute_candidate;
-  std::string candidate_value;
+  absl::string_view attribute_candidate;
+  absl::string_view candidate_value;
 
   // `first_line` must be in the form of "candidate:<value>".
   if (!rtc::tokenize_first(first_line, kSdpDelimiterColonChar,
@@ -2073,8 +2074,8 @@ bool ParseConnectionData(absl::string_view line,
                          rtc::SocketAddress* addr,
                          SdpParseError* error) {
   // Parse the line from left to right.
-  std::string token;
-  std::string rightpart;
+  absl::string_view token;
+  absl::string_view rightpart;
   // RFC 4566
   // c=<nettype> <addrtype> <connection-address>
   // Skip the "c="
@@ -3045,8 +3046,8 @@ bool ParseContent(absl::string_view message,
     // RFC 4566
     // b=* (zero or more bandwidth information lines)
     if (IsLineType(*line, kLineTypeSessionBandwidth)) {
-      std::string bandwidth;
-      std::string bandwidth_type;
+      absl::string_view bandwidth;
+      absl::string_view bandwidth_type;
       if (!rtc::tokenize_first(line->substr(kLinePrefixLength),
                                kSdpDelimiterColonChar, &bandwidth_type,
                                &bandwidth)) {
@@ -3076,7 +3077,9 @@ bool ParseContent(absl::string_view message,
       }
       if (b < 0) {
         return ParseFailed(
-            *line, "b=" + bandwidth_type + " value can't be negative.", error);
+            *line,
+            absl::StrCat("b=", bandwidth_type, " value can't be negative."),
+            error);
       }
       // Convert values. Prevent integer overflow.
       if (bandwidth_type == kApplicationSpecificBandwidth) {
@@ -3085,7 +3088,7 @@ bool ParseContent(absl::string_view message,
         b = std::min(b, INT_MAX);
       }
       media_desc->set_bandwidth(b);
-      media_desc->set_bandwidth_type(bandwidth_type);
+      media_desc->set_bandwidth_type(std::string(bandwidth_type));
       continue;
     }
 
@@ -3430,7 +3433,7 @@ bool ParseSsrcAttribute(absl::string_view line,
   // RFC 5576
   // a=ssrc:<ssrc-id> <attribute>
   // a=ssrc:<ssrc-id> <attribute>:<value>
-  std::string field1, field2;
+  absl::string_view field1, field2;
   if (!rtc::tokenize_first(line.substr(kLinePrefixLength),
                            kSdpDelimiterSpaceChar, &field1, &field2)) {
     const size_t expected_fields = 2;
@@ -3447,8 +3450,8 @@ bool ParseSsrcAttribute(absl::string_view line,
     return false;
   }
 
-  std::string attribute;
-  std::string value;
+  absl::string_view attribute;
+  absl::string_view value;
   if (!rtc::tokenize_first(field2, kSdpDelimiterColonChar, &attribute,
                            &value)) {
     rtc::StringBuilder description;
@@ -3475,7 +3478,7 @@ bool ParseSsrcAttribute(absl::string_view line,
   if (attribute == kSsrcAttributeCname) {
     // RFC 5576
     // cname:<value>
-    ssrc_info.cname = value;
+    ssrc_info.cname = std::string(value);
   } else if (attribute == kSsrcAttributeMsid) {
     // draft-alvestrand-mmusic-msid-00
     // msid:identifier [appdata]
@@ -3713,8 +3716,8 @@ bool ParseFmtpAttributes(absl::string_view line,
     return true;
   }
 
-  std::string line_payload;
-  std::string line_params;
+  absl::string_view line_payload;
+  absl::string_view line_params;
 
   // https://tools.ietf.org/html/rfc4566#section-6
   // a=fmtp:<format> <format specific parameters>
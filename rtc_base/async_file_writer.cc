@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/async_file_writer.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "api/sequence_checker.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+
+AsyncFileWriter::AsyncFileWriter(FileWrapper file,
+                                 TaskQueueBase* task_queue,
+                                 const Config& config)
+    : task_queue_(task_queue),
+      config_(config),
+      safety_(PendingTaskSafetyFlag::CreateAttachedToTaskQueue(
+          /*alive=*/true,
+          task_queue)),
+      file_(std::move(file)) {
+  RTC_DCHECK(task_queue_);
+  RTC_DCHECK_GT(config_.write_size, 0);
+  current_chunk_.reserve(config_.write_size);
+}
+
+AsyncFileWriter::AsyncFileWriter(FileWrapper file, TaskQueueBase* task_queue)
+    : AsyncFileWriter(std::move(file), task_queue, Config()) {}
+
+AsyncFileWriter::~AsyncFileWriter() {
+  RTC_DCHECK(!task_queue_->IsCurrent());
+  rtc::Event done;
+  task_queue_->PostTask([this, &done] {
+    RTC_DCHECK_RUN_ON(task_queue_);
+    WriteBufferedData(/*include_partial_chunk=*/true);
+    file_.Close();
+    safety_->SetNotAlive();
+    done.Set();
+  });
+  done.Wait(rtc::Event::kForever);
+}
+
+bool AsyncFileWriter::Write(
+    std::initializer_list<rtc::ArrayView<const uint8_t>> parts) {
+  size_t size = 0;
+  for (const auto& part : parts) {
+    size += part.size();
+  }
+
+  MutexLock lock(&lock_);
+  if (!file_size_limit_reached_ && config_.max_file_size_bytes >= 0 &&
+      accepted_bytes_ + static_cast<int64_t>(size) >
+          config_.max_file_size_bytes) {
+    RTC_LOG(LS_WARNING) << "File size limit of "
+                        << config_.max_file_size_bytes
+                        << " bytes reached, writing stops.";
+    file_size_limit_reached_ = true;
+  }
+  if (file_size_limit_reached_ ||
+      buffered_bytes_ + size > config_.max_buffered_bytes) {
+    ++dropped_records_;
+    dropped_bytes_ += size;
+    return false;
+  }
+  buffered_bytes_ += size;
+  accepted_bytes_ += size;
+
+  // Split the data at `write_size` boundaries, so that the file is written
+  // in blocks of that size.
+  bool chunk_completed = false;
+  for (rtc::ArrayView<const uint8_t> part : parts) {
+    while (!part.empty()) {
+      const size_t bytes = std::min(
+          part.size(), config_.write_size - current_chunk_.size());
+      current_chunk_.insert(current_chunk_.end(), part.begin(),
+                            part.begin() + bytes);
+      part = part.subview(bytes);
+      if (current_chunk_.size() == config_.write_size) {
+        full_chunks_.push_back(std::move(current_chunk_));
+        current_chunk_ = std::vector<uint8_t>();
+        current_chunk_.reserve(config_.write_size);
+        chunk_completed = true;
+      }
+    }
+  }
+
+  if (chunk_completed) {
+    task_queue_->PostTask(SafeTask(safety_, [this] {
+      RTC_DCHECK_RUN_ON(task_queue_);
+      WriteBufferedData(/*include_partial_chunk=*/false);
+    }));
+  }
+  if (!current_chunk_.empty() && !delayed_write_pending_) {
+    delayed_write_pending_ = true;
+    task_queue_->PostDelayedTask(
+        SafeTask(safety_,
+                 [this] {
+                   RTC_DCHECK_RUN_ON(task_queue_);
+                   {
+                     MutexLock lock(&lock_);
+                     delayed_write_pending_ = false;
+                   }
+                   WriteBufferedData(/*include_partial_chunk=*/true);
+                 }),
+        config_.max_write_delay);
+  }
+  return true;
+}
+
+void AsyncFileWriter::PostFileTask(
+    absl::AnyInvocable<void(FileWrapper&) &&> task) {
+  task_queue_->PostTask(
+      SafeTask(safety_, [this, task = std::move(task)]() mutable {
+        RTC_DCHECK_RUN_ON(task_queue_);
+        WriteBufferedData(/*include_partial_chunk=*/true);
+        std::move(task)(file_);
+      }));
+}
+
+int64_t AsyncFileWriter::dropped_records() const {
+  MutexLock lock(&lock_);
+  return dropped_records_;
+}
+
+int64_t AsyncFileWriter::dropped_bytes() const {
+  MutexLock lock(&lock_);
+  return dropped_bytes_;
+}
+
+void AsyncFileWriter::WriteBufferedData(bool include_partial_chunk) {
+  while (true) {
+    std::vector<uint8_t> chunk;
+    {
+      MutexLock lock(&lock_);
+      if (!full_chunks_.empty()) {
+        chunk = std::move(full_chunks_.front());
+        full_chunks_.pop_front();
+      } else if (include_partial_chunk && !current_chunk_.empty()) {
+        chunk = std::move(current_chunk_);
+        current_chunk_ = std::vector<uint8_t>();
+        current_chunk_.reserve(config_.write_size);
+      } else {
+        return;
+      }
+    }
+    if (file_.is_open() && !file_.Write(chunk.data(), chunk.size())) {
+      RTC_LOG(LS_ERROR) << "Failed to write " << chunk.size()
+                        << " bytes, closing the file.";
+      file_.Close();
+    }
+    MutexLock lock(&lock_);
+    buffered_bytes_ -= chunk.size();
+  }
+}
+
+}  // namespace webrtc
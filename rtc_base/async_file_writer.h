@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_ASYNC_FILE_WRITER_H_
+#define RTC_BASE_ASYNC_FILE_WRITER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <initializer_list>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "api/array_view.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Writes diagnostics, such as AEC dumps and IVF frame dumps, to a file
+// without blocking the thread producing them. Write() only copies the data
+// into a buffer; the buffer is written to the file on `task_queue` in writes
+// of `write_size` bytes, or when the oldest buffered data is
+// `max_write_delay` old.
+//
+// The memory used is bounded: a record that would take the buffered data
+// above `max_buffered_bytes`, for example because the disk can't keep up, is
+// dropped and counted rather than delaying the caller. Records are written
+// or dropped as a whole.
+class AsyncFileWriter {
+ public:
+  struct Config {
+    size_t write_size = 256 * 1024;
+    size_t max_buffered_bytes = 8 * 1024 * 1024;
+    TimeDelta max_write_delay = TimeDelta::Seconds(1);
+    // Once a record would take the file above this size, it and all later
+    // records are dropped. -1 means no limit.
+    int64_t max_file_size_bytes = -1;
+  };
+
+  // `task_queue` must outlive the AsyncFileWriter.
+  AsyncFileWriter(FileWrapper file,
+                  TaskQueueBase* task_queue,
+                  const Config& config);
+  AsyncFileWriter(FileWrapper file, TaskQueueBase* task_queue);
+  // Blocks until the buffered data has been written, and closes the file.
+  // Must not be called on `task_queue`.
+  ~AsyncFileWriter();
+
+  AsyncFileWriter(const AsyncFileWriter&) = delete;
+  AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+  // Appends the concatenation of `parts` to the file as one record. Returns
+  // false if the record was dropped. May be called on any thread.
+  bool Write(std::initializer_list<rtc::ArrayView<const uint8_t>> parts);
+  bool Write(rtc::ArrayView<const uint8_t> data) { return Write({data}); }
+
+  // Runs `task` on `task_queue` once the data of all earlier Write() calls
+  // has been written, for random access such as rewriting a header.
+  void PostFileTask(absl::AnyInvocable<void(FileWrapper&) &&> task);
+
+  int64_t dropped_records() const;
+  int64_t dropped_bytes() const;
+
+ private:
+  // Writes the buffered data up to the last complete `write_size` chunk, or
+  // all of it if `include_partial_chunk`.
+  void WriteBufferedData(bool include_partial_chunk);
+
+  TaskQueueBase* const task_queue_;
+  const Config config_;
+  const rtc::scoped_refptr<PendingTaskSafetyFlag> safety_;
+  FileWrapper file_ RTC_GUARDED_BY(task_queue_);
+
+  mutable Mutex lock_;
+  std::deque<std::vector<uint8_t>> full_chunks_ RTC_GUARDED_BY(lock_);
+  std::vector<uint8_t> current_chunk_ RTC_GUARDED_BY(lock_);
+  // Includes the chunk being written to the file.
+  size_t buffered_bytes_ RTC_GUARDED_BY(lock_) = 0;
+  int64_t accepted_bytes_ RTC_GUARDED_BY(lock_) = 0;
+  bool file_size_limit_reached_ RTC_GUARDED_BY(lock_) = false;
+  bool delayed_write_pending_ RTC_GUARDED_BY(lock_) = false;
+  int64_t dropped_records_ RTC_GUARDED_BY(lock_) = 0;
+  int64_t dropped_bytes_ RTC_GUARDED_BY(lock_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_ASYNC_FILE_WRITER_H_
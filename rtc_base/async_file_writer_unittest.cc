@@ -0,0 +1,148 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/async_file_writer.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rtc_base/event.h"
+#include "rtc_base/task_queue_for_test.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+class AsyncFileWriterTest : public ::testing::Test {
+ protected:
+  AsyncFileWriterTest()
+      : filename_(test::TempFilename(test::OutputPath(), "async_file_writer")) {
+  }
+  ~AsyncFileWriterTest() override { test::RemoveFile(filename_); }
+
+  std::unique_ptr<AsyncFileWriter> CreateWriter(
+      const AsyncFileWriter::Config& config) {
+    return std::make_unique<AsyncFileWriter>(
+        FileWrapper::OpenWriteOnly(filename_), queue_.Get(), config);
+  }
+
+  std::vector<uint8_t> ReadFile() {
+    FileWrapper file = FileWrapper::OpenReadOnly(filename_);
+    std::vector<uint8_t> contents(1024);
+    contents.resize(file.Read(contents.data(), contents.size()));
+    return contents;
+  }
+
+  // Keeps `queue_` busy until the returned event is set.
+  std::unique_ptr<rtc::Event> BlockQueue() {
+    auto event = std::make_unique<rtc::Event>();
+    queue_.PostTask(
+        [event = event.get()] { event->Wait(rtc::Event::kForever); });
+    return event;
+  }
+
+  const std::string filename_;
+  TaskQueueForTest queue_;
+};
+
+TEST_F(AsyncFileWriterTest, WritesRecordsInOrder) {
+  AsyncFileWriter::Config config;
+  config.write_size = 4;
+  std::unique_ptr<AsyncFileWriter> writer = CreateWriter(config);
+  const uint8_t kFirst[] = {1, 2, 3};
+  const uint8_t kSecond[] = {4, 5, 6, 7, 8, 9};
+  const uint8_t kThird[] = {10};
+  EXPECT_TRUE(writer->Write(kFirst));
+  EXPECT_TRUE(writer->Write({kSecond, kThird}));
+  writer = nullptr;
+  EXPECT_THAT(ReadFile(), ElementsAre(1, 2, 3, 4, 5, 6, 7, 8, 9, 10));
+}
+
+TEST_F(AsyncFileWriterTest, WritesPartialChunkAfterDelay) {
+  AsyncFileWriter::Config config;
+  config.max_write_delay = TimeDelta::Millis(1);
+  std::unique_ptr<AsyncFileWriter> writer = CreateWriter(config);
+  const uint8_t kData[] = {1, 2, 3};
+  EXPECT_TRUE(writer->Write(kData));
+
+  rtc::Event delay_passed;
+  queue_.PostDelayedTask([&delay_passed] { delay_passed.Set(); },
+                         TimeDelta::Millis(50));
+  delay_passed.Wait(rtc::Event::kForever);
+  // Flush the stdio buffer of the file on the writer's queue.
+  writer->PostFileTask([](FileWrapper& file) { file.Flush(); });
+  queue_.WaitForPreviouslyPostedTasks();
+  EXPECT_THAT(ReadFile(), ElementsAre(1, 2, 3));
+}
+
+TEST_F(AsyncFileWriterTest, DropsRecordsOverMemoryBudget) {
+  AsyncFileWriter::Config config;
+  config.write_size = 2;
+  config.max_buffered_bytes = 5;
+  std::unique_ptr<AsyncFileWriter> writer = CreateWriter(config);
+  const uint8_t kFirst[] = {1, 2, 3};
+  const uint8_t kSecond[] = {4, 5, 6};
+  const uint8_t kThird[] = {7, 8};
+
+  std::unique_ptr<rtc::Event> unblock = BlockQueue();
+  EXPECT_TRUE(writer->Write(kFirst));
+  EXPECT_FALSE(writer->Write(kSecond));
+  EXPECT_TRUE(writer->Write(kThird));
+  EXPECT_EQ(writer->dropped_records(), 1);
+  EXPECT_EQ(writer->dropped_bytes(), 3);
+  unblock->Set();
+  queue_.WaitForPreviouslyPostedTasks();
+
+  // The budget is available again once the data has been written.
+  EXPECT_TRUE(writer->Write(kSecond));
+  writer = nullptr;
+  EXPECT_THAT(ReadFile(), ElementsAre(1, 2, 3, 7, 8, 4, 5, 6));
+}
+
+TEST_F(AsyncFileWriterTest, StopsAtFileSizeLimit) {
+  AsyncFileWriter::Config config;
+  config.max_file_size_bytes = 6;
+  std::unique_ptr<AsyncFileWriter> writer = CreateWriter(config);
+  const uint8_t kFirst[] = {1, 2, 3, 4};
+  const uint8_t kSecond[] = {5, 6, 7};
+  const uint8_t kThird[] = {8};
+  EXPECT_TRUE(writer->Write(kFirst));
+  EXPECT_FALSE(writer->Write(kSecond));
+  // Even though it would fit.
+  EXPECT_FALSE(writer->Write(kThird));
+  writer = nullptr;
+  EXPECT_THAT(ReadFile(), ElementsAre(1, 2, 3, 4));
+}
+
+TEST_F(AsyncFileWriterTest, FileTaskRunsAfterEarlierWrites) {
+  std::unique_ptr<AsyncFileWriter> writer =
+      CreateWriter(AsyncFileWriter::Config());
+  const uint8_t kData[] = {1, 2, 3, 4};
+  EXPECT_TRUE(writer->Write(kData));
+  writer->PostFileTask([](FileWrapper& file) {
+    const uint8_t kHeader[] = {9, 9};
+    ASSERT_TRUE(file.Rewind());
+    ASSERT_TRUE(file.Write(kHeader, sizeof(kHeader)));
+  });
+  writer = nullptr;
+  std::vector<uint8_t> expected = {9, 9, 3, 4};
+  EXPECT_THAT(ReadFile(), ElementsAreArray(expected));
+}
+
+}  // namespace
+}  // namespace webrtc
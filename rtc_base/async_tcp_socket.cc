@@ -185,6 +185,14 @@ void AsyncTCPSocketBase::OnReadEvent(Socket* socket) {
   size_t total_recv = 0;
   while (true) {
     size_t free_size = inbuf_.capacity() - inbuf_.size();
+    if (free_size < kMinimumRecvSize && inbuf_start_ > 0) {
+      // Move the unprocessed bytes to the front to make room at the back.
+      size_t bytes_remaining = inbuf_.size() - inbuf_start_;
+      memmove(inbuf_.data(), inbuf_.data() + inbuf_start_, bytes_remaining);
+      inbuf_.SetSize(bytes_remaining);
+      inbuf_start_ = 0;
+      free_size = inbuf_.capacity() - inbuf_.size();
+    }
     if (free_size < kMinimumRecvSize && inbuf_.capacity() < max_insize_) {
       inbuf_.EnsureCapacity(std::min(max_insize_, inbuf_.capacity() * 2));
       free_size = inbuf_.capacity() - inbuf_.size();
@@ -211,17 +219,22 @@ void AsyncTCPSocketBase::OnReadEvent(Socket* socket) {
     return;
   }
 
-  size_t processed = ProcessInput(inbuf_);
-  size_t bytes_remaining = inbuf_.size() - processed;
-  if (processed > inbuf_.size()) {
+  // Packets are processed in place. The bytes of an incomplete packet are left
+  // where they are, and only moved when the buffer runs out of space, so that
+  // a burst of small reads doesn't move the same bytes over and over.
+  rtc::ArrayView<const uint8_t> input =
+      rtc::ArrayView<const uint8_t>(inbuf_).subview(inbuf_start_);
+  size_t processed = ProcessInput(input);
+  if (processed > input.size()) {
     RTC_LOG(LS_ERROR) << "input buffer overflow";
     RTC_DCHECK_NOTREACHED();
     inbuf_.Clear();
+    inbuf_start_ = 0;
+  } else if (processed == input.size()) {
+    inbuf_.Clear();
+    inbuf_start_ = 0;
   } else {
-    if (bytes_remaining > 0) {
-      memmove(inbuf_.data(), inbuf_.data() + processed, bytes_remaining);
-    }
-    inbuf_.SetSize(bytes_remaining);
+    inbuf_start_ += processed;
   }
 }
 
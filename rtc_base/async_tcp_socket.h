@@ -80,6 +80,8 @@ class AsyncTCPSocketBase : public AsyncPacketSocket {
 
   std::unique_ptr<Socket> socket_;
   Buffer inbuf_;
+  // Offset of the first byte in `inbuf_` that has not been processed yet.
+  size_t inbuf_start_ = 0;
   Buffer outbuf_;
   size_t max_insize_;
   size_t max_outsize_;
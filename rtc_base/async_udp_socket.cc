@@ -10,21 +10,38 @@
 
 #include "rtc_base/async_udp_socket.h"
 
+#include <algorithm>
+#include <utility>
 
+#include "api/array_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/timestamp.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/network/received_packet.h"
 #include "rtc_base/network/sent_packet.h"
 #include "rtc_base/time_utils.h"
 #include "system_wrappers/include/field_trial.h"
 
 namespace rtc {
 
+// Upper bound on the number of packets held back while waiting for the end of
+// a batch.
+constexpr size_t kMaxPendingBatchSize = 64;
+
 // Returns true if the experiement "WebRTC-SCM-Timestamp" is explicitly
 // disabled.
 static bool IsScmTimeStampExperimentDisabled() {
   return webrtc::field_trial::IsDisabled("WebRTC-SCM-Timestamp");
 }
 
+// Stamps `sent_packet` with the time the socket call returned, which is as
+// close to the kernel's transmit time as we get without TX timestamping.
+static void SetSendTime(int64_t send_time_us, SentPacket* sent_packet) {
+  sent_packet->send_time_us = send_time_us;
+  sent_packet->send_time_ms = send_time_us / 1000;
+}
+
 AsyncUDPSocket* AsyncUDPSocket::Create(Socket* socket,
                                        const SocketAddress& bind_address) {
   std::unique_ptr<Socket> owned_socket(socket);
@@ -45,11 +62,29 @@ AsyncUDPSocket* AsyncUDPSocket::Create(SocketFactory* factory,
 
 AsyncUDPSocket::AsyncUDPSocket(Socket* socket) : socket_(socket) {
   sequence_checker_.Detach();
+  send_sequence_checker_.Detach();
   // The socket should start out readable but not writable.
   socket_->SignalReadEvent.connect(this, &AsyncUDPSocket::OnReadEvent);
   socket_->SignalWriteEvent.connect(this, &AsyncUDPSocket::OnWriteEvent);
 }
 
+void AsyncUDPSocket::EnableBatchedReceive(size_t max_packets,
+                                          size_t max_packet_size) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  batch_slots_.clear();
+  batch_buffer_.clear();
+  if (max_packets <= 1) {
+    return;
+  }
+  RTC_DCHECK_GT(max_packet_size, 0);
+  batch_buffer_.resize(max_packets * max_packet_size);
+  batch_slots_.resize(max_packets);
+  for (size_t i = 0; i < max_packets; ++i) {
+    batch_slots_[i].data = &batch_buffer_[i * max_packet_size];
+    batch_slots_[i].capacity = max_packet_size;
+  }
+}
+
 SocketAddress AsyncUDPSocket::GetLocalAddress() const {
   return socket_->GetLocalAddress();
 }
@@ -61,10 +96,13 @@ SocketAddress AsyncUDPSocket::GetRemoteAddress() const {
 int AsyncUDPSocket::Send(const void* pv,
                          size_t cb,
                          const rtc::PacketOptions& options) {
+  RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+  FlushPendingBatch();
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, false, &sent_packet.info);
   int ret = socket_->Send(pv, cb);
+  SetSendTime(rtc::TimeMicros(), &sent_packet);
   SignalSentPacket(this, sent_packet);
   return ret;
 }
@@ -73,15 +111,75 @@ int AsyncUDPSocket::SendTo(const void* pv,
                            size_t cb,
                            const SocketAddress& addr,
                            const rtc::PacketOptions& options) {
+  RTC_DCHECK_RUN_ON(&send_sequence_checker_);
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, true, &sent_packet.info);
+  if (options.batchable) {
+    pending_batch_.push_back(
+        {.payload = Buffer(static_cast<const uint8_t*>(pv), cb),
+         .destination = addr,
+         .sent_packet = sent_packet});
+    if (!options.last_packet_in_batch &&
+        pending_batch_.size() < kMaxPendingBatchSize) {
+      if (pending_batch_.size() == 1) {
+        PostFlushPendingBatch();
+      }
+      return static_cast<int>(cb);
+    }
+    return FlushPendingBatch() ? static_cast<int>(cb) : -1;
+  }
+  // Keep packets in order with respect to an unfinished batch.
+  FlushPendingBatch();
   int ret = socket_->SendTo(pv, cb, addr);
+  SetSendTime(rtc::TimeMicros(), &sent_packet);
   SignalSentPacket(this, sent_packet);
   return ret;
 }
 
+void AsyncUDPSocket::PostFlushPendingBatch() {
+  webrtc::TaskQueueBase* task_queue = webrtc::TaskQueueBase::Current();
+  if (!task_queue) {
+    // Without a task queue the batch waits for its last packet.
+    return;
+  }
+  task_queue->PostTask(
+      webrtc::SafeTask(safety_.flag(), [this, batch_id = pending_batch_id_] {
+        RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+        if (batch_id == pending_batch_id_) {
+          FlushPendingBatch();
+        }
+      }));
+}
+
+bool AsyncUDPSocket::FlushPendingBatch() {
+  if (pending_batch_.empty()) {
+    return true;
+  }
+  ++pending_batch_id_;
+  std::vector<Socket::SendSlot> slots;
+  slots.reserve(pending_batch_.size());
+  for (const PendingPacket& packet : pending_batch_) {
+    slots.push_back({.data = packet.payload.data(),
+                     .size = packet.payload.size(),
+                     .destination = packet.destination});
+  }
+  int sent = socket_->SendToBatch(slots);
+  // Like for single packets, the sent packet is signaled whether or not the
+  // socket accepted it, with the time it was actually handed to the socket.
+  int64_t send_time_us = rtc::TimeMicros();
+  std::vector<PendingPacket> batch = std::move(pending_batch_);
+  pending_batch_.clear();
+  for (PendingPacket& packet : batch) {
+    SetSendTime(send_time_us, &packet.sent_packet);
+    SignalSentPacket(this, packet.sent_packet);
+  }
+  return sent == static_cast<int>(batch.size());
+}
+
 int AsyncUDPSocket::Close() {
+  RTC_DCHECK_RUN_ON(&send_sequence_checker_);
+  FlushPendingBatch();
   return socket_->Close();
 }
 
@@ -94,7 +192,12 @@ int AsyncUDPSocket::GetOption(Socket::Option opt, int* value) {
 }
 
 int AsyncUDPSocket::SetOption(Socket::Option opt, int value) {
-  return socket_->SetOption(opt, value);
+  int result = socket_->SetOption(opt, value);
+  if (result == 0 && opt == Socket::OPT_RECV_ECN) {
+    RTC_DCHECK_RUN_ON(&sequence_checker_);
+    receive_ecn_ = value != 0;
+  }
+  return result;
 }
 
 int AsyncUDPSocket::GetError() const {
@@ -109,6 +212,18 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
   RTC_DCHECK(socket_.get() == socket);
   RTC_DCHECK_RUN_ON(&sequence_checker_);
 
+  if (!batch_slots_.empty()) {
+    ReadBatch(batch_slots_);
+    return;
+  }
+  if (receive_ecn_) {
+    Socket::ReceiveSlot slot;
+    slot.data = buf_;
+    slot.capacity = BUF_SIZE;
+    ReadBatch(rtc::ArrayView<Socket::ReceiveSlot>(&slot, 1));
+    return;
+  }
+
   SocketAddress remote_addr;
   int64_t timestamp = -1;
   int len = socket_->RecvFrom(buf_, BUF_SIZE, &remote_addr, &timestamp);
@@ -123,21 +238,82 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
                      << "] receive failed with error " << socket_->GetError();
     return;
   }
-  if (timestamp == -1) {
-    // Timestamp from socket is not available.
-    timestamp = TimeMicros();
-  } else {
-    if (!socket_time_offset_) {
-      socket_time_offset_ =
-          !IsScmTimeStampExperimentDisabled() ? TimeMicros() - timestamp : 0;
-    }
-    timestamp += *socket_time_offset_;
-  }
 
   // TODO: Make sure that we got all of the packet.
   // If we did not, then we should resize our buffer to be large enough.
-  NotifyPacketReceived(
-      rtc::ReceivedPacket::CreateFromLegacy(buf_, len, timestamp, remote_addr));
+  NotifyPacketReceived(rtc::ReceivedPacket::CreateFromLegacy(
+      buf_, len, ToRtcTimeMicros(timestamp), remote_addr));
+}
+
+void AsyncUDPSocket::ReadBatch(rtc::ArrayView<Socket::ReceiveSlot> slots) {
+  int count = socket_->RecvFromBatch(slots);
+  if (count < 0) {
+    SocketAddress local_addr = socket_->GetLocalAddress();
+    RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                     << "] batched receive failed with error "
+                     << socket_->GetError();
+    return;
+  }
+  // Stamp datagrams without a socket timestamp once for the whole batch,
+  // they were all pending when the read event fired.
+  int64_t now = -1;
+  for (int i = 0; i < count; ++i) {
+    const Socket::ReceiveSlot& slot = slots[i];
+    if (slot.truncated) {
+      RTC_LOG(LS_WARNING) << "Dropping datagram larger than "
+                          << slot.capacity << " bytes.";
+      continue;
+    }
+    int64_t timestamp;
+    if (slot.timestamp == -1) {
+      if (now == -1) {
+        now = TimeMicros();
+      }
+      timestamp = now;
+    } else {
+      timestamp = ToRtcTimeMicros(slot.timestamp);
+    }
+    const uint8_t* data = static_cast<const uint8_t*>(slot.data);
+    if (slot.segment_size == 0 || slot.segment_size >= slot.size) {
+      NotifyPacketReceived(rtc::ReceivedPacket(
+          rtc::MakeArrayView(data, slot.size), slot.source_address,
+          webrtc::Timestamp::Micros(timestamp), slot.ecn));
+      continue;
+    }
+    // Split datagrams coalesced by UDP GRO. Every segment but the last one
+    // is exactly `segment_size` bytes.
+    for (size_t offset = 0; offset < slot.size;
+         offset += slot.segment_size) {
+      size_t size = std::min(slot.segment_size, slot.size - offset);
+      NotifyPacketReceived(rtc::ReceivedPacket(
+          rtc::MakeArrayView(data + offset, size), slot.source_address,
+          webrtc::Timestamp::Micros(timestamp), slot.ecn));
+    }
+  }
+}
+
+bool AsyncUDPSocket::EnableGroReceive(size_t max_packets) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  if (socket_->SetOption(Socket::OPT_UDP_GRO, 1) != 0) {
+    return false;
+  }
+  // A coalesced read may hold up to a full IP datagram worth of segments.
+  size_t buffers = std::clamp<size_t>(max_packets, 2, kMaxGroReceiveBuffers);
+  EnableBatchedReceive(buffers, BUF_SIZE);
+  return true;
+}
+
+int64_t AsyncUDPSocket::ToRtcTimeMicros(int64_t socket_timestamp) {
+  if (socket_timestamp == -1) {
+    // Timestamp from socket is not available.
+    return TimeMicros();
+  }
+  if (!socket_time_offset_) {
+    socket_time_offset_ = !IsScmTimeStampExperimentDisabled()
+                              ? TimeMicros() - socket_timestamp
+                              : 0;
+  }
+  return socket_timestamp + *socket_time_offset_;
 }
 
 void AsyncUDPSocket::OnWriteEvent(Socket* socket) {
@@ -15,10 +15,14 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/network/sent_packet.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/socket_factory.h"
@@ -28,7 +32,11 @@
 namespace rtc {
 
 // Provides the ability to receive packets asynchronously.  Sends are not
-// buffered since it is acceptable to drop packets under high load.
+// buffered since it is acceptable to drop packets under high load, with the
+// exception of packets marked as `PacketOptions::batchable`: those are held
+// until the packet marked `last_packet_in_batch` is sent and then handed to
+// the socket together, see Socket::SendToBatch(). A batch whose last packet
+// never arrives is sent by a task posted to the sending task queue.
 class AsyncUDPSocket : public AsyncPacketSocket {
  public:
   // Binds `socket` and creates AsyncUDPSocket for it. Takes ownership
@@ -43,6 +51,24 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   explicit AsyncUDPSocket(Socket* socket);
   ~AsyncUDPSocket() = default;
 
+  // Reads up to `max_packets` datagrams per read event using
+  // Socket::RecvFromBatch(), which lets the socket drain its receive queue
+  // with a single system call where supported. Datagrams larger than
+  // `max_packet_size` bytes are dropped in this mode. A `max_packets` of 0 or
+  // 1 restores reading one datagram at a time.
+  void EnableBatchedReceive(size_t max_packets, size_t max_packet_size);
+  // Asks the kernel to coalesce consecutive datagrams from the same source
+  // (UDP GRO) and enables batched receive with buffers large enough to hold
+  // them. Coalesced datagrams are split and delivered one by one. Returns
+  // false, leaving the receive mode unchanged, if the socket does not
+  // support GRO.
+  // Every buffer must fit a coalesced read of up to 64 KB, so `max_packets`
+  // is capped at kMaxGroReceiveBuffers and this costs up to 256 KB per
+  // socket. A single coalesced read already holds dozens of MTU sized
+  // datagrams, so the cap does not limit the datagrams read per event much.
+  bool EnableGroReceive(size_t max_packets);
+  static constexpr size_t kMaxGroReceiveBuffers = 4;
+
   SocketAddress GetLocalAddress() const override;
   SocketAddress GetRemoteAddress() const override;
   int Send(const void* pv,
@@ -65,12 +91,46 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   void OnReadEvent(Socket* socket);
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(Socket* socket);
+  // Drains up to `slots.size()` datagrams with one call to
+  // Socket::RecvFromBatch().
+  void ReadBatch(rtc::ArrayView<Socket::ReceiveSlot> slots)
+      RTC_RUN_ON(sequence_checker_);
+  // Sends all packets queued as part of a batch. Returns false if any of
+  // them could not be sent.
+  bool FlushPendingBatch() RTC_RUN_ON(send_sequence_checker_);
+  // Posts a task that sends the pending batch, so that it is not held back
+  // if the packet that ends it is dropped before it reaches this socket.
+  void PostFlushPendingBatch() RTC_RUN_ON(send_sequence_checker_);
+  // Translates a socket timestamp (or -1) to the rtc::TimeMicros() epoch.
+  int64_t ToRtcTimeMicros(int64_t socket_timestamp)
+      RTC_RUN_ON(sequence_checker_);
 
   RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker sequence_checker_;
+  // Sends may happen on another sequence than reads.
+  RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker send_sequence_checker_;
   std::unique_ptr<Socket> socket_;
   static constexpr int BUF_SIZE = 64 * 1024;
   char buf_[BUF_SIZE] RTC_GUARDED_BY(sequence_checker_);
   absl::optional<int64_t> socket_time_offset_ RTC_GUARDED_BY(sequence_checker_);
+  // Storage for batched receive. Empty when datagrams are read one at a time.
+  std::vector<char> batch_buffer_ RTC_GUARDED_BY(sequence_checker_);
+  std::vector<Socket::ReceiveSlot> batch_slots_
+      RTC_GUARDED_BY(sequence_checker_);
+  // Whether Socket::OPT_RECV_ECN is enabled. Only RecvFromBatch() reports the
+  // codepoint, so datagrams read one at a time then use it too.
+  bool receive_ecn_ RTC_GUARDED_BY(sequence_checker_) = false;
+
+  struct PendingPacket {
+    Buffer payload;
+    SocketAddress destination;
+    SentPacket sent_packet;
+  };
+  std::vector<PendingPacket> pending_batch_
+      RTC_GUARDED_BY(send_sequence_checker_);
+  // Incremented for every batch, so that a posted flush only sends the batch
+  // it was posted for.
+  uint64_t pending_batch_id_ RTC_GUARDED_BY(send_sequence_checker_) = 0;
+  webrtc::ScopedTaskSafetyDetached safety_;
 };
 
 }  // namespace rtc
@@ -12,9 +12,13 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rtc_base/gunit.h"
+#include "rtc_base/ip_address.h"
 #include "rtc_base/physical_socket_server.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/virtual_socket_server.h"
 
 namespace rtc {
@@ -22,9 +26,8 @@ namespace rtc {
 class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
  public:
   AsyncUdpSocketTest()
-      : pss_(new rtc::PhysicalSocketServer),
-        vss_(new rtc::VirtualSocketServer(pss_.get())),
-        socket_(vss_->CreateSocket(SOCK_DGRAM)),
+      : vss_(new rtc::VirtualSocketServer()),
+        socket_(vss_->CreateSocket(AF_INET, SOCK_DGRAM)),
         udp_socket_(new AsyncUDPSocket(socket_)),
         ready_to_send_(false) {
     udp_socket_->SignalReadyToSend.connect(this,
@@ -34,7 +37,6 @@ class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
   void OnReadyToSend(rtc::AsyncPacketSocket* socket) { ready_to_send_ = true; }
 
  protected:
-  std::unique_ptr<PhysicalSocketServer> pss_;
   std::unique_ptr<VirtualSocketServer> vss_;
   Socket* socket_;
   std::unique_ptr<AsyncUDPSocket> udp_socket_;
@@ -47,4 +49,272 @@ TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+TEST(AsyncUdpSocketBatchedReceiveTest, DeliversAllPendingPacketsOnReadEvent) {
+  PhysicalSocketServer pss;
+  Socket* socket = pss.CreateSocket(AF_INET, SOCK_DGRAM);
+  ASSERT_TRUE(socket);
+  std::unique_ptr<AsyncUDPSocket> udp_socket(
+      AsyncUDPSocket::Create(socket, SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  ASSERT_TRUE(udp_socket);
+  udp_socket->EnableBatchedReceive(/*max_packets=*/8, /*max_packet_size=*/1500);
+  std::vector<std::string> received;
+  udp_socket->RegisterReceivedPacketCallback(
+      [&](AsyncPacketSocket*, const ReceivedPacket& packet) {
+        received.emplace_back(packet.payload().begin(),
+                              packet.payload().end());
+        EXPECT_TRUE(packet.arrival_time().has_value());
+      });
+
+  std::unique_ptr<Socket> sender(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  for (const char* payload : {"one", "two", "three"}) {
+    ASSERT_GT(sender->SendTo(payload, strlen(payload),
+                             udp_socket->GetLocalAddress()),
+              0);
+  }
+
+  socket->SignalReadEvent(socket);
+#if defined(WEBRTC_LINUX)
+  EXPECT_EQ(received, std::vector<std::string>({"one", "two", "three"}));
+#else
+  EXPECT_EQ(received, std::vector<std::string>({"one"}));
+#endif
+}
+
+#if defined(WEBRTC_LINUX)
+TEST(AsyncUdpSocketGroReceiveTest, SplitsCoalescedDatagrams) {
+  PhysicalSocketServer pss;
+  Socket* socket = pss.CreateSocket(AF_INET, SOCK_DGRAM);
+  ASSERT_TRUE(socket);
+  std::unique_ptr<AsyncUDPSocket> udp_socket(AsyncUDPSocket::Create(
+      socket, SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  ASSERT_TRUE(udp_socket);
+  if (!udp_socket->EnableGroReceive(/*max_packets=*/8)) {
+    GTEST_SKIP() << "UDP GRO is not supported by this kernel.";
+  }
+  std::vector<std::string> received;
+  udp_socket->RegisterReceivedPacketCallback(
+      [&](AsyncPacketSocket*, const ReceivedPacket& packet) {
+        received.emplace_back(packet.payload().begin(),
+                              packet.payload().end());
+      });
+
+  // Equal sized datagrams sent in one batch leave the sender as a single GSO
+  // buffer, which loopback hands to a GRO socket without splitting it.
+  const std::vector<std::string> payloads = {"aaaa", "bbbb", "cccc", "dd"};
+  std::vector<Socket::SendSlot> slots;
+  for (const std::string& payload : payloads) {
+    slots.push_back(
+        {payload.data(), payload.size(), udp_socket->GetLocalAddress()});
+  }
+  std::unique_ptr<Socket> sender(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  ASSERT_EQ(4, sender->SendToBatch(slots));
+
+  socket->SignalReadEvent(socket);
+  EXPECT_EQ(received, payloads);
+}
+
+// Sends two ECT(1) marked datagrams to a socket with ECN reception enabled
+// that reads `max_packets` datagrams per read event, and returns the
+// markings of the received packets.
+static std::vector<EcnMarking> ReceiveEct1MarkedDatagrams(size_t max_packets) {
+  PhysicalSocketServer pss;
+  Socket* socket = pss.CreateSocket(AF_INET, SOCK_DGRAM);
+  std::unique_ptr<AsyncUDPSocket> udp_socket(AsyncUDPSocket::Create(
+      socket, SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  udp_socket->EnableBatchedReceive(max_packets, /*max_packet_size=*/1500);
+  EXPECT_EQ(0, udp_socket->SetOption(Socket::OPT_RECV_ECN, 1));
+  std::vector<EcnMarking> received;
+  udp_socket->RegisterReceivedPacketCallback(
+      [&](AsyncPacketSocket*, const ReceivedPacket& packet) {
+        received.push_back(packet.ecn());
+      });
+
+  std::unique_ptr<Socket> sender(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  EXPECT_EQ(0, sender->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  EXPECT_EQ(0, sender->SetOption(Socket::OPT_SEND_ECN,
+                                 static_cast<int>(EcnMarking::kEct1)));
+  for (const char* payload : {"one", "two"}) {
+    EXPECT_GT(sender->SendTo(payload, strlen(payload),
+                             udp_socket->GetLocalAddress()),
+              0);
+  }
+  while (received.size() < 2) {
+    size_t previous_size = received.size();
+    socket->SignalReadEvent(socket);
+    if (received.size() == previous_size) {
+      break;
+    }
+  }
+  return received;
+}
+
+TEST(AsyncUdpSocketEcnTest, ReportsEcnMarkingOfDatagramsReadOneAtATime) {
+  EXPECT_EQ(ReceiveEct1MarkedDatagrams(/*max_packets=*/1),
+            std::vector<EcnMarking>({EcnMarking::kEct1, EcnMarking::kEct1}));
+}
+
+TEST(AsyncUdpSocketEcnTest, ReportsEcnMarkingOfBatchedDatagrams) {
+  EXPECT_EQ(ReceiveEct1MarkedDatagrams(/*max_packets=*/8),
+            std::vector<EcnMarking>({EcnMarking::kEct1, EcnMarking::kEct1}));
+}
+#endif  // WEBRTC_LINUX
+
+class SentPacketRecorder : public sigslot::has_slots<> {
+ public:
+  void OnSentPacket(AsyncPacketSocket*, const SentPacket& sent_packet) {
+    packet_ids.push_back(sent_packet.packet_id);
+    send_times_us.push_back(sent_packet.send_time_us);
+  }
+
+  std::vector<int64_t> packet_ids;
+  std::vector<int64_t> send_times_us;
+};
+
+TEST(AsyncUdpSocketSendTest, StampsSentPacketAfterSend) {
+  PhysicalSocketServer pss;
+  std::unique_ptr<AsyncUDPSocket> sender(AsyncUDPSocket::Create(
+      &pss, SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  std::unique_ptr<Socket> receiver(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_TRUE(sender);
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  SentPacketRecorder recorder;
+  sender->SignalSentPacket.connect(&recorder,
+                                   &SentPacketRecorder::OnSentPacket);
+
+  PacketOptions options;
+  options.packet_id = 7;
+  const int64_t before_us = TimeMicros();
+  EXPECT_EQ(4,
+            sender->SendTo("data", 4, receiver->GetLocalAddress(), options));
+  const int64_t after_us = TimeMicros();
+
+  ASSERT_EQ(recorder.send_times_us.size(), 1u);
+  EXPECT_GE(recorder.send_times_us[0], before_us);
+  EXPECT_LE(recorder.send_times_us[0], after_us);
+}
+
+TEST(AsyncUdpSocketBatchedSendTest, HoldsBatchablePacketsUntilLastInBatch) {
+  PhysicalSocketServer pss;
+  std::unique_ptr<AsyncUDPSocket> sender(AsyncUDPSocket::Create(
+      &pss, SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  std::unique_ptr<Socket> receiver(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_TRUE(sender);
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  SentPacketRecorder recorder;
+  sender->SignalSentPacket.connect(&recorder,
+                                   &SentPacketRecorder::OnSentPacket);
+
+  PacketOptions options;
+  options.batchable = true;
+  char buffer[16];
+  SocketAddress source;
+  int64_t timestamp;
+  for (int i = 0; i < 2; ++i) {
+    options.packet_id = i;
+    EXPECT_EQ(4, sender->SendTo("data", 4, receiver->GetLocalAddress(),
+                                options));
+  }
+  EXPECT_TRUE(recorder.packet_ids.empty());
+  EXPECT_LT(receiver->RecvFrom(buffer, sizeof(buffer), &source, &timestamp),
+            0);
+
+  options.packet_id = 2;
+  options.last_packet_in_batch = true;
+  EXPECT_EQ(4,
+            sender->SendTo("data", 4, receiver->GetLocalAddress(), options));
+  EXPECT_EQ(recorder.packet_ids, std::vector<int64_t>({0, 1, 2}));
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(4,
+              receiver->RecvFrom(buffer, sizeof(buffer), &source, &timestamp));
+  }
+}
+
+TEST(AsyncUdpSocketBatchedSendTest, SendsBatchWithoutLastPacketFromPostedTask) {
+  PhysicalSocketServer pss;
+  AutoSocketServerThread thread(&pss);
+  std::unique_ptr<AsyncUDPSocket> sender(AsyncUDPSocket::Create(
+      &pss, SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  std::unique_ptr<Socket> receiver(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_TRUE(sender);
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  SentPacketRecorder recorder;
+  sender->SignalSentPacket.connect(&recorder,
+                                   &SentPacketRecorder::OnSentPacket);
+
+  PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 2; ++i) {
+    options.packet_id = i;
+    EXPECT_EQ(4, sender->SendTo("data", 4, receiver->GetLocalAddress(),
+                                options));
+  }
+  EXPECT_TRUE(recorder.packet_ids.empty());
+
+  // The packet marked `last_packet_in_batch` never comes.
+  thread.ProcessMessages(0);
+  EXPECT_EQ(recorder.packet_ids, std::vector<int64_t>({0, 1}));
+  char buffer[16];
+  SocketAddress source;
+  int64_t timestamp;
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(4,
+              receiver->RecvFrom(buffer, sizeof(buffer), &source, &timestamp));
+  }
+}
+
+TEST(AsyncUdpSocketBatchedSendTest, PostedFlushDoesNotSplitLaterBatch) {
+  PhysicalSocketServer pss;
+  AutoSocketServerThread thread(&pss);
+  std::unique_ptr<AsyncUDPSocket> sender(AsyncUDPSocket::Create(
+      &pss, SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  std::unique_ptr<Socket> receiver(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_TRUE(sender);
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  SentPacketRecorder recorder;
+  sender->SignalSentPacket.connect(&recorder,
+                                   &SentPacketRecorder::OnSentPacket);
+
+  PacketOptions options;
+  options.batchable = true;
+  options.packet_id = 0;
+  options.last_packet_in_batch = true;
+  EXPECT_EQ(4,
+            sender->SendTo("data", 4, receiver->GetLocalAddress(), options));
+  options.packet_id = 1;
+  options.last_packet_in_batch = false;
+  EXPECT_EQ(4,
+            sender->SendTo("data", 4, receiver->GetLocalAddress(), options));
+  EXPECT_EQ(recorder.packet_ids, std::vector<int64_t>({0}));
+
+  // Only the flush posted for the second batch may send it.
+  thread.ProcessMessages(0);
+  EXPECT_EQ(recorder.packet_ids, std::vector<int64_t>({0, 1}));
+}
+
+TEST(AsyncUdpSocketBatchedSendTest, NonBatchablePacketFlushesPendingBatch) {
+  PhysicalSocketServer pss;
+  std::unique_ptr<AsyncUDPSocket> sender(AsyncUDPSocket::Create(
+      &pss, SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  std::unique_ptr<Socket> receiver(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_TRUE(sender);
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+
+  PacketOptions batchable;
+  batchable.batchable = true;
+  EXPECT_EQ(5, sender->SendTo("first", 5, receiver->GetLocalAddress(),
+                              batchable));
+  EXPECT_EQ(6, sender->SendTo("second", 6, receiver->GetLocalAddress(),
+                              PacketOptions()));
+
+  char buffer[16];
+  SocketAddress source;
+  int64_t timestamp;
+  ASSERT_EQ(5, receiver->RecvFrom(buffer, sizeof(buffer), &source, &timestamp));
+  EXPECT_EQ(std::string(buffer, 5), "first");
+  ASSERT_EQ(6, receiver->RecvFrom(buffer, sizeof(buffer), &source, &timestamp));
+  EXPECT_EQ(std::string(buffer, 6), "second");
+}
+
 }  // namespace rtc
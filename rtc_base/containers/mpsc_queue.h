@@ -0,0 +1,159 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_CONTAINERS_MPSC_QUEUE_H_
+#define RTC_BASE_CONTAINERS_MPSC_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/containers/pooled_queue.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Multi producer, single consumer FIFO queue. Values are pushed without a
+// lock into a fixed size ring of `capacity` slots, which uses a sequence
+// number per slot as in the bounded queue of Dmitry Vyukov. When the ring is
+// full, values are pushed to an overflow queue under a mutex, until the
+// consumer has emptied it.
+//
+// Values pushed by one thread are popped in order, and so are values pushed
+// by different threads in an order established by other means, e.g. a mutex.
+// Push(), empty() and size() may be called on any thread, while Pop() and
+// Clear() must be called on a single consumer thread. empty() and size() are
+// only exact on the consumer thread, when no value is pushed concurrently.
+template <typename T>
+class MpscQueue {
+ public:
+  static constexpr size_t kDefaultCapacity = 256;
+
+  explicit MpscQueue(size_t capacity = kDefaultCapacity)
+      : mask_(capacity - 1), cells_(new Cell[capacity]) {
+    RTC_DCHECK_GT(capacity, 1);
+    RTC_DCHECK_EQ(capacity & mask_, 0) << "Capacity must be a power of two.";
+    for (size_t i = 0; i < capacity; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+  ~MpscQueue() = default;
+
+  void Push(T value) {
+    // Once values are in the overflow queue, the next ones must follow them.
+    if (!use_overflow_.load()) {
+      size_t position = enqueue_position_.load(std::memory_order_relaxed);
+      while (true) {
+        Cell& cell = cells_[position & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t diff =
+            static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (diff == 0) {
+          if (enqueue_position_.compare_exchange_weak(position,
+                                                      position + 1)) {
+            cell.value = std::move(value);
+            cell.sequence.store(position + 1, std::memory_order_release);
+            return;
+          }
+        } else if (diff < 0) {
+          // The ring is full.
+          break;
+        } else {
+          position = enqueue_position_.load(std::memory_order_relaxed);
+        }
+      }
+    }
+    MutexLock lock(&overflow_lock_);
+    overflow_.push(std::move(value));
+    use_overflow_.store(true);
+  }
+
+  // Moves the oldest value to `value` and returns true, or returns false if
+  // there's none, or the oldest one is still being pushed.
+  bool Pop(T& value) {
+    size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    Cell& cell = cells_[position & mask_];
+    if (cell.sequence.load(std::memory_order_acquire) == position + 1) {
+      value = std::move(cell.value);
+      cell.value = T();
+      cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+      dequeue_position_.store(position + 1, std::memory_order_relaxed);
+      return true;
+    }
+    // Values in the overflow queue are newer than the ones in the ring, which
+    // must be popped first.
+    if (enqueue_position_.load() != position || !use_overflow_.load()) {
+      return false;
+    }
+    MutexLock lock(&overflow_lock_);
+    if (overflow_.empty()) {
+      return false;
+    }
+    value = std::move(overflow_.front());
+    overflow_.pop();
+    if (overflow_.empty()) {
+      use_overflow_.store(false);
+    }
+    return true;
+  }
+
+  // Returns true if nothing has been pushed since the last value was popped.
+  bool empty() const {
+    return enqueue_position_.load() ==
+               dequeue_position_.load(std::memory_order_relaxed) &&
+           !use_overflow_.load();
+  }
+
+  size_t size() const {
+    // Loads the consumer position first, which never passes the producer one.
+    size_t dequeue_position = dequeue_position_.load();
+    size_t size = enqueue_position_.load() - dequeue_position;
+    MutexLock lock(&overflow_lock_);
+    return size + overflow_.size();
+  }
+
+  // Pops and destroys all values, in FIFO order.
+  void Clear() {
+    T value;
+    while (Pop(value)) {
+      value = T();
+    }
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  const size_t mask_;
+  const std::unique_ptr<Cell[]> cells_;
+  std::atomic<size_t> enqueue_position_{0};
+  // Only written by the consumer.
+  std::atomic<size_t> dequeue_position_{0};
+  // True while the overflow queue isn't empty. Accessed with sequentially
+  // consistent ordering, as is `enqueue_position_`, so that a consumer which
+  // finds the queue empty before waiting, and a producer which checks if the
+  // consumer is waiting after pushing, can't miss each other.
+  std::atomic<bool> use_overflow_{false};
+  mutable Mutex overflow_lock_;
+  PooledQueue<T> overflow_ RTC_GUARDED_BY(overflow_lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_CONTAINERS_MPSC_QUEUE_H_
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/containers/mpsc_queue.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+std::vector<int> PopAll(MpscQueue<int>& queue) {
+  std::vector<int> values;
+  int value;
+  while (queue.Pop(value)) {
+    values.push_back(value);
+  }
+  return values;
+}
+
+TEST(MpscQueueTest, PopsInPushOrder) {
+  MpscQueue<int> queue(4);
+  EXPECT_TRUE(queue.empty());
+  int value;
+  EXPECT_FALSE(queue.Pop(value));
+
+  queue.Push(1);
+  queue.Push(2);
+  EXPECT_FALSE(queue.empty());
+  EXPECT_EQ(queue.size(), 2u);
+  ASSERT_TRUE(queue.Pop(value));
+  EXPECT_EQ(value, 1);
+  // Wraps around the ring.
+  queue.Push(3);
+  queue.Push(4);
+  queue.Push(5);
+  EXPECT_THAT(PopAll(queue), ElementsAre(2, 3, 4, 5));
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(MpscQueueTest, KeepsOrderWhenOverflowing) {
+  MpscQueue<int> queue(4);
+  for (int i = 0; i < 6; ++i) {
+    queue.Push(i);
+  }
+  EXPECT_EQ(queue.size(), 6u);
+  int value;
+  ASSERT_TRUE(queue.Pop(value));
+  EXPECT_EQ(value, 0);
+  // Follows the values in the overflow queue, although the ring has room.
+  queue.Push(6);
+  EXPECT_THAT(PopAll(queue), ElementsAre(1, 2, 3, 4, 5, 6));
+  EXPECT_TRUE(queue.empty());
+
+  // Uses the ring again once the overflow queue is empty.
+  queue.Push(7);
+  EXPECT_THAT(PopAll(queue), ElementsAre(7));
+}
+
+TEST(MpscQueueTest, DestroysPoppedValues) {
+  MpscQueue<std::unique_ptr<int>> queue(2);
+  auto value = std::make_unique<int>(1);
+  int* raw = value.get();
+  queue.Push(std::move(value));
+  queue.Push(std::make_unique<int>(2));
+  queue.Push(std::make_unique<int>(3));
+  std::unique_ptr<int> popped;
+  ASSERT_TRUE(queue.Pop(popped));
+  EXPECT_EQ(popped.get(), raw);
+  queue.Clear();
+  EXPECT_TRUE(queue.empty());
+  EXPECT_FALSE(queue.Pop(popped));
+}
+
+TEST(MpscQueueTest, KeepsOrderOfEachProducer) {
+  constexpr int kNumProducers = 4;
+  constexpr int kValuesPerProducer = 10000;
+  // Small enough for the producers to overflow the ring now and then.
+  MpscQueue<int> queue(16);
+  std::vector<rtc::PlatformThread> producers;
+  for (int p = 0; p < kNumProducers; ++p) {
+    producers.push_back(rtc::PlatformThread::SpawnJoinable(
+        [&queue, p] {
+          for (int i = 0; i < kValuesPerProducer; ++i) {
+            queue.Push(p * kValuesPerProducer + i);
+          }
+        },
+        "producer"));
+  }
+
+  std::vector<int> next(kNumProducers, 0);
+  int num_popped = 0;
+  while (num_popped < kNumProducers * kValuesPerProducer) {
+    int value;
+    if (!queue.Pop(value)) {
+      continue;
+    }
+    int producer = value / kValuesPerProducer;
+    ASSERT_EQ(value % kValuesPerProducer, next[producer]);
+    ++next[producer];
+    ++num_popped;
+  }
+  for (rtc::PlatformThread& producer : producers) {
+    producer.Finalize();
+  }
+  EXPECT_TRUE(queue.empty());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_CONTAINERS_POOLED_QUEUE_H_
+#define RTC_BASE_CONTAINERS_POOLED_QUEUE_H_
+
+#include <stddef.h>
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// FIFO queue with a std::queue-like interface, made of intrusively linked
+// nodes which are kept in a free list when popped and reused by later
+// pushes. Once the queue has been as long as it gets in steady state, pushing
+// and popping don't allocate, unlike std::queue whose std::deque allocates
+// and frees a block every few elements. Up to `max_free_nodes` nodes are
+// kept, to release the memory of bursts.
+//
+// Popping assigns a default constructed `T` to the node, so that the popped
+// value is destroyed right away. Not thread safe.
+template <typename T>
+class PooledQueue {
+ public:
+  static constexpr size_t kDefaultMaxFreeNodes = 256;
+
+  explicit PooledQueue(size_t max_free_nodes = kDefaultMaxFreeNodes)
+      : max_free_nodes_(max_free_nodes) {}
+  PooledQueue(const PooledQueue&) = delete;
+  PooledQueue& operator=(const PooledQueue&) = delete;
+  ~PooledQueue() {
+    DeleteNodes(head_);
+    DeleteNodes(free_);
+  }
+
+  bool empty() const { return head_ == nullptr; }
+  size_t size() const { return size_; }
+
+  T& front() {
+    RTC_DCHECK(head_);
+    return head_->value;
+  }
+
+  void push(T value) {
+    Node* node = free_;
+    if (node != nullptr) {
+      free_ = node->next;
+      --num_free_;
+      node->value = std::move(value);
+      node->next = nullptr;
+    } else {
+      node = new Node{std::move(value), nullptr};
+    }
+    if (tail_ != nullptr) {
+      tail_->next = node;
+    } else {
+      head_ = node;
+    }
+    tail_ = node;
+    ++size_;
+  }
+
+  void pop() {
+    RTC_DCHECK(head_);
+    Node* node = head_;
+    head_ = node->next;
+    if (head_ == nullptr) {
+      tail_ = nullptr;
+    }
+    --size_;
+    node->value = T();
+    if (num_free_ < max_free_nodes_) {
+      node->next = free_;
+      free_ = node;
+      ++num_free_;
+    } else {
+      delete node;
+    }
+  }
+
+  // Pops all values, in FIFO order.
+  void clear() {
+    while (!empty()) {
+      pop();
+    }
+  }
+
+  // Swaps the queued values, keeping the free nodes of each queue.
+  void swap(PooledQueue& other) {
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(size_, other.size_);
+  }
+
+ private:
+  struct Node {
+    T value;
+    Node* next;
+  };
+
+  static void DeleteNodes(Node* node) {
+    while (node != nullptr) {
+      Node* next = node->next;
+      delete node;
+      node = next;
+    }
+  }
+
+  const size_t max_free_nodes_;
+  Node* head_ = nullptr;
+  Node* tail_ = nullptr;
+  size_t size_ = 0;
+  // Singly linked list of nodes without a value.
+  Node* free_ = nullptr;
+  size_t num_free_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_CONTAINERS_POOLED_QUEUE_H_
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/containers/pooled_queue.h"
+
+#include <memory>
+#include <utility>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(PooledQueueTest, PopsInPushOrder) {
+  PooledQueue<int> queue;
+  EXPECT_TRUE(queue.empty());
+  queue.push(1);
+  queue.push(2);
+  queue.push(3);
+  EXPECT_EQ(queue.size(), 3u);
+
+  EXPECT_EQ(queue.front(), 1);
+  queue.pop();
+  queue.push(4);
+  EXPECT_EQ(queue.front(), 2);
+  queue.pop();
+  EXPECT_EQ(queue.front(), 3);
+  queue.pop();
+  EXPECT_EQ(queue.front(), 4);
+  queue.pop();
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(queue.size(), 0u);
+}
+
+TEST(PooledQueueTest, ReusesPoppedNodes) {
+  PooledQueue<std::unique_ptr<int>> queue;
+  queue.push(std::make_unique<int>(1));
+  queue.push(std::make_unique<int>(2));
+  const std::unique_ptr<int>* first_node = &queue.front();
+  queue.pop();
+  queue.pop();
+
+  queue.push(std::make_unique<int>(3));
+  queue.push(std::make_unique<int>(4));
+  // The most recently freed node is reused first.
+  queue.pop();
+  EXPECT_EQ(&queue.front(), first_node);
+  EXPECT_EQ(*queue.front(), 4);
+}
+
+TEST(PooledQueueTest, DestroysValueWhenPopped) {
+  PooledQueue<std::shared_ptr<int>> queue;
+  auto value = std::make_shared<int>(5);
+  queue.push(value);
+  EXPECT_EQ(value.use_count(), 2);
+  queue.pop();
+  EXPECT_EQ(value.use_count(), 1);
+
+  queue.push(value);
+  queue.clear();
+  EXPECT_TRUE(queue.empty());
+  EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(PooledQueueTest, DeletesNodesBeyondMaxFreeNodes) {
+  PooledQueue<std::shared_ptr<int>> queue(/*max_free_nodes=*/1);
+  auto value = std::make_shared<int>(5);
+  queue.push(value);
+  queue.push(value);
+  queue.push(value);
+  queue.clear();
+  EXPECT_EQ(value.use_count(), 1);
+  queue.push(value);
+  EXPECT_EQ(queue.size(), 1u);
+}
+
+TEST(PooledQueueTest, SwapsValues) {
+  PooledQueue<int> a;
+  PooledQueue<int> b;
+  a.push(1);
+  a.push(2);
+  b.push(3);
+  a.swap(b);
+  ASSERT_EQ(a.size(), 1u);
+  EXPECT_EQ(a.front(), 3);
+  ASSERT_EQ(b.size(), 2u);
+  EXPECT_EQ(b.front(), 1);
+  b.pop();
+  b.push(4);
+  b.pop();
+  EXPECT_EQ(b.front(), 4);
+}
+
+}  // namespace
+}  // namespace webrtc
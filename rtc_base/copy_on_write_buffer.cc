@@ -13,6 +13,7 @@
 #include <stddef.h>
 
 #include "absl/strings/string_view.h"
+#include "rtc_base/copy_on_write_buffer_pool.h"
 
 namespace rtc {
 
@@ -48,6 +49,11 @@ CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size, size_t capacity)
   RTC_DCHECK(IsConsistent());
 }
 
+CopyOnWriteBuffer::CopyOnWriteBuffer(scoped_refptr<RefCountedBuffer> buffer)
+    : buffer_(std::move(buffer)), offset_(0), size_(buffer_->size()) {
+  RTC_DCHECK(IsConsistent());
+}
+
 CopyOnWriteBuffer::~CopyOnWriteBuffer() = default;
 
 bool CopyOnWriteBuffer::operator==(const CopyOnWriteBuffer& buf) const {
@@ -118,10 +124,39 @@ void CopyOnWriteBuffer::UnshareAndEnsureCapacity(size_t new_capacity) {
     return;
   }
 
+  // Copies of pooled buffers keep using storage from the same pool. `pool_`
+  // can't change while this buffer holds a reference.
+  RefCountedBuffer* pooled_buffer =
+      buffer_->pool_ != nullptr ? buffer_->pool_->TakeStorage(new_capacity)
+                                : nullptr;
+  if (pooled_buffer != nullptr) {
+    pooled_buffer->SetData(buffer_->data() + offset_, size_);
+    buffer_ = pooled_buffer;
+    offset_ = 0;
+    RTC_DCHECK(IsConsistent());
+    return;
+  }
+
   buffer_ =
       new RefCountedBuffer(buffer_->data() + offset_, size_, new_capacity);
   offset_ = 0;
   RTC_DCHECK(IsConsistent());
 }
 
+RefCountReleaseStatus CopyOnWriteBuffer::RefCountedBuffer::Release() const {
+  const auto status = ref_count_.DecRef();
+  if (status == RefCountReleaseStatus::kDroppedLastRef) {
+    if (pool_ != nullptr) {
+      CopyOnWriteBufferPool* pool = pool_;
+      pool_ = nullptr;
+      pool->Recycle(const_cast<RefCountedBuffer*>(this));
+      // May delete the pool, and with it this buffer.
+      pool->Release();
+    } else {
+      delete this;
+    }
+  }
+  return status;
+}
+
 }  // namespace rtc
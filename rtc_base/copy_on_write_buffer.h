@@ -29,6 +29,8 @@
 
 namespace rtc {
 
+class CopyOnWriteBufferPool;
+
 class RTC_EXPORT CopyOnWriteBuffer {
  public:
   // An empty buffer.
@@ -289,7 +291,30 @@ class RTC_EXPORT CopyOnWriteBuffer {
   }
 
  private:
-  using RefCountedBuffer = FinalRefCountedObject<Buffer>;
+  friend class CopyOnWriteBufferPool;
+
+  // Storage shared by all CopyOnWriteBuffers referring to the same data.
+  // Storage handed out by a CopyOnWriteBufferPool goes back to the pool,
+  // rather than being freed, when the last reference is dropped.
+  class RefCountedBuffer final : public Buffer {
+   public:
+    using Buffer::Buffer;
+
+    void AddRef() const { ref_count_.IncRef(); }
+    RefCountReleaseStatus Release() const;
+    bool HasOneRef() const { return ref_count_.HasOneRef(); }
+
+   private:
+    friend class CopyOnWriteBuffer;
+    friend class CopyOnWriteBufferPool;
+
+    mutable webrtc::webrtc_impl::RefCounter ref_count_{0};
+    // Reference to the owning pool, held while the storage is in use.
+    mutable CopyOnWriteBufferPool* pool_ = nullptr;
+  };
+
+  explicit CopyOnWriteBuffer(scoped_refptr<RefCountedBuffer> buffer);
+
   // Create a copy of the underlying data if it is referenced from other Buffer
   // objects or there is not enough capacity.
   void UnshareAndEnsureCapacity(size_t new_capacity);
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/copy_on_write_buffer_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace rtc {
+
+CopyOnWriteBufferPool::CopyOnWriteBufferPool(size_t buffer_capacity,
+                                             size_t max_free_buffers)
+    : CopyOnWriteBufferPool(std::vector<size_t>{buffer_capacity},
+                            max_free_buffers) {}
+
+CopyOnWriteBufferPool::CopyOnWriteBufferPool(
+    std::vector<size_t> buffer_capacities,
+    size_t max_free_buffers)
+    : max_free_buffers_(max_free_buffers) {
+  RTC_DCHECK(!buffer_capacities.empty());
+  std::sort(buffer_capacities.begin(), buffer_capacities.end());
+  buffer_capacities.erase(
+      std::unique(buffer_capacities.begin(), buffer_capacities.end()),
+      buffer_capacities.end());
+  webrtc::MutexLock lock(&mutex_);
+  size_classes_.reserve(buffer_capacities.size());
+  for (size_t capacity : buffer_capacities) {
+    RTC_DCHECK_GT(capacity, 0);
+    size_classes_.emplace_back(capacity);
+  }
+}
+
+CopyOnWriteBufferPool::~CopyOnWriteBufferPool() {
+  webrtc::MutexLock lock(&mutex_);
+  for (SizeClass& size_class : size_classes_) {
+    for (CopyOnWriteBuffer::RefCountedBuffer* buffer :
+         size_class.free_buffers) {
+      delete buffer;
+    }
+  }
+}
+
+CopyOnWriteBuffer CopyOnWriteBufferPool::CreateBuffer(const uint8_t* data,
+                                                      size_t size) {
+  CopyOnWriteBuffer::RefCountedBuffer* buffer =
+      size > 0 ? TakeStorage(size) : nullptr;
+  if (buffer == nullptr) {
+    // Empty buffers and buffers larger than all size classes aren't pooled.
+    return CopyOnWriteBuffer(data, size);
+  }
+  buffer->SetData(data, size);
+  return CopyOnWriteBuffer(scoped_refptr<CopyOnWriteBuffer::RefCountedBuffer>(
+      buffer));
+}
+
+CopyOnWriteBuffer CopyOnWriteBufferPool::CreateEmptyBuffer(size_t capacity) {
+  CopyOnWriteBuffer::RefCountedBuffer* buffer =
+      capacity > 0 ? TakeStorage(capacity) : nullptr;
+  if (buffer == nullptr) {
+    return CopyOnWriteBuffer(0, capacity);
+  }
+  return CopyOnWriteBuffer(scoped_refptr<CopyOnWriteBuffer::RefCountedBuffer>(
+      buffer));
+}
+
+CopyOnWriteBuffer::RefCountedBuffer* CopyOnWriteBufferPool::TakeStorage(
+    size_t capacity) {
+  CopyOnWriteBuffer::RefCountedBuffer* buffer = nullptr;
+  {
+    webrtc::MutexLock lock(&mutex_);
+    SizeClass* size_class = FindSizeClass(capacity);
+    if (size_class == nullptr) {
+      return nullptr;
+    }
+    capacity = size_class->capacity;
+    if (!size_class->free_buffers.empty()) {
+      buffer = size_class->free_buffers.back();
+      size_class->free_buffers.pop_back();
+    }
+  }
+  if (buffer == nullptr) {
+    buffer = new CopyOnWriteBuffer::RefCountedBuffer(0, capacity);
+  }
+  AddRef();
+  buffer->pool_ = this;
+  return buffer;
+}
+
+size_t CopyOnWriteBufferPool::free_buffers() const {
+  webrtc::MutexLock lock(&mutex_);
+  size_t free_buffers = 0;
+  for (const SizeClass& size_class : size_classes_) {
+    free_buffers += size_class.free_buffers.size();
+  }
+  return free_buffers;
+}
+
+void CopyOnWriteBufferPool::ReleaseFreeBuffers() {
+  webrtc::MutexLock lock(&mutex_);
+  for (SizeClass& size_class : size_classes_) {
+    for (CopyOnWriteBuffer::RefCountedBuffer* buffer :
+         size_class.free_buffers) {
+      delete buffer;
+    }
+    std::vector<CopyOnWriteBuffer::RefCountedBuffer*>().swap(
+        size_class.free_buffers);
+  }
+}
+
+CopyOnWriteBufferPool::SizeClass* CopyOnWriteBufferPool::FindSizeClass(
+    size_t size) {
+  auto it = std::lower_bound(size_classes_.begin(), size_classes_.end(), size,
+                             [](const SizeClass& size_class, size_t size) {
+                               return size_class.capacity < size;
+                             });
+  return it != size_classes_.end() ? &*it : nullptr;
+}
+
+void CopyOnWriteBufferPool::Recycle(
+    CopyOnWriteBuffer::RefCountedBuffer* buffer) {
+  {
+    webrtc::MutexLock lock(&mutex_);
+    // Pooled storage is not expected to be reallocated, but storage whose
+    // capacity no longer matches a size class must not be handed out as if
+    // it did, so it is deleted instead.
+    SizeClass* size_class = FindSizeClass(buffer->capacity());
+    if (size_class && size_class->capacity == buffer->capacity() &&
+        size_class->free_buffers.size() < max_free_buffers_) {
+      buffer->Clear();
+      size_class->free_buffers.push_back(buffer);
+      return;
+    }
+  }
+  delete buffer;
+}
+
+}  // namespace rtc
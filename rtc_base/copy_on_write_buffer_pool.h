@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_COPY_ON_WRITE_BUFFER_POOL_H_
+#define RTC_BASE_COPY_ON_WRITE_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/ref_counted_base.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// Recycles the storage of short lived CopyOnWriteBuffers of bounded size, such
+// as received packets, so that steady state use does not allocate. Buffers
+// created by the pool behave like any other CopyOnWriteBuffer and may outlive
+// the pool. Buffers may be released on any thread. When a shared buffer is
+// written to, it gets its own copy of the data in storage from the same pool.
+class RTC_EXPORT CopyOnWriteBufferPool final
+    : public RefCountedNonVirtual<CopyOnWriteBufferPool> {
+ public:
+  // Pooled storage has `buffer_capacity` bytes, larger buffers are allocated
+  // as usual. At most `max_free_buffers` unused buffers are kept around.
+  CopyOnWriteBufferPool(size_t buffer_capacity, size_t max_free_buffers);
+  // Pooled storage comes in each of the `buffer_capacities`, and a buffer uses
+  // the smallest capacity that fits its data. This keeps e.g. small RTCP
+  // packets from holding on to storage sized for the largest packets. At most
+  // `max_free_buffers` unused buffers are kept around per capacity.
+  CopyOnWriteBufferPool(std::vector<size_t> buffer_capacities,
+                        size_t max_free_buffers);
+  ~CopyOnWriteBufferPool();
+
+  // Returns a buffer holding a copy of the `size` bytes at `data`.
+  CopyOnWriteBuffer CreateBuffer(const uint8_t* data, size_t size);
+
+  // Returns an empty buffer with room for at least `capacity` bytes.
+  CopyOnWriteBuffer CreateEmptyBuffer(size_t capacity);
+
+  // Number of unused buffers ready for reuse, of all capacities.
+  size_t free_buffers() const;
+
+  // Frees the unused buffers, e.g. once the owner goes idle. The pool fills up
+  // again as buffers are created and released.
+  void ReleaseFreeBuffers();
+
+ private:
+  friend class CopyOnWriteBuffer;
+
+  struct SizeClass {
+    explicit SizeClass(size_t capacity) : capacity(capacity) {}
+
+    const size_t capacity;
+    std::vector<CopyOnWriteBuffer::RefCountedBuffer*> free_buffers;
+  };
+
+  // Returns the smallest size class that fits `size` bytes, or nullptr.
+  SizeClass* FindSizeClass(size_t size) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  // Returns empty storage for at least `capacity` bytes that is returned to
+  // this pool when released, or nullptr if `capacity` is too large.
+  CopyOnWriteBuffer::RefCountedBuffer* TakeStorage(size_t capacity);
+
+  // Called when the last reference to `buffer` is dropped.
+  void Recycle(CopyOnWriteBuffer::RefCountedBuffer* buffer);
+
+  const size_t max_free_buffers_;
+  mutable webrtc::Mutex mutex_;
+  // Sorted by increasing capacity.
+  std::vector<SizeClass> size_classes_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_COPY_ON_WRITE_BUFFER_POOL_H_
@@ -0,0 +1,194 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/copy_on_write_buffer_pool.h"
+
+#include <cstdint>
+
+#include "api/scoped_refptr.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+const uint8_t kTestData[] = {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7};
+
+TEST(CopyOnWriteBufferPoolTest, ReusesReleasedStorage) {
+  scoped_refptr<CopyOnWriteBufferPool> pool(
+      new CopyOnWriteBufferPool(/*buffer_capacity=*/64,
+                                /*max_free_buffers=*/4));
+  const uint8_t* data;
+  {
+    CopyOnWriteBuffer buffer = pool->CreateBuffer(kTestData, 8);
+    EXPECT_EQ(buffer, CopyOnWriteBuffer(kTestData, 8));
+    EXPECT_EQ(buffer.capacity(), 64u);
+    data = buffer.cdata();
+  }
+  EXPECT_EQ(pool->free_buffers(), 1u);
+
+  CopyOnWriteBuffer buffer = pool->CreateBuffer(kTestData, 4);
+  EXPECT_EQ(pool->free_buffers(), 0u);
+  EXPECT_EQ(buffer.cdata(), data);
+  EXPECT_EQ(buffer, CopyOnWriteBuffer(kTestData, 4));
+}
+
+TEST(CopyOnWriteBufferPoolTest, StorageIsReturnedOnlyWhenAllCopiesAreGone) {
+  scoped_refptr<CopyOnWriteBufferPool> pool(
+      new CopyOnWriteBufferPool(/*buffer_capacity=*/64,
+                                /*max_free_buffers=*/4));
+  CopyOnWriteBuffer buffer = pool->CreateBuffer(kTestData, 8);
+  CopyOnWriteBuffer slice = buffer.Slice(2, 4);
+  buffer = CopyOnWriteBuffer();
+  EXPECT_EQ(pool->free_buffers(), 0u);
+  EXPECT_EQ(slice, CopyOnWriteBuffer(kTestData + 2, 4));
+  slice = CopyOnWriteBuffer();
+  EXPECT_EQ(pool->free_buffers(), 1u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, WritingToUnsharedBufferKeepsPooledStorage) {
+  scoped_refptr<CopyOnWriteBufferPool> pool(
+      new CopyOnWriteBufferPool(/*buffer_capacity=*/64,
+                                /*max_free_buffers=*/4));
+  CopyOnWriteBuffer buffer = pool->CreateBuffer(kTestData, 8);
+  const uint8_t* data = buffer.cdata();
+  buffer.MutableData()[0] = 0xff;
+  EXPECT_EQ(buffer.cdata(), data);
+  buffer = CopyOnWriteBuffer();
+  EXPECT_EQ(pool->free_buffers(), 1u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, KeepsAtMostMaxFreeBuffers) {
+  scoped_refptr<CopyOnWriteBufferPool> pool(
+      new CopyOnWriteBufferPool(/*buffer_capacity=*/64,
+                                /*max_free_buffers=*/1));
+  {
+    CopyOnWriteBuffer first = pool->CreateBuffer(kTestData, 8);
+    CopyOnWriteBuffer second = pool->CreateBuffer(kTestData, 8);
+  }
+  EXPECT_EQ(pool->free_buffers(), 1u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, LargeBuffersAreNotPooled) {
+  scoped_refptr<CopyOnWriteBufferPool> pool(
+      new CopyOnWriteBufferPool(/*buffer_capacity=*/4,
+                                /*max_free_buffers=*/4));
+  {
+    CopyOnWriteBuffer buffer = pool->CreateBuffer(kTestData, 8);
+    EXPECT_EQ(buffer, CopyOnWriteBuffer(kTestData, 8));
+  }
+  EXPECT_EQ(pool->free_buffers(), 0u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, UsesSmallestCapacityThatFits) {
+  scoped_refptr<CopyOnWriteBufferPool> pool(new CopyOnWriteBufferPool(
+      /*buffer_capacities=*/{64, 4}, /*max_free_buffers=*/4));
+  const uint8_t* small_data;
+  const uint8_t* large_data;
+  {
+    CopyOnWriteBuffer small = pool->CreateBuffer(kTestData, 4);
+    CopyOnWriteBuffer large = pool->CreateBuffer(kTestData, 8);
+    EXPECT_EQ(small.capacity(), 4u);
+    EXPECT_EQ(large.capacity(), 64u);
+    small_data = small.cdata();
+    large_data = large.cdata();
+  }
+  EXPECT_EQ(pool->free_buffers(), 2u);
+
+  // Each buffer reuses the storage of its own size.
+  CopyOnWriteBuffer large = pool->CreateBuffer(kTestData, 5);
+  CopyOnWriteBuffer small = pool->CreateBuffer(kTestData, 2);
+  EXPECT_EQ(large.cdata(), large_data);
+  EXPECT_EQ(small.cdata(), small_data);
+  EXPECT_EQ(large, CopyOnWriteBuffer(kTestData, 5));
+  EXPECT_EQ(small, CopyOnWriteBuffer(kTestData, 2));
+  EXPECT_EQ(pool->free_buffers(), 0u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, KeepsAtMostMaxFreeBuffersPerCapacity) {
+  scoped_refptr<CopyOnWriteBufferPool> pool(new CopyOnWriteBufferPool(
+      /*buffer_capacities=*/{4, 64}, /*max_free_buffers=*/1));
+  {
+    CopyOnWriteBuffer small1 = pool->CreateBuffer(kTestData, 4);
+    CopyOnWriteBuffer small2 = pool->CreateBuffer(kTestData, 4);
+    CopyOnWriteBuffer large1 = pool->CreateBuffer(kTestData, 8);
+    CopyOnWriteBuffer large2 = pool->CreateBuffer(kTestData, 8);
+  }
+  EXPECT_EQ(pool->free_buffers(), 2u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, CreatesEmptyBuffers) {
+  scoped_refptr<CopyOnWriteBufferPool> pool(
+      new CopyOnWriteBufferPool(/*buffer_capacity=*/64,
+                                /*max_free_buffers=*/4));
+  {
+    CopyOnWriteBuffer buffer = pool->CreateEmptyBuffer(32);
+    EXPECT_EQ(buffer.size(), 0u);
+    EXPECT_EQ(buffer.capacity(), 64u);
+    buffer.AppendData(kTestData);
+    EXPECT_EQ(buffer, CopyOnWriteBuffer(kTestData));
+  }
+  EXPECT_EQ(pool->free_buffers(), 1u);
+
+  CopyOnWriteBuffer large = pool->CreateEmptyBuffer(128);
+  EXPECT_GE(large.capacity(), 128u);
+  EXPECT_EQ(pool->free_buffers(), 1u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, ReleasesFreeBuffersOnRequest) {
+  scoped_refptr<CopyOnWriteBufferPool> pool(
+      new CopyOnWriteBufferPool(/*buffer_capacity=*/64,
+                                /*max_free_buffers=*/4));
+  CopyOnWriteBuffer in_use = pool->CreateBuffer(kTestData, 8);
+  {
+    CopyOnWriteBuffer released1 = pool->CreateBuffer(kTestData, 8);
+    CopyOnWriteBuffer released2 = pool->CreateBuffer(kTestData, 8);
+  }
+  EXPECT_EQ(pool->free_buffers(), 2u);
+
+  pool->ReleaseFreeBuffers();
+  EXPECT_EQ(pool->free_buffers(), 0u);
+
+  // Buffers in use are still returned to the pool.
+  in_use = CopyOnWriteBuffer();
+  EXPECT_EQ(pool->free_buffers(), 1u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, WritingToSharedBufferCopiesToPooledStorage) {
+  scoped_refptr<CopyOnWriteBufferPool> pool(
+      new CopyOnWriteBufferPool(/*buffer_capacity=*/64,
+                                /*max_free_buffers=*/4));
+  CopyOnWriteBuffer buffer = pool->CreateBuffer(kTestData, 8);
+  // Puts storage in the free list.
+  pool->CreateBuffer(kTestData, 8);
+  ASSERT_EQ(pool->free_buffers(), 1u);
+
+  CopyOnWriteBuffer copy = buffer;
+  copy.MutableData()[0] = 0xff;
+  EXPECT_NE(copy.cdata(), buffer.cdata());
+  EXPECT_EQ(copy.capacity(), 64u);
+  EXPECT_EQ(buffer, CopyOnWriteBuffer(kTestData, 8));
+  // The copy took the free storage.
+  EXPECT_EQ(pool->free_buffers(), 0u);
+  copy = CopyOnWriteBuffer();
+  buffer = CopyOnWriteBuffer();
+  EXPECT_EQ(pool->free_buffers(), 2u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, BuffersMayOutliveThePool) {
+  scoped_refptr<CopyOnWriteBufferPool> pool(
+      new CopyOnWriteBufferPool(/*buffer_capacity=*/64,
+                                /*max_free_buffers=*/4));
+  CopyOnWriteBuffer buffer = pool->CreateBuffer(kTestData, 8);
+  pool = nullptr;
+  EXPECT_EQ(buffer, CopyOnWriteBuffer(kTestData, 8));
+}
+
+}  // namespace
+}  // namespace rtc
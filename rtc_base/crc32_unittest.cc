@@ -34,4 +34,16 @@ TEST(Crc32Test, TestMultipleUpdates) {
   EXPECT_EQ(0x171A3F5FU, c);
 }
 
+TEST(Crc32Test, TestUnalignedUpdates) {
+  std::string input =
+      "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+  // Split the input at every offset, so that both the word-at-a-time and the
+  // byte-at-a-time paths start at all alignments.
+  for (size_t split = 0; split <= input.size(); ++split) {
+    uint32_t c = UpdateCrc32(0, input.data(), split);
+    c = UpdateCrc32(c, input.data() + split, input.size() - split);
+    EXPECT_EQ(0x171A3F5FU, c) << "split at " << split;
+  }
+}
+
 }  // namespace rtc
@@ -16,8 +16,10 @@
 
 #include <atomic>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
 #include "api/sequence_checker.h"
 #include "rtc_base/checks.h"
@@ -33,6 +35,8 @@
 // This is a guesstimate that should be enough in most cases.
 static const size_t kEventLoggerArgsStrBufferInitialSize = 256;
 static const size_t kTraceArgBufferLength = 32;
+// The TRACE_EVENT macros take at most two arguments.
+static const size_t kInlineTraceArgs = 2;
 
 namespace webrtc {
 
@@ -98,7 +102,9 @@ class EventLogger final {
                      uint64_t timestamp,
                      int pid,
                      rtc::PlatformThreadId thread_id) {
-    std::vector<TraceArg> args(num_args);
+    // Kept inline, so that recording an event doesn't need to allocate unless
+    // it has string arguments that must be copied.
+    absl::InlinedVector<TraceArg, kInlineTraceArgs> args(num_args);
     for (int i = 0; i < num_args; ++i) {
       TraceArg& arg = args[i];
       arg.name = arg_names[i];
@@ -115,8 +121,8 @@ class EventLogger final {
       }
     }
     webrtc::MutexLock lock(&mutex_);
-    trace_events_.push_back(
-        {name, category_enabled, phase, args, timestamp, 1, thread_id});
+    trace_events_.push_back({name, category_enabled, phase, std::move(args),
+                             timestamp, 1, thread_id});
   }
 
   // The TraceEvent format is documented here:
@@ -127,10 +133,13 @@ class EventLogger final {
         webrtc::TimeDelta::Millis(100);
     fprintf(output_file_, "{ \"traceEvents\": [\n");
     bool has_logged_event = false;
+    std::vector<TraceEvent> events;
     while (true) {
       bool shutting_down = shutdown_event_.Wait(kLoggingInterval);
-      std::vector<TraceEvent> events;
       {
+        // The previous batch is swapped back in, so that the recording threads
+        // reuse its capacity instead of growing a new vector every interval.
+        events.clear();
         webrtc::MutexLock lock(&mutex_);
         trace_events_.swap(events);
       }
@@ -214,7 +223,7 @@ class EventLogger final {
     TRACE_EVENT_INSTANT0("webrtc", "EventLogger::Stop");
     // Try to stop. Abort if we're not currently logging.
     int one = 1;
-    if (g_event_logging_active.compare_exchange_strong(one, 0))
+    if (!g_event_logging_active.compare_exchange_strong(one, 0))
       return;
 
     // Wake up logging thread to finish writing.
@@ -248,7 +257,7 @@ class EventLogger final {
     const char* name;
     const unsigned char* category_enabled;
     char phase;
-    std::vector<TraceArg> args;
+    absl::InlinedVector<TraceArg, kInlineTraceArgs> args;
     uint64_t timestamp;
     int pid;
     rtc::PlatformThreadId tid;
@@ -62,15 +62,16 @@ constexpr char VideoRateControlConfig::kKey[];
 std::unique_ptr<StructParametersParser> VideoRateControlConfig::Parser() {
   // The empty comments ensures that each pair is on a separate line.
   return StructParametersParser::Create(
-      "pacing_factor", &pacing_factor,                  //
-      "alr_probing", &alr_probing,                      //
-      "vp8_qp_max", &vp8_qp_max,                        //
-      "vp8_min_pixels", &vp8_min_pixels,                //
-      "trust_vp8", &trust_vp8,                          //
-      "trust_vp9", &trust_vp9,                          //
-      "bitrate_adjuster", &bitrate_adjuster,            //
-      "adjuster_use_headroom", &adjuster_use_headroom,  //
-      "vp8_s0_boost", &vp8_s0_boost,                    //
+      "pacing_factor", &pacing_factor,                            //
+      "alr_probing", &alr_probing,                                //
+      "vp8_qp_max", &vp8_qp_max,                                  //
+      "vp8_min_pixels", &vp8_min_pixels,                          //
+      "trust_vp8", &trust_vp8,                                    //
+      "trust_vp9", &trust_vp9,                                    //
+      "bitrate_adjuster", &bitrate_adjuster,                      //
+      "adjuster_use_headroom", &adjuster_use_headroom,            //
+      "adjuster_use_qp_prediction", &adjuster_use_qp_prediction,  //
+      "vp8_s0_boost", &vp8_s0_boost,                              //
       "vp8_base_heavy_tl3_alloc", &vp8_base_heavy_tl3_alloc);
 }
 
@@ -180,4 +181,8 @@ bool RateControlSettings::BitrateAdjusterCanUseNetworkHeadroom() const {
   return video_config_.adjuster_use_headroom;
 }
 
+bool RateControlSettings::BitrateAdjusterCanUseQpPrediction() const {
+  return video_config_.adjuster_use_qp_prediction;
+}
+
 }  // namespace webrtc
@@ -40,6 +40,7 @@ struct VideoRateControlConfig {
   bool trust_vp9 = true;
   bool bitrate_adjuster = true;
   bool adjuster_use_headroom = true;
+  bool adjuster_use_qp_prediction = false;
   bool vp8_s0_boost = false;
   bool vp8_base_heavy_tl3_alloc = false;
 
@@ -80,6 +81,7 @@ class RateControlSettings final {
 
   bool UseEncoderBitrateAdjuster() const;
   bool BitrateAdjusterCanUseNetworkHeadroom() const;
+  bool BitrateAdjusterCanUseQpPrediction() const;
 
  private:
   explicit RateControlSettings(const FieldTrialsView* const key_value_config);
@@ -186,6 +186,20 @@ TEST(RateControlSettingsTest, UseEncoderBitrateAdjuster) {
   }
 }
 
+TEST(RateControlSettingsTest, BitrateAdjusterCanUseQpPrediction) {
+  // Should be off by default.
+  EXPECT_FALSE(RateControlSettings::ParseFromFieldTrials()
+                   .BitrateAdjusterCanUseQpPrediction());
+
+  {
+    // Can be turned on via field trial.
+    test::ScopedFieldTrials field_trials(
+        "WebRTC-VideoRateControl/adjuster_use_qp_prediction:true/");
+    EXPECT_TRUE(RateControlSettings::ParseFromFieldTrials()
+                    .BitrateAdjusterCanUseQpPrediction());
+  }
+}
+
 }  // namespace
 
 }  // namespace webrtc
@@ -0,0 +1,265 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/io_uring_poller.h"
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/system/arch.h"
+
+// In-place poll updates are only available from Linux 5.13, and not all
+// sysroots carry headers that recent.
+#if !defined(IORING_POLL_UPDATE_EVENTS)
+#define IORING_POLL_UPDATE_EVENTS (1U << 1)
+#endif
+#if !defined(IORING_FEAT_RSRC_TAGS)
+#define IORING_FEAT_RSRC_TAGS (1U << 10)
+#endif
+
+namespace rtc {
+namespace {
+
+// Marks the completions of update and remove requests.
+constexpr uint64_t kUpdateTag = uint64_t{1} << 63;
+constexpr uint64_t kRemoveUserData = ~uint64_t{0};
+
+int IoUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int fd,
+                 unsigned to_submit,
+                 unsigned min_complete,
+                 unsigned flags,
+                 const void* arg,
+                 size_t arg_size) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, arg, arg_size));
+}
+
+uint32_t ToPoll32Events(uint32_t events) {
+#if defined(WEBRTC_ARCH_BIG_ENDIAN)
+  // The kernel expects the two 16 bit halves swapped on big endian hosts.
+  return (events << 16) | (events >> 16);
+#else
+  return events;
+#endif
+}
+
+template <typename T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+}  // namespace
+
+std::unique_ptr<IoUringPoller> IoUringPoller::Create(unsigned queue_depth) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int fd = IoUringSetup(queue_depth, &params);
+  if (fd < 0) {
+    RTC_LOG_ERR(LS_INFO) << "io_uring_setup";
+    return nullptr;
+  }
+  // Single mmap, extended wait arguments and poll updates were all added no
+  // later than resource tags (Linux 5.13), which have a feature bit.
+  constexpr uint32_t kRequiredFeatures =
+      IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG |
+      IORING_FEAT_RSRC_TAGS;
+  if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+    RTC_LOG(LS_INFO) << "io_uring lacks features needed for polling.";
+    close(fd);
+    return nullptr;
+  }
+
+  // Both rings share one mapping.
+  size_t rings_size =
+      std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+               params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  void* rings = mmap(nullptr, rings_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+  if (rings == MAP_FAILED) {
+    RTC_LOG_ERR(LS_WARNING) << "mmap io_uring rings";
+    close(fd);
+    return nullptr;
+  }
+  size_t sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    RTC_LOG_ERR(LS_WARNING) << "mmap io_uring submission entries";
+    munmap(rings, rings_size);
+    close(fd);
+    return nullptr;
+  }
+  return std::unique_ptr<IoUringPoller>(new IoUringPoller(
+      fd, params, rings, rings_size, static_cast<io_uring_sqe*>(sqes)));
+}
+
+IoUringPoller::IoUringPoller(int ring_fd,
+                             const io_uring_params& params,
+                             void* rings,
+                             size_t rings_size,
+                             io_uring_sqe* sqes)
+    : ring_fd_(ring_fd),
+      rings_(rings),
+      rings_size_(rings_size),
+      sqes_(sqes),
+      sq_head_(RingField<unsigned>(rings, params.sq_off.head)),
+      sq_tail_(RingField<unsigned>(rings, params.sq_off.tail)),
+      sq_ring_mask_(*RingField<unsigned>(rings, params.sq_off.ring_mask)),
+      sq_ring_entries_(*RingField<unsigned>(rings, params.sq_off.ring_entries)),
+      sq_array_(RingField<unsigned>(rings, params.sq_off.array)),
+      cq_head_(RingField<unsigned>(rings, params.cq_off.head)),
+      cq_tail_(RingField<unsigned>(rings, params.cq_off.tail)),
+      cq_ring_mask_(*RingField<unsigned>(rings, params.cq_off.ring_mask)),
+      cqes_(RingField<io_uring_cqe>(rings, params.cq_off.cqes)),
+      sq_local_tail_(*sq_tail_) {}
+
+IoUringPoller::~IoUringPoller() {
+  munmap(sqes_, sq_ring_entries_ * sizeof(io_uring_sqe));
+  munmap(rings_, rings_size_);
+  close(ring_fd_);
+}
+
+io_uring_sqe* IoUringPoller::GetSqe() {
+  unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  if (sq_local_tail_ - head >= sq_ring_entries_) {
+    // The queue is full, hand the queued requests to the kernel first.
+    if (!Submit()) {
+      return nullptr;
+    }
+    head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (sq_local_tail_ - head >= sq_ring_entries_) {
+      return nullptr;
+    }
+  }
+  unsigned index = sq_local_tail_ & sq_ring_mask_;
+  io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sq_array_[index] = index;
+  ++sq_local_tail_;
+  return sqe;
+}
+
+void IoUringPoller::AddPoll(int fd, uint32_t events, uint64_t user_data) {
+  RTC_DCHECK_EQ(user_data & kUpdateTag, 0);
+  io_uring_sqe* sqe = GetSqe();
+  if (sqe == nullptr) {
+    RTC_LOG(LS_ERROR) << "io_uring submission queue overflow.";
+    return;
+  }
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  sqe->poll32_events = ToPoll32Events(events);
+  sqe->user_data = user_data;
+}
+
+void IoUringPoller::UpdatePoll(uint64_t user_data, uint32_t events) {
+  RTC_DCHECK_EQ(user_data & kUpdateTag, 0);
+  io_uring_sqe* sqe = GetSqe();
+  if (sqe == nullptr) {
+    RTC_LOG(LS_ERROR) << "io_uring submission queue overflow.";
+    return;
+  }
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = user_data;
+  sqe->poll32_events = ToPoll32Events(events);
+  sqe->len = IORING_POLL_UPDATE_EVENTS;
+  sqe->user_data = user_data | kUpdateTag;
+}
+
+void IoUringPoller::RemovePoll(uint64_t user_data) {
+  RTC_DCHECK_EQ(user_data & kUpdateTag, 0);
+  io_uring_sqe* sqe = GetSqe();
+  if (sqe == nullptr) {
+    RTC_LOG(LS_ERROR) << "io_uring submission queue overflow.";
+    return;
+  }
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = user_data;
+  sqe->user_data = kRemoveUserData;
+}
+
+bool IoUringPoller::Submit() {
+  unsigned to_submit = sq_local_tail_ - *sq_tail_;
+  if (to_submit == 0) {
+    return true;
+  }
+  __atomic_store_n(sq_tail_, sq_local_tail_, __ATOMIC_RELEASE);
+  while (to_submit > 0) {
+    int submitted = IoUringEnter(ring_fd_, to_submit, /*min_complete=*/0,
+                                 /*flags=*/0, /*arg=*/nullptr, /*arg_size=*/0);
+    if (submitted < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      RTC_LOG_ERR(LS_ERROR) << "io_uring_enter";
+      return false;
+    }
+    to_submit -= std::min<unsigned>(to_submit, submitted);
+  }
+  return true;
+}
+
+int IoUringPoller::WaitForCompletions(int timeout_ms) {
+  unsigned ready = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE) - *cq_head_;
+  if (ready > 0) {
+    return static_cast<int>(ready);
+  }
+  __kernel_timespec timeout;
+  io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  if (timeout_ms >= 0) {
+    timeout.tv_sec = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000000LL;
+    arg.ts = reinterpret_cast<uint64_t>(&timeout);
+  }
+  int result =
+      IoUringEnter(ring_fd_, /*to_submit=*/0, /*min_complete=*/1,
+                   IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg,
+                   sizeof(arg));
+  if (result < 0 && errno != ETIME) {
+    return -1;
+  }
+  return static_cast<int>(__atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE) -
+                          *cq_head_);
+}
+
+void IoUringPoller::ReapCompletions(
+    FunctionView<void(const Completion&)> on_completion) {
+  unsigned head = *cq_head_;
+  unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head) {
+    const io_uring_cqe& cqe = cqes_[head & cq_ring_mask_];
+    if (cqe.user_data == kRemoveUserData) {
+      continue;
+    }
+    Completion completion;
+    completion.user_data = cqe.user_data & ~kUpdateTag;
+    completion.result = cqe.res;
+    completion.is_update = (cqe.user_data & kUpdateTag) != 0;
+    on_completion(completion);
+  }
+  __atomic_store_n(cq_head_, tail, __ATOMIC_RELEASE);
+}
+
+}  // namespace rtc
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_IO_URING_POLLER_H_
+#define RTC_BASE_IO_URING_POLLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "api/function_view.h"
+
+struct io_uring_cqe;
+struct io_uring_params;
+struct io_uring_sqe;
+
+namespace rtc {
+
+// Readiness notifications for file descriptors through an io_uring instance,
+// used by PhysicalSocketServer as an alternative to epoll. Descriptors are
+// watched by one-shot poll requests, which gives the same level triggered
+// behavior as epoll when re-armed after each event. Requests to add, re-arm,
+// change or remove watches are queued and handed to the kernel together, so a
+// busy event loop needs a single system call per iteration.
+//
+// Not thread safe, callers must serialize all calls except
+// WaitForCompletions(), which may run concurrently with queueing and
+// submitting requests.
+class IoUringPoller {
+ public:
+  struct Completion {
+    // `user_data` of the poll request.
+    uint64_t user_data;
+    // For poll requests the ready events, or a negative errno. For update
+    // requests 0 or a negative errno.
+    int32_t result;
+    // True if this completes an UpdatePoll() request.
+    bool is_update;
+  };
+
+  // Returns null if io_uring, or one of the features needed here, is not
+  // available (kernels older than 5.13, or blocked by a sandbox).
+  static std::unique_ptr<IoUringPoller> Create(unsigned queue_depth);
+  ~IoUringPoller();
+
+  IoUringPoller(const IoUringPoller&) = delete;
+  IoUringPoller& operator=(const IoUringPoller&) = delete;
+
+  // Queues a request to wait once for the poll(2) `events` on `fd`.
+  // `user_data` identifies the request and is reported with its completion;
+  // values with the top bit set are reserved.
+  void AddPoll(int fd, uint32_t events, uint64_t user_data);
+  // Queues a request to change the events of the pending request
+  // `user_data`. Completes with -ENOENT if that request already completed.
+  void UpdatePoll(uint64_t user_data, uint32_t events);
+  // Queues a request to stop the watch `user_data`. Its final completion
+  // reports -ECANCELED.
+  void RemovePoll(uint64_t user_data);
+
+  // Hands all queued requests to the kernel.
+  bool Submit();
+
+  // Waits up to `timeout_ms`, or forever if negative, for completions.
+  // Returns the number of completions ready, 0 on timeout and -1 on error
+  // with errno set.
+  int WaitForCompletions(int timeout_ms);
+
+  // Calls `on_completion` for, and consumes, all ready completions.
+  void ReapCompletions(FunctionView<void(const Completion&)> on_completion);
+
+ private:
+  IoUringPoller(int ring_fd,
+                const io_uring_params& params,
+                void* rings,
+                size_t rings_size,
+                io_uring_sqe* sqes);
+
+  io_uring_sqe* GetSqe();
+
+  const int ring_fd_;
+  // Shared mapping of the submission and completion queue rings.
+  void* const rings_;
+  const size_t rings_size_;
+  io_uring_sqe* const sqes_;
+
+  const unsigned* const sq_head_;
+  unsigned* const sq_tail_;
+  const unsigned sq_ring_mask_;
+  const unsigned sq_ring_entries_;
+  unsigned* const sq_array_;
+  unsigned* const cq_head_;
+  const unsigned* const cq_tail_;
+  const unsigned cq_ring_mask_;
+  const io_uring_cqe* const cqes_;
+
+  // Local tail of the submission queue, published to the kernel by Submit().
+  unsigned sq_local_tail_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_IO_URING_POLLER_H_
@@ -14,9 +14,12 @@
 
 #include <cstdio>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/strings/string_builder.h"
 
 namespace rtc {
 
@@ -83,4 +86,96 @@ CallSessionFileRotatingLogSink::CallSessionFileRotatingLogSink(
 
 CallSessionFileRotatingLogSink::~CallSessionFileRotatingLogSink() {}
 
+AsyncLogSink::AsyncLogSink(LogSink* sink, size_t max_queued_messages)
+    : sink_(sink), max_queued_messages_(max_queued_messages) {
+  RTC_DCHECK(sink_);
+  RTC_DCHECK_GT(max_queued_messages_, 0);
+  thread_ = PlatformThread::SpawnJoinable(
+      [this] { Run(); }, "AsyncLogSink",
+      ThreadAttributes().SetPriority(ThreadPriority::kLow));
+}
+
+AsyncLogSink::~AsyncLogSink() {
+  {
+    webrtc::MutexLock lock(&mutex_);
+    stopping_ = true;
+  }
+  wakeup_.Set();
+  thread_.Finalize();
+}
+
+void AsyncLogSink::OnLogMessage(const std::string& message) {
+  Enqueue(message, LS_INFO);
+}
+
+void AsyncLogSink::OnLogMessage(const std::string& message,
+                                LoggingSeverity severity) {
+  Enqueue(message, severity);
+}
+
+void AsyncLogSink::OnLogMessage(absl::string_view message,
+                                LoggingSeverity severity) {
+  Enqueue(message, severity);
+}
+
+void AsyncLogSink::OnLogMessage(const LogLineRef& line) {
+  Enqueue(line.DefaultLogLine(), line.severity());
+}
+
+int64_t AsyncLogSink::dropped_messages() const {
+  webrtc::MutexLock lock(&mutex_);
+  return dropped_messages_;
+}
+
+void AsyncLogSink::Enqueue(absl::string_view message,
+                           LoggingSeverity severity) {
+  bool was_empty;
+  {
+    webrtc::MutexLock lock(&mutex_);
+    if (queue_.size() >= max_queued_messages_) {
+      ++pending_dropped_messages_;
+      ++dropped_messages_;
+      return;
+    }
+    was_empty = queue_.empty();
+    queue_.push_back({std::string(message), severity});
+  }
+  // The background thread takes the whole queue when woken up, so it only
+  // needs to be woken up for the first message.
+  if (was_empty) {
+    wakeup_.Set();
+  }
+}
+
+void AsyncLogSink::Run() {
+  std::vector<QueuedMessage> messages;
+  while (true) {
+    wakeup_.Wait(rtc::Event::kForever);
+    int64_t dropped_messages;
+    bool stopping;
+    {
+      webrtc::MutexLock lock(&mutex_);
+      // The previous batch is swapped back in, so that its capacity is reused.
+      messages.clear();
+      std::swap(messages, queue_);
+      dropped_messages = pending_dropped_messages_;
+      pending_dropped_messages_ = 0;
+      stopping = stopping_;
+    }
+    for (const QueuedMessage& message : messages) {
+      sink_->OnLogMessage(absl::string_view(message.message), message.severity);
+    }
+    if (dropped_messages > 0) {
+      char buffer[64];
+      SimpleStringBuilder builder(buffer);
+      builder << "(AsyncLogSink) Dropped " << dropped_messages
+              << " log messages.\n";
+      sink_->OnLogMessage(absl::string_view(builder.str()), LS_WARNING);
+    }
+    if (stopping) {
+      return;
+    }
+  }
+}
+
 }  // namespace rtc
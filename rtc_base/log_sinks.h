@@ -12,13 +12,19 @@
 #define RTC_BASE_LOG_SINKS_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "absl/strings/string_view.h"
+#include "rtc_base/event.h"
 #include "rtc_base/file_rotating_stream.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace rtc {
 
@@ -75,6 +81,58 @@ class CallSessionFileRotatingLogSink : public FileRotatingLogSink {
       const CallSessionFileRotatingLogSink&) = delete;
 };
 
+// Log sink that queues the messages and passes them on to another sink, e.g. a
+// FileRotatingLogSink, on a background thread. Logging threads then only have
+// to copy the formatted message, instead of waiting for the other sink to do
+// its I/O while holding the global logging lock. If the background thread
+// falls behind by more than `max_queued_messages`, new messages are dropped,
+// and a line with the number of dropped messages is passed on in their place.
+class AsyncLogSink : public LogSink {
+ public:
+  static constexpr size_t kDefaultMaxQueuedMessages = 10000;
+
+  // `sink` must outlive this object, and must not be added to LogMessage.
+  explicit AsyncLogSink(LogSink* sink,
+                        size_t max_queued_messages = kDefaultMaxQueuedMessages);
+  // Passes on all queued messages before returning.
+  ~AsyncLogSink() override;
+
+  AsyncLogSink(const AsyncLogSink&) = delete;
+  AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+  void OnLogMessage(const std::string& message) override;
+  void OnLogMessage(const std::string& message,
+                    LoggingSeverity severity) override;
+  void OnLogMessage(absl::string_view message,
+                    LoggingSeverity severity) override;
+  void OnLogMessage(const LogLineRef& line) override;
+
+  // Total number of messages dropped because the queue was full.
+  int64_t dropped_messages() const;
+
+ private:
+  struct QueuedMessage {
+    std::string message;
+    LoggingSeverity severity;
+  };
+
+  void Enqueue(absl::string_view message, LoggingSeverity severity);
+  void Run();
+
+  LogSink* const sink_;
+  const size_t max_queued_messages_;
+  rtc::Event wakeup_;
+  mutable webrtc::Mutex mutex_;
+  std::vector<QueuedMessage> queue_ RTC_GUARDED_BY(mutex_);
+  // Messages dropped since the last time the queue was taken by `Run()`.
+  int64_t pending_dropped_messages_ RTC_GUARDED_BY(mutex_) = 0;
+  int64_t dropped_messages_ RTC_GUARDED_BY(mutex_) = 0;
+  bool stopping_ RTC_GUARDED_BY(mutex_) = false;
+  // Must be last, so that the thread is joined before the members it uses are
+  // destroyed.
+  PlatformThread thread_;
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_LOG_SINKS_H_
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/log_sinks.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::HasSubstr;
+
+class RecordingLogSink : public LogSink {
+ public:
+  void OnLogMessage(const std::string& message) override {
+    OnLogMessage(absl::string_view(message));
+  }
+  void OnLogMessage(absl::string_view message) override {
+    entered_.Set();
+    gate_.Wait(Event::kForever);
+    webrtc::MutexLock lock(&mutex_);
+    messages_.emplace_back(message);
+  }
+
+  // Makes `OnLogMessage()` block until `OpenGate()` is called.
+  void CloseGate() { gate_.Reset(); }
+  void OpenGate() { gate_.Set(); }
+  void WaitUntilEntered() { entered_.Wait(Event::kForever); }
+
+  std::vector<std::string> messages() const {
+    webrtc::MutexLock lock(&mutex_);
+    return messages_;
+  }
+
+ private:
+  Event entered_;
+  Event gate_{/*manual_reset=*/true, /*initially_signaled=*/true};
+  mutable webrtc::Mutex mutex_;
+  std::vector<std::string> messages_;
+};
+
+TEST(AsyncLogSinkTest, PassesOnMessagesInOrder) {
+  RecordingLogSink sink;
+  {
+    AsyncLogSink async_sink(&sink);
+    async_sink.OnLogMessage(std::string("a"));
+    async_sink.OnLogMessage(absl::string_view("b"), LS_WARNING);
+    async_sink.OnLogMessage(std::string("c"), LS_INFO);
+  }
+  EXPECT_THAT(sink.messages(), ElementsAre("a", "b", "c"));
+}
+
+TEST(AsyncLogSinkTest, DropsMessagesWhenQueueIsFull) {
+  RecordingLogSink sink;
+  {
+    AsyncLogSink async_sink(&sink, /*max_queued_messages=*/2);
+    sink.CloseGate();
+    async_sink.OnLogMessage(std::string("1"));
+    // The background thread has taken the first message and is blocked, so
+    // the queue is empty.
+    sink.WaitUntilEntered();
+    async_sink.OnLogMessage(std::string("2"));
+    async_sink.OnLogMessage(std::string("3"));
+    async_sink.OnLogMessage(std::string("4"));
+    async_sink.OnLogMessage(std::string("5"));
+    EXPECT_EQ(async_sink.dropped_messages(), 2);
+    sink.OpenGate();
+  }
+  std::vector<std::string> messages = sink.messages();
+  ASSERT_EQ(messages.size(), 4u);
+  EXPECT_EQ(messages[0], "1");
+  EXPECT_EQ(messages[1], "2");
+  EXPECT_EQ(messages[2], "3");
+  EXPECT_THAT(messages[3], HasSubstr("Dropped 2 log messages"));
+}
+
+}  // namespace
+}  // namespace rtc
@@ -384,17 +384,15 @@ void NetworkManagerBase::MergeNetworkList(
     std::string key = MakeNetworkKey(network->name(), network->prefix(),
                                      network->prefix_length());
     const std::vector<InterfaceAddress>& addresses = network->GetIPs();
-    if (consolidated_address_list.find(key) ==
-        consolidated_address_list.end()) {
-      AddressList addrlist;
-      addrlist.net = std::move(network);
-      consolidated_address_list[key] = std::move(addrlist);
+    auto [it, inserted] =
+        consolidated_address_list.try_emplace(std::move(key));
+    AddressList& current_list = it->second;
+    current_list.ips.insert(current_list.ips.end(), addresses.begin(),
+                            addresses.end());
+    if (inserted) {
+      current_list.net = std::move(network);
       might_add_to_merged_list = true;
     }
-    AddressList& current_list = consolidated_address_list[key];
-    for (const InterfaceAddress& address : addresses) {
-      current_list.ips.push_back(address);
-    }
     if (might_add_to_merged_list) {
       if (current_list.ips[0].family() == AF_INET) {
         stats->ipv4_network_count++;
@@ -459,12 +457,13 @@ void NetworkManagerBase::MergeNetworkList(
   // and re-sort it.
   if (*changed) {
     networks_ = merged_list;
-    // Reset the active states of all networks.
+    // Reset the active states of all networks: those in the newly generated
+    // `networks_` are active.
     for (const auto& kv : networks_map_) {
-      const std::unique_ptr<Network>& network = kv.second;
-      // If `network` is in the newly generated `networks_`, it is active.
-      bool found = absl::c_linear_search(networks_, network.get());
-      network->set_active(found);
+      kv.second->set_active(false);
+    }
+    for (Network* network : networks_) {
+      network->set_active(true);
     }
     absl::c_sort(networks_, SortNetworks);
     // Now network interfaces are sorted, we should set the preference value
@@ -601,6 +600,41 @@ NetworkMonitorInterface::InterfaceInfo BasicNetworkManager::GetInterfaceInfo(
   }
 }
 
+bool BasicNetworkManager::UpdateInterfacesSnapshot(ifaddrs* interfaces) {
+  // Serializes the name, flags, address and netmask of every IPv4 and IPv6
+  // address. Other entries, such as the AF_PACKET ones with interface
+  // statistics on Linux, are skipped like in ConvertIfAddrs().
+  std::string snapshot;
+  snapshot.reserve(interfaces_snapshot_.size());
+  for (struct ifaddrs* cursor = interfaces; cursor != nullptr;
+       cursor = cursor->ifa_next) {
+    if (!cursor->ifa_addr || !cursor->ifa_netmask) {
+      continue;
+    }
+    size_t address_size;
+    if (cursor->ifa_addr->sa_family == AF_INET) {
+      address_size = sizeof(sockaddr_in);
+    } else if (cursor->ifa_addr->sa_family == AF_INET6) {
+      address_size = sizeof(sockaddr_in6);
+    } else {
+      continue;
+    }
+    snapshot.append(cursor->ifa_name);
+    snapshot.push_back('\0');
+    snapshot.append(reinterpret_cast<const char*>(&cursor->ifa_flags),
+                    sizeof(cursor->ifa_flags));
+    snapshot.append(reinterpret_cast<const char*>(cursor->ifa_addr),
+                    address_size);
+    snapshot.append(reinterpret_cast<const char*>(cursor->ifa_netmask),
+                    address_size);
+  }
+  if (snapshot == interfaces_snapshot_) {
+    return false;
+  }
+  interfaces_snapshot_ = std::move(snapshot);
+  return true;
+}
+
 void BasicNetworkManager::ConvertIfAddrs(
     struct ifaddrs* interfaces,
     IfAddrsConverter* ifaddrs_converter,
@@ -624,6 +658,12 @@ void BasicNetworkManager::ConvertIfAddrs(
         cursor->ifa_addr->sa_family != AF_INET6) {
       continue;
     }
+    // Skip interfaces that would be ignored by name before doing any work for
+    // them; on hosts with hundreds of virtual interfaces these are most of
+    // the list.
+    if (!include_ignored && IsIgnoredNetworkName(cursor->ifa_name)) {
+      continue;
+    }
     // Convert to InterfaceAddress.
     // TODO(webrtc:13114): Convert ConvertIfAddrs to use rtc::Netmask.
     if (!ifaddrs_converter->ConvertIfAddrsToIPAddress(cursor, &ip, &mask)) {
@@ -922,22 +962,12 @@ bool BasicNetworkManager::CreateNetworks(
 #endif  // WEBRTC_WIN
 
 bool BasicNetworkManager::IsIgnoredNetwork(const Network& network) const {
-  // Ignore networks on the explicit ignore list.
-  for (const std::string& ignored_name : network_ignore_list_) {
-    if (network.name() == ignored_name) {
-      return true;
-    }
-  }
-
-#if defined(WEBRTC_POSIX)
-  // Filter out VMware/VirtualBox interfaces, typically named vmnet1,
-  // vmnet8, or vboxnet0.
-  if (strncmp(network.name().c_str(), "vmnet", 5) == 0 ||
-      strncmp(network.name().c_str(), "vnic", 4) == 0 ||
-      strncmp(network.name().c_str(), "vboxnet", 7) == 0) {
+  // Ignore networks by the name of their interface.
+  if (IsIgnoredNetworkName(network.name())) {
     return true;
   }
-#elif defined(WEBRTC_WIN)
+
+#if defined(WEBRTC_WIN)
   // Ignore any HOST side vmware adapters with a description like:
   // VMware Virtual Ethernet Adapter for VMnet1
   // but don't ignore any GUEST side adapters with a description like:
@@ -955,6 +985,31 @@ bool BasicNetworkManager::IsIgnoredNetwork(const Network& network) const {
   return false;
 }
 
+bool BasicNetworkManager::IsIgnoredNetworkName(absl::string_view name) const {
+  // Ignore networks on the explicit ignore lists.
+  for (const std::string& ignored_name : network_ignore_list_) {
+    if (name == ignored_name) {
+      return true;
+    }
+  }
+  for (const std::string& ignored_prefix : network_ignore_prefix_list_) {
+    if (absl::StartsWith(name, ignored_prefix)) {
+      return true;
+    }
+  }
+
+#if defined(WEBRTC_POSIX)
+  // Filter out VMware/VirtualBox interfaces, typically named vmnet1,
+  // vmnet8, or vboxnet0.
+  if (absl::StartsWith(name, "vmnet") || absl::StartsWith(name, "vnic") ||
+      absl::StartsWith(name, "vboxnet")) {
+    return true;
+  }
+#endif
+
+  return false;
+}
+
 void BasicNetworkManager::StartUpdating() {
   thread_ = Thread::Current();
   // Redundant but necessary for thread annotations.
@@ -1057,10 +1112,41 @@ IPAddress BasicNetworkManager::QueryDefaultLocalAddress(int family) const {
   return socket->GetLocalAddress().ipaddr();
 }
 
+bool BasicNetworkManager::InterfacesMayHaveChanged() {
+#if defined(WEBRTC_LINUX)
+  // A network monitor may change the properties of a network without any
+  // change to its addresses, so the snapshot is only relied on without one.
+  // Other platforms may read address attributes that getifaddrs() doesn't
+  // return; see MacIfAddrsConverter.
+  if (network_monitor_) {
+    return true;
+  }
+  struct ifaddrs* interfaces;
+  if (getifaddrs(&interfaces) != 0) {
+    interfaces_snapshot_.clear();
+    return true;
+  }
+  bool changed = UpdateInterfacesSnapshot(interfaces);
+  freeifaddrs(interfaces);
+  return changed;
+#else
+  return true;
+#endif
+}
+
 void BasicNetworkManager::UpdateNetworksOnce() {
   if (!start_count_)
     return;
 
+  // Most periodic updates find the same interfaces as the previous one. Skip
+  // rebuilding and merging the networks then, which is the expensive part on
+  // hosts with many interfaces.
+  if (!InterfacesMayHaveChanged() && sent_first_update_) {
+    set_default_local_addresses(QueryDefaultLocalAddress(AF_INET),
+                                QueryDefaultLocalAddress(AF_INET6));
+    return;
+  }
+
   std::vector<std::unique_ptr<Network>> list;
   if (!CreateNetworks(false, &list)) {
     SignalError();
@@ -1285,7 +1371,12 @@ void BasicNetworkManager::set_vpn_list(const std::vector<NetworkMask>& vpn) {
   if (thread_ == nullptr) {
     vpn_ = vpn;
   } else {
-    thread_->BlockingCall([this, vpn] { vpn_ = vpn; });
+    thread_->BlockingCall([this, vpn] {
+      RTC_DCHECK_RUN_ON(thread_);
+      vpn_ = vpn;
+      // The networks depend on the VPN list; rebuild them on the next update.
+      interfaces_snapshot_.clear();
+    });
   }
 }
 
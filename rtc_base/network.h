@@ -301,6 +301,16 @@ class RTC_EXPORT BasicNetworkManager : public NetworkManagerBase,
     network_ignore_list_ = list;
   }
 
+  // Sets a list of interface name prefixes to ignore, such as "veth" for the
+  // virtual interfaces of containers. Addresses on interfaces that match are
+  // dropped before any network object is created for them, which keeps the
+  // enumeration cheap on hosts with many such interfaces.
+  // Should be called only before initialization.
+  void set_network_ignore_prefix_list(const std::vector<std::string>& list) {
+    RTC_DCHECK(thread_ == nullptr);
+    network_ignore_prefix_list_ = list;
+  }
+
   // Set a list of manually configured VPN's.
   void set_vpn_list(const std::vector<NetworkMask>& vpn) override;
 
@@ -326,6 +336,9 @@ class RTC_EXPORT BasicNetworkManager : public NetworkManagerBase,
       RTC_RUN_ON(thread_);
   NetworkMonitorInterface::InterfaceInfo GetInterfaceInfo(
       struct ifaddrs* cursor) const RTC_RUN_ON(thread_);
+  // Remembers the fields of `interfaces` that ConvertIfAddrs() uses, and
+  // returns true if they differ from the ones of the previous call.
+  bool UpdateInterfacesSnapshot(ifaddrs* interfaces) RTC_RUN_ON(thread_);
 #endif  // defined(WEBRTC_POSIX)
 
   // Creates a network object for each network available on the machine.
@@ -336,6 +349,8 @@ class RTC_EXPORT BasicNetworkManager : public NetworkManagerBase,
   // Determines if a network should be ignored. This should only be determined
   // based on the network's property instead of any individual IP.
   bool IsIgnoredNetwork(const Network& network) const RTC_RUN_ON(thread_);
+  // The part of IsIgnoredNetwork() that only depends on the interface name.
+  bool IsIgnoredNetworkName(absl::string_view name) const RTC_RUN_ON(thread_);
 
   // This function connects a UDP socket to a public address and returns the
   // local address associated it. Since it binds to the "any" address
@@ -356,6 +371,9 @@ class RTC_EXPORT BasicNetworkManager : public NetworkManagerBase,
   void UpdateNetworksContinually() RTC_RUN_ON(thread_);
   // Only updates the networks; does not reschedule the next update.
   void UpdateNetworksOnce() RTC_RUN_ON(thread_);
+  // Returns false if the interfaces are known not to have changed since the
+  // last update, in which case the networks don't need to be rebuilt.
+  bool InterfacesMayHaveChanged() RTC_RUN_ON(thread_);
 
   Thread* thread_ = nullptr;
   bool sent_first_update_ = true;
@@ -365,6 +383,7 @@ class RTC_EXPORT BasicNetworkManager : public NetworkManagerBase,
                              webrtc::FieldTrialBasedConfig>
       field_trials_;
   std::vector<std::string> network_ignore_list_;
+  std::vector<std::string> network_ignore_prefix_list_;
   NetworkMonitorFactory* const network_monitor_factory_;
   SocketFactory* const socket_factory_;
   std::unique_ptr<NetworkMonitorInterface> network_monitor_
@@ -373,6 +392,7 @@ class RTC_EXPORT BasicNetworkManager : public NetworkManagerBase,
   bool bind_using_ifname_ RTC_GUARDED_BY(thread_) = false;
 
   std::vector<NetworkMask> vpn_;
+  std::string interfaces_snapshot_ RTC_GUARDED_BY(thread_);
   rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> task_safety_flag_;
 };
 
@@ -15,6 +15,7 @@
 #include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "api/units/timestamp.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/system/rtc_export.h"
 
@@ -31,7 +32,8 @@ class RTC_EXPORT ReceivedPacket {
   ReceivedPacket(
       rtc::ArrayView<const uint8_t> payload,
       const SocketAddress& source_address,
-      absl::optional<webrtc::Timestamp> arrival_time = absl::nullopt);
+      absl::optional<webrtc::Timestamp> arrival_time = absl::nullopt,
+      EcnMarking ecn = EcnMarking::kNotEct);
 
   // Address/port of the packet sender.
   const SocketAddress& source_address() const { return source_address_; }
@@ -43,6 +45,10 @@ class RTC_EXPORT ReceivedPacket {
     return arrival_time_;
   }
 
+  // ECN codepoint of the IP header. Only read by sockets that have
+  // Socket::OPT_RECV_ECN enabled, kNotEct otherwise.
+  EcnMarking ecn() const { return ecn_; }
+
   static ReceivedPacket CreateFromLegacy(
       const char* data,
       size_t size,
@@ -52,6 +58,7 @@ class RTC_EXPORT ReceivedPacket {
  private:
   rtc::ArrayView<const uint8_t> payload_;
   absl::optional<webrtc::Timestamp> arrival_time_;
+  EcnMarking ecn_;
   const SocketAddress& source_address_;
 };
 
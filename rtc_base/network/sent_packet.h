@@ -61,6 +61,10 @@ struct RTC_EXPORT SentPacket {
 
   int64_t packet_id = -1;
   int64_t send_time_ms = -1;
+  // The same send time with microsecond precision, or -1 if only
+  // `send_time_ms` is known. Set by sockets that take the time right after
+  // handing the packet to the kernel.
+  int64_t send_time_us = -1;
   rtc::PacketInfo info;
 };
 
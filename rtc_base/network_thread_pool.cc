@@ -0,0 +1,36 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/network_thread_pool.h"
+
+#include <string>
+
+#include "rtc_base/checks.h"
+
+namespace rtc {
+
+NetworkThreadPool::NetworkThreadPool(size_t num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  threads_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {
+    std::unique_ptr<Thread> thread = Thread::CreateWithSocketServer();
+    thread->SetName("network_shard_" + std::to_string(i), nullptr);
+    thread->Start();
+    threads_.push_back(std::move(thread));
+  }
+}
+
+NetworkThreadPool::~NetworkThreadPool() {
+  for (std::unique_ptr<Thread>& thread : threads_) {
+    thread->Stop();
+  }
+}
+
+}  // namespace rtc
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NETWORK_THREAD_POOL_H_
+#define RTC_BASE_NETWORK_THREAD_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/system/rtc_export.h"
+#include "rtc_base/thread.h"
+
+namespace rtc {
+
+// Owns a fixed set of network threads, each running its own socket server
+// event loop. Servers can combine it with Socket::OPT_REUSEPORT to spread the
+// network I/O for a single address over several cores: create one
+// BasicPacketSocketFactory per shard on `thread(i)->socketserver()`, enable
+// SetUdpReusePort(), and bind one socket per shard. The kernel then balances
+// incoming flows between the shards.
+class RTC_EXPORT NetworkThreadPool {
+ public:
+  // Creates and starts `num_threads` threads. `num_threads` must be positive.
+  explicit NetworkThreadPool(size_t num_threads);
+  ~NetworkThreadPool();
+
+  NetworkThreadPool(const NetworkThreadPool&) = delete;
+  NetworkThreadPool& operator=(const NetworkThreadPool&) = delete;
+
+  size_t size() const { return threads_.size(); }
+  Thread* thread(size_t index) const { return threads_[index].get(); }
+
+  // Returns the shard for `key`, e.g. a hash of a connection's 5-tuple, so
+  // that all work for the same key runs on the same thread.
+  Thread* ThreadForKey(uint64_t key) const {
+    return threads_[key % threads_.size()].get();
+  }
+
+ private:
+  std::vector<std::unique_ptr<Thread>> threads_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_NETWORK_THREAD_POOL_H_
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/network_thread_pool.h"
+
+#include <set>
+
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+TEST(NetworkThreadPoolTest, RunsEachShardOnItsOwnThread) {
+  NetworkThreadPool pool(3);
+  ASSERT_EQ(pool.size(), 3u);
+  std::set<Thread*> threads;
+  for (size_t i = 0; i < pool.size(); ++i) {
+    Thread* thread = pool.thread(i);
+    ASSERT_TRUE(thread);
+    EXPECT_TRUE(thread->socketserver());
+    EXPECT_TRUE(thread->BlockingCall([thread] { return thread->IsCurrent(); }));
+    threads.insert(thread);
+  }
+  EXPECT_EQ(threads.size(), 3u);
+}
+
+TEST(NetworkThreadPoolTest, MapsKeysToStableShards) {
+  NetworkThreadPool pool(2);
+  EXPECT_EQ(pool.ThreadForKey(0), pool.thread(0));
+  EXPECT_EQ(pool.ThreadForKey(1), pool.thread(1));
+  EXPECT_EQ(pool.ThreadForKey(7), pool.ThreadForKey(7));
+}
+
+}  // namespace
+}  // namespace rtc
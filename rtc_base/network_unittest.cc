@@ -216,6 +216,12 @@ class NetworkTest : public ::testing::Test, public sigslot::has_slots<> {
                                    include_ignored, networks);
   }
 
+  static bool UpdateInterfacesSnapshot(BasicNetworkManager& network_manager,
+                                       struct ifaddrs* interfaces) {
+    RTC_DCHECK_RUN_ON(network_manager.thread_);
+    return network_manager.UpdateInterfacesSnapshot(interfaces);
+  }
+
   struct sockaddr_in6* CreateIpv6Addr(absl::string_view ip_string,
                                       uint32_t scope_id) {
     struct sockaddr_in6* ipv6_addr =
@@ -899,6 +905,63 @@ TEST_F(NetworkTest, TestConvertIfAddrsNotRunning) {
   EXPECT_TRUE(result.empty());
 }
 
+TEST_F(NetworkTest, TestConvertIfAddrsSkipsIgnoredPrefixes) {
+  char veth_name[20] = "veth1a2b3c";
+  char eth_name[20] = "eth0";
+  ifaddrs* list = nullptr;
+  list = AddIpv4Address(list, veth_name, "10.1.0.1", "255.255.255.0");
+  list = AddIpv4Address(list, eth_name, "192.168.0.2", "255.255.255.0");
+  PhysicalSocketServer socket_server;
+  BasicNetworkManager manager(&socket_server);
+  manager.set_network_ignore_prefix_list({"veth", "cali"});
+  manager.StartUpdating();
+
+  std::vector<std::unique_ptr<Network>> result;
+  CallConvertIfAddrs(manager, list, /*include_ignored=*/false, &result);
+  ASSERT_EQ(1U, result.size());
+  EXPECT_EQ("eth0", result[0]->name());
+
+  result.clear();
+  CallConvertIfAddrs(manager, list, /*include_ignored=*/true, &result);
+  ASSERT_EQ(2U, result.size());
+  for (const auto& network : result) {
+    EXPECT_EQ(network->name() == "veth1a2b3c", network->ignored());
+  }
+  ReleaseIfAddrs(list);
+}
+
+TEST_F(NetworkTest, TestUpdateInterfacesSnapshot) {
+  char if_name[20] = "eth0";
+  ifaddrs* list = nullptr;
+  list = AddIpv4Address(list, if_name, "192.168.0.2", "255.255.255.0");
+  PhysicalSocketServer socket_server;
+  BasicNetworkManager manager(&socket_server);
+  manager.StartUpdating();
+  EXPECT_TRUE(UpdateInterfacesSnapshot(manager, list));
+  EXPECT_FALSE(UpdateInterfacesSnapshot(manager, list));
+
+  // Entries without an IP address are not part of the snapshot.
+  ifaddrs packet_entry;
+  memset(&packet_entry, 0, sizeof(packet_entry));
+  packet_entry.ifa_name = if_name;
+  sockaddr packet_addr;
+  memset(&packet_addr, 0, sizeof(packet_addr));
+  packet_addr.sa_family = AF_UNSPEC;
+  packet_entry.ifa_addr = &packet_addr;
+  packet_entry.ifa_netmask = &packet_addr;
+  packet_entry.ifa_next = list;
+  EXPECT_FALSE(UpdateInterfacesSnapshot(manager, &packet_entry));
+
+  // A new address, or a change of flags, is a change.
+  list = AddIpv6Address(list, if_name, "1000:2000:3000:4000:0:0:0:1",
+                        "FFFF:FFFF:FFFF:FFFF::", 0);
+  EXPECT_TRUE(UpdateInterfacesSnapshot(manager, list));
+  list->ifa_flags = 0;
+  EXPECT_TRUE(UpdateInterfacesSnapshot(manager, list));
+  EXPECT_FALSE(UpdateInterfacesSnapshot(manager, list));
+  ReleaseIfAddrs(list);
+}
+
 TEST_F(NetworkTest, TestConvertIfAddrsGetsNullAddr) {
   ifaddrs list;
   memset(&list, 0, sizeof(list));
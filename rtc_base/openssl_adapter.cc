@@ -603,6 +603,14 @@ int OpenSSLAdapter::Recv(void* pv, size_t cb, int64_t* timestamp) {
 
   switch (error) {
     case SSL_ERROR_NONE:
+      if (ssl_mode_ == SSL_MODE_TLS) {
+        // SSL_read returns the contents of a single record, which readers
+        // such as AsyncTCPSocket take to mean that the socket has been
+        // drained. Keep reading the records that have already arrived, so
+        // that a burst of them is handled in one read event rather than in
+        // one per record. DTLS records are datagrams and are not merged.
+        code += ReadAvailableRecords(static_cast<char*>(pv) + code, cb - code);
+      }
       return code;
     case SSL_ERROR_WANT_READ:
       SetError(EWOULDBLOCK);
@@ -626,6 +634,23 @@ int OpenSSLAdapter::Recv(void* pv, size_t cb, int64_t* timestamp) {
   return SOCKET_ERROR;
 }
 
+int OpenSSLAdapter::ReadAvailableRecords(char* buffer, size_t size) {
+  int total = 0;
+  while (static_cast<size_t>(total) < size) {
+    int code = SSL_read(ssl_, buffer + total, checked_cast<int>(size - total));
+    if (code <= 0) {
+      // Errors are reported by the next call to Recv, after the data read so
+      // far has been returned.
+      if (SSL_get_error(ssl_, code) == SSL_ERROR_WANT_WRITE) {
+        ssl_read_needs_write_ = true;
+      }
+      break;
+    }
+    total += code;
+  }
+  return total;
+}
+
 int OpenSSLAdapter::RecvFrom(void* pv,
                              size_t cb,
                              SocketAddress* paddr,
@@ -114,6 +114,9 @@ class OpenSSLAdapter final : public SSLAdapter {
   // Return value and arguments have the same meanings as for Send; `error` is
   // an output parameter filled with the result of SSL_get_error.
   int DoSslWrite(const void* pv, size_t cb, int* error);
+  // Reads the records that can be decrypted without blocking into `buffer`,
+  // after a successful SSL_read. Returns the number of bytes read.
+  int ReadAvailableRecords(char* buffer, size_t size);
   bool SSLPostConnectionCheck(SSL* ssl, absl::string_view host);
 
   // Logs info about the state of the SSL connection.
@@ -9,6 +9,7 @@
  */
 #include "rtc_base/physical_socket_server.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <utility>
 
@@ -55,6 +56,16 @@
 
 #if defined(WEBRTC_LINUX)
 #include <linux/sockios.h>
+#include <netinet/udp.h>
+
+// UDP generic segmentation and receive offload, available since Linux 4.18
+// and 5.0 respectively. Not all libc headers define them yet.
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
+#if !defined(UDP_GRO)
+#define UDP_GRO 104
+#endif
 #endif
 
 #if defined(WEBRTC_WIN)
@@ -93,6 +104,60 @@ int64_t GetSocketRecvTimestamp(int socket) {
 }
 #endif
 
+#if defined(WEBRTC_POSIX)
+// Returns the SCM_TIMESTAMP carried in the control data of `msg` in
+// microseconds, or -1 if there is none.
+int64_t GetScmTimestamp(msghdr& msg) {
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level != SOL_SOCKET)
+      continue;
+    if (cmsg->cmsg_type == SCM_TIMESTAMP) {
+      timeval* ts = reinterpret_cast<timeval*>(CMSG_DATA(cmsg));
+      return rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts->tv_sec) +
+             static_cast<int64_t>(ts->tv_usec);
+    }
+  }
+  return -1;
+}
+#endif  // WEBRTC_POSIX
+
+#if defined(WEBRTC_LINUX)
+// Returns the segment size of a datagram coalesced by UDP GRO, or 0 if `msg`
+// holds a single datagram.
+size_t GetUdpGroSegmentSize(msghdr& msg) {
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_UDP && cmsg->cmsg_type == UDP_GRO) {
+      int segment_size;
+      memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(segment_size));
+      return segment_size > 0 ? segment_size : 0;
+    }
+  }
+  return 0;
+}
+
+// Returns the ECN codepoint of the TOS / Traffic Class byte carried in the
+// control data of `msg`, kNotEct if there is none.
+rtc::EcnMarking GetEcnMarking(msghdr& msg) {
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg;
+       cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    int tos;
+    if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_TOS) {
+      // IPv4 delivers the TOS as a single byte.
+      tos = *reinterpret_cast<const uint8_t*>(CMSG_DATA(cmsg));
+    } else if (cmsg->cmsg_level == IPPROTO_IPV6 &&
+               cmsg->cmsg_type == IPV6_TCLASS) {
+      memcpy(&tos, CMSG_DATA(cmsg), sizeof(tos));
+    } else {
+      continue;
+    }
+    return static_cast<rtc::EcnMarking>(tos & 3);
+  }
+  return rtc::EcnMarking::kNotEct;
+}
+#endif  // WEBRTC_LINUX
+
 #if defined(WEBRTC_WIN)
 typedef char* SockOptArg;
 #endif
@@ -315,6 +380,9 @@ int PhysicalSocket::GetOption(Option opt, int* value) {
     // unshift DSCP value to get six most significant bits of IP DiffServ field
     *value >>= 2;
 #endif
+  } else if (opt == OPT_SEND_ECN) {
+    // The ECN codepoint is the two least significant bits of the TOS field.
+    *value &= 3;
   }
   return ret;
 }
@@ -330,16 +398,23 @@ int PhysicalSocket::SetOption(Option opt, int value) {
 #endif
   } else if (opt == OPT_DSCP) {
 #if defined(WEBRTC_POSIX)
-    // shift DSCP value to fit six most significant bits of IP DiffServ field
-    value <<= 2;
+    // DSCP and ECN share the TOS field, keep the ECN codepoint.
+    dscp_ = value;
+    value = (dscp_ << 2) | ecn_;
 #endif
+  } else if (opt == OPT_SEND_ECN) {
+    ecn_ = value & 3;
+    value = (dscp_ << 2) | ecn_;
   }
 #if defined(WEBRTC_POSIX)
+  // Set the IPv4 option in all cases to support dual-stack sockets.
+  // Don't bother checking the return code, as this is expected to fail if
+  // it's not actually dual-stack.
   if (sopt == IPV6_TCLASS) {
-    // Set the IPv4 option in all cases to support dual-stack sockets.
-    // Don't bother checking the return code, as this is expected to fail if
-    // it's not actually dual-stack.
     ::setsockopt(s_, IPPROTO_IP, IP_TOS, (SockOptArg)&value, sizeof(value));
+  } else if (sopt == IPV6_RECVTCLASS) {
+    ::setsockopt(s_, IPPROTO_IP, IP_RECVTOS, (SockOptArg)&value,
+                 sizeof(value));
   }
 #endif
   int result =
@@ -400,6 +475,117 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+int PhysicalSocket::SendToBatch(rtc::ArrayView<const SendSlot> slots) {
+#if defined(WEBRTC_LINUX)
+  if (!udp_) {
+    return Socket::SendToBatch(slots);
+  }
+  size_t sent = 0;
+  while (sent < slots.size()) {
+    bool used_gso = false;
+    int result = DoSendBatchToSocket(slots.subview(sent), &used_gso);
+    if (result < 0 && used_gso && (errno == EIO || errno == EINVAL)) {
+      // Segmentation offload is not supported by the kernel or the network
+      // device, don't try it again on this socket.
+      RTC_LOG(LS_INFO) << "UDP GSO not available, errno: " << errno;
+      udp_gso_enabled_ = false;
+      continue;
+    }
+    if (result <= 0) {
+      break;
+    }
+    sent += result;
+  }
+  UpdateLastError();
+  MaybeRemapSendError();
+  if (sent < slots.size() && IsBlockingError(GetError())) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent > 0 ? static_cast<int>(sent) : -1;
+#else
+  return Socket::SendToBatch(slots);
+#endif
+}
+
+#if defined(WEBRTC_LINUX)
+int PhysicalSocket::DoSendBatchToSocket(rtc::ArrayView<const SendSlot> slots,
+                                        bool* used_gso) {
+  // Bounds the stack usage of the per-datagram bookkeeping below.
+  static constexpr size_t kMaxBatchSize = 64;
+  // Largest UDP payload the kernel accepts in a single (GSO) send.
+  static constexpr size_t kMaxUdpPayloadSize = 65507;
+  struct alignas(cmsghdr) Control {
+    char data[CMSG_SPACE(sizeof(uint16_t))];
+  };
+  const size_t batch_size = std::min(slots.size(), kMaxBatchSize);
+  std::array<mmsghdr, kMaxBatchSize> messages;
+  std::array<iovec, kMaxBatchSize> iovs;
+  std::array<sockaddr_storage, kMaxBatchSize> addrs;
+  std::array<Control, kMaxBatchSize> controls;
+  std::array<size_t, kMaxBatchSize> datagrams_in_message;
+  size_t num_messages = 0;
+  for (size_t i = 0; i < batch_size;) {
+    // Consecutive datagrams of the same size to the same destination are
+    // handed to the kernel as one segmented message. Only the final segment
+    // may be shorter.
+    const SendSlot& first = slots[i];
+    size_t run = 1;
+    size_t run_bytes = first.size;
+    while (udp_gso_enabled_ && i + run < batch_size &&
+           slots[i + run - 1].size == first.size &&
+           slots[i + run].size <= first.size &&
+           run_bytes + slots[i + run].size <= kMaxUdpPayloadSize &&
+           slots[i + run].destination == first.destination) {
+      run_bytes += slots[i + run].size;
+      ++run;
+    }
+    for (size_t j = 0; j < run; ++j) {
+      iovs[i + j] = {.iov_base = const_cast<void*>(slots[i + j].data),
+                     .iov_len = slots[i + j].size};
+    }
+    mmsghdr& message = messages[num_messages];
+    message = {};
+    message.msg_hdr.msg_name = &addrs[num_messages];
+    message.msg_hdr.msg_namelen =
+        first.destination.ToSockAddrStorage(&addrs[num_messages]);
+    message.msg_hdr.msg_iov = &iovs[i];
+    message.msg_hdr.msg_iovlen = run;
+    if (run > 1) {
+      Control& control = controls[num_messages];
+      message.msg_hdr.msg_control = control.data;
+      message.msg_hdr.msg_controllen = sizeof(control.data);
+      cmsghdr* cmsg = CMSG_FIRSTHDR(&message.msg_hdr);
+      cmsg->cmsg_level = SOL_UDP;
+      cmsg->cmsg_type = UDP_SEGMENT;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+      const uint16_t segment_size = static_cast<uint16_t>(first.size);
+      memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+      *used_gso = true;
+    }
+    datagrams_in_message[num_messages] = run;
+    ++num_messages;
+    i += run;
+  }
+  int sent_messages = ::sendmmsg(s_, messages.data(), num_messages,
+#if !defined(WEBRTC_ANDROID)
+                                 // Suppress SIGPIPE. See above for
+                                 // explanation.
+                                 MSG_NOSIGNAL
+#else
+                                 0
+#endif
+  );
+  if (sent_messages < 0) {
+    return sent_messages;
+  }
+  int sent = 0;
+  for (int i = 0; i < sent_messages; ++i) {
+    sent += datagrams_in_message[i];
+  }
+  return sent;
+}
+#endif  // WEBRTC_LINUX
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received =
       DoReadFromSocket(buffer, length, /*out_addr*/ nullptr, timestamp);
@@ -444,6 +630,70 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+int PhysicalSocket::RecvFromBatch(rtc::ArrayView<ReceiveSlot> slots) {
+#if defined(WEBRTC_LINUX)
+  if (!udp_) {
+    return Socket::RecvFromBatch(slots);
+  }
+  int received = DoReadBatchFromSocket(slots);
+  UpdateLastError();
+  int error = GetError();
+  bool success = (received >= 0) || IsBlockingError(error);
+  EnableEvents(DE_READ);
+  if (!success) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << error;
+  }
+  return received;
+#else
+  return Socket::RecvFromBatch(slots);
+#endif
+}
+
+#if defined(WEBRTC_LINUX)
+int PhysicalSocket::DoReadBatchFromSocket(rtc::ArrayView<ReceiveSlot> slots) {
+  // Bounds the stack usage of the per-datagram bookkeeping below.
+  static constexpr size_t kMaxBatchSize = 64;
+  const size_t batch_size = std::min(slots.size(), kMaxBatchSize);
+  if (batch_size == 0) {
+    return 0;
+  }
+  struct alignas(cmsghdr) Control {
+    char data[CMSG_SPACE(sizeof(struct timeval)) + CMSG_SPACE(sizeof(int)) +
+              CMSG_SPACE(sizeof(int))];
+  };
+  std::array<mmsghdr, kMaxBatchSize> messages;
+  std::array<iovec, kMaxBatchSize> iovs;
+  std::array<sockaddr_storage, kMaxBatchSize> addrs;
+  std::array<Control, kMaxBatchSize> controls;
+  for (size_t i = 0; i < batch_size; ++i) {
+    iovs[i] = {.iov_base = slots[i].data, .iov_len = slots[i].capacity};
+    messages[i] = {};
+    messages[i].msg_hdr.msg_iov = &iovs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+    messages[i].msg_hdr.msg_name = &addrs[i];
+    messages[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    messages[i].msg_hdr.msg_control = controls[i].data;
+    messages[i].msg_hdr.msg_controllen = sizeof(controls[i].data);
+  }
+  int received = ::recvmmsg(s_, messages.data(), batch_size, MSG_DONTWAIT,
+                            /*timeout=*/nullptr);
+  if (received <= 0) {
+    return received;
+  }
+  for (int i = 0; i < received; ++i) {
+    msghdr& msg = messages[i].msg_hdr;
+    ReceiveSlot& slot = slots[i];
+    slot.size = messages[i].msg_len;
+    slot.truncated = (msg.msg_flags & MSG_TRUNC) != 0;
+    slot.timestamp = read_scm_timestamp_experiment_ ? GetScmTimestamp(msg) : -1;
+    slot.segment_size = GetUdpGroSegmentSize(msg);
+    slot.ecn = GetEcnMarking(msg);
+    SocketAddressFromSockAddrStorage(addrs[i], &slot.source_address);
+  }
+  return received;
+}
+#endif  // WEBRTC_LINUX
+
 int PhysicalSocket::DoReadFromSocket(void* buffer,
                                      size_t length,
                                      SocketAddress* out_addr,
@@ -474,18 +724,7 @@ int PhysicalSocket::DoReadFromSocket(void* buffer,
       return received;
     }
     if (timestamp) {
-      struct cmsghdr* cmsg;
-      for (cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
-        if (cmsg->cmsg_level != SOL_SOCKET)
-          continue;
-        if (cmsg->cmsg_type == SCM_TIMESTAMP) {
-          timeval* ts = reinterpret_cast<timeval*>(CMSG_DATA(cmsg));
-          *timestamp =
-              rtc::kNumMicrosecsPerSec * static_cast<int64_t>(ts->tv_sec) +
-              static_cast<int64_t>(ts->tv_usec);
-          break;
-        }
-      }
+      *timestamp = GetScmTimestamp(msg);
     }
     if (out_addr) {
       SocketAddressFromSockAddrStorage(addr_storage, out_addr);
@@ -662,6 +901,7 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
       *sopt = TCP_NODELAY;
       break;
     case OPT_DSCP:
+    case OPT_SEND_ECN:
 #if defined(WEBRTC_POSIX)
       if (family_ == AF_INET6) {
         *slevel = IPPROTO_IPV6;
@@ -674,9 +914,41 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
 #else
       RTC_LOG(LS_WARNING) << "Socket::OPT_DSCP not supported.";
       return -1;
+#endif
+    case OPT_RECV_ECN:
+#if defined(WEBRTC_POSIX)
+      if (family_ == AF_INET6) {
+        *slevel = IPPROTO_IPV6;
+        *sopt = IPV6_RECVTCLASS;
+      } else {
+        *slevel = IPPROTO_IP;
+        *sopt = IP_RECVTOS;
+      }
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_RECV_ECN not supported.";
+      return -1;
 #endif
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
+    case OPT_UDP_GRO:
+#if defined(WEBRTC_LINUX)
+      *slevel = SOL_UDP;
+      *sopt = UDP_GRO;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_UDP_GRO not supported.";
+      return -1;
+#endif
+    case OPT_REUSEPORT:
+#if defined(SO_REUSEPORT)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_REUSEPORT;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_REUSEPORT not supported.";
+      return -1;
+#endif
     default:
       RTC_DCHECK_NOTREACHED();
       return -1;
@@ -1141,19 +1413,27 @@ class Signaler : public Dispatcher {
 #endif  // WEBRTC_WIN
 
 PhysicalSocketServer::PhysicalSocketServer()
+    : PhysicalSocketServer(Backend::kDefault) {}
+
+PhysicalSocketServer::PhysicalSocketServer(Backend backend)
     :
+#if defined(WEBRTC_USE_IO_URING)
+      io_uring_(backend == Backend::kIoUring
+                    ? IoUringPoller::Create(kIoUringQueueDepth)
+                    : nullptr),
+#endif
 #if defined(WEBRTC_USE_EPOLL)
       // Since Linux 2.6.8, the size argument is ignored, but must be greater
       // than zero. Before that the size served as hint to the kernel for the
       // amount of space to initially allocate in internal data structures.
-      epoll_fd_(epoll_create(FD_SETSIZE)),
+      epoll_fd_(uses_io_uring() ? INVALID_SOCKET : epoll_create(FD_SETSIZE)),
 #endif
 #if defined(WEBRTC_WIN)
       socket_ev_(WSACreateEvent()),
 #endif
       fWait_(false) {
 #if defined(WEBRTC_USE_EPOLL)
-  if (epoll_fd_ == -1) {
+  if (epoll_fd_ == -1 && !uses_io_uring()) {
     // Not an error, will fall back to "select" below.
     RTC_LOG_E(LS_WARNING, EN, errno) << "epoll_create";
     // Note that -1 == INVALID_SOCKET, the alias used by later checks.
@@ -1177,6 +1457,14 @@ PhysicalSocketServer::~PhysicalSocketServer() {
   RTC_DCHECK(key_by_dispatcher_.empty());
 }
 
+bool PhysicalSocketServer::uses_io_uring() const {
+#if defined(WEBRTC_USE_IO_URING)
+  return io_uring_ != nullptr;
+#else
+  return false;
+#endif
+}
+
 void PhysicalSocketServer::WakeUp() {
   signal_wakeup_->Signal();
 }
@@ -1211,6 +1499,11 @@ void PhysicalSocketServer::Add(Dispatcher* pdispatcher) {
   uint64_t key = next_dispatcher_key_++;
   dispatcher_by_key_.emplace(key, pdispatcher);
   key_by_dispatcher_.emplace(pdispatcher, key);
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    AddIoUring(pdispatcher, key);
+  }
+#endif  // WEBRTC_USE_IO_URING
 #if defined(WEBRTC_USE_EPOLL)
   if (epoll_fd_ != INVALID_SOCKET) {
     AddEpoll(pdispatcher, key);
@@ -1229,6 +1522,11 @@ void PhysicalSocketServer::Remove(Dispatcher* pdispatcher) {
   uint64_t key = key_by_dispatcher_.at(pdispatcher);
   key_by_dispatcher_.erase(pdispatcher);
   dispatcher_by_key_.erase(key);
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    RemoveIoUring(key);
+  }
+#endif  // WEBRTC_USE_IO_URING
 #if defined(WEBRTC_USE_EPOLL)
   if (epoll_fd_ != INVALID_SOCKET) {
     RemoveEpoll(pdispatcher);
@@ -1238,7 +1536,7 @@ void PhysicalSocketServer::Remove(Dispatcher* pdispatcher) {
 
 void PhysicalSocketServer::Update(Dispatcher* pdispatcher) {
 #if defined(WEBRTC_USE_EPOLL)
-  if (epoll_fd_ == INVALID_SOCKET) {
+  if (epoll_fd_ == INVALID_SOCKET && !uses_io_uring()) {
     return;
   }
 
@@ -1248,6 +1546,12 @@ void PhysicalSocketServer::Update(Dispatcher* pdispatcher) {
     return;
   }
 
+#if defined(WEBRTC_USE_IO_URING)
+  if (io_uring_) {
+    UpdateIoUring(pdispatcher, key_by_dispatcher_.at(pdispatcher));
+    return;
+  }
+#endif  // WEBRTC_USE_IO_URING
   UpdateEpoll(pdispatcher, key_by_dispatcher_.at(pdispatcher));
 #endif
 }
@@ -1276,6 +1580,10 @@ bool PhysicalSocketServer::Wait(webrtc::TimeDelta max_wait_duration,
   // "select" to support sockets larger than FD_SETSIZE.
   if (!process_io) {
     return WaitPollOneDispatcher(cmsWait, signal_wakeup_);
+#if defined(WEBRTC_USE_IO_URING)
+  } else if (io_uring_) {
+    return WaitIoUring(cmsWait);
+#endif
   } else if (epoll_fd_ != INVALID_SOCKET) {
     return WaitEpoll(cmsWait);
   }
@@ -1638,6 +1946,202 @@ bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
   return true;
 }
 
+#if defined(WEBRTC_USE_IO_URING)
+
+// Poll request user data, combining a dispatcher key with the generation of
+// its watch. The generation takes the low 32 bits so that it only wraps after
+// 2^32 requests, long after any superseded request has completed; the key
+// gets the high 32 bits, enough for 2^32 dispatchers.
+static constexpr int kIoUringGenerationBits = 32;
+
+static uint64_t ToIoUringUserData(uint64_t key, uint32_t generation) {
+  RTC_DCHECK_LT(key, uint64_t{1} << (64 - kIoUringGenerationBits));
+  return (key << kIoUringGenerationBits) | generation;
+}
+
+void PhysicalSocketServer::AddIoUring(Dispatcher* pdispatcher, uint64_t key) {
+  uint32_t events = GetEpollEvents(pdispatcher->GetRequestedEvents());
+  if (events == 0u) {
+    // As with epoll, don't watch dispatchers without requested events.
+    return;
+  }
+  IoUringWatch& watch = io_uring_watches_[key];
+  watch.events = events;
+  ArmIoUring(pdispatcher, key, watch);
+  SubmitIoUringIfWaiting();
+}
+
+void PhysicalSocketServer::RemoveIoUring(uint64_t key) {
+  auto it = io_uring_watches_.find(key);
+  if (it == io_uring_watches_.end()) {
+    return;
+  }
+  if (it->second.armed) {
+    io_uring_->RemovePoll(ToIoUringUserData(key, it->second.generation));
+    // A pending poll request keeps the file open, so submit the removal
+    // right away rather than holding on to a closed socket until the next
+    // wait.
+    io_uring_->Submit();
+  }
+  io_uring_watches_.erase(it);
+}
+
+void PhysicalSocketServer::UpdateIoUring(Dispatcher* pdispatcher,
+                                         uint64_t key) {
+  uint32_t events = GetEpollEvents(pdispatcher->GetRequestedEvents());
+  auto it = io_uring_watches_.find(key);
+  if (it == io_uring_watches_.end()) {
+    AddIoUring(pdispatcher, key);
+    return;
+  }
+  IoUringWatch& watch = it->second;
+  if (events == 0u) {
+    // Could indicate a closed socket.
+    if (watch.armed) {
+      io_uring_->RemovePoll(ToIoUringUserData(key, watch.generation));
+      SubmitIoUringIfWaiting();
+    }
+    io_uring_watches_.erase(it);
+  } else if (events != watch.events) {
+    watch.events = events;
+    // A watch that is not armed gets the new events when it is re-armed.
+    if (watch.armed) {
+      io_uring_->UpdatePoll(ToIoUringUserData(key, watch.generation), events);
+      SubmitIoUringIfWaiting();
+    }
+  }
+}
+
+void PhysicalSocketServer::ArmIoUring(Dispatcher* pdispatcher,
+                                      uint64_t key,
+                                      IoUringWatch& watch) {
+  int fd = pdispatcher->GetDescriptor();
+  RTC_DCHECK(fd != INVALID_SOCKET);
+  if (fd == INVALID_SOCKET) {
+    return;
+  }
+  // Generations are not restarted for a new watch of the same dispatcher, so
+  // completions of the watch it replaced are not mistaken for its own.
+  watch.generation = ++next_io_uring_generation_;
+  watch.armed = true;
+  // epoll and poll events share their values. The request is submitted with
+  // the next wait.
+  io_uring_->AddPoll(fd, watch.events,
+                     ToIoUringUserData(key, watch.generation));
+}
+
+void PhysicalSocketServer::ProcessIoUringCompletion(
+    const IoUringPoller::Completion& completion) {
+  if (completion.is_update) {
+    // -ENOENT means the poll request completed before the update reached
+    // it; it is re-armed with the new events after that completion.
+    if (completion.result < 0 && completion.result != -ENOENT) {
+      RTC_LOG(LS_ERROR) << "io_uring poll update failed: "
+                        << -completion.result;
+    }
+    return;
+  }
+  const uint64_t key = completion.user_data >> kIoUringGenerationBits;
+  auto watch_it = io_uring_watches_.find(key);
+  if (watch_it == io_uring_watches_.end() || !watch_it->second.armed ||
+      ToIoUringUserData(key, watch_it->second.generation) !=
+          completion.user_data) {
+    // A request that was removed, e.g. -ECANCELED, or one that completed
+    // while its removal was on the way.
+    return;
+  }
+  watch_it->second.armed = false;
+  if (completion.result < 0) {
+    RTC_LOG(LS_ERROR) << "io_uring poll failed: " << -completion.result;
+    return;
+  }
+  auto dispatcher_it = dispatcher_by_key_.find(key);
+  if (dispatcher_it == dispatcher_by_key_.end()) {
+    // The dispatcher for this socket no longer exists.
+    return;
+  }
+  Dispatcher* pdispatcher = dispatcher_it->second;
+
+  uint32_t revents = static_cast<uint32_t>(completion.result);
+  bool readable = (revents & (EPOLLIN | EPOLLPRI));
+  bool writable = (revents & EPOLLOUT);
+  bool error = (revents & (EPOLLRDHUP | EPOLLERR | EPOLLHUP));
+  ProcessEvents(pdispatcher, readable, writable, error, error);
+
+  // Handling the event may have changed or removed the watch. If it is still
+  // there, re-arm it, which reports right away if the socket is still ready.
+  watch_it = io_uring_watches_.find(key);
+  if (watch_it != io_uring_watches_.end() && !watch_it->second.armed &&
+      dispatcher_by_key_.count(key)) {
+    ArmIoUring(pdispatcher, key, watch_it->second);
+  }
+}
+
+void PhysicalSocketServer::SubmitIoUringIfWaiting() {
+  // The waiting thread submits queued requests before it blocks, but a request
+  // queued by another thread while it is blocked would otherwise not reach the
+  // kernel until the wait ends, e.g. a socket added from another thread would
+  // not be watched until the next timeout.
+  if (io_uring_waiting_) {
+    io_uring_->Submit();
+  }
+}
+
+bool PhysicalSocketServer::WaitIoUring(int cmsWait) {
+  RTC_DCHECK(io_uring_);
+  int64_t msWait = -1;
+  int64_t msStop = -1;
+  if (cmsWait != kForeverMs) {
+    msWait = cmsWait;
+    msStop = TimeAfter(cmsWait);
+  }
+
+  fWait_ = true;
+  while (fWait_) {
+    {
+      // Requests are queued under `crit_`, possibly from other threads.
+      CritScope cr(&crit_);
+      if (!io_uring_->Submit()) {
+        return false;
+      }
+      io_uring_waiting_ = true;
+    }
+    int n = io_uring_->WaitForCompletions(static_cast<int>(msWait));
+    {
+      CritScope cr(&crit_);
+      io_uring_waiting_ = false;
+    }
+    if (n < 0) {
+      if (errno != EINTR) {
+        RTC_LOG_E(LS_ERROR, EN, errno) << "io_uring wait";
+        return false;
+      }
+      // Else ignore the error and keep going, as in WaitEpoll().
+    } else if (n == 0) {
+      // If timeout, return success
+      return true;
+    } else {
+      CritScope cr(&crit_);
+      io_uring_->ReapCompletions(
+          [this](const IoUringPoller::Completion& completion) {
+            ProcessIoUringCompletion(completion);
+          });
+    }
+
+    if (cmsWait != kForeverMs) {
+      msWait = TimeDiff(msStop, TimeMillis());
+      if (msWait <= 0) {
+        // Return success on timeout.
+        return true;
+      }
+    }
+  }
+
+  return true;
+}
+
+#endif  // WEBRTC_USE_IO_URING
+
 bool PhysicalSocketServer::WaitPollOneDispatcher(int cmsWait,
                                                  Dispatcher* dispatcher) {
   RTC_DCHECK(dispatcher);
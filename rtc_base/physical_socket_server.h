@@ -23,6 +23,11 @@
 #include <sys/epoll.h>
 
 #define WEBRTC_USE_EPOLL 1
+#if !defined(WEBRTC_ANDROID)
+// Desktop Linux can wait on io_uring instead, see
+// PhysicalSocketServer::Backend.
+#define WEBRTC_USE_IO_URING 1
+#endif
 #elif defined(WEBRTC_FUCHSIA)
 // Fuchsia implements select and poll but not epoll, and testing shows that poll
 // is faster than select.
@@ -42,6 +47,9 @@
 #include <vector>
 
 #include "rtc_base/deprecated/recursive_critical_section.h"
+#if defined(WEBRTC_USE_IO_URING)
+#include "rtc_base/io_uring_poller.h"
+#endif
 #include "rtc_base/socket_server.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/rtc_export.h"
@@ -82,9 +90,24 @@ class Dispatcher {
 // A socket server that provides the real sockets of the underlying OS.
 class RTC_EXPORT PhysicalSocketServer : public SocketServer {
  public:
+  // How to wait for socket events.
+  enum class Backend {
+    // epoll on Linux, poll on Fuchsia, select elsewhere.
+    kDefault,
+    // io_uring one-shot poll requests on Linux, re-armed after each event,
+    // with the re-arms and changes to the watched events batched into one
+    // system call per wait. Falls back to kDefault where io_uring is not
+    // available.
+    kIoUring,
+  };
+
   PhysicalSocketServer();
+  explicit PhysicalSocketServer(Backend backend);
   ~PhysicalSocketServer() override;
 
+  // True if socket events are delivered through io_uring.
+  bool uses_io_uring() const;
+
   // SocketFactory:
   Socket* CreateSocket(int family, int type) override;
 
@@ -102,6 +125,8 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
  private:
   // The number of events to process with one call to "epoll_wait".
   static constexpr size_t kNumEpollEvents = 128;
+  // The number of requests that can be queued for io_uring between waits.
+  static constexpr unsigned kIoUringQueueDepth = 256;
   // A local historical definition of "foreverness", in milliseconds.
   static constexpr int kForeverMs = -1;
 
@@ -122,6 +147,35 @@ class RTC_EXPORT PhysicalSocketServer : public SocketServer {
   // server can outlive the thread it's bound to, forcing the Wait call
   // to have to reset the sequence checker on Wait calls.
   std::array<epoll_event, kNumEpollEvents> epoll_events_;
+#if defined(WEBRTC_USE_IO_URING)
+  struct IoUringWatch {
+    // The poll events to wait for, never 0.
+    uint32_t events = 0;
+    // Tells the pending poll request apart from earlier ones that may still
+    // report completions after a removal, also those of an earlier watch of
+    // the same dispatcher. Taken from `next_io_uring_generation_`.
+    uint32_t generation = 0;
+    // Whether a poll request is pending.
+    bool armed = false;
+  };
+
+  void AddIoUring(Dispatcher* dispatcher, uint64_t key);
+  void RemoveIoUring(uint64_t key);
+  void UpdateIoUring(Dispatcher* dispatcher, uint64_t key);
+  void ArmIoUring(Dispatcher* dispatcher, uint64_t key, IoUringWatch& watch);
+  bool WaitIoUring(int cmsWait);
+  void ProcessIoUringCompletion(const IoUringPoller::Completion& completion);
+  void SubmitIoUringIfWaiting();
+
+  // Created before `epoll_fd_`, which is only opened if this is null.
+  const std::unique_ptr<IoUringPoller> io_uring_;
+  std::unordered_map<uint64_t, IoUringWatch> io_uring_watches_
+      RTC_GUARDED_BY(crit_);
+  uint32_t next_io_uring_generation_ RTC_GUARDED_BY(crit_) = 0;
+  // True while a thread is blocked waiting for io_uring completions. Requests
+  // queued by other threads meanwhile are submitted right away.
+  bool io_uring_waiting_ RTC_GUARDED_BY(crit_) = false;
+#endif  // WEBRTC_USE_IO_URING
   const int epoll_fd_ = INVALID_SOCKET;
 
 #elif defined(WEBRTC_USE_POLL)
@@ -186,12 +240,18 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+  // Uses sendmmsg() where available, and UDP segmentation offload for runs
+  // of equally sized datagrams to the same destination.
+  int SendToBatch(rtc::ArrayView<const SendSlot> slots) override;
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   int RecvFrom(void* buffer,
                size_t length,
                SocketAddress* out_addr,
                int64_t* timestamp) override;
+  // Uses recvmmsg() where available to drain several datagrams with a single
+  // system call.
+  int RecvFromBatch(rtc::ArrayView<ReceiveSlot> slots) override;
 
   int Listen(int backlog) override;
   Socket* Accept(SocketAddress* out_addr) override;
@@ -223,6 +283,13 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
                        size_t length,
                        SocketAddress* out_addr,
                        int64_t* timestamp);
+#if defined(WEBRTC_LINUX)
+  int DoReadBatchFromSocket(rtc::ArrayView<ReceiveSlot> slots);
+  // Sends a prefix of `slots` with one sendmmsg() call, sets `used_gso` if
+  // any of the messages relied on UDP segmentation offload.
+  int DoSendBatchToSocket(rtc::ArrayView<const SendSlot> slots,
+                          bool* used_gso);
+#endif
 
   void OnResolveResult(const webrtc::AsyncDnsResolverResult& resolver);
 
@@ -240,6 +307,9 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   SOCKET s_;
   bool udp_;
   int family_ = 0;
+  // Both written to the IP TOS / Traffic Class field, see SetOption().
+  int dscp_ = 0;
+  int ecn_ = 0;
   mutable webrtc::Mutex mutex_;
   int error_ RTC_GUARDED_BY(mutex_);
   ConnState state_;
@@ -252,6 +322,10 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
  private:
   const bool read_scm_timestamp_experiment_;
   uint8_t enabled_events_ = 0;
+#if defined(WEBRTC_LINUX)
+  // Cleared the first time a segmentation offloaded send fails.
+  bool udp_gso_enabled_ = true;
+#endif
 };
 
 class SocketDispatcher : public Dispatcher, public PhysicalSocket {
@@ -14,7 +14,10 @@
 
 #include <algorithm>
 #include <memory>
+#include <string>
+#include <vector>
 
+#include "rtc_base/event.h"
 #include "rtc_base/gunit.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/logging.h"
@@ -24,6 +27,7 @@
 #include "rtc_base/socket_unittest.h"
 #include "rtc_base/test_utils.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 #include "test/field_trial.h"
 #include "test/gtest.h"
 
@@ -521,7 +525,295 @@ TEST_F(PhysicalSocketTest,
   server_.set_network_binder(nullptr);
 }
 
+TEST_F(PhysicalSocketTest, RecvFromBatchDrainsPendingDatagrams) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  const SocketAddress receiver_address = receiver->GetLocalAddress();
+  for (char c : {'a', 'b', 'c'}) {
+    const std::string payload(10, c);
+    ASSERT_EQ(10, sender->SendTo(payload.data(), payload.size(),
+                                 receiver_address));
+  }
+
+  char buffers[4][16];
+  Socket::ReceiveSlot slots[4];
+  for (int i = 0; i < 4; ++i) {
+    slots[i].data = buffers[i];
+    slots[i].capacity = sizeof(buffers[i]);
+  }
+  int received = receiver->RecvFromBatch(slots);
+#if defined(WEBRTC_LINUX)
+  ASSERT_EQ(3, received);
+#else
+  // Without recvmmsg() datagrams are read one at a time.
+  ASSERT_EQ(1, received);
 #endif
+  for (int i = 0; i < received; ++i) {
+    EXPECT_EQ(slots[i].size, 10u);
+    EXPECT_FALSE(slots[i].truncated);
+    EXPECT_EQ(slots[i].source_address, sender->GetLocalAddress());
+    EXPECT_EQ(buffers[i][0], 'a' + i);
+  }
+}
+
+TEST_F(PhysicalSocketTest, RecvFromBatchReportsTruncatedDatagrams) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  const std::string payload(100, 'x');
+  ASSERT_EQ(100, sender->SendTo(payload.data(), payload.size(),
+                                receiver->GetLocalAddress()));
+
+  char buffer[16];
+  Socket::ReceiveSlot slot;
+  slot.data = buffer;
+  slot.capacity = sizeof(buffer);
+  ASSERT_EQ(1, receiver->RecvFromBatch(rtc::ArrayView<Socket::ReceiveSlot>(
+                   &slot, 1)));
+#if defined(WEBRTC_LINUX)
+  EXPECT_TRUE(slot.truncated);
+#endif
+  EXPECT_EQ(slot.size, sizeof(buffer));
+}
+
+TEST_F(PhysicalSocketTest, SendToBatchDeliversDatagramsInOrder) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> other(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, other->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  // Three equally sized datagrams followed by a shorter one qualify for
+  // segmentation offload, the last datagram goes to another destination.
+  const std::string payloads[] = {std::string(100, 'a'), std::string(100, 'b'),
+                                  std::string(100, 'c'), std::string(40, 'd'),
+                                  std::string(100, 'e')};
+  std::vector<Socket::SendSlot> slots;
+  for (const std::string& payload : payloads) {
+    slots.push_back({.data = payload.data(),
+                     .size = payload.size(),
+                     .destination = receiver->GetLocalAddress()});
+  }
+  slots.back().destination = other->GetLocalAddress();
+  EXPECT_EQ(5, sender->SendToBatch(slots));
+
+  char buffer[200];
+  for (int i = 0; i < 4; ++i) {
+    SocketAddress source;
+    int64_t timestamp;
+    ASSERT_EQ(static_cast<int>(payloads[i].size()),
+              receiver->RecvFrom(buffer, sizeof(buffer), &source, &timestamp));
+    EXPECT_EQ(std::string(buffer, payloads[i].size()), payloads[i]);
+    EXPECT_EQ(source, sender->GetLocalAddress());
+  }
+  SocketAddress source;
+  int64_t timestamp;
+  ASSERT_EQ(100, other->RecvFrom(buffer, sizeof(buffer), &source, &timestamp));
+  EXPECT_EQ(buffer[0], 'e');
+}
+
+TEST_F(PhysicalSocketTest, ReusePortAllowsBindingTheSameAddress) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> first(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> second(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, first->SetOption(Socket::OPT_REUSEPORT, 1));
+  ASSERT_EQ(0, second->SetOption(Socket::OPT_REUSEPORT, 1));
+  ASSERT_EQ(0, first->Bind(SocketAddress(kIPv4Loopback, 0)));
+  EXPECT_EQ(0, second->Bind(first->GetLocalAddress()));
+
+  std::unique_ptr<Socket> third(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  EXPECT_NE(0, third->Bind(first->GetLocalAddress()));
+}
+
+TEST_F(PhysicalSocketTest, RecvFromBatchReportsEcnMarking) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, receiver->SetOption(Socket::OPT_RECV_ECN, 1));
+  ASSERT_EQ(0, sender->SetOption(Socket::OPT_SEND_ECN,
+                                 static_cast<int>(EcnMarking::kEct1)));
+  // Setting the DSCP must keep the ECN codepoint and vice versa.
+  ASSERT_EQ(0, sender->SetOption(Socket::OPT_DSCP, 10));
+  int value;
+  ASSERT_EQ(0, sender->GetOption(Socket::OPT_SEND_ECN, &value));
+  EXPECT_EQ(value, static_cast<int>(EcnMarking::kEct1));
+  ASSERT_EQ(0, sender->GetOption(Socket::OPT_DSCP, &value));
+  EXPECT_EQ(value, 10);
+
+  const std::string payload(10, 'x');
+  ASSERT_EQ(10, sender->SendTo(payload.data(), payload.size(),
+                               receiver->GetLocalAddress()));
+  char buffer[16];
+  Socket::ReceiveSlot slot;
+  slot.data = buffer;
+  slot.capacity = sizeof(buffer);
+  ASSERT_EQ(1, receiver->RecvFromBatch(rtc::ArrayView<Socket::ReceiveSlot>(
+                   &slot, 1)));
+#if defined(WEBRTC_LINUX)
+  EXPECT_EQ(slot.ecn, EcnMarking::kEct1);
+#endif
+}
+
+TEST_F(PhysicalSocketTest, ChangingDscpKeepsEcnMarking) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> receiver(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, receiver->SetOption(Socket::OPT_RECV_ECN, 1));
+  ASSERT_EQ(0, sender->SetOption(Socket::OPT_DSCP, 10));
+  ASSERT_EQ(0, sender->SetOption(Socket::OPT_SEND_ECN,
+                                 static_cast<int>(EcnMarking::kEct0)));
+  ASSERT_EQ(0, sender->SetOption(Socket::OPT_DSCP, 46));
+  int value;
+  ASSERT_EQ(0, sender->GetOption(Socket::OPT_SEND_ECN, &value));
+  EXPECT_EQ(value, static_cast<int>(EcnMarking::kEct0));
+  ASSERT_EQ(0, sender->GetOption(Socket::OPT_DSCP, &value));
+  EXPECT_EQ(value, 46);
+
+  const std::string payload(10, 'x');
+  ASSERT_EQ(10, sender->SendTo(payload.data(), payload.size(),
+                               receiver->GetLocalAddress()));
+  char buffer[16];
+  Socket::ReceiveSlot slot;
+  slot.data = buffer;
+  slot.capacity = sizeof(buffer);
+  ASSERT_EQ(1, receiver->RecvFromBatch(rtc::ArrayView<Socket::ReceiveSlot>(
+                   &slot, 1)));
+#if defined(WEBRTC_LINUX)
+  EXPECT_EQ(slot.ecn, EcnMarking::kEct0);
+#endif
+
+  // Clearing the ECN codepoint keeps the DSCP.
+  ASSERT_EQ(0, sender->SetOption(Socket::OPT_SEND_ECN,
+                                 static_cast<int>(EcnMarking::kNotEct)));
+  ASSERT_EQ(0, sender->GetOption(Socket::OPT_DSCP, &value));
+  EXPECT_EQ(value, 46);
+}
+
+#endif
+
+#if defined(WEBRTC_USE_IO_URING)
+// Runs the generic socket tests with events delivered through io_uring.
+class PhysicalSocketIoUringTest : public SocketTest {
+ protected:
+  PhysicalSocketIoUringTest()
+      : SocketTest(&server_),
+        server_(PhysicalSocketServer::Backend::kIoUring),
+        thread_(&server_) {}
+
+  void SetUp() override {
+    if (!server_.uses_io_uring()) {
+      GTEST_SKIP() << "io_uring is not available.";
+    }
+  }
+
+  PhysicalSocketServer server_;
+  rtc::AutoSocketServerThread thread_;
+};
+
+TEST_F(PhysicalSocketIoUringTest, TestConnectIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestConnectIPv4();
+}
+
+TEST_F(PhysicalSocketIoUringTest, TestServerCloseIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestServerCloseIPv4();
+}
+
+TEST_F(PhysicalSocketIoUringTest, TestCloseInClosedCallbackIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestCloseInClosedCallbackIPv4();
+}
+
+TEST_F(PhysicalSocketIoUringTest, TestDeleteInReadCallbackIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestDeleteInReadCallbackIPv4();
+}
+
+TEST_F(PhysicalSocketIoUringTest, TestSocketServerWaitIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestSocketServerWaitIPv4();
+}
+
+TEST_F(PhysicalSocketIoUringTest, TestTcpIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestTcpIPv4();
+}
+
+TEST_F(PhysicalSocketIoUringTest, TestSingleFlowControlCallbackIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestSingleFlowControlCallbackIPv4();
+}
+
+TEST_F(PhysicalSocketIoUringTest, TestUdpIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpIPv4();
+}
+
+TEST_F(PhysicalSocketIoUringTest, TestUdpReadyToSendIPv4) {
+  MAYBE_SKIP_IPV4;
+  SocketTest::TestUdpReadyToSendIPv4();
+}
+
+TEST_F(PhysicalSocketIoUringTest, TestUdpIPv6) {
+  MAYBE_SKIP_IPV6;
+  SocketTest::TestUdpIPv6();
+}
+
+// Ends the wait of a socket server when a socket becomes readable.
+class WakeUpOnReadEvent : public sigslot::has_slots<> {
+ public:
+  explicit WakeUpOnReadEvent(SocketServer* server) : server_(server) {}
+  void OnReadEvent(Socket* socket) { server_->WakeUp(); }
+
+ private:
+  SocketServer* const server_;
+};
+
+TEST_F(PhysicalSocketIoUringTest, WatchesSocketAddedWhileWaiting) {
+  MAYBE_SKIP_IPV4;
+  const SocketAddress kLoopback(kIPv4Loopback, 0);
+  std::unique_ptr<Socket> sender(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(sender->Bind(kLoopback), 0);
+
+  // While this thread waits, another one adds a socket and sends a packet to
+  // it.
+  std::unique_ptr<Socket> receiver;
+  WakeUpOnReadEvent wake_up(&server_);
+  rtc::Event receiver_created;
+  std::unique_ptr<Thread> adder = Thread::Create();
+  adder->Start();
+  adder->PostDelayedTask(
+      [&] {
+        receiver.reset(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+        ASSERT_EQ(receiver->Bind(kLoopback), 0);
+        receiver->SignalReadEvent.connect(&wake_up,
+                                          &WakeUpOnReadEvent::OnReadEvent);
+        receiver_created.Set();
+        sender->SendTo("x", 1, receiver->GetLocalAddress());
+      },
+      webrtc::TimeDelta::Millis(100));
+
+  // The socket is watched, and the wait ended by its read event, without
+  // waiting for the timeout first.
+  const int64_t start_ms = TimeMillis();
+  EXPECT_TRUE(server_.Wait(webrtc::TimeDelta::Seconds(10), true));
+  EXPECT_LT(TimeMillis() - start_ms, 5000);
+  ASSERT_TRUE(receiver_created.Wait(webrtc::TimeDelta::Seconds(10)));
+  adder->Stop();
+}
+#endif  // WEBRTC_USE_IO_URING
 
 TEST_F(PhysicalSocketTest, UdpSocketRecvTimestampUseRtcEpochIPv4) {
   MAYBE_SKIP_IPV4;
@@ -18,6 +18,7 @@
 #endif
 
 #include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
 
 namespace rtc {
 namespace {
@@ -106,6 +107,31 @@ void* RunPlatformThread(void* param) {
 
 }  // namespace
 
+bool SetCurrentThreadCpuAffinity(rtc::ArrayView<const int> cpus) {
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+      return false;
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+  return sched_setaffinity(0, sizeof(cpu_set), &cpu_set) == 0;
+#elif defined(WEBRTC_WIN)
+  DWORD_PTR mask = 0;
+  for (int cpu : cpus) {
+    if (cpu < 0 || cpu >= static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+      return false;
+    }
+    mask |= DWORD_PTR{1} << cpu;
+  }
+  return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#else
+  return false;
+#endif
+}
+
 PlatformThread::PlatformThread(Handle handle, bool joinable)
     : handle_(handle), joinable_(joinable) {}
 
@@ -182,6 +208,10 @@ PlatformThread PlatformThread::SpawnThread(
                                  name = std::string(name), attributes] {
         rtc::SetCurrentThreadName(name.c_str());
         SetPriority(attributes.priority);
+        if (!attributes.cpu_affinity.empty() &&
+            !SetCurrentThreadCpuAffinity(attributes.cpu_affinity)) {
+          RTC_LOG(LS_WARNING) << "Failed to set the CPU affinity of " << name;
+        }
         thread_function();
       });
 #if defined(WEBRTC_WIN)
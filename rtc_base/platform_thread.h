@@ -13,12 +13,15 @@
 
 #include <functional>
 #include <string>
+#include <utility>
+#include <vector>
 #if !defined(WEBRTC_WIN)
 #include <pthread.h>
 #endif
 
 #include "absl/strings/string_view.h"
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "rtc_base/platform_thread_types.h"
 
 namespace rtc {
@@ -32,12 +35,27 @@ enum class ThreadPriority {
 
 struct ThreadAttributes {
   ThreadPriority priority = ThreadPriority::kNormal;
+  // CPUs the thread may run on, see SetCurrentThreadCpuAffinity(). Empty
+  // means any CPU.
+  std::vector<int> cpu_affinity;
   ThreadAttributes& SetPriority(ThreadPriority priority_param) {
     priority = priority_param;
     return *this;
   }
+  ThreadAttributes& SetCpuAffinity(std::vector<int> cpu_affinity_param) {
+    cpu_affinity = std::move(cpu_affinity_param);
+    return *this;
+  }
 };
 
+// Restricts the calling thread to run on `cpus`. Memory pages are placed on
+// the NUMA node of the thread that first touches them, so a thread kept on
+// the CPUs of one node also keeps the buffers it allocates on that node.
+// Returns false if the affinity could not be set, which is always the case on
+// platforms other than Linux, Android and Windows. On Windows only the first
+// 64 CPUs, the ones of the thread's processor group, can be used.
+bool SetCurrentThreadCpuAffinity(rtc::ArrayView<const int> cpus);
+
 // Represents a simple worker thread.
 class PlatformThread final {
  public:
@@ -10,6 +10,10 @@
 
 #include "rtc_base/platform_thread.h"
 
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+#include <sched.h>
+#endif
+
 #include "absl/types/optional.h"
 #include "rtc_base/event.h"
 #include "system_wrappers/include/sleep.h"
@@ -106,4 +110,29 @@ TEST(PlatformThreadTest, StopsBeforeDetachedThreadExits) {
   EXPECT_TRUE(flag);
 }
 
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+TEST(PlatformThreadTest, RunsOnCpusOfItsAffinity) {
+  cpu_set_t allowed;
+  ASSERT_EQ(sched_getaffinity(0, sizeof(allowed), &allowed), 0);
+  int cpu = 0;
+  while (!CPU_ISSET(cpu, &allowed)) {
+    ++cpu;
+  }
+
+  cpu_set_t thread_cpus;
+  CPU_ZERO(&thread_cpus);
+  PlatformThread::SpawnJoinable(
+      [&] { sched_getaffinity(0, sizeof(thread_cpus), &thread_cpus); }, "T",
+      ThreadAttributes().SetCpuAffinity({cpu}));
+  EXPECT_EQ(CPU_COUNT(&thread_cpus), 1);
+  EXPECT_TRUE(CPU_ISSET(cpu, &thread_cpus));
+}
+#endif
+
+TEST(PlatformThreadTest, RejectsInvalidCpuAffinity) {
+  const int kNegativeCpu[] = {-1};
+  EXPECT_FALSE(SetCurrentThreadCpuAffinity({}));
+  EXPECT_FALSE(SetCurrentThreadCpuAffinity(kNegativeCpu));
+}
+
 }  // namespace rtc
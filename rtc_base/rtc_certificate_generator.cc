@@ -18,6 +18,7 @@
 
 #include "rtc_base/checks.h"
 #include "rtc_base/ssl_identity.h"
+#include "rtc_base/time_utils.h"
 
 namespace rtc {
 
@@ -27,6 +28,24 @@ namespace {
 const char kIdentityName[] = "WebRTC";
 const uint64_t kYearInSeconds = 365 * 24 * 60 * 60;
 
+// Pooled certificates with less lifetime left than this are not handed out.
+const int64_t kMinPooledCertificateLifetimeMs = 24 * 60 * 60 * 1000;
+
+bool SameKeyParams(const KeyParams& a, const KeyParams& b) {
+  if (a.type() != b.type()) {
+    return false;
+  }
+  switch (a.type()) {
+    case KT_RSA:
+      return a.rsa_params().mod_size == b.rsa_params().mod_size &&
+             a.rsa_params().pub_exp == b.rsa_params().pub_exp;
+    case KT_ECDSA:
+      return a.ec_curve() == b.ec_curve();
+    default:
+      return true;
+  }
+}
+
 }  // namespace
 
 // static
@@ -85,4 +104,135 @@ void RTCCertificateGenerator::GenerateCertificateAsync(
   });
 }
 
+class RTCCertificatePool::Generator : public RTCCertificateGeneratorInterface {
+ public:
+  explicit Generator(scoped_refptr<RTCCertificatePool> pool)
+      : pool_(std::move(pool)) {}
+
+  void GenerateCertificateAsync(const KeyParams& key_params,
+                                const absl::optional<uint64_t>& expires_ms,
+                                Callback callback) override {
+    pool_->GenerateCertificateAsync(key_params, expires_ms,
+                                    std::move(callback));
+  }
+
+ private:
+  const scoped_refptr<RTCCertificatePool> pool_;
+};
+
+// static
+scoped_refptr<RTCCertificatePool> RTCCertificatePool::Create(
+    Thread* signaling_thread,
+    Thread* worker_thread,
+    const KeyParams& key_params,
+    size_t size) {
+  scoped_refptr<RTCCertificatePool> pool(new RTCCertificatePool(
+      signaling_thread, worker_thread, key_params, size));
+  pool->MaybeRefill();
+  return pool;
+}
+
+RTCCertificatePool::RTCCertificatePool(Thread* signaling_thread,
+                                       Thread* worker_thread,
+                                       const KeyParams& key_params,
+                                       size_t size)
+    : signaling_thread_(signaling_thread),
+      worker_thread_(worker_thread),
+      key_params_(key_params),
+      size_(size),
+      generator_(signaling_thread, worker_thread) {
+  RTC_DCHECK(key_params_.IsValid());
+}
+
+RTCCertificatePool::~RTCCertificatePool() = default;
+
+std::unique_ptr<RTCCertificateGeneratorInterface>
+RTCCertificatePool::CreateGenerator() {
+  return std::make_unique<Generator>(scoped_refptr<RTCCertificatePool>(this));
+}
+
+size_t RTCCertificatePool::num_available() const {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  return certificates_.size();
+}
+
+int64_t RTCCertificatePool::num_hits() const {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  return num_hits_;
+}
+
+int64_t RTCCertificatePool::num_misses() const {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  return num_misses_;
+}
+
+void RTCCertificatePool::GenerateCertificateAsync(
+    const KeyParams& key_params,
+    const absl::optional<uint64_t>& expires_ms,
+    RTCCertificateGeneratorInterface::Callback callback) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  RTC_DCHECK(callback);
+
+  scoped_refptr<RTCCertificate> certificate;
+  if (!expires_ms && SameKeyParams(key_params, key_params_)) {
+    const uint64_t min_expires =
+        TimeUTCMillis() + kMinPooledCertificateLifetimeMs;
+    // Hand out the oldest certificates first.
+    while (!certificates_.empty() && !certificate) {
+      certificate = std::move(certificates_.front());
+      certificates_.erase(certificates_.begin());
+      if (certificate->Expires() < min_expires) {
+        certificate = nullptr;
+      }
+    }
+  }
+  if (!certificate) {
+    ++num_misses_;
+    generator_.GenerateCertificateAsync(key_params, expires_ms,
+                                        std::move(callback));
+    MaybeRefill();
+    return;
+  }
+
+  ++num_hits_;
+  // The callback is always invoked asynchronously, as for generated
+  // certificates.
+  signaling_thread_->PostTask(
+      [cert = std::move(certificate), cb = std::move(callback)]() mutable {
+        std::move(cb)(std::move(cert));
+      });
+  MaybeRefill();
+}
+
+void RTCCertificatePool::MaybeRefill() {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  if (refill_pending_ || certificates_.size() >= size_) {
+    return;
+  }
+  refill_pending_ = true;
+  worker_thread_->PostTask([pool = scoped_refptr<RTCCertificatePool>(this),
+                            key_params = key_params_]() mutable {
+    scoped_refptr<RTCCertificate> certificate =
+        RTCCertificateGenerator::GenerateCertificate(key_params,
+                                                     absl::nullopt);
+    Thread* signaling_thread = pool->signaling_thread_;
+    signaling_thread->PostTask([pool = std::move(pool),
+                                cert = std::move(certificate)]() mutable {
+      pool->OnCertificateGenerated(std::move(cert));
+    });
+  });
+}
+
+void RTCCertificatePool::OnCertificateGenerated(
+    scoped_refptr<RTCCertificate> certificate) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  refill_pending_ = false;
+  if (!certificate) {
+    // Don't retry on failure, the next request will.
+    return;
+  }
+  certificates_.push_back(std::move(certificate));
+  MaybeRefill();
+}
+
 }  // namespace rtc
@@ -13,8 +13,12 @@
 
 #include <stdint.h>
 
+#include <memory>
+#include <vector>
+
 #include "absl/functional/any_invocable.h"
 #include "absl/types/optional.h"
+#include "api/ref_counted_base.h"
 #include "api/scoped_refptr.h"
 #include "rtc_base/rtc_certificate.h"
 #include "rtc_base/ssl_identity.h"
@@ -77,6 +81,67 @@ class RTC_EXPORT RTCCertificateGenerator
   Thread* const worker_thread_;
 };
 
+// Keeps a pool of certificates generated ahead of time on the worker thread,
+// so that certificate requests can be served without waiting for key
+// generation. The pool can be shared by several PeerConnections, by passing a
+// generator from `CreateGenerator` as `PeerConnectionDependencies`'s
+// `cert_generator` to each of them.
+//
+// Only requests for the pool's `key_params` with the default expiration time
+// are served from the pool. Other requests, and requests made while the pool
+// is empty, are generated on demand like `RTCCertificateGenerator` does. Each
+// pooled certificate is handed out once, and the pool is refilled one
+// certificate at a time as it is drained. Certificates that are about to
+// expire are dropped from the pool rather than handed out.
+//
+// Must be created and used on the signaling thread.
+class RTC_EXPORT RTCCertificatePool final
+    : public RefCountedNonVirtual<RTCCertificatePool> {
+ public:
+  static scoped_refptr<RTCCertificatePool> Create(Thread* signaling_thread,
+                                                  Thread* worker_thread,
+                                                  const KeyParams& key_params,
+                                                  size_t size);
+
+  // Returns a generator that serves requests from this pool. The generator
+  // keeps the pool alive.
+  std::unique_ptr<RTCCertificateGeneratorInterface> CreateGenerator();
+
+  // Number of certificates ready to be handed out.
+  size_t num_available() const;
+  // Number of requests served from the pool and generated on demand.
+  int64_t num_hits() const;
+  int64_t num_misses() const;
+
+ protected:
+  friend class RefCountedNonVirtual<RTCCertificatePool>;
+  RTCCertificatePool(Thread* signaling_thread,
+                     Thread* worker_thread,
+                     const KeyParams& key_params,
+                     size_t size);
+  ~RTCCertificatePool();
+
+ private:
+  class Generator;
+
+  void GenerateCertificateAsync(
+      const KeyParams& key_params,
+      const absl::optional<uint64_t>& expires_ms,
+      RTCCertificateGeneratorInterface::Callback callback);
+  void MaybeRefill();
+  void OnCertificateGenerated(scoped_refptr<RTCCertificate> certificate);
+
+  Thread* const signaling_thread_;
+  Thread* const worker_thread_;
+  const KeyParams key_params_;
+  const size_t size_;
+  RTCCertificateGenerator generator_;
+  std::vector<scoped_refptr<RTCCertificate>> certificates_;
+  bool refill_pending_ = false;
+  int64_t num_hits_ = 0;
+  int64_t num_misses_ = 0;
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_RTC_CERTIFICATE_GENERATOR_H_
@@ -134,4 +134,82 @@ TEST_F(RTCCertificateGeneratorTest, GenerateWithInvalidParamsShouldFail) {
   EXPECT_FALSE(fixture_.certificate());
 }
 
+class RTCCertificatePoolTest : public ::testing::Test {
+ protected:
+  static constexpr int kGenerationTimeoutMs = 10000;
+
+  RTCCertificatePoolTest() : worker_thread_(Thread::Create()) {
+    RTC_CHECK(worker_thread_->Start());
+  }
+
+  scoped_refptr<RTCCertificatePool> CreatePool(size_t size) {
+    return RTCCertificatePool::Create(Thread::Current(), worker_thread_.get(),
+                                      KeyParams::ECDSA(), size);
+  }
+
+  scoped_refptr<RTCCertificate> Generate(
+      RTCCertificateGeneratorInterface* generator,
+      const KeyParams& key_params,
+      const absl::optional<uint64_t>& expires_ms) {
+    bool completed = false;
+    scoped_refptr<RTCCertificate> certificate;
+    generator->GenerateCertificateAsync(
+        key_params, expires_ms,
+        [&](scoped_refptr<RTCCertificate> generated) {
+          certificate = std::move(generated);
+          completed = true;
+        });
+    // The callback is never invoked synchronously.
+    EXPECT_FALSE(completed);
+    EXPECT_TRUE_WAIT(completed, kGenerationTimeoutMs);
+    return certificate;
+  }
+
+  rtc::AutoThread main_thread_;
+  std::unique_ptr<Thread> worker_thread_;
+};
+
+TEST_F(RTCCertificatePoolTest, ServesRequestsFromPool) {
+  scoped_refptr<RTCCertificatePool> pool = CreatePool(2);
+  EXPECT_EQ_WAIT(pool->num_available(), 2u, kGenerationTimeoutMs);
+  std::unique_ptr<RTCCertificateGeneratorInterface> generator =
+      pool->CreateGenerator();
+
+  scoped_refptr<RTCCertificate> first =
+      Generate(generator.get(), KeyParams::ECDSA(), absl::nullopt);
+  scoped_refptr<RTCCertificate> second =
+      Generate(generator.get(), KeyParams::ECDSA(), absl::nullopt);
+  ASSERT_TRUE(first);
+  ASSERT_TRUE(second);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(pool->num_hits(), 2);
+  EXPECT_EQ(pool->num_misses(), 0);
+
+  // The pool is refilled after being drained.
+  EXPECT_EQ_WAIT(pool->num_available(), 2u, kGenerationTimeoutMs);
+}
+
+TEST_F(RTCCertificatePoolTest, GeneratesOtherRequestsOnDemand) {
+  scoped_refptr<RTCCertificatePool> pool = CreatePool(1);
+  EXPECT_EQ_WAIT(pool->num_available(), 1u, kGenerationTimeoutMs);
+  std::unique_ptr<RTCCertificateGeneratorInterface> generator =
+      pool->CreateGenerator();
+
+  EXPECT_TRUE(Generate(generator.get(), KeyParams::RSA(), absl::nullopt));
+  EXPECT_TRUE(Generate(generator.get(), KeyParams::ECDSA(), 60000));
+  EXPECT_EQ(pool->num_hits(), 0);
+  EXPECT_EQ(pool->num_misses(), 2);
+  EXPECT_EQ(pool->num_available(), 1u);
+}
+
+TEST_F(RTCCertificatePoolTest, GeneratesOnDemandWhenEmpty) {
+  scoped_refptr<RTCCertificatePool> pool = CreatePool(0);
+  std::unique_ptr<RTCCertificateGeneratorInterface> generator =
+      pool->CreateGenerator();
+
+  EXPECT_TRUE(Generate(generator.get(), KeyParams::ECDSA(), absl::nullopt));
+  EXPECT_EQ(pool->num_hits(), 0);
+  EXPECT_EQ(pool->num_misses(), 1);
+}
+
 }  // namespace rtc
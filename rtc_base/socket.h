@@ -25,6 +25,8 @@
 #include "rtc_base/win32.h"
 #endif
 
+#include "api/array_view.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 
@@ -97,12 +99,49 @@ class Socket {
   virtual int Connect(const SocketAddress& addr) = 0;
   virtual int Send(const void* pv, size_t cb) = 0;
   virtual int SendTo(const void* pv, size_t cb, const SocketAddress& addr) = 0;
+
+  // One datagram to be sent by SendToBatch().
+  struct SendSlot {
+    const void* data = nullptr;
+    size_t size = 0;
+    SocketAddress destination;
+  };
+  // Sends the datagrams in `slots` in order. Returns the number of datagrams
+  // sent, which may be fewer than `slots.size()` if the socket would block,
+  // or a negative value if not even the first datagram could be sent. The
+  // default implementation calls SendTo() for each datagram.
+  virtual int SendToBatch(rtc::ArrayView<const SendSlot> slots);
   // `timestamp` is in units of microseconds.
   virtual int Recv(void* pv, size_t cb, int64_t* timestamp) = 0;
   virtual int RecvFrom(void* pv,
                        size_t cb,
                        SocketAddress* paddr,
                        int64_t* timestamp) = 0;
+
+  // Destination and result of one datagram read by RecvFromBatch(). `data`
+  // and `capacity` are provided by the caller, the remaining fields are
+  // filled in by the socket.
+  struct ReceiveSlot {
+    void* data = nullptr;
+    size_t capacity = 0;
+    size_t size = 0;
+    SocketAddress source_address;
+    // In units of microseconds, -1 if not available.
+    int64_t timestamp = -1;
+    // True if the datagram did not fit in `capacity` bytes.
+    bool truncated = false;
+    // Non-zero if the kernel coalesced several datagrams from the same
+    // source into this slot (see OPT_UDP_GRO). The slot then holds
+    // consecutive datagrams of `segment_size` bytes each, the last one may
+    // be shorter.
+    size_t segment_size = 0;
+    // ECN codepoint of the datagram, only read if OPT_RECV_ECN is enabled.
+    EcnMarking ecn = EcnMarking::kNotEct;
+  };
+  // Reads up to `slots.size()` pending datagrams without blocking. Returns
+  // the number of slots filled, or a negative value on error. The default
+  // implementation fills a single slot using RecvFrom().
+  virtual int RecvFromBatch(rtc::ArrayView<ReceiveSlot> slots);
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -123,6 +162,18 @@ class Socket {
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
+    OPT_UDP_GRO,               // Whether the kernel may coalesce datagrams
+                               // (Linux UDP_GRO). Coalesced datagrams must be
+                               // read with RecvFromBatch().
+    OPT_REUSEPORT,             // Whether other sockets with this option may
+                               // bind the same address (SO_REUSEPORT), the
+                               // kernel then spreads datagrams between them.
+                               // Must be set before Bind().
+    OPT_SEND_ECN,              // ECN codepoint (EcnMarking) of sent packets.
+                               // Shares the IP TOS field with OPT_DSCP.
+    OPT_RECV_ECN,              // Whether the ECN codepoint of received
+                               // datagrams is read. Only reported by
+                               // RecvFromBatch() (see ReceiveSlot::ecn).
   };
   virtual int GetOption(Option opt, int* value) = 0;
   virtual int SetOption(Option opt, int value) = 0;
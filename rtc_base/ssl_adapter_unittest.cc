@@ -100,6 +100,7 @@ class SSLAdapterTestDummyClient : public sigslot::has_slots<> {
   rtc::Socket::ConnState GetState() const { return ssl_adapter_->GetState(); }
 
   const std::string& GetReceivedData() const { return data_; }
+  int num_reads() const { return num_reads_; }
 
   int Connect(absl::string_view hostname, const rtc::SocketAddress& address) {
     RTC_LOG(LS_INFO) << "Initiating connection with " << address.ToString();
@@ -137,6 +138,7 @@ class SSLAdapterTestDummyClient : public sigslot::has_slots<> {
       RTC_LOG(LS_INFO) << "Client received '" << buffer << "'";
 
       data_ += buffer;
+      ++num_reads_;
     }
   }
 
@@ -155,6 +157,7 @@ class SSLAdapterTestDummyClient : public sigslot::has_slots<> {
   std::unique_ptr<rtc::SSLAdapter> ssl_adapter_;
 
   std::string data_;
+  int num_reads_ = 0;
 };
 
 class SSLAdapterTestDummyServer : public sigslot::has_slots<> {
@@ -513,6 +516,21 @@ TEST_F(SSLAdapterTestTLS_RSA, TestTLSTransferWithBlockedSocket) {
   EXPECT_EQ_WAIT(expected, server_->GetReceivedData(), kTimeout);
 }
 
+// Test that records which arrived together are read together.
+TEST_F(SSLAdapterTestTLS_ECDSA, TestTLSReadsAvailableRecordsAtOnce) {
+  TestHandshake(true);
+
+  // Hold the first records back, so that they go out with the last one.
+  vss_->SetSendingBlocked(true);
+  ASSERT_EQ(7, server_->Send("Hello, "));
+  ASSERT_EQ(5, server_->Send("world"));
+  vss_->SetSendingBlocked(false);
+  ASSERT_EQ(1, server_->Send("!"));
+
+  EXPECT_EQ_WAIT("Hello, world!", client_->GetReceivedData(), kTimeout);
+  EXPECT_EQ(1, client_->num_reads());
+}
+
 // Test transfer between client and server, using ECDSA
 TEST_F(SSLAdapterTestTLS_ECDSA, TestTLSTransfer) {
   TestHandshake(true);
@@ -61,6 +61,12 @@ bool tokenize_first(absl::string_view source,
                     char delimiter,
                     std::string* token,
                     std::string* rest);
+// Same as above, but `token` and `rest` point into `source` instead of being
+// copied.
+bool tokenize_first(absl::string_view source,
+                    char delimiter,
+                    absl::string_view* token,
+                    absl::string_view* rest);
 
 // Convert arbitrary values to/from a string.
 // TODO(jonasolsson): Remove these when absl::StrCat becomes available.
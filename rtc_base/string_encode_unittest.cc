@@ -132,6 +132,21 @@ TEST_F(HexEncodeTest, TestDecodeWithDelimiterTrailingDelimiter) {
   ASSERT_EQ(0U, dec_res_);
 }
 
+TEST(TokenizeFirstTest, StringViewOutput) {
+  absl::string_view source = "a=fmtp:96  apt=100";
+  absl::string_view token;
+  absl::string_view rest;
+
+  ASSERT_TRUE(tokenize_first(source, ' ', &token, &rest));
+  EXPECT_EQ("a=fmtp:96", token);
+  EXPECT_EQ("apt=100", rest);
+  // The results refer to the source rather than to copies.
+  EXPECT_EQ(source.data(), token.data());
+  EXPECT_EQ(source.data() + source.size(), rest.data() + rest.size());
+
+  EXPECT_FALSE(tokenize_first("ABC", ' ', &token, &rest));
+}
+
 // Tests counting substrings.
 TEST(TokenizeTest, CountSubstrings) {
   std::vector<std::string> fields;
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/system/memory_mapped_file.h"
+
+#include <algorithm>
+#include <string>
+
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace webrtc {
+
+rtc::scoped_refptr<MemoryMappedFile> MemoryMappedFile::Open(
+    absl::string_view file_name) {
+#if defined(WEBRTC_POSIX)
+  const int fd = open(std::string(file_name).c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+  const size_t size = static_cast<size_t>(file_stat.st_size);
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  return rtc::scoped_refptr<MemoryMappedFile>(
+      new MemoryMappedFile(static_cast<const uint8_t*>(data), size));
+#else
+  return nullptr;
+#endif
+}
+
+MemoryMappedFile::MemoryMappedFile(const uint8_t* data, size_t size)
+    : data_(data), size_(size) {}
+
+MemoryMappedFile::~MemoryMappedFile() {
+#if defined(WEBRTC_POSIX)
+  munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+}
+
+void MemoryMappedFile::Prefetch(size_t offset, size_t size) const {
+#if defined(WEBRTC_POSIX)
+  if (offset >= size_) {
+    return;
+  }
+  size = std::min(size, size_ - offset);
+  // madvise() needs a page aligned start address.
+  static const size_t kPageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t aligned_offset = offset - offset % kPageSize;
+  madvise(const_cast<uint8_t*>(data_) + aligned_offset,
+          size + offset - aligned_offset, MADV_WILLNEED);
+#endif
+}
+
+}  // namespace webrtc
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_SYSTEM_MEMORY_MAPPED_FILE_H_
+#define RTC_BASE_SYSTEM_MEMORY_MAPPED_FILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "absl/strings/string_view.h"
+#include "api/array_view.h"
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
+
+namespace webrtc {
+
+// A read-only view of a whole file, mapped into memory. Readers can hand out
+// pointers into the mapping instead of copying the data, as long as they keep
+// a reference to the MemoryMappedFile. Writing to the mapping faults.
+// Intended for test and replay tools.
+class MemoryMappedFile
+    : public rtc::RefCountedNonVirtual<MemoryMappedFile> {
+ public:
+  // Returns nullptr if the file can't be opened or mapped, if it is empty, or
+  // if memory mapping isn't supported on the platform.
+  static rtc::scoped_refptr<MemoryMappedFile> Open(
+      absl::string_view file_name);
+
+  ~MemoryMappedFile();
+
+  MemoryMappedFile(const MemoryMappedFile&) = delete;
+  MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+  rtc::ArrayView<const uint8_t> data() const { return {data_, size_}; }
+  size_t size() const { return size_; }
+
+  // Hints that the `size` bytes at `offset` will be read soon, so that they
+  // are read from disk asynchronously instead of on the first access. Ranges
+  // outside the file are clipped.
+  void Prefetch(size_t offset, size_t size) const;
+
+ private:
+  MemoryMappedFile(const uint8_t* data, size_t size);
+
+  const uint8_t* const data_;
+  const size_t size_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_SYSTEM_MEMORY_MAPPED_FILE_H_
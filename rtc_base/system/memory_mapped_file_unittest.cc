@@ -0,0 +1,56 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/system/memory_mapped_file.h"
+
+#include <string.h>
+
+#include <string>
+
+#include "rtc_base/system/file_wrapper.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+#if defined(WEBRTC_POSIX)
+
+TEST(MemoryMappedFileTest, MapsFileContents) {
+  const std::string file_name =
+      test::TempFilename(test::OutputPath(), "memory_mapped_file");
+  {
+    FileWrapper file = FileWrapper::OpenWriteOnly(file_name);
+    ASSERT_TRUE(file.Write("foobar", 6));
+  }
+
+  rtc::scoped_refptr<MemoryMappedFile> mapped =
+      MemoryMappedFile::Open(file_name);
+  ASSERT_TRUE(mapped);
+  ASSERT_EQ(mapped->size(), 6u);
+  EXPECT_EQ(memcmp(mapped->data().data(), "foobar", 6), 0);
+  mapped->Prefetch(2, 100);
+  mapped->Prefetch(100, 100);
+
+  test::RemoveFile(file_name);
+}
+
+#endif  // defined(WEBRTC_POSIX)
+
+TEST(MemoryMappedFileTest, FailsForMissingAndEmptyFiles) {
+  const std::string file_name =
+      test::TempFilename(test::OutputPath(), "memory_mapped_file");
+  EXPECT_FALSE(MemoryMappedFile::Open(file_name));
+  EXPECT_FALSE(MemoryMappedFile::Open(file_name + "_missing"));
+  test::RemoveFile(file_name);
+}
+
+}  // namespace
+}  // namespace webrtc
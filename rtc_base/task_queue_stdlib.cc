@@ -13,16 +13,16 @@
 #include <string.h>
 
 #include <algorithm>
-#include <map>
 #include <memory>
-#include <queue>
 #include <utility>
 
 #include "absl/functional/any_invocable.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/containers/pooled_queue.h"
 #include "rtc_base/event.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/divide_round.h"
@@ -30,6 +30,7 @@
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/time_utils.h"
+#include "rtc_base/timer_wheel.h"
 
 namespace webrtc {
 namespace {
@@ -65,17 +66,6 @@ class TaskQueueStdlib final : public TaskQueueBase {
  private:
   using OrderId = uint64_t;
 
-  struct DelayedEntryTimeout {
-    // TODO(bugs.webrtc.org/13756): Migrate to Timestamp.
-    int64_t next_fire_at_us{};
-    OrderId order{};
-
-    bool operator<(const DelayedEntryTimeout& o) const {
-      return std::tie(next_fire_at_us, order) <
-             std::tie(o.next_fire_at_us, o.order);
-    }
-  };
-
   struct NextTask {
     bool final_task = false;
     absl::AnyInvocable<void() &&> run_task;
@@ -105,17 +95,20 @@ class TaskQueueStdlib final : public TaskQueueBase {
   OrderId thread_posting_order_ RTC_GUARDED_BY(pending_lock_) = 0;
 
   // The list of all pending tasks that need to be processed in the
-  // FIFO queue ordering on the worker thread.
-  std::queue<std::pair<OrderId, absl::AnyInvocable<void() &&>>> pending_queue_
+  // FIFO queue ordering on the worker thread. Its nodes are reused, so that
+  // posting a task doesn't allocate besides the closure itself.
+  PooledQueue<std::pair<OrderId, absl::AnyInvocable<void() &&>>> pending_queue_
       RTC_GUARDED_BY(pending_lock_);
 
   // The list of all pending tasks that need to be processed at a future
   // time based upon a delay. On the off change the delayed task should
   // happen at exactly the same time interval as another task then the
-  // task is processed based on FIFO ordering. std::priority_queue was
-  // considered but rejected due to its inability to extract the
-  // move-only value out of the queue without the presence of a hack.
-  std::map<DelayedEntryTimeout, absl::AnyInvocable<void() &&>> delayed_queue_
+  // task is processed based on FIFO ordering.
+  TimerWheel<std::pair<OrderId, absl::AnyInvocable<void() &&>>> delayed_queue_
+      RTC_GUARDED_BY(pending_lock_);
+
+  // Delayed tasks which are due, in the order they are due.
+  PooledQueue<std::pair<OrderId, absl::AnyInvocable<void() &&>>> expired_queue_
       RTC_GUARDED_BY(pending_lock_);
 
   // Contains the active worker thread assigned to processing
@@ -176,13 +169,19 @@ void TaskQueueStdlib::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
                                           TimeDelta delay,
                                           const PostDelayedTaskTraits& traits,
                                           const Location& location) {
-  DelayedEntryTimeout delayed_entry;
-  delayed_entry.next_fire_at_us = rtc::TimeMicros() + delay.us();
+  const int64_t now_us = rtc::TimeMicros();
+  const int64_t now_ms = now_us / rtc::kNumMicrosecsPerMillisec;
+  // Round the run time, not only the delay, up to a whole millisecond. The
+  // task runs once the time in milliseconds reaches it, so that it doesn't
+  // run before `delay` has passed.
+  const int64_t run_time_ms =
+      DivideRoundUp(now_us + delay.us(), rtc::kNumMicrosecsPerMillisec);
 
   {
     MutexLock lock(&pending_lock_);
-    delayed_entry.order = ++thread_posting_order_;
-    delayed_queue_[delayed_entry] = std::move(task);
+    delayed_queue_.Insert(
+        now_ms, run_time_ms, /*coalesce=*/!traits.high_precision,
+        std::make_pair(++thread_posting_order_, std::move(task)));
   }
 
   NotifyWake();
@@ -191,7 +190,7 @@ void TaskQueueStdlib::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
 TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
   NextTask result;
 
-  const int64_t tick_us = rtc::TimeMicros();
+  const int64_t tick_ms = rtc::TimeMillis();
 
   MutexLock lock(&pending_lock_);
 
@@ -200,29 +199,33 @@ TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
     return result;
   }
 
-  if (delayed_queue_.size() > 0) {
-    auto delayed_entry = delayed_queue_.begin();
-    const auto& delay_info = delayed_entry->first;
-    auto& delay_run = delayed_entry->second;
-    if (tick_us >= delay_info.next_fire_at_us) {
-      if (pending_queue_.size() > 0) {
-        auto& entry = pending_queue_.front();
-        auto& entry_order = entry.first;
-        auto& entry_run = entry.second;
-        if (entry_order < delay_info.order) {
-          result.run_task = std::move(entry_run);
-          pending_queue_.pop();
-          return result;
-        }
+  delayed_queue_.PopExpired(
+      tick_ms,
+      [&](std::pair<OrderId, absl::AnyInvocable<void() &&>> delayed_task) {
+        expired_queue_.push(std::move(delayed_task));
+      });
+
+  if (expired_queue_.size() > 0) {
+    auto& delayed_entry = expired_queue_.front();
+    if (pending_queue_.size() > 0) {
+      auto& entry = pending_queue_.front();
+      auto& entry_order = entry.first;
+      auto& entry_run = entry.second;
+      if (entry_order < delayed_entry.first) {
+        result.run_task = std::move(entry_run);
+        pending_queue_.pop();
+        return result;
       }
-
-      result.run_task = std::move(delay_run);
-      delayed_queue_.erase(delayed_entry);
-      return result;
     }
 
-    result.sleep_time = TimeDelta::Millis(
-        DivideRoundUp(delay_info.next_fire_at_us - tick_us, 1'000));
+    result.run_task = std::move(delayed_entry.second);
+    expired_queue_.pop();
+    return result;
+  }
+
+  if (absl::optional<int64_t> wake_up_ms = delayed_queue_.NextWakeUpMs()) {
+    result.sleep_time =
+        TimeDelta::Millis(std::max<int64_t>(*wake_up_ms - tick_ms, 0));
   }
 
   if (pending_queue_.size() > 0) {
@@ -254,12 +257,12 @@ void TaskQueueStdlib::ProcessTasks() {
 
   // Ensure remaining deleted tasks are destroyed with Current() set up to this
   // task queue.
-  std::queue<std::pair<OrderId, absl::AnyInvocable<void() &&>>> pending_queue;
+  PooledQueue<std::pair<OrderId, absl::AnyInvocable<void() &&>>> pending_queue;
   {
     MutexLock lock(&pending_lock_);
     pending_queue_.swap(pending_queue);
   }
-  pending_queue = {};
+  pending_queue.clear();
 #if RTC_DCHECK_IS_ON
   MutexLock lock(&pending_lock_);
   RTC_DCHECK(pending_queue_.empty());
@@ -10,7 +10,12 @@
 
 #include "rtc_base/task_queue_stdlib.h"
 
+#include <memory>
+
 #include "api/task_queue/task_queue_test.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/event.h"
+#include "rtc_base/time_utils.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -25,5 +30,44 @@ INSTANTIATE_TEST_SUITE_P(TaskQueueStdlib,
                          TaskQueueTest,
                          ::testing::Values(CreateTaskQueueFactory));
 
+struct DelayedTaskState {
+  rtc::Event done;
+  int64_t ran_us = 0;
+};
+
+// Keeps `queue` busy until the delayed task has run, so that it checks for due
+// tasks all the time instead of sleeping until the deadline. The posted tasks
+// share ownership of `state`, so they may outlive the test iteration.
+void SpinUntilRan(TaskQueueBase* queue,
+                  std::shared_ptr<DelayedTaskState> state) {
+  if (!state->ran_us) {
+    queue->PostTask([queue, state] { SpinUntilRan(queue, state); });
+  }
+}
+
+TEST(TaskQueueStdlib, DelayedTasksDontRunEarly) {
+  constexpr TimeDelta kDelay = TimeDelta::Millis(1);
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> queue =
+      CreateTaskQueueStdlibFactory()->CreateTaskQueue(
+          "queue", TaskQueueFactory::Priority::NORMAL);
+  // Posting at different offsets within a millisecond covers deadlines that
+  // are less than a millisecond after the last whole millisecond.
+  for (int i = 0; i < 20; ++i) {
+    auto state = std::make_shared<DelayedTaskState>();
+    const int64_t posted_us = rtc::TimeMicros();
+    queue->PostDelayedHighPrecisionTask(
+        [state] {
+          state->ran_us = rtc::TimeMicros();
+          state->done.Set();
+        },
+        kDelay);
+    SpinUntilRan(queue.get(), state);
+    ASSERT_TRUE(state->done.Wait(TimeDelta::Seconds(1)));
+    EXPECT_GE(state->ran_us - posted_us, kDelay.us());
+    // Shifts the next post to another offset within the millisecond.
+    rtc::Event().Wait(TimeDelta::Micros(130));
+  }
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -0,0 +1,490 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_thread_pool.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/strings/string_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/numerics/divide_round.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/ref_counter.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+// Number of tasks a worker runs from one task queue before giving the other
+// ready task queues a turn.
+constexpr int kMaxTasksPerRun = 32;
+
+class PooledTaskQueue;
+class ThreadPool;
+
+struct PoolWorker {
+  ThreadPool* pool = nullptr;
+  size_t index = 0;
+  rtc::Event wake;
+  Mutex lock;
+  // Task queues ready to run. The worker takes them from the front, and other
+  // workers steal from the back.
+  std::deque<PooledTaskQueue*> ready RTC_GUARDED_BY(lock);
+  rtc::PlatformThread thread;
+};
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+
+ABSL_CONST_INIT thread_local PoolWorker* current_worker = nullptr;
+
+PoolWorker* GetCurrentWorker() {
+  return current_worker;
+}
+
+void SetCurrentWorker(PoolWorker* worker) {
+  current_worker = worker;
+}
+
+#else
+
+// Without thread local storage, task queues made ready by tasks also go
+// through the shared queue of the pool.
+PoolWorker* GetCurrentWorker() {
+  return nullptr;
+}
+
+void SetCurrentWorker(PoolWorker* worker) {}
+
+#endif
+
+class PooledTaskQueue final : public TaskQueueBase {
+ public:
+  explicit PooledTaskQueue(ThreadPool* pool) : pool_(pool) {}
+
+  void Delete() override;
+
+  void AddRef() { ref_count_.IncRef(); }
+  void Release() {
+    if (ref_count_.DecRef() == rtc::RefCountReleaseStatus::kDroppedLastRef) {
+      delete this;
+    }
+  }
+
+  // Runs pending tasks on the calling worker thread. Returns true if tasks
+  // remain and the task queue must be scheduled again, with the reference
+  // held for scheduling. Otherwise that reference is released.
+  bool RunTasks();
+
+  // Appends `task`, and schedules the task queue if it was idle.
+  void Enqueue(absl::AnyInvocable<void() &&> task);
+
+ protected:
+  void PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                    const PostTaskTraits& traits,
+                    const Location& location) override;
+  void PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                           TimeDelta delay,
+                           const PostDelayedTaskTraits& traits,
+                           const Location& location) override;
+
+ private:
+  ~PooledTaskQueue() override = default;
+
+  ThreadPool* const pool_;
+  // Held by the owner until Delete(), while the task queue is scheduled, and
+  // by each pending delayed task.
+  webrtc_impl::RefCounter ref_count_{1};
+  // Signaled when a worker stops running tasks after Delete().
+  rtc::Event stopped_;
+
+  Mutex lock_;
+  std::deque<absl::AnyInvocable<void() &&>> tasks_ RTC_GUARDED_BY(lock_);
+  // True while the task queue is waiting in a ready queue of the pool, or its
+  // tasks are running.
+  bool scheduled_ RTC_GUARDED_BY(lock_) = false;
+  // True while a worker runs tasks of this task queue.
+  bool running_ RTC_GUARDED_BY(lock_) = false;
+  bool deleted_ RTC_GUARDED_BY(lock_) = false;
+};
+
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+
+  // Makes `queue` ready to run, handing over a reference to it.
+  void Schedule(PooledTaskQueue* queue);
+  // Enqueues `task` to `queue` after `delay`, handing over a reference to
+  // `queue`.
+  void ScheduleDelayed(PooledTaskQueue* queue,
+                       absl::AnyInvocable<void() &&> task,
+                       TimeDelta delay);
+
+ private:
+  using OrderId = uint64_t;
+
+  struct DelayedEntryTimeout {
+    int64_t next_fire_at_us{};
+    OrderId order{};
+
+    bool operator<(const DelayedEntryTimeout& o) const {
+      return std::tie(next_fire_at_us, order) <
+             std::tie(o.next_fire_at_us, o.order);
+    }
+  };
+
+  struct DelayedTask {
+    PooledTaskQueue* queue;
+    absl::AnyInvocable<void() &&> task;
+  };
+
+  void RunWorker(PoolWorker* worker);
+  void RunTimer();
+  // Returns a ready task queue, preferring the ones of `worker`.
+  PooledTaskQueue* FindWork(PoolWorker* worker);
+  void WakeIdleWorker();
+
+  std::vector<std::unique_ptr<PoolWorker>> workers_;
+
+  Mutex lock_;
+  bool quit_ RTC_GUARDED_BY(lock_) = false;
+  // Task queues made ready by threads outside of the pool.
+  std::deque<PooledTaskQueue*> injected_ RTC_GUARDED_BY(lock_);
+  std::vector<PoolWorker*> idle_workers_ RTC_GUARDED_BY(lock_);
+
+  rtc::Event timer_wake_;
+  Mutex timer_lock_;
+  bool timer_quit_ RTC_GUARDED_BY(timer_lock_) = false;
+  OrderId next_order_ RTC_GUARDED_BY(timer_lock_) = 0;
+  std::map<DelayedEntryTimeout, DelayedTask> delayed_
+      RTC_GUARDED_BY(timer_lock_);
+  rtc::PlatformThread timer_thread_;
+};
+
+void PooledTaskQueue::Delete() {
+  RTC_DCHECK(!IsCurrent());
+  std::deque<absl::AnyInvocable<void() &&>> tasks;
+  bool wait_for_worker;
+  {
+    MutexLock lock(&lock_);
+    deleted_ = true;
+    tasks.swap(tasks_);
+    wait_for_worker = running_;
+  }
+  if (wait_for_worker) {
+    stopped_.Wait(rtc::Event::kForever);
+  }
+  {
+    // Pending tasks are destroyed with Current() set to this task queue.
+    CurrentTaskQueueSetter set_current(this);
+    tasks.clear();
+  }
+  Release();
+}
+
+bool PooledTaskQueue::RunTasks() {
+  for (int i = 0; i < kMaxTasksPerRun; ++i) {
+    absl::AnyInvocable<void() &&> task;
+    bool stop;
+    {
+      MutexLock lock(&lock_);
+      stop = deleted_ || tasks_.empty();
+      if (stop) {
+        if (deleted_ && running_) {
+          stopped_.Set();
+        }
+        running_ = false;
+        scheduled_ = false;
+      } else {
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+        running_ = true;
+      }
+    }
+    if (stop) {
+      Release();
+      return false;
+    }
+    CurrentTaskQueueSetter set_current(this);
+    std::move(task)();
+    // Destroy the task while Current() is still set.
+    task = nullptr;
+  }
+
+  bool deleted;
+  {
+    MutexLock lock(&lock_);
+    deleted = deleted_;
+    if (deleted_) {
+      stopped_.Set();
+      scheduled_ = false;
+    }
+    running_ = false;
+  }
+  if (deleted) {
+    Release();
+    return false;
+  }
+  return true;
+}
+
+void PooledTaskQueue::Enqueue(absl::AnyInvocable<void() &&> task) {
+  {
+    MutexLock lock(&lock_);
+    if (deleted_) {
+      return;
+    }
+    tasks_.push_back(std::move(task));
+    if (scheduled_) {
+      return;
+    }
+    scheduled_ = true;
+    AddRef();
+  }
+  pool_->Schedule(this);
+}
+
+void PooledTaskQueue::PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                                   const PostTaskTraits& traits,
+                                   const Location& location) {
+  Enqueue(std::move(task));
+}
+
+void PooledTaskQueue::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                                          TimeDelta delay,
+                                          const PostDelayedTaskTraits& traits,
+                                          const Location& location) {
+  AddRef();
+  pool_->ScheduleDelayed(this, std::move(task), delay);
+}
+
+ThreadPool::ThreadPool(int num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.push_back(std::make_unique<PoolWorker>());
+    workers_.back()->pool = this;
+    workers_.back()->index = i;
+  }
+  // All workers exist before any thread starts, since they steal from each
+  // other.
+  for (auto& worker : workers_) {
+    worker->thread = rtc::PlatformThread::SpawnJoinable(
+        [this, worker = worker.get()] { RunWorker(worker); }, "TaskQueuePool");
+  }
+  timer_thread_ = rtc::PlatformThread::SpawnJoinable([this] { RunTimer(); },
+                                                     "TaskQueuePoolTimer");
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    MutexLock lock(&timer_lock_);
+    timer_quit_ = true;
+  }
+  timer_wake_.Set();
+  timer_thread_.Finalize();
+  {
+    MutexLock lock(&lock_);
+    quit_ = true;
+  }
+  for (auto& worker : workers_) {
+    worker->wake.Set();
+    worker->thread.Finalize();
+  }
+
+  // Drop the remaining references, deleted task queues may still be waiting
+  // for delayed tasks or a worker.
+  std::map<DelayedEntryTimeout, DelayedTask> delayed;
+  {
+    MutexLock lock(&timer_lock_);
+    delayed.swap(delayed_);
+  }
+  for (auto& [timeout, delayed_task] : delayed) {
+    delayed_task.task = nullptr;
+    delayed_task.queue->Release();
+  }
+  while (PooledTaskQueue* queue = FindWork(workers_[0].get())) {
+    bool has_tasks = queue->RunTasks();
+    RTC_DCHECK(!has_tasks) << "Task queue not deleted before factory.";
+  }
+}
+
+void ThreadPool::Schedule(PooledTaskQueue* queue) {
+  PoolWorker* worker = GetCurrentWorker();
+  if (worker != nullptr && worker->pool == this) {
+    MutexLock lock(&worker->lock);
+    worker->ready.push_back(queue);
+  } else {
+    MutexLock lock(&lock_);
+    injected_.push_back(queue);
+  }
+  WakeIdleWorker();
+}
+
+void ThreadPool::ScheduleDelayed(PooledTaskQueue* queue,
+                                 absl::AnyInvocable<void() &&> task,
+                                 TimeDelta delay) {
+  DelayedEntryTimeout timeout;
+  timeout.next_fire_at_us = rtc::TimeMicros() + delay.us();
+  bool is_next;
+  {
+    MutexLock lock(&timer_lock_);
+    timeout.order = ++next_order_;
+    auto it = delayed_.emplace(timeout, DelayedTask{queue, std::move(task)});
+    is_next = it.first == delayed_.begin();
+  }
+  if (is_next) {
+    timer_wake_.Set();
+  }
+}
+
+void ThreadPool::RunWorker(PoolWorker* worker) {
+  SetCurrentWorker(worker);
+  while (true) {
+    PooledTaskQueue* queue = FindWork(worker);
+    if (queue == nullptr) {
+      {
+        MutexLock lock(&lock_);
+        if (quit_) {
+          break;
+        }
+        idle_workers_.push_back(worker);
+      }
+      // Look again after becoming idle, a task queue scheduled in between
+      // wouldn't have woken this worker.
+      queue = FindWork(worker);
+      if (queue == nullptr) {
+        worker->wake.Wait(rtc::Event::kForever);
+        continue;
+      }
+      MutexLock lock(&lock_);
+      auto it =
+          std::find(idle_workers_.begin(), idle_workers_.end(), worker);
+      if (it != idle_workers_.end()) {
+        idle_workers_.erase(it);
+      }
+    }
+    if (queue->RunTasks()) {
+      Schedule(queue);
+    }
+  }
+  SetCurrentWorker(nullptr);
+}
+
+void ThreadPool::RunTimer() {
+  while (true) {
+    std::vector<DelayedTask> due_tasks;
+    TimeDelta sleep_time = rtc::Event::kForever;
+    {
+      MutexLock lock(&timer_lock_);
+      if (timer_quit_) {
+        break;
+      }
+      const int64_t tick_us = rtc::TimeMicros();
+      while (!delayed_.empty() &&
+             delayed_.begin()->first.next_fire_at_us <= tick_us) {
+        due_tasks.push_back(std::move(delayed_.begin()->second));
+        delayed_.erase(delayed_.begin());
+      }
+      if (!delayed_.empty()) {
+        sleep_time = TimeDelta::Millis(DivideRoundUp(
+            delayed_.begin()->first.next_fire_at_us - tick_us, 1'000));
+      }
+    }
+    for (DelayedTask& due_task : due_tasks) {
+      due_task.queue->Enqueue(std::move(due_task.task));
+      due_task.queue->Release();
+    }
+    if (due_tasks.empty()) {
+      timer_wake_.Wait(sleep_time);
+    }
+  }
+}
+
+PooledTaskQueue* ThreadPool::FindWork(PoolWorker* worker) {
+  PooledTaskQueue* queue = nullptr;
+  {
+    MutexLock lock(&worker->lock);
+    if (!worker->ready.empty()) {
+      queue = worker->ready.front();
+      worker->ready.pop_front();
+      return queue;
+    }
+  }
+  {
+    MutexLock lock(&lock_);
+    if (!injected_.empty()) {
+      queue = injected_.front();
+      injected_.pop_front();
+      return queue;
+    }
+  }
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    PoolWorker* victim = workers_[(worker->index + i) % workers_.size()].get();
+    MutexLock lock(&victim->lock);
+    if (!victim->ready.empty()) {
+      queue = victim->ready.back();
+      victim->ready.pop_back();
+      return queue;
+    }
+  }
+  return nullptr;
+}
+
+void ThreadPool::WakeIdleWorker() {
+  PoolWorker* worker;
+  {
+    MutexLock lock(&lock_);
+    if (idle_workers_.empty()) {
+      return;
+    }
+    worker = idle_workers_.back();
+    idle_workers_.pop_back();
+  }
+  worker->wake.Set();
+}
+
+class TaskQueueThreadPoolFactory final : public TaskQueueFactory {
+ public:
+  explicit TaskQueueThreadPoolFactory(int num_threads)
+      : pool_(std::make_unique<ThreadPool>(num_threads)) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new PooledTaskQueue(pool_.get()));
+  }
+
+ private:
+  const std::unique_ptr<ThreadPool> pool_;
+};
+
+}  // namespace
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueThreadPoolFactory(
+    int num_threads) {
+  return std::make_unique<TaskQueueThreadPoolFactory>(num_threads);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,34 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef RTC_BASE_TASK_QUEUE_THREAD_POOL_H_
+#define RTC_BASE_TASK_QUEUE_THREAD_POOL_H_
+
+#include <memory>
+
+#include "api/task_queue/task_queue_factory.h"
+
+namespace webrtc {
+
+// Creates a factory whose task queues share a pool of `num_threads` worker
+// threads, instead of owning a thread each like the ones of
+// CreateTaskQueueStdlibFactory(). Typically `num_threads` is the number of
+// cores. Tasks of one task queue run in order and never overlap, but may run
+// on different worker threads. Idle workers steal task queues ready to run
+// from busy ones.
+//
+// The worker threads run with normal priority, so the priority of the
+// created task queues is ignored. A task that blocks holds up one worker
+// thread. All task queues must be deleted before the factory.
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueThreadPoolFactory(
+    int num_threads);
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_QUEUE_THREAD_POOL_H_
@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_thread_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_test.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/event.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::unique_ptr<TaskQueueFactory> CreateTaskQueueFactory(
+    const webrtc::FieldTrialsView*) {
+  return CreateTaskQueueThreadPoolFactory(/*num_threads=*/4);
+}
+
+std::unique_ptr<TaskQueueFactory> CreateSingleThreadTaskQueueFactory(
+    const webrtc::FieldTrialsView*) {
+  return CreateTaskQueueThreadPoolFactory(/*num_threads=*/1);
+}
+
+INSTANTIATE_TEST_SUITE_P(TaskQueueThreadPool,
+                         TaskQueueTest,
+                         ::testing::Values(CreateTaskQueueFactory,
+                                           CreateSingleThreadTaskQueueFactory));
+
+TEST(TaskQueueThreadPoolTest, KeepsOrderOfMoreQueuesThanThreads) {
+  constexpr int kNumQueues = 50;
+  constexpr int kNumTasks = 200;
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueThreadPoolFactory(/*num_threads=*/3);
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>> queues;
+  std::vector<std::vector<int>> executed(kNumQueues);
+  std::vector<bool> current_ok(kNumQueues, true);
+  Mutex lock;
+  int queues_done = 0;
+  rtc::Event done;
+  for (int q = 0; q < kNumQueues; ++q) {
+    queues.push_back(factory->CreateTaskQueue(
+        "Queue", TaskQueueFactory::Priority::NORMAL));
+  }
+  for (int i = 0; i < kNumTasks; ++i) {
+    for (int q = 0; q < kNumQueues; ++q) {
+      TaskQueueBase* queue = queues[q].get();
+      queue->PostTask([&, queue, q, i] {
+        // Tasks of one queue never overlap, so no locking is needed here.
+        executed[q].push_back(i);
+        if (!queue->IsCurrent()) {
+          current_ok[q] = false;
+        }
+        if (i == kNumTasks - 1) {
+          MutexLock l(&lock);
+          if (++queues_done == kNumQueues) {
+            done.Set();
+          }
+        }
+      });
+    }
+  }
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+  queues.clear();
+
+  for (int q = 0; q < kNumQueues; ++q) {
+    ASSERT_EQ(executed[q].size(), static_cast<size_t>(kNumTasks));
+    for (int i = 0; i < kNumTasks; ++i) {
+      EXPECT_EQ(executed[q][i], i);
+    }
+    EXPECT_TRUE(current_ok[q]);
+  }
+}
+
+TEST(TaskQueueThreadPoolTest, StealsQueuesMadeReadyByBlockedWorker) {
+  std::unique_ptr<TaskQueueFactory> factory =
+      CreateTaskQueueThreadPoolFactory(/*num_threads=*/2);
+  auto blocked = factory->CreateTaskQueue("Blocked",
+                                          TaskQueueFactory::Priority::NORMAL);
+  auto other =
+      factory->CreateTaskQueue("Other", TaskQueueFactory::Priority::NORMAL);
+  rtc::Event unblock;
+  rtc::Event other_ran;
+  blocked->PostTask([&] {
+    // `other` is made ready on the worker running this task, which then
+    // blocks, so that the other worker has to steal it.
+    other->PostTask([&] { other_ran.Set(); });
+    unblock.Wait(rtc::Event::kForever);
+  });
+  EXPECT_TRUE(other_ran.Wait(TimeDelta::Seconds(5)));
+  unblock.Set();
+}
+
+}  // namespace
+}  // namespace webrtc
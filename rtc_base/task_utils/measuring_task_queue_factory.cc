@@ -0,0 +1,288 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_utils/measuring_task_queue_factory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <utility>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/strings/str_cat.h"
+#include "api/location.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/metrics.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kMaxHistogramDelayMs = 10000;
+constexpr int kHistogramBuckets = 50;
+
+metrics::Histogram* GetDelayHistogram(absl::string_view name,
+                                      absl::string_view metric) {
+  return metrics::HistogramFactoryGetCounts(
+      absl::StrCat("WebRTC.TaskQueue.", name, ".", metric), 1,
+      kMaxHistogramDelayMs, kHistogramBuckets);
+}
+
+void AddToHistogram(metrics::Histogram* histogram, int64_t sample_us) {
+  // Like the RTC_HISTOGRAM macros, samples are dropped when metrics aren't
+  // collected.
+  if (histogram != nullptr) {
+    metrics::HistogramAdd(histogram,
+                          static_cast<int>(std::min<int64_t>(
+                              sample_us / rtc::kNumMicrosecsPerMillisec,
+                              kMaxHistogramDelayMs)));
+  }
+}
+
+}  // namespace
+
+class MeasuringTaskQueueFactory::Counters {
+ public:
+  explicit Counters(absl::string_view name)
+      : queuing_delay_histogram_(GetDelayHistogram(name, "QueuingDelayInMs")),
+        run_duration_histogram_(GetDelayHistogram(name, "RunDurationInMs")) {}
+
+  void AddTask(int64_t cpu_time_ns,
+               int64_t queuing_delay_us,
+               int64_t run_duration_us) {
+    AddToHistogram(queuing_delay_histogram_, queuing_delay_us);
+    AddToHistogram(run_duration_histogram_, run_duration_us);
+    MutexLock lock(&mutex_);
+    ++tasks_run_;
+    cpu_time_ns_ += cpu_time_ns;
+    total_queuing_delay_us_ += queuing_delay_us;
+    max_queuing_delay_us_ = std::max(max_queuing_delay_us_, queuing_delay_us);
+    total_run_duration_us_ += run_duration_us;
+    max_run_duration_us_ = std::max(max_run_duration_us_, run_duration_us);
+  }
+
+  void UpdateQueueDepth(int queue_depth) {
+    MutexLock lock(&mutex_);
+    max_queue_depth_ = std::max(max_queue_depth_, queue_depth);
+  }
+
+  TaskQueueUsage GetUsage() const {
+    MutexLock lock(&mutex_);
+    TaskQueueUsage usage;
+    usage.tasks_run = tasks_run_;
+    usage.cpu_time =
+        TimeDelta::Micros(cpu_time_ns_ / rtc::kNumNanosecsPerMicrosec);
+    usage.total_queuing_delay = TimeDelta::Micros(total_queuing_delay_us_);
+    usage.max_queuing_delay = TimeDelta::Micros(max_queuing_delay_us_);
+    usage.total_run_duration = TimeDelta::Micros(total_run_duration_us_);
+    usage.max_run_duration = TimeDelta::Micros(max_run_duration_us_);
+    usage.max_queue_depth = max_queue_depth_;
+    return usage;
+  }
+
+ private:
+  metrics::Histogram* const queuing_delay_histogram_;
+  metrics::Histogram* const run_duration_histogram_;
+  mutable Mutex mutex_;
+  int64_t tasks_run_ RTC_GUARDED_BY(mutex_) = 0;
+  int64_t cpu_time_ns_ RTC_GUARDED_BY(mutex_) = 0;
+  int64_t total_queuing_delay_us_ RTC_GUARDED_BY(mutex_) = 0;
+  int64_t max_queuing_delay_us_ RTC_GUARDED_BY(mutex_) = 0;
+  int64_t total_run_duration_us_ RTC_GUARDED_BY(mutex_) = 0;
+  int64_t max_run_duration_us_ RTC_GUARDED_BY(mutex_) = 0;
+  int max_queue_depth_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
+// Posts wrapped tasks to the task queue created by the wrapped factory. The
+// wrapped tasks make `Current()` return this task queue, so that `IsCurrent()`
+// is true for the task queue that tasks were posted to.
+class MeasuringTaskQueueFactory::MeasuringTaskQueue : public TaskQueueBase {
+ public:
+  MeasuringTaskQueue(absl::string_view name,
+                     std::unique_ptr<TaskQueueBase, TaskQueueDeleter> queue,
+                     std::shared_ptr<Counters> counters,
+                     TimeDelta slow_task_threshold)
+      : state_(std::make_shared<State>(name,
+                                       std::move(counters),
+                                       slow_task_threshold)),
+        queue_(std::move(queue)) {}
+
+  void Delete() override {
+    // Destroys the pending tasks so their destruction, too, happens with
+    // `Current()` pointing to this task queue. Task queue implementations
+    // whose Delete() doesn't wait may still run or destroy tasks afterwards;
+    // those only use the shared `State`, which they keep alive.
+    queue_ = nullptr;
+    delete this;
+  }
+
+ private:
+  // Measurement state shared with the wrapped tasks.
+  class State {
+   public:
+    State(absl::string_view name,
+          std::shared_ptr<Counters> counters,
+          TimeDelta slow_task_threshold)
+        : name_(name),
+          counters_(std::move(counters)),
+          slow_task_threshold_(slow_task_threshold) {}
+
+    void OnTaskQueued() {
+      counters_->UpdateQueueDepth(
+          queue_depth_.fetch_add(1, std::memory_order_relaxed) + 1);
+    }
+
+    void OnTaskDequeued() {
+      queue_depth_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void OnTaskRun(int64_t cpu_time_ns,
+                   int64_t queuing_delay_us,
+                   int64_t run_duration_us) {
+      counters_->AddTask(cpu_time_ns, queuing_delay_us, run_duration_us);
+      if (TimeDelta::Micros(run_duration_us) > slow_task_threshold_) {
+        // `Location` carries no information outside of Chromium, hence only
+        // the task queue is logged.
+        RTC_LOG(LS_WARNING) << "Task on task queue " << name_ << " ran for "
+                            << run_duration_us / rtc::kNumMicrosecsPerMillisec
+                            << " ms, after waiting for "
+                            << queuing_delay_us / rtc::kNumMicrosecsPerMillisec
+                            << " ms.";
+      }
+    }
+
+   private:
+    const std::string name_;
+    const std::shared_ptr<Counters> counters_;
+    const TimeDelta slow_task_threshold_;
+    std::atomic<int> queue_depth_{0};
+  };
+
+  class MeasuredTask {
+   public:
+    // `queue` is only used as the value of `Current()` while the task runs or
+    // is destroyed, and isn't dereferenced.
+    MeasuredTask(TaskQueueBase* queue,
+                 std::shared_ptr<State> state,
+                 absl::AnyInvocable<void() &&> task,
+                 int64_t due_time_us)
+        : queue_(queue),
+          state_(std::move(state)),
+          task_(std::move(task)),
+          due_time_us_(due_time_us) {}
+    MeasuredTask(MeasuredTask&& other)
+        : queue_(other.queue_),
+          state_(other.state_),
+          task_(std::exchange(other.task_, nullptr)),
+          due_time_us_(other.due_time_us_) {}
+    MeasuredTask& operator=(MeasuredTask&&) = delete;
+    ~MeasuredTask() {
+      if (task_) {
+        // The task is destroyed without having run.
+        state_->OnTaskDequeued();
+        CurrentTaskQueueSetter set_current(queue_);
+        task_ = nullptr;
+      }
+    }
+
+    void operator()() && {
+      state_->OnTaskDequeued();
+      CurrentTaskQueueSetter set_current(queue_);
+      int64_t start_time_us = rtc::TimeMicros();
+      int64_t start_cpu_time_ns = rtc::GetThreadCpuTimeNanos();
+      std::move(task_)();
+      task_ = nullptr;
+      state_->OnTaskRun(rtc::GetThreadCpuTimeNanos() - start_cpu_time_ns,
+                        std::max<int64_t>(start_time_us - due_time_us_, 0),
+                        rtc::TimeMicros() - start_time_us);
+    }
+
+   private:
+    TaskQueueBase* const queue_;
+    const std::shared_ptr<State> state_;
+    absl::AnyInvocable<void() &&> task_;
+    const int64_t due_time_us_;
+  };
+
+  ~MeasuringTaskQueue() override = default;
+
+  void PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                    const PostTaskTraits& traits,
+                    const Location& location) override {
+    state_->OnTaskQueued();
+    queue_->PostTask(
+        MeasuredTask(this, state_, std::move(task), rtc::TimeMicros()),
+        location);
+  }
+
+  void PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                           TimeDelta delay,
+                           const PostDelayedTaskTraits& traits,
+                           const Location& location) override {
+    state_->OnTaskQueued();
+    MeasuredTask measured_task(this, state_, std::move(task),
+                               rtc::TimeMicros() + delay.us());
+    if (traits.high_precision) {
+      queue_->PostDelayedHighPrecisionTask(std::move(measured_task), delay,
+                                           location);
+    } else {
+      queue_->PostDelayedTask(std::move(measured_task), delay, location);
+    }
+  }
+
+  const std::shared_ptr<State> state_;
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> queue_;
+};
+
+MeasuringTaskQueueFactory::MeasuringTaskQueueFactory(
+    std::unique_ptr<TaskQueueFactory> task_queue_factory,
+    TimeDelta slow_task_threshold)
+    : task_queue_factory_(std::move(task_queue_factory)),
+      slow_task_threshold_(slow_task_threshold) {
+  RTC_DCHECK(task_queue_factory_);
+}
+
+MeasuringTaskQueueFactory::~MeasuringTaskQueueFactory() = default;
+
+std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
+MeasuringTaskQueueFactory::CreateTaskQueue(absl::string_view name,
+                                           Priority priority) const {
+  std::shared_ptr<Counters> counters;
+  {
+    MutexLock lock(&mutex_);
+    auto it = counters_.find(name);
+    if (it == counters_.end()) {
+      it = counters_
+               .emplace(std::string(name), std::make_shared<Counters>(name))
+               .first;
+    }
+    counters = it->second;
+  }
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> queue =
+      task_queue_factory_->CreateTaskQueue(name, priority);
+  return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+      new MeasuringTaskQueue(name, std::move(queue), std::move(counters),
+                             slow_task_threshold_));
+}
+
+std::vector<TaskQueueUsage> MeasuringTaskQueueFactory::GetUsage() const {
+  MutexLock lock(&mutex_);
+  std::vector<TaskQueueUsage> usage;
+  usage.reserve(counters_.size());
+  for (const auto& [name, counters] : counters_) {
+    usage.push_back(counters->GetUsage());
+    usage.back().name = name;
+  }
+  return usage;
+}
+
+}  // namespace webrtc
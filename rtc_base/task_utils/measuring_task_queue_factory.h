@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TASK_UTILS_MEASURING_TASK_QUEUE_FACTORY_H_
+#define RTC_BASE_TASK_UTILS_MEASURING_TASK_QUEUE_FACTORY_H_
+
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Resources used by the tasks of all task queues with the same name.
+struct TaskQueueUsage {
+  std::string name;
+  int64_t tasks_run = 0;
+  // CPU time of the task queue threads while running the tasks.
+  TimeDelta cpu_time = TimeDelta::Zero();
+  // Time from when the tasks were due, i.e. when they were posted or when
+  // their delay expired, until they started to run.
+  TimeDelta total_queuing_delay = TimeDelta::Zero();
+  TimeDelta max_queuing_delay = TimeDelta::Zero();
+  // Wall clock time from when the tasks started to run until they returned.
+  TimeDelta total_run_duration = TimeDelta::Zero();
+  TimeDelta max_run_duration = TimeDelta::Zero();
+  // Largest number of tasks, including delayed tasks, that were posted to a
+  // single task queue and had not run yet.
+  int max_queue_depth = 0;
+};
+
+// Wraps a TaskQueueFactory, measuring the tasks run by the task queues that it
+// creates. Passing it as the `task_queue_factory` of e.g.
+// PeerConnectionFactoryDependencies shows how the CPU time of an application
+// is spent on the different WebRTC task queues, and how long tasks wait for
+// their queue to become idle. Measuring adds a thread CPU time query before
+// and after each task.
+//
+// The queuing delay and run duration of each task are also added to the
+// "WebRTC.TaskQueue.<name>.QueuingDelayInMs" and
+// "WebRTC.TaskQueue.<name>.RunDurationInMs" histograms, and tasks that run
+// for longer than `slow_task_threshold` are logged as warnings.
+class MeasuringTaskQueueFactory : public TaskQueueFactory {
+ public:
+  explicit MeasuringTaskQueueFactory(
+      std::unique_ptr<TaskQueueFactory> task_queue_factory,
+      TimeDelta slow_task_threshold = TimeDelta::PlusInfinity());
+  ~MeasuringTaskQueueFactory() override;
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override;
+
+  // Returns the usage per task queue name, sorted by name. Task queues that
+  // have been deleted are included. May be called on any thread.
+  std::vector<TaskQueueUsage> GetUsage() const;
+
+ private:
+  class Counters;
+  class MeasuringTaskQueue;
+
+  const std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  const TimeDelta slow_task_threshold_;
+  mutable Mutex mutex_;
+  mutable std::map<std::string, std::shared_ptr<Counters>, std::less<>>
+      counters_ RTC_GUARDED_BY(mutex_);
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TASK_UTILS_MEASURING_TASK_QUEUE_FACTORY_H_
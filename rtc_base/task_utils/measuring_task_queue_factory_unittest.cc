@@ -0,0 +1,292 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_utils/measuring_task_queue_factory.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/strings/string_view.h"
+#include "api/field_trials_view.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/task_queue/task_queue_test.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/metrics.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+class WarningLogSink : public rtc::LogSink {
+ public:
+  WarningLogSink() { rtc::LogMessage::AddLogToStream(this, rtc::LS_WARNING); }
+  ~WarningLogSink() override { rtc::LogMessage::RemoveLogToStream(this); }
+
+  void OnLogMessage(const std::string& message) override {
+    MutexLock lock(&mutex_);
+    log_ += message;
+  }
+
+  std::string log() const {
+    MutexLock lock(&mutex_);
+    return log_;
+  }
+
+ private:
+  mutable Mutex mutex_;
+  std::string log_;
+};
+
+// Creates task queues which don't wait for their tasks in Delete(), but leave
+// them in `tasks` to be run or destroyed later, like task queue
+// implementations that hand their tasks off to a system thread pool.
+class NonWaitingTaskQueueFactory : public TaskQueueFactory {
+ public:
+  explicit NonWaitingTaskQueueFactory(
+      std::vector<absl::AnyInvocable<void() &&>>* tasks)
+      : tasks_(tasks) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new NonWaitingTaskQueue(tasks_));
+  }
+
+ private:
+  class NonWaitingTaskQueue : public TaskQueueBase {
+   public:
+    explicit NonWaitingTaskQueue(
+        std::vector<absl::AnyInvocable<void() &&>>* tasks)
+        : tasks_(tasks) {}
+    void Delete() override { delete this; }
+
+   private:
+    void PostTaskImpl(absl::AnyInvocable<void() &&> task,
+                      const PostTaskTraits& traits,
+                      const Location& location) override {
+      tasks_->push_back(std::move(task));
+    }
+    void PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
+                             TimeDelta delay,
+                             const PostDelayedTaskTraits& traits,
+                             const Location& location) override {
+      tasks_->push_back(std::move(task));
+    }
+
+    std::vector<absl::AnyInvocable<void() &&>>* const tasks_;
+  };
+
+  std::vector<absl::AnyInvocable<void() &&>>* const tasks_;
+};
+
+std::unique_ptr<TaskQueueFactory> CreateMeasuringTaskQueueFactory(
+    const FieldTrialsView* field_trials) {
+  return std::make_unique<MeasuringTaskQueueFactory>(
+      CreateDefaultTaskQueueFactory(field_trials));
+}
+
+INSTANTIATE_TEST_SUITE_P(Measuring,
+                         TaskQueueTest,
+                         ::testing::Values(CreateMeasuringTaskQueueFactory));
+
+TEST(MeasuringTaskQueueFactoryTest, CountsTasksPerTaskQueueName) {
+  MeasuringTaskQueueFactory factory(CreateDefaultTaskQueueFactory());
+  auto queue_a =
+      factory.CreateTaskQueue("a", TaskQueueFactory::Priority::NORMAL);
+  auto queue_b = factory.CreateTaskQueue("b", TaskQueueFactory::Priority::LOW);
+
+  rtc::Event done;
+  queue_a->PostTask([] {});
+  queue_a->PostTask([&] { done.Set(); });
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+  queue_b->PostDelayedTask([&] { done.Set(); }, TimeDelta::Millis(1));
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+  // Deleting the task queues waits for the running tasks to be accounted.
+  queue_a = nullptr;
+  queue_b = nullptr;
+
+  std::vector<TaskQueueUsage> usage = factory.GetUsage();
+  ASSERT_EQ(usage.size(), 2u);
+  EXPECT_EQ(usage[0].name, "a");
+  EXPECT_EQ(usage[0].tasks_run, 2);
+  EXPECT_EQ(usage[1].name, "b");
+  EXPECT_EQ(usage[1].tasks_run, 1);
+}
+
+TEST(MeasuringTaskQueueFactoryTest, KeepsUsageOfDeletedTaskQueues) {
+  MeasuringTaskQueueFactory factory(CreateDefaultTaskQueueFactory());
+  for (int i = 0; i < 2; ++i) {
+    auto queue =
+        factory.CreateTaskQueue("queue", TaskQueueFactory::Priority::NORMAL);
+    rtc::Event done;
+    queue->PostTask([&] { done.Set(); });
+    ASSERT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+  }
+
+  std::vector<TaskQueueUsage> usage = factory.GetUsage();
+  ASSERT_EQ(usage.size(), 1u);
+  EXPECT_EQ(usage[0].name, "queue");
+  EXPECT_EQ(usage[0].tasks_run, 2);
+}
+
+TEST(MeasuringTaskQueueFactoryTest,
+     TasksOutlivingTheirTaskQueueAreMeasuredSafely) {
+  std::vector<absl::AnyInvocable<void() &&>> tasks;
+  MeasuringTaskQueueFactory factory(
+      std::make_unique<NonWaitingTaskQueueFactory>(&tasks));
+  auto queue =
+      factory.CreateTaskQueue("queue", TaskQueueFactory::Priority::NORMAL);
+  bool ran = false;
+  queue->PostTask([&] { ran = true; });
+  queue->PostDelayedTask([] {}, TimeDelta::Millis(1));
+  queue = nullptr;
+
+  ASSERT_EQ(tasks.size(), 2u);
+  std::move(tasks[0])();
+  tasks.clear();
+  EXPECT_TRUE(ran);
+
+  std::vector<TaskQueueUsage> usage = factory.GetUsage();
+  ASSERT_EQ(usage.size(), 1u);
+  EXPECT_EQ(usage[0].tasks_run, 1);
+  EXPECT_EQ(usage[0].max_queue_depth, 2);
+}
+
+TEST(MeasuringTaskQueueFactoryTest, MeasuresQueuingDelay) {
+  MeasuringTaskQueueFactory factory(CreateDefaultTaskQueueFactory());
+  auto queue =
+      factory.CreateTaskQueue("queue", TaskQueueFactory::Priority::NORMAL);
+
+  // The second task has to wait for the first one to finish.
+  rtc::Event unblock;
+  rtc::Event done;
+  queue->PostTask([&] { unblock.Wait(rtc::Event::kForever); });
+  queue->PostTask([&] { done.Set(); });
+  rtc::Event().Wait(TimeDelta::Millis(20));
+  unblock.Set();
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+  queue = nullptr;
+
+  std::vector<TaskQueueUsage> usage = factory.GetUsage();
+  ASSERT_EQ(usage.size(), 1u);
+  EXPECT_EQ(usage[0].tasks_run, 2);
+  EXPECT_GE(usage[0].max_queuing_delay, TimeDelta::Millis(20));
+  EXPECT_GE(usage[0].total_queuing_delay, usage[0].max_queuing_delay);
+}
+
+TEST(MeasuringTaskQueueFactoryTest, MeasuresCpuTime) {
+  MeasuringTaskQueueFactory factory(CreateDefaultTaskQueueFactory());
+  auto queue =
+      factory.CreateTaskQueue("queue", TaskQueueFactory::Priority::NORMAL);
+
+  rtc::Event done;
+  queue->PostTask([&] {
+    // Spins until the thread has used some CPU time.
+    const int64_t start_ns = rtc::GetThreadCpuTimeNanos();
+    while (rtc::GetThreadCpuTimeNanos() - start_ns <
+           5 * rtc::kNumNanosecsPerMillisec) {
+    }
+    done.Set();
+  });
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+  queue = nullptr;
+
+  std::vector<TaskQueueUsage> usage = factory.GetUsage();
+  ASSERT_EQ(usage.size(), 1u);
+  EXPECT_GE(usage[0].cpu_time, TimeDelta::Millis(5));
+}
+
+TEST(MeasuringTaskQueueFactoryTest, MeasuresMaxQueueDepth) {
+  MeasuringTaskQueueFactory factory(CreateDefaultTaskQueueFactory());
+  auto queue =
+      factory.CreateTaskQueue("queue", TaskQueueFactory::Priority::NORMAL);
+
+  rtc::Event unblock;
+  rtc::Event done;
+  queue->PostTask([&] { unblock.Wait(rtc::Event::kForever); });
+  // Not run before the task queue is deleted, but still counted.
+  queue->PostDelayedTask([] {}, TimeDelta::Seconds(100));
+  for (int i = 0; i < 3; ++i) {
+    queue->PostTask([] {});
+  }
+  queue->PostTask([&] { done.Set(); });
+  unblock.Set();
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+  queue = nullptr;
+
+  std::vector<TaskQueueUsage> usage = factory.GetUsage();
+  ASSERT_EQ(usage.size(), 1u);
+  EXPECT_EQ(usage[0].tasks_run, 5);
+  // The first task may have started to run before the others were posted.
+  EXPECT_GE(usage[0].max_queue_depth, 5);
+  EXPECT_LE(usage[0].max_queue_depth, 6);
+}
+
+TEST(MeasuringTaskQueueFactoryTest, MeasuresRunDuration) {
+  metrics::Reset();
+  MeasuringTaskQueueFactory factory(CreateDefaultTaskQueueFactory());
+  auto queue =
+      factory.CreateTaskQueue("queue", TaskQueueFactory::Priority::NORMAL);
+
+  rtc::Event done;
+  queue->PostTask([] { rtc::Event().Wait(TimeDelta::Millis(20)); });
+  queue->PostTask([&] { done.Set(); });
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+  queue = nullptr;
+
+  std::vector<TaskQueueUsage> usage = factory.GetUsage();
+  ASSERT_EQ(usage.size(), 1u);
+  EXPECT_GE(usage[0].max_run_duration, TimeDelta::Millis(20));
+  EXPECT_GE(usage[0].total_run_duration, usage[0].max_run_duration);
+  EXPECT_METRIC_EQ(
+      metrics::NumSamples("WebRTC.TaskQueue.queue.RunDurationInMs"), 2);
+  EXPECT_METRIC_EQ(
+      metrics::NumSamples("WebRTC.TaskQueue.queue.QueuingDelayInMs"), 2);
+}
+
+TEST(MeasuringTaskQueueFactoryTest, LogsSlowTasks) {
+  WarningLogSink log_sink;
+  MeasuringTaskQueueFactory factory(
+      CreateDefaultTaskQueueFactory(),
+      /*slow_task_threshold=*/TimeDelta::Millis(10));
+  auto queue =
+      factory.CreateTaskQueue("slow_queue", TaskQueueFactory::Priority::NORMAL);
+
+  rtc::Event done;
+  queue->PostTask([&] { done.Set(); });
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+  // Tasks are accounted before the next task on the task queue runs.
+  queue->PostTask([&] {
+    EXPECT_THAT(log_sink.log(), Not(HasSubstr("slow_queue")));
+    rtc::Event().Wait(TimeDelta::Millis(20));
+    done.Set();
+  });
+  ASSERT_TRUE(done.Wait(TimeDelta::Seconds(10)));
+  queue = nullptr;
+  EXPECT_THAT(log_sink.log(), HasSubstr("Task on task queue slow_queue ran"));
+}
+
+}  // namespace
+}  // namespace webrtc
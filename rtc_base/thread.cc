@@ -11,6 +11,7 @@
 #include "rtc_base/thread.h"
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/socket_server.h"
@@ -31,6 +32,7 @@
 
 #include <stdio.h>
 
+#include <deque>
 #include <utility>
 
 #include "absl/algorithm/container.h"
@@ -316,8 +318,7 @@ Thread::Thread(std::unique_ptr<SocketServer> ss)
     : Thread(std::move(ss), /*do_init=*/true) {}
 
 Thread::Thread(SocketServer* ss, bool do_init)
-    : delayed_next_num_(0),
-      fInitialized_(false),
+    : fInitialized_(false),
       fDestroyed_(false),
       stop_(0),
       ss_(ss) {
@@ -363,8 +364,8 @@ void Thread::DoDestroy() {
   ThreadManager::Remove(this);
   // Clear.
   CurrentTaskQueueSetter set_current(this);
-  messages_ = {};
-  delayed_messages_ = {};
+  messages_.Clear();
+  delayed_messages_.Clear();
 }
 
 SocketServer* Thread::socketserver() {
@@ -399,27 +400,25 @@ absl::AnyInvocable<void() &&> Thread::Get(int cmsWait) {
     // Check for posted events
     int64_t cmsDelayNext = kForever;
     {
-      // All queue operations need to be locked, but nothing else in this loop
-      // can happen while holding the `mutex_`.
+      // Delayed messages need to be locked, but nothing else in this loop can
+      // happen while holding the `mutex_`.
       MutexLock lock(&mutex_);
       // Check for delayed messages that have been triggered and calculate the
       // next trigger time.
-      while (!delayed_messages_.empty()) {
-        if (msCurrent < delayed_messages_.top().run_time_ms) {
-          cmsDelayNext =
-              TimeDiff(delayed_messages_.top().run_time_ms, msCurrent);
-          break;
-        }
-        messages_.push(std::move(delayed_messages_.top().functor));
-        delayed_messages_.pop();
-      }
-      // Pull a message off the message queue, if available.
-      if (!messages_.empty()) {
-        absl::AnyInvocable<void()&&> task = std::move(messages_.front());
-        messages_.pop();
-        return task;
+      delayed_messages_.PopExpired(
+          msCurrent, [this](absl::AnyInvocable<void() &&> functor) {
+            messages_.Push(std::move(functor));
+          });
+      if (absl::optional<int64_t> wake_up_ms =
+              delayed_messages_.NextWakeUpMs()) {
+        cmsDelayNext = TimeDiff(*wake_up_ms, msCurrent);
       }
     }
+    // Pull a message off the message queue, if available.
+    absl::AnyInvocable<void()&&> task;
+    if (messages_.Pop(task)) {
+      return task;
+    }
 
     if (IsQuitting())
       break;
@@ -436,10 +435,20 @@ absl::AnyInvocable<void() &&> Thread::Get(int cmsWait) {
     }
 
     {
+      // Posting only wakes the socket server once the flag is set, so check
+      // again for messages posted before.
+      waiting_for_messages_.store(true);
+      if (!messages_.empty()) {
+        waiting_for_messages_.store(false);
+        continue;
+      }
       // Wait and multiplex in the meantime
-      if (!ss_->Wait(cmsNext == kForever ? SocketServer::kForever
-                                         : webrtc::TimeDelta::Millis(cmsNext),
-                     /*process_io=*/true))
+      bool waited =
+          ss_->Wait(cmsNext == kForever ? SocketServer::kForever
+                                        : webrtc::TimeDelta::Millis(cmsNext),
+                    /*process_io=*/true);
+      waiting_for_messages_.store(false);
+      if (!waited)
         return nullptr;
     }
 
@@ -462,15 +471,13 @@ void Thread::PostTaskImpl(absl::AnyInvocable<void() &&> task,
     return;
   }
 
-  // Keep thread safe
-  // Add the message to the end of the queue
-  // Signal for the multiplexer to return
-
-  {
-    MutexLock lock(&mutex_);
-    messages_.push(std::move(task));
+  // Add the message to the end of the queue, without taking `mutex_`, and
+  // signal for the multiplexer to return if the thread waits on it. A thread
+  // busy running messages finds this one before waiting again.
+  messages_.Push(std::move(task));
+  if (waiting_for_messages_.exchange(false)) {
+    WakeUpSocketServer();
   }
-  WakeUpSocketServer();
 }
 
 void Thread::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
@@ -482,34 +489,30 @@ void Thread::PostDelayedTaskImpl(absl::AnyInvocable<void() &&> task,
   }
 
   // Keep thread safe
-  // Add to the priority queue. Gets sorted soonest first.
+  // Add to the timer wheel. Gets sorted soonest first.
   // Signal for the multiplexer to return.
 
   int64_t delay_ms = delay.RoundUpTo(webrtc::TimeDelta::Millis(1)).ms<int>();
-  int64_t run_time_ms = TimeAfter(delay_ms);
+  int64_t now_ms = TimeMillis();
   {
     MutexLock lock(&mutex_);
-    delayed_messages_.push({.delay_ms = delay_ms,
-                            .run_time_ms = run_time_ms,
-                            .message_number = delayed_next_num_,
-                            .functor = std::move(task)});
-    // If this message queue processes 1 message every millisecond for 50 days,
-    // we will wrap this number.  Even then, only messages with identical times
-    // will be misordered, and then only briefly.  This is probably ok.
-    ++delayed_next_num_;
-    RTC_DCHECK_NE(0, delayed_next_num_);
+    // Deadlines are kept exact, even with low precision, since code running
+    // on a Thread with a FakeClock expects delayed tasks to run as soon as
+    // the clock reaches them.
+    delayed_messages_.Insert(now_ms, now_ms + delay_ms, /*coalesce=*/false,
+                             std::move(task));
   }
   WakeUpSocketServer();
 }
 
 int Thread::GetDelay() {
-  MutexLock lock(&mutex_);
-
   if (!messages_.empty())
     return 0;
 
-  if (!delayed_messages_.empty()) {
-    int delay = TimeUntil(delayed_messages_.top().run_time_ms);
+  MutexLock lock(&mutex_);
+
+  if (absl::optional<int64_t> wake_up_ms = delayed_messages_.NextWakeUpMs()) {
+    int delay = TimeUntil(*wake_up_ms);
     if (delay < 0)
       delay = 0;
     return delay;
@@ -13,10 +13,10 @@
 
 #include <stdint.h>
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <memory>
-#include <queue>
 #include <set>
 #include <string>
 #include <type_traits>
@@ -35,11 +35,13 @@
 #include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/containers/mpsc_queue.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/socket_server.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/thread_annotations.h"
+#include "rtc_base/timer_wheel.h"
 
 #if defined(WEBRTC_WIN)
 #include "rtc_base/win32.h"
@@ -394,26 +396,6 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
     rtc::Thread* const previous_;
   };
 
-  // DelayedMessage goes into a priority queue, sorted by trigger time. Messages
-  // with the same trigger time are processed in num_ (FIFO) order.
-  struct DelayedMessage {
-    bool operator<(const DelayedMessage& dmsg) const {
-      return (dmsg.run_time_ms < run_time_ms) ||
-             ((dmsg.run_time_ms == run_time_ms) &&
-              (dmsg.message_number < message_number));
-    }
-
-    int64_t delay_ms;  // for debugging
-    int64_t run_time_ms;
-    // Monotonicaly incrementing number used for ordering of messages
-    // targeted to execute at the same time.
-    uint32_t message_number;
-    // std::priority_queue doesn't allow to extract elements, but functor
-    // is move-only and thus need to be changed when pulled out of the
-    // priority queue. That is ok because `functor` doesn't affect operator<
-    mutable absl::AnyInvocable<void() &&> functor;
-  };
-
   // TaskQueueBase implementation.
   void PostTaskImpl(absl::AnyInvocable<void() &&> task,
                     const PostTaskTraits& traits,
@@ -485,9 +467,15 @@ class RTC_LOCKABLE RTC_EXPORT Thread : public webrtc::TaskQueueBase {
   // Called by the ThreadManager when being unset as the current thread.
   void ClearCurrentTaskQueue();
 
-  std::queue<absl::AnyInvocable<void() &&>> messages_ RTC_GUARDED_BY(mutex_);
-  std::priority_queue<DelayedMessage> delayed_messages_ RTC_GUARDED_BY(mutex_);
-  uint32_t delayed_next_num_ RTC_GUARDED_BY(mutex_);
+  // Posted messages, pushed without taking `mutex_` and popped by Get().
+  webrtc::MpscQueue<absl::AnyInvocable<void() &&>> messages_;
+  // Set by Get() before waiting on the socket server, so that posting a
+  // message only wakes the socket server when the thread is idle.
+  std::atomic<bool> waiting_for_messages_{false};
+  // Delayed messages, sorted by trigger time. Messages with the same trigger
+  // time are processed in FIFO order.
+  webrtc::TimerWheel<absl::AnyInvocable<void() &&>> delayed_messages_
+      RTC_GUARDED_BY(mutex_);
 #if RTC_DCHECK_IS_ON
   uint32_t blocking_call_count_ RTC_GUARDED_BY(this) = 0;
   uint32_t could_be_blocking_call_count_ RTC_GUARDED_BY(this) = 0;
@@ -0,0 +1,240 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_TIMER_WHEEL_H_
+#define RTC_BASE_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+
+namespace webrtc {
+
+// Hierarchical timing wheel of values expiring at a millisecond run time, for
+// the delayed tasks of task queues. Inserting is constant time, instead of
+// logarithmic in the number of pending values for a std::map or a
+// std::priority_queue. The first level has a slot per millisecond for the
+// next 256 ms, and each of the four next levels has 64 slots, each spanning
+// the whole level below. Values move down a level when the current time
+// reaches their slot.
+//
+// Values expire in order of run time, and in insertion order for the same run
+// time. Coalesced values have their run time rounded up to a multiple of
+// `kCoalescingMs`, so that nearby deadlines expire together and share a wake
+// up.
+template <typename T>
+class TimerWheel {
+ public:
+  static constexpr int64_t kCoalescingMs = 16;
+
+  TimerWheel() = default;
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+
+  // Adds `value`, to expire at `run_time_ms`. `now_ms` is the current time,
+  // and run times before the last call to PopExpired() expire in the next.
+  void Insert(int64_t now_ms, int64_t run_time_ms, bool coalesce, T value) {
+    if (size_ == 0) {
+      current_ms_ = std::max(current_ms_, now_ms);
+    }
+    if (coalesce) {
+      // Rounds up, leaving run times which are already multiples unchanged.
+      int64_t remainder = run_time_ms % kCoalescingMs;
+      if (remainder < 0) {
+        remainder += kCoalescingMs;
+      }
+      if (remainder != 0) {
+        run_time_ms += kCoalescingMs - remainder;
+      }
+    }
+    Place(Entry{run_time_ms, next_order_++, std::move(value)});
+    ++size_;
+  }
+
+  // Calls `on_expired` with each value that expires at or before `now_ms`,
+  // and removes them.
+  template <typename Callback>
+  void PopExpired(int64_t now_ms, Callback on_expired) {
+    std::vector<Entry>& expired = expired_;
+    expired.swap(due_);
+    while (current_ms_ < now_ms && size_ > expired.size()) {
+      ++current_ms_;
+      if ((current_ms_ & kFirstLevelMask) == 0) {
+        Cascade(/*level=*/1);
+      }
+      std::vector<Entry>& slot = first_level_[current_ms_ & kFirstLevelMask];
+      MoveEntries(slot, expired);
+      num_in_level_[0] -= slot.size();
+      slot.clear();
+      MoveEntries(due_, expired);
+      due_.clear();
+      if (num_in_level_[0] == 0 && size_ > expired.size()) {
+        // Nothing expires before values move down from a higher level.
+        current_ms_ = std::min(*NextWakeUpMs() - 1, now_ms);
+      }
+    }
+    current_ms_ = std::max(current_ms_, now_ms);
+    size_ -= expired.size();
+
+    std::sort(expired.begin(), expired.end(),
+              [](const Entry& a, const Entry& b) {
+                return a.run_time_ms < b.run_time_ms ||
+                       (a.run_time_ms == b.run_time_ms && a.order < b.order);
+              });
+    for (Entry& entry : expired) {
+      on_expired(std::move(entry.value));
+    }
+    expired.clear();
+  }
+
+  // Returns the time of the next call to PopExpired() that may return values,
+  // which is at or before the next run time, or nullopt if empty.
+  absl::optional<int64_t> NextWakeUpMs() const {
+    if (size_ == 0) {
+      return absl::nullopt;
+    }
+    if (!due_.empty()) {
+      return current_ms_;
+    }
+    int64_t wake_up_ms = std::numeric_limits<int64_t>::max();
+    if (num_in_level_[0] > 0) {
+      for (int64_t t = current_ms_ + 1; t <= current_ms_ + kFirstLevelMask;
+           ++t) {
+        if (!first_level_[t & kFirstLevelMask].empty()) {
+          wake_up_ms = t;
+          break;
+        }
+      }
+    }
+    for (int level = 1; level < kNumLevels; ++level) {
+      if (num_in_level_[level] == 0) {
+        continue;
+      }
+      int shift = LevelShift(level);
+      int64_t block = current_ms_ >> shift;
+      for (int64_t b = block + 1; b <= block + kSlotsPerLevel; ++b) {
+        if (!levels_[level - 1][b & kLevelMask].empty()) {
+          wake_up_ms = std::min(wake_up_ms, b << shift);
+          break;
+        }
+      }
+    }
+    return wake_up_ms;
+  }
+
+  void Clear() {
+    for (std::vector<Entry>& slot : first_level_) {
+      slot.clear();
+    }
+    for (auto& level : levels_) {
+      for (std::vector<Entry>& slot : level) {
+        slot.clear();
+      }
+    }
+    due_.clear();
+    num_in_level_ = {};
+    size_ = 0;
+  }
+
+ private:
+  static constexpr int kFirstLevelBits = 8;
+  static constexpr int kLevelBits = 6;
+  static constexpr int kNumLevels = 5;
+  static constexpr int64_t kFirstLevelMask = (1 << kFirstLevelBits) - 1;
+  static constexpr int64_t kSlotsPerLevel = 1 << kLevelBits;
+  static constexpr int64_t kLevelMask = kSlotsPerLevel - 1;
+
+  struct Entry {
+    int64_t run_time_ms;
+    uint64_t order;
+    T value;
+  };
+
+  // Number of low bits of the time within a slot of `level`.
+  static constexpr int LevelShift(int level) {
+    return kFirstLevelBits + (level - 1) * kLevelBits;
+  }
+
+  static void MoveEntries(std::vector<Entry>& from, std::vector<Entry>& to) {
+    for (Entry& entry : from) {
+      to.push_back(std::move(entry));
+    }
+  }
+
+  void Place(Entry entry) {
+    int64_t delta = entry.run_time_ms - current_ms_;
+    if (delta <= 0) {
+      due_.push_back(std::move(entry));
+      return;
+    }
+    if (delta <= kFirstLevelMask) {
+      first_level_[entry.run_time_ms & kFirstLevelMask].push_back(
+          std::move(entry));
+      ++num_in_level_[0];
+      return;
+    }
+    // Values beyond the last level are placed at its end, and placed again
+    // when reaching it.
+    int64_t run_time_ms = entry.run_time_ms;
+    int level = 1;
+    while (level < kNumLevels - 1 &&
+           delta >= (int64_t{1} << LevelShift(level + 1))) {
+      ++level;
+    }
+    if (delta >= (int64_t{1} << LevelShift(kNumLevels))) {
+      run_time_ms = current_ms_ + (int64_t{1} << LevelShift(kNumLevels)) - 1;
+    }
+    levels_[level - 1][(run_time_ms >> LevelShift(level)) & kLevelMask]
+        .push_back(std::move(entry));
+    ++num_in_level_[level];
+  }
+
+  // Moves the values of the slot of `level` which starts at the current time
+  // to the levels below.
+  void Cascade(int level) {
+    int64_t index = (current_ms_ >> LevelShift(level)) & kLevelMask;
+    std::vector<Entry> entries = std::move(levels_[level - 1][index]);
+    levels_[level - 1][index].clear();
+    num_in_level_[level] -= entries.size();
+    for (Entry& entry : entries) {
+      Place(std::move(entry));
+    }
+    if (index == 0 && level + 1 < kNumLevels) {
+      Cascade(level + 1);
+    }
+  }
+
+  // The last processed millisecond.
+  int64_t current_ms_ = std::numeric_limits<int64_t>::min();
+  uint64_t next_order_ = 0;
+  size_t size_ = 0;
+  std::array<size_t, kNumLevels> num_in_level_ = {};
+  std::array<std::vector<Entry>, kFirstLevelMask + 1> first_level_;
+  std::array<std::array<std::vector<Entry>, kSlotsPerLevel>, kNumLevels - 1>
+      levels_;
+  // Values with a run time already passed when placed.
+  std::vector<Entry> due_;
+  // Scratch space of PopExpired(), kept to reuse its allocation.
+  std::vector<Entry> expired_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_TIMER_WHEEL_H_
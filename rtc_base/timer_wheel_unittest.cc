@@ -0,0 +1,152 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/timer_wheel.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/random.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Optional;
+
+std::vector<int> PopExpired(TimerWheel<int>& wheel, int64_t now_ms) {
+  std::vector<int> expired;
+  wheel.PopExpired(now_ms, [&](int value) { expired.push_back(value); });
+  return expired;
+}
+
+TEST(TimerWheelTest, ExpiresInRunTimeOrder) {
+  TimerWheel<int> wheel;
+  wheel.Insert(1000, 1003, /*coalesce=*/false, 3);
+  wheel.Insert(1000, 1001, /*coalesce=*/false, 1);
+  wheel.Insert(1000, 1002, /*coalesce=*/false, 2);
+  EXPECT_EQ(wheel.size(), 3u);
+
+  EXPECT_THAT(PopExpired(wheel, 1000), IsEmpty());
+  EXPECT_THAT(PopExpired(wheel, 1001), ElementsAre(1));
+  EXPECT_THAT(PopExpired(wheel, 1005), ElementsAre(2, 3));
+  EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTest, ExpiresInInsertionOrderForSameRunTime) {
+  TimerWheel<int> wheel;
+  wheel.Insert(0, 300, /*coalesce=*/false, 0);
+  // Once 300 is within the first level, a value inserted for the same run
+  // time is placed directly in its slot, where the first one arrives later.
+  EXPECT_THAT(PopExpired(wheel, 100), IsEmpty());
+  wheel.Insert(100, 300, /*coalesce=*/false, 1);
+  wheel.Insert(100, 299, /*coalesce=*/false, 2);
+  EXPECT_THAT(PopExpired(wheel, 300), ElementsAre(2, 0, 1));
+}
+
+TEST(TimerWheelTest, ExpiresValuesAlreadyDue) {
+  TimerWheel<int> wheel;
+  wheel.Insert(50, 60, /*coalesce=*/false, 1);
+  EXPECT_THAT(PopExpired(wheel, 55), IsEmpty());
+  wheel.Insert(55, 40, /*coalesce=*/false, 0);
+  EXPECT_THAT(wheel.NextWakeUpMs(), Optional(55));
+  EXPECT_THAT(PopExpired(wheel, 55), ElementsAre(0));
+  EXPECT_THAT(PopExpired(wheel, 60), ElementsAre(1));
+}
+
+TEST(TimerWheelTest, ExpiresFarFutureValues) {
+  TimerWheel<int> wheel;
+  constexpr int64_t kHour = 60 * 60 * 1000;
+  // Beyond the range of the last level.
+  wheel.Insert(0, 100 * 24 * kHour, /*coalesce=*/false, 2);
+  wheel.Insert(0, kHour, /*coalesce=*/false, 1);
+  int64_t now_ms = 0;
+  std::vector<int> expired;
+  while (!wheel.empty()) {
+    absl::optional<int64_t> wake_up_ms = wheel.NextWakeUpMs();
+    ASSERT_TRUE(wake_up_ms);
+    ASSERT_GT(*wake_up_ms, now_ms);
+    now_ms = *wake_up_ms;
+    wheel.PopExpired(now_ms, [&](int value) {
+      expired.push_back(value);
+      if (value == 1) {
+        EXPECT_EQ(now_ms, kHour);
+      } else {
+        EXPECT_EQ(now_ms, 100 * 24 * kHour);
+      }
+    });
+  }
+  EXPECT_THAT(expired, ElementsAre(1, 2));
+}
+
+TEST(TimerWheelTest, CoalescesDeadlines) {
+  TimerWheel<int> wheel;
+  wheel.Insert(1000, 1001, /*coalesce=*/true, 0);
+  wheel.Insert(1000, 1007, /*coalesce=*/true, 1);
+  wheel.Insert(1000, 1008, /*coalesce=*/true, 2);
+  wheel.Insert(1000, 1005, /*coalesce=*/false, 3);
+  EXPECT_THAT(wheel.NextWakeUpMs(), Optional(1005));
+  EXPECT_THAT(PopExpired(wheel, 1005), ElementsAre(3));
+  // All coalesced to 1008, in insertion order.
+  EXPECT_THAT(wheel.NextWakeUpMs(), Optional(1008));
+  EXPECT_THAT(PopExpired(wheel, 1008), ElementsAre(0, 1, 2));
+}
+
+TEST(TimerWheelTest, ClearRemovesAllValues) {
+  TimerWheel<int> wheel;
+  wheel.Insert(0, 10, /*coalesce=*/false, 0);
+  wheel.Insert(0, 100000, /*coalesce=*/false, 1);
+  wheel.Clear();
+  EXPECT_TRUE(wheel.empty());
+  EXPECT_EQ(wheel.NextWakeUpMs(), absl::nullopt);
+  EXPECT_THAT(PopExpired(wheel, 200000), IsEmpty());
+}
+
+TEST(TimerWheelTest, MatchesOrderedMap) {
+  Random random(12345);
+  TimerWheel<int> wheel;
+  // Reference ordered by (run time, insertion order).
+  std::map<std::pair<int64_t, int>, int> reference;
+  int64_t now_ms = 1'000'000;
+  int next_value = 0;
+  for (int round = 0; round < 2000; ++round) {
+    int num_inserts = random.Rand(0, 5);
+    for (int i = 0; i < num_inserts; ++i) {
+      // Mostly short delays, with some spanning the higher levels.
+      int64_t delay_ms = random.Rand(0, 3) == 0 ? random.Rand(0, 2'000'000)
+                                                : random.Rand(0, 300);
+      int value = next_value++;
+      wheel.Insert(now_ms, now_ms + delay_ms, /*coalesce=*/false, value);
+      reference[{now_ms + delay_ms, value}] = value;
+    }
+    absl::optional<int64_t> wake_up_ms = wheel.NextWakeUpMs();
+    if (!reference.empty()) {
+      ASSERT_TRUE(wake_up_ms);
+      ASSERT_LE(*wake_up_ms, reference.begin()->first.first);
+    }
+    now_ms += random.Rand(0, 1) == 0 ? random.Rand(0, 20)
+                                     : random.Rand(0, 100'000);
+
+    std::vector<int> expected;
+    while (!reference.empty() && reference.begin()->first.first <= now_ms) {
+      expected.push_back(reference.begin()->second);
+      reference.erase(reference.begin());
+    }
+    ASSERT_EQ(PopExpired(wheel, now_ms), expected) << "Round " << round;
+    ASSERT_EQ(wheel.size(), reference.size());
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
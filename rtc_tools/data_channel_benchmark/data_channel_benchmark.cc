@@ -17,17 +17,28 @@
  *  The negotiation does not require a 3rd party server and is done over a gRPC
  *  transport. No TURN server is configured, so both peers need to be reachable
  *  using STUN only.
+ *
+ *  To only measure the SCTP implementation, without any PeerConnection, ICE or
+ *  DTLS, transfer data between two dcSCTP sockets in the same process using:
+ *  ./data_channel_benchmark --dcsctp_loopback --transfer_size 100
+ *      --packet_size 8196 --num_channels 16 --loss_percent 1
+ *  or run a fixed set of such transfers with:
+ *  ./data_channel_benchmark --dcsctp_loopback_suite
  */
 #include <inttypes.h>
 
+#include <algorithm>
 #include <charconv>
 
 #include "absl/cleanup/cleanup.h"
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
+#include "rtc_base/cpu_time.h"
 #include "rtc_base/event.h"
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_tools/data_channel_benchmark/dcsctp_loopback.h"
 #include "rtc_tools/data_channel_benchmark/grpc_signaling.h"
 #include "rtc_tools/data_channel_benchmark/peer_connection_client.h"
 #include "system_wrappers/include/field_trial.h"
@@ -39,6 +50,23 @@ ABSL_FLAG(std::string, address, "localhost", "Connect to server address");
 ABSL_FLAG(uint16_t, port, 0, "Connect to port (0 for random)");
 ABSL_FLAG(uint64_t, transfer_size, 2, "Transfer size (MiB)");
 ABSL_FLAG(uint64_t, packet_size, 256 * 1024, "Packet size");
+ABSL_FLAG(bool,
+          unordered,
+          false,
+          "Send unordered messages (set on the server in PeerConnection mode)");
+ABSL_FLAG(bool,
+          dcsctp_loopback,
+          false,
+          "Transfer between two dcSCTP sockets in this process, without "
+          "PeerConnection, ICE or DTLS");
+ABSL_FLAG(bool,
+          dcsctp_loopback_suite,
+          false,
+          "Run dcSCTP loopback transfers over a range of packet sizes, ordering, "
+          "packet loss and number of channels");
+ABSL_FLAG(int, num_channels, 1, "Number of channels (dcSCTP loopback only)");
+ABSL_FLAG(int, loss_percent, 0, "Packet loss (dcSCTP loopback only)");
+ABSL_FLAG(int, delay_ms, 0, "One way delay (dcSCTP loopback only)");
 ABSL_FLAG(std::string,
           force_fieldtrials,
           "",
@@ -241,8 +269,10 @@ int RunServer() {
           auto peer_connection = client.peerConnection();
 
           // Set up the data channel
+          webrtc::DataChannelInit init;
+          init.ordered = !absl::GetFlag(FLAGS_unordered);
           auto dc_or_error =
-              peer_connection->CreateDataChannelOrError("benchmark", nullptr);
+              peer_connection->CreateDataChannelOrError("benchmark", &init);
           RTC_CHECK(dc_or_error.ok());
           auto data_channel = dc_or_error.MoveValue();
           auto data_channel_observer =
@@ -263,6 +293,7 @@ int RunServer() {
           absl::SleepFor(absl::Seconds(1));
 
           auto begin_time = webrtc::Clock::GetRealTimeClock()->CurrentTime();
+          int64_t begin_cpu_time_ns = rtc::GetProcessCpuTimeNanos();
 
           data_channel_observer->StartSending();
 
@@ -272,11 +303,15 @@ int RunServer() {
 
           auto end_time = webrtc::Clock::GetRealTimeClock()->CurrentTime();
           auto duration_ms = (end_time - begin_time).ms<size_t>();
-          double throughput =
-              (data_channel_observer->parameters().transfer_size / 1024. /
-               1024.) /
-              (duration_ms / 1000.);
-          printf("Elapsed time: %zums %gMiB/s\n", duration_ms, throughput);
+          double transfer_size_mib =
+              data_channel_observer->parameters().transfer_size / 1024. / 1024.;
+          double throughput = transfer_size_mib / (duration_ms / 1000.);
+          double cpu_ms_per_mib =
+              (rtc::GetProcessCpuTimeNanos() - begin_cpu_time_ns) /
+              static_cast<double>(rtc::kNumNanosecsPerMillisec) /
+              transfer_size_mib;
+          printf("Elapsed time: %zums %gMiB/s %gms CPU/MiB\n", duration_ms,
+                 throughput, cpu_ms_per_mib);
         },
         port, oneshot);
     grpc_server->Start();
@@ -357,6 +392,68 @@ int RunClient() {
   return 0;
 }
 
+void PrintLoopbackResult(const webrtc::DcSctpLoopbackConfig& config,
+                         const webrtc::DcSctpLoopbackResult& result) {
+  printf("size=%zu %s channels=%d loss=%d%%: ", config.message_size,
+         config.ordered ? "ordered" : "unordered", config.num_channels,
+         config.loss_percent);
+  if (!result.completed) {
+    printf("failed after %zu / %zu bytes\n", result.bytes_received,
+           config.transfer_size);
+    return;
+  }
+  printf("%" PRId64 "ms %gMiB/s %gms CPU/MiB %zu/%zu packets retransmitted\n",
+         result.duration.ms(), result.throughput_mib_per_second(),
+         result.cpu_ms_per_mib(), result.rtx_packets, result.tx_packets);
+}
+
+int RunDcSctpLoopback() {
+  webrtc::DcSctpLoopbackConfig config;
+  config.message_size = absl::GetFlag(FLAGS_packet_size);
+  config.transfer_size = absl::GetFlag(FLAGS_transfer_size) * 1024 * 1024;
+  config.ordered = !absl::GetFlag(FLAGS_unordered);
+  config.num_channels = absl::GetFlag(FLAGS_num_channels);
+  config.loss_percent = absl::GetFlag(FLAGS_loss_percent);
+  config.delay_ms = absl::GetFlag(FLAGS_delay_ms);
+
+  webrtc::DcSctpLoopbackResult result = webrtc::RunDcSctpLoopback(config);
+  PrintLoopbackResult(config, result);
+  return result.completed ? 0 : 1;
+}
+
+int RunDcSctpLoopbackSuite() {
+  // Small messages are bound by the per message cost, so their transfers are
+  // limited in number of messages rather than in size.
+  constexpr size_t kMaxMessages = 100'000;
+  const size_t transfer_size = absl::GetFlag(FLAGS_transfer_size) * 1024 * 1024;
+
+  int failures = 0;
+  for (size_t message_size : {1, 64, 1024, 16 * 1024, 256 * 1024}) {
+    for (bool ordered : {true, false}) {
+      for (int loss_percent : {0, 1}) {
+        for (int num_channels : {1, 256}) {
+          webrtc::DcSctpLoopbackConfig config;
+          config.message_size = message_size;
+          config.transfer_size =
+              std::min(transfer_size, message_size * kMaxMessages);
+          config.ordered = ordered;
+          config.num_channels = num_channels;
+          config.loss_percent = loss_percent;
+          config.delay_ms = absl::GetFlag(FLAGS_delay_ms);
+
+          webrtc::DcSctpLoopbackResult result =
+              webrtc::RunDcSctpLoopback(config);
+          PrintLoopbackResult(config, result);
+          if (!result.completed) {
+            ++failures;
+          }
+        }
+      }
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
+
 int main(int argc, char** argv) {
   rtc::InitializeSSL();
   absl::ParseCommandLine(argc, argv);
@@ -373,5 +470,12 @@ int main(int argc, char** argv) {
 
   webrtc::field_trial::InitFieldTrialsFromString(field_trials.c_str());
 
+  if (absl::GetFlag(FLAGS_dcsctp_loopback_suite)) {
+    return RunDcSctpLoopbackSuite();
+  }
+  if (absl::GetFlag(FLAGS_dcsctp_loopback)) {
+    return RunDcSctpLoopback();
+  }
+
   return is_server ? RunServer() : RunClient();
 }
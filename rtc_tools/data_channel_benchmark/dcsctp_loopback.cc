@@ -0,0 +1,305 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "rtc_tools/data_channel_benchmark/dcsctp_loopback.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/test/simulated_network.h"
+#include "api/units/timestamp.h"
+#include "call/simulated_network.h"
+#include "net/dcsctp/public/dcsctp_message.h"
+#include "net/dcsctp/public/dcsctp_options.h"
+#include "net/dcsctp/public/dcsctp_socket.h"
+#include "net/dcsctp/public/types.h"
+#include "net/dcsctp/socket/dcsctp_socket.h"
+#include "net/dcsctp/timer/task_queue_timeout.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace {
+
+// Binary data channel messages.
+constexpr dcsctp::PPID kPpid(53);
+
+// One of the two sockets, sending its packets to the other one over a
+// simulated link.
+class LoopbackEndpoint : public dcsctp::DcSctpSocketCallbacks {
+ public:
+  LoopbackEndpoint(absl::string_view name,
+                   rtc::Thread* thread,
+                   const DcSctpLoopbackConfig& config,
+                   uint64_t seed,
+                   rtc::Event* connected,
+                   rtc::Event& done)
+      : thread_(thread),
+        config_(config),
+        connected_(connected),
+        done_(done),
+        link_(MakeLinkConfig(config), seed),
+        random_(seed),
+        timeout_factory_(
+            *thread_,
+            [this]() { return dcsctp::TimeMs(Now().ms()); },
+            [this](dcsctp::TimeoutID timeout_id) {
+              socket_.HandleTimeout(timeout_id);
+            }),
+        socket_(name, *this, nullptr, MakeOptions(config)) {}
+
+  void set_peer(LoopbackEndpoint* peer) { peer_ = peer; }
+  dcsctp::DcSctpSocket& socket() { return socket_; }
+  size_t bytes_received() const { return bytes_received_; }
+  bool aborted() const { return aborted_; }
+
+  void StartSending() {
+    sending_ = true;
+    SendMore();
+  }
+
+  // Implementation of `dcsctp::DcSctpSocketCallbacks`.
+  dcsctp::SendPacketStatus SendPacketWithStatus(
+      rtc::ArrayView<const uint8_t> data) override {
+    uint64_t packet_id = next_packet_id_++;
+    if (link_.EnqueuePacket(
+            PacketInFlightInfo(data.size(), rtc::TimeMicros(), packet_id))) {
+      packets_in_flight_.emplace(
+          packet_id, std::vector<uint8_t>(data.begin(), data.end()));
+      MaybeScheduleDelivery();
+    }
+    // Packets dropped by a full link queue are lost, not failed to send.
+    return dcsctp::SendPacketStatus::kSuccess;
+  }
+
+  std::unique_ptr<dcsctp::Timeout> CreateTimeout(
+      TaskQueueBase::DelayPrecision precision) override {
+    return timeout_factory_.CreateTimeout(precision);
+  }
+
+  Timestamp Now() override { return Timestamp::Micros(rtc::TimeMicros()); }
+
+  uint32_t GetRandomInt(uint32_t low, uint32_t high) override {
+    return random_.Rand(low, high);
+  }
+
+  void OnMessageReceived(dcsctp::DcSctpMessage message) override {
+    bytes_received_ += message.payload().size();
+    if (bytes_received_ >= config_.transfer_size) {
+      done_.Set();
+    }
+  }
+
+  void OnError(dcsctp::ErrorKind error, absl::string_view message) override {
+    // A full send queue is expected, as the sender keeps it full.
+    if (error != dcsctp::ErrorKind::kResourceExhaustion) {
+      RTC_LOG(LS_WARNING) << "Socket error: " << dcsctp::ToString(error)
+                          << "; " << message;
+    }
+  }
+
+  void OnAborted(dcsctp::ErrorKind error, absl::string_view message) override {
+    RTC_LOG(LS_ERROR) << "Socket abort: " << dcsctp::ToString(error) << "; "
+                      << message;
+    aborted_ = true;
+    done_.Set();
+  }
+
+  void OnConnected() override {
+    if (connected_ != nullptr) {
+      connected_->Set();
+    }
+  }
+  void OnClosed() override {}
+  void OnConnectionRestarted() override {}
+  void OnStreamsResetFailed(
+      rtc::ArrayView<const dcsctp::StreamID> outgoing_streams,
+      absl::string_view reason) override {}
+  void OnStreamsResetPerformed(
+      rtc::ArrayView<const dcsctp::StreamID> outgoing_streams) override {}
+  void OnIncomingStreamsReset(
+      rtc::ArrayView<const dcsctp::StreamID> incoming_streams) override {}
+
+  void OnTotalBufferedAmountLow() override {
+    if (sending_) {
+      SendMore();
+    }
+  }
+
+ private:
+  static SimulatedNetwork::Config MakeLinkConfig(
+      const DcSctpLoopbackConfig& config) {
+    SimulatedNetwork::Config link_config;
+    link_config.loss_percent = config.loss_percent;
+    link_config.queue_delay_ms = config.delay_ms;
+    link_config.link_capacity_kbps = config.link_capacity_kbps;
+    return link_config;
+  }
+
+  static dcsctp::DcSctpOptions MakeOptions(const DcSctpLoopbackConfig& config) {
+    dcsctp::DcSctpOptions options;
+    options.max_message_size =
+        std::max(options.max_message_size, config.message_size);
+    return options;
+  }
+
+  // Fills the send queue, spreading the messages over all channels.
+  void SendMore() {
+    dcsctp::SendOptions send_options;
+    send_options.unordered = dcsctp::IsUnordered(!config_.ordered);
+    while (bytes_sent_ < config_.transfer_size) {
+      size_t size =
+          std::min(config_.message_size, config_.transfer_size - bytes_sent_);
+      dcsctp::StreamID stream_id(next_stream_id_);
+      if (socket_.Send(dcsctp::DcSctpMessage(stream_id, kPpid,
+                                             std::vector<uint8_t>(size)),
+                       send_options) != dcsctp::SendStatus::kSuccess) {
+        return;
+      }
+      bytes_sent_ += size;
+      next_stream_id_ = (next_stream_id_ + 1) % config_.num_channels;
+    }
+  }
+
+  void MaybeScheduleDelivery() {
+    absl::optional<int64_t> delivery_time_us = link_.NextDeliveryTimeUs();
+    if (!delivery_time_us.has_value() ||
+        (next_delivery_time_us_.has_value() &&
+         *next_delivery_time_us_ <= *delivery_time_us)) {
+      return;
+    }
+    // Any previously posted delivery is retired, since it's for a later time.
+    next_delivery_time_us_ = delivery_time_us;
+    int64_t delay_us = std::max<int64_t>(
+        *delivery_time_us - rtc::TimeMicros(), 0);
+    thread_->PostDelayedHighPrecisionTask(
+        SafeTask(safety_.flag(),
+                 [this, delivery_time_us = *delivery_time_us]() {
+                   if (next_delivery_time_us_ == delivery_time_us) {
+                     next_delivery_time_us_ = absl::nullopt;
+                     DeliverPackets();
+                   }
+                 }),
+        TimeDelta::Micros(delay_us));
+  }
+
+  void DeliverPackets() {
+    for (const PacketDeliveryInfo& info :
+         link_.DequeueDeliverablePackets(rtc::TimeMicros())) {
+      auto it = packets_in_flight_.find(info.packet_id);
+      RTC_DCHECK(it != packets_in_flight_.end());
+      std::vector<uint8_t> packet = std::move(it->second);
+      packets_in_flight_.erase(it);
+      if (info.receive_time_us != PacketDeliveryInfo::kNotReceived) {
+        peer_->socket().ReceivePacket(packet);
+      }
+    }
+    MaybeScheduleDelivery();
+  }
+
+  rtc::Thread* const thread_;
+  const DcSctpLoopbackConfig config_;
+  rtc::Event* const connected_;
+  rtc::Event& done_;
+  SimulatedNetwork link_;
+  Random random_;
+  dcsctp::TaskQueueTimeoutFactory timeout_factory_;
+  dcsctp::DcSctpSocket socket_;
+  LoopbackEndpoint* peer_ = nullptr;
+  uint64_t next_packet_id_ = 0;
+  std::map<uint64_t, std::vector<uint8_t>> packets_in_flight_;
+  absl::optional<int64_t> next_delivery_time_us_;
+  bool sending_ = false;
+  size_t bytes_sent_ = 0;
+  uint16_t next_stream_id_ = 0;
+  size_t bytes_received_ = 0;
+  bool aborted_ = false;
+  ScopedTaskSafety safety_;
+};
+
+}  // namespace
+
+double DcSctpLoopbackResult::throughput_mib_per_second() const {
+  return (bytes_received / 1024. / 1024.) / duration.seconds<double>();
+}
+
+double DcSctpLoopbackResult::cpu_ms_per_mib() const {
+  return cpu_time.ms<double>() / (bytes_received / 1024. / 1024.);
+}
+
+DcSctpLoopbackResult RunDcSctpLoopback(const DcSctpLoopbackConfig& config) {
+  RTC_CHECK_GT(config.message_size, 0);
+  RTC_CHECK_GT(config.num_channels, 0);
+  RTC_CHECK_LE(config.num_channels, 65535);
+
+  auto thread = rtc::Thread::Create();
+  thread->SetName("dcsctp_loopback", nullptr);
+  thread->Start();
+
+  rtc::Event connected;
+  rtc::Event done;
+  std::unique_ptr<LoopbackEndpoint> sender;
+  std::unique_ptr<LoopbackEndpoint> receiver;
+  thread->BlockingCall([&] {
+    sender = std::make_unique<LoopbackEndpoint>("A", thread.get(), config,
+                                                /*seed=*/1, &connected, done);
+    receiver = std::make_unique<LoopbackEndpoint>("Z", thread.get(), config,
+                                                  /*seed=*/2, nullptr, done);
+    sender->set_peer(receiver.get());
+    receiver->set_peer(sender.get());
+    sender->socket().Connect();
+  });
+
+  DcSctpLoopbackResult result;
+  if (connected.Wait(config.timeout)) {
+    Timestamp begin_time = Timestamp::Micros(rtc::TimeMicros());
+    int64_t begin_cpu_time_ns = rtc::GetProcessCpuTimeNanos();
+    thread->BlockingCall([&] { sender->StartSending(); });
+    bool finished = done.Wait(config.timeout);
+    result.cpu_time =
+        TimeDelta::Micros((rtc::GetProcessCpuTimeNanos() - begin_cpu_time_ns) /
+                          rtc::kNumNanosecsPerMicrosec);
+    result.duration = Timestamp::Micros(rtc::TimeMicros()) - begin_time;
+    thread->BlockingCall([&] {
+      result.completed = finished && !sender->aborted() &&
+                         !receiver->aborted() &&
+                         receiver->bytes_received() >= config.transfer_size;
+      result.bytes_received = receiver->bytes_received();
+      if (absl::optional<dcsctp::Metrics> metrics =
+              sender->socket().GetMetrics();
+          metrics.has_value()) {
+        result.tx_packets = metrics->tx_packets_count;
+        result.rtx_packets = metrics->rtx_packets_count;
+      }
+    });
+  }
+
+  thread->BlockingCall([&] {
+    sender = nullptr;
+    receiver = nullptr;
+  });
+  thread->Stop();
+  return result;
+}
+
+}  // namespace webrtc
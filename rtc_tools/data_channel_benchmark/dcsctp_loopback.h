@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef RTC_TOOLS_DATA_CHANNEL_BENCHMARK_DCSCTP_LOOPBACK_H_
+#define RTC_TOOLS_DATA_CHANNEL_BENCHMARK_DCSCTP_LOOPBACK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/units/time_delta.h"
+
+namespace webrtc {
+
+struct DcSctpLoopbackConfig {
+  // Size of each sent message.
+  size_t message_size = 256 * 1024;
+  // Total number of bytes to transfer, over all channels.
+  size_t transfer_size = 2 * 1024 * 1024;
+  bool ordered = true;
+  // Number of channels, i.e. SCTP streams, that messages are spread over.
+  int num_channels = 1;
+  // Random packet loss, applied in both directions.
+  int loss_percent = 0;
+  // One way delay, in addition to the capacity induced delay.
+  int delay_ms = 0;
+  // Link capacity in kbps, or 0 for an unlimited link.
+  int link_capacity_kbps = 0;
+  // The transfer is aborted if it hasn't completed within this time.
+  TimeDelta timeout = TimeDelta::Seconds(60);
+};
+
+struct DcSctpLoopbackResult {
+  // False if the association was aborted, or if the transfer timed out.
+  bool completed = false;
+  size_t bytes_received = 0;
+  TimeDelta duration = TimeDelta::Zero();
+  // Process CPU time spent during the transfer, by both sockets.
+  TimeDelta cpu_time = TimeDelta::Zero();
+  // Packets sent by the data sender, and how many of those that were
+  // retransmissions.
+  size_t tx_packets = 0;
+  size_t rtx_packets = 0;
+
+  double throughput_mib_per_second() const;
+  double cpu_ms_per_mib() const;
+};
+
+// Transfers data between two dcSCTP sockets in this process, connected
+// through a `SimulatedNetwork` link in each direction. Unlike a transfer over
+// a PeerConnection, this doesn't involve ICE, DTLS or the data channel layer,
+// which allows regressions in `net/dcsctp` to be tracked separately.
+//
+// Both sockets run on a dedicated thread, in real time.
+DcSctpLoopbackResult RunDcSctpLoopback(const DcSctpLoopbackConfig& config);
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_DATA_CHANNEL_BENCHMARK_DCSCTP_LOOPBACK_H_
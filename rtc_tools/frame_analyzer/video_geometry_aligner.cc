@@ -12,9 +12,12 @@
 
 #include <map>
 
+#include "absl/types/optional.h"
 #include "api/make_ref_counted.h"
 #include "api/video/i420_buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 #include "rtc_tools/frame_analyzer/video_quality_analysis.h"
 #include "third_party/libyuv/include/libyuv/scale.h"
 
@@ -155,12 +158,22 @@ rtc::scoped_refptr<Video> AdjustCropping(
           reference_video_->GetFrame(index);
 
       // Only calculate cropping region once per frame since it's expensive.
-      if (!crop_regions_.count(index)) {
-        crop_regions_[index] =
+      absl::optional<CropRegion> crop_region;
+      {
+        MutexLock lock(&mutex_);
+        auto it = crop_regions_.find(index);
+        if (it != crop_regions_.end()) {
+          crop_region = it->second;
+        }
+      }
+      if (!crop_region) {
+        crop_region =
             CalculateCropRegion(reference_frame, test_video_->GetFrame(index));
+        MutexLock lock(&mutex_);
+        crop_regions_[index] = *crop_region;
       }
 
-      return CropAndZoom(crop_regions_[index], reference_frame);
+      return CropAndZoom(*crop_region, reference_frame);
     }
 
    private:
@@ -168,7 +181,8 @@ rtc::scoped_refptr<Video> AdjustCropping(
     const rtc::scoped_refptr<Video> test_video_;
     // Mutable since this is a cache that affects performance and not logical
     // behavior.
-    mutable std::map<size_t, CropRegion> crop_regions_;
+    mutable Mutex mutex_;
+    mutable std::map<size_t, CropRegion> crop_regions_ RTC_GUARDED_BY(mutex_);
   };
 
   return rtc::make_ref_counted<CroppedVideo>(reference_video, test_video);
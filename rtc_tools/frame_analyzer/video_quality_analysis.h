@@ -51,11 +51,14 @@ struct ResultsContainer {
 // comprises the frames that were captured during the quality measurement test.
 // There may be missing or duplicate frames. Also the frames start at a random
 // position in the original video. We also need to provide a map from test frame
-// indices to reference frame indices.
+// indices to reference frame indices. The frames are analyzed on
+// `num_threads` threads, and the results are the same for any number of
+// threads.
 std::vector<AnalysisResult> RunAnalysis(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
-    const std::vector<size_t>& test_frame_indices);
+    const std::vector<size_t>& test_frame_indices,
+    int num_threads = 1);
 
 // Compute PSNR for an I420 buffer (all planes). The max return value (in the
 // case where the test and reference frames are exactly the same) will be 48.
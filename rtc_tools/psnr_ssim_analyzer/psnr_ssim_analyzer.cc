@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <string>
+#include <vector>
 
 #include "absl/flags/flag.h"
 #include "absl/flags/parse.h"
@@ -20,7 +21,9 @@
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame_buffer.h"
 #include "rtc_tools/frame_analyzer/video_quality_analysis.h"
+#include "rtc_tools/frame_analyzer/video_temporal_aligner.h"
 #include "rtc_tools/video_file_reader.h"
+#include "system_wrappers/include/cpu_info.h"
 
 ABSL_FLAG(std::string,
           results_file,
@@ -34,26 +37,34 @@ ABSL_FLAG(std::string,
           test_file,
           "test.yuv",
           "The test YUV file to run the analysis for");
+ABSL_FLAG(int,
+          num_threads,
+          0,
+          "The number of threads to analyze frames on, or 0 to use one thread "
+          "per CPU core");
 
 void CompareFiles(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
-    const char* results_file_name) {
+    const char* results_file_name,
+    int num_threads) {
   FILE* results_file = fopen(results_file_name, "w");
 
   const size_t num_frames = std::min(reference_video->number_of_frames(),
                                      test_video->number_of_frames());
+  // Compare the first `num_frames` frames of both videos, in parallel.
+  std::vector<size_t> indices(num_frames);
   for (size_t i = 0; i < num_frames; ++i) {
-    const rtc::scoped_refptr<webrtc::I420BufferInterface> ref_buffer =
-        reference_video->GetFrame(i);
-    const rtc::scoped_refptr<webrtc::I420BufferInterface> test_buffer =
-        test_video->GetFrame(i);
-
-    // Calculate the PSNR and SSIM.
-    double result_psnr = webrtc::test::Psnr(ref_buffer, test_buffer);
-    double result_ssim = webrtc::test::Ssim(ref_buffer, test_buffer);
-    fprintf(results_file, "Frame: %zu, PSNR: %f, SSIM: %f\n", i, result_psnr,
-            result_ssim);
+    indices[i] = i;
+  }
+  const std::vector<webrtc::test::AnalysisResult> results =
+      webrtc::test::RunAnalysis(
+          webrtc::test::ReorderVideo(reference_video, indices),
+          webrtc::test::ReorderVideo(test_video, indices), indices,
+          num_threads);
+  for (size_t i = 0; i < num_frames; ++i) {
+    fprintf(results_file, "Frame: %zu, PSNR: %f, SSIM: %f\n", i,
+            results[i].psnr_value, results[i].ssim_value);
   }
 
   fclose(results_file);
@@ -102,7 +113,11 @@ int main(int argc, char* argv[]) {
     return 0;
   }
 
+  const int num_threads = absl::GetFlag(FLAGS_num_threads) > 0
+                              ? absl::GetFlag(FLAGS_num_threads)
+                              : static_cast<int>(
+                                    webrtc::CpuInfo::DetectNumberOfCores());
   CompareFiles(reference_video, test_video,
-               absl::GetFlag(FLAGS_results_file).c_str());
+               absl::GetFlag(FLAGS_results_file).c_str(), num_threads);
   return 0;
 }
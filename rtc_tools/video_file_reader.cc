@@ -12,8 +12,15 @@
 
 #include <cstdio>
 #include <string>
+#include <utility>
 #include <vector>
 
+#if defined(WEBRTC_POSIX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#endif
+
 #include "absl/strings/match.h"
 #include "absl/types/optional.h"
 #include "api/make_ref_counted.h"
@@ -22,6 +29,8 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/string_encode.h"
 #include "rtc_base/string_to_number.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 namespace test {
@@ -32,7 +41,7 @@ bool ReadBytes(uint8_t* dst, size_t n, FILE* file) {
   return fread(reinterpret_cast<char*>(dst), /* size= */ 1, n, file) == n;
 }
 
-// Common base class for .yuv and .y4m files.
+// Common class for .yuv and .y4m files which are read with stdio.
 class VideoFile : public Video {
  public:
   VideoFile(int width,
@@ -54,9 +63,10 @@ class VideoFile : public Video {
       size_t frame_index) const override {
     RTC_CHECK_LT(frame_index, frame_positions_.size());
 
-    fsetpos(file_, &frame_positions_[frame_index]);
     rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
 
+    MutexLock lock(&mutex_);
+    fsetpos(file_, &frame_positions_[frame_index]);
     if (!ReadBytes(buffer->MutableDataY(), width_ * height_, file_) ||
         !ReadBytes(buffer->MutableDataU(),
                    buffer->ChromaWidth() * buffer->ChromaHeight(), file_) ||
@@ -73,9 +83,127 @@ class VideoFile : public Video {
   const int width_;
   const int height_;
   const std::vector<fpos_t> frame_positions_;
-  FILE* const file_;
+  mutable Mutex mutex_;
+  FILE* const file_ RTC_PT_GUARDED_BY(mutex_);
+};
+
+#if defined(WEBRTC_POSIX)
+// Common class for memory mapped .yuv and .y4m files.
+class MappedVideoFile : public Video {
+ public:
+  MappedVideoFile(int width,
+                  int height,
+                  const std::vector<size_t>& frame_offsets,
+                  const uint8_t* data,
+                  size_t size)
+      : width_(width),
+        height_(height),
+        frame_offsets_(frame_offsets),
+        data_(data),
+        size_(size) {}
+
+  ~MappedVideoFile() override {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+
+  size_t number_of_frames() const override { return frame_offsets_.size(); }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+
+  rtc::scoped_refptr<I420BufferInterface> GetFrame(
+      size_t frame_index) const override {
+    RTC_CHECK_LT(frame_index, frame_offsets_.size());
+
+    const size_t offset = frame_offsets_[frame_index];
+    if (offset > size_ || size_ - offset < 3 * width_ * height_ / 2) {
+      RTC_LOG(LS_ERROR) << "Could not read YUV data for frame " << frame_index;
+      return nullptr;
+    }
+    return rtc::make_ref_counted<MappedFrame>(
+        rtc::scoped_refptr<const MappedVideoFile>(this), data_ + offset);
+  }
+
+ private:
+  // Frame buffer pointing into the mapped file.
+  class MappedFrame : public I420BufferInterface {
+   public:
+    MappedFrame(rtc::scoped_refptr<const MappedVideoFile> video,
+                const uint8_t* data)
+        : video_(std::move(video)), data_(data) {}
+
+    int width() const override { return video_->width_; }
+    int height() const override { return video_->height_; }
+    const uint8_t* DataY() const override { return data_; }
+    const uint8_t* DataU() const override {
+      return data_ + width() * height();
+    }
+    const uint8_t* DataV() const override {
+      return DataU() + ChromaWidth() * ChromaHeight();
+    }
+    int StrideY() const override { return width(); }
+    int StrideU() const override { return ChromaWidth(); }
+    int StrideV() const override { return ChromaWidth(); }
+
+   private:
+    const rtc::scoped_refptr<const MappedVideoFile> video_;
+    const uint8_t* const data_;
+  };
+
+  const int width_;
+  const int height_;
+  const std::vector<size_t> frame_offsets_;
+  const uint8_t* const data_;
+  const size_t size_;
 };
 
+// Maps `file` into memory, or returns null if it can't be mapped.
+rtc::scoped_refptr<Video> MapVideoFile(
+    int width,
+    int height,
+    const std::vector<fpos_t>& frame_positions,
+    FILE* file) {
+  struct stat file_stat;
+  if (fstat(fileno(file), &file_stat) != 0 || file_stat.st_size <= 0) {
+    return nullptr;
+  }
+  std::vector<size_t> frame_offsets;
+  frame_offsets.reserve(frame_positions.size());
+  for (const fpos_t& position : frame_positions) {
+    fsetpos(file, &position);
+    const off_t offset = ftello(file);
+    if (offset < 0) {
+      return nullptr;
+    }
+    frame_offsets.push_back(static_cast<size_t>(offset));
+  }
+  const size_t size = static_cast<size_t>(file_stat.st_size);
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+  if (data == MAP_FAILED) {
+    RTC_LOG(LS_WARNING) << "Could not map input file, reading it instead";
+    return nullptr;
+  }
+  return rtc::make_ref_counted<MappedVideoFile>(
+      width, height, frame_offsets, static_cast<const uint8_t*>(data), size);
+}
+#endif  // defined(WEBRTC_POSIX)
+
+// Takes ownership of `file`.
+rtc::scoped_refptr<Video> CreateVideo(
+    int width,
+    int height,
+    const std::vector<fpos_t>& frame_positions,
+    FILE* file) {
+#if defined(WEBRTC_POSIX)
+  if (rtc::scoped_refptr<Video> video =
+          MapVideoFile(width, height, frame_positions, file)) {
+    fclose(file);
+    return video;
+  }
+#endif
+  return rtc::make_ref_counted<VideoFile>(width, height, frame_positions,
+                                          file);
+}
+
 }  // namespace
 
 Video::Iterator::Iterator(const rtc::scoped_refptr<const Video>& video,
@@ -225,8 +353,7 @@ rtc::scoped_refptr<Video> OpenY4mFile(const std::string& file_name) {
   }
   RTC_LOG(LS_INFO) << "Video has " << frame_positions.size() << " frames";
 
-  return rtc::make_ref_counted<VideoFile>(*width, *height, frame_positions,
-                                          file);
+  return CreateVideo(*width, *height, frame_positions, file);
 }
 
 rtc::scoped_refptr<Video> OpenYuvFile(const std::string& file_name,
@@ -267,7 +394,7 @@ rtc::scoped_refptr<Video> OpenYuvFile(const std::string& file_name,
   }
   RTC_LOG(LS_INFO) << "Video has " << frame_positions.size() << " frames";
 
-  return rtc::make_ref_counted<VideoFile>(width, height, frame_positions, file);
+  return CreateVideo(width, height, frame_positions, file);
 }
 
 rtc::scoped_refptr<Video> OpenYuvOrY4mFile(const std::string& file_name,
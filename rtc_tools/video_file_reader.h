@@ -23,8 +23,8 @@
 namespace webrtc {
 namespace test {
 
-// Iterable class representing a sequence of I420 buffers. This class is not
-// thread safe because it is expected to be backed by a file.
+// Iterable class representing a sequence of I420 buffers. The videos returned
+// by the functions below may have frames read from several threads at once.
 class Video : public RefCountInterface {
  public:
   class Iterator {
@@ -64,6 +64,8 @@ class Video : public RefCountInterface {
       size_t index) const = 0;
 };
 
+// The files are memory mapped where supported, so that reading a frame doesn't
+// copy it. The frame buffers keep the video alive.
 rtc::scoped_refptr<Video> OpenY4mFile(const std::string& file_name);
 
 rtc::scoped_refptr<Video> OpenYuvFile(const std::string& file_name,
@@ -73,6 +73,38 @@ TEST_F(Y4mFileReaderTest, TestPixelContent) {
   }
 }
 
+TEST_F(Y4mFileReaderTest, FrameOutlivesVideo) {
+  const rtc::scoped_refptr<I420BufferInterface> frame = video->GetFrame(1);
+  ASSERT_TRUE(frame);
+  video = nullptr;
+  EXPECT_EQ(6, frame->width());
+  EXPECT_EQ(4, frame->height());
+  EXPECT_EQ(36, frame->DataY()[0]);
+  EXPECT_EQ(36 + 6 * 4, frame->DataU()[0]);
+  EXPECT_EQ(36 + 6 * 4 + 3 * 2, frame->DataV()[0]);
+}
+
+TEST(Y4mFileReaderTruncatedTest, TruncatedFrameCanNotBeRead) {
+  const std::string filename =
+      TempFilename(webrtc::test::OutputPath(), "test_truncated_file.y4m");
+  FILE* file = fopen(filename.c_str(), "wb");
+  ASSERT_TRUE(file != nullptr);
+  fprintf(file, "YUV4MPEG2 W6 H4 F30:1 C420\n");
+  fprintf(file, "FRAME\n");
+  for (int i = 0; i < 6 * 4 * 3 / 2; ++i)
+    fputc(static_cast<char>(i), file);
+  fprintf(file, "FRAME\n");
+  for (int i = 0; i < 6 * 4; ++i)
+    fputc(static_cast<char>(i), file);
+  fclose(file);
+
+  rtc::scoped_refptr<Video> video = OpenY4mFile(filename);
+  ASSERT_TRUE(video);
+  ASSERT_EQ(2u, video->number_of_frames());
+  EXPECT_TRUE(video->GetFrame(0));
+  EXPECT_FALSE(video->GetFrame(1));
+}
+
 class YuvFileReaderTest : public ::testing::Test {
  public:
   void SetUp() override {
@@ -115,6 +115,14 @@ ABSL_FLAG(std::string, input_file, "", "input file");
 
 ABSL_FLAG(std::string, config_file, "", "config file");
 
+ABSL_FLAG(int,
+          config_index,
+          -1,
+          "Index of the configuration in --config_file to replay, or -1 to "
+          "replay all of them. Packets of the other streams are counted as "
+          "unknown, so that the streams of a dump can be replayed by parallel "
+          "processes, e.g. combined with --simulated_time.");
+
 // Flag for raw output files.
 ABSL_FLAG(std::string,
           out_base,
@@ -162,6 +170,14 @@ ABSL_FLAG(bool, disable_preview, false, "Disable decoded video preview.");
 
 ABSL_FLAG(bool, disable_decoding, false, "Disable video decoding.");
 
+ABSL_FLAG(int,
+          decode_ahead_frames,
+          0,
+          "If positive, decode frames as soon as they are complete instead of "
+          "at their render time, with at most this many frames queued for "
+          "decoding. Combined with --simulated_time, decodes faster than real "
+          "time.");
+
 ABSL_FLAG(int,
           extend_run_time_duration,
           0,
@@ -299,6 +315,15 @@ struct StreamState {
   std::unique_ptr<VideoDecoderFactory> decoder_factory;
 };
 
+// Applies --decode_ahead_frames to `receive_config`. Frames which are decoded
+// ahead are rendered as soon as they are decoded, too.
+void SetDecodeAheadFrames(VideoReceiveStreamInterface::Config& receive_config) {
+  receive_config.decode_ahead_frames = absl::GetFlag(FLAGS_decode_ahead_frames);
+  if (receive_config.decode_ahead_frames > 0) {
+    receive_config.enable_prerenderer_smoothing = false;
+  }
+}
+
 // Loads multiple configurations from the provided configuration file.
 std::unique_ptr<StreamState> ConfigureFromFile(const std::string& config_path,
                                                Call* call) {
@@ -326,8 +351,18 @@ std::unique_ptr<StreamState> ConfigureFromFile(const std::string& config_path,
   } else {
     stream_state->decoder_factory = std::make_unique<InternalDecoderFactory>();
   }
+  const int config_index = absl::GetFlag(FLAGS_config_index);
+  if (config_index >= static_cast<int>(json_configs.size())) {
+    fprintf(stderr, "Config index %d out of range, the file has %u configs\n",
+            config_index, json_configs.size());
+    return nullptr;
+  }
   size_t config_count = 0;
   for (const auto& json : json_configs) {
+    if (config_index >= 0 && static_cast<int>(config_count) != config_index) {
+      ++config_count;
+      continue;
+    }
     // Create the configuration and parse the JSON into the config.
     auto receive_config =
         ParseVideoReceiveStreamJsonConfig(&(stream_state->transport), json);
@@ -349,6 +384,7 @@ std::unique_ptr<StreamState> ConfigureFromFile(const std::string& config_path,
     // Create a receive stream for this config.
     receive_config.renderer = stream_state->sinks.back().get();
     receive_config.decoder_factory = stream_state->decoder_factory.get();
+    SetDecodeAheadFrames(receive_config);
     stream_state->receive_streams.emplace_back(
         call->CreateVideoReceiveStream(std::move(receive_config)));
   }
@@ -436,6 +472,7 @@ std::unique_ptr<StreamState> ConfigureFromFlags(
   }
   receive_config.decoder_factory = stream_state->decoder_factory.get();
   receive_config.decoders.push_back(decoder);
+  SetDecodeAheadFrames(receive_config);
 
   stream_state->receive_streams.emplace_back(
       call->CreateVideoReceiveStream(std::move(receive_config)));
@@ -699,6 +736,7 @@ int main(int argc, char* argv[]) {
       absl::GetFlag(FLAGS_transmission_offset_id)));
   RTC_CHECK(ValidateInputFilenameNotEmpty(absl::GetFlag(FLAGS_input_file)));
   RTC_CHECK_GE(absl::GetFlag(FLAGS_extend_run_time_duration), 0);
+  RTC_CHECK_GE(absl::GetFlag(FLAGS_config_index), -1);
 
   rtc::ThreadManager::Instance()->WrapCurrentThread();
   webrtc::test::RunTest(webrtc::RtpReplay);
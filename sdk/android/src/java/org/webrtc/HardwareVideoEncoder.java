@@ -358,11 +358,16 @@ class HardwareVideoEncoder implements VideoEncoder {
 
     final boolean isTextureBuffer = videoFrame.getBuffer() instanceof VideoFrame.TextureBuffer;
 
-    // If input resolution changed, restart the codec with the new resolution.
+    // If input resolution changed, restart the codec with the new resolution. Texture frames are
+    // scaled on the GPU when drawn into the input surface instead, so that e.g. the full
+    // resolution frame that is passed to every simulcast layer doesn't restart the codec at that
+    // resolution.
     final int frameWidth = videoFrame.getBuffer().getWidth();
     final int frameHeight = videoFrame.getBuffer().getHeight();
     final boolean shouldUseSurfaceMode = canUseSurface() && isTextureBuffer;
-    if (frameWidth != width || frameHeight != height || shouldUseSurfaceMode != useSurfaceMode) {
+    final boolean resolutionChanged = frameWidth != width || frameHeight != height;
+    if ((resolutionChanged && !(shouldUseSurfaceMode && useSurfaceMode))
+        || shouldUseSurfaceMode != useSurfaceMode) {
       VideoCodecStatus status = resetCodec(frameWidth, frameHeight, shouldUseSurfaceMode);
       if (status != VideoCodecStatus.OK) {
         return status;
@@ -388,8 +393,8 @@ class HardwareVideoEncoder implements VideoEncoder {
 
     EncodedImage.Builder builder = EncodedImage.builder()
                                        .setCaptureTimeNs(videoFrame.getTimestampNs())
-                                       .setEncodedWidth(videoFrame.getBuffer().getWidth())
-                                       .setEncodedHeight(videoFrame.getBuffer().getHeight())
+                                       .setEncodedWidth(width)
+                                       .setEncodedHeight(height)
                                        .setRotation(videoFrame.getRotation());
     outputBuilders.offer(builder);
 
@@ -422,10 +427,15 @@ class HardwareVideoEncoder implements VideoEncoder {
       // TODO(perkj): glClear() shouldn't be necessary since every pixel is covered anyway,
       // but it's a workaround for bug webrtc:5147.
       GLES20.glClear(GLES20.GL_COLOR_BUFFER_BIT);
-      // It is not necessary to release this frame because it doesn't own the buffer.
+      VideoFrame.Buffer scaledBuffer = scaleToCodecResolution(videoFrame.getBuffer());
       VideoFrame derotatedFrame =
-          new VideoFrame(videoFrame.getBuffer(), 0 /* rotation */, videoFrame.getTimestampNs());
-      videoFrameDrawer.drawFrame(derotatedFrame, textureDrawer, null /* additionalRenderMatrix */);
+          new VideoFrame(scaledBuffer, 0 /* rotation */, videoFrame.getTimestampNs());
+      try {
+        videoFrameDrawer.drawFrame(
+            derotatedFrame, textureDrawer, null /* additionalRenderMatrix */);
+      } finally {
+        derotatedFrame.release();
+      }
       textureEglBase.swapBuffers(TimeUnit.MICROSECONDS.toNanos(presentationTimestampUs));
     } catch (RuntimeException e) {
       Logging.e(TAG, "encodeTexture failed", e);
@@ -434,6 +444,30 @@ class HardwareVideoEncoder implements VideoEncoder {
     return VideoCodecStatus.OK;
   }
 
+  /**
+   * Returns a new reference to `buffer` cropped and scaled to the resolution of the codec. The crop
+   * keeps the center of the frame when its aspect ratio differs from that of the codec. For texture
+   * buffers this only changes the texture transform, so the scaling happens when the frame is
+   * drawn into the input surface.
+   */
+  private VideoFrame.Buffer scaleToCodecResolution(VideoFrame.Buffer buffer) {
+    final int bufferWidth = buffer.getWidth();
+    final int bufferHeight = buffer.getHeight();
+    if (bufferWidth == width && bufferHeight == height) {
+      buffer.retain();
+      return buffer;
+    }
+    int cropWidth = bufferWidth;
+    int cropHeight = bufferHeight;
+    if ((long) bufferWidth * height > (long) bufferHeight * width) {
+      cropWidth = (int) ((long) bufferHeight * width / height);
+    } else {
+      cropHeight = (int) ((long) bufferWidth * height / width);
+    }
+    return buffer.cropAndScale((bufferWidth - cropWidth) / 2, (bufferHeight - cropHeight) / 2,
+        cropWidth, cropHeight, width, height);
+  }
+
   private VideoCodecStatus encodeByteBuffer(VideoFrame videoFrame, long presentationTimestampUs) {
     encodeThreadChecker.checkIsOnValidThread();
     // No timeout.  Don't block for an input buffer, drop frames if the encoder falls behind.
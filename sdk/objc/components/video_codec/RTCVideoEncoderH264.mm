@@ -330,6 +330,7 @@ NSUInteger GetMaxSampleRate(const webrtc::H264ProfileLevelId &profile_level_id)
   int32_t _width;
   int32_t _height;
   VTCompressionSessionRef _compressionSession;
+  VTPixelTransferSessionRef _pixelTransferSession;
   RTCVideoCodecMode _mode;
 
   webrtc::H264BitstreamParser _h264BitstreamParser;
@@ -359,6 +360,7 @@ NSUInteger GetMaxSampleRate(const webrtc::H264ProfileLevelId &profile_level_id)
 
 - (void)dealloc {
   [self destroyCompressionSession];
+  [self destroyPixelTransferSession];
 }
 
 - (NSInteger)startEncodeWithSettings:(RTC_OBJC_TYPE(RTCVideoEncoderSettings) *)settings
@@ -422,17 +424,7 @@ NSUInteger GetMaxSampleRate(const webrtc::H264ProfileLevelId &profile_level_id)
       if (!pixelBuffer) {
         return WEBRTC_VIDEO_CODEC_ERROR;
       }
-      int dstWidth = CVPixelBufferGetWidth(pixelBuffer);
-      int dstHeight = CVPixelBufferGetHeight(pixelBuffer);
-      if ([rtcPixelBuffer requiresScalingToWidth:dstWidth height:dstHeight]) {
-        int size =
-            [rtcPixelBuffer bufferSizeForCroppingAndScalingToWidth:dstWidth height:dstHeight];
-        _frameScaleBuffer.resize(size);
-      } else {
-        _frameScaleBuffer.clear();
-      }
-      _frameScaleBuffer.shrink_to_fit();
-      if (![rtcPixelBuffer cropAndScaleTo:pixelBuffer withTempBuffer:_frameScaleBuffer.data()]) {
+      if (![self cropAndScalePixelBuffer:rtcPixelBuffer toPixelBuffer:pixelBuffer]) {
         CVBufferRelease(pixelBuffer);
         return WEBRTC_VIDEO_CODEC_ERROR;
       }
@@ -556,6 +548,7 @@ NSUInteger GetMaxSampleRate(const webrtc::H264ProfileLevelId &profile_level_id)
   // callback anymore. Do not remove callback until the session is invalidated
   // since async encoder callbacks can occur until invalidation.
   [self destroyCompressionSession];
+  [self destroyPixelTransferSession];
   _callback = nullptr;
   return WEBRTC_VIDEO_CODEC_OK;
 }
@@ -571,6 +564,62 @@ NSUInteger GetMaxSampleRate(const webrtc::H264ProfileLevelId &profile_level_id)
   return kNV12PixelFormat;
 }
 
+// Crops and scales `rtcPixelBuffer` into the encoder's pixel buffer. Where available this is done
+// by a pixel transfer session, which reads the source IOSurface once on the GPU and writes the
+// result directly into the IOSurface backed `pixelBuffer`, instead of scaling on the CPU through an
+// intermediate buffer. Every simulcast layer encodes from the same camera buffer this way.
+- (BOOL)cropAndScalePixelBuffer:(RTC_OBJC_TYPE(RTCCVPixelBuffer) *)rtcPixelBuffer
+                  toPixelBuffer:(CVPixelBufferRef)pixelBuffer {
+  if (@available(iOS 16.0, tvOS 16.0, macOS 10.8, *)) {
+    if (!_pixelTransferSession) {
+      OSStatus status = VTPixelTransferSessionCreate(nullptr, &_pixelTransferSession);
+      if (status != noErr) {
+        RTC_LOG(LS_WARNING) << "Failed to create pixel transfer session: " << status;
+        _pixelTransferSession = nullptr;
+      }
+    }
+    if (_pixelTransferSession) {
+      CFDictionaryRef cropRectangle = CGRectCreateDictionaryRepresentation(
+          CGRectMake(rtcPixelBuffer.cropX,
+                     rtcPixelBuffer.cropY,
+                     rtcPixelBuffer.cropWidth,
+                     rtcPixelBuffer.cropHeight));
+      OSStatus status = VTSessionSetProperty(
+          _pixelTransferSession, kVTPixelTransferPropertyKey_SourceCropRectangle, cropRectangle);
+      CFRelease(cropRectangle);
+      if (status == noErr) {
+        status = VTPixelTransferSessionTransferImage(
+            _pixelTransferSession, rtcPixelBuffer.pixelBuffer, pixelBuffer);
+      }
+      if (status == noErr) {
+        return YES;
+      }
+      RTC_LOG(LS_WARNING) << "Pixel transfer failed: " << status << ", scaling with libyuv.";
+    }
+  }
+
+  int dstWidth = CVPixelBufferGetWidth(pixelBuffer);
+  int dstHeight = CVPixelBufferGetHeight(pixelBuffer);
+  if ([rtcPixelBuffer requiresScalingToWidth:dstWidth height:dstHeight]) {
+    int size = [rtcPixelBuffer bufferSizeForCroppingAndScalingToWidth:dstWidth height:dstHeight];
+    _frameScaleBuffer.resize(size);
+  } else {
+    _frameScaleBuffer.clear();
+  }
+  _frameScaleBuffer.shrink_to_fit();
+  return [rtcPixelBuffer cropAndScaleTo:pixelBuffer withTempBuffer:_frameScaleBuffer.data()];
+}
+
+- (void)destroyPixelTransferSession {
+  if (_pixelTransferSession) {
+    if (@available(iOS 16.0, tvOS 16.0, macOS 10.8, *)) {
+      VTPixelTransferSessionInvalidate(_pixelTransferSession);
+    }
+    CFRelease(_pixelTransferSession);
+    _pixelTransferSession = nullptr;
+  }
+}
+
 - (BOOL)resetCompressionSessionIfNeededWithFrame:(RTC_OBJC_TYPE(RTCVideoFrame) *)frame {
   BOOL resetCompressionSession = NO;
 
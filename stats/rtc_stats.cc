@@ -139,6 +139,32 @@ bool RTCStats::operator!=(const RTCStats& other) const {
   return !(*this == other);
 }
 
+std::unique_ptr<RTCStats> RTCStats::CopyChangedMembers(
+    const RTCStats& previous) const {
+  RTC_DCHECK_EQ(type(), previous.type());
+  std::vector<const RTCStatsMemberInterface*> members = Members();
+  std::vector<const RTCStatsMemberInterface*> previous_members =
+      previous.Members();
+  RTC_DCHECK_EQ(members.size(), previous_members.size());
+  std::vector<bool> changed(members.size());
+  bool any_changed = false;
+  for (size_t i = 0; i < members.size(); ++i) {
+    changed[i] = *members[i] != *previous_members[i];
+    any_changed |= changed[i];
+  }
+  if (!any_changed)
+    return nullptr;
+
+  std::unique_ptr<RTCStats> copy = this->copy();
+  // The members of `copy` are only exposed as const, but `copy` itself isn't.
+  std::vector<const RTCStatsMemberInterface*> copy_members = copy->Members();
+  for (size_t i = 0; i < copy_members.size(); ++i) {
+    if (!changed[i])
+      const_cast<RTCStatsMemberInterface*>(copy_members[i])->Reset();
+  }
+  return copy;
+}
+
 std::string RTCStats::ToJson() const {
   rtc::StringBuilder sb;
   sb << "{\"type\":\"" << type()
@@ -13,6 +13,7 @@
 #include <type_traits>
 #include <utility>
 
+#include "absl/algorithm/container.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/strings/string_builder.h"
 
@@ -68,11 +69,33 @@ rtc::scoped_refptr<RTCStatsReport> RTCStatsReport::Copy() const {
   return copy;
 }
 
+rtc::scoped_refptr<RTCStatsReport> RTCStatsReport::CreateDelta(
+    const RTCStatsReport& previous,
+    const std::vector<std::string>& types) const {
+  rtc::scoped_refptr<RTCStatsReport> delta = Create(timestamp_);
+  for (const auto& [id, stats] : stats_) {
+    if (!types.empty() && absl::c_find(types, stats->type()) == types.end()) {
+      continue;
+    }
+    const RTCStats* previous_stats = previous.Get(id);
+    if (!previous_stats || previous_stats->type() != stats->type()) {
+      delta->AddStats(stats->copy());
+      continue;
+    }
+    std::unique_ptr<RTCStats> changed =
+        stats->CopyChangedMembers(*previous_stats);
+    if (changed)
+      delta->AddStats(std::move(changed));
+  }
+  return delta;
+}
+
 void RTCStatsReport::AddStats(std::unique_ptr<const RTCStats> stats) {
 #if RTC_DCHECK_IS_ON
   auto result =
 #endif
-      stats_.insert(std::make_pair(std::string(stats->id()), std::move(stats)));
+      stats_.insert(
+          std::make_pair(absl::string_view(stats->id()), std::move(stats)));
 #if RTC_DCHECK_IS_ON
   RTC_DCHECK(result.second)
       << "A stats object with ID \"" << result.first->second->id() << "\" is "
@@ -80,14 +103,14 @@ void RTCStatsReport::AddStats(std::unique_ptr<const RTCStats> stats) {
 #endif
 }
 
-const RTCStats* RTCStatsReport::Get(const std::string& id) const {
+const RTCStats* RTCStatsReport::Get(absl::string_view id) const {
   StatsMap::const_iterator it = stats_.find(id);
   if (it != stats_.cend())
     return it->second.get();
   return nullptr;
 }
 
-std::unique_ptr<const RTCStats> RTCStatsReport::Take(const std::string& id) {
+std::unique_ptr<const RTCStats> RTCStatsReport::Take(absl::string_view id) {
   StatsMap::iterator it = stats_.find(id);
   if (it == stats_.end())
     return nullptr;
@@ -10,6 +10,9 @@
 
 #include "api/stats/rtc_stats_report.h"
 
+#include <memory>
+#include <utility>
+
 #include "api/stats/rtc_stats.h"
 #include "rtc_base/checks.h"
 #include "test/gtest.h"
@@ -166,4 +169,86 @@ TEST(RTCStatsReport, TakeMembersFrom) {
   EXPECT_EQ(i, static_cast<int64_t>(6));
 }
 
+TEST(RTCStatsReport, GetsStatsWithLongIdsAfterTakingMembers) {
+  // Long enough to not be stored inline in a `std::string`.
+  const std::string kIdA = "RTCInboundRtpStreamStats_1234567890";
+  const std::string kIdB = "RTCOutboundRtpStreamStats_1234567890";
+  rtc::scoped_refptr<RTCStatsReport> a =
+      RTCStatsReport::Create(Timestamp::Zero());
+  EXPECT_TRUE(a->TryAddStats(
+      std::make_unique<RTCTestStats1>(kIdA, Timestamp::Micros(1))));
+  EXPECT_FALSE(a->TryAddStats(
+      std::make_unique<RTCTestStats1>(kIdA, Timestamp::Micros(2))));
+  rtc::scoped_refptr<RTCStatsReport> b =
+      RTCStatsReport::Create(Timestamp::Zero());
+  b->AddStats(std::make_unique<RTCTestStats1>(kIdB, Timestamp::Micros(3)));
+
+  a->TakeMembersFrom(b);
+  b = nullptr;
+  ASSERT_TRUE(a->Get(kIdA));
+  EXPECT_EQ(a->Get(kIdA)->timestamp(), Timestamp::Micros(1));
+  ASSERT_TRUE(a->Get(kIdB));
+  EXPECT_EQ(a->Get(kIdB)->timestamp(), Timestamp::Micros(3));
+
+  std::unique_ptr<const RTCStats> taken = a->Take(kIdA);
+  ASSERT_TRUE(taken);
+  EXPECT_EQ(taken->id(), kIdA);
+  EXPECT_FALSE(a->Get(kIdA));
+  EXPECT_TRUE(a->Get(kIdB));
+}
+
+TEST(RTCStatsReport, CreateDeltaHasNewAndChangedStats) {
+  rtc::scoped_refptr<RTCStatsReport> previous =
+      RTCStatsReport::Create(Timestamp::Micros(1));
+  auto unchanged = std::make_unique<RTCTestStats1>("A", Timestamp::Micros(1));
+  unchanged->integer = 1;
+  previous->AddStats(std::move(unchanged));
+  auto changed = std::make_unique<RTCTestStats1>("B", Timestamp::Micros(1));
+  changed->integer = 1;
+  previous->AddStats(std::move(changed));
+  previous->AddStats(
+      std::make_unique<RTCTestStats1>("C", Timestamp::Micros(1)));
+
+  rtc::scoped_refptr<RTCStatsReport> report =
+      RTCStatsReport::Create(Timestamp::Micros(2));
+  unchanged = std::make_unique<RTCTestStats1>("A", Timestamp::Micros(2));
+  unchanged->integer = 1;
+  report->AddStats(std::move(unchanged));
+  changed = std::make_unique<RTCTestStats1>("B", Timestamp::Micros(2));
+  changed->integer = 2;
+  report->AddStats(std::move(changed));
+  auto added = std::make_unique<RTCTestStats2>("D", Timestamp::Micros(2));
+  added->number = 1.0;
+  report->AddStats(std::move(added));
+
+  rtc::scoped_refptr<RTCStatsReport> delta = report->CreateDelta(*previous);
+  EXPECT_EQ(delta->timestamp(), Timestamp::Micros(2));
+  EXPECT_EQ(delta->size(), 2u);
+  EXPECT_FALSE(delta->Get("A"));
+  EXPECT_FALSE(delta->Get("C"));
+  const RTCTestStats1* b = delta->GetAs<RTCTestStats1>("B");
+  ASSERT_TRUE(b);
+  EXPECT_EQ(*b->integer, 2);
+  const RTCTestStats2* d = delta->GetAs<RTCTestStats2>("D");
+  ASSERT_TRUE(d);
+  EXPECT_EQ(*d->number, 1.0);
+}
+
+TEST(RTCStatsReport, CreateDeltaOfTypes) {
+  rtc::scoped_refptr<RTCStatsReport> previous =
+      RTCStatsReport::Create(Timestamp::Micros(1));
+  rtc::scoped_refptr<RTCStatsReport> report =
+      RTCStatsReport::Create(Timestamp::Micros(2));
+  report->AddStats(std::make_unique<RTCTestStats1>("A", Timestamp::Micros(2)));
+  report->AddStats(std::make_unique<RTCTestStats2>("B", Timestamp::Micros(2)));
+  report->AddStats(std::make_unique<RTCTestStats3>("C", Timestamp::Micros(2)));
+
+  rtc::scoped_refptr<RTCStatsReport> delta = report->CreateDelta(
+      *previous, {RTCTestStats1::kType, RTCTestStats3::kType});
+  EXPECT_EQ(delta->size(), 2u);
+  EXPECT_TRUE(delta->Get("A"));
+  EXPECT_FALSE(delta->Get("B"));
+  EXPECT_TRUE(delta->Get("C"));
+}
+
 }  // namespace webrtc
@@ -212,6 +212,25 @@ TEST(RTCStatsTest, EqualityOperator) {
   EXPECT_NE(stats_with_undefined_member, stats_with_defined_member);
 }
 
+TEST(RTCStatsTest, CopyChangedMembers) {
+  RTCTestStats previous("testId", Timestamp::Micros(123));
+  previous.m_int32 = 123;
+  previous.m_string = "123";
+  EXPECT_FALSE(previous.CopyChangedMembers(previous));
+
+  RTCTestStats stats = previous;
+  stats.m_int32 = 321;
+  stats.m_double = 321.0;
+  std::unique_ptr<RTCStats> changed = stats.CopyChangedMembers(previous);
+  ASSERT_TRUE(changed);
+  const RTCTestStats& changed_stats = changed->cast_to<RTCTestStats>();
+  EXPECT_EQ(changed_stats.id(), "testId");
+  EXPECT_EQ(*changed_stats.m_int32, 321);
+  EXPECT_EQ(*changed_stats.m_double, 321.0);
+  EXPECT_FALSE(changed_stats.m_string.has_value());
+  EXPECT_FALSE(changed_stats.m_bool.has_value());
+}
+
 TEST(RTCStatsTest, RTCStatsGrandChild) {
   RTCGrandChildStats stats("grandchild", Timestamp::Micros(0.0));
   stats.child_int = 1;
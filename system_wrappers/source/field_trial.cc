@@ -12,6 +12,7 @@
 #include <stddef.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 
@@ -19,6 +20,7 @@
 #include "absl/strings/string_view.h"
 #include "experiments/registered_field_trials.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/containers/flat_map.h"
 #include "rtc_base/containers/flat_set.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/string_encode.h"
@@ -34,6 +36,39 @@ namespace {
 
 constexpr char kPersistentStringSeparator = '/';
 
+#ifndef WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
+// Trial names and groups of `trials_init_string`, so that looking up a trial
+// doesn't have to scan the whole string. The views point into
+// `trials_init_string`.
+using FieldTrialMap = flat_map<absl::string_view, absl::string_view>;
+const FieldTrialMap* trials_map = nullptr;
+
+std::unique_ptr<FieldTrialMap> ParseFieldTrials(absl::string_view trials) {
+  auto parsed = std::make_unique<FieldTrialMap>();
+  size_t next_item = 0;
+  while (next_item < trials.length()) {
+    // Find next name/value pair in field trial configuration string.
+    size_t field_name_end = trials.find(kPersistentStringSeparator, next_item);
+    if (field_name_end == trials.npos || field_name_end == next_item)
+      break;
+    size_t field_value_end =
+        trials.find(kPersistentStringSeparator, field_name_end + 1);
+    if (field_value_end == trials.npos ||
+        field_value_end == field_name_end + 1)
+      break;
+    absl::string_view field_name =
+        trials.substr(next_item, field_name_end - next_item);
+    absl::string_view field_value = trials.substr(
+        field_name_end + 1, field_value_end - field_name_end - 1);
+    next_item = field_value_end + 1;
+
+    // The first occurrence of a trial wins, if it's listed more than once.
+    parsed->emplace(field_name, field_value);
+  }
+  return parsed;
+}
+#endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
+
 flat_set<std::string>& TestKeys() {
   static auto* test_keys = new flat_set<std::string>();
   return *test_keys;
@@ -127,35 +162,13 @@ std::string FindFullName(absl::string_view name) {
       << name << " is not registered, see g3doc/field-trials.md.";
 #endif
 
-  if (trials_init_string == NULL)
+  if (trials_map == nullptr)
     return std::string();
 
-  absl::string_view trials_string(trials_init_string);
-  if (trials_string.empty())
+  auto it = trials_map->find(name);
+  if (it == trials_map->end())
     return std::string();
-
-  size_t next_item = 0;
-  while (next_item < trials_string.length()) {
-    // Find next name/value pair in field trial configuration string.
-    size_t field_name_end =
-        trials_string.find(kPersistentStringSeparator, next_item);
-    if (field_name_end == trials_string.npos || field_name_end == next_item)
-      break;
-    size_t field_value_end =
-        trials_string.find(kPersistentStringSeparator, field_name_end + 1);
-    if (field_value_end == trials_string.npos ||
-        field_value_end == field_name_end + 1)
-      break;
-    absl::string_view field_name =
-        trials_string.substr(next_item, field_name_end - next_item);
-    absl::string_view field_value = trials_string.substr(
-        field_name_end + 1, field_value_end - field_name_end - 1);
-    next_item = field_value_end + 1;
-
-    if (name == field_name)
-      return std::string(field_value);
-  }
-  return std::string();
+  return std::string(it->second);
 }
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 
@@ -167,6 +180,12 @@ void InitFieldTrialsFromString(const char* trials_string) {
         << "Invalid field trials string:" << trials_string;
   };
   trials_init_string = trials_string;
+#ifndef WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
+  const FieldTrialMap* old_trials_map = trials_map;
+  trials_map =
+      trials_string ? ParseFieldTrials(trials_string).release() : nullptr;
+  delete old_trials_map;
+#endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 }
 
 const char* GetFieldTrialString() {
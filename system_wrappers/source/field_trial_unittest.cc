@@ -15,6 +15,26 @@
 
 namespace webrtc {
 namespace field_trial {
+#if !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+TEST(FieldTrialTest, FindsGroupOfInitializedTrials) {
+  const char* previous_trials = GetFieldTrialString();
+  InitFieldTrialsFromString(
+      "Audio/Enabled/Video/Disabled,Foo:1/Audio/Enabled/");
+  EXPECT_EQ(FindFullName("Audio"), "Enabled");
+  EXPECT_EQ(FindFullName("Video"), "Disabled,Foo:1");
+  EXPECT_EQ(FindFullName("Vid"), "");
+  EXPECT_EQ(FindFullName("Enabled"), "");
+
+  InitFieldTrialsFromString("Video/Enabled/");
+  EXPECT_EQ(FindFullName("Audio"), "");
+  EXPECT_EQ(FindFullName("Video"), "Enabled");
+
+  InitFieldTrialsFromString(nullptr);
+  EXPECT_EQ(FindFullName("Video"), "");
+  InitFieldTrialsFromString(previous_trials);
+}
+#endif  // !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+
 #if GTEST_HAS_DEATH_TEST && RTC_DCHECK_IS_ON && !defined(WEBRTC_ANDROID) && \
     !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
 TEST(FieldTrialValidationTest, AcceptsValidInputs) {
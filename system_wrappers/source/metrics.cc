@@ -10,6 +10,8 @@
 #include "system_wrappers/include/metrics.h"
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 
 #include "absl/strings/string_view.h"
 #include "rtc_base/string_utils.h"
@@ -29,11 +31,26 @@ namespace {
 // linearly/exponentially spaced buckets) if samples are logged more frequently.
 const int kMaxSampleMapSize = 300;
 
+// Histograms where all possible sample values, including the underflow bucket,
+// fit within kMaxSampleMapSize, such as boolean, enumeration and percentage
+// histograms, count the samples in an array of atomics instead. Adding samples
+// to them then doesn't need to take a lock.
 class RtcHistogram {
  public:
   RtcHistogram(absl::string_view name, int min, int max, int bucket_count)
-      : min_(min), max_(max), info_(name, min, max, bucket_count) {
+      : min_(min),
+        max_(max),
+        num_dense_samples_(max - min + 2 <= kMaxSampleMapSize ? max - min + 2
+                                                              : 0),
+        dense_samples_(num_dense_samples_ > 0
+                           ? std::make_unique<std::atomic<int>[]>(
+                                 num_dense_samples_)
+                           : nullptr),
+        info_(name, min, max, bucket_count) {
     RTC_DCHECK_GT(bucket_count, 0);
+    for (int i = 0; i < num_dense_samples_; ++i) {
+      dense_samples_[i].store(0, std::memory_order_relaxed);
+    }
   }
 
   RtcHistogram(const RtcHistogram&) = delete;
@@ -43,6 +60,12 @@ class RtcHistogram {
     sample = std::min(sample, max_);
     sample = std::max(sample, min_ - 1);  // Underflow bucket.
 
+    if (dense_samples_) {
+      dense_samples_[sample - (min_ - 1)].fetch_add(1,
+                                                    std::memory_order_relaxed);
+      return;
+    }
+
     MutexLock lock(&mutex_);
     if (info_.samples.size() == kMaxSampleMapSize &&
         info_.samples.find(sample) == info_.samples.end()) {
@@ -54,6 +77,9 @@ class RtcHistogram {
   // Returns a copy (or nullptr if there are no samples) and clears samples.
   std::unique_ptr<SampleInfo> GetAndReset() {
     MutexLock lock(&mutex_);
+    if (dense_samples_) {
+      info_.samples = DenseSamples(/*reset=*/true);
+    }
     if (info_.samples.empty())
       return nullptr;
 
@@ -69,11 +95,21 @@ class RtcHistogram {
 
   // Functions only for testing.
   void Reset() {
+    if (dense_samples_) {
+      DenseSamples(/*reset=*/true);
+      return;
+    }
     MutexLock lock(&mutex_);
     info_.samples.clear();
   }
 
   int NumEvents(int sample) const {
+    if (dense_samples_) {
+      const int index = sample - (min_ - 1);
+      return (index < 0 || index >= num_dense_samples_)
+                 ? 0
+                 : dense_samples_[index].load(std::memory_order_relaxed);
+    }
     MutexLock lock(&mutex_);
     const auto it = info_.samples.find(sample);
     return (it == info_.samples.end()) ? 0 : it->second;
@@ -81,27 +117,44 @@ class RtcHistogram {
 
   int NumSamples() const {
     int num_samples = 0;
-    MutexLock lock(&mutex_);
-    for (const auto& sample : info_.samples) {
+    for (const auto& sample : Samples()) {
       num_samples += sample.second;
     }
     return num_samples;
   }
 
   int MinSample() const {
-    MutexLock lock(&mutex_);
-    return (info_.samples.empty()) ? -1 : info_.samples.begin()->first;
+    std::map<int, int> samples = Samples();
+    return (samples.empty()) ? -1 : samples.begin()->first;
   }
 
   std::map<int, int> Samples() const {
+    if (dense_samples_) {
+      return DenseSamples(/*reset=*/false);
+    }
     MutexLock lock(&mutex_);
     return info_.samples;
   }
 
  private:
+  std::map<int, int> DenseSamples(bool reset) const {
+    std::map<int, int> samples;
+    for (int i = 0; i < num_dense_samples_; ++i) {
+      const int count =
+          reset ? dense_samples_[i].exchange(0, std::memory_order_relaxed)
+                : dense_samples_[i].load(std::memory_order_relaxed);
+      if (count > 0) {
+        samples.emplace_hint(samples.end(), min_ - 1 + i, count);
+      }
+    }
+    return samples;
+  }
+
   mutable Mutex mutex_;
   const int min_;
   const int max_;
+  const int num_dense_samples_;
+  const std::unique_ptr<std::atomic<int>[]> dense_samples_;
   SampleInfo info_ RTC_GUARDED_BY(mutex_);
 };
 
@@ -12,8 +12,10 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/string_utils.h"
 #include "system_wrappers/include/metrics.h"
 #include "test/gtest.h"
@@ -170,5 +172,24 @@ TEST_F(MetricsDefaultTest, TestMinMaxBucket) {
   EXPECT_EQ(1u, histograms.begin()->second->samples.size());
 }
 
+TEST_F(MetricsDefaultTest, AddsSamplesFromMultipleThreads) {
+  constexpr int kNumThreads = 4;
+  constexpr int kNumSamplesPerThread = 1000;
+  std::vector<rtc::PlatformThread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.push_back(rtc::PlatformThread::SpawnJoinable(
+        [] {
+          for (int j = 0; j < kNumSamplesPerThread; ++j) {
+            RTC_HISTOGRAM_BOOLEAN(kName, j % 2 == 0);
+          }
+        },
+        "MetricsThread"));
+  }
+  threads.clear();
+  EXPECT_EQ(kNumThreads * kNumSamplesPerThread, metrics::NumSamples(kName));
+  EXPECT_EQ(kNumThreads * kNumSamplesPerThread / 2,
+            metrics::NumEvents(kName, 1));
+}
+
 }  // namespace webrtc
 #endif
@@ -358,14 +358,16 @@ void LinkEmulation::Process(Timestamp at_time) {
   std::vector<PacketDeliveryInfo> delivery_infos =
       network_behavior_->DequeueDeliverablePackets(at_time.us());
   for (PacketDeliveryInfo& delivery_info : delivery_infos) {
-    StoredPacket* packet = nullptr;
-    for (auto& stored_packet : packets_) {
-      if (stored_packet.id == delivery_info.packet_id) {
-        packet = &stored_packet;
-        break;
-      }
-    }
-    RTC_CHECK(packet);
+    // Packets are stored in order of increasing id, so the packet can be
+    // found without scanning the whole queue, which gets long on congested
+    // links.
+    auto it = std::lower_bound(
+        packets_.begin(), packets_.end(), delivery_info.packet_id,
+        [](const StoredPacket& stored_packet, uint64_t packet_id) {
+          return stored_packet.id < packet_id;
+        });
+    RTC_CHECK(it != packets_.end() && it->id == delivery_info.packet_id);
+    StoredPacket* packet = &*it;
     RTC_DCHECK(!packet->removed);
     packet->removed = true;
     stats_builder_.AddPacketTransportTime(
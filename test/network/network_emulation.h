@@ -174,6 +174,7 @@ class LinkEmulation : public EmulatedNetworkReceiverInterface {
   EmulatedNetworkReceiverInterface* const receiver_;
 
   RepeatingTaskHandle process_task_ RTC_GUARDED_BY(task_queue_);
+  // Packets in flight, ordered by id.
   std::deque<StoredPacket> packets_ RTC_GUARDED_BY(task_queue_);
   uint64_t next_packet_id_ RTC_GUARDED_BY(task_queue_) = 1;
 
@@ -11,6 +11,7 @@
 #include "test/pc/e2e/analyzer/video/default_video_quality_analyzer_frames_comparator.h"
 
 #include <algorithm>
+#include <cmath>
 #include <map>
 #include <string>
 #include <utility>
@@ -321,6 +322,7 @@ void DefaultVideoQualityAnalyzerFramesComparator::AddComparison(
     absl::optional<VideoFrame> rendered,
     FrameComparisonType type,
     FrameStats frame_stats) {
+  MaybeDownscaleFrames(captured, rendered);
   MutexLock lock(&mutex_);
   RTC_CHECK_EQ(state_, State::kActive)
       << "Frames comparator has to be started before it will be used";
@@ -335,6 +337,7 @@ void DefaultVideoQualityAnalyzerFramesComparator::AddComparison(
     absl::optional<VideoFrame> rendered,
     FrameComparisonType type,
     FrameStats frame_stats) {
+  MaybeDownscaleFrames(captured, rendered);
   MutexLock lock(&mutex_);
   RTC_CHECK_EQ(state_, State::kActive)
       << "Frames comparator has to be started before it will be used";
@@ -347,6 +350,37 @@ void DefaultVideoQualityAnalyzerFramesComparator::AddComparison(
                         std::move(rendered), type, std::move(frame_stats));
 }
 
+void DefaultVideoQualityAnalyzerFramesComparator::MaybeDownscaleFrames(
+    absl::optional<VideoFrame>& captured,
+    absl::optional<VideoFrame>& rendered) const {
+  // Frames are only used for PSNR and SSIM, which need both of them.
+  if (!options_.max_comparison_frame_pixels.has_value() ||
+      !(options_.compute_psnr || options_.compute_ssim) ||
+      !captured.has_value() || !rendered.has_value()) {
+    return;
+  }
+  const int max_pixels = *options_.max_comparison_frame_pixels;
+  const int captured_pixels = captured->width() * captured->height();
+  if (captured_pixels <= max_pixels) {
+    return;
+  }
+
+  // Done before the frames are queued, and without holding the lock, so that
+  // the queue only holds the downscaled frames.
+  const double scale = std::sqrt(static_cast<double>(max_pixels) /
+                                 static_cast<double>(captured_pixels));
+  const int width = std::max(1, static_cast<int>(captured->width() * scale));
+  const int height = std::max(1, static_cast<int>(captured->height() * scale));
+  captured->set_video_frame_buffer(ScaleVideoFrameBuffer(
+      *captured->video_frame_buffer()->ToI420(), width, height));
+  // PSNR and SSIM need the rendered frame to be no larger than the captured
+  // one.
+  if (rendered->width() > width || rendered->height() > height) {
+    rendered->set_video_frame_buffer(ScaleVideoFrameBuffer(
+        *rendered->video_frame_buffer()->ToI420(), width, height));
+  }
+}
+
 void DefaultVideoQualityAnalyzerFramesComparator::AddComparisonInternal(
     InternalStatsKey stats_key,
     absl::optional<VideoFrame> captured,
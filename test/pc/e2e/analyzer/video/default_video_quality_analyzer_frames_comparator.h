@@ -126,6 +126,10 @@ class DefaultVideoQualityAnalyzerFramesComparator {
  private:
   enum State { kNew, kActive, kStopped };
 
+  // Downscales the frames according to
+  // `options_.max_comparison_frame_pixels`.
+  void MaybeDownscaleFrames(absl::optional<VideoFrame>& captured,
+                            absl::optional<VideoFrame>& rendered) const;
   void AddComparisonInternal(InternalStatsKey stats_key,
                              absl::optional<VideoFrame> captured,
                              absl::optional<VideoFrame> rendered,
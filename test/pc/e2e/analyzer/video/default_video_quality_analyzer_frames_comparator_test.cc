@@ -1650,5 +1650,39 @@ TEST(DefaultVideoQualityAnalyzerFramesComparatorTest,
 }
 // Stats validation tests end.
 
+TEST(DefaultVideoQualityAnalyzerFramesComparatorTest,
+     ComputesQualityOfDownscaledFrames) {
+  DefaultVideoQualityAnalyzerCpuMeasurer cpu_measurer;
+  DefaultVideoQualityAnalyzerOptions options = AnalyzerOptionsForTest();
+  options.compute_psnr = true;
+  options.compute_ssim = true;
+  options.max_comparison_frame_pixels = 320 * 180;
+  DefaultVideoQualityAnalyzerFramesComparator comparator(
+      Clock::GetRealTimeClock(), cpu_measurer, options);
+
+  Timestamp stream_start_time = Clock::GetRealTimeClock()->CurrentTime();
+  size_t stream = 0;
+  size_t sender = 0;
+  size_t receiver = 1;
+  InternalStatsKey stats_key(stream, sender, receiver);
+  VideoFrame frame =
+      CreateFrame(/*frame_id=*/1, /*width=*/1280, /*height=*/720,
+                  stream_start_time);
+  FrameStats frame_stats = FrameStatsWith10msDeltaBetweenPhasesAnd10x10Frame(
+      /*frame_id=*/1, stream_start_time);
+
+  comparator.Start(/*max_threads_count=*/1);
+  comparator.EnsureStatsForStream(stream, sender, /*peers_count=*/2,
+                                  stream_start_time, stream_start_time);
+  comparator.AddComparison(stats_key, /*captured=*/frame, /*rendered=*/frame,
+                           FrameComparisonType::kRegular, frame_stats);
+  comparator.Stop(/*last_rendered_frame_times=*/{});
+
+  StreamStats stats = comparator.stream_stats().at(stats_key);
+  ExpectSizeAndAllElementsAre(stats.psnr, /*size=*/1, /*value=*/48.0);
+  ASSERT_EQ(stats.ssim.NumSamples(), 1);
+  EXPECT_NEAR(stats.ssim.GetAverage(), 1.0, 1e-6);
+}
+
 }  // namespace
 }  // namespace webrtc
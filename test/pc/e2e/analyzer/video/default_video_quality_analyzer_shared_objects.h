@@ -275,6 +275,13 @@ struct DefaultVideoQualityAnalyzerOptions {
   // significantly slows down the comparison, so turn it on only when it is
   // needed.
   bool adjust_cropping_before_comparing_frames = false;
+  // If set, captured frames with more pixels than this are downscaled, keeping
+  // the aspect ratio, before they are queued for PSNR and SSIM computation.
+  // Rendered frames are downscaled to the same resolution if they are larger.
+  // This bounds the memory held by pending comparisons and the time spent on
+  // them in long runs with many streams, at the cost of metrics being less
+  // sensitive to degradation of fine details.
+  absl::optional<int> max_comparison_frame_pixels = absl::nullopt;
   // Amount of time for which DefaultVideoQualityAnalyzer will store frames
   // which were captured but not yet rendered on all receivers per stream.
   TimeDelta max_frames_storage_duration = kDefaultMaxFramesStorageDuration;
@@ -23,6 +23,7 @@
 #include "modules/video_coding/include/video_error_codes.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/system/memory_mapped_file.h"
 
 namespace webrtc {
 namespace test {
@@ -30,11 +31,21 @@ namespace {
 
 constexpr TimeDelta kMaxNextFrameWaitTimeout = TimeDelta::Seconds(1);
 
+std::unique_ptr<IvfFileReader> OpenIvfFile(const std::string& file_name) {
+  // Reading from a mapping doesn't copy the frames, which matters when a test
+  // replays many streams.
+  if (std::unique_ptr<IvfFileReader> reader =
+          IvfFileReader::Create(MemoryMappedFile::Open(file_name))) {
+    return reader;
+  }
+  return IvfFileReader::Create(FileWrapper::OpenReadOnly(file_name));
+}
+
 }  // namespace
 
 IvfVideoFrameGenerator::IvfVideoFrameGenerator(const std::string& file_name)
     : callback_(this),
-      file_reader_(IvfFileReader::Create(FileWrapper::OpenReadOnly(file_name))),
+      file_reader_(OpenIvfFile(file_name)),
       video_decoder_(CreateVideoDecoder(file_reader_->GetVideoCodecType())),
       width_(file_reader_->GetFrameWidth()),
       height_(file_reader_->GetFrameHeight()) {
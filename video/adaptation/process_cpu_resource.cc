@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/adaptation/process_cpu_resource.h"
+
+#include "api/make_ref_counted.h"
+#include "api/sequence_checker.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+// static
+rtc::scoped_refptr<ProcessCpuResource> ProcessCpuResource::Create(
+    TaskQueueBase* task_queue,
+    Clock* clock,
+    int num_cores,
+    const Config& config) {
+  return rtc::make_ref_counted<ProcessCpuResource>(task_queue, clock,
+                                                   num_cores, config);
+}
+
+ProcessCpuResource::ProcessCpuResource(TaskQueueBase* task_queue,
+                                       Clock* clock,
+                                       int num_cores,
+                                       const Config& config)
+    : task_queue_(task_queue),
+      clock_(clock),
+      num_cores_(num_cores),
+      config_(config) {
+  RTC_DCHECK(task_queue_);
+  RTC_DCHECK(clock_);
+  RTC_DCHECK_GT(num_cores_, 0);
+  RTC_DCHECK_LT(config_.underuse_threshold, config_.overuse_threshold);
+  RTC_DCHECK_GT(config_.measurement_interval, TimeDelta::Zero());
+}
+
+ProcessCpuResource::~ProcessCpuResource() {
+  RTC_DCHECK(!listener_);
+  RTC_DCHECK(!repeating_task_.Running());
+}
+
+absl::optional<double> ProcessCpuResource::last_usage() const {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  return last_usage_;
+}
+
+void ProcessCpuResource::SetResourceListener(ResourceListener* listener) {
+  RTC_DCHECK_RUN_ON(task_queue_);
+  listener_ = listener;
+  repeating_task_.Stop();
+  if (!listener_) {
+    return;
+  }
+  // Measure from when there is someone to report to, so that the first
+  // interval isn't averaged with the time before adaptation started.
+  last_measurement_time_ = clock_->CurrentTime();
+  last_cpu_time_ns_ = ProcessCpuTimeNanos();
+  repeating_task_ = RepeatingTaskHandle::DelayedStart(
+      task_queue_, config_.measurement_interval,
+      [this] {
+        RTC_DCHECK_RUN_ON(task_queue_);
+        MeasureUsage();
+        return config_.measurement_interval;
+      },
+      TaskQueueBase::DelayPrecision::kLow, clock_);
+}
+
+int64_t ProcessCpuResource::ProcessCpuTimeNanos() {
+  return rtc::GetProcessCpuTimeNanos();
+}
+
+void ProcessCpuResource::MeasureUsage() {
+  const Timestamp now = clock_->CurrentTime();
+  const int64_t cpu_time_ns = ProcessCpuTimeNanos();
+  const TimeDelta elapsed = now - last_measurement_time_;
+  const TimeDelta cpu_time = TimeDelta::Micros(
+      (cpu_time_ns - last_cpu_time_ns_) / rtc::kNumNanosecsPerMicrosec);
+  last_measurement_time_ = now;
+  last_cpu_time_ns_ = cpu_time_ns;
+  if (elapsed <= TimeDelta::Zero()) {
+    return;
+  }
+  last_usage_ = cpu_time / (elapsed * num_cores_);
+  if (!listener_) {
+    return;
+  }
+  if (*last_usage_ > config_.overuse_threshold) {
+    listener_->OnResourceUsageStateMeasured(rtc::scoped_refptr<Resource>(this),
+                                            ResourceUsageState::kOveruse);
+  } else if (*last_usage_ < config_.underuse_threshold) {
+    listener_->OnResourceUsageStateMeasured(rtc::scoped_refptr<Resource>(this),
+                                            ResourceUsageState::kUnderuse);
+  }
+}
+
+}  // namespace webrtc
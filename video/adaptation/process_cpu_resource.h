@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_ADAPTATION_PROCESS_CPU_RESOURCE_H_
+#define VIDEO_ADAPTATION_PROCESS_CPU_RESOURCE_H_
+
+#include <stdint.h>
+
+#include <string>
+
+#include "absl/types/optional.h"
+#include "api/adaptation/resource.h"
+#include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// A resource measuring the CPU usage of the whole process, as opposed to the
+// EncodeUsageResource which estimates the encode time of a single stream.
+// Every `measurement_interval` the CPU time used by the process during the
+// interval is compared to the wall clock time times `num_cores`: overuse is
+// reported above `overuse_threshold` and underuse below `underuse_threshold`.
+//
+// The resource is meant to be shared by all VideoSendStreams through a
+// PrioritizedResourceListener, which makes the low priority streams adapt
+// first, so that the total usage is kept under the target without every
+// stream adapting on every overuse. The caller is responsible for adding the
+// adapters with VideoSendStream::AddAdaptationResource().
+class ProcessCpuResource : public Resource {
+ public:
+  struct Config {
+    // Fractions of the total capacity of all cores.
+    double overuse_threshold = 0.85;
+    double underuse_threshold = 0.6;
+    TimeDelta measurement_interval = TimeDelta::Seconds(5);
+  };
+
+  static rtc::scoped_refptr<ProcessCpuResource> Create(
+      TaskQueueBase* task_queue,
+      Clock* clock,
+      int num_cores,
+      const Config& config);
+
+  ProcessCpuResource(TaskQueueBase* task_queue,
+                     Clock* clock,
+                     int num_cores,
+                     const Config& config);
+  ~ProcessCpuResource() override;
+
+  // The usage measured in the last interval, as a fraction of the total
+  // capacity of all cores.
+  absl::optional<double> last_usage() const;
+
+  // Resource implementation.
+  std::string Name() const override { return "ProcessCpuResource"; }
+  void SetResourceListener(ResourceListener* listener) override;
+
+ protected:
+  // Returns the CPU time used by the process so far. Virtual for testing.
+  virtual int64_t ProcessCpuTimeNanos();
+
+ private:
+  void MeasureUsage() RTC_RUN_ON(task_queue_);
+
+  TaskQueueBase* const task_queue_;
+  Clock* const clock_;
+  const int num_cores_;
+  const Config config_;
+  ResourceListener* listener_ RTC_GUARDED_BY(task_queue_) = nullptr;
+  RepeatingTaskHandle repeating_task_ RTC_GUARDED_BY(task_queue_);
+  Timestamp last_measurement_time_ RTC_GUARDED_BY(task_queue_) =
+      Timestamp::MinusInfinity();
+  int64_t last_cpu_time_ns_ RTC_GUARDED_BY(task_queue_) = 0;
+  absl::optional<double> last_usage_ RTC_GUARDED_BY(task_queue_);
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_ADAPTATION_PROCESS_CPU_RESOURCE_H_
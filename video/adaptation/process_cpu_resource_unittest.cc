@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/adaptation/process_cpu_resource.h"
+
+#include <memory>
+#include <utility>
+
+#include "absl/functional/any_invocable.h"
+#include "api/make_ref_counted.h"
+#include "api/units/timestamp.h"
+#include "call/adaptation/test/mock_resource_listener.h"
+#include "rtc_base/time_utils.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+using testing::_;
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kNumCores = 4;
+constexpr TimeDelta kMeasurementInterval = TimeDelta::Seconds(5);
+
+class FakeProcessCpuResource : public ProcessCpuResource {
+ public:
+  FakeProcessCpuResource(TaskQueueBase* task_queue, Clock* clock)
+      : ProcessCpuResource(task_queue, clock, kNumCores, Config()),
+        clock_(clock) {}
+
+  // Makes the process use `usage` of all cores from now on.
+  void SetUsage(double usage) { usage_ = usage; }
+
+ protected:
+  int64_t ProcessCpuTimeNanos() override {
+    // Accumulate CPU time for the wall clock time since the last call.
+    const Timestamp now = clock_->CurrentTime();
+    if (last_call_.IsFinite()) {
+      cpu_time_ns_ += (now - last_call_).ns() * kNumCores * usage_;
+    }
+    last_call_ = now;
+    return cpu_time_ns_;
+  }
+
+ private:
+  Clock* const clock_;
+  double usage_ = 0.7;
+  Timestamp last_call_ = Timestamp::MinusInfinity();
+  int64_t cpu_time_ns_ = 0;
+};
+
+}  // namespace
+
+class ProcessCpuResourceTest : public ::testing::Test {
+ public:
+  ProcessCpuResourceTest()
+      : time_controller_(Timestamp::Micros(1234)),
+        task_queue_(time_controller_.GetTaskQueueFactory()->CreateTaskQueue(
+            "TestQueue",
+            TaskQueueFactory::Priority::NORMAL)) {}
+
+  void RunTaskOnTaskQueue(absl::AnyInvocable<void() &&> task) {
+    task_queue_->PostTask(std::move(task));
+    time_controller_.AdvanceTime(TimeDelta::Zero());
+  }
+
+ protected:
+  GlobalSimulatedTimeController time_controller_;
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue_;
+};
+
+TEST_F(ProcessCpuResourceTest, ResourceIsSilentWithinThresholds) {
+  testing::StrictMock<MockResourceListener> resource_listener;
+  RunTaskOnTaskQueue([&]() {
+    auto resource = rtc::make_ref_counted<FakeProcessCpuResource>(
+        task_queue_.get(), time_controller_.GetClock());
+    resource->SetResourceListener(&resource_listener);
+    time_controller_.AdvanceTime(kMeasurementInterval * 10);
+    EXPECT_NEAR(*resource->last_usage(), 0.7, 1e-6);
+    resource->SetResourceListener(nullptr);
+  });
+}
+
+TEST_F(ProcessCpuResourceTest, OveruseIsReportedWhileAboveThreshold) {
+  testing::StrictMock<MockResourceListener> resource_listener;
+  RunTaskOnTaskQueue([&]() {
+    auto resource = rtc::make_ref_counted<FakeProcessCpuResource>(
+        task_queue_.get(), time_controller_.GetClock());
+    resource->SetResourceListener(&resource_listener);
+    resource->SetUsage(0.9);
+    EXPECT_CALL(resource_listener,
+                OnResourceUsageStateMeasured(_, ResourceUsageState::kOveruse))
+        .Times(3);
+    time_controller_.AdvanceTime(kMeasurementInterval * 3);
+    testing::Mock::VerifyAndClearExpectations(&resource_listener);
+
+    // Within the thresholds again.
+    resource->SetUsage(0.7);
+    time_controller_.AdvanceTime(kMeasurementInterval * 3);
+    resource->SetResourceListener(nullptr);
+  });
+}
+
+TEST_F(ProcessCpuResourceTest, UnderuseIsReportedWhileBelowThreshold) {
+  testing::StrictMock<MockResourceListener> resource_listener;
+  RunTaskOnTaskQueue([&]() {
+    auto resource = rtc::make_ref_counted<FakeProcessCpuResource>(
+        task_queue_.get(), time_controller_.GetClock());
+    resource->SetResourceListener(&resource_listener);
+    resource->SetUsage(0.3);
+    EXPECT_CALL(resource_listener,
+                OnResourceUsageStateMeasured(_, ResourceUsageState::kUnderuse))
+        .Times(2);
+    time_controller_.AdvanceTime(kMeasurementInterval * 2);
+    EXPECT_NEAR(*resource->last_usage(), 0.3, 1e-6);
+    resource->SetResourceListener(nullptr);
+  });
+}
+
+TEST_F(ProcessCpuResourceTest, StopsMeasuringWithoutListener) {
+  testing::StrictMock<MockResourceListener> resource_listener;
+  RunTaskOnTaskQueue([&]() {
+    auto resource = rtc::make_ref_counted<FakeProcessCpuResource>(
+        task_queue_.get(), time_controller_.GetClock());
+    resource->SetUsage(0.9);
+    time_controller_.AdvanceTime(kMeasurementInterval * 2);
+    EXPECT_FALSE(resource->last_usage());
+
+    resource->SetResourceListener(&resource_listener);
+    resource->SetResourceListener(nullptr);
+    time_controller_.AdvanceTime(kMeasurementInterval * 2);
+    EXPECT_FALSE(resource->last_usage());
+  });
+}
+
+}  // namespace webrtc
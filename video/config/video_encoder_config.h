@@ -22,6 +22,7 @@
 #include "api/video_codecs/scalability_mode.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_codec.h"
+#include "api/video_codecs/video_encoder.h"
 #include "rtc_base/ref_count.h"
 
 namespace webrtc {
@@ -213,6 +214,9 @@ class VideoEncoderConfig {
   // apply it to all simulcast layers/spatial layers.
   int max_qp;
 
+  // Passed to the encoder in VideoEncoder::Settings.
+  VideoEncoder::ParallelismPolicy parallelism_policy;
+
  private:
   // Access to the copy constructor is private to force use of the Copy()
   // method for those exceptional cases where we do use it.
@@ -0,0 +1,50 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decoder_thread_budget.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+// static
+DecoderThreadBudget& DecoderThreadBudget::Default() {
+  static DecoderThreadBudget* const budget =
+      new DecoderThreadBudget(CpuInfo::DetectNumberOfCores());
+  return *budget;
+}
+
+DecoderThreadBudget::DecoderThreadBudget(int max_threads)
+    : max_threads_(max_threads) {
+  RTC_DCHECK_GT(max_threads, 0);
+}
+
+void DecoderThreadBudget::SetMaxThreads(int max_threads) {
+  RTC_DCHECK_GT(max_threads, 0);
+  MutexLock lock(&mutex_);
+  max_threads_ = max_threads;
+}
+
+int DecoderThreadBudget::AddStream() {
+  MutexLock lock(&mutex_);
+  ++num_streams_;
+  return std::max(1, max_threads_ / num_streams_);
+}
+
+void DecoderThreadBudget::RemoveStream() {
+  MutexLock lock(&mutex_);
+  RTC_DCHECK_GT(num_streams_, 0);
+  --num_streams_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,52 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_DECODER_THREAD_BUDGET_H_
+#define VIDEO_DECODER_THREAD_BUDGET_H_
+
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Budget of decoder threads shared by video receive streams, so that a
+// process decoding many streams doesn't run more decoder threads than it has
+// cores. Each started stream is given an equal share of the budget, and at
+// least one thread, for its decoders. The share is taken when the stream
+// starts, so streams started earlier keep their larger share until restarted.
+// Thread safe.
+class DecoderThreadBudget {
+ public:
+  // The budget shared by all video receive streams of the process, which is
+  // the number of cores unless changed with SetMaxThreads().
+  static DecoderThreadBudget& Default();
+
+  explicit DecoderThreadBudget(int max_threads);
+  DecoderThreadBudget(const DecoderThreadBudget&) = delete;
+  DecoderThreadBudget& operator=(const DecoderThreadBudget&) = delete;
+
+  // Limits the number of decoder threads of all streams together. Must be
+  // positive.
+  void SetMaxThreads(int max_threads);
+
+  // Registers a starting stream, and returns the number of threads its
+  // decoders may use.
+  int AddStream();
+  void RemoveStream();
+
+ private:
+  Mutex mutex_;
+  int max_threads_ RTC_GUARDED_BY(mutex_);
+  int num_streams_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_DECODER_THREAD_BUDGET_H_
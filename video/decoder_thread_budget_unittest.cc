@@ -0,0 +1,44 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decoder_thread_budget.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(DecoderThreadBudgetTest, SharesThreadsBetweenStreams) {
+  DecoderThreadBudget budget(8);
+  EXPECT_EQ(budget.AddStream(), 8);
+  EXPECT_EQ(budget.AddStream(), 4);
+  EXPECT_EQ(budget.AddStream(), 2);
+  budget.RemoveStream();
+  budget.RemoveStream();
+  EXPECT_EQ(budget.AddStream(), 4);
+}
+
+TEST(DecoderThreadBudgetTest, GivesEachStreamAtLeastOneThread) {
+  DecoderThreadBudget budget(2);
+  EXPECT_EQ(budget.AddStream(), 2);
+  EXPECT_EQ(budget.AddStream(), 1);
+  EXPECT_EQ(budget.AddStream(), 1);
+}
+
+TEST(DecoderThreadBudgetTest, AppliesNewMaxToNextStreams) {
+  DecoderThreadBudget budget(8);
+  EXPECT_EQ(budget.AddStream(), 8);
+  budget.SetMaxThreads(16);
+  EXPECT_EQ(budget.AddStream(), 8);
+  EXPECT_EQ(budget.AddStream(), 5);
+}
+
+}  // namespace
+}  // namespace webrtc
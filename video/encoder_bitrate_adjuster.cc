@@ -50,6 +50,9 @@ EncoderBitrateAdjuster::EncoderBitrateAdjuster(
     : utilize_bandwidth_headroom_(
           RateControlSettings::ParseFromKeyValueConfig(&field_trials)
               .BitrateAdjusterCanUseNetworkHeadroom()),
+      use_qp_prediction_(
+          RateControlSettings::ParseFromKeyValueConfig(&field_trials)
+              .BitrateAdjusterCanUseQpPrediction()),
       frames_since_layout_change_(0),
       min_bitrates_bps_{},
       frame_size_pixels_{},
@@ -183,6 +186,44 @@ VideoBitrateAllocation EncoderBitrateAdjuster::AdjustRateAllocation(
       RTC_DCHECK_NOTREACHED();
     }
 
+    if (use_qp_prediction_ &&
+        frames_since_layout_change_ >= kMinFramesSinceLayoutChange &&
+        active_tls[si] > 0 && layer_info.target_rate > DataRate::Zero()) {
+      // If the frame size model predicts the next frames to overshoot more
+      // than what has been seen over the window, e.g. since the encoder just
+      // lowered the QP, reduce the target already now rather than once the
+      // large frames have built a queue. Use the bitrate weighted average
+      // over the temporal layers, ignoring the prediction unless it is
+      // available for all of them.
+      absl::optional<double> predicted_utilization_factor = 0.0;
+      for (size_t ti = 0; ti < active_tls[si]; ++ti) {
+        RTC_DCHECK(overshoot_detectors_[si][ti]);
+        const absl::optional<double> ti_predicted_utilization_factor =
+            overshoot_detectors_[si][ti]->GetPredictedUtilizationFactor();
+        if (!ti_predicted_utilization_factor) {
+          predicted_utilization_factor = absl::nullopt;
+          break;
+        }
+        const double weight =
+            active_tls[si] == 1
+                ? 1.0
+                : static_cast<double>(rates.bitrate.GetBitrate(si, ti)) /
+                      layer_info.target_rate.bps();
+        *predicted_utilization_factor +=
+            weight * ti_predicted_utilization_factor.value();
+      }
+      if (predicted_utilization_factor) {
+        // Raise the media utilization factor too, so that the predicted
+        // overshoot isn't mistaken for a burst that average media rate
+        // headroom can absorb.
+        layer_info.link_utilization_factor = std::max(
+            layer_info.link_utilization_factor, *predicted_utilization_factor);
+        layer_info.media_utilization_factor =
+            std::max(layer_info.media_utilization_factor,
+                     *predicted_utilization_factor);
+      }
+    }
+
     if (layer_info.link_utilization_factor < 1.0) {
       // TODO(sprang): Consider checking underuse and allowing it to cancel some
       // potential overuse by other streams.
@@ -337,12 +378,14 @@ void EncoderBitrateAdjuster::OnEncoderInfo(
 
 void EncoderBitrateAdjuster::OnEncodedFrame(DataSize size,
                                             int stream_index,
-                                            int temporal_index) {
+                                            int temporal_index,
+                                            absl::optional<int> qp) {
   ++frames_since_layout_change_;
   // Detectors may not exist, for instance if ScreenshareLayers is used.
   auto& detector = overshoot_detectors_[stream_index][temporal_index];
   if (detector) {
-    detector->OnEncodedFrame(size.bytes(), rtc::TimeMillis());
+    detector->OnEncodedFrame(size.bytes(), rtc::TimeMillis(),
+                             use_qp_prediction_ ? qp : absl::nullopt);
   }
 }
 
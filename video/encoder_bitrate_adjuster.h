@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "absl/types/optional.h"
 #include "api/field_trials_view.h"
 #include "api/video/encoded_image.h"
 #include "api/video/video_bitrate_allocation.h"
@@ -48,17 +49,24 @@ class EncoderBitrateAdjuster {
   // the temporal layer frame rate allocation.
   void OnEncoderInfo(const VideoEncoder::EncoderInfo& encoder_info);
 
-  // Updates the overuse detectors according to the encoded image size.
-  // `stream_index` is the spatial or simulcast index.
+  // Updates the overuse detectors according to the encoded image size and, for
+  // delta frames where it is known, its QP. `stream_index` is the spatial or
+  // simulcast index.
   // TODO(https://crbug.com/webrtc/14891): If we want to support a mix of
   // simulcast and SVC we'll also need to consider the case where we have both
   // simulcast and spatial indices.
-  void OnEncodedFrame(DataSize size, int stream_index, int temporal_index);
+  void OnEncodedFrame(DataSize size,
+                      int stream_index,
+                      int temporal_index,
+                      absl::optional<int> qp = absl::nullopt);
 
   void Reset();
 
  private:
   const bool utilize_bandwidth_headroom_;
+  // If set, the overshoot predicted from the QP of the latest frames is used
+  // in addition to the windowed utilization.
+  const bool use_qp_prediction_;
 
   VideoEncoder::RateControlParameters current_rate_control_parameters_;
   // FPS allocation of temporal layers, per simulcast/spatial layer. Represented
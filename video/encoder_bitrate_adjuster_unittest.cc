@@ -175,6 +175,23 @@ class EncoderBitrateAdjusterTest : public ::testing::Test {
     }
   }
 
+  // Inserts ideal sized frames at a steady QP into a single layer, after which
+  // the encoder lowers the QP and produces a few frames of twice the ideal
+  // size.
+  void InsertFramesWithQpDrop() {
+    const DataSize ideal_frame_size =
+        DataRate::BitsPerSec(current_adjusted_allocation_.GetBitrate(0, 0)) /
+        Frequency::Hertz(target_framerate_fps_);
+    for (int i = 0; i < 10; ++i) {
+      clock_.AdvanceTime(TimeDelta::Seconds(1) / target_framerate_fps_);
+      adjuster_->OnEncodedFrame(ideal_frame_size, 0, 0, /*qp=*/30);
+    }
+    for (int i = 0; i < 3; ++i) {
+      clock_.AdvanceTime(TimeDelta::Seconds(1) / target_framerate_fps_);
+      adjuster_->OnEncodedFrame(ideal_frame_size * 2, 0, 0, /*qp=*/24);
+    }
+  }
+
   size_t NumSpatialLayers() const {
     if (codec_.codecType == VideoCodecType::kVideoCodecVP9) {
       return codec_.VP9().numberOfSpatialLayers;
@@ -422,6 +439,39 @@ TEST_F(EncoderBitrateAdjusterTest, DifferentSpatialOvershoots) {
   }
 }
 
+TEST_F(EncoderBitrateAdjusterTest, PredictedOvershootReducesTargetEarly) {
+  test::ScopedKeyValueConfig field_trial(
+      scoped_field_trial_,
+      "WebRTC-VideoRateControl/adjuster_use_qp_prediction:true/");
+  current_input_allocation_.SetBitrate(0, 0, 300000);
+  target_framerate_fps_ = 30;
+  SetUpAdjuster(1, 1, false);
+  InsertFrames({{1.0}}, kWindowSizeMs);
+  InsertFramesWithQpDrop();
+
+  // The few large frames barely move the windowed utilization, but the
+  // predicted one cuts the target by close to half already.
+  current_adjusted_allocation_ =
+      adjuster_->AdjustRateAllocation(VideoEncoder::RateControlParameters(
+          current_input_allocation_, target_framerate_fps_));
+  EXPECT_LT(current_adjusted_allocation_.GetBitrate(0, 0),
+            current_input_allocation_.GetBitrate(0, 0) / 1.5);
+}
+
+TEST_F(EncoderBitrateAdjusterTest, PredictedOvershootNotUsedByDefault) {
+  current_input_allocation_.SetBitrate(0, 0, 300000);
+  target_framerate_fps_ = 30;
+  SetUpAdjuster(1, 1, false);
+  InsertFrames({{1.0}}, kWindowSizeMs);
+  InsertFramesWithQpDrop();
+
+  current_adjusted_allocation_ =
+      adjuster_->AdjustRateAllocation(VideoEncoder::RateControlParameters(
+          current_input_allocation_, target_framerate_fps_));
+  EXPECT_GT(current_adjusted_allocation_.GetBitrate(0, 0),
+            current_input_allocation_.GetBitrate(0, 0) / 1.2);
+}
+
 TEST_F(EncoderBitrateAdjusterTest, HeadroomAllowsOvershootToMediaRate) {
   // Two streams, both with three temporal layers.
   // Media rate is 1.0, but network rate is higher.
@@ -11,6 +11,7 @@
 #include "video/encoder_overshoot_detector.h"
 
 #include <algorithm>
+#include <cmath>
 #include <string>
 
 #include "system_wrappers/include/metrics.h"
@@ -21,6 +22,17 @@ namespace {
 // down to
 // -(`kMaxMediaUnderrunFrames` / `target_framerate_fps_`) * `target_bitrate_`.
 static constexpr double kMaxMediaUnderrunFrames = 5.0;
+// Weight of the latest frame in the frame size model.
+static constexpr double kFrameSizeModelSmoothingFactor = 0.1;
+// Number of frames needed before the frame size model is trusted.
+static constexpr int64_t kMinFramesForPrediction = 5;
+// Number of most recent frames whose QP must all be lowered for the model to
+// predict larger frames. A single low QP frame, e.g. when the encoder
+// alternates between QPs, is not a sustained drop.
+static constexpr size_t kQpDropFrames = 3;
+// Below this QP variance, the slope of the model is too noisy to be used, and
+// the prediction is just the average frame size.
+static constexpr double kMinQpVariance = 0.5;
 }  // namespace
 
 EncoderOvershootDetector::EncoderOvershootDetector(int64_t window_size_ms,
@@ -58,18 +70,24 @@ void EncoderOvershootDetector::SetTargetRate(DataRate target_bitrate,
     sum_media_utilization_factors_ = 0.0;
     network_buffer_level_bits_ = 0;
     media_buffer_level_bits_ = 0;
+    frame_size_model_ = FrameSizeModel();
   }
 
   target_bitrate_ = target_bitrate;
   target_framerate_fps_ = target_framerate_fps;
 }
 
-void EncoderOvershootDetector::OnEncodedFrame(size_t bytes, int64_t time_ms) {
+void EncoderOvershootDetector::OnEncodedFrame(size_t bytes,
+                                              int64_t time_ms,
+                                              absl::optional<int> qp) {
   // Leak bits from the virtual pacer buffer, according to the current target
   // bitrate.
   LeakBits(time_ms);
 
   const int64_t frame_size_bits = bytes * 8;
+  if (frame_size_bits > 0 && qp) {
+    UpdateFrameSizeModel(frame_size_bits, *qp);
+  }
   // Ideal size of a frame given the current rates.
   const int64_t ideal_frame_size_bits = IdealFrameSizeBits();
   if (ideal_frame_size_bits == 0) {
@@ -162,6 +180,60 @@ absl::optional<double> EncoderOvershootDetector::GetMediaRateUtilizationFactor(
   return sum_media_utilization_factors_ / utilization_factors_.size();
 }
 
+absl::optional<double> EncoderOvershootDetector::GetPredictedUtilizationFactor()
+    const {
+  const int64_t ideal_frame_size_bits = IdealFrameSizeBits();
+  if (frame_size_model_.num_frames < kMinFramesForPrediction ||
+      ideal_frame_size_bits == 0) {
+    return absl::nullopt;
+  }
+
+  if (frame_size_model_.recent_qps.size() < kQpDropFrames) {
+    return absl::nullopt;
+  }
+
+  // Assume the next frame is encoded with the highest QP of the most recent
+  // frames, so that only a QP drop sustained over all of them predicts
+  // larger frames. A higher QP never predicts a larger frame.
+  const int qp = *std::max_element(frame_size_model_.recent_qps.begin(),
+                                   frame_size_model_.recent_qps.end());
+  double slope = 0.0;
+  if (frame_size_model_.qp_variance >= kMinQpVariance) {
+    slope = std::min(0.0, frame_size_model_.qp_log2_size_covariance /
+                              frame_size_model_.qp_variance);
+  }
+  const double predicted_log2_size =
+      frame_size_model_.mean_log2_size +
+      slope * (qp - frame_size_model_.mean_qp);
+  return std::exp2(predicted_log2_size) / ideal_frame_size_bits;
+}
+
+void EncoderOvershootDetector::UpdateFrameSizeModel(int64_t frame_size_bits,
+                                                    int qp) {
+  const double log2_size = std::log2(static_cast<double>(frame_size_bits));
+  FrameSizeModel& model = frame_size_model_;
+  model.recent_qps.push_back(qp);
+  if (model.recent_qps.size() > kQpDropFrames) {
+    model.recent_qps.pop_front();
+  }
+  if (model.num_frames++ == 0) {
+    model.mean_qp = qp;
+    model.mean_log2_size = log2_size;
+    return;
+  }
+
+  constexpr double kAlpha = kFrameSizeModelSmoothingFactor;
+  const double qp_diff = qp - model.mean_qp;
+  const double log2_size_diff = log2_size - model.mean_log2_size;
+  model.mean_qp += kAlpha * qp_diff;
+  model.mean_log2_size += kAlpha * log2_size_diff;
+  model.qp_variance =
+      (1 - kAlpha) * (model.qp_variance + kAlpha * qp_diff * qp_diff);
+  model.qp_log2_size_covariance =
+      (1 - kAlpha) *
+      (model.qp_log2_size_covariance + kAlpha * qp_diff * log2_size_diff);
+}
+
 void EncoderOvershootDetector::Reset() {
   UpdateHistograms();
   sum_diff_kbps_squared_ = 0;
@@ -175,6 +247,7 @@ void EncoderOvershootDetector::Reset() {
   target_framerate_fps_ = 0.0;
   network_buffer_level_bits_ = 0;
   media_buffer_level_bits_ = 0;
+  frame_size_model_ = FrameSizeModel();
 }
 
 int64_t EncoderOvershootDetector::IdealFrameSizeBits() const {
@@ -30,7 +30,12 @@ class EncoderOvershootDetector {
                      double target_framerate_fps,
                      int64_t time_ms);
   // A frame has been encoded or dropped. `bytes` == 0 indicates a drop.
-  void OnEncodedFrame(size_t bytes, int64_t time_ms);
+  // `qp`, if known, is used to predict the size of the next frame. It should
+  // not be given for key frames, whose size doesn't follow the QP of the delta
+  // frames around them.
+  void OnEncodedFrame(size_t bytes,
+                      int64_t time_ms,
+                      absl::optional<int> qp = absl::nullopt);
   // This utilization factor reaches 1.0 only if the encoder produces encoded
   // frame in such a way that they can be sent onto the network at
   // `target_bitrate` without building growing queues.
@@ -39,11 +44,18 @@ class EncoderOvershootDetector {
   // relation to ideal sizes. An undershoot may be compensated by an
   // overshoot so that the average over time is close to `target_bitrate`.
   absl::optional<double> GetMediaRateUtilizationFactor(int64_t time_ms);
+  // This utilization factor is the predicted size of the next frame in
+  // relation to the ideal size. Unlike the factors above, which average over
+  // the window, it reacts within a few frames to the encoder spending more
+  // bits, i.e. when the QP has dropped for the last few frames. Only available
+  // once frames with a known QP have been encoded.
+  absl::optional<double> GetPredictedUtilizationFactor() const;
   void Reset();
 
  private:
   int64_t IdealFrameSizeBits() const;
   void LeakBits(int64_t time_ms);
+  void UpdateFrameSizeModel(int64_t frame_size_bits, int qp);
   void CullOldUpdates(int64_t time_ms);
   // Updates provided buffer and checks if overuse ensues, returns
   // the calculated utilization factor for this frame.
@@ -68,6 +80,19 @@ class EncoderOvershootDetector {
     int64_t update_time_ms;
   };
   void UpdateHistograms();
+
+  // Exponentially weighted linear model of log2 of the frame size as a
+  // function of the QP, which the encoder changes ahead of the frame size
+  // settling at a new level.
+  struct FrameSizeModel {
+    int64_t num_frames = 0;
+    std::deque<int> recent_qps;
+    double mean_qp = 0.0;
+    double mean_log2_size = 0.0;
+    double qp_variance = 0.0;
+    double qp_log2_size_covariance = 0.0;
+  };
+  FrameSizeModel frame_size_model_;
   std::deque<BitrateUpdate> utilization_factors_;
   double sum_network_utilization_factors_;
   double sum_media_utilization_factors_;
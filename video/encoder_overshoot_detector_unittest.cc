@@ -10,6 +10,7 @@
 
 #include "video/encoder_overshoot_detector.h"
 
+#include <cmath>
 #include <string>
 
 #include "api/units/data_rate.h"
@@ -267,6 +268,56 @@ TEST_P(EncoderOvershootDetectorTest,
                                          50));
 }
 
+TEST_P(EncoderOvershootDetectorTest, NoPredictionWithoutQp) {
+  const int frame_size_bytes =
+      target_bitrate_.bps() / target_framerate_fps_ / 8;
+  detector_.SetTargetRate(target_bitrate_, target_framerate_fps_,
+                          rtc::TimeMillis());
+  for (int i = 0; i < 30; ++i) {
+    detector_.OnEncodedFrame(frame_size_bytes, rtc::TimeMillis());
+    clock_.AdvanceTime(TimeDelta::Seconds(1) / target_framerate_fps_);
+  }
+  EXPECT_FALSE(detector_.GetPredictedUtilizationFactor());
+}
+
+TEST_P(EncoderOvershootDetectorTest, PredictsLargerFrameWhenQpDrops) {
+  const double ideal_frame_size_bytes =
+      target_bitrate_.bps() / target_framerate_fps_ / 8;
+  // Frame size doubles for every 6 steps the QP is lowered, and is ideal at
+  // QP 31.
+  auto frame_size_bytes = [&](int qp) {
+    return static_cast<size_t>(ideal_frame_size_bytes *
+                               std::exp2((31 - qp) / 6.0));
+  };
+  detector_.SetTargetRate(target_bitrate_, target_framerate_fps_,
+                          rtc::TimeMillis());
+  for (int i = 0; i < 3 * kDefaultFrameRateFps; ++i) {
+    const int qp = i % 2 == 0 ? 28 : 34;
+    detector_.OnEncodedFrame(frame_size_bytes(qp), rtc::TimeMillis(), qp);
+    clock_.AdvanceTime(TimeDelta::Seconds(1) / target_framerate_fps_);
+  }
+  // Alternating QPs are not a sustained drop. The next frame is predicted to
+  // be encoded with the higher QP, 34.
+  EXPECT_NEAR(detector_.GetPredictedUtilizationFactor().value_or(-1),
+              std::exp2(-3 / 6.0), 0.1);
+
+  // A single frame with a much lower QP doesn't predict larger frames either.
+  detector_.OnEncodedFrame(frame_size_bytes(22), rtc::TimeMillis(), 22);
+  clock_.AdvanceTime(TimeDelta::Seconds(1) / target_framerate_fps_);
+  EXPECT_LT(detector_.GetPredictedUtilizationFactor().value_or(-1), 1.0);
+
+  // Once the lower QP is sustained, the predicted frame size is far above
+  // what the windowed media utilization shows.
+  for (int i = 0; i < 2; ++i) {
+    detector_.OnEncodedFrame(frame_size_bytes(22), rtc::TimeMillis(), 22);
+    clock_.AdvanceTime(TimeDelta::Seconds(1) / target_framerate_fps_);
+  }
+  EXPECT_GT(detector_.GetPredictedUtilizationFactor().value_or(-1), 2.0);
+  EXPECT_LT(detector_.GetMediaRateUtilizationFactor(rtc::TimeMillis())
+                .value_or(-1),
+            1.5);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     PerCodecType,
     EncoderOvershootDetectorTest,
@@ -14,6 +14,7 @@
 #include <utility>
 
 #include "absl/types/optional.h"
+#include "api/video/video_frame_type.h"
 #include "api/video_codecs/video_encoder.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/keyframe_interval_settings.h"
@@ -35,7 +36,7 @@ EncoderRtcpFeedback::EncoderRtcpFeedback(
       ssrcs_(ssrcs),
       get_packet_infos_(std::move(get_packet_infos)),
       video_stream_encoder_(encoder),
-      time_last_packet_delivery_queue_(Timestamp::Zero()),
+      time_last_key_frame_request_(ssrcs.size(), Timestamp::MinusInfinity()),
       min_keyframe_send_interval_(
           TimeDelta::Millis(KeyframeIntervalSettings::ParseFromFieldTrials()
                                 .MinKeyframeSendIntervalMs()
@@ -47,16 +48,28 @@ EncoderRtcpFeedback::EncoderRtcpFeedback(
 // Called via Call::DeliverRtcp.
 void EncoderRtcpFeedback::OnReceivedIntraFrameRequest(uint32_t ssrc) {
   RTC_DCHECK_RUN_ON(&packet_delivery_queue_);
-  RTC_DCHECK(std::find(ssrcs_.begin(), ssrcs_.end(), ssrc) != ssrcs_.end());
+  auto it = std::find(ssrcs_.begin(), ssrcs_.end(), ssrc);
+  RTC_DCHECK(it != ssrcs_.end());
+  if (it == ssrcs_.end()) {
+    return;
+  }
+  const size_t index = it - ssrcs_.begin();
 
   const Timestamp now = clock_->CurrentTime();
-  if (time_last_packet_delivery_queue_ + min_keyframe_send_interval_ > now)
+  if (time_last_key_frame_request_[index] + min_keyframe_send_interval_ > now)
     return;
 
-  time_last_packet_delivery_queue_ = now;
+  time_last_key_frame_request_[index] = now;
 
-  // Always produce key frame for all streams.
-  video_stream_encoder_->SendKeyFrame();
+  if (ssrcs_.size() == 1) {
+    video_stream_encoder_->SendKeyFrame();
+    return;
+  }
+  // Only produce a key frame for the stream sent on `ssrc`.
+  std::vector<VideoFrameType> layers(ssrcs_.size(),
+                                     VideoFrameType::kVideoFrameDelta);
+  layers[index] = VideoFrameType::kVideoFrameKey;
+  video_stream_encoder_->SendKeyFrame(layers);
 }
 
 void EncoderRtcpFeedback::OnReceivedLossNotification(
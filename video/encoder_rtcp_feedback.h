@@ -58,7 +58,11 @@ class EncoderRtcpFeedback : public RtcpIntraFrameObserver,
   VideoStreamEncoderInterface* const video_stream_encoder_;
 
   RTC_NO_UNIQUE_ADDRESS SequenceChecker packet_delivery_queue_;
-  Timestamp time_last_packet_delivery_queue_
+  // Time of the last key frame request passed on for each of `ssrcs_`. Each
+  // layer is throttled separately, so that requests from the receivers of one
+  // layer, e.g. the many subscribers of an SFU, don't cause key frames on the
+  // others.
+  std::vector<Timestamp> time_last_key_frame_request_
       RTC_GUARDED_BY(packet_delivery_queue_);
 
   const TimeDelta min_keyframe_send_interval_;
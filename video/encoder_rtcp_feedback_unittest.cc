@@ -17,6 +17,7 @@
 #include "video/test/mock_video_stream_encoder.h"
 
 using ::testing::_;
+using ::testing::ElementsAre;
 
 namespace webrtc {
 
@@ -58,4 +59,33 @@ TEST_F(VieKeyRequestTest, TooManyOnReceivedIntraFrameRequest) {
   encoder_rtcp_feedback_.OnReceivedIntraFrameRequest(kSsrc);
 }
 
+TEST(EncoderRtcpFeedbackTest, RequestsKeyFramePerLayer) {
+  const std::vector<uint32_t> kSsrcs = {1, 2, 3};
+  SimulatedClock clock(123456789);
+  ::testing::StrictMock<MockVideoStreamEncoder> encoder;
+  EncoderRtcpFeedback feedback(&clock, kSsrcs, &encoder, nullptr);
+
+  EXPECT_CALL(encoder, SendKeyFrame(ElementsAre(
+                           VideoFrameType::kVideoFrameDelta,
+                           VideoFrameType::kVideoFrameKey,
+                           VideoFrameType::kVideoFrameDelta)));
+  feedback.OnReceivedIntraFrameRequest(2);
+  // Repeated requests for the same layer are throttled, e.g. from the other
+  // subscribers of that layer, but not those for other layers.
+  feedback.OnReceivedIntraFrameRequest(2);
+  EXPECT_CALL(encoder, SendKeyFrame(ElementsAre(
+                           VideoFrameType::kVideoFrameKey,
+                           VideoFrameType::kVideoFrameDelta,
+                           VideoFrameType::kVideoFrameDelta)));
+  feedback.OnReceivedIntraFrameRequest(1);
+  ::testing::Mock::VerifyAndClearExpectations(&encoder);
+
+  clock.AdvanceTimeMilliseconds(300);
+  EXPECT_CALL(encoder, SendKeyFrame(ElementsAre(
+                           VideoFrameType::kVideoFrameDelta,
+                           VideoFrameType::kVideoFrameKey,
+                           VideoFrameType::kVideoFrameDelta)));
+  feedback.OnReceivedIntraFrameRequest(2);
+}
+
 }  // namespace webrtc
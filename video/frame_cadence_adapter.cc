@@ -19,6 +19,10 @@
 
 #include "absl/algorithm/container.h"
 #include "absl/base/attributes.h"
+#include "absl/functional/any_invocable.h"
+#include "api/make_ref_counted.h"
+#include "api/ref_counted_base.h"
+#include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/task_queue/task_queue_base.h"
@@ -225,10 +229,92 @@ class ZeroHertzAdapterMode : public AdapterMode {
   ScopedTaskSafety safety_;
 };
 
+// Posts tasks to a queue on the ticks of a metronome used on a worker queue.
+// Referenced by the pending metronome callbacks, since the adapter is
+// destroyed on its queue, which the worker queue doesn't synchronize with.
+class MetronomeTaskPoster
+    : public rtc::RefCountedNonVirtual<MetronomeTaskPoster> {
+ public:
+  // Called on the queue with whether the tasks of a later tick were posted
+  // before the task ran, i.e. whether the queue is falling behind the ticks.
+  // Tasks posted on the same tick don't count, since they are all posted at
+  // once by design.
+  using Task = absl::AnyInvocable<void(bool later_tick_posted) &&>;
+
+  MetronomeTaskPoster(Metronome* metronome,
+                      TaskQueueBase* worker_queue,
+                      TaskQueueBase* queue)
+      : metronome_(metronome), worker_queue_(worker_queue), queue_(queue) {}
+
+  // Posts `task` to the queue on the next tick. May be called on any thread.
+  void PostTaskOnNextTick(Task task) {
+    MutexLock lock(&mutex_);
+    if (queue_ == nullptr) {
+      return;
+    }
+    pending_tasks_.push_back(std::move(task));
+    if (tick_requested_) {
+      return;
+    }
+    // A single request per tick, for all the tasks posted until then.
+    tick_requested_ = true;
+    worker_queue_->PostTask(
+        [poster = rtc::scoped_refptr<MetronomeTaskPoster>(this)] {
+          RTC_DCHECK_RUN_ON(poster->worker_queue_);
+          poster->metronome_->RequestCallOnNextTick(
+              [poster] { poster->OnTick(); });
+        });
+  }
+
+  // Drops the pending tasks, and the ones posted later. Called on the queue,
+  // before it's destroyed.
+  void Stop() {
+    MutexLock lock(&mutex_);
+    RTC_DCHECK_RUN_ON(queue_);
+    queue_ = nullptr;
+    pending_tasks_.clear();
+  }
+
+ private:
+  void OnTick() {
+    RTC_DCHECK_RUN_ON(worker_queue_);
+    MutexLock lock(&mutex_);
+    tick_requested_ = false;
+    if (queue_ == nullptr) {
+      return;
+    }
+    const int64_t tick = ++ticks_posted_;
+    for (Task& task : pending_tasks_) {
+      queue_->PostTask(
+          [poster = rtc::scoped_refptr<MetronomeTaskPoster>(this), tick,
+           task = std::move(task)]() mutable {
+            std::move(task)(poster->ticks_posted() > tick);
+          });
+    }
+    pending_tasks_.clear();
+  }
+
+  int64_t ticks_posted() {
+    MutexLock lock(&mutex_);
+    return ticks_posted_;
+  }
+
+  Metronome* const metronome_;
+  TaskQueueBase* const worker_queue_;
+  Mutex mutex_;
+  TaskQueueBase* queue_ RTC_GUARDED_BY(mutex_);
+  std::vector<Task> pending_tasks_ RTC_GUARDED_BY(mutex_);
+  bool tick_requested_ RTC_GUARDED_BY(mutex_) = false;
+  // Number of ticks on which tasks were posted to the queue.
+  int64_t ticks_posted_ RTC_GUARDED_BY(mutex_) = 0;
+};
+
 class FrameCadenceAdapterImpl : public FrameCadenceAdapterInterface {
  public:
   FrameCadenceAdapterImpl(Clock* clock,
                           TaskQueueBase* queue,
+                          Metronome* metronome,
+                          TaskQueueBase* worker_queue,
                           const FieldTrialsView& field_trials);
   ~FrameCadenceAdapterImpl();
 
@@ -267,6 +353,8 @@ class FrameCadenceAdapterImpl : public FrameCadenceAdapterInterface {
 
   Clock* const clock_;
   TaskQueueBase* const queue_;
+  // Set if frames are posted to `queue_` on metronome ticks.
+  const rtc::scoped_refptr<MetronomeTaskPoster> metronome_task_poster_;
 
   // True if we support frame entry for screenshare with a minimum frequency of
   // 0 Hz.
@@ -598,14 +686,25 @@ void ZeroHertzAdapterMode::MaybeStartRefreshFrameRequester() {
 FrameCadenceAdapterImpl::FrameCadenceAdapterImpl(
     Clock* clock,
     TaskQueueBase* queue,
+    Metronome* metronome,
+    TaskQueueBase* worker_queue,
     const FieldTrialsView& field_trials)
     : clock_(clock),
       queue_(queue),
+      metronome_task_poster_(
+          metronome ? rtc::make_ref_counted<MetronomeTaskPoster>(
+                          metronome, worker_queue, queue)
+                    : nullptr),
       zero_hertz_screenshare_enabled_(
-          !field_trials.IsDisabled("WebRTC-ZeroHertzScreenshare")) {}
+          !field_trials.IsDisabled("WebRTC-ZeroHertzScreenshare")) {
+  RTC_DCHECK(!metronome || worker_queue);
+}
 
 FrameCadenceAdapterImpl::~FrameCadenceAdapterImpl() {
   RTC_DLOG(LS_VERBOSE) << __func__ << " this " << this;
+  if (metronome_task_poster_) {
+    metronome_task_poster_->Stop();
+  }
 }
 
 void FrameCadenceAdapterImpl::Initialize(Callback* callback) {
@@ -672,7 +771,11 @@ void FrameCadenceAdapterImpl::OnFrame(const VideoFrame& frame) {
                              "OnFrameToQueue",
                              frame.video_frame_buffer().get());
   }
-  queue_->PostTask(SafeTask(safety_.flag(), [this, post_time, frame] {
+  auto task = [safety = safety_.flag(), this, post_time,
+               frame](bool later_tick_posted) {
+    if (!safety->alive()) {
+      return;
+    }
     RTC_DCHECK_RUN_ON(queue_);
     if (zero_hertz_adapter_is_active_.load(std::memory_order_relaxed)) {
       TRACE_EVENT_ASYNC_END0(TRACE_DISABLED_BY_DEFAULT("webrtc"),
@@ -691,9 +794,21 @@ void FrameCadenceAdapterImpl::OnFrame(const VideoFrame& frame) {
     const int frames_scheduled_for_processing =
         frames_scheduled_for_processing_.fetch_sub(1,
                                                    std::memory_order_relaxed);
-    OnFrameOnMainQueue(post_time, frames_scheduled_for_processing > 1,
-                       std::move(frame));
-  }));
+    // With a metronome, the frames that arrived since the previous tick are
+    // posted together, so frames waiting behind this one only mean overload
+    // if they were posted on a later tick.
+    const bool queue_overload = metronome_task_poster_
+                                    ? later_tick_posted
+                                    : frames_scheduled_for_processing > 1;
+    OnFrameOnMainQueue(post_time, queue_overload, std::move(frame));
+  };
+  if (metronome_task_poster_) {
+    metronome_task_poster_->PostTaskOnNextTick(std::move(task));
+  } else {
+    queue_->PostTask([task = std::move(task)]() mutable {
+      std::move(task)(/*later_tick_posted=*/false);
+    });
+  }
 }
 
 void FrameCadenceAdapterImpl::OnDiscardedFrame() {
@@ -766,8 +881,11 @@ void FrameCadenceAdapterImpl::MaybeReconfigureAdapters(
 std::unique_ptr<FrameCadenceAdapterInterface>
 FrameCadenceAdapterInterface::Create(Clock* clock,
                                      TaskQueueBase* queue,
+                                     Metronome* metronome,
+                                     TaskQueueBase* worker_queue,
                                      const FieldTrialsView& field_trials) {
-  return std::make_unique<FrameCadenceAdapterImpl>(clock, queue, field_trials);
+  return std::make_unique<FrameCadenceAdapterImpl>(clock, queue, metronome,
+                                                   worker_queue, field_trials);
 }
 
 }  // namespace webrtc
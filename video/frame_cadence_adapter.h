@@ -15,6 +15,7 @@
 
 #include "absl/base/attributes.h"
 #include "api/field_trials_view.h"
+#include "api/metronome/metronome.h"
 #include "api/task_queue/task_queue_base.h"
 #include "api/units/time_delta.h"
 #include "api/video/video_frame.h"
@@ -77,10 +78,14 @@ class FrameCadenceAdapterInterface
   // Factory function creating a production instance. Deletion of the returned
   // instance needs to happen on the same sequence that Create() was called on.
   // Frames arriving in FrameCadenceAdapterInterface::OnFrame are posted to
-  // Callback::OnFrame on the |queue|.
+  // Callback::OnFrame on the |queue|. If |metronome| is set, frames are posted
+  // on its ticks instead, so that the encoders of several streams run together.
+  // The |metronome| is used on |worker_queue|, which must then be set.
   static std::unique_ptr<FrameCadenceAdapterInterface> Create(
       Clock* clock,
       TaskQueueBase* queue,
+      Metronome* metronome,
+      TaskQueueBase* worker_queue,
       const FieldTrialsView& field_trials);
 
   // Call before using the rest of the API.
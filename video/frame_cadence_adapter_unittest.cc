@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "absl/functional/any_invocable.h"
+#include "api/metronome/test/fake_metronome.h"
 #include "api/task_queue/default_task_queue_factory.h"
 #include "api/task_queue/task_queue_base.h"
 #include "api/task_queue/task_queue_factory.h"
@@ -65,6 +66,8 @@ std::unique_ptr<FrameCadenceAdapterInterface> CreateAdapter(
     const FieldTrialsView& field_trials,
     Clock* clock) {
   return FrameCadenceAdapterInterface::Create(clock, TaskQueueBase::Current(),
+                                              /*metronome=*/nullptr,
+                                              /*worker_queue=*/nullptr,
                                               field_trials);
 }
 
@@ -126,6 +129,57 @@ TEST(FrameCadenceAdapterTest, CountsOutstandingFramesToProcess) {
   time_controller.AdvanceTime(TimeDelta::Zero());
 }
 
+TEST(FrameCadenceAdapterTest, PostsFramesOnMetronomeTicks) {
+  test::ScopedKeyValueConfig no_field_trials;
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1));
+  test::ForcedTickMetronome metronome(TimeDelta::Millis(16));
+  MockCallback callback1;
+  MockCallback callback2;
+  auto adapter1 = FrameCadenceAdapterInterface::Create(
+      time_controller.GetClock(), TaskQueueBase::Current(), &metronome,
+      TaskQueueBase::Current(), no_field_trials);
+  auto adapter2 = FrameCadenceAdapterInterface::Create(
+      time_controller.GetClock(), TaskQueueBase::Current(), &metronome,
+      TaskQueueBase::Current(), no_field_trials);
+  adapter1->Initialize(&callback1);
+  adapter2->Initialize(&callback2);
+  auto frame = CreateFrame();
+  adapter1->OnFrame(frame);
+  adapter1->OnFrame(frame);
+  adapter2->OnFrame(frame);
+  EXPECT_CALL(callback1, OnFrame).Times(0);
+  EXPECT_CALL(callback2, OnFrame).Times(0);
+  time_controller.AdvanceTime(TimeDelta::Millis(10));
+  // A single request per adapter and tick.
+  EXPECT_EQ(metronome.NumListeners(), 2u);
+  Mock::VerifyAndClearExpectations(&callback1);
+  Mock::VerifyAndClearExpectations(&callback2);
+
+  // Frames batched on the same tick don't indicate overload.
+  EXPECT_CALL(callback1, OnFrame(_, /*queue_overload=*/false, _)).Times(2);
+  EXPECT_CALL(callback2, OnFrame(_, /*queue_overload=*/false, _)).Times(1);
+  metronome.Tick();
+  time_controller.AdvanceTime(TimeDelta::Zero());
+  EXPECT_EQ(metronome.NumListeners(), 0u);
+}
+
+TEST(FrameCadenceAdapterTest, DropsFramesWaitingForTickOnDestruction) {
+  test::ScopedKeyValueConfig no_field_trials;
+  GlobalSimulatedTimeController time_controller(Timestamp::Millis(1));
+  test::ForcedTickMetronome metronome(TimeDelta::Millis(16));
+  MockCallback callback;
+  auto adapter = FrameCadenceAdapterInterface::Create(
+      time_controller.GetClock(), TaskQueueBase::Current(), &metronome,
+      TaskQueueBase::Current(), no_field_trials);
+  adapter->Initialize(&callback);
+  adapter->OnFrame(CreateFrame());
+  time_controller.AdvanceTime(TimeDelta::Zero());
+  adapter = nullptr;
+  EXPECT_CALL(callback, OnFrame).Times(0);
+  metronome.Tick();
+  time_controller.AdvanceTime(TimeDelta::Zero());
+}
+
 TEST(FrameCadenceAdapterTest, FrameRateFollowsRateStatisticsByDefault) {
   test::ScopedKeyValueConfig no_field_trials;
   GlobalSimulatedTimeController time_controller(Timestamp::Zero());
@@ -593,7 +647,8 @@ TEST(FrameCadenceAdapterTest, IgnoresDropInducedCallbacksPostDestruction) {
   auto queue = time_controller.GetTaskQueueFactory()->CreateTaskQueue(
       "queue", TaskQueueFactory::Priority::NORMAL);
   auto adapter = FrameCadenceAdapterInterface::Create(
-      time_controller.GetClock(), queue.get(), enabler);
+      time_controller.GetClock(), queue.get(), /*metronome=*/nullptr,
+      /*worker_queue=*/nullptr, enabler);
   queue->PostTask([&adapter, &callback] {
     adapter->Initialize(callback.get());
     adapter->SetZeroHertzModeEnabled(
@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/frame_content_analyzer.h"
+
+#include <utility>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "third_party/libyuv/include/libyuv/compare.h"
+#include "third_party/libyuv/include/libyuv/scale.h"
+
+namespace webrtc {
+
+FrameContentAnalyzer::Content FrameContentAnalyzer::Analyze(
+    const VideoFrame& frame) {
+  if (frame.width() != width_ || frame.height() != height_) {
+    width_ = frame.width();
+    height_ = frame.height();
+    has_previous_ = false;
+  }
+  if (has_previous_ && frame.has_update_rect() &&
+      frame.update_rect().IsEmpty()) {
+    return Content::kStatic;
+  }
+
+  rtc::scoped_refptr<VideoFrameBuffer> buffer = frame.video_frame_buffer();
+  const uint8_t* data_y = nullptr;
+  int stride_y = 0;
+  switch (buffer->type()) {
+    case VideoFrameBuffer::Type::kI420:
+    case VideoFrameBuffer::Type::kI420A:
+      data_y = buffer->GetI420()->DataY();
+      stride_y = buffer->GetI420()->StrideY();
+      break;
+    case VideoFrameBuffer::Type::kNV12:
+      data_y = buffer->GetNV12()->DataY();
+      stride_y = buffer->GetNV12()->StrideY();
+      break;
+    default:
+      // Mapping other buffers, e.g. native ones, is too expensive.
+      has_previous_ = false;
+      return Content::kUnknown;
+  }
+
+  libyuv::ScalePlane(data_y, stride_y, width_, height_, current_.data(),
+                     kThumbnailWidth, kThumbnailWidth, kThumbnailHeight,
+                     libyuv::kFilterBox);
+  std::swap(current_, previous_);
+  if (!has_previous_) {
+    has_previous_ = true;
+    return Content::kUnknown;
+  }
+
+  const double mse =
+      static_cast<double>(libyuv::ComputeSumSquareError(
+          previous_.data(), current_.data(), previous_.size())) /
+      previous_.size();
+  if (mse < kStaticThreshold) {
+    return Content::kStatic;
+  }
+  if (mse > kSceneChangeThreshold) {
+    return Content::kSceneChange;
+  }
+  return Content::kChanged;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_FRAME_CONTENT_ANALYZER_H_
+#define VIDEO_FRAME_CONTENT_ANALYZER_H_
+
+#include <stdint.h>
+
+#include <array>
+
+#include "api/video/video_frame.h"
+
+namespace webrtc {
+
+// Classifies the content of each frame by comparing it to the previous one,
+// without any lookahead. The luma planes are box filtered down to a small
+// thumbnail, and the mean squared difference of the thumbnails tells static
+// content, e.g. an idle screenshare, apart from scene changes, e.g. switching
+// slides. Both the downscaling and the comparison use the SIMD code of libyuv,
+// so the cost per frame is about one read of the luma plane. Frames with an
+// empty update rect aren't read at all.
+// This class is thread-compatible.
+class FrameContentAnalyzer {
+ public:
+  enum class Content {
+    // Nothing is known about the change, e.g. for the first frame, after a
+    // resolution change, or for frames without a mappable luma plane.
+    kUnknown,
+    kStatic,
+    kChanged,
+    kSceneChange,
+  };
+
+  static constexpr int kThumbnailWidth = 64;
+  static constexpr int kThumbnailHeight = 36;
+  // Thresholds for the mean squared difference per thumbnail pixel. Box
+  // filtering averages out sensor noise, so static camera content is well
+  // below `kStaticThreshold`, and only large changes of most of the frame
+  // exceed `kSceneChangeThreshold`.
+  static constexpr double kStaticThreshold = 1.0;
+  static constexpr double kSceneChangeThreshold = 900.0;
+
+  Content Analyze(const VideoFrame& frame);
+
+ private:
+  using Thumbnail = std::array<uint8_t, kThumbnailWidth * kThumbnailHeight>;
+
+  int width_ = 0;
+  int height_ = 0;
+  bool has_previous_ = false;
+  Thumbnail previous_;
+  Thumbnail current_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_FRAME_CONTENT_ANALYZER_H_
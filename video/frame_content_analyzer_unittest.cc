@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/frame_content_analyzer.h"
+
+#include <algorithm>
+
+#include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_rotation.h"
+#include "rtc_base/random.h"
+#include "test/fake_texture_frame.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using Content = FrameContentAnalyzer::Content;
+
+constexpr int kWidth = 640;
+constexpr int kHeight = 360;
+
+// Returns a frame with a horizontal luma gradient, of which the rectangle
+// given as fractions of the frame size is set to `rect_luma`. If `noise` is
+// set, up to +-3 is added to every luma sample.
+VideoFrame CreateFrame(int rect_luma = 0,
+                       double rect_width = 0.0,
+                       double rect_height = 0.0,
+                       Random* noise = nullptr,
+                       int width = kWidth,
+                       int height = kHeight) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      int luma = x * 255 / width;
+      if (x < width * rect_width && y < height * rect_height) {
+        luma = rect_luma;
+      }
+      if (noise) {
+        luma = std::min(std::max(luma + noise->Rand(-3, 3), 0), 255);
+      }
+      buffer->MutableDataY()[y * buffer->StrideY() + x] = luma;
+    }
+  }
+  return VideoFrame::Builder().set_video_frame_buffer(buffer).build();
+}
+
+TEST(FrameContentAnalyzerTest, FirstFrameIsUnknown) {
+  FrameContentAnalyzer analyzer;
+  EXPECT_EQ(analyzer.Analyze(CreateFrame()), Content::kUnknown);
+}
+
+TEST(FrameContentAnalyzerTest, IdenticalFramesAreStatic) {
+  FrameContentAnalyzer analyzer;
+  analyzer.Analyze(CreateFrame());
+  EXPECT_EQ(analyzer.Analyze(CreateFrame()), Content::kStatic);
+  EXPECT_EQ(analyzer.Analyze(CreateFrame()), Content::kStatic);
+}
+
+TEST(FrameContentAnalyzerTest, NoiseIsStatic) {
+  Random random(0x5eed);
+  FrameContentAnalyzer analyzer;
+  analyzer.Analyze(CreateFrame(0, 0.0, 0.0, &random));
+  EXPECT_EQ(analyzer.Analyze(CreateFrame(0, 0.0, 0.0, &random)),
+            Content::kStatic);
+}
+
+TEST(FrameContentAnalyzerTest, PartialChangeIsChanged) {
+  FrameContentAnalyzer analyzer;
+  analyzer.Analyze(CreateFrame());
+  EXPECT_EQ(analyzer.Analyze(CreateFrame(/*rect_luma=*/64, 0.25, 0.25)),
+            Content::kChanged);
+}
+
+TEST(FrameContentAnalyzerTest, FullChangeIsSceneChange) {
+  FrameContentAnalyzer analyzer;
+  analyzer.Analyze(CreateFrame());
+  EXPECT_EQ(analyzer.Analyze(CreateFrame(/*rect_luma=*/255, 1.0, 1.0)),
+            Content::kSceneChange);
+  EXPECT_EQ(analyzer.Analyze(CreateFrame(/*rect_luma=*/255, 1.0, 1.0)),
+            Content::kStatic);
+}
+
+TEST(FrameContentAnalyzerTest, EmptyUpdateRectIsStatic) {
+  FrameContentAnalyzer analyzer;
+  analyzer.Analyze(CreateFrame());
+  VideoFrame frame = CreateFrame(/*rect_luma=*/255, 1.0, 1.0);
+  frame.set_update_rect(VideoFrame::UpdateRect{0, 0, 0, 0});
+  EXPECT_EQ(analyzer.Analyze(frame), Content::kStatic);
+}
+
+TEST(FrameContentAnalyzerTest, ResolutionChangeIsUnknown) {
+  FrameContentAnalyzer analyzer;
+  analyzer.Analyze(CreateFrame());
+  VideoFrame frame = CreateFrame(0, 0.0, 0.0, nullptr, kWidth / 2, kHeight / 2);
+  frame.set_update_rect(VideoFrame::UpdateRect{0, 0, 0, 0});
+  EXPECT_EQ(analyzer.Analyze(frame), Content::kUnknown);
+  EXPECT_EQ(analyzer.Analyze(frame), Content::kStatic);
+}
+
+TEST(FrameContentAnalyzerTest, AnalyzesNv12Frames) {
+  FrameContentAnalyzer analyzer;
+  analyzer.Analyze(CreateFrame());
+  rtc::scoped_refptr<NV12Buffer> nv12 = NV12Buffer::Create(kWidth, kHeight);
+  nv12->InitializeData();
+  EXPECT_EQ(
+      analyzer.Analyze(VideoFrame::Builder().set_video_frame_buffer(nv12).build()),
+      Content::kSceneChange);
+}
+
+TEST(FrameContentAnalyzerTest, NativeFramesAreUnknown) {
+  FrameContentAnalyzer analyzer;
+  analyzer.Analyze(CreateFrame());
+  EXPECT_EQ(analyzer.Analyze(test::FakeNativeBuffer::CreateFrame(
+                kWidth, kHeight, 0, 0, kVideoRotation_0)),
+            Content::kUnknown);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -36,6 +36,17 @@ FrameDecodeTiming::OnFrameBufferUpdated(uint32_t next_temporal_unit_rtp,
   TimeDelta max_wait =
       timing_->MaxWaitingTime(render_time, now, too_many_frames_queued);
 
+  // A zero render time means that frames are rendered as soon as they are
+  // decoded, e.g. for cloud gaming. If a backlog has built up, e.g. after a
+  // network stall, catch up by fast-forwarding to the newest decodable frame
+  // rather than decoding and rendering every late frame.
+  if (render_time.IsZero() && too_many_frames_queued &&
+      next_temporal_unit_rtp != last_temporal_unit_rtp) {
+    RTC_DLOG(LS_VERBOSE) << "Fast-forwarded frame " << next_temporal_unit_rtp
+                         << " to catch up on the low-latency backlog.";
+    return absl::nullopt;
+  }
+
   // If the delay is not too far in the past, or this is the last decodable
   // frame then it is the best frame to be decoded. Otherwise, fast-forward
   // to the next frame in the buffer.
@@ -117,6 +117,29 @@ TEST_F(FrameDecodeTimingTest, NoFastForwardIfOnlyFrameToDecode) {
                         Eq(render_time)))));
 }
 
+TEST_F(FrameDecodeTimingTest, FastForwardsLowLatencyBacklog) {
+  // A zero render time is used for low-latency rendering, where the frames
+  // are paced but never late.
+  timing_.SetTimes(90000, Timestamp::Zero(), TimeDelta::Zero());
+  timing_.SetTimes(180000, Timestamp::Zero(), TimeDelta::Zero());
+
+  EXPECT_THAT(frame_decode_scheduler_.OnFrameBufferUpdated(
+                  90000, 180000, kMaxWaitForFrame, false),
+              Optional(Field(&FrameDecodeTiming::FrameSchedule::render_time,
+                             Eq(Timestamp::Zero()))));
+  EXPECT_THAT(frame_decode_scheduler_.OnFrameBufferUpdated(
+                  90000, 180000, kMaxWaitForFrame,
+                  /*too_many_frames_queued=*/true),
+              Eq(absl::nullopt));
+  // The newest decodable frame is decoded right away.
+  EXPECT_THAT(frame_decode_scheduler_.OnFrameBufferUpdated(
+                  180000, 180000, kMaxWaitForFrame,
+                  /*too_many_frames_queued=*/true),
+              Optional(Field(
+                  &FrameDecodeTiming::FrameSchedule::latest_decode_time,
+                  Eq(clock_.CurrentTime()))));
+}
+
 TEST_F(FrameDecodeTimingTest, MaxWaitCapped) {
   TimeDelta frame_delay = TimeDelta::Millis(30);
   const TimeDelta decode_delay = TimeDelta::Seconds(3);
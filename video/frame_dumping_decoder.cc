@@ -13,6 +13,9 @@
 #include <memory>
 #include <utility>
 
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/ivf_file_writer.h"
 
@@ -36,14 +39,21 @@ class FrameDumpingDecoder : public VideoDecoder {
  private:
   std::unique_ptr<VideoDecoder> decoder_;
   VideoCodecType codec_type_ = VideoCodecType::kVideoCodecGeneric;
+  // Writes the frames so that file IO doesn't delay decoding. Must outlive
+  // `writer_`.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> file_queue_;
   std::unique_ptr<IvfFileWriter> writer_;
 };
 
 FrameDumpingDecoder::FrameDumpingDecoder(std::unique_ptr<VideoDecoder> decoder,
                                          FileWrapper file)
     : decoder_(std::move(decoder)),
+      file_queue_(CreateDefaultTaskQueueFactory()->CreateTaskQueue(
+          "FrameDumpingDecoder",
+          TaskQueueFactory::Priority::LOW)),
       writer_(IvfFileWriter::Wrap(std::move(file),
-                                  /* byte_limit= */ 100000000)) {}
+                                  /* byte_limit= */ 100000000,
+                                  file_queue_.get())) {}
 
 FrameDumpingDecoder::~FrameDumpingDecoder() = default;
 
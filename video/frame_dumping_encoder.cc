@@ -17,6 +17,9 @@
 
 #include "absl/algorithm/container.h"
 #include "api/sequence_checker.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/video/video_codec_type.h"
 #include "modules/video_coding/utility/ivf_file_writer.h"
 #include "rtc_base/strings/string_builder.h"
@@ -32,9 +35,12 @@ constexpr auto kEncoderDataDumpDirectoryFieldTrial =
 class FrameDumpingEncoder : public VideoEncoder, public EncodedImageCallback {
  public:
   FrameDumpingEncoder(std::unique_ptr<VideoEncoder> wrapped,
+                      std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
+                          file_queue,
                       int64_t origin_time_micros,
                       std::string output_directory)
       : wrapped_(std::move(wrapped)),
+        file_queue_(std::move(file_queue)),
         output_directory_(output_directory),
         origin_time_micros_(origin_time_micros) {}
 
@@ -109,7 +115,7 @@ class FrameDumpingEncoder : public VideoEncoder, public EncodedImageCallback {
     }
     auto writer = IvfFileWriter::Wrap(
         FileWrapper::OpenWriteOnly(FilenameFromSimulcastIndex(index)),
-        /*byte_limit=*/100'000'000);
+        /*byte_limit=*/100'000'000, file_queue_.get());
     auto* writer_ptr = writer.get();
     writers_by_simulcast_index_.insert(
         std::make_pair(index, std::move(writer)));
@@ -117,6 +123,9 @@ class FrameDumpingEncoder : public VideoEncoder, public EncodedImageCallback {
   }
 
   std::unique_ptr<VideoEncoder> wrapped_;
+  // Writes the frames so that file IO doesn't delay the encoder callback.
+  // Must outlive the writers.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> file_queue_;
   Mutex mu_;
   std::map<int, std::unique_ptr<IvfFileWriter>> writers_by_simulcast_index_
       RTC_GUARDED_BY(mu_);
@@ -138,7 +147,11 @@ std::unique_ptr<VideoEncoder> MaybeCreateFrameDumpingEncoderWrapper(
   }
   absl::c_replace(output_directory, ';', '/');
   return std::make_unique<FrameDumpingEncoder>(
-      std::move(encoder), rtc::TimeMicros(), output_directory);
+      std::move(encoder),
+      CreateDefaultTaskQueueFactory(&field_trials)
+          ->CreateTaskQueue("FrameDumpingEncoder",
+                            TaskQueueFactory::Priority::LOW),
+      rtc::TimeMicros(), output_directory);
 }
 
 }  // namespace webrtc
@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/frame_preprocessor.h"
+
+#include <utility>
+
+#include "api/sequence_checker.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/trace_event.h"
+
+namespace webrtc {
+
+FramePreprocessor::FramePreprocessor(
+    rtc::VideoSinkInterface<VideoFrame>* sink,
+    VideoStreamEncoderObserver* encoder_stats_observer,
+    std::unique_ptr<TaskQueueBase, TaskQueueDeleter> queue,
+    int max_frames_in_flight)
+    : sink_(sink),
+      encoder_stats_observer_(encoder_stats_observer),
+      max_frames_in_flight_(max_frames_in_flight),
+      queue_(std::move(queue)) {
+  RTC_DCHECK(sink_);
+  RTC_DCHECK(encoder_stats_observer_);
+  RTC_DCHECK(queue_);
+  RTC_DCHECK_GT(max_frames_in_flight_, 0);
+}
+
+FramePreprocessor::~FramePreprocessor() = default;
+
+void FramePreprocessor::SetEncoderInfo(const VideoEncoder::EncoderInfo& info) {
+  MutexLock lock(&mutex_);
+  convert_native_frames_ = !info.supports_native_handle;
+  preferred_pixel_formats_ = info.preferred_pixel_formats;
+}
+
+void FramePreprocessor::OnFrame(const VideoFrame& frame) {
+  // Frames waiting on `queue_` must be forwarded first.
+  if (frames_in_flight_.load(std::memory_order_acquire) == 0 &&
+      !NeedsConversion(frame)) {
+    sink_->OnFrame(frame);
+    return;
+  }
+  if (frames_in_flight_.load(std::memory_order_relaxed) >=
+      max_frames_in_flight_) {
+    RTC_LOG(LS_VERBOSE) << "Dropping frame, " << max_frames_in_flight_
+                        << " frames already being preprocessed.";
+    encoder_stats_observer_->OnFrameDropped(
+        VideoStreamEncoderObserver::DropReason::kEncoderQueue);
+    return;
+  }
+  frames_in_flight_.fetch_add(1, std::memory_order_relaxed);
+  queue_->PostTask([this, frame] {
+    ConvertAndForward(frame);
+    frames_in_flight_.fetch_sub(1, std::memory_order_release);
+  });
+}
+
+void FramePreprocessor::OnDiscardedFrame() {
+  sink_->OnDiscardedFrame();
+}
+
+void FramePreprocessor::OnConstraintsChanged(
+    const VideoTrackSourceConstraints& constraints) {
+  sink_->OnConstraintsChanged(constraints);
+}
+
+bool FramePreprocessor::NeedsConversion(const VideoFrame& frame) const {
+  if (frame.video_frame_buffer()->type() != VideoFrameBuffer::Type::kNative) {
+    return false;
+  }
+  MutexLock lock(&mutex_);
+  return convert_native_frames_;
+}
+
+void FramePreprocessor::ConvertAndForward(VideoFrame frame) const {
+  RTC_DCHECK_RUN_ON(queue_.get());
+  if (NeedsConversion(frame)) {
+    TRACE_EVENT0("webrtc", "FramePreprocessor::ConvertAndForward");
+    PixelFormats preferred_pixel_formats;
+    {
+      MutexLock lock(&mutex_);
+      preferred_pixel_formats = preferred_pixel_formats_;
+    }
+    rtc::scoped_refptr<VideoFrameBuffer> buffer = frame.video_frame_buffer();
+    rtc::scoped_refptr<VideoFrameBuffer> mapped =
+        buffer->GetMappedFrameBuffer(preferred_pixel_formats);
+    if (!mapped) {
+      mapped = buffer->ToI420();
+    }
+    if (mapped) {
+      RTC_DCHECK_EQ(mapped->width(), buffer->width());
+      RTC_DCHECK_EQ(mapped->height(), buffer->height());
+      frame.set_video_frame_buffer(std::move(mapped));
+    } else {
+      // Leave it to the encoder to deal with.
+      RTC_LOG(LS_WARNING) << "Failed to map native frame buffer.";
+    }
+  }
+  sink_->OnFrame(frame);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_FRAME_PREPROCESSOR_H_
+#define VIDEO_FRAME_PREPROCESSOR_H_
+
+#include <atomic>
+#include <memory>
+
+#include "absl/container/inlined_vector.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_frame_buffer.h"
+#include "api/video/video_sink_interface.h"
+#include "api/video_codecs/video_encoder.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+#include "video/video_stream_encoder_observer.h"
+
+namespace webrtc {
+
+// Sits in front of the frame cadence adapter and converts native frames which
+// the encoder can't encode directly into one of its preferred pixel formats,
+// on a dedicated task queue. The conversion of a frame then overlaps the
+// encoding of the previous one on the encoder queue, where the encoder would
+// otherwise map the frame itself right before encoding it.
+//
+// At most `max_frames_in_flight` frames are converted, or wait to be converted,
+// at a time. Further frames are dropped and reported with
+// DropReason::kEncoderQueue, before they reach the cadence adapter, so that
+// the input frame rate used by the frame dropper only counts frames which are
+// offered to the encoder. Other frames are forwarded as is, in order.
+class FramePreprocessor : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  using PixelFormats =
+      absl::InlinedVector<VideoFrameBuffer::Type, kMaxPreferredPixelFormats>;
+
+  FramePreprocessor(rtc::VideoSinkInterface<VideoFrame>* sink,
+                    VideoStreamEncoderObserver* encoder_stats_observer,
+                    std::unique_ptr<TaskQueueBase, TaskQueueDeleter> queue,
+                    int max_frames_in_flight);
+  // Waits for a running conversion to finish. Frames waiting to be converted
+  // are dropped.
+  ~FramePreprocessor() override;
+
+  // Called whenever the encoder info changes. Until then, all frames are
+  // forwarded as is.
+  void SetEncoderInfo(const VideoEncoder::EncoderInfo& info);
+
+  // Implements rtc::VideoSinkInterface.
+  void OnFrame(const VideoFrame& frame) override;
+  void OnDiscardedFrame() override;
+  void OnConstraintsChanged(
+      const VideoTrackSourceConstraints& constraints) override;
+
+ private:
+  bool NeedsConversion(const VideoFrame& frame) const;
+  void ConvertAndForward(VideoFrame frame) const;
+
+  rtc::VideoSinkInterface<VideoFrame>* const sink_;
+  VideoStreamEncoderObserver* const encoder_stats_observer_;
+  const int max_frames_in_flight_;
+  mutable Mutex mutex_;
+  bool convert_native_frames_ RTC_GUARDED_BY(mutex_) = false;
+  PixelFormats preferred_pixel_formats_ RTC_GUARDED_BY(mutex_);
+  // Decremented after the frame has been forwarded, so that frames which don't
+  // need conversion can be forwarded directly from OnFrame once it's zero.
+  std::atomic<int> frames_in_flight_{0};
+  // Destroyed first, so that no task touches the other members afterwards.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> queue_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_FRAME_PREPROCESSOR_H_
@@ -0,0 +1,161 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/frame_preprocessor.h"
+
+#include <memory>
+
+#include "api/task_queue/task_queue_factory.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame.h"
+#include "call/adaptation/test/fake_frame_rate_provider.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/mappable_native_buffer.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::InSequence;
+using ::testing::Mock;
+using ::testing::NiceMock;
+using ::testing::Pointee;
+using ::testing::Property;
+
+constexpr int kWidth = 320;
+constexpr int kHeight = 180;
+
+class MockVideoSink : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  MOCK_METHOD(void, OnFrame, (const VideoFrame&), (override));
+  MOCK_METHOD(void, OnDiscardedFrame, (), (override));
+};
+
+VideoFrame CreateNativeFrame(int64_t ntp_time_ms) {
+  return test::CreateMappableNativeFrame(
+      ntp_time_ms, VideoFrameBuffer::Type::kNV12, kWidth, kHeight);
+}
+
+VideoFrame CreateI420Frame(int64_t ntp_time_ms) {
+  VideoFrame frame = VideoFrame::Builder()
+                         .set_video_frame_buffer(
+                             I420Buffer::Create(kWidth, kHeight))
+                         .build();
+  frame.set_ntp_time_ms(ntp_time_ms);
+  return frame;
+}
+
+VideoEncoder::EncoderInfo EncoderInfo(bool supports_native_handle) {
+  VideoEncoder::EncoderInfo info;
+  info.supports_native_handle = supports_native_handle;
+  info.preferred_pixel_formats = {VideoFrameBuffer::Type::kNV12};
+  return info;
+}
+
+auto BufferType(VideoFrameBuffer::Type type) {
+  return Property(&VideoFrame::video_frame_buffer,
+                  Pointee(Property(&VideoFrameBuffer::type, type)));
+}
+
+auto NtpTime(int64_t ntp_time_ms) {
+  return Property(&VideoFrame::ntp_time_ms, ntp_time_ms);
+}
+
+class FramePreprocessorTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<FramePreprocessor> CreatePreprocessor(
+      int max_frames_in_flight) {
+    return std::make_unique<FramePreprocessor>(
+        &sink_, &stats_observer_,
+        time_controller_.GetTaskQueueFactory()->CreateTaskQueue(
+            "Preprocessing", TaskQueueFactory::Priority::NORMAL),
+        max_frames_in_flight);
+  }
+
+  GlobalSimulatedTimeController time_controller_{Timestamp::Millis(1000)};
+  MockVideoSink sink_;
+  NiceMock<MockVideoStreamEncoderObserver> stats_observer_;
+};
+
+TEST_F(FramePreprocessorTest, ForwardsFramesDirectlyWithoutEncoderInfo) {
+  auto preprocessor = CreatePreprocessor(1);
+  EXPECT_CALL(sink_, OnFrame(BufferType(VideoFrameBuffer::Type::kNative)));
+  preprocessor->OnFrame(CreateNativeFrame(1));
+}
+
+TEST_F(FramePreprocessorTest, ForwardsFramesTheEncoderSupportsDirectly) {
+  auto preprocessor = CreatePreprocessor(1);
+  preprocessor->SetEncoderInfo(EncoderInfo(/*supports_native_handle=*/true));
+  EXPECT_CALL(sink_, OnFrame(BufferType(VideoFrameBuffer::Type::kNative)));
+  preprocessor->OnFrame(CreateNativeFrame(1));
+
+  preprocessor->SetEncoderInfo(EncoderInfo(/*supports_native_handle=*/false));
+  EXPECT_CALL(sink_, OnFrame(BufferType(VideoFrameBuffer::Type::kI420)));
+  preprocessor->OnFrame(CreateI420Frame(2));
+}
+
+TEST_F(FramePreprocessorTest, MapsNativeFramesOnQueue) {
+  auto preprocessor = CreatePreprocessor(1);
+  preprocessor->SetEncoderInfo(EncoderInfo(/*supports_native_handle=*/false));
+  EXPECT_CALL(sink_, OnFrame).Times(0);
+  VideoFrame frame = CreateNativeFrame(1);
+  preprocessor->OnFrame(frame);
+  Mock::VerifyAndClearExpectations(&sink_);
+
+  EXPECT_CALL(sink_, OnFrame(BufferType(VideoFrameBuffer::Type::kNV12)));
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  EXPECT_FALSE(
+      test::GetMappableNativeBufferFromVideoFrame(frame)->DidConvertToI420());
+}
+
+TEST_F(FramePreprocessorTest, KeepsFramesInOrder) {
+  auto preprocessor = CreatePreprocessor(2);
+  preprocessor->SetEncoderInfo(EncoderInfo(/*supports_native_handle=*/false));
+  preprocessor->OnFrame(CreateNativeFrame(1));
+  preprocessor->OnFrame(CreateI420Frame(2));
+
+  InSequence s;
+  EXPECT_CALL(sink_, OnFrame(NtpTime(1)));
+  EXPECT_CALL(sink_, OnFrame(NtpTime(2)));
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  Mock::VerifyAndClearExpectations(&sink_);
+
+  // Nothing in flight any more.
+  EXPECT_CALL(sink_, OnFrame(NtpTime(3)));
+  preprocessor->OnFrame(CreateI420Frame(3));
+}
+
+TEST_F(FramePreprocessorTest, DropsFramesAboveMaxInFlight) {
+  auto preprocessor = CreatePreprocessor(2);
+  preprocessor->SetEncoderInfo(EncoderInfo(/*supports_native_handle=*/false));
+  EXPECT_CALL(stats_observer_,
+              OnFrameDropped(
+                  VideoStreamEncoderObserver::DropReason::kEncoderQueue));
+  preprocessor->OnFrame(CreateNativeFrame(1));
+  preprocessor->OnFrame(CreateNativeFrame(2));
+  preprocessor->OnFrame(CreateNativeFrame(3));
+
+  EXPECT_CALL(sink_, OnFrame(NtpTime(1)));
+  EXPECT_CALL(sink_, OnFrame(NtpTime(2)));
+  EXPECT_CALL(sink_, OnFrame(NtpTime(3))).Times(0);
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+}
+
+TEST_F(FramePreprocessorTest, ForwardsDiscardedFrames) {
+  auto preprocessor = CreatePreprocessor(1);
+  EXPECT_CALL(sink_, OnDiscardedFrame);
+  preprocessor->OnDiscardedFrame();
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -24,6 +24,9 @@ namespace {
 // Time interval for logging stats.
 constexpr int64_t kStatsLogIntervalMs = 10000;
 constexpr TimeDelta kSyncInterval = TimeDelta::Millis(1000);
+// Interval until the delays of a new pair of streams have been aligned, so
+// that they are in sync soon after the required RTCP sender reports arrive.
+constexpr TimeDelta kAlignInterval = TimeDelta::Millis(100);
 
 bool UpdateMeasurements(StreamSynchronization::Measurements* stream,
                         const Syncable::Info& info) {
@@ -59,6 +62,7 @@ void RtpStreamsSynchronizer::ConfigureSync(Syncable* syncable_audio) {
 
   syncable_audio_ = syncable_audio;
   sync_.reset(nullptr);
+  aligned_ = false;
   if (!syncable_audio_) {
     repeating_task_.Stop();
     return;
@@ -71,9 +75,10 @@ void RtpStreamsSynchronizer::ConfigureSync(Syncable* syncable_audio) {
     return;
 
   repeating_task_ =
-      RepeatingTaskHandle::DelayedStart(task_queue_, kSyncInterval, [this]() {
+      RepeatingTaskHandle::DelayedStart(task_queue_, kAlignInterval, [this]() {
+        RTC_DCHECK_RUN_ON(&main_checker_);
         UpdateDelay();
-        return kSyncInterval;
+        return aligned_ ? kSyncInterval : kAlignInterval;
       });
 }
 
@@ -140,9 +145,19 @@ void RtpStreamsSynchronizer::UpdateDelay() {
   int target_audio_delay_ms = 0;
   int target_video_delay_ms = video_info->current_delay_ms;
   // Calculate the necessary extra audio delay and desired total video
-  // delay to get the streams in sync.
-  if (!sync_->ComputeDelays(relative_delay_ms, audio_info->current_delay_ms,
-                            &target_audio_delay_ms, &target_video_delay_ms)) {
+  // delay to get the streams in sync. The first time, the whole difference is
+  // corrected at once, after that in filtered steps.
+  const bool align = !aligned_;
+  aligned_ = true;
+  const bool changed =
+      align ? sync_->AlignDelays(relative_delay_ms,
+                                 audio_info->current_delay_ms,
+                                 &target_audio_delay_ms, &target_video_delay_ms)
+            : sync_->ComputeDelays(relative_delay_ms,
+                                   audio_info->current_delay_ms,
+                                   &target_audio_delay_ms,
+                                   &target_video_delay_ms);
+  if (!changed) {
     return;
   }
 
@@ -65,6 +65,8 @@ class RtpStreamsSynchronizer {
       RTC_GUARDED_BY(main_checker_);
   StreamSynchronization::Measurements video_measurement_
       RTC_GUARDED_BY(main_checker_);
+  // Set once the delays have been aligned in one step after ConfigureSync().
+  bool aligned_ RTC_GUARDED_BY(main_checker_) = false;
   RepeatingTaskHandle repeating_task_ RTC_GUARDED_BY(main_checker_);
   int64_t last_stats_log_ms_ RTC_GUARDED_BY(&main_checker_);
 };
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/rtp_video_layer_forwarder.h"
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "absl/types/variant.h"
+#include "modules/rtp_rtcp/source/rtp_dependency_descriptor_extension.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer_vp8.h"
+#include "modules/rtp_rtcp/source/video_rtp_depacketizer_vp9.h"
+#include "modules/video_coding/codecs/interface/common_constants.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+RtpVideoLayerForwarder::RtpVideoLayerForwarder(const Config& config,
+                                               RtpPacketSender* packet_sender)
+    : config_(config),
+      packet_sender_(packet_sender),
+      max_spatial_layer_(std::numeric_limits<int>::max()),
+      max_temporal_layer_(std::numeric_limits<int>::max()) {
+  RTC_DCHECK(packet_sender_);
+  sequence_checker_.Detach();
+}
+
+RtpVideoLayerForwarder::~RtpVideoLayerForwarder() = default;
+
+void RtpVideoLayerForwarder::SetMaxLayers(int max_spatial_layer,
+                                          int max_temporal_layer) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  RTC_DCHECK_GE(max_spatial_layer, 0);
+  RTC_DCHECK_GE(max_temporal_layer, 0);
+  max_spatial_layer_ = max_spatial_layer;
+  max_temporal_layer_ = max_temporal_layer;
+}
+
+int64_t RtpVideoLayerForwarder::num_forwarded_packets() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return num_forwarded_packets_;
+}
+
+int64_t RtpVideoLayerForwarder::num_dropped_packets() const {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  return num_dropped_packets_;
+}
+
+void RtpVideoLayerForwarder::OnRtpPacket(const RtpPacketReceived& packet) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  int64_t sequence_number =
+      sequence_number_unwrapper_.Unwrap(packet.SequenceNumber());
+  if (last_dropped_ && sequence_number <= *last_dropped_) {
+    // Leaves a gap in the forwarded stream, seen as loss by the receiver.
+    ++num_dropped_packets_;
+    return;
+  }
+
+  auto codec = config_.payload_types.find(packet.PayloadType());
+  if (codec == config_.payload_types.end()) {
+    Drop(sequence_number);
+    return;
+  }
+  Layer layer;
+  if (!ParseLayer(packet, codec->second, layer) ||
+      layer.spatial > max_spatial_layer_ ||
+      layer.temporal > max_temporal_layer_) {
+    Drop(sequence_number);
+    return;
+  }
+
+  auto forwarded = std::make_unique<RtpPacketToSend>(/*extensions=*/nullptr);
+  // Shares the received buffer until the header is rewritten below.
+  static_cast<RtpPacket&>(*forwarded) = packet;
+  forwarded->SetSsrc(config_.ssrc);
+  forwarded->SetSequenceNumber(
+      static_cast<uint16_t>(sequence_number - sequence_number_offset_));
+  // The marker bit ends the highest spatial layer of a picture, which moves
+  // down when the layers above are dropped.
+  if (layer.spatial == max_spatial_layer_ && layer.end_of_frame) {
+    forwarded->SetMarker(true);
+  }
+  forwarded->set_packet_type(RtpPacketMediaType::kVideo);
+  forwarded->set_allow_retransmission(true);
+  ++num_forwarded_packets_;
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  packets.push_back(std::move(forwarded));
+  packet_sender_->EnqueuePackets(std::move(packets));
+}
+
+bool RtpVideoLayerForwarder::ParseLayer(const RtpPacketReceived& packet,
+                                        VideoCodecType codec,
+                                        Layer& layer) {
+  if (packet.HasExtension<RtpDependencyDescriptorExtension>()) {
+    DependencyDescriptor descriptor;
+    if (!packet.GetExtension<RtpDependencyDescriptorExtension>(
+            video_structure_.get(), &descriptor)) {
+      // Either malformed, or sent with a structure not received yet.
+      return false;
+    }
+    if (descriptor.attached_structure != nullptr) {
+      video_structure_ = std::move(descriptor.attached_structure);
+    }
+    layer.spatial = descriptor.frame_dependencies.spatial_id;
+    layer.temporal = descriptor.frame_dependencies.temporal_id;
+    layer.end_of_frame = descriptor.last_packet_in_frame;
+    return true;
+  }
+
+  RTPVideoHeader video_header;
+  switch (codec) {
+    case kVideoCodecVP8: {
+      if (VideoRtpDepacketizerVp8::ParseRtpPayload(packet.payload(),
+                                                   &video_header) == 0) {
+        return false;
+      }
+      const auto& vp8 =
+          absl::get<RTPVideoHeaderVP8>(video_header.video_type_header);
+      if (vp8.temporalIdx != kNoTemporalIdx) {
+        layer.temporal = vp8.temporalIdx;
+      }
+      return true;
+    }
+    case kVideoCodecVP9: {
+      if (VideoRtpDepacketizerVp9::ParseRtpPayload(packet.payload(),
+                                                   &video_header) == 0) {
+        return false;
+      }
+      const auto& vp9 =
+          absl::get<RTPVideoHeaderVP9>(video_header.video_type_header);
+      if (vp9.spatial_idx != kNoSpatialIdx) {
+        layer.spatial = vp9.spatial_idx;
+      }
+      if (vp9.temporal_idx != kNoTemporalIdx) {
+        layer.temporal = vp9.temporal_idx;
+      }
+      layer.end_of_frame = vp9.end_of_frame;
+      return true;
+    }
+    default:
+      // No layer information, forward everything.
+      return true;
+  }
+}
+
+void RtpVideoLayerForwarder::Drop(int64_t sequence_number) {
+  ++num_dropped_packets_;
+  ++sequence_number_offset_;
+  last_dropped_ = sequence_number;
+}
+
+}  // namespace webrtc
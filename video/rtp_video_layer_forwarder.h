@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_RTP_VIDEO_LAYER_FORWARDER_H_
+#define VIDEO_RTP_VIDEO_LAYER_FORWARDER_H_
+
+#include <stdint.h>
+
+#include <memory>
+
+#include "absl/types/optional.h"
+#include "api/sequence_checker.h"
+#include "api/transport/rtp/dependency_descriptor.h"
+#include "api/video/video_codec_type.h"
+#include "call/rtp_packet_sink_interface.h"
+#include "modules/rtp_rtcp/include/rtp_packet_sender.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/containers/flat_map.h"
+#include "rtc_base/numerics/sequence_number_unwrapper.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Forwards the packets of a received video stream, for selective forwarding
+// units that relay layers of streams without decoding them. Unlike
+// RtpVideoStreamReceiver2, which depacketizes, assembles frames and finds
+// their references, only the dependency descriptor or the VP8/VP9 payload
+// descriptor of each packet is parsed, to drop the layers above the
+// configured limits. Forwarded packets get the SSRC of the forwarded stream
+// and continuous sequence numbers, and are handed to `packet_sender`,
+// normally the pacer of the sending side.
+//
+// Codecs without layer information in the payload descriptor, and without a
+// dependency descriptor, are forwarded in full. Changes of the layer limits
+// take effect immediately; callers should change them at key frames or
+// layer switch points. All methods must be called on the same sequence.
+class RtpVideoLayerForwarder : public RtpPacketSinkInterface {
+ public:
+  struct Config {
+    // SSRC of the forwarded packets.
+    uint32_t ssrc = 0;
+    // Codec of each payload type to forward. Packets of other payload types
+    // are dropped.
+    flat_map<int, VideoCodecType> payload_types;
+  };
+
+  RtpVideoLayerForwarder(const Config& config, RtpPacketSender* packet_sender);
+  ~RtpVideoLayerForwarder() override;
+
+  // Forwards spatial layers up to and including `max_spatial_layer`, and
+  // temporal layers up to and including `max_temporal_layer`. All layers are
+  // forwarded by default.
+  void SetMaxLayers(int max_spatial_layer, int max_temporal_layer);
+
+  // RtpPacketSinkInterface.
+  void OnRtpPacket(const RtpPacketReceived& packet) override;
+
+  int64_t num_forwarded_packets() const;
+  int64_t num_dropped_packets() const;
+
+ private:
+  struct Layer {
+    int spatial = 0;
+    int temporal = 0;
+    // True if the packet is the last one of its layer frame.
+    bool end_of_frame = false;
+  };
+
+  // Returns false if the packet should be dropped because its layer
+  // information is missing or malformed.
+  bool ParseLayer(const RtpPacketReceived& packet,
+                  VideoCodecType codec,
+                  Layer& layer);
+  void Drop(int64_t sequence_number);
+
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+  const Config config_;
+  RtpPacketSender* const packet_sender_;
+
+  int max_spatial_layer_ RTC_GUARDED_BY(sequence_checker_);
+  int max_temporal_layer_ RTC_GUARDED_BY(sequence_checker_);
+  // Latest dependency structure, needed to parse dependency descriptors.
+  std::unique_ptr<FrameDependencyStructure> video_structure_
+      RTC_GUARDED_BY(sequence_checker_);
+
+  SeqNumUnwrapper<uint16_t> sequence_number_unwrapper_
+      RTC_GUARDED_BY(sequence_checker_);
+  // Number of sequence numbers removed from the forwarded stream.
+  int64_t sequence_number_offset_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  // Newest dropped sequence number. Older packets arriving late are dropped
+  // as well, since their place in the forwarded stream is no longer known.
+  absl::optional<int64_t> last_dropped_ RTC_GUARDED_BY(sequence_checker_);
+
+  int64_t num_forwarded_packets_ RTC_GUARDED_BY(sequence_checker_) = 0;
+  int64_t num_dropped_packets_ RTC_GUARDED_BY(sequence_checker_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_RTP_VIDEO_LAYER_FORWARDER_H_
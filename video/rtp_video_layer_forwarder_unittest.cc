@@ -0,0 +1,174 @@
+/*
+ *  Copyright (c) 2024 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/rtp_video_layer_forwarder.h"
+
+#include <string.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/array_view.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr uint32_t kSourceSsrc = 1111;
+constexpr uint32_t kForwardedSsrc = 2222;
+constexpr int kVp8PayloadType = 96;
+constexpr int kVp9PayloadType = 98;
+
+class FakePacketSender : public RtpPacketSender {
+ public:
+  void EnqueuePackets(
+      std::vector<std::unique_ptr<RtpPacketToSend>> packets) override {
+    for (auto& packet : packets) {
+      packets_.push_back(std::move(packet));
+    }
+  }
+
+  std::vector<uint16_t> SequenceNumbers() const {
+    std::vector<uint16_t> sequence_numbers;
+    for (const auto& packet : packets_) {
+      sequence_numbers.push_back(packet->SequenceNumber());
+    }
+    return sequence_numbers;
+  }
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets_;
+};
+
+RtpPacketReceived CreatePacket(int payload_type,
+                               uint16_t sequence_number,
+                               bool marker,
+                               rtc::ArrayView<const uint8_t> payload) {
+  RtpPacketReceived packet;
+  packet.SetPayloadType(payload_type);
+  packet.SetSequenceNumber(sequence_number);
+  packet.SetTimestamp(90000);
+  packet.SetSsrc(kSourceSsrc);
+  packet.SetMarker(marker);
+  uint8_t* data = packet.AllocatePayload(payload.size());
+  memcpy(data, payload.data(), payload.size());
+  return packet;
+}
+
+// VP8 payload descriptor with a temporal layer index, and one byte of a delta
+// frame.
+RtpPacketReceived CreateVp8Packet(uint16_t sequence_number, int temporal_idx) {
+  const uint8_t kPayload[] = {0x90, 0x20,
+                              static_cast<uint8_t>(temporal_idx << 6), 0x01};
+  return CreatePacket(kVp8PayloadType, sequence_number, /*marker=*/true,
+                      kPayload);
+}
+
+// Non-flexible mode VP9 payload descriptor of a single packet layer frame,
+// and one payload byte.
+RtpPacketReceived CreateVp9Packet(uint16_t sequence_number,
+                                  int spatial_idx,
+                                  bool marker) {
+  const uint8_t kPayload[] = {0x2c, static_cast<uint8_t>(spatial_idx << 1),
+                              0x00, 0x00};
+  return CreatePacket(kVp9PayloadType, sequence_number, marker, kPayload);
+}
+
+RtpVideoLayerForwarder::Config CreateConfig() {
+  RtpVideoLayerForwarder::Config config;
+  config.ssrc = kForwardedSsrc;
+  config.payload_types[kVp8PayloadType] = kVideoCodecVP8;
+  config.payload_types[kVp9PayloadType] = kVideoCodecVP9;
+  return config;
+}
+
+TEST(RtpVideoLayerForwarderTest, ForwardsAllLayersByDefault) {
+  FakePacketSender sender;
+  RtpVideoLayerForwarder forwarder(CreateConfig(), &sender);
+
+  forwarder.OnRtpPacket(CreateVp8Packet(100, 0));
+  forwarder.OnRtpPacket(CreateVp8Packet(101, 2));
+  forwarder.OnRtpPacket(CreateVp8Packet(102, 1));
+
+  ASSERT_EQ(sender.packets_.size(), 3u);
+  EXPECT_THAT(sender.SequenceNumbers(), ElementsAre(100, 101, 102));
+  for (const auto& packet : sender.packets_) {
+    EXPECT_EQ(packet->Ssrc(), kForwardedSsrc);
+    EXPECT_EQ(packet->Timestamp(), 90000u);
+    EXPECT_EQ(packet->packet_type(), RtpPacketMediaType::kVideo);
+    EXPECT_EQ(packet->payload().size(), 4u);
+  }
+}
+
+TEST(RtpVideoLayerForwarderTest, DropsTemporalLayersWithContinuousSequence) {
+  FakePacketSender sender;
+  RtpVideoLayerForwarder forwarder(CreateConfig(), &sender);
+  forwarder.SetMaxLayers(/*max_spatial_layer=*/0, /*max_temporal_layer=*/1);
+
+  // L1T3 pattern 0 2 1 2 0, across a sequence number wrap.
+  const int kTemporalIdx[] = {0, 2, 1, 2, 0};
+  for (int i = 0; i < 5; ++i) {
+    forwarder.OnRtpPacket(CreateVp8Packet(0xfffe + i, kTemporalIdx[i]));
+  }
+
+  EXPECT_THAT(sender.SequenceNumbers(), ElementsAre(0xfffe, 0xffff, 0));
+  EXPECT_EQ(forwarder.num_forwarded_packets(), 3);
+  EXPECT_EQ(forwarder.num_dropped_packets(), 2);
+}
+
+TEST(RtpVideoLayerForwarderTest, MovesMarkerToHighestForwardedSpatialLayer) {
+  FakePacketSender sender;
+  RtpVideoLayerForwarder forwarder(CreateConfig(), &sender);
+  forwarder.SetMaxLayers(/*max_spatial_layer=*/1, /*max_temporal_layer=*/0);
+
+  forwarder.OnRtpPacket(CreateVp9Packet(10, 0, /*marker=*/false));
+  forwarder.OnRtpPacket(CreateVp9Packet(11, 1, /*marker=*/false));
+  forwarder.OnRtpPacket(CreateVp9Packet(12, 2, /*marker=*/true));
+  forwarder.OnRtpPacket(CreateVp9Packet(13, 0, /*marker=*/false));
+
+  ASSERT_EQ(sender.packets_.size(), 3u);
+  EXPECT_THAT(sender.SequenceNumbers(), ElementsAre(10, 11, 12));
+  EXPECT_FALSE(sender.packets_[0]->Marker());
+  EXPECT_TRUE(sender.packets_[1]->Marker());
+  EXPECT_FALSE(sender.packets_[2]->Marker());
+}
+
+TEST(RtpVideoLayerForwarderTest, DropsUnknownPayloadTypes) {
+  FakePacketSender sender;
+  RtpVideoLayerForwarder forwarder(CreateConfig(), &sender);
+  const uint8_t kPayload[] = {0x00};
+
+  forwarder.OnRtpPacket(CreateVp8Packet(1, 0));
+  forwarder.OnRtpPacket(CreatePacket(100, 2, /*marker=*/false, kPayload));
+  forwarder.OnRtpPacket(CreateVp8Packet(3, 0));
+
+  EXPECT_THAT(sender.SequenceNumbers(), ElementsAre(1, 2));
+}
+
+TEST(RtpVideoLayerForwarderTest, DropsReorderedPacketsOlderThanDroppedOne) {
+  FakePacketSender sender;
+  RtpVideoLayerForwarder forwarder(CreateConfig(), &sender);
+  forwarder.SetMaxLayers(/*max_spatial_layer=*/0, /*max_temporal_layer=*/0);
+
+  forwarder.OnRtpPacket(CreateVp8Packet(1, 0));
+  forwarder.OnRtpPacket(CreateVp8Packet(3, 1));
+  forwarder.OnRtpPacket(CreateVp8Packet(2, 0));
+  forwarder.OnRtpPacket(CreateVp8Packet(4, 0));
+
+  EXPECT_THAT(sender.SequenceNumbers(), ElementsAre(1, 3));
+  EXPECT_EQ(forwarder.num_dropped_packets(), 2);
+}
+
+}  // namespace
+}  // namespace webrtc
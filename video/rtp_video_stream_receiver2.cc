@@ -360,6 +360,12 @@ void RtpVideoStreamReceiver2::AddReceiveCodec(
       field_trials_.IsEnabled("WebRTC-SpsPpsIdrIsH264Keyframe")) {
     packet_buffer_.ForceSpsPpsIdrIsH264Keyframe();
   }
+#ifdef RTC_ENABLE_H265
+  if (video_codec == kVideoCodecH265 && !raw_payload && !h265_packet_buffer_) {
+    h265_packet_buffer_ = std::make_unique<H265PacketBuffer>(
+        /*irap_only_keyframes_allowed=*/true);
+  }
+#endif
   payload_type_map_.emplace(
       payload_type, raw_payload ? std::make_unique<VideoRtpDepacketizerRaw>()
                                 : CreateVideoRtpDepacketizer(video_codec));
@@ -702,6 +708,12 @@ void RtpVideoStreamReceiver2::OnReceivedPayloadData(
 
   rtcp_feedback_buffer_.SendBufferedRtcpFeedback();
   frame_counter_.Add(packet->timestamp);
+#ifdef RTC_ENABLE_H265
+  if (h265_packet_buffer_ && packet->codec() == kVideoCodecH265) {
+    OnInsertedPacket(h265_packet_buffer_->InsertPacket(std::move(packet)));
+    return;
+  }
+#endif
   OnInsertedPacket(packet_buffer_.InsertPacket(std::move(packet)));
 }
 
@@ -1128,6 +1140,11 @@ void RtpVideoStreamReceiver2::NotifyReceiverOfEmptyPacket(uint16_t seq_num) {
   OnCompleteFrames(reference_finder_->PaddingReceived(seq_num));
 
   OnInsertedPacket(packet_buffer_.InsertPadding(seq_num));
+#ifdef RTC_ENABLE_H265
+  if (h265_packet_buffer_) {
+    OnInsertedPacket(h265_packet_buffer_->InsertPadding(seq_num));
+  }
+#endif
   if (nack_module_) {
     nack_module_->OnReceivedPacket(seq_num, /* is_keyframe = */ false,
                                    /* is _recovered = */ false);
@@ -50,6 +50,10 @@
 #include "video/buffered_frame_decryptor.h"
 #include "video/unique_timestamp_counter.h"
 
+#ifdef RTC_ENABLE_H265
+#include "modules/video_coding/h265_packet_buffer.h"
+#endif
+
 namespace webrtc {
 
 class NackRequester;
@@ -357,6 +361,12 @@ class RtpVideoStreamReceiver2 : public LossNotificationSender,
 
   video_coding::PacketBuffer packet_buffer_
       RTC_GUARDED_BY(packet_sequence_checker_);
+#ifdef RTC_ENABLE_H265
+  // Assembles the frames of H265 payload types, created when the first one is
+  // added.
+  std::unique_ptr<H265PacketBuffer> h265_packet_buffer_
+      RTC_GUARDED_BY(packet_sequence_checker_);
+#endif
   UniqueTimestampCounter frame_counter_
       RTC_GUARDED_BY(packet_sequence_checker_);
   SeqNumUnwrapper<uint16_t> frame_id_unwrapper_
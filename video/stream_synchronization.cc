@@ -121,6 +121,59 @@ bool StreamSynchronization::ComputeDelays(int relative_delay_ms,
     }
   }
 
+  UpdateTargetDelays(total_audio_delay_target_ms, total_video_delay_target_ms);
+  return true;
+}
+
+bool StreamSynchronization::AlignDelays(int relative_delay_ms,
+                                        int current_audio_delay_ms,
+                                        int* total_audio_delay_target_ms,
+                                        int* total_video_delay_target_ms) {
+  int current_video_delay_ms = *total_video_delay_target_ms;
+  int diff_ms =
+      current_video_delay_ms - current_audio_delay_ms + relative_delay_ms;
+
+  // Later calls to ComputeDelays() filter from the aligned state.
+  avg_diff_ms_ = 0;
+  if (abs(diff_ms) < kMinDeltaMs) {
+    return false;
+  }
+  diff_ms = std::min(std::max(diff_ms, -kMaxDeltaDelayMs), kMaxDeltaDelayMs);
+
+  RTC_LOG(LS_VERBOSE) << "Aligning audio stream " << audio_stream_id_
+                      << " and video stream " << video_stream_id_
+                      << ", diff: " << diff_ms;
+
+  // Same as in ComputeDelays(), extra delay on one stream is removed before
+  // delay is added to the other. Added delay is on top of the current delay of
+  // the stream, which may already be larger than its extra delay.
+  if (diff_ms > 0) {
+    if (video_delay_.extra_ms > base_target_delay_ms_) {
+      video_delay_.extra_ms -= diff_ms;
+      audio_delay_.extra_ms = base_target_delay_ms_;
+    } else {
+      audio_delay_.extra_ms =
+          std::max(audio_delay_.extra_ms, current_audio_delay_ms) + diff_ms;
+      video_delay_.extra_ms = base_target_delay_ms_;
+    }
+  } else {
+    if (audio_delay_.extra_ms > base_target_delay_ms_) {
+      audio_delay_.extra_ms += diff_ms;
+      video_delay_.extra_ms = base_target_delay_ms_;
+    } else {
+      video_delay_.extra_ms =
+          std::max(video_delay_.extra_ms, current_video_delay_ms) - diff_ms;
+      audio_delay_.extra_ms = base_target_delay_ms_;
+    }
+  }
+
+  UpdateTargetDelays(total_audio_delay_target_ms, total_video_delay_target_ms);
+  return true;
+}
+
+void StreamSynchronization::UpdateTargetDelays(
+    int* total_audio_delay_target_ms,
+    int* total_video_delay_target_ms) {
   // Make sure that video is never below our target.
   video_delay_.extra_ms =
       std::max(video_delay_.extra_ms, base_target_delay_ms_);
@@ -167,7 +220,6 @@ bool StreamSynchronization::ComputeDelays(int relative_delay_ms,
 
   *total_video_delay_target_ms = new_video_delay_ms;
   *total_audio_delay_target_ms = new_audio_delay_ms;
-  return true;
 }
 
 void StreamSynchronization::SetTargetBufferingDelay(int target_delay_ms) {
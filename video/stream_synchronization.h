@@ -33,6 +33,16 @@ class StreamSynchronization {
                      int* total_audio_delay_target_ms,
                      int* total_video_delay_target_ms);
 
+  // Like ComputeDelays(), but corrects the whole difference between the streams
+  // at once, rather than in filtered steps. Meant for the first measurement of
+  // a newly paired audio and video stream, so that they are in sync within a
+  // few frames instead of after several seconds of steps. Returns false if no
+  // change is needed.
+  bool AlignDelays(int relative_delay_ms,
+                   int current_audio_delay_ms,
+                   int* total_audio_delay_target_ms,
+                   int* total_video_delay_target_ms);
+
   // On success `relative_delay_ms` contains the number of milliseconds later
   // video is rendered relative audio. If audio is played back later than video
   // `relative_delay_ms` will be negative.
@@ -59,6 +69,10 @@ class StreamSynchronization {
     int last_ms = 0;
   };
 
+  // Derives the total target delays from the extra delays.
+  void UpdateTargetDelays(int* total_audio_delay_target_ms,
+                          int* total_video_delay_target_ms);
+
   const uint32_t video_stream_id_;
   const uint32_t audio_stream_id_;
   SynchronizationDelays audio_delay_;
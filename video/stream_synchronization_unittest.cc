@@ -529,4 +529,64 @@ TEST_F(StreamSynchronizationTest,
   BothDelayedVideoLaterTest(kBaseTargetDelayMs);
 }
 
+TEST_F(StreamSynchronizationTest, AlignDelaysDelaysVideoAtOnce) {
+  // Audio is received 200 ms later than video.
+  int total_audio_delay_ms = 0;
+  int total_video_delay_ms = 50;
+  EXPECT_TRUE(sync_.AlignDelays(/*relative_delay_ms=*/-200,
+                                /*current_audio_delay_ms=*/50,
+                                &total_audio_delay_ms, &total_video_delay_ms));
+  EXPECT_EQ(0, total_audio_delay_ms);
+  EXPECT_EQ(250, total_video_delay_ms);
+
+  // Once the video delay has been applied, the streams are in sync.
+  EXPECT_FALSE(sync_.ComputeDelays(/*relative_delay_ms=*/-200,
+                                   /*current_audio_delay_ms=*/50,
+                                   &total_audio_delay_ms,
+                                   &total_video_delay_ms));
+}
+
+TEST_F(StreamSynchronizationTest, AlignDelaysDelaysAudioAtOnce) {
+  // Video is received 200 ms later than audio.
+  int total_audio_delay_ms = 0;
+  int total_video_delay_ms = 50;
+  EXPECT_TRUE(sync_.AlignDelays(/*relative_delay_ms=*/200,
+                                /*current_audio_delay_ms=*/80,
+                                &total_audio_delay_ms, &total_video_delay_ms));
+  EXPECT_EQ(250, total_audio_delay_ms);
+  EXPECT_EQ(0, total_video_delay_ms);
+
+  total_video_delay_ms = 50;
+  EXPECT_FALSE(sync_.ComputeDelays(/*relative_delay_ms=*/200,
+                                   /*current_audio_delay_ms=*/250,
+                                   &total_audio_delay_ms,
+                                   &total_video_delay_ms));
+}
+
+TEST_F(StreamSynchronizationTest, AlignDelaysRemovesExtraDelayFirst) {
+  int total_audio_delay_ms = 0;
+  int total_video_delay_ms = 50;
+  EXPECT_TRUE(sync_.AlignDelays(/*relative_delay_ms=*/-200,
+                                /*current_audio_delay_ms=*/50,
+                                &total_audio_delay_ms, &total_video_delay_ms));
+  EXPECT_EQ(250, total_video_delay_ms);
+
+  // Audio is now received 100 ms earlier than before, so most of the extra
+  // video delay is removed rather than audio delayed.
+  EXPECT_TRUE(sync_.AlignDelays(/*relative_delay_ms=*/-100,
+                                /*current_audio_delay_ms=*/50,
+                                &total_audio_delay_ms, &total_video_delay_ms));
+  EXPECT_EQ(0, total_audio_delay_ms);
+  EXPECT_EQ(150, total_video_delay_ms);
+}
+
+TEST_F(StreamSynchronizationTest, AlignDelaysIgnoresSmallDifference) {
+  int total_audio_delay_ms = 0;
+  int total_video_delay_ms = 50;
+  EXPECT_FALSE(sync_.AlignDelays(/*relative_delay_ms=*/10,
+                                 /*current_audio_delay_ms=*/50,
+                                 &total_audio_delay_ms,
+                                 &total_video_delay_ms));
+}
+
 }  // namespace webrtc
@@ -51,6 +51,7 @@
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/clock.h"
 #include "video/call_stats2.h"
+#include "video/decoder_thread_budget.h"
 #include "video/frame_dumping_decoder.h"
 #include "video/receive_statistics_proxy.h"
 #include "video/render/incoming_video_stream.h"
@@ -253,6 +254,9 @@ VideoReceiveStream2::VideoReceiveStream2(
       clock_, call_->worker_thread(), timing_.get(), &stats_proxy_, this,
       max_wait_for_keyframe_, max_wait_for_frame_, std::move(scheduler),
       call_->trials());
+  if (config_.decode_ahead_frames > 0) {
+    buffer_->SetDecodeAheadFrames(config_.decode_ahead_frames);
+  }
 
   if (!config_.rtp.rtx_associated_payload_types.empty()) {
     rtx_receive_stream_ = std::make_unique<RtxReceiveStream>(
@@ -351,13 +355,19 @@ void VideoReceiveStream2::Start() {
     renderer = this;
   }
 
+  int num_decoder_threads =
+      std::min(num_cpu_cores_, DecoderThreadBudget::Default().AddStream());
+  if (config_.max_decoder_threads) {
+    num_decoder_threads = std::max(
+        1, std::min(num_decoder_threads, *config_.max_decoder_threads));
+  }
   for (const Decoder& decoder : config_.decoders) {
     VideoDecoder::Settings settings;
     settings.set_codec_type(
         PayloadStringToCodecType(decoder.video_format.name));
     settings.set_max_render_resolution(
         InitialDecoderResolution(call_->trials()));
-    settings.set_number_of_cores(num_cpu_cores_);
+    settings.set_number_of_cores(num_decoder_threads);
 
     const bool raw_payload =
         config_.rtp.raw_payload_types.count(decoder.payload_type) > 0;
@@ -426,6 +436,7 @@ void VideoReceiveStream2::Stop() {
     done.Wait(rtc::Event::kForever);
 
     decoder_running_ = false;
+    DecoderThreadBudget::Default().RemoveStream();
     stats_proxy_.DecoderThreadStopped();
 
     UpdateHistograms();
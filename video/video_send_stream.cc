@@ -114,18 +114,26 @@ std::unique_ptr<VideoStreamEncoder> CreateVideoStreamEncoder(
     VideoStreamEncoder::BitrateAllocationCallbackType
         bitrate_allocation_callback_type,
     const FieldTrialsView& field_trials,
+    Metronome* metronome,
     webrtc::VideoEncoderFactory::EncoderSelectorInterface* encoder_selector) {
   std::unique_ptr<TaskQueueBase, TaskQueueDeleter> encoder_queue =
       task_queue_factory->CreateTaskQueue("EncoderQueue",
                                           TaskQueueFactory::Priority::NORMAL);
   TaskQueueBase* encoder_queue_ptr = encoder_queue.get();
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> preprocessing_queue;
+  if (encoder_settings.max_preprocessed_frames_in_flight > 0) {
+    preprocessing_queue = task_queue_factory->CreateTaskQueue(
+        "EncoderPreprocessingQueue", TaskQueueFactory::Priority::NORMAL);
+  }
   return std::make_unique<VideoStreamEncoder>(
       clock, num_cpu_cores, stats_proxy, encoder_settings,
       std::make_unique<OveruseFrameDetector>(stats_proxy),
-      FrameCadenceAdapterInterface::Create(clock, encoder_queue_ptr,
-                                           field_trials),
+      FrameCadenceAdapterInterface::Create(
+          clock, encoder_queue_ptr, metronome,
+          /*worker_queue=*/metronome ? TaskQueueBase::Current() : nullptr,
+          field_trials),
       std::move(encoder_queue), bitrate_allocation_callback_type, field_trials,
-      encoder_selector);
+      encoder_selector, std::move(preprocessing_queue));
 }
 
 }  // namespace
@@ -147,7 +155,8 @@ VideoSendStream::VideoSendStream(
     const std::map<uint32_t, RtpState>& suspended_ssrcs,
     const std::map<uint32_t, RtpPayloadState>& suspended_payload_states,
     std::unique_ptr<FecController> fec_controller,
-    const FieldTrialsView& field_trials)
+    const FieldTrialsView& field_trials,
+    Metronome* metronome)
     : transport_(transport),
       stats_proxy_(clock, config, encoder_config.content_type, field_trials),
       send_packet_observer_(&stats_proxy_, send_delay_stats),
@@ -161,6 +170,7 @@ VideoSendStream::VideoSendStream(
           config_.encoder_settings,
           GetBitrateAllocationCallbackType(config_, field_trials),
           field_trials,
+          metronome,
           config_.encoder_selector)),
       encoder_feedback_(
           clock,
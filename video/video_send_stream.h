@@ -18,6 +18,7 @@
 
 #include "api/fec_controller.h"
 #include "api/field_trials_view.h"
+#include "api/metronome/metronome.h"
 #include "api/sequence_checker.h"
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "call/bitrate_allocator.h"
@@ -70,7 +71,8 @@ class VideoSendStream : public webrtc::VideoSendStream {
       const std::map<uint32_t, RtpState>& suspended_ssrcs,
       const std::map<uint32_t, RtpPayloadState>& suspended_payload_states,
       std::unique_ptr<FecController> fec_controller,
-      const FieldTrialsView& field_trials);
+      const FieldTrialsView& field_trials,
+      Metronome* metronome = nullptr);
 
   ~VideoSendStream() override;
 
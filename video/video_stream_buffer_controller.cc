@@ -132,6 +132,7 @@ void VideoStreamBufferController::Stop() {
   frame_decode_scheduler_->Stop();
   timeout_tracker_.Stop();
   decoder_ready_for_new_frame_ = false;
+  frames_queued_for_decode_ = 0;
 }
 
 void VideoStreamBufferController::SetProtectionMode(
@@ -140,6 +141,15 @@ void VideoStreamBufferController::SetProtectionMode(
   protection_mode_ = protection_mode;
 }
 
+void VideoStreamBufferController::SetDecodeAheadFrames(int max_frames) {
+  RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
+  decode_ahead_ = max_frames > 0;
+  max_frames_queued_for_decode_ = decode_ahead_ ? max_frames : 1;
+  if (decode_ahead_) {
+    frame_decode_scheduler_->CancelOutstanding();
+  }
+}
+
 void VideoStreamBufferController::Clear() {
   RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
   stats_proxy_->OnDroppedFrames(buffer_->CurrentSize());
@@ -191,6 +201,9 @@ void VideoStreamBufferController::StartNextDecode(bool keyframe_required) {
   if (keyframe_required_) {
     timeout_tracker_.SetWaitingForKeyframe();
   }
+  if (frames_queued_for_decode_ > 0) {
+    --frames_queued_for_decode_;
+  }
   decoder_ready_for_new_frame_ = true;
   MaybeScheduleFrameForRelease();
 }
@@ -272,7 +285,9 @@ void VideoStreamBufferController::OnFrameReady(
 
   timing_->SetLastDecodeScheduledTimestamp(now);
 
-  decoder_ready_for_new_frame_ = false;
+  ++frames_queued_for_decode_;
+  decoder_ready_for_new_frame_ =
+      frames_queued_for_decode_ < max_frames_queued_for_decode_;
   receiver_->OnEncodedFrame(std::move(frame));
 }
 
@@ -286,6 +301,8 @@ void VideoStreamBufferController::OnTimeout(TimeDelta delay) {
   if (!decoder_ready_for_new_frame_) {
     return;
   }
+  // Answered with StartNextDecode() like a released frame.
+  ++frames_queued_for_decode_;
   decoder_ready_for_new_frame_ = false;
   receiver_->OnDecodableFrameTimeout(delay);
 }
@@ -389,6 +406,27 @@ void VideoStreamBufferController::ForceKeyFrameReleaseImmediately()
   }
 }
 
+void VideoStreamBufferController::ReleaseDecodableFramesImmediately()
+    RTC_RUN_ON(&worker_sequence_checker_) {
+  RTC_DCHECK(decode_ahead_);
+  while (decoder_ready_for_new_frame_ &&
+         buffer_->DecodableTemporalUnitsInfo()) {
+    auto frames = buffer_->ExtractNextDecodableTemporalUnit();
+    if (frames.empty()) {
+      RTC_DCHECK_NOTREACHED()
+          << "Frame buffer should always return at least 1 frame.";
+      continue;
+    }
+    // Skip ahead to the next keyframe if one is required.
+    if (keyframe_required_ && !frames.front()->is_keyframe()) {
+      continue;
+    }
+    auto render_time = timing_->RenderTime(frames.front()->RtpTimestamp(),
+                                           clock_->CurrentTime());
+    OnFrameReady(std::move(frames), render_time);
+  }
+}
+
 void VideoStreamBufferController::MaybeScheduleFrameForRelease()
     RTC_RUN_ON(&worker_sequence_checker_) {
   auto decodable_tu_info = buffer_->DecodableTemporalUnitsInfo();
@@ -396,6 +434,10 @@ void VideoStreamBufferController::MaybeScheduleFrameForRelease()
     return;
   }
 
+  if (decode_ahead_) {
+    return ReleaseDecodableFramesImmediately();
+  }
+
   if (keyframe_required_) {
     return ForceKeyFrameReleaseImmediately();
   }
@@ -410,12 +452,15 @@ void VideoStreamBufferController::MaybeScheduleFrameForRelease()
   // Ensures the frame is scheduled for decode before the stream times out.
   // This is otherwise a race condition.
   max_wait = std::max(max_wait - TimeDelta::Millis(1), TimeDelta::Zero());
+  // Checked once, so that catching up on a backlog continues to the newest
+  // frame rather than stopping as soon as the queue is short enough again.
+  const bool too_many_frames_queued = IsTooManyFramesQueued();
   absl::optional<FrameDecodeTiming::FrameSchedule> schedule;
   while (decodable_tu_info) {
     schedule = decode_timing_.OnFrameBufferUpdated(
         decodable_tu_info->next_rtp_timestamp,
         decodable_tu_info->last_rtp_timestamp, max_wait,
-        IsTooManyFramesQueued());
+        too_many_frames_queued);
     if (schedule) {
       // Don't schedule if already waiting for the same frame.
       if (frame_decode_scheduler_->ScheduledRtpTimestamp() !=
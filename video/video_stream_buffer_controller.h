@@ -80,6 +80,12 @@ class VideoStreamBufferController {
 
   void Stop();
   void SetProtectionMode(VCMVideoProtection protection_mode);
+  // If positive, releases decodable frames right away, bypassing the frame
+  // decode scheduler and the frame dropping due to late render times, with up
+  // to `max_frames` released frames not yet followed by StartNextDecode().
+  // Otherwise, releases one frame at a time when it's due for decoding. Takes
+  // effect from the next StartNextDecode().
+  void SetDecodeAheadFrames(int max_frames);
   void Clear();
   absl::optional<int64_t> InsertFrame(std::unique_ptr<EncodedFrame> frame);
   void UpdateRtt(int64_t max_rtt_ms);
@@ -100,6 +106,8 @@ class VideoStreamBufferController {
   bool IsTooManyFramesQueued() const RTC_RUN_ON(&worker_sequence_checker_);
   void ForceKeyFrameReleaseImmediately() RTC_RUN_ON(&worker_sequence_checker_);
   void MaybeScheduleFrameForRelease() RTC_RUN_ON(&worker_sequence_checker_);
+  void ReleaseDecodableFramesImmediately()
+      RTC_RUN_ON(&worker_sequence_checker_);
 
   RTC_NO_UNIQUE_ADDRESS SequenceChecker worker_sequence_checker_;
   const FieldTrialsView& field_trials_;
@@ -132,6 +140,13 @@ class VideoStreamBufferController {
   // fast-forwarded when the decoder is slow or hangs.
   bool decoder_ready_for_new_frame_ RTC_GUARDED_BY(&worker_sequence_checker_) =
       false;
+  // Number of frames, or timeouts, passed to the receiver which haven't been
+  // answered with StartNextDecode() yet. The decoder is ready for a new frame
+  // while this is less than `max_frames_queued_for_decode_`.
+  int frames_queued_for_decode_ RTC_GUARDED_BY(&worker_sequence_checker_) = 0;
+  int max_frames_queued_for_decode_ RTC_GUARDED_BY(&worker_sequence_checker_) =
+      1;
+  bool decode_ahead_ RTC_GUARDED_BY(&worker_sequence_checker_) = false;
 
   // Maximum number of frames in the decode queue to allow pacing. If the
   // queue grows beyond the max limit, pacing will be disabled and frames will
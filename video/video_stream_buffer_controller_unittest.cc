@@ -40,6 +40,7 @@ using ::testing::_;
 using ::testing::AllOf;
 using ::testing::Contains;
 using ::testing::Each;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 using ::testing::IsEmpty;
 using ::testing::Matches;
@@ -876,9 +877,10 @@ TEST_P(LowLatencyVideoStreamBufferControllerTest, ZeroPlayoutDelayFullQueue) {
   }
 
   // The queue is at its max size for zero playout delay pacing, so the pacing
-  // should be ignored and the next frame should be decoded instantly.
+  // should be ignored and the backlog skipped, so that the newest frame is
+  // decoded instantly.
   StartNextDecode();
-  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(test::WithId(1)));
+  EXPECT_THAT(WaitForFrameOrTimeout(TimeDelta::Zero()), Frame(test::WithId(6)));
 }
 
 TEST_P(LowLatencyVideoStreamBufferControllerTest,
@@ -950,4 +952,79 @@ INSTANTIATE_TEST_SUITE_P(
             "WebRTC-IncomingTimestampOnMarkerBitOnly/Enabled/",
             "WebRTC-IncomingTimestampOnMarkerBitOnly/Disabled/")));
 
+class DecodeAheadVideoStreamBufferControllerTest
+    : public ::testing::Test,
+      public VideoStreamBufferControllerFixture {
+ public:
+  void OnEncodedFrame(std::unique_ptr<EncodedFrame> frame) override {
+    released_ids_.push_back(frame->Id());
+  }
+
+  void InsertFrames(int count) {
+    buffer_->InsertFrame(
+        test::FakeFrameBuilder().Id(0).Time(0).AsLast().Build());
+    for (int id = 1; id < count; ++id) {
+      buffer_->InsertFrame(test::FakeFrameBuilder()
+                               .Id(id)
+                               .Time(id * kFps30Rtp)
+                               .AsLast()
+                               .Refs({id - 1})
+                               .Build());
+    }
+  }
+
+ protected:
+  std::vector<int64_t> released_ids_;
+};
+
+TEST_P(DecodeAheadVideoStreamBufferControllerTest,
+       ReleasesFramesWithoutWaitingForRenderTime) {
+  buffer_->SetDecodeAheadFrames(3);
+  StartNextDecodeForceKeyframe();
+  InsertFrames(3);
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  EXPECT_THAT(released_ids_, ElementsAre(0, 1, 2));
+  EXPECT_EQ(dropped_frames(), 0);
+}
+
+TEST_P(DecodeAheadVideoStreamBufferControllerTest,
+       LimitsFramesQueuedForDecode) {
+  buffer_->SetDecodeAheadFrames(2);
+  StartNextDecodeForceKeyframe();
+  InsertFrames(4);
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  EXPECT_THAT(released_ids_, ElementsAre(0, 1));
+
+  buffer_->StartNextDecode(false);
+  EXPECT_THAT(released_ids_, ElementsAre(0, 1, 2));
+  buffer_->StartNextDecode(false);
+  EXPECT_THAT(released_ids_, ElementsAre(0, 1, 2, 3));
+  EXPECT_EQ(dropped_frames(), 0);
+}
+
+TEST_P(DecodeAheadVideoStreamBufferControllerTest,
+       SkipsToKeyframeIfRequired) {
+  buffer_->SetDecodeAheadFrames(2);
+  StartNextDecodeForceKeyframe();
+  InsertFrames(2);
+  time_controller_.AdvanceTime(TimeDelta::Zero());
+  ASSERT_THAT(released_ids_, ElementsAre(0, 1));
+
+  buffer_->InsertFrame(test::FakeFrameBuilder()
+                           .Id(2)
+                           .Time(2 * kFps30Rtp)
+                           .AsLast()
+                           .Refs({1})
+                           .Build());
+  buffer_->InsertFrame(
+      test::FakeFrameBuilder().Id(3).Time(3 * kFps30Rtp).AsLast().Build());
+  buffer_->StartNextDecode(true);
+  EXPECT_THAT(released_ids_, ElementsAre(0, 1, 3));
+}
+
+INSTANTIATE_TEST_SUITE_P(VideoStreamBufferController,
+                         DecodeAheadVideoStreamBufferControllerTest,
+                         ::testing::Combine(::testing::Bool(),
+                                            ::testing::Values("")));
+
 }  // namespace webrtc
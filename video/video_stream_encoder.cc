@@ -83,6 +83,10 @@ constexpr int kMaxAnimationPixels = 1280 * 720;
 
 constexpr int kDefaultMinScreenSharebps = 1200000;
 
+// Used if VideoStreamEncoderSettings::enable_content_analysis is set.
+constexpr TimeDelta kMinSceneChangeKeyFrameInterval = TimeDelta::Seconds(1);
+constexpr TimeDelta kStaticContentFrameInterval = TimeDelta::Millis(200);
+
 int GetNumSpatialLayers(const VideoCodec& codec) {
   if (codec.codecType == kVideoCodecVP9) {
     return codec.VP9().numberOfSpatialLayers;
@@ -655,7 +659,9 @@ VideoStreamEncoder::VideoStreamEncoder(
         encoder_queue,
     BitrateAllocationCallbackType allocation_cb_type,
     const FieldTrialsView& field_trials,
-    webrtc::VideoEncoderFactory::EncoderSelectorInterface* encoder_selector)
+    webrtc::VideoEncoderFactory::EncoderSelectorInterface* encoder_selector,
+    std::unique_ptr<webrtc::TaskQueueBase, webrtc::TaskQueueDeleter>
+        preprocessing_queue)
     : field_trials_(field_trials),
       worker_queue_(TaskQueueBase::Current()),
       number_of_cores_(number_of_cores),
@@ -673,11 +679,22 @@ VideoStreamEncoder::VideoStreamEncoder(
                             : encoder_selector_from_factory_.get()),
       encoder_stats_observer_(encoder_stats_observer),
       frame_cadence_adapter_(std::move(frame_cadence_adapter)),
+      frame_preprocessor_(
+          preprocessing_queue && settings.max_preprocessed_frames_in_flight > 0
+              ? std::make_unique<FramePreprocessor>(
+                    frame_cadence_adapter_.get(),
+                    encoder_stats_observer,
+                    std::move(preprocessing_queue),
+                    settings.max_preprocessed_frames_in_flight)
+              : nullptr),
       clock_(clock),
       delta_ntp_internal_ms_(clock_->CurrentNtpInMilliseconds() -
                              clock_->TimeInMilliseconds()),
       last_frame_log_ms_(clock_->TimeInMilliseconds()),
       next_frame_types_(1, VideoFrameType::kVideoFrameDelta),
+      content_analyzer_(settings.enable_content_analysis
+                            ? std::make_unique<FrameContentAnalyzer>()
+                            : nullptr),
       automatic_animation_detection_experiment_(
           ParseAutomatincAnimationDetectionFieldTrial()),
       input_state_provider_(encoder_stats_observer),
@@ -695,8 +712,12 @@ VideoStreamEncoder::VideoStreamEncoder(
                                std::move(overuse_detector),
                                degradation_preference_manager_.get(),
                                field_trials),
-      video_source_sink_controller_(/*sink=*/frame_cadence_adapter_.get(),
-                                    /*source=*/nullptr),
+      video_source_sink_controller_(
+          /*sink=*/frame_preprocessor_
+              ? static_cast<rtc::VideoSinkInterface<VideoFrame>*>(
+                    frame_preprocessor_.get())
+              : frame_cadence_adapter_.get(),
+          /*source=*/nullptr),
       default_limits_allowed_(
           !field_trials.IsEnabled("WebRTC-DefaultBitrateLimitsKillSwitch")),
       qp_parsing_allowed_(
@@ -772,6 +793,9 @@ void VideoStreamEncoder::Stop() {
     rate_allocator_ = nullptr;
     ReleaseEncoder();
     encoder_ = nullptr;
+    // Waits for the frame being preprocessed, which needs the cadence
+    // adapter.
+    frame_preprocessor_ = nullptr;
     frame_cadence_adapter_ = nullptr;
   });
   shutdown_event.Wait(rtc::Event::kForever);
@@ -902,7 +926,8 @@ void VideoStreamEncoder::ConfigureEncoder(VideoEncoderConfig config,
 
     pending_encoder_creation_ =
         (!encoder_ || encoder_config_.video_format != config.video_format ||
-         max_data_payload_length_ != max_data_payload_length);
+         max_data_payload_length_ != max_data_payload_length ||
+         encoder_config_.parallelism_policy != config.parallelism_policy);
     encoder_config_ = std::move(config);
     max_data_payload_length_ = max_data_payload_length;
     pending_encoder_reconfiguration_ = true;
@@ -1279,6 +1304,7 @@ void VideoStreamEncoder::ReconfigureEncoder() {
     VideoEncoder::Settings settings = VideoEncoder::Settings(
         settings_.capabilities, number_of_cores_, max_data_payload_length);
     settings.encoder_thread_limit = experimental_encoder_thread_limit_;
+    settings.parallelism_policy = encoder_config_.parallelism_policy;
     int error = encoder_->InitEncode(&send_codec_, settings);
     if (error != 0) {
       RTC_LOG(LS_ERROR) << "Failed to initialize the encoder associated with "
@@ -1858,9 +1884,44 @@ void VideoStreamEncoder::MaybeEncodeVideoFrame(const VideoFrame& video_frame,
     return;
   }
 
+  if (content_analyzer_ && ApplyContentAnalysis(video_frame)) {
+    ProcessDroppedFrame(
+        video_frame,
+        VideoStreamEncoderObserver::DropReason::kMediaOptimization);
+    return;
+  }
+
   EncodeVideoFrame(video_frame, time_when_posted_us);
 }
 
+bool VideoStreamEncoder::ApplyContentAnalysis(const VideoFrame& frame) {
+  const Timestamp now = clock_->CurrentTime();
+  switch (content_analyzer_->Analyze(frame)) {
+    case FrameContentAnalyzer::Content::kStatic:
+      if (last_analyzed_frame_encode_time_ &&
+          now - *last_analyzed_frame_encode_time_ <
+              kStaticContentFrameInterval) {
+        return true;
+      }
+      break;
+    case FrameContentAnalyzer::Content::kSceneChange:
+      if (!last_scene_change_key_frame_time_ ||
+          now - *last_scene_change_key_frame_time_ >=
+              kMinSceneChangeKeyFrameInterval) {
+        RTC_LOG(LS_VERBOSE) << "Requesting key frame on scene change.";
+        std::fill(next_frame_types_.begin(), next_frame_types_.end(),
+                  VideoFrameType::kVideoFrameKey);
+        last_scene_change_key_frame_time_ = now;
+      }
+      break;
+    case FrameContentAnalyzer::Content::kUnknown:
+    case FrameContentAnalyzer::Content::kChanged:
+      break;
+  }
+  last_analyzed_frame_encode_time_ = now;
+  return false;
+}
+
 void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
                                           int64_t time_when_posted_us) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
@@ -1898,6 +1959,9 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
   if (encoder_info_ != info) {
     OnEncoderSettingsChanged();
     stream_resource_manager_.ConfigureEncodeUsageResource();
+    if (frame_preprocessor_) {
+      frame_preprocessor_->SetEncoderInfo(info);
+    }
     // Re-configure scalers when encoder info changed. Consider two cases:
     // 1. When the status of the scaler changes from enabled to disabled, if we
     // don't do this CL, scaler will adapt up/down to trigger an unnecessary
@@ -2047,9 +2111,14 @@ void VideoStreamEncoder::SendKeyFrame(
   }
 
   if (!layers.empty()) {
-    RTC_DCHECK_EQ(layers.size(), next_frame_types_.size());
+    // `layers` may list more layers than are encoded, e.g. one per configured
+    // SSRC while fewer simulcast streams are encoded. The entries for layers
+    // that aren't encoded are ignored. Delta entries don't cancel key frames
+    // already requested for a layer.
     for (size_t i = 0; i < layers.size() && i < next_frame_types_.size(); i++) {
-      next_frame_types_[i] = layers[i];
+      if (layers[i] == VideoFrameType::kVideoFrameKey) {
+        next_frame_types_[i] = VideoFrameType::kVideoFrameKey;
+      }
     }
   } else {
     std::fill(next_frame_types_.begin(), next_frame_types_.end(),
@@ -2410,7 +2479,13 @@ void VideoStreamEncoder::RunPostEncode(const EncodedImage& encoded_image,
     // simulcast and spatial indices.
     int stream_index = encoded_image.SpatialIndex().value_or(
         encoded_image.SimulcastIndex().value_or(0));
-    bitrate_adjuster_->OnEncodedFrame(frame_size, stream_index, temporal_index);
+    // Key frames are left out of the QP based frame size prediction.
+    absl::optional<int> qp;
+    if (encoded_image.qp_ >= 0 && !keyframe) {
+      qp = encoded_image.qp_;
+    }
+    bitrate_adjuster_->OnEncodedFrame(frame_size, stream_index, temporal_index,
+                                      qp);
   }
 }
 
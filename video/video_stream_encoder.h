@@ -48,7 +48,9 @@
 #include "video/adaptation/video_stream_encoder_resource_manager.h"
 #include "video/encoder_bitrate_adjuster.h"
 #include "video/frame_cadence_adapter.h"
+#include "video/frame_content_analyzer.h"
 #include "video/frame_encode_metadata_writer.h"
+#include "video/frame_preprocessor.h"
 #include "video/video_source_sink_controller.h"
 #include "video/video_stream_encoder_interface.h"
 #include "video/video_stream_encoder_observer.h"
@@ -86,7 +88,9 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
       BitrateAllocationCallbackType allocation_cb_type,
       const FieldTrialsView& field_trials,
       webrtc::VideoEncoderFactory::EncoderSelectorInterface* encoder_selector =
-          nullptr);
+          nullptr,
+      std::unique_ptr<webrtc::TaskQueueBase, webrtc::TaskQueueDeleter>
+          preprocessing_queue = nullptr);
   ~VideoStreamEncoder() override;
 
   VideoStreamEncoder(const VideoStreamEncoder&) = delete;
@@ -256,6 +260,10 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   void CheckForAnimatedContent(const VideoFrame& frame,
                                int64_t time_when_posted_in_ms)
       RTC_RUN_ON(&encoder_queue_);
+  // Requests a key frame on scene changes. Returns true if the frame should be
+  // dropped to reduce the frame rate of static content.
+  bool ApplyContentAnalysis(const VideoFrame& frame)
+      RTC_RUN_ON(&encoder_queue_);
 
   void RequestEncoderSwitch() RTC_RUN_ON(&encoder_queue_);
 
@@ -295,6 +303,10 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   // forwards them to our OnFrame method.
   std::unique_ptr<FrameCadenceAdapterInterface> frame_cadence_adapter_
       RTC_GUARDED_BY(&encoder_queue_) RTC_PT_GUARDED_BY(&encoder_queue_);
+  // If set, frames enter this preprocessor before the cadence adapter. See
+  // VideoStreamEncoderSettings::max_preprocessed_frames_in_flight.
+  std::unique_ptr<FramePreprocessor> frame_preprocessor_
+      RTC_GUARDED_BY(&encoder_queue_);
 
   VideoEncoderConfig encoder_config_ RTC_GUARDED_BY(&encoder_queue_);
   std::unique_ptr<VideoEncoder> encoder_ RTC_GUARDED_BY(&encoder_queue_)
@@ -365,6 +377,14 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   } expect_resize_state_ RTC_GUARDED_BY(&encoder_queue_) =
       ExpectResizeState::kNoResize;
 
+  // Set if VideoStreamEncoderSettings::enable_content_analysis.
+  std::unique_ptr<FrameContentAnalyzer> content_analyzer_
+      RTC_GUARDED_BY(&encoder_queue_);
+  absl::optional<Timestamp> last_analyzed_frame_encode_time_
+      RTC_GUARDED_BY(&encoder_queue_);
+  absl::optional<Timestamp> last_scene_change_key_frame_time_
+      RTC_GUARDED_BY(&encoder_queue_);
+
   FecControllerOverride* fec_controller_override_
       RTC_GUARDED_BY(&encoder_queue_) = nullptr;
   absl::optional<int64_t> last_parameters_update_ms_
@@ -101,7 +101,9 @@ class VideoStreamEncoderInterface {
 
   // Request a key frame. Used for signalling from the remote receiver with
   // no arguments and for RTCRtpSender.generateKeyFrame with a list of
-  // rids/layers.
+  // rids/layers. `layers` is indexed by simulcast stream, and may be longer
+  // than the number of encoded streams, in which case the extra entries are
+  // ignored.
   virtual void SendKeyFrame(const std::vector<VideoFrameType>& layers = {}) = 0;
 
   // Inform the encoder that a loss has occurred.
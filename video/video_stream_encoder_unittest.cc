@@ -11,6 +11,7 @@
 #include "video/video_stream_encoder.h"
 
 #include <algorithm>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <tuple>
@@ -871,8 +872,9 @@ class VideoStreamEncoderTest : public ::testing::Test {
         "EncoderQueue", TaskQueueFactory::Priority::NORMAL);
     TaskQueueBase* encoder_queue_ptr = encoder_queue.get();
     std::unique_ptr<FrameCadenceAdapterInterface> cadence_adapter =
-        FrameCadenceAdapterInterface::Create(time_controller_.GetClock(),
-                                             encoder_queue_ptr, field_trials_);
+        FrameCadenceAdapterInterface::Create(
+            time_controller_.GetClock(), encoder_queue_ptr,
+            /*metronome=*/nullptr, /*worker_queue=*/nullptr, field_trials_);
     video_stream_encoder_ = std::make_unique<VideoStreamEncoderUnderTest>(
         &time_controller_, std::move(cadence_adapter), std::move(encoder_queue),
         stats_proxy_.get(), video_send_config_.encoder_settings,
@@ -1219,6 +1221,11 @@ class VideoStreamEncoderTest : public ::testing::Test {
       return last_encoder_complexity_;
     }
 
+    ParallelismPolicy LastParallelismPolicy() {
+      MutexLock lock(&local_mutex_);
+      return last_parallelism_policy_;
+    }
+
    private:
     int32_t Encode(const VideoFrame& input_image,
                    const std::vector<VideoFrameType>* frame_types) override {
@@ -1278,6 +1285,7 @@ class VideoStreamEncoderTest : public ::testing::Test {
       }
 
       last_encoder_complexity_ = config->GetVideoEncoderComplexity();
+      last_parallelism_policy_ = settings.parallelism_policy;
 
       if (force_init_encode_failed_) {
         initialized_ = EncoderState::kInitializationFailed;
@@ -1362,6 +1370,8 @@ class VideoStreamEncoderTest : public ::testing::Test {
     absl::optional<bool> is_qp_trusted_ RTC_GUARDED_BY(local_mutex_);
     VideoCodecComplexity last_encoder_complexity_ RTC_GUARDED_BY(local_mutex_){
         VideoCodecComplexity::kComplexityNormal};
+    ParallelismPolicy last_parallelism_policy_ RTC_GUARDED_BY(local_mutex_) =
+        ParallelismPolicy::kDefault;
   };
 
   class TestSink : public VideoStreamEncoder::EncoderSink {
@@ -1942,6 +1952,30 @@ TEST_F(VideoStreamEncoderTest,
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest, ReinitializesEncoderWithParallelismPolicy) {
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  WaitForEncodedFrame(1);
+  EXPECT_EQ(fake_encoder_.LastParallelismPolicy(),
+            VideoEncoder::ParallelismPolicy::kDefault);
+
+  VideoEncoderConfig video_encoder_config;
+  test::FillEncoderConfiguration(kVideoCodecVP8, 1, &video_encoder_config);
+  video_encoder_config.parallelism_policy =
+      VideoEncoder::ParallelismPolicy::kLowLatency;
+  video_stream_encoder_->ConfigureEncoder(std::move(video_encoder_config),
+                                          kMaxPayloadLength);
+
+  video_source_.IncomingCapturedFrame(CreateFrame(2, nullptr));
+  WaitForEncodedFrame(2);
+  EXPECT_EQ(fake_encoder_.LastParallelismPolicy(),
+            VideoEncoder::ParallelismPolicy::kLowLatency);
+
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, BitrateLimitsChangeReconfigureRateAllocator) {
   video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
       kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
@@ -7344,6 +7378,32 @@ TEST_F(VideoStreamEncoderTest, SetsFrameTypes) {
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest, SendKeyFrameIgnoresLayersThatAreNotEncoded) {
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  WaitForEncodedFrame(1);
+  video_source_.IncomingCapturedFrame(CreateFrame(2, nullptr));
+  WaitForEncodedFrame(2);
+  EXPECT_THAT(
+      fake_encoder_.LastFrameTypes(),
+      ::testing::ElementsAre(VideoFrameType{VideoFrameType::kVideoFrameDelta}));
+
+  // Request a key frame with one entry per configured SSRC, although only a
+  // single stream is encoded.
+  video_stream_encoder_->SendKeyFrame({VideoFrameType::kVideoFrameKey,
+                                       VideoFrameType::kVideoFrameDelta,
+                                       VideoFrameType::kVideoFrameDelta});
+  video_source_.IncomingCapturedFrame(CreateFrame(3, nullptr));
+  WaitForEncodedFrame(3);
+  EXPECT_THAT(
+      fake_encoder_.LastFrameTypes(),
+      ::testing::ElementsAre(VideoFrameType{VideoFrameType::kVideoFrameKey}));
+
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, SetsFrameTypesSimulcast) {
   // Setup simulcast with three streams.
   ResetEncoder("VP8", 3, 1, 1, false);
@@ -7385,6 +7445,61 @@ TEST_F(VideoStreamEncoderTest, SetsFrameTypesSimulcast) {
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest, ContentAnalysisRequestsKeyFrameOnSceneChange) {
+  video_send_config_.encoder_settings.enable_content_analysis = true;
+  ConfigureEncoder(video_encoder_config_.Copy());
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+  auto create_frame = [&](uint8_t luma) {
+    rtc::scoped_refptr<I420Buffer> buffer =
+        I420Buffer::Create(codec_width_, codec_height_);
+    std::memset(buffer->MutableDataY(), luma,
+                buffer->StrideY() * codec_height_);
+    return VideoFrame::Builder()
+        .set_video_frame_buffer(buffer)
+        .set_ntp_time_ms(CurrentTimeMs())
+        .build();
+  };
+
+  video_source_.IncomingCapturedFrame(create_frame(0));
+  WaitForEncodedFrame(CurrentTimeMs());
+  AdvanceTime(TimeDelta::Millis(500));
+  video_source_.IncomingCapturedFrame(create_frame(16));
+  WaitForEncodedFrame(CurrentTimeMs());
+  EXPECT_THAT(fake_encoder_.LastFrameTypes(),
+              ::testing::ElementsAre(VideoFrameType::kVideoFrameDelta));
+
+  AdvanceTime(TimeDelta::Seconds(1));
+  video_source_.IncomingCapturedFrame(create_frame(255));
+  WaitForEncodedFrame(CurrentTimeMs());
+  EXPECT_THAT(fake_encoder_.LastFrameTypes(),
+              ::testing::ElementsAre(VideoFrameType::kVideoFrameKey));
+
+  video_stream_encoder_->Stop();
+}
+
+TEST_F(VideoStreamEncoderTest, ContentAnalysisDropsStaticFrames) {
+  video_send_config_.encoder_settings.enable_content_analysis = true;
+  ConfigureEncoder(video_encoder_config_.Copy());
+  video_stream_encoder_->OnBitrateUpdatedAndWaitForManagedResources(
+      kTargetBitrate, kTargetBitrate, kTargetBitrate, 0, 0, 0);
+
+  video_source_.IncomingCapturedFrame(
+      CreateFrame(CurrentTimeMs(), codec_width_, codec_height_));
+  WaitForEncodedFrame(CurrentTimeMs());
+  // Same content shortly after the last encoded frame.
+  video_source_.IncomingCapturedFrame(
+      CreateFrame(CurrentTimeMs(), codec_width_, codec_height_));
+  ExpectDroppedFrame();
+
+  AdvanceTime(TimeDelta::Millis(200));
+  video_source_.IncomingCapturedFrame(
+      CreateFrame(CurrentTimeMs(), codec_width_, codec_height_));
+  WaitForEncodedFrame(CurrentTimeMs());
+
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, DoesNotRewriteH264BitstreamWithOptimalSps) {
   // SPS contains VUI with restrictions on the maximum number of reordered
   // pictures, there is no need to rewrite the bitstream to enable faster
@@ -9552,7 +9667,7 @@ TEST(VideoStreamEncoderFrameCadenceTest,
       "WebRTC-ZeroHertzScreenshare/Enabled/");
   auto adapter = FrameCadenceAdapterInterface::Create(
       factory.GetTimeController()->GetClock(), encoder_queue.get(),
-      field_trials);
+      /*metronome=*/nullptr, /*worker_queue=*/nullptr, field_trials);
   FrameCadenceAdapterInterface* adapter_ptr = adapter.get();
 
   MockVideoSourceInterface mock_source;